@@ -195,6 +195,10 @@ Node& Node::operator=(VPackSlice const& slice) {
     _value.front().append(reinterpret_cast<char const*>(slice.begin()), slice.byteSize());
   }
   _vecBufDirty = true;
+  if (_isArray) {
+    // readers share the store's lock and must not rebuild the buffer
+    rebuildVecBuf();
+  }
   return *this;
 }
 
@@ -726,6 +730,7 @@ bool Node::applieOp(VPackSlice const& slice) {
       _children.clear();
       _value.clear();
       _vecBufDirty = true;    // just in case there was an array
+      rebuildVecBuf();
       return true;
     } else {
       return _parent->removeChild(_nodeName);
@@ -135,6 +135,59 @@ bool State::persist(index_t index, term_t term, uint64_t millis,
   return res.ok();
 }
 
+/// Persist several entries at once
+bool State::persist(std::vector<PendingEntry> const& entries) const {
+  LOG_TOPIC("a3c5e", TRACE, Logger::AGENCY)
+      << "persist " << entries.size() << " entries, first index=" << entries.front().index;
+
+  Builder body;
+  {
+    VPackArrayBuilder a(&body);
+    for (auto const& e : entries) {
+      VPackObjectBuilder b(&body);
+      body.add("_key", Value(stringify(e.index)));
+      body.add("term", Value(e.term));
+      body.add("request", e.entry);
+      body.add("clientId", Value(e.clientId));
+      body.add("timestamp", Value(timestamp(e.millis)));
+    }
+  }
+
+  TRI_ASSERT(_vocbase != nullptr);
+  auto ctx = std::make_shared<transaction::StandaloneContext>(*_vocbase);
+  SingleCollectionTransaction trx(ctx, "log", AccessMode::Type::WRITE);
+
+  Result res = trx.begin();
+
+  if (!res.ok()) {
+    THROW_ARANGO_EXCEPTION(res);
+  }
+
+  OperationResult result;
+
+  try {
+    result = trx.insert("log", body.slice(), _options);
+  } catch (std::exception const& e) {
+    LOG_TOPIC("5b0e2", ERR, Logger::AGENCY) << "Failed to persist log entries:" << e.what();
+    return false;
+  }
+
+  if (result.ok() && !result.countErrorCodes.empty()) {
+    // all entries or none
+    LOG_TOPIC("2e7f9", ERR, Logger::AGENCY)
+        << "Failed to persist log entries: "
+        << TRI_errno_string(result.countErrorCodes.begin()->first);
+    result.result.reset(result.countErrorCodes.begin()->first);
+  }
+
+  res = trx.finish(result.result);
+
+  LOG_TOPIC("7f4d1", TRACE, Logger::AGENCY)
+      << "persist done " << entries.size() << " entries, ok:" << res.ok();
+
+  return res.ok();
+}
+
 bool State::persistconf(index_t index, term_t term, uint64_t millis,
                         arangodb::velocypack::Slice const& entry,
                         std::string const& clientId) const {
@@ -242,6 +295,9 @@ std::vector<index_t> State::logLeaderMulti(query_t const& transactions,
 
   TRI_ASSERT(!_log.empty());  // log must never be empty
 
+  // all entries up to the next reconfiguration go to disk together
+  std::vector<PendingEntry> pending;
+
   for (auto const& i : VPackArrayIterator(slice)) {
     if (!i.isArray()) {
       THROW_ARANGO_EXCEPTION_MESSAGE(30000,
@@ -257,12 +313,19 @@ std::vector<index_t> State::logLeaderMulti(query_t const& transactions,
       TRI_ASSERT(transaction.length() > 0);
       size_t pos = transaction.keyAt(0).copyString().find(RECONFIGURE);
 
-      idx[j] = logNonBlocking(_log.back().index + 1, i[0], term, 0, clientId, true,
-                              pos == 0 || pos == 1);
+      if (pos == 0 || pos == 1) {
+        logNonBlocking(pending);
+        idx[j] = logNonBlocking(_log.back().index + 1, i[0], term, 0, clientId, true, true);
+      } else {
+        idx[j] = _log.back().index + 1 + pending.size();
+        pending.push_back(PendingEntry{idx[j], term, 0, i[0], clientId});
+      }
     }
     ++j;
   }
 
+  logNonBlocking(pending);
+
   return idx;
 }
 
@@ -295,6 +358,27 @@ index_t State::logNonBlocking(index_t idx, velocypack::Slice const& slice,
   return _log.back().index;
 }
 
+/// Log transactions in one go (leader and follower)
+void State::logNonBlocking(std::vector<PendingEntry>& pending) {
+  _logLock.assertLockedByCurrentThread();
+
+  if (pending.empty()) {
+    return;
+  }
+
+  if (!persist(pending)) {  // log to disk or die
+    LOG_TOPIC("c5e1a", FATAL, Logger::AGENCY)
+      << "RAFT member fails to persist log entries!";
+    FATAL_ERROR_EXIT();
+  }
+
+  for (auto const& e : pending) {
+    auto buf = std::make_shared<Buffer<uint8_t>>();
+    buf->append((char const*)e.entry.begin(), e.entry.byteSize());
+    logEmplaceBackNoLock(log_t(e.index, e.term, buf, e.clientId));
+  }
+  pending.clear();
+}
 
 void State::logEmplaceBackNoLock(log_t&& l) {
 
@@ -394,6 +478,7 @@ index_t State::logFollower(query_t const& transactions) {
     TRI_ASSERT(slices.isArray());
     size_t nqs = slices.length();
     std::string clientId;
+    std::vector<PendingEntry> pending;
 
     for (size_t i = ndups; i < nqs; ++i) {
       VPackSlice const& slice = slices[i];
@@ -413,11 +498,17 @@ index_t State::logFollower(query_t const& transactions) {
 
       bool reconfiguration = query.keyAt(0).isEqualString(RECONFIGURE);
 
-      // first to disk
-      if (logNonBlocking(index, query, term, tstamp, clientId, false, reconfiguration) == 0) {
-        break;
+      // first to disk, all entries up to the next reconfiguration together
+      if (reconfiguration) {
+        logNonBlocking(pending);
+        if (logNonBlocking(index, query, term, tstamp, clientId, false, true) == 0) {
+          break;
+        }
+      } else {
+        pending.push_back(PendingEntry{index, term, tstamp, query, clientId});
       }
     }
+    logNonBlocking(pending);
   }
   return _log.back().index;  // never empty
 }
@@ -213,10 +213,27 @@ class State {
                          std::string const& clientId = std::string(),
                          bool leading = false, bool reconfiguration = false);
 
+  /// @brief a log entry about to be persisted
+  struct PendingEntry {
+    index_t index;
+    term_t term;
+    uint64_t millis;
+    arangodb::velocypack::Slice entry;
+    std::string clientId;
+  };
+
+  /// @brief Log several entries, none of which is a reconfiguration, with a
+  /// single transaction. Clears pending. Must be guarded by caller.
+  void logNonBlocking(std::vector<PendingEntry>& pending);
+
   /// @brief Save currentTerm, votedFor, log entries
   bool persist(index_t, term_t, uint64_t, arangodb::velocypack::Slice const&,
                std::string const&) const;
 
+  /// @brief Save several log entries in one transaction, such that they
+  /// share one sync to disk
+  bool persist(std::vector<PendingEntry> const&) const;
+
   /// @brief Save currentTerm, votedFor, log entries for reconfiguration
   bool persistconf(index_t, term_t, uint64_t, arangodb::velocypack::Slice const&,
                    std::string const&) const;
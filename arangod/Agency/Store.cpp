@@ -27,6 +27,7 @@
 #include "Agency/Agent.h"
 #include "Basics/ConditionLocker.h"
 #include "Basics/ReadLocker.h"
+#include "Basics/WriteLocker.h"
 #include "Basics/StringUtils.h"
 #include "Basics/VelocyPackHelper.h"
 #include "Basics/WriteLocker.h"
@@ -116,8 +117,8 @@ Store::Store(Agent* agent, std::string const& name)
 /// Copy assignment operator
 Store& Store::operator=(Store const& rhs) {
   if (&rhs != this) {
-    MUTEX_LOCKER(otherLock, rhs._storeLock);
-    MUTEX_LOCKER(lock, _storeLock);
+    READ_LOCKER(otherLock, rhs._storeLock);
+    WRITE_LOCKER(lock, _storeLock);
     _agent = rhs._agent;
     _timeTable = rhs._timeTable;
     _observerTable = rhs._observerTable;
@@ -130,8 +131,8 @@ Store& Store::operator=(Store const& rhs) {
 /// Move assignment operator
 Store& Store::operator=(Store&& rhs) {
   if (&rhs != this) {
-    MUTEX_LOCKER(otherLock, rhs._storeLock);
-    MUTEX_LOCKER(lock, _storeLock);
+    WRITE_LOCKER(otherLock, rhs._storeLock);
+    WRITE_LOCKER(lock, _storeLock);
     _agent = std::move(rhs._agent);
     _timeTable = std::move(rhs._timeTable);
     _observerTable = std::move(rhs._observerTable);
@@ -168,7 +169,7 @@ std::vector<apply_ret_t> Store::applyTransactions(query_t const& query,
           }
         }
 
-        MUTEX_LOCKER(storeLocker, _storeLock);
+        WRITE_LOCKER(storeLocker, _storeLock);
         switch (i.length()) {
           case 1:  // No precondition
             success.push_back(applies(i[0]) ? APPLIED : UNKNOWN_ERROR);
@@ -213,7 +214,7 @@ std::vector<apply_ret_t> Store::applyTransactions(query_t const& query,
 check_ret_t Store::applyTransaction(Slice const& query) {
   check_ret_t ret(true);
 
-  MUTEX_LOCKER(storeLocker, _storeLock);
+  WRITE_LOCKER(storeLocker, _storeLock);
   switch (query.length()) {
     case 1:  // No precondition
       applies(query[0]);
@@ -270,7 +271,7 @@ std::vector<bool> Store::applyLogEntries(arangodb::velocypack::Builder const& qu
   {
     VPackArrayIterator queriesIterator(queries.slice());
 
-    MUTEX_LOCKER(storeLocker, _storeLock);
+    WRITE_LOCKER(storeLocker, _storeLock);
 
     while (queriesIterator.valid()) {
       applied.push_back(applies(queriesIterator.value()));
@@ -297,7 +298,7 @@ std::vector<bool> Store::applyLogEntries(arangodb::velocypack::Builder const& qu
             while (true) {
               // TODO: Check if not a special lock will help
               {
-                MUTEX_LOCKER(storeLocker, _storeLock);
+                READ_LOCKER(storeLocker, _storeLock);
                 auto ret = _observedTable.equal_range(uri);
                 for (auto it = ret.first; it != ret.second; ++it) {
                   in.emplace(it->second,
@@ -378,7 +379,6 @@ check_ret_t Store::check(VPackSlice const& slice, CheckMode mode) const {
   check_ret_t ret;
   ret.open();
 
-  _storeLock.assertLockedByCurrentThread();
 
   for (auto const& precond : VPackObjectIterator(slice)) {  // Preconditions
 
@@ -556,7 +556,7 @@ bool Store::read(VPackSlice const& query, Builder& ret) const {
   //   a fast path for exactly one path, in which we do not have to copy all
   //   a slow path for more than one path
 
-  MUTEX_LOCKER(storeLocker, _storeLock);  // Freeze KV-Store for read
+  READ_LOCKER(storeLocker, _storeLock);  // Freeze KV-Store for read
   if (query_strs.size() == 1) {
     auto const& path = query_strs[0];
     std::vector<std::string> pv = split(path, '/');
@@ -606,7 +606,7 @@ query_t Store::clearExpired() const {
   query_t tmp = std::make_shared<Builder>();
   {
     VPackArrayBuilder t(tmp.get());
-    MUTEX_LOCKER(storeLocker, _storeLock);
+    READ_LOCKER(storeLocker, _storeLock);
     if (!_timeTable.empty()) {
       for (auto it = _timeTable.cbegin(); it != _timeTable.cend(); ++it) {
         if (it->first < std::chrono::system_clock::now()) {
@@ -630,7 +630,7 @@ query_t Store::clearExpired() const {
 
 /// Dump internal data to builder
 void Store::dumpToBuilder(Builder& builder) const {
-  MUTEX_LOCKER(storeLocker, _storeLock);
+  WRITE_LOCKER(storeLocker, _storeLock);
   toBuilder(builder, true);
 
   std::map<std::string, int64_t> clean {};
@@ -686,8 +686,6 @@ bool Store::applies(arangodb::velocypack::Slice const& transaction) {
   sort(idx.begin(), idx.end(),
        [&abskeys](size_t i1, size_t i2) { return abskeys[i1] < abskeys[i2]; });
 
-  _storeLock.assertLockedByCurrentThread();
-
   for (const auto& i : idx) {
     std::string const& key = keys.at(i);
     Slice value = transaction.get(key);
@@ -704,7 +702,7 @@ bool Store::applies(arangodb::velocypack::Slice const& transaction) {
 
 // Clear my data
 void Store::clear() {
-  MUTEX_LOCKER(storeLocker, _storeLock);
+  WRITE_LOCKER(storeLocker, _storeLock);
   _timeTable.clear();
   _observerTable.clear();
   _observedTable.clear();
@@ -718,7 +716,7 @@ Store& Store::operator=(VPackSlice const& s) {
   auto const& slice = s.get("readDB");
   TRI_ASSERT(slice.length() == 4);
 
-  MUTEX_LOCKER(storeLocker, _storeLock);
+  WRITE_LOCKER(storeLocker, _storeLock);
   _node.applies(slice[0]);
 
   if (s.hasKey("version")) {
@@ -756,61 +754,53 @@ Store& Store::operator=(VPackSlice const& s) {
 
 /// Put key value store in velocypack, guarded by caller
 void Store::toBuilder(Builder& b, bool showHidden) const {
-  _storeLock.assertLockedByCurrentThread();
   _node.toBuilder(b, showHidden);
 }
 
 /// Time table
 std::multimap<TimePoint, std::string>& Store::timeTable() {
-  _storeLock.assertLockedByCurrentThread();
   return _timeTable;
 }
 
 /// Time table
 std::multimap<TimePoint, std::string> const& Store::timeTable() const {
-  _storeLock.assertLockedByCurrentThread();
   return _timeTable;
 }
 
 /// Observer table
 std::unordered_multimap<std::string, std::string>& Store::observerTable() {
-  _storeLock.assertLockedByCurrentThread();
   return _observerTable;
 }
 
 /// Observer table
 std::unordered_multimap<std::string, std::string> const& Store::observerTable() const {
-  _storeLock.assertLockedByCurrentThread();
   return _observerTable;
 }
 
 /// Observed table
 std::unordered_multimap<std::string, std::string>& Store::observedTable() {
-  _storeLock.assertLockedByCurrentThread();
   return _observedTable;
 }
 
 /// Observed table
 std::unordered_multimap<std::string, std::string> const& Store::observedTable() const {
-  _storeLock.assertLockedByCurrentThread();
   return _observedTable;
 }
 
 /// Get node at path under mutex
 Node Store::get(std::string const& path) const {
-  MUTEX_LOCKER(storeLocker, _storeLock);
+  READ_LOCKER(storeLocker, _storeLock);
   return _node.hasAsNode(path).first;
 }
 
 /// Get node at path under mutex
 bool Store::has(std::string const& path) const {
-  MUTEX_LOCKER(storeLocker, _storeLock);
+  READ_LOCKER(storeLocker, _storeLock);
   return _node.has(path);
 }
 
 /// Remove ttl entry for path, guarded by caller
 void Store::removeTTL(std::string const& uri) {
-  _storeLock.assertLockedByCurrentThread();
   if (!_timeTable.empty()) {
     for (auto it = _timeTable.cbegin(); it != _timeTable.cend();) {
       if (it->second == uri) {
@@ -26,6 +26,7 @@
 
 #include "AgentInterface.h"
 #include "Basics/ConditionVariable.h"
+#include "Basics/ReadWriteLock.h"
 #include "Node.h"
 #include <map>
 
@@ -159,9 +160,11 @@ class Store {
   /// @brief Condition variable guarding removal of expired entries
   mutable arangodb::basics::ConditionVariable _cv;
 
-  /// @brief Read/Write mutex on database
-  /// guard _node, _timeTable, _observerTable, _observedTable
-  mutable arangodb::Mutex _storeLock;
+  /// @brief Read/Write lock on database
+  /// guard _node, _timeTable, _observerTable, _observedTable. reads of the
+  /// agency, of the supervision and of the callbacks share the lock, only
+  /// writes are exclusive
+  mutable arangodb::basics::ReadWriteLock _storeLock;
 
   /// @brief My own agent
   Agent* _agent;
@@ -22,6 +22,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "Aggregator.h"
+#include "Basics/HyperLogLog.h"
 #include "Basics/VelocyPackHelper.h"
 #include "Transaction/Context.h"
 #include "Transaction/Helpers.h"
@@ -32,6 +33,7 @@
 #include <velocypack/Slice.h>
 #include <velocypack/velocypack-aliases.h>
 
+#include <cmath>
 #include <set>
 
 using namespace arangodb;
@@ -669,7 +671,7 @@ struct AggregatorUniqueStep2 final : public AggregatorUnique {
     for (auto const& it : VPackArrayIterator(s)) {
       if (seen.find(it) != seen.end()) {
         // already saw the same value
-        return;
+        continue;
       }
 
       char* pos = allocator.store(it.startAs<char>(), it.byteSize());
@@ -747,7 +749,7 @@ struct AggregatorSortedUniqueStep2 final : public AggregatorSortedUnique {
     for (auto const& it : VPackArrayIterator(s)) {
       if (seen.find(it) != seen.end()) {
         // already saw the same value
-        return;
+        continue;
       }
 
       char* pos = allocator.store(it.startAs<char>(), it.byteSize());
@@ -812,9 +814,9 @@ struct AggregatorCountDistinctStep2 final : public AggregatorCountDistinct {
     }
 
     for (auto const& it : VPackArrayIterator(s)) {
-      if (seen.find(s) != seen.end()) {
+      if (seen.find(it) != seen.end()) {
         // already saw the same value
-        return;
+        continue;
       }
 
       char* pos = allocator.store(it.startAs<char>(), it.byteSize());
@@ -823,6 +825,109 @@ struct AggregatorCountDistinctStep2 final : public AggregatorCountDistinct {
   }
 };
 
+/// @brief the single-server variant of APPROX_COUNT_DISTINCT
+struct AggregatorApproxCountDistinct : public Aggregator {
+  explicit AggregatorApproxCountDistinct(transaction::Methods* trx)
+      : Aggregator(trx) {}
+
+  void reset() override final { sketch.clear(); }
+
+  void reduce(AqlValue const& cmpValue) override {
+    AqlValueMaterializer materializer(trx);
+    // values that compare equal in AQL (e.g. 1 and 1.0) are counted once
+    sketch.insert(materializer.slice(cmpValue, true).normalizedHash());
+  }
+
+  AqlValue stealValue() override {
+    uint64_t value = static_cast<uint64_t>(std::llround(sketch.estimate()));
+    reset();
+    return AqlValue(AqlValueHintUInt(value));
+  }
+
+  basics::HyperLogLog sketch;
+};
+
+/// @brief the DB server variant of APPROX_COUNT_DISTINCT, produces the
+/// sketch registers instead of the estimate
+struct AggregatorApproxCountDistinctStep1 final : public AggregatorApproxCountDistinct {
+  explicit AggregatorApproxCountDistinctStep1(transaction::Methods* trx)
+      : AggregatorApproxCountDistinct(trx) {}
+
+  AqlValue stealValue() override final {
+    std::string registers;
+    sketch.serialize(registers);
+    AqlValue result(registers);
+    reset();
+    return result;
+  }
+};
+
+/// @brief the coordinator variant of APPROX_COUNT_DISTINCT, merges the
+/// sketches of the DB servers
+struct AggregatorApproxCountDistinctStep2 final : public AggregatorApproxCountDistinct {
+  explicit AggregatorApproxCountDistinctStep2(transaction::Methods* trx)
+      : AggregatorApproxCountDistinct(trx) {}
+
+  void reduce(AqlValue const& cmpValue) override final {
+    AqlValueMaterializer materializer(trx);
+
+    VPackSlice s = materializer.slice(cmpValue, true);
+
+    if (!s.isString()) {
+      return;
+    }
+
+    VPackValueLength length;
+    char const* p = s.getStringUnchecked(length);
+    basics::HyperLogLog other;
+    if (!other.deserialize(p, static_cast<size_t>(length))) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                     "invalid APPROX_COUNT_DISTINCT sketch");
+    }
+    sketch.merge(other);
+  }
+};
+
+/// @brief the coordinator variant of COLLECT ... INTO. concatenates the
+/// partial group arrays built on the DB servers
+struct AggregatorMergeLists final : public Aggregator {
+  explicit AggregatorMergeLists(transaction::Methods* trx) : Aggregator(trx) {}
+
+  void reset() override final { builder.clear(); }
+
+  void reduce(AqlValue const& cmpValue) override final {
+    AqlValueMaterializer materializer(trx);
+
+    VPackSlice s = materializer.slice(cmpValue, true);
+
+    if (!s.isArray()) {
+      return;
+    }
+
+    if (builder.isClosed()) {
+      builder.openArray();
+    }
+    for (auto const& it : VPackArrayIterator(s)) {
+      builder.add(it);
+    }
+  }
+
+  AqlValue stealValue() override final {
+    // if not yet an array, start one
+    if (builder.isClosed()) {
+      builder.openArray();
+    }
+
+    // always close the Builder
+    builder.close();
+    AqlValue result(builder.slice());
+    reset();
+    return result;
+  }
+
+  arangodb::velocypack::Builder builder;
+};
+
 /// @brief all available aggregators with their meta data
 std::unordered_map<std::string, AggregatorInfo> const aggregators = {
     {"LENGTH",
@@ -964,7 +1069,28 @@ std::unordered_map<std::string, AggregatorInfo> const aggregators = {
      {[](transaction::Methods* trx) {
         return std::make_unique<AggregatorCountDistinctStep2>(trx);
       },
-      doesRequireInput, internalOnly, "", "COUNT_DISTINCT_STEP2"}}};
+      doesRequireInput, internalOnly, "", "COUNT_DISTINCT_STEP2"}},
+    {"APPROX_COUNT_DISTINCT",
+     {[](transaction::Methods* trx) {
+        return std::make_unique<AggregatorApproxCountDistinct>(trx);
+      },
+      doesRequireInput, official, "APPROX_COUNT_DISTINCT_STEP1",
+      "APPROX_COUNT_DISTINCT_STEP2"}},
+    {"APPROX_COUNT_DISTINCT_STEP1",
+     {[](transaction::Methods* trx) {
+        return std::make_unique<AggregatorApproxCountDistinctStep1>(trx);
+      },
+      doesRequireInput, internalOnly, "", "APPROX_COUNT_DISTINCT_STEP1"}},
+    {"APPROX_COUNT_DISTINCT_STEP2",
+     {[](transaction::Methods* trx) {
+        return std::make_unique<AggregatorApproxCountDistinctStep2>(trx);
+      },
+      doesRequireInput, internalOnly, "", "APPROX_COUNT_DISTINCT_STEP2"}},
+    {"MERGE_LISTS",
+     {[](transaction::Methods* trx) {
+        return std::make_unique<AggregatorMergeLists>(trx);
+      },
+      doesRequireInput, internalOnly, "", "MERGE_LISTS"}}};
 
 /// @brief aliases (user-visible) for aggregation functions
 std::unordered_map<std::string, std::string> const aliases = {
@@ -79,7 +79,15 @@ struct Aggregator {
   /// example, the COUNT aggregator is commutative. it can be pushed from the
   /// coordinator to the DB server and be used there too. However, on the
   /// coordinator we must not use COUNT on the aggregated results from the DB
-  /// server, but use SUM instead
+  /// server, but use SUM instead.
+  /// note that this is also the way to merge partial aggregation states in
+  /// general: the partial aggregators must be of type pushToDBServerAs(type),
+  /// not of type itself (e.g. AVERAGE_STEP1 for AVERAGE), and the results of
+  /// their stealValue() are fed into a single aggregator of type
+  /// runOnCoordinatorAs(type) via reduce(). aggregators for which
+  /// pushToDBServerAs(type) is empty cannot be split up like this.
+  /// aggregators are not thread-safe, as they compare and hash values using
+  /// the (non-thread-safe) transaction they were created for
   static std::string runOnCoordinatorAs(std::string const& type);
 
   /// @brief whether or not the aggregator name is supported and part of the
@@ -284,6 +284,7 @@ void AqlFunctionFeature::addListFunctions() {
   add({"COUNT_DISTINCT", ".", flags, &Functions::CountDistinct});
   // COUNT_UNIQUE is an alias for COUNT_DISTINCT
   addAlias("COUNT_UNIQUE", "COUNT_DISTINCT");
+  add({"APPROX_COUNT_DISTINCT", ".", flags, &Functions::ApproxCountDistinct});
   add({"UNIQUE", ".", flags, &Functions::Unique});
   add({"SORTED_UNIQUE", ".", flags, &Functions::SortedUnique});
   add({"SORTED", ".", flags, &Functions::Sorted});
@@ -33,11 +33,64 @@
 #include <velocypack/Iterator.h>
 #include <velocypack/velocypack-aliases.h>
 
+#include <lz4.h>
+
 using namespace arangodb;
 using namespace arangodb::aql;
 
 using VelocyPackHelper = arangodb::basics::VelocyPackHelper;
 
+namespace {
+/// @brief adds the "data" and "raw" attributes from payload to result,
+/// LZ4-compressed if this is worth it
+void addPayload(VPackSlice payload, VPackBuilder& result) {
+  size_t const size = payload.byteSize();
+  if (size >= AqlItemBlock::compressionThreshold &&
+      size <= static_cast<size_t>(LZ4_MAX_INPUT_SIZE)) {
+    std::string buffer;
+    buffer.resize(static_cast<size_t>(LZ4_compressBound(static_cast<int>(size))));
+    int compressed = LZ4_compress_default(payload.startAs<char>(), &buffer[0],
+                                          static_cast<int>(size),
+                                          static_cast<int>(buffer.size()));
+    // only use the compressed variant if it saves at least 10%
+    if (compressed > 0 && static_cast<size_t>(compressed) < size - size / 10) {
+      result.add("uncompressedSize", VPackValue(size));
+      result.add("compressed",
+                 VPackValuePair(reinterpret_cast<uint8_t const*>(buffer.data()),
+                                static_cast<VPackValueLength>(compressed),
+                                VPackValueType::Binary));
+      return;
+    }
+  }
+  result.add("data", payload.get("data"));
+  result.add("raw", payload.get("raw"));
+}
+
+/// @brief decompresses the "compressed" attribute of a serialized block
+/// into buffer and returns the contained payload object
+VPackSlice decompressPayload(VPackSlice slice, std::string& buffer) {
+  VPackValueLength compressedSize;
+  uint8_t const* compressed = slice.get("compressed").getBinary(compressedSize);
+  size_t const size =
+      VelocyPackHelper::getNumericValue<size_t>(slice, "uncompressedSize", 0);
+  if (size == 0 || size > static_cast<size_t>(LZ4_MAX_INPUT_SIZE)) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                   "invalid uncompressed size for AqlItemBlock");
+  }
+  buffer.resize(size);
+  int decompressed = LZ4_decompress_safe(reinterpret_cast<char const*>(compressed),
+                                         &buffer[0], static_cast<int>(compressedSize),
+                                         static_cast<int>(size));
+  VPackSlice payload(reinterpret_cast<uint8_t const*>(buffer.data()));
+  if (decompressed != static_cast<int>(size) || !payload.isObject() ||
+      payload.byteSize() != size) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                   "cannot decompress AqlItemBlock");
+  }
+  return payload;
+}
+}  // namespace
+
 /// @brief create the block
 AqlItemBlock::AqlItemBlock(AqlItemBlockManager& manager, size_t nrItems, RegisterId nrRegs)
     : _nrItems(nrItems), _nrRegs(nrRegs), _manager(manager), _refCount(0) {
@@ -84,6 +137,15 @@ void AqlItemBlock::initFromSlice(VPackSlice const slice) {
   VPackSlice data = slice.get("data");
   VPackSlice raw = slice.get("raw");
 
+  // the AqlValues created below copy their data, so the decompressed
+  // payload only needs to live until the end of this method
+  std::string decompressed;
+  if (slice.get("compressed").isBinary()) {
+    VPackSlice payload = decompressPayload(slice, decompressed);
+    data = payload.get("data");
+    raw = payload.get("raw");
+  }
+
   std::vector<AqlValue> madeHere;
   madeHere.reserve(static_cast<size_t>(raw.length()));
   madeHere.emplace_back();  // an empty AqlValue
@@ -356,7 +418,7 @@ void AqlItemBlock::rescale(size_t nrItems, RegisterId nrRegs) {
 void AqlItemBlock::clearRegisters(std::unordered_set<RegisterId> const& toClear) {
   for (size_t i = 0; i < _nrItems; i++) {
     for (auto const& reg : toClear) {
-      AqlValue& a(_data[_nrRegs * i + reg]);
+      AqlValue& a(_data[getAddress(i, reg)]);
 
       if (a.requiresDestruction()) {
         auto it = _valueCount.find(a);
@@ -391,7 +453,7 @@ SharedAqlItemBlockPtr AqlItemBlock::slice(size_t from, size_t to) const {
 
   for (size_t row = from; row < to; row++) {
     for (RegisterId col = 0; col < _nrRegs; col++) {
-      AqlValue const& a(_data[row * _nrRegs + col]);
+      AqlValue const& a(_data[getAddress(row, col)]);
 
       if (!a.isEmpty()) {
         if (a.requiresDestruction()) {
@@ -435,7 +497,7 @@ SharedAqlItemBlockPtr AqlItemBlock::slice(size_t row,
       continue;
     }
 
-    AqlValue const& a(_data[row * _nrRegs + col]);
+    AqlValue const& a(_data[getAddress(row, col)]);
 
     if (!a.isEmpty()) {
       if (a.requiresDestruction()) {
@@ -475,7 +537,7 @@ SharedAqlItemBlockPtr AqlItemBlock::slice(std::vector<size_t> const& chosen,
 
   for (size_t row = from; row < to; row++) {
     for (RegisterId col = 0; col < _nrRegs; col++) {
-      AqlValue const& a(_data[chosen[row] * _nrRegs + col]);
+      AqlValue const& a(_data[getAddress(chosen[row], col)]);
 
       if (!a.isEmpty()) {
         if (a.requiresDestruction()) {
@@ -517,7 +579,7 @@ SharedAqlItemBlockPtr AqlItemBlock::steal(std::vector<size_t> const& chosen,
 
   for (size_t row = from; row < to; row++) {
     for (RegisterId col = 0; col < _nrRegs; col++) {
-      AqlValue& a(_data[chosen[row] * _nrRegs + col]);
+      AqlValue& a(_data[getAddress(chosen[row], col)]);
 
       if (!a.isEmpty()) {
         steal(a);
@@ -567,7 +629,8 @@ SharedAqlItemBlockPtr AqlItemBlock::steal(std::vector<size_t> const& chosen,
 ///                  corresponding position
 ///  "raw":     List of actual values, positions 0 and 1 are always null
 ///                  such that actual indices start at 2
-void AqlItemBlock::toVelocyPack(transaction::Methods* trx, VPackBuilder& result) const {
+void AqlItemBlock::toVelocyPack(transaction::Methods* trx, VPackBuilder& result,
+                                bool allowCompression) const {
   VPackOptions options(VPackOptions::Defaults);
   options.buildUnindexedArrays = true;
   options.buildUnindexedObjects = true;
@@ -584,6 +647,13 @@ void AqlItemBlock::toVelocyPack(transaction::Methods* trx, VPackBuilder& result)
   // Backwards compatbility 3.3
   result.add("exhausted", VPackValue(false));
 
+  // when compressing, "data" and "raw" are assembled separately first
+  VPackBuilder payload;
+  VPackBuilder& out = allowCompression ? payload : result;
+  if (allowCompression) {
+    payload.openObject();
+  }
+
   enum State {
     Empty,       // saw an empty value
     Range,       // saw a range value
@@ -599,7 +669,7 @@ void AqlItemBlock::toVelocyPack(transaction::Methods* trx, VPackBuilder& result)
   size_t runLength = 0;
   size_t tablePos = 0;
 
-  result.add("data", VPackValue(VPackValueType::Array));
+  out.add("data", VPackValue(VPackValueType::Array));
 
   // write out data buffered for repeated "empty" or "next" values
   auto writeBuffered = [](State lastState, size_t lastTablePos,
@@ -634,7 +704,7 @@ void AqlItemBlock::toVelocyPack(transaction::Methods* trx, VPackBuilder& result)
   size_t pos = 2;  // write position in raw
   for (RegisterId column = 0; column < _nrRegs; column++) {
     for (size_t i = 0; i < _nrItems; i++) {
-      AqlValue const& a(_data[i * _nrRegs + column]);
+      AqlValue const& a(_data[getAddress(i, column)]);
 
       // determine current state
       if (a.isEmpty()) {
@@ -662,7 +732,7 @@ void AqlItemBlock::toVelocyPack(transaction::Methods* trx, VPackBuilder& result)
       if (currentState != lastState ||
           (currentState == Positional && tablePos != lastTablePos)) {
         // write out remaining buffered data in case of a state change
-        writeBuffered(lastState, lastTablePos, result, runLength);
+        writeBuffered(lastState, lastTablePos, out, runLength);
 
         lastTablePos = 0;
         lastState = currentState;
@@ -678,21 +748,26 @@ void AqlItemBlock::toVelocyPack(transaction::Methods* trx, VPackBuilder& result)
           break;
 
         case Range:
-          result.add(VPackValue(-2));
-          result.add(VPackValue(a.range()->_low));
-          result.add(VPackValue(a.range()->_high));
+          out.add(VPackValue(-2));
+          out.add(VPackValue(a.range()._low));
+          out.add(VPackValue(a.range()._high));
           break;
       }
     }
   }
 
   // write out any remaining buffered data
-  writeBuffered(lastState, lastTablePos, result, runLength);
+  writeBuffered(lastState, lastTablePos, out, runLength);
 
-  result.close();  // closes "data"
+  out.close();  // closes "data"
 
   raw.close();
-  result.add("raw", raw.slice());
+  out.add("raw", raw.slice());
+
+  if (allowCompression) {
+    payload.close();
+    addPayload(payload.slice(), result);
+  }
 }
 
 ResourceMonitor& AqlItemBlock::resourceMonitor() noexcept {
@@ -94,26 +94,35 @@ class AqlItemBlock {
     resourceMonitor().decreaseMemoryUsage(value);
   }
 
+  /// @brief position of the value for (row, register) in _data. this is the
+  /// only place that knows about the (row-major) layout of the block, so all
+  /// accesses to _data must go through it
+  inline size_t getAddress(size_t index, RegisterId varNr) const noexcept {
+    TRI_ASSERT(index < _nrItems);
+    TRI_ASSERT(varNr < _nrRegs);
+    return index * _nrRegs + varNr;
+  }
+
  public:
   /// @brief getValue, get the value of a register
   inline AqlValue getValue(size_t index, RegisterId varNr) const {
     TRI_ASSERT(index < _nrItems);
     TRI_ASSERT(varNr < _nrRegs);
-    return _data[index * _nrRegs + varNr];
+    return _data[getAddress(index, varNr)];
   }
 
   /// @brief getValue, get the value of a register by reference
   inline AqlValue const& getValueReference(size_t index, RegisterId varNr) const {
     TRI_ASSERT(index < _nrItems);
     TRI_ASSERT(varNr < _nrRegs);
-    return _data[index * _nrRegs + varNr];
+    return _data[getAddress(index, varNr)];
   }
 
   /// @brief setValue, set the current value of a register
   inline void setValue(size_t index, RegisterId varNr, AqlValue const& value) {
     TRI_ASSERT(index < _nrItems);
     TRI_ASSERT(varNr < _nrRegs);
-    TRI_ASSERT(_data[index * _nrRegs + varNr].isEmpty());
+    TRI_ASSERT(_data[getAddress(index, varNr)].isEmpty());
 
     // First update the reference count, if this fails, the value is empty
     if (value.requiresDestruction()) {
@@ -123,7 +132,7 @@ class AqlItemBlock {
       }
     }
 
-    _data[index * _nrRegs + varNr] = value;
+    _data[getAddress(index, varNr)] = value;
   }
 
   /// @brief emplaceValue, set the current value of a register, constructing
@@ -135,7 +144,7 @@ class AqlItemBlock {
     TRI_ASSERT(index < _nrItems);
     TRI_ASSERT(varNr < _nrRegs);
 
-    AqlValue* p = &_data[index * _nrRegs + varNr];
+    AqlValue* p = &_data[getAddress(index, varNr)];
     TRI_ASSERT(p->isEmpty());
     // construct the AqlValue in place
     AqlValue* value;
@@ -143,7 +152,7 @@ class AqlItemBlock {
       value = new (p) AqlValue(std::forward<Args>(args)...);
     } catch (...) {
       // clean up the cell
-      _data[index * _nrRegs + varNr].erase();
+      _data[getAddress(index, varNr)].erase();
       throw;
     }
 
@@ -159,7 +168,7 @@ class AqlItemBlock {
       value->~AqlValue();
       // TODO - instead of disabling it completly we could you use
       // a constexpr if() with c++17
-      _data[index * _nrRegs + varNr].destroy();
+      _data[getAddress(index, varNr)].destroy();
       throw;
     }
   }
@@ -169,7 +178,7 @@ class AqlItemBlock {
   /// use with caution only in special situations when it can be ensured that
   /// no one else will be pointing to the same value
   void destroyValue(size_t index, RegisterId varNr) {
-    auto& element = _data[index * _nrRegs + varNr];
+    auto& element = _data[getAddress(index, varNr)];
 
     if (element.requiresDestruction()) {
       auto it = _valueCount.find(element);
@@ -190,7 +199,7 @@ class AqlItemBlock {
   /// @brief eraseValue, erase the current value of a register not freeing it
   /// this is used if the value is stolen and later released from elsewhere
   void eraseValue(size_t index, RegisterId varNr) {
-    auto& element = _data[index * _nrRegs + varNr];
+    auto& element = _data[getAddress(index, varNr)];
 
     if (element.requiresDestruction()) {
       auto it = _valueCount.find(element);
@@ -245,13 +254,13 @@ class AqlItemBlock {
     TRI_ASSERT(currentRow != fromRow);
 
     for (RegisterId i = 0; i < curRegs; i++) {
-      if (_data[currentRow * _nrRegs + i].isEmpty()) {
+      if (_data[getAddress(currentRow, i)].isEmpty()) {
         // First update the reference count, if this fails, the value is empty
-        if (_data[fromRow * _nrRegs + i].requiresDestruction()) {
-          ++_valueCount[_data[fromRow * _nrRegs + i]];
+        if (_data[getAddress(fromRow, i)].requiresDestruction()) {
+          ++_valueCount[_data[getAddress(fromRow, i)]];
         }
-        TRI_ASSERT(_data[currentRow * _nrRegs + i].isEmpty());
-        _data[currentRow * _nrRegs + i] = _data[fromRow * _nrRegs + i];
+        TRI_ASSERT(_data[getAddress(currentRow, i)].isEmpty());
+        _data[getAddress(currentRow, i)] = _data[getAddress(fromRow, i)];
       }
     }
   }
@@ -268,7 +277,7 @@ class AqlItemBlock {
         if (getValueReference(fromRow, reg).requiresDestruction()) {
           ++_valueCount[getValueReference(fromRow, reg)];
         }
-        _data[currentRow * _nrRegs + reg] = getValueReference(fromRow, reg);
+        _data[getAddress(currentRow, reg)] = getValueReference(fromRow, reg);
       }
     }
   }
@@ -346,8 +355,15 @@ class AqlItemBlock {
   SharedAqlItemBlockPtr steal(std::vector<size_t> const& chosen, size_t from, size_t to);
 
   /// @brief toJson, transfer a whole AqlItemBlock to Json, the result can
-  /// be used to recreate the AqlItemBlock via the Json constructor
-  void toVelocyPack(transaction::Methods* trx, arangodb::velocypack::Builder&) const;
+  /// be used to recreate the AqlItemBlock via the Json constructor.
+  /// if allowCompression is set, the "data" and "raw" attributes of large
+  /// blocks are replaced by a single LZ4-compressed "compressed" attribute
+  void toVelocyPack(transaction::Methods* trx, arangodb::velocypack::Builder&,
+                    bool allowCompression = false) const;
+
+  /// @brief minimum size of the serialized block payload for which
+  /// compression is attempted
+  static constexpr size_t compressionThreshold = 16 * 1024;
 
  protected:
   AqlItemBlockManager& aqlItemBlockManager() noexcept { return _manager; }
@@ -117,6 +117,17 @@ class AqlItemMatrix {
     return InputAqlItemRow{block, index.second};
   }
 
+  /**
+   * @brief Get the value of a register in the row at the given index,
+   *        without creating an InputAqlItemRow (and thus without touching
+   *        the reference count of the block). Intended for hot loops such
+   *        as the comparison function of a sort.
+   */
+  inline AqlValue const& getValueReference(RowIndex index, RegisterId reg) const noexcept {
+    TRI_ASSERT(index.first < numberOfBlocks());
+    return _blocks[index.first]->getValueReference(index.second, reg);
+  }
+
   inline size_t numberOfBlocks() const noexcept { return _blocks.size(); }
 
   inline SharedAqlItemBlockPtr getBlock(size_t index) const noexcept {
@@ -194,7 +194,7 @@ size_t AqlValue::length() const {
       return docvecSize();
     }
     case RANGE: {
-      return range()->size();
+      return range().size();
     }
   }
   TRI_ASSERT(false);
@@ -259,7 +259,8 @@ AqlValue AqlValue::at(int64_t position, bool& mustDestroy, bool doCopy) const {
       break;
     }
     case RANGE: {
-      size_t const n = range()->size();
+      Range const r = range();
+      size_t const n = r.size();
       if (position < 0) {
         // a negative position is allowed
         position = static_cast<int64_t>(n) + position;
@@ -267,7 +268,7 @@ AqlValue AqlValue::at(int64_t position, bool& mustDestroy, bool doCopy) const {
 
       if (position >= 0 && position < static_cast<int64_t>(n)) {
         // only look up the value if it is within array bounds
-        return AqlValue(AqlValueHintInt(_data.range->at(static_cast<size_t>(position))));
+        return AqlValue(AqlValueHintInt(r.at(static_cast<size_t>(position))));
       }
       // intentionally falls through
       break;
@@ -341,7 +342,7 @@ AqlValue AqlValue::at(int64_t position, size_t n, bool& mustDestroy, bool doCopy
 
       if (position >= 0 && position < static_cast<int64_t>(n)) {
         // only look up the value if it is within array bounds
-        return AqlValue(AqlValueHintInt(_data.range->at(static_cast<size_t>(position))));
+        return AqlValue(AqlValueHintInt(range().at(static_cast<size_t>(position))));
       }
       // intentionally falls through
       break;
@@ -874,12 +875,13 @@ v8::Handle<v8::Value> AqlValue::toV8(v8::Isolate* isolate, transaction::Methods*
       return result;
     }
     case RANGE: {
-      size_t const n = _data.range->size();
+      Range const r = range();
+      size_t const n = r.size();
       v8::Handle<v8::Array> result = v8::Array::New(isolate, static_cast<int>(n));
 
       for (uint32_t i = 0; i < n; ++i) {
         // is it safe to use a double here (precision loss)?
-        result->Set(i, v8::Number::New(isolate, static_cast<double>(_data.range->at(
+        result->Set(i, v8::Number::New(isolate, static_cast<double>(r.at(
                                                     static_cast<size_t>(i)))));
 
         if (i % 1000 == 0) {
@@ -933,9 +935,10 @@ void AqlValue::toVelocyPack(transaction::Methods* trx, arangodb::velocypack::Bui
     }
     case RANGE: {
       builder.openArray();
-      size_t const n = _data.range->size();
+      Range const r = range();
+      size_t const n = r.size();
       for (size_t i = 0; i < n; ++i) {
-        builder.add(VPackValue(_data.range->at(i)));
+        builder.add(VPackValue(r.at(i)));
       }
       builder.close();
       break;
@@ -1003,7 +1006,8 @@ AqlValue AqlValue::clone() const {
     }
     case RANGE: {
       // create a new value with a new range
-      return AqlValue(range()->_low, range()->_high);
+      Range const r = range();
+      return AqlValue(r._low, r._high);
     }
   }
 
@@ -1033,7 +1037,9 @@ void AqlValue::destroy() noexcept {
       break;
     }
     case RANGE: {
-      delete _data.range;
+      if (!isInlineRange()) {
+        delete _data.range;
+      }
       break;
     }
   }
@@ -1224,16 +1230,18 @@ int AqlValue::Compare(transaction::Methods* trx, AqlValue const& left,
       return (lblock < lsize ? -1 : 1);
     }
     case RANGE: {
-      if (left.range()->_low < right.range()->_low) {
+      Range const l = left.range();
+      Range const r = right.range();
+      if (l._low < r._low) {
         return -1;
       }
-      if (left.range()->_low > right.range()->_low) {
+      if (l._low > r._low) {
         return 1;
       }
-      if (left.range()->_high < right.range()->_high) {
+      if (l._high < r._high) {
         return -1;
       }
-      if (left.range()->_high > right.range()->_high) {
+      if (l._high > r._high) {
         return 1;
       }
       return 0;
@@ -155,7 +155,8 @@ struct AqlValue final {
                            // slice
     VPACK_MANAGED_BUFFER,  // contains vpack, via pointer to a managed buffer
     DOCVEC,  // a vector of blocks of results coming from a subquery, managed
-    RANGE    // a pointer to a range remembering lower and upper bound, managed
+    RANGE    // a range remembering lower and upper bound, either inline or
+             // via a managed pointer
   };
 
   /// @brief Holds the actual data for this AqlValue
@@ -176,7 +177,10 @@ struct AqlValue final {
   /// by the AqlValue.
   /// DOCVEC: a managed vector of AqlItemBlocks, for storing subquery results.
   /// The vector and ItemBlocks are managed by the AqlValue
-  /// RANGE: a managed range object. The memory is managed by the AqlValue
+  /// RANGE: a range. If both bounds fit into 32 bits, they are stored inline
+  /// (_data.internal[14] == 1) and there is no need for memory management.
+  /// Otherwise this is a managed range object, and the memory is managed by
+  /// the AqlValue
  private:
   union {
     uint64_t words[2];
@@ -412,7 +416,15 @@ struct AqlValue final {
 
   // construct range type
   AqlValue(int64_t low, int64_t high) {
-    _data.range = new Range(low, high);
+    if (low >= INT32_MIN && low <= INT32_MAX && high >= INT32_MIN && high <= INT32_MAX) {
+      // the common case: store both bounds inline
+      int32_t const bounds[2] = {static_cast<int32_t>(low), static_cast<int32_t>(high)};
+      memcpy(_data.internal, &bounds[0], sizeof(bounds));
+      _data.internal[sizeof(_data.internal) - 2] = 1;
+    } else {
+      _data.range = new Range(low, high);
+      _data.internal[sizeof(_data.internal) - 2] = 0;
+    }
     setType(AqlValueType::RANGE);
   }
 
@@ -429,7 +441,7 @@ struct AqlValue final {
   /// @brief whether or not the value must be destroyed
   inline bool requiresDestruction() const noexcept {
     auto t = type();
-    return (t != VPACK_SLICE_POINTER && t != VPACK_INLINE);
+    return (t != VPACK_SLICE_POINTER && t != VPACK_INLINE && !isInlineRange());
   }
 
   /// @brief whether or not the value is empty / none
@@ -451,6 +463,11 @@ struct AqlValue final {
   /// @brief whether or not the value is a range
   inline bool isRange() const noexcept { return type() == RANGE; }
 
+  /// @brief whether or not the value is a range with inline bounds
+  inline bool isInlineRange() const noexcept {
+    return isRange() && (_data.internal[sizeof(_data.internal) - 2] == 1);
+  }
+
   /// @brief whether or not the value is a docvec
   inline bool isDocvec() const noexcept { return type() == DOCVEC; }
 
@@ -519,9 +536,14 @@ struct AqlValue final {
   bool toBoolean() const;
 
   /// @brief return the range value
-  Range const* range() const {
+  Range range() const {
     TRI_ASSERT(isRange());
-    return _data.range;
+    if (isInlineRange()) {
+      int32_t bounds[2];
+      memcpy(&bounds[0], _data.internal, sizeof(bounds));
+      return Range(bounds[0], bounds[1]);
+    }
+    return *_data.range;
   }
 
   /// @brief return the total size of the docvecs
@@ -581,7 +603,7 @@ struct AqlValue final {
         // and AqlItemBlock::setValue)
         return sizeofDocvec();
       case RANGE:
-        return sizeof(Range);
+        return isInlineRange() ? 0 : sizeof(Range);
     }
     return 0;
   }
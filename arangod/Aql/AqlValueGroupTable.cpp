@@ -0,0 +1,182 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "AqlValueGroupTable.h"
+
+#include "Aql/ResourceUsage.h"
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace {
+/// @brief initial number of slots, allocated on the first insert
+constexpr size_t initialSlots = 64;
+}  // namespace
+
+constexpr size_t AqlValueGroupTable::notFound;
+
+AqlValueGroupTable::AqlValueGroupTable(transaction::Methods* trx, size_t groupWidth,
+                                       ResourceMonitor* resourceMonitor)
+    : _trx(trx),
+      _resourceMonitor(resourceMonitor),
+      _groupWidth(groupWidth),
+      _memoryUsage(0),
+      _structureMemoryUsage(0),
+      _size(0) {
+  TRI_ASSERT(_groupWidth > 0);
+}
+
+AqlValueGroupTable::~AqlValueGroupTable() {
+  for (auto& it : _values) {
+    it.destroy();
+  }
+  decreaseMemoryUsage(_memoryUsage);
+}
+
+uint64_t AqlValueGroupTable::hash(AqlValue const* values) const {
+  uint64_t hash = 0x12345678;
+
+  for (size_t i = 0; i < _groupWidth; ++i) {
+    // we must use the slow hash function here, because a value may have
+    // different representations in case its an array/object/number
+    // (calls normalizedHash() internally)
+    hash = values[i].hash(_trx, hash);
+  }
+
+  return hash;
+}
+
+size_t AqlValueGroupTable::find(AqlValue const* values, uint64_t hash) const {
+  if (_slots.empty()) {
+    return notFound;
+  }
+
+  size_t const mask = _slots.size() - 1;
+  size_t i = static_cast<size_t>(hash) & mask;
+
+  while (true) {
+    Slot const& slot = _slots[i];
+    if (slot.position == notFound) {
+      return notFound;
+    }
+    if (slot.hash == hash && equal(group(slot.position), values)) {
+      return slot.position;
+    }
+    i = (i + 1) & mask;
+  }
+}
+
+size_t AqlValueGroupTable::insert(AqlValue const* values, uint64_t hash) {
+  TRI_ASSERT(find(values, hash) == notFound);
+
+  size_t valuesMemoryUsage = 0;
+  for (size_t i = 0; i < _groupWidth; ++i) {
+    if (values[i].requiresDestruction()) {
+      valuesMemoryUsage += values[i].memoryUsage();
+    }
+  }
+  increaseMemoryUsage(valuesMemoryUsage);
+
+  try {
+    // keep the load factor at or below 50%, so that probe sequences stay short
+    if ((_size + 1) * 2 > _slots.size()) {
+      grow();
+    }
+
+    // grow() has reserved enough space, so this will not reallocate
+    _values.insert(_values.end(), values, values + _groupWidth);
+  } catch (...) {
+    decreaseMemoryUsage(valuesMemoryUsage);
+    throw;
+  }
+
+  size_t const mask = _slots.size() - 1;
+  size_t i = static_cast<size_t>(hash) & mask;
+  while (_slots[i].position != notFound) {
+    i = (i + 1) & mask;
+  }
+  _slots[i].hash = hash;
+  _slots[i].position = _size;
+
+  return _size++;
+}
+
+bool AqlValueGroupTable::equal(AqlValue const* lhs, AqlValue const* rhs) const {
+  for (size_t i = 0; i < _groupWidth; ++i) {
+    if (AqlValue::Compare(_trx, lhs[i], rhs[i], false) != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void AqlValueGroupTable::increaseMemoryUsage(size_t value) {
+  if (_resourceMonitor != nullptr) {
+    _resourceMonitor->increaseMemoryUsage(value);
+  }
+  _memoryUsage += value;
+}
+
+void AqlValueGroupTable::decreaseMemoryUsage(size_t value) noexcept {
+  if (_resourceMonitor != nullptr) {
+    _resourceMonitor->decreaseMemoryUsage(value);
+  }
+  TRI_ASSERT(_memoryUsage >= value);
+  _memoryUsage -= value;
+}
+
+void AqlValueGroupTable::grow() {
+  size_t const newSize = _slots.empty() ? ::initialSlots : _slots.size() * 2;
+  size_t const structureMemoryUsage =
+      newSize * sizeof(Slot) + (newSize / 2) * _groupWidth * sizeof(AqlValue);
+
+  // both the old and the new slots are in use while growing
+  increaseMemoryUsage(structureMemoryUsage);
+
+  try {
+    rehash(newSize);
+  } catch (...) {
+    decreaseMemoryUsage(structureMemoryUsage);
+    throw;
+  }
+
+  decreaseMemoryUsage(_structureMemoryUsage);
+  _structureMemoryUsage = structureMemoryUsage;
+}
+
+void AqlValueGroupTable::rehash(size_t newSize) {
+  _values.reserve((newSize / 2) * _groupWidth);
+
+  std::vector<Slot> slots(newSize, Slot{0, notFound});
+
+  size_t const mask = newSize - 1;
+  for (auto const& slot : _slots) {
+    if (slot.position == notFound) {
+      continue;
+    }
+    size_t i = static_cast<size_t>(slot.hash) & mask;
+    while (slots[i].position != notFound) {
+      i = (i + 1) & mask;
+    }
+    slots[i] = slot;
+  }
+
+  _slots = std::move(slots);
+}
@@ -0,0 +1,139 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_AQL_AQL_VALUE_GROUP_TABLE_H
+#define ARANGOD_AQL_AQL_VALUE_GROUP_TABLE_H 1
+
+#include "Aql/AqlValue.h"
+#include "Basics/Common.h"
+
+#include <limits>
+
+namespace arangodb {
+namespace transaction {
+class Methods;
+}
+
+namespace aql {
+struct ResourceMonitor;
+
+/// @brief flat open-addressing hash table for groups of AqlValues, as used
+/// by COLLECT and DISTINCT. all groups consist of the same number of values,
+/// which are stored back-to-back in a single vector instead of one
+/// heap-allocated vector per group. groups are identified by their position
+/// (0, 1, 2, ... in insertion order), so callers can keep any per-group payload
+/// in a vector of their own. every slot keeps the full hash of its group, so a
+/// probe only compares values on a hash match, and growing the table never
+/// needs to hash any values again.
+/// the table owns the values of all groups and destroys them when it is
+/// destroyed. values can be handed out by erase()ing them afterwards.
+/// if a ResourceMonitor is given, the memory used by the table and the values
+/// it owns is accounted for in it, so that the query's memory limit applies.
+class AqlValueGroupTable {
+ public:
+  static constexpr size_t notFound = std::numeric_limits<size_t>::max();
+
+  AqlValueGroupTable(transaction::Methods* trx, size_t groupWidth,
+                     ResourceMonitor* resourceMonitor = nullptr);
+  ~AqlValueGroupTable();
+
+  AqlValueGroupTable(AqlValueGroupTable const&) = delete;
+  AqlValueGroupTable& operator=(AqlValueGroupTable const&) = delete;
+
+  /// @brief hash a group of groupWidth() values
+  uint64_t hash(AqlValue const* values) const;
+
+  /// @brief look up a group by its values and their hash, as computed by
+  /// hash(). returns the position of the group or notFound
+  size_t find(AqlValue const* values, uint64_t hash) const;
+
+  /// @brief append a new group, which must not yet be contained in the table.
+  /// returns the position of the new group. if and only if this does not
+  /// throw, the table has taken over the ownership of the values
+  size_t insert(AqlValue const* values, uint64_t hash);
+
+  /// @brief the values of the group at the given position
+  AqlValue* group(size_t position) noexcept {
+    TRI_ASSERT(position < _size);
+    return _values.data() + position * _groupWidth;
+  }
+
+  AqlValue const* group(size_t position) const noexcept {
+    TRI_ASSERT(position < _size);
+    return _values.data() + position * _groupWidth;
+  }
+
+  /// @brief number of groups in the table
+  size_t size() const noexcept { return _size; }
+
+  /// @brief number of values per group
+  size_t groupWidth() const noexcept { return _groupWidth; }
+
+  /// @brief memory used by the table and the values of all groups, as
+  /// reported to the ResourceMonitor
+  size_t memoryUsage() const noexcept { return _memoryUsage; }
+
+ private:
+  struct Slot {
+    uint64_t hash;
+    size_t position;
+  };
+
+  bool equal(AqlValue const* lhs, AqlValue const* rhs) const;
+
+  /// @brief account for memory, throws if this exceeds the memory limit
+  void increaseMemoryUsage(size_t value);
+
+  void decreaseMemoryUsage(size_t value) noexcept;
+
+  /// @brief double the number of slots
+  void grow();
+
+  /// @brief move all slots into a new slot vector of the given size
+  void rehash(size_t newSize);
+
+ private:
+  transaction::Methods* _trx;
+
+  ResourceMonitor* _resourceMonitor;
+
+  size_t const _groupWidth;
+
+  /// @brief total memory accounted for
+  size_t _memoryUsage;
+
+  /// @brief memory accounted for _values and _slots
+  size_t _structureMemoryUsage;
+
+  /// @brief number of groups
+  size_t _size;
+
+  /// @brief values of all groups, _groupWidth values per group
+  std::vector<AqlValue> _values;
+
+  /// @brief hash slots, the number of slots is always a power of two.
+  /// unused slots have a position of notFound
+  std::vector<Slot> _slots;
+};
+
+}  // namespace aql
+}  // namespace arangodb
+
+#endif
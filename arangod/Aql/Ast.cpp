@@ -3757,12 +3757,8 @@ std::pair<std::string, bool> Ast::normalizeFunctionName(char const* name, size_t
 AstNode* Ast::createNode(AstNodeType type) {
   TRI_ASSERT(_query != nullptr);
 
-  auto node = new AstNode(type);
-
-  // register the node so it gets freed automatically later
-  _query->addNode(node);
-
-  return node;
+  // the node is freed automatically when the query is destroyed
+  return _query->createNode(type);
 }
 
 /// @brief validate the name of the given datasource
@@ -303,8 +303,9 @@ class GatherNode final : public ExecutionNode {
   /// @brief clone ExecutionNode recursively
   ExecutionNode* clone(ExecutionPlan* plan, bool withDependencies,
                        bool withProperties) const override final {
-    return cloneHelper(std::make_unique<GatherNode>(plan, _id, _sortmode),
-                       withDependencies, withProperties);
+    auto c = std::make_unique<GatherNode>(plan, _id, _sortmode);
+    c->limit(_limit);
+    return cloneHelper(std::move(c), withDependencies, withProperties);
   }
 
   /// @brief creates corresponding ExecutionBlock
@@ -331,6 +332,11 @@ class GatherNode final : public ExecutionNode {
   SortMode sortMode() const noexcept { return _sortmode; }
   void sortMode(SortMode sortMode) noexcept { _sortmode = sortMode; }
 
+  /// @brief the number of rows the query needs from this node at most,
+  /// 0 if unknown
+  size_t limit() const noexcept { return _limit; }
+  void limit(size_t limit) noexcept { _limit = limit; }
+
  private:
   /// @brief sort elements, variable, ascending flags and possible attribute
   /// paths.
@@ -338,6 +344,9 @@ class GatherNode final : public ExecutionNode {
 
   /// @brief sorting mode
   SortMode _sortmode;
+
+  /// @brief number of rows needed at most, 0 if unknown
+  size_t _limit;
 };
 
 /// @brief class RemoteNode
@@ -279,7 +279,8 @@ std::unique_ptr<ExecutionBlock> CollectNode::createBlock(
           getRegisterPlan()->nrRegs[getDepth()], getRegsToClear(), calcRegsToKeep(),
           std::move(readableInputRegisters), std::move(writeableOutputRegisters),
           std::move(groupRegisters), collectRegister, std::move(aggregateTypes),
-          std::move(aggregateRegisters), trxPtr, _count);
+          std::move(aggregateRegisters), trxPtr, _count,
+          engine.getQuery()->resourceMonitor());
 
       return std::make_unique<ExecutionBlockImpl<HashedCollectExecutor>>(&engine, this,
                                                                          std::move(infos));
@@ -367,7 +368,8 @@ std::unique_ptr<ExecutionBlock> CollectNode::createBlock(
                                          getRegsToClear(), calcRegsToKeep(),
                                          std::move(readableInputRegisters),
                                          std::move(writeableOutputRegisters),
-                                         std::move(groupRegisters), trxPtr);
+                                         std::move(groupRegisters), trxPtr,
+                                         engine.getQuery()->resourceMonitor());
 
       return std::make_unique<ExecutionBlockImpl<DistinctCollectExecutor>>(&engine, this,
                                                                            std::move(infos));
@@ -446,6 +448,7 @@ struct UserVarFinder final : public WalkerWorker<ExecutionNode> {
     if (en->getType() == ExecutionNode::SINGLETON) {
       depth = 0;
     } else if (en->getType() == ExecutionNode::ENUMERATE_COLLECTION ||
+               en->getType() == ExecutionNode::HASH_JOIN ||
                en->getType() == ExecutionNode::INDEX ||
                en->getType() == ExecutionNode::ENUMERATE_LIST ||
                en->getType() == ExecutionNode::TRAVERSAL ||
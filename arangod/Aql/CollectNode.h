@@ -185,12 +185,18 @@ class CollectNode : public ExecutionNode {
     return _expressionVariable != nullptr;
   }
 
+  /// @brief return the expression variable
+  Variable const* expressionVariable() const { return _expressionVariable; }
+
   /// @brief set the expression variable
   void expressionVariable(Variable const* variable) {
     TRI_ASSERT(!hasExpressionVariable());
     _expressionVariable = variable;
   }
 
+  /// @brief clear the expression variable
+  void clearExpressionVariable() { _expressionVariable = nullptr; }
+
   /// @brief return whether or not the collect has keep variables
   bool hasKeepVariables() const { return !_keepVariables.empty(); }
 
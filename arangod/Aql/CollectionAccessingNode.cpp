@@ -70,6 +70,14 @@ CollectionAccessingNode::CollectionAccessingNode(ExecutionPlan* plan,
   if (restrictedTo.isString()) {
     _restrictedTo = restrictedTo.copyString();
   }
+
+  VPackSlice restrictedToShards = slice.get("restrictedToShards");
+
+  if (restrictedToShards.isArray()) {
+    for (VPackSlice shard : VPackArrayIterator(restrictedToShards)) {
+      _restrictedToShards.emplace(shard.copyString());
+    }
+  }
 }
 
 TRI_vocbase_t* CollectionAccessingNode::vocbase() const {
@@ -98,6 +106,14 @@ void CollectionAccessingNode::toVelocyPack(arangodb::velocypack::Builder& builde
   if (!_restrictedTo.empty()) {
     builder.add("restrictedTo", VPackValue(_restrictedTo));
   }
+
+  if (!_restrictedToShards.empty()) {
+    builder.add("restrictedToShards", VPackValue(VPackValueType::Array));
+    for (auto const& shard : _restrictedToShards) {
+      builder.add(VPackValue(shard));
+    }
+    builder.close();
+  }
 }
 
 void CollectionAccessingNode::toVelocyPackHelperPrimaryIndex(arangodb::velocypack::Builder& builder) const {
@@ -29,6 +29,8 @@
 #include <velocypack/Builder.h>
 #include <velocypack/Slice.h>
 
+#include <unordered_set>
+
 struct TRI_vocbase_t;
 
 namespace arangodb {
@@ -79,6 +81,18 @@ class CollectionAccessingNode {
    */
   std::string const& restrictedShard() const { return _restrictedTo; }
 
+  /// @brief restrict this node to a subset of the collection's shards
+  /// (cluster only). a restriction to a single shard takes precedence
+  void restrictToShards(std::unordered_set<std::string> shardIds) {
+    _restrictedToShards = std::move(shardIds);
+  }
+
+  /// @brief the shards this node is restricted to, empty if there is no
+  /// such restriction
+  std::unordered_set<std::string> const& restrictedShards() const {
+    return _restrictedToShards;
+  }
+
   /// @brief set the prototype collection when using distributeShardsLike
   void setPrototype(arangodb::aql::Collection const* prototypeCollection, 
                     arangodb::aql::Variable const* prototypeOutVariable) {
@@ -94,6 +108,9 @@ class CollectionAccessingNode {
 
   /// @brief A shard this node is restricted to, may be empty
   std::string _restrictedTo;
+
+  /// @brief shards this node is restricted to, may be empty
+  std::unordered_set<std::string> _restrictedToShards;
   
   /// @brief prototype collection when using distributeShardsLike
   aql::Collection const* _prototypeCollection;
@@ -22,14 +22,119 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "ConditionFinder.h"
+#include "Aql/Ast.h"
+#include "Aql/Collection.h"
 #include "Aql/ExecutionPlan.h"
 #include "Aql/IndexNode.h"
+#include "Aql/Query.h"
 #include "Aql/SortCondition.h"
 #include "Aql/SortNode.h"
+#include "Basics/AttributeNameParser.h"
+#include "Indexes/Index.h"
+#include "Transaction/Methods.h"
 
 using namespace arangodb::aql;
 using EN = arangodb::aql::ExecutionNode;
 
+namespace {
+/// @brief maximum number of document ids the executor collects from the
+/// second index of an intersection
+constexpr size_t maxIntersectionSize = 256 * 1024;
+
+/// @brief whether all comparisons of a specialized index condition compare
+/// against constant values, so the index can be looked up once per query
+bool isConstantIndexCondition(AstNode const* andNode) {
+  if (andNode == nullptr || andNode->numMembers() == 0) {
+    return false;
+  }
+  for (size_t i = 0; i < andNode->numMembers(); ++i) {
+    AstNode const* leaf = andNode->getMemberUnchecked(i);
+    if (!leaf->isComparisonOperator() || leaf->numMembers() != 2) {
+      return false;
+    }
+    if (!leaf->getMemberUnchecked(0)->isConstant() &&
+        !leaf->getMemberUnchecked(1)->isConstant()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// @brief looks for a second index on attributes the used index does not
+/// cover, whose (much smaller) result can be intersected with the results
+/// of the used index. returns the specialized condition for the second
+/// index, or nullptr if intersecting does not pay off
+AstNode* findIntersectionIndex(Ast* ast, EnumerateCollectionNode const* node,
+                               AstNode const* andNode,
+                               arangodb::transaction::Methods::IndexHandle const& used,
+                               arangodb::transaction::Methods::IndexHandle& result) {
+  auto trx = ast->query()->trx();
+  Variable const* reference = node->outVariable();
+  size_t const itemsInCollection = node->collection()->count(trx);
+  if (itemsInCollection == 0) {
+    return nullptr;
+  }
+
+  auto usedIndex = used.getIndex();
+  auto indexes = trx->indexesForCollection(node->collection()->name());
+
+  // costs of the used index, with the full AND condition
+  auto usedCosts = usedIndex->supportsFilterCondition(indexes, andNode, reference,
+                                                      itemsInCollection);
+  if (!usedCosts.supportsCondition) {
+    return nullptr;
+  }
+
+  std::shared_ptr<arangodb::Index> best;
+  size_t bestItems = 0;
+  for (auto const& idx : indexes) {
+    if (idx == usedIndex || idx->fields().empty()) {
+      continue;
+    }
+    // the second index must filter on something the used index does not
+    bool covered = false;
+    for (auto const& field : usedIndex->fields()) {
+      if (arangodb::basics::AttributeName::isIdentical(field, idx->fields()[0], false)) {
+        covered = true;
+        break;
+      }
+    }
+    if (covered) {
+      continue;
+    }
+    auto costs = idx->supportsFilterCondition(indexes, andNode, reference, itemsInCollection);
+    if (!costs.supportsCondition || costs.estimatedItems > maxIntersectionSize) {
+      continue;
+    }
+    if (best == nullptr || costs.estimatedItems < bestItems) {
+      best = idx;
+      bestItems = costs.estimatedItems;
+    }
+  }
+
+  if (best == nullptr) {
+    return nullptr;
+  }
+
+  // collecting the ids of the second index costs bestItems lookups, and
+  // saves fetching all documents of the used index that are not among them
+  double const saved = static_cast<double>(usedCosts.estimatedItems) *
+                       (1.0 - static_cast<double>(bestItems) /
+                                  static_cast<double>(itemsInCollection));
+  if (saved <= static_cast<double>(bestItems)) {
+    return nullptr;
+  }
+
+  AstNode* specialized = best->specializeCondition(andNode->clone(ast), reference);
+  if (!isConstantIndexCondition(specialized)) {
+    return nullptr;
+  }
+
+  result = arangodb::transaction::Methods::IndexHandle(best);
+  return specialized;
+}
+}  // namespace
+
 bool ConditionFinder::before(ExecutionNode* en) {
   switch (en->getType()) {
     case EN::ENUMERATE_LIST:
@@ -120,6 +225,14 @@ bool ConditionFinder::before(ExecutionNode* en) {
         break;
       }
 
+      // findIndexes specializes the condition in place, keep the full
+      // condition of a single AND around for a possible intersection
+      AstNode* fullAndNode = nullptr;
+      if (condition->root() != nullptr && condition->root()->numMembers() == 1 &&
+          node->hint().type() == IndexHint::None) {
+        fullAndNode = condition->root()->getMemberUnchecked(0)->clone(_plan->getAst());
+      }
+
       std::vector<transaction::Methods::IndexHandle> usedIndexes;
       auto canUseIndex = condition->findIndexes(node, usedIndexes, sortCondition.get());
 
@@ -143,9 +256,19 @@ bool ConditionFinder::before(ExecutionNode* en) {
         // will clear out usedIndexes
         IndexIteratorOptions opts;
         opts.ascending = !descending;
-        std::unique_ptr<ExecutionNode> newNode(
+        std::unique_ptr<IndexNode> newNode(
             new IndexNode(_plan, _plan->nextId(), node->collection(),
                           node->outVariable(), usedIndexes, std::move(condition), opts));
+
+        if (fullAndNode != nullptr && canUseIndex.first && usedIndexes.size() == 1) {
+          transaction::Methods::IndexHandle intersectionIndex;
+          AstNode* intersectionCondition =
+              ::findIntersectionIndex(_plan->getAst(), node, fullAndNode,
+                                      usedIndexes[0], intersectionIndex);
+          if (intersectionCondition != nullptr) {
+            newNode->setIntersection(intersectionIndex, intersectionCondition);
+          }
+        }
         TRI_IF_FAILURE("ConditionFinder::insertIndexNode") {
           THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
         }
@@ -52,6 +52,7 @@ CountCollectExecutorInfos::CountCollectExecutorInfos(
       _collectRegister(collectRegister) {}
 
 CountCollectExecutor::CountCollectExecutor(Fetcher& fetcher, Infos& infos)
-    : _infos(infos), _fetcher(fetcher), _state(ExecutionState::HASMORE), _count(0){};
+    : _infos(infos), _fetcher(fetcher), _state(ExecutionState::HASMORE), _count(0),
+      _lastRow(CreateInvalidInputRowHint{}){};
 
 CountCollectExecutor::~CountCollectExecutor() = default;
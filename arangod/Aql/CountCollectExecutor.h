@@ -32,6 +32,7 @@
 #include "Aql/ExecutionNode.h"
 #include "Aql/ExecutionState.h"
 #include "Aql/ExecutorInfos.h"
+#include "Aql/InputAqlItemRow.h"
 #include "Aql/LimitStats.h"
 #include "Aql/OutputAqlItemRow.h"
 #include "Aql/types.h"
@@ -104,6 +105,26 @@ class CountCollectExecutor {
     }
 
     while (true) {
+      if (_lastRow.isInitialized() && _lastRow.isLastRowInBlock()) {
+        // the kept registers are the same in all rows, so the row we hold
+        // suffices to write the output. all further rows are only
+        // counted, which lets upstream skip them, e.g. an index only
+        // scans its keys then
+        size_t skipped;
+        std::tie(_state, skipped) = _fetcher.skipRows(ExecutionBlock::DefaultBatchSize());
+        _count += skipped;
+
+        if (_state == ExecutionState::WAITING) {
+          return {_state, stats};
+        }
+        if (_state == ExecutionState::DONE) {
+          output.cloneValueInto(_infos.getOutputRegisterId(), _lastRow,
+                                AqlValue(AqlValueHintUInt(getCount())));
+          return {_state, stats};
+        }
+        continue;
+      }
+
       std::tie(_state, input) = _fetcher.fetchRow();
 
       if (_state == ExecutionState::WAITING) {
@@ -112,13 +133,14 @@ class CountCollectExecutor {
 
       if (!input) {
         TRI_ASSERT(_state == ExecutionState::DONE);
-        output.cloneValueInto(_infos.getOutputRegisterId(), input,
+        output.cloneValueInto(_infos.getOutputRegisterId(), _lastRow,
                               AqlValue(AqlValueHintUInt(getCount())));
         return {_state, stats};
       }
 
       TRI_ASSERT(input.isInitialized());
       incrCount();
+      _lastRow = input;
 
       // Abort if upstream is done
       if (_state == ExecutionState::DONE) {
@@ -147,6 +169,8 @@ class CountCollectExecutor {
   Fetcher& _fetcher;
   ExecutionState _state;
   uint64_t _count;
+  // the last row fetched, the rows after it are skipped
+  InputAqlItemRow _lastRow;
 };
 
 }  // namespace aql
@@ -45,32 +45,25 @@ DistinctCollectExecutorInfos::DistinctCollectExecutorInfos(
     std::unordered_set<RegisterId>&& readableInputRegisters,
     std::unordered_set<RegisterId>&& writeableInputRegisters,
     std::vector<std::pair<RegisterId, RegisterId>>&& groupRegisters,
-    transaction::Methods* trxPtr)
+    transaction::Methods* trxPtr, ResourceMonitor* resourceMonitor)
     : ExecutorInfos(std::make_shared<std::unordered_set<RegisterId>>(readableInputRegisters),
                     std::make_shared<std::unordered_set<RegisterId>>(writeableInputRegisters),
                     nrInputRegisters, nrOutputRegisters,
                     std::move(registersToClear), std::move(registersToKeep)),
       _groupRegisters(groupRegisters),
-      _trxPtr(trxPtr) {
+      _trxPtr(trxPtr),
+      _resourceMonitor(resourceMonitor) {
   TRI_ASSERT(!_groupRegisters.empty());
 }
 
 DistinctCollectExecutor::DistinctCollectExecutor(Fetcher& fetcher, Infos& infos)
     : _infos(infos),
       _fetcher(fetcher),
-      _seen(1024,
-            AqlValueGroupHash(_infos.getTransaction(),
-                              _infos.getGroupRegisters().size()),
-            AqlValueGroupEqual(_infos.getTransaction())) {}
-
-DistinctCollectExecutor::~DistinctCollectExecutor() {
-  // destroy all AqlValues captured
-  for (auto& it : _seen) {
-    for (auto& it2 : it) {
-      const_cast<AqlValue*>(&it2)->destroy();
-    }
-  }
-}
+      _seen(_infos.getTransaction(), _infos.getGroupRegisters().size(),
+            _infos.getResourceMonitor()) {}
+
+// all AqlValues captured are destroyed by _seen
+DistinctCollectExecutor::~DistinctCollectExecutor() = default;
 
 std::pair<ExecutionState, NoStats> DistinctCollectExecutor::produceRows(OutputAqlItemRow& output) {
   TRI_IF_FAILURE("DistinctCollectExecutor::produceRows") {
@@ -104,9 +97,8 @@ std::pair<ExecutionState, NoStats> DistinctCollectExecutor::produceRows(OutputAq
     }
 
     // now check if we already know this group
-    auto foundIt = _seen.find(groupValues);
-
-    bool newGroup = foundIt == _seen.end();
+    uint64_t const hash = _seen.hash(groupValues.data());
+    bool newGroup = _seen.find(groupValues.data(), hash) == AqlValueGroupTable::notFound;
     if (newGroup) {
       size_t i = 0;
 
@@ -118,10 +110,17 @@ std::pair<ExecutionState, NoStats> DistinctCollectExecutor::produceRows(OutputAq
       // transfer ownership
       std::vector<AqlValue> copy;
       copy.reserve(groupValues.size());
-      for (auto const& it : groupValues) {
-        copy.emplace_back(it.clone());
+      try {
+        for (auto const& it : groupValues) {
+          copy.emplace_back(it.clone());
+        }
+        _seen.insert(copy.data(), hash);
+      } catch (...) {
+        for (auto& it : copy) {
+          it.destroy();
+        }
+        throw;
       }
-      _seen.emplace(std::move(copy));
     }
 
     // Abort if upstream is done
@@ -26,7 +26,7 @@
 #ifndef ARANGOD_AQL_DISTINCT_COLLECT_EXECUTOR_H
 #define ARANGOD_AQL_DISTINCT_COLLECT_EXECUTOR_H
 
-#include "Aql/AqlValueGroup.h"
+#include "Aql/AqlValueGroupTable.h"
 #include "Aql/ExecutionBlock.h"
 #include "Aql/ExecutionBlockImpl.h"
 #include "Aql/ExecutionNode.h"
@@ -54,7 +54,8 @@ class DistinctCollectExecutorInfos : public ExecutorInfos {
                                std::unordered_set<RegisterId>&& readableInputRegisters,
                                std::unordered_set<RegisterId>&& writeableInputRegisters,
                                std::vector<std::pair<RegisterId, RegisterId>>&& groupRegisters,
-                               transaction::Methods* trxPtr);
+                               transaction::Methods* trxPtr,
+                               ResourceMonitor* resourceMonitor = nullptr);
 
   DistinctCollectExecutorInfos() = delete;
   DistinctCollectExecutorInfos(DistinctCollectExecutorInfos&&) = default;
@@ -62,10 +63,11 @@ class DistinctCollectExecutorInfos : public ExecutorInfos {
   ~DistinctCollectExecutorInfos() = default;
 
  public:
-  std::vector<std::pair<RegisterId, RegisterId>> getGroupRegisters() const {
+  std::vector<std::pair<RegisterId, RegisterId>> const& getGroupRegisters() const noexcept {
     return _groupRegisters;
   }
   transaction::Methods* getTransaction() const { return _trxPtr; }
+  ResourceMonitor* getResourceMonitor() const { return _resourceMonitor; }
 
  private:
   /// @brief pairs, consisting of out register and in register
@@ -73,6 +75,9 @@ class DistinctCollectExecutorInfos : public ExecutorInfos {
 
   /// @brief the transaction for this query
   transaction::Methods* _trxPtr;
+
+  /// @brief the query's resource monitor, may be a nullptr
+  ResourceMonitor* _resourceMonitor;
 };
 
 /**
@@ -111,7 +116,7 @@ class DistinctCollectExecutor {
  private:
   Infos const& _infos;
   Fetcher& _fetcher;
-  std::unordered_set<std::vector<AqlValue>, AqlValueGroupHash, AqlValueGroupEqual> _seen;
+  AqlValueGroupTable _seen;
 };
 
 }  // namespace aql
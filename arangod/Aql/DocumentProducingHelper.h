@@ -86,10 +86,12 @@ struct DocumentProducingFunctionContext {
                                    transaction::Methods* trxPtr,
                                    std::vector<size_t> const& coveringIndexAttributePositions,
                                    bool allowCoveringIndexOptimization,
-                                   bool useRawDocumentPointers, bool checkUniqueness)
+                                   bool useRawDocumentPointers, bool checkUniqueness,
+                                   RegisterId const docIdRegister = ExecutionNode::MaxRegisterId)
       : _inputRow(inputRow),
         _outputRow(outputRow),
         _outputRegister(outputRegister),
+        _docIdRegister(docIdRegister),
         _produceResult(produceResult),
         _projections(projections),
         _trxPtr(trxPtr),
@@ -99,7 +101,8 @@ struct DocumentProducingFunctionContext {
         _numScanned(0),
         _alreadyReturned(),
         _isLastIndex(false),
-        _checkUniqueness(checkUniqueness) {}
+        _checkUniqueness(checkUniqueness),
+        _intersection(nullptr) {}
 
   DocumentProducingFunctionContext() = delete;
 
@@ -145,7 +148,20 @@ struct DocumentProducingFunctionContext {
 
   RegisterId getOutputRegister() const noexcept { return _outputRegister; }
 
+  /// @brief register to write the LocalDocumentId of each produced document
+  /// into, used for late materialization. MaxRegisterId if not wanted
+  RegisterId getDocIdRegister() const noexcept { return _docIdRegister; }
+
+  bool producesDocId() const noexcept {
+    return _docIdRegister != ExecutionNode::MaxRegisterId;
+  }
+
   bool checkUniqueness(LocalDocumentId const& token) {
+    if (_intersection != nullptr &&
+        _intersection->find(token.id()) == _intersection->end()) {
+      // not found via the intersection index. Skip this
+      return false;
+    }
     if (_checkUniqueness) {
       if (!_isLastIndex) {
         // insert & check for duplicates in one go
@@ -173,10 +189,17 @@ struct DocumentProducingFunctionContext {
 
   void setIsLastIndex(bool val) { _isLastIndex = val; }
 
+  /// @brief only produce documents whose ids are contained in the set.
+  /// the set is owned by the caller
+  void setIntersection(std::unordered_set<TRI_voc_rid_t> const* ids) {
+    _intersection = ids;
+  }
+
  private:
   InputAqlItemRow const& _inputRow;
   OutputAqlItemRow* _outputRow;
   RegisterId const _outputRegister;
+  RegisterId const _docIdRegister;
   bool const _produceResult;
   std::vector<std::string> const& _projections;
   transaction::Methods* const _trxPtr;
@@ -194,6 +217,10 @@ struct DocumentProducingFunctionContext {
 
   /// @brief Flag if we need to check for uniqueness
   bool _checkUniqueness;
+
+  /// @brief ids of the documents to intersect with, nullptr if all
+  /// documents are produced
+  std::unordered_set<TRI_voc_rid_t> const* _intersection;
 };
 
 namespace DocumentProducingCallbackVariant {
@@ -261,6 +288,10 @@ inline DocumentProducingFunction getCallback(DocumentProducingCallbackVariant::W
     AqlValue v(b.get());
     AqlValueGuard guard{v, true};
     TRI_ASSERT(!output.isFull());
+    if (context.producesDocId()) {
+      output.cloneValueInto(context.getDocIdRegister(), input,
+                            AqlValue(AqlValueHintUInt(token.id())));
+    }
     output.moveValueInto(registerId, input, guard);
     TRI_ASSERT(output.produced());
     output.advanceRow();
@@ -290,6 +321,10 @@ inline DocumentProducingFunction getCallback(DocumentProducingCallbackVariant::W
     AqlValue v(b.get());
     AqlValueGuard guard{v, true};
     TRI_ASSERT(!output.isFull());
+    if (context.producesDocId()) {
+      output.cloneValueInto(context.getDocIdRegister(), input,
+                            AqlValue(AqlValueHintUInt(token.id())));
+    }
     output.moveValueInto(registerId, input, guard);
     TRI_ASSERT(output.produced());
     output.advanceRow();
@@ -33,6 +33,8 @@
 #include "Aql/Query.h"
 #include "Aql/QueryRegistry.h"
 #include "Basics/Result.h"
+#include "Basics/ScopeGuard.h"
+#include "Basics/VelocyPackHelper.h"
 #include "Cluster/ClusterComm.h"
 #include "Cluster/ClusterMethods.h"
 #include "Cluster/ClusterTrxMethods.h"
@@ -172,6 +174,10 @@ void EngineInfoContainerDBServer::EngineInfo::addNode(ExecutionNode* node) {
     if (node->isRestricted()) {
       TRI_ASSERT(sourceImpl->restrictedShard.empty());
       sourceImpl->restrictedShard = node->restrictedShard();
+    } else if (!node->restrictedShards().empty()) {
+      TRI_ASSERT(sourceImpl->restrictedShards.empty());
+      sourceImpl->restrictedShards.insert(node->restrictedShards().begin(),
+                                          node->restrictedShards().end());
     }
   };
 
@@ -309,24 +315,13 @@ void EngineInfoContainerDBServer::EngineInfo::serializeSnippet(
   plan.root()->toVelocyPack(infoBuilder, flags, /*keepTopLevelOpen*/ false);
 }
 
-void EngineInfoContainerDBServer::EngineInfo::serializeSnippet(
-    Query& query, const ShardID& id, VPackBuilder& infoBuilder,
-    bool isResponsibleForInitializeCursor) const {
+void EngineInfoContainerDBServer::EngineInfo::shardMapping(
+    ShardID const& id, std::unordered_map<aql::Collection*, ShardID>& mapping) const {
   auto* collection = boost::get<CollectionSource>(&_source);
   TRI_ASSERT(collection);
-  auto& restrictedShard = collection->restrictedShard;
 
-  if (!restrictedShard.empty()) {
-    if (id != restrictedShard) {
-      return;
-    }
-    // We only have one shard it has to be responsible!
-    isResponsibleForInitializeCursor = true;
-  }
-  // The Key is required to build up the queryId mapping later
-  infoBuilder.add(VPackValue(arangodb::basics::StringUtils::itoa(_idOfRemoteNode) + ":" + id));
-
-  TRI_ASSERT(!_nodes.empty());
+  mapping.clear();
+  mapping.emplace(collection->collection, id);
 
   // build up a map of prototypes, e.g. c1 => c2, c2 => c3, c3 => c4,
   // so we can determine a common prototype ancestor in case we have 3- or 4-way joins
@@ -343,6 +338,63 @@ void EngineInfoContainerDBServer::EngineInfo::serializeSnippet(
     }
   }
 
+  for (auto enIt = _nodes.rbegin(), end = _nodes.rend(); enIt != end; ++enIt) {
+    auto const nodeType = (*enIt)->getType();
+    if (nodeType != ExecutionNode::INDEX && nodeType != ExecutionNode::ENUMERATE_COLLECTION) {
+      continue;
+    }
+    auto x = dynamic_cast<CollectionAccessingNode*>(*enIt);
+    auto const* prototype = x->prototypeCollection();
+    // find prototypes of prototypes
+    while (prototype != nullptr) {
+      auto it = prototypes.find(prototype);
+      if (it == prototypes.end()) {
+        break;
+      }
+      prototype = (*it).second;
+    }
+
+    if (prototype != nullptr) {
+      auto s1 = prototype->shardIds();
+      auto s2 = x->collection()->shardIds();
+      if (s1->size() == s2->size()) {
+        for (size_t i = 0; i < s1->size(); ++i) {
+          if ((*s1)[i] == id) {
+            mapping[const_cast<arangodb::aql::Collection*>(x->collection())] = (*s2)[i];
+            break;
+          }
+        }
+      }
+    }
+  }
+}
+
+bool EngineInfoContainerDBServer::EngineInfo::serializeSnippet(
+    Query& query, const ShardID& id, VPackBuilder& infoBuilder,
+    bool isResponsibleForInitializeCursor) const {
+  auto* collection = boost::get<CollectionSource>(&_source);
+  TRI_ASSERT(collection);
+  auto& restrictedShard = collection->restrictedShard;
+
+  if (!restrictedShard.empty()) {
+    if (id != restrictedShard) {
+      return false;
+    }
+    // We only have one shard it has to be responsible!
+    isResponsibleForInitializeCursor = true;
+  } else if (!collection->restrictedShards.empty()) {
+    if (collection->restrictedShards.find(id) == collection->restrictedShards.end()) {
+      return false;
+    }
+    // the shard that is responsible for the collection may not be among
+    // ours, so we pick one of our own
+    isResponsibleForInitializeCursor = (id == *collection->restrictedShards.begin());
+  }
+  // The Key is required to build up the queryId mapping later
+  infoBuilder.add(VPackValue(arangodb::basics::StringUtils::itoa(_idOfRemoteNode) + ":" + id));
+
+  TRI_ASSERT(!_nodes.empty());
+
   // copy the relevant fragment of the plan for each shard
   // Note that in these parts of the query there are no SubqueryNodes,
   // since they are all on the coordinator!
@@ -350,10 +402,19 @@ void EngineInfoContainerDBServer::EngineInfo::serializeSnippet(
   // this clone does the translation collection => shardId implicitly
   // at the relevant parts of the query.
 
-  std::unordered_set<aql::Collection*> cleanup;
-  cleanup.emplace(collection->collection);
+  std::unordered_map<aql::Collection*, ShardID> mapping;
+  shardMapping(id, mapping);
+
+  for (auto const& it : mapping) {
+    it.first->setCurrentShard(it.second);
+  }
 
-  collection->collection->setCurrentShard(id);
+  // remove shard id hack for all participating collections
+  auto cleanup = scopeGuard([&mapping]() {
+    for (auto const& it : mapping) {
+      it.first->resetCurrentShard();
+    }
+  });
 
   ExecutionPlan plan(query.ast());
   ExecutionNode* previous = nullptr;
@@ -366,35 +427,6 @@ void EngineInfoContainerDBServer::EngineInfo::serializeSnippet(
     // we need to count nodes by type ourselves, as we will set the
     // "varUsageComputed" flag below (which will handle the counting)
     plan.increaseCounter(nodeType);
-    
-    if (nodeType == ExecutionNode::INDEX || nodeType == ExecutionNode::ENUMERATE_COLLECTION) {
-      auto x = dynamic_cast<CollectionAccessingNode*>(clone);
-      auto const* prototype = x->prototypeCollection();
-      // find prototypes of prototypes
-      while (prototype != nullptr) {
-        auto it = prototypes.find(prototype);
-        if (it == prototypes.end()) {
-          break;
-        }
-        prototype = (*it).second;
-      }
-
-      if (prototype != nullptr) {
-        auto s1 = prototype->shardIds();
-        auto s2 = x->collection()->shardIds();
-        if (s1->size() == s2->size()) {
-          for (size_t i = 0; i < s1->size(); ++i) {
-            if ((*s1)[i] == id) {
-              // inject shard id into collection
-              auto collection = const_cast<arangodb::aql::Collection*>(x->collection());
-              collection->setCurrentShard((*s2)[i]);
-              cleanup.emplace(collection);
-              break;
-            }
-          }
-        }
-      }
-    }
 
     if (ExecutionNode::REMOTE == nodeType) {
       auto rem = ExecutionNode::castTo<RemoteNode*>(clone);
@@ -418,11 +450,83 @@ void EngineInfoContainerDBServer::EngineInfo::serializeSnippet(
   plan.setVarUsageComputed();
   const unsigned flags = ExecutionNode::SERIALIZE_DETAILS;
   plan.root()->toVelocyPack(infoBuilder, flags, /*keepTopLevelOpen*/ false);
+  return true;
+}
 
-  // remove shard id hack for all participating collections 
-  for (auto& it : cleanup) {
-    it->resetCurrentShard();
+bool EngineInfoContainerDBServer::EngineInfo::serializeSnippetReference(
+    ShardID const& templateShard, ShardID const& id, VPackBuilder& infoBuilder,
+    bool isResponsibleForInitializeCursor) const {
+  auto* collection = boost::get<CollectionSource>(&_source);
+  TRI_ASSERT(collection);
+
+  if (!collection->restrictedShard.empty() || !collection->restrictedShards.empty()) {
+    // at most one snippet anyway, or the snippets differ in responsibility
+    return false;
   }
+
+  std::unordered_map<aql::Collection*, ShardID> templateMapping;
+  shardMapping(templateShard, templateMapping);
+  std::unordered_map<aql::Collection*, ShardID> mapping;
+  shardMapping(id, mapping);
+
+  if (templateMapping.size() != mapping.size()) {
+    return false;
+  }
+  for (auto const& it : templateMapping) {
+    if (mapping.find(it.first) == mapping.end()) {
+      // a collection is translated for one of the shards only
+      return false;
+    }
+  }
+
+  std::string const prefix = arangodb::basics::StringUtils::itoa(_idOfRemoteNode) + ":";
+  infoBuilder.add(VPackValue(prefix + id));
+  infoBuilder.openObject();
+  infoBuilder.add("template", VPackValue(prefix + templateShard));
+  infoBuilder.add(VPackValue("shards"));
+  infoBuilder.openObject();
+  for (auto const& it : templateMapping) {
+    infoBuilder.add(it.second, VPackValue(mapping[it.first]));
+  }
+  infoBuilder.close();  // shards
+  infoBuilder.add("isResponsibleForInitializeCursor",
+                  VPackValue(isResponsibleForInitializeCursor));
+  infoBuilder.close();
+  return true;
+}
+
+void EngineInfoContainerDBServer::instantiateSnippetTemplate(VPackSlice nodes, VPackSlice shards,
+                                                             bool isResponsibleForInitializeCursor,
+                                                             VPackBuilder& builder) {
+  // translates a shard name of the template, all other values are kept
+  auto translate = [&shards](VPackSlice value) -> VPackSlice {
+    if (value.isString()) {
+      VPackSlice shard = shards.get(value.copyString());
+      if (shard.isString()) {
+        return shard;
+      }
+    }
+    return value;
+  };
+
+  builder.openArray();
+  for (auto const& node : VPackArrayIterator(nodes)) {
+    bool const isRemote = node.get("type").isEqualString("RemoteNode");
+    builder.openObject();
+    for (auto const& it : VPackObjectIterator(node, true)) {
+      arangodb::velocypack::StringRef key(it.key);
+      builder.add(it.key);
+      if (key == "collection" || key == "prototype" || (isRemote && key == "ownName")) {
+        builder.add(translate(it.value));
+      } else if (isRemote && key == "isResponsibleForInitializeCursor") {
+        builder.add(VPackValue(isResponsibleForInitializeCursor));
+      } else {
+        builder.add(it.value);
+      }
+    }
+    builder.close();
+  }
+  builder.close();
 }
 
 void EngineInfoContainerDBServer::CollectionInfo::mergeShards(
@@ -450,6 +554,8 @@ void EngineInfoContainerDBServer::addNode(ExecutionNode* node) {
       std::unordered_set<std::string> restrictedShard;
       if (colNode->isRestricted()) {
         restrictedShard.emplace(colNode->restrictedShard());
+      } else {
+        restrictedShard = colNode->restrictedShards();
       }
 
       auto const* col = colNode->collection();
@@ -660,6 +766,12 @@ void EngineInfoContainerDBServer::DBServerInfo::buildMessage(
         return false;
       };
 
+  auto const* queryRegistryFeature =
+      application_features::ApplicationServer::lookupFeature<QueryRegistryFeature>(
+          "QueryRegistry");
+  bool const useSnippetTemplates =
+      queryRegistryFeature == nullptr || queryRegistryFeature->snippetTemplates();
+
   for (auto const& it : _engineInfos) {
     TRI_ASSERT(it.first);
     EngineInfo& engine = *it.first;
@@ -673,8 +785,42 @@ void EngineInfoContainerDBServer::DBServerInfo::buildMessage(
       continue;
     }
 
+    // the first snippet serialized for this engine is the template for
+    // the snippets of all other shards on this server, which differ only
+    // in shard names
+    ShardID const* templateShard = nullptr;
     for (auto const& shard : shards) {
-      engine.serializeSnippet(query, shard, infoBuilder, isResponsibleForInitializeCursor(shard));
+      bool const isResponsible = isResponsibleForInitializeCursor(shard);
+      if (templateShard != nullptr && useSnippetTemplates &&
+          engine.serializeSnippetReference(*templateShard, shard, infoBuilder, isResponsible)) {
+#ifdef ARANGODB_ENABLE_MAINTAINER_MODE
+        // expanding the reference on the DB server must yield the full snippet
+        VPackBuilder templateSnippet;
+        templateSnippet.openObject();
+        engine.serializeSnippet(query, *templateShard, templateSnippet,
+                                isResponsibleForInitializeCursor(*templateShard));
+        templateSnippet.close();
+        VPackBuilder fullSnippet;
+        fullSnippet.openObject();
+        engine.serializeSnippet(query, shard, fullSnippet, isResponsible);
+        fullSnippet.close();
+        VPackBuilder reference;
+        reference.openObject();
+        engine.serializeSnippetReference(*templateShard, shard, reference, isResponsible);
+        reference.close();
+        VPackBuilder instance;
+        instantiateSnippetTemplate(templateSnippet.slice().valueAt(0).get("nodes"),
+                                   reference.slice().valueAt(0).get("shards"),
+                                   isResponsible, instance);
+        TRI_ASSERT(basics::VelocyPackHelper::compare(instance.slice(),
+                                                     fullSnippet.slice().valueAt(0).get("nodes"),
+                                                     false) == 0);
+#endif
+        continue;
+      }
+      if (engine.serializeSnippet(query, shard, infoBuilder, isResponsible)) {
+        templateShard = &shard;
+      }
     }
   }
   infoBuilder.close();  // snippets
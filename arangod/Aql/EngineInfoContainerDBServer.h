@@ -98,9 +98,18 @@ class EngineInfoContainerDBServer {
     Collection const* collection() const noexcept;
     void collection(Collection* col) noexcept;
 
-    void serializeSnippet(Query& query, ShardID const& id, velocypack::Builder& infoBuilder,
+    /// @returns false if nothing was serialized for the shard
+    bool serializeSnippet(Query& query, ShardID const& id, velocypack::Builder& infoBuilder,
                           bool isResponsibleForInitializeCursor) const;
 
+    /// @brief serialize the snippet for shard id as a reference to the
+    /// snippet already serialized for templateShard, carrying only the
+    /// shard names that differ. returns false if the snippet cannot be
+    /// expressed this way and has to be serialized in full
+    bool serializeSnippetReference(ShardID const& templateShard, ShardID const& id,
+                                   velocypack::Builder& infoBuilder,
+                                   bool isResponsibleForInitializeCursor) const;
+
     void serializeSnippet(ServerID const& serverId, Query& query,
                           std::vector<ShardID> const& shards, VPackBuilder& infoBuilder,
                           bool isResponsibleForInitializeCursor) const;
@@ -123,6 +132,9 @@ class EngineInfoContainerDBServer {
 
       aql::Collection* collection{};  // The collection used to connect to this engine
       std::string restrictedShard;    // The shard this snippet is restricted to
+      // The shards this snippet is restricted to, ordered so that the first
+      // one forwards initializeCursor
+      std::set<std::string> restrictedShards;
     };
 
     struct ViewSource {
@@ -144,6 +156,11 @@ class EngineInfoContainerDBServer {
     EngineInfo(EngineInfo&) = delete;
     EngineInfo(EngineInfo const& other) = delete;
 
+    /// @brief determine the shards the collections of a collection based
+    /// engine are translated to when the snippet is built for shard id
+    void shardMapping(ShardID const& id,
+                      std::unordered_map<aql::Collection*, ShardID>& mapping) const;
+
     std::vector<ExecutionNode*> _nodes;
     size_t _idOfRemoteNode;  // id of the remote node
     QueryId _otherId;        // Id of query engine before this one
@@ -239,6 +256,14 @@ class EngineInfoContainerDBServer {
   // the DBServers. The GraphNode itself will retain on the coordinator.
   void addGraphNode(GraphNode* node);
 
+  // Expand a snippet that was sent as a reference to the snippet of
+  // another shard: copies the nodes of the referenced snippet, translates
+  // the shard names given in shards and sets the responsibility for
+  // initializeCursor of the remote node
+  static void instantiateSnippetTemplate(velocypack::Slice nodes, velocypack::Slice shards,
+                                         bool isResponsibleForInitializeCursor,
+                                         velocypack::Builder& builder);
+
  private:
   /**
    * @brief Take care of this collection, set the lock state accordingly
@@ -91,6 +91,11 @@ class EnumerateCollectionExecutorInfos : public ExecutorInfos {
 
 /**
  * @brief Implementation of EnumerateCollection Node
+ *
+ * The collection is scanned through a single cursor on the thread that runs
+ * the query. transaction::Methods and the underlying storage engine
+ * transaction are not thread-safe, so a shard cannot be split into ranges
+ * scanned by several scheduler threads inside the same transaction.
  */
 class EnumerateCollectionExecutor {
  public:
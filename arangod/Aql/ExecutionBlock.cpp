@@ -29,11 +29,61 @@
 #include "Aql/BlockCollector.h"
 #include "Aql/InputAqlItemRow.h"
 #include "Aql/Query.h"
+#include "Aql/ResourceUsage.h"
 #include "Basics/Exceptions.h"
 
+#include <chrono>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
 using namespace arangodb;
 using namespace arangodb::aql;
 
+namespace {
+/// @brief metrics state of the current thread. the times are the totals of
+/// all instrumented calls, a call subtracts the increase during its runtime
+/// to get its exclusive time. only differences are used, so an exception
+/// between the begin and the end of a call just skews a single value
+struct ThreadMetrics {
+  double wallTime = 0.0;
+  double cpuTime = 0.0;
+  bool sampling = false;
+};
+
+thread_local ThreadMetrics threadMetrics;
+
+double wallClock() {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+double threadCpuTime() {
+#ifdef _WIN32
+  FILETIME creationTime, exitTime, kernelTime, userTime;
+  if (GetThreadTimes(GetCurrentThread(), &creationTime, &exitTime, &kernelTime, &userTime)) {
+    ULARGE_INTEGER kernel, user;
+    kernel.LowPart = kernelTime.dwLowDateTime;
+    kernel.HighPart = kernelTime.dwHighDateTime;
+    user.LowPart = userTime.dwLowDateTime;
+    user.HighPart = userTime.dwHighDateTime;
+    // 100 nanosecond intervals
+    return static_cast<double>(kernel.QuadPart + user.QuadPart) * 1.0e-7;
+  }
+  return 0.0;
+#else
+  struct timespec ts;
+  if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0) {
+    return static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) * 1.0e-9;
+  }
+  return 0.0;
+#endif
+}
+}  // namespace
+
 ExecutionBlock::ExecutionBlock(ExecutionEngine* engine, ExecutionNode const* ep)
     : _engine(engine),
       _trx(engine->getQuery()->trx()),
@@ -45,10 +95,67 @@ ExecutionBlock::ExecutionBlock(ExecutionEngine* engine, ExecutionNode const* ep)
       _getSomeBegin(0.0),
       _upstreamState(ExecutionState::HASMORE),
       _pos(0),
-      _collector(&engine->itemBlockManager()) {}
+      _collector(&engine->itemBlockManager()),
+      _resourceMonitor(engine->getQuery()->resourceMonitor()),
+      _callWallStart(0.0),
+      _callCpuStart(0.0),
+      _callChildWall(0.0),
+      _callChildCpu(0.0),
+      _callMemoryStart(0),
+      _callSampled(false),
+      _waitingSince(0.0) {}
 
 ExecutionBlock::~ExecutionBlock() = default;
 
+void ExecutionBlock::sampleMetrics(bool value) { ::threadMetrics.sampling = value; }
+
+void ExecutionBlock::metricsBegin() {
+  double const now = ::wallClock();
+  if (_waitingSince > 0.0) {
+    _metrics.waitTime += now - _waitingSince;
+    _waitingSince = 0.0;
+  }
+  _callWallStart = now;
+  _callChildWall = ::threadMetrics.wallTime;
+  // the first call is always measured, so every node gets a CPU time.
+  // it usually is the first call of the dependencies as well
+  _callSampled = ::threadMetrics.sampling || _metrics.calls == 0;
+  if (_callSampled) {
+    _callCpuStart = ::threadCpuTime();
+    _callChildCpu = ::threadMetrics.cpuTime;
+  }
+  _callMemoryStart = _resourceMonitor->currentResources.memoryUsage;
+}
+
+void ExecutionBlock::metricsEnd(ExecutionState state, size_t rows) {
+  double const now = ::wallClock();
+  double const elapsed = now - _callWallStart;
+
+  ++_metrics.calls;
+  _metrics.rows += rows;
+  // the calls of the dependencies have added their time to the thread total
+  double const childWall = ::threadMetrics.wallTime - _callChildWall;
+  _metrics.wallTime += (std::max)(0.0, elapsed - childWall);
+  ::threadMetrics.wallTime = _callChildWall + elapsed;
+
+  if (_callSampled) {
+    double const cpu = ::threadCpuTime() - _callCpuStart;
+    double const childCpu = ::threadMetrics.cpuTime - _callChildCpu;
+    ++_metrics.sampledCalls;
+    _metrics.sampledCpuTime += (std::max)(0.0, cpu - childCpu);
+    ::threadMetrics.cpuTime = _callChildCpu + cpu;
+  }
+
+  size_t const memory = _resourceMonitor->currentResources.memoryUsage;
+  if (memory > _callMemoryStart) {
+    _metrics.peakMemoryUsage = (std::max)(_metrics.peakMemoryUsage, memory - _callMemoryStart);
+  }
+
+  if (state == ExecutionState::WAITING) {
+    _waitingSince = now;
+  }
+}
+
 std::pair<ExecutionState, Result> ExecutionBlock::initializeCursor(InputAqlItemRow const& input) {
   if (_dependencyPos == _dependencies.end()) {
     // We need to start again.
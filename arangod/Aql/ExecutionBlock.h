@@ -30,6 +30,7 @@
 #include "Aql/ExecutionEngine.h"
 #include "Aql/ExecutionState.h"
 #include "Aql/ExecutionStats.h"
+#include "Aql/QueryMetrics.h"
 #include "Aql/Variable.h"
 #include "QueryOptions.h"
 
@@ -69,6 +70,7 @@ namespace aql {
 class InputAqlItemRow;
 class ExecutionEngine;
 class SharedAqlItemBlockPtr;
+struct ResourceMonitor;
 
 class ExecutionBlock {
  public:
@@ -112,6 +114,7 @@ class ExecutionBlock {
 
   // Trace the start of a getSome call
   inline void traceGetSomeBegin(size_t atMost) {
+    metricsBegin();
     if (_profile >= PROFILE_LEVEL_BLOCKS) {
       if (_getSomeBegin <= 0.0) {
         _getSomeBegin = TRI_microtime();
@@ -129,6 +132,7 @@ class ExecutionBlock {
   inline std::pair<ExecutionState, SharedAqlItemBlockPtr> traceGetSomeEnd(
       ExecutionState state, SharedAqlItemBlockPtr result) {
     TRI_ASSERT(result != nullptr || state != ExecutionState::HASMORE);
+    metricsEnd(state, result != nullptr ? result->size() : 0);
     if (_profile >= PROFILE_LEVEL_BLOCKS) {
       ExecutionNode const* en = getPlanNode();
       ExecutionStats::Node stats;
@@ -174,6 +178,7 @@ class ExecutionBlock {
   }
 
   inline void traceSkipSomeBegin(size_t atMost) {
+    metricsBegin();
     if (_profile >= PROFILE_LEVEL_BLOCKS) {
       if (_getSomeBegin <= 0.0) {
         _getSomeBegin = TRI_microtime();
@@ -191,6 +196,7 @@ class ExecutionBlock {
     ExecutionState const state = res.first;
     size_t const skipped = res.second;
 
+    metricsEnd(state, skipped);
     if (_profile >= PROFILE_LEVEL_BLOCKS) {
       ExecutionNode const* en = getPlanNode();
       ExecutionStats::Node stats;
@@ -263,6 +269,18 @@ class ExecutionBlock {
     _dependencyPos = _dependencies.end();
   }
 
+  /// @brief the always-on metrics of this block, without id and type
+  NodeMetrics const& metrics() const { return _metrics; }
+
+  /// @brief whether the calls of the current thread measure CPU time, set
+  /// by the ExecutionEngine for a sample of its calls
+  static void sampleMetrics(bool value);
+
+ private:
+  /// @brief start and end of the metrics of a getSome or skipSome call
+  void metricsBegin();
+  void metricsEnd(ExecutionState state, size_t rows);
+
  protected:
   /// @brief the execution engine
   ExecutionEngine* _engine;
@@ -315,6 +333,23 @@ class ExecutionBlock {
   /// @brief Collects result blocks during ExecutionBlock::getOrSkipSome. Must
   /// be a member variable due to possible WAITING interruptions.
   aql::BlockCollector _collector;
+
+  NodeMetrics _metrics;
+
+ private:
+  /// @brief memory accounting of the query, for the peak memory metric
+  ResourceMonitor const* _resourceMonitor;
+
+  // state of the call in progress, see metricsBegin()
+  double _callWallStart;
+  double _callCpuStart;
+  double _callChildWall;
+  double _callChildCpu;
+  size_t _callMemoryStart;
+  bool _callSampled;
+
+  /// @brief when the last call returned WAITING, 0 if it did not
+  double _waitingSince;
 };
 
 
@@ -173,6 +173,10 @@ class ExecutionBlockImpl final : public ExecutionBlock {
 
   Infos const& infos() const { return _infos; }
 
+  /// @brief replaces the rows the singleton of a subquery produces after
+  /// initializeCursor, only implemented for IdExecutor<ConstFetcher>
+  void injectConstBlock(SharedAqlItemBlockPtr block);
+
   /// @brief shutdown, will be called exactly once for the whole query
   /// Special implementation for all Executors that need to implement Shutdown
   /// Most do not, we might be able to move their shutdown logic to a more
@@ -45,6 +45,11 @@
 using namespace arangodb;
 using namespace arangodb::aql;
 
+namespace {
+/// @brief the CPU time of every n-th engine call is measured
+constexpr uint64_t metricsSampleInterval = 8;
+}  // namespace
+
 // @brief Local struct to create the
 // information required to build traverser engines
 // on DB servers.
@@ -191,7 +196,8 @@ ExecutionEngine::ExecutionEngine(Query* query)
       _query(query),
       _resultRegister(0),
       _initializeCursorCalled(false),
-      _wasShutdown(false) {
+      _wasShutdown(false),
+      _metricsCalls(0) {
   _blocks.reserve(8);
 }
 
@@ -470,6 +476,7 @@ std::pair<ExecutionState, SharedAqlItemBlockPtr> ExecutionEngine::getSome(size_t
       return {res.first, nullptr};
     }
   }
+  ExecutionBlock::sampleMetrics(_metricsCalls++ % ::metricsSampleInterval == 0);
   return _root->getSome((std::min)(atMost, ExecutionBlock::DefaultBatchSize()));
 }
 
@@ -480,9 +487,23 @@ std::pair<ExecutionState, size_t> ExecutionEngine::skipSome(size_t atMost) {
       return {res.first, 0};
     }
   }
+  ExecutionBlock::sampleMetrics(_metricsCalls++ % ::metricsSampleInterval == 0);
   return _root->skipSome(atMost);
 }
 
+void ExecutionEngine::collectMetrics(QueryMetrics& metrics) const {
+  for (auto const* block : _blocks) {
+    NodeMetrics m = block->metrics();
+    if (m.calls == 0) {
+      continue;
+    }
+    ExecutionNode const* node = block->getPlanNode();
+    m.id = node->id();
+    m.type = node->getTypeString();
+    metrics.add(m);
+  }
+}
+
 Result ExecutionEngine::shutdownSync(int errorCode) noexcept {
   Result res{TRI_ERROR_INTERNAL};
   ExecutionState state = ExecutionState::WAITING;
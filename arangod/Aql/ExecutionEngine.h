@@ -84,6 +84,9 @@ class ExecutionEngine {
   /// @brief skipSome
   std::pair<ExecutionState, size_t> skipSome(size_t atMost);
 
+  /// @brief adds the metrics of all blocks that were called
+  void collectMetrics(QueryMetrics& metrics) const;
+
   /// @brief whether or not initializeCursor was called
   bool initializeCursorCalled() const { return _initializeCursorCalled; }
 
@@ -133,6 +136,9 @@ class ExecutionEngine {
 
   /// @brief whether or not shutdown() was executed
   bool _wasShutdown;
+
+  /// @brief number of getSome and skipSome calls, to sample the CPU time
+  uint64_t _metricsCalls;
 };
 }  // namespace aql
 }  // namespace arangodb
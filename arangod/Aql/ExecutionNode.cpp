@@ -39,11 +39,13 @@
 #include "Aql/ExecutionPlan.h"
 #include "Aql/FilterExecutor.h"
 #include "Aql/Function.h"
+#include "Aql/HashJoinNode.h"
 #include "Aql/IResearchViewNode.h"
 #include "Aql/IdExecutor.h"
 #include "Aql/IndexNode.h"
 #include "Aql/KShortestPathsNode.h"
 #include "Aql/LimitExecutor.h"
+#include "Aql/MaterializeNode.h"
 #include "Aql/ModificationNodes.h"
 #include "Aql/NoResultsExecutor.h"
 #include "Aql/NodeFinder.h"
@@ -100,6 +102,8 @@ std::unordered_map<int, std::string const> const typeNames{
      "SingleRemoteOperationNode"},
     {static_cast<int>(ExecutionNode::ENUMERATE_IRESEARCH_VIEW),
      "EnumerateViewNode"},
+    {static_cast<int>(ExecutionNode::MATERIALIZE), "MaterializeNode"},
+    {static_cast<int>(ExecutionNode::HASH_JOIN), "HashJoinNode"},
 };
 
 // FIXME -- this temporary function should be
@@ -330,6 +334,10 @@ ExecutionNode* ExecutionNode::fromVPackFactory(ExecutionPlan* plan, VPackSlice c
       return new SingleRemoteOperationNode(plan, slice);
     case ENUMERATE_IRESEARCH_VIEW:
       return new iresearch::IResearchViewNode(*plan, slice);
+    case MATERIALIZE:
+      return new MaterializeNode(plan, slice);
+    case HASH_JOIN:
+      return new HashJoinNode(plan, slice);
     default: {
       // should not reach this point
       TRI_ASSERT(false);
@@ -618,7 +626,8 @@ ExecutionNode const* ExecutionNode::getLoop() const {
 
     if (type == ENUMERATE_COLLECTION || type == INDEX || type == TRAVERSAL ||
         type == ENUMERATE_LIST || type == SHORTEST_PATH ||
-        type == K_SHORTEST_PATHS || type == ENUMERATE_IRESEARCH_VIEW) {
+        type == K_SHORTEST_PATHS || type == ENUMERATE_IRESEARCH_VIEW ||
+        type == HASH_JOIN) {
       return node;
     }
   }
@@ -786,6 +795,12 @@ void ExecutionNode::planRegisters(ExecutionNode* super) {
     v.reset(new RegisterPlan());
   } else {
     v.reset(new RegisterPlan(*(super->_registerPlan), super->_depth));
+    auto sq = ExecutionNode::castTo<SubqueryNode*>(super);
+    if (sq->runsBatched()) {
+      // the out register of the subquery is not used inside of it, so it
+      // can carry the index of the outer row
+      v->outerRowRegister = super->variableToRegisterId(sq->outVariable());
+    }
   }
   v->setSharedPtr(&v);
 
@@ -814,6 +829,7 @@ ExecutionNode::RegisterPlan::RegisterPlan(RegisterPlan const& v, unsigned int ne
       subQueryNodes(),
       depth(newdepth + 1),
       totalNrRegs(v.nrRegs[newdepth]),
+      outerRowRegister(ExecutionNode::MaxRegisterId),
       me(nullptr) {
   if (depth + 1 < 8) {
     // do a minium initial allocation to avoid frequent reallocations
@@ -837,6 +853,7 @@ void ExecutionNode::RegisterPlan::clear() {
   subQueryNodes.clear();
   depth = 0;
   totalNrRegs = 0;
+  outerRowRegister = ExecutionNode::MaxRegisterId;
 }
 
 ExecutionNode::RegisterPlan* ExecutionNode::RegisterPlan::clone(ExecutionPlan* otherPlan,
@@ -847,6 +864,7 @@ ExecutionNode::RegisterPlan* ExecutionNode::RegisterPlan::clone(ExecutionPlan* o
   other->nrRegs = nrRegs;
   other->depth = depth;
   other->totalNrRegs = totalNrRegs;
+  other->outerRowRegister = outerRowRegister;
 
   other->varInfo = varInfo;
 
@@ -858,8 +876,30 @@ ExecutionNode::RegisterPlan* ExecutionNode::RegisterPlan::clone(ExecutionPlan* o
 
 void ExecutionNode::RegisterPlan::after(ExecutionNode* en) {
   switch (en->getType()) {
-    case ExecutionNode::ENUMERATE_COLLECTION:
     case ExecutionNode::INDEX: {
+      auto ep = ExecutionNode::castTo<IndexNode const*>(en);
+      TRI_ASSERT(ep != nullptr);
+      if (ep->isLateMaterialized()) {
+        // document id and projections, see MaterializeNode
+        depth++;
+        auto vars = ep->getVariablesSetHere();
+        nrRegsHere.emplace_back(static_cast<RegisterId>(vars.size()));
+        // create a copy of the last value here
+        // this is required because back returns a reference and emplace/push_back
+        // may invalidate all references
+        RegisterId registerId = static_cast<RegisterId>(vars.size() + nrRegs.back());
+        nrRegs.emplace_back(registerId);
+
+        for (auto& it : vars) {
+          varInfo.emplace(it->id, VarInfo(depth, totalNrRegs));
+          totalNrRegs++;
+        }
+        break;
+      }
+      // fall-through
+    }
+
+    case ExecutionNode::ENUMERATE_COLLECTION: {
       depth++;
       nrRegsHere.emplace_back(1);
       // create a copy of the last value here
@@ -896,6 +936,22 @@ void ExecutionNode::RegisterPlan::after(ExecutionNode* en) {
       break;
     }
 
+    case ExecutionNode::HASH_JOIN: {
+      depth++;
+      nrRegsHere.emplace_back(1);
+      // create a copy of the last value here
+      // this is required because back returns a reference and emplace/push_back
+      // may invalidate all references
+      RegisterId registerId = 1 + nrRegs.back();
+      nrRegs.emplace_back(registerId);
+
+      auto ep = ExecutionNode::castTo<HashJoinNode const*>(en);
+      TRI_ASSERT(ep != nullptr);
+      varInfo.emplace(ep->outVariable()->id, VarInfo(depth, totalNrRegs));
+      totalNrRegs++;
+      break;
+    }
+
     case ExecutionNode::CALCULATION: {
       nrRegsHere[depth]++;
       nrRegs[depth]++;
@@ -906,6 +962,16 @@ void ExecutionNode::RegisterPlan::after(ExecutionNode* en) {
       break;
     }
 
+    case ExecutionNode::MATERIALIZE: {
+      nrRegsHere[depth]++;
+      nrRegs[depth]++;
+      auto ep = ExecutionNode::castTo<MaterializeNode const*>(en);
+      TRI_ASSERT(ep != nullptr);
+      varInfo.emplace(ep->outVariable()->id, VarInfo(depth, totalNrRegs));
+      totalNrRegs++;
+      break;
+    }
+
     case ExecutionNode::SUBQUERY: {
       nrRegsHere[depth]++;
       nrRegs[depth]++;
@@ -1227,6 +1293,12 @@ std::unordered_set<RegisterId> ExecutionNode::calcRegsToKeep() const {
     }
   }
 
+  RegisterId const outerRowRegister = getRegisterPlan()->outerRowRegister;
+  if (outerRowRegister != MaxRegisterId) {
+    TRI_ASSERT(outerRowRegister < nrInRegs);
+    regsToKeep.emplace(outerRowRegister);
+  }
+
   return regsToKeep;
 };
 
@@ -1284,6 +1356,9 @@ std::unique_ptr<ExecutionBlock> SingletonNode::createBlock(
         TRI_ASSERT(rv.second);
       }
     }
+    if (getRegisterPlan()->outerRowRegister != MaxRegisterId) {
+      toKeep.emplace(getRegisterPlan()->outerRowRegister);
+    }
   }
 
   IdExecutorInfos infos(nrRegs, std::move(toKeep), getRegsToClear());
@@ -1763,6 +1838,7 @@ bool SubqueryNode::mayAccessCollections() {
   // a collection
   std::vector<ExecutionNode::NodeType> const types = {ExecutionNode::ENUMERATE_IRESEARCH_VIEW,
                                                       ExecutionNode::ENUMERATE_COLLECTION,
+                                                      ExecutionNode::HASH_JOIN,
                                                       ExecutionNode::INDEX,
                                                       ExecutionNode::INSERT,
                                                       ExecutionNode::UPDATE,
@@ -1786,6 +1862,41 @@ bool SubqueryNode::mayAccessCollections() {
   return false;
 }
 
+bool SubqueryNode::runsBatched() {
+  if (isModificationSubquery() || isConst()) {
+    // a const subquery is run once per block anyway
+    return false;
+  }
+
+  TRI_ASSERT(_subquery != nullptr);
+  if (_subquery->getType() != RETURN) {
+    return false;
+  }
+
+  auto current = _subquery->getFirstDependency();
+  while (current != nullptr && current->getType() != SINGLETON) {
+    switch (current->getType()) {
+      case CALCULATION:
+      case FILTER:
+      case ENUMERATE_LIST:
+      case ENUMERATE_COLLECTION:
+      case HASH_JOIN:
+        break;
+      case INDEX:
+        if (ExecutionNode::castTo<IndexNode const*>(current)->isLateMaterialized()) {
+          return false;
+        }
+        break;
+      default:
+        // everything else either needs to see all of its input, like
+        // SORT, LIMIT or COLLECT, or may have to wait for another server
+        return false;
+    }
+    current = current->getFirstDependency();
+  }
+  return current != nullptr;
+}
+
 /// @brief creates corresponding ExecutionBlock
 std::unique_ptr<ExecutionBlock> SubqueryNode::createBlock(
     ExecutionEngine& engine,
@@ -1812,6 +1923,27 @@ std::unique_ptr<ExecutionBlock> SubqueryNode::createBlock(
                               getRegisterPlan()->nrRegs[getDepth()],
                               getRegsToClear(), calcRegsToKeep(), *subquery,
                               outReg, const_cast<SubqueryNode*>(this)->isConst());
+
+  if (getSubquery()->getRegisterPlan()->outerRowRegister != MaxRegisterId) {
+    // the rows are fed into the singleton of the subquery, and the results
+    // are taken from the node before its RETURN
+    TRI_ASSERT(getSubquery()->getRegisterPlan()->outerRowRegister == outReg);
+    auto returnNode = ExecutionNode::castTo<ReturnNode const*>(getSubquery());
+    ExecutionNode* singleton = getSubquery();
+    while (singleton->hasDependency()) {
+      singleton = singleton->getFirstDependency();
+    }
+    auto const results = cache.find(getSubquery()->getFirstDependency());
+    auto const input = cache.find(singleton);
+    TRI_ASSERT(results != cache.end() && input != cache.end());
+    auto const returnVar =
+        getSubquery()->getRegisterPlan()->varInfo.find(returnNode->inVariable()->id);
+    TRI_ASSERT(returnVar != getSubquery()->getRegisterPlan()->varInfo.end());
+
+    infos.runBatched(engine.itemBlockManager(),
+                     *static_cast<ExecutionBlockImpl<IdExecutor<ConstFetcher>>*>(input->second),
+                     *results->second, returnVar->second.registerId);
+  }
   if (isModificationSubquery()) {
     return std::make_unique<ExecutionBlockImpl<SubqueryExecutor<true>>>(&engine, this,
                                                                         std::move(infos));
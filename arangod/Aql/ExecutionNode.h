@@ -147,6 +147,8 @@ class ExecutionNode {
     K_SHORTEST_PATHS = 25,
     REMOTESINGLE = 26,
     ENUMERATE_IRESEARCH_VIEW,
+    MATERIALIZE,
+    HASH_JOIN,
     MAX_NODE_TYPE_VALUE
   };
 
@@ -473,12 +475,18 @@ class ExecutionNode {
     unsigned int depth;
     unsigned int totalNrRegs;
 
+    // if a subquery runs for a whole block of outer rows at once, the
+    // register holding the index of the outer row each of its rows belongs
+    // to. all nodes of the subquery keep it. MaxRegisterId otherwise
+    RegisterId outerRowRegister;
+
    private:
     // This is used to tell all nodes and share a pointer to ourselves
     std::shared_ptr<RegisterPlan>* me;
 
    public:
-    RegisterPlan() : depth(0), totalNrRegs(0), me(nullptr) {
+    RegisterPlan()
+        : depth(0), totalNrRegs(0), outerRowRegister(MaxRegisterId), me(nullptr) {
       nrRegsHere.reserve(8);
       nrRegsHere.emplace_back(0);
       nrRegs.reserve(8);
@@ -814,6 +822,9 @@ class LimitNode : public ExecutionNode {
   /// @brief tell the node to fully count what it will limit
   void setFullCount() { _fullCount = true; }
 
+  /// @brief whether or not the node fully counts what it limits
+  bool fullCount() const { return _fullCount; }
+
   /// @brief return the offset value
   size_t offset() const { return _offset; }
 
@@ -977,6 +988,12 @@ class SubqueryNode : public ExecutionNode {
   bool isConst();
   bool mayAccessCollections();
 
+  /// @brief whether the subquery is run once for all rows of an input block
+  /// instead of once per row. this is the case if every node of it produces
+  /// its rows strictly one input row after the other, so that the rows
+  /// can be told apart by the index of the outer row they belong to
+  bool runsBatched();
+
  private:
   /// @brief we need to have an expression and where to write the result
   ExecutionNode* _subquery;
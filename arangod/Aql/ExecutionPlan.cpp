@@ -2334,7 +2334,8 @@ bool ExecutionPlan::isDeadSimple() const {
 
     if (nodeType == ExecutionNode::SUBQUERY || nodeType == ExecutionNode::ENUMERATE_COLLECTION ||
         nodeType == ExecutionNode::ENUMERATE_LIST || nodeType == ExecutionNode::TRAVERSAL ||
-        nodeType == ExecutionNode::SHORTEST_PATH || nodeType == ExecutionNode::INDEX) {
+        nodeType == ExecutionNode::SHORTEST_PATH || nodeType == ExecutionNode::INDEX ||
+        nodeType == ExecutionNode::HASH_JOIN) {
       // these node types are not simple
       return false;
     }
@@ -2345,6 +2346,36 @@ bool ExecutionPlan::isDeadSimple() const {
   return true;
 }
 
+bool ExecutionPlan::isSimple() const {
+  size_t collections = 0;
+  auto current = _root;
+
+  while (current != nullptr) {
+    switch (current->getType()) {
+      case ExecutionNode::SINGLETON:
+      case ExecutionNode::CALCULATION:
+      case ExecutionNode::FILTER:
+      case ExecutionNode::LIMIT:
+      case ExecutionNode::RETURN:
+        break;
+      case ExecutionNode::ENUMERATE_COLLECTION:
+        if (++collections > 1) {
+          return false;
+        }
+        break;
+      default:
+        return false;
+    }
+
+    if (current->getDependencies().size() > 1) {
+      return false;
+    }
+    current = current->getFirstDependency();
+  }
+
+  return true;
+}
+
 #ifdef ARANGODB_ENABLE_MAINTAINER_MODE
 
 #include <iostream>
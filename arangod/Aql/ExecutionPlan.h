@@ -141,6 +141,11 @@ class ExecutionPlan {
   /// probably cost more than simply executing the plan
   bool isDeadSimple() const;
 
+  /// @brief returns true if a plan iterates over a single collection with
+  /// only filters, calculations and limits, so that a minimal set of
+  /// optimizer rules produces the best plan
+  bool isSimple() const;
+
 /// @brief show an overview over the plan
 #ifdef ARANGODB_ENABLE_MAINTAINER_MODE
   void show();
@@ -48,6 +48,7 @@ void ExecutionStats::toVelocyPack(VPackBuilder& builder, bool reportFullCount) c
   builder.add("executionTime", VPackValue(executionTime));
   
   builder.add("peakMemoryUsage", VPackValue(peakMemoryUsage));
+  builder.add("intermediateCommits", VPackValue(intermediateCommits));
 
   if (!nodes.empty()) {
     builder.add("nodes", VPackValue(VPackValueType::Array));
@@ -82,6 +83,7 @@ void ExecutionStats::add(ExecutionStats const& summand) {
   }
   count += summand.count;
   peakMemoryUsage = std::max(summand.peakMemoryUsage, peakMemoryUsage);
+  intermediateCommits += summand.intermediateCommits;
   // intentionally no modification of executionTime
 
   for (auto const& pair : summand.nodes) {
@@ -102,7 +104,8 @@ ExecutionStats::ExecutionStats()
       fullCount(0),
       count(0),
       executionTime(0.0),
-      peakMemoryUsage(0) {}
+      peakMemoryUsage(0),
+      intermediateCommits(0) {}
 
 ExecutionStats::ExecutionStats(VPackSlice const& slice) : ExecutionStats() {
   if (!slice.isObject()) {
@@ -127,6 +130,10 @@ ExecutionStats::ExecutionStats(VPackSlice const& slice) : ExecutionStats() {
     fullCount = count;
   }
 
+  if (slice.hasKey("intermediateCommits")) {
+    intermediateCommits = slice.get("intermediateCommits").getNumber<int64_t>();
+  }
+
   // note: node stats are optional
   if (slice.hasKey("nodes")) {
     ExecutionStats::Node node;
@@ -82,6 +82,7 @@ struct ExecutionStats {
     count = 0;
     executionTime = 0.0;
     peakMemoryUsage = 0;
+    intermediateCommits = 0;
   }
 
   /// @brief number of successfully executed write operations
@@ -115,6 +116,9 @@ struct ExecutionStats {
   /// @brief peak memory usage of the query
   size_t peakMemoryUsage;
 
+  /// @brief number of automatic intermediate commits of the transaction
+  int64_t intermediateCommits;
+
   ///  @brief statistics per ExecutionNodes
   std::map<size_t, ExecutionStats::Node> nodes;
 };
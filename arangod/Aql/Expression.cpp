@@ -55,6 +55,38 @@
 
 using namespace arangodb;
 using namespace arangodb::aql;
+
+namespace {
+
+/// @brief collect all attribute access chains of length > 1 that start at a
+/// variable reference, e.g. doc.a.b, so they can be resolved in one go
+void collectAttributePaths(AstNode const* node,
+                           std::unordered_map<AstNode const*, std::vector<std::string>>& paths) {
+  if (node == nullptr) {
+    return;
+  }
+
+  if (node->type == NODE_TYPE_ATTRIBUTE_ACCESS) {
+    std::vector<std::string> parts{node->getString()};
+    AstNode const* member = node->getMemberUnchecked(0);
+    while (member->type == NODE_TYPE_ATTRIBUTE_ACCESS) {
+      parts.insert(parts.begin(), member->getString());
+      member = member->getMemberUnchecked(0);
+    }
+    if (member->type == NODE_TYPE_REFERENCE && parts.size() > 1) {
+      // the inner nodes of the chain will never be evaluated on their own
+      paths.emplace(node, std::move(parts));
+      return;
+    }
+  }
+
+  size_t const n = node->numMembers();
+  for (size_t i = 0; i < n; ++i) {
+    collectAttributePaths(node->getMemberUnchecked(i), paths);
+  }
+}
+
+}  // namespace
 using VelocyPackHelper = arangodb::basics::VelocyPackHelper;
 
 /// @brief create the expression
@@ -167,6 +199,8 @@ void Expression::freeInternals() noexcept {
       break;
     }
   }
+
+  _attributePaths.clear();
 }
 
 /// @brief reset internal attributes after variables in the expression were
@@ -251,10 +285,7 @@ bool Expression::findInArray(AqlValue const& left, AqlValue const& right,
     int64_t value = left.toInt64();
     if (left.toDouble() == static_cast<double>(value)) {
       // no loss
-      Range const* r = right.range();
-      TRI_ASSERT(r != nullptr);
-
-      return r->isIn(value);
+      return right.range().isIn(value);
     }
     // fall-through to linear search
   }
@@ -291,6 +322,7 @@ void Expression::initExpression() {
   _type = SIMPLE;
 
   if (_node->type != NODE_TYPE_ATTRIBUTE_ACCESS) {
+    collectAttributePaths(_node, _attributePaths);
     return;
   }
 
@@ -305,6 +337,7 @@ void Expression::initExpression() {
   }
 
   if (member->type != NODE_TYPE_REFERENCE) {
+    collectAttributePaths(_node, _attributePaths);
     return;
   }
   auto v = static_cast<Variable const*>(member->getData());
@@ -459,13 +492,30 @@ AqlValue Expression::executeSimpleExpressionAttributeAccess(AstNode const* node,
   // object lookup, e.g. users.name
   TRI_ASSERT(node->numMembers() == 1);
 
+  auto resolver = trx->resolver();
+  TRI_ASSERT(resolver != nullptr);
+
+  if (!_attributePaths.empty()) {
+    auto it = _attributePaths.find(node);
+    if (it != _attributePaths.end()) {
+      // nested access on a variable, e.g. doc.a.b. look up the full path at
+      // once so we do not copy the intermediate sub-objects
+      AstNode const* ref = node;
+      while (ref->type == NODE_TYPE_ATTRIBUTE_ACCESS) {
+        ref = ref->getMemberUnchecked(0);
+      }
+      bool localMustDestroy;
+      AqlValue result = executeSimpleExpressionReference(ref, trx, localMustDestroy, false);
+      AqlValueGuard guard(result, localMustDestroy);
+      return result.get(*resolver, (*it).second, mustDestroy, true);
+    }
+  }
+
   auto member = node->getMemberUnchecked(0);
 
   bool localMustDestroy;
   AqlValue result = executeSimpleExpression(member, trx, localMustDestroy, false);
   AqlValueGuard guard(result, localMustDestroy);
-  auto resolver = trx->resolver();
-  TRI_ASSERT(resolver != nullptr);
 
   return result.get(
       *resolver, 
@@ -822,26 +872,15 @@ AqlValue Expression::invokeV8Function(ExpressionContext* expressionContext,
   ISOLATE;
   auto current = isolate->GetCurrentContext()->Global();
 
-  v8::Handle<v8::Value> module =
-      current->Get(TRI_V8_ASCII_STRING(isolate, "_AQL"));
-  if (module.IsEmpty() || !module->IsObject()) {
-    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
-                                   "unable to find global _AQL module");
-  }
-
-  v8::Handle<v8::Value> function =
-      v8::Handle<v8::Object>::Cast(module)->Get(TRI_V8_STD_STRING(isolate, jsName));
-  if (function.IsEmpty() || !function->IsFunction()) {
-    THROW_ARANGO_EXCEPTION_MESSAGE(
-        TRI_ERROR_INTERNAL,
-        std::string("unable to find AQL function '") + jsName + "'");
-  }
+  Query* query = expressionContext->query();
+  TRI_ASSERT(query != nullptr);
+  v8::Handle<v8::Function> function = query->aqlV8Function(isolate, jsName);
 
   // actually call the V8 function
   v8::TryCatch tryCatch(isolate);
   ;
   v8::Handle<v8::Value> result =
-      v8::Handle<v8::Function>::Cast(function)->Call(current, static_cast<int>(callArgs), args);
+      function->Call(current, static_cast<int>(callArgs), args);
 
   try {
     V8Executor::HandleV8Error(tryCatch, result, nullptr, false);
@@ -1149,11 +1188,21 @@ AqlValue Expression::executeSimpleExpressionComparison(AstNode const* node,
 
   // all other comparison operators...
 
-  // for equality and non-equality we can use a binary comparison
-  bool compareUtf8 = (node->type != NODE_TYPE_OPERATOR_BINARY_EQ &&
-                      node->type != NODE_TYPE_OPERATOR_BINARY_NE);
+  int compareResult;
+  if (left.isNumber() && right.isNumber()) {
+    // fast path for the very common case of comparing two numbers, e.g.
+    // FILTER doc.value >= @lo. this skips the type weight calculation and
+    // the generic VelocyPack comparison dispatch
+    VPackSlice const l = left.slice();
+    compareResult = arangodb::basics::VelocyPackHelper::compareNumberValues(
+        l.type(), l, right.slice());
+  } else {
+    // for equality and non-equality we can use a binary comparison
+    bool compareUtf8 = (node->type != NODE_TYPE_OPERATOR_BINARY_EQ &&
+                        node->type != NODE_TYPE_OPERATOR_BINARY_NE);
 
-  int compareResult = AqlValue::Compare(trx, left, right, compareUtf8);
+    compareResult = AqlValue::Compare(trx, left, right, compareUtf8);
+  }
 
   switch (node->type) {
     case NODE_TYPE_OPERATOR_BINARY_EQ:
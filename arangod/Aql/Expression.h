@@ -356,6 +356,12 @@ class Expression {
   /// @brief variables only temporarily valid during execution
   std::unordered_map<Variable const*, arangodb::velocypack::Slice> _variables;
 
+  /// @brief precomputed attribute paths for nested attribute accesses on
+  /// a variable (e.g. doc.a.b.c) inside SIMPLE expressions, keyed by the
+  /// outermost ATTRIBUTE_ACCESS node. these are resolved with a single
+  /// path lookup instead of one intermediate copy per path level
+  std::unordered_map<AstNode const*, std::vector<std::string>> _attributePaths;
+
   ExpressionContext* _expressionContext;
 };
 
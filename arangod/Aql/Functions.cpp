@@ -30,9 +30,11 @@
 #include "Aql/ExpressionContext.h"
 #include "Aql/Function.h"
 #include "Aql/Query.h"
+#include "Aql/RegexCache.h"
 #include "Aql/V8Executor.h"
 #include "Basics/Exceptions.h"
 #include "Basics/HybridLogicalClock.h"
+#include "Basics/HyperLogLog.h"
 #include "Basics/Mutex.h"
 #include "Basics/MutexLocker.h"
 #include "Basics/StringBuffer.h"
@@ -283,6 +285,26 @@ AqlValue numberValue(double value, bool nullify) {
   return AqlValue(AqlValueHintDouble(value));
 }
 
+/// @brief convert a computed string into an AqlValue. strings that are too
+/// long to be stored inline are interned in the query, so that repeated
+/// values need neither a memory allocation nor memory accounting
+AqlValue stringValue(ExpressionContext* expressionContext, char const* p, size_t length) {
+  if (length >= sizeof(AqlValue) - 1) {
+    Query* query = expressionContext->query();
+    if (query != nullptr) {
+      uint8_t const* interned = query->registerVPackString(p, length);
+      if (interned != nullptr) {
+        return AqlValue(interned);
+      }
+    }
+  }
+  return AqlValue(p, length);
+}
+
+inline AqlValue stringValue(ExpressionContext* expressionContext, std::string const& value) {
+  return stringValue(expressionContext, value.data(), value.size());
+}
+
 inline AqlValue timeAqlValue(tp_sys_clock_ms const& tp) {
   std::string formatted = format("%FT%TZ", floor<milliseconds>(tp));
   return AqlValue(formatted);
@@ -528,8 +550,7 @@ bool parameterToTimePoint(ExpressionContext* expressionContext,
   if (value.isNumber()) {
     tp = tp_sys_clock_ms(milliseconds(value.toInt64()));
   } else {
-    std::string const dateVal = value.slice().copyString();
-    if (!basics::parseDateTime(dateVal, tp)) {
+    if (!basics::parseDateTime(arangodb::velocypack::StringRef(value.slice()), tp)) {
       ::registerWarning(expressionContext, AFN, TRI_ERROR_QUERY_INVALID_DATE_VALUE);
       return false;
     }
@@ -1371,7 +1392,7 @@ AqlValue Functions::ToNumber(ExpressionContext*,
 }
 
 /// @brief function TO_STRING
-AqlValue Functions::ToString(ExpressionContext*, transaction::Methods* trx,
+AqlValue Functions::ToString(ExpressionContext* expressionContext, transaction::Methods* trx,
                              VPackFunctionParameters const& parameters) {
   AqlValue const& value = extractFunctionParameterValue(parameters, 0);
 
@@ -1379,7 +1400,7 @@ AqlValue Functions::ToString(ExpressionContext*, transaction::Methods* trx,
   arangodb::basics::VPackStringBufferAdapter adapter(buffer->stringBuffer());
 
   ::appendAsString(trx, adapter, value);
-  return AqlValue(buffer->begin(), buffer->length());
+  return ::stringValue(expressionContext, buffer->begin(), buffer->length());
 }
 
 /// @brief function TO_BASE64
@@ -1887,7 +1908,7 @@ AqlValue Functions::Contains(ExpressionContext*, transaction::Methods* trx,
 }
 
 /// @brief function CONCAT
-AqlValue Functions::Concat(ExpressionContext*, transaction::Methods* trx,
+AqlValue Functions::Concat(ExpressionContext* expressionContext, transaction::Methods* trx,
                            VPackFunctionParameters const& parameters) {
   transaction::StringBufferLeaser buffer(trx);
   arangodb::basics::VPackStringBufferAdapter adapter(buffer->stringBuffer());
@@ -1907,7 +1928,7 @@ AqlValue Functions::Concat(ExpressionContext*, transaction::Methods* trx,
         // convert member to a string and append
         ::appendAsString(trx, adapter, AqlValue(it.begin()));
       }
-      return AqlValue(buffer->c_str(), buffer->length());
+      return ::stringValue(expressionContext, buffer->c_str(), buffer->length());
     }
   }
 
@@ -1922,11 +1943,11 @@ AqlValue Functions::Concat(ExpressionContext*, transaction::Methods* trx,
     ::appendAsString(trx, adapter, member);
   }
 
-  return AqlValue(buffer->c_str(), buffer->length());
+  return ::stringValue(expressionContext, buffer->c_str(), buffer->length());
 }
 
 /// @brief function CONCAT_SEPARATOR
-AqlValue Functions::ConcatSeparator(ExpressionContext*, transaction::Methods* trx,
+AqlValue Functions::ConcatSeparator(ExpressionContext* expressionContext, transaction::Methods* trx,
                                     VPackFunctionParameters const& parameters) {
   transaction::StringBufferLeaser buffer(trx);
   arangodb::basics::VPackStringBufferAdapter adapter(buffer->stringBuffer());
@@ -1961,7 +1982,7 @@ AqlValue Functions::ConcatSeparator(ExpressionContext*, transaction::Methods* tr
         ::appendAsString(trx, adapter, AqlValue(it.begin()));
         found = true;
       }
-      return AqlValue(buffer->c_str(), buffer->length());
+      return ::stringValue(expressionContext, buffer->c_str(), buffer->length());
     }
   }
 
@@ -1982,7 +2003,7 @@ AqlValue Functions::ConcatSeparator(ExpressionContext*, transaction::Methods* tr
     found = true;
   }
 
-  return AqlValue(buffer->c_str(), buffer->length());
+  return ::stringValue(expressionContext, buffer->c_str(), buffer->length());
 }
 
 /// @brief function CHAR_LENGTH
@@ -2032,7 +2053,7 @@ AqlValue Functions::CharLength(ExpressionContext*, transaction::Methods* trx,
 }
 
 /// @brief function LOWER
-AqlValue Functions::Lower(ExpressionContext*, transaction::Methods* trx,
+AqlValue Functions::Lower(ExpressionContext* expressionContext, transaction::Methods* trx,
                           VPackFunctionParameters const& parameters) {
   std::string utf8;
   AqlValue const& value = extractFunctionParameterValue(parameters, 0);
@@ -2046,11 +2067,11 @@ AqlValue Functions::Lower(ExpressionContext*, transaction::Methods* trx,
   unicodeStr.toLower(nullptr);
   unicodeStr.toUTF8String(utf8);
 
-  return AqlValue(utf8);
+  return ::stringValue(expressionContext, utf8);
 }
 
 /// @brief function UPPER
-AqlValue Functions::Upper(ExpressionContext*, transaction::Methods* trx,
+AqlValue Functions::Upper(ExpressionContext* expressionContext, transaction::Methods* trx,
                           VPackFunctionParameters const& parameters) {
   std::string utf8;
   AqlValue const& value = extractFunctionParameterValue(parameters, 0);
@@ -2064,11 +2085,11 @@ AqlValue Functions::Upper(ExpressionContext*, transaction::Methods* trx,
   unicodeStr.toUpper(nullptr);
   unicodeStr.toUTF8String(utf8);
 
-  return AqlValue(utf8);
+  return ::stringValue(expressionContext, utf8);
 }
 
 /// @brief function SUBSTRING
-AqlValue Functions::Substring(ExpressionContext*, transaction::Methods* trx,
+AqlValue Functions::Substring(ExpressionContext* expressionContext, transaction::Methods* trx,
                               VPackFunctionParameters const& parameters) {
   AqlValue const& value = extractFunctionParameterValue(parameters, 0);
 
@@ -2098,7 +2119,7 @@ AqlValue Functions::Substring(ExpressionContext*, transaction::Methods* trx,
       .tempSubString(offset, unicodeStr.moveIndex32(offset, length) - offset)
       .toUTF8String(utf8);
 
-  return AqlValue(utf8);
+  return ::stringValue(expressionContext, utf8);
 }
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
@@ -2351,11 +2372,11 @@ AqlValue Functions::Substitute(ExpressionContext* expressionContext,
   result.append(unicodeStr, lastStart, unicodeStr.length() - lastStart);
 
   result.toUTF8String(utf8);
-  return AqlValue(utf8);
+  return ::stringValue(expressionContext, utf8);
 }
 
 /// @brief function LEFT str, length
-AqlValue Functions::Left(ExpressionContext*, transaction::Methods* trx,
+AqlValue Functions::Left(ExpressionContext* expressionContext, transaction::Methods* trx,
                          VPackFunctionParameters const& parameters) {
   AqlValue value = extractFunctionParameterValue(parameters, 0);
   uint32_t length =
@@ -2372,11 +2393,11 @@ AqlValue Functions::Left(ExpressionContext*, transaction::Methods* trx,
       unicodeStr.tempSubString(0, unicodeStr.moveIndex32(0, length));
 
   left.toUTF8String(utf8);
-  return AqlValue(utf8);
+  return ::stringValue(expressionContext, utf8);
 }
 
 /// @brief function RIGHT
-AqlValue Functions::Right(ExpressionContext*, transaction::Methods* trx,
+AqlValue Functions::Right(ExpressionContext* expressionContext, transaction::Methods* trx,
                           VPackFunctionParameters const& parameters) {
   AqlValue value = extractFunctionParameterValue(parameters, 0);
   uint32_t length =
@@ -2393,7 +2414,7 @@ AqlValue Functions::Right(ExpressionContext*, transaction::Methods* trx,
       unicodeStr.moveIndex32(unicodeStr.length(), -static_cast<int32_t>(length)));
 
   right.toUTF8String(utf8);
-  return AqlValue(utf8);
+  return ::stringValue(expressionContext, utf8);
 }
 
 namespace {
@@ -2490,7 +2511,7 @@ AqlValue Functions::Trim(ExpressionContext* expressionContext, transaction::Meth
   icu::UnicodeString result = unicodeStr.tempSubString(startOffset, endOffset - startOffset);
   std::string utf8;
   result.toUTF8String(utf8);
-  return AqlValue(utf8);
+  return ::stringValue(expressionContext, utf8);
 }
 
 /// @brief function LTRIM
@@ -2530,7 +2551,7 @@ AqlValue Functions::LTrim(ExpressionContext* expressionContext, transaction::Met
   icu::UnicodeString result = unicodeStr.tempSubString(startOffset, endOffset - startOffset);
   std::string utf8;
   result.toUTF8String(utf8);
-  return AqlValue(utf8);
+  return ::stringValue(expressionContext, utf8);
 }
 
 /// @brief function RTRIM
@@ -2570,7 +2591,7 @@ AqlValue Functions::RTrim(ExpressionContext* expressionContext, transaction::Met
   icu::UnicodeString result = unicodeStr.tempSubString(startOffset, endOffset - startOffset);
   std::string utf8;
   result.toUTF8String(utf8);
-  return AqlValue(utf8);
+  return ::stringValue(expressionContext, utf8);
 }
 
 /// @brief function LIKE
@@ -2586,6 +2607,25 @@ AqlValue Functions::Like(ExpressionContext* expressionContext, transaction::Meth
   AqlValue const& regex = extractFunctionParameterValue(parameters, 1);
   ::appendAsString(trx, adapter, regex);
 
+  // extract value
+  transaction::StringBufferLeaser valueBuffer(trx);
+  arangodb::basics::VPackStringBufferAdapter valueAdapter(valueBuffer->stringBuffer());
+  AqlValue const& value = extractFunctionParameterValue(parameters, 0);
+  ::appendAsString(trx, valueAdapter, value);
+
+  if (!caseInsensitive) {
+    // patterns such as "abc", "abc%", "%abc" and "%abc%" are matched
+    // without the regex engine
+    std::string literal;
+    auto type = RegexCache::analyzeLikePattern(literal, buffer->c_str(), buffer->length());
+    bool result;
+    if (type != RegexCache::LikePatternType::Regex &&
+        RegexCache::matchLikePattern(type, literal, valueBuffer->c_str(),
+                                     valueBuffer->length(), result)) {
+      return AqlValue(AqlValueHintBool(result));
+    }
+  }
+
   // the matcher is owned by the context!
   icu::RegexMatcher* matcher =
       expressionContext->buildLikeMatcher(buffer->c_str(), buffer->length(), caseInsensitive);
@@ -2596,14 +2636,9 @@ AqlValue Functions::Like(ExpressionContext* expressionContext, transaction::Meth
     return AqlValue(AqlValueHintNull());
   }
 
-  // extract value
-  buffer->clear();
-  AqlValue const& value = extractFunctionParameterValue(parameters, 0);
-  ::appendAsString(trx, adapter, value);
-
   bool error = false;
   bool const result = arangodb::basics::Utf8Helper::DefaultUtf8Helper.matches(
-      matcher, buffer->c_str(), buffer->length(), false, error);
+      matcher, valueBuffer->c_str(), valueBuffer->length(), false, error);
 
   if (error) {
     // compiling regular expression failed
@@ -2653,11 +2688,11 @@ AqlValue Functions::Split(ExpressionContext* expressionContext, transaction::Met
 
   if (parameters.size() == 1) {
     // pre-documented edge-case: if we only have the first parameter, return it.
-    VPackBuilder result;
-    result.openArray();
-    result.add(aqlValueToSplit.slice());
-    result.close();
-    return AqlValue(result);
+    transaction::BuilderLeaser result(trx);
+    result->openArray();
+    result->add(aqlValueToSplit.slice());
+    result->close();
+    return AqlValue(result.get());
   }
 
   // Get ready for ICU
@@ -2676,14 +2711,14 @@ AqlValue Functions::Split(ExpressionContext* expressionContext, transaction::Met
     return AqlValue(AqlValueHintNull());
   }
 
-  VPackBuilder result;
-  result.openArray();
+  transaction::BuilderLeaser result(trx);
+  result->openArray();
   if (!isEmptyExpression && (buffer->length() == 0)) {
     // Edge case: splitting an empty string by non-empty expression produces an
     // empty string again.
-    result.add(VPackValue(""));
-    result.close();
-    return AqlValue(result);
+    result->add(VPackValue(""));
+    result->close();
+    return AqlValue(result.get());
   }
 
   std::string utf8;
@@ -2721,7 +2756,7 @@ AqlValue Functions::Split(ExpressionContext* expressionContext, transaction::Met
         continue;
       }
       uResults[i].toUTF8String(utf8);
-      result.add(VPackValue(utf8));
+      result->add(VPackValue(utf8));
       utf8.clear();
       i++;
       totalCount++;
@@ -2741,8 +2776,8 @@ AqlValue Functions::Split(ExpressionContext* expressionContext, transaction::Met
     }
   }
 
-  result.close();
-  return AqlValue(result);
+  result->close();
+  return AqlValue(result.get());
 }
 
 /// @brief function REGEX_MATCHES
@@ -2754,11 +2789,11 @@ AqlValue Functions::RegexMatches(ExpressionContext* expressionContext,
   AqlValue const& aqlValueToMatch = extractFunctionParameterValue(parameters, 0);
 
   if (parameters.size() == 1) {
-    VPackBuilder result;
-    result.openArray();
-    result.add(aqlValueToMatch.slice());
-    result.close();
-    return AqlValue(result);
+    transaction::BuilderLeaser result(trx);
+    result->openArray();
+    result->add(aqlValueToMatch.slice());
+    result->close();
+    return AqlValue(result.get());
   }
 
   bool const caseInsensitive = ::getBooleanParameter(trx, parameters, 2, false);
@@ -2786,15 +2821,15 @@ AqlValue Functions::RegexMatches(ExpressionContext* expressionContext,
   icu::UnicodeString valueToMatch(buffer->c_str(),
                                   static_cast<uint32_t>(buffer->length()));
 
-  VPackBuilder result;
-  result.openArray();
+  transaction::BuilderLeaser result(trx);
+  result->openArray();
 
   if (!isEmptyExpression && (buffer->length() == 0)) {
     // Edge case: splitting an empty string by non-empty expression produces an
     // empty string again.
-    result.add(VPackValue(""));
-    result.close();
-    return AqlValue(result);
+    result->add(VPackValue(""));
+    result->close();
+    return AqlValue(result.get());
   }
 
   UErrorCode status = U_ZERO_ERROR;
@@ -2813,12 +2848,12 @@ AqlValue Functions::RegexMatches(ExpressionContext* expressionContext,
     } else {
       std::string s;
       match.toUTF8String(s);
-      result.add(VPackValue(s));
+      result->add(VPackValue(s));
     }
   }
 
-  result.close();
-  return AqlValue(result);
+  result->close();
+  return AqlValue(result.get());
 }
 
 /// @brief function REGEX_SPLIT
@@ -2849,11 +2884,11 @@ AqlValue Functions::RegexSplit(ExpressionContext* expressionContext,
 
   if (parameters.size() == 1) {
     // pre-documented edge-case: if we only have the first parameter, return it.
-    VPackBuilder result;
-    result.openArray();
-    result.add(aqlValueToSplit.slice());
-    result.close();
-    return AqlValue(result);
+    transaction::BuilderLeaser result(trx);
+    result->openArray();
+    result->add(aqlValueToSplit.slice());
+    result->close();
+    return AqlValue(result.get());
   }
 
   bool const caseInsensitive = ::getBooleanParameter(trx, parameters, 2, false);
@@ -2880,14 +2915,14 @@ AqlValue Functions::RegexSplit(ExpressionContext* expressionContext,
   ::appendAsString(trx, adapter, value);
   icu::UnicodeString valueToSplit(buffer->c_str(), static_cast<int32_t>(buffer->length()));
 
-  VPackBuilder result;
-  result.openArray();
+  transaction::BuilderLeaser result(trx);
+  result->openArray();
   if (!isEmptyExpression && (buffer->length() == 0)) {
     // Edge case: splitting an empty string by non-empty expression produces an
     // empty string again.
-    result.add(VPackValue(""));
-    result.close();
-    return AqlValue(result);
+    result->add(VPackValue(""));
+    result->close();
+    return AqlValue(result.get());
   }
 
   std::string utf8;
@@ -2925,7 +2960,7 @@ AqlValue Functions::RegexSplit(ExpressionContext* expressionContext,
         continue;
       }
       uResults[i].toUTF8String(utf8);
-      result.add(VPackValue(utf8));
+      result->add(VPackValue(utf8));
       utf8.clear();
       i++;
       totalCount++;
@@ -2945,8 +2980,8 @@ AqlValue Functions::RegexSplit(ExpressionContext* expressionContext,
     }
   }
 
-  result.close();
-  return AqlValue(result);
+  result->close();
+  return AqlValue(result.get());
 }
 
 /// @brief function REGEX_TEST
@@ -3072,7 +3107,7 @@ AqlValue Functions::IsDatestring(ExpressionContext*, transaction::Methods*,
 
   if (value.isString()) {
     tp_sys_clock_ms tp;  // unused
-    isValid = basics::parseDateTime(value.slice().copyString(), tp);
+    isValid = basics::parseDateTime(arangodb::velocypack::StringRef(value.slice()), tp);
   }
 
   return AqlValue(AqlValueHintBool(isValid));
@@ -3821,33 +3856,33 @@ AqlValue Functions::Attributes(ExpressionContext* expressionContext,
     std::set<std::string, arangodb::basics::VelocyPackHelper::AttributeSorterUTF8> keys;
 
     VPackCollection::keys(slice, keys);
-    VPackBuilder result;
-    result.openArray();
+    transaction::BuilderLeaser result(trx);
+    result->openArray();
     for (auto const& it : keys) {
       TRI_ASSERT(!it.empty());
       if (removeInternal && !it.empty() && it.at(0) == '_') {
         continue;
       }
-      result.add(VPackValue(it));
+      result->add(VPackValue(it));
     }
-    result.close();
+    result->close();
 
-    return AqlValue(result);
+    return AqlValue(result.get());
   }
 
   std::unordered_set<std::string> keys;
   VPackCollection::keys(slice, keys);
 
-  VPackBuilder result;
-  result.openArray();
+  transaction::BuilderLeaser result(trx);
+  result->openArray();
   for (auto const& it : keys) {
     if (removeInternal && !it.empty() && it.at(0) == '_') {
       continue;
     }
-    result.add(VPackValue(it));
+    result->add(VPackValue(it));
   }
-  result.close();
-  return AqlValue(result);
+  result->close();
+  return AqlValue(result.get());
 }
 
 /// @brief function VALUES
@@ -4276,6 +4311,34 @@ AqlValue Functions::CountDistinct(ExpressionContext* expressionContext,
   return AqlValue(AqlValueHintUInt(values.size()));
 }
 
+/// @brief function APPROX_COUNT_DISTINCT
+AqlValue Functions::ApproxCountDistinct(ExpressionContext* expressionContext,
+                                        transaction::Methods* trx,
+                                        VPackFunctionParameters const& parameters) {
+  static char const* AFN = "APPROX_COUNT_DISTINCT";
+
+  AqlValue const& value = extractFunctionParameterValue(parameters, 0);
+
+  if (!value.isArray()) {
+    // not an array
+    ::registerWarning(expressionContext, AFN, TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    return AqlValue(AqlValueHintNull());
+  }
+
+  AqlValueMaterializer materializer(trx);
+  VPackSlice slice = materializer.slice(value, false);
+
+  basics::HyperLogLog sketch;
+  for (VPackSlice s : VPackArrayIterator(slice)) {
+    if (!s.isNone()) {
+      // values that compare equal in AQL (e.g. 1 and 1.0) are counted once
+      sketch.insert(s.resolveExternal().normalizedHash());
+    }
+  }
+
+  return AqlValue(AqlValueHintUInt(static_cast<uint64_t>(std::llround(sketch.estimate()))));
+}
+
 /// @brief function UNIQUE
 AqlValue Functions::Unique(ExpressionContext* expressionContext, transaction::Methods* trx,
                            VPackFunctionParameters const& parameters) {
@@ -4810,7 +4873,7 @@ AqlValue Functions::IsInPolygon(ExpressionContext* expressionContext,
 /// @brief geo constructors
 
 /// @brief function GEO_POINT
-AqlValue Functions::GeoPoint(ExpressionContext* expressionContext, transaction::Methods*,
+AqlValue Functions::GeoPoint(ExpressionContext* expressionContext, transaction::Methods* trx,
                              VPackFunctionParameters const& parameters) {
   size_t const n = parameters.size();
 
@@ -4842,17 +4905,17 @@ AqlValue Functions::GeoPoint(ExpressionContext* expressionContext, transaction::
     return AqlValue(arangodb::velocypack::Slice::nullSlice());
   }
 
-  VPackBuilder b;
+  transaction::BuilderLeaser b(trx);
 
-  b.add(VPackValue(VPackValueType::Object));
-  b.add("type", VPackValue("Point"));
-  b.add("coordinates", VPackValue(VPackValueType::Array));
-  b.add(VPackValue(lon1Value));
-  b.add(VPackValue(lat1Value));
-  b.close();
-  b.close();
+  b->add(VPackValue(VPackValueType::Object));
+  b->add("type", VPackValue("Point"));
+  b->add("coordinates", VPackValue(VPackValueType::Array));
+  b->add(VPackValue(lon1Value));
+  b->add(VPackValue(lat1Value));
+  b->close();
+  b->close();
 
-  return AqlValue(b);
+  return AqlValue(b.get());
 }
 
 /// @brief function GEO_MULTIPOINT
@@ -4879,20 +4942,20 @@ AqlValue Functions::GeoMultiPoint(ExpressionContext* expressionContext,
     return AqlValue(arangodb::velocypack::Slice::nullSlice());
   }
 
-  VPackBuilder b;
+  transaction::BuilderLeaser b(trx);
 
-  b.add(VPackValue(VPackValueType::Object));
-  b.add("type", VPackValue("MultiPoint"));
-  b.add("coordinates", VPackValue(VPackValueType::Array));
+  b->add(VPackValue(VPackValueType::Object));
+  b->add("type", VPackValue("MultiPoint"));
+  b->add("coordinates", VPackValue(VPackValueType::Array));
 
   AqlValueMaterializer materializer(trx);
   VPackSlice s = materializer.slice(geoArray, false);
   for (auto const& v : VPackArrayIterator(s)) {
     if (v.isArray()) {
-      b.openArray();
+      b->openArray();
       for (auto const& coord : VPackArrayIterator(v)) {
         if (coord.isNumber()) {
-          b.add(VPackValue(coord.getNumber<double>()));
+          b->add(VPackValue(coord.getNumber<double>()));
         } else {
           ::registerWarning(expressionContext, "GEO_MULTIPOINT",
                             Result(TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH,
@@ -4900,7 +4963,7 @@ AqlValue Functions::GeoMultiPoint(ExpressionContext* expressionContext,
           return AqlValue(arangodb::velocypack::Slice::nullSlice());
         }
       }
-      b.close();
+      b->close();
     } else {
       ::registerWarning(expressionContext, "GEO_MULTIPOINT",
                         Result(TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH,
@@ -4909,10 +4972,10 @@ AqlValue Functions::GeoMultiPoint(ExpressionContext* expressionContext,
     }
   }
 
-  b.close();
-  b.close();
+  b->close();
+  b->close();
 
-  return AqlValue(b);
+  return AqlValue(b.get());
 }
 
 /// @brief function GEO_POLYGON
@@ -4933,24 +4996,24 @@ AqlValue Functions::GeoPolygon(ExpressionContext* expressionContext,
     return AqlValue(arangodb::velocypack::Slice::nullSlice());
   }
 
-  VPackBuilder b;
-  b.openObject();
-  b.add("type", VPackValue("Polygon"));
-  b.add("coordinates", VPackValue(VPackValueType::Array));
+  transaction::BuilderLeaser b(trx);
+  b->openObject();
+  b->add("type", VPackValue("Polygon"));
+  b->add("coordinates", VPackValue(VPackValueType::Array));
 
   AqlValueMaterializer materializer(trx);
   VPackSlice s = materializer.slice(geoArray, false);
 
-  Result res = ::parseGeoPolygon(s, b);
+  Result res = ::parseGeoPolygon(s, *b.get());
   if (res.fail()) {
     ::registerWarning(expressionContext, "GEO_POLYGON", res);
     return AqlValue(arangodb::velocypack::Slice::nullSlice());
   }
 
-  b.close(); // coordinates
-  b.close(); // object
+  b->close(); // coordinates
+  b->close(); // object
 
-  return AqlValue(b);
+  return AqlValue(b.get());
 }
 
 /// @brief function GEO_MULTIPOLYGON
@@ -4995,10 +5058,10 @@ AqlValue Functions::GeoMultiPolygon(ExpressionContext* expressionContext,
     return AqlValue(arangodb::velocypack::Slice::nullSlice());
   }
 
-  VPackBuilder b;
-  b.openObject();
-  b.add("type", VPackValue("MultiPolygon"));
-  b.add("coordinates", VPackValue(VPackValueType::Array));
+  transaction::BuilderLeaser b(trx);
+  b->openObject();
+  b->add("type", VPackValue("MultiPolygon"));
+  b->add("coordinates", VPackValue(VPackValueType::Array));
 
   for (auto const& arrayOfPolygons : VPackArrayIterator(s)) {
     if (!arrayOfPolygons.isArray()) {
@@ -5007,21 +5070,21 @@ AqlValue Functions::GeoMultiPolygon(ExpressionContext* expressionContext,
             "a MultiPolygon needs at least two Polygons inside."));
       return AqlValue(arangodb::velocypack::Slice::nullSlice());
     }
-    b.openArray(); //arrayOfPolygons
+    b->openArray(); //arrayOfPolygons
     for (auto const& v : VPackArrayIterator(arrayOfPolygons)) {
-      Result res = ::parseGeoPolygon(v, b);
+      Result res = ::parseGeoPolygon(v, *b.get());
       if (res.fail()) {
         ::registerWarning(expressionContext, "GEO_MULTIPOLYGON", res);
         return AqlValue(arangodb::velocypack::Slice::nullSlice());
       }
     }
-    b.close(); //arrayOfPolygons close
+    b->close(); //arrayOfPolygons close
   }
 
-  b.close();
-  b.close();
+  b->close();
+  b->close();
 
-  return AqlValue(b);
+  return AqlValue(b.get());
 }
 
 /// @brief function GEO_LINESTRING
@@ -5048,20 +5111,20 @@ AqlValue Functions::GeoLinestring(ExpressionContext* expressionContext,
     return AqlValue(arangodb::velocypack::Slice::nullSlice());
   }
 
-  VPackBuilder b;
+  transaction::BuilderLeaser b(trx);
 
-  b.add(VPackValue(VPackValueType::Object));
-  b.add("type", VPackValue("LineString"));
-  b.add("coordinates", VPackValue(VPackValueType::Array));
+  b->add(VPackValue(VPackValueType::Object));
+  b->add("type", VPackValue("LineString"));
+  b->add("coordinates", VPackValue(VPackValueType::Array));
 
   AqlValueMaterializer materializer(trx);
   VPackSlice s = materializer.slice(geoArray, false);
   for (auto const& v : VPackArrayIterator(s)) {
     if (v.isArray()) {
-      b.openArray();
+      b->openArray();
       for (auto const& coord : VPackArrayIterator(v)) {
         if (coord.isNumber()) {
-          b.add(VPackValue(coord.getNumber<double>()));
+          b->add(VPackValue(coord.getNumber<double>()));
         } else {
           ::registerWarning(expressionContext, "GEO_LINESTRING",
                             Result(TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH,
@@ -5069,7 +5132,7 @@ AqlValue Functions::GeoLinestring(ExpressionContext* expressionContext,
           return AqlValue(arangodb::velocypack::Slice::nullSlice());
         }
       }
-      b.close();
+      b->close();
     } else {
       ::registerWarning(expressionContext, "GEO_LINESTRING",
                         Result(TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH,
@@ -5078,10 +5141,10 @@ AqlValue Functions::GeoLinestring(ExpressionContext* expressionContext,
     }
   }
 
-  b.close();
-  b.close();
+  b->close();
+  b->close();
 
-  return AqlValue(b);
+  return AqlValue(b.get());
 }
 
 /// @brief function GEO_MULTILINESTRING
@@ -5109,24 +5172,24 @@ AqlValue Functions::GeoMultiLinestring(ExpressionContext* expressionContext,
     return AqlValue(arangodb::velocypack::Slice::nullSlice());
   }
 
-  VPackBuilder b;
+  transaction::BuilderLeaser b(trx);
 
-  b.add(VPackValue(VPackValueType::Object));
-  b.add("type", VPackValue("MultiLineString"));
-  b.add("coordinates", VPackValue(VPackValueType::Array));
+  b->add(VPackValue(VPackValueType::Object));
+  b->add("type", VPackValue("MultiLineString"));
+  b->add("coordinates", VPackValue(VPackValueType::Array));
 
   AqlValueMaterializer materializer(trx);
   VPackSlice s = materializer.slice(geoArray, false);
   for (auto const& v : VPackArrayIterator(s)) {
     if (v.isArray()) {
       if (v.length() > 1) {
-        b.openArray();
+        b->openArray();
         for (auto const& inner : VPackArrayIterator(v)) {
           if (inner.isArray()) {
-            b.openArray();
+            b->openArray();
             for (auto const& coord : VPackArrayIterator(inner)) {
               if (coord.isNumber()) {
-                b.add(VPackValue(coord.getNumber<double>()));
+                b->add(VPackValue(coord.getNumber<double>()));
               } else {
                 ::registerWarning(expressionContext, "GEO_MULTILINESTRING",
                                   Result(TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH,
@@ -5134,7 +5197,7 @@ AqlValue Functions::GeoMultiLinestring(ExpressionContext* expressionContext,
                 return AqlValue(arangodb::velocypack::Slice::nullSlice());
               }
             }
-            b.close();
+            b->close();
           } else {
             ::registerWarning(expressionContext, "GEO_MULTILINESTRING",
                               Result(TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH,
@@ -5142,7 +5205,7 @@ AqlValue Functions::GeoMultiLinestring(ExpressionContext* expressionContext,
             return AqlValue(arangodb::velocypack::Slice::nullSlice());
           }
         }
-        b.close();
+        b->close();
       } else {
         ::registerWarning(expressionContext, "GEO_MULTILINESTRING",
                           Result(TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH,
@@ -5157,10 +5220,10 @@ AqlValue Functions::GeoMultiLinestring(ExpressionContext* expressionContext,
     }
   }
 
-  b.close();
-  b.close();
+  b->close();
+  b->close();
 
-  return AqlValue(b);
+  return AqlValue(b.get());
 }
 
 /// @brief function FLATTEN
@@ -6829,7 +6892,8 @@ AqlValue Functions::DateFormat(ExpressionContext* expressionContext,
     return AqlValue(AqlValueHintNull());
   }
 
-  return AqlValue(arangodb::basics::formatDate(aqlFormatString.slice().copyString(), tp));
+  return AqlValue(arangodb::basics::formatDate(
+      arangodb::velocypack::StringRef(aqlFormatString.slice()), tp));
 }
 
 /// @brief function DECODE_REV
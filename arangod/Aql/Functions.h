@@ -280,6 +280,8 @@ struct Functions {
                         transaction::Methods*, VPackFunctionParameters const&);
   static AqlValue CountDistinct(arangodb::aql::ExpressionContext*,
                                 transaction::Methods*, VPackFunctionParameters const&);
+  static AqlValue ApproxCountDistinct(arangodb::aql::ExpressionContext*,
+                                      transaction::Methods*, VPackFunctionParameters const&);
   static AqlValue CheckDocument(arangodb::aql::ExpressionContext*,
                                 transaction::Methods*, VPackFunctionParameters const&);
   static AqlValue Unique(arangodb::aql::ExpressionContext*,
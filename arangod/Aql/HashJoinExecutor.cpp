@@ -0,0 +1,195 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "HashJoinExecutor.h"
+
+#include "Aql/AqlValue.h"
+#include "Aql/Collection.h"
+#include "Aql/ResourceUsage.h"
+#include "Aql/SingleRowFetcher.h"
+#include "Basics/VelocyPackHelper.h"
+#include "Transaction/Context.h"
+#include "Transaction/Methods.h"
+#include "Utils/OperationCursor.h"
+
+#include <velocypack/Slice.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include <algorithm>
+#include <utility>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace {
+/// @brief approximate memory usage of a hash table entry
+constexpr size_t tableEntrySize = 4 * sizeof(void*);
+
+VPackSlice orNull(VPackSlice slice) {
+  return slice.isNone() ? VPackSlice::nullSlice() : slice;
+}
+}  // namespace
+
+HashJoinExecutorInfos::HashJoinExecutorInfos(
+    RegisterId outerRegister, RegisterId outputRegister,
+    RegisterId nrInputRegisters, RegisterId nrOutputRegisters,
+    // cppcheck-suppress passedByValue
+    std::unordered_set<RegisterId> registersToClear,
+    // cppcheck-suppress passedByValue
+    std::unordered_set<RegisterId> registersToKeep,
+    Collection const* collection, transaction::Methods* trxPtr,
+    ResourceMonitor* resourceMonitor, std::vector<std::string> outerAttribute,
+    std::vector<std::string> innerAttribute)
+    : ExecutorInfos(make_shared_unordered_set({outerRegister}),
+                    make_shared_unordered_set({outputRegister}),
+                    nrInputRegisters, nrOutputRegisters,
+                    std::move(registersToClear), std::move(registersToKeep)),
+      _outerRegister(outerRegister),
+      _outputRegister(outputRegister),
+      _collection(collection),
+      _trxPtr(trxPtr),
+      _resourceMonitor(resourceMonitor),
+      _outerAttribute(std::move(outerAttribute)),
+      _innerAttribute(std::move(innerAttribute)) {}
+
+HashJoinExecutor::HashJoinExecutor(Fetcher& fetcher, Infos& infos)
+    : _infos(infos),
+      _fetcher(fetcher),
+      _state(ExecutionState::HASMORE),
+      _input(InputAqlItemRow{CreateInvalidInputRowHint{}}),
+      _tableBuilt(false),
+      _memoryUsage(0),
+      _matchPosition(0) {}
+
+HashJoinExecutor::~HashJoinExecutor() {
+  _infos.resourceMonitor()->decreaseMemoryUsage(_memoryUsage);
+}
+
+std::pair<ExecutionState, EnumerateCollectionStats> HashJoinExecutor::produceRows(
+    OutputAqlItemRow& output) {
+  TRI_IF_FAILURE("HashJoinExecutor::produceRows") {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+  }
+  EnumerateCollectionStats stats{};
+
+  while (true) {
+    if (_matchPosition < _matches.size()) {
+      TRI_ASSERT(_input.isInitialized());
+      uint8_t const* document = _documents.data() + _matches[_matchPosition++];
+      AqlValue v{AqlValueHintCopy{document}};
+      AqlValueGuard guard{v, true};
+      output.moveValueInto(_infos.outputRegister(), _input, guard);
+
+      if (_state == ExecutionState::DONE && _matchPosition == _matches.size()) {
+        return {ExecutionState::DONE, stats};
+      }
+      return {ExecutionState::HASMORE, stats};
+    }
+
+    if (_state == ExecutionState::DONE) {
+      return {_state, stats};
+    }
+
+    std::tie(_state, _input) = _fetcher.fetchRow();
+
+    if (_state == ExecutionState::WAITING) {
+      return {_state, stats};
+    }
+
+    if (!_input) {
+      TRI_ASSERT(_state == ExecutionState::DONE);
+      return {_state, stats};
+    }
+
+    if (!_tableBuilt) {
+      // only read the collection once there is something to join with
+      buildTable(stats);
+    }
+    findMatches();
+  }
+}
+
+void HashJoinExecutor::initializeCursor() {
+  _state = ExecutionState::HASMORE;
+  _input = InputAqlItemRow{CreateInvalidInputRowHint{}};
+  _matches.clear();
+  _matchPosition = 0;
+}
+
+VPackSlice HashJoinExecutor::innerKey(uint8_t const* document) const {
+  return ::orNull(VPackSlice(document).get(_infos.innerAttribute()));
+}
+
+void HashJoinExecutor::buildTable(EnumerateCollectionStats& stats) {
+  TRI_ASSERT(!_tableBuilt);
+  transaction::Methods* trx = _infos.trxPtr();
+  ResourceMonitor* monitor = _infos.resourceMonitor();
+
+  OperationCursor cursor(trx->indexScan(_infos.collection()->name(),
+                                        transaction::Methods::CursorType::ALL));
+  size_t scanned = 0;
+
+  cursor.allDocuments(
+      [&](LocalDocumentId const&, VPackSlice document) {
+        document = document.resolveExternal();
+        size_t const size = document.byteSize();
+        monitor->increaseMemoryUsage(size + ::tableEntrySize);
+        _memoryUsage += size + ::tableEntrySize;
+
+        size_t const offset = _documents.size();
+        _documents.append(document.begin(), size);
+        _table.emplace(innerKey(_documents.data() + offset).normalizedHash(), offset);
+        ++scanned;
+      },
+      1000);
+
+  stats.incrScanned(scanned);
+  _tableBuilt = true;
+}
+
+void HashJoinExecutor::findMatches() {
+  TRI_ASSERT(_tableBuilt);
+  TRI_ASSERT(_input.isInitialized());
+  _matches.clear();
+  _matchPosition = 0;
+
+  transaction::Methods* trx = _infos.trxPtr();
+  AqlValue const& outer = _input.getValue(_infos.outerRegister());
+
+  bool mustDestroy = false;
+  AqlValue key = outer.get(*trx->resolver(), _infos.outerAttribute(), mustDestroy, false);
+  AqlValueGuard guard(key, mustDestroy);
+  AqlValueMaterializer materializer(trx);
+  VPackSlice outerKey = ::orNull(materializer.slice(key, false));
+
+  VPackOptions const* options = trx->transactionContextPtr()->getVPackOptions();
+  auto range = _table.equal_range(outerKey.normalizedHash());
+  for (auto it = range.first; it != range.second; ++it) {
+    // hash collisions, and values that hash alike without being equal
+    if (basics::VelocyPackHelper::compare(outerKey, innerKey(_documents.data() + it->second),
+                                          true, options) == 0) {
+      _matches.emplace_back(it->second);
+    }
+  }
+
+  // the multimap does not keep the insertion order within a bucket,
+  // produce the documents in collection order
+  std::sort(_matches.begin(), _matches.end());
+}
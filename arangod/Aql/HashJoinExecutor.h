@@ -0,0 +1,160 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_AQL_HASH_JOIN_EXECUTOR_H
+#define ARANGOD_AQL_HASH_JOIN_EXECUTOR_H
+
+#include "Aql/ExecutionState.h"
+#include "Aql/ExecutorInfos.h"
+#include "Aql/InputAqlItemRow.h"
+#include "Aql/OutputAqlItemRow.h"
+#include "Aql/SingleRowFetcher.h"
+#include "Aql/Stats.h"
+
+#include <velocypack/Buffer.h>
+#include <velocypack/Slice.h>
+
+#include <memory>
+#include <unordered_map>
+
+namespace arangodb {
+namespace transaction {
+class Methods;
+}
+
+namespace aql {
+
+struct Collection;
+struct ResourceMonitor;
+
+class HashJoinExecutorInfos : public ExecutorInfos {
+ public:
+  HashJoinExecutorInfos(RegisterId outerRegister, RegisterId outputRegister,
+                        RegisterId nrInputRegisters, RegisterId nrOutputRegisters,
+                        std::unordered_set<RegisterId> registersToClear,
+                        std::unordered_set<RegisterId> registersToKeep,
+                        Collection const* collection, transaction::Methods* trxPtr,
+                        ResourceMonitor* resourceMonitor,
+                        std::vector<std::string> outerAttribute,
+                        std::vector<std::string> innerAttribute);
+
+  HashJoinExecutorInfos() = delete;
+  HashJoinExecutorInfos(HashJoinExecutorInfos&&) = default;
+  HashJoinExecutorInfos(HashJoinExecutorInfos const&) = delete;
+  ~HashJoinExecutorInfos() = default;
+
+  RegisterId outerRegister() const { return _outerRegister; }
+  RegisterId outputRegister() const { return _outputRegister; }
+  Collection const* collection() const { return _collection; }
+  transaction::Methods* trxPtr() const { return _trxPtr; }
+  ResourceMonitor* resourceMonitor() const { return _resourceMonitor; }
+  std::vector<std::string> const& outerAttribute() const {
+    return _outerAttribute;
+  }
+  std::vector<std::string> const& innerAttribute() const {
+    return _innerAttribute;
+  }
+
+ private:
+  /// @brief register of the outer variable
+  RegisterId const _outerRegister;
+
+  /// @brief register to write the matching inner documents into
+  RegisterId const _outputRegister;
+
+  Collection const* _collection;
+  transaction::Methods* _trxPtr;
+  ResourceMonitor* _resourceMonitor;
+  std::vector<std::string> const _outerAttribute;
+  std::vector<std::string> const _innerAttribute;
+};
+
+/**
+ * @brief Implementation of HashJoin Node. Reads the inner collection into a
+ *        hash table once, and produces the matching documents for each
+ *        incoming row.
+ */
+class HashJoinExecutor {
+ public:
+  struct Properties {
+    static const bool preservesOrder = true;
+    static const bool allowsBlockPassthrough = false;
+    static const bool inputSizeRestrictsOutputSize = false;
+  };
+  using Fetcher = SingleRowFetcher<Properties::allowsBlockPassthrough>;
+  using Infos = HashJoinExecutorInfos;
+  using Stats = EnumerateCollectionStats;
+
+  HashJoinExecutor() = delete;
+  HashJoinExecutor(HashJoinExecutor&&) = default;
+  HashJoinExecutor(HashJoinExecutor const&) = delete;
+  HashJoinExecutor(Fetcher& fetcher, Infos& infos);
+  ~HashJoinExecutor();
+
+  /**
+   * @brief produce the next Row of Aql Values.
+   *
+   * @return ExecutionState, and if successful exactly one new Row of AqlItems.
+   */
+  std::pair<ExecutionState, Stats> produceRows(OutputAqlItemRow& output);
+
+  /// @brief keeps the hash table, the collection does not change within
+  /// the query
+  void initializeCursor();
+
+  inline std::pair<ExecutionState, size_t> expectedNumberOfRows(size_t) const {
+    TRI_ASSERT(false);
+    THROW_ARANGO_EXCEPTION_MESSAGE(
+        TRI_ERROR_INTERNAL,
+        "Logic_error, prefetching number fo rows not supported");
+  }
+
+ private:
+  void buildTable(Stats& stats);
+  void findMatches();
+
+  /// @brief the join attribute of an inner document, null if missing
+  velocypack::Slice innerKey(uint8_t const* document) const;
+
+ private:
+  Infos& _infos;
+  Fetcher& _fetcher;
+
+  ExecutionState _state;
+  InputAqlItemRow _input;
+
+  /// @brief the documents of the inner collection, back to back
+  velocypack::Buffer<uint8_t> _documents;
+  /// @brief normalized hash of the join attribute => document offset
+  std::unordered_multimap<uint64_t, size_t> _table;
+  bool _tableBuilt;
+
+  /// @brief memory accounted with the query for documents and table
+  size_t _memoryUsage;
+
+  /// @brief offsets of the documents matching the current input row
+  std::vector<size_t> _matches;
+  size_t _matchPosition;
+};
+
+}  // namespace aql
+}  // namespace arangodb
+
+#endif
@@ -0,0 +1,158 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "HashJoinNode.h"
+#include "Aql/Ast.h"
+#include "Aql/Collection.h"
+#include "Aql/ExecutionBlockImpl.h"
+#include "Aql/ExecutionPlan.h"
+#include "Aql/HashJoinExecutor.h"
+#include "Aql/Query.h"
+#include "Transaction/Methods.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace {
+std::vector<std::string> attributeFromVPack(VPackSlice base, char const* name) {
+  std::vector<std::string> result;
+  VPackSlice attribute = base.get(name);
+  if (!attribute.isArray() || attribute.length() == 0) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                   std::string("invalid attribute '") + name +
+                                       "' for HashJoinNode");
+  }
+  for (VPackSlice it : VPackArrayIterator(attribute)) {
+    result.emplace_back(it.copyString());
+  }
+  return result;
+}
+
+void attributeToVPack(VPackBuilder& nodes, char const* name,
+                      std::vector<std::string> const& attribute) {
+  nodes.add(VPackValue(name));
+  nodes.openArray();
+  for (auto const& it : attribute) {
+    nodes.add(VPackValue(it));
+  }
+  nodes.close();
+}
+}  // namespace
+
+HashJoinNode::HashJoinNode(ExecutionPlan* plan, size_t id, aql::Collection const* collection,
+                           Variable const* outVariable, Variable const* outerVariable,
+                           std::vector<std::string> outerAttribute,
+                           std::vector<std::string> innerAttribute)
+    : ExecutionNode(plan, id),
+      CollectionAccessingNode(collection),
+      _outVariable(outVariable),
+      _outerVariable(outerVariable),
+      _outerAttribute(std::move(outerAttribute)),
+      _innerAttribute(std::move(innerAttribute)) {
+  TRI_ASSERT(_outVariable != nullptr);
+  TRI_ASSERT(_outerVariable != nullptr);
+  TRI_ASSERT(!_outerAttribute.empty());
+  TRI_ASSERT(!_innerAttribute.empty());
+}
+
+HashJoinNode::HashJoinNode(ExecutionPlan* plan, arangodb::velocypack::Slice const& base)
+    : ExecutionNode(plan, base),
+      CollectionAccessingNode(plan, base),
+      _outVariable(Variable::varFromVPack(plan->getAst(), base, "outVariable")),
+      _outerVariable(Variable::varFromVPack(plan->getAst(), base, "outerVariable")),
+      _outerAttribute(::attributeFromVPack(base, "outerAttribute")),
+      _innerAttribute(::attributeFromVPack(base, "innerAttribute")) {}
+
+void HashJoinNode::toVelocyPackHelper(VPackBuilder& nodes, unsigned flags) const {
+  // call base class method
+  ExecutionNode::toVelocyPackHelperGeneric(nodes, flags);
+
+  // add collection information
+  CollectionAccessingNode::toVelocyPack(nodes);
+
+  nodes.add(VPackValue("outVariable"));
+  _outVariable->toVelocyPack(nodes);
+
+  nodes.add(VPackValue("outerVariable"));
+  _outerVariable->toVelocyPack(nodes);
+
+  ::attributeToVPack(nodes, "outerAttribute", _outerAttribute);
+  ::attributeToVPack(nodes, "innerAttribute", _innerAttribute);
+
+  // And close it:
+  nodes.close();
+}
+
+std::unique_ptr<ExecutionBlock> HashJoinNode::createBlock(
+    ExecutionEngine& engine, std::unordered_map<ExecutionNode*, ExecutionBlock*> const&) const {
+  ExecutionNode const* previousNode = getFirstDependency();
+  TRI_ASSERT(previousNode != nullptr);
+
+  RegisterId outerRegister = variableToRegisterId(_outerVariable);
+  RegisterId outputRegister = variableToRegisterId(_outVariable);
+
+  Query* query = _plan->getAst()->query();
+
+  HashJoinExecutorInfos infos(outerRegister, outputRegister,
+                              getRegisterPlan()->nrRegs[previousNode->getDepth()],
+                              getRegisterPlan()->nrRegs[getDepth()],
+                              getRegsToClear(), calcRegsToKeep(), _collection,
+                              query->trx(), query->resourceMonitor(),
+                              _outerAttribute, _innerAttribute);
+
+  return std::make_unique<ExecutionBlockImpl<HashJoinExecutor>>(&engine, this,
+                                                                std::move(infos));
+}
+
+ExecutionNode* HashJoinNode::clone(ExecutionPlan* plan, bool withDependencies,
+                                   bool withProperties) const {
+  auto outVariable = _outVariable;
+  auto outerVariable = _outerVariable;
+
+  if (withProperties) {
+    outVariable = plan->getAst()->variables()->createVariable(outVariable);
+    outerVariable = plan->getAst()->variables()->createVariable(outerVariable);
+  }
+
+  auto c = std::make_unique<HashJoinNode>(plan, _id, _collection, outVariable,
+                                          outerVariable, _outerAttribute, _innerAttribute);
+
+  return cloneHelper(std::move(c), withDependencies, withProperties);
+}
+
+/// @brief the collection is read only once to build the hash table, then
+/// every incoming row costs a lookup. there are no statistics about the
+/// join attribute, so each row is assumed to find one partner, as it is
+/// the case for foreign keys
+CostEstimate HashJoinNode::estimateCost() const {
+  transaction::Methods* trx = _plan->getAst()->query()->trx();
+  if (trx->status() != transaction::Status::RUNNING) {
+    return CostEstimate::empty();
+  }
+
+  TRI_ASSERT(!_dependencies.empty());
+  CostEstimate estimate = _dependencies.at(0)->getCost();
+  estimate.estimatedCost += 2.0 * _collection->count(trx) + estimate.estimatedNrItems + 1.0;
+  return estimate;
+}
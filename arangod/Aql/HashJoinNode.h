@@ -0,0 +1,112 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_AQL_HASH_JOIN_NODE_H
+#define ARANGOD_AQL_HASH_JOIN_NODE_H 1
+
+#include "Aql/CollectionAccessingNode.h"
+#include "Aql/ExecutionNode.h"
+#include "Aql/Variable.h"
+#include "Basics/Common.h"
+
+#include <velocypack/Slice.h>
+
+namespace arangodb {
+namespace aql {
+struct Collection;
+class ExecutionBlock;
+class ExecutionEngine;
+class ExecutionPlan;
+
+/// @brief class HashJoinNode, replaces the full scan of the inner collection
+/// of an equi-join. the documents of the collection are read once into a
+/// hash table on their join attribute, and each incoming row only produces
+/// the documents whose join attribute equals the one of the outer variable.
+/// the join condition itself stays in the plan and is still evaluated
+class HashJoinNode : public ExecutionNode, public CollectionAccessingNode {
+ public:
+  HashJoinNode(ExecutionPlan* plan, size_t id, aql::Collection const* collection,
+               Variable const* outVariable, Variable const* outerVariable,
+               std::vector<std::string> outerAttribute,
+               std::vector<std::string> innerAttribute);
+
+  HashJoinNode(ExecutionPlan* plan, arangodb::velocypack::Slice const& base);
+
+  /// @brief return the type of the node
+  NodeType getType() const override final { return HASH_JOIN; }
+
+  /// @brief export to VelocyPack
+  void toVelocyPackHelper(arangodb::velocypack::Builder& nodes,
+                          unsigned flags) const override final;
+
+  /// @brief creates corresponding ExecutionBlock
+  std::unique_ptr<ExecutionBlock> createBlock(
+      ExecutionEngine& engine,
+      std::unordered_map<ExecutionNode*, ExecutionBlock*> const&) const override;
+
+  /// @brief clone ExecutionNode recursively
+  ExecutionNode* clone(ExecutionPlan* plan, bool withDependencies,
+                       bool withProperties) const override final;
+
+  /// @brief estimateCost
+  CostEstimate estimateCost() const override final;
+
+  /// @brief getVariablesUsedHere, modifying the set in-place
+  void getVariablesUsedHere(arangodb::HashSet<Variable const*>& vars) const override final {
+    vars.emplace(_outerVariable);
+  }
+
+  /// @brief getVariablesSetHere
+  std::vector<Variable const*> getVariablesSetHere() const override final {
+    return std::vector<Variable const*>{_outVariable};
+  }
+
+  /// @brief return the out variable
+  Variable const* outVariable() const { return _outVariable; }
+
+  /// @brief the variable of the outer loop the join attribute is read from
+  Variable const* outerVariable() const { return _outerVariable; }
+
+  std::vector<std::string> const& outerAttribute() const {
+    return _outerAttribute;
+  }
+
+  std::vector<std::string> const& innerAttribute() const {
+    return _innerAttribute;
+  }
+
+ private:
+  /// @brief the documents of the inner collection
+  Variable const* _outVariable;
+
+  /// @brief the variable of the outer loop
+  Variable const* _outerVariable;
+
+  /// @brief join attribute path of the outer variable
+  std::vector<std::string> const _outerAttribute;
+
+  /// @brief join attribute path of the inner documents
+  std::vector<std::string> const _innerAttribute;
+};
+
+}  // namespace aql
+}  // namespace arangodb
+
+#endif
@@ -49,7 +49,7 @@ HashedCollectExecutorInfos::HashedCollectExecutorInfos(
     std::vector<std::pair<RegisterId, RegisterId>>&& groupRegisters,
     RegisterId collectRegister, std::vector<std::string>&& aggregateTypes,
     std::vector<std::pair<RegisterId, RegisterId>>&& aggregateRegisters,
-    transaction::Methods* trxPtr, bool count)
+    transaction::Methods* trxPtr, bool count, ResourceMonitor* resourceMonitor)
     : ExecutorInfos(std::make_shared<std::unordered_set<RegisterId>>(readableInputRegisters),
                     std::make_shared<std::unordered_set<RegisterId>>(writeableOutputRegisters),
                     nrInputRegisters, nrOutputRegisters,
@@ -59,7 +59,8 @@ HashedCollectExecutorInfos::HashedCollectExecutorInfos(
       _groupRegisters(groupRegisters),
       _collectRegister(collectRegister),
       _count(count),
-      _trxPtr(trxPtr) {
+      _trxPtr(trxPtr),
+      _resourceMonitor(resourceMonitor) {
   TRI_ASSERT(!_groupRegisters.empty());
 }
 
@@ -91,10 +92,9 @@ HashedCollectExecutor::HashedCollectExecutor(Fetcher& fetcher, Infos& infos)
       _fetcher(fetcher),
       _upstreamState(ExecutionState::HASMORE),
       _lastInitializedInputRow(InputAqlItemRow{CreateInvalidInputRowHint{}}),
-      _allGroups(1024,
-                 AqlValueGroupHash(_infos.getTransaction(),
-                                   _infos.getGroupRegisters().size()),
-                 AqlValueGroupEqual(_infos.getTransaction())),
+      _allGroups(_infos.getTransaction(), _infos.getGroupRegisters().size(),
+                 _infos.getResourceMonitor()),
+      _currentGroup(0),
       _isInitialized(false),
       _aggregatorFactories(),
       _returnedGroups(0) {
@@ -102,45 +102,37 @@ HashedCollectExecutor::HashedCollectExecutor(Fetcher& fetcher, Infos& infos)
   _nextGroupValues.reserve(_infos.getGroupRegisters().size());
 };
 
-HashedCollectExecutor::~HashedCollectExecutor() {
-  // Generally, _allGroups should be empty when the block is destroyed - except
-  // when an exception is thrown during getOrSkipSome, in which case the
-  // AqlValue ownership hasn't been transferred.
-  destroyAllGroupsAqlValues();
-}
-
-void HashedCollectExecutor::destroyAllGroupsAqlValues() {
-  for (auto& it : _allGroups) {
-    for (auto& it2 : it.first) {
-      const_cast<AqlValue*>(&it2)->destroy();
-    }
-  }
-}
+// Generally, all group values have been moved to the output when the block is
+// destroyed - except when an exception is thrown during getOrSkipSome, in
+// which case the AqlValue ownership hasn't been transferred, and _allGroups
+// will destroy them.
+HashedCollectExecutor::~HashedCollectExecutor() = default;
 
 void HashedCollectExecutor::consumeInputRow(InputAqlItemRow& input) {
   TRI_ASSERT(input.isInitialized());
 
-  decltype(_allGroups)::iterator currentGroupIt = findOrEmplaceGroup(input);
+  size_t const group = findOrEmplaceGroup(input);
 
   // reduce the aggregates
-  AggregateValuesType* aggregateValues = currentGroupIt->second.get();
+  std::unique_ptr<Aggregator>* aggregators =
+      _aggregators.data() + group * _aggregatorFactories.size();
 
   if (_infos.getAggregateTypes().empty()) {
     // no aggregate registers. simply increase the counter
     if (_infos.getCount()) {
       // TODO get rid of this special case if possible
-      TRI_ASSERT(!aggregateValues->empty());
-      aggregateValues->back()->reduce(EmptyValue);
+      TRI_ASSERT(_aggregatorFactories.size() == 1);
+      aggregators[0]->reduce(EmptyValue);
     }
   } else {
     // apply the aggregators for the group
-    TRI_ASSERT(aggregateValues->size() == _infos.getAggregatedRegisters().size());
+    TRI_ASSERT(_aggregatorFactories.size() == _infos.getAggregatedRegisters().size());
     size_t j = 0;
     for (auto const& r : _infos.getAggregatedRegisters()) {
       if (r.second == ExecutionNode::MaxRegisterId) {
-        (*aggregateValues)[j]->reduce(EmptyValue);
+        aggregators[j]->reduce(EmptyValue);
       } else {
-        (*aggregateValues)[j]->reduce(input.getValue(r.second));
+        aggregators[j]->reduce(input.getValue(r.second));
       }
       ++j;
     }
@@ -151,32 +143,32 @@ void HashedCollectExecutor::writeCurrentGroupToOutput(OutputAqlItemRow& output)
   // build the result
   TRI_ASSERT(!_infos.getCount() || _infos.getCollectRegister() != ExecutionNode::MaxRegisterId);
 
-  auto& keys = _currentGroup->first;
-  TRI_ASSERT(_currentGroup->second != nullptr);
+  AqlValue* keys = _allGroups.group(_currentGroup);
 
-  TRI_ASSERT(keys.size() == _infos.getGroupRegisters().size());
-  size_t i = 0;
-  for (auto& it : keys) {
-    AqlValue& key = *const_cast<AqlValue*>(&it);
+  TRI_ASSERT(_allGroups.groupWidth() == _infos.getGroupRegisters().size());
+  for (size_t i = 0; i < _allGroups.groupWidth(); ++i) {
+    AqlValue& key = keys[i];
     AqlValueGuard guard{key, true};
-    output.moveValueInto(_infos.getGroupRegisters()[i++].first,
+    output.moveValueInto(_infos.getGroupRegisters()[i].first,
                          _lastInitializedInputRow, guard);
     key.erase();  // to prevent double-freeing later
   }
 
+  std::unique_ptr<Aggregator>* aggregators =
+      _aggregators.data() + _currentGroup * _aggregatorFactories.size();
+
   if (!_infos.getCount()) {
-    TRI_ASSERT(_currentGroup->second->size() == _infos.getAggregatedRegisters().size());
-    size_t j = 0;
-    for (auto const& it : *(_currentGroup->second)) {
-      AqlValue r = it->stealValue();
+    TRI_ASSERT(_aggregatorFactories.size() == _infos.getAggregatedRegisters().size());
+    for (size_t j = 0; j < _aggregatorFactories.size(); ++j) {
+      AqlValue r = aggregators[j]->stealValue();
       AqlValueGuard guard{r, true};
-      output.moveValueInto(_infos.getAggregatedRegisters()[j++].first,
+      output.moveValueInto(_infos.getAggregatedRegisters()[j].first,
                            _lastInitializedInputRow, guard);
     }
   } else {
     // set group count in result register
-    TRI_ASSERT(!_currentGroup->second->empty());
-    AqlValue r = _currentGroup->second->back()->stealValue();
+    TRI_ASSERT(_aggregatorFactories.size() == 1);
+    AqlValue r = aggregators[0]->stealValue();
     AqlValueGuard guard{r, true};
     output.moveValueInto(_infos.getCollectRegister(), _lastInitializedInputRow, guard);
   }
@@ -208,7 +200,7 @@ ExecutionState HashedCollectExecutor::init() {
   }
 
   // initialize group iterator for output
-  _currentGroup = _allGroups.begin();
+  _currentGroup = 0;
   // The values within are not supposed to be used anymore.
   _nextGroupValues.clear();
   return ExecutionState::DONE;
@@ -230,24 +222,24 @@ std::pair<ExecutionState, NoStats> HashedCollectExecutor::produceRows(OutputAqlI
   }
 
   // produce output
-  if (_currentGroup != _allGroups.end()) {
+  if (_currentGroup < _allGroups.size()) {
     writeCurrentGroupToOutput(output);
     ++_currentGroup;
     ++_returnedGroups;
     TRI_ASSERT(_returnedGroups <= _allGroups.size());
   }
 
-  ExecutionState state = _currentGroup != _allGroups.end() ? ExecutionState::HASMORE
+  ExecutionState state = _currentGroup < _allGroups.size() ? ExecutionState::HASMORE
                                                            : ExecutionState::DONE;
 
   return {state, NoStats{}};
 }
 
 // finds the group matching the current row, or emplaces it. in either case,
-// it returns an iterator to the group matching the current row in
-// _allGroups. additionally, .second is true iff a new group was emplaced.
-decltype(HashedCollectExecutor::_allGroups)::iterator HashedCollectExecutor::findOrEmplaceGroup(
-    InputAqlItemRow& input) {
+// it returns the position of the group matching the current row in
+// _allGroups. the group's aggregators are at the same position (times the
+// number of aggregators) in _aggregators.
+size_t HashedCollectExecutor::findOrEmplaceGroup(InputAqlItemRow& input) {
   _nextGroupValues.clear();
 
   // for hashing simply re-use the aggregate registers, without cloning
@@ -256,11 +248,25 @@ decltype(HashedCollectExecutor::_allGroups)::iterator HashedCollectExecutor::fin
     _nextGroupValues.emplace_back(input.getValue(reg.second));
   }
 
-  auto it = _allGroups.find(_nextGroupValues);
+  // the hash is computed only once, and is reused for the insert
+  uint64_t const hash = _allGroups.hash(_nextGroupValues.data());
+  size_t const group = _allGroups.find(_nextGroupValues.data(), hash);
 
-  if (it != _allGroups.end()) {
+  if (group != AqlValueGroupTable::notFound) {
     // group already exists
-    return it;
+    return group;
+  }
+
+  // this prepares the aggregate functions for the new group
+  size_t const numAggregators = _aggregators.size();
+  auto trx = _infos.getTransaction();
+  try {
+    for (auto const& it : _aggregatorFactories) {
+      _aggregators.emplace_back((*it)(trx));
+    }
+  } catch (...) {
+    _aggregators.resize(numAggregators);
+    throw;
   }
 
   _nextGroupValues.clear();
@@ -269,26 +275,17 @@ decltype(HashedCollectExecutor::_allGroups)::iterator HashedCollectExecutor::fin
   for (auto const& reg : _infos.getGroupRegisters()) {
     _nextGroupValues.emplace_back(input.stealValue(reg.second));
   }
-  // this builds a new group with aggregate functions being prepared.
-  auto aggregateValues = std::make_unique<AggregateValuesType>();
-  aggregateValues->reserve(_aggregatorFactories.size());
-  auto trx = _infos.getTransaction();
-  for (auto const& it : _aggregatorFactories) {
-    aggregateValues->emplace_back((*it)(trx));
-  }
-
-  // note: aggregateValues may be a nullptr!
-  auto emplaceResult =
-      _allGroups.emplace(std::move(_nextGroupValues), std::move(aggregateValues));
-  // emplace must not fail
-  TRI_ASSERT(emplaceResult.second);
-
-  // Moving _nextGroupValues left us with an empty vector of minimum capacity.
-  // So in order to have correct capacity reserve again.
-  _nextGroupValues.reserve(_infos.getGroupRegisters().size());
 
-  return emplaceResult.first;
-};
+  try {
+    return _allGroups.insert(_nextGroupValues.data(), hash);
+  } catch (...) {
+    for (auto& it : _nextGroupValues) {
+      it.destroy();
+    }
+    _aggregators.resize(numAggregators);
+    throw;
+  }
+}
 
 std::pair<ExecutionState, size_t> HashedCollectExecutor::expectedNumberOfRows(size_t atMost) const {
   size_t rowsLeft = 0;
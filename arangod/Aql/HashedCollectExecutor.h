@@ -27,7 +27,7 @@
 #define ARANGOD_AQL_HASHED_COLLECT_EXECUTOR_H
 
 #include "Aql/Aggregator.h"
-#include "Aql/AqlValueGroup.h"
+#include "Aql/AqlValueGroupTable.h"
 #include "Aql/ExecutionBlock.h"
 #include "Aql/ExecutionBlockImpl.h"
 #include "Aql/ExecutionNode.h"
@@ -57,7 +57,8 @@ class HashedCollectExecutorInfos : public ExecutorInfos {
                              std::vector<std::pair<RegisterId, RegisterId>>&& groupRegisters,
                              RegisterId collectRegister, std::vector<std::string>&& aggregateTypes,
                              std::vector<std::pair<RegisterId, RegisterId>>&& aggregateRegisters,
-                             transaction::Methods* trxPtr, bool count);
+                             transaction::Methods* trxPtr, bool count,
+                             ResourceMonitor* resourceMonitor = nullptr);
 
   HashedCollectExecutorInfos() = delete;
   HashedCollectExecutorInfos(HashedCollectExecutorInfos&&) = default;
@@ -65,16 +66,19 @@ class HashedCollectExecutorInfos : public ExecutorInfos {
   ~HashedCollectExecutorInfos() = default;
 
  public:
-  std::vector<std::pair<RegisterId, RegisterId>> getGroupRegisters() const {
+  std::vector<std::pair<RegisterId, RegisterId>> const& getGroupRegisters() const noexcept {
     return _groupRegisters;
   }
-  std::vector<std::pair<RegisterId, RegisterId>> getAggregatedRegisters() const {
+  std::vector<std::pair<RegisterId, RegisterId>> const& getAggregatedRegisters() const noexcept {
     return _aggregateRegisters;
   }
-  std::vector<std::string> getAggregateTypes() const { return _aggregateTypes; }
+  std::vector<std::string> const& getAggregateTypes() const noexcept {
+    return _aggregateTypes;
+  }
   bool getCount() const noexcept { return _count; }
   transaction::Methods* getTransaction() const { return _trxPtr; }
   RegisterId getCollectRegister() const noexcept { return _collectRegister; }
+  ResourceMonitor* getResourceMonitor() const { return _resourceMonitor; }
 
  private:
   /// @brief aggregate types
@@ -97,6 +101,9 @@ class HashedCollectExecutorInfos : public ExecutorInfos {
 
   /// @brief the transaction for this query
   transaction::Methods* _trxPtr;
+
+  /// @brief the query's resource monitor, may be a nullptr
+  ResourceMonitor* _resourceMonitor;
 };
 
 /**
@@ -136,29 +143,25 @@ class HashedCollectExecutor {
   std::pair<ExecutionState, size_t> expectedNumberOfRows(size_t atMost) const;
 
  private:
-  using AggregateValuesType = std::vector<std::unique_ptr<Aggregator>>;
   using GroupKeyType = std::vector<AqlValue>;
-  using GroupValueType = std::unique_ptr<AggregateValuesType>;
-  using GroupMapType =
-      std::unordered_map<GroupKeyType, GroupValueType, AqlValueGroupHash, AqlValueGroupEqual>;
 
   Infos const& infos() const noexcept { return _infos; }
 
   /**
    * @brief Shall be executed until it returns DONE, then never again.
    * Consumes all input, writes groups and calculates aggregates, and
-   * initializes _currentGroup to _allGroups.begin().
+   * initializes _currentGroup to the first group.
    *
    * @return DONE or WAITING
    */
   ExecutionState init();
 
-  void destroyAllGroupsAqlValues();
-
   static std::vector<std::function<std::unique_ptr<Aggregator>(transaction::Methods*)> const*>
   createAggregatorFactories(HashedCollectExecutor::Infos const& infos);
 
-  GroupMapType::iterator findOrEmplaceGroup(InputAqlItemRow& input);
+  /// @brief returns the position of the group matching the input row in
+  /// _allGroups, emplacing a new group (and its aggregators) if required
+  size_t findOrEmplaceGroup(InputAqlItemRow& input);
 
   void consumeInputRow(InputAqlItemRow& input);
 
@@ -174,9 +177,15 @@ class HashedCollectExecutor {
   /// rows later.
   InputAqlItemRow _lastInitializedInputRow;
 
-  /// @brief hashmap of all encountered groups
-  GroupMapType _allGroups;
-  GroupMapType::iterator _currentGroup;
+  /// @brief hash table of all encountered groups
+  AqlValueGroupTable _allGroups;
+
+  /// @brief aggregators of all groups, _aggregatorFactories.size() per
+  /// group, in the same order as the groups in _allGroups
+  std::vector<std::unique_ptr<Aggregator>> _aggregators;
+
+  /// @brief position of the next group to be returned
+  size_t _currentGroup;
 
   bool _isInitialized;  // init() was called successfully (e.g. it returned DONE)
 
@@ -25,11 +25,17 @@
 
 #include "Aql/Query.h"
 #include "Aql/SingleRowFetcher.h"
+#include "Basics/ConditionLocker.h"
+#include "Basics/ConditionVariable.h"
+#include "Basics/system-functions.h"
 #include "IResearch/IResearchCommon.h"
 #include "IResearch/IResearchDocument.h"
 #include "IResearch/IResearchFilterFactory.h"
 #include "IResearch/IResearchOrderFactory.h"
 #include "IResearch/IResearchView.h"
+#include "IResearch/IResearchViewStoredValues.h"
+#include "Scheduler/Scheduler.h"
+#include "Scheduler/SchedulerFeature.h"
 #include "StorageEngine/EngineSelectorFeature.h"
 #include "StorageEngine/StorageEngine.h"
 #include "StorageEngine/TransactionCollection.h"
@@ -40,6 +46,11 @@
 #include "search/boolean_filter.hpp"
 #include "search/score.hpp"
 
+#include <algorithm>
+#include <exception>
+#include <iterator>
+#include <limits>
+
 // TODO Eliminate access to the plan if possible!
 // I think it is used for two things only:
 //  - to get the Ast, which can simply be passed on its own, and
@@ -111,7 +122,9 @@ IResearchViewExecutorInfos::IResearchViewExecutorInfos(
     aql::AstNode const& filterCondition,
     std::pair<bool, bool> volatility,
     IResearchViewExecutorInfos::VarInfoMap const& varInfoMap,
-    int depth)
+    int depth,
+    IResearchViewExecutorInfos::ScoresLimit const& scoresLimit,
+    std::vector<std::string> const& projections)
   : ExecutorInfos(std::move(infos)),
     _outputRegister(firstOutputRegister),
     _numScoreRegisters(numScoreRegisters),
@@ -126,7 +139,9 @@ IResearchViewExecutorInfos::IResearchViewExecutorInfos(
     // `_volatileSort` implies `_volatileFilter`
     _volatileFilter(_volatileSort || volatility.first),
     _varInfoMap(varInfoMap),
-    _depth(depth) {
+    _depth(depth),
+    _scoresLimit(scoresLimit),
+    _projections(projections) {
   TRI_ASSERT(_reader != nullptr);
   TRI_ASSERT(getOutputRegisters()->find(firstOutputRegister) !=
              getOutputRegisters()->end());
@@ -384,29 +399,34 @@ bool IResearchViewExecutorBase<Impl, Traits>::writeRow(ReadContext& ctx,
 
   // read document from underlying storage engine, if we got an id
   if (collection.readDocumentWithCallback(infos().getQuery().trx(), documentId, ctx.callback)) {
-    // in the ordered case we have to write scores as well as a document
-    if /* constexpr */ (Traits::Ordered) {
-      // scorer register are placed consecutively after the document output register
-      RegisterId scoreReg = ctx.docOutReg + 1;
-
-      for (auto& it : _indexReadBuffer.getScores(bufferEntry)) {
-        TRI_ASSERT(infos().isScoreReg(scoreReg));
-        bool mustDestroy = false;
-        AqlValueGuard guard{it, mustDestroy};
-        ctx.outputRow.moveValueInto(scoreReg, ctx.inputRow, guard);
-        ++scoreReg;
-      }
-
-      // we should have written exactly all score registers by now
-      TRI_ASSERT(!infos().isScoreReg(scoreReg));
-    }
-
+    writeScores(ctx, bufferEntry);
     return true;
   }
 
   return false;
 }
 
+template<typename Impl, typename Traits>
+void IResearchViewExecutorBase<Impl, Traits>::writeScores(ReadContext& ctx,
+                                                          IndexReadBufferEntry bufferEntry) {
+  // in the ordered case we have to write scores as well as a document
+  if /* constexpr */ (Traits::Ordered) {
+    // scorer register are placed consecutively after the document output register
+    RegisterId scoreReg = ctx.docOutReg + 1;
+
+    for (auto& it : _indexReadBuffer.getScores(bufferEntry)) {
+      TRI_ASSERT(infos().isScoreReg(scoreReg));
+      bool mustDestroy = false;
+      AqlValueGuard guard{it, mustDestroy};
+      ctx.outputRow.moveValueInto(scoreReg, ctx.inputRow, guard);
+      ++scoreReg;
+    }
+
+    // we should have written exactly all score registers by now
+    TRI_ASSERT(!infos().isScoreReg(scoreReg));
+  }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 /// --SECTION--                                           IResearchViewExecutor
 ///////////////////////////////////////////////////////////////////////////////
@@ -420,6 +440,8 @@ IResearchViewExecutor<ordered>::IResearchViewExecutor(Fetcher& fetcher, Infos& i
       _scr(&irs::score::no_score()),
       _scrVal() {
   TRI_ASSERT(ordered == (infos.getNumScoreRegisters() != 0));
+  TRI_ASSERT(!infos.scoresLimit().limit ||
+             infos.scoresLimit().scorer < infos.scorers().size());
 }
 
 template <bool ordered>
@@ -468,6 +490,11 @@ template <bool ordered>
 void IResearchViewExecutor<ordered>::fillBuffer(IResearchViewExecutor::ReadContext& ctx) {
   TRI_ASSERT(this->_filter != nullptr);
 
+  if (useScoresLimit()) {
+    fillBufferTopK(ctx);
+    return;
+  }
+
   std::size_t const atMost = ctx.outputRow.numRowsLeft();
 
   size_t const count = this->_reader->size();
@@ -507,6 +534,7 @@ void IResearchViewExecutor<ordered>::fillBuffer(IResearchViewExecutor::ReadConte
 
       _collection = collection.get();
       this->_indexReadBuffer.reset();
+      clearStoredValues();
     }
 
     TRI_ASSERT(_pkReader);
@@ -539,6 +567,10 @@ void IResearchViewExecutor<ordered>::fillBuffer(IResearchViewExecutor::ReadConte
       evaluateScores(ctx);
     }
 
+    if (useStoredValues()) {
+      pushStoredValues(_doc->value);
+    }
+
     // doc and scores are both pushed, sizes must now be coherent
     this->_indexReadBuffer.assertSizeCoherence();
 
@@ -579,6 +611,10 @@ bool IResearchViewExecutor<ordered>::resetIterator() {
   _doc = _itr->attributes().get<irs::document>().get();
   TRI_ASSERT(_doc);
 
+  if (useStoredValues()) {
+    resetStoredValues(segmentReader);
+  }
+
   if /* constexpr */ (ordered) {
     _scr = _itr->attributes().get<irs::score>().get();
 
@@ -608,6 +644,107 @@ void IResearchViewExecutor<ordered>::reset() {
   _itr.reset();
   _doc = nullptr;
   _readerOffset = 0;
+
+  // reset scores limit state
+  _topK.clear();
+  _topKOffset = 0;
+  _topKCollected = false;
+  if (useScoresLimit()) {
+    _collection = nullptr;
+  }
+
+  clearStoredValues();
+}
+
+template <bool ordered>
+bool IResearchViewExecutor<ordered>::writeRow(ReadContext& ctx,
+                                              IndexReadBufferEntry bufferEntry) {
+  TRI_ASSERT(_collection);
+
+  if (useStoredValues()) {
+    TRI_ASSERT(bufferEntry.getKeyIdx() < _storedValuesOffsets.size());
+    auto const offset = _storedValuesOffsets[bufferEntry.getKeyIdx()];
+
+    if (offset != std::numeric_limits<size_t>::max()) {
+      // produce the document from the values stored in the view
+      AqlValue value{AqlValueHintCopy(_storedValuesBuilder.data() + offset)};
+      bool mustDestroy = true;
+      AqlValueGuard guard{value, mustDestroy};
+      ctx.outputRow.moveValueInto(ctx.docOutReg, ctx.inputRow, guard);
+      this->writeScores(ctx, bufferEntry);
+      return true;
+    }
+  }
+
+  return Base::writeRow(ctx,
+                        bufferEntry,
+                        this->_indexReadBuffer.getValue(bufferEntry),
+                        *_collection);
+}
+
+template <bool ordered>
+void IResearchViewExecutor<ordered>::resetStoredValues(irs::sub_reader const& segment) {
+  auto const& projections = this->infos().projections();
+
+  _storedValuesReaders.clear();
+  _storedValuesReaders.reserve(projections.size());
+
+  for (auto const& attribute : projections) {
+    auto const* reader = segment.column_reader(IResearchViewStoredValues::column(attribute));
+
+    if (!reader) {
+      // segment was written without stored values, fall back to documents
+      _storedValuesReaders.clear();
+      return;
+    }
+
+    _storedValuesReaders.emplace_back(reader->values());
+  }
+}
+
+template <bool ordered>
+void IResearchViewExecutor<ordered>::pushStoredValues(irs::doc_id_t doc) {
+  auto const& projections = this->infos().projections();
+
+  if (_storedValuesReaders.size() != projections.size()) {
+    _storedValuesOffsets.emplace_back(std::numeric_limits<size_t>::max());
+    return;
+  }
+
+  _storedValues.resize(projections.size());
+
+  for (size_t i = 0, size = projections.size(); i < size; ++i) {
+    if (!_storedValuesReaders[i](doc, _storedValues[i]) || _storedValues[i].empty()) {
+      // no value stored for the document, fall back to the document
+      _storedValuesOffsets.emplace_back(std::numeric_limits<size_t>::max());
+      return;
+    }
+  }
+
+  if (_storedValuesBuilder.isClosed()) {
+    _storedValuesBuilder.openArray();
+  }
+
+  auto const offset = _storedValuesBuilder.buffer()->size();
+
+  _storedValuesBuilder.openObject();
+  for (size_t i = 0, size = projections.size(); i < size; ++i) {
+    VPackSlice const slice(_storedValues[i].c_str());
+
+    if (!slice.isNull()) {
+      // attributes absent in the document are stored as 'null'
+      _storedValuesBuilder.add(projections[i], slice);
+    }
+  }
+  _storedValuesBuilder.close();
+
+  _storedValuesOffsets.emplace_back(offset);
+}
+
+template <bool ordered>
+void IResearchViewExecutor<ordered>::clearStoredValues() {
+  _storedValuesBuilder.clear();
+  _storedValuesOffsets.clear();
 }
 
 template <bool ordered>
@@ -615,6 +752,10 @@ size_t IResearchViewExecutor<ordered>::skip(size_t limit) {
   TRI_ASSERT(this->_indexReadBuffer.empty());
   TRI_ASSERT(this->_filter);
 
+  if (useScoresLimit()) {
+    return skipTopK(limit);
+  }
+
   size_t const toSkip = limit;
 
   for (size_t count = this->_reader->size(); _readerOffset < count;) {
@@ -659,12 +800,299 @@ size_t IResearchViewExecutor<ordered>::skip(size_t limit) {
     }
 
     this->_indexReadBuffer.reset();
+    clearStoredValues();
     _collection = collection.get();
   }
 
   return toSkip - limit;
 }
 
+template <bool ordered>
+struct IResearchViewExecutor<ordered>::TopKSegment {
+  TopKSegment(size_t offset, irs::doc_iterator::ptr&& itr,
+              irs::columnstore_reader::values_reader_f&& pkReader)
+      : offset(offset), itr(std::move(itr)), pkReader(std::move(pkReader)) {}
+
+  size_t offset;  // offset of the segment in the snapshot
+  irs::doc_iterator::ptr itr;
+  irs::columnstore_reader::values_reader_f pkReader;
+  std::vector<TopKEntry> best;  // best documents of the segment
+};
+
+// shared between the executor and the scheduler workers, as workers that
+// start late may outlive the collection
+template <bool ordered>
+struct IResearchViewExecutor<ordered>::TopKState {
+  std::vector<TopKSegment> segments;  // not resized once workers are started
+  std::atomic<size_t> next{0};        // next segment to scan
+  basics::ConditionVariable cv;
+  size_t done{0};                     // number of scanned segments, protected by cv
+  std::exception_ptr error;           // first error of a worker, protected by cv
+};
+
+template <bool ordered>
+void IResearchViewExecutor<ordered>::collectSegment(
+    TopKSegment& segment, IResearchViewExecutorInfos::ScoresLimit const& limit,
+    size_t numScores) {
+  TRI_ASSERT(segment.itr);
+  TRI_ASSERT(segment.pkReader);
+
+  irs::doc_iterator& itr = *segment.itr;
+  auto const* doc = itr.attributes().get<irs::document>().get();
+  TRI_ASSERT(doc);
+  auto const* score = itr.attributes().get<irs::score>().get();
+  irs::bytes_ref const scoreValue = score ? irs::bytes_ref(score->value()) : irs::bytes_ref::NIL;
+  TRI_ASSERT(!score ||
+             static_cast<size_t>(std::distance(scoreValue.begin(), scoreValue.end())) /
+                     sizeof(float_t) == numScores);
+
+  auto const better = [&limit](float_t lhs, float_t rhs) noexcept {
+    return limit.ascending ? lhs < rhs : lhs > rhs;
+  };
+
+  // the heap keeps the worst of the best documents at its front
+  auto const heapLess = [&better](TopKEntry const& lhs, TopKEntry const& rhs) noexcept {
+    return better(lhs.key, rhs.key);
+  };
+
+  auto& heap = segment.best;
+
+  while (itr.next()) {
+    float_t const* scores = nullptr;
+    float_t key = 0;
+
+    if (score) {
+      score->evaluate();
+      // in arangodb we assume all scorers return float_t
+      scores = reinterpret_cast<float_t const*>(scoreValue.begin());
+      key = scores[limit.scorer];
+    }
+
+    if (heap.size() < limit.limit) {
+      heap.emplace_back();
+    } else if (better(key, heap.front().key)) {
+      // replace the worst document, reusing its score storage
+      std::pop_heap(heap.begin(), heap.end(), heapLess);
+    } else {
+      continue;
+    }
+
+    auto& entry = heap.back();
+    entry.key = key;
+    entry.doc = doc->value;
+    entry.segment = segment.offset;
+    if (scores) {
+      entry.scores.assign(scores, scores + numScores);
+    } else {
+      entry.scores.clear();
+    }
+    std::push_heap(heap.begin(), heap.end(), heapLess);
+  }
+
+  // read primary keys of the best documents only
+  irs::bytes_ref pk;
+  for (auto& entry : heap) {
+    if (!segment.pkReader(entry.doc, pk) || !DocumentPrimaryKey::read(entry.documentId, pk)) {
+      LOG_TOPIC("e2b7a", WARN, arangodb::iresearch::TOPIC)
+          << "failed to read document primary key while reading document "
+             "from arangosearch view, doc_id '"
+          << entry.doc << "'";
+    }
+  }
+
+  heap.erase(std::remove_if(heap.begin(), heap.end(),
+                            [](TopKEntry const& entry) {
+                              return !entry.documentId.isSet();
+                            }),
+             heap.end());
+}
+
+template <bool ordered>
+void IResearchViewExecutor<ordered>::collectTopK() {
+  TRI_ASSERT(useScoresLimit());
+  TRI_ASSERT(this->_filter);
+  TRI_ASSERT(_topK.empty());
+
+  auto const& limit = this->infos().scoresLimit();
+  size_t const numScores = this->infos().scorers().size();
+  auto state = std::make_shared<TopKState>();
+
+  // executing the filter may evaluate expressions in the context of the
+  // query, which must happen on the executor's thread
+  for (size_t i = 0, count = this->_reader->size(); i < count; ++i) {
+    auto& segmentReader = (*this->_reader)[i];
+    auto pkReader = ::pkColumn(segmentReader);
+
+    if (!pkReader) {
+      LOG_TOPIC("5c2e9", WARN, arangodb::iresearch::TOPIC)
+          << "encountered a sub-reader without a primary key column while "
+             "executing a query, ignoring";
+      continue;
+    }
+
+    state->segments.emplace_back(
+        i,
+        segmentReader.mask(this->_filter->execute(segmentReader, this->_order, this->_filterCtx)),
+        std::move(pkReader));
+  }
+
+  size_t const count = state->segments.size();
+
+  auto scan = [state, limit, numScores, count]() {
+    while (true) {
+      size_t const i = state->next.fetch_add(1);
+
+      if (i >= count) {
+        return;
+      }
+
+      std::exception_ptr error;
+
+      try {
+        collectSegment(state->segments[i], limit, numScores);
+      } catch (...) {
+        error = std::current_exception();
+      }
+
+      CONDITION_LOCKER(guard, state->cv);
+      if (error && !state->error) {
+        state->error = error;
+      }
+      if (++state->done == count) {
+        guard.signal();
+      }
+    }
+  };
+
+  // let scheduler workers help with all but one segment, this thread scans
+  // as well and so never waits on a worker that has not started yet
+  Scheduler* scheduler = SchedulerFeature::SCHEDULER;
+  size_t helpers = count > 1 ? std::min(count - 1, TRI_numberProcessors()) : 0;
+
+  for (; scheduler && helpers; --helpers) {
+    if (!scheduler->queue(RequestLane::CLIENT_AQL, scan)) {
+      break;
+    }
+  }
+
+  scan();
+
+  {
+    CONDITION_LOCKER(guard, state->cv);
+    while (state->done < count) {
+      guard.wait();
+    }
+  }
+
+  if (state->error) {
+    std::rethrow_exception(state->error);
+  }
+
+  size_t total = 0;
+  for (auto& segment : state->segments) {
+    total += segment.best.size();
+  }
+  _topK.reserve(total);
+
+  for (auto& segment : state->segments) {
+    std::move(segment.best.begin(), segment.best.end(), std::back_inserter(_topK));
+    // release the iterators on this thread, late workers do not touch them
+    segment.itr.reset();
+  }
+
+  if (_topK.size() > limit.limit) {
+    std::nth_element(_topK.begin(), _topK.begin() + limit.limit, _topK.end(),
+                     [&limit](TopKEntry const& lhs, TopKEntry const& rhs) noexcept {
+                       return limit.ascending ? lhs.key < rhs.key : lhs.key > rhs.key;
+                     });
+    _topK.resize(limit.limit);
+  }
+
+  // the CID must stay the same for all documents in the buffer, the following
+  // SORT establishes the final order anyway
+  std::sort(_topK.begin(), _topK.end(), [](TopKEntry const& lhs, TopKEntry const& rhs) noexcept {
+    return lhs.segment < rhs.segment;
+  });
+}
+
+template <bool ordered>
+void IResearchViewExecutor<ordered>::fillBufferTopK(ReadContext& ctx) {
+  if (!_topKCollected) {
+    collectTopK();
+    _topKCollected = true;
+  }
+
+  std::size_t const atMost = ctx.outputRow.numRowsLeft();
+
+  while (_topKOffset < _topK.size()) {
+    auto const& entry = _topK[_topKOffset];
+
+    if (!_collection || _readerOffset != entry.segment) {
+      if (!this->_indexReadBuffer.empty()) {
+        // the cid changes with each segment
+        break;
+      }
+
+      TRI_voc_cid_t const cid = this->_reader->cid(entry.segment);
+      Query& query = this->infos().getQuery();
+      auto collection = lookupCollection(*query.trx(), cid, query);
+
+      if (!collection) {
+        // We don't have a collection, skip the documents of the segment.
+        size_t const segment = entry.segment;
+        while (_topKOffset < _topK.size() && _topK[_topKOffset].segment == segment) {
+          ++_topKOffset;
+        }
+        _collection = nullptr;
+        continue;
+      }
+
+      _readerOffset = entry.segment;
+      _collection = collection.get();
+      this->_indexReadBuffer.reset();
+      clearStoredValues();
+
+      if (useStoredValues()) {
+        resetStoredValues((*this->_reader)[entry.segment]);
+      }
+    }
+
+    this->_indexReadBuffer.pushValue(entry.documentId);
+
+    if (entry.scores.empty()) {
+      this->fillScores(ctx, nullptr, nullptr);
+    } else {
+      this->fillScores(ctx, entry.scores.data(), entry.scores.data() + entry.scores.size());
+    }
+
+    if (useStoredValues()) {
+      pushStoredValues(entry.doc);
+    }
+
+    // doc and scores are both pushed, sizes must now be coherent
+    this->_indexReadBuffer.assertSizeCoherence();
+    ++_topKOffset;
+
+    if (this->_indexReadBuffer.size() >= atMost) {
+      break;
+    }
+  }
+}
+
+template <bool ordered>
+size_t IResearchViewExecutor<ordered>::skipTopK(size_t toSkip) {
+  if (!_topKCollected) {
+    collectTopK();
+    _topKCollected = true;
+  }
+
+  size_t const skipped = std::min(toSkip, _topK.size() - _topKOffset);
+  _topKOffset += skipped;
+  _collection = nullptr;
+
+  return skipped;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 /// --SECTION--                                      IResearchViewMergeExecutor
 ///////////////////////////////////////////////////////////////////////////////
@@ -30,6 +30,7 @@
 #include "Aql/OutputAqlItemRow.h"
 #include "IResearch/ExpressionFilter.h"
 #include "IResearch/IResearchExpressionContext.h"
+#include "IResearch/IResearchOrderFactory.h"
 #include "IResearch/IResearchView.h"
 #include "IResearch/IResearchVPackComparer.h"
 #include "Indexes/IndexIterator.h"
@@ -37,6 +38,8 @@
 
 #include "index/heap_iterator.hpp"
 
+#include <velocypack/Builder.h>
+
 namespace iresearch {
 class score;
 struct document;
@@ -57,6 +60,8 @@ class IResearchViewExecutorInfos : public ExecutorInfos {
  public:
   using VarInfoMap = std::unordered_map<aql::VariableId, aql::ExecutionNode::VarInfo>;
 
+  using ScoresLimit = iresearch::ScoresLimit;
+
   IResearchViewExecutorInfos(
       ExecutorInfos&& infos,
       std::shared_ptr<iresearch::IResearchView::Snapshot const> reader,
@@ -70,7 +75,9 @@ class IResearchViewExecutorInfos : public ExecutorInfos {
       aql::AstNode const& filterCondition,
       std::pair<bool, bool> volatility,
       VarInfoMap const& varInfoMap,
-      int depth);
+      int depth,
+      ScoresLimit const& scoresLimit,
+      std::vector<std::string> const& projections);
 
   RegisterId getOutputRegister() const noexcept { return _outputRegister; }
   RegisterId getNumScoreRegisters() const noexcept { return _numScoreRegisters; }
@@ -89,6 +96,11 @@ class IResearchViewExecutorInfos : public ExecutorInfos {
   // second - number of sort conditions to take into account
   std::pair<iresearch::IResearchViewSort const*, size_t> const& sort() const noexcept { return _sort; }
 
+  ScoresLimit const& scoresLimit() const noexcept { return _scoresLimit; }
+
+  // top-level attributes to read from the stored values instead of documents
+  std::vector<std::string> const& projections() const noexcept { return _projections; }
+
   bool isScoreReg(RegisterId reg) const noexcept {
     return getOutputRegister() < reg && reg <= getOutputRegister() + getNumScoreRegisters();
   }
@@ -107,6 +119,8 @@ class IResearchViewExecutorInfos : public ExecutorInfos {
   bool const _volatileFilter;
   VarInfoMap const& _varInfoMap;
   int const _depth;
+  ScoresLimit const _scoresLimit;
+  std::vector<std::string> const& _projections;
 }; // IResearchViewExecutorInfos
 
 class IResearchViewStats {
@@ -194,6 +208,9 @@ class IResearchViewExecutorBase {
       : _keyIdx(keyIdx) {
     }
 
+   public:
+    inline std::size_t getKeyIdx() const noexcept { return _keyIdx; }
+
    protected:
     std::size_t _keyIdx;
   };
@@ -326,6 +343,8 @@ class IResearchViewExecutorBase {
                 LocalDocumentId const& documentId,
                 LogicalCollection const& collection);
 
+  void writeScores(ReadContext& ctx, IndexReadBufferEntry bufferEntry);
+
   void reset();
 
  private:
@@ -371,20 +390,56 @@ class IResearchViewExecutor : public IResearchViewExecutorBase<IResearchViewExec
 
   void fillBuffer(ReadContext& ctx);
 
-  inline bool writeRow(ReadContext& ctx, IndexReadBufferEntry bufferEntry) {
-    TRI_ASSERT(_collection);
-
-    return Base::writeRow(ctx,
-                          bufferEntry,
-                          this->_indexReadBuffer.getValue(bufferEntry),
-                          *_collection);
-  }
+  bool writeRow(ReadContext& ctx, IndexReadBufferEntry bufferEntry);
 
   bool resetIterator();
 
   void reset();
 
  private:
+  // single document of the scores limited (top-k) case
+  struct TopKEntry {
+    float_t key{};  // value of the scorer the documents are limited by
+    irs::doc_id_t doc{};
+    LocalDocumentId documentId;
+    size_t segment{};
+    std::vector<float_t> scores;
+  };
+
+  struct TopKSegment;
+  struct TopKState;
+
+  bool useScoresLimit() const noexcept {
+    return ordered && this->infos().scoresLimit().limit != 0;
+  }
+
+  // collects the best documents of every segment, segments are scanned
+  // concurrently by scheduler workers and the calling thread
+  void collectTopK();
+
+  // collects the best documents of a single segment
+  static void collectSegment(TopKSegment& segment,
+                             IResearchViewExecutorInfos::ScoresLimit const& limit,
+                             size_t numScores);
+
+  void fillBufferTopK(ReadContext& ctx);
+
+  size_t skipTopK(size_t toSkip);
+
+  bool useStoredValues() const noexcept {
+    return !this->infos().projections().empty();
+  }
+
+  // prepares the stored values column readers of the specified segment
+  void resetStoredValues(irs::sub_reader const& segment);
+
+  // reads the stored values of the specified document into the buffer,
+  // must be called right after pushing the document and its scores into
+  // _indexReadBuffer
+  void pushStoredValues(irs::doc_id_t doc);
+
+  void clearStoredValues();
+
   // Returns true unless the iterator is exhausted. documentId will always be
   // written. It will always be unset when readPK returns false, but may also be
   // unset if readPK returns true.
@@ -399,6 +454,17 @@ class IResearchViewExecutor : public IResearchViewExecutorBase<IResearchViewExec
   // case ordered only:
   irs::score const* _scr;
   irs::bytes_ref _scrVal;
+
+  // case scores limit only:
+  std::vector<TopKEntry> _topK;  // best documents, grouped by segment
+  size_t _topKOffset{0};
+  bool _topKCollected{false};
+
+  // case stored values only:
+  std::vector<irs::columnstore_reader::values_reader_f> _storedValuesReaders;  // current segment
+  velocypack::Builder _storedValuesBuilder;  // objects of the buffered documents
+  std::vector<size_t> _storedValuesOffsets;  // per buffered document, npos - read the document
+  std::vector<irs::bytes_ref> _storedValues;  // temporary store for values of a document
 }; // IResearchViewExecutor
 
 template<bool ordered>
@@ -762,6 +762,55 @@ IResearchViewNode::IResearchViewNode(aql::ExecutionPlan& plan, velocypack::Slice
     _volatilityMask = volatilityMaskSlice.getNumber<int>();
   }
 
+  // scores limit
+  auto const scoresLimitSlice = base.get("scoresLimit");
+
+  if (!scoresLimitSlice.isNone()) {
+    auto const limitSlice = scoresLimitSlice.get("limit");
+    auto const scorerSlice = scoresLimitSlice.get("scorer");
+    auto const ascendingSlice = scoresLimitSlice.get("ascending");
+
+    if (!limitSlice.isNumber() || !scorerSlice.isNumber() || !ascendingSlice.isBool()) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(
+          TRI_ERROR_BAD_PARAMETER,
+          "invalid vpack format: 'scoresLimit' attribute is intended to be an "
+          "object with numeric 'limit', 'scorer' and boolean 'ascending'");
+    }
+
+    _scoresLimit.limit = limitSlice.getNumber<size_t>();
+    _scoresLimit.scorer = scorerSlice.getNumber<size_t>();
+    _scoresLimit.ascending = ascendingSlice.getBool();
+
+    if (_scoresLimit.limit && _scoresLimit.scorer >= _scorers.size()) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(
+          TRI_ERROR_BAD_PARAMETER,
+          "invalid vpack format: value of 'scorer' attribute '" +
+              std::to_string(_scoresLimit.scorer) +
+              "' exceeds the number of scorers '" + std::to_string(_scorers.size()) + "'");
+    }
+  }
+
+  // projections
+  auto const projectionsSlice = base.get("projections");
+
+  if (!projectionsSlice.isNone()) {
+    if (!projectionsSlice.isArray()) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(
+          TRI_ERROR_BAD_PARAMETER,
+          "invalid vpack format: 'projections' attribute is intended to be an array");
+    }
+
+    for (auto projectionSlice : VPackArrayIterator(projectionsSlice)) {
+      if (!projectionSlice.isString()) {
+        THROW_ARANGO_EXCEPTION_MESSAGE(
+            TRI_ERROR_BAD_PARAMETER,
+            "invalid vpack format: 'projections' attribute is intended to be an array of strings");
+      }
+
+      _projections.emplace_back(projectionSlice.copyString());
+    }
+  }
+
   // primary sort
   auto const primarySortSlice = base.get("primarySort");
 
@@ -904,6 +953,22 @@ void IResearchViewNode::toVelocyPackHelper(VPackBuilder& nodes, unsigned flags)
     nodes.add("primarySortBuckets", VPackValue(_sort.second));
   }
 
+  // scores limit
+  if (_scoresLimit.limit) {
+    VPackObjectBuilder objectScope(&nodes, "scoresLimit");
+    nodes.add("limit", VPackValue(_scoresLimit.limit));
+    nodes.add("scorer", VPackValue(_scoresLimit.scorer));
+    nodes.add("ascending", VPackValue(_scoresLimit.ascending));
+  }
+
+  // projections
+  if (!_projections.empty()) {
+    VPackArrayBuilder arrayScope(&nodes, "projections");
+    for (auto& projection : _projections) {
+      nodes.add(VPackValue(projection));
+    }
+  }
+
 
   nodes.close();
 }
@@ -961,6 +1026,8 @@ aql::ExecutionNode* IResearchViewNode::clone(aql::ExecutionPlan* plan,
   node->_options = _options;
   node->_volatilityMask = _volatilityMask;
   node->_sort = _sort;
+  node->_scoresLimit = _scoresLimit;
+  node->_projections = _projections;
 
   return cloneHelper(std::move(node), withDependencies, withProperties);
 }
@@ -1138,7 +1205,9 @@ std::unique_ptr<aql::ExecutionBlock> IResearchViewNode::createBlock(
                                                 filterCondition(),
                                                 volatility(),
                                                 getRegisterPlan()->varInfo,
-                                                getDepth()};
+                                                getDepth(),
+                                                _scoresLimit,
+                                                _projections};
 
   if (_sort.first) {
     TRI_ASSERT(!_sort.first->empty()); // guaranteed by optimizer rule
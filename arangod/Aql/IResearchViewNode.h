@@ -142,6 +142,25 @@ class IResearchViewNode final : public arangodb::aql::ExecutionNode {
     _sort.second = sort ? std::min(size, sort->size()) : 0;
   }
 
+  /// @return number of best documents according to a scorer that suffice for
+  ///         the following SORT, zero limit if all documents are required
+  ScoresLimit const& scoresLimit() const noexcept { return _scoresLimit; }
+
+  /// @brief set number of best documents according to a scorer that suffice
+  void scoresLimit(ScoresLimit const& limit) noexcept { _scoresLimit = limit; }
+
+  /// @return top-level attributes of the documents that are read by the
+  ///         following nodes, the documents are produced from the values
+  ///         stored in the view if not empty
+  std::vector<std::string> const& projections() const noexcept {
+    return _projections;
+  }
+
+  /// @brief set the attributes to produce from the stored values of the view
+  void projections(std::vector<std::string>&& projections) noexcept {
+    _projections = std::move(projections);
+  }
+
   /// @brief getVariablesUsedHere, modifying the set in-place
   void getVariablesUsedHere(arangodb::HashSet<aql::Variable const*>& vars) const override final;
 
@@ -190,6 +209,12 @@ class IResearchViewNode final : public arangodb::aql::ExecutionNode {
   /// @brief scorers related to the view
   std::vector<Scorer> _scorers;
 
+  /// @brief limit of the following SORT on a single scorer
+  ScoresLimit _scoresLimit;
+
+  /// @brief attributes produced from the stored values of the view
+  std::vector<std::string> _projections;
+
   /// @brief list of shards involved, need this for the cluster
   std::vector<std::string> _shards;
 
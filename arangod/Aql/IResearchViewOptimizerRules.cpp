@@ -23,6 +23,7 @@
 
 #include "IResearchViewOptimizerRules.h"
 
+#include "Aql/Ast.h"
 #include "Aql/ClusterNodes.h"
 #include "Aql/Condition.h"
 #include "Aql/ExecutionNode.h"
@@ -38,6 +39,7 @@
 #include "IResearch/AqlHelper.h"
 #include "IResearch/IResearchView.h"
 #include "IResearch/IResearchViewCoordinator.h"
+#include "IResearch/IResearchViewStoredValues.h"
 #include "IResearch/IResearchFilterFactory.h"
 #include "IResearch/IResearchOrderFactory.h"
 #include "Utils/CollectionNameResolver.h"
@@ -61,6 +63,16 @@ inline IResearchViewSort const& primarySort(arangodb::LogicalView const& view) {
   return viewImpl.primarySort();
 }
 
+inline IResearchViewStoredValues const& storedValues(arangodb::LogicalView const& view) {
+  if (arangodb::ServerState::instance()->isCoordinator()) {
+    auto& viewImpl = arangodb::LogicalView::cast<IResearchViewCoordinator>(view);
+    return viewImpl.storedValues();
+  }
+
+  auto& viewImpl = arangodb::LogicalView::cast<IResearchView>(view);
+  return viewImpl.storedValues();
+}
+
 bool addView(arangodb::LogicalView const& view, arangodb::aql::Query& query) {
   auto* collections = query.collections();
 
@@ -260,6 +272,105 @@ bool optimizeSort(IResearchViewNode& viewNode, ExecutionPlan* plan) {
   }
 }
 
+/// @returns the number of best documents according to a single scorer that
+///          suffice for a non-stable, limited SORT following a given node with
+///          only calculations in between, zero limit if there's no such SORT
+ScoresLimit scoresLimit(IResearchViewNode const& node) {
+  ScoresLimit result;
+  auto const& scorers = node.scorers();
+
+  // non-deterministic filters evaluate expressions while iterating over
+  // documents, which must not happen concurrently
+  if (scorers.empty() || !node.filterCondition().isDeterministic()) {
+    return result;
+  }
+
+  auto const* cur = node.getFirstParent();
+
+  while (cur && cur->getType() == EN::CALCULATION) {
+    cur = cur->getFirstParent();
+  }
+
+  if (!cur || cur->getType() != EN::SORT) {
+    return result;
+  }
+
+  auto const& sort = *EN::castTo<SortNode const*>(cur);
+
+  if (sort.isStable() || !sort.limit() || sort.elements().size() != 1) {
+    return result;
+  }
+
+  auto const& element = sort.elements().front();
+
+  if (!element.attributePath.empty()) {
+    return result;
+  }
+
+  // the sorted variable may be a plain reference to a scorer variable
+  auto const* var = element.var;
+  auto const* setter = node.plan()->getVarSetBy(var->id);
+
+  if (setter && setter->getType() == EN::CALCULATION) {
+    auto const* expr =
+        EN::castTo<CalculationNode const*>(setter)->expression();
+
+    if (expr && expr->node() && expr->node()->type == NODE_TYPE_REFERENCE) {
+      var = static_cast<Variable const*>(expr->node()->getData());
+    }
+  }
+
+  auto const scorer = std::find_if(scorers.begin(), scorers.end(),
+                                   [var](Scorer const& scorer) { return scorer.var == var; });
+
+  if (scorer == scorers.end()) {
+    return result;
+  }
+
+  result.limit = sort.limit();
+  result.scorer = static_cast<size_t>(std::distance(scorers.begin(), scorer));
+  result.ascending = element.ascending;
+
+  return result;
+}
+
+/// @returns top-level attributes of the view documents used by the nodes
+///          following the specified view node, empty if the entire
+///          documents are required
+std::vector<std::string> projections(IResearchViewNode const& node) {
+  std::unordered_set<std::string> attributes;
+  ::arangodb::HashSet<Variable const*> vars;
+  auto const* outVariable = &node.outVariable();
+
+  for (auto const* current = node.getFirstParent(); current;
+       current = current->getFirstParent()) {
+    vars.clear();
+    current->getVariablesUsedHere(vars);
+
+    if (vars.find(outVariable) == vars.end()) {
+      continue;
+    }
+
+    if (EN::CALCULATION != current->getType()) {
+      // node requires the entire document
+      return {};
+    }
+
+    auto const* expr = EN::castTo<CalculationNode const*>(current)->expression();
+
+    if (!expr || !expr->node() ||
+        !Ast::getReferencedAttributes(expr->node(), outVariable, attributes)) {
+      // expression requires the entire document
+      return {};
+    }
+  }
+
+  std::vector<std::string> result(attributes.begin(), attributes.end());
+  std::sort(result.begin(), result.end());
+
+  return result;
+}
+
 }  // namespace
 
 namespace arangodb {
@@ -338,6 +449,100 @@ void handleViewsRule(arangodb::aql::Optimizer* opt,
   });
 }
 
+/// @brief push the limit of a following SORT on a scorer into views
+void scoresLimitRule(arangodb::aql::Optimizer* opt,
+                     std::unique_ptr<arangodb::aql::ExecutionPlan> plan,
+                     arangodb::aql::OptimizerRule const* rule) {
+  TRI_ASSERT(plan);
+
+  // ensure 'Optimizer::addPlan' will be called
+  bool modified = false;
+  auto addPlan = irs::make_finally([opt, &plan, rule, &modified]() {
+    opt->addPlan(std::move(plan), rule, modified);
+  });
+
+  if (!plan->contains(EN::ENUMERATE_IRESEARCH_VIEW)) {
+    // no view present in the query
+    return;
+  }
+
+  SmallVector<ExecutionNode*>::allocator_type::arena_type a;
+  SmallVector<ExecutionNode*> nodes{a};
+  plan->findNodesOfType(nodes, EN::ENUMERATE_IRESEARCH_VIEW, true);
+
+  for (auto* node : nodes) {
+    TRI_ASSERT(node && EN::ENUMERATE_IRESEARCH_VIEW == node->getType());
+    auto& viewNode = *EN::castTo<IResearchViewNode*>(node);
+
+    if (viewNode.sort().first) {
+      // documents of a sorted view are merged in the order of the view
+      continue;
+    }
+
+    auto const limit = ::scoresLimit(viewNode);
+
+    if (limit.limit && limit != viewNode.scoresLimit()) {
+      viewNode.scoresLimit(limit);
+      modified = true;
+    }
+  }
+}
+
+/// @brief produce documents of views from the stored values of the view when
+/// only stored attributes are used by the query
+void storedValuesRule(arangodb::aql::Optimizer* opt,
+                      std::unique_ptr<arangodb::aql::ExecutionPlan> plan,
+                      arangodb::aql::OptimizerRule const* rule) {
+  TRI_ASSERT(plan);
+
+  // ensure 'Optimizer::addPlan' will be called
+  bool modified = false;
+  auto addPlan = irs::make_finally([opt, &plan, rule, &modified]() {
+    opt->addPlan(std::move(plan), rule, modified);
+  });
+
+  if (!plan->contains(EN::ENUMERATE_IRESEARCH_VIEW)) {
+    // no view present in the query
+    return;
+  }
+
+  SmallVector<ExecutionNode*>::allocator_type::arena_type a;
+  SmallVector<ExecutionNode*> nodes{a};
+  plan->findNodesOfType(nodes, EN::ENUMERATE_IRESEARCH_VIEW, true);
+
+  for (auto* node : nodes) {
+    TRI_ASSERT(node && EN::ENUMERATE_IRESEARCH_VIEW == node->getType());
+    auto& viewNode = *EN::castTo<IResearchViewNode*>(node);
+
+    if (viewNode.sort().first || !viewNode.view()) {
+      // documents of a sorted view are read by the merge executor
+      continue;
+    }
+
+    auto const& storedValues = ::storedValues(*viewNode.view());
+
+    if (storedValues.empty()) {
+      continue;
+    }
+
+    auto projections = ::projections(viewNode);
+
+    if (projections.empty() || projections.size() > storedValues.size()) {
+      continue;
+    }
+
+    bool const covered = std::all_of(
+        projections.begin(), projections.end(), [&storedValues](std::string const& field) {
+          return storedValues.find(field) < storedValues.size();
+        });
+
+    if (covered && projections != viewNode.projections()) {
+      viewNode.projections(std::move(projections));
+      modified = true;
+    }
+  }
+}
+
 void scatterViewInClusterRule(arangodb::aql::Optimizer* opt,
                               std::unique_ptr<arangodb::aql::ExecutionPlan> plan,
                               arangodb::aql::OptimizerRule const* rule) {
@@ -41,6 +41,16 @@ void handleViewsRule(arangodb::aql::Optimizer* opt,
                      std::unique_ptr<arangodb::aql::ExecutionPlan> plan,
                      arangodb::aql::OptimizerRule const* rule);
 
+/// @brief push the limit of a following SORT on a single scorer into views
+void scoresLimitRule(arangodb::aql::Optimizer* opt,
+                     std::unique_ptr<arangodb::aql::ExecutionPlan> plan,
+                     arangodb::aql::OptimizerRule const* rule);
+
+/// @brief produce view documents from the values stored in views
+void storedValuesRule(arangodb::aql::Optimizer* opt,
+                      std::unique_ptr<arangodb::aql::ExecutionPlan> plan,
+                      arangodb::aql::OptimizerRule const* rule);
+
 /// @brief scatter view query in cluster
 /// this rule inserts scatter, gather and remote nodes so operations on sharded
 /// views
@@ -70,7 +70,16 @@ static inline DocumentProducingFunctionContext createContext(InputAqlItemRow con
       inputRow, nullptr, infos.getOutputRegisterId(), infos.getProduceResult(),
       infos.getProjections(), infos.getTrxPtr(),
       infos.getCoveringIndexAttributePositions(), false, infos.getUseRawDocumentPointers(),
-      infos.getIndexes().size() > 1 || infos.hasMultipleExpansions());
+      infos.getIndexes().size() > 1 || infos.hasMultipleExpansions(),
+      infos.getDocIdRegisterId());
+}
+
+static inline std::shared_ptr<std::unordered_set<RegisterId>> makeOutputRegisters(
+    RegisterId outputRegister, RegisterId docIdRegister) {
+  if (docIdRegister == ExecutionNode::MaxRegisterId) {
+    return make_shared_unordered_set({outputRegister});
+  }
+  return make_shared_unordered_set({outputRegister, docIdRegister});
 }
 }  // namespace
 
@@ -87,17 +96,19 @@ IndexExecutorInfos::IndexExecutorInfos(
     std::vector<Variable const*>&& expInVars, std::vector<RegisterId>&& expInRegs,
     bool hasV8Expression, AstNode const* condition,
     std::vector<transaction::Methods::IndexHandle> indexes, Ast* ast,
-    IndexIteratorOptions options)
+    IndexIteratorOptions options, RegisterId docIdRegister)
     : ExecutorInfos(make_shared_unordered_set(),
-                    make_shared_unordered_set({outputRegister}),
+                    ::makeOutputRegisters(outputRegister, docIdRegister),
                     nrInputRegisters, nrOutputRegisters,
                     std::move(registersToClear), std::move(registersToKeep)),
       _indexes(std::move(indexes)),
       _condition(condition),
+      _intersectionCondition(nullptr),
       _ast(ast),
       _hasMultipleExpansions(false),
       _options(options),
       _outputRegisterId(outputRegister),
+      _docIdRegisterId(docIdRegister),
       _engine(engine),
       _collection(collection),
       _outVariable(outVariable),
@@ -171,6 +182,7 @@ IndexExecutor::CursorReader::CursorReader(IndexExecutorInfos const& infos,
     : _infos(infos),
       _condition(condition),
       _index(index),
+      _context(context),
       _cursor(std::make_unique<OperationCursor>(infos.getTrxPtr()->indexScanForCondition(
           index, condition, infos.getOutVariable(), infos.getOptions()))),
       _type(!infos.getProduceResult()
@@ -199,6 +211,7 @@ IndexExecutor::CursorReader::CursorReader(CursorReader&& other) noexcept
     : _infos(other._infos),
       _condition(other._condition),
       _index(other._index),
+      _context(other._context),
       _cursor(std::move(other._cursor)),
       _type(other._type),
       _callback() {
@@ -303,6 +316,18 @@ size_t IndexExecutor::CursorReader::skipIndex(size_t toSkip) {
   }
 
   uint64_t skipped = 0;
+  if (_infos.hasIntersection()) {
+    // only documents that are also found via the intersection index count
+    auto callback = [this, &skipped](LocalDocumentId const& token) {
+      if (_context.checkUniqueness(token)) {
+        ++skipped;
+      }
+    };
+    while (skipped < toSkip && _cursor->hasMore()) {
+      _cursor->next(callback, toSkip - skipped);
+    }
+    return static_cast<size_t>(skipped);
+  }
   _cursor->skip(toSkip, skipped);
 
   TRI_ASSERT(skipped <= toSkip);
@@ -317,6 +342,9 @@ void IndexExecutor::initIndexes(InputAqlItemRow& input) {
   // We start with a different context. Return documents found in the previous
   // context again.
   _documentProducingFunctionContext.reset();
+  if (_infos.hasIntersection() && _intersection == nullptr) {
+    initIntersection();
+  }
   // Find out about the actual values for the bounds in the variable bound case:
 
   if (!_infos.getNonConstExpressions().empty()) {
@@ -358,6 +386,25 @@ void IndexExecutor::initIndexes(InputAqlItemRow& input) {
   _currentIndex = _infos.getIndexes().size();
 }
 
+void IndexExecutor::initIntersection() {
+  TRI_ASSERT(_infos.hasIntersection());
+  auto ids = std::make_unique<std::unordered_set<TRI_voc_rid_t>>();
+
+  // the limit and sort order of the options only apply to the main index
+  OperationCursor cursor(_infos.getTrxPtr()->indexScanForCondition(
+      _infos.getIntersectionIndex(), _infos.getIntersectionCondition(),
+      _infos.getOutVariable(), IndexIteratorOptions()));
+  auto callback = [&ids](LocalDocumentId const& token) {
+    ids->emplace(token.id());
+  };
+  while (cursor.hasMore()) {
+    cursor.next(callback, ExecutionBlock::DefaultBatchSize());
+  }
+
+  _intersection = std::move(ids);
+  _documentProducingFunctionContext.setIntersection(_intersection.get());
+}
+
 void IndexExecutor::executeExpressions(InputAqlItemRow& input) {
   TRI_ASSERT(_infos.getCondition() != nullptr);
   TRI_ASSERT(!_infos.getNonConstExpressions().empty());
@@ -62,7 +62,7 @@ class IndexExecutorInfos : public ExecutorInfos {
       std::vector<Variable const*>&& expInVars, std::vector<RegisterId>&& expInRegs,
       bool hasV8Expression, AstNode const* condition,
       std::vector<transaction::Methods::IndexHandle> indexes, Ast* ast,
-      IndexIteratorOptions options);
+      IndexIteratorOptions options, RegisterId docIdRegister);
 
   IndexExecutorInfos() = delete;
   IndexExecutorInfos(IndexExecutorInfos&&) = default;
@@ -87,6 +87,9 @@ class IndexExecutorInfos : public ExecutorInfos {
   AstNode const* getCondition() { return _condition; }
   bool getV8Expression() const { return _hasV8Expression; }
   RegisterId getOutputRegisterId() const { return _outputRegisterId; }
+  /// @brief register for the document ids in case of late materialization,
+  /// ExecutionNode::MaxRegisterId otherwise
+  RegisterId getDocIdRegisterId() const { return _docIdRegisterId; }
   std::vector<std::unique_ptr<NonConstExpression>> const& getNonConstExpressions() {
     return _nonConstExpression;
   }
@@ -103,8 +106,23 @@ class IndexExecutorInfos : public ExecutorInfos {
   }
   std::vector<RegisterId> const& getExpInRegs() const { return _expInRegs; }
 
+  /// @brief second index whose results are intersected with the results
+  /// of the indexes, only valid if hasIntersection() returns true
+  transaction::Methods::IndexHandle const& getIntersectionIndex() const {
+    return _intersectionIndex;
+  }
+  AstNode const* getIntersectionCondition() const {
+    return _intersectionCondition;
+  }
+  bool hasIntersection() const { return _intersectionCondition != nullptr; }
+
   // setter
   void setHasMultipleExpansions(bool flag) { _hasMultipleExpansions = flag; }
+  void setIntersection(transaction::Methods::IndexHandle const& index,
+                       AstNode const* condition) {
+    _intersectionIndex = index;
+    _intersectionCondition = condition;
+  }
 
   bool hasNonConstParts() const { return !_nonConstExpression.empty(); }
 
@@ -119,6 +137,10 @@ class IndexExecutorInfos : public ExecutorInfos {
   /// @brief _condition: holds the complete condition this Block can serve for
   AstNode const* _condition;
 
+  /// @brief the second index and its constant condition for intersections
+  transaction::Methods::IndexHandle _intersectionIndex;
+  AstNode const* _intersectionCondition;
+
   /// @brief _ast: holds the ast of the _plan
   Ast* _ast;
 
@@ -134,6 +156,7 @@ class IndexExecutorInfos : public ExecutorInfos {
   IndexIteratorOptions _options;
 
   RegisterId _outputRegisterId;
+  RegisterId _docIdRegisterId;
   ExecutionEngine* _engine;
   Collection const* _collection;
   Variable const* _outVariable;
@@ -180,6 +203,7 @@ class IndexExecutor {
     IndexExecutorInfos const& _infos;
     AstNode const* _condition;
     transaction::Methods::IndexHandle const& _index;
+    DocumentProducingFunctionContext& _context;
     std::unique_ptr<OperationCursor> _cursor;
     Type const _type;
 
@@ -231,6 +255,7 @@ class IndexExecutor {
   bool advanceCursor();
   void executeExpressions(InputAqlItemRow& input);
   void initIndexes(InputAqlItemRow& input);
+  void initIntersection();
 
   inline CursorReader& getCursor() {
     TRI_ASSERT(_currentIndex < _cursors.size());
@@ -238,7 +263,8 @@ class IndexExecutor {
   }
 
   inline bool needsUniquenessCheck() const {
-    return _infos.getIndexes().size() > 1 || _infos.hasMultipleExpansions();
+    return _infos.getIndexes().size() > 1 || _infos.hasMultipleExpansions() ||
+           _infos.hasIntersection();
   }
 
  private:
@@ -255,6 +281,10 @@ class IndexExecutor {
   /// @brief current position in _indexes
   size_t _currentIndex;
 
+  /// @brief ids of the documents found via the intersection index. the
+  /// condition of that index is constant, so this is built only once
+  std::unique_ptr<std::unordered_set<TRI_voc_rid_t>> _intersection;
+
   /// @brief Count how many documents have been skipped during one call.
   ///        Retained during WAITING situations.
   ///        Needs to be 0 after we return a result.
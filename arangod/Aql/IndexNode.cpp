@@ -55,7 +55,10 @@ IndexNode::IndexNode(ExecutionPlan* plan, size_t id,
       _indexes(indexes),
       _condition(std::move(condition)),
       _needsGatherNodeSort(false),
-      _options(opts) {
+      _options(opts),
+      _intersectionCondition(nullptr),
+      _outNonMaterializedDocId(nullptr),
+      _outNonMaterializedDocument(nullptr) {
   TRI_ASSERT(_condition != nullptr);
 
   initIndexCoversProjections();
@@ -69,7 +72,12 @@ IndexNode::IndexNode(ExecutionPlan* plan, arangodb::velocypack::Slice const& bas
       _indexes(),
       _needsGatherNodeSort(
           basics::VelocyPackHelper::readBooleanValue(base, "needsGatherNodeSort", false)),
-      _options() {
+      _options(),
+      _intersectionCondition(nullptr),
+      _outNonMaterializedDocId(
+          Variable::varFromVPack(plan->getAst(), base, "outNmDocId", true)),
+      _outNonMaterializedDocument(
+          Variable::varFromVPack(plan->getAst(), base, "outNmDoc", true)) {
   _options.sorted = basics::VelocyPackHelper::readBooleanValue(base, "sorted", true);
   _options.ascending =
       basics::VelocyPackHelper::readBooleanValue(base, "ascending", false);
@@ -108,6 +116,20 @@ IndexNode::IndexNode(ExecutionPlan* plan, arangodb::velocypack::Slice const& bas
 
   TRI_ASSERT(_condition != nullptr);
 
+  VPackSlice intersection = base.get("intersectionIndex");
+  if (intersection.isObject()) {
+    VPackSlice intersectionCondition = base.get("intersectionCondition");
+    if (!intersectionCondition.isObject()) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(
+          TRI_ERROR_BAD_PARAMETER,
+          "\"intersectionCondition\" attribute should be an object");
+    }
+    // note: the AST is responsible for freeing the AstNode later!
+    setIntersection(trx->getIndexByIdentifier(_collection->name(),
+                                              intersection.get("id").copyString()),
+                    new AstNode(plan->getAst(), intersectionCondition));
+  }
+
   initIndexCoversProjections();
 }
 
@@ -193,6 +215,12 @@ void IndexNode::toVelocyPackHelper(VPackBuilder& builder, unsigned flags) const
   }
   builder.add(VPackValue("condition"));
   _condition->toVelocyPack(builder, flags);
+  if (hasIntersection()) {
+    builder.add(VPackValue("intersectionIndex"));
+    _intersectionIndex.toVelocyPack(builder, Index::makeFlags(Index::Serialize::Estimates));
+    builder.add(VPackValue("intersectionCondition"));
+    _intersectionCondition->toVelocyPack(builder, flags);
+  }
   // IndexIteratorOptions
   builder.add("sorted", VPackValue(_options.sorted));
   builder.add("ascending", VPackValue(_options.ascending));
@@ -200,6 +228,14 @@ void IndexNode::toVelocyPackHelper(VPackBuilder& builder, unsigned flags) const
   builder.add("evalFCalls", VPackValue(_options.evaluateFCalls));
   builder.add("limit", VPackValue(_options.limit));
 
+  // late materialization
+  if (isLateMaterialized()) {
+    builder.add(VPackValue("outNmDocId"));
+    _outNonMaterializedDocId->toVelocyPack(builder);
+    builder.add(VPackValue("outNmDoc"));
+    _outNonMaterializedDocument->toVelocyPack(builder);
+  }
+
   // And close it:
   builder.close();
 }
@@ -352,9 +388,23 @@ std::unique_ptr<ExecutionBlock> IndexNode::createBlock(
     ExecutionEngine& engine, std::unordered_map<ExecutionNode*, ExecutionBlock*> const&) const {
   ExecutionNode const* previousNode = getFirstDependency();
   TRI_ASSERT(previousNode != nullptr);
-  auto it = getRegisterPlan()->varInfo.find(_outVariable->id);
-  TRI_ASSERT(it != getRegisterPlan()->varInfo.end());
-  RegisterId outputRegister = it->second.registerId;
+  auto const& varInfo = getRegisterPlan()->varInfo;
+  RegisterId outputRegister;
+  RegisterId docIdRegister = ExecutionNode::MaxRegisterId;
+  if (isLateMaterialized()) {
+    // only the document id and the projections are produced here, the
+    // document itself is fetched by a MaterializeNode further down
+    auto it = varInfo.find(_outNonMaterializedDocument->id);
+    TRI_ASSERT(it != varInfo.end());
+    outputRegister = it->second.registerId;
+    it = varInfo.find(_outNonMaterializedDocId->id);
+    TRI_ASSERT(it != varInfo.end());
+    docIdRegister = it->second.registerId;
+  } else {
+    auto it = varInfo.find(_outVariable->id);
+    TRI_ASSERT(it != varInfo.end());
+    outputRegister = it->second.registerId;
+  }
 
   transaction::Methods* trxPtr = _plan->getAst()->query()->trx();
 
@@ -379,12 +429,17 @@ std::unique_ptr<ExecutionBlock> IndexNode::createBlock(
                            getRegisterPlan()->nrRegs[previousNode->getDepth()],
                            getRegisterPlan()->nrRegs[getDepth()], getRegsToClear(),
                            calcRegsToKeep(), &engine, this->_collection, _outVariable,
-                           this->isVarUsedLater(_outVariable), this->projections(),
+                           isLateMaterialized() || this->isVarUsedLater(_outVariable),
+                           this->projections(),
                            trxPtr, this->coveringIndexAttributePositions(),
                            EngineSelectorFeature::ENGINE->useRawDocumentPointers(),
                            std::move(nonConstExpressions), std::move(inVars),
                            std::move(inRegs), hasV8Expression, _condition->root(),
-                           this->getIndexes(), _plan->getAst(), this->options());
+                           this->getIndexes(), _plan->getAst(), this->options(),
+                           docIdRegister);
+  if (hasIntersection()) {
+    infos.setIntersection(_intersectionIndex, _intersectionCondition);
+  }
 
   return std::make_unique<ExecutionBlockImpl<IndexExecutor>>(&engine, this,
                                                              std::move(infos));
@@ -393,9 +448,17 @@ std::unique_ptr<ExecutionBlock> IndexNode::createBlock(
 ExecutionNode* IndexNode::clone(ExecutionPlan* plan, bool withDependencies,
                                 bool withProperties) const {
   auto outVariable = _outVariable;
+  auto outNonMaterializedDocId = _outNonMaterializedDocId;
+  auto outNonMaterializedDocument = _outNonMaterializedDocument;
 
   if (withProperties) {
     outVariable = plan->getAst()->variables()->createVariable(outVariable);
+    if (isLateMaterialized()) {
+      outNonMaterializedDocId =
+          plan->getAst()->variables()->createVariable(outNonMaterializedDocId);
+      outNonMaterializedDocument =
+          plan->getAst()->variables()->createVariable(outNonMaterializedDocument);
+    }
   }
 
   auto c = std::make_unique<IndexNode>(plan, _id, _collection, outVariable, _indexes,
@@ -404,7 +467,13 @@ ExecutionNode* IndexNode::clone(ExecutionPlan* plan, bool withDependencies,
 
   c->projections(_projections);
   c->needsGatherNodeSort(_needsGatherNodeSort);
+  if (hasIntersection()) {
+    c->setIntersection(_intersectionIndex, _intersectionCondition);
+  }
   c->initIndexCoversProjections();
+  if (isLateMaterialized()) {
+    c->setLateMaterialized(outNonMaterializedDocId, outNonMaterializedDocument);
+  }
   c->_prototypeCollection = _prototypeCollection;
   c->_prototypeOutVariable = _prototypeOutVariable;
 
@@ -447,6 +516,17 @@ CostEstimate IndexNode::estimateCost() const {
     totalCost += costs.estimatedCosts;
   }
 
+  if (hasIntersection() && itemsInCollection > 0) {
+    // the second index is looked up once, and only the documents found
+    // via both indexes are produced
+    auto costs = _intersectionIndex.getIndex()->supportsFilterCondition(
+        std::vector<std::shared_ptr<Index>>(), _intersectionCondition,
+        _outVariable, itemsInCollection);
+    estimate.estimatedCost += costs.estimatedCosts;
+    totalItems = static_cast<size_t>(totalItems * static_cast<double>(costs.estimatedItems) /
+                                     static_cast<double>(itemsInCollection));
+  }
+
   estimate.estimatedNrItems *= totalItems;
   estimate.estimatedCost += incoming * totalCost;
   return estimate;
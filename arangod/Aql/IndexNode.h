@@ -104,9 +104,37 @@ class IndexNode : public ExecutionNode, public DocumentProducingNode, public Col
 
   /// @brief getVariablesSetHere
   std::vector<Variable const*> getVariablesSetHere() const override final {
+    if (isLateMaterialized()) {
+      return std::vector<Variable const*>{_outNonMaterializedDocId,
+                                          _outNonMaterializedDocument};
+    }
     return std::vector<Variable const*>{_outVariable};
   }
 
+  /// @brief whether or not the node only produces document ids and projections,
+  /// leaving the fetching of the full documents to a later MaterializeNode
+  bool isLateMaterialized() const noexcept {
+    return _outNonMaterializedDocId != nullptr;
+  }
+
+  /// @brief turn on late materialization. the node will then write the
+  /// document id into docIdVariable and the projections into documentVariable
+  void setLateMaterialized(Variable const* docIdVariable,
+                           Variable const* documentVariable) {
+    TRI_ASSERT(docIdVariable != nullptr);
+    TRI_ASSERT(documentVariable != nullptr);
+    _outNonMaterializedDocId = docIdVariable;
+    _outNonMaterializedDocument = documentVariable;
+  }
+
+  Variable const* outNonMaterializedDocId() const {
+    return _outNonMaterializedDocId;
+  }
+
+  Variable const* outNonMaterializedDocument() const {
+    return _outNonMaterializedDocument;
+  }
+
   /// @brief getVariablesUsedHere, modifying the set in-place
   void getVariablesUsedHere(arangodb::HashSet<Variable const*>& vars) const override final;
 
@@ -122,6 +150,26 @@ class IndexNode : public ExecutionNode, public DocumentProducingNode, public Col
   /// the projection attributes (if any)
   void initIndexCoversProjections();
 
+  /// @brief whether the results of the index are intersected with the
+  /// results of a second index
+  bool hasIntersection() const { return _intersectionCondition != nullptr; }
+
+  /// @brief the second index and its (constant) condition, only valid if
+  /// hasIntersection() returns true
+  transaction::Methods::IndexHandle const& intersectionIndex() const {
+    return _intersectionIndex;
+  }
+  AstNode const* intersectionCondition() const { return _intersectionCondition; }
+
+  /// @brief only produce documents that are also found via the given index
+  /// and its specialized condition
+  void setIntersection(transaction::Methods::IndexHandle const& index,
+                       AstNode const* condition) {
+    TRI_ASSERT(condition != nullptr);
+    _intersectionIndex = index;
+    _intersectionCondition = condition;
+  }
+
  private:
   void initializeOnce(bool hasV8Expression,
                       std::vector<Variable const*>& inVars,
@@ -144,6 +192,15 @@ class IndexNode : public ExecutionNode, public DocumentProducingNode, public Col
 
   /// @brief the index iterator options - same for all indexes
   IndexIteratorOptions _options;
+
+  /// @brief second index to intersect the results with, and its condition.
+  /// the condition is nullptr if there is no intersection
+  transaction::Methods::IndexHandle _intersectionIndex;
+  AstNode const* _intersectionCondition;
+
+  /// @brief output variables in case of late materialization, nullptr otherwise
+  Variable const* _outNonMaterializedDocId;
+  Variable const* _outNonMaterializedDocument;
 };
 
 }  // namespace aql
@@ -223,8 +223,8 @@ void InputAqlItemRow::toVelocyPack(transaction::Methods* trx, VPackBuilder& resu
 
       case Range:
         result.add(VPackValue(-2));
-        result.add(VPackValue(a.range()->_low));
-        result.add(VPackValue(a.range()->_high));
+        result.add(VPackValue(a.range()._low));
+        result.add(VPackValue(a.range()._high));
         break;
     }
   }
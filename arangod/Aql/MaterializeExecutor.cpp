@@ -0,0 +1,95 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "MaterializeExecutor.h"
+
+#include "Aql/AqlValue.h"
+#include "Aql/Collection.h"
+#include "Aql/SingleRowFetcher.h"
+#include "StorageEngine/PhysicalCollection.h"
+#include "VocBase/LocalDocumentId.h"
+#include "VocBase/LogicalCollection.h"
+
+#include <velocypack/Slice.h>
+
+#include <utility>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+MaterializeExecutorInfos::MaterializeExecutorInfos(
+    RegisterId inNonMaterializedDocId, RegisterId outMaterializedDocument,
+    RegisterId nrInputRegisters, RegisterId nrOutputRegisters,
+    // cppcheck-suppress passedByValue
+    std::unordered_set<RegisterId> registersToClear,
+    // cppcheck-suppress passedByValue
+    std::unordered_set<RegisterId> registersToKeep,
+    Collection const* collection, transaction::Methods* trxPtr)
+    : ExecutorInfos(make_shared_unordered_set({inNonMaterializedDocId}),
+                    make_shared_unordered_set({outMaterializedDocument}),
+                    nrInputRegisters, nrOutputRegisters,
+                    std::move(registersToClear), std::move(registersToKeep)),
+      _inNonMaterializedDocRegId(inNonMaterializedDocId),
+      _outMaterializedDocumentRegId(outMaterializedDocument),
+      _collection(collection),
+      _trxPtr(trxPtr) {}
+
+MaterializeExecutor::MaterializeExecutor(Fetcher& fetcher, Infos& infos)
+    : _infos(infos), _fetcher(fetcher), _collection(infos.collection()->getCollection()) {}
+MaterializeExecutor::~MaterializeExecutor() = default;
+
+std::pair<ExecutionState, NoStats> MaterializeExecutor::produceRows(OutputAqlItemRow& output) {
+  TRI_IF_FAILURE("MaterializeExecutor::produceRows") {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+  }
+  ExecutionState state;
+  InputAqlItemRow input{CreateInvalidInputRowHint{}};
+
+  std::tie(state, input) = _fetcher.fetchRow();
+
+  if (state == ExecutionState::WAITING) {
+    return {state, NoStats{}};
+  }
+
+  if (!input) {
+    TRI_ASSERT(state == ExecutionState::DONE);
+    return {state, NoStats{}};
+  }
+  TRI_ASSERT(input.isInitialized());
+
+  RegisterId const outputRegister = _infos.outputMaterializedDocumentRegId();
+  AqlValue const& docIdValue = input.getValue(_infos.inputNonMaterializedDocRegId());
+  LocalDocumentId const docId(docIdValue.slice().getNumber<LocalDocumentId::BaseType>());
+
+  bool const found = _collection->getPhysical()->readDocumentWithCallback(
+      _infos.trxPtr(), docId, [&](LocalDocumentId const&, VPackSlice doc) {
+        AqlValue v{AqlValueHintCopy{doc.begin()}};
+        AqlValueGuard guard{v, true};
+        output.moveValueInto(outputRegister, input, guard);
+      });
+
+  if (!found) {
+    // cannot happen within the transaction's snapshot, but do not return
+    // garbage if it does
+    output.cloneValueInto(outputRegister, input, AqlValue(AqlValueHintNull()));
+  }
+
+  return {state, NoStats{}};
+}
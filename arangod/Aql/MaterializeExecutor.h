@@ -0,0 +1,124 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_AQL_MATERIALIZE_EXECUTOR_H
+#define ARANGOD_AQL_MATERIALIZE_EXECUTOR_H
+
+#include "Aql/ExecutionState.h"
+#include "Aql/ExecutorInfos.h"
+#include "Aql/InputAqlItemRow.h"
+#include "Aql/OutputAqlItemRow.h"
+#include "Aql/SingleRowFetcher.h"
+#include "Aql/Stats.h"
+
+#include <memory>
+
+namespace arangodb {
+class LogicalCollection;
+
+namespace transaction {
+class Methods;
+}
+
+namespace aql {
+
+struct Collection;
+class ExecutorInfos;
+class NoStats;
+
+class MaterializeExecutorInfos : public ExecutorInfos {
+ public:
+  MaterializeExecutorInfos(RegisterId inNonMaterializedDocId, RegisterId outMaterializedDocument,
+                           RegisterId nrInputRegisters, RegisterId nrOutputRegisters,
+                           std::unordered_set<RegisterId> registersToClear,
+                           std::unordered_set<RegisterId> registersToKeep,
+                           Collection const* collection, transaction::Methods* trxPtr);
+
+  MaterializeExecutorInfos() = delete;
+  MaterializeExecutorInfos(MaterializeExecutorInfos&&) = default;
+  MaterializeExecutorInfos(MaterializeExecutorInfos const&) = delete;
+  ~MaterializeExecutorInfos() = default;
+
+  RegisterId inputNonMaterializedDocRegId() const { return _inNonMaterializedDocRegId; }
+
+  RegisterId outputMaterializedDocumentRegId() const {
+    return _outMaterializedDocumentRegId;
+  }
+
+  Collection const* collection() const { return _collection; }
+
+  transaction::Methods* trxPtr() const { return _trxPtr; }
+
+ private:
+  /// @brief register with the document ids to materialize
+  RegisterId const _inNonMaterializedDocRegId;
+
+  /// @brief register to write the full documents into
+  RegisterId const _outMaterializedDocumentRegId;
+
+  Collection const* _collection;
+  transaction::Methods* _trxPtr;
+};
+
+/**
+ * @brief Implementation of Materialize Node. Looks up the full document
+ *        for each incoming document id.
+ */
+class MaterializeExecutor {
+ public:
+  struct Properties {
+    static const bool preservesOrder = true;
+    static const bool allowsBlockPassthrough = true;
+    static const bool inputSizeRestrictsOutputSize = false;
+  };
+  using Fetcher = SingleRowFetcher<Properties::allowsBlockPassthrough>;
+  using Infos = MaterializeExecutorInfos;
+  using Stats = NoStats;
+
+  MaterializeExecutor() = delete;
+  MaterializeExecutor(MaterializeExecutor&&) = default;
+  MaterializeExecutor(MaterializeExecutor const&) = delete;
+  MaterializeExecutor(Fetcher& fetcher, Infos& infos);
+  ~MaterializeExecutor();
+
+  /**
+   * @brief produce the next Row of Aql Values.
+   *
+   * @return ExecutionState, and if successful exactly one new Row of AqlItems.
+   */
+  std::pair<ExecutionState, Stats> produceRows(OutputAqlItemRow& output);
+
+  inline std::pair<ExecutionState, size_t> expectedNumberOfRows(size_t) const {
+    TRI_ASSERT(false);
+    THROW_ARANGO_EXCEPTION_MESSAGE(
+        TRI_ERROR_INTERNAL,
+        "Logic_error, prefetching number fo rows not supported");
+  }
+
+ private:
+  Infos& _infos;
+  Fetcher& _fetcher;
+  std::shared_ptr<LogicalCollection> _collection;
+};
+
+}  // namespace aql
+}  // namespace arangodb
+
+#endif
@@ -0,0 +1,110 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "MaterializeNode.h"
+#include "Aql/Ast.h"
+#include "Aql/Collection.h"
+#include "Aql/ExecutionBlockImpl.h"
+#include "Aql/ExecutionPlan.h"
+#include "Aql/MaterializeExecutor.h"
+#include "Aql/Query.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+MaterializeNode::MaterializeNode(ExecutionPlan* plan, size_t id,
+                                 aql::Collection const* collection,
+                                 Variable const& inDocId, Variable const& outVariable)
+    : ExecutionNode(plan, id),
+      CollectionAccessingNode(collection),
+      _inNonMaterializedDocId(&inDocId),
+      _outVariable(&outVariable) {}
+
+MaterializeNode::MaterializeNode(ExecutionPlan* plan, arangodb::velocypack::Slice const& base)
+    : ExecutionNode(plan, base),
+      CollectionAccessingNode(plan, base),
+      _inNonMaterializedDocId(Variable::varFromVPack(plan->getAst(), base, "inNmDocId")),
+      _outVariable(Variable::varFromVPack(plan->getAst(), base, "outVariable")) {}
+
+void MaterializeNode::toVelocyPackHelper(VPackBuilder& nodes, unsigned flags) const {
+  // call base class method
+  ExecutionNode::toVelocyPackHelperGeneric(nodes, flags);
+
+  // add collection information
+  CollectionAccessingNode::toVelocyPack(nodes);
+
+  nodes.add(VPackValue("inNmDocId"));
+  _inNonMaterializedDocId->toVelocyPack(nodes);
+
+  nodes.add(VPackValue("outVariable"));
+  _outVariable->toVelocyPack(nodes);
+
+  // And close it:
+  nodes.close();
+}
+
+std::unique_ptr<ExecutionBlock> MaterializeNode::createBlock(
+    ExecutionEngine& engine, std::unordered_map<ExecutionNode*, ExecutionBlock*> const&) const {
+  ExecutionNode const* previousNode = getFirstDependency();
+  TRI_ASSERT(previousNode != nullptr);
+
+  RegisterId inputRegister = variableToRegisterId(_inNonMaterializedDocId);
+  RegisterId outputRegister = variableToRegisterId(_outVariable);
+
+  transaction::Methods* trxPtr = _plan->getAst()->query()->trx();
+
+  MaterializeExecutorInfos infos(inputRegister, outputRegister,
+                                 getRegisterPlan()->nrRegs[previousNode->getDepth()],
+                                 getRegisterPlan()->nrRegs[getDepth()],
+                                 getRegsToClear(), calcRegsToKeep(),
+                                 _collection, trxPtr);
+
+  return std::make_unique<ExecutionBlockImpl<MaterializeExecutor>>(&engine, this,
+                                                                   std::move(infos));
+}
+
+ExecutionNode* MaterializeNode::clone(ExecutionPlan* plan, bool withDependencies,
+                                      bool withProperties) const {
+  auto inNonMaterializedDocId = _inNonMaterializedDocId;
+  auto outVariable = _outVariable;
+
+  if (withProperties) {
+    inNonMaterializedDocId =
+        plan->getAst()->variables()->createVariable(inNonMaterializedDocId);
+    outVariable = plan->getAst()->variables()->createVariable(outVariable);
+  }
+
+  auto c = std::make_unique<MaterializeNode>(plan, _id, _collection,
+                                             *inNonMaterializedDocId, *outVariable);
+
+  return cloneHelper(std::move(c), withDependencies, withProperties);
+}
+
+/// @brief the cost of a materialize node is one document lookup per
+/// incoming row
+CostEstimate MaterializeNode::estimateCost() const {
+  TRI_ASSERT(!_dependencies.empty());
+  CostEstimate estimate = _dependencies.at(0)->getCost();
+  estimate.estimatedCost += estimate.estimatedNrItems;
+  return estimate;
+}
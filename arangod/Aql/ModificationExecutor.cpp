@@ -25,6 +25,8 @@
 #include "Aql/OutputAqlItemRow.h"
 #include "Basics/Common.h"
 #include "ModificationExecutorTraits.h"
+#include "StorageEngine/TransactionState.h"
+#include "Transaction/Methods.h"
 #include "VocBase/LogicalCollection.h"
 
 #include <algorithm>
@@ -44,6 +46,15 @@ std::string toString(SingleBlockFetcher<false>&) {
 }  // namespace aql
 }  // namespace arangodb
 
+bool ModificationExecutorInfos::abortsOnFailure() const {
+  // an error that is not ignored fails the query, and a query that owns
+  // its transaction aborts it. queries inside JavaScript or streaming
+  // transactions can see their errors caught, so they keep the
+  // per-document rollback
+  return !_ignoreErrors._value && _trx != nullptr && _trx->state() != nullptr &&
+         _trx->state()->hasHint(transaction::Hints::Hint::FROM_TOPLEVEL_AQL);
+}
+
 template <typename FetcherType>
 ModificationExecutorBase<FetcherType>::ModificationExecutorBase(Fetcher& fetcher, Infos& infos)
     : _infos(infos), _fetcher(fetcher), _prepared(false) {}
@@ -150,13 +150,19 @@ struct ModificationExecutorInfos : public ExecutorInfos {
         _input3RegisterId(input3RegisterId),
         _outputNewRegisterId(outputNewRegisterId),
         _outputOldRegisterId(outputOldRegisterId),
-        _outputRegisterId(outputRegisterId) {}
+        _outputRegisterId(outputRegisterId) {
+    _options.abortOnFailure = abortsOnFailure();
+  }
 
   ModificationExecutorInfos() = delete;
   ModificationExecutorInfos(ModificationExecutorInfos&&) = default;
   ModificationExecutorInfos(ModificationExecutorInfos const&) = delete;
   ~ModificationExecutorInfos() = default;
 
+  /// @brief whether any failed document fails the query and with it the
+  /// transaction. this holds for top-level queries that do not ignore errors
+  bool abortsOnFailure() const;
+
   /// @brief the variable produced by Return
   transaction::Methods* _trx;
   OperationOptions _options;
@@ -26,14 +26,57 @@
 #include "Aql/ExecutionEngine.h"
 #include "Aql/OptimizerRulesFeature.h"
 #include "Aql/QueryOptions.h"
+#include "Basics/system-functions.h"
 #include "Cluster/ServerState.h"
 #include "Logger/Logger.h"
 
 using namespace arangodb::aql;
 
+namespace {
+/// @brief the rules that can be disabled but are still applied to simple
+/// plans. the rules that cannot be disabled are always applied
+bool isFastPathRule(OptimizerRule::RuleLevel level) {
+  switch (level) {
+    case OptimizerRule::moveCalculationsUpRule:
+    case OptimizerRule::moveFiltersUpRule:
+    case OptimizerRule::removeRedundantCalculationsRule:
+    case OptimizerRule::removeUnnecessaryFiltersRule:
+    case OptimizerRule::removeUnnecessaryCalculationsRule:
+    case OptimizerRule::useIndexesRule:
+    case OptimizerRule::removeFiltersCoveredByIndexRule:
+    case OptimizerRule::removeUnnecessaryCalculationsRule2:
+    case OptimizerRule::reduceExtractionToProjectionRule:
+      return true;
+    default:
+      return false;
+  }
+}
+}  // namespace
+
+void Optimizer::Stats::toVelocyPack(velocypack::Builder& b) const {
+  velocypack::ObjectBuilder guard(&b, true);
+  b.add("rulesExecuted", velocypack::Value(rulesExecuted));
+  b.add("rulesSkipped", velocypack::Value(rulesSkipped));
+  b.add("plansCreated", velocypack::Value(plansCreated));
+  b.add("fastPath", velocypack::Value(fastPath));
+  b.add("runtimeExceeded", velocypack::Value(runtimeExceeded));
+  b.add(velocypack::Value("rules"));
+  {
+    velocypack::ObjectBuilder rulesGuard(&b, true);
+    for (auto const& it : rulesExecutionTime) {
+      char const* name = OptimizerRulesFeature::translateRule(it.first);
+      if (name != nullptr) {
+        b.add(name, velocypack::Value(it.second));
+      }
+    }
+  }
+}
+
 // @brief constructor, this will initialize the rules database
 Optimizer::Optimizer(size_t maxNumberOfPlans)
-    : _maxNumberOfPlans(maxNumberOfPlans), _runOnlyRequiredRules(false) {
+    : _maxNumberOfPlans(maxNumberOfPlans),
+      _runOnlyRequiredRules(false),
+      _fastPath(false) {
   for (auto& r : OptimizerRulesFeature::_rules) {
     _rules.emplace(r.first, Rule{r.second, true});
   }
@@ -98,7 +141,9 @@ void Optimizer::addPlan(std::unique_ptr<ExecutionPlan> plan,
 int Optimizer::createPlans(std::unique_ptr<ExecutionPlan> plan,
                            QueryOptions const& queryOptions, bool estimateAllPlans) {
   _runOnlyRequiredRules = false;
+  _fastPath = false;
   ExecutionPlan* initialPlan = plan.get();
+  double const startTime = TRI_microtime();
 
   // _plans contains the previous optimization result
   _plans.clear();
@@ -126,6 +171,16 @@ int Optimizer::createPlans(std::unique_ptr<ExecutionPlan> plan,
     disableRule(rule);
   }
 
+  if (queryOptions.optimizerFastPath && queryOptions.optimizerRules.empty() &&
+      !arangodb::ServerState::instance()->isCoordinator() && initialPlan->isSimple()) {
+    // a single collection with filters only. apart from the required
+    // rules, only the rules that move filters and pick indexes matter,
+    // and no alternative plans are worth creating
+    _fastPath = true;
+    _runOnlyRequiredRules = true;
+    _stats.fastPath = true;
+  }
+
   _newPlans.clear();
 
   while (true) {
@@ -154,8 +209,19 @@ int Optimizer::createPlans(std::unique_ptr<ExecutionPlan> plan,
         // skip over rules if we should
         // however, we don't want to skip those rules that will not create
         // additional plans
+        if (!_runOnlyRequiredRules && queryOptions.maxOptimizerRuntime > 0.0 &&
+            TRI_microtime() - startTime >= queryOptions.maxOptimizerRuntime) {
+          // out of time. finish the plans we have without creating new ones
+          _runOnlyRequiredRules = true;
+          _stats.runtimeExceeded = true;
+          LOG_TOPIC("3a9e1", DEBUG, Logger::QUERIES)
+              << "optimizer runtime of " << queryOptions.maxOptimizerRuntime
+              << " s exceeded, not creating any more plans";
+        }
+
         if (!it->second.enabled ||
-            (_runOnlyRequiredRules && rule.canCreateAdditionalPlans && rule.canBeDisabled)) {
+            (_runOnlyRequiredRules && rule.canCreateAdditionalPlans && rule.canBeDisabled) ||
+            (_fastPath && rule.canBeDisabled && !::isFastPathRule(rule.level))) {
           // we picked a disabled rule or we have reached the max number of
           // plans and just skip this rule
           ++it;  // move it to the next rule to be processed in the next
@@ -185,10 +251,12 @@ int Optimizer::createPlans(std::unique_ptr<ExecutionPlan> plan,
         //   thus the rule must not have deleted the plan itself or add it
         //   back to the optimizer
         p->setValidity(false);
+        double const ruleStartTime = TRI_microtime();
         rule.func(this, std::move(p), &rule);
 
         if (!rule.isHidden) {
           ++_stats.rulesExecuted;
+          _stats.rulesExecutionTime[rule.level] += TRI_microtime() - ruleStartTime;
         }
       }
 
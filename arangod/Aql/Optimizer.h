@@ -44,13 +44,14 @@ class Optimizer {
     int64_t rulesExecuted = 0;
     int64_t rulesSkipped = 0;
     int64_t plansCreated = 1;  // 1 for the initial plan
-
-    void toVelocyPack(velocypack::Builder& b) const {
-      velocypack::ObjectBuilder guard(&b, true);
-      b.add("rulesExecuted", velocypack::Value(rulesExecuted));
-      b.add("rulesSkipped", velocypack::Value(rulesSkipped));
-      b.add("plansCreated", velocypack::Value(plansCreated));
-    }
+    // whether only the minimal rule set for simple plans was applied
+    bool fastPath = false;
+    // whether the runtime budget of the optimizer was exceeded
+    bool runtimeExceeded = false;
+    // time spent per rule (in seconds), summed over all plans
+    std::map<int, double> rulesExecutionTime;
+
+    void toVelocyPack(velocypack::Builder& b) const;
   };
 
  public:
@@ -182,6 +183,9 @@ class Optimizer {
 
   /// @brief run only the required optimizer rules
   bool _runOnlyRequiredRules;
+
+  /// @brief run only the rules of the minimal rule set for simple plans
+  bool _fastPath;
 };
 
 }  // namespace aql
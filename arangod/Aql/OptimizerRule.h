@@ -148,6 +148,12 @@ struct OptimizerRule {
     // replace FULLTEXT with index
     applyFulltextIndexRule,
 
+    // turn MIN/MAX over an indexed attribute into a sorted LIMIT 1
+    optimizeMinMaxRule,
+
+    // add index ranges for LIKE with a literal prefix
+    optimizeLikePrefixRule,
+
     useIndexesRule,
 
     // try to remove filters covered by index ranges
@@ -184,6 +190,9 @@ struct OptimizerRule {
     // make sort node aware of subsequent limit statements for internal optimizations
     applySortLimitRule,
 
+    // make views aware of subsequent limited sorts on scorers
+    applyArangoSearchScoresLimitRule,
+
     /// Pass 9: push down calculations beyond FILTERs and LIMITs
     moveCalculationsDownRule,
 
@@ -242,9 +251,25 @@ struct OptimizerRule {
     // try to restrict fragments to a single shard if possible
     restrictToSingleShardRule,
 
+    // copy a LIMIT after a GatherNode to the DB servers, so that each shard
+    // stops after offset + count rows
+    distributeLimitToClusterRule,
+
+    // join with a hash table on the inner collection if the join
+    // condition cannot use an index
+    hashJoinRule,
+
     // simplify an EnumerationCollectionNode that fetches an
     // entire document to a projection of this document
     reduceExtractionToProjectionRule,
+
+    // produce documents of ArangoSearch views from the values stored in the
+    // view if the query uses stored attributes only
+    arangoSearchStoredValuesRule,
+
+    // fetch documents produced by an IndexNode only after SORT and LIMIT,
+    // using the index values for everything in between
+    lateDocumentMaterializationRule,
   };
 
   std::string name;
@@ -34,12 +34,14 @@
 #include "Aql/ExecutionNode.h"
 #include "Aql/ExecutionPlan.h"
 #include "Aql/Function.h"
+#include "Aql/HashJoinNode.h"
 #include "Aql/IResearchViewNode.h"
 #include "Aql/IndexNode.h"
 #include "Aql/KShortestPathsNode.h"
 #include "Aql/ModificationNodes.h"
 #include "Aql/Optimizer.h"
 #include "Aql/Query.h"
+#include "Aql/RegexCache.h"
 #include "Aql/ShortestPathNode.h"
 #include "Aql/SortCondition.h"
 #include "Aql/SortNode.h"
@@ -53,19 +55,26 @@
 #include "Basics/SmallVector.h"
 #include "Basics/StaticStrings.h"
 #include "Basics/StringBuffer.h"
+#include "Basics/Utf8Helper.h"
+#include "Basics/VelocyPackHelper.h"
 #include "Cluster/ClusterInfo.h"
 #include "Geo/GeoParams.h"
 #include "GeoIndex/Index.h"
 #include "Graph/TraverserOptions.h"
 #include "Indexes/Index.h"
+#include "Sharding/ShardingInfo.h"
+#include "Sharding/ShardingStrategyGeo.h"
 #include "StorageEngine/EngineSelectorFeature.h"
 #include "StorageEngine/StorageEngine.h"
 #include "Transaction/Methods.h"
 #include "Utils/CollectionNameResolver.h"
+#include "VocBase/LogicalCollection.h"
 #include "VocBase/Methods/Collections.h"
 
 
 #include <boost/optional.hpp>
+#include <s2/s2cap.h>
+#include <s2/s2region_coverer.h>
 #include <tuple>
 
 namespace {
@@ -204,6 +213,112 @@ void restrictToShard(arangodb::aql::ExecutionNode* node, std::string shardId) {
       TRI_ERROR_INTERNAL, "node type cannot be restricted to a single shard");
 }
 
+/// @brief whether the parts of a geo index condition that do not refer to
+/// the document are known at optimization time
+bool isConstantGeoCondition(arangodb::aql::AstNode const* node) {
+  using arangodb::aql::AstNode;
+  AstNode const* fcall = node;
+  switch (node->type) {
+    case arangodb::aql::NODE_TYPE_FCALL:
+      break;
+    case arangodb::aql::NODE_TYPE_OPERATOR_BINARY_LT:
+    case arangodb::aql::NODE_TYPE_OPERATOR_BINARY_LE:
+    case arangodb::aql::NODE_TYPE_OPERATOR_BINARY_GT:
+    case arangodb::aql::NODE_TYPE_OPERATOR_BINARY_GE:
+      if (node->numMembers() != 2 || !node->getMember(1)->isConstant()) {
+        return false;
+      }
+      fcall = node->getMember(0);
+      break;
+    default:
+      return false;
+  }
+  if (fcall->type != arangodb::aql::NODE_TYPE_FCALL) {
+    return false;
+  }
+  AstNode const* args = fcall->getMember(0);
+  return args->numMembers() == 2 && args->getMember(0)->isConstant();
+}
+
+/// @brief the shards of a geo-sharded collection on which an index node
+/// that uses a geo index on the shard keys can find documents. empty if
+/// the node may find documents on all shards
+std::unordered_set<std::string> geoShards(arangodb::aql::IndexNode const* node) {
+  using arangodb::aql::AstNode;
+  std::unordered_set<std::string> result;
+
+  auto* collection = node->collection()->getCollection().get();
+  auto* strategy = dynamic_cast<arangodb::ShardingStrategyGeo*>(
+      collection->shardingInfo()->shardingStrategy());
+  if (strategy == nullptr || node->getIndexes().size() != 1) {
+    return result;
+  }
+
+  // the index must locate documents the way the sharding does
+  auto index = node->getIndexes()[0].getIndex();
+  auto const& shardKeys = collection->shardKeys();
+  if (index->type() != arangodb::Index::TRI_IDX_TYPE_GEO_INDEX ||
+      index->fields().size() != shardKeys.size()) {
+    return result;
+  }
+  for (size_t i = 0; i < shardKeys.size(); ++i) {
+    auto const& field = index->fields()[i];
+    if (field.size() != 1 || field[0].name != shardKeys[i]) {
+      return result;
+    }
+  }
+  if (shardKeys.size() == 1) {
+    VPackBuilder definition;
+    index->toVelocyPack(definition, arangodb::Index::makeFlags());
+    if (!arangodb::basics::VelocyPackHelper::getBooleanValue(definition.slice(), "geoJson", false)) {
+      return result;
+    }
+  }
+
+  AstNode const* root = node->condition()->root();
+  if (root == nullptr || root->numMembers() == 0) {
+    return result;
+  }
+
+  std::vector<S2CellId> cells;
+  for (size_t i = 0; i < root->numMembers(); ++i) {
+    AstNode const* andNode = root->getMemberUnchecked(i);
+    for (size_t j = 0; j < andNode->numMembers(); ++j) {
+      if (!::isConstantGeoCondition(andNode->getMemberUnchecked(j))) {
+        return result;
+      }
+    }
+
+    arangodb::geo::QueryParams params;
+    try {
+      arangodb::geo_index::Index::parseCondition(andNode, node->outVariable(), params);
+    } catch (...) {
+      return result;
+    }
+
+    S2RegionCoverer coverer(params.cover.regionCovererOpts());
+    if (params.filterType != arangodb::geo::FilterType::NONE) {
+      std::vector<S2CellId> covering = params.filterShape.covering(&coverer);
+      cells.insert(cells.end(), covering.begin(), covering.end());
+    } else if (params.origin.is_valid() &&
+               params.maxDistance < arangodb::geo::kMaxDistanceBetweenPoints) {
+      S2Cap cap(params.origin.ToPoint(), S1Angle::Radians(params.maxDistanceRad()));
+      std::vector<S2CellId> covering;
+      coverer.GetCovering(cap, &covering);
+      cells.insert(cells.end(), covering.begin(), covering.end());
+    } else {
+      // an unbounded NEAR query may return documents from anywhere
+      return result;
+    }
+  }
+
+  result = strategy->shardsForCells(cells);
+  if (result.size() >= collection->numberOfShards()) {
+    result.clear();
+  }
+  return result;
+}
+
 struct PairHash {
   template <class T1, class T2>
   size_t operator()(std::pair<T1, T2> const& pair) const noexcept {
@@ -2901,6 +3016,280 @@ void arangodb::aql::removeUnnecessaryCalculationsRule(Optimizer* opt,
   opt->addPlan(std::move(plan), rule, !toUnlink.empty());
 }
 
+/// @brief turns
+///   FOR d IN coll COLLECT AGGREGATE m = MIN(d.a)
+/// into
+///   FOR d IN coll FILTER d.a > null SORT d.a LIMIT 1 COLLECT AGGREGATE m = MIN(d.a)
+/// if there is a sorted index on d.a, so that use-indexes and
+/// use-index-for-sort make this a seek to the first (for MAX: the last)
+/// index entry. MIN and MAX ignore null, so excluding it does not change
+/// the result, and the aggregate of no rows is null as before
+void arangodb::aql::optimizeMinMaxRule(Optimizer* opt, std::unique_ptr<ExecutionPlan> plan,
+                                       OptimizerRule const* rule) {
+  bool modified = false;
+
+  SmallVector<ExecutionNode*>::allocator_type::arena_type a;
+  SmallVector<ExecutionNode*> nodes{a};
+  plan->findNodesOfType(nodes, EN::COLLECT, true);
+
+  Ast* ast = plan->getAst();
+  transaction::Methods* trx = ast->query()->trx();
+
+  for (auto const& n : nodes) {
+    auto collectNode = ExecutionNode::castTo<CollectNode*>(n);
+    if (!collectNode->groupVariables().empty() || collectNode->hasOutVariable() ||
+        collectNode->aggregateVariables().size() != 1) {
+      continue;
+    }
+
+    auto const& aggregate = collectNode->aggregateVariables()[0].second;
+    bool const isMin = (aggregate.second == "MIN");
+    if (!isMin && aggregate.second != "MAX") {
+      continue;
+    }
+
+    auto setter = plan->getVarSetBy(aggregate.first->id);
+    if (setter == nullptr || setter->getType() != EN::CALCULATION) {
+      continue;
+    }
+    AstNode const* access =
+        ExecutionNode::castTo<CalculationNode const*>(setter)->expression()->node();
+    std::pair<Variable const*, std::vector<arangodb::basics::AttributeName>> attribute;
+    if (!access->isAttributeAccessForVariable(attribute, false) ||
+        attribute.second.empty() ||
+        arangodb::basics::TRI_AttributeNamesHaveExpansion(attribute.second)) {
+      continue;
+    }
+
+    auto docSetter = plan->getVarSetBy(attribute.first->id);
+    if (docSetter == nullptr || docSetter->getType() != EN::ENUMERATE_COLLECTION) {
+      continue;
+    }
+    auto en = ExecutionNode::castTo<EnumerateCollectionNode const*>(docSetter);
+
+    bool hasIndex = false;
+    for (auto const& index : trx->indexesForCollection(en->collection()->name())) {
+      if (index->isSorted() && !index->fields().empty() &&
+          arangodb::basics::AttributeName::isIdentical(index->fields()[0],
+                                                       attribute.second, false)) {
+        hasIndex = true;
+        break;
+      }
+    }
+    if (!hasIndex) {
+      continue;
+    }
+
+    auto limitNode = new LimitNode(plan.get(), plan->nextId(), 0, 1);
+    plan->registerNode(limitNode);
+    plan->insertDependency(collectNode, limitNode);
+
+    SortElementVector sortElements;
+    sortElements.emplace_back(aggregate.first, isMin);
+    auto sortNode = new SortNode(plan.get(), plan->nextId(), sortElements, false);
+    plan->registerNode(sortNode);
+    plan->insertDependency(limitNode, sortNode);
+
+    // the condition refers to the document, so that use-indexes finds it
+    auto outVar = ast->variables()->createTemporaryVariable();
+    auto condition = ast->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_GT,
+                                                   access->clone(ast),
+                                                   ast->createNodeValueNull());
+    auto filterNode = new FilterNode(plan.get(), plan->nextId(), outVar);
+    plan->registerNode(filterNode);
+    plan->insertDependency(sortNode, filterNode);
+
+    ExecutionNode* calculationNode = nullptr;
+    auto expression = new Expression(plan.get(), ast, condition);
+    try {
+      calculationNode = new CalculationNode(plan.get(), plan->nextId(), expression, outVar);
+    } catch (...) {
+      delete expression;
+      throw;
+    }
+    plan->registerNode(calculationNode);
+    plan->insertDependency(filterNode, calculationNode);
+
+    modified = true;
+  }
+
+  opt->addPlan(std::move(plan), rule, modified);
+}
+
+namespace {
+
+/// @brief whether all values matching LIKE(value, "prefix%") are strings
+/// within the range [prefix, prefix + U+FFFF]. LIKE casts its operand to a
+/// string, so numbers, bools, arrays and objects must not be able to match.
+/// the range is only exact for printable ASCII prefixes with a collation
+/// that does not tailor ASCII characters
+bool isSafeLikePrefix(std::string const& prefix) {
+  if (prefix.empty()) {
+    return false;
+  }
+  for (char c : prefix) {
+    if (c < 0x20 || c > 0x7e) {
+      return false;
+    }
+  }
+  char const c = prefix[0];
+  if ((c >= '0' && c <= '9') || c == '-' || c == '[' || c == '{') {
+    // numbers, arrays and objects
+    return false;
+  }
+  for (std::string const v : {"true", "false"}) {
+    if (v.compare(0, prefix.size(), prefix) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// @brief collects the range conditions for all case-sensitive LIKEs with a
+/// literal prefix among the conjuncts of node
+void collectLikePrefixRanges(ExecutionPlan* plan, transaction::Methods* trx,
+                             AstNode const* node, std::vector<AstNode*>& ranges) {
+  if (node->type == NODE_TYPE_OPERATOR_BINARY_AND ||
+      node->type == NODE_TYPE_OPERATOR_NARY_AND) {
+    for (size_t i = 0; i < node->numMembers(); ++i) {
+      collectLikePrefixRanges(plan, trx, node->getMemberUnchecked(i), ranges);
+    }
+    return;
+  }
+
+  if (node->type != NODE_TYPE_FCALL ||
+      static_cast<Function const*>(node->getData())->name != "LIKE") {
+    return;
+  }
+
+  auto args = node->getMember(0);
+  if (args->numMembers() < 2 || args->numMembers() > 3) {
+    return;
+  }
+  if (args->numMembers() == 3 &&
+      (!args->getMember(2)->isConstant() || args->getMember(2)->isTrue())) {
+    // case-insensitive, or not known at compile time
+    return;
+  }
+
+  auto pattern = args->getMember(1);
+  if (!pattern->isStringValue()) {
+    return;
+  }
+  std::string prefix;
+  if (RegexCache::analyzeLikePattern(prefix, pattern->getStringValue(),
+                                     pattern->getStringLength()) !=
+          RegexCache::LikePatternType::Prefix ||
+      !isSafeLikePrefix(prefix)) {
+    return;
+  }
+
+  auto access = args->getMember(0);
+  std::pair<Variable const*, std::vector<arangodb::basics::AttributeName>> attribute;
+  if (!access->isAttributeAccessForVariable(attribute, false) ||
+      attribute.second.empty() ||
+      arangodb::basics::TRI_AttributeNamesHaveExpansion(attribute.second)) {
+    return;
+  }
+
+  auto docSetter = plan->getVarSetBy(attribute.first->id);
+  if (docSetter == nullptr || docSetter->getType() != EN::ENUMERATE_COLLECTION) {
+    return;
+  }
+  auto en = ExecutionNode::castTo<EnumerateCollectionNode const*>(docSetter);
+
+  bool hasIndex = false;
+  for (auto const& index : trx->indexesForCollection(en->collection()->name())) {
+    if (index->isSorted() && !index->fields().empty() &&
+        arangodb::basics::AttributeName::isIdentical(index->fields()[0],
+                                                     attribute.second, false)) {
+      hasIndex = true;
+      break;
+    }
+  }
+  if (!hasIndex) {
+    return;
+  }
+
+  Ast* ast = plan->getAst();
+  char const* p = ast->query()->registerString(prefix.data(), prefix.size());
+  ranges.push_back(ast->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_GE,
+                                                 access->clone(ast),
+                                                 ast->createNodeValueString(p, prefix.size())));
+  // U+FFFF sorts after all other characters
+  prefix.append("\xef\xbf\xbf");
+  p = ast->query()->registerString(prefix.data(), prefix.size());
+  ranges.push_back(ast->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_LE,
+                                                 access->clone(ast),
+                                                 ast->createNodeValueString(p, prefix.size())));
+}
+
+}  // namespace
+
+/// @brief turns
+///   FOR d IN coll FILTER LIKE(d.a, "abc%")
+/// into
+///   FOR d IN coll FILTER d.a >= "abc" && d.a <= "abc\uFFFF" && LIKE(d.a, "abc%")
+/// if there is a sorted index on d.a, so that use-indexes turns the prefix
+/// into an index range scan. the LIKE is kept, the range only narrows the
+/// input
+void arangodb::aql::optimizeLikePrefixRule(Optimizer* opt, std::unique_ptr<ExecutionPlan> plan,
+                                           OptimizerRule const* rule) {
+  SmallVector<ExecutionNode*>::allocator_type::arena_type a;
+  SmallVector<ExecutionNode*> nodes{a};
+  plan->findNodesOfType(nodes, EN::FILTER, true);
+
+  Ast* ast = plan->getAst();
+  transaction::Methods* trx = ast->query()->trx();
+
+  bool modified = false;
+  // only determined if there is a candidate
+  int collationIsSafe = -1;
+
+  for (auto const& n : nodes) {
+    TRI_ASSERT(n->hasDependency());
+
+    auto const dep = n->getFirstDependency();
+    if (dep->getType() != EN::CALCULATION) {
+      continue;
+    }
+
+    auto fn = ExecutionNode::castTo<FilterNode const*>(n);
+    auto cn = ExecutionNode::castTo<CalculationNode*>(dep);
+    if (cn->outVariable() != fn->inVariable()) {
+      continue;
+    }
+
+    AstNode const* root = cn->expression()->node();
+    std::vector<AstNode*> ranges;
+    collectLikePrefixRanges(plan.get(), trx, root, ranges);
+    if (ranges.empty()) {
+      continue;
+    }
+
+    if (collationIsSafe == -1) {
+      collationIsSafe =
+          arangodb::basics::Utf8Helper::DefaultUtf8Helper.tailorsAscii() ? 0 : 1;
+    }
+    if (collationIsSafe == 0) {
+      break;
+    }
+
+    // a binary AND yields its right operand if the left one is true, so
+    // the value of the calculation stays the same
+    AstNode* condition =
+        ast->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_AND, ranges.back(), root);
+    for (auto it = ranges.rbegin() + 1; it != ranges.rend(); ++it) {
+      condition = ast->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_AND,
+                                                *it, condition);
+    }
+    cn->expression()->replaceNode(condition);
+    modified = true;
+  }
+
+  opt->addPlan(std::move(plan), rule, modified);
+}
+
 /// @brief useIndex, try to use an index for filtering
 void arangodb::aql::useIndexesRule(Optimizer* opt, std::unique_ptr<ExecutionPlan> plan,
                                    OptimizerRule const* rule) {
@@ -4326,11 +4715,13 @@ void arangodb::aql::collectInClusterRule(Optimizer* opt, std::unique_ptr<Executi
             collectNode->groupVariables(copy);
 
             replaceGatherNodeVariables(plan.get(), gatherNode, replacements);
-          } else if (  //! collectNode->groupVariables().empty() &&
-              (!collectNode->hasOutVariable() || collectNode->count())) {
+          } else {
             // clone a COLLECT v1 = expr, v2 = expr ... operation from the
             // coordinator to the DB server(s), and leave an aggregate COLLECT
-            // node on the coordinator for total aggregation
+            // node on the coordinator for total aggregation. a COLLECT ...
+            // INTO builds the partial groups on the DB servers, and the
+            // coordinator concatenates them
+            bool const hasInto = collectNode->hasOutVariableButNoCount();
 
             std::vector<std::pair<Variable const*, std::pair<Variable const*, std::string>>> aggregateVariables;
             if (!collectNode->aggregateVariables().empty()) {
@@ -4352,7 +4743,7 @@ void arangodb::aql::collectInClusterRule(Optimizer* opt, std::unique_ptr<Executi
             }
 
             Variable const* outVariable = nullptr;
-            if (collectNode->count()) {
+            if (collectNode->hasOutVariable()) {
               outVariable = plan->getAst()->variables()->createTemporaryVariable();
             }
 
@@ -4371,8 +4762,11 @@ void arangodb::aql::collectInClusterRule(Optimizer* opt, std::unique_ptr<Executi
 
             auto dbCollectNode =
                 new CollectNode(plan.get(), plan->nextId(), collectNode->getOptions(),
-                                outVars, aggregateVariables, nullptr,
-                                outVariable, std::vector<Variable const*>(),
+                                outVars, aggregateVariables,
+                                hasInto ? collectNode->expressionVariable() : nullptr,
+                                outVariable,
+                                hasInto ? collectNode->keepVariables()
+                                        : std::vector<Variable const*>(),
                                 collectNode->variableMap(), collectNode->count(), false);
 
             plan->registerNode(dbCollectNode);
@@ -4408,6 +4802,18 @@ void arangodb::aql::collectInClusterRule(Optimizer* opt, std::unique_ptr<Executi
                 it.second.second = Aggregator::runOnCoordinatorAs(it.second.second);
                 ++i;
               }
+
+              if (hasInto) {
+                // the groups now come from the DB servers, so the
+                // coordinator neither evaluates the INTO expression nor
+                // needs the kept variables
+                collectNode->aggregateVariables().emplace_back(
+                    std::make_pair(collectNode->outVariable(),
+                                   std::make_pair(outVariable, "MERGE_LISTS")));
+                collectNode->clearOutVariable();
+                collectNode->clearExpressionVariable();
+                collectNode->setKeepVariables(std::vector<Variable const*>());
+              }
             }
 
             removeGatherNodeSort = (dbCollectNode->aggregationMethod() !=
@@ -4422,9 +4828,6 @@ void arangodb::aql::collectInClusterRule(Optimizer* opt, std::unique_ptr<Executi
                 !gatherNode->elements().empty()) {
               replaceGatherNodeVariables(plan.get(), gatherNode, replacements);
             }
-          } else {
-            // all other cases cannot be optimized
-            break;
           }
 
           if (gatherNode != nullptr && removeGatherNodeSort) {
@@ -4655,6 +5058,8 @@ void arangodb::aql::distributeSortToClusterRule(Optimizer* opt,
         case EN::SHORTEST_PATH:
         case EN::REMOTESINGLE:
         case EN::ENUMERATE_IRESEARCH_VIEW:
+        case EN::MATERIALIZE:
+        case EN::HASH_JOIN:
 
           // For all these, we do not want to pull a SortNode further down
           // out to the DBservers, note that potential FilterNodes and
@@ -4708,6 +5113,89 @@ void arangodb::aql::distributeSortToClusterRule(Optimizer* opt,
   opt->addPlan(std::move(plan), rule, modified);
 }
 
+/// @brief copy a LIMIT that follows a GatherNode into the DB server part of
+/// the plan. each shard then stops after offset + count rows, which is all
+/// the coordinator can use of it, sorted or not. the LIMIT itself stays on
+/// the coordinator. the GatherNode also learns the limit, so it does not
+/// fetch full batches from the shards
+void arangodb::aql::distributeLimitToClusterRule(Optimizer* opt,
+                                                 std::unique_ptr<ExecutionPlan> plan,
+                                                 OptimizerRule const* rule) {
+  SmallVector<ExecutionNode*>::allocator_type::arena_type a;
+  SmallVector<ExecutionNode*> nodes{a};
+  plan->findNodesOfType(nodes, EN::GATHER, true);
+
+  bool modified = false;
+
+  for (auto& n : nodes) {
+    auto gatherNode = ExecutionNode::castTo<GatherNode*>(n);
+    auto rn = n->getFirstDependency();
+    if (rn == nullptr || rn->getType() != EN::REMOTE) {
+      continue;
+    }
+
+    // find the LIMIT. calculations in between do not change the number of
+    // rows, everything else (e.g. a SORT or FILTER) does
+    LimitNode* limit = nullptr;
+    ExecutionNode* current = n->getFirstParent();
+    while (current != nullptr) {
+      if (current->getType() == EN::LIMIT) {
+        limit = ExecutionNode::castTo<LimitNode*>(current);
+        break;
+      }
+      if (current->getType() != EN::CALCULATION) {
+        break;
+      }
+      current = current->getFirstParent();
+    }
+
+    if (limit == nullptr || limit->fullCount()) {
+      // fullCount needs to see all rows
+      continue;
+    }
+
+    // the DB servers must not skip work with side effects
+    bool canPush = true;
+    current = rn->getFirstDependency();
+    while (current != nullptr) {
+      auto type = current->getType();
+      if (type == EN::REMOTE || type == EN::SCATTER ||
+          type == EN::DISTRIBUTE || type == EN::SINGLETON) {
+        break;
+      }
+      if (current->isModificationNode()) {
+        canPush = false;
+        break;
+      }
+      current = current->getFirstDependency();
+    }
+    if (!canPush) {
+      continue;
+    }
+
+    size_t const total = limit->offset() + limit->limit();
+    gatherNode->limit(total);
+
+    auto previous = rn->getFirstDependency();
+    if (previous != nullptr && previous->getType() == EN::LIMIT) {
+      auto previousLimit = ExecutionNode::castTo<LimitNode const*>(previous);
+      if (!previousLimit->fullCount() && previousLimit->offset() == 0 &&
+          previousLimit->limit() <= total) {
+        // already limited enough
+        modified = true;
+        continue;
+      }
+    }
+
+    auto shardLimit = new LimitNode(plan.get(), plan->nextId(), 0, total);
+    plan->registerNode(shardLimit);
+    plan->insertDependency(rn, shardLimit);
+    modified = true;
+  }
+
+  opt->addPlan(std::move(plan), rule, modified);
+}
+
 /// @brief try to get rid of a RemoteNode->ScatterNode combination which has
 /// only a SingletonNode and possibly some CalculationNodes as dependencies
 void arangodb::aql::removeUnnecessaryRemoteScatterRule(Optimizer* opt,
@@ -4921,6 +5409,19 @@ void arangodb::aql::restrictToSingleShardRule(Optimizer* opt,
             shardId = *shards.begin();
             ::restrictToShard(current, shardId);
             forwardRestrictionToPrototype(current, shardId);
+          } else if (currentType == ExecutionNode::INDEX) {
+            // geo queries on a geo-sharded collection only need the shards
+            // that intersect the query region
+            auto geoShards = ::geoShards(ExecutionNode::castTo<IndexNode const*>(current));
+            if (geoShards.size() == 1) {
+              wasModified = true;
+              shardId = *geoShards.begin();
+              ::restrictToShard(current, shardId);
+              forwardRestrictionToPrototype(current, shardId);
+            } else if (!geoShards.empty()) {
+              wasModified = true;
+              ExecutionNode::castTo<IndexNode*>(current)->restrictToShards(std::move(geoShards));
+            }
           }
         }
       } else if (currentType == ExecutionNode::UPSERT || currentType == ExecutionNode::REMOTE ||
@@ -7255,3 +7756,123 @@ void arangodb::aql::optimizeSubqueriesRule(Optimizer* opt,
 
   opt->addPlan(std::move(plan), rule, modified);
 }
+
+namespace {
+/// @brief extracts the attribute path of an attribute access for a
+/// variable. returns false for expansions, indexed access and _id, which
+/// is stored in a custom type in documents
+bool hashJoinAttribute(arangodb::aql::AstNode const* node,
+                       std::pair<Variable const*, std::vector<arangodb::basics::AttributeName>>& access,
+                       std::vector<std::string>& path) {
+  access.first = nullptr;
+  access.second.clear();
+  if (!node->isAttributeAccessForVariable(access, false) || access.second.empty() ||
+      arangodb::basics::TRI_AttributeNamesHaveExpansion(access.second) ||
+      access.second[0].name == StaticStrings::IdString) {
+    return false;
+  }
+  path.clear();
+  for (auto const& it : access.second) {
+    path.emplace_back(it.name);
+  }
+  return true;
+}
+}  // namespace
+
+/// @brief replace the full scan of the inner collection of an equi-join with
+/// a hash join if there is no index the join could use. looks for
+///   FOR a IN outer FOR b IN inner FILTER b.x == a.y
+/// and reads inner just once into a hash table on b.x
+void arangodb::aql::hashJoinRule(Optimizer* opt, std::unique_ptr<ExecutionPlan> plan,
+                                 OptimizerRule const* rule) {
+  bool modified = false;
+
+  // the documents are read once at the start of the query, so a query
+  // that modifies documents could see stale ones. on a coordinator the
+  // inner collection is spread over the shards
+  if (ServerState::instance()->isCoordinator() || plan->contains(EN::INSERT) ||
+      plan->contains(EN::UPDATE) || plan->contains(EN::REPLACE) ||
+      plan->contains(EN::REMOVE) || plan->contains(EN::UPSERT)) {
+    opt->addPlan(std::move(plan), rule, modified);
+    return;
+  }
+
+  SmallVector<ExecutionNode*>::allocator_type::arena_type a;
+  SmallVector<ExecutionNode*> nodes{a};
+  plan->findNodesOfType(nodes, EN::ENUMERATE_COLLECTION, true);
+
+  if (nodes.empty()) {
+    opt->addPlan(std::move(plan), rule, modified);
+    return;
+  }
+
+  plan->findVarUsage();
+  transaction::Methods* trx = plan->getAst()->query()->trx();
+
+  for (auto const& n : nodes) {
+    auto en = ExecutionNode::castTo<EnumerateCollectionNode*>(n);
+    if (!en->isDeterministic() || !en->isInInnerLoop()) {
+      continue;
+    }
+
+    Variable const* innerVariable = en->outVariable();
+    auto const& varsValid = en->getVarsValid();
+
+    Variable const* outerVariable = nullptr;
+    std::vector<std::string> outerAttribute;
+    std::vector<std::string> innerAttribute;
+
+    // look for an equality filter right after the collection scan
+    ExecutionNode* current = en->getFirstParent();
+    while (current != nullptr && outerVariable == nullptr &&
+           (current->getType() == EN::CALCULATION || current->getType() == EN::FILTER)) {
+      if (current->getType() == EN::FILTER) {
+        auto setter = plan->getVarSetBy(
+            ExecutionNode::castTo<FilterNode const*>(current)->inVariable()->id);
+        if (setter != nullptr && setter->getType() == EN::CALCULATION &&
+            setter->isDeterministic()) {
+          auto condition = ExecutionNode::castTo<CalculationNode*>(setter)->expression()->node();
+          if (condition->type == NODE_TYPE_OPERATOR_BINARY_EQ) {
+            std::pair<Variable const*, std::vector<arangodb::basics::AttributeName>> lhs, rhs;
+            std::vector<std::string> lhsPath, rhsPath;
+            if (::hashJoinAttribute(condition->getMember(0), lhs, lhsPath) &&
+                ::hashJoinAttribute(condition->getMember(1), rhs, rhsPath)) {
+              if (rhs.first == innerVariable) {
+                std::swap(lhs, rhs);
+                std::swap(lhsPath, rhsPath);
+              }
+              if (lhs.first == innerVariable && rhs.first != innerVariable &&
+                  varsValid.find(rhs.first) != varsValid.end()) {
+                outerVariable = rhs.first;
+                outerAttribute = std::move(rhsPath);
+                innerAttribute = std::move(lhsPath);
+              }
+            }
+          }
+        }
+      }
+      current = current->getFirstParent();
+    }
+
+    if (outerVariable == nullptr) {
+      continue;
+    }
+
+    // nested loop: N scans of the inner collection. hash join: one scan
+    // plus a lookup per outer row
+    double const outer = en->getFirstDependency()->getCost().estimatedNrItems;
+    double const inner = static_cast<double>(en->collection()->count(trx));
+    if (2.0 * inner + outer + 1.0 >= outer * inner + 1.0) {
+      continue;
+    }
+
+    auto join = new HashJoinNode(plan.get(), plan->nextId(), en->collection(),
+                                 innerVariable, outerVariable,
+                                 std::move(outerAttribute), std::move(innerAttribute));
+    plan->registerNode(join);
+    plan->replaceNode(en, join);
+    modified = true;
+  }
+
+  opt->addPlan(std::move(plan), rule, modified);
+}
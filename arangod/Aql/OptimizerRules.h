@@ -42,6 +42,10 @@ Collection* addCollectionToQuery(Query* query, std::string const& cname, bool as
 /// @brief adds a SORT operation for IN right-hand side operands
 void sortInValuesRule(Optimizer*, std::unique_ptr<ExecutionPlan>, OptimizerRule const*);
 
+/// @brief replace the scan of the inner collection of an equi-join without
+/// a usable index with a hash join
+void hashJoinRule(Optimizer*, std::unique_ptr<ExecutionPlan>, OptimizerRule const*);
+
 /// @brief remove redundant sorts
 /// this rule modifies the plan in place:
 /// - sorts that are covered by earlier sorts will be removed
@@ -105,6 +109,14 @@ void removeRedundantCalculationsRule(Optimizer*, std::unique_ptr<ExecutionPlan>,
 void removeUnnecessaryCalculationsRule(Optimizer*, std::unique_ptr<ExecutionPlan>,
                                        OptimizerRule const*);
 
+/// @brief let MIN/MAX over an indexed attribute read just the first or
+/// last index entry
+void optimizeMinMaxRule(Optimizer*, std::unique_ptr<ExecutionPlan>, OptimizerRule const*);
+
+/// @brief add a range condition for LIKE with a literal prefix on an
+/// attribute with a sorted index
+void optimizeLikePrefixRule(Optimizer*, std::unique_ptr<ExecutionPlan>, OptimizerRule const*);
+
 /// @brief useIndex, try to use an index for filtering
 void useIndexesRule(Optimizer*, std::unique_ptr<ExecutionPlan>, OptimizerRule const*);
 
@@ -170,6 +182,11 @@ void distributeFilternCalcToClusterRule(Optimizer*, std::unique_ptr<ExecutionPla
 void distributeSortToClusterRule(Optimizer*, std::unique_ptr<ExecutionPlan>,
                                  OptimizerRule const*);
 
+/// @brief copy a LIMIT that follows a GatherNode into the DB server part of
+/// the plan, so that the shards do not produce more rows than needed
+void distributeLimitToClusterRule(Optimizer*, std::unique_ptr<ExecutionPlan>,
+                                  OptimizerRule const*);
+
 /// @brief try to get rid of a RemoteNode->ScatterNode combination which has
 /// only a SingletonNode and possibly some CalculationNodes as dependencies
 void removeUnnecessaryRemoteScatterRule(Optimizer*, std::unique_ptr<ExecutionPlan>,
@@ -230,6 +230,16 @@ void OptimizerRulesFeature::addRules() {
   registerRule("remove-redundant-or", removeRedundantOrRule, OptimizerRule::removeRedundantOrRule,
                DoesNotCreateAdditionalPlans, CanBeDisabled);
 
+  // prepare MIN/MAX aggregates for an index seek
+  registerRule("optimize-min-max", optimizeMinMaxRule, OptimizerRule::optimizeMinMaxRule,
+               DoesNotCreateAdditionalPlans, CanBeDisabled);
+
+  // add a range for LIKE with a literal prefix, so that a sorted index
+  // can be used
+  registerRule("optimize-like-prefix", optimizeLikePrefixRule,
+               OptimizerRule::optimizeLikePrefixRule,
+               DoesNotCreateAdditionalPlans, CanBeDisabled);
+
   // try to find a filter after an enumerate collection and find indexes
   registerRule("use-indexes", useIndexesRule, OptimizerRule::useIndexesRule,
                DoesNotCreateAdditionalPlans, CanBeDisabled);
@@ -285,6 +295,21 @@ void OptimizerRulesFeature::addRules() {
                                       OptimizerRule::applySortLimitRule,
                                       DoesNotCreateAdditionalPlans, CanBeDisabled);
 
+  // make views aware of subsequent limited sorts on scorers
+  registerRule("arangosearch-scores-limit", arangodb::iresearch::scoresLimitRule,
+               OptimizerRule::applyArangoSearchScoresLimitRule,
+               DoesNotCreateAdditionalPlans, CanBeDisabled);
+
+  // produce view documents from the values stored in the view
+  registerRule("use-arangosearch-stored-values", arangodb::iresearch::storedValuesRule,
+               OptimizerRule::arangoSearchStoredValuesRule,
+               DoesNotCreateAdditionalPlans, CanBeDisabled);
+
+  // join with a hash table instead of scanning the inner collection
+  // once for each outer row
+  registerRule("hash-join", hashJoinRule, OptimizerRule::hashJoinRule,
+               DoesNotCreateAdditionalPlans, CanBeDisabled);
+
   if (arangodb::ServerState::instance()->isCoordinator()) {
     registerRule("optimize-cluster-single-document-operations",
                  substituteClusterSingleDocumentOperations,
@@ -343,6 +368,10 @@ void OptimizerRulesFeature::addRules() {
     registerRule("restrict-to-single-shard", restrictToSingleShardRule,
                  OptimizerRule::restrictToSingleShardRule,
                  DoesNotCreateAdditionalPlans, CanBeDisabled);
+
+    registerRule("distribute-limit-to-cluster", distributeLimitToClusterRule,
+                 OptimizerRule::distributeLimitToClusterRule,
+                 DoesNotCreateAdditionalPlans, CanBeDisabled);
   }
 
   // finally add the storage-engine specific rules
@@ -31,6 +31,7 @@
 #include "VocBase/vocbase.h"
 
 #include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
 
 using namespace arangodb::aql;
 
@@ -38,7 +39,7 @@ using namespace arangodb::aql;
 static arangodb::aql::PlanCache Instance;
 
 /// @brief create the plan cache
-PlanCache::PlanCache() : _lock(), _plans() {}
+PlanCache::PlanCache() : _lock(), _hits(0), _misses(0), _plans() {}
 
 /// @brief destroy the plan cache
 PlanCache::~PlanCache() {}
@@ -46,24 +47,33 @@ PlanCache::~PlanCache() {}
 /// @brief lookup a plan in the cache
 std::shared_ptr<PlanCacheEntry> PlanCache::lookup(TRI_vocbase_t* vocbase, uint64_t queryHash,
                                                   QueryString const& queryString) {
-  READ_LOCKER(readLocker, _lock);
+  std::shared_ptr<PlanCacheEntry> entry;
 
-  auto it = _plans.find(vocbase);
+  {
+    READ_LOCKER(readLocker, _lock);
 
-  if (it == _plans.end()) {
-    // no entry found for the requested database
-    return std::shared_ptr<PlanCacheEntry>();
-  }
+    auto it = _plans.find(vocbase);
+
+    if (it != _plans.end()) {
+      auto it2 = (*it).second.find(queryHash);
 
-  auto it2 = (*it).second.find(queryHash);
+      if (it2 != (*it).second.end()) {
+        entry = (*it2).second;
+      }
+    }
+  }
 
-  if (it2 == (*it).second.end()) {
-    // plan not found in cache
+  if (entry == nullptr ||
+      entry->queryString.size() != queryString.size() ||
+      memcmp(entry->queryString.data(), queryString.data(), queryString.size()) != 0) {
+    // plan not found in cache, or a different query with the same hash
+    _misses.fetch_add(1, std::memory_order_relaxed);
     return std::shared_ptr<PlanCacheEntry>();
   }
 
   // plan found in cache
-  return (*it2).second;
+  _hits.fetch_add(1, std::memory_order_relaxed);
+  return entry;
 }
 
 /// @brief store a plan in the cache
@@ -74,8 +84,15 @@ void PlanCache::store(TRI_vocbase_t* vocbase, uint64_t hash,
 
   WRITE_LOCKER(writeLocker, _lock);
 
-  // store cache entry
-  _plans[vocbase].insert({hash, std::move(entry)});
+  auto& plans = _plans[vocbase];
+
+  if (plans.size() >= maxEntriesPerDatabase && plans.find(hash) == plans.end()) {
+    // make room for the new entry by evicting an arbitrary other one
+    plans.erase(plans.begin());
+  }
+
+  // store cache entry, replacing an existing entry with the same hash
+  plans[hash] = std::move(entry);
 }
 
 /// @brief invalidate all queries for a particular database
@@ -85,5 +102,22 @@ void PlanCache::invalidate(TRI_vocbase_t* vocbase) {
   _plans.erase(vocbase);
 }
 
+/// @brief return the cache statistics
+void PlanCache::toVelocyPack(VPackBuilder& builder) const {
+  size_t entries = 0;
+  {
+    READ_LOCKER(readLocker, _lock);
+    for (auto const& it : _plans) {
+      entries += it.second.size();
+    }
+  }
+
+  builder.openObject();
+  builder.add("hits", VPackValue(_hits.load(std::memory_order_relaxed)));
+  builder.add("misses", VPackValue(_misses.load(std::memory_order_relaxed)));
+  builder.add("entries", VPackValue(entries));
+  builder.close();
+}
+
 /// @brief get the plan cache instance
 PlanCache* PlanCache::instance() { return &Instance; }
@@ -27,6 +27,8 @@
 #include "Basics/Common.h"
 #include "Basics/ReadWriteLock.h"
 
+#include <atomic>
+
 struct TRI_vocbase_t;
 
 namespace arangodb {
@@ -60,7 +62,8 @@ class PlanCache {
   ~PlanCache();
 
  public:
-  /// @brief lookup a plan in the cache
+  /// @brief lookup a plan in the cache. entries are only returned if their
+  /// query string matches, so hash collisions cannot produce wrong plans
   std::shared_ptr<PlanCacheEntry> lookup(TRI_vocbase_t*, uint64_t, QueryString const&);
 
   /// @brief store a plan in the cache
@@ -69,12 +72,24 @@ class PlanCache {
   /// @brief invalidate all plans for a particular database
   void invalidate(TRI_vocbase_t*);
 
+  /// @brief return the cache statistics (hits, misses, number of entries)
+  void toVelocyPack(arangodb::velocypack::Builder&) const;
+
   /// @brief get the pointer to the global plan cache
   static PlanCache* instance();
 
  private:
+  /// @brief maximum number of plans stored per database
+  static constexpr size_t maxEntriesPerDatabase = 256;
+
   /// @brief read-write lock for the cache
-  arangodb::basics::ReadWriteLock _lock;
+  mutable arangodb::basics::ReadWriteLock _lock;
+
+  /// @brief number of successful lookups
+  std::atomic<uint64_t> _hits;
+
+  /// @brief number of unsuccessful lookups
+  std::atomic<uint64_t> _misses;
 
   /// @brief cached query plans, organized per database
   std::unordered_map<TRI_vocbase_t*, std::unordered_map<uint64_t, std::shared_ptr<PlanCacheEntry>>> _plans;
@@ -38,7 +38,10 @@
 #include "Basics/Exceptions.h"
 #include "Basics/VelocyPackHelper.h"
 #include "Basics/fasthash.h"
+#include "Cluster/ClusterInfo.h"
+#include "Cluster/ClusterMethods.h"
 #include "Cluster/ServerState.h"
+#include "Graph/CoordinatorVertexCache.h"
 #include "Graph/Graph.h"
 #include "Graph/GraphManager.h"
 #include "Logger/Logger.h"
@@ -55,6 +58,7 @@
 #include "V8/v8-conv.h"
 #include "V8/v8-vpack.h"
 #include "V8Server/V8DealerFeature.h"
+#include "VocBase/DatabaseQuota.h"
 #include "VocBase/LogicalCollection.h"
 #include "VocBase/vocbase.h"
 
@@ -210,6 +214,10 @@ Query::~Query() {
 
   exitContext();
 
+  if (_countedInQuota) {
+    _vocbase.quota().finishQuery();
+  }
+
   _ast.reset();
   _graphs.clear();
 
@@ -231,8 +239,7 @@ Query* Query::clone(QueryPart part, bool withPlan) {
   auto clone = std::make_unique<Query>(false, _vocbase, _queryString,
                                        std::shared_ptr<VPackBuilder>(), _options, part);
 
-  clone->_resourceMonitor = _resourceMonitor;
-  clone->_resourceMonitor.clear();
+  clone->_resourceMonitor.setMemoryLimit(_resourceMonitor.maxResources.memoryUsage);
 
   if (_isModificationQuery) {
     clone->setIsModificationQuery();
@@ -276,6 +283,11 @@ void Query::setExecutionTime() {
   if (_engine != nullptr) {
     _engine->_stats.setPeakMemoryUsage(_resourceMonitor.currentResources.peakMemoryUsage);
     _engine->_stats.setExecutionTime(TRI_microtime() - _startTime);
+    if (_trx != nullptr && _trx->state() != nullptr && !_isClonedQuery) {
+      // clones share the transaction of their origin, count it once
+      _engine->_stats.intermediateCommits =
+          static_cast<int64_t>(_trx->state()->numIntermediateCommits());
+    }
   }
 }
     
@@ -345,19 +357,36 @@ void Query::registerWarning(int code, char const* details) {
 void Query::prepare(QueryRegistry* registry) {
   TRI_ASSERT(registry != nullptr);
 
+  if (_part == PART_MAIN) {
+    if (!_countedInQuota) {
+      // fails if the database runs too many queries
+      _vocbase.quota().startQuery();
+      _countedInQuota = true;
+    }
+    // queued while the global query memory budget is exhausted
+    GlobalResourceMonitor::instance().admit();
+
+    transaction::Options& trxOptions = _queryOptions.transactionOptions;
+    if (trxOptions.consistentSnapshot && trxOptions.snapshotTimestamp == 0 &&
+        ServerState::instance()->isCoordinator()) {
+      // all DB servers read their shards as of this timestamp
+      trxOptions.snapshotTimestamp = transaction::Options::consistentSnapshotTimestamp();
+    }
+  }
+
   init();
   enterState(QueryExecutionState::ValueType::PARSING);
 
   std::unique_ptr<ExecutionPlan> plan;
 
 #if USE_PLAN_CACHE
-  if (!_queryString.empty() && hashQuery() != DontCache && _part == PART_MAIN) {
+  if (!_queryString.empty() && hash() != DontCache && _part == PART_MAIN) {
     // LOG_TOPIC("d79d9", INFO, Logger::FIXME) << "trying to find query in execution plan
-    // cache: '" << _queryString << "', hash: " << hashQuery();
+    // cache: '" << _queryString << "', hash: " << hash();
 
     // store & lookup velocypack plans!!
     std::shared_ptr<PlanCacheEntry> planCacheEntry =
-        PlanCache::instance()->lookup(_vocbase, hashQuery(), queryString);
+        PlanCache::instance()->lookup(&_vocbase, hash(), _queryString);
     if (planCacheEntry != nullptr) {
       // LOG_TOPIC("8aa30", INFO, Logger::FIXME) << "query found in execution plan cache:
       // '" << _queryString << "'";
@@ -377,7 +406,7 @@ void Query::prepare(QueryRegistry* registry) {
 
       enterState(QueryExecutionState::ValueType::LOADING_COLLECTIONS);
 
-      Result res = trx->addCollections(*_collections.collections());
+      Result res = _trx->addCollections(*_collections.collections());
 
       if (res.ok()) {
         res = _trx->begin();
@@ -409,11 +438,11 @@ void Query::prepare(QueryRegistry* registry) {
     TRI_ASSERT(plan != nullptr);
 
 #if USE_PLAN_CACHE
-    if (!_queryString.empty() && hashQuery() != DontCache &&
+    if (!_queryString.empty() && hash() != DontCache &&
         _part == PART_MAIN && _warnings.empty() && _ast->root()->isCacheable()) {
       // LOG_TOPIC("6de32", INFO, Logger::FIXME) << "storing query in execution plan
-      // cache '" << _queryString << "', hash: " << hashQuery();
-      PlanCache::instance()->store(_vocbase, hashQuery(), _queryString, plan.get());
+      // cache '" << _queryString << "', hash: " << hash();
+      PlanCache::instance()->store(&_vocbase, hash(), _queryString, plan.get());
     }
 #endif
   }
@@ -423,6 +452,16 @@ void Query::prepare(QueryRegistry* registry) {
 
   TRI_ASSERT(_engine == nullptr);
   TRI_ASSERT(_trx != nullptr);
+
+  if (ServerState::instance()->isCoordinator() &&
+      ((canUseQueryCache() && _ast->root()->isCacheable()) ||
+       (!_isModificationQuery && graph::CoordinatorVertexCache::instance() != nullptr))) {
+    // the DB servers take their snapshots when the engine is instantiated.
+    // the ticks must be read before, so that they are never newer than the
+    // data the result is built from. traversals use them for the vertex cache
+    fetchShardTicks();
+  }
+
   // note that the engine returned here may already be present in our
   // own _engine attribute (the instanciation procedure may modify us
   // by calling our engine(ExecutionEngine*) function
@@ -577,6 +616,10 @@ ExecutionState Query::execute(QueryRegistry* registry, QueryResult& queryResult)
           auto cacheEntry =
               arangodb::aql::QueryCache::instance()->lookup(&_vocbase, hash(), _queryString,
                                                             bindParameters());
+          if (cacheEntry != nullptr && !isCacheEntryValid(*cacheEntry)) {
+            // a shard has been modified since the result was cached
+            cacheEntry.reset();
+          }
 
           if (cacheEntry != nullptr) {
             bool hasPermissions = true;
@@ -701,6 +744,10 @@ ExecutionState Query::execute(QueryRegistry* registry, QueryResult& queryResult)
                                                       bindParameters(),
                                                       std::move(dataSources)  // query DataSources
               );
+          if (!attachShardTicks(*_cacheEntry)) {
+            // we could not tell later whether the result is still valid
+            _cacheEntry.reset();
+          }
         }
 
         queryResult.data = std::move(_resultBuilder);
@@ -783,6 +830,10 @@ ExecutionState Query::executeV8(v8::Isolate* isolate, QueryRegistry* registry,
       auto cacheEntry =
           arangodb::aql::QueryCache::instance()->lookup(&_vocbase, hash(), _queryString,
                                                         bindParameters());
+      if (cacheEntry != nullptr && !isCacheEntryValid(*cacheEntry)) {
+        // a shard has been modified since the result was cached
+        cacheEntry.reset();
+      }
 
       if (cacheEntry != nullptr) {
         bool hasPermissions = true;
@@ -915,6 +966,10 @@ ExecutionState Query::executeV8(v8::Isolate* isolate, QueryRegistry* registry,
                                                             builder, bindParameters(),
                                                             std::move(dataSources)  // query DataSources
       );
+      if (!attachShardTicks(*_cacheEntry)) {
+        // we could not tell later whether the result is still valid
+        _cacheEntry.reset();
+      }
     }
 
     // will set warnings, stats, profile and cleanup plan and engine
@@ -1215,6 +1270,9 @@ void Query::exitContext() {
         ctx->unregisterTransaction();
       }
 
+      // the handles must be released while the context is still entered
+      _v8Functions.clear();
+
       TRI_ASSERT(V8DealerFeature::DEALER != nullptr);
       V8DealerFeature::DEALER->exitContext(_context);
       _context = nullptr;
@@ -1223,6 +1281,41 @@ void Query::exitContext() {
   }
 }
 
+v8::Handle<v8::Function> Query::aqlV8Function(v8::Isolate* isolate,
+                                             std::string const& name) {
+  if (!_contextOwnedByExterior) {
+    auto it = _v8Functions.find(name);
+    if (it != _v8Functions.end()) {
+      return v8::Local<v8::Function>::New(isolate, (*it).second);
+    }
+  }
+
+  auto current = isolate->GetCurrentContext()->Global();
+
+  v8::Handle<v8::Value> module =
+      current->Get(TRI_V8_ASCII_STRING(isolate, "_AQL"));
+  if (module.IsEmpty() || !module->IsObject()) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                   "unable to find global _AQL module");
+  }
+
+  v8::Handle<v8::Value> function =
+      v8::Handle<v8::Object>::Cast(module)->Get(TRI_V8_STD_STRING(isolate, name));
+  if (function.IsEmpty() || !function->IsFunction()) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(
+        TRI_ERROR_INTERNAL,
+        std::string("unable to find AQL function '") + name + "'");
+  }
+
+  auto result = v8::Handle<v8::Function>::Cast(function);
+  if (!_contextOwnedByExterior) {
+    // a context entered from outside may be left without the query
+    // noticing, so only handles of our own context are kept
+    _v8Functions.emplace(name, v8::Global<v8::Function>(isolate, result));
+  }
+  return result;
+}
+
 /// @brief returns statistics for current query.
 void Query::getStats(VPackBuilder& builder) {
   if (_engine != nullptr) {
@@ -1318,10 +1411,92 @@ uint64_t Query::calculateHash() const {
   }
   hash ^= options.hash();
 
-  // blend query hash with bind parameters
+  // blend query hash with bind parameters. this is required because bind
+  // parameter values are injected into the AST before optimization, so the
+  // optimizer's decisions (constant folding, index selection etc.) depend on
+  // them. an optimized plan can thus not be reused with different bind values
   return hash ^ _bindParameters.hash();
 }
 
+/// @brief the shards of all collections of the query, on a coordinator
+bool Query::shardsOfCollections(std::vector<std::string>& shards) const {
+  ClusterInfo* ci = ClusterInfo::instance();
+  for (auto const& it : *_collections.collections()) {
+    auto collection = ci->getCollectionNT(_vocbase.name(), it.first);
+    if (collection == nullptr) {
+      return false;
+    }
+    for (auto const& shard : *collection->shardIds()) {
+      shards.emplace_back(shard.first);
+    }
+  }
+  return true;
+}
+
+/// @brief read the invalidation ticks of all shards of the query
+void Query::fetchShardTicks() {
+  _hasShardTicks = false;
+  _shardTicks.clear();
+
+  for (auto const& dataSource : _queryDataSources) {
+    if (_collections.get(dataSource.second) == nullptr) {
+      // e.g. a view. views have no invalidation ticks
+      return;
+    }
+  }
+
+  std::vector<ShardID> shards;
+  if (!shardsOfCollections(shards)) {
+    return;
+  }
+  if (!shards.empty() &&
+      invalidationTicksOnCoordinator(_vocbase.name(), shards, _shardTicks) != TRI_ERROR_NO_ERROR) {
+    _shardTicks.clear();
+    return;
+  }
+  _hasShardTicks = (_shardTicks.size() == shards.size());
+}
+
+/// @brief store the shard ticks in a new cache entry. returns false if the
+/// entry must not be cached
+bool Query::attachShardTicks(QueryCacheResultEntry& entry) const {
+  if (!ServerState::instance()->isCoordinator()) {
+    return true;
+  }
+  if (!_hasShardTicks) {
+    return false;
+  }
+  for (auto const& dataSource : entry._dataSources) {
+    if (_collections.get(dataSource.second) == nullptr) {
+      // used by the transaction, but its shard ticks are unknown
+      return false;
+    }
+  }
+  entry._shardTicks = _shardTicks;
+  return true;
+}
+
+/// @brief whether a cached result is still valid. on a coordinator, this
+/// compares the invalidation ticks of all shards the result was built from
+/// with their current ones
+bool Query::isCacheEntryValid(QueryCacheResultEntry const& entry) const {
+  if (!ServerState::instance()->isCoordinator() || entry._shardTicks.empty()) {
+    return true;
+  }
+
+  std::vector<ShardID> shards;
+  shards.reserve(entry._shardTicks.size());
+  for (auto const& it : entry._shardTicks) {
+    shards.emplace_back(it.first);
+  }
+
+  std::unordered_map<ShardID, uint64_t> ticks;
+  if (invalidationTicksOnCoordinator(_vocbase.name(), shards, ticks) != TRI_ERROR_NO_ERROR) {
+    return false;
+  }
+  return ticks == entry._shardTicks;
+}
+
 /// @brief whether or not the query cache can be used for the query
 bool Query::canUseQueryCache() const {
   if (_queryString.size() < 8) {
@@ -1338,8 +1513,9 @@ bool Query::canUseQueryCache() const {
     // cache mode is set to always on or on-demand...
     // query will only be cached if `cache` attribute is not set to false
 
-    // cannot use query cache on a coordinator at the moment
-    return !arangodb::ServerState::instance()->isRunningInCluster();
+    // DB servers only execute parts of queries. results cached on a
+    // coordinator are validated by the invalidation ticks of their shards
+    return !arangodb::ServerState::instance()->isDBServer();
   }
 
   return false;
@@ -1357,6 +1533,14 @@ void Query::enterState(QueryExecutionState::ValueType state) {
 
   // and adjust the state
   _state = state;
+
+  _stateSpan.finish();
+  tracing::SpanContext trace = tracing::current();
+  if (trace.sampled() && state != QueryExecutionState::ValueType::FINISHED &&
+      state != QueryExecutionState::ValueType::INVALID_STATE) {
+    _stateSpan = tracing::Span(
+        ("AQL " + QueryExecutionState::toString(state)).c_str(), trace);
+  }
 }
 
 void Query::cleanupPlanAndEngineSync(int errorCode, VPackBuilder* statsBuilder) noexcept {
@@ -1389,6 +1573,7 @@ ExecutionState Query::cleanupPlanAndEngine(int errorCode, VPackBuilder* statsBui
         statsBuilder->add(VPackValue("stats"));
         _engine->_stats.toVelocyPack(*statsBuilder, _queryOptions.fullCount);
       }
+      _engine->collectMetrics(_metrics);
     } catch (...) {
       // shutdown may fail but we must not throw here
       // (we're also called from the destructor)
@@ -29,6 +29,7 @@
 #include "Aql/ExecutionState.h"
 #include "Aql/Graphs.h"
 #include "Aql/QueryExecutionState.h"
+#include "Aql/QueryMetrics.h"
 #include "Aql/QueryOptions.h"
 #include "Aql/QueryResources.h"
 #include "Aql/QueryResultV8.h"
@@ -40,6 +41,7 @@
 #include "Basics/Common.h"
 #include "Basics/ConditionLocker.h"
 #include "Basics/ConditionVariable.h"
+#include "Statistics/Tracing.h"
 #include "V8Server/V8Context.h"
 #include "VocBase/voc-types.h"
 
@@ -136,6 +138,10 @@ class Query {
 
   QueryProfile* profile() const { return _profile.get(); }
 
+  /// @brief metrics of the execution nodes, available once the execution
+  /// engine is destroyed
+  QueryMetrics const& metrics() const { return _metrics; }
+
   velocypack::Slice optionsSlice() const { return _options->slice(); }
   TEST_VIRTUAL QueryOptions const& queryOptions() const {
     return _queryOptions;
@@ -151,6 +157,11 @@ class Query {
 
   ResourceMonitor* resourceMonitor() { return &_resourceMonitor; }
 
+  /// @brief the memory the query has reserved from the global budget. this
+  /// is its memory usage rounded up to whole chunks, and may be read by any
+  /// thread
+  size_t reservedMemory() const { return _resourceMonitor.reservedMemory(); }
+
   /// @brief return the start timestamp of the query
   double startTime() const { return _startTime; }
 
@@ -186,6 +197,9 @@ class Query {
   /// @brief add a node to the list of nodes
   void addNode(AstNode* node) { _resources.addNode(node); }
 
+  /// @brief create a node in the query's node arena
+  AstNode* createNode(AstNodeType type) { return _resources.createNode(type); }
+
   /// @brief register a string
   /// the string is freed when the query is destroyed
   char* registerString(char const* p, size_t length) {
@@ -204,6 +218,13 @@ class Query {
     return _resources.registerEscapedString(p, length, outLength);
   }
 
+  /// @brief register a short string in VelocyPack format, reusing an
+  /// already registered one with the same contents. returns a nullptr if
+  /// the string cannot be registered
+  uint8_t const* registerVPackString(char const* p, size_t length) {
+    return _resources.registerVPackString(p, length);
+  }
+
   /// @brief register an error, with an optional parameter inserted into printf
   /// this also makes the query abort
   void registerError(int, char const* = nullptr);
@@ -263,6 +284,12 @@ class Query {
   /// @brief mark a query as modification query
   void setIsModificationQuery() { _isModificationQuery = true; }
 
+  /// @brief invalidation ticks of all shards of the query, read before the
+  /// query was instantiated on a coordinator. nullptr if they are unknown
+  std::unordered_map<std::string, uint64_t> const* shardTicks() const {
+    return _hasShardTicks ? &_shardTicks : nullptr;
+  }
+
   /// @brief prepare a V8 context for execution for this expression
   /// this needs to be called once before executing any V8 function in this
   /// expression
@@ -282,6 +309,11 @@ class Query {
   // @brief resets the contexts load-state of the AQL functions.
   void unPrepareV8Context() { _preparedV8Context = false; }
 
+  /// @brief returns the function of the global _AQL module with the given
+  /// name. the lookup is done once per V8 context the query owns, not once
+  /// per invocation
+  v8::Handle<v8::Function> aqlV8Function(v8::Isolate*, std::string const& name);
+
   /// @brief returns statistics for current query.
   void getStats(arangodb::velocypack::Builder&);
 
@@ -328,6 +360,20 @@ class Query {
   /// @brief whether or not the query cache can be used for the query
   bool canUseQueryCache() const;
 
+  /// @brief the shards of all collections of the query, on a coordinator
+  bool shardsOfCollections(std::vector<std::string>& shards) const;
+
+  /// @brief read the invalidation ticks of all shards of the query, on a
+  /// coordinator
+  void fetchShardTicks();
+
+  /// @brief store the shard ticks in a new cache entry. returns false if the
+  /// entry must not be cached
+  bool attachShardTicks(QueryCacheResultEntry& entry) const;
+
+  /// @brief whether a cached result is still valid
+  bool isCacheEntryValid(QueryCacheResultEntry const& entry) const;
+
   /// @brief enter a new state
   void enterState(QueryExecutionState::ValueType);
 
@@ -392,6 +438,10 @@ class Query {
   /// if we do not have a parser, because AstNodes occur in plans and engines
   std::unique_ptr<Ast> _ast;
 
+  /// @brief node metrics, must outlive the profile, which reads them when
+  /// it removes the query from the query list
+  QueryMetrics _metrics;
+
   /// @brief query execution profile
   std::unique_ptr<QueryProfile> _profile;
 
@@ -399,6 +449,9 @@ class Query {
   /// messages)
   QueryExecutionState::ValueType _state;
 
+  /// @brief span of the current state, if the query is traced
+  tracing::Span _stateSpan;
+
   /// @brief the ExecutionPlan object, if the query is prepared
   std::shared_ptr<ExecutionPlan> _plan;
 
@@ -423,6 +476,10 @@ class Query {
   /// @brief the query part
   QueryPart const _part;
 
+  /// @brief whether or not the query counts against the concurrent queries
+  /// of its database
+  bool _countedInQuota = false;
+
   /// @brief whether or not someone else has acquired a V8 context for us
   bool const _contextOwnedByExterior;
 
@@ -437,6 +494,10 @@ class Query {
   /// it needs to be run once before any V8-based function is called
   bool _preparedV8Context;
 
+  /// @brief _AQL functions resolved in the V8 context of the query, only
+  /// used when the context is owned by the query. released in exitContext
+  std::unordered_map<std::string, v8::Global<v8::Function>> _v8Functions;
+
   /// Create the result in this builder. It is also used to determine
   /// if we are continuing the query or of we called
   std::shared_ptr<arangodb::velocypack::Builder> _resultBuilder;
@@ -457,6 +518,13 @@ class Query {
   /// storing the cache entry in the query cache
   std::unique_ptr<QueryCacheResultEntry> _cacheEntry;
 
+  /// @brief invalidation ticks of the shards of the query, read before the
+  /// query is executed on a coordinator
+  std::unordered_map<std::string, uint64_t> _shardTicks;
+
+  /// @brief whether _shardTicks has the ticks of all shards of the query
+  bool _hasShardTicks = false;
+
   /// @brief hash for this query. will be calculated only once when needed
   mutable uint64_t _queryHash = DontCache;
 
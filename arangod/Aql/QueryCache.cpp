@@ -60,6 +60,40 @@ static std::atomic<bool> includeSystem(false);  // default value. can be changed
 /// @brief whether or not the query cache will return bind vars in its list of
 /// cached results
 static bool showBindVars = true;  // will be set once on startup. cannot be changed at runtime
+
+/// @brief the result builder of a query reserves memory up front. results
+/// that leave more than this unused are copied into a right-sized buffer
+/// before they are cached
+constexpr size_t maxUnusedResultCapacity = 4096;
+
+/// @brief approximate overhead of a node in an unordered_map
+constexpr size_t hashNodeOverhead = 2 * sizeof(void*);
+
+std::shared_ptr<VPackBuilder> compactResult(std::shared_ptr<VPackBuilder> const& result) {
+  if (result == nullptr || result->buffer() == nullptr) {
+    return result;
+  }
+  size_t const size = result->size();
+  size_t const capacity = result->buffer()->capacity();
+  if (capacity <= 2 * size || capacity - size <= ::maxUnusedResultCapacity) {
+    return result;
+  }
+  // the copy constructor of a builder allocates exactly the used size
+  return std::make_shared<VPackBuilder>(*result);
+}
+
+size_t builderMemoryUsage(std::shared_ptr<VPackBuilder> const& builder) {
+  if (builder == nullptr) {
+    return 0;
+  }
+  size_t size = sizeof(VPackBuilder);
+  if (builder->buffer() != nullptr) {
+    size += sizeof(VPackBuffer<uint8_t>) + builder->buffer()->capacity();
+  } else {
+    size += builder->size();
+  }
+  return size;
+}
 }  // namespace
 
 /// @brief create a cache entry
@@ -70,26 +104,76 @@ QueryCacheResultEntry::QueryCacheResultEntry(uint64_t hash, QueryString const& q
 )
     : _hash(hash),
       _queryString(queryString.data(), queryString.size()),
-      _queryResult(queryResult),
+      _queryResult(::compactResult(queryResult)),
       _bindVars(bindVars),
       _dataSources(std::move(dataSources)),
-      _size(_queryString.size()),
+      _size(0),
       _rows(0),
       _hits(0),
       _stamp(0.0),
       _prev(nullptr),
       _next(nullptr) {
-  // add result size
   try {
     if (_queryResult) {
-      _size += _queryResult->size();
       _rows = _queryResult->slice().length();
     }
-    if (_bindVars) {
-      _size += _bindVars->size();
-    }
   } catch (...) {
   }
+  _size = memoryUsage();
+}
+
+/// @brief whether the entry is the result of the given query string and
+/// bind parameters
+bool QueryCacheResultEntry::matches(QueryString const& queryString,
+                                    std::shared_ptr<VPackBuilder> const& bindVars) const {
+  if (queryString.size() != _queryString.size() ||
+      memcmp(queryString.data(), _queryString.data(), queryString.size()) != 0) {
+    // the result of a different query with the same hash
+    return false;
+  }
+
+  // compare bind variables
+  VPackSlice entryBindVars = VPackSlice::emptyObjectSlice();
+  if (_bindVars != nullptr) {
+    entryBindVars = _bindVars->slice();
+  }
+  VPackValueLength entryLength = entryBindVars.length();
+
+  VPackSlice lookupBindVars = VPackSlice::emptyObjectSlice();
+  if (bindVars != nullptr) {
+    lookupBindVars = bindVars->slice();
+  }
+  VPackValueLength lookupLength = lookupBindVars.length();
+
+  if (entryLength > 0 || lookupLength > 0) {
+    if (entryLength != lookupLength) {
+      // different number of bind variables
+      return false;
+    }
+
+    if (basics::VelocyPackHelper::compare(entryBindVars, lookupBindVars, false) != 0) {
+      // different bind variables
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/// @brief number of bytes allocated for the entry, including the unused
+/// capacity of its buffers
+size_t QueryCacheResultEntry::memoryUsage() const {
+  size_t size = sizeof(QueryCacheResultEntry) + _queryString.capacity();
+  size += ::builderMemoryUsage(_queryResult);
+  size += ::builderMemoryUsage(_bindVars);
+  size += ::builderMemoryUsage(_stats);
+  for (auto const& it : _dataSources) {
+    size += ::hashNodeOverhead + sizeof(it) + it.first.capacity() + it.second.capacity();
+  }
+  for (auto const& it : _shardTicks) {
+    size += ::hashNodeOverhead + sizeof(it) + it.first.capacity();
+  }
+  return size;
 }
 
 double QueryCacheResultEntry::executionTime() const {
@@ -160,14 +244,23 @@ void QueryCacheResultEntry::toVelocyPack(VPackBuilder& builder) const {
 }
 
 /// @brief create a database-specific cache
-QueryCacheDatabaseEntry::QueryCacheDatabaseEntry()
-    : _entriesByHash(), _head(nullptr), _tail(nullptr), _numResults(0), _sizeResults(0) {
+QueryCacheDatabaseEntry::QueryCacheDatabaseEntry(QueryCache& cache, TRI_vocbase_t const* vocbase)
+    : _cache(cache),
+      _vocbase(vocbase),
+      _entriesByHash(),
+      _head(nullptr),
+      _tail(nullptr),
+      _numResults(0),
+      _sizeResults(0) {
   _entriesByHash.reserve(128);
   _entriesByDataSourceGuid.reserve(16);
 }
 
 /// @brief destroy a database-specific cache
 QueryCacheDatabaseEntry::~QueryCacheDatabaseEntry() {
+  for (auto const& it : _entriesByHash) {
+    _cache.unpublish(_vocbase, it.second.get());
+  }
   _entriesByHash.clear();
   _entriesByDataSourceGuid.clear();
 }
@@ -182,59 +275,6 @@ void QueryCacheDatabaseEntry::queriesToVelocyPack(VPackBuilder& builder) const {
   }
 }
 
-/// @brief lookup a query result in the database-specific cache
-std::shared_ptr<QueryCacheResultEntry> QueryCacheDatabaseEntry::lookup(
-    uint64_t hash, QueryString const& queryString,
-    std::shared_ptr<VPackBuilder> const& bindVars) const {
-  auto it = _entriesByHash.find(hash);
-
-  if (it == _entriesByHash.end()) {
-    // not found in cache
-    return nullptr;
-  }
-
-  // found some result in cache
-  auto entry = (*it).second.get();
-
-  if (queryString.size() != entry->_queryString.size() ||
-      memcmp(queryString.data(), entry->_queryString.data(), queryString.size()) != 0) {
-    // found something, but obviously the result of a different query with the
-    // same hash
-    return nullptr;
-  }
-
-  // compare bind variables
-  VPackSlice entryBindVars = VPackSlice::emptyObjectSlice();
-  if (entry->_bindVars != nullptr) {
-    entryBindVars = entry->_bindVars->slice();
-  }
-  VPackValueLength entryLength = entryBindVars.length();
-
-  VPackSlice lookupBindVars = VPackSlice::emptyObjectSlice();
-  if (bindVars != nullptr) {
-    lookupBindVars = bindVars->slice();
-  }
-  VPackValueLength lookupLength = lookupBindVars.length();
-
-  if (entryLength > 0 || lookupLength > 0) {
-    if (entryLength != lookupLength) {
-      // different number of bind variables
-      return nullptr;
-    }
-
-    if (basics::VelocyPackHelper::compare(entryBindVars, lookupBindVars, false) != 0) {
-      // different bind variables
-      return nullptr;
-    }
-  }
-
-  // all equal -> hit!
-  entry->increaseHits();
-
-  // found an entry
-  return (*it).second;
-}
-
 /// @brief store a query result in the database-specific cache
 void QueryCacheDatabaseEntry::store(std::shared_ptr<QueryCacheResultEntry>&& entry,
                                     size_t allowedMaxResultsCount,
@@ -252,6 +292,7 @@ void QueryCacheDatabaseEntry::store(std::shared_ptr<QueryCacheResultEntry>&& ent
     auto& previous = result.first->second;
     removeDatasources(previous.get());
     unlink(previous.get());
+    _cache.unpublish(_vocbase, previous.get());
 
     // update with the new entry
     result.first->second = std::move(entry);
@@ -263,6 +304,8 @@ void QueryCacheDatabaseEntry::store(std::shared_ptr<QueryCacheResultEntry>&& ent
       ref.first = TRI_vocbase_t::IsSystemName(it.second);
       ref.second.emplace(hash);
     }
+
+    _cache.publish(_vocbase, result.first->second);
   } catch (...) {
     // rollback
 
@@ -314,6 +357,7 @@ void QueryCacheDatabaseEntry::invalidate(std::string const& dataSourceGuid) {
       // remove entry from the linked list
       auto entry = (*it3).second;
       unlink(entry.get());
+      _cache.unpublish(_vocbase, entry.get());
 
       // erase it from hash table
       _entriesByHash.erase(it3);
@@ -333,6 +377,7 @@ void QueryCacheDatabaseEntry::enforceMaxResults(size_t numResults, size_t sizeRe
     auto head = _head;
     removeDatasources(head);
     unlink(head);
+    _cache.unpublish(_vocbase, head);
     auto it = _entriesByHash.find(head->_hash);
     TRI_ASSERT(it != _entriesByHash.end());
     _entriesByHash.erase(it);
@@ -349,6 +394,7 @@ void QueryCacheDatabaseEntry::enforceMaxEntrySize(size_t value) {
     if (entry->_size > value) {
       removeDatasources(entry);
       unlink(entry);
+      _cache.unpublish(_vocbase, entry);
       it = _entriesByHash.erase(it);
     } else {
       // keep the entry
@@ -373,6 +419,7 @@ void QueryCacheDatabaseEntry::excludeSystem() {
         if (it2 != _entriesByHash.end()) {
           auto* entry = (*it2).second.get();
           unlink(entry);
+          _cache.unpublish(_vocbase, entry);
           _entriesByHash.erase(it2);
         }
       }
@@ -586,17 +633,28 @@ QueryCacheMode QueryCache::modeString(std::string const& mode) {
 std::shared_ptr<QueryCacheResultEntry> QueryCache::lookup(
     TRI_vocbase_t* vocbase, uint64_t hash, QueryString const& queryString,
     std::shared_ptr<VPackBuilder> const& bindVars) const {
-  auto const part = getPart(vocbase);
-  READ_LOCKER(readLocker, _entriesLock[part]);
+  std::shared_ptr<QueryCacheResultEntry> entry;
 
-  auto it = _entries[part].find(vocbase);
+  {
+    auto const& stripe = _stripes[getStripe(vocbase, hash)];
+    READ_LOCKER(readLocker, stripe.lock);
 
-  if (it == _entries[part].end()) {
-    // no entry found for the requested database
+    auto it = stripe.entries.find(StripeKey{vocbase, hash});
+
+    if (it == stripe.entries.end()) {
+      // not found in cache
+      return nullptr;
+    }
+    entry = (*it).second;
+  }
+
+  // the entry cannot change anymore, so it can be compared without the lock
+  if (!entry->matches(queryString, bindVars)) {
     return nullptr;
   }
 
-  return (*it).second->lookup(hash, queryString, bindVars);
+  entry->increaseHits();
+  return entry;
 }
 
 /// @brief store a query in the cache
@@ -604,6 +662,9 @@ void QueryCache::store(TRI_vocbase_t* vocbase, std::shared_ptr<QueryCacheResultE
   TRI_ASSERT(entry != nullptr);
   auto* e = entry.get();
 
+  // the statistics and shard ticks have been attached after construction
+  e->_size = e->memoryUsage();
+
   if (e->_size > ::maxEntrySize.load()) {
     // entry is too big
     return;
@@ -644,7 +705,7 @@ void QueryCache::store(TRI_vocbase_t* vocbase, std::shared_ptr<QueryCacheResultE
 
   if (it == _entries[part].end()) {
     // create entry for the current database
-    auto db = std::make_unique<QueryCacheDatabaseEntry>();
+    auto db = std::make_unique<QueryCacheDatabaseEntry>(*this, vocbase);
     it = _entries[part].emplace(vocbase, std::move(db)).first;
   }
 
@@ -780,6 +841,43 @@ unsigned int QueryCache::getPart(TRI_vocbase_t const* vocbase) const {
   return static_cast<int>(fasthash64_uint64(v, 0xf12345678abcdef) % numberOfParts);
 }
 
+/// @brief determine which stripe to use for looking up a query
+unsigned int QueryCache::getStripe(TRI_vocbase_t const* vocbase, uint64_t hash) const {
+  uint64_t v = uintptr_t(vocbase);
+  return static_cast<unsigned int>(fasthash64_uint64(hash, v) % numberOfStripes);
+}
+
+/// @brief make an entry visible to lookups
+/// must be called under the lock of the database's cache part
+void QueryCache::publish(TRI_vocbase_t const* vocbase,
+                         std::shared_ptr<QueryCacheResultEntry> const& entry) {
+  auto& stripe = _stripes[getStripe(vocbase, entry->_hash)];
+  WRITE_LOCKER(writeLocker, stripe.lock);
+
+  stripe.entries[StripeKey{vocbase, entry->_hash}] = entry;
+}
+
+/// @brief hide an entry from lookups, unless it has been replaced already
+void QueryCache::unpublish(TRI_vocbase_t const* vocbase,
+                           QueryCacheResultEntry const* entry) noexcept {
+  std::shared_ptr<QueryCacheResultEntry> removed;
+
+  {
+    auto& stripe = _stripes[getStripe(vocbase, entry->_hash)];
+    WRITE_LOCKER(writeLocker, stripe.lock);
+
+    auto it = stripe.entries.find(StripeKey{vocbase, entry->_hash});
+
+    if (it == stripe.entries.end() || (*it).second.get() != entry) {
+      return;
+    }
+    removed = std::move((*it).second);
+    stripe.entries.erase(it);
+  }
+
+  // the entry may be freed here, which must not happen under the spin lock
+}
+
 /// @brief invalidate all entries in the cache part
 /// note that the caller of this method must hold the write lock
 void QueryCache::invalidate(unsigned int part) { _entries[part].clear(); }
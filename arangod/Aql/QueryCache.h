@@ -28,6 +28,7 @@
 #include "Basics/Common.h"
 #include "Basics/Mutex.h"
 #include "Basics/ReadWriteLock.h"
+#include "Basics/ReadWriteSpinLock.h"
 
 #include <unordered_set>
 #include <memory>
@@ -46,6 +47,7 @@ class Builder;
 class Slice;
 }  // namespace velocypack
 namespace aql {
+class QueryCache;
 
 /// @brief cache mode
 enum QueryCacheMode { CACHE_ALWAYS_OFF, CACHE_ALWAYS_ON, CACHE_ON_DEMAND };
@@ -76,6 +78,9 @@ struct QueryCacheResultEntry {
   std::shared_ptr<arangodb::velocypack::Builder> const _bindVars;
   // stores datasource guid -> datasource name
   std::unordered_map<std::string, std::string> const _dataSources;
+  // stores shard name -> invalidation tick when the result was computed.
+  // only used on coordinators
+  std::unordered_map<std::string, uint64_t> _shardTicks;
   std::shared_ptr<arangodb::velocypack::Builder> _stats;
   size_t _size;
   size_t _rows;
@@ -87,6 +92,15 @@ struct QueryCacheResultEntry {
   void increaseHits() { _hits.fetch_add(1, std::memory_order_relaxed); }
   double executionTime() const;
 
+  /// @brief whether the entry is the result of the given query string and
+  /// bind parameters
+  bool matches(QueryString const& queryString,
+               std::shared_ptr<arangodb::velocypack::Builder> const& bindVars) const;
+
+  /// @brief number of bytes allocated for the entry, including the unused
+  /// capacity of its buffers
+  size_t memoryUsage() const;
+
   void toVelocyPack(arangodb::velocypack::Builder& builder) const;
 };
 
@@ -95,16 +109,11 @@ struct QueryCacheDatabaseEntry {
   QueryCacheDatabaseEntry& operator=(QueryCacheDatabaseEntry const&) = delete;
 
   /// @brief create a database-specific cache
-  QueryCacheDatabaseEntry();
+  QueryCacheDatabaseEntry(QueryCache& cache, TRI_vocbase_t const* vocbase);
 
   /// @brief destroy a database-specific cache
   ~QueryCacheDatabaseEntry();
 
-  /// @brief lookup a query result in the database-specific cache
-  std::shared_ptr<QueryCacheResultEntry> lookup(
-      uint64_t hash, QueryString const& queryString,
-      std::shared_ptr<arangodb::velocypack::Builder> const& bindVars) const;
-
   /// @brief store a query result in the database-specific cache
   void store(std::shared_ptr<QueryCacheResultEntry>&& entry,
              size_t allowedMaxResultsCount, size_t allowedMaxResultsSize);
@@ -140,6 +149,12 @@ struct QueryCacheDatabaseEntry {
   /// @brief link the result entry to the end of the list
   void link(QueryCacheResultEntry*);
 
+  /// @brief the cache that looks up the entries
+  QueryCache& _cache;
+
+  /// @brief the database of the entries
+  TRI_vocbase_t const* _vocbase;
+
   /// @brief hash table that maps query hashes to query results
   std::unordered_map<uint64_t, std::shared_ptr<QueryCacheResultEntry>> _entriesByHash;
 
@@ -161,7 +176,13 @@ struct QueryCacheDatabaseEntry {
   size_t _sizeResults;
 };
 
+/// @brief the query cache. lookups only take the lock of the stripe their
+/// query hash belongs to. storing and invalidating results is done under
+/// the lock of the database's cache part, which also publishes the entries
+/// to and removes them from the stripes
 class QueryCache {
+  friend struct QueryCacheDatabaseEntry;
+
  public:
   QueryCache(QueryCache const&) = delete;
   QueryCache& operator=(QueryCache const&) = delete;
@@ -256,10 +277,47 @@ class QueryCache {
   /// @brief determine which part of the cache to use for the cache entries
   unsigned int getPart(TRI_vocbase_t const*) const;
 
+  /// @brief determine which stripe to use for looking up a query
+  unsigned int getStripe(TRI_vocbase_t const*, uint64_t hash) const;
+
+  /// @brief make an entry visible to lookups
+  /// must be called under the lock of the database's cache part
+  void publish(TRI_vocbase_t const* vocbase,
+               std::shared_ptr<QueryCacheResultEntry> const& entry);
+
+  /// @brief hide an entry from lookups, unless it has been replaced already
+  /// must be called under the lock of the database's cache part, or for an
+  /// entry that is not part of the cache anymore
+  void unpublish(TRI_vocbase_t const* vocbase, QueryCacheResultEntry const* entry) noexcept;
+
  private:
   /// @brief number of R/W locks for the query cache
   static constexpr uint64_t numberOfParts = 16;
 
+  /// @brief number of lookup stripes
+  static constexpr uint64_t numberOfStripes = 64;
+
+  struct StripeKey {
+    TRI_vocbase_t const* vocbase;
+    uint64_t hash;
+
+    bool operator==(StripeKey const& other) const noexcept {
+      return vocbase == other.vocbase && hash == other.hash;
+    }
+  };
+
+  struct StripeKeyHash {
+    size_t operator()(StripeKey const& key) const noexcept {
+      // the query hash is well distributed already
+      return static_cast<size_t>(key.hash ^ uintptr_t(key.vocbase));
+    }
+  };
+
+  struct Stripe {
+    mutable arangodb::basics::ReadWriteSpinLock lock;
+    std::unordered_map<StripeKey, std::shared_ptr<QueryCacheResultEntry>, StripeKeyHash> entries;
+  };
+
   /// @brief protect mode changes with a mutex
   mutable arangodb::Mutex _propertiesLock;
 
@@ -268,6 +326,9 @@ class QueryCache {
 
   /// @brief cached query entries, organized per database
   std::unordered_map<TRI_vocbase_t*, std::unique_ptr<QueryCacheDatabaseEntry>> _entries[numberOfParts];
+
+  /// @brief the entries of all databases, by query hash
+  Stripe _stripes[numberOfStripes];
 };
 }  // namespace aql
 }  // namespace arangodb
@@ -28,6 +28,11 @@
 #include "Aql/ExecutionEngine.h"
 #include "Aql/Query.h"
 #include "Aql/QueryRegistry.h"
+#include "ApplicationFeatures/PageSizeFeature.h"
+#include "Basics/FileUtils.h"
+#include "Basics/Thread.h"
+#include "Basics/files.h"
+#include "Basics/memory-map.h"
 #include "Logger/Logger.h"
 #include "RestServer/QueryRegistryFeature.h"
 #include "StorageEngine/TransactionState.h"
@@ -41,18 +46,144 @@
 #include <velocypack/Options.h>
 #include <velocypack/velocypack-aliases.h>
 
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
 using namespace arangodb;
 using namespace arangodb::aql;
 
+namespace arangodb {
+namespace aql {
+
+/// @brief a query result in a memory-mapped temporary file. the mapping is
+/// backed by the file, so the kernel can drop its pages under memory
+/// pressure and read them back when the client fetches the next batch
+class QueryResultSpillFile {
+ public:
+  QueryResultSpillFile(CursorId id, VPackSlice data);
+  ~QueryResultSpillFile();
+
+  QueryResultSpillFile(QueryResultSpillFile const&) = delete;
+  QueryResultSpillFile& operator=(QueryResultSpillFile const&) = delete;
+
+  VPackSlice slice() const { return VPackSlice(_data); }
+
+  /// @brief allow the kernel to drop the pages before the given position.
+  /// they are not needed anymore, as cursors only move forward
+  void consumed(uint8_t const* position);
+
+ private:
+  void close();
+
+  std::string _filename;
+  int _fd;
+  void* _mmHandle;
+  uint8_t* _data;
+  size_t _size;
+  /// @brief number of bytes at the start that have been dropped already
+  size_t _released;
+};
+
+}  // namespace aql
+}  // namespace arangodb
+
+QueryResultSpillFile::QueryResultSpillFile(CursorId id, VPackSlice data)
+    : _fd(-1), _mmHandle(nullptr), _data(nullptr), _size(data.byteSize()), _released(0) {
+  std::string file = "cursor-" + std::to_string(uint64_t(Thread::currentProcessId())) +
+                     "-" + std::to_string(id) + ".mmap";
+  _filename = basics::FileUtils::buildFilename(TRI_GetTempPath(), file);
+
+  _fd = TRI_CREATE(_filename.c_str(), O_CREAT | O_EXCL | O_RDWR | TRI_O_CLOEXEC,
+                   S_IRUSR | S_IWUSR);
+  if (_fd < 0) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_SYS_ERROR,
+                                   std::string("cannot create cursor spill file '") +
+                                       _filename + "': " + TRI_last_error());
+  }
+
+  if (!TRI_WritePointer(_fd, data.start(), _size)) {
+    std::string message = std::string("cannot write cursor spill file '") +
+                          _filename + "': " + TRI_last_error();
+    close();
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_SYS_ERROR, message);
+  }
+
+  void* result;
+  int res = TRI_MMFile(nullptr, _size, PROT_READ, MAP_SHARED, _fd, &_mmHandle, 0, &result);
+  if (res != TRI_ERROR_NO_ERROR) {
+    close();
+    THROW_ARANGO_EXCEPTION_MESSAGE(res, std::string("cannot memory map cursor spill file '") +
+                                            _filename + "'");
+  }
+  _data = static_cast<uint8_t*>(result);
+
+  TRI_MMFileAdvise(_data, _size, TRI_MADVISE_SEQUENTIAL);
+}
+
+QueryResultSpillFile::~QueryResultSpillFile() { close(); }
+
+void QueryResultSpillFile::consumed(uint8_t const* position) {
+  TRI_ASSERT(position >= _data && position <= _data + _size);
+  size_t const pageSize = PageSizeFeature::getPageSize();
+  // the mapping starts at a page boundary
+  size_t const end = ((position - _data) / pageSize) * pageSize;
+  if (end > _released) {
+    TRI_MMFileAdvise(_data + _released, end - _released, TRI_MADVISE_DONTNEED);
+    _released = end;
+  }
+}
+
+void QueryResultSpillFile::close() {
+  if (_data != nullptr) {
+    int res = TRI_UNMMFile(_data, _size, _fd, &_mmHandle);
+    if (res != TRI_ERROR_NO_ERROR) {
+      LOG_TOPIC("4b7c2", ERR, Logger::QUERIES)
+          << "unable to unmap cursor spill file '" << _filename << "': " << res;
+    }
+    _data = nullptr;
+  }
+  if (_fd >= 0) {
+    TRI_CLOSE(_fd);
+    _fd = -1;
+    TRI_UnlinkFile(_filename.c_str());
+  }
+}
+
 QueryResultCursor::QueryResultCursor(TRI_vocbase_t& vocbase,
-                                     aql::QueryResult&& result,
-                                     size_t batchSize, double ttl, bool hasCount)
+                                     aql::QueryResult&& result, size_t batchSize,
+                                     double ttl, bool hasCount, uint64_t spillThreshold)
     : Cursor(TRI_NewServerSpecificTick(), batchSize, ttl, hasCount),
       _guard(vocbase),
       _result(std::move(result)),
       _iterator(_result.data->slice()),
       _cached(_result.cached) {
   TRI_ASSERT(_result.data->slice().isArray());
+
+  if (spillThreshold > 0) {
+    spill(spillThreshold);
+  }
+}
+
+QueryResultCursor::~QueryResultCursor() = default;
+
+void QueryResultCursor::spill(uint64_t threshold) {
+  // a result that is shared, e.g. with the query cache, would stay in memory
+  // anyway
+  if (_cached || _result.data.use_count() != 1 || _result.data->size() <= threshold) {
+    return;
+  }
+
+  try {
+    _spillFile = std::make_unique<QueryResultSpillFile>(id(), _result.data->slice());
+  } catch (std::exception const& ex) {
+    LOG_TOPIC("7c1e4", WARN, Logger::QUERIES)
+        << "keeping result of cursor " << id() << " in memory: " << ex.what();
+    return;
+  }
+
+  _iterator = VPackArrayIterator(_spillFile->slice());
+  _result.data.reset();
 }
 
 VPackSlice QueryResultCursor::extra() const {
@@ -74,7 +205,7 @@ bool QueryResultCursor::hasNext() {
 
 /// @brief return the next element
 VPackSlice QueryResultCursor::next() {
-  TRI_ASSERT(_result.data != nullptr);
+  TRI_ASSERT(_result.data != nullptr || _spillFile != nullptr);
   TRI_ASSERT(_iterator.valid());
   VPackSlice slice = _iterator.value();
   _iterator.next();
@@ -112,6 +243,10 @@ Result QueryResultCursor::dumpSync(VPackBuilder& builder) {
     }
     builder.close();
 
+    if (_spillFile != nullptr && _iterator.valid()) {
+      _spillFile->consumed(_iterator.value().start());
+    }
+
     builder.add("hasMore", VPackValue(hasNext()));
 
     if (hasNext()) {
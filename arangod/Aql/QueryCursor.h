@@ -40,16 +40,20 @@ namespace aql {
 class AqlItemBlock;
 enum class ExecutionState;
 class Query;
+class QueryResultSpillFile;
 class SharedAqlItemBlockPtr;
 
 /// Cursor managing an entire query result in-memory
 /// Should be used in conjunction with the RestCursorHandler
 class QueryResultCursor final : public arangodb::Cursor {
  public:
+  /// @brief results bigger than spillThreshold bytes are moved into a
+  /// memory-mapped temporary file. 0 keeps all results in memory
   QueryResultCursor(TRI_vocbase_t& vocbase, aql::QueryResult&& result,
-                    size_t batchSize, double ttl, bool hasCount);
+                    size_t batchSize, double ttl, bool hasCount,
+                    uint64_t spillThreshold = 0);
 
-  ~QueryResultCursor() = default;
+  ~QueryResultCursor();
 
   aql::QueryResult const* result() const { return &_result; }
 
@@ -75,9 +79,16 @@ class QueryResultCursor final : public arangodb::Cursor {
   /// If no extras are set this will return a NONE slice.
   arangodb::velocypack::Slice extra() const;
 
+ private:
+  /// @brief moves the result data into a spill file if it is big enough and
+  /// not shared with anyone else, e.g. the query cache
+  void spill(uint64_t threshold);
+
  private:
   DatabaseGuard _guard;
   aql::QueryResult _result;
+  /// @brief the result data if it has been spilled. _result.data is empty then
+  std::unique_ptr<QueryResultSpillFile> _spillFile;
   arangodb::velocypack::ArrayIterator _iterator;
   bool _cached;
 };
@@ -42,14 +42,18 @@ using namespace arangodb::aql;
 QueryEntryCopy::QueryEntryCopy(TRI_voc_tick_t id, std::string&& queryString,
                                std::shared_ptr<arangodb::velocypack::Builder> const& bindParameters,
                                double started, double runTime,
-                               QueryExecutionState::ValueType state, bool stream)
+                               QueryExecutionState::ValueType state, bool stream,
+                               std::shared_ptr<arangodb::velocypack::Builder> const& metrics,
+                               size_t memoryUsage)
     : id(id),
       queryString(std::move(queryString)),
       bindParameters(bindParameters),
       started(started),
       runTime(runTime),
       state(state),
-      stream(stream) {}
+      stream(stream),
+      metrics(metrics),
+      memoryUsage(memoryUsage) {}
 
 /// @brief create a query list
 QueryList::QueryList(TRI_vocbase_t*)
@@ -164,21 +168,33 @@ void QueryList::remove(Query* query) {
         }
       }
 
+      std::string nodes;
+      std::shared_ptr<VPackBuilder> metrics;
+      QueryMetrics const& queryMetrics = query->metrics();
+      if (!queryMetrics.empty()) {
+        nodes.append(", slowest nodes: ");
+        nodes.append(queryMetrics.summary(3));
+        metrics = std::make_shared<VPackBuilder>();
+        queryMetrics.toVelocyPack(*metrics);
+      }
+
       if (loadTime >= 0.1) {
         LOG_TOPIC("d728e", WARN, Logger::QUERIES)
             << "slow " << (isStreaming ? "streaming " : "") << "query: '" << q
             << "'" << bindParameters << ", took: " << Logger::FIXED(now - started)
-            << " s, loading took: " << Logger::FIXED(loadTime) << " s";
+            << " s, loading took: " << Logger::FIXED(loadTime) << " s" << nodes;
       } else {
         LOG_TOPIC("8bcee", WARN, Logger::QUERIES)
             << "slow " << (isStreaming ? "streaming " : "") << "query: '" << q << "'"
-            << bindParameters << ", took: " << Logger::FIXED(now - started) << " s";
+            << bindParameters << ", took: " << Logger::FIXED(now - started)
+            << " s" << nodes;
       }
 
       _slow.emplace_back(query->id(), std::move(q),
                          _trackBindVars ? query->bindParameters() : nullptr,
                          started, now - started,
-                         QueryExecutionState::ValueType::FINISHED, isStreaming);
+                         QueryExecutionState::ValueType::FINISHED, isStreaming,
+                         metrics);
 
       if (++_slowCount > _maxSlowQueries) {
         // free first element
@@ -259,7 +275,8 @@ std::vector<QueryEntryCopy> QueryList::listCurrent() {
 
       result.emplace_back(query->id(), extractQueryString(query, maxLength),
                           _trackBindVars ? query->bindParameters() : nullptr, started,
-                          now - started, query->state(), query->queryOptions().stream);
+                          now - started, query->state(), query->queryOptions().stream,
+                          nullptr, query->reservedMemory());
     }
   }
 
@@ -46,7 +46,9 @@ struct QueryEntryCopy {
   QueryEntryCopy(TRI_voc_tick_t id, std::string&& queryString,
                  std::shared_ptr<arangodb::velocypack::Builder> const& bindParameters,
                  double started, double runTime,
-                 QueryExecutionState::ValueType state, bool stream);
+                 QueryExecutionState::ValueType state, bool stream,
+                 std::shared_ptr<arangodb::velocypack::Builder> const& metrics = nullptr,
+                 size_t memoryUsage = 0);
 
   TRI_voc_tick_t const id;
   std::string const queryString;
@@ -55,6 +57,11 @@ struct QueryEntryCopy {
   double const runTime;
   QueryExecutionState::ValueType const state;
   bool stream;
+  /// @brief the node metrics of slow queries, see QueryMetrics
+  std::shared_ptr<arangodb::velocypack::Builder> const metrics;
+  /// @brief memory reserved by a running query, in whole chunks of the
+  /// global query memory budget
+  size_t const memoryUsage;
 };
 
 class QueryList {
@@ -0,0 +1,106 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "QueryMetrics.h"
+
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+NodeMetrics& NodeMetrics::operator+=(NodeMetrics const& other) {
+  calls += other.calls;
+  sampledCalls += other.sampledCalls;
+  rows += other.rows;
+  wallTime += other.wallTime;
+  sampledCpuTime += other.sampledCpuTime;
+  waitTime += other.waitTime;
+  peakMemoryUsage = (std::max)(peakMemoryUsage, other.peakMemoryUsage);
+  bytesFetched += other.bytesFetched;
+  return *this;
+}
+
+void NodeMetrics::toVelocyPack(VPackBuilder& builder) const {
+  builder.openObject();
+  builder.add("id", VPackValue(id));
+  builder.add("type", VPackValue(type));
+  builder.add("calls", VPackValue(calls));
+  builder.add("items", VPackValue(rows));
+  builder.add("wallTime", VPackValue(wallTime));
+  builder.add("cpuTime", VPackValue(cpuTime()));
+  builder.add("waitTime", VPackValue(waitTime));
+  builder.add("peakMemoryUsage", VPackValue(peakMemoryUsage));
+  builder.add("bytesFetched", VPackValue(bytesFetched));
+  builder.close();
+}
+
+void QueryMetrics::add(NodeMetrics const& metrics) {
+  for (auto& it : nodes) {
+    if (it.id == metrics.id) {
+      it += metrics;
+      return;
+    }
+  }
+  nodes.push_back(metrics);
+}
+
+void QueryMetrics::toVelocyPack(VPackBuilder& builder) const {
+  builder.openArray();
+  for (auto const& it : nodes) {
+    it.toVelocyPack(builder);
+  }
+  builder.close();
+}
+
+std::string QueryMetrics::summary(size_t maxNodes) const {
+  std::vector<NodeMetrics const*> sorted;
+  sorted.reserve(nodes.size());
+  for (auto const& it : nodes) {
+    sorted.push_back(&it);
+  }
+  std::sort(sorted.begin(), sorted.end(), [](NodeMetrics const* lhs, NodeMetrics const* rhs) {
+    return lhs->wallTime + lhs->waitTime > rhs->wallTime + rhs->waitTime;
+  });
+  if (sorted.size() > maxNodes) {
+    sorted.resize(maxNodes);
+  }
+
+  std::ostringstream out;
+  out << std::fixed << std::setprecision(6);
+  for (auto const* it : sorted) {
+    if (out.tellp() > 0) {
+      out << ", ";
+    }
+    out << it->type << " #" << it->id << " (wall: " << it->wallTime
+        << " s, cpu: " << it->cpuTime() << " s, wait: " << it->waitTime
+        << " s, items: " << it->rows << ", peak memory: " << it->peakMemoryUsage;
+    if (it->bytesFetched > 0) {
+      out << ", fetched: " << it->bytesFetched;
+    }
+    out << ")";
+  }
+  return out.str();
+}
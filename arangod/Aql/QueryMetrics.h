@@ -0,0 +1,85 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_AQL_QUERY_METRICS_H
+#define ARANGOD_AQL_QUERY_METRICS_H 1
+
+#include "Basics/Common.h"
+
+namespace arangodb {
+
+namespace velocypack {
+class Builder;
+}
+
+namespace aql {
+
+/// @brief always-on metrics of one ExecutionNode, gathered by its block in
+/// getSome() and skipSome(). wall and CPU time are exclusive, i.e. without
+/// the time spent in the dependencies. the CPU time is only measured for a
+/// sample of the calls and extrapolated. the wait time is the time between
+/// returning WAITING and being called again, and includes the waiting of all
+/// dependencies
+struct NodeMetrics {
+  size_t id = 0;
+  std::string type;
+  uint64_t calls = 0;
+  uint64_t sampledCalls = 0;
+  uint64_t rows = 0;
+  double wallTime = 0.0;
+  double sampledCpuTime = 0.0;
+  double waitTime = 0.0;
+  // largest amount of memory a single call allocated and still held when
+  // it returned, including the memory of the dependencies
+  size_t peakMemoryUsage = 0;
+  // bytes received from other servers
+  uint64_t bytesFetched = 0;
+
+  double cpuTime() const {
+    return sampledCalls == 0 ? 0.0 : sampledCpuTime * calls / sampledCalls;
+  }
+
+  NodeMetrics& operator+=(NodeMetrics const& other);
+
+  void toVelocyPack(arangodb::velocypack::Builder&) const;
+};
+
+/// @brief the metrics of all nodes of a query, taken when its execution
+/// engine is destroyed
+struct QueryMetrics {
+  std::vector<NodeMetrics> nodes;
+
+  bool empty() const { return nodes.empty(); }
+
+  /// @brief adds the metrics of a block, merging blocks of the same node
+  void add(NodeMetrics const& metrics);
+
+  /// @brief the nodes as an array
+  void toVelocyPack(arangodb::velocypack::Builder&) const;
+
+  /// @brief describes the nodes that took the most wall-clock time, for
+  /// the slow query log
+  std::string summary(size_t maxNodes) const;
+};
+
+}  // namespace aql
+}  // namespace arangodb
+
+#endif
@@ -37,6 +37,7 @@ using namespace arangodb::aql;
 QueryOptions::QueryOptions()
     : memoryLimit(0),
       maxNumberOfPlans(0),
+      maxOptimizerRuntime(0.0),
       maxWarningCount(10),
       literalSizeThreshold(-1),
       satelliteSyncWait(60.0),
@@ -51,7 +52,8 @@ QueryOptions::QueryOptions()
       fullCount(false),
       count(false),
       verboseErrors(false),
-      inspectSimplePlans(true) {
+      inspectSimplePlans(true),
+      optimizerFastPath(true) {
   // now set some default values from server configuration options
   QueryRegistryFeature* q =
       application_features::ApplicationServer::getFeature<QueryRegistryFeature>(
@@ -76,6 +78,8 @@ QueryOptions::QueryOptions()
 
   maxNumberOfPlans = q->maxQueryPlans();
   TRI_ASSERT(maxNumberOfPlans > 0);
+
+  maxOptimizerRuntime = q->maxOptimizerRuntime();
 }
 
 void QueryOptions::fromVelocyPack(VPackSlice const& slice) {
@@ -177,6 +181,14 @@ void QueryOptions::fromVelocyPack(VPackSlice const& slice) {
     if (value.isBool()) {
       inspectSimplePlans = value.getBool();
     }
+    value = optimizer.get("fastPath");
+    if (value.isBool()) {
+      optimizerFastPath = value.getBool();
+    }
+    value = optimizer.get("maxRuntime");
+    if (value.isNumber()) {
+      maxOptimizerRuntime = value.getNumber<double>();
+    }
     value = optimizer.get("rules");
     if (value.isArray()) {
       for (auto const& rule : VPackArrayIterator(value)) {
@@ -238,6 +250,8 @@ void QueryOptions::toVelocyPack(VPackBuilder& builder, bool disableOptimizerRule
 
   builder.add("optimizer", VPackValue(VPackValueType::Object));
   builder.add("inspectSimplePlans", VPackValue(inspectSimplePlans));
+  builder.add("fastPath", VPackValue(optimizerFastPath));
+  builder.add("maxRuntime", VPackValue(maxOptimizerRuntime));
   if (!optimizerRules.empty() || disableOptimizerRules) {
     builder.add("rules", VPackValue(VPackValueType::Array));
     if (disableOptimizerRules) {
@@ -60,6 +60,9 @@ struct QueryOptions {
 
   size_t memoryLimit;
   size_t maxNumberOfPlans;
+  /// @brief time (in seconds) after which the optimizer only runs the rules
+  /// that do not create additional plans. 0 means no limit
+  double maxOptimizerRuntime;
   size_t maxWarningCount;
   int64_t literalSizeThreshold;
   double satelliteSyncWait;
@@ -76,6 +79,8 @@ struct QueryOptions {
   bool count;
   bool verboseErrors;
   bool inspectSimplePlans;
+  /// @brief apply only a minimal set of rules to simple plans
+  bool optimizerFastPath;
   std::vector<std::string> optimizerRules;
   std::unordered_set<std::string> shardIds;
 #ifdef USE_ENTERPRISE
@@ -34,6 +34,14 @@ using namespace arangodb::aql;
 namespace {
 /// @brief empty string singleton
 static char const* EmptyString = "";
+
+/// @brief number of nodes per memory block of the node arena
+constexpr size_t nodesPerBlock = 128;
+
+/// @brief approximate memory usage of an entry in the hash set of strings
+/// registered via registerVPackString
+constexpr size_t vpackStringEntrySize =
+    sizeof(arangodb::velocypack::StringRef) + 2 * sizeof(void*);
 }  // namespace
 
 QueryResources::QueryResources(ResourceMonitor* resourceMonitor)
@@ -41,7 +49,9 @@ QueryResources::QueryResources(ResourceMonitor* resourceMonitor)
 #ifdef ARANGODB_ENABLE_MAINTAINER_MODE
       _stringsLength(0),
 #endif
-      _shortStringStorage(_resourceMonitor, 1024) {
+      _nodesInLastBlock(nodesPerBlock),
+      _shortStringStorage(_resourceMonitor, 1024),
+      _vpackStringsLength(0) {
 }
 
 QueryResources::~QueryResources() {
@@ -55,6 +65,16 @@ QueryResources::~QueryResources() {
     delete it;
   }
 
+  // destroy nodes in the node arena, and free its blocks
+  for (size_t i = 0; i < _nodeBlocks.size(); ++i) {
+    AstNode* nodes = static_cast<AstNode*>(_nodeBlocks[i]);
+    size_t const n = (i + 1 == _nodeBlocks.size()) ? _nodesInLastBlock : nodesPerBlock;
+    for (size_t j = 0; j < n; ++j) {
+      nodes[j].~AstNode();
+    }
+    ::operator delete(_nodeBlocks[i]);
+  }
+
 #ifdef ARANGODB_ENABLE_MAINTAINER_MODE
   // we are in the destructor here already. decreasing the memory usage counters
   // will only provide a benefit (in terms of assertions) if we are in
@@ -62,6 +82,8 @@ QueryResources::~QueryResources() {
   _resourceMonitor->decreaseMemoryUsage(_strings.capacity() * sizeof(char*) + _stringsLength);
   _resourceMonitor->decreaseMemoryUsage(_nodes.size() * sizeof(AstNode) +
                                         _nodes.capacity() * sizeof(AstNode*));
+  _resourceMonitor->decreaseMemoryUsage(_vpackStrings.size() * vpackStringEntrySize);
+  _resourceMonitor->decreaseMemoryUsage(_nodeBlocks.size() * nodesPerBlock * sizeof(AstNode));
 #endif
 }
 
@@ -110,6 +132,34 @@ void QueryResources::addNode(AstNode* node) {
   guard.cancel();
 }
 
+/// @brief create a node in the node arena
+AstNode* QueryResources::createNode(AstNodeType type) {
+  if (_nodesInLastBlock == nodesPerBlock) {
+    // current block is full, need a new one
+    if (_nodeBlocks.size() == _nodeBlocks.capacity()) {
+      _nodeBlocks.reserve(std::max<size_t>(8, _nodeBlocks.capacity() * 2));
+    }
+
+    size_t const blockSize = nodesPerBlock * sizeof(AstNode);
+    _resourceMonitor->increaseMemoryUsage(blockSize);
+    void* block;
+    try {
+      block = ::operator new(blockSize);
+    } catch (...) {
+      // revert change in memory increase
+      _resourceMonitor->decreaseMemoryUsage(blockSize);
+      throw;
+    }
+    // will not fail, as we have reserved enough space
+    _nodeBlocks.push_back(block);
+    _nodesInLastBlock = 0;
+  }
+
+  AstNode* node = new (static_cast<AstNode*>(_nodeBlocks.back()) + _nodesInLastBlock) AstNode(type);
+  ++_nodesInLastBlock;
+  return node;
+}
+
 /// @brief register a string
 /// the string is freed when the query is destroyed
 char* QueryResources::registerString(char const* p, size_t length) {
@@ -151,6 +201,34 @@ char* QueryResources::registerEscapedString(char const* p, size_t length, size_t
   return registerLongString(copy, outLength);
 }
 
+/// @brief register a short string in VelocyPack format
+uint8_t const* QueryResources::registerVPackString(char const* p, size_t length) {
+  if (length >= ShortStringStorage::maxStringLength ||
+      _vpackStringsLength + length > maxVPackStringsLength) {
+    return nullptr;
+  }
+
+  auto it = _vpackStrings.find(arangodb::velocypack::StringRef(p, length));
+  if (it != _vpackStrings.end()) {
+    // already registered
+    return reinterpret_cast<uint8_t const*>((*it).data()) - 1;
+  }
+
+  uint8_t const* position = _shortStringStorage.registerVPackString(p, length);
+
+  // approximate memory usage of the hash set entry
+  _resourceMonitor->increaseMemoryUsage(vpackStringEntrySize);
+  try {
+    _vpackStrings.emplace(reinterpret_cast<char const*>(position) + 1, length);
+  } catch (...) {
+    _resourceMonitor->decreaseMemoryUsage(vpackStringEntrySize);
+    throw;
+  }
+  _vpackStringsLength += length;
+
+  return position;
+}
+
 /// @brief registers a long string and takes over the ownership for it
 char* QueryResources::registerLongString(char* copy, size_t length) {
   if (copy == nullptr) {
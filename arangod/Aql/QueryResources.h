@@ -27,11 +27,16 @@
 #include "Aql/ShortStringStorage.h"
 #include "Basics/Common.h"
 
+#include <velocypack/StringRef.h>
+
+#include <unordered_set>
+
 namespace arangodb {
 namespace aql {
 
 struct AstNode;
 struct ResourceMonitor;
+enum AstNodeType : uint32_t;
 
 class QueryResources {
  public:
@@ -45,6 +50,11 @@ class QueryResources {
   /// @brief add a node to the list of nodes
   void addNode(AstNode*);
 
+  /// @brief create a node in the node arena. the arena allocates memory for
+  /// many nodes at once, and all nodes in it are destroyed together when the
+  /// query is destroyed
+  AstNode* createNode(AstNodeType);
+
   /// @brief register a string
   /// the string is freed when the query is destroyed
   char* registerString(char const* p, size_t length);
@@ -59,6 +69,16 @@ class QueryResources {
   /// the string is freed when the query is destroyed
   char* registerEscapedString(char const* p, size_t length, size_t& outLength);
 
+  /// @brief register a short string in VelocyPack format. strings with the
+  /// same contents are stored only once. returns a nullptr if the string is
+  /// too long or if the query has already registered too many such strings.
+  /// the string is freed when the query is destroyed
+  uint8_t const* registerVPackString(char const* p, size_t length);
+
+  /// @brief maximum cumulated length of strings registered via
+  /// registerVPackString
+  static constexpr size_t maxVPackStringsLength = 4 * 1024 * 1024;
+
  private:
   /// @brief registers a long string and takes over the ownership for it
   char* registerLongString(char* copy, size_t length);
@@ -69,6 +89,13 @@ class QueryResources {
   /// @brief all nodes created in the AST - will be used for freeing them later
   std::vector<AstNode*> _nodes;
 
+  /// @brief memory blocks of the node arena, with room for nodesPerBlock
+  /// nodes each
+  std::vector<void*> _nodeBlocks;
+
+  /// @brief number of nodes in the last block of the node arena
+  size_t _nodesInLastBlock;
+
   /// @brief strings created in the query - used for easy memory deallocation
   std::vector<char*> _strings;
 
@@ -80,6 +107,13 @@ class QueryResources {
   /// @brief short string storage. uses less memory allocations for short
   /// strings
   ShortStringStorage _shortStringStorage;
+
+  /// @brief strings registered via registerVPackString, pointing to their
+  /// contents in _shortStringStorage (after the VelocyPack header byte)
+  std::unordered_set<arangodb::velocypack::StringRef> _vpackStrings;
+
+  /// @brief cumulated length of strings in _vpackStrings
+  size_t _vpackStringsLength;
 };
 
 }  // namespace aql
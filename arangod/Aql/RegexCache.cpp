@@ -34,6 +34,30 @@
 using namespace arangodb::aql;
 
 
+namespace {
+
+/// @brief whether the UTF-8 string contains one of U+0085, U+2028 or
+/// U+2029. the wildcard "(.|[\r\n])" of a LIKE regex does not match these
+bool containsLineSeparator(char const* p, size_t length) {
+  unsigned char const* s = reinterpret_cast<unsigned char const*>(p);
+  unsigned char const* e = s + length;
+  while (s < e) {
+    if (*s == 0xc2) {
+      if (e - s >= 2 && s[1] == 0x85) {
+        return true;
+      }
+    } else if (*s == 0xe2) {
+      if (e - s >= 3 && s[1] == 0x80 && (s[2] == 0xa8 || s[2] == 0xa9)) {
+        return true;
+      }
+    }
+    ++s;
+  }
+  return false;
+}
+
+}  // namespace
+
 RegexCache::~RegexCache() { clear(); }
 
 void RegexCache::clear() noexcept {
@@ -126,6 +150,120 @@ void RegexCache::buildRegexPattern(std::string& out, char const* ptr,
 }
 
 /// @brief compile a LIKE pattern from a string
+RegexCache::LikePatternType RegexCache::analyzeLikePattern(std::string& literal,
+                                                           char const* ptr, size_t length) {
+  literal.clear();
+  literal.reserve(length);
+
+  bool leadingWildcard = false;
+  bool trailingWildcard = false;
+  bool escaped = false;
+
+  for (size_t i = 0; i < length; ++i) {
+    char const c = ptr[i];
+
+    if (c == '\\') {
+      if (escaped) {
+        // literal backslash
+        if (trailingWildcard) {
+          return LikePatternType::Regex;
+        }
+        literal.push_back('\\');
+      }
+      escaped = !escaped;
+      continue;
+    }
+
+    if (c == '_' && !escaped) {
+      // single character wildcard
+      return LikePatternType::Regex;
+    }
+
+    if (c == '%' && !escaped) {
+      if (literal.empty()) {
+        leadingWildcard = true;
+      } else {
+        trailingWildcard = true;
+      }
+      continue;
+    }
+
+    if (trailingWildcard) {
+      // literal after a wildcard that follows a literal, e.g. "a%b"
+      return LikePatternType::Regex;
+    }
+
+    if (escaped && c != '%' && c != '_' && c != '?' && c != '+' && c != '[' &&
+        c != '(' && c != ')' && c != '{' && c != '}' && c != '^' &&
+        c != '$' && c != '|' && c != '.' && c != '*') {
+      // found a backslash followed by no special character.
+      // same as in buildLikePattern
+      literal.push_back('\\');
+    }
+    literal.push_back(c);
+    escaped = false;
+  }
+
+  if (literal.empty()) {
+    // "" matches the empty string only, "%" matches everything
+    return leadingWildcard ? LikePatternType::Contains : LikePatternType::Exact;
+  }
+  if (leadingWildcard) {
+    return trailingWildcard ? LikePatternType::Contains : LikePatternType::Suffix;
+  }
+  return trailingWildcard ? LikePatternType::Prefix : LikePatternType::Exact;
+}
+
+bool RegexCache::matchLikePattern(LikePatternType type, std::string const& literal,
+                                  char const* value, size_t length, bool& result) {
+  TRI_ASSERT(type != LikePatternType::Regex);
+
+  size_t const n = literal.size();
+
+  switch (type) {
+    case LikePatternType::Exact: {
+      result = (length == n && memcmp(value, literal.data(), n) == 0);
+      return true;
+    }
+    case LikePatternType::Prefix: {
+      if (length < n || memcmp(value, literal.data(), n) != 0) {
+        result = false;
+        return true;
+      }
+      if (containsLineSeparator(value + n, length - n)) {
+        return false;
+      }
+      result = true;
+      return true;
+    }
+    case LikePatternType::Suffix: {
+      if (length < n || memcmp(value + length - n, literal.data(), n) != 0) {
+        result = false;
+        return true;
+      }
+      if (containsLineSeparator(value, length - n)) {
+        return false;
+      }
+      result = true;
+      return true;
+    }
+    case LikePatternType::Contains: {
+      if (containsLineSeparator(value, length)) {
+        // the regex may still find an occurrence with no separator around it
+        return false;
+      }
+      result = (n == 0 ||
+                (length >= n && memmem(value, length, literal.data(), n) != nullptr));
+      return true;
+    }
+    case LikePatternType::Regex: {
+      break;
+    }
+  }
+
+  return false;
+}
+
 void RegexCache::buildLikePattern(std::string& out, char const* ptr,
                                   size_t length, bool caseInsensitive) {
   out.clear();
@@ -64,6 +64,22 @@ class RegexCache {
   static std::pair<bool, bool> inspectLikePattern(std::string& out,
                                                   char const* ptr, size_t length);
 
+  /// @brief the kinds of LIKE patterns that can be matched without a regex
+  enum class LikePatternType { Exact, Prefix, Suffix, Contains, Regex };
+
+  /// @brief analyze a case-sensitive LIKE pattern. for all types except
+  /// Regex, `literal` is set to the unescaped literal part of the pattern,
+  /// e.g. "abc" for "abc", "abc%", "%abc" and "%abc%"
+  static LikePatternType analyzeLikePattern(std::string& literal,
+                                            char const* ptr, size_t length);
+
+  /// @brief match a value against a pattern analyzed by analyzeLikePattern.
+  /// returns false if the result cannot be determined without the regex.
+  /// this is the case if a wildcard would have to match a line separator
+  /// other than \r and \n, which the regex wildcard does not match
+  static bool matchLikePattern(LikePatternType type, std::string const& literal,
+                               char const* value, size_t length, bool& result);
+
  private:
   /// @brief get matcher from cache, or insert a new matcher for the specified
   /// pattern
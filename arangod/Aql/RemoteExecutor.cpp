@@ -27,10 +27,13 @@
 #include "Aql/WakeupQueryCallback.h"
 #include "Basics/MutexLocker.h"
 #include "Basics/RecursiveLocker.h"
+#include "Basics/StaticStrings.h"
 #include "Basics/StringBuffer.h"
 #include "Basics/VelocyPackHelper.h"
 #include "Cluster/ClusterComm.h"
 #include "Cluster/ServerState.h"
+#include "Transaction/Context.h"
+#include "Transaction/Methods.h"
 
 #include <lib/Rest/CommonDefines.h>
 #include <velocypack/Iterator.h>
@@ -44,6 +47,13 @@ using arangodb::basics::VelocyPackHelper;
 /// @brief timeout
 double const ExecutionBlockImpl<RemoteExecutor>::defaultTimeOut = 3600.0;
 
+namespace {
+/// @brief request bodies are sent as binary VelocyPack
+std::shared_ptr<std::string const> buildBody(VPackSlice slice) {
+  return std::make_shared<std::string const>(slice.startAs<char>(), slice.byteSize());
+}
+}  // namespace
+
 ExecutionBlockImpl<RemoteExecutor>::ExecutionBlockImpl(
     ExecutionEngine* engine, RemoteNode const* node, ExecutorInfos&& infos,
     std::string const& server, std::string const& ownName, std::string const& queryId)
@@ -57,7 +67,12 @@ ExecutionBlockImpl<RemoteExecutor>::ExecutionBlockImpl(
       _lastResponse(nullptr),
       _lastError(TRI_ERROR_NO_ERROR),
       _lastTicketId(0),
-      _hasTriggeredShutdown(false) {
+      _hasTriggeredShutdown(false),
+      // subqueries initialize their dependencies once per input row
+      _requestShutdownWithFinalBatch(_isResponsibleForInitializeCursor &&
+                                     ownName.empty() &&
+                                     !node->plan()->contains(ExecutionNode::SUBQUERY)),
+      _remoteIsShutdown(false) {
   TRI_ASSERT(!queryId.empty());
   TRI_ASSERT((arangodb::ServerState::instance()->isCoordinator() && ownName.empty()) ||
              (!arangodb::ServerState::instance()->isCoordinator() && !ownName.empty()));
@@ -85,6 +100,17 @@ std::pair<ExecutionState, SharedAqlItemBlockPtr> ExecutionBlockImpl<RemoteExecut
     THROW_ARANGO_EXCEPTION(TRI_ERROR_QUERY_KILLED);
   }
 
+  if (hasPendingRequest()) {
+    // we are polled again, e.g. by a gather block that fetches from all of its
+    // dependencies at the same time, before our response has arrived
+    return {ExecutionState::WAITING, nullptr};
+  }
+
+  if (_remoteIsShutdown) {
+    // the final batch has been delivered already
+    return {ExecutionState::DONE, nullptr};
+  }
+
   // For every call we simply forward via HTTP
   if (_lastError.fail()) {
     TRI_ASSERT(_lastResponse == nullptr);
@@ -110,7 +136,12 @@ std::pair<ExecutionState, SharedAqlItemBlockPtr> ExecutionBlockImpl<RemoteExecut
     if (VelocyPackHelper::getBooleanValue(responseBody, "done", true)) {
       state = ExecutionState::DONE;
     }
-    if (responseBody.hasKey("data")) {
+    if (VelocyPackHelper::getBooleanValue(responseBody, "shutdown", false)) {
+      // the remote snippet is gone already, see _requestShutdownWithFinalBatch
+      addRemoteStatsAndWarnings(responseBody);
+      _remoteIsShutdown = true;
+    }
+    if (responseBody.hasKey("data") || responseBody.hasKey("compressed")) {
       SharedAqlItemBlockPtr r =
           _engine->itemBlockManager().requestAndInitBlock(responseBody);
 
@@ -123,9 +154,15 @@ std::pair<ExecutionState, SharedAqlItemBlockPtr> ExecutionBlockImpl<RemoteExecut
   VPackBuilder builder;
   builder.openObject();
   builder.add("atMost", VPackValue(atMost));
+  // we can handle LZ4-compressed blocks. older servers ignore this
+  builder.add("compression", VPackValue("lz4"));
+  if (_requestShutdownWithFinalBatch) {
+    // older servers ignore this and wait for the shutdown request
+    builder.add("shutdown", VPackValue(true));
+  }
   builder.close();
 
-  auto bodyString = std::make_shared<std::string const>(builder.slice().toJson());
+  auto bodyString = buildBody(builder.slice());
 
   auto res = sendAsyncRequest(rest::RequestType::PUT, "/_api/aql/getSome/", bodyString);
   if (!res.ok()) {
@@ -142,6 +179,14 @@ std::pair<ExecutionState, size_t> ExecutionBlockImpl<RemoteExecutor>::skipSome(s
 }
 
 std::pair<ExecutionState, size_t> ExecutionBlockImpl<RemoteExecutor>::skipSomeWithoutTrace(size_t atMost) {
+  if (hasPendingRequest()) {
+    return {ExecutionState::WAITING, 0};
+  }
+
+  if (_remoteIsShutdown) {
+    return {ExecutionState::DONE, 0};
+  }
+
   if (_lastError.fail()) {
     TRI_ASSERT(_lastResponse == nullptr);
     Result res = _lastError;
@@ -190,7 +235,7 @@ std::pair<ExecutionState, size_t> ExecutionBlockImpl<RemoteExecutor>::skipSomeWi
   builder.add("atMost", VPackValue(atMost));
   builder.close();
 
-  auto bodyString = std::make_shared<std::string const>(builder.slice().toJson());
+  auto bodyString = buildBody(builder.slice());
 
   auto res = sendAsyncRequest(rest::RequestType::PUT, "/_api/aql/skipSome/", bodyString);
   if (!res.ok()) {
@@ -251,7 +296,14 @@ std::pair<ExecutionState, Result> ExecutionBlockImpl<RemoteExecutor>::initialize
 
   builder.close();
 
-  auto bodyString = std::make_shared<std::string const>(builder.slice().toJson());
+  // the row may point to documents, which contain externals and custom
+  // values that the other side cannot resolve
+  VPackBuilder sanitized(&options);
+  VelocyPackHelper::sanitizeNonClientTypes(
+      builder.slice(), VPackSlice::noneSlice(), sanitized,
+      _engine->getQuery()->trx()->transactionContextPtr()->getVPackOptions(), true, true);
+
+  auto bodyString = buildBody(sanitized.slice());
 
   auto res = sendAsyncRequest(rest::RequestType::PUT,
                               "/_api/aql/initializeCursor/", bodyString);
@@ -266,7 +318,24 @@ std::pair<ExecutionState, Result> ExecutionBlockImpl<RemoteExecutor>::initialize
 std::pair<ExecutionState, Result> ExecutionBlockImpl<RemoteExecutor>::shutdown(int errorCode) {
 
   if (!_isResponsibleForInitializeCursor) {
-    // do nothing...
+    // the remote snippet is shut down by another block, but a request
+    // fetched ahead of time may still be in flight, e.g. if a LIMIT
+    // terminated the query early. it is of no use anymore
+    MUTEX_LOCKER(locker, _communicationMutex);
+    if (_lastTicketId != 0) {
+      auto cc = ClusterComm::instance();
+      if (cc != nullptr) {
+        cc->drop(0, _lastTicketId, "");
+      }
+      _lastTicketId = 0;
+    }
+    _lastError.reset(TRI_ERROR_NO_ERROR);
+    _lastResponse.reset();
+    return {ExecutionState::DONE, TRI_ERROR_NO_ERROR};
+  }
+
+  if (_remoteIsShutdown) {
+    // shut down along with the final batch
     return {ExecutionState::DONE, TRI_ERROR_NO_ERROR};
   }
 
@@ -320,26 +389,7 @@ std::pair<ExecutionState, Result> ExecutionBlockImpl<RemoteExecutor>::shutdown(i
 
     VPackSlice slice = responseBodyBuilder->slice();
     if (slice.isObject()) {
-      if (slice.hasKey("stats")) {
-        ExecutionStats newStats(slice.get("stats"));
-        _engine->_stats.add(newStats);
-      }
-
-      // read "warnings" attribute if present and add it to our query
-      VPackSlice warnings = slice.get("warnings");
-      if (warnings.isArray()) {
-        auto query = _engine->getQuery();
-        for (auto const& it : VPackArrayIterator(warnings)) {
-          if (it.isObject()) {
-            VPackSlice code = it.get("code");
-            VPackSlice message = it.get("message");
-            if (code.isNumber() && message.isString()) {
-              query->registerWarning(code.getNumericValue<int>(),
-                                     message.copyString().c_str());
-            }
-          }
-        }
-      }
+      addRemoteStatsAndWarnings(slice);
       if (slice.hasKey("code")) {
         return {ExecutionState::DONE, slice.get("code").getNumericValue<int>()};
       }
@@ -354,7 +404,7 @@ std::pair<ExecutionState, Result> ExecutionBlockImpl<RemoteExecutor>::shutdown(i
   bodyBuilder.add("code", VPackValue(errorCode));
   bodyBuilder.close();
 
-  auto bodyString = std::make_shared<std::string const>(bodyBuilder.slice().toJson());
+  auto bodyString = buildBody(bodyBuilder.slice());
 
   auto res = sendAsyncRequest(rest::RequestType::PUT, "/_api/aql/shutdown/", bodyString);
   if (!res.ok()) {
@@ -363,6 +413,29 @@ std::pair<ExecutionState, Result> ExecutionBlockImpl<RemoteExecutor>::shutdown(i
   return {ExecutionState::WAITING, TRI_ERROR_NO_ERROR};
 }
 
+void ExecutionBlockImpl<RemoteExecutor>::addRemoteStatsAndWarnings(VPackSlice slice) {
+  if (slice.hasKey("stats")) {
+    ExecutionStats newStats(slice.get("stats"));
+    _engine->_stats.add(newStats);
+  }
+
+  // read "warnings" attribute if present and add it to our query
+  VPackSlice warnings = slice.get("warnings");
+  if (warnings.isArray()) {
+    auto query = _engine->getQuery();
+    for (auto const& it : VPackArrayIterator(warnings)) {
+      if (it.isObject()) {
+        VPackSlice code = it.get("code");
+        VPackSlice message = it.get("message");
+        if (code.isNumber() && message.isString()) {
+          query->registerWarning(code.getNumericValue<int>(),
+                                 message.copyString().c_str());
+        }
+      }
+    }
+  }
+}
+
 Result ExecutionBlockImpl<RemoteExecutor>::sendAsyncRequest(
     arangodb::rest::RequestType type, std::string const& urlPart,
     std::shared_ptr<std::string const> body) {
@@ -375,6 +448,10 @@ Result ExecutionBlockImpl<RemoteExecutor>::sendAsyncRequest(
   // Later, we probably want to set these sensibly:
   CoordTransactionID const coordTransactionId = TRI_NewTickServer();
   std::unordered_map<std::string, std::string> headers;
+  // binary VelocyPack in both directions, so neither side has to
+  // serialize or parse JSON
+  headers.emplace(StaticStrings::ContentTypeHeader, StaticStrings::MimeTypeVPack);
+  headers.emplace(StaticStrings::Accept, StaticStrings::MimeTypeVPack);
   if (!_ownName.empty()) {
     headers.emplace("Shard-Id", _ownName);
   }
@@ -408,6 +485,16 @@ Result ExecutionBlockImpl<RemoteExecutor>::sendAsyncRequest(
   return {TRI_ERROR_NO_ERROR};
 }
 
+bool ExecutionBlockImpl<RemoteExecutor>::hasPendingRequest() {
+  #ifdef ARANGODB_USE_GOOGLE_TESTS
+    RECURSIVE_MUTEX_LOCKER(_communicationMutex, _communicationMutexOwner);
+  #else
+    MUTEX_LOCKER(locker, _communicationMutex);
+  #endif
+
+  return _lastTicketId != 0;
+}
+
 bool ExecutionBlockImpl<RemoteExecutor>::handleAsyncResult(ClusterCommResult* result) {
   // So we cannot have the response being produced while sending the request.
   // Make sure to cover against the race that this
@@ -452,9 +539,7 @@ arangodb::Result ExecutionBlockImpl<RemoteExecutor>::handleCommErrors(ClusterCom
     int errorNum = TRI_ERROR_INTERNAL;
     if (res->result != nullptr) {
       errorNum = TRI_ERROR_NO_ERROR;
-      arangodb::basics::StringBuffer const& responseBodyBuf(res->result->getBody());
-      std::shared_ptr<VPackBuilder> builder =
-          VPackParser::fromJson(responseBodyBuf.c_str(), responseBodyBuf.length());
+      std::shared_ptr<VPackBuilder> builder = res->result->getBodyVelocyPack();
       VPackSlice slice = builder->slice();
 
       if (!slice.hasKey(StaticStrings::Error) ||
@@ -513,6 +598,7 @@ std::shared_ptr<VPackBuilder> ExecutionBlockImpl<RemoteExecutor>::stealResultBod
   }
   // We have an open result still.
   // Result is the response which is an object containing the ErrorCode
+  _metrics.bytesFetched += _lastResponse->getBody().length();
   std::shared_ptr<VPackBuilder> responseBodyBuilder = _lastResponse->getBodyVelocyPack();
   _lastResponse.reset();
   return responseBodyBuilder;
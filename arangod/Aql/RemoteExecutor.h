@@ -98,6 +98,15 @@ class ExecutionBlockImpl<RemoteExecutor> : public ExecutionBlock {
 
   std::shared_ptr<velocypack::Builder> stealResultBody();
 
+  /// @brief add the statistics and warnings reported by the remote snippet
+  /// when it was shut down to our query
+  void addRemoteStatsAndWarnings(velocypack::Slice slice);
+
+  /// @brief whether a request has been sent, but its response has not yet
+  /// arrived. A block that is polled again in this state must not send
+  /// another request, but simply keep waiting for the wakeup.
+  bool hasPendingRequest();
+
  private:
   /// @brief timeout
   static double const defaultTimeOut;
@@ -135,6 +144,15 @@ class ExecutionBlockImpl<RemoteExecutor> : public ExecutionBlock {
   OperationID _lastTicketId;
 
   bool _hasTriggeredShutdown;
+
+  /// @brief whether the remote snippet is asked to shut down along with
+  /// its final batch. only done if this block is responsible for the
+  /// shutdown and the cursor is never initialized again
+  bool const _requestShutdownWithFinalBatch;
+
+  /// @brief whether the remote snippet has been shut down along with its
+  /// final batch, so no shutdown request must be sent anymore
+  bool _remoteIsShutdown;
 };
 
 }  // namespace aql
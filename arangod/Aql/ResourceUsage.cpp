@@ -0,0 +1,104 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "ResourceUsage.h"
+
+#include "Basics/ConditionLocker.h"
+#include "Basics/system-functions.h"
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+GlobalResourceMonitor::GlobalResourceMonitor()
+    : _limit(0), _used(0), _admissionTimeout(0.0), _waiting(0) {}
+
+GlobalResourceMonitor& GlobalResourceMonitor::instance() {
+  static GlobalResourceMonitor monitor;
+  return monitor;
+}
+
+void GlobalResourceMonitor::reserve(size_t value) {
+  size_t const limit = _limit.load(std::memory_order_relaxed);
+  size_t const used = _used.fetch_add(value) + value;
+
+  if (limit > 0 && used > limit) {
+    release(value);
+    THROW_ARANGO_EXCEPTION_MESSAGE(
+        TRI_ERROR_RESOURCE_LIMIT,
+        "query would exceed the global query memory limit");
+  }
+}
+
+void GlobalResourceMonitor::release(size_t value) noexcept {
+  TRI_ASSERT(_used.load() >= value);
+  _used -= value;
+
+  if (_waiting.load() > 0) {
+    CONDITION_LOCKER(guard, _condition);
+    guard.broadcast();
+  }
+}
+
+void GlobalResourceMonitor::admit() {
+  size_t const limit = _limit.load(std::memory_order_relaxed);
+  if (limit == 0 || _used.load() + chunkSize <= limit) {
+    return;
+  }
+
+  double const end = TRI_microtime() + _admissionTimeout.load();
+
+  ++_waiting;
+  CONDITION_LOCKER(guard, _condition);
+  while (_used.load() + chunkSize > limit) {
+    double const now = TRI_microtime();
+    if (now >= end) {
+      --_waiting;
+      THROW_ARANGO_EXCEPTION_MESSAGE(
+          TRI_ERROR_RESOURCE_LIMIT,
+          "global query memory limit exhausted, query not admitted");
+    }
+    guard.wait(static_cast<uint64_t>((end - now) * 1000000.0) + 1);
+  }
+  --_waiting;
+}
+
+void ResourceMonitor::reserve() {
+  size_t const reserved = _reserved.load(std::memory_order_relaxed);
+  TRI_ASSERT(currentResources.memoryUsage > reserved);
+
+  size_t const chunks = (currentResources.memoryUsage - reserved +
+                         GlobalResourceMonitor::chunkSize - 1) /
+                        GlobalResourceMonitor::chunkSize;
+  size_t const value = chunks * GlobalResourceMonitor::chunkSize;
+
+  GlobalResourceMonitor::instance().reserve(value);
+  _reserved.store(reserved + value, std::memory_order_relaxed);
+}
+
+void ResourceMonitor::releaseReserved(size_t keep) noexcept {
+  size_t const reserved = _reserved.load(std::memory_order_relaxed);
+  // whole chunks only
+  keep = ((keep + GlobalResourceMonitor::chunkSize - 1) / GlobalResourceMonitor::chunkSize) *
+         GlobalResourceMonitor::chunkSize;
+  if (reserved > keep) {
+    GlobalResourceMonitor::instance().release(reserved - keep);
+    _reserved.store(keep, std::memory_order_relaxed);
+  }
+}
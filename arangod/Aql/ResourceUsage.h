@@ -25,9 +25,11 @@
 #define ARANGOD_AQL_RESOURCE_USAGE_H 1
 
 #include "Basics/Common.h"
+#include "Basics/ConditionVariable.h"
 #include "Basics/Exceptions.h"
 
 #include <algorithm>
+#include <atomic>
 
 namespace arangodb {
 namespace aql {
@@ -49,10 +51,59 @@ struct ResourceUsage {
   size_t peakMemoryUsage;
 };
 
+/// @brief the memory budget shared by all queries of a server. queries
+/// reserve it in chunks, so the shared counter is only touched when a
+/// query's memory usage crosses a chunk boundary
+class GlobalResourceMonitor {
+ public:
+  static constexpr size_t chunkSize = 1024 * 1024;
+
+  GlobalResourceMonitor();
+
+  GlobalResourceMonitor(GlobalResourceMonitor const&) = delete;
+  GlobalResourceMonitor& operator=(GlobalResourceMonitor const&) = delete;
+
+  static GlobalResourceMonitor& instance();
+
+  /// @brief the budget in bytes, 0 means no limit
+  void setMemoryLimit(size_t value) { _limit.store(value); }
+  size_t memoryLimit() const { return _limit.load(std::memory_order_relaxed); }
+
+  /// @brief how long a new query waits for memory to become available
+  void setAdmissionTimeout(double value) { _admissionTimeout.store(value); }
+
+  /// @brief memory reserved by all queries
+  size_t memoryUsage() const { return _used.load(std::memory_order_relaxed); }
+
+  /// @brief reserve memory, throws TRI_ERROR_RESOURCE_LIMIT if the budget is
+  /// exhausted
+  void reserve(size_t value);
+
+  /// @brief return reserved memory
+  void release(size_t value) noexcept;
+
+  /// @brief admission control for a new query. waits until at least a chunk
+  /// of the budget is free, throws TRI_ERROR_RESOURCE_LIMIT if none becomes
+  /// free within the admission timeout
+  void admit();
+
+ private:
+  std::atomic<size_t> _limit;
+  std::atomic<size_t> _used;
+  std::atomic<double> _admissionTimeout;
+  /// @brief number of queries waiting in admit()
+  std::atomic<size_t> _waiting;
+  basics::ConditionVariable _condition;
+};
+
 struct ResourceMonitor {
-  ResourceMonitor() : currentResources(), maxResources() {}
+  ResourceMonitor() : currentResources(), maxResources(), _reserved(0) {}
   explicit ResourceMonitor(ResourceUsage const& maxResources)
-      : currentResources(), maxResources(maxResources) {}
+      : currentResources(), maxResources(maxResources), _reserved(0) {}
+  ~ResourceMonitor() { releaseReserved(0); }
+
+  ResourceMonitor(ResourceMonitor const&) = delete;
+  ResourceMonitor& operator=(ResourceMonitor const&) = delete;
 
   void setMemoryLimit(size_t value) { maxResources.memoryUsage = value; }
 
@@ -66,18 +117,50 @@ struct ResourceMonitor {
           TRI_ERROR_RESOURCE_LIMIT, "query would use more memory than allowed");
     }
 
+    if (ADB_UNLIKELY(currentResources.memoryUsage > _reserved.load(std::memory_order_relaxed))) {
+      try {
+        reserve();
+      } catch (...) {
+        currentResources.memoryUsage -= value;
+        throw;
+      }
+    }
+
     currentResources.peakMemoryUsage = std::max(currentResources.memoryUsage, currentResources.peakMemoryUsage);
   }
 
   inline void decreaseMemoryUsage(size_t value) noexcept {
     TRI_ASSERT(currentResources.memoryUsage >= value);
     currentResources.memoryUsage -= value;
+
+    // keep a spare chunk, so that a query does not reserve and release the
+    // same chunk over and over
+    if (ADB_UNLIKELY(_reserved.load(std::memory_order_relaxed) >
+                     currentResources.memoryUsage + 2 * GlobalResourceMonitor::chunkSize)) {
+      releaseReserved(currentResources.memoryUsage + GlobalResourceMonitor::chunkSize);
+    }
   }
 
-  void clear() { currentResources.clear(); }
+  void clear() {
+    currentResources.clear();
+    releaseReserved(0);
+  }
+
+  /// @brief the memory reserved from the global budget, which is the memory
+  /// usage rounded up to chunks. may be read by other threads
+  size_t reservedMemory() const { return _reserved.load(std::memory_order_relaxed); }
 
   ResourceUsage currentResources;
   ResourceUsage maxResources;
+
+ private:
+  /// @brief reserve chunks for the current memory usage
+  void reserve();
+
+  /// @brief release chunks down to the given size
+  void releaseReserved(size_t keep) noexcept;
+
+  std::atomic<size_t> _reserved;
 };
 
 }  // namespace aql
@@ -29,8 +29,11 @@
 
 #include "Aql/AqlItemBlock.h"
 #include "Aql/BlocksWithClients.h"
+#include "Aql/ClusterNodes.h"
+#include "Aql/EngineInfoContainerDBServer.h"
 #include "Aql/ExecutionBlock.h"
 #include "Aql/ExecutionEngine.h"
+#include "Aql/ExecutionPlan.h"
 #include "Aql/Query.h"
 #include "Aql/QueryRegistry.h"
 #include "Basics/Exceptions.h"
@@ -57,6 +60,28 @@ using namespace arangodb::aql;
 
 using VelocyPackHelper = arangodb::basics::VelocyPackHelper;
 
+namespace {
+/// @brief whether a snippet may be shut down along with its final batch.
+/// the main snippet of a server owns the transaction, which must stay
+/// alive until all other snippets are done, and a snippet that forwards
+/// initializeCursor and shutdown to the coordinator cannot be shut down
+/// without waiting
+bool canShutdownWithFinalBatch(Query const* query) {
+  if (query->part() != PART_DEPENDENT || query->plan() == nullptr) {
+    return false;
+  }
+  SmallVector<ExecutionNode*>::allocator_type::arena_type a;
+  SmallVector<ExecutionNode*> nodes{a};
+  query->plan()->findNodesOfType(nodes, ExecutionNode::REMOTE, true);
+  for (auto const& n : nodes) {
+    if (ExecutionNode::castTo<RemoteNode const*>(n)->isResponsibleForInitializeCursor()) {
+      return false;
+    }
+  }
+  return true;
+}
+}  // namespace
+
 RestAqlHandler::RestAqlHandler(GeneralRequest* request, GeneralResponse* response,
                                std::pair<QueryRegistry*, traverser::TraverserEngineRegistry*>* registries)
     : RestVocbaseBaseHandler(request, response),
@@ -286,7 +311,22 @@ bool RestAqlHandler::registerSnippets(VPackSlice const snippetsSlice,
     planBuilder->add("initialize", VPackValue(false));
 
     planBuilder->add(VPackValue("nodes"));
-    planBuilder->add(it.value.get("nodes"));
+    VPackSlice templateKey = it.value.get("template");
+    if (templateKey.isString()) {
+      // the snippet only differs from the snippet of another shard in
+      // the shard names, expand it from there
+      VPackSlice templateSnippet = snippetsSlice.get(templateKey.copyString());
+      if (!templateSnippet.isObject() || !templateSnippet.get("nodes").isArray()) {
+        generateError(rest::ResponseCode::BAD, TRI_ERROR_QUERY_BAD_JSON_PLAN,
+                      "unknown snippet template '" + templateKey.copyString() + "'");
+        return false;
+      }
+      EngineInfoContainerDBServer::instantiateSnippetTemplate(
+          templateSnippet.get("nodes"), it.value.get("shards"),
+          it.value.get("isResponsibleForInitializeCursor").isTrue(), *planBuilder);
+    } else {
+      planBuilder->add(it.value.get("nodes"));
+    }
 
     planBuilder->add(VPackValue("variables"));
     planBuilder->add(variablesSlice);
@@ -752,7 +792,31 @@ RestStatus RestAqlHandler::handleUseQuery(std::string const& operation, Query* q
           answerBuilder.add("exhausted", VPackValue(true));
           answerBuilder.add(StaticStrings::Error, VPackValue(false));
         } else {
-          items->toVelocyPack(query->trx(), answerBuilder);
+          // LZ4 compression of the block is only used if the caller
+          // announced that it can handle it
+          bool const allowCompression =
+              VelocyPackHelper::getStringValue(querySlice, "compression", "") == "lz4";
+          items->toVelocyPack(query->trx(), answerBuilder, allowCompression);
+        }
+
+        // the caller may ask to tear down the snippet along with its final
+        // batch, which saves the separate shutdown request
+        if (state == ExecutionState::DONE && shardId.empty() &&
+            VelocyPackHelper::getBooleanValue(querySlice, "shutdown", false) &&
+            canShutdownWithFinalBatch(query)) {
+          // the block belongs to the engine, which is destroyed below
+          items = nullptr;
+          Result res = query->engine()->shutdownSync(TRI_ERROR_NO_ERROR);
+
+          answerBuilder.add("shutdown", VPackValue(true));
+          answerBuilder.add(VPackValue("stats"));
+          query->getStats(answerBuilder);
+          query->addWarningsToVelocyPack(answerBuilder);
+
+          _queryRegistry->close(&_vocbase, _qId);
+          closeGuard.cancel();
+          _queryRegistry->destroy(_vocbase.name(), _qId, res.errorNumber(), false);
+          _qId = 0;
         }
       } else if (operation == "skipSome") {
         auto atMost =
@@ -58,11 +58,17 @@ void SharedQueryState::setContinueHandler(std::function<void()> const& handler)
   std::lock_guard<std::mutex> guard(_mutex);
   _continueCallback = handler;
   _hasHandler = true;
+  // a queued call of a previous handler must not swallow wakeups for this one
+  _continueQueued = false;
 }
 
 /// execute the _continueCallback. must hold _mutex
-bool SharedQueryState::executeContinueCallback() const {
+bool SharedQueryState::executeContinueCallback() {
   TRI_ASSERT(_hasHandler);
+  if (_continueQueued) {
+    // the queued call will pick up the results of this wakeup as well
+    return true;
+  }
   auto scheduler = SchedulerFeature::SCHEDULER;
   if (ADB_UNLIKELY(scheduler == nullptr)) {
     // We are shutting down
@@ -70,6 +76,13 @@ bool SharedQueryState::executeContinueCallback() const {
   }
   // do NOT use scheduler->post(), can have high latency that
   //  then backs up libcurl callbacks to other objects
-  scheduler->queue(RequestLane::CLIENT_AQL, _continueCallback);
+  _continueQueued = scheduler->queue(RequestLane::CLIENT_AQL,
+                                     [self = shared_from_this(), cb = _continueCallback]() {
+                                       {
+                                         std::lock_guard<std::mutex> guard(self->_mutex);
+                                         self->_continueQueued = false;
+                                       }
+                                       cb();
+                                     });
   return true;
 }
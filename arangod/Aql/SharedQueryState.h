@@ -29,12 +29,13 @@
 namespace arangodb {
 namespace aql {
 
-class SharedQueryState {
+class SharedQueryState : public std::enable_shared_from_this<SharedQueryState> {
  public:
   SharedQueryState(SharedQueryState const&) = delete;
   SharedQueryState& operator=(SharedQueryState const&) = delete;
 
-  SharedQueryState() : _wasNotified(false), _hasHandler(false), _valid(true) {}
+  SharedQueryState()
+      : _wasNotified(false), _hasHandler(false), _valid(true), _continueQueued(false) {}
 
   ~SharedQueryState() = default;
 
@@ -87,7 +88,7 @@ class SharedQueryState {
 
  private:
   /// execute the _continueCallback. must hold _mutex
-  bool executeContinueCallback() const;
+  bool executeContinueCallback();
 
  private:
   std::mutex _mutex;
@@ -106,6 +107,13 @@ class SharedQueryState {
   bool _hasHandler;
 
   bool _valid;
+
+  /// @brief whether a call of the _continueCallback is queued, but has not
+  /// yet started. further wakeups until then are covered by that call, because
+  /// it will see all results that have been stored before it starts. this
+  /// saves re-entering the whole execution tree once per response when many
+  /// remote responses arrive at about the same time
+  bool _continueQueued;
 };
 
 }  // namespace aql
@@ -91,6 +91,28 @@ char* ShortStringStorage::unescape(char const* p, size_t length, size_t* outLeng
   return position;
 }
 
+/// @brief register a short string in VelocyPack format
+uint8_t const* ShortStringStorage::registerVPackString(char const* p, size_t length) {
+  // VelocyPack short strings have a maximum length of 126 bytes
+  TRI_ASSERT(length < maxStringLength);
+
+  if (_current == nullptr || (_current + length + 1 > _end)) {
+    allocateBlock();
+  }
+
+  TRI_ASSERT(!_blocks.empty());
+  TRI_ASSERT(_current != nullptr);
+  TRI_ASSERT(_end != nullptr);
+  TRI_ASSERT(_current + length + 1 <= _end);
+
+  uint8_t* position = reinterpret_cast<uint8_t*>(_current);
+  position[0] = static_cast<uint8_t>(0x40U + length);
+  memcpy(static_cast<void*>(position + 1), p, length);
+  _current += length + 1;
+
+  return position;
+}
+
 /// @brief allocate a new block of memory
 void ShortStringStorage::allocateBlock() {
   char* buffer = new char[_blockSize];
@@ -46,6 +46,10 @@ class ShortStringStorage {
   /// @brief register a short string, unescaping it
   char* unescape(char const* p, size_t length, size_t* outLength);
 
+  /// @brief register a short string in VelocyPack format, i.e. with the
+  /// VelocyPack header byte in front of it
+  uint8_t const* registerVPackString(char const* p, size_t length);
+
  private:
   /// @brief allocate a new block of memory
   void allocateBlock();
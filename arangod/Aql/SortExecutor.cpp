@@ -29,29 +29,79 @@
 #include "Aql/OutputAqlItemRow.h"
 #include "Aql/SortRegister.h"
 #include "Aql/Stats.h"
+#include "Basics/Utf8Helper.h"
+
+#include <velocypack/Slice.h>
+#include <velocypack/velocypack-aliases.h>
 
 #include <algorithm>
+#include <numeric>
 
 using namespace arangodb;
 using namespace arangodb::aql;
 
 namespace {
 
+/// @brief minimum number of rows for which collation sort keys are
+/// precomputed. for fewer rows, comparing the strings directly is cheaper
+constexpr size_t minRowsForSortKeys = 32;
+
+/// @brief computes the collation sort keys of the values of a register, if
+/// all of them are strings. every string goes through ICU only once then, and
+/// the sorting itself compares keys bytewise. leaves keys empty otherwise
+void buildSortKeys(AqlItemMatrix const& input,
+                   std::vector<AqlItemMatrix::RowIndex> const& rows,
+                   RegisterId reg, std::vector<std::string>& keys) {
+  for (auto const& row : rows) {
+    if (!input.getValueReference(row, reg).isString()) {
+      return;
+    }
+  }
+
+  keys.reserve(rows.size());
+  for (auto const& row : rows) {
+    VPackValueLength length;
+    char const* p = input.getValueReference(row, reg).slice().getString(length);
+
+    std::string key;
+    arangodb::basics::Utf8Helper::DefaultUtf8Helper.appendSortKey(p, length, key);
+    // strings that collate equal are ordered by their byte length, see
+    // VelocyPackHelper::compareStringValues. sort keys do not contain NUL
+    // bytes, so the length can be appended after a separator
+    key.push_back('\0');
+    for (int shift = 56; shift >= 0; shift -= 8) {
+      key.push_back(static_cast<char>((length >> shift) & 0xff));
+    }
+    keys.emplace_back(std::move(key));
+  }
+}
+
 /// @brief OurLessThan
 class OurLessThan {
  public:
   OurLessThan(arangodb::transaction::Methods* trx, AqlItemMatrix const& input,
-              std::vector<SortRegister> const& sortRegisters) noexcept
-      : _trx(trx), _input(input), _sortRegisters(sortRegisters) {}
-
-  bool operator()(AqlItemMatrix::RowIndex const& a, AqlItemMatrix::RowIndex const& b) const {
-    InputAqlItemRow left = _input.getRow(a);
-    InputAqlItemRow right = _input.getRow(b);
-    for (auto const& reg : _sortRegisters) {
-      AqlValue const& lhs = left.getValue(reg.reg);
-      AqlValue const& rhs = right.getValue(reg.reg);
-
-      int const cmp = AqlValue::Compare(_trx, lhs, rhs, true);
+              std::vector<SortRegister> const& sortRegisters,
+              std::vector<AqlItemMatrix::RowIndex> const& rows,
+              std::vector<std::vector<std::string>> const& sortKeys) noexcept
+      : _trx(trx),
+        _input(input),
+        _sortRegisters(sortRegisters),
+        _rows(rows),
+        _sortKeys(sortKeys) {}
+
+  bool operator()(size_t a, size_t b) const {
+    for (size_t i = 0; i < _sortRegisters.size(); ++i) {
+      auto const& reg = _sortRegisters[i];
+      int cmp;
+
+      if (!_sortKeys[i].empty()) {
+        cmp = _sortKeys[i][a].compare(_sortKeys[i][b]);
+      } else {
+        AqlValue const& lhs = _input.getValueReference(_rows[a], reg.reg);
+        AqlValue const& rhs = _input.getValueReference(_rows[b], reg.reg);
+
+        cmp = AqlValue::Compare(_trx, lhs, rhs, true);
+      }
 
       if (cmp < 0) {
         return reg.asc;
@@ -67,6 +117,8 @@ class OurLessThan {
   arangodb::transaction::Methods* _trx;
   AqlItemMatrix const& _input;
   std::vector<SortRegister> const& _sortRegisters;
+  std::vector<AqlItemMatrix::RowIndex> const& _rows;
+  std::vector<std::vector<std::string>> const& _sortKeys;
 };  // OurLessThan
 
 }  // namespace
@@ -155,13 +207,32 @@ void SortExecutor::doSorting() {
     THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
   }
   TRI_ASSERT(_input != nullptr);
-  _sortedIndexes = _input->produceRowIndexes();
+  std::vector<AqlItemMatrix::RowIndex> rows = _input->produceRowIndexes();
+  auto const& sortRegisters = _infos.sortRegisters();
+
+  std::vector<std::vector<std::string>> sortKeys(sortRegisters.size());
+  if (rows.size() >= ::minRowsForSortKeys) {
+    for (size_t i = 0; i < sortRegisters.size(); ++i) {
+      ::buildSortKeys(*_input, rows, sortRegisters[i].reg, sortKeys[i]);
+    }
+  }
+
+  // sort positions into rows, so that the sort keys can be looked up
+  std::vector<size_t> positions(rows.size());
+  std::iota(positions.begin(), positions.end(), 0);
+
   // comparison function
-  OurLessThan ourLessThan(_infos.trx(), *_input, _infos.sortRegisters());
+  OurLessThan ourLessThan(_infos.trx(), *_input, sortRegisters, rows, sortKeys);
   if (_infos.stable()) {
-    std::stable_sort(_sortedIndexes.begin(), _sortedIndexes.end(), ourLessThan);
+    std::stable_sort(positions.begin(), positions.end(), ourLessThan);
   } else {
-    std::sort(_sortedIndexes.begin(), _sortedIndexes.end(), ourLessThan);
+    std::sort(positions.begin(), positions.end(), ourLessThan);
+  }
+
+  _sortedIndexes.clear();
+  _sortedIndexes.reserve(positions.size());
+  for (auto const& position : positions) {
+    _sortedIndexes.emplace_back(rows[position]);
   }
 }
 
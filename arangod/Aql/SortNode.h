@@ -66,6 +66,9 @@ class SortNode : public ExecutionNode {
   /// @brief if non-zero, limits the number of elements that the node will return
   void setLimit(size_t limit) { _limit = limit; }
 
+  /// @brief the maximum number of elements the node will return, 0 if unlimited
+  size_t limit() const noexcept { return _limit; }
+
   /// @brief return the type of the node
   NodeType getType() const override final { return SORT; }
 
@@ -168,13 +168,14 @@ SortingGatherExecutorInfos::SortingGatherExecutorInfos(
     std::shared_ptr<std::unordered_set<RegisterId>> outputRegisters, RegisterId nrInputRegisters,
     RegisterId nrOutputRegisters, std::unordered_set<RegisterId> registersToClear,
     std::unordered_set<RegisterId> registersToKeep, std::vector<SortRegister>&& sortRegister,
-    arangodb::transaction::Methods* trx, GatherNode::SortMode sortMode)
+    arangodb::transaction::Methods* trx, GatherNode::SortMode sortMode, size_t limit)
     : ExecutorInfos(std::move(inputRegisters), std::move(outputRegisters),
                     nrInputRegisters, nrOutputRegisters,
                     std::move(registersToClear), std::move(registersToKeep)),
       _sortRegister(std::move(sortRegister)),
       _trx(trx),
-      _sortMode(sortMode) {}
+      _sortMode(sortMode),
+      _limit(limit) {}
 
 SortingGatherExecutorInfos::SortingGatherExecutorInfos(SortingGatherExecutorInfos&&) = default;
 SortingGatherExecutorInfos::~SortingGatherExecutorInfos() = default;
@@ -184,7 +185,9 @@ SortingGatherExecutor::SortingGatherExecutor(Fetcher& fetcher, Infos& infos)
       _initialized(false),
       _numberDependencies(0),
       _dependencyToFetch(0),
-      _nrDone() {
+      _nrDone(),
+      _limit(infos.limit()),
+      _rowsReturned(0) {
   switch (infos.sortMode()) {
     case GatherNode::SortMode::MinElement:
       _strategy = std::make_unique<MinElementSorting>(infos.trx(), infos.sortRegister());
@@ -218,6 +221,11 @@ SortingGatherExecutor::~SortingGatherExecutor() = default;
 
 std::pair<ExecutionState, NoStats> SortingGatherExecutor::produceRows(OutputAqlItemRow& output) {
   TRI_ASSERT(_strategy != nullptr);
+  if (_limit > 0 && _rowsReturned >= _limit) {
+    // the query does not need more rows. requests still in flight are
+    // dropped when the query shuts down
+    return {ExecutionState::DONE, NoStats{}};
+  }
   if (!_initialized) {
     ExecutionState state = init();
     if (state != ExecutionState::HASMORE) {
@@ -233,7 +241,7 @@ std::pair<ExecutionState, NoStats> SortingGatherExecutor::produceRows(OutputAqlI
       // This is executed on every produceRows, and will replace the row that we have returned last time
       std::tie(_inputRows[_dependencyToFetch].state,
                _inputRows[_dependencyToFetch].row) =
-          _fetcher.fetchRowForDependency(_dependencyToFetch);
+          _fetcher.fetchRowForDependency(_dependencyToFetch, fetchSize());
       if (_inputRows[_dependencyToFetch].state == ExecutionState::WAITING) {
         return {ExecutionState::WAITING, NoStats{}};
       }
@@ -272,8 +280,9 @@ std::pair<ExecutionState, NoStats> SortingGatherExecutor::produceRows(OutputAqlI
   // inside the outputblock by identical AQL values.
   // This optimization is not in use anymore.
   output.copyRow(val.row);
+  ++_rowsReturned;
   adjustNrDone(_dependencyToFetch);
-  if (_nrDone >= _numberDependencies) {
+  if (_nrDone >= _numberDependencies || (_limit > 0 && _rowsReturned >= _limit)) {
     return {ExecutionState::DONE, NoStats{}};
   }
   return {ExecutionState::HASMORE, NoStats{}};
@@ -305,19 +314,31 @@ ExecutionState SortingGatherExecutor::init() {
     }
   }
 
-  while (_dependencyToFetch < _numberDependencies) {
-    std::tie(_inputRows[_dependencyToFetch].state,
-             _inputRows[_dependencyToFetch].row) =
-        _fetcher.fetchRowForDependency(_dependencyToFetch);
-    if (_inputRows[_dependencyToFetch].state == ExecutionState::WAITING) {
-      return ExecutionState::WAITING;
+  // Ask all dependencies for their first row before waiting for any of them,
+  // so that the requests to remote dependencies are in flight concurrently,
+  // instead of paying one round-trip per dependency one after the other.
+  // A dependency still needs fetching as long as it has neither delivered a
+  // row nor reported DONE.
+  bool waiting = false;
+  for (size_t index = 0; index < _numberDependencies; ++index) {
+    ValueType& input = _inputRows[index];
+    if (input.row || input.state == ExecutionState::DONE) {
+      continue;
+    }
+    std::tie(input.state, input.row) = _fetcher.fetchRowForDependency(index, fetchSize());
+    if (input.state == ExecutionState::WAITING) {
+      waiting = true;
+      continue;
     }
-    if (!_inputRows[_dependencyToFetch].row) {
-      TRI_ASSERT(_inputRows[_dependencyToFetch].state == ExecutionState::DONE);
-      adjustNrDone(_dependencyToFetch);
+    if (!input.row) {
+      TRI_ASSERT(input.state == ExecutionState::DONE);
+      adjustNrDone(index);
     }
-    ++_dependencyToFetch;
   }
+  if (waiting) {
+    return ExecutionState::WAITING;
+  }
+  _dependencyToFetch = _numberDependencies;
   _initialized = true;
   if (_nrDone >= _numberDependencies) {
     return ExecutionState::DONE;
@@ -326,6 +347,14 @@ ExecutionState SortingGatherExecutor::init() {
   return ExecutionState::HASMORE;
 }
 
+size_t SortingGatherExecutor::fetchSize() const noexcept {
+  if (_limit == 0) {
+    return ExecutionBlock::DefaultBatchSize();
+  }
+  TRI_ASSERT(_rowsReturned < _limit);
+  return (std::min)(_limit - _rowsReturned, ExecutionBlock::DefaultBatchSize());
+}
+
 std::pair<ExecutionState, size_t> SortingGatherExecutor::expectedNumberOfRows(size_t atMost) const {
   ExecutionState state;
   size_t expectedNumberOfRows;
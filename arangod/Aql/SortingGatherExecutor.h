@@ -50,7 +50,7 @@ class SortingGatherExecutorInfos : public ExecutorInfos {
                              std::unordered_set<RegisterId> registersToKeep,
                              std::vector<SortRegister>&& sortRegister,
                              arangodb::transaction::Methods* trx,
-                             GatherNode::SortMode sortMode);
+                             GatherNode::SortMode sortMode, size_t limit);
   SortingGatherExecutorInfos() = delete;
   SortingGatherExecutorInfos(SortingGatherExecutorInfos&&);
   SortingGatherExecutorInfos(SortingGatherExecutorInfos const&) = delete;
@@ -62,10 +62,13 @@ class SortingGatherExecutorInfos : public ExecutorInfos {
 
   GatherNode::SortMode sortMode() { return _sortMode; }
 
+  size_t limit() const noexcept { return _limit; }
+
  private:
   std::vector<SortRegister> _sortRegister;
   arangodb::transaction::Methods* _trx;
   GatherNode::SortMode _sortMode;
+  size_t _limit;
 };
 
 class SortingGatherExecutor {
@@ -123,6 +126,10 @@ class SortingGatherExecutor {
  private:
   ExecutionState init();
 
+  /// @brief number of rows to ask a dependency for. with a known limit,
+  /// there is no point in fetching more rows than can still be returned
+  size_t fetchSize() const noexcept;
+
  private:
   Fetcher& _fetcher;
 
@@ -144,6 +151,12 @@ class SortingGatherExecutor {
   /// @brief sorting strategy
   std::unique_ptr<SortingStrategy> _strategy;
 
+  /// @brief number of rows needed at most, 0 if unknown
+  size_t const _limit;
+
+  /// @brief number of rows returned so far
+  size_t _rowsReturned;
+
 #ifdef ARANGODB_ENABLE_MAINTAINER_MODE
   std::vector<bool> _flaggedAsDone;
 #endif
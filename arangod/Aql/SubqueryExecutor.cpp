@@ -23,6 +23,10 @@
 #include "ExecutionBlock.h"
 #include "SubqueryExecutor.h"
 
+#include "Aql/AqlItemBlockManager.h"
+#include "Aql/ConstFetcher.h"
+#include "Aql/ExecutionBlockImpl.h"
+#include "Aql/IdExecutor.h"
 #include "Aql/OutputAqlItemRow.h"
 #include "Aql/SingleRowFetcher.h"
 
@@ -41,7 +45,22 @@ SubqueryExecutorInfos::SubqueryExecutorInfos(
       _subQuery(subQuery),
       _outReg(outReg),
       _returnsData(subQuery.getPlanNode()->getType() == ExecutionNode::RETURN),
-      _isConst(subqueryIsConst) {}
+      _isConst(subqueryIsConst),
+      _itemBlockManager(nullptr),
+      _batchSingleton(nullptr),
+      _batchResults(nullptr),
+      _returnReg(0) {}
+
+void SubqueryExecutorInfos::runBatched(AqlItemBlockManager& itemBlockManager,
+                                       ExecutionBlockImpl<IdExecutor<ConstFetcher>>& singleton,
+                                       ExecutionBlock& results, RegisterId returnRegister) {
+  TRI_ASSERT(_returnsData);
+  TRI_ASSERT(!_isConst);
+  _itemBlockManager = &itemBlockManager;
+  _batchSingleton = &singleton;
+  _batchResults = &results;
+  _returnReg = returnRegister;
+}
 
 SubqueryExecutorInfos::SubqueryExecutorInfos(SubqueryExecutorInfos&& other) = default;
 
@@ -57,7 +76,9 @@ SubqueryExecutor<isModificationSubquery>::SubqueryExecutor(Fetcher& fetcher, Sub
       _shutdownResult(TRI_ERROR_INTERNAL),
       _subquery(infos.getSubquery()),
       _subqueryResults(nullptr),
-      _input(CreateInvalidInputRowHint{}) {}
+      _input(CreateInvalidInputRowHint{}),
+      _batchDone(false),
+      _batchPosition(0) {}
 
 template<bool isModificationSubquery>
 SubqueryExecutor<isModificationSubquery>::~SubqueryExecutor() = default;
@@ -71,6 +92,9 @@ SubqueryExecutor<isModificationSubquery>::~SubqueryExecutor() = default;
 
 template<bool isModificationSubquery>
 std::pair<ExecutionState, NoStats> SubqueryExecutor<isModificationSubquery>::produceRows(OutputAqlItemRow& output) {
+  if (_infos.runsBatched()) {
+    return produceRowsBatched(output);
+  }
   if (_state == ExecutionState::DONE && !_input.isInitialized()) {
     // We have seen DONE upstream, and we have discarded our local reference
     // to the last input, we will not be able to produce results anymore.
@@ -175,6 +199,190 @@ void SubqueryExecutor<isModificationSubquery>::writeOutput(OutputAqlItemRow& out
   TRI_ASSERT(output.produced());
 }
 
+/**
+ * Batched variant: all remaining rows of the input block are fetched, which
+ * cannot wait as the block is passed through, and fed into the subquery at
+ * once. Its results are collected per outer row, and then written one row
+ * after the other.
+ */
+template<bool isModificationSubquery>
+std::pair<ExecutionState, NoStats> SubqueryExecutor<isModificationSubquery>::produceRowsBatched(
+    OutputAqlItemRow& output) {
+  while (true) {
+    if (_subqueryInitialized) {
+      auto res = _infos.batchResults().getSome(ExecutionBlock::DefaultBatchSize());
+      if (res.first == ExecutionState::WAITING) {
+        TRI_ASSERT(res.second == nullptr);
+        return {res.first, NoStats{}};
+      }
+      if (res.second != nullptr) {
+        TRI_IF_FAILURE("SubqueryBlock::executeSubquery") {
+          THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+        }
+        distributeResults(*res.second);
+      }
+      if (res.first == ExecutionState::DONE) {
+        _subqueryInitialized = false;
+        _batchDone = true;
+      }
+      continue;
+    }
+
+    if (_batchDone) {
+      writeBatchOutput(output);
+      if (_batchPosition < _batch.size()) {
+        return {ExecutionState::HASMORE, NoStats{}};
+      }
+      _batch.clear();
+      _batchResults.clear();
+      _batchDone = false;
+      _batchPosition = 0;
+      return {_state, NoStats{}};
+    }
+
+    if (_batch.empty()) {
+      if (_state == ExecutionState::DONE) {
+        return {_state, NoStats{}};
+      }
+      InputAqlItemRow input{CreateInvalidInputRowHint{}};
+      do {
+        std::tie(_state, input) = _fetcher.fetchRow();
+        if (_state == ExecutionState::WAITING) {
+          TRI_ASSERT(_batch.empty());
+          return {_state, NoStats{}};
+        }
+        if (!input) {
+          TRI_ASSERT(_state == ExecutionState::DONE);
+          break;
+        }
+        _batch.emplace_back(input);
+      } while (_state != ExecutionState::DONE && input.blockHasMoreRows());
+
+      if (_batch.empty()) {
+        return {_state, NoStats{}};
+      }
+    }
+
+    auto initRes = _subquery.initializeCursor(_batch.front());
+    if (initRes.first == ExecutionState::WAITING) {
+      return {ExecutionState::WAITING, NoStats{}};
+    }
+    if (initRes.second.fail()) {
+      THROW_ARANGO_EXCEPTION(initRes.second);
+    }
+    // replaces the single row the singleton was initialized with
+    _infos.batchSingleton().injectConstBlock(batchBlock());
+
+    _batchResults.clear();
+    _batchResults.reserve(_batch.size());
+    for (size_t i = 0; i < _batch.size(); ++i) {
+      _batchResults.emplace_back(std::make_unique<std::vector<SharedAqlItemBlockPtr>>());
+    }
+    _subqueryInitialized = true;
+  }
+}
+
+template<bool isModificationSubquery>
+SharedAqlItemBlockPtr SubqueryExecutor<isModificationSubquery>::batchBlock() const {
+  auto const& singletonInfos = _infos.batchSingleton().infos();
+  auto const& registers = *singletonInfos.registersToKeep();
+  RegisterId const rowRegister = _infos.outputRegister();
+
+  SharedAqlItemBlockPtr block =
+      _infos.itemBlockManager().requestBlock(_batch.size(),
+                                             singletonInfos.numberOfOutputRegisters());
+  // values shared by several rows are cloned only once
+  std::unordered_map<AqlValue, AqlValue> cache;
+
+  for (size_t row = 0; row < _batch.size(); ++row) {
+    InputAqlItemRow const& input = _batch[row];
+    for (auto const col : registers) {
+      if (col == rowRegister || col >= input.getNrRegisters()) {
+        continue;
+      }
+      AqlValue const& a = input.getValue(col);
+      if (a.isEmpty()) {
+        continue;
+      }
+      if (!a.requiresDestruction()) {
+        block->setValue(row, col, a);
+        continue;
+      }
+      auto it = cache.find(a);
+      if (it == cache.end()) {
+        AqlValue b = a.clone();
+        try {
+          block->setValue(row, col, b);
+        } catch (...) {
+          b.destroy();
+          throw;
+        }
+        cache.emplace(a, b);
+      } else {
+        block->setValue(row, col, it->second);
+      }
+    }
+    block->emplaceValue(row, rowRegister, AqlValueHintUInt(row));
+  }
+  return block;
+}
+
+template<bool isModificationSubquery>
+void SubqueryExecutor<isModificationSubquery>::distributeResults(AqlItemBlock& block) {
+  RegisterId const rowRegister = _infos.outputRegister();
+  RegisterId const returnRegister = _infos.returnRegister();
+  size_t const n = block.size();
+
+  size_t from = 0;
+  while (from < n) {
+    // the rows of one outer row are contiguous
+    auto const index = static_cast<size_t>(block.getValueReference(from, rowRegister).toInt64());
+    TRI_ASSERT(index < _batchResults.size());
+    size_t to = from + 1;
+    while (to < n &&
+           static_cast<size_t>(block.getValueReference(to, rowRegister).toInt64()) == index) {
+      ++to;
+    }
+
+    SharedAqlItemBlockPtr result = _infos.itemBlockManager().requestBlock(to - from, 1);
+    for (size_t row = from; row < to; ++row) {
+      AqlValue const& a = block.getValueReference(row, returnRegister);
+      AqlValue value = a;
+      if (a.requiresDestruction()) {
+        if (block.valueCount(a) > 0) {
+          // taken over, like RETURN does
+          block.steal(a);
+        } else {
+          // another row has taken it over already
+          value = a.clone();
+        }
+      }
+      AqlValueGuard guard{value, true};
+      result->setValue(row - from, 0, value);
+      guard.steal();
+    }
+    _batchResults[index]->emplace_back(std::move(result));
+    from = to;
+  }
+}
+
+template<bool isModificationSubquery>
+void SubqueryExecutor<isModificationSubquery>::writeBatchOutput(OutputAqlItemRow& output) {
+  TRI_ASSERT(_batchPosition < _batch.size());
+  TRI_IF_FAILURE("SubqueryBlock::getSome") {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+  }
+  auto& results = _batchResults[_batchPosition];
+  TRI_ASSERT(results != nullptr);
+  AqlValue resultDocVec{results.get()};
+  AqlValueGuard guard{resultDocVec, true};
+  // Responsibility is handed over
+  results.release();
+  output.moveValueInto(_infos.outputRegister(), _batch[_batchPosition], guard);
+  ++_batchPosition;
+  TRI_ASSERT(output.produced());
+}
+
 /// @brief shutdown, tell dependency and the subquery
 template<bool isModificationSubquery>
 std::pair<ExecutionState, Result> SubqueryExecutor<isModificationSubquery>::shutdown(int errorCode) {
@@ -31,6 +31,12 @@
 namespace arangodb {
 namespace aql {
 
+class AqlItemBlockManager;
+class ConstFetcher;
+template <class Executor>
+class ExecutionBlockImpl;
+template <class T>
+class IdExecutor;
 class NoStats;
 class OutputAqlItemRow;
 template <bool>
@@ -55,11 +61,34 @@ class SubqueryExecutorInfos : public ExecutorInfos {
   inline RegisterId outputRegister() const { return _outReg; }
   inline bool isConst() const { return _isConst; }
 
+  /// @brief run the subquery once for all rows of an input block. the rows
+  /// are injected into its singleton, with the index of each row in the
+  /// output register, and its results are read from the block before the
+  /// RETURN, whose value is in returnRegister
+  void runBatched(AqlItemBlockManager& itemBlockManager,
+                  ExecutionBlockImpl<IdExecutor<ConstFetcher>>& singleton,
+                  ExecutionBlock& results, RegisterId returnRegister);
+
+  inline bool runsBatched() const { return _batchSingleton != nullptr; }
+  inline AqlItemBlockManager& itemBlockManager() const {
+    return *_itemBlockManager;
+  }
+  inline ExecutionBlockImpl<IdExecutor<ConstFetcher>>& batchSingleton() const {
+    return *_batchSingleton;
+  }
+  inline ExecutionBlock& batchResults() const { return *_batchResults; }
+  inline RegisterId returnRegister() const { return _returnReg; }
+
  private:
   ExecutionBlock& _subQuery;
   RegisterId const _outReg;
   bool const _returnsData;
   bool const _isConst;
+
+  AqlItemBlockManager* _itemBlockManager;
+  ExecutionBlockImpl<IdExecutor<ConstFetcher>>* _batchSingleton;
+  ExecutionBlock* _batchResults;
+  RegisterId _returnReg;
 };
 
 template<bool isModificationSubquery>
@@ -108,6 +137,16 @@ class SubqueryExecutor {
    */
   void writeOutput(OutputAqlItemRow& output);
 
+  std::pair<ExecutionState, NoStats> produceRowsBatched(OutputAqlItemRow& output);
+
+  /// @brief the rows of the batch as the input of the subquery
+  SharedAqlItemBlockPtr batchBlock() const;
+
+  /// @brief sorts the rows the subquery produced by the outer row
+  void distributeResults(AqlItemBlock& block);
+
+  void writeBatchOutput(OutputAqlItemRow& output);
+
  private:
   Fetcher& _fetcher;
   SubqueryExecutorInfos& _infos;
@@ -132,6 +171,17 @@ class SubqueryExecutor {
 
   // Cache for the input row we are currently working on
   InputAqlItemRow _input;
+
+  // The rest of the input block when running batched, and the results of
+  // the subquery for each of its rows
+  std::vector<InputAqlItemRow> _batch;
+  std::vector<std::unique_ptr<std::vector<SharedAqlItemBlockPtr>>> _batchResults;
+
+  // Flag if the subquery has produced all results of the batch
+  bool _batchDone;
+
+  // Next row of the batch to write
+  size_t _batchPosition;
 };
 }  // namespace aql
 }  // namespace arangodb
@@ -29,6 +29,7 @@
 #include "Basics/ReadLocker.h"
 #include "Basics/VelocyPackHelper.h"
 #include "Basics/WriteLocker.h"
+#include "Basics/fasthash.h"
 #include "Basics/tri-strings.h"
 #include "Cluster/ServerState.h"
 #include "GeneralServer/AuthenticationFeature.h"
@@ -49,8 +50,7 @@ auth::TokenCache::TokenCache(auth::UserManager* um, double timeout)
     : _userManager(um),
       _authTimeout(timeout),
       _basicCacheVersion(0),
-      _jwtSecret(""),
-      _jwtCache(16384) {}
+      _jwtSecret("") {}
 
 auth::TokenCache::~TokenCache() {
   // properly clear structs while using the appropriate locks
@@ -58,10 +58,7 @@ auth::TokenCache::~TokenCache() {
     WRITE_LOCKER(readLocker, _basicLock);
     _basicCache.clear();
   }
-  {
-    WRITE_LOCKER(writeLocker, _jwtLock);
-    _jwtCache.clear();
-  }
+  clearJwtCache();
 }
 
 void auth::TokenCache::setJwtSecret(std::string const& jwtSecret) {
@@ -69,7 +66,7 @@ void auth::TokenCache::setJwtSecret(std::string const& jwtSecret) {
   LOG_TOPIC("71a76", DEBUG, Logger::AUTHENTICATION)
       << "Setting jwt secret of size " << jwtSecret.size();
   _jwtSecret = jwtSecret;
-  _jwtCache.clear();
+  clearJwtCache();
   generateJwtToken();
 }
 
@@ -169,27 +166,48 @@ auth::TokenCache::Entry auth::TokenCache::checkAuthenticationBasic(std::string c
   return entry;
 }
 
+void auth::TokenCache::clearJwtCache() {
+  for (auto& shard : _jwtCache) {
+    WRITE_LOCKER(writeLocker, shard.lock);
+    shard.entries.clear();
+  }
+}
+
 auth::TokenCache::Entry auth::TokenCache::checkAuthenticationJWT(std::string const& jwt) {
-  // note that we need the write lock here because it is an LRU
-  // cache. reading from it will move the read entry to the start of
-  // the cache's linked list. so acquiring just a read-lock is
-  // insufficient!!
+  uint64_t const hash = fasthash64(jwt.data(), jwt.size(), 0xdeadbeef);
+  JwtCacheShard& shard = _jwtCache[hash % numJwtCacheShards];
+
   {
-    WRITE_LOCKER(writeLocker, _jwtLock);
-    // intentionally copy the entry from the cache
-    auth::TokenCache::Entry const* entry = _jwtCache.get(jwt);
-    if (entry != nullptr) {
-      // would have thrown if not found
-      if (entry->expired()) {
-        _jwtCache.remove(jwt);
-        LOG_TOPIC("65e15", TRACE, Logger::AUTHENTICATION) << "JWT Token expired";
-        return auth::TokenCache::Entry::Unauthenticated();
+    bool expired = false;
+    {
+      READ_LOCKER(readLocker, shard.lock);
+      auto it = shard.entries.find(hash);
+      if (it != shard.entries.end() && it->second.first == jwt) {
+        if (!it->second.second.expired()) {
+          // intentionally copy the entry from the cache
+          auth::TokenCache::Entry entry = it->second.second;
+          readLocker.unlock();
+          if (_userManager != nullptr) {
+            // LDAP rights might need to be refreshed
+            _userManager->refreshUser(entry.username());
+          }
+          return entry;
+        }
+        expired = true;
       }
-      if (_userManager != nullptr) {
-        // LDAP rights might need to be refreshed
-        _userManager->refreshUser(entry->username());
+    }
+
+    if (expired) {
+      // expired entries are only removed when they are looked up again,
+      // or when their shard is full
+      WRITE_LOCKER(writeLocker, shard.lock);
+      auto it = shard.entries.find(hash);
+      if (it != shard.entries.end() && it->second.first == jwt &&
+          it->second.second.expired()) {
+        shard.entries.erase(it);
       }
-      return *entry;
+      LOG_TOPIC("65e15", TRACE, Logger::AUTHENTICATION) << "JWT Token expired";
+      return auth::TokenCache::Entry::Unauthenticated();
     }
   }
   std::vector<std::string> const parts = StringUtils::split(jwt, '.');
@@ -223,8 +241,27 @@ auth::TokenCache::Entry auth::TokenCache::checkAuthenticationJWT(std::string con
     return auth::TokenCache::Entry::Unauthenticated();
   }
 
-  WRITE_LOCKER(writeLocker, _jwtLock);
-  _jwtCache.put(jwt, newEntry);
+  WRITE_LOCKER(writeLocker, shard.lock);
+  if (shard.entries.size() >= maxJwtCacheShardSize &&
+      shard.entries.find(hash) == shard.entries.end()) {
+    // make room, preferably by dropping expired tokens
+    for (auto it = shard.entries.begin(); it != shard.entries.end();) {
+      if (it->second.second.expired()) {
+        it = shard.entries.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    if (shard.entries.size() >= maxJwtCacheShardSize) {
+      shard.entries.erase(shard.entries.begin());
+    }
+  }
+  auto result = shard.entries.emplace(hash, std::make_pair(jwt, newEntry));
+  if (!result.second) {
+    // the same token was added concurrently, or a different token has
+    // the same hash
+    result.first->second = std::make_pair(jwt, newEntry);
+  }
   return newEntry;
 }
 
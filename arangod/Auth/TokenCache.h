@@ -25,9 +25,9 @@
 #define ARANGOD_AUTHENTICATION_TOKEN_CACHE_H 1
 
 #include "Basics/Common.h"
-#include "Basics/LruCache.h"
 #include "Basics/Mutex.h"
 #include "Basics/ReadWriteLock.h"
+#include "Basics/ReadWriteSpinLock.h"
 #include "Basics/Result.h"
 #include "Rest/CommonDefines.h"
 
@@ -108,7 +108,22 @@ class TokenCache {
   /// generate new _jwtToken
   void generateJwtToken();
 
+  /// Remove all entries from the JWT cache
+  void clearJwtCache();
+
  private:
+  /// part of the JWT cache. tokens are distributed over the parts by their
+  /// hash, so that requests with different tokens do not contend
+  struct JwtCacheShard {
+    mutable arangodb::basics::ReadWriteSpinLock lock;
+    /// token hash => (token, entry)
+    std::unordered_map<uint64_t, std::pair<std::string, TokenCache::Entry>> entries;
+  };
+
+  static constexpr size_t numJwtCacheShards = 16;
+  /// maximum number of tokens cached in each shard
+  static constexpr size_t maxJwtCacheShardSize = 1024;
+
   auth::UserManager* const _userManager;
   /// Timeout in seconds
   double const _authTimeout;
@@ -121,7 +136,7 @@ class TokenCache {
   std::string _jwtToken;
 
   mutable arangodb::basics::ReadWriteLock _jwtLock;
-  arangodb::basics::LruCache<std::string, TokenCache::Entry> _jwtCache;
+  JwtCacheShard _jwtCache[numJwtCacheShards];
 };
 }  // namespace auth
 }  // namespace arangodb
@@ -24,7 +24,7 @@
 #include "Cache/Cache.h"
 #include "Basics/Common.h"
 #include "Basics/SharedPRNG.h"
-#include "Basics/fasthash.h"
+#include "Basics/hashes.h"
 #include "Cache/CachedValue.h"
 #include "Cache/Common.h"
 #include "Cache/Manager.h"
@@ -57,6 +57,10 @@ Cache::Cache(ConstructionGuard guard, Manager* manager, uint64_t id,
       _findStats(nullptr),
       _findHits(),
       _findMisses(),
+      _admission(nullptr),
+      _ghostEntries(0),
+      _ghostBytes(0),
+      _ghostHits(0),
       _manager(manager),
       _id(id),
       _metadata(std::move(metadata)),
@@ -68,8 +72,12 @@ Cache::Cache(ConstructionGuard guard, Manager* manager, uint64_t id,
       _insertEvictions(),
       _migrateRequestTime(std::chrono::steady_clock::now().time_since_epoch().count()),
       _resizeRequestTime(std::chrono::steady_clock::now().time_since_epoch().count()) {
+  for (auto& ghost : _ghosts) {
+    ghost.store(0, std::memory_order_relaxed);
+  }
   _tableShrdPtr->setTypeSpecifics(_bucketClearer, _slotsPerBucket);
   _tableShrdPtr->enable();
+  resizeAdmission(_tableShrdPtr->size());
   if (_enableWindowedStats) {
     try {
       _findStats.reset(new StatBuffer(_findStatsCapacity));
@@ -167,6 +175,21 @@ std::pair<double, double> Cache::hitRates() {
   return std::pair<double, double>(lifetimeRate, windowedRate);
 }
 
+double Cache::marginalUtility() const {
+  uint64_t entries = _ghostEntries.load(std::memory_order_relaxed);
+  uint64_t bytes = _ghostBytes.load(std::memory_order_relaxed);
+  uint64_t hits = _ghostHits.load(std::memory_order_relaxed);
+  if (entries == 0 || bytes == 0 || hits == 0) {
+    return 0.0;
+  }
+
+  // the ghost slots hold at most the latest _ghostSlots sampled evictions.
+  // hits and evictions are sampled alike, so the sampling rate cancels out
+  double covered = static_cast<double>(std::min<uint64_t>(entries, _ghostSlots)) *
+                   (static_cast<double>(bytes) / static_cast<double>(entries));
+  return static_cast<double>(hits) / covered;
+}
+
 bool Cache::isResizing() {
   if (isShutdown()) {
     return false;
@@ -274,7 +297,73 @@ bool Cache::reclaimMemory(uint64_t size) {
 }
 
 uint32_t Cache::hashKey(void const* key, size_t keySize) const {
-  return (std::max)(static_cast<uint32_t>(1), fasthash32(key, keySize, 0xdeadbeefUL));
+  // the hashes only live in memory, so the fastest hash function can be used
+  return (std::max)(static_cast<uint32_t>(1),
+                    static_cast<uint32_t>(TRI_Xxh3Hash64(key, keySize, 0xdeadbeefUL)));
+}
+
+void Cache::recordAccess(uint32_t hash) {
+  _admission.load(std::memory_order_acquire)->insertRecord(hash);
+}
+
+bool Cache::admitInsert(uint32_t hash, uint32_t victimHash) const {
+  FrequencySketch const* admission = _admission.load(std::memory_order_acquire);
+  // ties are admitted, so that a cache without any repeated accesses still
+  // behaves like a plain LRU cache
+  return admission->estimate(hash) >= admission->estimate(victimHash);
+}
+
+void Cache::resizeAdmission(uint64_t tableSize) {
+  // one counter per slot, so that the sketch can tell apart about as many
+  // keys as the table holds
+  size_t width = FrequencySketch::normalizedWidth(static_cast<size_t>(
+      (std::min)(tableSize * _slotsPerBucket, static_cast<uint64_t>(65536))));
+  FrequencySketch* current = _admission.load(std::memory_order_relaxed);
+  if (current != nullptr && current->width() == width) {
+    return;
+  }
+
+  for (auto const& sketch : _admissionSketches) {
+    if (sketch->width() == width) {
+      _admission.store(sketch.get(), std::memory_order_release);
+      return;
+    }
+  }
+  _admissionSketches.emplace_back(std::make_unique<FrequencySketch>(width));
+  _admission.store(_admissionSketches.back().get(), std::memory_order_release);
+}
+
+void Cache::recordEviction(CachedValue const* victim, uint32_t hash) {
+  TRI_ASSERT(victim != nullptr);
+  if ((hash & _ghostSampleMask) != 0) {
+    return;
+  }
+
+  _ghosts[(hash >> 3) & (_ghostSlots - 1)].store(hash, std::memory_order_relaxed);
+  _ghostEntries.fetch_add(1, std::memory_order_relaxed);
+  _ghostBytes.fetch_add(victim->size(), std::memory_order_relaxed);
+}
+
+void Cache::recordMiss(uint32_t hash) {
+  if ((hash & _ghostSampleMask) != 0) {
+    return;
+  }
+
+  // a ghost entry only counts once, the key is inserted again after the miss
+  uint32_t expected = hash;
+  if (_ghosts[(hash >> 3) & (_ghostSlots - 1)].compare_exchange_strong(
+          expected, 0, std::memory_order_relaxed)) {
+    _ghostHits.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void Cache::ageGhostStats() {
+  _ghostEntries.fetch_sub(_ghostEntries.load(std::memory_order_relaxed) / 2,
+                          std::memory_order_relaxed);
+  _ghostBytes.fetch_sub(_ghostBytes.load(std::memory_order_relaxed) / 2,
+                        std::memory_order_relaxed);
+  _ghostHits.fetch_sub(_ghostHits.load(std::memory_order_relaxed) / 2,
+                       std::memory_order_relaxed);
 }
 
 void Cache::recordStat(Stat stat) {
@@ -408,6 +497,7 @@ bool Cache::freeMemory() {
 
   bool underLimit = reclaimMemory(0ULL);
   uint64_t failures = 0;
+  uint64_t freed = 0;
   while (!underLimit) {
     // pick a random bucket
     uint32_t randomHash = RandomGenerator::interval(UINT32_MAX);
@@ -416,6 +506,11 @@ bool Cache::freeMemory() {
     if (reclaimed > 0) {
       failures = 0;
       underLimit = reclaimMemory(reclaimed);
+      // pace large shrinks, so that they do not keep the buckets locked
+      // away from the regular operations for long stretches
+      if ((++freed & _freeMemoryBatchMask) == 0 && !underLimit) {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+      }
     } else {
       failures++;
       if (failures > 100) {
@@ -452,6 +547,7 @@ bool Cache::migrate(std::shared_ptr<Table> newTable) {
   _taskLock.writeLock();
   _table.store(newTable.get(), std::memory_order_relaxed);
   std::shared_ptr<Table> oldTable = std::atomic_exchange(&_tableShrdPtr, newTable);
+  resizeAdmission(newTable->size());
   std::shared_ptr<Table> confirm =
       oldTable->setAuxiliary(std::shared_ptr<Table>(nullptr));
   _taskLock.writeUnlock();
@@ -32,14 +32,17 @@
 #include "Cache/Common.h"
 #include "Cache/Finding.h"
 #include "Cache/FrequencyBuffer.h"
+#include "Cache/FrequencySketch.h"
 #include "Cache/Manager.h"
 #include "Cache/ManagerTasks.h"
 #include "Cache/Metadata.h"
 #include "Cache/Table.h"
 
 #include <stdint.h>
+#include <atomic>
 #include <list>
 #include <memory>
+#include <vector>
 
 namespace arangodb {
 namespace cache {
@@ -82,6 +85,7 @@ class Cache : public std::enable_shared_from_this<Cache> {
   virtual Result insert(CachedValue* value) = 0;
   virtual Result remove(void const* key, uint32_t keySize) = 0;
   virtual Result blacklist(void const* key, uint32_t keySize) = 0;
+  virtual std::vector<std::string> hotKeys(size_t maxKeys) = 0;
 
   //////////////////////////////////////////////////////////////////////////////
   /// @brief Returns the ID for this cache.
@@ -121,6 +125,17 @@ class Cache : public std::enable_shared_from_this<Cache> {
   //////////////////////////////////////////////////////////////////////////////
   std::pair<double, double> hitRates();
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Returns the estimated hit-rate gain per byte of additional memory.
+  ///
+  /// The estimate is based on ghost entries, which remember a sample of
+  /// recently evicted keys. A miss on a ghost entry would have been a hit if
+  /// the cache had been larger. The value is the number of such misses in the
+  /// recent past, divided by the memory the ghost entries stand for. It is 0
+  /// if the cache has not evicted anything it was asked for again.
+  //////////////////////////////////////////////////////////////////////////////
+  double marginalUtility() const;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief Check whether the cache is currently in the process of resizing.
   //////////////////////////////////////////////////////////////////////////////
@@ -156,6 +171,23 @@ class Cache : public std::enable_shared_from_this<Cache> {
   mutable basics::SharedCounter<64> _findHits;
   mutable basics::SharedCounter<64> _findMisses;
 
+  // admission filter for inserts that would evict another entry, sized from
+  // the capacity of the current table. accesses are recorded without locking,
+  // so a sketch replaced on migration is kept until the cache is destroyed and
+  // reused if the table gets back to its size
+  std::vector<std::unique_ptr<FrequencySketch>> _admissionSketches;
+  std::atomic<FrequencySketch*> _admission;
+
+  // ghost entries: hashes of a sample of the recently evicted values, kept
+  // in a direct-mapped table. the sample is taken by hash, so that misses on
+  // the same keys are sampled as well
+  static constexpr uint32_t _ghostSampleMask = 7;  // every 8th hash
+  static constexpr size_t _ghostSlots = 1024;
+  std::atomic<uint32_t> _ghosts[_ghostSlots];
+  std::atomic<uint64_t> _ghostEntries;
+  std::atomic<uint64_t> _ghostBytes;
+  std::atomic<uint64_t> _ghostHits;
+
   // allow communication with manager
   Manager* _manager;
   uint64_t _id;
@@ -177,6 +209,9 @@ class Cache : public std::enable_shared_from_this<Cache> {
                                                           // evictions in past 4096
                                                           // inserts, migrate
 
+  // free memory in batches of 1024 values
+  static constexpr uint64_t _freeMemoryBatchMask = 1023;
+
   // times to wait until requesting is allowed again
   std::atomic<Manager::time_point::rep> _migrateRequestTime;
   std::atomic<Manager::time_point::rep> _resizeRequestTime;
@@ -199,8 +234,22 @@ class Cache : public std::enable_shared_from_this<Cache> {
   uint32_t hashKey(void const* key, size_t keySize) const;
   void recordStat(Stat stat);
 
+  // record an access to the given key hash for the admission filter
+  void recordAccess(uint32_t hash);
+  // check whether a new entry with the given hash may evict the victim
+  bool admitInsert(uint32_t hash, uint32_t victimHash) const;
+  // size the admission filter for a table with the given number of buckets
+  void resizeAdmission(uint64_t tableSize);
+
   bool reportInsert(bool hadEviction);
 
+  // remember an evicted value as a ghost entry, if its hash is sampled
+  void recordEviction(CachedValue const* victim, uint32_t hash);
+  // count a miss on a ghost entry
+  void recordMiss(uint32_t hash);
+  // halve the ghost statistics, so that the utility follows the workload
+  void ageGhostStats();
+
   // management
   Metadata* metadata();
   std::shared_ptr<Table> table() const;
@@ -58,7 +58,8 @@ CacheManagerFeature::CacheManagerFeature(application_features::ApplicationServer
                      ? static_cast<uint64_t>(
                            (TRI_PhysicalMemory - (static_cast<uint64_t>(2) << 30)) * 0.25)
                      : (256 << 20)),
-      _rebalancingInterval(static_cast<uint64_t>(2 * 1000 * 1000)) {
+      _rebalancingInterval(static_cast<uint64_t>(2 * 1000 * 1000)),
+      _useHugePages(false) {
   setOptional(true);
   startsAfter("BasicsPhase");
 }
@@ -75,6 +76,10 @@ void CacheManagerFeature::collectOptions(std::shared_ptr<options::ProgramOptions
   options->addOption("--cache.rebalancing-interval",
                      "microseconds between rebalancing attempts",
                      new UInt64Parameter(&_rebalancingInterval));
+
+  options->addOption("--cache.use-huge-pages",
+                     "back large cache tables with 2MB huge pages",
+                     new BooleanParameter(&_useHugePages));
 }
 
 void CacheManagerFeature::validateOptions(std::shared_ptr<options::ProgramOptions>) {
@@ -104,7 +109,7 @@ void CacheManagerFeature::start() {
     scheduler->queue(RequestLane::INTERNAL_LOW, fn);
     return true;
   };
-  _manager.reset(new Manager(postFn, _cacheSize));
+  _manager.reset(new Manager(postFn, _cacheSize, true, _useHugePages));
   MANAGER = _manager.get();
   _rebalancer.reset(new CacheRebalancerThread(_manager.get(), _rebalancingInterval));
   _rebalancer->start();
@@ -53,6 +53,7 @@ class CacheManagerFeature final : public application_features::ApplicationFeatur
   std::unique_ptr<CacheRebalancerThread> _rebalancer;
   uint64_t _cacheSize;
   uint64_t _rebalancingInterval;
+  bool _useHugePages;
 };
 
 }  // namespace arangodb
@@ -0,0 +1,148 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_CACHE_FREQUENCY_SKETCH_H
+#define ARANGODB_CACHE_FREQUENCY_SKETCH_H
+
+#include "Basics/Common.h"
+#include "Basics/SharedPRNG.h"
+
+#include <stdint.h>
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+namespace arangodb {
+namespace cache {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Lockless count-min sketch to estimate recent access frequencies of
+/// keys, identified by their hash.
+///
+/// Used as a TinyLFU-style admission filter: an insert that has to evict an
+/// existing entry is only let in if its key was accessed at least as often as
+/// the key of the victim. Counters saturate at 15 and are periodically halved,
+/// so the estimates reflect recent history only. Concurrent updates are not
+/// synchronized and may occasionally get lost, which is fine for estimates.
+////////////////////////////////////////////////////////////////////////////////
+class FrequencySketch {
+ public:
+  static constexpr size_t depth = 4;
+  static constexpr uint8_t maxCount = 15;
+
+ private:
+  size_t _width;
+  size_t _mask;
+  uint64_t _resetMask;
+  std::vector<std::atomic<uint8_t>> _counters;
+
+ private:
+  inline size_t slot(uint64_t mixed, size_t row) const noexcept {
+    return (row * _width) + (static_cast<size_t>(mixed >> (row * 16)) & _mask);
+  }
+
+  static inline uint64_t mix(uint32_t hash) noexcept {
+    return static_cast<uint64_t>(hash) * 0x9E3779B97F4A7C15ULL;
+  }
+
+ public:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Initialize with the given number of counters per row (at most
+  /// 65536).
+  //////////////////////////////////////////////////////////////////////////////
+  explicit FrequencySketch(size_t width)
+      : _width(normalizedWidth(width)),
+        _mask(_width - 1),
+        // age roughly every 8 * width recorded accesses
+        _resetMask(static_cast<uint64_t>(_width * 8) - 1),
+        _counters(_width * depth) {
+    for (auto& c : _counters) {
+      c.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Returns the number of counters per row that a sketch constructed
+  /// with the given width will use: the next power of two, at most 65536.
+  //////////////////////////////////////////////////////////////////////////////
+  static size_t normalizedWidth(size_t width) {
+    width = std::min(width, static_cast<size_t>(65536));
+    size_t i = 0;
+    for (; (static_cast<size_t>(1) << i) < width; i++) {
+    }
+    return (static_cast<size_t>(1) << i);
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Returns the number of counters per row.
+  //////////////////////////////////////////////////////////////////////////////
+  size_t width() const { return _width; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Reports the memory usage in bytes.
+  //////////////////////////////////////////////////////////////////////////////
+  size_t memoryUsage() const {
+    return (_counters.size() * sizeof(uint8_t)) + sizeof(FrequencySketch);
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Record an access to the key with the given hash.
+  //////////////////////////////////////////////////////////////////////////////
+  void insertRecord(uint32_t hash) {
+    uint64_t mixed = mix(hash);
+    for (size_t row = 0; row < depth; row++) {
+      auto& c = _counters[slot(mixed, row)];
+      uint8_t current = c.load(std::memory_order_relaxed);
+      if (current < maxCount) {
+        c.store(current + 1, std::memory_order_relaxed);
+      }
+    }
+
+    if ((basics::SharedPRNG::rand() & _resetMask) == 0) {
+      age();
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Return the estimated recent access frequency for the given hash.
+  //////////////////////////////////////////////////////////////////////////////
+  uint8_t estimate(uint32_t hash) const {
+    uint64_t mixed = mix(hash);
+    uint8_t result = maxCount;
+    for (size_t row = 0; row < depth; row++) {
+      result = std::min(result, _counters[slot(mixed, row)].load(std::memory_order_relaxed));
+    }
+    return result;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Halve all counters, so that old accesses lose weight.
+  //////////////////////////////////////////////////////////////////////////////
+  void age() {
+    for (auto& c : _counters) {
+      c.store(c.load(std::memory_order_relaxed) >> 1, std::memory_order_relaxed);
+    }
+  }
+};
+
+};  // end namespace cache
+};  // end namespace arangodb
+
+#endif
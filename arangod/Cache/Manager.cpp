@@ -40,10 +40,12 @@
 #include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <map>
 #include <memory>
 #include <set>
 #include <stack>
 #include <utility>
+#include <vector>
 
 using namespace arangodb::cache;
 
@@ -53,8 +55,10 @@ const uint64_t Manager::minCacheAllocation =
     std::max(PlainCache::allocationSize(true), TransactionalCache::allocationSize(true)) +
     Manager::cacheRecordOverhead;
 const std::chrono::milliseconds Manager::rebalancingGracePeriod(10);
+const size_t Manager::maxResizesPerRebalance = 4;
 
-Manager::Manager(PostFn schedulerPost, uint64_t globalLimit, bool enableWindowedStats)
+Manager::Manager(PostFn schedulerPost, uint64_t globalLimit,
+                 bool enableWindowedStats, bool useHugePages)
     : _lock(),
       _shutdown(false),
       _shuttingDown(false),
@@ -69,6 +73,7 @@ Manager::Manager(PostFn schedulerPost, uint64_t globalLimit, bool enableWindowed
       _findMisses(),
       _caches(),
       _nextCacheId(1),
+      _useHugePages(useHugePages),
       _globalSoftLimit(globalLimit),
       _globalHardLimit(globalLimit),
       _globalHighwaterMark(static_cast<uint64_t>(
@@ -384,8 +389,9 @@ std::pair<bool, Manager::time_point> Manager::requestMigrate(Cache* cache, uint3
 
       allowed = !metadata->isMigrating();
       if (allowed) {
-        if (metadata->tableSize < Table::allocationSize(requestedLogSize)) {
-          uint64_t increase = Table::allocationSize(requestedLogSize) - metadata->tableSize;
+        uint64_t requestedSize = Table::allocationSize(requestedLogSize, _useHugePages);
+        if (metadata->tableSize < requestedSize) {
+          uint64_t increase = requestedSize - metadata->tableSize;
           if ((metadata->allocatedSize + increase >= metadata->deservedSize) &&
               pastRebalancingGracePeriod()) {
             if (increaseAllowed(increase)) {
@@ -403,7 +409,8 @@ std::pair<bool, Manager::time_point> Manager::requestMigrate(Cache* cache, uint3
 
       if (allowed) {
         // first find out if cache is allowed to migrate
-        allowed = metadata->migrationAllowed(Table::allocationSize(requestedLogSize));
+        allowed = metadata->migrationAllowed(
+            Table::allocationSize(requestedLogSize, _useHugePages));
       }
       if (allowed) {
         // now find out if we can lease the table
@@ -555,6 +562,10 @@ int Manager::rebalance(bool onlyCalculate) {
   }
 
   if (!onlyCalculate) {
+    for (auto const& it : _caches) {
+      it.second->ageGhostStats();
+    }
+
     if (_globalAllocation >= _globalHighwaterMark * 0.7) {
       shrinkOvergrownCaches(TaskEnvironment::rebalancing);
     }
@@ -572,6 +583,7 @@ int Manager::rebalance(bool onlyCalculate) {
 
 void Manager::shrinkOvergrownCaches(Manager::TaskEnvironment environment) {
   TRI_ASSERT(_lock.isWriteLocked());
+  std::vector<std::pair<Cache*, uint64_t>> overgrown;
   for (auto it : _caches) {
     std::shared_ptr<Cache>& cache = it.second;
     // skip this cache if it is already resizing or shutdown!
@@ -580,10 +592,32 @@ void Manager::shrinkOvergrownCaches(Manager::TaskEnvironment environment) {
     }
 
     Metadata* metadata = cache->metadata();
+    metadata->readLock();
+    if (metadata->allocatedSize > metadata->deservedSize) {
+      overgrown.emplace_back(cache.get(), metadata->allocatedSize - metadata->deservedSize);
+    }
+    metadata->readUnlock();
+  }
+
+  // a rebalancing round only shrinks the most overgrown caches, the others
+  // follow in the next rounds. this keeps the memory freeing tasks from
+  // competing with the regular operations all at once
+  if (environment == TaskEnvironment::rebalancing &&
+      overgrown.size() > Manager::maxResizesPerRebalance) {
+    std::partial_sort(overgrown.begin(),
+                      overgrown.begin() + Manager::maxResizesPerRebalance,
+                      overgrown.end(), [](auto const& a, auto const& b) {
+                        return a.second > b.second;
+                      });
+    overgrown.resize(Manager::maxResizesPerRebalance);
+  }
+
+  for (auto const& it : overgrown) {
+    Metadata* metadata = it.first->metadata();
     metadata->writeLock();
 
     if (metadata->allocatedSize > metadata->deservedSize) {
-      resizeCache(environment, cache.get(),
+      resizeCache(environment, it.first,
                   metadata->newLimit());  // unlocks metadata
     } else {
       metadata->writeUnlock();
@@ -675,9 +709,9 @@ std::shared_ptr<Table> Manager::leaseTable(uint32_t logSize) {
 
   std::shared_ptr<Table> table(nullptr);
   if (_tables[logSize].empty()) {
-    if (increaseAllowed(Table::allocationSize(logSize), true)) {
+    if (increaseAllowed(Table::allocationSize(logSize, _useHugePages), true)) {
       try {
-        table = std::make_shared<Table>(logSize);
+        table = std::make_shared<Table>(logSize, _useHugePages);
         _globalAllocation += table->memoryUsage();
       } catch (std::bad_alloc const&) {
         table.reset();
@@ -769,6 +803,18 @@ std::shared_ptr<Manager::PriorityList> Manager::priorityList() {
   }
   totalAccesses = std::max(static_cast<uint64_t>(1), totalAccesses);
 
+  // the hit-rate gain per byte each cache would get from more memory. if
+  // any cache would gain, the memory not bound by the current usage is split
+  // by these gains instead of by the access frequencies, so that a small but
+  // hot cache is not starved by a large one with little use for its memory
+  std::map<uint64_t, double> utilities;
+  double totalUtility = 0.0;
+  for (auto const& it : _caches) {
+    double utility = it.second->marginalUtility();
+    utilities.emplace(it.first, utility);
+    totalUtility += utility;
+  }
+
   double allocFrac = 0.8 * std::min(1.0, static_cast<double>(_globalAllocation) /
                                              static_cast<double>(_globalHighwaterMark));
   // calculate global data usage
@@ -777,18 +823,24 @@ std::shared_ptr<Manager::PriorityList> Manager::priorityList() {
   }
   globalUsage = std::max(globalUsage, static_cast<uint64_t>(1));  // avoid div-by-zero
 
+  double accessNormalizer =
+      ((1.0 - allocFrac) * remainingWeight) / static_cast<double>(totalAccesses);
+  double utilityNormalizer =
+      (totalUtility > 0.0) ? ((1.0 - allocFrac) * remainingWeight) / totalUtility : 0.0;
+
   // gather all unaccessed caches at beginning of list
   for (auto it = _caches.begin(); it != _caches.end(); it++) {
     std::shared_ptr<Cache>& cache = it->second;
     auto found = accessed.find(cache->id());
     if (found == accessed.end()) {
       double weight = baseWeight + (cache->usage() / globalUsage) * allocFrac;
+      if (totalUtility > 0.0) {
+        weight += utilities[cache->id()] * utilityNormalizer;
+      }
       list->emplace_back(cache, weight);
     }
   }
 
-  double accessNormalizer =
-      ((1.0 - allocFrac) * remainingWeight) / static_cast<double>(totalAccesses);
   double usageNormalizer = (allocFrac * remainingWeight) / static_cast<double>(globalUsage);
 
   // gather all accessed caches in order
@@ -796,7 +848,9 @@ std::shared_ptr<Manager::PriorityList> Manager::priorityList() {
     auto it = accessed.find(s.first);
     if (it != accessed.end()) {
       std::shared_ptr<Cache>& cache = _caches.find(s.first)->second;
-      double accessWeight = static_cast<double>(s.second) * accessNormalizer;
+      double accessWeight = (totalUtility > 0.0)
+                                ? utilities[cache->id()] * utilityNormalizer
+                                : static_cast<double>(s.second) * accessNormalizer;
       double usageWeight = static_cast<double>(cache->usage()) * usageNormalizer;
 
       TRI_ASSERT(accessWeight >= 0.0);
@@ -63,8 +63,8 @@ class Rebalancer;      // forward declaration
 ///
 /// The global limit may be adjusted, and compliance may be achieved through
 /// asynchronous background tasks. The manager periodically rebalances the
-/// allocations across the pool of caches to allow more frequently used ones to
-/// have more space.
+/// allocations across the pool of caches to give more space to the ones that
+/// gain the most hits from it, or else to the more frequently used ones.
 ///
 /// There should be a single Manager instance exposed via
 /// CacheManagerFeature::MANAGER --- use this unless you are very certain you
@@ -85,8 +85,11 @@ class Manager {
   //////////////////////////////////////////////////////////////////////////////
   /// @brief Initialize the manager with a scheduler post method and global
   /// usage limit.
+  ///
+  /// If useHugePages is true, large tables are backed by huge pages.
   //////////////////////////////////////////////////////////////////////////////
-  Manager(PostFn schedulerPost, uint64_t globalLimit, bool enableWindowedStats = true);
+  Manager(PostFn schedulerPost, uint64_t globalLimit,
+          bool enableWindowedStats = true, bool useHugePages = false);
   ~Manager();
 
   //////////////////////////////////////////////////////////////////////////////
@@ -193,6 +196,7 @@ class Manager {
 
   // actual tables to lease out
   std::stack<std::shared_ptr<Table>> _tables[32];
+  bool _useHugePages;
 
   // global statistics
   uint64_t _globalSoftLimit;
@@ -241,6 +245,8 @@ class Manager {
   static constexpr double highwaterMultiplier = 0.8;
   static const uint64_t minCacheAllocation;
   static const std::chrono::milliseconds rebalancingGracePeriod;
+  // number of caches a rebalancing round shrinks at most
+  static const size_t maxResizesPerRebalance;
 
   // check if shutdown or shutting down
   bool isOperational() const;
@@ -268,7 +274,7 @@ class Manager {
   // helpers for individual allocations
   bool increaseAllowed(uint64_t increase, bool privileged = false) const;
 
-  // helper for lr-accessed heuristics
+  // helper for lr-accessed and marginal utility heuristics
   std::shared_ptr<PriorityList> priorityList();
 
   // helper for wait times
@@ -73,7 +73,9 @@ CachedValue* PlainBucket::find(uint32_t hash, void const* key, size_t keySize, b
     }
     if (_cachedHashes[i] == hash && _cachedData[i]->sameKey(key, keySize)) {
       result = _cachedData[i];
-      if (moveToFront) {
+      // hot entries usually sit in the first slot already. skip the no-op
+      // move then, so that lookups of these do not store into the bucket
+      if (moveToFront && i != 0) {
         moveSlot(i, true);
       }
       break;
@@ -109,7 +111,7 @@ CachedValue* PlainBucket::remove(uint32_t hash, void const* key, size_t keySize)
   return value;
 }
 
-CachedValue* PlainBucket::evictionCandidate(bool ignoreRefCount) const {
+CachedValue* PlainBucket::evictionCandidate(bool ignoreRefCount, uint32_t* hash) const {
   TRI_ASSERT(isLocked());
   for (size_t i = 0; i < slotsData; i++) {
     size_t slot = slotsData - (i + 1);
@@ -117,6 +119,9 @@ CachedValue* PlainBucket::evictionCandidate(bool ignoreRefCount) const {
       continue;
     }
     if (ignoreRefCount || _cachedData[slot]->isFreeable()) {
+      if (hash != nullptr) {
+        *hash = _cachedHashes[slot];
+      }
       return _cachedData[slot];
     }
   }
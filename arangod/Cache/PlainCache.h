@@ -96,6 +96,15 @@ class PlainCache final : public Cache {
   //////////////////////////////////////////////////////////////////////////////
   Result blacklist(void const* key, uint32_t keySize) override;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Returns the keys of the most recently used entry of each bucket,
+  /// but at most maxKeys of them.
+  ///
+  /// Intended to take a cheap snapshot of the hot entries, e.g. to warm up a
+  /// cache after a restart. Buckets that cannot be locked quickly are skipped.
+  //////////////////////////////////////////////////////////////////////////////
+  std::vector<std::string> hotKeys(size_t maxKeys) override;
+
  private:
   // friend class manager and tasks
   friend class FreeMemoryTask;
@@ -27,8 +27,13 @@
 
 #include <stdint.h>
 #include <memory>
+#include <new>
 #include <stdexcept>
 
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
 using namespace arangodb::cache;
 
 const uint32_t Table::minLogSize = 8;
@@ -80,7 +85,7 @@ bool Table::Subtable::applyToAllBuckets(std::function<bool(void*)> cb) {
   return ok;
 }
 
-Table::Table(uint32_t logSize)
+Table::Table(uint32_t logSize, bool useHugePages)
     : _lock(),
       _disabled(true),
       _evictions(false),
@@ -88,9 +93,10 @@ Table::Table(uint32_t logSize)
       _size(static_cast<uint64_t>(1) << _logSize),
       _shift(32 - _logSize),
       _mask((uint32_t)((_size - 1) << _shift)),
-      _buffer(new uint8_t[(_size * BUCKET_SIZE) + Table::padding]),
+      _mappedSize(usesHugePages(_logSize, useHugePages) ? (_size * BUCKET_SIZE) : 0),
+      _buffer(allocateBuffer((_size * BUCKET_SIZE) + Table::padding, _mappedSize)),
       _buckets(reinterpret_cast<GenericBucket*>(
-          reinterpret_cast<uint64_t>((_buffer.get() + (BUCKET_SIZE - 1))) &
+          reinterpret_cast<uint64_t>((_buffer + (BUCKET_SIZE - 1))) &
           ~(static_cast<uint64_t>(BUCKET_SIZE - 1)))),
       _auxiliary(nullptr),
       _bucketClearer(defaultClearer),
@@ -109,13 +115,28 @@ Table::~Table() {
     // call dtor
     b->~GenericBucket();
   }
+#ifdef __linux__
+  if (_mappedSize > 0) {
+    ::munmap(_buffer, _mappedSize);
+    return;
+  }
+#endif
+  delete[] _buffer;
 }
 
-uint64_t Table::allocationSize(uint32_t logSize) {
-  return sizeof(Table) + (BUCKET_SIZE * (static_cast<uint64_t>(1) << logSize)) + Table::padding;
+uint64_t Table::allocationSize(uint32_t logSize, bool useHugePages) {
+  uint64_t bucketsSize = BUCKET_SIZE * (static_cast<uint64_t>(1) << logSize);
+  if (usesHugePages(logSize, useHugePages)) {
+    // the mapping is page-aligned and a whole multiple of the huge page size,
+    // so no alignment padding is needed
+    return sizeof(Table) + bucketsSize;
+  }
+  return sizeof(Table) + bucketsSize + Table::padding;
 }
 
-uint64_t Table::memoryUsage() const { return Table::allocationSize(_logSize); }
+uint64_t Table::memoryUsage() const {
+  return Table::allocationSize(_logSize, _mappedSize > 0);
+}
 
 uint64_t Table::size() const { return _size; }
 
@@ -287,3 +308,34 @@ uint32_t Table::idealSize() {
 void Table::defaultClearer(void* ptr) {
   throw std::invalid_argument("must register a clearer");
 }
+
+bool Table::usesHugePages(uint32_t logSize, bool useHugePages) {
+#ifdef __linux__
+  uint32_t effectiveLogSize = std::min(logSize, maxLogSize);
+  return useHugePages &&
+         (BUCKET_SIZE * (static_cast<uint64_t>(1) << effectiveLogSize)) >= hugePageSize;
+#else
+  return false;
+#endif
+}
+
+uint8_t* Table::allocateBuffer(uint64_t size, uint64_t mappedSize) {
+#ifdef __linux__
+  if (mappedSize > 0) {
+    void* p = ::mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (p == MAP_FAILED) {
+      // no reserved huge pages available, let the kernel back the mapping
+      // with transparent huge pages instead
+      p = ::mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if (p == MAP_FAILED) {
+        throw std::bad_alloc();
+      }
+      ::madvise(p, mappedSize, MADV_HUGEPAGE);
+    }
+    return static_cast<uint8_t*>(p);
+  }
+#endif
+  return new uint8_t[size];
+}
@@ -47,6 +47,7 @@ class Table : public std::enable_shared_from_this<Table> {
   static constexpr uint32_t standardLogSizeAdjustment = 6;
   static constexpr uint64_t triesGuarantee = UINT64_MAX;
   static constexpr uint64_t padding = BUCKET_SIZE;
+  static constexpr uint64_t hugePageSize = 2 * 1024 * 1024;
 
   typedef std::function<void(void*)> BucketClearer;
 
@@ -84,11 +85,17 @@ class Table : public std::enable_shared_from_this<Table> {
 
  public:
   Table() = delete;
+  Table(Table const&) = delete;
+  Table& operator=(Table const&) = delete;
 
   //////////////////////////////////////////////////////////////////////////////
   /// @brief Construct a new table of size 2^(logSize) in disabled state.
+  ///
+  /// If useHugePages is true and the bucket array spans at least one huge
+  /// page, the buckets are placed in an anonymous mapping backed by huge
+  /// pages (falling back to transparent huge pages if none are reserved).
   //////////////////////////////////////////////////////////////////////////////
-  explicit Table(uint32_t logSize);
+  explicit Table(uint32_t logSize, bool useHugePages = false);
 
   //////////////////////////////////////////////////////////////////////////////
   /// @brief Destroy the table
@@ -99,7 +106,7 @@ class Table : public std::enable_shared_from_this<Table> {
   //////////////////////////////////////////////////////////////////////////////
   /// @brief Returns the memory usage for a table with specified logSize
   //////////////////////////////////////////////////////////////////////////////
-  static uint64_t allocationSize(uint32_t logSize);
+  static uint64_t allocationSize(uint32_t logSize, bool useHugePages = false);
 
   //////////////////////////////////////////////////////////////////////////////
   /// @brief Returns the memory usage of the table.
@@ -204,7 +211,8 @@ class Table : public std::enable_shared_from_this<Table> {
   uint64_t _size;
   uint32_t _shift;
   uint32_t _mask;
-  std::unique_ptr<uint8_t[]> _buffer;
+  uint64_t _mappedSize;
+  uint8_t* _buffer;
   GenericBucket* _buckets;
 
   std::shared_ptr<Table> _auxiliary;
@@ -218,6 +226,8 @@ class Table : public std::enable_shared_from_this<Table> {
   void disable();
   bool isEnabled(uint64_t maxTries = triesGuarantee);
   static void defaultClearer(void* ptr);
+  static bool usesHugePages(uint32_t logSize, bool useHugePages);
+  static uint8_t* allocateBuffer(uint64_t size, uint64_t mappedSize);
 };
 
 };  // end namespace cache
@@ -81,7 +81,9 @@ CachedValue* TransactionalBucket::find(uint32_t hash, void const* key,
     }
     if (_cachedHashes[i] == hash && _cachedData[i]->sameKey(key, keySize)) {
       result = _cachedData[i];
-      if (moveToFront) {
+      // hot entries usually sit in the first slot already. skip the no-op
+      // move then, so that lookups of these do not store into the bucket
+      if (moveToFront && i != 0) {
         moveSlot(i, true);
       }
       break;
@@ -165,7 +167,7 @@ bool TransactionalBucket::isBlacklisted(uint32_t hash) const {
   return blacklisted;
 }
 
-CachedValue* TransactionalBucket::evictionCandidate(bool ignoreRefCount) const {
+CachedValue* TransactionalBucket::evictionCandidate(bool ignoreRefCount, uint32_t* hash) const {
   TRI_ASSERT(isLocked());
   for (size_t i = 0; i < slotsData; i++) {
     size_t slot = slotsData - (i + 1);
@@ -173,6 +175,9 @@ CachedValue* TransactionalBucket::evictionCandidate(bool ignoreRefCount) const {
       continue;
     }
     if (ignoreRefCount || _cachedData[slot]->isFreeable()) {
+      if (hash != nullptr) {
+        *hash = _cachedHashes[slot];
+      }
       return _cachedData[slot];
     }
   }
@@ -165,8 +165,10 @@ struct TransactionalBucket {
   /// bucket contains no values or all have outstanding references, then it
   /// returns nullptr. In the case that ignoreRefCount is set to true, then it
   /// simply returns the least recently used value, regardless of freeability.
+  /// If hash is given, it receives the stored hash of the returned value.
   //////////////////////////////////////////////////////////////////////////////
-  CachedValue* evictionCandidate(bool ignoreRefCount = false) const;
+  CachedValue* evictionCandidate(bool ignoreRefCount = false,
+                                 uint32_t* hash = nullptr) const;
 
   //////////////////////////////////////////////////////////////////////////////
   /// @brief Evicts the given value from the bucket. Requires state to be
@@ -45,6 +45,7 @@ Finding TransactionalCache::find(void const* key, uint32_t keySize) {
   TRI_ASSERT(key != nullptr);
   Finding result;
   uint32_t hash = hashKey(key, keySize);
+  recordAccess(hash);
 
   Result status;
   TransactionalBucket* bucket;
@@ -60,10 +61,10 @@ Finding TransactionalCache::find(void const* key, uint32_t keySize) {
     recordStat(Stat::findHit);
   } else {
     recordStat(Stat::findMiss);
+    recordMiss(hash);
     status.reset(TRI_ERROR_ARANGO_DOCUMENT_NOT_FOUND);
     result.reportError(status);
   }
-  recordStat(result.found() ? Stat::findHit : Stat::findMiss);
   bucket->unlock();
 
   return result;
@@ -72,6 +73,7 @@ Finding TransactionalCache::find(void const* key, uint32_t keySize) {
 Result TransactionalCache::insert(CachedValue* value) {
   TRI_ASSERT(value != nullptr);
   uint32_t hash = hashKey(value->key(), value->keySize());
+  recordAccess(hash);
 
   Result status;
   TransactionalBucket* bucket;
@@ -85,13 +87,20 @@ Result TransactionalCache::insert(CachedValue* value) {
   bool allowed = !bucket->isBlacklisted(hash);
   if (allowed) {
     int64_t change = static_cast<int64_t>(value->size());
+    uint32_t candidateHash = 0;
     CachedValue* candidate = bucket->find(hash, value->key(), value->keySize());
 
     if (candidate == nullptr && bucket->isFull()) {
-      candidate = bucket->evictionCandidate();
+      candidate = bucket->evictionCandidate(false, &candidateHash);
       if (candidate == nullptr) {
         allowed = false;
         status.reset(TRI_ERROR_ARANGO_BUSY);
+      } else if (!admitInsert(hash, candidateHash)) {
+        // the victim is accessed more often than the new entry, so keep it.
+        // this still counts as an eviction for the migration heuristics
+        allowed = false;
+        status.reset(TRI_ERROR_ARANGO_BUSY);
+        maybeMigrate = reportInsert(true);
       }
     }
 
@@ -110,6 +119,7 @@ Result TransactionalCache::insert(CachedValue* value) {
           bucket->evict(candidate, true);
           if (!candidate->sameKey(value->key(), value->keySize())) {
             eviction = true;
+            recordEviction(candidate, candidateHash);
           }
           freeValue(candidate);
         }
@@ -135,6 +145,38 @@ Result TransactionalCache::insert(CachedValue* value) {
   return status;
 }
 
+std::vector<std::string> TransactionalCache::hotKeys(size_t maxKeys) {
+  std::vector<std::string> result;
+  cache::Table* table = _table.load(std::memory_order_relaxed);
+  if (isShutdown() || table == nullptr) {
+    return result;
+  }
+
+  uint64_t const size = table->size();
+  uint32_t const shift = 32 - table->logSize();
+  for (uint64_t i = 0; i < size && result.size() < maxKeys; i++) {
+    uint32_t hash = static_cast<uint32_t>(i << shift);
+    Result status;
+    TransactionalBucket* bucket;
+    Table* source;
+    std::tie(status, bucket, source) = getBucket(hash, Cache::triesFast, false);
+    if (status.fail()) {
+      if (status.errorNumber() == TRI_ERROR_SHUTTING_DOWN) {
+        break;
+      }
+      continue;
+    }
+    // the front slot holds the most recently used entry
+    CachedValue const* value = bucket->_cachedData[0];
+    if (value != nullptr) {
+      result.emplace_back(reinterpret_cast<char const*>(value->key()), value->keySize());
+    }
+    bucket->unlock();
+  }
+
+  return result;
+}
+
 Result TransactionalCache::remove(void const* key, uint32_t keySize) {
   TRI_ASSERT(key != nullptr);
   uint32_t hash = hashKey(key, keySize);
@@ -248,10 +290,12 @@ uint64_t TransactionalCache::freeMemoryFrom(uint32_t hash) {
 
   bool maybeMigrate = false;
   // evict LRU freeable value if exists
-  CachedValue* candidate = bucket->evictionCandidate();
+  uint32_t candidateHash = 0;
+  CachedValue* candidate = bucket->evictionCandidate(false, &candidateHash);
 
   if (candidate != nullptr) {
     reclaimed = candidate->size();
+    recordEviction(candidate, candidateHash);
     bucket->evict(candidate);
     freeValue(candidate);
     maybeMigrate = source->slotEmptied();
@@ -32,8 +32,11 @@
 #include "Cluster/ServerState.h"
 #include "GeneralServer/AuthenticationFeature.h"
 #include "Logger/Logger.h"
+#include "Rest/HttpResponse.h"
 #include "Scheduler/SchedulerFeature.h"
 #include "SimpleHttpClient/SimpleHttpCommunicatorResult.h"
+#include "Statistics/ClusterCommStatistics.h"
+#include "Statistics/Tracing.h"
 #include "Transaction/Methods.h"
 #include "VocBase/ticks.h"
 
@@ -85,8 +88,68 @@ std::stringstream createResponseInfo(ClusterCommResult const* result) {
   }
   return ss;
 }
+
+size_t responseSize(GeneralResponse* response) {
+  auto httpResponse = dynamic_cast<HttpResponse*>(response);
+  if (httpResponse == nullptr) {
+    return 0;
+  }
+  return httpResponse->body().length();
+}
+
+/// @brief wraps the callbacks of a request so that it is accounted for in
+/// the per-destination statistics
+void addStatistics(Callbacks& callbacks, ClusterCommResult const& result, size_t bytesSent) {
+  auto sample = std::make_shared<ClusterCommStatistics::Sample>();
+  sample->serverID = result.serverID.empty() ? result.endpoint : result.serverID;
+  sample->shardID = result.shardID;
+  sample->bytesSent = bytesSent;
+  if (!ClusterCommStatistics::requestStarted(*sample)) {
+    return;
+  }
+
+  auto scheduleMe = std::move(callbacks._scheduleMe);
+  callbacks._scheduleMe = [sample, scheduleMe](std::function<void()> task) {
+    sample->receivedTime = TRI_microtime();
+    scheduleMe(std::move(task));
+  };
+  auto onSuccess = std::move(callbacks._onSuccess);
+  callbacks._onSuccess = [sample, onSuccess](std::unique_ptr<GeneralResponse> response) {
+    ClusterCommStatistics::requestFinished(*sample, responseSize(response.get()));
+    onSuccess(std::move(response));
+  };
+  auto onError = std::move(callbacks._onError);
+  callbacks._onError = [sample, onError](int errorCode, std::unique_ptr<GeneralResponse> response) {
+    ClusterCommStatistics::requestFinished(*sample, responseSize(response.get()));
+    onError(errorCode, std::move(response));
+  };
 }
 
+/// @brief passes the trace of the current thread on to the receiver of the
+/// request, and records the request as a span of the trace
+void addTracing(Callbacks& callbacks, HttpRequest& request, ClusterCommResult const& result) {
+  tracing::SpanContext parent = tracing::current();
+  if (!parent.sampled()) {
+    return;
+  }
+
+  auto span = std::make_shared<tracing::Span>("cluster request", parent);
+  span->setDetail(result.shardID.empty() ? result.serverID : result.shardID);
+  request.setHeader(StaticStrings::XArangoTrace, tracing::toHeader(span->context()));
+
+  auto onSuccess = std::move(callbacks._onSuccess);
+  callbacks._onSuccess = [span, onSuccess](std::unique_ptr<GeneralResponse> response) {
+    span->finish();
+    onSuccess(std::move(response));
+  };
+  auto onError = std::move(callbacks._onError);
+  callbacks._onError = [span, onError](int errorCode, std::unique_ptr<GeneralResponse> response) {
+    span->finish();
+    onError(errorCode, std::move(response));
+  };
+}
+}  // namespace
+
 /// @brief empty map with headers
 std::unordered_map<std::string, std::string> const ClusterCommRequest::noHeaders;
 
@@ -542,6 +605,9 @@ OperationID ClusterComm::asyncRequest(
     };
   }
 
+  addStatistics(callbacks, *result, body == nullptr ? 0 : body->size());
+  addTracing(callbacks, *request, *result);
+
   TRI_ASSERT(request != nullptr);
   // Call a random communicator
   auto communicatorPtr = communicator();
@@ -643,6 +709,8 @@ std::unique_ptr<ClusterCommResult> ClusterComm::syncRequest(
         } // else
       });
   callbacks._scheduleMe = scheduleMe;
+  addStatistics(callbacks, *sharedData->result, body.size());
+  addTracing(callbacks, *request, *sharedData->result);
 
   communicator::Options opt;
   opt.requestTimeout = timeout;
@@ -1102,10 +1170,18 @@ std::pair<ClusterCommResult*, HttpRequest*> ClusterComm::prepareRequest(
 #endif
 #endif
 
+  // callers can send binary VelocyPack bodies by setting the content-type
+  // header. the communicator will then not add a JSON content-type
+  ContentType contentType = ContentType::JSON;
+  auto it = headersCopy.find(StaticStrings::ContentTypeHeader);
+  if (it != headersCopy.end() && it->second == StaticStrings::MimeTypeVPack) {
+    contentType = ContentType::VPACK;
+  }
+
   if (body == nullptr) {
-    request = HttpRequest::createHttpRequest(ContentType::JSON, "", 0, headersCopy);
+    request = HttpRequest::createHttpRequest(contentType, "", 0, headersCopy);
   } else {
-    request = HttpRequest::createHttpRequest(ContentType::JSON, body->data(),
+    request = HttpRequest::createHttpRequest(contentType, body->data(),
                                              body->size(), headersCopy);
   }
   request->setRequestType(reqtype);
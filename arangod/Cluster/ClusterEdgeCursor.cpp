@@ -46,15 +46,27 @@ ClusterEdgeCursor::ClusterEdgeCursor(arangodb::velocypack::StringRef vertexId, u
       _cache(static_cast<ClusterTraverserCache*>(opts->cache())),
       _httpRequests(0) {
   TRI_ASSERT(_cache != nullptr);
-  auto trx = _opts->trx();
-  transaction::BuilderLeaser leased(trx);
-  transaction::BuilderLeaser b(trx);
+  if (_cache->prefetchedEdges(vertexId, depth, _edgeList)) {
+    // the edges have been fetched together with the rest of the frontier
+    return;
+  }
+  transaction::BuilderLeaser b(_opts->trx());
 
   b->add(VPackValuePair(vertexId.data(), vertexId.length(), VPackValueType::String));
-  fetchEdgesFromEngines(trx->vocbase().name(), _cache->engines(), b->slice(), depth,
-                        _cache->cache(), _edgeList, _cache->datalake(), *(leased.get()),
-                        _cache->filteredDocuments(), _cache->insertedDocuments());
-  _httpRequests += _cache->engines()->size();
+  fetchTraverserEdges(b->slice(), depth);
+}
+
+// Traverser variant for a whole frontier of vertices
+ClusterEdgeCursor::ClusterEdgeCursor(VPackSlice vertexIds, uint64_t depth,
+                                     graph::BaseOptions* opts)
+    : _position(0),
+      _resolver(opts->trx()->resolver()),
+      _opts(opts),
+      _cache(static_cast<ClusterTraverserCache*>(opts->cache())),
+      _httpRequests(0) {
+  TRI_ASSERT(_cache != nullptr);
+  TRI_ASSERT(vertexIds.isArray());
+  fetchTraverserEdges(vertexIds, depth);
 }
 
 // ShortestPath variant
@@ -65,12 +77,40 @@ ClusterEdgeCursor::ClusterEdgeCursor(arangodb::velocypack::StringRef vertexId, b
       _cache(static_cast<ClusterTraverserCache*>(opts->cache())),
       _httpRequests(0) {
   TRI_ASSERT(_cache != nullptr);
+  transaction::BuilderLeaser b(_opts->trx());
+
+  b->add(VPackValuePair(vertexId.data(), vertexId.length(), VPackValueType::String));
+  fetchShortestPathEdges(b->slice(), backward);
+}
+
+// ShortestPath variant for a whole frontier of vertices
+ClusterEdgeCursor::ClusterEdgeCursor(VPackSlice vertexIds, bool backward,
+                                     graph::BaseOptions* opts)
+    : _position(0),
+      _resolver(opts->trx()->resolver()),
+      _opts(opts),
+      _cache(static_cast<ClusterTraverserCache*>(opts->cache())),
+      _httpRequests(0) {
+  TRI_ASSERT(_cache != nullptr);
+  TRI_ASSERT(vertexIds.isArray());
+  fetchShortestPathEdges(vertexIds, backward);
+}
+
+void ClusterEdgeCursor::fetchTraverserEdges(VPackSlice vertexIds, uint64_t depth) {
   auto trx = _opts->trx();
   transaction::BuilderLeaser leased(trx);
-  transaction::BuilderLeaser b(trx);
 
-  b->add(VPackValuePair(vertexId.data(), vertexId.length(), VPackValueType::String));
-  fetchEdgesFromEngines(trx->vocbase().name(), _cache->engines(), b->slice(),
+  fetchEdgesFromEngines(trx->vocbase().name(), _cache->engines(), vertexIds, depth,
+                        _cache->cache(), _edgeList, _cache->datalake(), *(leased.get()),
+                        _cache->filteredDocuments(), _cache->insertedDocuments());
+  _httpRequests += _cache->engines()->size();
+}
+
+void ClusterEdgeCursor::fetchShortestPathEdges(VPackSlice vertexIds, bool backward) {
+  auto trx = _opts->trx();
+  transaction::BuilderLeaser leased(trx);
+
+  fetchEdgesFromEngines(trx->vocbase().name(), _cache->engines(), vertexIds,
                         backward, _cache->cache(), _edgeList, _cache->datalake(),
                         *(leased.get()), _cache->insertedDocuments());
   _httpRequests += _cache->engines()->size();
@@ -43,8 +43,12 @@ class ClusterEdgeCursor : public graph::EdgeCursor {
  public:
   // Traverser Variant
   ClusterEdgeCursor(arangodb::velocypack::StringRef vid, uint64_t, graph::BaseOptions*);
+  // Traverser Variant for an array of vertex ids, fetched in one go
+  ClusterEdgeCursor(arangodb::velocypack::Slice vids, uint64_t, graph::BaseOptions*);
   // ShortestPath Variant
   ClusterEdgeCursor(arangodb::velocypack::StringRef vid, bool isBackward, graph::BaseOptions*);
+  // ShortestPath Variant for an array of vertex ids, fetched in one go
+  ClusterEdgeCursor(arangodb::velocypack::Slice vids, bool isBackward, graph::BaseOptions*);
 
   ~ClusterEdgeCursor() {}
 
@@ -55,6 +59,15 @@ class ClusterEdgeCursor : public graph::EdgeCursor {
   /// @brief number of HTTP requests performed.
   size_t httpRequests() const override { return _httpRequests; }
 
+ private:
+  /// @brief fetch the edges of one vertex id or an array of vertex ids from
+  /// all traverser engines
+  void fetchTraverserEdges(arangodb::velocypack::Slice vids, uint64_t depth);
+
+  /// @brief fetch the edges of one vertex id or an array of vertex ids from
+  /// all shortest path engines
+  void fetchShortestPathEdges(arangodb::velocypack::Slice vids, bool isBackward);
+
  private:
   std::vector<arangodb::velocypack::Slice> _edgeList;
 
@@ -29,6 +29,8 @@
 #include "Cluster/ClusterComm.h"
 #include "Cluster/ClusterInfo.h"
 #include "Cluster/HeartbeatThread.h"
+#include "Cluster/InsertCoalescer.h"
+#include "Cluster/ReplicationPipeline.h"
 #include "Endpoint/Endpoint.h"
 #include "GeneralServer/AuthenticationFeature.h"
 #include "Logger/Logger.h"
@@ -141,9 +143,36 @@ void ClusterFeature::collectOptions(std::shared_ptr<ProgramOptions> options) {
       "be created before giving up",
       new DoubleParameter(&_indexCreationTimeout),
       arangodb::options::makeFlags(arangodb::options::Flags::Hidden));
+
+  options->addOption(
+      "--cluster.insert-coalescing-window",
+      "time (in microseconds) a coordinator collects concurrent "
+      "single-document inserts into the same shard before sending them as "
+      "one batch (0 = off)",
+      new UInt64Parameter(&_insertCoalescingWindow));
+
+  options->addOption(
+      "--cluster.insert-coalescing-max-batch-size",
+      "maximum number of documents in a coalesced insert batch",
+      new UInt64Parameter(&_insertCoalescingMaxBatchSize),
+      arangodb::options::makeFlags(arangodb::options::Flags::Hidden));
+
+  options->addOption(
+      "--cluster.synchronous-replication-max-batch-size",
+      "maximum number of concurrent single-document operations a leader "
+      "sends to its followers in one request (1 = one request per operation)",
+      new UInt64Parameter(&ReplicationPipeline::maxBatchSize),
+      arangodb::options::makeFlags(arangodb::options::Flags::Hidden));
 }
 
 void ClusterFeature::validateOptions(std::shared_ptr<ProgramOptions> options) {
+  if (_insertCoalescingMaxBatchSize < 1) {
+    _insertCoalescingMaxBatchSize = 1;
+  }
+  if (ReplicationPipeline::maxBatchSize < 1) {
+    ReplicationPipeline::maxBatchSize = 1;
+  }
+
   if (options->processingResult().touched(
           "cluster.disable-dispatcher-kickstarter") ||
       options->processingResult().touched(
@@ -434,6 +463,11 @@ void ClusterFeature::start() {
 
   startHeartbeatThread(_agencyCallbackRegistry.get(), _heartbeatInterval, 5, endpoints);
 
+  if (role == ServerState::ROLE_COORDINATOR && _insertCoalescingWindow > 0) {
+    _insertCoalescer = std::make_unique<InsertCoalescer>(_insertCoalescingWindow,
+                                                         _insertCoalescingMaxBatchSize);
+  }
+
   comm.increment("Current/Version");
 
   ServerState::instance()->setState(ServerState::STATE_SERVING);
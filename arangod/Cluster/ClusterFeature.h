@@ -33,6 +33,7 @@ namespace arangodb {
 
 class AgencyCallbackRegistry;
 class HeartbeatThread;
+class InsertCoalescer;
 
 class ClusterFeature : public application_features::ApplicationFeature {
  public:
@@ -89,6 +90,9 @@ class ClusterFeature : public application_features::ApplicationFeature {
   };
   double indexCreationTimeout() const { return _indexCreationTimeout; }
   uint32_t systemReplicationFactor() { return _systemReplicationFactor; };
+  /// @brief merges concurrent single-document inserts on coordinators,
+  /// nullptr if --cluster.insert-coalescing-window is 0
+  InsertCoalescer* insertCoalescer() const { return _insertCoalescer.get(); }
 
   void stop() override final;
 
@@ -100,6 +104,9 @@ class ClusterFeature : public application_features::ApplicationFeature {
   uint64_t _heartbeatInterval;
   std::unique_ptr<AgencyCallbackRegistry> _agencyCallbackRegistry;
   ServerState::RoleEnum _requestedRole;
+  uint64_t _insertCoalescingWindow = 0;
+  uint64_t _insertCoalescingMaxBatchSize = 1000;
+  std::unique_ptr<InsertCoalescer> _insertCoalescer;
 };
 
 }  // namespace arangodb
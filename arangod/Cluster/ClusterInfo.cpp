@@ -400,6 +400,29 @@ void ClusterInfo::loadClusterId() {
 //
 static std::string const prefixPlan = "Plan";
 
+/// @brief whether the value at path in the previously loaded agency subtree
+/// is byte-for-byte the same as now. objects derived from an unchanged value
+/// may be kept instead of being rebuilt
+static bool unchangedSince(std::shared_ptr<VPackBuilder> const& previous,
+                           std::vector<std::string> const& path, VPackSlice now) {
+  if (previous == nullptr) {
+    return false;
+  }
+  try {
+    VPackSlice old = previous->slice();
+    for (auto const& key : path) {
+      if (!old.isObject()) {
+        return false;
+      }
+      old = old.get(key);
+    }
+    return old.byteSize() == now.byteSize() &&
+           memcmp(old.start(), now.start(), now.byteSize()) == 0;
+  } catch (...) {
+    return false;
+  }
+}
+
 void ClusterInfo::loadPlan() {
   DatabaseFeature* databaseFeature =
       application_features::ApplicationServer::getFeature<DatabaseFeature>(
@@ -741,6 +764,24 @@ void ClusterInfo::loadPlan() {
       auto const databaseName = databasePairSlice.key.copyString();
       auto* vocbase = databaseFeature->lookupDatabase(databaseName);
 
+      // arangosearch links register with the view objects, which are created
+      // anew above. collections of databases with views are therefore rebuilt,
+      // all others are kept if their definition has not changed.
+      // it is effectively safe to access _plan and _plannedCollections in
+      // read-only mode here, see below
+      bool reuseCollections = true;
+      if (planViewsSlice.isObject()) {
+        VPackSlice views = planViewsSlice.get(databaseName);
+        reuseCollections = !views.isObject() || views.length() == 0;
+      }
+      DatabaseCollections const* oldCollections = nullptr;
+      if (reuseCollections) {
+        auto it = _plannedCollections.find(databaseName);
+        if (it != _plannedCollections.end()) {
+          oldCollections = &(it->second);
+        }
+      }
+
       if (!vocbase) {
         // No database with this name found.
         // We have an invalid state here.
@@ -771,27 +812,40 @@ void ClusterInfo::loadPlan() {
         try {
           std::shared_ptr<LogicalCollection> newCollection;
 
+          if (oldCollections != nullptr) {
+            auto it = oldCollections->find(collectionId);
+            if (it != oldCollections->end() && &(it->second->vocbase()) == vocbase &&
+                unchangedSince(_plan, {"Collections", databaseName, collectionId},
+                               collectionSlice)) {
+              newCollection = it->second;
+            }
+          }
+
+          bool const reused = (newCollection != nullptr);
+
+          if (!reused) {
 #if defined(USE_ENTERPRISE)
-          auto isSmart = collectionSlice.get(StaticStrings::IsSmart);
+            auto isSmart = collectionSlice.get(StaticStrings::IsSmart);
 
-          if (isSmart.isTrue()) {
-            auto type = collectionSlice.get(StaticStrings::DataSourceType);
+            if (isSmart.isTrue()) {
+              auto type = collectionSlice.get(StaticStrings::DataSourceType);
 
-            if (type.isInteger() && type.getUInt() == TRI_COL_TYPE_EDGE) {
-              newCollection = std::make_shared<VirtualSmartEdgeCollection>(  // create collection
-                  *vocbase, collectionSlice, newPlanVersion  // args
-              );
-            } else {
-              newCollection = std::make_shared<SmartVertexCollection>(  // create collection
-                  *vocbase, collectionSlice, newPlanVersion  // args
+              if (type.isInteger() && type.getUInt() == TRI_COL_TYPE_EDGE) {
+                newCollection = std::make_shared<VirtualSmartEdgeCollection>(  // create collection
+                    *vocbase, collectionSlice, newPlanVersion  // args
+                );
+              } else {
+                newCollection = std::make_shared<SmartVertexCollection>(  // create collection
+                    *vocbase, collectionSlice, newPlanVersion  // args
+                );
+              }
+            } else
+#endif
+            {
+              newCollection = std::make_shared<LogicalCollection>(  // create collection
+                  *vocbase, collectionSlice, true, newPlanVersion  // args
               );
             }
-          } else
-#endif
-          {
-            newCollection = std::make_shared<LogicalCollection>(  // create collection
-                *vocbase, collectionSlice, true, newPlanVersion  // args
-            );
           }
 
           auto& collectionName = newCollection->name();
@@ -799,7 +853,7 @@ void ClusterInfo::loadPlan() {
           bool isBuilding = isCoordinator &&
                             arangodb::basics::VelocyPackHelper::getBooleanValue(
                                 collectionSlice, StaticStrings::IsBuilding, false);
-          if (isCoordinator) {
+          if (isCoordinator && !reused) {
             // copying over index estimates from the old version of the
             // collection into the new one
             LOG_TOPIC("7a884", TRACE, Logger::CLUSTER)
@@ -1063,13 +1117,32 @@ void ClusterInfo::loadCurrent() {
            velocypack::ObjectIterator(databaseSlice.value)) {
         auto const collectionName = collectionSlice.key.copyString();
 
-        auto collectionDataCurrent =
-            std::make_shared<CollectionInfoCurrent>(newCurrentVersion);
+        // keep the information of collections whose entry has not changed.
+        // it is effectively safe to access _current and _currentCollections
+        // in read-only mode here, as the only places that modify them are
+        // the shutdown and this function itself, which is protected by a mutex
+        std::shared_ptr<CollectionInfoCurrent> collectionDataCurrent;
+        if (unchangedSince(_current, {"Collections", databaseName, collectionName},
+                           collectionSlice.value)) {
+          auto it = _currentCollections.find(databaseName);
+          if (it != _currentCollections.end()) {
+            auto it2 = it->second.find(collectionName);
+            if (it2 != it->second.end()) {
+              collectionDataCurrent = it2->second;
+            }
+          }
+        }
+        bool const reused = (collectionDataCurrent != nullptr);
+        if (!reused) {
+          collectionDataCurrent = std::make_shared<CollectionInfoCurrent>(newCurrentVersion);
+        }
 
         for (auto const& shardSlice : velocypack::ObjectIterator(collectionSlice.value)) {
           auto const shardID = shardSlice.key.copyString();
 
-          collectionDataCurrent->add(shardID, shardSlice.value);
+          if (!reused) {
+            collectionDataCurrent->add(shardID, shardSlice.value);
+          }
 
           // Note that we have only inserted the CollectionInfoCurrent under
           // the collection ID and not under the name! It is not possible
@@ -1608,6 +1681,15 @@ Result ClusterInfo::createCollectionsCoordinator(std::string const& databaseName
   LOG_TOPIC("4315c", DEBUG, Logger::CLUSTER)
       << "createCollectionCoordinator, loading Plan from agency...";
   loadPlan();
+
+  // mop: why do these ask the agency instead of checking cluster info?
+  if (!ac.exists("Plan/Databases/" + databaseName)) {
+    for (auto const& info : infos) {
+      events::CreateCollection(databaseName, info.name, TRI_ERROR_ARANGO_DATABASE_NOT_FOUND);
+    }
+    return TRI_ERROR_ARANGO_DATABASE_NOT_FOUND;
+  }
+
   // No matter how long this will take, we will not ourselfes trigger a plan relaoding.
   for (auto& info : infos) {
     // Check if name exists.
@@ -1646,12 +1728,6 @@ Result ClusterInfo::createCollectionsCoordinator(std::string const& databaseName
     LOG_TOPIC("66541", DEBUG, Logger::CLUSTER)
         << "createCollectionCoordinator, checking things...";
 
-    // mop: why do these ask the agency instead of checking cluster info?
-    if (!ac.exists("Plan/Databases/" + databaseName)) {
-      events::CreateCollection(databaseName, info.name, TRI_ERROR_ARANGO_DATABASE_NOT_FOUND);
-      return TRI_ERROR_ARANGO_DATABASE_NOT_FOUND;
-    }
-
     if (ac.exists("Plan/Collections/" + databaseName + "/" + info.collectionID)) {
       events::CreateCollection(databaseName, info.name, TRI_ERROR_CLUSTER_COLLECTION_ID_EXISTS);
       return TRI_ERROR_CLUSTER_COLLECTION_ID_EXISTS;
@@ -1693,6 +1769,11 @@ Result ClusterInfo::createCollectionsCoordinator(std::string const& databaseName
 
   std::vector<AgencyPrecondition> precs;
   std::unordered_set<std::string> conditions;
+  // prototypes of distributeShardsLike that are created in this batch are
+  // not yet in the plan, and their shards cannot be locked by the supervision
+  for (auto const& info : infos) {
+    conditions.emplace(info.collectionID);
+  }
 
   // current thread owning 'cacheMutex' write lock (workaround for non-recursive Mutex)
   for (auto& info : infos) {
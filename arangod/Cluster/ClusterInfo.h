@@ -100,6 +100,25 @@ class CollectionInfoCurrent {
     return VPackSlice::noneSlice();
   }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief returns the approximate number of documents the shard leader
+  /// reported, or -1 if it has not reported one
+  //////////////////////////////////////////////////////////////////////////////
+
+  int64_t approximateCount(ShardID const& shardID) const {
+    auto it = _vpacks.find(shardID);
+    if (it != _vpacks.end()) {
+      VPackSlice slice = it->second->slice();
+      if (slice.isObject()) {
+        VPackSlice count = slice.get("approximateCount");
+        if (count.isNumber()) {
+          return count.getNumber<int64_t>();
+        }
+      }
+    }
+    return -1;
+  }
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief returns the error flag for a shardID
   //////////////////////////////////////////////////////////////////////////////
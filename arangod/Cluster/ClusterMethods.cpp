@@ -22,6 +22,8 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "ClusterMethods.h"
+#include "Basics/HybridLogicalClock.h"
+#include "Basics/HyperLogLog.h"
 #include "Basics/NumberUtils.h"
 #include "Basics/StaticStrings.h"
 #include "Basics/StringUtils.h"
@@ -30,10 +32,16 @@
 #include "Basics/tri-strings.h"
 #include "Cluster/ClusterCollectionCreationInfo.h"
 #include "Cluster/ClusterComm.h"
+#include "Cluster/ClusterFeature.h"
 #include "Cluster/ClusterInfo.h"
 #include "Cluster/ClusterTrxMethods.h"
+#include "Cluster/FollowerReads.h"
+#include "Cluster/InsertCoalescer.h"
+#include "Futures/Utilities.h"
 #include "Graph/Traverser.h"
 #include "Indexes/Index.h"
+#include "Network/Methods.h"
+#include "Network/NetworkFeature.h"
 #include "RestServer/TtlFeature.h"
 #include "StorageEngine/TransactionCollection.h"
 #include "StorageEngine/TransactionState.h"
@@ -68,6 +76,59 @@ static double const CL_DEFAULT_TIMEOUT = 120.0;
 static double const CL_DEFAULT_LONG_TIMEOUT = 900.0;
 
 namespace {
+/// @brief per-shard selectivity sketch of an index
+struct ShardSketch {
+  HyperLogLog sketch;
+  uint64_t used = 0;
+  uint64_t total = 0;
+};
+
+/// @brief parse a sketch as produced by Index::selectivitySketch
+bool parseShardSketch(VPackSlice value, ShardSketch& result) {
+  if (!value.isObject()) {
+    return false;
+  }
+  VPackSlice sketch = value.get("sketch");
+  if (!sketch.isString()) {
+    return false;
+  }
+  std::string registers = StringUtils::decodeBase64(sketch.copyString());
+  if (!result.sketch.deserialize(registers.data(), registers.size())) {
+    return false;
+  }
+  result.used = VelocyPackHelper::getNumericValue<uint64_t>(value, "used", 0);
+  result.total = VelocyPackHelper::getNumericValue<uint64_t>(value, "total", 0);
+  return true;
+}
+
+/// @brief combine the selectivity of all shards of an index. the union of
+/// the sketches tells how much the distinct values of the shards overlap,
+/// and the shards' own distinct counts are scaled down accordingly. the
+/// sketches are only used for the ratio because they never forget removed
+/// values, while the shards' counts do
+double mergeShardSketches(std::vector<ShardSketch> const& sketches) {
+  HyperLogLog merged;
+  double sumSketches = 0.0;
+  uint64_t used = 0;
+  uint64_t total = 0;
+  for (auto const& it : sketches) {
+    merged.merge(it.sketch);
+    sumSketches += it.sketch.estimate();
+    used += it.used;
+    total += it.total;
+  }
+  if (total == 0) {
+    // no documents, same as on the DB servers
+    return 1.0;
+  }
+  double overlap = 1.0;
+  if (sumSketches > 0.0) {
+    overlap = std::min(1.0, merged.estimate() / sumSketches);
+  }
+  double distinct = std::max(1.0, overlap * static_cast<double>(used));
+  return std::min(1.0, distinct / static_cast<double>(total));
+}
+
 template <typename T>
 T addFigures(VPackSlice const& v1, VPackSlice const& v2,
              std::vector<std::string> const& attr) {
@@ -220,6 +281,94 @@ static void addTransactionHeaderForShard(transaction::Methods& trx,
                                    "couldnt find shard in shardMap");
   }
 }
+
+/// @brief destination of a document read. if the client allows dirty
+/// reads, one of the in-sync followers is picked and the headers it needs
+/// to check its progress are added
+static std::string readDestination(ClusterInfo* ci, ShardID const& shard,
+                                   OperationOptions const& options, bool followerReads,
+                                   std::unordered_map<std::string, std::string>& headers) {
+  if (followerReads) {
+    auto servers = ci->getResponsibleServer(shard);
+    ServerID follower = FollowerReads::selectFollower(shard, *servers, options.readTimestamp);
+    if (!follower.empty()) {
+      headers.emplace(StaticStrings::AllowDirtyReads, "true");
+      if (options.readTimestamp != 0) {
+        headers.emplace(StaticStrings::ReadTimestamp,
+                        HybridLogicalClock::encodeTimeStamp(options.readTimestamp));
+      }
+      return "server:" + follower;
+    }
+  }
+  return "shard:" + shard;
+}
+
+/// @brief sends the requests, of which some may go to followers. followers
+/// that cannot answer, e.g. because they are not in sync or are behind the
+/// requested time stamp, are not retried but replaced by the leader
+static void performReadRequests(ClusterComm& cc, std::vector<ClusterCommRequest>& requests,
+                                std::vector<ShardID> const& shards, bool isManaged) {
+  TRI_ASSERT(requests.size() == shards.size());
+  bool followerReads = false;
+  for (auto const& req : requests) {
+    if (req.destination.compare(0, 7, "server:") == 0) {
+      followerReads = true;
+      break;
+    }
+  }
+  if (!followerReads) {
+    cc.performRequests(requests, CL_DEFAULT_TIMEOUT, Logger::COMMUNICATION,
+                        /*retryOnCollNotFound*/ true, /*retryOnBackUnvlbl*/ !isManaged);
+    return;
+  }
+
+  // a shard that is missing on a follower is not going to appear there
+  cc.performRequests(requests, CL_DEFAULT_TIMEOUT, Logger::COMMUNICATION,
+                      /*retryOnCollNotFound*/ false, /*retryOnBackUnvlbl*/ false);
+
+  std::vector<ClusterCommRequest> retries;
+  std::vector<size_t> positions;
+  for (size_t i = 0; i < requests.size(); ++i) {
+    ClusterCommRequest& req = requests[i];
+    if (req.destination.compare(0, 7, "server:") != 0) {
+      continue;
+    }
+    ClusterCommResult const& res = req.result;
+    if (res.status == CL_COMM_RECEIVED && res.answer != nullptr) {
+      bool found = false;
+      std::string const& applied =
+          res.answer->header(StaticStrings::AppliedTimestamp, found);
+      if (found) {
+        FollowerReads::reportApplied(shards[i], req.destination.substr(7),
+                                     HybridLogicalClock::decodeTimeStamp(applied));
+      }
+      if (res.answer_code != rest::ResponseCode::SERVICE_UNAVAILABLE) {
+        // the results are collected per shard, as for reads from leaders
+        req.result.shardID = shards[i];
+        req.destination = "shard:" + shards[i];
+        continue;
+      }
+    }
+
+    // read from the leader instead
+    if (req.headerFields != nullptr) {
+      req.headerFields->erase(StaticStrings::AllowDirtyReads);
+      req.headerFields->erase(StaticStrings::ReadTimestamp);
+    }
+    retries.emplace_back("shard:" + shards[i], req.requestType, req.path,
+                         req.body, std::move(req.headerFields));
+    positions.emplace_back(i);
+  }
+
+  if (retries.empty()) {
+    return;
+  }
+  cc.performRequests(retries, CL_DEFAULT_TIMEOUT, Logger::COMMUNICATION,
+                      /*retryOnCollNotFound*/ true, /*retryOnBackUnvlbl*/ !isManaged);
+  for (size_t i = 0; i < retries.size(); ++i) {
+    requests[positions[i]] = std::move(retries[i]);
+  }
+}
 }  // namespace
 
 namespace arangodb {
@@ -404,6 +553,39 @@ static int distributeBabyOnShards(std::unordered_map<ShardID, std::vector<VPackS
   return TRI_ERROR_NO_ERROR;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Distribute all documents of an array onto a shard map, determining
+///        their shards in one go. If this returns sth. else than
+///        TRI_ERROR_NO_ERROR, the shardMap is incomplete
+////////////////////////////////////////////////////////////////////////////////
+
+static int distributeBabiesOnShards(std::unordered_map<ShardID, std::vector<VPackSlice>>& shardMap,
+                                    std::shared_ptr<LogicalCollection> const& collinfo,
+                                    std::vector<std::pair<ShardID, VPackValueLength>>& reverseMapping,
+                                    VPackSlice const& values) {
+  std::vector<ShardID> shardIDs;
+  shardIDs.reserve(values.length());
+  int error = collinfo->getResponsibleShards(values, false, shardIDs);
+  if (error == TRI_ERROR_ARANGO_DATA_SOURCE_NOT_FOUND) {
+    return TRI_ERROR_CLUSTER_SHARD_GONE;
+  }
+  if (error != TRI_ERROR_NO_ERROR) {
+    // We can not find a responsible shard
+    return error;
+  }
+
+  reverseMapping.reserve(reverseMapping.size() + shardIDs.size());
+  size_t i = 0;
+  for (VPackSlice value : VPackArrayIterator(values)) {
+    TRI_ASSERT(i < shardIDs.size());
+    auto& babies = shardMap[shardIDs[i]];
+    babies.emplace_back(value);
+    reverseMapping.emplace_back(std::move(shardIDs[i]), babies.size() - 1);
+    ++i;
+  }
+  return TRI_ERROR_NO_ERROR;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief Distribute one document onto a shard map. If this returns
 ///        TRI_ERROR_NO_ERROR the correct shard could be determined, if
@@ -603,37 +785,32 @@ static std::shared_ptr<std::unordered_map<std::string, std::vector<std::string>>
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief Clone shard distribution from other collection
+/// @brief Clone shard distribution from other collection, whose shards are
+/// given in shardList in the order of their shard ids
 ////////////////////////////////////////////////////////////////////////////////
 
 static std::shared_ptr<std::unordered_map<std::string, std::vector<std::string>>> CloneShardDistribution(
-    ClusterInfo* ci, LogicalCollection* col, TRI_voc_cid_t cid) {
+    ClusterInfo* ci, LogicalCollection* col, LogicalCollection const& other,
+    std::vector<ShardID> const& shardList) {
   auto result =
       std::make_shared<std::unordered_map<std::string, std::vector<std::string>>>();
-  TRI_ASSERT(cid != 0);
-  std::string cidString = arangodb::basics::StringUtils::itoa(cid);
   TRI_ASSERT(col);
-  auto other = ci->getCollection(col->vocbase().name(), cidString);
-
-  // The function guarantees that no nullptr is returned
-  TRI_ASSERT(other != nullptr);
 
-  if (!other->distributeShardsLike().empty()) {
-    std::string const errorMessage = "Cannot distribute shards like '" + other->name() +
+  if (!other.distributeShardsLike().empty()) {
+    std::string const errorMessage = "Cannot distribute shards like '" + other.name() +
                                      "' it is already distributed like '" +
-                                     other->distributeShardsLike() + "'.";
+                                     other.distributeShardsLike() + "'.";
     THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_CLUSTER_CHAIN_OF_DISTRIBUTESHARDSLIKE, errorMessage);
   }
 
   // We need to replace the distribute with the cid.
-  col->distributeShardsLike(cidString, other->shardingInfo());
+  col->distributeShardsLike(std::to_string(other.id()), other.shardingInfo());
 
   if (col->isSmart() && col->type() == TRI_COL_TYPE_EDGE) {
     return result;
   }
 
-  auto shards = other->shardIds();
-  auto shardList = ci->getShardList(cidString);
+  auto shards = other.shardIds();
 
   auto numberOfShards = static_cast<uint64_t>(col->numberOfShards());
   // fetch a unique id for each shard to create
@@ -641,7 +818,7 @@ static std::shared_ptr<std::unordered_map<std::string, std::vector<std::string>>
   for (uint64_t i = 0; i < numberOfShards; ++i) {
     // determine responsible server(s)
     std::string shardId = "s" + StringUtils::itoa(id + i);
-    auto it = shards->find(shardList->at(i));
+    auto it = shards->find(shardList.at(i));
     if (it == shards->end()) {
       TRI_ASSERT(false);
       THROW_ARANGO_EXCEPTION_MESSAGE(
@@ -654,6 +831,44 @@ static std::shared_ptr<std::unordered_map<std::string, std::vector<std::string>>
   return result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Clone shard distribution from other collection in the plan
+////////////////////////////////////////////////////////////////////////////////
+
+static std::shared_ptr<std::unordered_map<std::string, std::vector<std::string>>> CloneShardDistribution(
+    ClusterInfo* ci, LogicalCollection* col, TRI_voc_cid_t cid) {
+  TRI_ASSERT(cid != 0);
+  std::string cidString = arangodb::basics::StringUtils::itoa(cid);
+  TRI_ASSERT(col);
+  auto other = ci->getCollection(col->vocbase().name(), cidString);
+
+  // The function guarantees that no nullptr is returned
+  TRI_ASSERT(other != nullptr);
+
+  return CloneShardDistribution(ci, col, *other, *ci->getShardList(cidString));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Clone shard distribution from a collection that is created in the
+/// same batch and is not yet in the plan
+////////////////////////////////////////////////////////////////////////////////
+
+static std::shared_ptr<std::unordered_map<std::string, std::vector<std::string>>> CloneShardDistributionInBatch(
+    ClusterInfo* ci, LogicalCollection* col, LogicalCollection const& other) {
+  std::vector<ShardID> shardList;
+  for (auto const& it : *other.shardIds()) {
+    shardList.emplace_back(it.first);
+  }
+  // same order as in ClusterInfo::getShardList
+  std::sort(shardList.begin(), shardList.end(),
+            [](std::string const& a, std::string const& b) -> bool {
+              return std::strtol(a.c_str() + 1, nullptr, 10) <
+                     std::strtol(b.c_str() + 1, nullptr, 10);
+            });
+
+  return CloneShardDistribution(ci, col, other, shardList);
+}
+
 /// @brief convert ClusterComm error into arango error code
 int handleGeneralCommErrors(arangodb::ClusterCommResult const* res) {
   // This function creates an error code from a ClusterCommResult,
@@ -864,6 +1079,61 @@ int revisionOnCoordinator(std::string const& dbname,
                               // the DBserver could have reported an error.
 }
 
+int invalidationTicksOnCoordinator(std::string const& dbname,
+                                   std::vector<ShardID> const& shards,
+                                   std::unordered_map<ShardID, uint64_t>& ticks) {
+  ClusterInfo* ci = ClusterInfo::instance();
+  auto cc = ClusterComm::instance();
+  if (cc == nullptr) {
+    // nullptr happens only during controlled shutdown
+    return TRI_ERROR_SHUTTING_DOWN;
+  }
+
+  // group the shards by their leaders
+  std::unordered_map<ServerID, VPackBuilder> shardsByServer;
+  for (auto const& shard : shards) {
+    auto servers = ci->getResponsibleServer(shard);
+    if (servers == nullptr || servers->empty()) {
+      return TRI_ERROR_CLUSTER_BACKEND_UNAVAILABLE;
+    }
+    VPackBuilder& body = shardsByServer[servers->front()];
+    if (body.isEmpty()) {
+      body.openArray();
+    }
+    body.add(VPackValue(shard));
+  }
+
+  std::vector<ClusterCommRequest> requests;
+  std::string const url =
+      "/_db/" + StringUtils::urlEncode(dbname) + "/_api/query-cache/ticks";
+  for (auto& it : shardsByServer) {
+    it.second.close();
+    requests.emplace_back("server:" + it.first, arangodb::rest::RequestType::PUT, url,
+                          std::make_shared<std::string>(it.second.slice().toJson()));
+  }
+
+  cc->performRequests(requests, 30.0, Logger::QUERIES, false);
+
+  for (auto const& req : requests) {
+    auto const& res = req.result;
+    if (res.status != CL_COMM_RECEIVED ||
+        res.answer_code != arangodb::rest::ResponseCode::OK) {
+      return TRI_ERROR_CLUSTER_BACKEND_UNAVAILABLE;
+    }
+    VPackSlice answer = res.answer->payload().get("ticks");
+    if (!answer.isObject()) {
+      return TRI_ERROR_INTERNAL;
+    }
+    for (auto const& it : VPackObjectIterator(answer)) {
+      if (it.value.isString()) {
+        ticks.emplace(it.key.copyString(), StringUtils::uint64(it.value.copyString()));
+      }
+    }
+  }
+
+  return TRI_ERROR_NO_ERROR;
+}
+
 int warmupOnCoordinator(std::string const& dbname, std::string const& cid) {
   // Set a few variables needed for our work:
   ClusterInfo* ci = ClusterInfo::instance();
@@ -1041,6 +1311,37 @@ int countOnCoordinator(transaction::Methods& trx, std::string const& cname,
   return TRI_ERROR_NO_ERROR;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief approximate number of documents by shard, from Current
+////////////////////////////////////////////////////////////////////////////////
+
+int approximateCountOnCoordinator(std::string const& dbname, std::string const& cname,
+                                  std::vector<std::pair<std::string, uint64_t>>& result) {
+  ClusterInfo* ci = ClusterInfo::instance();
+
+  result.clear();
+
+  std::shared_ptr<LogicalCollection> collinfo = ci->getCollectionNT(dbname, cname);
+  if (collinfo == nullptr) {
+    return TRI_ERROR_ARANGO_DATA_SOURCE_NOT_FOUND;
+  }
+
+  std::shared_ptr<CollectionInfoCurrent> current =
+      ci->getCollectionCurrent(dbname, std::to_string(collinfo->id()));
+  std::shared_ptr<ShardMap> shardIds = collinfo->shardIds();
+  for (auto const& p : *shardIds) {
+    int64_t count = current->approximateCount(p.first);
+    if (count < 0) {
+      // not reported (yet), e.g. by an older DB server
+      result.clear();
+      return TRI_ERROR_CLUSTER_BACKEND_UNAVAILABLE;
+    }
+    result.emplace_back(p.first, static_cast<uint64_t>(count));
+  }
+
+  return TRI_ERROR_NO_ERROR;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief gets the selectivity estimates from DBservers
 ////////////////////////////////////////////////////////////////////////////////
@@ -1077,7 +1378,8 @@ int selectivityEstimatesOnCoordinator(std::string const& dbname, std::string con
     }
 
     requestsUrl = "/_db/" + StringUtils::urlEncode(dbname) +
-                  "/_api/index/selectivity?collection=" + StringUtils::urlEncode(p.first);
+                  "/_api/index/selectivity?collection=" + StringUtils::urlEncode(p.first) +
+                  "&sketches=true";
     requests.emplace_back("shard:" + p.first, arangodb::rest::RequestType::GET,
                           requestsUrl, body, std::move(headers));
   }
@@ -1091,12 +1393,15 @@ int selectivityEstimatesOnCoordinator(std::string const& dbname, std::string con
   // ,"indexes":{ "s10004/0"    : 1.0,
   //              "s10004/10005": 0.5
   //            }
+  // ,"sketches":{ "s10004/10005": { "used": 5, "total": 10, "sketch": "..." } }
   // }
+  // sketches are missing for older DB servers and for indexes without one
 
   cc->performRequests(requests, CL_DEFAULT_TIMEOUT, Logger::QUERIES,
                       /*retryOnCollNotFound*/ true);
 
   std::map<std::string, std::vector<double>> indexEstimates;
+  std::map<std::string, std::vector<::ShardSketch>> indexSketches;
 
   for (auto& req : requests) {
     int res = handleGeneralCommErrors(&req.result);
@@ -1121,6 +1426,19 @@ int selectivityEstimatesOnCoordinator(std::string const& dbname, std::string con
         indexEstimates[index].push_back(estimate);
       }
 
+      VPackSlice sketches = answer.get("sketches");
+      if (sketches.isObject()) {
+        for (auto const& pair : VPackObjectIterator(sketches, true)) {
+          velocypack::StringRef shard_index_id(pair.key);
+          auto split_point = std::find(shard_index_id.begin(), shard_index_id.end(), '/');
+          std::string index(split_point + 1, shard_index_id.end());
+          ::ShardSketch sketch;
+          if (::parseShardSketch(pair.value, sketch)) {
+            indexSketches[index].push_back(std::move(sketch));
+          }
+        }
+      }
+
     } else {
       return static_cast<int>(comRes.answer_code);
     }
@@ -1134,7 +1452,13 @@ int selectivityEstimatesOnCoordinator(std::string const& dbname, std::string con
   };
 
   for (auto const& p : indexEstimates) {
-    result[p.first] = aggregate_indexes(p.second);
+    auto it = indexSketches.find(p.first);
+    if (it != indexSketches.end() && it->second.size() == p.second.size()) {
+      // every shard delivered a sketch
+      result[p.first] = ::mergeShardSketches(it->second);
+    } else {
+      result[p.first] = aggregate_indexes(p.second);
+    }
   }
 
   return TRI_ERROR_NO_ERROR;
@@ -1223,6 +1547,39 @@ Result createDocumentOnCoordinator(transaction::Methods& trx, std::string const&
 
   VPackBuilder reqBuilder;
 
+  auto cluster =
+      application_features::ApplicationServer::getFeature<ClusterFeature>("Cluster");
+  InsertCoalescer* coalescer = cluster->insertCoalescer();
+  if (!useMultiple && !isManaged && coalescer != nullptr &&
+      !ClusterTrxMethods::isElCheapo(trx)) {
+    // a standalone single-document insert. merge it with concurrent inserts
+    // into the same shard
+    TRI_ASSERT(shardMap.size() == 1);
+    auto const& it = *shardMap.begin();
+    TRI_ASSERT(it.second.size() == 1);
+    auto const& idx = it.second.front();
+    VPackSlice document = slice;
+    if (!idx.second.empty()) {
+      reqBuilder.openObject();
+      reqBuilder.add(StaticStrings::KeyString, VPackValue(idx.second));
+      TRI_SanitizeObject(slice, reqBuilder);
+      reqBuilder.close();
+      document = reqBuilder.slice();
+    }
+    // this function is synchronous, so the caller waits for the answer to
+    // its own document. sending and splitting up the batch is left to the
+    // continuations of the coalescer
+    InsertCoalescer::Result res =
+        coalescer
+            ->insert(it.first, baseUrl + StringUtils::urlEncode(it.first) + optsUrlPart, document)
+            .get();
+    if (res.commError == TRI_ERROR_NO_ERROR) {
+      responseCode = res.responseCode;
+      resultBody = std::move(res.body);
+    }
+    return res.commError;
+  }
+
   // Now prepare the requests:
   std::vector<ClusterCommRequest> requests;
   std::shared_ptr<std::string> body;
@@ -1671,14 +2028,11 @@ int getDocumentOnCoordinator(arangodb::transaction::Methods& trx, std::string co
   int res = TRI_ERROR_NO_ERROR;
   bool canUseFastPath = true;
   if (useMultiple) {
-    for (VPackSlice value : VPackArrayIterator(slice)) {
-      res = distributeBabyOnShards(shardMap, ci, collid, collinfo, reverseMapping, value);
-      if (res != TRI_ERROR_NO_ERROR) {
-        canUseFastPath = false;
-        shardMap.clear();
-        reverseMapping.clear();
-        break;
-      }
+    res = distributeBabiesOnShards(shardMap, collinfo, reverseMapping, slice);
+    if (res != TRI_ERROR_NO_ERROR) {
+      canUseFastPath = false;
+      shardMap.clear();
+      reverseMapping.clear();
     }
   } else {
     res = distributeBabyOnShards(shardMap, ci, collid, collinfo, reverseMapping, slice);
@@ -1725,10 +2079,16 @@ int getDocumentOnCoordinator(arangodb::transaction::Methods& trx, std::string co
 
     VPackBuilder reqBuilder;
 
+    // followers can only serve reads outside of transactions, which only
+    // exist on the leaders
+    bool const followerReads = options.allowDirtyReads && !ClusterTrxMethods::isElCheapo(trx);
+
     // Now prepare the requests:
     std::vector<ClusterCommRequest> requests;
+    std::vector<ShardID> requestShards;
     auto body = std::make_shared<std::string>();
     for (auto const& it : shardMap) {
+      requestShards.emplace_back(it.first);
       if (!useMultiple) {
         TRI_ASSERT(it.second.size() == 1);
         auto headers = std::make_unique<std::unordered_map<std::string, std::string>>();
@@ -1743,7 +2103,9 @@ int getDocumentOnCoordinator(arangodb::transaction::Methods& trx, std::string co
         }
 
         // We send to single endpoint
-        requests.emplace_back("shard:" + it.first, reqType,
+        std::string destination =
+            readDestination(ci, it.first, options, followerReads, *headers);
+        requests.emplace_back(destination, reqType,
                               baseUrl + StringUtils::urlEncode(it.first) + "/" +
                                   StringUtils::urlEncode(keySlice.copyString()) + optsUrlPart,
                               body, std::move(headers));
@@ -1758,15 +2120,16 @@ int getDocumentOnCoordinator(arangodb::transaction::Methods& trx, std::string co
         auto headers = std::make_unique<std::unordered_map<std::string, std::string>>();
         addTransactionHeaderForShard(trx, *shardIds, /*shard*/ it.first, *headers);
         // We send to Babies endpoint
-        requests.emplace_back("shard:" + it.first, reqType,
+        std::string destination =
+            readDestination(ci, it.first, options, followerReads, *headers);
+        requests.emplace_back(destination, reqType,
                               baseUrl + StringUtils::urlEncode(it.first) + optsUrlPart,
                               body, std::move(headers));
       }
     }
 
     // Perform the requests
-    cc->performRequests(requests, CL_DEFAULT_TIMEOUT, Logger::COMMUNICATION,
-                        /*retryOnCollNotFound*/ true, /*retryOnBackUnvlbl*/ !isManaged);
+    performReadRequests(*cc, requests, requestShards, isManaged);
 
     // Now listen to the results:
     if (!useMultiple) {
@@ -2001,6 +2364,109 @@ int fetchEdgesFromEngines(std::string const& dbname,
   return TRI_ERROR_NO_ERROR;
 }
 
+/// @brief fetch edges from TraverserEngines, grouped by vertex
+///        Contacts all TraverserEngines placed
+///        on the DBServers for the given array
+///        of vertex _id's. result[i] receives
+///        the edges of the i-th vertex id.
+
+int fetchGroupedEdgesFromEngines(
+    std::string const& dbname,
+    std::unordered_map<ServerID, traverser::TraverserEngineID> const* engines,
+    VPackSlice const vertexIds, size_t depth,
+    std::unordered_map<arangodb::velocypack::StringRef, VPackSlice>& cache,
+    std::vector<std::vector<VPackSlice>>& result,
+    std::vector<std::shared_ptr<VPackBuilder>>& datalake,
+    VPackBuilder& builder, size_t& filtered, size_t& read) {
+  auto cc = ClusterComm::instance();
+  if (cc == nullptr) {
+    // nullptr happens only during controlled shutdown
+    return TRI_ERROR_SHUTTING_DOWN;
+  }
+
+  TRI_ASSERT(vertexIds.isArray());
+  size_t const n = vertexIds.length();
+  builder.clear();
+  builder.openObject();
+  builder.add("depth", VPackValue(depth));
+  builder.add("keys", vertexIds);
+  builder.add("grouped", VPackValue(true));
+  builder.close();
+
+  std::string const url =
+      "/_db/" + StringUtils::urlEncode(dbname) + "/_internal/traverser/edge/";
+
+  std::vector<ClusterCommRequest> requests;
+  auto body = std::make_shared<std::string>(builder.toJson());
+  for (auto const& engine : *engines) {
+    requests.emplace_back("server:" + engine.first, RequestType::PUT,
+                          url + StringUtils::itoa(engine.second), body);
+  }
+
+  // Perform the requests
+  cc->performRequests(requests, CL_DEFAULT_TIMEOUT, Logger::COMMUNICATION,
+                      /*retryOnCollNotFound*/ false);
+
+  result.clear();
+  result.resize(n);
+  for (auto const& req : requests) {
+    bool allCached = true;
+    auto res = req.result;
+    int commError = handleGeneralCommErrors(&res);
+    if (commError != TRI_ERROR_NO_ERROR) {
+      // oh-oh cluster is in a bad state
+      return commError;
+    }
+    TRI_ASSERT(res.answer != nullptr);
+    auto resBody = res.answer->toVelocyPackBuilderPtrNoUniquenessChecks();
+    VPackSlice resSlice = resBody->slice();
+    if (!resSlice.isObject()) {
+      // Response has invalid format
+      return TRI_ERROR_HTTP_CORRUPTED_JSON;
+    }
+    filtered +=
+        arangodb::basics::VelocyPackHelper::getNumericValue<size_t>(resSlice,
+                                                                    "filtered", 0);
+    read +=
+        arangodb::basics::VelocyPackHelper::getNumericValue<size_t>(resSlice,
+                                                                    "readIndex", 0);
+    VPackSlice groups = resSlice.get("edges");
+    if (!groups.isArray() || groups.length() != n) {
+      // server does not know about grouping
+      return TRI_ERROR_HTTP_CORRUPTED_JSON;
+    }
+    size_t i = 0;
+    for (auto const& group : VPackArrayIterator(groups)) {
+      if (!group.isArray()) {
+        return TRI_ERROR_HTTP_CORRUPTED_JSON;
+      }
+      for (auto const& e : VPackArrayIterator(group)) {
+        VPackSlice id = e.get(StaticStrings::IdString);
+        if (!id.isString()) {
+          // invalid id type
+          LOG_TOPIC("0a5d3", ERR, Logger::GRAPHS)
+              << "got invalid edge id type: " << id.typeName();
+          continue;
+        }
+        arangodb::velocypack::StringRef idRef(id);
+        auto resE = cache.insert({idRef, e});
+        if (resE.second) {
+          // This edge is not yet cached.
+          allCached = false;
+          result[i].emplace_back(e);
+        } else {
+          result[i].emplace_back(resE.first->second);
+        }
+      }
+      ++i;
+    }
+    if (!allCached) {
+      datalake.emplace_back(resBody);
+    }
+  }
+  return TRI_ERROR_NO_ERROR;
+}
+
 /// @brief fetch vertices from TraverserEngines
 ///        Contacts all TraverserEngines placed
 ///        on the DBServers for the given list
@@ -2383,17 +2849,14 @@ int modifyDocumentOnCoordinator(
   int res = TRI_ERROR_NO_ERROR;
   bool canUseFastPath = true;
   if (useMultiple) {
-    for (VPackSlice value : VPackArrayIterator(slice)) {
-      res = distributeBabyOnShards(shardMap, ci, collid, collinfo, reverseMapping, value);
-      if (res != TRI_ERROR_NO_ERROR) {
-        if (!isPatch) {
-          return res;
-        }
-        canUseFastPath = false;
-        shardMap.clear();
-        reverseMapping.clear();
-        break;
+    res = distributeBabiesOnShards(shardMap, collinfo, reverseMapping, slice);
+    if (res != TRI_ERROR_NO_ERROR) {
+      if (!isPatch) {
+        return res;
       }
+      canUseFastPath = false;
+      shardMap.clear();
+      reverseMapping.clear();
     }
   } else {
     res = distributeBabyOnShards(shardMap, ci, collid, collinfo, reverseMapping, slice);
@@ -2620,13 +3083,11 @@ int modifyDocumentOnCoordinator(
 
 int flushWalOnAllDBServers(bool waitForSync, bool waitForCollector, double maxWaitTime) {
   ClusterInfo* ci = ClusterInfo::instance();
-  auto cc = ClusterComm::instance();
-  if (cc == nullptr) {
+  if (NetworkFeature::pool() == nullptr) {
     // nullptr happens only during controlled shutdown
     return TRI_ERROR_SHUTTING_DOWN;
   }
   std::vector<ServerID> DBservers = ci->getCurrentDBServers();
-  CoordTransactionID coordTransactionID = TRI_NewTickServer();
   std::string url = std::string("/_admin/wal/flush?waitForSync=") +
                     (waitForSync ? "true" : "false") +
                     "&waitForCollector=" + (waitForCollector ? "true" : "false");
@@ -2634,35 +3095,36 @@ int flushWalOnAllDBServers(bool waitForSync, bool waitForCollector, double maxWa
     url += "&maxWaitTime=" + std::to_string(maxWaitTime);
   }
 
-  auto body = std::make_shared<std::string const>();
-  std::unordered_map<std::string, std::string> headers;
-  for (auto it = DBservers.begin(); it != DBservers.end(); ++it) {
-    // set collection name (shard id)
-    cc->asyncRequest(coordTransactionID, "server:" + *it, arangodb::rest::RequestType::PUT,
-                     url, body, headers, nullptr, 120.0);
+  std::vector<network::FutureRes> futures;
+  futures.reserve(DBservers.size());
+  for (auto const& server : DBservers) {
+    futures.emplace_back(network::sendRequest("server:" + server, fuerte::RestVerb::Put,
+                                              url, VPackBuffer<uint8_t>(),
+                                              network::Timeout(120.0)));
   }
 
   // Now listen to the results:
-  int count;
   int nrok = 0;
   int globalErrorCode = TRI_ERROR_INTERNAL;
-  for (count = (int)DBservers.size(); count > 0; count--) {
-    auto res = cc->wait(coordTransactionID, 0, "", 0.0);
-    if (res.status == CL_COMM_RECEIVED) {
-      if (res.answer_code == arangodb::rest::ResponseCode::OK) {
-        nrok++;
-      } else {
-        // got an error. Now try to find the errorNum value returned (if any)
-        TRI_ASSERT(res.answer != nullptr);
-        auto resBody = res.answer->toVelocyPackBuilderPtr();
-        VPackSlice resSlice = resBody->slice();
-        if (resSlice.isObject()) {
-          int code = arangodb::basics::VelocyPackHelper::getNumericValue<int>(
-              resSlice, "errorNum", TRI_ERROR_INTERNAL);
-
-          if (code != TRI_ERROR_NO_ERROR) {
-            globalErrorCode = code;
-          }
+  for (auto& tryRes : futures::collectAll(futures).get()) {
+    if (!tryRes.hasValue()) {
+      continue;
+    }
+    network::Response const& res = tryRes.get();
+    if (!res.ok()) {
+      continue;
+    }
+    if (res.statusCode() == fuerte::StatusOK) {
+      nrok++;
+    } else {
+      // got an error. Now try to find the errorNum value returned (if any)
+      VPackSlice resSlice = res.response->slice();
+      if (resSlice.isObject()) {
+        int code = arangodb::basics::VelocyPackHelper::getNumericValue<int>(
+            resSlice, "errorNum", TRI_ERROR_INTERNAL);
+
+        if (code != TRI_ERROR_NO_ERROR) {
+          globalErrorCode = code;
         }
       }
     }
@@ -2896,6 +3358,8 @@ std::vector<std::shared_ptr<LogicalCollection>> ClusterMethods::persistCollectio
   std::vector<std::shared_ptr<VPackBuffer<uint8_t>>> vpackData;
   infos.reserve(collections.size());
   vpackData.reserve(collections.size());
+  // collections of this batch that already have their shards, by name
+  std::unordered_map<std::string, LogicalCollection const*> batch;
   for (auto& col : collections) {
     // We can only serve on Database at a time with this call.
     // We have the vocbase context around this calls anyways, so this is save.
@@ -2904,7 +3368,13 @@ std::vector<std::shared_ptr<LogicalCollection>> ClusterMethods::persistCollectio
     std::vector<std::string> avoid = col->avoidServers();
     std::shared_ptr<std::unordered_map<std::string, std::vector<std::string>>> shards = nullptr;
 
-    if (!distributeShardsLike.empty()) {
+    auto inBatch = distributeShardsLike.empty() ? batch.end() : batch.find(distributeShardsLike);
+
+    if (inBatch != batch.end()) {
+      // the prototype is created along with this collection, so it is
+      // not yet in the plan
+      shards = CloneShardDistributionInBatch(ci, col.get(), *inBatch->second);
+    } else if (!distributeShardsLike.empty()) {
       CollectionNameResolver resolver(col->vocbase());
       TRI_voc_cid_t otherCid = resolver.getCollectionIdCluster(distributeShardsLike);
 
@@ -2966,6 +3436,7 @@ std::vector<std::shared_ptr<LogicalCollection>> ClusterMethods::persistCollectio
     }
 
     col->setShardMap(shards);
+    batch.emplace(col->name(), col.get());
 
     std::unordered_set<std::string> const ignoreKeys{
         "allowUserKeys", "cid",     "globallyUniqueId", "count",
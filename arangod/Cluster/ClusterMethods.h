@@ -75,6 +75,15 @@ bool smartJoinAttributeChanged(LogicalCollection const& collection, VPackSlice c
 int revisionOnCoordinator(std::string const& dbname,
                           std::string const& collname, TRI_voc_rid_t&);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the invalidation ticks of shards, with one request per
+/// DB server. shards that could not be asked are missing in the result
+////////////////////////////////////////////////////////////////////////////////
+
+int invalidationTicksOnCoordinator(std::string const& dbname,
+                                   std::vector<ShardID> const& shards,
+                                   std::unordered_map<ShardID, uint64_t>& ticks);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief Warmup index caches on Shards
 ////////////////////////////////////////////////////////////////////////////////
@@ -95,6 +104,15 @@ int figuresOnCoordinator(std::string const& dbname, std::string const& collname,
 int countOnCoordinator(transaction::Methods& trx, std::string const& collname,
                        std::vector<std::pair<std::string, uint64_t>>& result);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief approximate number of documents by shard, from the counts the
+/// shard leaders report to Current. does not contact any DB server. fails
+/// if a shard has not reported its count yet
+////////////////////////////////////////////////////////////////////////////////
+
+int approximateCountOnCoordinator(std::string const& dbname, std::string const& collname,
+                                  std::vector<std::pair<std::string, uint64_t>>& result);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief gets the selectivity estimates from DBservers
 ////////////////////////////////////////////////////////////////////////////////
@@ -175,6 +193,24 @@ int fetchEdgesFromEngines(
     std::vector<std::shared_ptr<arangodb::velocypack::Builder>>& datalake,
     arangodb::velocypack::Builder& builder, size_t& read);
 
+/// @brief fetch edges from TraverserEngines, grouped by vertex
+///        Contacts all TraverserEngines placed
+///        on the DBServers for the given array
+///        of vertex _id's. result[i] receives
+///        the edges of the i-th vertex id, from
+///        all servers combined. Slices point into
+///        the datalake, as above.
+///        TraversalVariant
+
+int fetchGroupedEdgesFromEngines(
+    std::string const& dbname,
+    std::unordered_map<ServerID, traverser::TraverserEngineID> const* engines,
+    arangodb::velocypack::Slice vertexIds, size_t depth,
+    std::unordered_map<arangodb::velocypack::StringRef, arangodb::velocypack::Slice>& cache,
+    std::vector<std::vector<arangodb::velocypack::Slice>>& result,
+    std::vector<std::shared_ptr<arangodb::velocypack::Builder>>& datalake,
+    arangodb::velocypack::Builder& builder, size_t& filtered, size_t& read);
+
 /// @brief fetch vertices from TraverserEngines
 ///        Contacts all TraverserEngines placed
 ///        on the DBServers for the given list
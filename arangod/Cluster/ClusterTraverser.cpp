@@ -22,14 +22,18 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "ClusterTraverser.h"
+#include "Aql/Query.h"
 #include "Basics/StaticStrings.h"
 #include "Basics/VelocyPackHelper.h"
 #include "Cluster/ClusterComm.h"
 #include "Cluster/ClusterMethods.h"
 #include "Graph/BreadthFirstEnumerator.h"
 #include "Graph/ClusterTraverserCache.h"
+#include "Graph/CoordinatorVertexCache.h"
 #include "Graph/TraverserCache.h"
+#include "StorageEngine/TransactionState.h"
 #include "Transaction/Helpers.h"
+#include "Transaction/Methods.h"
 
 #include <velocypack/Iterator.h>
 #include <velocypack/velocypack-aliases.h>
@@ -50,6 +54,8 @@ ClusterTraverser::ClusterTraverser(arangodb::traverser::TraverserOptions* opts,
 
 void ClusterTraverser::setStartVertex(std::string const& vid) {
   _verticesToFetch.clear();
+  // the edge conditions may depend on the input row
+  static_cast<ClusterTraverserCache*>(traverserCache())->clearPrefetchedEdges();
   _startIdBuilder.clear();
   _startIdBuilder.add(VPackValue(vid));
   VPackSlice idSlice = _startIdBuilder.slice();
@@ -110,13 +116,85 @@ bool ClusterTraverser::getSingleVertex(arangodb::velocypack::Slice edge,
 void ClusterTraverser::fetchVertices() {
   auto ch = static_cast<ClusterTraverserCache*>(traverserCache());
   ch->insertedDocuments() += _verticesToFetch.size();
-  transaction::BuilderLeaser lease(_trx);
-  fetchVerticesFromEngines(_dbname, _engines, _verticesToFetch, _vertices,
-                           *(lease.get()));
-  _verticesToFetch.clear();
-  if (_enumerator != nullptr) {
-    _enumerator->incHttpRequests(_engines->size()); 
+
+  // vertices not found in the shared cache, stored there once fetched
+  std::vector<std::pair<arangodb::velocypack::StringRef, uint64_t>> toStore;
+  CoordinatorVertexCache* cache = vertexCache();
+  if (cache != nullptr) {
+    for (auto it = _verticesToFetch.begin(); it != _verticesToFetch.end();) {
+      uint64_t tick;
+      if (!vertexCollectionTick(*it, tick)) {
+        ++it;
+        continue;
+      }
+      auto document = cache->lookup(_dbname, *it, tick);
+      if (document == nullptr) {
+        toStore.emplace_back(*it, tick);
+        ++it;
+        continue;
+      }
+      // the key must point into the buffer, like for fetched vertices
+      VPackSlice id = VPackSlice(document->data()).get(StaticStrings::IdString);
+      TRI_ASSERT(id.isString());
+      _vertices.emplace(arangodb::velocypack::StringRef(id), std::move(document));
+      it = _verticesToFetch.erase(it);
+    }
+  }
+
+  if (!_verticesToFetch.empty()) {
+    transaction::BuilderLeaser lease(_trx);
+    fetchVerticesFromEngines(_dbname, _engines, _verticesToFetch, _vertices,
+                             *(lease.get()));
+    _verticesToFetch.clear();
+    if (_enumerator != nullptr) {
+      _enumerator->incHttpRequests(_engines->size());
+    }
+  }
+
+  for (auto const& it : toStore) {
+    auto fetched = _vertices.find(it.first);
+    if (fetched != _vertices.end()) {
+      VPackSlice document(fetched->second->data());
+      if (document.isObject()) {
+        cache->store(_dbname, it.first, it.second, document);
+      }
+    }
+  }
+}
+
+CoordinatorVertexCache* ClusterTraverser::vertexCache() {
+  CoordinatorVertexCache* cache = CoordinatorVertexCache::instance();
+  if (cache == nullptr) {
+    return nullptr;
+  }
+  aql::Query* query = _opts->query();
+  // writes of the query's own transaction are not reflected by the ticks
+  if (query == nullptr || query->isModificationQuery() ||
+      query->shardTicks() == nullptr || !_trx->state()->isReadOnlyTransaction()) {
+    return nullptr;
+  }
+  return cache;
+}
+
+bool ClusterTraverser::vertexCollectionTick(arangodb::velocypack::StringRef id,
+                                            uint64_t& tick) {
+  size_t pos = id.find('/');
+  if (pos == std::string::npos) {
+    return false;
+  }
+  std::string collection(id.data(), pos);
+  auto it = _vertexCollectionTicks.find(collection);
+  if (it == _vertexCollectionTicks.end()) {
+    uint64_t collectionTick = 0;
+    bool known = CoordinatorVertexCache::collectionTick(_dbname, collection,
+                                                        *_opts->query()->shardTicks(),
+                                                        collectionTick);
+    it = _vertexCollectionTicks
+             .emplace(std::move(collection), std::make_pair(known, collectionTick))
+             .first;
   }
+  tick = it->second.second;
+  return it->second.first;
 }
 
 aql::AqlValue ClusterTraverser::fetchVertexData(arangodb::velocypack::StringRef idString) {
@@ -31,6 +31,9 @@
 
 namespace arangodb {
 class CollectionNameResolver;
+namespace graph {
+class CoordinatorVertexCache;
+}
 namespace transaction {
 class Methods;
 }
@@ -85,6 +88,13 @@ class ClusterTraverser final : public Traverser {
  private:
   void fetchVertices();
 
+  /// @brief the shared vertex cache, if the query may use it
+  graph::CoordinatorVertexCache* vertexCache();
+
+  /// @brief the write tick of the vertex's collection when the query was
+  /// instantiated. returns false if it is unknown
+  bool vertexCollectionTick(arangodb::velocypack::StringRef id, uint64_t& tick);
+
   std::unordered_map<arangodb::velocypack::StringRef, std::shared_ptr<arangodb::velocypack::Buffer<uint8_t>>> _vertices;
 
   std::string _dbname;
@@ -92,6 +102,9 @@ class ClusterTraverser final : public Traverser {
   std::unordered_map<ServerID, traverser::TraverserEngineID> const* _engines;
 
   std::unordered_set<arangodb::velocypack::StringRef> _verticesToFetch;
+
+  /// @brief write ticks of the vertex collections, false if unknown
+  std::unordered_map<std::string, std::pair<bool, uint64_t>> _vertexCollectionTicks;
 };
 
 }  // namespace traverser
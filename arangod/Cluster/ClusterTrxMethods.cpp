@@ -218,8 +218,11 @@ Result commitAbortTransaction(transaction::Methods& trx, transaction::Status sta
   }
   TRI_voc_tid_t tidPlus = state.id() + 1;
   // std::vector<ServerID> DBservers = ci->getCurrentDBServers();
-  const std::string path = "/_db/" + StringUtils::urlEncode(state.vocbase().name()) +
-                           "/_api/transaction/" + std::to_string(tidPlus);
+  std::string path = "/_db/" + StringUtils::urlEncode(state.vocbase().name()) +
+                     "/_api/transaction/" + std::to_string(tidPlus);
+  if (status == transaction::Status::COMMITTED && state.waitForSync()) {
+    path.append("?waitForSync=true");
+  }
 
   RequestType rtype;
   if (status == transaction::Status::COMMITTED) {
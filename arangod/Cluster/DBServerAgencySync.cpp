@@ -35,6 +35,7 @@
 #include "Logger/Logger.h"
 #include "RestServer/DatabaseFeature.h"
 #include "RestServer/SystemDatabaseFeature.h"
+#include "Statistics/MaintenanceStatistics.h"
 #include "Utils/DatabaseGuard.h"
 #include "VocBase/LogicalCollection.h"
 #include "VocBase/Methods/Databases.h"
@@ -178,8 +179,16 @@ DBServerAgencySyncResult DBServerAgencySync::execute() {
     return result;
   }
 
+  // seconds since the given time point
+  auto since = [](clock::time_point start) {
+    return duration<double>(clock::now() - start).count();
+  };
+
+  auto start = clock::now();
   VPackBuilder local;
   Result glc = getLocalCollections(local);
+  MaintenanceStatistics::addPhaseTime(MaintenanceStatistics::Phase::LOCAL_COLLECTIONS,
+                                      since(start));
   if (!glc.ok()) {
     // FIXMEMAINTENANCE: if this fails here, then result is empty, is this
     // intended? I also notice that there is another Result object "tmp"
@@ -190,7 +199,6 @@ DBServerAgencySyncResult DBServerAgencySync::execute() {
     return result;
   }
 
-  auto start = clock::now();
   try {
     // in previous life handlePlanChange
 
@@ -201,6 +209,9 @@ DBServerAgencySyncResult DBServerAgencySync::execute() {
     tmp = arangodb::maintenance::phaseOne(plan->slice(), local.slice(),
                                           serverId, *mfeature, rb);
     auto endTimePhaseOne = std::chrono::steady_clock::now();
+    MaintenanceStatistics::addPhaseTime(
+        MaintenanceStatistics::Phase::PHASE_ONE,
+        duration<double>(endTimePhaseOne - startTimePhaseOne).count());
     LOG_TOPIC("93f83", DEBUG, Logger::MAINTENANCE)
         << "DBServerAgencySync::phaseOne done";
 
@@ -226,7 +237,10 @@ DBServerAgencySyncResult DBServerAgencySync::execute() {
         << "DBServerAgencySync::phaseTwo - current state: " << current->toJson();
 
     local.clear();
+    auto startTimeLocal = clock::now();
     glc = getLocalCollections(local);
+    MaintenanceStatistics::addPhaseTime(MaintenanceStatistics::Phase::LOCAL_COLLECTIONS,
+                                        since(startTimeLocal));
     // We intentionally refetch local collections here, such that phase 2
     // can already see potential changes introduced by phase 1. The two
     // phases are sufficiently independent that this is OK.
@@ -239,8 +253,11 @@ DBServerAgencySyncResult DBServerAgencySync::execute() {
 
     LOG_TOPIC("652ff", DEBUG, Logger::MAINTENANCE) << "DBServerAgencySync::phaseTwo";
 
+    auto startTimePhaseTwo = clock::now();
     tmp = arangodb::maintenance::phaseTwo(plan->slice(), current->slice(),
                                           local.slice(), serverId, *mfeature, rb);
+    MaintenanceStatistics::addPhaseTime(MaintenanceStatistics::Phase::PHASE_TWO,
+                                        since(startTimePhaseTwo));
 
     LOG_TOPIC("dfc54", DEBUG, Logger::MAINTENANCE)
         << "DBServerAgencySync::phaseTwo done";
@@ -285,7 +302,10 @@ DBServerAgencySyncResult DBServerAgencySync::execute() {
                                                AgencySimpleOperationType::INCREMENT_OP));
 
           AgencyWriteTransaction currentTransaction(operations, preconditions);
+          auto startTimeReport = clock::now();
           AgencyCommResult r = comm.sendTransactionWithFailover(currentTransaction);
+          MaintenanceStatistics::addPhaseTime(MaintenanceStatistics::Phase::REPORT,
+                                              since(startTimeReport));
           if (!r.successful()) {
             LOG_TOPIC("d73b8", INFO, Logger::MAINTENANCE)
               << "Error reporting to agency: _statusCode: " << r.errorCode()
@@ -316,7 +336,8 @@ DBServerAgencySyncResult DBServerAgencySync::execute() {
     result.errorMessage = "Report from phase 1 and 2 was not closed.";
   }
 
-  auto took = duration<double>(clock::now() - start).count();
+  auto took = since(start);
+  MaintenanceStatistics::addPhaseTime(MaintenanceStatistics::Phase::TOTAL, took);
   if (took > 30.0) {
     LOG_TOPIC("83cb8", WARN, Logger::MAINTENANCE) << "DBServerAgencySync::execute "
                                             "took "
@@ -27,10 +27,12 @@
 #include "EnsureIndex.h"
 
 #include "ApplicationFeatures/ApplicationServer.h"
+#include "Basics/ScopeGuard.h"
 #include "Basics/StaticStrings.h"
 #include "Basics/VelocyPackHelper.h"
 #include "Cluster/ClusterFeature.h"
 #include "Cluster/MaintenanceFeature.h"
+#include "Indexes/IndexBuildProgress.h"
 #include "Utils/DatabaseGuard.h"
 #include "VocBase/Methods/Collections.h"
 #include "VocBase/Methods/Databases.h"
@@ -115,8 +117,22 @@ bool EnsureIndex::first() {
       body.add(VPackObjectIterator(props));
     }
 
+    // the progress of the build is reported in Current, until it is done
+    auto progress = std::make_shared<IndexBuildProgress>(_feature.indexWriteRate());
+    _feature.storeIndexBuild(database, collection, shard, id, progress);
+    auto unregister = scopeGuard([&]() {
+      try {
+        _feature.storeIndexBuild(database, collection, shard, id, nullptr);
+      } catch (...) {
+      }
+    });
+
     VPackBuilder index;
-    _result = methods::Indexes::ensureIndex(col.get(), body.slice(), true, index);
+    {
+      IndexBuildProgressScope scope(progress.get());
+      _result = methods::Indexes::ensureIndex(col.get(), body.slice(), true, index);
+    }
+    unregister.fire();
 
     if (_result.ok()) {
       VPackSlice created = index.slice().get("isNewlyCreated");
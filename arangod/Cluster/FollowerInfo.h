@@ -40,10 +40,15 @@ class FollowerInfo {
   std::string _theLeader;
   // if the latter is empty, then we are leading
   bool _theLeaderTouched;
+  // as a follower: HLC time stamp up to which we have the leader's data
+  std::atomic<uint64_t> _appliedTimestamp;
 
  public:
   explicit FollowerInfo(arangodb::LogicalCollection* d)
-      : _followers(new std::vector<ServerID>()), _docColl(d), _theLeaderTouched(false) {}
+      : _followers(new std::vector<ServerID>()),
+        _docColl(d),
+        _theLeaderTouched(false),
+        _appliedTimestamp(0) {}
 
   //////////////////////////////////////////////////////////////////////////////
   /// @brief get information about current followers of a shard.
@@ -109,6 +114,31 @@ class FollowerInfo {
     MUTEX_LOCKER(locker, _mutex);
     return _theLeaderTouched;
   }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief as a follower, the HLC time stamp up to which all operations
+  /// the leader has acknowledged are applied locally. 0 while we are not
+  /// known to be in sync, in which case reads must go to the leader
+  //////////////////////////////////////////////////////////////////////////////
+
+  uint64_t appliedTimestamp() const { return _appliedTimestamp.load(); }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief advance the applied time stamp, it never moves backwards
+  //////////////////////////////////////////////////////////////////////////////
+
+  void advanceAppliedTimestamp(uint64_t timestamp) {
+    uint64_t current = _appliedTimestamp.load();
+    while (current < timestamp &&
+           !_appliedTimestamp.compare_exchange_weak(current, timestamp)) {
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief forget the applied time stamp when getting (back) in sync
+  //////////////////////////////////////////////////////////////////////////////
+
+  void resetAppliedTimestamp() { _appliedTimestamp.store(0); }
 };
 }  // end namespace arangodb
 
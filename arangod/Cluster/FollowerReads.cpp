@@ -0,0 +1,123 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "FollowerReads.h"
+
+#include "Basics/HybridLogicalClock.h"
+#include "Basics/ReadLocker.h"
+#include "Basics/ReadWriteLock.h"
+#include "Basics/WriteLocker.h"
+#include "VocBase/ticks.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::basics;
+
+namespace {
+/// @brief protects appliedTimestamps
+ReadWriteLock timestampsLock;
+
+struct FollowerState {
+  FollowerState() : applied(0), lag(0.0) {}
+
+  // the newest time stamp reported
+  uint64_t applied;
+  // the distance of the time stamp to the local clock on arrival, in seconds
+  double lag;
+};
+
+/// @brief the last reported state per shard and follower
+std::unordered_map<ShardID, std::unordered_map<ServerID, FollowerState>> appliedTimestamps;
+
+/// @brief spreads the reads over the followers of a shard
+std::atomic<uint64_t> nextFollower(0);
+}  // namespace
+
+ServerID FollowerReads::selectFollower(ShardID const& shard,
+                                       std::vector<ServerID> const& servers,
+                                       uint64_t timestamp) {
+  if (servers.size() < 2) {
+    return ServerID();
+  }
+
+  std::vector<ServerID const*> candidates;
+  candidates.reserve(servers.size() - 1);
+  {
+    READ_LOCKER(guard, timestampsLock);
+    auto it = appliedTimestamps.find(shard);
+    for (size_t i = 1; i < servers.size(); ++i) {
+      if (timestamp != 0 && it != appliedTimestamps.end()) {
+        auto it2 = it->second.find(servers[i]);
+        if (it2 != it->second.end() && it2->second.applied < timestamp) {
+          // the follower will refuse the read, unless it has caught up
+          // in the meantime. try the others first
+          continue;
+        }
+      }
+      candidates.emplace_back(&servers[i]);
+    }
+  }
+
+  if (candidates.empty()) {
+    return ServerID();
+  }
+  return *candidates[nextFollower.fetch_add(1, std::memory_order_relaxed) %
+                     candidates.size()];
+}
+
+void FollowerReads::reportApplied(ShardID const& shard, ServerID const& server,
+                                  uint64_t appliedTimestamp) {
+  // the physical part of the time stamps is in milliseconds
+  uint64_t const now = HybridLogicalClock::extractTime(TRI_HybridLogicalClock());
+  uint64_t const applied = HybridLogicalClock::extractTime(appliedTimestamp);
+  double const lag = now > applied ? static_cast<double>(now - applied) / 1000.0 : 0.0;
+
+  WRITE_LOCKER(guard, timestampsLock);
+  FollowerState& state = appliedTimestamps[shard][server];
+  // reports of concurrent reads can arrive in any order
+  if (appliedTimestamp >= state.applied) {
+    state.applied = appliedTimestamp;
+    state.lag = lag;
+  }
+}
+
+void FollowerReads::toVelocyPack(VPackBuilder& builder) {
+  std::unordered_map<ServerID, double> lag;
+  {
+    READ_LOCKER(guard, timestampsLock);
+    for (auto const& shard : appliedTimestamps) {
+      for (auto const& follower : shard.second) {
+        double& value = lag[follower.first];
+        value = std::max(value, follower.second.lag);
+      }
+    }
+  }
+
+  for (auto const& it : lag) {
+    builder.add(it.first, VPackValue(it.second));
+  }
+}
+
+void FollowerReads::clear() {
+  WRITE_LOCKER(guard, timestampsLock);
+  appliedTimestamps.clear();
+}
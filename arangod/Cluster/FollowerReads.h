@@ -0,0 +1,60 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_CLUSTER_FOLLOWER_READS_H
+#define ARANGOD_CLUSTER_FOLLOWER_READS_H 1
+
+#include "Basics/Common.h"
+#include "Cluster/ClusterInfo.h"
+
+namespace arangodb {
+namespace velocypack {
+class Builder;
+}
+
+/// @brief what a coordinator knows about the followers it reads from.
+/// followers report the HLC time stamp up to which they have applied the
+/// operations of their leader, the distance to the local clock is their
+/// replication lag
+class FollowerReads {
+ public:
+  /// @brief picks one of the followers of a shard, given the servers of
+  /// the shard in Current with the leader first. followers that are known
+  /// to be behind the time stamp are skipped. returns an empty string if
+  /// the read has to go to the leader
+  static ServerID selectFollower(ShardID const& shard,
+                                 std::vector<ServerID> const& servers,
+                                 uint64_t timestamp);
+
+  /// @brief records the time stamp a follower has reported for a shard
+  static void reportApplied(ShardID const& shard, ServerID const& server,
+                            uint64_t appliedTimestamp);
+
+  /// @brief adds the largest lag (in seconds) of every follower known, as
+  /// of its last report, to the builder, which must contain an open object
+  static void toVelocyPack(velocypack::Builder& builder);
+
+  /// @brief forgets everything, for testing
+  static void clear();
+};
+
+}  // namespace arangodb
+
+#endif
@@ -0,0 +1,251 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "InsertCoalescer.h"
+
+#include "Basics/Exceptions.h"
+#include "Basics/StaticStrings.h"
+#include "Basics/VelocyPackHelper.h"
+#include "Network/Methods.h"
+#include "Rest/GeneralResponse.h"
+#include "Scheduler/SchedulerExecutor.h"
+#include "Scheduler/SchedulerFeature.h"
+
+#include <fuerte/types.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+namespace {
+// same timeout the uncoalesced insert is using
+static double const CL_DEFAULT_LONG_TIMEOUT = 900.0;
+
+futures::Future<InsertCoalescer::Result> sendToShard(ShardID const& shard,
+                                                     std::string const& url,
+                                                     VPackSlice body) {
+  VPackBuffer<uint8_t> payload;
+  payload.append(body.start(), body.byteSize());
+  // the I/O thread only hands the answer over, the scheduler splits it up
+  return network::sendRequest("shard:" + shard, fuerte::RestVerb::Post, url,
+                              std::move(payload), network::Timeout(CL_DEFAULT_LONG_TIMEOUT))
+      .via(SchedulerExecutor::lane(RequestLane::CLUSTER_INTERNAL))
+      .thenValue([](network::Response&& res) {
+        InsertCoalescer::Result result;
+        if (!res.ok()) {
+          result.commError = res.errorCode();
+          if (result.commError == TRI_ERROR_NO_ERROR) {
+            result.commError = TRI_ERROR_CLUSTER_CONNECTION_LOST;
+          }
+          return result;
+        }
+        result.responseCode = static_cast<rest::ResponseCode>(res.statusCode());
+        result.body = std::make_shared<VPackBuilder>();
+        result.body->add(res.response->slice());
+        return result;
+      });
+}
+
+Scheduler::WorkHandle delayOnScheduler(std::chrono::microseconds delay,
+                                       std::function<void(bool)> fn) {
+  auto scheduler = SchedulerFeature::SCHEDULER;
+  if (scheduler == nullptr) {
+    fn(true);
+    return nullptr;
+  }
+  if (delay < std::chrono::milliseconds(1)) {
+    // queueDelay would post it right away as well, but drop it silently if
+    // the queue is full. the batch must be sent in any case, and sending
+    // does not block, so do it on this thread then
+    if (!scheduler->queue(RequestLane::CLUSTER_INTERNAL, [fn]() { fn(false); })) {
+      fn(false);
+    }
+    return nullptr;
+  }
+  return scheduler->queueDelay(RequestLane::CLUSTER_INTERNAL, delay, std::move(fn));
+}
+}  // namespace
+
+InsertCoalescer::InsertCoalescer(uint64_t windowMicros, uint64_t maxBatchSize)
+    : InsertCoalescer(windowMicros, maxBatchSize, ::sendToShard, ::delayOnScheduler) {}
+
+InsertCoalescer::InsertCoalescer(uint64_t windowMicros, uint64_t maxBatchSize,
+                                 SendFunction send, DelayFunction delay)
+    : _windowMicros(windowMicros),
+      _maxBatchSize(std::max<uint64_t>(maxBatchSize, 1)),
+      _send(std::move(send)),
+      _delay(std::move(delay)) {}
+
+futures::Future<InsertCoalescer::Result> InsertCoalescer::insert(ShardID const& shard,
+                                                                 std::string const& url,
+                                                                 VPackSlice document) {
+  futures::Promise<Result> promise;
+  futures::Future<Result> future = promise.getFuture();
+
+  std::shared_ptr<Batch> batch;
+  bool opened = false;
+  bool full = false;
+  {
+    std::lock_guard<std::mutex> guard(_mutex);
+    auto& slot = _open[url];
+    if (slot == nullptr) {
+      slot = std::make_shared<Batch>();
+      slot->shard = shard;
+      slot->url = url;
+      slot->documents.openArray();
+      opened = true;
+    }
+    batch = slot;
+    batch->documents.add(document);
+    batch->promises.emplace_back(std::move(promise));
+
+    if (batch->promises.size() >= _maxBatchSize) {
+      // full, send it right away
+      _open.erase(url);
+      full = true;
+    }
+  }
+
+  if (full) {
+    execute(std::move(batch));
+  } else if (opened) {
+    // the batch is sent by whoever comes first, the timer or the insert
+    // that fills it up
+    std::weak_ptr<Batch> weak = batch;
+    auto timer = _delay(std::chrono::microseconds(_windowMicros), [this, weak](bool canceled) {
+      std::shared_ptr<Batch> batch = weak.lock();
+      if (batch == nullptr) {
+        return;
+      }
+      {
+        std::lock_guard<std::mutex> guard(_mutex);
+        auto it = _open.find(batch->url);
+        if (it == _open.end() || it->second != batch) {
+          // sent already
+          return;
+        }
+        _open.erase(it);
+      }
+      if (canceled) {
+        Result result;
+        result.commError = TRI_ERROR_SHUTTING_DOWN;
+        distribute(*batch, std::move(result));
+      } else {
+        execute(std::move(batch));
+      }
+    });
+    std::lock_guard<std::mutex> guard(_mutex);
+    auto it = _open.find(url);
+    if (it != _open.end() && it->second == batch) {
+      batch->timer = std::move(timer);
+    }
+  }
+
+  return future;
+}
+
+void InsertCoalescer::execute(std::shared_ptr<Batch> batch) {
+  // nobody else touches the documents anymore
+  batch->documents.close();
+  VPackSlice documents = batch->documents.slice();
+  // a batch of one is sent as a regular single-document insert, so that the
+  // answer has exactly the same shape as without coalescing
+  VPackSlice body = (batch->promises.size() == 1) ? documents.at(0) : documents;
+
+  futures::Future<Result> answer = futures::Future<Result>::makeEmpty();
+  int res = TRI_ERROR_NO_ERROR;
+  try {
+    answer = _send(batch->shard, batch->url, body);
+  } catch (basics::Exception const& ex) {
+    res = ex.code();
+  } catch (std::bad_alloc const&) {
+    res = TRI_ERROR_OUT_OF_MEMORY;
+  } catch (...) {
+    res = TRI_ERROR_INTERNAL;
+  }
+  if (res != TRI_ERROR_NO_ERROR) {
+    Result result;
+    result.commError = res;
+    distribute(*batch, std::move(result));
+    return;
+  }
+
+  std::move(answer).thenFinal([batch](futures::Try<Result>&& t) {
+    Result result;
+    if (t.hasValue()) {
+      result = std::move(t.get());
+    } else {
+      result.commError = TRI_ERROR_INTERNAL;
+    }
+    distribute(*batch, std::move(result));
+  });
+}
+
+void InsertCoalescer::distribute(Batch& batch, Result&& answer) {
+  size_t const count = batch.promises.size();
+
+  if (answer.commError != TRI_ERROR_NO_ERROR) {
+    for (auto& p : batch.promises) {
+      Result r;
+      r.commError = answer.commError;
+      p.setValue(std::move(r));
+    }
+    return;
+  }
+
+  TRI_ASSERT(answer.body != nullptr);
+  if (count == 1) {
+    batch.promises[0].setValue(std::move(answer));
+    return;
+  }
+
+  VPackSlice slice = answer.body->slice();
+  if ((answer.responseCode != rest::ResponseCode::CREATED &&
+       answer.responseCode != rest::ResponseCode::ACCEPTED) ||
+      !slice.isArray() || slice.length() != count) {
+    // the request failed as a whole (e.g. the collection is gone), so every
+    // document gets the same answer. the callers steal from their result
+    // bodies, so each needs its own copy
+    for (auto& p : batch.promises) {
+      Result r;
+      r.responseCode = answer.responseCode;
+      r.body = std::make_shared<VPackBuilder>();
+      r.body->add(slice);
+      p.setValue(std::move(r));
+    }
+    return;
+  }
+
+  size_t i = 0;
+  for (VPackSlice entry : VPackArrayIterator(slice)) {
+    Result r;
+    r.body = std::make_shared<VPackBuilder>();
+    r.body->add(entry);
+    if (entry.isObject() &&
+        basics::VelocyPackHelper::getBooleanValue(entry, StaticStrings::Error, false)) {
+      int errorNum = basics::VelocyPackHelper::getNumericValue<int>(
+          entry, StaticStrings::ErrorNum.c_str(), TRI_ERROR_INTERNAL);
+      r.responseCode = GeneralResponse::responseCode(errorNum);
+    } else {
+      r.responseCode = answer.responseCode;
+    }
+    batch.promises[i++].setValue(std::move(r));
+  }
+}
@@ -0,0 +1,113 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_CLUSTER_INSERT_COALESCER_H
+#define ARANGOD_CLUSTER_INSERT_COALESCER_H 1
+
+#include "Basics/Common.h"
+#include "Cluster/ClusterInfo.h"
+#include "Futures/Future.h"
+#include "Futures/Promise.h"
+#include "Rest/CommonDefines.h"
+#include "Scheduler/Scheduler.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+#include <chrono>
+#include <mutex>
+#include <unordered_map>
+
+namespace arangodb {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief merges concurrent single-document inserts into the same shard.
+///
+/// The first insert for a shard opens a batch and schedules it to be sent
+/// once the coalescing window has passed. All inserts for the same shard and
+/// with the same options that arrive in the meantime are added to the batch,
+/// and a full batch is sent right away. The batch goes to the leader as one
+/// array insert, and the continuation of the request hands each caller its
+/// own result via its future. No thread waits for the window or for the
+/// answer of the leader. Only used for inserts that are not part of a
+/// larger transaction.
+////////////////////////////////////////////////////////////////////////////////
+class InsertCoalescer {
+ public:
+  struct Result {
+    int commError = TRI_ERROR_NO_ERROR;
+    rest::ResponseCode responseCode = rest::ResponseCode::SERVER_ERROR;
+    std::shared_ptr<velocypack::Builder> body;
+  };
+
+  /// @brief sends the body to the shard, an array of documents or a single
+  /// document for a batch of one. the result is the answer to the request
+  typedef std::function<futures::Future<Result>(ShardID const&, std::string const& url,
+                                                velocypack::Slice body)>
+      SendFunction;
+  /// @brief calls the function once the delay has passed, or with true if
+  /// it is canceled because the server shuts down. the call is canceled as
+  /// well if the returned handle is dropped before
+  typedef std::function<Scheduler::WorkHandle(std::chrono::microseconds,
+                                              std::function<void(bool canceled)>)>
+      DelayFunction;
+
+  /// @brief sends batches via the connection pool, and uses the scheduler
+  /// for the window
+  InsertCoalescer(uint64_t windowMicros, uint64_t maxBatchSize);
+  InsertCoalescer(uint64_t windowMicros, uint64_t maxBatchSize,
+                  SendFunction send, DelayFunction delay);
+
+  /// @brief insert a single document into the shard. url is the full
+  /// request path including the collection and option parameters. the
+  /// result has a communication error code; only if it is
+  /// TRI_ERROR_NO_ERROR, responseCode and body contain the shard's answer
+  /// for the document
+  futures::Future<Result> insert(ShardID const& shard, std::string const& url,
+                                 velocypack::Slice document);
+
+ private:
+  struct Batch {
+    ShardID shard;
+    std::string url;
+    velocypack::Builder documents;
+    std::vector<futures::Promise<Result>> promises;
+    Scheduler::WorkHandle timer;
+  };
+
+  /// @brief send a batch that nobody can add to anymore
+  void execute(std::shared_ptr<Batch> batch);
+
+  /// @brief hands each caller its result from the answer to the batch
+  static void distribute(Batch& batch, Result&& answer);
+
+ private:
+  uint64_t const _windowMicros;
+  uint64_t const _maxBatchSize;
+  SendFunction const _send;
+  DelayFunction const _delay;
+
+  std::mutex _mutex;
+  std::unordered_map<std::string, std::shared_ptr<Batch>> _open;
+};
+
+}  // namespace arangodb
+
+#endif
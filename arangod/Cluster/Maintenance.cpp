@@ -32,6 +32,7 @@
 #include "Cluster/FollowerInfo.h"
 #include "Indexes/Index.h"
 #include "Logger/Logger.h"
+#include "StorageEngine/PhysicalCollection.h"
 #include "Utils/DatabaseGuard.h"
 #include "VocBase/LogicalCollection.h"
 #include "VocBase/Methods/Databases.h"
@@ -378,6 +379,27 @@ struct NotEmpty {
   bool operator()(const std::string& s) { return !s.empty(); }
 };
 
+/// @brief whether there are pending shard or index errors in the database
+static bool hasDatabaseErrors(MaintenanceFeature::errors_t const& errors,
+                              std::string const& dbname) {
+  std::string const prefix = dbname + "/";
+  for (auto const& shard : errors.shards) {
+    if (shard.second != nullptr && shard.first.compare(0, prefix.size(), prefix) == 0) {
+      return true;
+    }
+  }
+  for (auto const& shard : errors.indexes) {
+    if (shard.first.compare(0, prefix.size(), prefix) == 0) {
+      for (auto const& index : shard.second) {
+        if (index.second != nullptr) {
+          return true;
+        }
+      }
+    }
+  }
+  return false;
+}
+
 /// @brief calculate difference between plan and local for for databases
 arangodb::Result arangodb::maintenance::diffPlanLocal(
     VPackSlice const& plan, VPackSlice const& local,
@@ -422,12 +444,25 @@ arangodb::Result arangodb::maintenance::diffPlanLocal(
     }
   }
 
+  // Databases, which needed no action in the previous run and whose plan
+  // and local state are still the same, are skipped entirely. The diff would
+  // not produce anything for them either.
+  uint64_t const seed = std::hash<std::string>()(serverId);
+  std::unordered_map<std::string, uint64_t> states;
+  std::unordered_set<std::string> skipped;
+
   // Create or modify if local collections are affected
   pdbs = plan.get(COLLECTIONS);
   for (auto const& pdb : VPackObjectIterator(pdbs)) {  // for each db in Plan
     auto const& dbname = pdb.key.copyString();
     if (local.hasKey(dbname)) {  // have database in both
       auto const& ldb = local.get(dbname);
+      uint64_t const state = ldb.hash(pdb.value.hash(seed));
+      if (!hasDatabaseErrors(errors, dbname) && feature.isConvergedDatabase(dbname, state)) {
+        skipped.emplace(dbname);
+        continue;
+      }
+      states.emplace(dbname, state);
       for (auto const& pcol : VPackObjectIterator(pdb.value)) {  // for each plan collection
         auto const& cprops = pcol.value;
         for (auto const& shard : VPackObjectIterator(cprops.get(SHARDS))) {  // for each shard in plan collection
@@ -457,7 +492,7 @@ arangodb::Result arangodb::maintenance::diffPlanLocal(
   auto const shardMap = getShardMap(pdbs);             // plan shards -> servers
   for (auto const& db : VPackObjectIterator(local)) {  // for each local databases
     auto const& dbname = db.key.copyString();
-    if (pdbs.hasKey(dbname)) {                                // if in plan
+    if (pdbs.hasKey(dbname) && skipped.find(dbname) == skipped.end()) {  // if in plan
       for (auto const& sh : VPackObjectIterator(db.value)) {  // for each local shard
         std::string shName = sh.key.copyString();
         handleLocalShard(dbname, shName, sh.value, shardMap.slice(),
@@ -502,6 +537,22 @@ arangodb::Result arangodb::maintenance::diffPlanLocal(
     }
   }
 
+  // Remember the databases, which need no action
+  for (auto const& state : states) {
+    bool converged = !hasDatabaseErrors(errors, state.first);
+    for (auto const& action : actions) {
+      if (!converged) {
+        break;
+      }
+      converged = !(action.has(DATABASE) && action.get(DATABASE) == state.first);
+    }
+    if (converged) {
+      feature.setConvergedDatabase(state.first, state.second);
+    } else {
+      feature.removeConvergedDatabase(state.first);
+    }
+  }
+
   return result;
 }
 
@@ -655,10 +706,28 @@ static VPackBuilder removeSelectivityEstimate(VPackSlice const& index) {
                                                              {SELECTIVITY_ESTIMATE}));
 }
 
+uint64_t arangodb::maintenance::approximateCountForCurrent(uint64_t actual,
+                                                          VPackSlice const& current) {
+  if (!current.isObject()) {
+    return actual;
+  }
+  VPackSlice reported = current.get(APPROXIMATE_COUNT);
+  if (!reported.isNumber()) {
+    return actual;
+  }
+  uint64_t value = reported.getNumber<uint64_t>();
+  uint64_t delta = (actual > value) ? (actual - value) : (value - actual);
+  if (delta * 100 > value) {
+    return actual;
+  }
+  return value;
+}
+
 static VPackBuilder assembleLocalCollectionInfo(
     VPackSlice const& info, VPackSlice const& planServers,
     std::string const& database, std::string const& shard,
-    std::string const& ourselves, MaintenanceFeature::errors_t const& allErrors) {
+    std::string const& ourselves, MaintenanceFeature::errors_t const& allErrors,
+    VPackSlice const& current) {
   VPackBuilder ret;
 
   try {
@@ -691,6 +760,10 @@ static VPackBuilder assembleLocalCollectionInfo(
         ret.add(StaticStrings::ErrorNum, errs.get(StaticStrings::ErrorNum));
         ret.add(StaticStrings::ErrorMessage, errs.get(StaticStrings::ErrorMessage));
       }
+      // lets coordinators answer approximate counts from Current
+      ret.add(APPROXIMATE_COUNT,
+              VPackValue(approximateCountForCurrent(
+                  collection->getPhysical()->approximateNumberDocuments(), current)));
       ret.add(VPackValue(INDEXES));
       {
         VPackArrayBuilder ixs(&ret);
@@ -722,6 +795,16 @@ static VPackBuilder assembleLocalCollectionInfo(
           }
         }
       }
+      // percentages of the index builds that are still running, so that the
+      // progress of a cluster-wide index creation can be followed in Current
+      auto builds = allErrors.indexBuilds.find(errorKey);
+      if (builds != allErrors.indexBuilds.end() && !builds->second.empty()) {
+        ret.add(VPackValue(INDEX_BUILDS));
+        VPackObjectBuilder b(&ret);
+        for (auto const& build : builds->second) {
+          ret.add(build.first, VPackValue(build.second));
+        }
+      }
       ret.add(VPackValue(SERVERS));
       {
         VPackArrayBuilder a(&ret);
@@ -840,17 +923,18 @@ arangodb::Result arangodb::maintenance::reportInCurrent(
       VPackBuilder error;
       if (shSlice.get(THE_LEADER).copyString().empty()) {  // Leader
 
+        auto cp = std::vector<std::string>{COLLECTIONS, dbName, colName, shName};
+
         auto const localCollectionInfo =
             assembleLocalCollectionInfo(shSlice, shardMap.slice().get(shName),
-                                        dbName, shName, serverId, allErrors);
+                                        dbName, shName, serverId, allErrors,
+                                        cur.get(cp));
         // Collection no longer exists
         TRI_ASSERT(!localCollectionInfo.slice().isNone());
         if (localCollectionInfo.slice().isEmptyObject() || localCollectionInfo.slice().isNone()) {
           continue;
         }
 
-        auto cp = std::vector<std::string>{COLLECTIONS, dbName, colName, shName};
-
         auto inCurrent = cur.hasKey(cp);
         if (!inCurrent || !equivalent(localCollectionInfo.slice(), cur.get(cp))) {
           report.add(VPackValue(CURRENT_COLLECTIONS + dbName + "/" + colName + "/" + shName));
@@ -152,6 +152,20 @@ arangodb::Result reportInCurrent(VPackSlice const& plan, VPackSlice const& cur,
                                  MaintenanceFeature::errors_t const& allErrors,
                                  std::string const& serverId, VPackBuilder& report);
 
+/**
+ * @brief          Approximate document count of a shard to report in current
+ *
+ * The reported value only follows the actual count once it has moved away
+ * by more than one percent, so that writes do not change Current all the
+ * time.
+ *
+ * @param actual   Actual number of documents in the shard
+ * @param current  Shard's entry in current, may be none
+ *
+ * @return         Count to report
+ */
+uint64_t approximateCountForCurrent(uint64_t actual, VPackSlice const& current);
+
 /**
  * @brief            Schedule synchroneous replications
  *
@@ -29,12 +29,16 @@
 #include "Basics/ConditionLocker.h"
 #include "Basics/MutexLocker.h"
 #include "Basics/ReadLocker.h"
+#include "Basics/StringUtils.h"
 #include "Basics/WriteLocker.h"
 #include "Cluster/Action.h"
 #include "Cluster/ActionDescription.h"
 #include "Cluster/CreateDatabase.h"
 #include "Cluster/MaintenanceWorker.h"
+#include "Cluster/MaintenanceStrings.h"
 #include "Cluster/ServerState.h"
+#include "Indexes/IndexBuildProgress.h"
+#include "Logger/Logger.h"
 #include "Random/RandomGenerator.h"
 
 using namespace arangodb;
@@ -48,7 +52,9 @@ const uint32_t MaintenanceFeature::maxThreadLimit = 64;
 MaintenanceFeature::MaintenanceFeature(application_features::ApplicationServer& server)
     : ApplicationFeature(server, "Maintenance"),
       _forceActivation(false),
-      _maintenanceThreadsMax(2) {
+      _maintenanceThreadsMax(2),
+      _maintenanceThreadsFastTrack(1),
+      _indexWriteRate(0) {
   // the number of threads will be adjusted later. it's just that we want to
   // initialize all members properly
 
@@ -87,6 +93,26 @@ void MaintenanceFeature::collectOptions(std::shared_ptr<ProgramOptions> options)
       arangodb::options::makeFlags(arangodb::options::Flags::Hidden,
                                    arangodb::options::Flags::Dynamic));
 
+  options->addOption(
+      "--server.maintenance-fast-track-threads",
+      "number of maintenance threads reserved for fast track actions",
+      new UInt32Parameter(&_maintenanceThreadsFastTrack),
+      arangodb::options::makeFlags(arangodb::options::Flags::Hidden));
+
+  options->addOption(
+      "--server.maintenance-action-concurrency",
+      "maximum number of concurrently executing maintenance actions of a "
+      "type, as action=limit, e.g. SynchronizeShard=2",
+      new VectorParameter<StringParameter>(&_actionConcurrency),
+      arangodb::options::makeFlags(arangodb::options::Flags::Hidden));
+
+  options->addOption(
+      "--server.maintenance-index-write-rate",
+      "maximum number of bytes per second a single index build on a shard "
+      "may write, 0 means no limit",
+      new UInt64Parameter(&_indexWriteRate),
+      arangodb::options::makeFlags(arangodb::options::Flags::Hidden));
+
   options->addOption(
       "--server.maintenance-actions-block",
       "minimum number of seconds finished Actions block duplicates",
@@ -110,6 +136,42 @@ void MaintenanceFeature::validateOptions(std::shared_ptr<ProgramOptions> options
     LOG_TOPIC("8fb0e", WARN, Logger::MAINTENANCE) << "maintenance-threads limited to " << maxThreadLimit;
     _maintenanceThreadsMax = maxThreadLimit;
   }
+
+  // at least one worker for fast track actions and one for all others
+  if (_maintenanceThreadsFastTrack < 1) {
+    _maintenanceThreadsFastTrack = 1;
+  } else if (_maintenanceThreadsFastTrack >= _maintenanceThreadsMax) {
+    LOG_TOPIC("5b1c7", WARN, Logger::MAINTENANCE)
+        << "maintenance-fast-track-threads limited to " << _maintenanceThreadsMax - 1;
+    _maintenanceThreadsFastTrack = _maintenanceThreadsMax - 1;
+  }
+
+  _actionLimits.clear();
+  for (auto const& value : _actionConcurrency) {
+    auto pos = value.find('=');
+    uint64_t limit = 0;
+    if (pos != std::string::npos) {
+      limit = basics::StringUtils::uint64(value.substr(pos + 1));
+    }
+    if (pos == std::string::npos || pos == 0 || limit == 0) {
+      LOG_TOPIC("e7a30", FATAL, Logger::MAINTENANCE)
+          << "invalid value '" << value
+          << "' for --server.maintenance-action-concurrency, expecting "
+             "action=limit with a limit of at least 1";
+      FATAL_ERROR_EXIT();
+    }
+    _actionLimits[value.substr(0, pos)] = static_cast<size_t>(limit);
+  }
+
+  // unless configured otherwise, shard synchronizations leave one of the
+  // workers that are not reserved for fast track actions to everything else,
+  // e.g. index creation
+  uint32_t const slowThreads = _maintenanceThreadsMax - _maintenanceThreadsFastTrack;
+  if (slowThreads > 1) {
+    _actionLimits.emplace(SYNCHRONIZE_SHARD, slowThreads - 1);
+    // the same goes for index builds, which can take long on large shards
+    _actionLimits.emplace(ENSURE_INDEX, slowThreads - 1);
+  }
 }
 
 /// do not start threads in prepare
@@ -127,9 +189,9 @@ void MaintenanceFeature::start() {
 
   // start threads
   for (uint32_t loop = 0; loop < _maintenanceThreadsMax; ++loop) {
-    // First worker will be available only to fast track
+    // First workers will be available only to fast track
     std::unordered_set<std::string> labels{};
-    if (loop == 0) {
+    if (loop < _maintenanceThreadsFastTrack) {
       labels.emplace(ActionBase::FAST_TRACK);
     }
 
@@ -415,25 +477,44 @@ std::shared_ptr<Action> MaintenanceFeature::findReadyAction(std::unordered_set<s
     {
       WRITE_LOCKER(wLock, _actionRegistryLock);
 
+      // actions whose type is at its concurrency limit, they go back into
+      // the queue once we have found something to do or not
+      std::vector<std::shared_ptr<Action>> deferred;
+
       while (!_prioQueue.empty()) {
         // If _prioQueue is empty, we have no ready job and simply loop in the
         // outer loop.
-        auto const& top = _prioQueue.top();
+        auto top = _prioQueue.top();
         if (top->getState() != maintenance::READY) {  // in case it is deleted
           _prioQueue.pop();
           continue;
         }
-        if (top->matches(labels)) {
-          ret_ptr = top;
-          _prioQueue.pop();
-          return ret_ptr;
+        if (!top->matches(labels)) {
+          // We are not interested, this can only mean that we are fast track
+          // and the top action is not. Therefore, the rest of the queue does
+          // not contain any fast track, so we can idle.
+          break;
         }
-        // We are not interested, this can only mean that we are fast track
-        // and the top action is not. Therefore, the whole queue does not
-        // contain any fast track, so we can idle.
+        _prioQueue.pop();
+        auto const& name = top->describe().name();
+        auto limit = _actionLimits.find(name);
+        auto& running = _runningActions[name];
+        if (limit != _actionLimits.end() && running >= limit->second) {
+          deferred.emplace_back(std::move(top));
+          continue;
+        }
+        ++running;
+        ret_ptr = std::move(top);
         break;
       }
 
+      for (auto& action : deferred) {
+        _prioQueue.push(std::move(action));
+      }
+      if (ret_ptr) {
+        return ret_ptr;
+      }
+
       // When we get here, there is currently nothing to do, so we might
       // as well clean up those jobs in the _actionRegistry, which are
       // in state DONE:
@@ -460,6 +541,25 @@ std::shared_ptr<Action> MaintenanceFeature::findReadyAction(std::unordered_set<s
 
 }  // MaintenanceFeature::findReadyAction
 
+void MaintenanceFeature::actionFinished(std::string const& name) {
+  bool limited;
+  {
+    WRITE_LOCKER(wLock, _actionRegistryLock);
+    auto it = _runningActions.find(name);
+    TRI_ASSERT(it != _runningActions.end() && it->second > 0);
+    if (it != _runningActions.end() && it->second > 0) {
+      --it->second;
+    }
+    limited = _actionLimits.find(name) != _actionLimits.end();
+  }
+
+  // a deferred action of this type may run now
+  if (limited) {
+    CONDITION_LOCKER(cLock, _actionRegistryCond);
+    _actionRegistryCond.broadcast();
+  }
+}  // MaintenanceFeature::actionFinished
+
 VPackBuilder MaintenanceFeature::toVelocyPack() const {
   VPackBuilder vb;
   toVelocyPack(vb);
@@ -712,6 +812,27 @@ arangodb::Result MaintenanceFeature::removeIndexErrors(
   return removeIndexErrors(database + SLASH + collection + SLASH + shard, indexIds);
 }
 
+void MaintenanceFeature::storeIndexBuild(std::string const& database,
+                                         std::string const& collection,
+                                         std::string const& shard, std::string const& indexId,
+                                         std::shared_ptr<IndexBuildProgress> progress) {
+  std::string key = database + SLASH + collection + SLASH + shard;
+
+  MUTEX_LOCKER(guard, _ibLock);
+  if (progress != nullptr) {
+    _indexBuilds[key][indexId] = std::move(progress);
+    return;
+  }
+
+  auto it = _indexBuilds.find(key);
+  if (it != _indexBuilds.end()) {
+    it->second.erase(indexId);
+    if (it->second.empty()) {
+      _indexBuilds.erase(it);
+    }
+  }
+}
+
 arangodb::Result MaintenanceFeature::copyAllErrors(errors_t& errors) const {
   {
     MUTEX_LOCKER(guard, _seLock);
@@ -725,6 +846,16 @@ arangodb::Result MaintenanceFeature::copyAllErrors(errors_t& errors) const {
     MUTEX_LOCKER(guard, _dbeLock);
     errors.databases = _dbErrors;
   }
+  {
+    MUTEX_LOCKER(guard, _ibLock);
+    errors.indexBuilds.clear();
+    for (auto const& shard : _indexBuilds) {
+      auto& builds = errors.indexBuilds[shard.first];
+      for (auto const& build : shard.second) {
+        builds.emplace(build.first, build.second->percent());
+      }
+    }
+  }
   return Result();
 }
 
@@ -751,3 +882,19 @@ void MaintenanceFeature::delShardVersion(std::string const& shname) {
     _shardVersion.erase(it);
   }
 }
+
+void MaintenanceFeature::setConvergedDatabase(std::string const& database, uint64_t state) {
+  MUTEX_LOCKER(guard, _convergedLock);
+  _convergedDatabases[database] = state;
+}
+
+bool MaintenanceFeature::isConvergedDatabase(std::string const& database, uint64_t state) const {
+  MUTEX_LOCKER(guard, _convergedLock);
+  auto const it = _convergedDatabases.find(database);
+  return it != _convergedDatabases.end() && it->second == state;
+}
+
+void MaintenanceFeature::removeConvergedDatabase(std::string const& database) {
+  MUTEX_LOCKER(guard, _convergedLock);
+  _convergedDatabases.erase(database);
+}
@@ -35,6 +35,8 @@
 #include <queue>
 
 namespace arangodb {
+class IndexBuildProgress;
+
 
 template<typename T>
 struct SharedPtrComparer {
@@ -62,6 +64,10 @@ class MaintenanceFeature : public application_features::ApplicationFeature {
 
     // dbname -> error
     std::unordered_map<std::string, std::shared_ptr<VPackBuffer<uint8_t>>> databases;
+
+    // dbname/collection/shardid -> index id -> percentage of the running
+    // index build done. not an error, but reported to Current alike
+    std::unordered_map<std::string, std::map<std::string, uint64_t>> indexBuilds;
   };
 
  public:
@@ -143,6 +149,10 @@ class MaintenanceFeature : public application_features::ApplicationFeature {
   std::shared_ptr<maintenance::Action> findReadyAction(
       std::unordered_set<std::string> const& options = std::unordered_set<std::string>());
 
+  /// @brief Called by a worker when it is done with an action it got from
+  ///  findReadyAction, frees the slot the action took of its concurrency limit
+  void actionFinished(std::string const& name);
+
   /// @brief Process specific ID for a new action
   /// @returns uint64_t
   uint64_t nextActionId() { return _nextActionId++; };
@@ -204,6 +214,23 @@ class MaintenanceFeature : public application_features::ApplicationFeature {
   arangodb::Result removeIndexErrors(std::string const& path,
                                      std::unordered_set<std::string> const& indexIds);
 
+  /**
+   * @brief register a running index build, for reporting its progress
+   *        Builds are registered by EnsureIndex for as long as they run
+   *
+   * @param  database     database
+   * @param  collection   collection
+   * @param  shard        shard
+   * @param  indexId      index' id
+   * @param  progress     progress of the build, nullptr unregisters it
+   */
+  void storeIndexBuild(std::string const& database, std::string const& collection,
+                       std::string const& shard, std::string const& indexId,
+                       std::shared_ptr<IndexBuildProgress> progress);
+
+  /// @brief bytes per second a single index build may write, 0 means no limit
+  uint64_t indexWriteRate() const { return _indexWriteRate; }
+
   /**
    * @brief add shard error to bucket
    *        Errors are added by CreateCollection, UpdateCollection
@@ -312,6 +339,23 @@ class MaintenanceFeature : public application_features::ApplicationFeature {
    */
   void delShardVersion(std::string const& shardId);
 
+  /**
+   * @brief remember that the local shards of a database needed no action
+   * @param  database  Database name
+   * @param  state     Hash of the plan and local state of the database
+   */
+  void setConvergedDatabase(std::string const& database, uint64_t state);
+
+  /**
+   * @brief check whether the database needed no action in exactly this state
+   */
+  bool isConvergedDatabase(std::string const& database, uint64_t state) const;
+
+  /**
+   * @brief forget that a database needed no action
+   */
+  void removeConvergedDatabase(std::string const& database);
+
  protected:
   /// @brief common code used by multiple constructors
   void init();
@@ -338,6 +382,20 @@ class MaintenanceFeature : public application_features::ApplicationFeature {
   /// @brief tunable option for thread pool size
   uint32_t _maintenanceThreadsMax;
 
+  /// @brief tunable option for the number of workers reserved for fast track
+  ///  actions (leadership and metadata changes)
+  uint32_t _maintenanceThreadsFastTrack;
+
+  /// @brief tunable option, limits of concurrently executing actions per
+  ///  action name, as name=limit
+  std::vector<std::string> _actionConcurrency;
+
+  /// @brief parsed _actionConcurrency, action name -> limit
+  std::unordered_map<std::string, size_t> _actionLimits;
+
+  /// @brief tunable option, bytes per second a single index build may write
+  uint64_t _indexWriteRate;
+
   /// @brief tunable option for number of seconds COMPLETE or FAILED actions block
   ///  duplicates from adding to _actionRegistry
   int32_t _secondsActionsBlock;
@@ -378,6 +436,10 @@ class MaintenanceFeature : public application_features::ApplicationFeature {
                       std::vector<std::shared_ptr<maintenance::Action>>,
                       SharedPtrComparer<maintenance::Action>> _prioQueue;
 
+  /// @brief number of actions per name that were handed out by findReadyAction
+  ///  and are not finished yet, protected by _actionRegistryLock as well
+  std::unordered_map<std::string, size_t> _runningActions;
+
   /// @brief lock to protect _actionRegistry and state changes to MaintenanceActions within
   mutable arangodb::basics::ReadWriteLock _actionRegistryLock;
 
@@ -399,6 +461,11 @@ class MaintenanceFeature : public application_features::ApplicationFeature {
   /// @brief pending errors raised by EnsureIndex
   std::map<std::string, std::map<std::string, std::shared_ptr<VPackBuffer<uint8_t>>>> _indexErrors;
 
+  /// @brief lock for index build bucket
+  mutable arangodb::Mutex _ibLock;
+  /// @brief index builds running in EnsureIndex
+  std::unordered_map<std::string, std::map<std::string, std::shared_ptr<IndexBuildProgress>>> _indexBuilds;
+
   /// @brief lock for shard error bucket
   mutable arangodb::Mutex _seLock;
   /// @brief pending errors raised by CreateCollection/UpdateCollection
@@ -414,6 +481,12 @@ class MaintenanceFeature : public application_features::ApplicationFeature {
   /// @brief shards have versions in order to be able to distinguish between
   /// independant actions
   std::unordered_map<std::string, size_t> _shardVersion;
+
+  /// @brief lock for converged databases
+  mutable arangodb::Mutex _convergedLock;
+  /// @brief databases that needed no action in the last maintenance run,
+  /// with the hash of their plan and local state at the time
+  std::unordered_map<std::string, uint64_t> _convergedDatabases;
 };
 
 }  // namespace arangodb
@@ -29,6 +29,7 @@ namespace maintenance {
 
 constexpr char const* ACTIONS = "actions";
 constexpr char const* AGENCY = "agency";
+constexpr char const* APPROXIMATE_COUNT = "approximateCount";
 constexpr char const* COLLECTION = "collection";
 constexpr char const* CREATE_COLLECTION = "CreateCollection";
 constexpr char const* CREATE_DATABASE = "CreateDatabase";
@@ -47,6 +48,7 @@ constexpr char const* GLOB_UID = "globallyUniqueId";
 constexpr char const* ID = "id";
 constexpr char const* INDEX = "index";
 constexpr char const* INDEX_BUCKETS = "indexBuckets";
+constexpr char const* INDEX_BUILDS = "indexBuilds";
 constexpr char const* INDEXES = "indexes";
 constexpr char const* JOURNAL_SIZE = "journalSize";
 constexpr char const* KEY = "key";
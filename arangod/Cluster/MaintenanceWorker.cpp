@@ -60,7 +60,11 @@ void MaintenanceWorker::run() {
     try {
       switch (_loopState) {
         case eFIND_ACTION:
+          releaseAction();
           _curAction = _feature.findReadyAction(_labels);
+          if (_curAction) {
+            _claimedAction = _curAction->describe().name();
+          }
           more = (bool)_curAction;
           break;
 
@@ -110,8 +114,16 @@ void MaintenanceWorker::run() {
     nextState(more);
   }  // while
 
+  releaseAction();
 }  // MaintenanceWorker::run
 
+void MaintenanceWorker::releaseAction() {
+  if (!_claimedAction.empty()) {
+    _feature.actionFinished(_claimedAction);
+    _claimedAction.clear();
+  }
+}  // MaintenanceWorker::releaseAction
+
 void MaintenanceWorker::nextState(bool actionMore) {
   // bad result code forces actionMore to false
   if (_curAction && (!_curAction->result().ok() || FAILED == _curAction->getState())) {
@@ -81,6 +81,13 @@ class MaintenanceWorker : public Thread {
 
   const std::unordered_set<std::string> _labels;
 
+  /// @brief name of the action this worker got from findReadyAction, whose
+  ///  concurrency slot it holds until it looks for the next action
+  std::string _claimedAction;
+
+  /// @brief give back the concurrency slot of the claimed action, if any
+  void releaseAction();
+
  private:
   MaintenanceWorker(MaintenanceWorker const&) = delete;
 
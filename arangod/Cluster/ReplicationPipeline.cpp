@@ -0,0 +1,102 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "ReplicationPipeline.h"
+
+#include "Basics/Exceptions.h"
+
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+uint64_t ReplicationPipeline::maxBatchSize = 1000;
+
+ReplicationPipeline& ReplicationPipeline::instance() {
+  static ReplicationPipeline pipeline;
+  return pipeline;
+}
+
+ReplicationPipeline::Outcome ReplicationPipeline::replicate(std::string const& stream,
+                                                            VPackSlice document,
+                                                            SendCallback const& send) {
+  TRI_ASSERT(enabled());
+
+  std::unique_lock<std::mutex> guard(_mutex);
+
+  Stream& s = _streams[stream];
+  if (s.queue.empty() || s.queue.back()->count >= maxBatchSize) {
+    s.queue.emplace_back(std::make_shared<Batch>());
+    s.queue.back()->documents.openArray();
+  }
+  std::shared_ptr<Batch> batch = s.queue.back();
+  ++batch->count;
+  batch->documents.add(document);
+
+  while (!batch->done) {
+    // the stream stays in the map as long as it has queued batches
+    auto it = _streams.find(stream);
+    TRI_ASSERT(it != _streams.end());
+    Stream& current = it->second;
+    if (current.busy || current.queue.front() != batch) {
+      batch->cv.wait(guard);
+      continue;
+    }
+
+    // our turn. from here on nobody else touches the documents
+    current.busy = true;
+    current.queue.pop_front();
+    guard.unlock();
+
+    batch->documents.close();
+    execute(*batch, send);
+
+    guard.lock();
+    batch->done = true;
+    batch->cv.notify_all();
+
+    it = _streams.find(stream);
+    TRI_ASSERT(it != _streams.end());
+    it->second.busy = false;
+    if (it->second.queue.empty()) {
+      _streams.erase(it);
+    } else {
+      // wake up the next batch, one of its callers will send it
+      it->second.queue.front()->cv.notify_all();
+    }
+  }
+
+  return batch->outcome;
+}
+
+void ReplicationPipeline::execute(Batch& batch, SendCallback const& send) {
+  int res = TRI_ERROR_NO_ERROR;
+  try {
+    send(batch.documents.slice(), batch.outcome);
+  } catch (basics::Exception const& ex) {
+    res = ex.code();
+  } catch (std::bad_alloc const&) {
+    res = TRI_ERROR_OUT_OF_MEMORY;
+  } catch (...) {
+    res = TRI_ERROR_INTERNAL;
+  }
+  if (res != TRI_ERROR_NO_ERROR) {
+    batch.outcome.errorCode = res;
+  }
+}
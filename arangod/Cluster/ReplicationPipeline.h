@@ -0,0 +1,105 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_CLUSTER_REPLICATION_PIPELINE_H
+#define ARANGOD_CLUSTER_REPLICATION_PIPELINE_H 1
+
+#include "Basics/Common.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+
+namespace arangodb {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief orders the synchronous replication of single-document operations
+/// of a leader into one stream per shard, followers and operation.
+///
+/// Only one request per stream is in flight. Operations that arrive while
+/// it is in flight are queued and sent together as one array request once
+/// it is acknowledged, and the answer acknowledges all of them at once.
+/// Without concurrent operations each one is sent right away, exactly as
+/// without the pipeline. Operations on the same stream never touch the same
+/// document, as the leader holds the document's lock until it has committed.
+////////////////////////////////////////////////////////////////////////////////
+class ReplicationPipeline {
+ public:
+  /// @brief maximum number of documents per request, 1 turns the pipeline off
+  static uint64_t maxBatchSize;
+
+  static bool enabled() { return maxBatchSize > 1; }
+
+  static ReplicationPipeline& instance();
+
+  /// @brief the answer of the followers for a request
+  struct Outcome {
+    /// @brief whether each follower has applied the documents, in the order
+    /// of the follower list
+    std::vector<bool> applied;
+    /// @brief a follower refused the request, as it follows somebody else
+    bool refused = false;
+    /// @brief the request could not even be sent
+    int errorCode = TRI_ERROR_NO_ERROR;
+  };
+
+  /// @brief sends an array of documents to the followers of the stream
+  typedef std::function<void(velocypack::Slice documents, Outcome& outcome)> SendCallback;
+
+  /// @brief replicates one document. stream identifies the shard, the
+  /// followers and the operation including its options, so that all
+  /// documents of a stream can be sent with the same request. the callback
+  /// of the caller that turns out to send the request is used
+  Outcome replicate(std::string const& stream, velocypack::Slice document,
+                    SendCallback const& send);
+
+ private:
+  struct Batch {
+    velocypack::Builder documents;
+    size_t count = 0;
+    // the outcome is available
+    bool done = false;
+    Outcome outcome;
+    std::condition_variable cv;
+  };
+
+  struct Stream {
+    // a request of the stream is in flight
+    bool busy = false;
+    // batches not yet sent, in order
+    std::deque<std::shared_ptr<Batch>> queue;
+  };
+
+  /// @brief send a batch and store the outcome in it
+  void execute(Batch& batch, SendCallback const& send);
+
+ private:
+  std::mutex _mutex;
+  std::unordered_map<std::string, Stream> _streams;
+};
+
+}  // namespace arangodb
+
+#endif
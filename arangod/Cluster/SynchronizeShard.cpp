@@ -47,6 +47,7 @@
 #include "VocBase/LogicalCollection.h"
 #include "VocBase/Methods/Collections.h"
 #include "VocBase/Methods/Databases.h"
+#include "VocBase/ticks.h"
 
 #include <velocypack/Compare.h>
 #include <velocypack/Iterator.h>
@@ -776,6 +777,10 @@ bool SynchronizeShard::first() {
       return false;
     }
 
+    // we are out of sync until the leader has added us again, do not serve
+    // follower reads in between
+    collection->followers()->resetAppliedTimestamp();
+
     auto ep = clusterInfo->getServerEndpoint(leader);
     uint64_t docCount;
     if (!collectionCount(collection, docCount).ok()) {
@@ -794,9 +799,11 @@ bool SynchronizeShard::first() {
           << database << "/" << shard << "' for central '" << database << "/"
           << planId << "'";
       try {
+        uint64_t const addedSince = TRI_HybridLogicalClock();
         auto asResult = addShardFollower(ep, database, shard, 0, clientId, 60.0);
 
         if (asResult.ok()) {
+          collection->followers()->advanceAppliedTimestamp(addedSince);
           if (Logger::isEnabled(LogLevel::DEBUG, Logger::MAINTENANCE)) {
             std::stringstream msg;
             msg << "synchronizeOneShard: shortcut worked, done, ";
@@ -1103,6 +1110,9 @@ Result SynchronizeShard::catchupWithExclusiveLock(
     return {TRI_ERROR_INTERNAL, errorMessage};
   }
 
+  // everything the leader acknowledged before this time stamp is either in
+  // the data we synchronized, or replicated to us once we are added
+  uint64_t const addedSince = TRI_HybridLogicalClock();
   res = addShardFollower(ep, database, shard, lockJobId, clientId, 60.0);
 
   if (!res.ok()) {
@@ -1111,6 +1121,7 @@ Result SynchronizeShard::catchupWithExclusiveLock(
     errorMessage += res.errorMessage();
     return {TRI_ERROR_INTERNAL, errorMessage};
   }
+  collection.followers()->advanceAppliedTimestamp(addedSince);
 
   // Report success:
   LOG_TOPIC("3423d", DEBUG, Logger::MAINTENANCE)
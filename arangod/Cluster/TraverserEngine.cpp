@@ -271,7 +271,8 @@ BaseTraverserEngine::BaseTraverserEngine(TRI_vocbase_t& vocbase,
 
 BaseTraverserEngine::~BaseTraverserEngine() {}
 
-void BaseTraverserEngine::getEdges(VPackSlice vertex, size_t depth, VPackBuilder& builder) {
+void BaseTraverserEngine::getEdges(VPackSlice vertex, size_t depth,
+                                   VPackBuilder& builder, bool grouped) {
   // We just hope someone has locked the shards properly. We have no clue...
   // Thanks locking
   TRI_ASSERT(vertex.isString() || vertex.isArray());
@@ -285,6 +286,9 @@ void BaseTraverserEngine::getEdges(VPackSlice vertex, size_t depth, VPackBuilder
       arangodb::velocypack::StringRef vertexId(v);
       std::unique_ptr<arangodb::graph::EdgeCursor> edgeCursor(
           _opts->nextCursor(vertexId, depth));
+      if (grouped) {
+        builder.openArray();
+      }
 
       edgeCursor->readAll([&](EdgeDocumentToken&& eid, VPackSlice edge, size_t cursorId) {
         if (edge.isString()) {
@@ -297,6 +301,9 @@ void BaseTraverserEngine::getEdges(VPackSlice vertex, size_t depth, VPackBuilder
           builder.add(edge);
         }
       });
+      if (grouped) {
+        builder.close();
+      }
       // Result now contains all valid edges, probably multiples.
     }
   } else if (vertex.isString()) {
@@ -427,7 +434,7 @@ void ShortestPathEngine::getEdges(VPackSlice vertex, bool backward, VPackBuilder
   builder.openArray();
   if (vertex.isArray()) {
     for (VPackSlice v : VPackArrayIterator(vertex)) {
-      if (!vertex.isString()) {
+      if (!v.isString()) {
         continue;
       }
       TRI_ASSERT(v.isString());
@@ -113,7 +113,11 @@ class BaseTraverserEngine : public BaseEngine {
 
   virtual ~BaseTraverserEngine();
 
-  void getEdges(arangodb::velocypack::Slice, size_t, arangodb::velocypack::Builder&);
+  /// @brief write the edges of one or many vertices on the given depth into
+  /// the builder. if grouped is set and an array of vertices is given, the
+  /// edges are written as one array per requested vertex, in request order
+  void getEdges(arangodb::velocypack::Slice, size_t, arangodb::velocypack::Builder&,
+                bool grouped = false);
 
   void getVertexData(arangodb::velocypack::Slice, size_t, arangodb::velocypack::Builder&);
 
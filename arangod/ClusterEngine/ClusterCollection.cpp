@@ -241,6 +241,13 @@ void ClusterCollection::getPropertiesVPack(velocypack::Builder& result) const {
   } else if (_engineType == ClusterEngineType::RocksDBEngine) {
     result.add("cacheEnabled",
                VPackValue(Helper::readBooleanValue(_info.slice(), "cacheEnabled", false)));
+    result.add("compressDocuments",
+               VPackValue(Helper::readBooleanValue(_info.slice(), "compressDocuments", false)));
+    result.add("dedicatedColumnFamily",
+               VPackValue(Helper::readBooleanValue(_info.slice(), "dedicatedColumnFamily", false)));
+    result.add("documentsCompactionStyle",
+               VPackValue(Helper::getStringValue(_info.slice(), "documentsCompactionStyle",
+                                                 "level")));
 
   } else if (_engineType != ClusterEngineType::MockEngine) {
     TRI_ASSERT(false);
@@ -299,6 +306,10 @@ uint64_t ClusterCollection::numberDocuments(transaction::Methods* trx) const {
   THROW_ARANGO_EXCEPTION(TRI_ERROR_NOT_IMPLEMENTED);
 }
 
+uint64_t ClusterCollection::approximateNumberDocuments() const {
+  THROW_ARANGO_EXCEPTION(TRI_ERROR_NOT_IMPLEMENTED);
+}
+
 /// @brief report extra memory used by indexes etc.
 size_t ClusterCollection::memory() const { return 0; }
 
@@ -91,6 +91,7 @@ class ClusterCollection final : public PhysicalCollection {
 
   TRI_voc_rid_t revision(arangodb::transaction::Methods* trx) const override;
   uint64_t numberDocuments(transaction::Methods* trx) const override;
+  uint64_t approximateNumberDocuments() const override;
 
   /// @brief report extra memory used by indexes etc.
   size_t memory() const override;
@@ -151,6 +151,12 @@ void ClusterEngine::addParametersForNewCollection(VPackBuilder& builder, VPackSl
     if (!info.hasKey("cacheEnabled") || !info.get("cacheEnabled").isBool()) {
       builder.add("cacheEnabled", VPackValue(false));
     }
+    if (!info.hasKey("compressDocuments") || !info.get("compressDocuments").isBool()) {
+      builder.add("compressDocuments", VPackValue(false));
+    }
+    if (!info.hasKey("dedicatedColumnFamily") || !info.get("dedicatedColumnFamily").isBool()) {
+      builder.add("dedicatedColumnFamily", VPackValue(false));
+    }
   }
 }
 
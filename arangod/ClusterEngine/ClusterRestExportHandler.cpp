@@ -23,16 +23,200 @@
 
 #include "ClusterRestExportHandler.h"
 #include "Basics/Exceptions.h"
+#include "Basics/StringUtils.h"
+#include "Basics/VelocyPackHelper.h"
+#include "Cluster/ClusterComm.h"
+#include "Cluster/ClusterInfo.h"
+#include "Cluster/ClusterMethods.h"
+#include "Utils/ExecContext.h"
+#include "VocBase/LogicalCollection.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
 
 using namespace arangodb;
+using namespace arangodb::basics;
 using namespace arangodb::rest;
 
+namespace {
+double const timeout = 120.0;
+}
+
 ClusterRestExportHandler::ClusterRestExportHandler(GeneralRequest* request,
                                                    GeneralResponse* response)
     : RestVocbaseBaseHandler(request, response) {}
 
 RestStatus ClusterRestExportHandler::execute() {
-  generateError(rest::ResponseCode::NOT_IMPLEMENTED, TRI_ERROR_CLUSTER_UNSUPPORTED,
-                "'/_api/export' is not supported in a cluster");
+  if (_request->requestType() != rest::RequestType::POST) {
+    // the cursors live on the DB servers, and are read from there
+    generateError(rest::ResponseCode::METHOD_NOT_ALLOWED, TRI_ERROR_HTTP_METHOD_NOT_ALLOWED);
+    return RestStatus::DONE;
+  }
+  return createCursors();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create an export cursor on the leader of every shard of the
+/// collection. the client reads the cursors from the DB servers in parallel,
+/// with PUT /_api/cursor/<id> on the returned endpoints. every cursor reads
+/// its shard from a snapshot of its own. the DB servers only accept the
+/// superuser JWT, so only administrators may use this
+////////////////////////////////////////////////////////////////////////////////
+
+RestStatus ClusterRestExportHandler::createCursors() {
+  if (!_request->suffixes().empty()) {
+    generateError(rest::ResponseCode::BAD, TRI_ERROR_HTTP_BAD_PARAMETER,
+                  "expecting POST /_api/export");
+    return RestStatus::DONE;
+  }
+
+  bool found;
+  std::string const& name = _request->value("collection", found);
+
+  if (!found || name.empty()) {
+    generateError(rest::ResponseCode::BAD, TRI_ERROR_ARANGO_COLLECTION_PARAMETER_MISSING,
+                  "'collection' is missing, expecting "
+                  "/_api/export?collection=<identifier>");
+    return RestStatus::DONE;
+  }
+
+  ExecContext const* exec = ExecContext::CURRENT;
+  if (exec != nullptr &&
+      (!exec->isAdminUser() || !exec->canUseCollection(name, auth::Level::RO))) {
+    generateError(rest::ResponseCode::FORBIDDEN, TRI_ERROR_FORBIDDEN);
+    return RestStatus::DONE;
+  }
+
+  bool parseSuccess = false;
+  VPackSlice const body = this->parseVPackBody(parseSuccess);
+
+  if (!parseSuccess) {
+    return RestStatus::DONE;
+  }
+  if (!body.isObject()) {
+    generateError(rest::ResponseCode::BAD, TRI_ERROR_BAD_PARAMETER);
+    return RestStatus::DONE;
+  }
+
+  auto cc = ClusterComm::instance();
+  if (cc == nullptr) {
+    // nullptr happens only during controlled shutdown
+    generateError(rest::ResponseCode::SERVICE_UNAVAILABLE, TRI_ERROR_SHUTTING_DOWN);
+    return RestStatus::DONE;
+  }
+
+  auto ci = ClusterInfo::instance();
+  std::string const& dbname = _vocbase.name();
+  auto collection = ci->getCollectionNT(dbname, name);
+  if (collection == nullptr) {
+    generateError(rest::ResponseCode::NOT_FOUND, TRI_ERROR_ARANGO_DATA_SOURCE_NOT_FOUND);
+    return RestStatus::DONE;
+  }
+
+  std::vector<ShardID> shards;
+  for (auto const& it : *collection->shardIds()) {
+    shards.emplace_back(it.first);
+  }
+  std::sort(shards.begin(), shards.end());
+
+  // the DB servers export their shards like local collections
+  std::string const prefix =
+      "/_db/" + StringUtils::urlEncode(dbname) + "/_api/export?collection=";
+  auto requestBody = std::make_shared<std::string>(body.toJson());
+
+  std::vector<ClusterCommRequest> requests;
+  std::vector<ServerID> leaders;
+  for (auto const& shard : shards) {
+    auto servers = ci->getResponsibleServer(shard);
+    if (servers == nullptr || servers->empty()) {
+      generateError(rest::ResponseCode::SERVER_ERROR,
+                    TRI_ERROR_CLUSTER_BACKEND_UNAVAILABLE,
+                    "no leader for shard '" + shard + "'");
+      return RestStatus::DONE;
+    }
+    leaders.emplace_back(servers->front());
+    requests.emplace_back("server:" + servers->front(), rest::RequestType::POST,
+                          prefix + StringUtils::urlEncode(shard), requestBody);
+  }
+
+  cc->performRequests(requests, ::timeout, Logger::COMMUNICATION,
+                      /*retryOnCollNotFound*/ false);
+
+  VPackBuilder result;
+  result.openObject();
+  result.add("shards", VPackValue(VPackValueType::Array));
+
+  int errorCode = TRI_ERROR_NO_ERROR;
+  std::string errorMessage;
+  // cursors already created, dropped again if any shard failed
+  std::vector<std::pair<ServerID, std::string>> cursors;
+
+  for (size_t i = 0; i < requests.size(); ++i) {
+    auto const& res = requests[i].result;
+    int commError = handleGeneralCommErrors(&res);
+    if (commError != TRI_ERROR_NO_ERROR) {
+      errorCode = commError;
+      continue;
+    }
+    TRI_ASSERT(res.answer != nullptr);
+    auto answer = res.answer->toVelocyPackBuilderPtrNoUniquenessChecks();
+    VPackSlice cursor = answer->slice();
+    if (!cursor.isObject()) {
+      errorCode = TRI_ERROR_HTTP_CORRUPTED_JSON;
+      continue;
+    }
+    if (res.answer_code != rest::ResponseCode::CREATED) {
+      errorCode = VelocyPackHelper::getNumericValue<int>(cursor, "errorNum",
+                                                         TRI_ERROR_INTERNAL);
+      errorMessage = VelocyPackHelper::getStringValue(cursor, StaticStrings::ErrorMessage,
+                                                      TRI_errno_string(errorCode));
+      continue;
+    }
+
+    VPackSlice id = cursor.get("id");
+    if (id.isString()) {
+      cursors.emplace_back(leaders[i], id.copyString());
+    }
+
+    result.openObject();
+    result.add("shard", VPackValue(shards[i]));
+    result.add("server", VPackValue(leaders[i]));
+    result.add("endpoint", VPackValue(ci->getServerEndpoint(leaders[i])));
+    for (auto const& it : VPackObjectIterator(cursor)) {
+      if (!it.key.isEqualString(StaticStrings::Error) &&
+          !it.key.isEqualString(StaticStrings::Code)) {
+        result.add(it.key.stringRef(), it.value);
+      }
+    }
+    result.close();
+  }
+
+  result.close();  // shards
+
+  if (errorCode != TRI_ERROR_NO_ERROR) {
+    std::vector<ClusterCommRequest> drops;
+    for (auto const& it : cursors) {
+      drops.emplace_back("server:" + it.first, rest::RequestType::DELETE_REQ,
+                         "/_db/" + StringUtils::urlEncode(dbname) +
+                             "/_api/cursor/" + it.second,
+                         std::make_shared<std::string>());
+    }
+    if (!drops.empty()) {
+      cc->performRequests(drops, ::timeout, Logger::COMMUNICATION,
+                          /*retryOnCollNotFound*/ false);
+    }
+    if (errorMessage.empty()) {
+      generateError(GeneralResponse::responseCode(errorCode), errorCode);
+    } else {
+      generateError(GeneralResponse::responseCode(errorCode), errorCode, errorMessage);
+    }
+    return RestStatus::DONE;
+  }
+
+  result.add(StaticStrings::Error, VPackValue(false));
+  result.add(StaticStrings::Code, VPackValue(static_cast<int>(rest::ResponseCode::CREATED)));
+  result.close();
+  generateResult(rest::ResponseCode::CREATED, result.slice());
   return RestStatus::DONE;
 }
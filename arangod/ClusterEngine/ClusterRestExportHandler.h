@@ -38,6 +38,9 @@ class ClusterRestExportHandler : public RestVocbaseBaseHandler {
   char const* name() const override final { return "ClusterRestExportHandler"; }
   RequestLane lane() const override final { return RequestLane::CLIENT_SLOW; }
   RestStatus execute() override;
+
+ private:
+  RestStatus createCursors();
 };
 }  // namespace arangodb
 
@@ -37,11 +37,11 @@ Acceptor::Acceptor(rest::GeneralServer& server,
 
 std::unique_ptr<Acceptor> Acceptor::factory(rest::GeneralServer& server,
                                             rest::GeneralServer::IoContext& context,
-                                            Endpoint* endpoint) {
+                                            Endpoint* endpoint, bool reusePort) {
 #ifdef ARANGODB_HAVE_DOMAIN_SOCKETS
   if (endpoint->domainType() == Endpoint::DomainType::UNIX) {
     return std::make_unique<AcceptorUnixDomain>(server, context, endpoint);
   }
 #endif
-  return std::make_unique<AcceptorTcp>(server, context, endpoint);
+  return std::make_unique<AcceptorTcp>(server, context, endpoint, reusePort);
 }
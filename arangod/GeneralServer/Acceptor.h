@@ -47,9 +47,12 @@ class Acceptor {
   std::unique_ptr<Socket> movePeer() { return std::move(_peer); };
 
  public:
+  /// @brief with reusePort, the acceptor binds with SO_REUSEPORT and hands
+  /// the accepted sockets to its own io context. otherwise the least loaded
+  /// io context is selected for every connection
   static std::unique_ptr<Acceptor> factory(rest::GeneralServer& server,
                                            rest::GeneralServer::IoContext& context,
-                                           Endpoint*);
+                                           Endpoint*, bool reusePort = false);
 
  protected:
   rest::GeneralServer& _server;
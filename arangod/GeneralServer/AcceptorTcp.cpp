@@ -87,6 +87,21 @@ void AcceptorTcp::open() {
 #else
   _acceptor->set_option(asio_ns::ip::tcp::acceptor::reuse_address(
       ((EndpointIp*)_endpoint)->reuseAddress()));
+
+#ifdef SO_REUSEPORT
+  if (_reusePort) {
+    // all acceptors of the endpoint bind to the same address, the kernel
+    // then distributes the incoming connections among them
+    typedef asio_ns::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT> reuse_port;
+    _acceptor->set_option(reuse_port(true), err);
+    if (err) {
+      LOG_TOPIC("0f5a3", ERR, Logger::COMMUNICATION)
+          << "unable to set SO_REUSEPORT on endpoint '"
+          << _endpoint->specification() << "': " << err.message();
+      throw std::runtime_error(err.message());
+    }
+  }
+#endif
 #endif
 
   _acceptor->bind(asioEndpoint, err);
@@ -110,12 +125,12 @@ void AcceptorTcp::open() {
 void AcceptorTcp::asyncAccept(AcceptHandler const& handler) {
   TRI_ASSERT(!_peer);
 
-  // select the io context for this socket
-  auto& context = _server.selectIoContext();
+  // select the io context for this socket. with SO_REUSEPORT every io
+  // context has an acceptor of its own, which keeps its connections
+  auto& context = _reusePort ? _context : _server.selectIoContext();
 
   if (_endpoint->encryption() == Endpoint::EncryptionType::SSL) {
-    auto sslContext = SslServerFeature::SSL->createSslContext();
-    _peer.reset(new SocketSslTcp(context, std::move(sslContext)));
+    _peer.reset(new SocketSslTcp(context, SslServerFeature::SSL->sslContext()));
     SocketSslTcp* peer = static_cast<SocketSslTcp*>(_peer.get());
     _acceptor->async_accept(peer->_socket, peer->_peerEndpoint, handler);
   } else {
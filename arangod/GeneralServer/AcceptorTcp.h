@@ -29,8 +29,11 @@ namespace arangodb {
 class AcceptorTcp final : public Acceptor {
  public:
   AcceptorTcp(rest::GeneralServer& server,
-              rest::GeneralServer::IoContext& context, Endpoint* endpoint)
-      : Acceptor(server, context, endpoint), _acceptor(context.newAcceptor()) {}
+              rest::GeneralServer::IoContext& context, Endpoint* endpoint,
+              bool reusePort = false)
+      : Acceptor(server, context, endpoint),
+        _acceptor(context.newAcceptor()),
+        _reusePort(reusePort) {}
 
  public:
   void open() override;
@@ -45,6 +48,7 @@ class AcceptorTcp final : public Acceptor {
 
  private:
   std::unique_ptr<asio_ns::ip::tcp::acceptor> _acceptor;
+  bool const _reusePort;
 };
 }  // namespace arangodb
 
@@ -23,14 +23,22 @@
 
 #include "AsyncJobManager.h"
 
+#include "Basics/FileUtils.h"
 #include "Basics/ReadLocker.h"
+#include "Basics/StringBuffer.h"
+#include "Basics/Thread.h"
 #include "Basics/WriteLocker.h"
+#include "Basics/files.h"
 #include "Basics/voc-errors.h"
 #include "GeneralServer/RestHandler.h"
 #include "Logger/Logger.h"
 #include "Rest/GeneralResponse.h"
+#include "Rest/HttpResponse.h"
 #include "Utils/ExecContext.h"
 
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
 namespace {
 bool authorized(std::pair<std::string, arangodb::rest::AsyncJobResult> const& job) {
   auto context = arangodb::ExecContext::CURRENT;
@@ -44,6 +52,10 @@ bool authorized(std::pair<std::string, arangodb::rest::AsyncJobResult> const& jo
 
   return (job.first == context->user());
 }
+
+uint64_t microseconds(double seconds) {
+  return seconds > 0.0 ? static_cast<uint64_t>(seconds * 1000000.0) : 0;
+}
 }  // namespace
 
 using namespace arangodb;
@@ -51,7 +63,7 @@ using namespace arangodb::basics;
 using namespace arangodb::rest;
 
 AsyncJobResult::AsyncJobResult()
-    : _jobId(0), _response(nullptr), _stamp(0.0), _status(JOB_UNDEFINED) {}
+    : _jobId(0), _response(nullptr), _stamp(0.0), _status(JOB_UNDEFINED), _memoryUsage(0) {}
 
 AsyncJobResult::AsyncJobResult(IdType jobId, Status status,
                                std::shared_ptr<RestHandler>&& handler)
@@ -59,17 +71,93 @@ AsyncJobResult::AsyncJobResult(IdType jobId, Status status,
       _response(nullptr),
       _stamp(TRI_microtime()),
       _status(status),
-      _handler(std::move(handler)) {}
+      _handler(std::move(handler)),
+      _memoryUsage(0) {}
 
 AsyncJobResult::~AsyncJobResult() {}
 
-AsyncJobManager::AsyncJobManager() : _lock(), _jobs() {}
+AsyncJobManager::AsyncJobManager(uint64_t memoryLimit)
+    : _memoryLimit(memoryLimit),
+      _memoryUsage(0),
+      _jobsStarted(0),
+      _jobsFinished(0),
+      _jobsSpilled(0),
+      _bytesSpilled(0),
+      _totalRuntime(0),
+      _jobsFetched(0),
+      _totalFetchDelay(0) {}
 
 AsyncJobManager::~AsyncJobManager() {
   // remove all results that haven't been fetched
   deleteJobs();
 }
 
+void AsyncJobManager::releaseResult(AsyncJobResult& job) {
+  delete job._response;
+  job._response = nullptr;
+  if (!job._spillFile.empty()) {
+    TRI_UnlinkFile(job._spillFile.c_str());
+    job._spillFile.clear();
+  }
+  _memoryUsage -= job._memoryUsage;
+  job._memoryUsage = 0;
+}
+
+uint64_t AsyncJobManager::spill(AsyncJobResult::IdType jobId, GeneralResponse* response,
+                                std::string& spillFile) {
+  if (response == nullptr ||
+      response->transportType() != Endpoint::TransportType::HTTP) {
+    return 0;
+  }
+  StringBuffer& body = static_cast<HttpResponse*>(response)->body();
+  uint64_t const size = body.length();
+
+  uint64_t const usage = _memoryUsage.fetch_add(size) + size;
+  if (_memoryLimit == 0 || size == 0 || usage <= _memoryLimit) {
+    return size;
+  }
+  _memoryUsage -= size;
+
+  std::string file = FileUtils::buildFilename(
+      TRI_GetTempPath(), "async-job-" + std::to_string(uint64_t(Thread::currentProcessId())) +
+                             "-" + std::to_string(jobId) + ".tmp");
+  try {
+    FileUtils::spit(file, body.c_str(), body.length());
+  } catch (std::exception const& ex) {
+    LOG_TOPIC("b2e91", WARN, Logger::FIXME)
+        << "unable to spill result of async job " << jobId << ": " << ex.what();
+    TRI_UnlinkFile(file.c_str());
+    _memoryUsage += size;
+    return size;
+  }
+
+  // frees the body
+  StringBuffer empty(false);
+  body.swap(&empty);
+
+  spillFile = std::move(file);
+  ++_jobsSpilled;
+  _bytesSpilled += size;
+  return 0;
+}
+
+void AsyncJobManager::unspill(AsyncJobResult& job) {
+  if (job._spillFile.empty()) {
+    return;
+  }
+  TRI_ASSERT(job._response != nullptr);
+  try {
+    FileUtils::slurp(job._spillFile, static_cast<HttpResponse*>(job._response)->body());
+  } catch (std::exception const& ex) {
+    LOG_TOPIC("0c6d4", ERR, Logger::FIXME)
+        << "unable to read spilled result of async job " << job._jobId << ": "
+        << ex.what();
+    job._response->reset(rest::ResponseCode::SERVER_ERROR);
+  }
+  TRI_UnlinkFile(job._spillFile.c_str());
+  job._spillFile.clear();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief returns the result of an async job
 ////////////////////////////////////////////////////////////////////////////////
@@ -77,29 +165,40 @@ AsyncJobManager::~AsyncJobManager() {
 GeneralResponse* AsyncJobManager::getJobResult(AsyncJobResult::IdType jobId,
                                                AsyncJobResult::Status& status,
                                                bool removeFromList) {
-  WRITE_LOCKER(writeLocker, _lock);
+  AsyncJobResult job;
+  {
+    Shard& s = shard(jobId);
+    WRITE_LOCKER(writeLocker, s.lock);
 
-  auto it = _jobs.find(jobId);
+    auto it = s.jobs.find(jobId);
 
-  if (it == _jobs.end() || !::authorized(it->second)) {
-    status = AsyncJobResult::JOB_UNDEFINED;
-    return nullptr;
-  }
+    if (it == s.jobs.end() || !::authorized(it->second)) {
+      status = AsyncJobResult::JOB_UNDEFINED;
+      return nullptr;
+    }
 
-  GeneralResponse* response = (*it).second.second._response;
-  status = (*it).second.second._status;
+    status = (*it).second.second._status;
 
-  if (status == AsyncJobResult::JOB_PENDING) {
-    return nullptr;
-  }
+    if (status == AsyncJobResult::JOB_PENDING) {
+      return nullptr;
+    }
+
+    if (!removeFromList) {
+      return nullptr;
+    }
 
-  if (!removeFromList) {
-    return nullptr;
+    // remove the job from the list
+    job = std::move(it->second.second);
+    s.jobs.erase(it);
   }
 
-  // remove the job from the list
-  _jobs.erase(it);
-  return response;
+  _memoryUsage -= job._memoryUsage;
+  ++_jobsFetched;
+  _totalFetchDelay += ::microseconds(TRI_microtime() - job._stamp);
+
+  // the file is read outside of the lock
+  unspill(job);
+  return job._response;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -107,22 +206,19 @@ GeneralResponse* AsyncJobManager::getJobResult(AsyncJobResult::IdType jobId,
 ////////////////////////////////////////////////////////////////////////////////
 
 bool AsyncJobManager::deleteJobResult(AsyncJobResult::IdType jobId) {
-  WRITE_LOCKER(writeLocker, _lock);
+  Shard& s = shard(jobId);
+  WRITE_LOCKER(writeLocker, s.lock);
 
-  auto it = _jobs.find(jobId);
+  auto it = s.jobs.find(jobId);
 
-  if (it == _jobs.end() || !::authorized(it->second)) {
+  if (it == s.jobs.end() || !::authorized(it->second)) {
     return false;
   }
 
-  GeneralResponse* response = (*it).second.second._response;
-
-  if (response != nullptr) {
-    delete response;
-  }
+  releaseResult(it->second.second);
 
   // remove the job from the list
-  _jobs.erase(it);
+  s.jobs.erase(it);
   return true;
 }
 
@@ -131,56 +227,49 @@ bool AsyncJobManager::deleteJobResult(AsyncJobResult::IdType jobId) {
 ////////////////////////////////////////////////////////////////////////////////
 
 void AsyncJobManager::deleteJobs() {
-  WRITE_LOCKER(writeLocker, _lock);
+  for (Shard& s : _shards) {
+    WRITE_LOCKER(writeLocker, s.lock);
 
-  auto it = _jobs.begin();
+    auto it = s.jobs.begin();
 
-  while (it != _jobs.end()) {
-    if (::authorized(it->second)) {
-      GeneralResponse* response = (*it).second.second._response;
-      if (response != nullptr) {
-        delete response;
+    while (it != s.jobs.end()) {
+      if (::authorized(it->second)) {
+        releaseResult(it->second.second);
+        s.jobs.erase(it++);
+      } else {
+        ++it;
       }
-      _jobs.erase(it++);
-    } else {
-      ++it;
     }
   }
 }
 
 void AsyncJobManager::deleteExpiredJobResults(double stamp) {
-  WRITE_LOCKER(writeLocker, _lock);
-
-  auto it = _jobs.begin();
-
-  while (it != _jobs.end()) {
-    if (::authorized(it->second)) {
-      AsyncJobResult ajr = (*it).second.second;
+  for (Shard& s : _shards) {
+    WRITE_LOCKER(writeLocker, s.lock);
 
-      if (ajr._stamp < stamp) {
-        GeneralResponse* response = ajr._response;
+    auto it = s.jobs.begin();
 
-        if (response != nullptr) {
-          delete response;
-        }
+    while (it != s.jobs.end()) {
+      AsyncJobResult& ajr = (*it).second.second;
 
-        _jobs.erase(it++);
+      if (::authorized(it->second) && ajr._stamp < stamp) {
+        releaseResult(ajr);
+        s.jobs.erase(it++);
       } else {
         ++it;
       }
-    } else {
-      ++it;
     }
   }
 }
 
 Result AsyncJobManager::cancelJob(AsyncJobResult::IdType jobId) {
   Result rv;
-  WRITE_LOCKER(writeLocker, _lock);
+  Shard& s = shard(jobId);
+  WRITE_LOCKER(writeLocker, s.lock);
 
-  auto it = _jobs.find(jobId);
+  auto it = s.jobs.find(jobId);
 
-  if (it == _jobs.end() || !::authorized(it->second)) {
+  if (it == s.jobs.end() || !::authorized(it->second)) {
     rv.reset(TRI_ERROR_HTTP_NOT_FOUND,
              "could not find job (" + std::to_string(jobId) +
                  ") in AsyncJobManager during cancel operation");
@@ -206,24 +295,28 @@ Result AsyncJobManager::cancelJob(AsyncJobResult::IdType jobId) {
 /// @brief cancel and delete all pending / done jobs
 Result AsyncJobManager::clearAllJobs() {
   Result rv;
-  WRITE_LOCKER(writeLocker, _lock);
 
-  for (auto& it : _jobs) {
-    bool ok = true;
-    std::shared_ptr<RestHandler>& handler = it.second.second._handler;
+  for (Shard& s : _shards) {
+    WRITE_LOCKER(writeLocker, s.lock);
 
-    if (handler != nullptr) {
-      ok = handler->cancel();
-    }
+    for (auto& it : s.jobs) {
+      bool ok = true;
+      std::shared_ptr<RestHandler>& handler = it.second.second._handler;
+
+      if (handler != nullptr) {
+        ok = handler->cancel();
+      }
 
-    if (!ok) {
-      // if you end up here you might need to implement the cancel method on
-      // your handler
-      rv.reset(TRI_ERROR_INTERNAL, "could not cancel job (" + std::to_string(it.first) +
-                                       ") in handler " + handler->name());
+      if (!ok) {
+        // if you end up here you might need to implement the cancel method on
+        // your handler
+        rv.reset(TRI_ERROR_INTERNAL, "could not cancel job (" + std::to_string(it.first) +
+                                         ") in handler " + handler->name());
+      }
+      releaseResult(it.second.second);
     }
+    s.jobs.clear();
   }
-  _jobs.clear();
 
   return rv;
 }
@@ -248,24 +341,16 @@ std::vector<AsyncJobResult::IdType> AsyncJobManager::byStatus(AsyncJobResult::St
                                                               size_t maxCount) {
   std::vector<AsyncJobResult::IdType> jobs;
 
-  {
-    size_t n = 0;
-    READ_LOCKER(readLocker, _lock);
-    auto it = _jobs.begin();
-
-    // iterate the list. the list is sorted by id
-    while (it != _jobs.end()) {
-      AsyncJobResult::IdType jobId = (*it).first;
+  for (Shard& s : _shards) {
+    READ_LOCKER(readLocker, s.lock);
 
-      if ((*it).second.second._status == status && ::authorized(it->second)) {
-        jobs.emplace_back(jobId);
-
-        if (++n >= maxCount) {
-          break;
-        }
+    for (auto const& it : s.jobs) {
+      if (jobs.size() >= maxCount) {
+        return jobs;
+      }
+      if (it.second.second._status == status && ::authorized(it.second)) {
+        jobs.emplace_back(it.first);
       }
-
-      ++it;
     }
   }
 
@@ -283,9 +368,13 @@ void AsyncJobManager::initAsyncJob(std::shared_ptr<RestHandler> handler) {
   std::string user = handler->request()->user();
   AsyncJobResult ajr(jobId, AsyncJobResult::JOB_PENDING, std::move(handler));
 
-  WRITE_LOCKER(writeLocker, _lock);
+  {
+    Shard& s = shard(jobId);
+    WRITE_LOCKER(writeLocker, s.lock);
 
-  _jobs.emplace(jobId, std::make_pair(std::move(user), ajr));
+    s.jobs.emplace(jobId, std::make_pair(std::move(user), std::move(ajr)));
+  }
+  ++_jobsStarted;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -296,16 +385,73 @@ void AsyncJobManager::finishAsyncJob(RestHandler* handler) {
   AsyncJobResult::IdType jobId = handler->handlerId();
   std::unique_ptr<GeneralResponse> response = handler->stealResponse();
 
-  {
-    WRITE_LOCKER(writeLocker, _lock);
-    auto it = _jobs.find(jobId);
+  // the file is written outside of the lock
+  std::string spillFile;
+  uint64_t memoryUsage = spill(jobId, response.get(), spillFile);
+  double const now = TRI_microtime();
 
-    if (it == _jobs.end()) {
-      return;  // job is already canceled
+  {
+    Shard& s = shard(jobId);
+    WRITE_LOCKER(writeLocker, s.lock);
+    auto it = s.jobs.find(jobId);
+
+    if (it == s.jobs.end()) {
+      // job is already canceled
+      writeLocker.unlock();
+      if (!spillFile.empty()) {
+        TRI_UnlinkFile(spillFile.c_str());
+      }
+      _memoryUsage -= memoryUsage;
+      return;
     }
 
-    it->second.second._response = response.release();
-    it->second.second._status = AsyncJobResult::JOB_DONE;
-    it->second.second._stamp = TRI_microtime();
+    AsyncJobResult& job = it->second.second;
+    _totalRuntime += ::microseconds(now - job._stamp);
+
+    job._response = response.release();
+    job._status = AsyncJobResult::JOB_DONE;
+    job._stamp = now;
+    job._memoryUsage = memoryUsage;
+    job._spillFile = std::move(spillFile);
+  }
+  ++_jobsFinished;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of jobs, memory usage and latencies
+////////////////////////////////////////////////////////////////////////////////
+
+void AsyncJobManager::statistics(VPackBuilder& builder) {
+  uint64_t pending = 0;
+  uint64_t done = 0;
+  for (Shard& s : _shards) {
+    READ_LOCKER(readLocker, s.lock);
+    for (auto const& it : s.jobs) {
+      if (it.second.second._status == AsyncJobResult::JOB_PENDING) {
+        ++pending;
+      } else {
+        ++done;
+      }
+    }
   }
+
+  uint64_t const finished = _jobsFinished.load();
+  uint64_t const fetched = _jobsFetched.load();
+
+  builder.openObject();
+  builder.add("pending", VPackValue(pending));
+  builder.add("done", VPackValue(done));
+  builder.add("started", VPackValue(_jobsStarted.load()));
+  builder.add("finished", VPackValue(finished));
+  builder.add("fetched", VPackValue(fetched));
+  builder.add("memoryUsage", VPackValue(_memoryUsage.load()));
+  builder.add("memoryLimit", VPackValue(_memoryLimit));
+  builder.add("spilled", VPackValue(_jobsSpilled.load()));
+  builder.add("spilledBytes", VPackValue(_bytesSpilled.load()));
+  // in seconds
+  builder.add("averageRuntime",
+              VPackValue(finished == 0 ? 0.0 : _totalRuntime.load() / 1000000.0 / finished));
+  builder.add("averageFetchDelay",
+              VPackValue(fetched == 0 ? 0.0 : _totalFetchDelay.load() / 1000000.0 / fetched));
+  builder.close();
 }
@@ -28,8 +28,14 @@
 #include "Basics/ReadWriteLock.h"
 #include "Basics/Result.h"
 
+#include <array>
+#include <atomic>
+
 namespace arangodb {
 class GeneralResponse;
+namespace velocypack {
+class Builder;
+}
 
 namespace rest {
 class RestHandler;
@@ -56,13 +62,20 @@ struct AsyncJobResult {
   double _stamp;
   Status _status;
   std::shared_ptr<RestHandler> _handler;
+  /// @brief memory used by the response body, 0 if it has been spilled
+  uint64_t _memoryUsage;
+  /// @brief temporary file with the response body, if it has been spilled
+  std::string _spillFile;
 };
 
 // -----------------------------------------------------------------------------
 // --SECTION--                                                   AsyncJobManager
 // -----------------------------------------------------------------------------
 
-/// @brief Manages responses which will be fetched later by clients.
+/// @brief Manages responses which will be fetched later by clients. the
+/// jobs are distributed over several independently locked shards. once the
+/// stored response bodies use more than the memory limit, further bodies are
+/// moved into temporary files until they are fetched
 class AsyncJobManager {
   AsyncJobManager(AsyncJobManager const&) = delete;
   AsyncJobManager& operator=(AsyncJobManager const&) = delete;
@@ -71,7 +84,8 @@ class AsyncJobManager {
   typedef std::unordered_map<AsyncJobResult::IdType, std::pair<std::string, AsyncJobResult>> JobList;
 
  public:
-  AsyncJobManager();
+  /// @brief a memory limit of 0 means that bodies are never spilled
+  explicit AsyncJobManager(uint64_t memoryLimit = 0);
   ~AsyncJobManager();
 
  public:
@@ -93,9 +107,50 @@ class AsyncJobManager {
   void initAsyncJob(std::shared_ptr<RestHandler>);
   void finishAsyncJob(RestHandler*);
 
+  /// @brief number of jobs, memory usage and latencies, as an object
+  void statistics(velocypack::Builder&);
+
  private:
-  basics::ReadWriteLock _lock;
-  JobList _jobs;
+  static constexpr size_t numShards = 16;
+
+  struct Shard {
+    basics::ReadWriteLock lock;
+    JobList jobs;
+  };
+
+  Shard& shard(AsyncJobResult::IdType jobId) {
+    return _shards[jobId % numShards];
+  }
+
+  /// @brief free the response of a job that is removed
+  void releaseResult(AsyncJobResult& job);
+
+  /// @brief move the response body into a temporary file if the memory limit
+  /// is exceeded. returns the memory used by the response afterwards
+  uint64_t spill(AsyncJobResult::IdType jobId, GeneralResponse* response,
+                 std::string& spillFile);
+
+  /// @brief read a spilled response body back
+  void unspill(AsyncJobResult& job);
+
+  uint64_t const _memoryLimit;
+
+  std::array<Shard, numShards> _shards;
+
+  /// @brief memory used by the response bodies of all done jobs
+  std::atomic<uint64_t> _memoryUsage;
+
+  std::atomic<uint64_t> _jobsStarted;
+  std::atomic<uint64_t> _jobsFinished;
+  std::atomic<uint64_t> _jobsSpilled;
+  std::atomic<uint64_t> _bytesSpilled;
+  /// @brief sum of the times from queueing to finishing of all finished
+  /// jobs, in microseconds
+  std::atomic<uint64_t> _totalRuntime;
+  std::atomic<uint64_t> _jobsFetched;
+  /// @brief sum of the times from finishing to fetching of all fetched jobs,
+  /// in microseconds
+  std::atomic<uint64_t> _totalFetchDelay;
 };
 }  // namespace rest
 }  // namespace arangodb
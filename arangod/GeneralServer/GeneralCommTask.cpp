@@ -31,6 +31,7 @@
 #include "Basics/Locking.h"
 #include "Basics/MutexLocker.h"
 #include "Basics/StaticStrings.h"
+#include "Basics/tri-strings.h"
 #include "Cluster/ServerState.h"
 #include "GeneralServer/AsyncJobManager.h"
 #include "GeneralServer/AuthenticationFeature.h"
@@ -42,11 +43,15 @@
 #include "Logger/Logger.h"
 #include "Meta/conversion.h"
 #include "Replication/ReplicationFeature.h"
+#include "Rest/HttpRequest.h"
+#include "Rest/HttpResponse.h"
 #include "RestServer/DatabaseFeature.h"
 #include "RestServer/VocbaseContext.h"
 #include "Scheduler/Scheduler.h"
 #include "Scheduler/SchedulerFeature.h"
+#include "Statistics/Tracing.h"
 #include "Utils/Events.h"
+#include "VocBase/DatabaseQuota.h"
 #include "VocBase/ticks.h"
 #include "VocBase/vocbase.h"
 
@@ -115,6 +120,21 @@ TRI_vocbase_t* lookupDatabaseFromRequest(GeneralRequest& req) {
 
   return databaseFeature->useDatabase(dbName);
 }
+
+/// @brief run a client request's job within the resource limits of the
+/// request's database. the job holds the handler, which keeps the database
+/// in use while the job is parked
+std::function<void()> withDatabaseQuota(RestHandler const& handler, RequestLane lane,
+                                        std::function<void()>&& job) {
+  auto* vc = static_cast<VocbaseContext*>(handler.request()->requestContext());
+  if (vc == nullptr || !isClientRequestLane(lane)) {
+    return std::move(job);
+  }
+  DatabaseQuota* quota = &vc->vocbase().quota();
+  return [quota, lane, job = std::move(job)]() mutable {
+    quota->runJob(lane, std::move(job));
+  };
+}
 }  // namespace
 
 /// Set the appropriate requestContext
@@ -193,6 +213,7 @@ GeneralCommTask::RequestFlow GeneralCommTask::prepareExecution(GeneralRequest& r
       if (!::startsWith(path, "/_admin/shutdown") &&
           !::startsWith(path, "/_admin/cluster/health") &&
           !::startsWith(path, "/_admin/log") &&
+          !::startsWith(path, "/_admin/metrics") &&
           !::startsWith(path, "/_admin/server/role") &&
           !::startsWith(path, "/_admin/server/availability") &&
           !::startsWith(path, "/_admin/status") &&
@@ -317,6 +338,14 @@ void GeneralCommTask::executeRequest(std::unique_ptr<GeneralRequest>&& request,
     return;
   }
 
+  if (tracing::enabled()) {
+    // continue the trace of the calling server, or sample a new one
+    bool traced;
+    std::string const& trace =
+        handler->request()->header(StaticStrings::XArangoTrace, traced);
+    handler->startTrace(traced ? tracing::fromHeader(trace) : tracing::sample());
+  }
+
   // forward to correct server if necessary
   bool forwarded = handler->forwardRequest();
   if (forwarded) {
@@ -455,13 +484,28 @@ bool GeneralCommTask::handleRequestSync(std::shared_ptr<RestHandler> handler) {
     return false;
   }
 
+  if (allowDirectHandling() && handler->canRunOnIoThread() &&
+      handler->request()->bodyStream() == nullptr) {
+    // cheap handlers that never block are executed right here, without
+    // handing them over to a scheduler thread
+    handler->_onIoThread = true;
+    handleRequestDirectly(basics::ConditionalLocking::DoNotLock, std::move(handler));
+    return true;
+  }
+
   // queue the operation in the scheduler, and make it eligible for direct execution
   // only if the current CommTask type allows it (HttpCommTask: yes, VstCommTask: no)
-  // and there is currently only a single client handled by the IoContext
-  bool ok = SchedulerFeature::SCHEDULER->queue(handler->getRequestLane(), [self = shared_from_this(), handler]() {
+  // and there is currently only a single client handled by the IoContext.
+  // a handler that waits for the rest of its body must never run on the IO thread
+  bool const direct = allowDirectHandling() && _peer->clients() == 1 &&
+                      handler->request()->bodyStream() == nullptr;
+  // lets the scheduler account the queueing time to the request's trace
+  tracing::ContextScope traceScope(handler->traceContext());
+  auto const lane = handler->getRequestLane();
+  bool ok = SchedulerFeature::SCHEDULER->queue(lane, ::withDatabaseQuota(*handler, lane, [self = shared_from_this(), handler]() {
     auto thisPtr = static_cast<GeneralCommTask*>(self.get());
     thisPtr->handleRequestDirectly(basics::ConditionalLocking::DoLock, handler);
-  }, allowDirectHandling() && _peer->clients() == 1);
+  }), direct);
 
   if (!ok) {
     addErrorResponse(rest::ResponseCode::SERVICE_UNAVAILABLE,
@@ -482,6 +526,7 @@ void GeneralCommTask::handleRequestDirectly(bool doLock, std::shared_ptr<RestHan
   
   handler->runHandler([self = shared_from_this()](rest::RestHandler* handler) {
     auto thisPtr = static_cast<GeneralCommTask*>(self.get());
+    thisPtr->compressResponse(*handler);
     RequestStatistics* stat = handler->stealStatistics();
     auto h = handler->shared_from_this();
     // Pass the response the io context
@@ -492,6 +537,30 @@ void GeneralCommTask::handleRequestDirectly(bool doLock, std::shared_ptr<RestHan
   });
 }
 
+void GeneralCommTask::compressResponse(RestHandler& handler) {
+  if (HttpResponse::COMPRESSION_THRESHOLD == 0 ||
+      transportType() != Endpoint::TransportType::HTTP) {
+    // VST has no content codings
+    return;
+  }
+
+  GeneralRequest const* request = handler.request();
+  GeneralResponse* response = handler.response();
+
+  if (request == nullptr || response == nullptr ||
+      request->requestType() == rest::RequestType::HEAD ||
+      response->bodyStream() != nullptr) {
+    return;
+  }
+
+  bool found;
+  std::string const& acceptEncoding = request->header(StaticStrings::AcceptEncoding, found);
+
+  if (found) {
+    static_cast<HttpResponse*>(response)->compressBody(acceptEncoding);
+  }
+}
+
 // handle a request which came in with the x-arango-async header
 bool GeneralCommTask::handleRequestAsync(std::shared_ptr<RestHandler> handler,
                                          uint64_t* jobId) {
@@ -500,22 +569,25 @@ bool GeneralCommTask::handleRequestAsync(std::shared_ptr<RestHandler> handler,
   }
 
   auto const lane = handler->getRequestLane();
+  tracing::ContextScope traceScope(handler->traceContext());
 
   if (jobId != nullptr) {
     GeneralServerFeature::JOB_MANAGER->initAsyncJob(handler);
     *jobId = handler->handlerId();
 
     // callback will persist the response with the AsyncJobManager
-    return SchedulerFeature::SCHEDULER->queue(lane, [self = shared_from_this(), handler = std::move(handler)] {
+    RestHandler const& ref = *handler;
+    return SchedulerFeature::SCHEDULER->queue(lane, ::withDatabaseQuota(ref, lane, [self = shared_from_this(), handler = std::move(handler)] {
       handler->runHandler([](RestHandler* h) {
         GeneralServerFeature::JOB_MANAGER->finishAsyncJob(h);
       });
-    });
+    }));
   } else {
     // here the response will just be ignored
-    return SchedulerFeature::SCHEDULER->queue(lane, [self = shared_from_this(), handler = std::move(handler)] {
+    RestHandler const& ref = *handler;
+    return SchedulerFeature::SCHEDULER->queue(lane, ::withDatabaseQuota(ref, lane, [self = shared_from_this(), handler = std::move(handler)] {
       handler->runHandler([](RestHandler*) {});
-    });
+    }));
   }
 }
 
@@ -614,3 +686,68 @@ rest::ResponseCode GeneralCommTask::canAccessPath(GeneralRequest& req) const {
 
   return result;
 }
+
+/// @brief authenticates an HTTP request from its authorization header
+rest::ResponseCode GeneralCommTask::handleAuthHeader(HttpRequest* req) {
+  bool found;
+  std::string const& authStr = req->header(StaticStrings::Authorization, found);
+  if (!found) {
+    if (_auth->isActive()) {
+      events::CredentialsMissing(*req);
+      return rest::ResponseCode::UNAUTHORIZED;
+    }
+    return rest::ResponseCode::OK;
+  }
+
+  size_t methodPos = authStr.find_first_of(' ');
+  if (methodPos != std::string::npos) {
+    // skip over authentication method
+    char const* auth = authStr.c_str() + methodPos;
+    while (*auth == ' ') {
+      ++auth;
+    }
+
+    if (Logger::logRequestParameters()) {
+      LOG_TOPIC("c4536", DEBUG, arangodb::Logger::REQUESTS)
+          << "\"authorization-header\",\"" << (void*)this << "\",\"" << authStr << "\"";
+    }
+
+    try {
+      // note that these methods may throw in case of an error
+      AuthenticationMethod authMethod = AuthenticationMethod::NONE;
+      if (TRI_CaseEqualString(authStr.c_str(), "basic ", 6)) {
+        authMethod = AuthenticationMethod::BASIC;
+      } else if (TRI_CaseEqualString(authStr.c_str(), "bearer ", 7)) {
+        authMethod = AuthenticationMethod::JWT;
+      }
+
+      req->setAuthenticationMethod(authMethod);
+      if (authMethod != AuthenticationMethod::NONE) {
+        _authToken = _auth->tokenCache().checkAuthentication(authMethod, auth);
+        req->setAuthenticated(_authToken.authenticated());
+        req->setUser(_authToken._username); // do copy here, so that we do not invalidate the member
+      }
+
+      if (req->authenticated() || !_auth->isActive()) {
+        events::Authenticated(*req, authMethod);
+        return rest::ResponseCode::OK;
+      } else if (_auth->isActive()) {
+        events::CredentialsBad(*req, authMethod);
+        return rest::ResponseCode::UNAUTHORIZED;
+      }
+
+      // intentionally falls through
+    } catch (arangodb::basics::Exception const& ex) {
+      // translate error
+      if (ex.code() == TRI_ERROR_USER_NOT_FOUND) {
+        return rest::ResponseCode::UNAUTHORIZED;
+      }
+      return GeneralResponse::responseCode(ex.what());
+    } catch (...) {
+      return rest::ResponseCode::SERVER_ERROR;
+    }
+  }
+
+  events::UnknownAuthenticationMethod(*req);
+  return rest::ResponseCode::UNAUTHORIZED;
+}
@@ -40,6 +40,7 @@ namespace arangodb {
 class AuthenticationFeature;
 class GeneralRequest;
 class GeneralResponse;
+class HttpRequest;
 
 namespace rest {
 class RestHandler;
@@ -154,9 +155,16 @@ class GeneralCommTask : public SocketTask {
   ////////////////////////////////////////////////////////////////////////////////
   rest::ResponseCode canAccessPath(GeneralRequest&) const;
 
+  /// @brief authenticates an HTTP request from its authorization header,
+  /// shared by HTTP/1 and HTTP/2
+  rest::ResponseCode handleAuthHeader(HttpRequest*);
+
  private:
   bool handleRequestSync(std::shared_ptr<RestHandler>);
   void handleRequestDirectly(bool doLock, std::shared_ptr<RestHandler>);
+  /// @brief compresses an HTTP response body as the client accepts it.
+  /// runs on the thread that ran the handler, not on the IO thread
+  void compressResponse(RestHandler&);
   bool handleRequestAsync(std::shared_ptr<RestHandler>, uint64_t* jobId = nullptr);
 };
 }  // namespace rest
@@ -46,8 +46,15 @@ using namespace arangodb::rest;
 // -----------------------------------------------------------------------------
 // --SECTION--                                                    public methods
 // -----------------------------------------------------------------------------
-GeneralServer::GeneralServer(uint64_t numIoThreads)
-    : _numIoThreads(numIoThreads), _contexts(numIoThreads) {}
+GeneralServer::GeneralServer(uint64_t numIoThreads, bool reusePort)
+    : _numIoThreads(numIoThreads),
+#ifdef SO_REUSEPORT
+      _reusePort(reusePort && numIoThreads > 1),
+#else
+      _reusePort(false),
+#endif
+      _contexts(numIoThreads) {
+}
 
 GeneralServer::~GeneralServer() {}
   
@@ -78,9 +85,20 @@ void GeneralServer::startListening() {
     LOG_TOPIC("e62e0", TRACE, arangodb::Logger::FIXME)
         << "trying to bind to endpoint '" << it.first << "' for requests";
 
-    // distribute endpoints across all io contexts
-    IoContext& ioContext = _contexts[i++ % _numIoThreads];
-    bool ok = openEndpoint(ioContext, it.second);
+    bool ok = true;
+    if (_reusePort && it.second->domainType() != Endpoint::DomainType::UNIX) {
+      // one acceptor per io context, the kernel balances the connections
+      for (auto& ioContext : _contexts) {
+        if (!openEndpoint(ioContext, it.second, true)) {
+          ok = false;
+          break;
+        }
+      }
+    } else {
+      // distribute endpoints across all io contexts
+      IoContext& ioContext = _contexts[i++ % _numIoThreads];
+      ok = openEndpoint(ioContext, it.second, false);
+    }
 
     if (ok) {
       LOG_TOPIC("dc45a", DEBUG, arangodb::Logger::FIXME) << "bound to endpoint '" << it.first << "'";
@@ -176,8 +194,8 @@ void GeneralServer::stopWorking() {
 // --SECTION--                                                 protected methods
 // -----------------------------------------------------------------------------
 
-bool GeneralServer::openEndpoint(IoContext& ioContext, Endpoint* endpoint) {
-  auto task = std::make_shared<ListenTask>(*this, ioContext, endpoint);
+bool GeneralServer::openEndpoint(IoContext& ioContext, Endpoint* endpoint, bool reusePort) {
+  auto task = std::make_shared<ListenTask>(*this, ioContext, endpoint, reusePort);
   _listenTasks.emplace_back(task);
 
   return task->start();
@@ -221,3 +239,12 @@ GeneralServer::IoContext& GeneralServer::selectIoContext() {
 
   return _contexts[lowpos];
 }
+
+std::vector<uint64_t> GeneralServer::clientsPerIoContext() const {
+  std::vector<uint64_t> result;
+  result.reserve(_contexts.size());
+  for (auto const& context : _contexts) {
+    result.push_back(context._clients.load(std::memory_order_relaxed));
+  }
+  return result;
+}
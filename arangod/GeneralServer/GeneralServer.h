@@ -44,7 +44,7 @@ class GeneralServer {
   GeneralServer const& operator=(GeneralServer const&) = delete;
 
  public:
-  explicit GeneralServer(uint64_t numIoThreads);
+  GeneralServer(uint64_t numIoThreads, bool reusePort);
   ~GeneralServer();
 
  public:
@@ -137,14 +137,19 @@ class GeneralServer {
 
   GeneralServer::IoContext& selectIoContext();
 
+  /// @brief number of connections currently served by each io context
+  std::vector<uint64_t> clientsPerIoContext() const;
+
  protected:
-  bool openEndpoint(IoContext& ioContext, Endpoint* endpoint);
+  bool openEndpoint(IoContext& ioContext, Endpoint* endpoint, bool reusePort);
 
  private:
   friend class IoThread;
   friend class IoContext;
 
   uint64_t const _numIoThreads;
+  // open one SO_REUSEPORT acceptor per io context for TCP endpoints
+  bool const _reusePort;
   std::vector<IoContext> _contexts;
   EndpointList const* _endpointList = nullptr;
 
@@ -47,6 +47,7 @@
 #include "RestHandler/RestAdminDatabaseHandler.h"
 #include "RestHandler/RestAdminExecuteHandler.h"
 #include "RestHandler/RestAdminLogHandler.h"
+#include "RestHandler/RestAdminProfileHandler.h"
 #include "RestHandler/RestAdminRoutingHandler.h"
 #include "RestHandler/RestAdminServerHandler.h"
 #include "RestHandler/RestAdminStatisticsHandler.h"
@@ -117,7 +118,9 @@ GeneralServerFeature::GeneralServerFeature(application_features::ApplicationServ
     : ApplicationFeature(server, "GeneralServer"),
       _allowMethodOverride(false),
       _proxyCheck(true),
-      _numIoThreads(0) {
+      _numIoThreads(0),
+      _reusePort(false),
+      _asyncJobMemoryLimit(0) {
   setOptional(true);
   startsAfter("AQLPhase");
   startsAfter("Endpoint");
@@ -147,6 +150,17 @@ void GeneralServerFeature::collectOptions(std::shared_ptr<ProgramOptions> option
                      new UInt64Parameter(&_numIoThreads),
                      arangodb::options::makeFlags(arangodb::options::Flags::Dynamic));
 
+  options->addOption("--server.reuse-port",
+                     "listen on every TCP endpoint with one SO_REUSEPORT socket "
+                     "per IO thread and let the kernel balance the connections",
+                     new BooleanParameter(&_reusePort));
+
+  options->addOption("--server.async-job-memory-limit",
+                     "memory (in bytes) for the stored results of async jobs. "
+                     "results beyond it are kept in temporary files until "
+                     "they are fetched; 0 means no limit",
+                     new UInt64Parameter(&_asyncJobMemoryLimit));
+
   options->addSection("http", "HttpServer features");
 
   options->addOption("--http.allow-method-override",
@@ -163,6 +177,11 @@ void GeneralServerFeature::collectOptions(std::shared_ptr<ProgramOptions> option
       "do not expose \"Server: ArangoDB\" header in HTTP responses",
       new BooleanParameter(&HttpResponse::HIDE_PRODUCT_HEADER));
 
+  options->addOption("--http.compress-response-threshold",
+                     "compress response bodies of at least this many bytes "
+                     "with gzip or deflate if the client accepts it (0 = off)",
+                     new UInt64Parameter(&HttpResponse::COMPRESSION_THRESHOLD));
+
   options->addOption("--http.trusted-origin",
                      "trusted origin URLs for CORS requests with credentials",
                      new VectorParameter<StringParameter>(&_accessControlAllowOrigins));
@@ -217,13 +236,29 @@ void GeneralServerFeature::validateOptions(std::shared_ptr<ProgramOptions>) {
   }
 }
 
+std::vector<uint64_t> GeneralServerFeature::ioContextClients() {
+  std::vector<uint64_t> result;
+  if (GENERAL_SERVER == nullptr) {
+    return result;
+  }
+
+  for (auto const& server : GENERAL_SERVER->_servers) {
+    std::vector<uint64_t> clients = server->clientsPerIoContext();
+    result.resize((std::max)(result.size(), clients.size()), 0);
+    for (size_t i = 0; i < clients.size(); ++i) {
+      result[i] += clients[i];
+    }
+  }
+  return result;
+}
+
 void GeneralServerFeature::prepare() {
   ServerState::instance()->setServerMode(ServerState::Mode::MAINTENANCE);
   GENERAL_SERVER = this;
 }
 
 void GeneralServerFeature::start() {
-  _jobManager.reset(new AsyncJobManager);
+  _jobManager.reset(new AsyncJobManager(_asyncJobMemoryLimit));
 
   JOB_MANAGER = _jobManager.get();
 
@@ -289,7 +324,7 @@ void GeneralServerFeature::buildServers() {
     ssl->SSL->verifySslOptions();
   }
 
-  auto server = std::make_unique<GeneralServer>(_numIoThreads);
+  auto server = std::make_unique<GeneralServer>(_numIoThreads, _reusePort);
   server->setEndpointList(&endpointList);
   _servers.push_back(std::move(server));
 }
@@ -537,12 +572,21 @@ void GeneralServerFeature::defineHandlers() {
   _handlerFactory->addPrefixHandler("/_admin/server",
                                     RestHandlerCreator<arangodb::RestAdminServerHandler>::createNoData);
 
+  _handlerFactory->addPrefixHandler("/_admin/profile",
+                                    RestHandlerCreator<arangodb::RestAdminProfileHandler>::createNoData);
+
   _handlerFactory->addHandler("/_admin/statistics",
                               RestHandlerCreator<arangodb::RestAdminStatisticsHandler>::createNoData);
 
   _handlerFactory->addHandler("/_admin/statistics-description",
                               RestHandlerCreator<arangodb::RestAdminStatisticsHandler>::createNoData);
 
+  _handlerFactory->addHandler("/_admin/metrics",
+                              RestHandlerCreator<arangodb::RestAdminStatisticsHandler>::createNoData);
+
+  _handlerFactory->addHandler("/_admin/trace",
+                              RestHandlerCreator<arangodb::RestAdminStatisticsHandler>::createNoData);
+
   if (cluster->isEnabled()) {
     _handlerFactory->addPrefixHandler("/_admin/repair",
                                       RestHandlerCreator<arangodb::RestRepairHandler>::createNoData);
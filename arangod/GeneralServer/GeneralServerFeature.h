@@ -73,6 +73,9 @@ class GeneralServerFeature final : public application_features::ApplicationFeatu
     return GENERAL_SERVER->_allowMethodOverride;
   }
 
+  /// @brief connections per io context, summed up over all servers
+  static std::vector<uint64_t> ioContextClients();
+
   static std::vector<std::string> const& accessControlAllowOrigins() {
     static std::vector<std::string> empty;
 
@@ -115,6 +118,8 @@ class GeneralServerFeature final : public application_features::ApplicationFeatu
   std::unique_ptr<std::pair<aql::QueryRegistry*, traverser::TraverserEngineRegistry*>> _combinedRegistries;
   std::vector<std::unique_ptr<rest::GeneralServer>> _servers;
   uint64_t _numIoThreads;
+  bool _reusePort;
+  uint64_t _asyncJobMemoryLimit;
 };
 
 }  // namespace arangodb
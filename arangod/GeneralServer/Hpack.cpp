@@ -0,0 +1,506 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Hpack.h"
+
+using namespace arangodb::rest::hpack;
+
+namespace {
+
+/// @brief every entry accounts for 32 bytes of overhead (RFC 7541, 4.1)
+constexpr size_t EntryOverhead = 32;
+
+/// @brief the static table (RFC 7541, Appendix A), addressed from 1
+struct StaticEntry {
+  char const* name;
+  char const* value;
+};
+
+constexpr StaticEntry StaticTable[] = {
+    {":authority", ""},
+    {":method", "GET"},
+    {":method", "POST"},
+    {":path", "/"},
+    {":path", "/index.html"},
+    {":scheme", "http"},
+    {":scheme", "https"},
+    {":status", "200"},
+    {":status", "204"},
+    {":status", "206"},
+    {":status", "304"},
+    {":status", "400"},
+    {":status", "404"},
+    {":status", "500"},
+    {"accept-charset", ""},
+    {"accept-encoding", "gzip, deflate"},
+    {"accept-language", ""},
+    {"accept-ranges", ""},
+    {"accept", ""},
+    {"access-control-allow-origin", ""},
+    {"age", ""},
+    {"allow", ""},
+    {"authorization", ""},
+    {"cache-control", ""},
+    {"content-disposition", ""},
+    {"content-encoding", ""},
+    {"content-language", ""},
+    {"content-length", ""},
+    {"content-location", ""},
+    {"content-range", ""},
+    {"content-type", ""},
+    {"cookie", ""},
+    {"date", ""},
+    {"etag", ""},
+    {"expect", ""},
+    {"expires", ""},
+    {"from", ""},
+    {"host", ""},
+    {"if-match", ""},
+    {"if-modified-since", ""},
+    {"if-none-match", ""},
+    {"if-range", ""},
+    {"if-unmodified-since", ""},
+    {"last-modified", ""},
+    {"link", ""},
+    {"location", ""},
+    {"max-forwards", ""},
+    {"proxy-authenticate", ""},
+    {"proxy-authorization", ""},
+    {"range", ""},
+    {"referer", ""},
+    {"refresh", ""},
+    {"retry-after", ""},
+    {"server", ""},
+    {"set-cookie", ""},
+    {"strict-transport-security", ""},
+    {"transfer-encoding", ""},
+    {"user-agent", ""},
+    {"vary", ""},
+    {"via", ""},
+    {"www-authenticate", ""},
+};
+
+constexpr size_t StaticTableSize = sizeof(StaticTable) / sizeof(StaticTable[0]);
+
+/// @brief Huffman code lengths of the 256 octets and EOS (RFC 7541,
+/// Appendix B). the code is canonical, so the codes themselves follow
+/// from the lengths
+constexpr uint8_t HuffmanLengths[257] = {
+    13, 23, 28, 28, 28, 28, 28, 28, 28, 24, 30, 28, 28, 30, 28, 28,
+    28, 28, 28, 28, 28, 28, 30, 28, 28, 28, 28, 28, 28, 28, 28, 28,
+    6, 10, 10, 12, 13, 6, 8, 11, 10, 10, 8, 11, 8, 6, 6, 6,
+    5, 5, 5, 6, 6, 6, 6, 6, 6, 6, 7, 8, 15, 6, 12, 10,
+    13, 6, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+    7, 7, 7, 7, 7, 7, 7, 7, 8, 7, 8, 13, 19, 13, 14, 6,
+    15, 5, 6, 5, 6, 5, 6, 6, 6, 5, 7, 7, 6, 6, 6, 5,
+    6, 7, 6, 5, 5, 6, 7, 7, 7, 7, 7, 15, 11, 14, 13, 28,
+    20, 22, 20, 20, 22, 22, 22, 23, 22, 23, 23, 23, 23, 23, 24, 23,
+    24, 24, 22, 23, 24, 23, 23, 23, 23, 21, 22, 23, 22, 23, 23, 24,
+    22, 21, 20, 22, 22, 23, 23, 21, 23, 22, 22, 24, 21, 22, 23, 23,
+    21, 21, 22, 21, 23, 22, 23, 23, 20, 22, 22, 22, 23, 22, 22, 23,
+    26, 26, 20, 19, 22, 23, 22, 25, 26, 26, 26, 27, 27, 26, 24, 25,
+    19, 21, 26, 27, 27, 26, 27, 24, 21, 21, 26, 26, 28, 27, 27, 27,
+    20, 24, 20, 21, 22, 21, 21, 23, 22, 22, 25, 25, 24, 24, 26, 23,
+    26, 27, 26, 26, 27, 27, 27, 27, 27, 28, 27, 27, 27, 27, 27, 26,
+    30
+};
+
+constexpr uint16_t HuffmanEos = 256;
+constexpr unsigned HuffmanMaxLength = 30;
+
+struct HuffmanTables {
+  uint32_t codes[257];
+  // canonical decoding state per code length
+  uint32_t firstCode[HuffmanMaxLength + 1];
+  uint16_t firstSymbol[HuffmanMaxLength + 1];
+  uint16_t count[HuffmanMaxLength + 1];
+  // symbols ordered by code length, then by value
+  uint16_t symbols[257];
+
+  HuffmanTables() {
+    uint16_t n = 0;
+    for (unsigned length = 0; length <= HuffmanMaxLength; ++length) {
+      firstSymbol[length] = n;
+      count[length] = 0;
+      for (uint16_t symbol = 0; symbol <= HuffmanEos; ++symbol) {
+        if (HuffmanLengths[symbol] == length) {
+          symbols[n++] = symbol;
+          ++count[length];
+        }
+      }
+    }
+    TRI_ASSERT(n == 257);
+
+    uint32_t code = 0;
+    for (unsigned length = 0; length <= HuffmanMaxLength; ++length) {
+      firstCode[length] = code;
+      for (uint16_t i = 0; i < count[length]; ++i) {
+        codes[symbols[firstSymbol[length] + i]] = code++;
+      }
+      code <<= 1;
+    }
+  }
+};
+
+HuffmanTables const& huffman() {
+  static HuffmanTables const tables;
+  return tables;
+}
+
+bool decodeInteger(uint8_t const*& p, uint8_t const* end, uint8_t prefixBits,
+                   uint64_t& value) {
+  TRI_ASSERT(p < end);
+  uint64_t const max = (uint64_t(1) << prefixBits) - 1;
+  value = *p++ & max;
+  if (value < max) {
+    return true;
+  }
+  unsigned shift = 0;
+  while (p < end) {
+    uint8_t const b = *p++;
+    value += uint64_t(b & 0x7f) << shift;
+    if ((b & 0x80) == 0) {
+      return true;
+    }
+    shift += 7;
+    if (shift > 28) {
+      // no sane header block needs integers this large
+      return false;
+    }
+  }
+  return false;
+}
+
+bool decodeString(uint8_t const*& p, uint8_t const* end, std::string& out) {
+  if (p >= end) {
+    return false;
+  }
+  bool const huffmanCoded = (*p & 0x80) != 0;
+  uint64_t length;
+  if (!decodeInteger(p, end, 7, length) || length > uint64_t(end - p)) {
+    return false;
+  }
+  out.clear();
+  if (huffmanCoded) {
+    if (!huffmanDecode(p, length, out)) {
+      return false;
+    }
+  } else {
+    out.assign(reinterpret_cast<char const*>(p), length);
+  }
+  p += length;
+  return true;
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                      DynamicTable
+// -----------------------------------------------------------------------------
+
+void DynamicTable::insert(std::string name, std::string value) {
+  size_t const entrySize = name.size() + value.size() + EntryOverhead;
+  if (entrySize > _maxSize) {
+    // not an error, the table is just emptied (RFC 7541, 4.4)
+    _entries.clear();
+    _size = 0;
+    return;
+  }
+  evict(entrySize);
+  _entries.emplace_front(std::move(name), std::move(value));
+  _size += entrySize;
+}
+
+void DynamicTable::resize(size_t maxSize) {
+  _maxSize = maxSize;
+  evict(0);
+}
+
+void DynamicTable::evict(size_t required) {
+  while (!_entries.empty() && _size + required > _maxSize) {
+    HeaderField const& oldest = _entries.back();
+    _size -= oldest.first.size() + oldest.second.size() + EntryOverhead;
+    _entries.pop_back();
+  }
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                           Decoder
+// -----------------------------------------------------------------------------
+
+Decoder::Result Decoder::decode(uint8_t const* data, size_t length,
+                                std::vector<HeaderField>& headers, size_t maxListSize) {
+  uint8_t const* p = data;
+  uint8_t const* end = data + length;
+  bool fieldSeen = false;
+  size_t listSize = 0;
+
+  auto add = [&](HeaderField&& field) {
+    listSize += field.first.size() + field.second.size() + EntryOverhead;
+    if (listSize > maxListSize) {
+      return false;
+    }
+    headers.emplace_back(std::move(field));
+    fieldSeen = true;
+    return true;
+  };
+
+  while (p < end) {
+    uint8_t const b = *p;
+    uint64_t index;
+
+    if ((b & 0x80) != 0) {
+      // indexed header field
+      HeaderField field;
+      if (!decodeInteger(p, end, 7, index) || !lookup(index, field)) {
+        return Result::COMPRESSION_ERROR;
+      }
+      if (!add(std::move(field))) {
+        return Result::LIST_TOO_LARGE;
+      }
+      continue;
+    }
+
+    if ((b & 0xe0) == 0x20) {
+      // dynamic table size update, only allowed at the start of a block
+      if (fieldSeen || !decodeInteger(p, end, 5, index) || index > _maxTableSize) {
+        return Result::COMPRESSION_ERROR;
+      }
+      _table.resize(static_cast<size_t>(index));
+      continue;
+    }
+
+    // literal header field, with incremental indexing (01), without
+    // indexing (0000) or never indexed (0001)
+    bool const addToTable = (b & 0xc0) == 0x40;
+    HeaderField field;
+    if (!decodeInteger(p, end, addToTable ? 6 : 4, index)) {
+      return Result::COMPRESSION_ERROR;
+    }
+    if (index == 0) {
+      if (!decodeString(p, end, field.first)) {
+        return Result::COMPRESSION_ERROR;
+      }
+    } else if (!lookup(index, field)) {
+      return Result::COMPRESSION_ERROR;
+    }
+    if (!decodeString(p, end, field.second)) {
+      return Result::COMPRESSION_ERROR;
+    }
+    if (addToTable) {
+      _table.insert(field.first, field.second);
+    }
+    if (!add(std::move(field))) {
+      return Result::LIST_TOO_LARGE;
+    }
+  }
+
+  return Result::OK;
+}
+
+bool Decoder::lookup(uint64_t index, HeaderField& field) const {
+  if (index == 0) {
+    return false;
+  }
+  if (index <= StaticTableSize) {
+    field.first = StaticTable[index - 1].name;
+    field.second = StaticTable[index - 1].value;
+    return true;
+  }
+  index -= StaticTableSize + 1;
+  if (index >= _table.entries()) {
+    return false;
+  }
+  field = _table.at(static_cast<size_t>(index));
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                           Encoder
+// -----------------------------------------------------------------------------
+
+void Encoder::setMaxTableSize(size_t maxSize) {
+  // we never use more than the default, even if the peer allows it
+  maxSize = std::min(maxSize, DefaultTableSize);
+  if (maxSize != _table.maxSize()) {
+    _pendingMinSize = std::min(_pendingMinSize, maxSize);
+    _table.resize(maxSize);
+  }
+}
+
+void Encoder::encode(std::vector<HeaderField> const& headers, std::string& out) {
+  if (_pendingMinSize != SIZE_MAX) {
+    // signal the smallest size the table had, then the final size, so the
+    // decoder evicts the same entries we did (RFC 7541, 4.2)
+    if (_pendingMinSize < _table.maxSize()) {
+      encodeInteger(_pendingMinSize, 5, 0x20, out);
+    }
+    encodeInteger(_table.maxSize(), 5, 0x20, out);
+    _pendingMinSize = SIZE_MAX;
+  }
+
+  for (auto const& field : headers) {
+    encodeField(field, out);
+  }
+}
+
+void Encoder::encodeField(HeaderField const& field, std::string& out) {
+  std::string const& name = field.first;
+  std::string const& value = field.second;
+  uint64_t nameIndex = 0;
+
+  for (size_t i = 0; i < StaticTableSize; ++i) {
+    if (name == StaticTable[i].name) {
+      if (value == StaticTable[i].value) {
+        encodeInteger(i + 1, 7, 0x80, out);
+        return;
+      }
+      if (nameIndex == 0) {
+        nameIndex = i + 1;
+      }
+    }
+  }
+
+  for (size_t i = 0; i < _table.entries(); ++i) {
+    HeaderField const& entry = _table.at(i);
+    if (name == entry.first) {
+      if (value == entry.second) {
+        encodeInteger(StaticTableSize + 1 + i, 7, 0x80, out);
+        return;
+      }
+      if (nameIndex == 0) {
+        nameIndex = StaticTableSize + 1 + i;
+      }
+    }
+  }
+
+  if (name == "set-cookie" || name == "authorization" || name == "www-authenticate") {
+    // credentials must not end up in a compression context
+    encodeInteger(nameIndex, 4, 0x10, out);
+  } else if (name == "content-length" || name == "date" || name == "etag" ||
+             name.size() + value.size() + EntryOverhead > _table.maxSize() / 2) {
+    // values that hardly ever repeat would only flush the table
+    encodeInteger(nameIndex, 4, 0x00, out);
+  } else {
+    encodeInteger(nameIndex, 6, 0x40, out);
+    _table.insert(name, value);
+  }
+
+  if (nameIndex == 0) {
+    encodeString(name.data(), name.size(), out);
+  }
+  encodeString(value.data(), value.size(), out);
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 primitive codecs
+// -----------------------------------------------------------------------------
+
+void arangodb::rest::hpack::encodeInteger(uint64_t value, uint8_t prefixBits,
+                                          uint8_t flags, std::string& out) {
+  uint64_t const max = (uint64_t(1) << prefixBits) - 1;
+  if (value < max) {
+    out.push_back(static_cast<char>(flags | value));
+    return;
+  }
+  out.push_back(static_cast<char>(flags | max));
+  value -= max;
+  while (value >= 0x80) {
+    out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<char>(value));
+}
+
+void arangodb::rest::hpack::encodeString(char const* data, size_t length,
+                                         std::string& out) {
+  size_t const huffmanLength = huffmanEncodedLength(data, length);
+  if (huffmanLength < length) {
+    encodeInteger(huffmanLength, 7, 0x80, out);
+    huffmanEncode(data, length, out);
+  } else {
+    encodeInteger(length, 7, 0x00, out);
+    out.append(data, length);
+  }
+}
+
+bool arangodb::rest::hpack::huffmanDecode(uint8_t const* data, size_t length,
+                                          std::string& out) {
+  HuffmanTables const& tables = huffman();
+  uint32_t code = 0;
+  unsigned codeLength = 0;
+
+  for (size_t i = 0; i < length; ++i) {
+    uint8_t const b = data[i];
+    for (int bit = 7; bit >= 0; --bit) {
+      code = (code << 1) | ((b >> bit) & 1);
+      ++codeLength;
+      // codes of one length are consecutive, prefixes of longer codes
+      // are larger than all of them
+      uint32_t const offset = code - tables.firstCode[codeLength];
+      if (offset < tables.count[codeLength]) {
+        uint16_t const symbol = tables.symbols[tables.firstSymbol[codeLength] + offset];
+        if (symbol == HuffmanEos) {
+          return false;
+        }
+        out.push_back(static_cast<char>(symbol));
+        code = 0;
+        codeLength = 0;
+      } else if (codeLength == HuffmanMaxLength) {
+        return false;
+      }
+    }
+  }
+
+  // padding must be shorter than a byte and consist of the most
+  // significant bits of EOS, which are all set
+  return codeLength < 8 && code == (uint32_t(1) << codeLength) - 1;
+}
+
+void arangodb::rest::hpack::huffmanEncode(char const* data, size_t length,
+                                          std::string& out) {
+  HuffmanTables const& tables = huffman();
+  uint64_t bits = 0;
+  unsigned pending = 0;
+
+  for (size_t i = 0; i < length; ++i) {
+    uint8_t const c = static_cast<uint8_t>(data[i]);
+    bits = (bits << HuffmanLengths[c]) | tables.codes[c];
+    pending += HuffmanLengths[c];
+    while (pending >= 8) {
+      pending -= 8;
+      out.push_back(static_cast<char>(bits >> pending));
+    }
+    bits &= (uint64_t(1) << pending) - 1;
+  }
+
+  if (pending > 0) {
+    // pad with the most significant bits of EOS
+    out.push_back(static_cast<char>((bits << (8 - pending)) | (0xff >> pending)));
+  }
+}
+
+size_t arangodb::rest::hpack::huffmanEncodedLength(char const* data, size_t length) {
+  size_t bits = 0;
+  for (size_t i = 0; i < length; ++i) {
+    bits += HuffmanLengths[static_cast<uint8_t>(data[i])];
+  }
+  return (bits + 7) / 8;
+}
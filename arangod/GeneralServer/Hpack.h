@@ -0,0 +1,145 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_GENERAL_SERVER_HPACK_H
+#define ARANGOD_GENERAL_SERVER_HPACK_H 1
+
+#include "Basics/Common.h"
+
+#include <deque>
+
+namespace arangodb {
+namespace rest {
+namespace hpack {
+
+/// @brief a single decoded or to be encoded header field
+typedef std::pair<std::string, std::string> HeaderField;
+
+/// @brief default size of the dynamic table (SETTINGS_HEADER_TABLE_SIZE)
+static constexpr size_t DefaultTableSize = 4096;
+
+/// @brief the dynamic table of one direction of an HTTP/2 connection.
+/// entries are stored newest first, as they are addressed by HPACK
+class DynamicTable {
+ public:
+  explicit DynamicTable(size_t maxSize) : _size(0), _maxSize(maxSize) {}
+
+  size_t size() const { return _size; }
+  size_t maxSize() const { return _maxSize; }
+  size_t entries() const { return _entries.size(); }
+
+  /// @brief entry with the 0-based position, 0 being the newest entry
+  HeaderField const& at(size_t position) const { return _entries[position]; }
+
+  /// @brief adds an entry, evicting old ones. entries larger than the
+  /// table leave an empty table behind
+  void insert(std::string name, std::string value);
+
+  /// @brief changes the maximum size, evicting entries as needed
+  void resize(size_t maxSize);
+
+ private:
+  void evict(size_t required);
+
+ private:
+  std::deque<HeaderField> _entries;
+  size_t _size;
+  size_t _maxSize;
+};
+
+/// @brief HPACK (RFC 7541) decoder. one instance per connection, as the
+/// dynamic table is shared by all header blocks the peer sends
+class Decoder {
+ public:
+  enum class Result {
+    OK,
+    /// @brief the block is not valid HPACK
+    COMPRESSION_ERROR,
+    /// @brief the decoded header list exceeds the given limit
+    LIST_TOO_LARGE
+  };
+
+  /// @brief maxTableSize is the table size announced in our SETTINGS
+  explicit Decoder(size_t maxTableSize = DefaultTableSize)
+      : _table(maxTableSize), _maxTableSize(maxTableSize) {}
+
+  /// @brief decodes a complete header block (HEADERS plus all
+  /// CONTINUATION payloads). the size of the decoded header list, counted
+  /// as in SETTINGS_MAX_HEADER_LIST_SIZE (name plus value plus 32 bytes per
+  /// field), must not exceed maxListSize, as a small block can reference
+  /// large table entries many times. on any error, the connection must be
+  /// torn down, as the table state is lost
+  Result decode(uint8_t const* data, size_t length,
+                std::vector<HeaderField>& headers, size_t maxListSize = SIZE_MAX);
+
+  DynamicTable const& table() const { return _table; }
+
+ private:
+  bool lookup(uint64_t index, HeaderField& field) const;
+
+ private:
+  DynamicTable _table;
+  size_t const _maxTableSize;
+};
+
+/// @brief HPACK (RFC 7541) encoder. one instance per connection
+class Encoder {
+ public:
+  Encoder() : _table(DefaultTableSize), _pendingMinSize(SIZE_MAX) {}
+
+  /// @brief applies the SETTINGS_HEADER_TABLE_SIZE of the peer. the
+  /// required dynamic table size update is emitted with the next block
+  void setMaxTableSize(size_t maxSize);
+
+  /// @brief appends the header block for the fields to out
+  void encode(std::vector<HeaderField> const& headers, std::string& out);
+
+  DynamicTable const& table() const { return _table; }
+
+ private:
+  void encodeField(HeaderField const& field, std::string& out);
+
+ private:
+  DynamicTable _table;
+  // smallest table size set since the last block, SIZE_MAX if unchanged
+  size_t _pendingMinSize;
+};
+
+/// @brief HPACK integer with an N bit prefix, the other bits of the first
+/// byte are taken from the flags
+void encodeInteger(uint64_t value, uint8_t prefixBits, uint8_t flags, std::string& out);
+
+/// @brief HPACK string literal, Huffman coded if that is shorter
+void encodeString(char const* data, size_t length, std::string& out);
+
+/// @brief decodes a Huffman coded string, returns false on invalid input
+bool huffmanDecode(uint8_t const* data, size_t length, std::string& out);
+
+/// @brief appends the Huffman code of the data to out
+void huffmanEncode(char const* data, size_t length, std::string& out);
+
+/// @brief number of bytes the Huffman code of the data takes
+size_t huffmanEncodedLength(char const* data, size_t length);
+
+}  // namespace hpack
+}  // namespace rest
+}  // namespace arangodb
+
+#endif
@@ -0,0 +1,1065 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Http2CommTask.h"
+
+#include "Basics/StaticStrings.h"
+#include "Basics/StringBuffer.h"
+#include "Basics/StringUtils.h"
+#include "Cluster/ServerState.h"
+#include "GeneralServer/GeneralServer.h"
+#include "GeneralServer/GeneralServerFeature.h"
+#include "GeneralServer/HttpCommTask.h"
+#include "Logger/Logger.h"
+#include "Rest/HttpRequest.h"
+#include "Rest/HttpResponse.h"
+#include "Statistics/ConnectionStatistics.h"
+#include "Statistics/RequestStatistics.h"
+
+#include <algorithm>
+
+using namespace arangodb;
+using namespace arangodb::basics;
+using namespace arangodb::rest;
+
+namespace {
+
+constexpr size_t FrameHeaderLength = 9;
+
+constexpr uint8_t FrameData = 0x0;
+constexpr uint8_t FrameHeaders = 0x1;
+constexpr uint8_t FramePriority = 0x2;
+constexpr uint8_t FrameRstStream = 0x3;
+constexpr uint8_t FrameSettings = 0x4;
+constexpr uint8_t FramePushPromise = 0x5;
+constexpr uint8_t FramePing = 0x6;
+constexpr uint8_t FrameGoAway = 0x7;
+constexpr uint8_t FrameWindowUpdate = 0x8;
+constexpr uint8_t FrameContinuation = 0x9;
+
+constexpr uint8_t FlagEndStream = 0x1;
+constexpr uint8_t FlagAck = 0x1;
+constexpr uint8_t FlagEndHeaders = 0x4;
+constexpr uint8_t FlagPadded = 0x8;
+constexpr uint8_t FlagPriority = 0x20;
+
+constexpr uint16_t SettingsHeaderTableSize = 0x1;
+constexpr uint16_t SettingsEnablePush = 0x2;
+constexpr uint16_t SettingsMaxConcurrentStreams = 0x3;
+constexpr uint16_t SettingsInitialWindowSize = 0x4;
+constexpr uint16_t SettingsMaxFrameSize = 0x5;
+constexpr uint16_t SettingsMaxHeaderListSize = 0x6;
+
+// window and frame sizes every connection starts with
+constexpr int64_t DefaultWindowSize = 65535;
+constexpr uint32_t DefaultFrameSize = 16384;
+constexpr int64_t MaximalWindowSize = 0x7fffffff;
+constexpr uint32_t MaximalPeerFrameSize = 0xffffff;
+
+uint32_t readUInt32(uint8_t const* p) {
+  return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) |
+         uint32_t(p[3]);
+}
+
+void writeUInt32(char* p, uint32_t value) {
+  p[0] = static_cast<char>(value >> 24);
+  p[1] = static_cast<char>(value >> 16);
+  p[2] = static_cast<char>(value >> 8);
+  p[3] = static_cast<char>(value);
+}
+
+void writeSetting(char* p, uint16_t id, uint32_t value) {
+  p[0] = static_cast<char>(id >> 8);
+  p[1] = static_cast<char>(id);
+  writeUInt32(p + 2, value);
+}
+
+/// @brief header values are turned into HTTP/1 header lines, so they must
+/// not be able to end a line
+bool isValidField(hpack::HeaderField const& field) {
+  auto invalid = [](char c) { return c == '\r' || c == '\n' || c == '\0'; };
+  return !field.first.empty() &&
+         std::none_of(field.first.begin(), field.first.end(), invalid) &&
+         std::none_of(field.second.begin(), field.second.end(), invalid);
+}
+
+/// @brief header fields that are specific to an HTTP/1 connection and
+/// must not be used with HTTP/2 (RFC 7540, 8.1.2.2)
+bool isConnectionSpecific(std::string const& name) {
+  return name == "connection" || name == "keep-alive" ||
+         name == "proxy-connection" || name == "transfer-encoding" || name == "upgrade";
+}
+
+/// @brief translates a rendered HTTP/1 response header into HTTP/2 fields
+void translateResponseHeader(char const* p, char const* end,
+                             std::vector<hpack::HeaderField>& fields) {
+  static char const* const crlf = "\r\n";
+
+  // status line, "HTTP/1.1 200 OK"
+  char const* eol = std::search(p, end, crlf, crlf + 2);
+  TRI_ASSERT(eol - p >= 12);
+  fields.emplace_back(":status", std::string(p + 9, 3));
+
+  for (p = eol + 2; p < end; p = eol + 2) {
+    eol = std::search(p, end, crlf, crlf + 2);
+    if (eol == p || eol == end) {
+      break;
+    }
+    char const* colon = std::find(p, eol, ':');
+    if (colon == eol) {
+      continue;
+    }
+    std::string name(p, colon);
+    std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+    if (isConnectionSpecific(name)) {
+      continue;
+    }
+    char const* value = colon + 1;
+    while (value < eol && *value == ' ') {
+      ++value;
+    }
+    fields.emplace_back(std::move(name), std::string(value, eol));
+  }
+}
+
+}  // namespace
+
+char const* const Http2CommTask::ConnectionPreface =
+    "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n";
+size_t const Http2CommTask::ConnectionPrefaceLength = 24;
+
+uint32_t const Http2CommTask::MaximalConcurrentStreams = 128;
+uint32_t const Http2CommTask::MaximalFrameSize = DefaultFrameSize;
+uint32_t const Http2CommTask::InitialWindowSize = 1024 * 1024;  //    1 MB
+
+Http2CommTask::Stream::Stream(int64_t window)
+    : requestType(rest::RequestType::ILLEGAL),
+      sendWindow(window),
+      receiveWindow(InitialWindowSize),
+      remoteClosed(false),
+      trailers(false),
+      responding(false),
+      responseOffset(0),
+      responseStatistics(nullptr) {}
+
+Http2CommTask::Stream::~Stream() {
+  if (responseStatistics != nullptr) {
+    responseStatistics->release();
+  }
+}
+
+Http2CommTask::Http2CommTask(GeneralServer& server, std::unique_ptr<Socket> socket,
+                             ConnectionInfo&& info, double timeout, bool skipInit)
+    : GeneralCommTask(server, "Http2CommTask", std::move(socket),
+                      std::move(info), timeout, skipInit),
+      _decoder(hpack::DefaultTableSize),
+      _readPosition(0),
+      _prefaceReceived(false),
+      _goAwayReceived(false),
+      _allowMethodOverride(GeneralServerFeature::allowMethodOverride()),
+      _lastStreamId(0),
+      _continuationStreamId(0),
+      _sendWindow(DefaultWindowSize),
+      _receiveWindow(DefaultWindowSize),
+      _peerInitialWindowSize(DefaultWindowSize),
+      _peerMaxFrameSize(DefaultFrameSize) {
+  _protocol = "http2";
+
+  ConnectionStatistics::SET_HTTP(_connectionStatistics);
+}
+
+Http2CommTask::~Http2CommTask() {}
+
+// whether or not this task can mix sync and async I/O
+bool Http2CommTask::canUseMixedIO() const {
+  // in case SSL is used, we cannot use a combination of sync and async I/O
+  // because that will make TLS fall apart
+  return !_peer->isEncrypted();
+}
+
+// reads one frame from the read buffer
+bool Http2CommTask::processRead(double startTime) {
+  TRI_ASSERT(_peer->runningInThisThread());
+
+  cancelKeepAlive();
+
+  if (!_prefaceReceived) {
+    if (_readBuffer.length() < ConnectionPrefaceLength) {
+      return false;
+    }
+    if (std::memcmp(_readBuffer.c_str(), ConnectionPreface, ConnectionPrefaceLength) != 0) {
+      LOG_TOPIC("fd2d7", DEBUG, Logger::COMMUNICATION)
+          << "invalid HTTP/2 connection preface, closing connection";
+      _closeRequested = true;
+      return false;
+    }
+    _readPosition = ConnectionPrefaceLength;
+    _prefaceReceived = true;
+    sendServerPreface();
+  }
+
+  size_t const available = _readBuffer.length() - _readPosition;
+  if (available < FrameHeaderLength) {
+    return false;
+  }
+
+  uint8_t const* p = reinterpret_cast<uint8_t const*>(_readBuffer.c_str()) + _readPosition;
+  uint32_t const length = (uint32_t(p[0]) << 16) | (uint32_t(p[1]) << 8) | uint32_t(p[2]);
+
+  if (length > MaximalFrameSize) {
+    return connectionError(ErrorCode::FRAME_SIZE_ERROR,
+                           "frame exceeds the maximal frame size");
+  }
+  if (available < FrameHeaderLength + length) {
+    // let client send more
+    return false;
+  }
+
+  _readPosition += FrameHeaderLength + length;
+
+  return processFrame(startTime, p[3], p[4], readUInt32(p + 5) & 0x7fffffff,
+                      p + FrameHeaderLength, length);
+}
+
+#ifdef ARANGODB_USE_GOOGLE_TESTS
+bool Http2CommTask::receiveForTest(char const* data, size_t length) {
+  addToReadBuffer(data, length);
+  while (processRead(TRI_microtime())) {
+  }
+  compactify();
+  return !_closeRequested.load() && !_closedSend.load();
+}
+#endif
+
+void Http2CommTask::compactify() {
+  if (_readPosition > 0) {
+    _readBuffer.erase_front(_readPosition);
+    _readPosition = 0;
+  }
+}
+
+bool Http2CommTask::processFrame(double startTime, uint8_t type, uint8_t flags,
+                                 uint32_t streamId, uint8_t const* payload,
+                                 uint32_t length) {
+  if (_continuationStreamId != 0 && type != FrameContinuation) {
+    return connectionError(ErrorCode::PROTOCOL_ERROR,
+                           "header block interrupted by another frame");
+  }
+
+  switch (type) {
+    case FrameData:
+      return processData(flags, streamId, payload, length);
+
+    case FrameHeaders:
+      return processHeaders(startTime, flags, streamId, payload, length);
+
+    case FramePriority:
+      if (streamId == 0) {
+        return connectionError(ErrorCode::PROTOCOL_ERROR, "PRIORITY on stream 0");
+      }
+      if (length != 5) {
+        streamError(streamId, ErrorCode::FRAME_SIZE_ERROR);
+      }
+      // all streams are treated alike
+      return true;
+
+    case FrameRstStream:
+      if (streamId == 0 || streamId > _lastStreamId) {
+        return connectionError(ErrorCode::PROTOCOL_ERROR,
+                               "RST_STREAM on an idle stream");
+      }
+      if (length != 4) {
+        return connectionError(ErrorCode::FRAME_SIZE_ERROR,
+                               "RST_STREAM with invalid length");
+      }
+      forgetStream(streamId);
+      return true;
+
+    case FrameSettings:
+      return processSettings(flags, streamId, payload, length);
+
+    case FramePushPromise:
+      return connectionError(ErrorCode::PROTOCOL_ERROR,
+                             "PUSH_PROMISE sent by a client");
+
+    case FramePing:
+      if (streamId != 0) {
+        return connectionError(ErrorCode::PROTOCOL_ERROR, "PING on a stream");
+      }
+      if (length != 8) {
+        return connectionError(ErrorCode::FRAME_SIZE_ERROR, "PING with invalid length");
+      }
+      if ((flags & FlagAck) == 0) {
+        sendFrame(FramePing, FlagAck, 0, reinterpret_cast<char const*>(payload), length);
+      }
+      return true;
+
+    case FrameGoAway:
+      if (streamId != 0) {
+        return connectionError(ErrorCode::PROTOCOL_ERROR, "GOAWAY on a stream");
+      }
+      // the client does not open new streams, finish the open ones
+      _goAwayReceived = true;
+      if (_streams.empty()) {
+        return connectionError(ErrorCode::NONE, "client sent GOAWAY");
+      }
+      return true;
+
+    case FrameWindowUpdate:
+      return processWindowUpdate(streamId, payload, length);
+
+    case FrameContinuation:
+      return processContinuation(flags, streamId, payload, length);
+
+    default:
+      // unknown frame types must be ignored
+      return true;
+  }
+}
+
+bool Http2CommTask::processData(uint8_t flags, uint32_t streamId,
+                                uint8_t const* payload, uint32_t length) {
+  if (streamId == 0) {
+    return connectionError(ErrorCode::PROTOCOL_ERROR, "DATA on stream 0");
+  }
+  if (streamId > _lastStreamId) {
+    return connectionError(ErrorCode::PROTOCOL_ERROR, "DATA on an idle stream");
+  }
+
+  // the whole frame, including padding, is subject to flow control
+  if (length > _receiveWindow) {
+    return connectionError(ErrorCode::FLOW_CONTROL_ERROR,
+                           "connection flow control window exceeded");
+  }
+  _receiveWindow -= length;
+  if (_receiveWindow < InitialWindowSize / 2) {
+    sendWindowUpdate(0, static_cast<uint32_t>(InitialWindowSize - _receiveWindow));
+    _receiveWindow = InitialWindowSize;
+  }
+
+  uint8_t const* data = payload;
+  size_t size = length;
+  if ((flags & FlagPadded) != 0) {
+    if (length == 0 || payload[0] >= length) {
+      return connectionError(ErrorCode::PROTOCOL_ERROR, "invalid padding");
+    }
+    data = payload + 1;
+    size = length - 1 - payload[0];
+  }
+
+  auto it = _streams.find(streamId);
+  if (it == _streams.end()) {
+    // the stream was reset or has been answered already
+    return true;
+  }
+
+  Stream& stream = it->second;
+  if (stream.remoteClosed) {
+    streamError(streamId, ErrorCode::STREAM_CLOSED);
+    return true;
+  }
+  if (length > stream.receiveWindow) {
+    streamError(streamId, ErrorCode::FLOW_CONTROL_ERROR);
+    return true;
+  }
+  stream.receiveWindow -= length;
+
+  if (!stream.responding) {
+    if (stream.body.size() + size > HttpCommTask::MaximalBodySize) {
+      // the stream is answered right away and the rest of the body
+      // is dropped
+      addSimpleResponse(rest::ResponseCode::REQUEST_ENTITY_TOO_LARGE,
+                        rest::ContentType::UNSET, streamId, VPackBuffer<uint8_t>());
+      return true;
+    }
+    stream.body.append(reinterpret_cast<char const*>(data), size);
+  }
+
+  if ((flags & FlagEndStream) != 0) {
+    stream.remoteClosed = true;
+    if (!stream.responding) {
+      processRequest(streamId, stream);
+    }
+  } else if (stream.receiveWindow < InitialWindowSize / 2) {
+    sendWindowUpdate(streamId, static_cast<uint32_t>(InitialWindowSize - stream.receiveWindow));
+    stream.receiveWindow = InitialWindowSize;
+  }
+
+  return true;
+}
+
+bool Http2CommTask::processHeaders(double startTime, uint8_t flags, uint32_t streamId,
+                                   uint8_t const* payload, uint32_t length) {
+  if (streamId == 0 || (streamId & 1) == 0) {
+    return connectionError(ErrorCode::PROTOCOL_ERROR,
+                           "HEADERS on a stream not opened by the client");
+  }
+
+  uint8_t const* fragment = payload;
+  size_t size = length;
+  if ((flags & FlagPadded) != 0) {
+    if (size == 0 || payload[0] >= size) {
+      return connectionError(ErrorCode::PROTOCOL_ERROR, "invalid padding");
+    }
+    ++fragment;
+    size -= 1 + payload[0];
+  }
+  if ((flags & FlagPriority) != 0) {
+    // stream dependency and weight, not taken into account
+    if (size < 5) {
+      return connectionError(ErrorCode::PROTOCOL_ERROR, "invalid priority");
+    }
+    fragment += 5;
+    size -= 5;
+  }
+
+  Stream* stream = nullptr;
+  auto it = _streams.find(streamId);
+
+  if (it != _streams.end()) {
+    // trailers of a request whose body is still being received
+    if (it->second.remoteClosed || it->second.responding) {
+      return connectionError(ErrorCode::STREAM_CLOSED, "HEADERS on a closed stream");
+    }
+    if ((flags & FlagEndStream) == 0) {
+      return connectionError(ErrorCode::PROTOCOL_ERROR, "trailers without END_STREAM");
+    }
+    stream = &it->second;
+    stream->trailers = true;
+  } else {
+    if (streamId <= _lastStreamId) {
+      return connectionError(ErrorCode::STREAM_CLOSED, "HEADERS on a closed stream");
+    }
+    _lastStreamId = streamId;
+    stream = &_streams
+                  .emplace(std::piecewise_construct, std::forward_as_tuple(streamId),
+                           std::forward_as_tuple(_peerInitialWindowSize))
+                  .first->second;
+
+    RequestStatistics* stat = acquireStatistics(streamId);
+    RequestStatistics::SET_READ_START(stat, startTime);
+  }
+
+  stream->headerBlock.append(reinterpret_cast<char const*>(fragment), size);
+  if ((flags & FlagEndStream) != 0) {
+    stream->remoteClosed = true;
+  }
+
+  if ((flags & FlagEndHeaders) == 0) {
+    _continuationStreamId = streamId;
+    return true;
+  }
+  return headersComplete(streamId, *stream);
+}
+
+bool Http2CommTask::processContinuation(uint8_t flags, uint32_t streamId,
+                                        uint8_t const* payload, uint32_t length) {
+  if (_continuationStreamId == 0 || streamId != _continuationStreamId) {
+    return connectionError(ErrorCode::PROTOCOL_ERROR, "unexpected CONTINUATION");
+  }
+
+  auto it = _streams.find(streamId);
+  TRI_ASSERT(it != _streams.end());
+  Stream& stream = it->second;
+
+  if (stream.headerBlock.size() + length > HttpCommTask::MaximalHeaderSize) {
+    // the block cannot be skipped, as it changes the compression state
+    return connectionError(ErrorCode::ENHANCE_YOUR_CALM, "header block too large");
+  }
+  stream.headerBlock.append(reinterpret_cast<char const*>(payload), length);
+
+  if ((flags & FlagEndHeaders) == 0) {
+    return true;
+  }
+  _continuationStreamId = 0;
+  return headersComplete(streamId, stream);
+}
+
+bool Http2CommTask::processSettings(uint8_t flags, uint32_t streamId,
+                                    uint8_t const* payload, uint32_t length) {
+  if (streamId != 0) {
+    return connectionError(ErrorCode::PROTOCOL_ERROR, "SETTINGS on a stream");
+  }
+  if ((flags & FlagAck) != 0) {
+    if (length != 0) {
+      return connectionError(ErrorCode::FRAME_SIZE_ERROR, "SETTINGS ack with payload");
+    }
+    return true;
+  }
+  if (length % 6 != 0) {
+    return connectionError(ErrorCode::FRAME_SIZE_ERROR, "SETTINGS with invalid length");
+  }
+
+  for (uint32_t i = 0; i < length; i += 6) {
+    uint16_t const id = static_cast<uint16_t>((payload[i] << 8) | payload[i + 1]);
+    uint32_t const value = readUInt32(payload + i + 2);
+
+    switch (id) {
+      case SettingsHeaderTableSize:
+        _encoder.setMaxTableSize(value);
+        break;
+
+      case SettingsEnablePush:
+        // we never push
+        if (value > 1) {
+          return connectionError(ErrorCode::PROTOCOL_ERROR, "invalid ENABLE_PUSH");
+        }
+        break;
+
+      case SettingsInitialWindowSize: {
+        if (value > MaximalWindowSize) {
+          return connectionError(ErrorCode::FLOW_CONTROL_ERROR,
+                                 "invalid INITIAL_WINDOW_SIZE");
+        }
+        // applies to the windows of all open streams (RFC 7540, 6.9.2)
+        int64_t const delta = int64_t(value) - int64_t(_peerInitialWindowSize);
+        for (auto& it : _streams) {
+          it.second.sendWindow += delta;
+          if (it.second.sendWindow > MaximalWindowSize) {
+            return connectionError(ErrorCode::FLOW_CONTROL_ERROR,
+                                   "stream flow control window overflow");
+          }
+        }
+        _peerInitialWindowSize = value;
+        break;
+      }
+
+      case SettingsMaxFrameSize:
+        if (value < DefaultFrameSize || value > MaximalPeerFrameSize) {
+          return connectionError(ErrorCode::PROTOCOL_ERROR, "invalid MAX_FRAME_SIZE");
+        }
+        _peerMaxFrameSize = value;
+        break;
+
+      default:
+        // MAX_CONCURRENT_STREAMS only limits pushed streams, our headers are
+        // far below any MAX_HEADER_LIST_SIZE, unknown settings are ignored
+        break;
+    }
+  }
+
+  sendFrame(FrameSettings, FlagAck, 0, nullptr, 0);
+  // a larger window may unblock pending response bodies
+  flushStreams();
+  return true;
+}
+
+bool Http2CommTask::processWindowUpdate(uint32_t streamId, uint8_t const* payload,
+                                        uint32_t length) {
+  if (length != 4) {
+    return connectionError(ErrorCode::FRAME_SIZE_ERROR,
+                           "WINDOW_UPDATE with invalid length");
+  }
+  uint32_t const increment = readUInt32(payload) & 0x7fffffff;
+
+  if (streamId == 0) {
+    if (increment == 0) {
+      return connectionError(ErrorCode::PROTOCOL_ERROR, "WINDOW_UPDATE of 0");
+    }
+    _sendWindow += increment;
+    if (_sendWindow > MaximalWindowSize) {
+      return connectionError(ErrorCode::FLOW_CONTROL_ERROR,
+                             "connection flow control window overflow");
+    }
+  } else {
+    auto it = _streams.find(streamId);
+    if (it == _streams.end()) {
+      // updates may still arrive for streams closed just now
+      return true;
+    }
+    if (increment == 0) {
+      streamError(streamId, ErrorCode::PROTOCOL_ERROR);
+      return true;
+    }
+    it->second.sendWindow += increment;
+    if (it->second.sendWindow > MaximalWindowSize) {
+      streamError(streamId, ErrorCode::FLOW_CONTROL_ERROR);
+      return true;
+    }
+  }
+
+  flushStreams();
+  return true;
+}
+
+bool Http2CommTask::headersComplete(uint32_t streamId, Stream& stream) {
+  std::vector<hpack::HeaderField> fields;
+  // enforces the SETTINGS_MAX_HEADER_LIST_SIZE we announced
+  auto const res =
+      _decoder.decode(reinterpret_cast<uint8_t const*>(stream.headerBlock.data()),
+                      stream.headerBlock.size(), fields, HttpCommTask::MaximalHeaderSize);
+  if (res == hpack::Decoder::Result::LIST_TOO_LARGE) {
+    return connectionError(ErrorCode::ENHANCE_YOUR_CALM, "header list too large");
+  }
+  if (res != hpack::Decoder::Result::OK) {
+    return connectionError(ErrorCode::COMPRESSION_ERROR, "invalid header block");
+  }
+  std::string().swap(stream.headerBlock);
+
+  if (stream.trailers) {
+    // trailers carry nothing a handler could use
+    stream.trailers = false;
+  } else if (_streams.size() > MaximalConcurrentStreams) {
+    // the block had to be decoded anyway to keep the compression state
+    streamError(streamId, ErrorCode::REFUSED_STREAM);
+    return true;
+  } else {
+    stream.headers = std::move(fields);
+
+    if (!stream.remoteClosed) {
+      auto it = std::find_if(stream.headers.begin(), stream.headers.end(),
+                             [](hpack::HeaderField const& field) {
+                               return field.first == "expect";
+                             });
+      if (it != stream.headers.end() && StringUtils::trim(it->second) == "100-continue") {
+        LOG_TOPIC("962ed", TRACE, Logger::COMMUNICATION)
+            << "received a 100-continue request";
+        StringBuffer* buffer = leaseStringBuffer(32);
+        appendHeaders(*buffer, streamId, {{":status", "100"}}, false);
+        addWriteBuffer(WriteBuffer(buffer, nullptr));
+      }
+    }
+  }
+
+  if (stream.remoteClosed) {
+    processRequest(streamId, stream);
+  }
+  return true;
+}
+
+void Http2CommTask::processRequest(uint32_t streamId, Stream& stream) {
+  TRI_ASSERT(_peer->runningInThisThread());
+
+  // the request is handed to HttpRequest as an HTTP/1 header, so that all
+  // of its header parsing (URL, parameters, cookies, method override) is
+  // shared with HttpCommTask
+  std::string method;
+  std::string path;
+  std::string authority;
+  std::string cookies;
+  std::string fields;
+  bool hostSeen = false;
+
+  for (auto const& field : stream.headers) {
+    if (!isValidField(field)) {
+      streamError(streamId, ErrorCode::PROTOCOL_ERROR);
+      return;
+    }
+    std::string const& name = field.first;
+    if (name[0] == ':') {
+      if (name == ":method") {
+        method = field.second;
+      } else if (name == ":path") {
+        path = field.second;
+      } else if (name == ":authority") {
+        authority = field.second;
+      }
+      // :scheme has no meaning for the handlers
+      continue;
+    }
+    if (name == "cookie") {
+      // cookies may be split into several fields (RFC 7540, 8.1.2.5)
+      if (!cookies.empty()) {
+        cookies.append("; ");
+      }
+      cookies.append(field.second);
+      continue;
+    }
+    if (name == "content-length" || isConnectionSpecific(name)) {
+      continue;
+    }
+    if (name == "host") {
+      hostSeen = true;
+    }
+    fields.append(name).append(": ").append(field.second).append("\r\n");
+  }
+
+  if (method.empty() || path.empty() || path.find(' ') != std::string::npos) {
+    streamError(streamId, ErrorCode::PROTOCOL_ERROR);
+    return;
+  }
+
+  std::string header;
+  header.reserve(method.size() + path.size() + authority.size() +
+                 cookies.size() + fields.size() + 64);
+  header.append(method).append(" ").append(path).append(" HTTP/1.1\r\n");
+  if (!authority.empty() && !hostSeen) {
+    header.append("host: ").append(authority).append("\r\n");
+  }
+  if (!cookies.empty()) {
+    header.append("cookie: ").append(cookies).append("\r\n");
+  }
+  header.append(fields);
+  header.append("content-length: ")
+      .append(std::to_string(stream.body.size()))
+      .append("\r\n\r\n");
+  std::vector<hpack::HeaderField>().swap(stream.headers);
+
+  std::unique_ptr<HttpRequest> request(
+      new HttpRequest(_connectionInfo, header.data(), header.size(), _allowMethodOverride));
+  request->setClientTaskId(_taskId);
+  request->setProtocol(_protocol);
+  request->_messageId = streamId;
+
+  rest::RequestType const requestType = request->requestType();
+  stream.requestType = requestType;
+
+  RequestStatistics* stat = statistics(streamId);
+  RequestStatistics::SET_READ_END(stat);
+  RequestStatistics::ADD_RECEIVED_BYTES(stat, header.size() + stream.body.size());
+  RequestStatistics::SET_REQUEST_TYPE(stat, requestType);
+
+  if (requestType == rest::RequestType::ILLEGAL) {
+    addSimpleResponse(rest::ResponseCode::METHOD_NOT_ALLOWED,
+                      rest::ContentType::UNSET, streamId, VPackBuffer<uint8_t>());
+    return;
+  }
+
+  if (!stream.body.empty()) {
+    std::string const& encoding = request->header(StaticStrings::ContentEncoding);
+    if (encoding == "gzip" || encoding == "deflate") {
+      std::string uncompressed;
+      bool const ok =
+          encoding == "gzip"
+              ? StringUtils::gzipUncompress(stream.body.data(), stream.body.size(), uncompressed)
+              : StringUtils::gzipDeflate(stream.body.data(), stream.body.size(), uncompressed);
+      if (!ok) {
+        addErrorResponse(rest::ResponseCode::BAD, request->contentTypeResponse(),
+                         streamId, TRI_ERROR_BAD_PARAMETER,
+                         encoding == "gzip" ? "gzip decoding error"
+                                            : "gzip deflate error");
+        return;
+      }
+      request->setBody(uncompressed.data(), uncompressed.size());
+    } else {
+      request->setBody(stream.body.data(), stream.body.size());
+    }
+    std::string().swap(stream.body);
+  }
+
+  if (requestType == rest::RequestType::OPTIONS) {
+    // no CORS preflights here, browsers do not speak HTTP/2 without TLS
+    HttpResponse resp(rest::ResponseCode::OK, leaseStringBuffer(0));
+    resp._messageId = streamId;
+    resp.setHeaderNCIfNotSet(StaticStrings::Allow, StaticStrings::CorsMethods);
+    addResponse(resp, stealStatistics(streamId));
+    return;
+  }
+
+  rest::ResponseCode const authResult = handleAuthHeader(request.get());
+
+  if (authResult == rest::ResponseCode::SERVER_ERROR) {
+    HttpResponse resp(rest::ResponseCode::UNAUTHORIZED, leaseStringBuffer(0));
+    resp._messageId = streamId;
+    resp.setHeaderNC(StaticStrings::WwwAuthenticate,
+                     "Bearer token_type=\"JWT\", realm=\"ArangoDB\"");
+    addResponse(resp, stealStatistics(streamId));
+    return;
+  }
+
+  // prepare execution will send an error message
+  if (prepareExecution(*request) != RequestFlow::Continue) {
+    return;
+  }
+
+  LOG_TOPIC("6efcd", DEBUG, Logger::REQUESTS)
+      << "\"http2-request-begin\",\"" << (void*)this << "\",\""
+      << _connectionInfo.clientAddress << "\",\""
+      << HttpRequest::translateMethod(requestType) << "\"," << streamId << ",\""
+      << (Logger::logRequestParameters() ? path : path.substr(0, path.find_first_of('?')))
+      << "\"";
+
+  auto resp = std::make_unique<HttpResponse>(rest::ResponseCode::SERVER_ERROR,
+                                             leaseStringBuffer(1024));
+  resp->_messageId = streamId;
+  resp->setContentType(request->contentTypeResponse());
+  resp->setContentTypeRequested(request->contentTypeResponse());
+
+  executeRequest(std::move(request), std::move(resp));
+}
+
+std::unique_ptr<GeneralResponse> Http2CommTask::createResponse(rest::ResponseCode responseCode,
+                                                               uint64_t messageId) {
+  auto resp = std::make_unique<HttpResponse>(responseCode, leaseStringBuffer(0));
+  resp->_messageId = messageId;
+  return resp;
+}
+
+/// @brief send simple response including response body
+void Http2CommTask::addSimpleResponse(rest::ResponseCode code, rest::ContentType respType,
+                                      uint64_t messageId,
+                                      velocypack::Buffer<uint8_t>&& buffer) {
+  try {
+    HttpResponse resp(code, leaseStringBuffer(buffer.size()));
+    resp._messageId = messageId;
+    resp.setContentType(respType);
+    if (!buffer.empty()) {
+      resp.setPayload(std::move(buffer), true, VPackOptions::Defaults);
+    }
+    addResponse(resp, stealStatistics(messageId));
+  } catch (std::exception const& ex) {
+    LOG_TOPIC("a427b", WARN, Logger::COMMUNICATION)
+        << "addSimpleResponse received an exception, resetting stream:" << ex.what();
+    streamError(static_cast<uint32_t>(messageId), ErrorCode::INTERNAL_ERROR);
+  } catch (...) {
+    LOG_TOPIC("962ec", WARN, Logger::COMMUNICATION)
+        << "addSimpleResponse received an exception, resetting stream";
+    streamError(static_cast<uint32_t>(messageId), ErrorCode::INTERNAL_ERROR);
+  }
+}
+
+void Http2CommTask::addResponse(GeneralResponse& baseResponse, RequestStatistics* stat) {
+  TRI_ASSERT(_peer->runningInThisThread());
+
+#ifdef ARANGODB_ENABLE_MAINTAINER_MODE
+  HttpResponse& response = dynamic_cast<HttpResponse&>(baseResponse);
+#else
+  HttpResponse& response = static_cast<HttpResponse&>(baseResponse);
+#endif
+
+  finishExecution(baseResponse);
+
+  uint32_t const streamId = static_cast<uint32_t>(response.messageId());
+  auto it = _streams.find(streamId);
+
+  if (it == _streams.end() || it->second.responding) {
+    // the client has reset the stream in the meantime
+    if (stat != nullptr) {
+      stat->release();
+    }
+    return;
+  }
+
+  Stream& stream = it->second;
+
+  if (!ServerState::instance()->isDBServer()) {
+    // DB server is not user-facing, and does not need to set this header
+    // use "IfNotSet" to not overwrite an existing response header
+    response.setHeaderNCIfNotSet(StaticStrings::XContentTypeOptions, StaticStrings::NoSniff);
+  }
+
+  size_t const responseBodyLength = response.bodySize();
+  bool const isHead = stream.requestType == rest::RequestType::HEAD;
+
+  if (isHead) {
+    // HEAD must not return a body
+    response.headResponse(responseBodyLength);
+  }
+
+  bool const hasBody = !isHead && responseBodyLength > 0;
+
+  // the HTTP/1 header is rendered and translated, so all special header
+  // handling of HttpResponse applies to HTTP/2 as well
+  std::vector<hpack::HeaderField> fields;
+  {
+    StringBuffer rendered(false);
+    response.writeHeader(&rendered);
+    translateResponseHeader(rendered.c_str(), rendered.c_str() + rendered.length(), fields);
+  }
+
+  StringBuffer* buffer = leaseStringBuffer(256);
+  appendHeaders(*buffer, streamId, fields, !hasBody);
+
+  double const totalTime = RequestStatistics::ELAPSED_SINCE_READ_START(stat);
+
+  LOG_TOPIC("a455d", INFO, Logger::REQUESTS)
+      << "\"http2-request-end\",\"" << (void*)this << "\",\""
+      << _connectionInfo.clientAddress << "\",\""
+      << HttpRequest::translateMethod(stream.requestType) << "\"," << streamId
+      << "," << static_cast<int>(response.responseCode()) << ","
+      << responseBodyLength << "," << Logger::FIXED(totalTime, 6);
+
+  if (hasBody) {
+    // the body follows in DATA frames as the flow control windows allow,
+    // the statistics are finished with the last one
+    stream.responding = true;
+    stream.responseBody = response.stealBody();
+    stream.responseOffset = 0;
+    stream.responseStatistics = stat;
+    addWriteBuffer(WriteBuffer(buffer, nullptr));
+    flushStreams();
+  } else {
+    addWriteBuffer(WriteBuffer(buffer, stat));
+    forgetStream(streamId);
+  }
+
+  std::unique_ptr<basics::StringBuffer> body = response.stealBody();
+  if (body != nullptr) {
+    returnStringBuffer(body.release());  // takes care of deleting
+  }
+}
+
+void Http2CommTask::flushStreams() {
+  StringBuffer* buffer = nullptr;
+  bool progress = true;
+
+  // one frame per stream and round, so that streams share the connection
+  // window instead of the oldest one taking all of it
+  while (progress && _sendWindow > 0) {
+    progress = false;
+
+    for (auto it = _streams.begin(); it != _streams.end() && _sendWindow > 0;) {
+      Stream& stream = it->second;
+      if (stream.responseBody == nullptr || stream.sendWindow <= 0) {
+        ++it;
+        continue;
+      }
+
+      size_t const remaining = stream.responseBody->length() - stream.responseOffset;
+      size_t const chunk = std::min<size_t>(
+          std::min<size_t>(remaining, _peerMaxFrameSize),
+          static_cast<size_t>(std::min(_sendWindow, stream.sendWindow)));
+      bool const last = chunk == remaining;
+
+      if (buffer == nullptr) {
+        buffer = leaseStringBuffer(chunk + FrameHeaderLength);
+      }
+      appendFrame(*buffer, FrameData, last ? FlagEndStream : 0, it->first,
+                  stream.responseBody->c_str() + stream.responseOffset, chunk);
+      stream.responseOffset += chunk;
+      stream.sendWindow -= chunk;
+      _sendWindow -= chunk;
+      progress = true;
+
+      if (!last) {
+        ++it;
+        continue;
+      }
+
+      // the statistics of a stream end with its last frame
+      addWriteBuffer(WriteBuffer(buffer, stream.responseStatistics));
+      buffer = nullptr;
+      stream.responseStatistics = nullptr;
+      returnStringBuffer(stream.responseBody.release());
+
+      uint32_t const streamId = it->first;
+      ++it;
+      forgetStream(streamId);
+    }
+  }
+
+  if (buffer != nullptr) {
+    addWriteBuffer(WriteBuffer(buffer, nullptr));
+  }
+}
+
+void Http2CommTask::appendHeaders(StringBuffer& out, uint32_t streamId,
+                                  std::vector<hpack::HeaderField> const& fields,
+                                  bool endStream) {
+  std::string block;
+  _encoder.encode(fields, block);
+
+  // HEADERS and as many CONTINUATION frames as the frame size of the
+  // client requires
+  size_t offset = 0;
+  do {
+    size_t const chunk = std::min<size_t>(block.size() - offset, _peerMaxFrameSize);
+    uint8_t flags = offset + chunk == block.size() ? FlagEndHeaders : 0;
+    if (offset == 0 && endStream) {
+      flags |= FlagEndStream;
+    }
+    appendFrame(out, offset == 0 ? FrameHeaders : FrameContinuation, flags,
+                streamId, block.data() + offset, chunk);
+    offset += chunk;
+  } while (offset < block.size());
+}
+
+void Http2CommTask::sendServerPreface() {
+  char settings[3 * 6];
+  writeSetting(settings, SettingsMaxConcurrentStreams, MaximalConcurrentStreams);
+  writeSetting(settings + 6, SettingsInitialWindowSize, InitialWindowSize);
+  writeSetting(settings + 12, SettingsMaxHeaderListSize,
+               static_cast<uint32_t>(HttpCommTask::MaximalHeaderSize));
+
+  // the connection window starts at the default and is raised to the one
+  // of the streams right away
+  char update[4];
+  writeUInt32(update, static_cast<uint32_t>(InitialWindowSize - DefaultWindowSize));
+  _receiveWindow = InitialWindowSize;
+
+  StringBuffer* buffer = leaseStringBuffer(2 * FrameHeaderLength + sizeof(settings) + sizeof(update));
+  appendFrame(*buffer, FrameSettings, 0, 0, settings, sizeof(settings));
+  appendFrame(*buffer, FrameWindowUpdate, 0, 0, update, sizeof(update));
+  addWriteBuffer(WriteBuffer(buffer, nullptr));
+}
+
+void Http2CommTask::sendFrame(uint8_t type, uint8_t flags, uint32_t streamId,
+                              char const* payload, size_t length) {
+  StringBuffer* buffer = leaseStringBuffer(FrameHeaderLength + length);
+  appendFrame(*buffer, type, flags, streamId, payload, length);
+  addWriteBuffer(WriteBuffer(buffer, nullptr));
+}
+
+void Http2CommTask::sendWindowUpdate(uint32_t streamId, uint32_t increment) {
+  char payload[4];
+  writeUInt32(payload, increment);
+  sendFrame(FrameWindowUpdate, 0, streamId, payload, sizeof(payload));
+}
+
+void Http2CommTask::appendFrame(StringBuffer& out, uint8_t type, uint8_t flags,
+                                uint32_t streamId, char const* payload, size_t length) {
+  TRI_ASSERT(length <= MaximalPeerFrameSize);
+  char header[FrameHeaderLength];
+  header[0] = static_cast<char>(length >> 16);
+  header[1] = static_cast<char>(length >> 8);
+  header[2] = static_cast<char>(length);
+  header[3] = static_cast<char>(type);
+  header[4] = static_cast<char>(flags);
+  writeUInt32(header + 5, streamId & 0x7fffffff);
+  out.appendText(header, FrameHeaderLength);
+  if (length > 0) {
+    out.appendText(payload, length);
+  }
+}
+
+void Http2CommTask::streamError(uint32_t streamId, ErrorCode code) {
+  LOG_TOPIC("0e318", DEBUG, Logger::COMMUNICATION)
+      << "resetting HTTP/2 stream " << streamId << ", error "
+      << static_cast<uint32_t>(code);
+  char payload[4];
+  writeUInt32(payload, static_cast<uint32_t>(code));
+  sendFrame(FrameRstStream, 0, streamId, payload, sizeof(payload));
+  forgetStream(streamId);
+}
+
+bool Http2CommTask::connectionError(ErrorCode code, char const* reason) {
+  LOG_TOPIC("5d087", DEBUG, Logger::COMMUNICATION)
+      << "closing HTTP/2 connection: " << reason;
+  char payload[8];
+  writeUInt32(payload, _lastStreamId);
+  writeUInt32(payload + 4, static_cast<uint32_t>(code));
+  sendFrame(FrameGoAway, 0, 0, payload, sizeof(payload));
+  _closeRequested = true;
+  return false;
+}
+
+void Http2CommTask::forgetStream(uint32_t streamId) {
+  _streams.erase(streamId);
+  // statistics of a stream that never reached a handler
+  setStatistics(streamId, nullptr);
+
+  if (_streams.empty()) {
+    if (_goAwayReceived) {
+      connectionError(ErrorCode::NONE, "client sent GOAWAY");
+    } else {
+      resetKeepAlive();
+    }
+  }
+}
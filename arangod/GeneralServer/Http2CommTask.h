@@ -0,0 +1,186 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_GENERAL_SERVER_HTTP2_COMM_TASK_H
+#define ARANGOD_GENERAL_SERVER_HTTP2_COMM_TASK_H 1
+
+#include "Basics/Common.h"
+#include "GeneralServer/GeneralCommTask.h"
+#include "GeneralServer/Hpack.h"
+
+#include <map>
+
+namespace arangodb {
+class HttpRequest;
+
+namespace rest {
+
+/// @brief HTTP/2 (RFC 7540) with prior knowledge. every stream carries one
+/// request, streams are mapped onto handlers by their id just like VST
+/// message ids, so many requests can be in flight on one connection
+class Http2CommTask final : public GeneralCommTask {
+ public:
+  /// @brief the client connection preface
+  static char const* const ConnectionPreface;
+  static size_t const ConnectionPrefaceLength;
+
+  static uint32_t const MaximalConcurrentStreams;
+  static uint32_t const MaximalFrameSize;
+  static uint32_t const InitialWindowSize;
+
+ public:
+  Http2CommTask(GeneralServer& server, std::unique_ptr<Socket> socket,
+                ConnectionInfo&&, double timeout, bool skipSocketInit = false);
+
+  ~Http2CommTask();
+
+  arangodb::Endpoint::TransportType transportType() override {
+    return arangodb::Endpoint::TransportType::HTTP;
+  }
+
+  // whether or not this task can mix sync and async I/O
+  bool canUseMixedIO() const override;
+
+#ifdef ARANGODB_USE_GOOGLE_TESTS
+  /// @brief appends the data to the read buffer and processes all frames
+  /// like the read loop does. returns false once the connection is closed
+  bool receiveForTest(char const* data, size_t length);
+#endif
+
+ protected:
+  bool processRead(double startTime) override;
+  void compactify() override;
+
+  std::unique_ptr<GeneralResponse> createResponse(rest::ResponseCode,
+                                                  uint64_t messageId) override final;
+
+  /// @brief send simple response including response body
+  void addSimpleResponse(rest::ResponseCode, rest::ContentType, uint64_t messageId,
+                         velocypack::Buffer<uint8_t>&&) override;
+
+  void addResponse(GeneralResponse&, RequestStatistics*) override;
+
+  // requests of different streams must not block each other
+  bool allowDirectHandling() const override final { return false; }
+
+ private:
+  enum class ErrorCode : uint32_t {
+    NONE = 0x0,  // NO_ERROR, which clashes with a Windows macro
+    PROTOCOL_ERROR = 0x1,
+    INTERNAL_ERROR = 0x2,
+    FLOW_CONTROL_ERROR = 0x3,
+    STREAM_CLOSED = 0x5,
+    FRAME_SIZE_ERROR = 0x6,
+    REFUSED_STREAM = 0x7,
+    CANCEL = 0x8,
+    COMPRESSION_ERROR = 0x9,
+    ENHANCE_YOUR_CALM = 0xb
+  };
+
+  struct Stream {
+    explicit Stream(int64_t window);
+    ~Stream();
+
+    // HEADERS and CONTINUATION fragments until END_HEADERS
+    std::string headerBlock;
+    std::vector<hpack::HeaderField> headers;
+    std::string body;
+    rest::RequestType requestType;
+    // flow control windows, the send window may become negative
+    int64_t sendWindow;
+    int64_t receiveWindow;
+    // the client has sent END_STREAM
+    bool remoteClosed;
+    // the header block in progress is a trailer
+    bool trailers;
+    // the response headers have been sent, the body is pending
+    bool responding;
+    std::unique_ptr<basics::StringBuffer> responseBody;
+    size_t responseOffset;
+    RequestStatistics* responseStatistics;
+  };
+
+  // frame handlers, all return false if the connection is to be closed
+  bool processFrame(double startTime, uint8_t type, uint8_t flags,
+                    uint32_t streamId, uint8_t const* payload, uint32_t length);
+  bool processData(uint8_t flags, uint32_t streamId, uint8_t const* payload, uint32_t length);
+  bool processHeaders(double startTime, uint8_t flags, uint32_t streamId,
+                      uint8_t const* payload, uint32_t length);
+  bool processContinuation(uint8_t flags, uint32_t streamId,
+                           uint8_t const* payload, uint32_t length);
+  bool processSettings(uint8_t flags, uint32_t streamId, uint8_t const* payload, uint32_t length);
+  bool processWindowUpdate(uint32_t streamId, uint8_t const* payload, uint32_t length);
+
+  /// @brief decodes a complete header block and dispatches the request if
+  /// the stream is complete
+  bool headersComplete(uint32_t streamId, Stream& stream);
+
+  /// @brief converts the stream into an HttpRequest and executes it
+  void processRequest(uint32_t streamId, Stream& stream);
+
+  /// @brief sends the response body of all streams as far as the flow
+  /// control windows allow
+  void flushStreams();
+
+  void sendServerPreface();
+  void sendFrame(uint8_t type, uint8_t flags, uint32_t streamId,
+                 char const* payload, size_t length);
+  void sendWindowUpdate(uint32_t streamId, uint32_t increment);
+  void appendHeaders(basics::StringBuffer& out, uint32_t streamId,
+                     std::vector<hpack::HeaderField> const& fields, bool endStream);
+  void appendFrame(basics::StringBuffer& out, uint8_t type, uint8_t flags,
+                   uint32_t streamId, char const* payload, size_t length);
+
+  /// @brief answers with RST_STREAM and forgets the stream
+  void streamError(uint32_t streamId, ErrorCode);
+  /// @brief answers with GOAWAY and closes the connection
+  bool connectionError(ErrorCode, char const* reason);
+
+  // drops the state of a stream, releasing what it still holds
+  void forgetStream(uint32_t streamId);
+
+ private:
+  hpack::Decoder _decoder;
+  hpack::Encoder _encoder;
+
+  std::map<uint32_t, Stream> _streams;
+
+  size_t _readPosition;
+  bool _prefaceReceived;
+  bool _goAwayReceived;
+  bool _allowMethodOverride;
+
+  // highest stream id opened by the client
+  uint32_t _lastStreamId;
+  // stream whose header block continues, 0 if none
+  uint32_t _continuationStreamId;
+
+  // connection level flow control windows
+  int64_t _sendWindow;
+  int64_t _receiveWindow;
+
+  // settings of the client
+  uint32_t _peerInitialWindowSize;
+  uint32_t _peerMaxFrameSize;
+};
+}  // namespace rest
+}  // namespace arangodb
+
+#endif
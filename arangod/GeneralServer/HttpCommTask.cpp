@@ -29,12 +29,15 @@
 #include "GeneralServer/AuthenticationFeature.h"
 #include "GeneralServer/GeneralServer.h"
 #include "GeneralServer/GeneralServerFeature.h"
+#include "GeneralServer/Http2CommTask.h"
 #include "GeneralServer/RestHandler.h"
 #include "GeneralServer/RestHandlerFactory.h"
 #include "GeneralServer/VstCommTask.h"
 #include "Meta/conversion.h"
 #include "Rest/HttpRequest.h"
 #include "Rest/HttpResponse.h"
+#include "Rest/RequestBodyStream.h"
+#include "Rest/ResponseBodyStream.h"
 #include "Statistics/ConnectionStatistics.h"
 #include "Utils/Events.h"
 
@@ -46,6 +49,8 @@ size_t const HttpCommTask::MaximalHeaderSize = 2 * 1024 * 1024;       //    2 MB
 size_t const HttpCommTask::MaximalBodySize = 1024 * 1024 * 1024;      // 1024 MB
 size_t const HttpCommTask::MaximalPipelineSize = 1024 * 1024 * 1024;  // 1024 MB
 size_t const HttpCommTask::RunCompactEvery = 500;
+size_t const HttpCommTask::MinimalSeparateBodySize = 64 * 1024;      //   64 KB
+size_t const HttpCommTask::MinimalStreamBodySize = 4 * 1024 * 1024;   //    4 MB
 
 HttpCommTask::HttpCommTask(GeneralServer& server, std::unique_ptr<Socket> socket,
                            ConnectionInfo&& info, double timeout)
@@ -62,13 +67,21 @@ HttpCommTask::HttpCommTask(GeneralServer& server, std::unique_ptr<Socket> socket
       _fullUrl(),
       _origin(),
       _sinceCompactification(0),
-      _originalBodyLength(0) {
+      _originalBodyLength(0),
+      _bodyStreamRemaining(0) {
   _protocol = "http";
 
   ConnectionStatistics::SET_HTTP(_connectionStatistics);
 }
 
-HttpCommTask::~HttpCommTask() {}
+HttpCommTask::~HttpCommTask() {
+  if (_bodyStream != nullptr) {
+    _bodyStream->abort();
+  }
+  if (_responseStream != nullptr) {
+    _responseStream->abort();
+  }
+}
 
 // whether or not this task can mix sync and async I/O
 bool HttpCommTask::canUseMixedIO() const {
@@ -111,8 +124,18 @@ void HttpCommTask::addResponse(GeneralResponse& baseResponse, RequestStatistics*
   finishExecution(baseResponse);
   resetKeepAlive();
 
-  // response has been queued, allow further requests
-  _requestPending = false;
+  if (_bodyStream != nullptr) {
+    // answered before the body was complete. the rest of the body is
+    // still sent by the client and discarded on arrival
+    _bodyStream->abort();
+    resumeRead();
+  }
+
+  std::shared_ptr<ResponseBodyStream> const bodyStream = response.bodyStream();
+
+  // response has been queued, allow further requests. a streamed body
+  // has to be sent completely first
+  _requestPending = (bodyStream != nullptr);
 
   // CORS response handling
   if (!_origin.empty()) {
@@ -151,14 +174,25 @@ void HttpCommTask::addResponse(GeneralResponse& baseResponse, RequestStatistics*
     response.headResponse(responseBodyLength);
   }
 
+  if (bodyStream != nullptr) {
+    TRI_ASSERT(responseBodyLength == 0);
+    response.setHeaderNC(StaticStrings::TransferEncoding, "chunked");
+  }
+
+  // large bodies are handed over to the socket as they are, instead of
+  // copying them behind the header
+  bool const separateBody = _requestType != rest::RequestType::HEAD &&
+                            responseBodyLength >= MinimalSeparateBodySize;
+
   // reserve a buffer with some spare capacity
-  WriteBuffer buffer(leaseStringBuffer(responseBodyLength + 220), stat);
+  WriteBuffer buffer(leaseStringBuffer((separateBody ? 0 : responseBodyLength) + 220),
+                     separateBody ? nullptr : stat);
 
   // write header
   response.writeHeader(buffer._buffer);
 
   // write body
-  if (_requestType != rest::RequestType::HEAD) {
+  if (_requestType != rest::RequestType::HEAD && !separateBody) {
     buffer._buffer->appendText(response.body());
   }
 
@@ -172,8 +206,11 @@ void HttpCommTask::addResponse(GeneralResponse& baseResponse, RequestStatistics*
                 : _fullUrl.substr(0, _fullUrl.find_first_of('?')))
         << "\",\""
         << (Logger::logRequestParameters()
-                ? StringUtils::escapeUnicode(std::string(buffer._buffer->c_str(),
-                                                         buffer._buffer->length()))
+                ? StringUtils::escapeUnicode(
+                      std::string(buffer._buffer->c_str(), buffer._buffer->length()) +
+                      (separateBody ? std::string(response.body().c_str(),
+                                                  response.body().length())
+                                    : std::string()))
                 : "--body--")
         << "\"";
   }
@@ -195,9 +232,30 @@ void HttpCommTask::addResponse(GeneralResponse& baseResponse, RequestStatistics*
                 : _fullUrl.substr(0, _fullUrl.find_first_of('?')))
         << "\"," << stat->timingsCsv();
   }
-  addWriteBuffer(std::move(buffer));
-  // read pipelined requests
-  triggerProcessAll();
+  if (separateBody) {
+    // the statistics are finished with the body, which is written last
+    addWriteBuffer(std::move(buffer), WriteBuffer(response.stealBody().release(), stat));
+  } else {
+    addWriteBuffer(std::move(buffer));
+  }
+
+  if (bodyStream != nullptr) {
+    // the connection is busy until the body is complete
+    cancelKeepAlive();
+    _responseStream = bodyStream;
+    _responseStream->setNotifyCallback([self = std::weak_ptr<SocketTask>(shared_from_this())]() {
+      auto task = self.lock();
+      if (task != nullptr) {
+        task->_peer->post([task]() {
+          static_cast<HttpCommTask*>(task.get())->drainResponseStream();
+        });
+      }
+    });
+    drainResponseStream();
+  } else {
+    // read pipelined requests
+    triggerProcessAll();
+  }
 
   // and give some request information
   LOG_TOPIC("8f555", INFO, Logger::REQUESTS)
@@ -212,7 +270,9 @@ void HttpCommTask::addResponse(GeneralResponse& baseResponse, RequestStatistics*
       << "\"," << Logger::FIXED(totalTime, 6);
 
   std::unique_ptr<basics::StringBuffer> body = response.stealBody();
-  returnStringBuffer(body.release());  // takes care of deleting
+  if (body != nullptr) {
+    returnStringBuffer(body.release());  // takes care of deleting
+  }
 }
 
 // reads data from the socket
@@ -221,7 +281,17 @@ bool HttpCommTask::processRead(double startTime) {
   TRI_ASSERT(_peer->runningInThisThread());
 
   cancelKeepAlive();
-  TRI_ASSERT(_readBuffer.c_str() != nullptr);
+
+  if (_readBuffer.c_str() == nullptr) {
+    // the read buffer is back in the pool, nothing was received since
+    return false;
+  }
+
+  if (_bodyStream != nullptr) {
+    // the request is already executed, only its body is still arriving
+    feedBodyStream();
+    return false;
+  }
 
   if (_requestPending) {
     return false;
@@ -279,6 +349,42 @@ bool HttpCommTask::processRead(double startTime) {
       return false;
     }
 
+    // HTTP/2 with prior knowledge, the preface contains an empty line
+    // after 18 bytes already, so it must be caught before the header is
+    // considered complete
+    size_t const prefaceLength =
+        std::min(_readBuffer.length(), Http2CommTask::ConnectionPrefaceLength);
+    if (std::memcmp(_readBuffer.c_str(), Http2CommTask::ConnectionPreface, prefaceLength) == 0) {
+      if (prefaceLength < Http2CommTask::ConnectionPrefaceLength) {
+        // let client send the rest of the preface
+        return false;
+      }
+
+      LOG_TOPIC("f8eae", TRACE, Logger::COMMUNICATION) << "switching from HTTP to HTTP/2";
+
+      // mark task as abandoned, no more reads will happen on _peer
+      if (!abandon()) {
+        THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                       "task is already abandoned");
+      }
+
+      _server.unregisterTask(this->id());
+
+      std::shared_ptr<GeneralCommTask> commTask =
+          std::make_shared<Http2CommTask>(_server, std::move(_peer),
+                                          std::move(_connectionInfo),
+                                          GeneralServerFeature::keepAliveTimeout(),
+                                          /*skipSocketInit*/ true);
+
+      _server.registerTask(commTask);
+
+      // the preface is checked by the new task
+      commTask->addToReadBuffer(_readBuffer.c_str(), _readBuffer.length());
+      commTask->processAll();
+      commTask->start();
+      return false;
+    }
+
     if (_readBuffer.length() >= 11 &&
         (std::memcmp(_readBuffer.c_str(), "VST/1.0\r\n\r\n", 11) == 0 ||
          std::memcmp(_readBuffer.c_str(), "VST/1.1\r\n\r\n", 11) == 0)) {
@@ -462,6 +568,13 @@ bool HttpCommTask::processRead(double startTime) {
           triggerProcessAll();  // read pipelined requests
         }
       }
+
+      // the request is dispatched right away, its body is passed on to the
+      // handler while it arrives
+      if (_readRequestBody && startBodyStream()) {
+        _readRequestBody = false;
+        handleRequest = true;
+      }
     } else {
       size_t l = (_readBuffer.end() - _readBuffer.c_str());
 
@@ -631,6 +744,12 @@ void HttpCommTask::processRequest(std::unique_ptr<HttpRequest> request) {
   resp->setContentType(request->contentTypeResponse());
   resp->setContentTypeRequested(request->contentTypeResponse());
 
+  // chunked bodies for HTTP/1.1 clients that wait for the response
+  bool found;
+  request->header(StaticStrings::Async, found);
+  resp->setAllowBodyStream(request->isHttp11() && !found &&
+                           _requestType != rest::RequestType::HEAD);
+
   executeRequest(std::move(request), std::move(resp));
 }
 
@@ -676,6 +795,134 @@ bool HttpCommTask::checkContentLength(HttpRequest* request, bool expectContentLe
   return true;
 }
 
+bool HttpCommTask::startBodyStream() {
+  // only for large imports, RestImportHandler is the only handler that
+  // consumes a streamed body
+  if (_requestType != rest::RequestType::POST || _bodyLength < MinimalStreamBodySize ||
+      _incompleteRequest->requestPath() != "/_api/import") {
+    return false;
+  }
+
+  // compressed bodies are decoded as a whole, and async jobs are answered
+  // before the body would have been read
+  bool found;
+  _incompleteRequest->header(StaticStrings::Async, found);
+  if (found || !_incompleteRequest->header(StaticStrings::ContentEncoding).empty()) {
+    return false;
+  }
+
+  TRI_ASSERT(_bodyStream == nullptr);
+  _bodyStream = std::make_shared<RequestBodyStream>(_bodyLength);
+  _bodyStream->setResumeCallback([self = std::weak_ptr<SocketTask>(shared_from_this())]() {
+    auto task = self.lock();
+    if (task != nullptr) {
+      task->resumeRead();
+    }
+  });
+  _incompleteRequest->setBodyStream(_bodyStream);
+
+  // pass on what was received along with the header
+  TRI_ASSERT(_readPosition == _bodyPosition);
+  _bodyStreamRemaining = _bodyLength;
+  feedBodyStream();
+
+  // the request ends where the stream stands now
+  _bodyPosition = _readPosition;
+  _bodyLength = 0;
+  return true;
+}
+
+void HttpCommTask::feedBodyStream() {
+  TRI_ASSERT(_bodyStream != nullptr);
+
+  // the body may be followed by the next pipelined request
+  size_t const length =
+      std::min(_readBuffer.length() - _readPosition, _bodyStreamRemaining);
+
+  if (length > 0 && !_bodyStream->append(_readBuffer.c_str() + _readPosition, length)) {
+    // the handler cannot keep up, wait until it has consumed some data
+    pauseRead();
+  }
+
+  _readPosition += length;
+  _bodyStreamRemaining -= length;
+
+  if (_bodyStreamRemaining == 0) {
+    _bodyStream->finish();
+    _bodyStream.reset();
+  }
+}
+
+void HttpCommTask::streamClosed() {
+  if (_bodyStream != nullptr) {
+    // wake up the handler, the body will never be complete
+    _bodyStream->abort();
+    _bodyStream.reset();
+  }
+  if (_responseStream != nullptr) {
+    // the handler stops producing
+    _responseStream->abort();
+    _responseStream.reset();
+  }
+}
+
+void HttpCommTask::completedWrites() {
+  if (_responseStream != nullptr) {
+    // not invoked directly, the write that just completed is still unwinding
+    _peer->post([self = shared_from_this()]() {
+      static_cast<HttpCommTask*>(self.get())->drainResponseStream();
+    });
+  }
+}
+
+void HttpCommTask::drainResponseStream() {
+  TRI_ASSERT(_peer->runningInThisThread());
+
+  // the socket paces the handler, only take more data when everything
+  // before has been sent
+  if (_responseStream == nullptr || !writeQueueEmpty()) {
+    return;
+  }
+
+  std::string data;
+  bool finished = false;
+
+  if (!_responseStream->take(data, finished)) {
+    // the handler failed, the client has to notice the truncated body
+    LOG_TOPIC("c3e07", DEBUG, Logger::COMMUNICATION)
+        << "response stream aborted, closing connection";
+    _responseStream.reset();
+    closeStreamNoLock();
+    return;
+  }
+
+  if (data.empty() && !finished) {
+    return;
+  }
+
+  WriteBuffer buffer(leaseStringBuffer(data.size() + 32), nullptr);
+  if (!data.empty()) {
+    buffer._buffer->appendHex(data.size());
+    buffer._buffer->appendText(TRI_CHAR_LENGTH_PAIR("\r\n"));
+    buffer._buffer->appendText(data);
+    buffer._buffer->appendText(TRI_CHAR_LENGTH_PAIR("\r\n"));
+  }
+
+  if (finished) {
+    buffer._buffer->appendText(TRI_CHAR_LENGTH_PAIR("0\r\n\r\n"));
+    _responseStream.reset();
+    _requestPending = false;
+    resetKeepAlive();
+  }
+
+  addWriteBuffer(std::move(buffer));
+
+  if (finished) {
+    // read pipelined requests
+    triggerProcessAll();
+  }
+}
+
 void HttpCommTask::processCorsOptions(std::unique_ptr<HttpRequest> request) {
   HttpResponse resp(rest::ResponseCode::OK, leaseStringBuffer(0));
 
@@ -764,67 +1011,3 @@ void HttpCommTask::resetState() {
   _newRequest = true;
   _readRequestBody = false;
 }
-
-ResponseCode HttpCommTask::handleAuthHeader(HttpRequest* req) {
-  bool found;
-  std::string const& authStr = req->header(StaticStrings::Authorization, found);
-  if (!found) {
-    if (_auth->isActive()) {
-      events::CredentialsMissing(*req);
-      return rest::ResponseCode::UNAUTHORIZED;
-    }
-    return rest::ResponseCode::OK;
-  }
-
-  size_t methodPos = authStr.find_first_of(' ');
-  if (methodPos != std::string::npos) {
-    // skip over authentication method
-    char const* auth = authStr.c_str() + methodPos;
-    while (*auth == ' ') {
-      ++auth;
-    }
-
-    if (Logger::logRequestParameters()) {
-      LOG_TOPIC("c4536", DEBUG, arangodb::Logger::REQUESTS)
-          << "\"authorization-header\",\"" << (void*)this << "\",\"" << authStr << "\"";
-    }
-
-    try {
-      // note that these methods may throw in case of an error
-      AuthenticationMethod authMethod = AuthenticationMethod::NONE;
-      if (TRI_CaseEqualString(authStr.c_str(), "basic ", 6)) {
-        authMethod = AuthenticationMethod::BASIC;
-      } else if (TRI_CaseEqualString(authStr.c_str(), "bearer ", 7)) {
-        authMethod = AuthenticationMethod::JWT;
-      }
-
-      req->setAuthenticationMethod(authMethod);
-      if (authMethod != AuthenticationMethod::NONE) {
-        _authToken = _auth->tokenCache().checkAuthentication(authMethod, auth);
-        req->setAuthenticated(_authToken.authenticated());
-        req->setUser(_authToken._username); // do copy here, so that we do not invalidate the member
-      }
-
-      if (req->authenticated() || !_auth->isActive()) {
-        events::Authenticated(*req, authMethod);
-        return rest::ResponseCode::OK;
-      } else if (_auth->isActive()) {
-        events::CredentialsBad(*req, authMethod);
-        return rest::ResponseCode::UNAUTHORIZED;
-      }
-
-      // intentionally falls through
-    } catch (arangodb::basics::Exception const& ex) {
-      // translate error
-      if (ex.code() == TRI_ERROR_USER_NOT_FOUND) {
-        return rest::ResponseCode::UNAUTHORIZED;
-      }
-      return GeneralResponse::responseCode(ex.what());
-    } catch (...) {
-      return rest::ResponseCode::SERVER_ERROR;
-    }
-  }
-
-  events::UnknownAuthenticationMethod(*req);
-  return rest::ResponseCode::UNAUTHORIZED;
-}
@@ -6,6 +6,8 @@
 
 namespace arangodb {
 class HttpRequest;
+class RequestBodyStream;
+class ResponseBodyStream;
 
 namespace rest {
 class HttpCommTask final : public GeneralCommTask {
@@ -14,6 +16,8 @@ class HttpCommTask final : public GeneralCommTask {
   static size_t const MaximalBodySize;
   static size_t const MaximalPipelineSize;
   static size_t const RunCompactEvery;
+  static size_t const MinimalSeparateBodySize;
+  static size_t const MinimalStreamBodySize;
 
  public:
   HttpCommTask(GeneralServer& server,
@@ -43,6 +47,9 @@ class HttpCommTask final : public GeneralCommTask {
 
   bool allowDirectHandling() const override final { return true; }
 
+  void streamClosed() override;
+  void completedWrites() override;
+
  private:
   void processRequest(std::unique_ptr<HttpRequest>);
   void processCorsOptions(std::unique_ptr<HttpRequest>);
@@ -52,9 +59,17 @@ class HttpCommTask final : public GeneralCommTask {
   // check the content-length header of a request and fail it is broken
   bool checkContentLength(HttpRequest*, bool expectContentLength);
 
+  // hands the body of the incomplete request to the handler while it is
+  // received, if the handler can consume it that way
+  bool startBodyStream();
+  // passes received body data on to the body stream
+  void feedBodyStream();
+  // sends what the handler has written into the response stream as chunks,
+  // once everything queued before has been sent
+  void drainResponseStream();
+
   std::string authenticationRealm() const;
   ResponseCode authenticateRequest(HttpRequest*);
-  ResponseCode handleAuthHeader(HttpRequest* request);
 
  private:
   size_t _readPosition;       // current read position
@@ -80,6 +95,14 @@ class HttpCommTask final : public GeneralCommTask {
   bool _requestPending = false;
 
   std::unique_ptr<HttpRequest> _incompleteRequest;
+
+  // body of the current request that is still being received, and the
+  // number of body bytes still to come
+  std::shared_ptr<RequestBodyStream> _bodyStream;
+  size_t _bodyStreamRemaining;
+
+  // body of the current response that is still being produced
+  std::shared_ptr<ResponseBodyStream> _responseStream;
 };
 }  // namespace rest
 }  // namespace arangodb
@@ -30,6 +30,8 @@
 #include "GeneralServer/HttpCommTask.h"
 #include "GeneralServer/Socket.h"
 #include "Logger/Logger.h"
+#include "Statistics/ConnectionStatistics.h"
+#include "Statistics/StatisticsFeature.h"
 
 using namespace arangodb;
 using namespace arangodb::rest;
@@ -40,13 +42,13 @@ using namespace arangodb::rest;
 
 ListenTask::ListenTask(GeneralServer& server, 
                        GeneralServer::IoContext& context,
-                       Endpoint* endpoint)
+                       Endpoint* endpoint, bool reusePort)
     : _server(server),
       _context(context),
       _endpoint(endpoint),
       _acceptFailures(0),
       _bound(false),
-      _acceptor(Acceptor::factory(server, context, endpoint)) {
+      _acceptor(Acceptor::factory(server, context, endpoint, reusePort)) {
         _keepAliveTimeout = GeneralServerFeature::keepAliveTimeout();
   }
 
@@ -78,6 +80,7 @@ void ListenTask::accept() {
 
   auto handler = [this, self](asio_ns::error_code const& ec) {
     TRI_ASSERT(_acceptor != nullptr);
+    double const acceptTime = StatisticsFeature::time();
 
     if (ec) {
       if (ec == asio_ns::error::operation_aborted) {
@@ -109,7 +112,7 @@ void ListenTask::accept() {
     info.serverAddress = _endpoint->host();
     info.serverPort = _endpoint->port();
 
-    handleConnected(std::move(peer), std::move(info));
+    handleConnected(std::move(peer), std::move(info), acceptTime);
 
     this->accept();
   };
@@ -132,13 +135,14 @@ void ListenTask::stop() {
 
 
 void ListenTask::handleConnected(std::unique_ptr<Socket> socket,
-                                 ConnectionInfo&& info) {
+                                 ConnectionInfo&& info, double acceptTime) {
   auto commTask = std::make_shared<HttpCommTask>(_server, std::move(socket),
                                                  std::move(info), _keepAliveTimeout);
   
   _server.registerTask(commTask);
   
   if (commTask->start()) {
+    ConnectionStatistics::ADD_ACCEPT_TIME(StatisticsFeature::time() - acceptTime);
     LOG_TOPIC("54790", DEBUG, Logger::COMMUNICATION) << "Started comm task";
   } else {
     LOG_TOPIC("56754", DEBUG, Logger::COMMUNICATION) << "Failed to start comm task";
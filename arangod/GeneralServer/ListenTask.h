@@ -45,12 +45,14 @@ class ListenTask final : public std::enable_shared_from_this<ListenTask> {
  public:
   ListenTask(rest::GeneralServer& server, 
              rest::GeneralServer::IoContext&, 
-             Endpoint*);
+             Endpoint*, bool reusePort = false);
 
   ~ListenTask();
 
  public:
-  void handleConnected(std::unique_ptr<Socket>, ConnectionInfo&&);
+  /// @brief acceptTime is the time the connection was accepted at, the
+  /// time until the comm task is started is its accept latency
+  void handleConnected(std::unique_ptr<Socket>, ConnectionInfo&&, double acceptTime);
 
  public:
   Endpoint* endpoint() const { return _endpoint; }
@@ -0,0 +1,159 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "ReadBufferPool.h"
+
+#include "Basics/Mutex.h"
+#include "Basics/MutexLocker.h"
+#include "Basics/StringBuffer.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Value.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::rest;
+
+constexpr size_t ReadBufferPool::NumSizeClasses;
+
+size_t const ReadBufferPool::SizeClasses[NumSizeClasses] = {16 * 1024, 64 * 1024,
+                                                            256 * 1024, 1024 * 1024,
+                                                            4 * 1024 * 1024};
+
+size_t const ReadBufferPool::MaxPooledPerSizeClass = 16 * 1024 * 1024;
+
+namespace {
+struct SizeClass {
+  Mutex mutex;
+  std::vector<std::unique_ptr<basics::StringBuffer>> buffers;  // needs mutex
+  size_t pooled = 0;                                           // needs mutex
+};
+
+SizeClass sizeClasses[ReadBufferPool::NumSizeClasses];
+
+std::atomic<uint64_t> memoryInUse(0);
+std::atomic<uint64_t> memoryPooled(0);
+std::atomic<uint64_t> highWaterMark(0);
+std::atomic<uint64_t> leases(0);
+std::atomic<uint64_t> poolHits(0);
+
+void updateHighWaterMark() {
+  uint64_t current = memoryInUse.load(std::memory_order_relaxed) +
+                     memoryPooled.load(std::memory_order_relaxed);
+  uint64_t mark = highWaterMark.load(std::memory_order_relaxed);
+  while (current > mark &&
+         !highWaterMark.compare_exchange_weak(mark, current, std::memory_order_relaxed)) {
+  }
+}
+
+std::unique_ptr<basics::StringBuffer> pop(size_t sizeClass) {
+  SizeClass& sc = sizeClasses[sizeClass];
+  MUTEX_LOCKER(locker, sc.mutex);
+
+  if (sc.buffers.empty()) {
+    return nullptr;
+  }
+  std::unique_ptr<basics::StringBuffer> result = std::move(sc.buffers.back());
+  sc.buffers.pop_back();
+  sc.pooled -= result->capacity();
+  return result;
+}
+}  // namespace
+
+int ReadBufferPool::lease(basics::StringBuffer& buffer, size_t capacity) {
+  TRI_ASSERT(buffer.capacity() == 0);
+  leases.fetch_add(1, std::memory_order_relaxed);
+
+  size_t sizeClass = 0;
+  while (sizeClass < NumSizeClasses && SizeClasses[sizeClass] < capacity) {
+    ++sizeClass;
+  }
+
+  // take a buffer of the size class or the one above, larger ones would
+  // hand out too much memory to a single connection
+  for (size_t i = sizeClass; i < (std::min)(sizeClass + 2, NumSizeClasses); ++i) {
+    std::unique_ptr<basics::StringBuffer> pooled = pop(i);
+    if (pooled != nullptr) {
+      memoryPooled.fetch_sub(pooled->capacity(), std::memory_order_relaxed);
+      poolHits.fetch_add(1, std::memory_order_relaxed);
+      pooled->reset();
+      buffer.swap(pooled.get());
+      return TRI_ERROR_NO_ERROR;
+    }
+  }
+
+  size_t size = sizeClass < NumSizeClasses ? SizeClasses[sizeClass] : capacity;
+  return buffer.reserve(size);
+}
+
+void ReadBufferPool::release(basics::StringBuffer& buffer) {
+  size_t capacity = buffer.capacity();
+  if (capacity < SizeClasses[0] || capacity > 2 * SizeClasses[NumSizeClasses - 1]) {
+    // too small to bother or too large to keep around
+    char* memory = buffer.steal();
+    if (memory != nullptr) {
+      TRI_Free(memory);
+    }
+    return;
+  }
+
+  size_t sizeClass = NumSizeClasses - 1;
+  while (SizeClasses[sizeClass] > capacity) {
+    --sizeClass;
+  }
+
+  auto pooled = std::make_unique<basics::StringBuffer>();
+  pooled->swap(&buffer);
+
+  SizeClass& sc = sizeClasses[sizeClass];
+  {
+    MUTEX_LOCKER(locker, sc.mutex);
+    if (sc.pooled + capacity <= MaxPooledPerSizeClass) {
+      sc.buffers.emplace_back(std::move(pooled));
+      sc.pooled += capacity;
+    }
+  }
+
+  // pooled is still set if the size class is full and frees the memory
+  if (pooled == nullptr) {
+    memoryPooled.fetch_add(capacity, std::memory_order_relaxed);
+    updateHighWaterMark();
+  }
+}
+
+void ReadBufferPool::track(basics::StringBuffer const& buffer, size_t& accounted) {
+  size_t capacity = buffer.capacity();
+  if (capacity > accounted) {
+    memoryInUse.fetch_add(capacity - accounted, std::memory_order_relaxed);
+    updateHighWaterMark();
+  } else if (capacity < accounted) {
+    memoryInUse.fetch_sub(accounted - capacity, std::memory_order_relaxed);
+  }
+  accounted = capacity;
+}
+
+void ReadBufferPool::toVelocyPack(velocypack::Builder& b) {
+  b.add("memoryInUse", VPackValue(memoryInUse.load(std::memory_order_relaxed)));
+  b.add("memoryPooled", VPackValue(memoryPooled.load(std::memory_order_relaxed)));
+  b.add("highWaterMark", VPackValue(highWaterMark.load(std::memory_order_relaxed)));
+  b.add("leases", VPackValue(leases.load(std::memory_order_relaxed)));
+  b.add("poolHits", VPackValue(poolHits.load(std::memory_order_relaxed)));
+}
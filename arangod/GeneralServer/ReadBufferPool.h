@@ -0,0 +1,68 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef ARANGOD_GENERAL_SERVER_READ_BUFFER_POOL_H
+#define ARANGOD_GENERAL_SERVER_READ_BUFFER_POOL_H 1
+
+#include "Basics/Common.h"
+
+namespace arangodb {
+namespace basics {
+class StringBuffer;
+}
+namespace velocypack {
+class Builder;
+}
+
+namespace rest {
+
+/// @brief process wide pool of connection read buffers. the memory of a
+/// released buffer is kept in the largest size class it covers, so that
+/// idle connections do not pin the largest request they have ever seen
+class ReadBufferPool {
+ public:
+  static constexpr size_t NumSizeClasses = 5;
+  static size_t const SizeClasses[NumSizeClasses];
+
+  /// @brief pooled memory per size class, buffers beyond it are freed
+  static size_t const MaxPooledPerSizeClass;
+
+ public:
+  /// @brief gives the buffer, which must not hold any memory, a capacity of
+  /// at least the given size, taking the memory from the pool if possible.
+  /// returns TRI_ERROR_OUT_OF_MEMORY if nothing could be allocated
+  static int lease(basics::StringBuffer& buffer, size_t capacity);
+
+  /// @brief takes the memory away from the buffer and keeps it for reuse.
+  /// the buffer does not hold any memory afterwards
+  static void release(basics::StringBuffer& buffer);
+
+  /// @brief tracks the memory of a read buffer in use. accounted is the
+  /// capacity the owner reported last and is updated
+  static void track(basics::StringBuffer const& buffer, size_t& accounted);
+
+  /// @brief memory of read buffers, for the server statistics
+  static void toVelocyPack(velocypack::Builder&);
+};
+}  // namespace rest
+}  // namespace arangodb
+
+#endif
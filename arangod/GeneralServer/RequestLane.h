@@ -83,6 +83,7 @@ enum class RequestLane {
   TASK_V8,
 
   // Internal tasks with low priority
+  // This must remain the last lane, see NumRequestLanes below.
   INTERNAL_LOW,
 
   // Not yet used:
@@ -92,6 +93,17 @@ enum class RequestLane {
   // AGENCY_CALLBACK`
 };
 
+// number of distinct request lanes
+constexpr size_t NumRequestLanes = static_cast<size_t>(RequestLane::INTERNAL_LOW) + 1;
+
+// whether or not requests on this lane are sent by clients rather than by
+// other servers of the cluster or by the server itself
+inline bool isClientRequestLane(RequestLane lane) {
+  return lane == RequestLane::CLIENT_FAST || lane == RequestLane::CLIENT_AQL ||
+         lane == RequestLane::CLIENT_V8 || lane == RequestLane::CLIENT_SLOW ||
+         lane == RequestLane::CLIENT_UI;
+}
+
 enum class RequestPriority { HIGH, MED, LOW };
 
 inline RequestPriority PriorityRequestLane(RequestLane lane) {
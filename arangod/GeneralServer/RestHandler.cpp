@@ -54,6 +54,7 @@ RestHandler::RestHandler(GeneralRequest* request, GeneralResponse* response)
       _response(response),
       _statistics(nullptr),
       _state(HandlerState::PREPARE),
+      _onIoThread(false),
       _handlerId(0) {}
 
 RestHandler::~RestHandler() {
@@ -95,6 +96,11 @@ void RestHandler::setStatistics(RequestStatistics* stat) {
   }
 }
 
+void RestHandler::startTrace(tracing::SpanContext const& parent) {
+  _traceSpan = tracing::Span("request", parent);
+  _traceSpan.setDetail(_request->requestPath());
+}
+
 bool RestHandler::forwardRequest() {
   if (!ServerState::instance()->isCoordinator()) {
     return false;
@@ -258,6 +264,8 @@ bool RestHandler::forwardRequest() {
 void RestHandler::runHandlerStateMachine() {
   TRI_ASSERT(_callback);
   MUTEX_LOCKER(locker, _executionMutex);
+  // everything done on behalf of this request belongs to its trace
+  tracing::ContextScope traceScope(_traceSpan.context());
 
   while (true) {
     switch (_state) {
@@ -295,6 +303,7 @@ void RestHandler::runHandlerStateMachine() {
 
       case HandlerState::FINALIZE:
         RequestStatistics::SET_REQUEST_END(_statistics);
+        _traceSpan.finish();
         // Callback may stealStatistics!
         _callback(this);
         // Schedule callback BEFORE! finalize
@@ -303,6 +312,7 @@ void RestHandler::runHandlerStateMachine() {
 
       case HandlerState::FAILED:
         RequestStatistics::SET_REQUEST_END(_statistics);
+        _traceSpan.finish();
         // Callback may stealStatistics!
         _callback(this);
         // No need to finalize here!
@@ -29,6 +29,7 @@
 #include "GeneralServer/RequestLane.h"
 #include "Rest/GeneralResponse.h"
 #include "Scheduler/Scheduler.h"
+#include "Statistics/Tracing.h"
 
 namespace arangodb {
 namespace basics {
@@ -72,6 +73,13 @@ class RestHandler : public std::enable_shared_from_this<RestHandler> {
 
   void setStatistics(RequestStatistics* stat);
 
+  /// @brief starts the span of the request, as a child of the given
+  /// context. nothing is traced if the context is not sampled
+  void startTrace(tracing::SpanContext const& parent);
+  tracing::SpanContext const& traceContext() const {
+    return _traceSpan.context();
+  }
+
   /// Execute the rest handler state machine
   void runHandler(std::function<void(rest::RestHandler*)> cb) {
     TRI_ASSERT(_state == HandlerState::PREPARE);
@@ -103,6 +111,11 @@ class RestHandler : public std::enable_shared_from_this<RestHandler> {
     return lane();
   }
 
+  /// @brief whether the request can be executed right on the IO thread.
+  /// the handler must then never block, but continue on the scheduler
+  /// whenever it would have to wait
+  virtual bool canRunOnIoThread() const { return false; }
+
   virtual void prepareExecute(bool isContinue) {}
   virtual RestStatus execute() = 0;
   virtual RestStatus continueExecute() { return RestStatus::DONE; }
@@ -167,11 +180,17 @@ class RestHandler : public std::enable_shared_from_this<RestHandler> {
   std::atomic<RequestStatistics*> _statistics;
   HandlerState _state;
 
+  // executed on the IO thread, see canRunOnIoThread()
+  bool _onIoThread;
+
  private:
   uint64_t _handlerId;
 
   std::function<void(rest::RestHandler*)> _callback;
 
+  /// @brief span of the whole request, if it is sampled
+  tracing::Span _traceSpan;
+
   mutable Mutex _executionMutex;
 };
 
@@ -33,6 +33,7 @@
 namespace arangodb {
 
 typedef std::function<void(const asio_ns::error_code& ec, std::size_t transferred)> AsyncHandler;
+typedef std::function<void(const asio_ns::error_code& ec)> WaitHandler;
 
 class Socket {
  public:
@@ -102,6 +103,9 @@ class Socket {
   virtual std::size_t available(asio_ns::error_code& ec) = 0;
   virtual void asyncRead(asio_ns::mutable_buffers_1 const& buffer,
                          AsyncHandler const& handler) = 0;
+  // waits until the socket becomes readable without holding a buffer.
+  // returns false if not supported, as by TLS, which may have data pending
+  virtual bool asyncWaitReadable(WaitHandler const&) { return false; }
   virtual void close(asio_ns::error_code& ec) = 0;
 
  protected:
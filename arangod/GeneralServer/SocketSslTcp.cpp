@@ -84,5 +84,9 @@ bool SocketSslTcp::sslHandshake() {
         << "unable to perform ssl handshake: " << ec.message() << " : " << ec.value();
     return false;
   }
+
+  LOG_TOPIC("48c1d", TRACE, Logger::COMMUNICATION)
+      << "ssl handshake done, session "
+      << (SSL_session_reused(_sslSocket->native_handle()) ? "resumed" : "created");
   return true;
 }
@@ -33,10 +33,11 @@ class SocketSslTcp final : public Socket {
   friend class AcceptorTcp;
 
  public:
-  SocketSslTcp(rest::GeneralServer::IoContext& context, asio_ns::ssl::context&& sslContext)
+  SocketSslTcp(rest::GeneralServer::IoContext& context,
+               std::shared_ptr<asio_ns::ssl::context> sslContext)
       : Socket(context, /*encrypted*/ true),
         _sslContext(std::move(sslContext)),
-        _sslSocket(context.newSslSocket(_sslContext)),
+        _sslSocket(context.newSslSocket(*_sslContext)),
         _socket(_sslSocket->next_layer()),
         _peerEndpoint() {}
 
@@ -95,7 +96,8 @@ class SocketSslTcp final : public Socket {
   }
 
  private:
-  asio_ns::ssl::context _sslContext;
+  // shared by all connections of the server
+  std::shared_ptr<asio_ns::ssl::context> _sslContext;
   std::unique_ptr<asio_ns::ssl::stream<asio_ns::ip::tcp::socket>> _sslSocket;
   asio_ns::ip::tcp::socket& _socket;
   asio_ns::ip::tcp::acceptor::endpoint_type _peerEndpoint;
@@ -30,6 +30,7 @@
 #include "Basics/StringBuffer.h"
 #include "Basics/socket-utils.h"
 #include "Endpoint/ConnectionInfo.h"
+#include "GeneralServer/ReadBufferPool.h"
 #include "Logger/Logger.h"
 #include "Scheduler/Scheduler.h"
 #include "Scheduler/SchedulerFeature.h"
@@ -59,7 +60,8 @@ SocketTask::SocketTask(GeneralServer& server,
       _peer(std::move(socket)),
       _connectionInfo(std::move(connectionInfo)),
       _connectionStatistics(nullptr),
-      _readBuffer(READ_BLOCK_SIZE + 1, false),
+      _readBuffer(),
+      _readBufferMemory(0),
       _stringBuffers{_stringBuffersArena},
       _writeBuffer(nullptr, nullptr),
       _keepAliveTimeout(static_cast<long>(keepAliveTimeout * 1000)),
@@ -69,7 +71,9 @@ SocketTask::SocketTask(GeneralServer& server,
       _closeRequested(false),
       _abandoned(false),
       _closedSend(false),
-      _closedReceive(false) {
+      _closedReceive(false),
+      _readPaused(false),
+      _readStopped(false) {
   _connectionStatistics = ConnectionStatistics::acquire();
   ConnectionStatistics::SET_START(_connectionStatistics);
 
@@ -94,6 +98,8 @@ SocketTask::~SocketTask() {
 
   cancelKeepAlive();
 
+  releaseReadBuffer();
+
   // _peer could be nullptr if it was moved out of a HttpCommTask, during
   // upgrade to a VstCommTask.
   if (_peer) {
@@ -141,25 +147,38 @@ bool SocketTask::start() {
 
 // caller must hold the _lock
 void SocketTask::addWriteBuffer(WriteBuffer&& buffer) {
+  addWriteBuffer(std::move(buffer), WriteBuffer(nullptr, nullptr));
+}
+
+// caller must hold the _lock
+void SocketTask::addWriteBuffer(WriteBuffer&& buffer, WriteBuffer&& next) {
   TRI_ASSERT(_peer->runningInThisThread());
 
   if (_closedSend.load(std::memory_order_acquire) ||
       _abandoned.load(std::memory_order_acquire)) {
     LOG_TOPIC("01285", DEBUG, Logger::COMMUNICATION) << "Connection abandoned or closed";
     buffer.release();
+    next.release();
     return;
   }
 
   TRI_ASSERT(!buffer.empty());
+  bool const writing = !_writeBuffer.empty();
   if (!buffer.empty()) {
-    if (!_writeBuffer.empty()) {
+    if (writing) {
       _writeBuffers.emplace_back(std::move(buffer));
-      return;
+    } else {
+      _writeBuffer = std::move(buffer);
     }
-    _writeBuffer = std::move(buffer);
   }
 
-  asyncWriteSome();
+  if (!next.empty()) {
+    _writeBuffers.emplace_back(std::move(next));
+  }
+
+  if (!writing) {
+    asyncWriteSome();
+  }
 }
 
 // caller must hold the _lock
@@ -172,6 +191,8 @@ bool SocketTask::completedWriteBuffer() {
   if (_writeBuffers.empty()) {
     if (_closeRequested) {
       closeStreamNoLock();
+    } else {
+      completedWrites();
     }
     return false;
   }
@@ -212,7 +233,9 @@ void SocketTask::closeStreamNoLock() {
   _closedReceive.store(true, std::memory_order_release);
   _closeRequested.store(false, std::memory_order_release);
   cancelKeepAlive();
-  
+
+  streamClosed();
+
   _server.unregisterTask(this->id());
 }
 
@@ -226,6 +249,7 @@ void SocketTask::addToReadBuffer(char const* data, std::size_t len) {
   TRI_ASSERT(_peer->runningInThisThread());
 
   _readBuffer.appendText(data, len);
+  ReadBufferPool::track(_readBuffer, _readBufferMemory);
 }
 
 // does not need lock
@@ -263,7 +287,16 @@ bool SocketTask::reserveMemory() {
   TRI_ASSERT(_peer != nullptr);
   TRI_ASSERT(_peer->runningInThisThread());
 
-  if (_readBuffer.reserve(READ_BLOCK_SIZE + 1) == TRI_ERROR_OUT_OF_MEMORY) {
+  int res = TRI_ERROR_NO_ERROR;
+  if (_readBuffer.capacity() == 0) {
+    res = ReadBufferPool::lease(_readBuffer, READ_BLOCK_SIZE + 1);
+  }
+  if (res == TRI_ERROR_NO_ERROR) {
+    res = _readBuffer.reserve(READ_BLOCK_SIZE + 1);
+  }
+  ReadBufferPool::track(_readBuffer, _readBufferMemory);
+
+  if (res == TRI_ERROR_OUT_OF_MEMORY) {
     LOG_TOPIC("1997b", WARN, arangodb::Logger::COMMUNICATION)
         << "out of memory while reading from client";
     closeStreamNoLock();
@@ -273,6 +306,11 @@ bool SocketTask::reserveMemory() {
   return true;
 }
 
+void SocketTask::releaseReadBuffer() {
+  ReadBufferPool::release(_readBuffer);
+  ReadBufferPool::track(_readBuffer, _readBufferMemory);
+}
+
 // caller must be on _peer->strand()
 bool SocketTask::trySyncRead() {
   if (_abandoned.load(std::memory_order_acquire)) {
@@ -368,6 +406,11 @@ void SocketTask::asyncReadSome() {
   TRI_ASSERT(_peer != nullptr);
   TRI_ASSERT(_peer->runningInThisThread());
 
+  if (_readPaused) {
+    _readStopped = true;
+    return;
+  }
+
   if (this->canUseMixedIO()) {
     // try some direct read only for non-SSL mode
     // in SSL mode it will fall apart when mixing direct reads and async
@@ -391,6 +434,10 @@ void SocketTask::asyncReadSome() {
         // ignore the result of processAll, try to read more bytes down below
         processAll();
         compactify();
+
+        if (_readPaused) {
+          break;
+        }
       }
     } catch (asio_ns::system_error const& err) {
       LOG_TOPIC("d5bb6", DEBUG, Logger::COMMUNICATION) << "sync read failed with: " << err.what();
@@ -408,6 +455,51 @@ void SocketTask::asyncReadSome() {
   if (_abandoned.load(std::memory_order_acquire)) {
     return;
   }
+
+  if (_readPaused) {
+    _readStopped = true;
+    return;
+  }
+
+  if (_readBuffer.empty()) {
+    // nothing is buffered, so the connection is idle. wait for the next
+    // request without holding any memory if the socket allows this,
+    // otherwise shrink the buffer to the smallest size class
+    bool waiting = _peer->asyncWaitReadable([self = shared_from_this()](asio_ns::error_code const& ec) {
+      auto thisPtr = self.get();
+
+      if (thisPtr->_abandoned.load(std::memory_order_acquire)) {
+        return;
+      }
+      if (ec) {
+        LOG_TOPIC("4b2e8", DEBUG, Logger::COMMUNICATION)
+            << "waiting on stream failed with: " << ec.message();
+        thisPtr->closeStream();
+        return;
+      }
+
+      // a read is needed, as a closed connection is readable as well
+      thisPtr->asyncReadIntoBuffer();
+    });
+
+    if (waiting) {
+      // the handler cannot run before we return, it is invoked on this thread
+      releaseReadBuffer();
+      return;
+    }
+    if (_readBuffer.capacity() >= ReadBufferPool::SizeClasses[1]) {
+      releaseReadBuffer();
+    }
+  }
+
+  asyncReadIntoBuffer();
+}
+
+// must be invoked on strand
+void SocketTask::asyncReadIntoBuffer() {
+  TRI_ASSERT(_peer != nullptr);
+  TRI_ASSERT(_peer->runningInThisThread());
+
   if (!reserveMemory()) {
     LOG_TOPIC("fcd45", TRACE, Logger::COMMUNICATION) << "failed to reserve memory";
     return;
@@ -589,6 +681,20 @@ void SocketTask::returnStringBuffer(StringBuffer* buffer) {
   }
 }
 
+void SocketTask::resumeRead() {
+  _peer->post([self = shared_from_this()] {
+    self->_readPaused = false;
+    if (self->_closedReceive.load(std::memory_order_acquire)) {
+      return;
+    }
+    // a read may still be scheduled, which must not be doubled
+    if (self->_readStopped) {
+      self->_readStopped = false;
+      self->asyncReadSome();
+    }
+  });
+}
+
 void SocketTask::triggerProcessAll() {
   // try to process remaining request data
   _peer->post([self = shared_from_this()] { self->processAll(); });
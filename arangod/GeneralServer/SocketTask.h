@@ -41,6 +41,7 @@ class ConnectionStatistics;
 namespace rest {
 class SocketTask : public std::enable_shared_from_this<SocketTask> {
   friend class HttpCommTask;
+  friend class Http2CommTask;
   friend class GeneralServer;
 
   explicit SocketTask(SocketTask const&) = delete;
@@ -75,6 +76,12 @@ class SocketTask : public std::enable_shared_from_this<SocketTask> {
   virtual bool processRead(double startTime) = 0;
   virtual void compactify() {}
 
+  // called on strand when the connection is closed
+  virtual void streamClosed() {}
+
+  // called on strand when all queued write buffers have been sent
+  virtual void completedWrites() {}
+
   // This function is used during the protocol switch from http
   // to VelocyStream. This way we do not require additional
   // constructor arguments. It should not be used otherwise.
@@ -141,6 +148,11 @@ class SocketTask : public std::enable_shared_from_this<SocketTask> {
   // will be run in strand
   void addWriteBuffer(WriteBuffer&&);
 
+  // will be run in strand
+  // queues both buffers before writing starts, so the second one directly
+  // follows the first one on the wire
+  void addWriteBuffer(WriteBuffer&&, WriteBuffer&&);
+
   // will be run in strand
   void closeStream();
 
@@ -165,13 +177,27 @@ class SocketTask : public std::enable_shared_from_this<SocketTask> {
   bool processAll();
   void triggerProcessAll();
 
+  // whether all queued write buffers have been sent
+  bool writeQueueEmpty() const { return _writeBuffer.empty(); }
+
+  // stops reading from the socket after the current read, for consumers
+  // that cannot keep up with the client. runs on strand
+  void pauseRead() { _readPaused = true; }
+  // continues reading, can be called from any thread
+  void resumeRead();
+
  private:
   bool completedWriteBuffer();
 
   bool reserveMemory();
   bool trySyncRead();
 
+  // hands the read buffer back to the pool
+  void releaseReadBuffer();
+
   void asyncReadSome();
+  // reads into the read buffer, reserving it first
+  void asyncReadIntoBuffer();
   void asyncWriteSome();
 
  protected:
@@ -183,9 +209,14 @@ class SocketTask : public std::enable_shared_from_this<SocketTask> {
   ConnectionInfo _connectionInfo;
 
   ConnectionStatistics* _connectionStatistics;
+  // leased from the ReadBufferPool, holds no memory while the connection
+  // is idle
   basics::StringBuffer _readBuffer;
 
  private:
+  // capacity of _readBuffer as reported to the ReadBufferPool
+  size_t _readBufferMemory;
+
   Mutex _bufferLock;
   SmallVector<basics::StringBuffer*, 32>::allocator_type::arena_type _stringBuffersArena;
   SmallVector<basics::StringBuffer*, 32> _stringBuffers;  // needs _bufferLock
@@ -203,6 +234,11 @@ class SocketTask : public std::enable_shared_from_this<SocketTask> {
   std::atomic<bool> _abandoned;      // was task abandoned for another task
   std::atomic<bool> _closedSend;     // Close socket send
   std::atomic<bool> _closedReceive;  // Closed socket received
+
+  // only accessed on strand
+  bool _readPaused;
+  // asyncReadSome returned without reading because of _readPaused
+  bool _readStopped;
 };
 }  // namespace rest
 }  // namespace arangodb
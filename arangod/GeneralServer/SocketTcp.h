@@ -66,6 +66,11 @@ class SocketTcp final : public Socket {
     return _socket->async_read_some(buffer, handler);
   }
 
+  bool asyncWaitReadable(WaitHandler const& handler) override {
+    _socket->async_wait(asio_ns::ip::tcp::socket::wait_read, handler);
+    return true;
+  }
+
   void close(asio_ns::error_code& ec) override {
     if (_socket->is_open()) {
       _socket->close(ec);
@@ -49,6 +49,11 @@ void SocketUnixDomain::asyncRead(asio_ns::mutable_buffers_1 const& buffer,
   return _socket->async_read_some(buffer, handler);
 }
 
+bool SocketUnixDomain::asyncWaitReadable(WaitHandler const& handler) {
+  _socket->async_wait(asio_ns::local::stream_protocol::socket::wait_read, handler);
+  return true;
+}
+
 void SocketUnixDomain::shutdownReceive(asio_ns::error_code& ec) {
   _socket->shutdown(asio_ns::local::stream_protocol::socket::shutdown_receive, ec);
 }
@@ -56,6 +56,8 @@ class SocketUnixDomain final : public Socket {
 
   void asyncRead(asio_ns::mutable_buffers_1 const& buffer, AsyncHandler const& handler) override;
 
+  bool asyncWaitReadable(WaitHandler const& handler) override;
+
  protected:
   bool sslHandshake() override { return false; }
   void shutdownReceive(asio_ns::error_code& ec) override;
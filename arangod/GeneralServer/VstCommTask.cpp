@@ -411,6 +411,16 @@ bool VstCommTask::processRead(double startTime) {
   return true;
 }
 
+void VstCommTask::compactify() {
+  auto& prv = _processReadVariables;
+  // empty the buffer once all chunks are processed, so that it can go
+  // back to the pool while the connection is idle
+  if (prv._readBufferOffset > 0 && prv._readBufferOffset == _readBuffer.length()) {
+    _readBuffer.reset();
+    prv._readBufferOffset = 0;
+  }
+}
+
 void VstCommTask::closeTask(rest::ResponseCode code) {
   _processReadVariables._readBufferOffset = 0;
   _processReadVariables._currentChunkLength = 0;
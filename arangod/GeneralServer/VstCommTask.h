@@ -53,6 +53,7 @@ class VstCommTask final : public GeneralCommTask {
   // read data check if chunk and message are complete
   // if message is complete execute a request
   bool processRead(double startTime) override;
+  void compactify() override;
 
   std::unique_ptr<GeneralResponse> createResponse(rest::ResponseCode,
                                                   uint64_t messageId) override final;
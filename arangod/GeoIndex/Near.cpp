@@ -31,6 +31,9 @@
 
 #include <s2/s2distance_target.h>
 
+#include <mutex>
+#include <unordered_map>
+
 #include <velocypack/Builder.h>
 #include <velocypack/Slice.h>
 #include <velocypack/velocypack-aliases.h>
@@ -122,6 +125,131 @@ void NearUtils<CMP>::estimateDensity(S2Point const& found) {
   }
 }
 
+namespace {
+
+/// regions with cached coverings
+enum class CoverType : uint8_t { FAST_CAP, CAP, RING };
+
+/// coverings only depend on the covered region and the coverer options
+struct CoverKey {
+  CoverType type;
+  S2Point origin;
+  double innerLength2;  // unused for caps
+  double outerLength2;
+  int minLevel;
+  int maxLevel;
+  int levelMod;
+  int maxCells;
+
+  bool operator==(CoverKey const& other) const noexcept {
+    return type == other.type && origin == other.origin &&
+           innerLength2 == other.innerLength2 &&
+           outerLength2 == other.outerLength2 && minLevel == other.minLevel &&
+           maxLevel == other.maxLevel && levelMod == other.levelMod &&
+           maxCells == other.maxCells;
+  }
+};
+
+struct CoverKeyHash {
+  size_t operator()(CoverKey const& key) const noexcept {
+    std::hash<double> hasher;
+    size_t hash = static_cast<size_t>(key.type);
+    for (double v : {key.origin.x(), key.origin.y(), key.origin.z(),
+                     key.innerLength2, key.outerLength2}) {
+      hash = hash * 31 + hasher(v);
+    }
+    for (int v : {key.minLevel, key.maxLevel, key.levelMod, key.maxCells}) {
+      hash = hash * 31 + static_cast<size_t>(v);
+    }
+    return hash;
+  }
+};
+
+/// Process-wide cache of the coverings of search caps and rings. Queries
+/// around the same origins (e.g. map tiles) request the same coverings over
+/// and over again, computing them dominates the cost of small near queries.
+/// The cache is simply emptied once it is full
+class CoverCache {
+ public:
+  template <typename F>
+  void covering(CoverKey const& key, std::vector<S2CellId>* cover, F&& compute) {
+    {
+      std::lock_guard<std::mutex> guard(_mutex);
+      auto it = _covers.find(key);
+      if (it != _covers.end()) {
+        *cover = it->second;
+        return;
+      }
+    }
+
+    std::forward<F>(compute)(cover);
+
+    std::lock_guard<std::mutex> guard(_mutex);
+    if (_covers.size() >= kMaxEntries) {
+      _covers.clear();
+    }
+    _covers.emplace(key, *cover);
+  }
+
+  static CoverCache& instance() {
+    static CoverCache cache;
+    return cache;
+  }
+
+ private:
+  static constexpr size_t kMaxEntries = 8192;
+
+  std::mutex _mutex;
+  std::unordered_map<CoverKey, std::vector<S2CellId>, CoverKeyHash> _covers;
+};
+
+CoverKey coverKey(CoverType type, S2RegionCoverer const& coverer, S2Point const& origin,
+                  S1ChordAngle inner, S1ChordAngle outer) {
+  S2RegionCoverer::Options const& opts = coverer.options();
+  return CoverKey{type,
+                  origin,
+                  inner.length2(),
+                  outer.length2(),
+                  opts.min_level(),
+                  opts.max_level(),
+                  opts.level_mod(),
+                  opts.max_cells()};
+}
+
+/// covering of the cap around origin, served from the cover cache
+void capCovering(S2RegionCoverer& coverer, S2Point const& origin,
+                 S1ChordAngle outer, bool fast, std::vector<S2CellId>* cover) {
+  CoverType type = fast ? CoverType::FAST_CAP : CoverType::CAP;
+  CoverCache::instance().covering(
+      coverKey(type, coverer, origin, S1ChordAngle::Zero(), outer), cover,
+      [&](std::vector<S2CellId>* result) {
+        S2Cap ob(origin, outer);
+        if (fast) {
+          coverer.GetFastCovering(ob, result);
+        } else {
+          coverer.GetCovering(ob, result);
+        }
+      });
+}
+
+/// covering of the ring between inner and outer angle around origin,
+/// served from the cover cache
+void ringCovering(S2RegionCoverer& coverer, S2Point const& origin, S1ChordAngle inner,
+                  S1ChordAngle outer, std::vector<S2CellId>* cover) {
+  CoverCache::instance().covering(
+      coverKey(CoverType::RING, coverer, origin, inner, outer), cover,
+      [&](std::vector<S2CellId>* result) {
+        std::vector<std::unique_ptr<S2Region>> regions;
+        S2Cap ib(origin, inner);  // inner ring
+        regions.push_back(std::make_unique<S2Cap>(ib.Complement()));
+        regions.push_back(std::make_unique<S2Cap>(origin, outer));
+        S2RegionIntersection ring(std::move(regions));
+        coverer.GetCovering(ring, result);
+      });
+}
+
+}  // namespace
+
 /// Makes sure we do not have a search area already covered by cell_ids.
 /// The parameter cell_ids must be normalized, otherwise result is undefined
 /// Calculates id - cell_ids and adds the remaining cell(s) to result
@@ -179,13 +307,12 @@ std::vector<geo::Interval> NearUtils<CMP>::intervals() {
   std::vector<S2CellId> cover;
   if (_innerAngle == _minAngle) {
     // LOG_TOPIC("55f3b", INFO, Logger::FIXME) << "[Scan] 0 to something";
-    S2Cap ob = S2Cap(_origin, _outerAngle);
     //_coverer.GetCovering(ob, &cover);
     if (_scannedCells.empty() == 0) {
-      _coverer.GetFastCovering(ob, &cover);
+      capCovering(_coverer, _origin, _outerAngle, true, &cover);
     } else {
       std::vector<S2CellId> tmpCover;
-      _coverer.GetFastCovering(ob, &tmpCover);
+      capCovering(_coverer, _origin, _outerAngle, true, &tmpCover);
       for (S2CellId id : tmpCover) {
         GetDifference(_scannedCells, id, &cover);
       }
@@ -194,21 +321,15 @@ std::vector<geo::Interval> NearUtils<CMP>::intervals() {
     // create a search ring
 
     if (_scannedCells.size() > 0) {
-      S2Cap ob(_origin, _outerAngle);  // outer ring
-      std::vector<S2CellId> tmpCover;
-      _coverer.GetCovering(ob, &tmpCover);
+      std::vector<S2CellId> tmpCover;  // outer ring
+      capCovering(_coverer, _origin, _outerAngle, false, &tmpCover);
       //_coverer.GetFastCovering(ob, &tmpCover);
       for (S2CellId id : tmpCover) {
         GetDifference(_scannedCells, id, &cover);
       }
     } else {
       // expensive exact cover
-      std::vector<std::unique_ptr<S2Region>> regions;
-      S2Cap ib(_origin, _innerAngle);  // inner ring
-      regions.push_back(std::make_unique<S2Cap>(ib.Complement()));
-      regions.push_back(std::make_unique<S2Cap>(_origin, _outerAngle));
-      S2RegionIntersection ring(std::move(regions));
-      _coverer.GetCovering(ring, &cover);
+      ringCovering(_coverer, _origin, _innerAngle, _outerAngle, &cover);
     }
 
     /*std::vector<std::unique_ptr<S2Region>> regions;
@@ -262,7 +383,7 @@ void NearUtils<CMP>::reportFound(LocalDocumentId lid, S2Point const& center) {
   }
 
   if (!_params.pointsOnly) {
-    auto result = _seenDocs.insert(lid.id());
+    auto result = _seenDocs.emplace(lid.id(), angle);
     if (!result.second) {
       _rejection++;
       return;  // ignore repeated documents
@@ -288,6 +409,7 @@ void NearUtils<CMP>::didScanIntervals() {
   if (!_allIntervalsCovered) {
     estimateDelta();
     calculateBounds();
+    pruneSeenDocs();
   }
 }
 
@@ -296,9 +418,11 @@ template <typename CMP>
 void NearUtils<CMP>::estimateDelta() {
   S1ChordAngle minBound =
       S1ChordAngle::Radians(S2::kMaxDiag.GetValue(S2::kMaxCellLevel - 3));
-  if (_statsFoundLastInterval <= 64) {
+  // enough buffered results, the search area must not grow any further
+  bool const mayGrow = _buffer.size() <= kMaxBufferedDocs;
+  if (mayGrow && _statsFoundLastInterval <= 64) {
     _deltaAngle = S1ChordAngle::FromLength2(_deltaAngle.length2() * 4);
-  } else if (_statsFoundLastInterval <= 256) {
+  } else if (mayGrow && _statsFoundLastInterval <= 256) {
     _deltaAngle += _deltaAngle;
   } else if (_statsFoundLastInterval > 1024 && _deltaAngle > minBound) {
     _deltaAngle = S1ChordAngle::FromLength2(_deltaAngle.length2() / 2);
@@ -307,6 +431,24 @@ void NearUtils<CMP>::estimateDelta() {
   TRI_ASSERT(_deltaAngle > S1ChordAngle::Zero());
 }
 
+/// Documents outside of the remaining search area are rejected by their
+/// distance before the deduplication filter is consulted, so their entries
+/// can be dropped. Keeps the filter proportional to the search frontier
+template <typename CMP>
+void NearUtils<CMP>::pruneSeenDocs() {
+  if (isFilterIntersects() || _seenDocs.empty()) {
+    return;  // distance based rejection is not used
+  }
+  for (auto it = _seenDocs.begin(); it != _seenDocs.end();) {
+    if ((isAscending() && it->second < _innerAngle) ||
+        (isDescending() && it->second > _outerAngle)) {
+      it = _seenDocs.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
 /// @brief estimate the scan bounds
 template <typename CMP>
 void NearUtils<CMP>::calculateBounds() {
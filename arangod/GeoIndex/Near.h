@@ -25,6 +25,7 @@
 
 #include <queue>
 #include <type_traits>
+#include <unordered_map>
 #include <vector>
 
 #include <s2/s2cap.h>
@@ -71,6 +72,10 @@ struct DocumentsDescending {
 /// search intervals). Should be storage engine agnostic
 template <typename CMP = DocumentsAscending>
 class NearUtils {
+  /// do not widen the search area while this many documents are buffered,
+  /// keeps the memory of long cursors bounded by the search frontier
+  static constexpr size_t kMaxBufferedDocs = 4096;
+
   static_assert(std::is_same<CMP, DocumentsAscending>::value ||
                     std::is_same<CMP, DocumentsDescending>::value,
                 "Invalid template type");
@@ -161,6 +166,8 @@ class NearUtils {
  private:
   /// @brief adjust the bounds delta
   void estimateDelta();
+  /// @brief forget seen documents outside of the remaining search area
+  void pruneSeenDocs();
   /// @brief calculate the scan bounds
   void calculateBounds();
 
@@ -210,8 +217,9 @@ class NearUtils {
   /// buffer of found documents
   GeoDocumentsQueue _buffer;
 
-  // deduplication filter
-  std::unordered_set<uint64_t> _seenDocs;
+  /// deduplication filter, maps documents to their distance to be able to
+  /// drop entries once the search area has moved past them
+  std::unordered_map<uint64_t, S1ChordAngle> _seenDocs;
 
   /// Track the already scanned region
   std::vector<S2CellId> _scannedCells;
@@ -51,7 +51,8 @@ BaseOptions::LookupInfo::LookupInfo()
     : expression(nullptr),
       indexCondition(nullptr),
       conditionNeedUpdate(false),
-      conditionMemberToUpdate(0) {
+      conditionMemberToUpdate(0),
+      coveringComputed(false) {
   // NOTE: We need exactly one in this case for the optimizer to update
   idxHandles.resize(1);
 };
@@ -63,7 +64,8 @@ BaseOptions::LookupInfo::~LookupInfo() {
 }
 
 BaseOptions::LookupInfo::LookupInfo(arangodb::aql::Query* query,
-                                    VPackSlice const& info, VPackSlice const& shards) {
+                                    VPackSlice const& info, VPackSlice const& shards)
+    : coveringComputed(false) {
   TRI_ASSERT(shards.isArray());
   idxHandles.reserve(shards.length());
 
@@ -115,7 +117,8 @@ BaseOptions::LookupInfo::LookupInfo(LookupInfo const& other)
       expression(nullptr),
       indexCondition(other.indexCondition),
       conditionNeedUpdate(other.conditionNeedUpdate),
-      conditionMemberToUpdate(other.conditionMemberToUpdate) {
+      conditionMemberToUpdate(other.conditionMemberToUpdate),
+      coveringComputed(false) {
   if (other.expression != nullptr) {
     expression = other.expression->clone(nullptr, nullptr);
   }
@@ -396,6 +399,52 @@ double BaseOptions::costForLookupInfoList(std::vector<BaseOptions::LookupInfo> c
   return cost;
 }
 
+std::vector<std::string> const* BaseOptions::coveringAttributes(LookupInfo const& info) const {
+  if (!info.coveringComputed) {
+    info.coveringComputed = true;
+    info.coveringAttributes.clear();
+
+    // without conditionNeedUpdate the expression compares _from / _to with
+    // the vertex, which is injected only when the edge is evaluated
+    if (info.expression == nullptr || !info.conditionNeedUpdate ||
+        !info.expression->isDeterministic() || info.idxHandles.empty() ||
+        info.idxHandles[0].getIndex() == nullptr) {
+      return nullptr;
+    }
+
+    std::vector<std::string> fields;
+    for (auto const& field : info.idxHandles[0].getIndex()->fields()) {
+      if (field.size() != 1 || field[0].shouldExpand) {
+        // only whole top-level attributes can be rebuilt from index values
+        return nullptr;
+      }
+      fields.emplace_back(field[0].name);
+    }
+
+    std::unordered_set<std::string> attributes;
+    if (!aql::Ast::getReferencedAttributes(info.expression->node(), _tmpVar, attributes)) {
+      // the whole edge is used
+      return nullptr;
+    }
+    for (auto const& it : attributes) {
+      if (std::find(fields.begin(), fields.end(), it) == fields.end()) {
+        return nullptr;
+      }
+    }
+    info.coveringAttributes = std::move(fields);
+  }
+
+  if (info.coveringAttributes.empty()) {
+    return nullptr;
+  }
+  return &info.coveringAttributes;
+}
+
+bool BaseOptions::evaluateCoveringExpression(aql::Expression* expression,
+                                             VPackSlice partialEdge) const {
+  return evaluateExpression(expression, partialEdge);
+}
+
 EdgeCursor* BaseOptions::nextCursorLocal(arangodb::velocypack::StringRef vid,
                                          std::vector<LookupInfo> const& list) {
   auto allCursor = std::make_unique<SingleServerEdgeCursor>(this, list.size());
@@ -424,6 +473,7 @@ EdgeCursor* BaseOptions::nextCursorLocal(arangodb::velocypack::StringRef vid,
       csrs.emplace_back(new OperationCursor(_trx->indexScanForCondition(it, node, _tmpVar, opts)));
     }
     opCursors.emplace_back(std::move(csrs));
+    allCursor->addCoveringFilter(info.expression, coveringAttributes(info));
   }
   return allCursor.release();
 }
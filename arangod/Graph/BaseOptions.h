@@ -63,6 +63,9 @@ struct BaseOptions {
     bool conditionNeedUpdate;
     // Position of _from / _to in the index search condition
     size_t conditionMemberToUpdate;
+    // Edge attributes of the index, see BaseOptions::coveringAttributes()
+    mutable std::vector<std::string> coveringAttributes;
+    mutable bool coveringComputed;
 
     LookupInfo();
     ~LookupInfo();
@@ -131,6 +134,17 @@ struct BaseOptions {
   void activateCache(bool enableDocumentCache,
                      std::unordered_map<ServerID, traverser::TraverserEngineID> const* engines);
 
+  /// @brief the top-level edge attributes of the index of the lookup, in
+  /// index order, if its expression reads no other attribute of the edge.
+  /// The expression can then be evaluated on the index values before the
+  /// edge document is read. nullptr if not
+  std::vector<std::string> const* coveringAttributes(LookupInfo const&) const;
+
+  /// @brief evaluate the expression of a lookup on an edge built from the
+  /// index values, see coveringAttributes()
+  bool evaluateCoveringExpression(aql::Expression*,
+                                  arangodb::velocypack::Slice partialEdge) const;
+
  protected:
   double costForLookupInfoList(std::vector<LookupInfo> const& list, size_t& createItems) const;
 
@@ -33,6 +33,8 @@
 #include <velocypack/Slice.h>
 #include <velocypack/velocypack-aliases.h>
 
+#include <algorithm>
+
 using namespace arangodb;
 using namespace arangodb::graph;
 using namespace arangodb::traverser;
@@ -52,7 +54,8 @@ BreadthFirstEnumerator::BreadthFirstEnumerator(Traverser* traverser, VPackSlice
       _schreierIndex(0),
       _lastReturned(0),
       _currentDepth(0),
-      _toSearchPos(0) {
+      _toSearchPos(0),
+      _prefetchedUpTo(0) {
   _schreier.reserve(32);
   arangodb::velocypack::StringRef startVId =
       _opts->cache()->persistString(arangodb::velocypack::StringRef(startVertex));
@@ -107,6 +110,10 @@ bool BreadthFirstEnumerator::next() {
     // If not it should have bailed out before.
     TRI_ASSERT(_toSearchPos < _toSearch.size());
 
+    if (_toSearchPos >= _prefetchedUpTo && _opts->supportsFrontierCursor()) {
+      prefetchEdges();
+    }
+
     _tmpEdges.clear();
     auto const nextIdx = _toSearch[_toSearchPos++].sourceIdx;
     auto const nextVertex = _schreier[nextIdx]->vertex;
@@ -291,6 +298,7 @@ bool BreadthFirstEnumerator::prepareSearchOnNextDepth() {
   // and next is empty.
   _toSearch.clear();
   _toSearchPos = 0;
+  _prefetchedUpTo = 0;
   _toSearch.swap(_nextDepth);
   _currentDepth++;
   TRI_ASSERT(_toSearchPos < _toSearch.size());
@@ -299,6 +307,38 @@ bool BreadthFirstEnumerator::prepareSearchOnNextDepth() {
   return true;
 }
 
+void BreadthFirstEnumerator::prefetchEdges() {
+  // maximum number of vertices whose edges are requested at once
+  size_t const batchSize = 1000;
+
+  size_t const end = (std::min)(_toSearchPos + batchSize, _toSearch.size());
+  _prefetchedUpTo = end;
+  if (end - _toSearchPos <= 1) {
+    // a single vertex is fetched by its cursor just as well
+    return;
+  }
+
+  std::vector<arangodb::velocypack::StringRef> vertices;
+  vertices.reserve(end - _toSearchPos);
+  for (size_t i = _toSearchPos; i < end; ++i) {
+    vertices.emplace_back(_schreier[_toSearch[i].sourceIdx]->vertex);
+  }
+  // duplicates are possible without global vertex uniqueness
+  std::sort(vertices.begin(), vertices.end(),
+            [](arangodb::velocypack::StringRef const& lhs,
+               arangodb::velocypack::StringRef const& rhs) {
+              return lhs.compare(rhs) < 0;
+            });
+  vertices.erase(std::unique(vertices.begin(), vertices.end(),
+                             [](arangodb::velocypack::StringRef const& lhs,
+                                arangodb::velocypack::StringRef const& rhs) {
+                               return lhs.compare(rhs) == 0;
+                             }),
+                 vertices.end());
+
+  incHttpRequests(_opts->prefetchEdges(vertices, _currentDepth));
+}
+
 bool BreadthFirstEnumerator::shouldPrune() {
   if (_opts->usesPrune()) {
     // evaluator->evaluate() might access these, so they have to live long enough.
@@ -123,6 +123,13 @@ class BreadthFirstEnumerator final : public arangodb::traverser::PathEnumerator
 
   size_t _toSearchPos;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief position in _toSearch up to which the edges have been prefetched
+  ///        (coordinator only).
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t _prefetchedUpTo;
+
  public:
   BreadthFirstEnumerator(arangodb::traverser::Traverser* traverser,
                          arangodb::velocypack::Slice startVertex,
@@ -179,6 +186,13 @@ class BreadthFirstEnumerator final : public arangodb::traverser::PathEnumerator
    *        Also honors pruned paths
    * @return true if we can continue searching. False if we are done
    */
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief fetch the edges of the next vertices in _toSearch with one
+  ///        request per DB server, instead of one per vertex.
+  //////////////////////////////////////////////////////////////////////////////
+
+  void prefetchEdges();
+
   bool prepareSearchOnNextDepth();
 
   aql::AqlValue vertexToAqlValue(size_t index);
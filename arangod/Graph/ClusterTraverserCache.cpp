@@ -25,6 +25,7 @@
 #include "Aql/AqlValue.h"
 #include "Aql/Query.h"
 #include "Basics/VelocyPackHelper.h"
+#include "Cluster/ClusterMethods.h"
 #include "Cluster/ServerState.h"
 #include "Graph/EdgeDocumentToken.h"
 #include "Transaction/Methods.h"
@@ -40,7 +41,54 @@ using namespace arangodb::graph;
 
 ClusterTraverserCache::ClusterTraverserCache(
     aql::Query* query, std::unordered_map<ServerID, traverser::TraverserEngineID> const* engines)
-    : TraverserCache(query), _engines(engines) {}
+    : TraverserCache(query), _engines(engines), _prefetchedDepth(0) {}
+
+size_t ClusterTraverserCache::prefetchEdges(std::vector<arangodb::velocypack::StringRef> const& vertices,
+                                            uint64_t depth) {
+  TRI_ASSERT(ServerState::instance()->isCoordinator());
+  _prefetched.clear();
+  _prefetchedDepth = depth;
+
+  VPackBuilder ids;
+  ids.openArray();
+  for (auto const& v : vertices) {
+    ids.add(VPackValuePair(v.data(), v.length(), VPackValueType::String));
+  }
+  ids.close();
+
+  std::vector<std::vector<VPackSlice>> edges;
+  VPackBuilder builder;
+  int res = fetchGroupedEdgesFromEngines(_trx->vocbase().name(), _engines,
+                                         ids.slice(), depth, _cache, edges,
+                                         _datalake, builder, _filteredDocuments,
+                                         _insertedDocuments);
+  if (res != TRI_ERROR_NO_ERROR) {
+    // nothing prefetched. the cursors will fetch their edges one by one and
+    // report the error properly
+    _prefetched.clear();
+    return _engines->size();
+  }
+
+  TRI_ASSERT(edges.size() == vertices.size());
+  for (size_t i = 0; i < vertices.size(); ++i) {
+    _prefetched.emplace(vertices[i], std::move(edges[i]));
+  }
+  return _engines->size();
+}
+
+bool ClusterTraverserCache::prefetchedEdges(arangodb::velocypack::StringRef vertex,
+                                            uint64_t depth,
+                                            std::vector<VPackSlice>& result) const {
+  if (depth != _prefetchedDepth) {
+    return false;
+  }
+  auto it = _prefetched.find(vertex);
+  if (it == _prefetched.end()) {
+    return false;
+  }
+  result = it->second;
+  return true;
+}
 
 VPackSlice ClusterTraverserCache::lookupToken(EdgeDocumentToken const& token) {
   return VPackSlice(token.vpack());
@@ -91,12 +91,33 @@ class ClusterTraverserCache : public TraverserCache {
 
   size_t& filteredDocuments() { return _filteredDocuments; }
 
+  /// @brief fetch the edges of all given vertices on the given depth with a
+  /// single request per traverser engine, and keep them so that the edge
+  /// cursors for these vertices need no request of their own. replaces all
+  /// previously prefetched edges. returns the number of requests performed
+  size_t prefetchEdges(std::vector<arangodb::velocypack::StringRef> const& vertices,
+                       uint64_t depth);
+
+  /// @brief copy the prefetched edges of the vertex on the given depth into
+  /// result. returns false if they have not been prefetched
+  bool prefetchedEdges(arangodb::velocypack::StringRef vertex, uint64_t depth,
+                       std::vector<arangodb::velocypack::Slice>& result) const;
+
+  /// @brief forget all prefetched edges. must be called whenever the edge
+  /// conditions can change, e.g. for a new start vertex
+  void clearPrefetchedEdges() { _prefetched.clear(); }
+
  private:
   /// @brief link by _id into our data dump
   std::unordered_map<arangodb::velocypack::StringRef, arangodb::velocypack::Slice> _cache;
   /// @brief dump for our edge and vertex documents
   std::vector<std::shared_ptr<arangodb::velocypack::Builder>> _datalake;
   std::unordered_map<ServerID, traverser::TraverserEngineID> const* _engines;
+  /// @brief edges fetched by prefetchEdges(), by vertex. vertices must be
+  /// persisted strings, edges point into the datalake
+  std::unordered_map<arangodb::velocypack::StringRef, std::vector<arangodb::velocypack::Slice>> _prefetched;
+  /// @brief depth the edges in _prefetched were fetched for
+  uint64_t _prefetchedDepth;
 };
 
 }  // namespace graph
@@ -41,6 +41,12 @@
 using namespace arangodb;
 using namespace arangodb::graph;
 
+namespace {
+// maximum number of closure vertices whose edges are requested from the
+// DB servers at once
+size_t const frontierBatchSize = 1000;
+}
+
 ConstantWeightShortestPathFinder::PathSnippet::PathSnippet(arangodb::velocypack::StringRef& pred,
                                                            EdgeDocumentToken&& path)
     : _pred(pred), _path(std::move(path)) {}
@@ -102,6 +108,11 @@ bool ConstantWeightShortestPathFinder::expandClosure(Closure& sourceClosure,
                                                      Snippets& sourceSnippets,
                                                      Snippets& targetSnippets,
                                                      bool isBackward, arangodb::velocypack::StringRef& result) {
+  if (_options.supportsFrontierCursor()) {
+    return expandClosureBatched(sourceClosure, sourceSnippets, targetSnippets,
+                                isBackward, result);
+  }
+
   _nextClosure.clear();
   for (auto& v : sourceClosure) {
     _edges.clear();
@@ -134,6 +145,63 @@ bool ConstantWeightShortestPathFinder::expandClosure(Closure& sourceClosure,
   return false;
 }
 
+bool ConstantWeightShortestPathFinder::expandClosureBatched(
+    Closure& sourceClosure, Snippets& sourceSnippets, Snippets& targetSnippets,
+    bool isBackward, arangodb::velocypack::StringRef& result) {
+  _nextClosure.clear();
+  transaction::BuilderLeaser ids(_options.trx());
+
+  bool found = false;
+  size_t pos = 0;
+  while (pos < sourceClosure.size()) {
+    size_t const end = (std::min)(pos + ::frontierBatchSize, sourceClosure.size());
+    ids->clear();
+    ids->openArray();
+    for (; pos < end; ++pos) {
+      auto const& v = sourceClosure[pos];
+      ids->add(VPackValuePair(v.data(), v.length(), VPackValueType::String));
+    }
+    ids->close();
+
+    std::unique_ptr<EdgeCursor> cursor(_options.nextFrontierCursor(ids->slice(), isBackward));
+    cursor->readAll([&](EdgeDocumentToken&& eid, VPackSlice edge, size_t) {
+      if (found) {
+        return;
+      }
+      // we do not know which closure vertex an edge was found for. but one
+      // of its ends is in the closure and thus known on this side, so the
+      // other end is the neighbor, unless it has been seen before as well
+      TRI_ASSERT(edge.isObject());
+      arangodb::velocypack::StringRef from(transaction::helpers::extractFromFromDocument(edge));
+      arangodb::velocypack::StringRef to(transaction::helpers::extractToFromDocument(edge));
+      auto fromIt = sourceSnippets.find(from);
+      auto toIt = sourceSnippets.find(to);
+      if ((fromIt == sourceSnippets.end()) == (toIt == sourceSnippets.end())) {
+        return;
+      }
+      arangodb::velocypack::StringRef pred =
+          (fromIt != sourceSnippets.end()) ? fromIt->first : toIt->first;
+      arangodb::velocypack::StringRef n =
+          _options.cache()->persistString((fromIt != sourceSnippets.end()) ? to : from);
+      sourceSnippets.emplace(n, new PathSnippet(pred, std::move(eid)));
+      if (targetSnippets.find(n) != targetSnippets.end()) {
+        result = n;
+        found = true;
+        return;
+      }
+      _nextClosure.emplace_back(n);
+    });
+
+    if (found) {
+      return true;
+    }
+  }
+
+  sourceClosure.swap(_nextClosure);
+  _nextClosure.clear();
+  return false;
+}
+
 void ConstantWeightShortestPathFinder::fillResult(arangodb::velocypack::StringRef& n,
                                                   arangodb::graph::ShortestPathResult& result) {
   result._vertices.emplace_back(n);
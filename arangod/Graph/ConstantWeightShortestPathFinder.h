@@ -70,6 +70,12 @@ class ConstantWeightShortestPathFinder : public ShortestPathFinder {
   bool expandClosure(Closure& sourceClosure, Snippets& sourceSnippets,
                      Snippets& targetSnippets, bool direction, arangodb::velocypack::StringRef& result);
 
+  /// @brief expandClosure() variant for coordinators, which fetches the
+  /// edges of many closure vertices with one request per DB server
+  bool expandClosureBatched(Closure& sourceClosure, Snippets& sourceSnippets,
+                            Snippets& targetSnippets, bool direction,
+                            arangodb::velocypack::StringRef& result);
+
   void fillResult(arangodb::velocypack::StringRef& n, arangodb::graph::ShortestPathResult& result);
 
  private:
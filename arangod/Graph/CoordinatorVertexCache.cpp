@@ -0,0 +1,143 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "CoordinatorVertexCache.h"
+
+#include "Cache/Cache.h"
+#include "Cache/CacheManagerFeature.h"
+#include "Cache/CachedValue.h"
+#include "Cache/Common.h"
+#include "Cache/Finding.h"
+#include "Cache/Manager.h"
+#include "Cluster/ClusterInfo.h"
+#include "Logger/Logger.h"
+#include "VocBase/LogicalCollection.h"
+
+#include <thread>
+
+using namespace arangodb;
+using namespace arangodb::graph;
+
+std::unique_ptr<CoordinatorVertexCache> CoordinatorVertexCache::INSTANCE;
+
+CoordinatorVertexCache::CoordinatorVertexCache(std::shared_ptr<cache::Cache> cache)
+    : _cache(std::move(cache)) {
+  TRI_ASSERT(_cache != nullptr);
+}
+
+CoordinatorVertexCache::~CoordinatorVertexCache() {
+  try {
+    if (CacheManagerFeature::MANAGER != nullptr) {
+      CacheManagerFeature::MANAGER->destroyCache(_cache);
+    }
+  } catch (...) {
+  }
+}
+
+void CoordinatorVertexCache::create(uint64_t maxSize) {
+  TRI_ASSERT(INSTANCE == nullptr);
+  if (maxSize == 0 || CacheManagerFeature::MANAGER == nullptr) {
+    return;
+  }
+  auto cache = CacheManagerFeature::MANAGER->createCache(cache::CacheType::Transactional,
+                                                         false, maxSize);
+  if (cache == nullptr) {
+    LOG_TOPIC("3e0a4", WARN, Logger::GRAPHS)
+        << "unable to create the coordinator vertex cache";
+    return;
+  }
+  INSTANCE.reset(new CoordinatorVertexCache(std::move(cache)));
+}
+
+void CoordinatorVertexCache::destroy() { INSTANCE.reset(); }
+
+bool CoordinatorVertexCache::collectionTick(std::string const& dbname,
+                                            std::string const& collection,
+                                            std::unordered_map<std::string, uint64_t> const& shardTicks,
+                                            uint64_t& tick) {
+  auto c = ClusterInfo::instance()->getCollectionNT(dbname, collection);
+  if (c == nullptr) {
+    return false;
+  }
+  // the ticks only grow, so their sum changes with every write
+  tick = 0;
+  for (auto const& it : *c->shardIds()) {
+    auto shard = shardTicks.find(it.first);
+    if (shard == shardTicks.end()) {
+      return false;
+    }
+    tick += shard->second;
+  }
+  return true;
+}
+
+std::string CoordinatorVertexCache::key(std::string const& dbname,
+                                        velocypack::StringRef id) {
+  std::string result;
+  result.reserve(dbname.size() + 1 + id.size());
+  result.append(dbname);
+  result.push_back('\0');
+  result.append(id.data(), id.size());
+  return result;
+}
+
+std::shared_ptr<velocypack::Buffer<uint8_t>> CoordinatorVertexCache::lookup(
+    std::string const& dbname, velocypack::StringRef id, uint64_t tick) {
+  std::string const k = key(dbname, id);
+  cache::Finding finding = _cache->find(k.data(), static_cast<uint32_t>(k.size()));
+  if (!finding.found()) {
+    return nullptr;
+  }
+  cache::CachedValue const* value = finding.value();
+  // value is the tick followed by the document
+  if (value->valueSize() <= sizeof(uint64_t)) {
+    return nullptr;
+  }
+  uint64_t cachedTick;
+  memcpy(&cachedTick, value->value(), sizeof(uint64_t));
+  if (cachedTick != tick) {
+    return nullptr;
+  }
+  auto result = std::make_shared<velocypack::Buffer<uint8_t>>();
+  result->append(value->value() + sizeof(uint64_t), value->valueSize() - sizeof(uint64_t));
+  return result;
+}
+
+void CoordinatorVertexCache::store(std::string const& dbname, velocypack::StringRef id,
+                                   uint64_t tick, velocypack::Slice document) {
+  std::string const k = key(dbname, id);
+  std::string v;
+  v.reserve(sizeof(uint64_t) + document.byteSize());
+  v.append(reinterpret_cast<char const*>(&tick), sizeof(uint64_t));
+  v.append(document.startAs<char>(), document.byteSize());
+
+  auto entry = cache::CachedValue::construct(k.data(), k.size(), v.data(), v.size());
+  if (entry == nullptr) {
+    return;
+  }
+  Result res = _cache->insert(entry);
+  if (res.is(TRI_ERROR_LOCK_TIMEOUT)) {
+    std::this_thread::yield();
+    res = _cache->insert(entry);
+  }
+  if (res.fail()) {
+    delete entry;
+  }
+}
@@ -0,0 +1,87 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_GRAPH_COORDINATOR_VERTEX_CACHE_H
+#define ARANGOD_GRAPH_COORDINATOR_VERTEX_CACHE_H 1
+
+#include "Basics/Common.h"
+
+#include <velocypack/Buffer.h>
+#include <velocypack/Slice.h>
+#include <velocypack/StringRef.h>
+
+namespace arangodb {
+namespace cache {
+class Cache;
+}
+
+namespace graph {
+
+/// @brief vertex documents fetched by traversals on a coordinator, shared
+/// by all read-only queries. every entry carries the write tick of its
+/// collection, the sum of the invalidation ticks of all its shards as read
+/// by the query that fetched it. an entry is only used by queries that read
+/// the same tick, so any write to the collection, through any coordinator,
+/// invalidates it.
+/// disabled unless --query.vertex-cache-size is set
+class CoordinatorVertexCache {
+ public:
+  explicit CoordinatorVertexCache(std::shared_ptr<cache::Cache> cache);
+  ~CoordinatorVertexCache();
+
+  CoordinatorVertexCache(CoordinatorVertexCache const&) = delete;
+  CoordinatorVertexCache& operator=(CoordinatorVertexCache const&) = delete;
+
+  /// @brief the cache, nullptr if it is disabled
+  static CoordinatorVertexCache* instance() { return INSTANCE.get(); }
+
+  /// @brief create the cache with the given maximum size, if the cache
+  /// manager is available
+  static void create(uint64_t maxSize);
+  static void destroy();
+
+  /// @brief the write tick of the collection, from the invalidation ticks of
+  /// the shards read by the query. returns false if a shard is missing
+  static bool collectionTick(std::string const& dbname, std::string const& collection,
+                             std::unordered_map<std::string, uint64_t> const& shardTicks,
+                             uint64_t& tick);
+
+  /// @brief the cached document of the vertex if it was fetched at the given
+  /// write tick of its collection, nullptr otherwise
+  std::shared_ptr<velocypack::Buffer<uint8_t>> lookup(std::string const& dbname,
+                                                      velocypack::StringRef id,
+                                                      uint64_t tick);
+
+  /// @brief remember a vertex document fetched at the given write tick
+  void store(std::string const& dbname, velocypack::StringRef id, uint64_t tick,
+             velocypack::Slice document);
+
+ private:
+  static std::string key(std::string const& dbname, velocypack::StringRef id);
+
+  static std::unique_ptr<CoordinatorVertexCache> INSTANCE;
+
+  std::shared_ptr<cache::Cache> _cache;
+};
+
+}  // namespace graph
+}  // namespace arangodb
+
+#endif
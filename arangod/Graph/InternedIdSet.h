@@ -0,0 +1,70 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_GRAPH_INTERNED_ID_SET_H
+#define ARANGOD_GRAPH_INTERNED_ID_SET_H 1
+
+#include "Basics/Common.h"
+
+#include <vector>
+
+namespace arangodb {
+namespace graph {
+
+/// @brief set of ids handed out by TraverserCache::internString(). as these
+/// ids are dense, the set is a bitset, which is a lot smaller and faster than
+/// a hash set of the id strings. it must be cleared whenever the cache is
+class InternedIdSet {
+ public:
+  InternedIdSet() = default;
+
+  bool contains(uint32_t id) const {
+    return id < _bits.size() && _bits[id];
+  }
+
+  /// @brief adds the id, returns false if it was already contained
+  bool insert(uint32_t id) {
+    if (id >= _bits.size()) {
+      _bits.resize((std::max)(static_cast<size_t>(id) + 1, _bits.size() * 2), false);
+    }
+    if (_bits[id]) {
+      return false;
+    }
+    _bits[id] = true;
+    return true;
+  }
+
+  void erase(uint32_t id) {
+    if (id < _bits.size()) {
+      _bits[id] = false;
+    }
+  }
+
+  /// @brief removes all ids, but keeps the allocated memory
+  void clear() { _bits.assign(_bits.size(), false); }
+
+ private:
+  std::vector<bool> _bits;
+};
+
+}  // namespace graph
+}  // namespace arangodb
+
+#endif
@@ -94,8 +94,12 @@ bool KShortestPathsFinder::computeShortestPath(VertexRef const& start, VertexRef
 void KShortestPathsFinder::computeNeighbourhoodOfVertexCache(VertexRef vertex,
                                                              Direction direction,
                                                              std::vector<Step>*& res) {
-  auto lookup = _vertexCache.emplace(vertex, FoundVertex(vertex)).first;
-  auto& cache = lookup->second;  // want to update the cached vertex in place
+  uint32_t id = _options.cache()->internString(vertex);
+  while (_vertexCache.size() <= id) {
+    _vertexCache.emplace_back(VertexRef());
+  }
+  auto& cache = _vertexCache[id];  // want to update the cached vertex in place
+  cache._vertex = _options.cache()->internedString(id);
 
   switch (direction) {
     case BACKWARD:
@@ -270,30 +274,52 @@ bool KShortestPathsFinder::computeNextShortestPath(Path& result) {
   auto& lastShortestPath = _shortestPaths.back();
   bool available = false;
 
-  for (size_t i = lastShortestPath._branchpoint; i + 1 < lastShortestPath.length(); ++i) {
-    auto& spur = lastShortestPath._vertices.at(i);
+  size_t const branchpoint = lastShortestPath._branchpoint;
 
-    forbiddenVertices.clear();
-    forbiddenEdges.clear();
+  // Must not use vertices on the prefix. The prefix grows by one vertex per
+  // spur, so the set is extended instead of being rebuilt for every spur.
+  for (size_t j = 0; j < branchpoint; ++j) {
+    forbiddenVertices.emplace(lastShortestPath._vertices[j]);
+  }
 
-    // Must not use vertices on the prefix
-    for (size_t j = 0; j < i; ++j) {
-      forbiddenVertices.emplace(lastShortestPath._vertices[j]);
+  // Indexes of the previous shortest paths that share the prefix up to the
+  // current spur with the last one. Every spur extends the prefix by one
+  // edge, so this list only shrinks and is filtered incrementally.
+  std::vector<size_t> samePrefix;
+  samePrefix.reserve(_shortestPaths.size());
+  for (size_t k = 0; k < _shortestPaths.size(); ++k) {
+    auto const& p = _shortestPaths[k];
+    bool eq = p._edges.size() >= branchpoint;
+    for (size_t e = 0; eq && e < branchpoint; ++e) {
+      eq = p._edges[e].equals(lastShortestPath._edges[e]);
+    }
+    if (eq) {
+      samePrefix.emplace_back(k);
     }
+  }
 
-    // TODO: This can be done more efficiently by storing shortest
-    //       paths in a prefix/postfix tree
-    // previous paths with same prefix must not be
-    for (auto const& p : _shortestPaths) {
-      bool eq = true;
-      for (size_t e = 0; e < i; ++e) {
-        if (!p._edges.at(e).equals(lastShortestPath._edges.at(e))) {
-          eq = false;
-          break;
-        }
-      }
-      if (eq && (i < p._edges.size())) {
-        forbiddenEdges.emplace(p._edges.at(i));
+  for (size_t i = branchpoint; i + 1 < lastShortestPath.length(); ++i) {
+    auto& spur = lastShortestPath._vertices.at(i);
+
+    if (i > branchpoint) {
+      forbiddenVertices.emplace(lastShortestPath._vertices[i - 1]);
+      Edge const& e = lastShortestPath._edges[i - 1];
+      samePrefix.erase(std::remove_if(samePrefix.begin(), samePrefix.end(),
+                                      [&](size_t k) {
+                                        auto const& p = _shortestPaths[k];
+                                        return p._edges.size() < i ||
+                                               !p._edges[i - 1].equals(e);
+                                      }),
+                       samePrefix.end());
+    }
+
+    // previous paths with same prefix must not be found again, so their
+    // edge leaving the spur is forbidden
+    forbiddenEdges.clear();
+    for (size_t k : samePrefix) {
+      auto const& p = _shortestPaths[k];
+      if (i < p._edges.size()) {
+        forbiddenEdges.emplace(p._edges[i]);
       }
     }
 
@@ -303,12 +329,22 @@ bool KShortestPathsFinder::computeNextShortestPath(Path& result) {
       candidate.append(tmpPath, 0, tmpPath.length() - 1);
       candidate._branchpoint = i;
 
-      auto it = find_if(_candidatePaths.begin(), _candidatePaths.end(),
-                        [candidate](Path const& v) {
-                          return v._weight >= candidate._weight;
-                        });
-      if (it == _candidatePaths.end() || !(*it == candidate)) {
-        _candidatePaths.emplace(it, candidate);
+      auto it = std::find_if(_candidatePaths.begin(), _candidatePaths.end(),
+                             [&candidate](Path const& v) {
+                               return v._weight >= candidate._weight;
+                             });
+      // the same candidate can be found from several spurs. it can only be
+      // a duplicate of a candidate with exactly the same weight
+      bool duplicate = false;
+      for (auto dup = it; dup != _candidatePaths.end() &&
+                          dup->_weight == candidate._weight; ++dup) {
+        if (*dup == candidate) {
+          duplicate = true;
+          break;
+        }
+      }
+      if (!duplicate) {
+        _candidatePaths.emplace(it, std::move(candidate));
       }
     }
   }
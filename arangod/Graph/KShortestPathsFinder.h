@@ -32,6 +32,7 @@
 
 #include <velocypack/StringRef.h>
 
+#include <deque>
 #include <list>
 
 namespace arangodb {
@@ -198,7 +199,9 @@ class KShortestPathsFinder : public ShortestPathFinder {
   // for a shortest path between start and end together with
   // the number of paths leading to that vertex and information
   // how to trace paths from the vertex from start/to end.
-  typedef std::unordered_map<VertexRef, FoundVertex> FoundVertexCache;
+  // Indexed by the id the vertex is interned under in the traverser cache;
+  // a deque so that references to entries survive growing it.
+  typedef std::deque<FoundVertex> FoundVertexCache;
 
  public:
   explicit KShortestPathsFinder(ShortestPathOptions& options);
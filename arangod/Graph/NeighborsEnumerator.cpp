@@ -29,18 +29,26 @@
 #include "Graph/Traverser.h"
 #include "Graph/TraverserCache.h"
 #include "Graph/TraverserOptions.h"
+#include "Transaction/Helpers.h"
+
+#include <algorithm>
 
 using namespace arangodb;
 using namespace arangodb::graph;
 using namespace arangodb::traverser;
 
+namespace {
+// maximum number of frontier vertices whose edges are requested from the
+// DB servers at once
+size_t const frontierBatchSize = 1000;
+}
+
 NeighborsEnumerator::NeighborsEnumerator(Traverser* traverser, VPackSlice const& startVertex,
                                          TraverserOptions* opts)
     : PathEnumerator(traverser, startVertex.copyString(), opts), _searchDepth(0) {
-  arangodb::velocypack::StringRef vId = _traverser->traverserCache()->persistString(
-      arangodb::velocypack::StringRef(startVertex));
+  uint32_t vId = _opts->cache()->internString(arangodb::velocypack::StringRef(startVertex));
   _allFound.insert(vId);
-  _currentDepth.insert(vId);
+  _currentDepth.emplace_back(vId);
   _iterator = _currentDepth.begin();
 }
 
@@ -48,7 +56,7 @@ bool NeighborsEnumerator::next() {
   if (_isFirst) {
     _isFirst = false;
     if (shouldPrune(*_iterator)) {
-      _toPrune.emplace(*_iterator);
+      _toPrune.emplace_back(*_iterator);
     }
     if (_opts->minDepth == 0) {
       return true;
@@ -64,54 +72,7 @@ bool NeighborsEnumerator::next() {
       }
 
       swapLastAndCurrentDepth();
-      for (auto const& nextVertex : _lastDepth) {
-        auto callback = [&](EdgeDocumentToken&& eid, VPackSlice other, size_t cursorId) {
-          if (_opts->hasEdgeFilter(_searchDepth, cursorId)) {
-            // execute edge filter
-            VPackSlice edge = other;
-            if (edge.isString()) {
-              edge = _opts->cache()->lookupToken(eid);
-            }
-            if (!_traverser->edgeMatchesConditions(edge, nextVertex, _searchDepth, cursorId)) {
-              // edge does not qualify
-              return;
-            }
-          }
-
-          // Counting should be done in readAll
-          arangodb::velocypack::StringRef v;
-          if (other.isString()) {
-            v = _opts->cache()->persistString(arangodb::velocypack::StringRef(other));
-          } else {
-            TRI_ASSERT(other.isObject());
-            VPackSlice tmp = transaction::helpers::extractFromFromDocument(other);
-            if (tmp.compareString(nextVertex.data(), nextVertex.length()) == 0) {
-              tmp = transaction::helpers::extractToFromDocument(other);
-            }
-            TRI_ASSERT(tmp.isString());
-            v = _opts->cache()->persistString(arangodb::velocypack::StringRef(tmp));
-          }
-
-          if (_allFound.find(v) == _allFound.end()) {
-            if (_traverser->vertexMatchesConditions(v, _searchDepth + 1)) {
-              _allFound.emplace(v);
-              if (shouldPrune(v)) {
-                _toPrune.emplace(v);
-              }
-              _currentDepth.emplace(v);
-            }
-          } else {
-            _opts->cache()->increaseFilterCounter();
-          }
-        };
-
-        std::unique_ptr<arangodb::graph::EdgeCursor> cursor(
-            _opts->nextCursor(nextVertex, _searchDepth));
-        if (cursor != nullptr) {
-          incHttpRequests(cursor->httpRequests());
-          cursor->readAll(callback);
-        }
-      }
+      expandFrontier();
       if (_currentDepth.empty()) {
         // Nothing found. Cannot do anything more.
         return false;
@@ -126,7 +87,7 @@ bool NeighborsEnumerator::next() {
 
 arangodb::aql::AqlValue NeighborsEnumerator::lastVertexToAqlValue() {
   TRI_ASSERT(_iterator != _currentDepth.end());
-  return _traverser->fetchVertexData(*_iterator);
+  return _traverser->fetchVertexData(_opts->cache()->internedString(*_iterator));
 }
 
 arangodb::aql::AqlValue NeighborsEnumerator::lastEdgeToAqlValue() {
@@ -143,24 +104,140 @@ arangodb::aql::AqlValue NeighborsEnumerator::pathToAqlValue(arangodb::velocypack
   THROW_ARANGO_EXCEPTION(TRI_ERROR_NOT_IMPLEMENTED);
 }
 
+void NeighborsEnumerator::expandFrontier() {
+  // work on the frontier in sorted order, so that consecutive edge index
+  // lookups hit adjacent keys
+  TraverserCache* cache = _opts->cache();
+  std::sort(_lastDepth.begin(), _lastDepth.end(), [cache](uint32_t lhs, uint32_t rhs) {
+    return cache->internedString(lhs).compare(cache->internedString(rhs)) < 0;
+  });
+
+  if (_opts->supportsFrontierCursor()) {
+    expandFrontierBatched();
+    return;
+  }
+
+  for (uint32_t nextId : _lastDepth) {
+    arangodb::velocypack::StringRef const nextVertex = cache->internedString(nextId);
+    auto callback = [&](EdgeDocumentToken&& eid, VPackSlice other, size_t cursorId) {
+      if (_opts->hasEdgeFilter(_searchDepth, cursorId)) {
+        // execute edge filter
+        VPackSlice edge = other;
+        if (edge.isString()) {
+          edge = _opts->cache()->lookupToken(eid);
+        }
+        if (!_traverser->edgeMatchesConditions(edge, nextVertex, _searchDepth, cursorId)) {
+          // edge does not qualify
+          return;
+        }
+      }
+
+      // Counting should be done in readAll
+      uint32_t v;
+      if (other.isString()) {
+        v = cache->internString(arangodb::velocypack::StringRef(other));
+      } else {
+        TRI_ASSERT(other.isObject());
+        VPackSlice tmp = transaction::helpers::extractFromFromDocument(other);
+        if (tmp.compareString(nextVertex.data(), nextVertex.length()) == 0) {
+          tmp = transaction::helpers::extractToFromDocument(other);
+        }
+        TRI_ASSERT(tmp.isString());
+        v = cache->internString(arangodb::velocypack::StringRef(tmp));
+      }
+
+      addNeighbor(v);
+    };
+
+    std::unique_ptr<arangodb::graph::EdgeCursor> cursor(
+        _opts->nextCursor(nextVertex, _searchDepth));
+    if (cursor != nullptr) {
+      incHttpRequests(cursor->httpRequests());
+      cursor->readAll(callback);
+    }
+  }
+}
+
+void NeighborsEnumerator::expandFrontierBatched() {
+  TraverserCache* cache = _opts->cache();
+  transaction::BuilderLeaser ids(_opts->trx());
+
+  size_t pos = 0;
+  while (pos < _lastDepth.size()) {
+    size_t const end = (std::min)(pos + ::frontierBatchSize, _lastDepth.size());
+    ids->clear();
+    ids->openArray();
+    for (; pos < end; ++pos) {
+      arangodb::velocypack::StringRef const v = cache->internedString(_lastDepth[pos]);
+      ids->add(VPackValuePair(v.data(), v.length(), VPackValueType::String));
+    }
+    ids->close();
+
+    std::unique_ptr<arangodb::graph::EdgeCursor> cursor(
+        _opts->nextFrontierCursor(ids->slice(), _searchDepth));
+    if (cursor == nullptr) {
+      continue;
+    }
+    incHttpRequests(cursor->httpRequests());
+    cursor->readAll([&](EdgeDocumentToken&&, VPackSlice edge, size_t) {
+      // the edge filters have already been applied by the DB servers, which
+      // know the vertex each edge was found for. here we only know that one
+      // end of the edge is in the frontier and thus already found, so the
+      // neighbor is the other end, if it is still unknown
+      TRI_ASSERT(edge.isObject());
+      uint32_t from = cache->internString(arangodb::velocypack::StringRef(
+          transaction::helpers::extractFromFromDocument(edge)));
+      uint32_t to = cache->internString(arangodb::velocypack::StringRef(
+          transaction::helpers::extractToFromDocument(edge)));
+      if (!_allFound.contains(from)) {
+        addNeighbor(from);
+      } else if (!_allFound.contains(to)) {
+        addNeighbor(to);
+      } else {
+        cache->increaseFilterCounter();
+      }
+    });
+  }
+}
+
+void NeighborsEnumerator::addNeighbor(uint32_t v) {
+  if (!_allFound.contains(v)) {
+    if (_traverser->vertexMatchesConditions(_opts->cache()->internedString(v),
+                                            _searchDepth + 1)) {
+      _allFound.insert(v);
+      if (shouldPrune(v)) {
+        _toPrune.emplace_back(v);
+      }
+      _currentDepth.emplace_back(v);
+    }
+  } else {
+    _opts->cache()->increaseFilterCounter();
+  }
+}
+
 void NeighborsEnumerator::swapLastAndCurrentDepth() {
   // Filter all in _toPrune
   if (!_toPrune.empty()) {
-    for (auto const& it : _toPrune) {
-      _currentDepth.erase(it);
-    }
+    std::sort(_toPrune.begin(), _toPrune.end());
+    _currentDepth.erase(std::remove_if(_currentDepth.begin(), _currentDepth.end(),
+                                       [this](uint32_t v) {
+                                         return std::binary_search(_toPrune.begin(),
+                                                                   _toPrune.end(), v);
+                                       }),
+                        _currentDepth.end());
     _toPrune.clear();
   }
   _lastDepth.swap(_currentDepth);
   _currentDepth.clear();
 }
 
-bool NeighborsEnumerator::shouldPrune(arangodb::velocypack::StringRef v) {
+bool NeighborsEnumerator::shouldPrune(uint32_t v) {
   // Prune here
   if (_opts->usesPrune()) {
     auto* evaluator = _opts->getPruneEvaluator();
     if (evaluator->needsVertex()) {
-      evaluator->injectVertex(_traverser->fetchVertexData(v).slice());
+      evaluator->injectVertex(
+          _traverser->fetchVertexData(_opts->cache()->internedString(v)).slice());
     }
     // We cannot support these two here
     TRI_ASSERT(!evaluator->needsEdge());
@@ -25,6 +25,7 @@
 #define ARANGODB_GRAPH_NEIGHBORSENUMERATOR_H 1
 
 #include "Basics/Common.h"
+#include "Graph/InternedIdSet.h"
 #include "Graph/PathEnumerator.h"
 
 #include <velocypack/Slice.h>
@@ -34,11 +35,14 @@ namespace graph {
 // @brief Enumerator optimized for neighbors. Does not allow edge access
 
 class NeighborsEnumerator final : public arangodb::traverser::PathEnumerator {
-  std::unordered_set<arangodb::velocypack::StringRef> _allFound;
-  std::unordered_set<arangodb::velocypack::StringRef> _currentDepth;
-  std::unordered_set<arangodb::velocypack::StringRef> _lastDepth;
-  std::unordered_set<arangodb::velocypack::StringRef>::iterator _iterator;
-  std::unordered_set<arangodb::velocypack::StringRef> _toPrune;
+  // all vertices are handled by the ids they are interned under in the
+  // traverser cache. the depth vectors never contain duplicates, as vertices
+  // are only added to them when first found
+  InternedIdSet _allFound;
+  std::vector<uint32_t> _currentDepth;
+  std::vector<uint32_t> _lastDepth;
+  std::vector<uint32_t>::const_iterator _iterator;
+  std::vector<uint32_t> _toPrune;
 
   uint64_t _searchDepth;
 
@@ -70,7 +74,19 @@ class NeighborsEnumerator final : public arangodb::traverser::PathEnumerator {
  private:
   void swapLastAndCurrentDepth();
 
-  bool shouldPrune(arangodb::velocypack::StringRef v);
+  /// @brief fetch the edges of all vertices in _lastDepth and collect their
+  /// unseen neighbors in _currentDepth. sorts _lastDepth
+  void expandFrontier();
+
+  /// @brief expandFrontier() variant that fetches the edges of many
+  /// vertices with one request per DB server
+  void expandFrontierBatched();
+
+  /// @brief record v as found on the next depth, unless it was seen before
+  /// or does not match the vertex conditions
+  void addNeighbor(uint32_t v);
+
+  bool shouldPrune(uint32_t v);
 };
 
 }  // namespace graph
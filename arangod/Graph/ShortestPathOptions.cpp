@@ -203,6 +203,12 @@ EdgeCursor* ShortestPathOptions::nextReverseCursorCoordinator(arangodb::velocypa
   return cursor.release();
 }
 
+EdgeCursor* ShortestPathOptions::nextFrontierCursor(VPackSlice vids, bool backward) {
+  TRI_ASSERT(_isCoordinator);
+  auto cursor = std::make_unique<ClusterEdgeCursor>(vids, backward, this);
+  return cursor.release();
+}
+
 void ShortestPathOptions::fetchVerticesCoordinator(
     std::deque<arangodb::velocypack::StringRef> const& vertexIds) {
   // TRI_ASSERT(arangodb::ServerState::instance()->isCoordinator());
@@ -95,6 +95,16 @@ struct ShortestPathOptions : public BaseOptions {
 
   EdgeCursor* nextReverseCursor(arangodb::velocypack::StringRef vid);
 
+  /// @brief whether the edges of a whole frontier of vertices can be fetched
+  /// with a single cursor, see nextFrontierCursor()
+  bool supportsFrontierCursor() const { return _isCoordinator; }
+
+  /// @brief cursor over the edges of all vertex ids in the array vids, in
+  /// forward or reverse direction. the edges arrive without their source
+  /// vertex. only supported on coordinators, where it saves one round-trip
+  /// to all DB servers per vertex
+  EdgeCursor* nextFrontierCursor(arangodb::velocypack::Slice vids, bool backward);
+
   void fetchVerticesCoordinator(std::deque<arangodb::velocypack::StringRef> const& vertexIds);
 
   void isQueryKilledCallback() const;
@@ -32,6 +32,8 @@
 #include "Utils/OperationCursor.h"
 #include "VocBase/LogicalCollection.h"
 
+#include <velocypack/Iterator.h>
+
 using namespace arangodb;
 using namespace arangodb::graph;
 
@@ -106,6 +108,44 @@ void SingleServerEdgeCursor::getDocAndRunCallback(OperationCursor* cursor, EdgeC
       });
 }
 
+void SingleServerEdgeCursor::addCoveringFilter(aql::Expression* expression,
+                                               std::vector<std::string> const* attributes) {
+  TRI_ASSERT(!_cursors.empty());
+  _coveringFilters.resize(_cursors.size(), CoveringFilter{nullptr, nullptr});
+  _coveringFilters.back() = CoveringFilter{expression, attributes};
+}
+
+SingleServerEdgeCursor::CoveringFilter const* SingleServerEdgeCursor::coveringFilter(
+    size_t cursorSet, OperationCursor* cursor) const {
+  if (cursorSet >= _coveringFilters.size()) {
+    return nullptr;
+  }
+  CoveringFilter const& filter = _coveringFilters[cursorSet];
+  if (filter.expression == nullptr || filter.attributes == nullptr ||
+      !cursor->hasCovering()) {
+    return nullptr;
+  }
+  return &filter;
+}
+
+bool SingleServerEdgeCursor::matchesCoveringFilter(CoveringFilter const& filter,
+                                                   VPackSlice values) {
+  TRI_ASSERT(values.isArray());
+  // the part of the edge the filter reads
+  _coveringEdge.clear();
+  _coveringEdge.openObject();
+  size_t i = 0;
+  for (VPackSlice value : VPackArrayIterator(values)) {
+    if (i >= filter.attributes->size()) {
+      break;
+    }
+    _coveringEdge.add((*filter.attributes)[i], value);
+    ++i;
+  }
+  _coveringEdge.close();
+  return _opts->evaluateCoveringExpression(filter.expression, _coveringEdge.slice());
+}
+
 bool SingleServerEdgeCursor::advanceCursor(OperationCursor*& cursor,
                                            std::vector<OperationCursor*>& cursorSet) {
   ++_currentSubCursor;
@@ -186,14 +226,26 @@ bool SingleServerEdgeCursor::next(EdgeCursor::Callback const& callback) {
         }
       } else {
         _cache.clear();
-        auto cb = [&](LocalDocumentId const& token) {
-          if (token.isSet()) {
-            // Document found
-            _cache.emplace_back(token);
-          }
-        };
-        bool tmp = cursor->next(cb, 1000);
-        TRI_ASSERT(tmp == cursor->hasMore());
+        CoveringFilter const* filter = coveringFilter(_currentCursor, cursor);
+        if (filter != nullptr) {
+          // only edges passing the filter are read later on
+          auto cb = [&](LocalDocumentId const& token, VPackSlice values) {
+            if (token.isSet() && matchesCoveringFilter(*filter, values)) {
+              _cache.emplace_back(token);
+            }
+          };
+          bool tmp = cursor->nextCovering(cb, 1000);
+          TRI_ASSERT(tmp == cursor->hasMore());
+        } else {
+          auto cb = [&](LocalDocumentId const& token) {
+            if (token.isSet()) {
+              // Document found
+              _cache.emplace_back(token);
+            }
+          };
+          bool tmp = cursor->next(cb, 1000);
+          TRI_ASSERT(tmp == cursor->hasMore());
+        }
       }
     }
   } while (_cache.empty());
@@ -247,7 +299,19 @@ void SingleServerEdgeCursor::readAll(EdgeCursor::Callback const& callback) {
             callback(EdgeDocumentToken(cid, token), edgeDoc, cursorId);
           });
         };
-        cursor->all(cb);
+        CoveringFilter const* filter = coveringFilter(_currentCursor, cursor);
+        if (filter != nullptr) {
+          // only edges passing the filter are read
+          auto coveringCb = [&](LocalDocumentId const& token, VPackSlice values) {
+            if (matchesCoveringFilter(*filter, values)) {
+              cb(token);
+            }
+          };
+          while (cursor->nextCovering(coveringCb, 1000)) {
+          }
+        } else {
+          cursor->all(cb);
+        }
       }
     }
   }
@@ -26,6 +26,8 @@
 
 #include "Basics/Common.h"
 #include "Graph/EdgeCursor.h"
+
+#include <velocypack/Builder.h>
 #include <velocypack/StringRef.h>
 
 namespace arangodb {
@@ -34,6 +36,10 @@ class LocalDocumentId;
 struct OperationCursor;
 class LogicalCollection;
 
+namespace aql {
+class Expression;
+}
+
 namespace transaction {
 class Methods;
 }
@@ -48,6 +54,13 @@ struct SingleServerEdgeDocumentToken;
 
 class SingleServerEdgeCursor final : public EdgeCursor {
  private:
+  /// @brief edge filter of a cursor set which can be evaluated on the index
+  /// values, see BaseOptions::coveringAttributes()
+  struct CoveringFilter {
+    aql::Expression* expression;
+    std::vector<std::string> const* attributes;
+  };
+
   BaseOptions* _opts;
   transaction::Methods* _trx;
   std::vector<std::vector<OperationCursor*>> _cursors;
@@ -56,6 +69,8 @@ class SingleServerEdgeCursor final : public EdgeCursor {
   std::vector<LocalDocumentId> _cache;
   size_t _cachePos;
   std::vector<size_t> const* _internalCursorMapping;
+  std::vector<CoveringFilter> _coveringFilters;
+  velocypack::Builder _coveringEdge;
 
  public:
   SingleServerEdgeCursor(BaseOptions* options, size_t,
@@ -68,6 +83,12 @@ class SingleServerEdgeCursor final : public EdgeCursor {
   void readAll(EdgeCursor::Callback const& callback) override;
 
   std::vector<std::vector<OperationCursor*>>& getCursors() { return _cursors; }
+
+  /// @brief set the filter of the cursor set added last. edges not matching
+  /// it are skipped before their documents are read, if the attributes are
+  /// not nullptr and the index supports covering
+  void addCoveringFilter(aql::Expression* expression,
+                         std::vector<std::string> const* attributes);
   
   /// @brief number of HTTP requests performed. always 0 in single server
   size_t httpRequests() const override { return 0; }
@@ -77,6 +98,13 @@ class SingleServerEdgeCursor final : public EdgeCursor {
   bool advanceCursor(OperationCursor*& cursor, std::vector<OperationCursor*>& cursorSet);
 
   void getDocAndRunCallback(OperationCursor*, EdgeCursor::Callback const& callback);
+
+  /// @brief the covering filter of a cursor set, nullptr if there is none
+  /// or the cursor cannot provide the index values
+  CoveringFilter const* coveringFilter(size_t cursorSet, OperationCursor* cursor) const;
+
+  /// @brief whether the edge with the given index values passes the filter
+  bool matchesCoveringFilter(CoveringFilter const& filter, velocypack::Slice values);
 };
 }  // namespace graph
 }  // namespace arangodb
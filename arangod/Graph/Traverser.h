@@ -31,6 +31,7 @@
 #include "Basics/hashes.h"
 #include "Graph/AttributeWeightShortestPathFinder.h"
 #include "Graph/ConstantWeightShortestPathFinder.h"
+#include "Graph/InternedIdSet.h"
 #include "Graph/PathEnumerator.h"
 #include "Graph/ShortestPathFinder.h"
 #include "Transaction/Helpers.h"
@@ -165,7 +166,8 @@ class Traverser {
     void reset(arangodb::velocypack::StringRef const&) override;
 
    private:
-    std::unordered_set<arangodb::velocypack::StringRef> _returnedVertices;
+    /// @brief the interned ids of all vertices returned so far
+    graph::InternedIdSet _returnedVertices;
   };
 
  public:
@@ -22,6 +22,7 @@
 
 #include "TraverserCache.h"
 
+#include "Basics/Exceptions.h"
 #include "Basics/StringHeap.h"
 #include "Basics/VelocyPackHelper.h"
 
@@ -56,6 +57,7 @@ TraverserCache::~TraverserCache() {}
 void TraverserCache::clear() {
   _stringHeap->clear();
   _persistedStrings.clear();
+  _internedStrings.clear();
   _mmdr->clear();
 }
 
@@ -133,12 +135,18 @@ aql::AqlValue TraverserCache::fetchVertexAqlResult(arangodb::velocypack::StringR
   return aql::AqlValue(lookupInCollection(idString));
 }
 
-arangodb::velocypack::StringRef TraverserCache::persistString(arangodb::velocypack::StringRef const idString) {
+uint32_t TraverserCache::internString(arangodb::velocypack::StringRef const idString) {
   auto it = _persistedStrings.find(idString);
   if (it != _persistedStrings.end()) {
-    return *it;
+    return it->second;
+  }
+  if (_internedStrings.size() >= UINT32_MAX) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_RESOURCE_LIMIT,
+                                   "too many distinct ids in traversal");
   }
   arangodb::velocypack::StringRef res = _stringHeap->registerString(idString.begin(), idString.length());
-  _persistedStrings.emplace(res);
-  return res;
+  uint32_t id = static_cast<uint32_t>(_internedStrings.size());
+  _internedStrings.emplace_back(res);
+  _persistedStrings.emplace(res, id);
+  return id;
 }
@@ -25,7 +25,7 @@
 
 #include "Basics/Common.h"
 #include <velocypack/StringRef.h>
-#include <unordered_set>
+#include <unordered_map>
 
 namespace arangodb {
 class ManagedDocumentResult;
@@ -103,7 +103,23 @@ class TraverserCache {
   /// @brief Persist the given id string. The return value is guaranteed to
   ///        stay valid as long as this cache is valid
   //////////////////////////////////////////////////////////////////////////////
-  arangodb::velocypack::StringRef persistString(arangodb::velocypack::StringRef const idString);
+  arangodb::velocypack::StringRef persistString(arangodb::velocypack::StringRef const idString) {
+    return _internedStrings[internString(idString)];
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Persist the given id string and return a dense integer id for it.
+  ///        Equal strings get the same id, ids are handed out from 0 upwards
+  ///        and stay valid until clear() is called. They allow visited sets
+  ///        to be kept as bitsets, see InternedIdSet
+  //////////////////////////////////////////////////////////////////////////////
+  uint32_t internString(arangodb::velocypack::StringRef const idString);
+
+  /// @brief the persisted string for an id returned by internString()
+  arangodb::velocypack::StringRef internedString(uint32_t id) const {
+    TRI_ASSERT(id < _internedStrings.size());
+    return _internedStrings[id];
+  }
 
   void increaseFilterCounter() { _filteredDocuments++; }
 
@@ -154,10 +170,15 @@ class TraverserCache {
   std::unique_ptr<arangodb::StringHeap> _stringHeap;
 
   //////////////////////////////////////////////////////////////////////////////
-  /// @brief Set of all strings persisted in the stringHeap. So we can save some
-  ///        memory by not storing them twice.
+  /// @brief All strings persisted in the stringHeap, mapped to their interned
+  ///        id. So we can save some memory by not storing them twice.
+  //////////////////////////////////////////////////////////////////////////////
+  std::unordered_map<arangodb::velocypack::StringRef, uint32_t> _persistedStrings;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief The persisted strings, indexed by their interned id
   //////////////////////////////////////////////////////////////////////////////
-  std::unordered_set<arangodb::velocypack::StringRef> _persistedStrings;
+  std::vector<arangodb::velocypack::StringRef> _internedStrings;
 };
 
 }  // namespace graph
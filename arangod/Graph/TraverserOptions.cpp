@@ -29,6 +29,7 @@
 #include "Aql/Query.h"
 #include "Basics/VelocyPackHelper.h"
 #include "Cluster/ClusterEdgeCursor.h"
+#include "Graph/ClusterTraverserCache.h"
 #include "Graph/SingleServerTraverser.h"
 #include "Indexes/Index.h"
 
@@ -513,6 +514,19 @@ EdgeCursor* TraverserOptions::nextCursorCoordinator(arangodb::velocypack::String
   return cursor.release();
 }
 
+EdgeCursor* TraverserOptions::nextFrontierCursor(VPackSlice vids, uint64_t depth) {
+  TRI_ASSERT(_isCoordinator);
+  TRI_ASSERT(_traverser != nullptr);
+  auto cursor = std::make_unique<ClusterEdgeCursor>(vids, depth, this);
+  return cursor.release();
+}
+
+size_t TraverserOptions::prefetchEdges(std::vector<arangodb::velocypack::StringRef> const& vertices,
+                                       uint64_t depth) {
+  TRI_ASSERT(_isCoordinator);
+  return static_cast<ClusterTraverserCache*>(cache())->prefetchEdges(vertices, depth);
+}
+
 void TraverserOptions::linkTraverser(ClusterTraverser* trav) {
   _traverser = trav;
 }
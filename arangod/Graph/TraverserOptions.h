@@ -123,6 +123,22 @@ struct TraverserOptions : public graph::BaseOptions {
 
   graph::EdgeCursor* nextCursor(arangodb::velocypack::StringRef vid, uint64_t);
 
+  /// @brief whether the edges of a whole frontier of vertices can be fetched
+  /// with a single cursor, see nextFrontierCursor()
+  bool supportsFrontierCursor() const { return _isCoordinator; }
+
+  /// @brief cursor over the edges of all vertex ids in the array vids. the
+  /// edges arrive already filtered, but without their source vertex, so
+  /// callers need to tell the two ends apart themselves. only supported on
+  /// coordinators, where it saves one round-trip to all DB servers per vertex
+  graph::EdgeCursor* nextFrontierCursor(arangodb::velocypack::Slice vids, uint64_t);
+
+  /// @brief fetch the edges of all given vertices on the given depth in one
+  /// go, so that nextCursor() can serve them without further requests. only
+  /// supported on coordinators. returns the number of requests performed
+  size_t prefetchEdges(std::vector<arangodb::velocypack::StringRef> const& vertices,
+                       uint64_t depth);
+
   void linkTraverser(arangodb::traverser::ClusterTraverser*);
 
   double estimateCost(size_t& nrItems) const override;
@@ -26,6 +26,8 @@
 #include "Aql/SortCondition.h"
 #include "VelocyPackHelper.h"
 
+#include <boost/optional.hpp>
+
 #include "search/sort.hpp"
 #include "utils/noncopyable.hpp"
 #include "utils/string.hpp"
@@ -316,8 +318,11 @@ class ScopedAqlValue : private irs::util::noncopyable {
     return true;
   }
 
-  aql::Range const* getRange() const {
-    return _node->isConstant() ? nullptr : _value.range();
+  boost::optional<aql::Range> getRange() const {
+    if (_node->isConstant()) {
+      return boost::none;
+    }
+    return _value.range();
   }
 
   size_t size() const {
@@ -46,6 +46,7 @@
 #include "IResearchAnalyzerFeature.h"
 #include "IResearchCommon.h"
 #include "Logger/LogMacros.h"
+#include "ProgramOptions/ProgramOptions.h"
 #include "RestHandler/RestVocbaseBaseHandler.h"
 #include "RestServer/DatabaseFeature.h"
 #include "RestServer/QueryRegistryFeature.h"
@@ -73,6 +74,12 @@ static char const ANALYZER_PREFIX_DELIM = ':'; // name prefix delimiter (2 chars
 static size_t const ANALYZER_PROPERTIES_SIZE_MAX = 1024 * 1024; // arbitrary value
 static size_t const DEFAULT_POOL_SIZE = 8;  // arbitrary value
 static std::string const FEATURE_NAME("IResearchAnalyzer");
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief inputs longer than this are analyzed without consulting the tokens
+///        cache, the cache targets short and frequently repeated query terms
+////////////////////////////////////////////////////////////////////////////////
+static size_t const TOKENS_CACHE_MAX_INPUT_SIZE = 256;
 static irs::string_ref const IDENTITY_ANALYZER_NAME("identity");
 static auto const RELOAD_INTERVAL = std::chrono::seconds(60); // arbitrary value
 
@@ -176,36 +183,18 @@ arangodb::aql::AqlValue aqlFnTokens(arangodb::aql::ExpressionContext* expression
     THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_BAD_PARAMETER, message);
   }
 
-  auto analyzer = pool->get();
-
-  if (!analyzer) {
-    auto const message = "failure to find arangosearch analyzer with name '"s
-      + static_cast<std::string>(name)
-      + "' while computing result for function 'TOKENS'";
-    LOG_TOPIC("d7477", WARN, arangodb::iresearch::TOPIC) << message;
-    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_BAD_PARAMETER, message);
-  }
+  std::shared_ptr<arangodb::iresearch::IResearchAnalyzerFeature::Tokens const> tokens;
+  auto res = analyzers->tokens(tokens, *pool, data);
 
-  if (!analyzer->reset(data)) {
-    auto const message = "failure to reset arangosearch analyzer: ' "s
-      + static_cast<std::string>(name)
-      + "' while computing result for function 'TOKENS'";
+  if (!res.ok()) {
+    auto const message = res.errorMessage()
+      + " while computing result for function 'TOKENS'";
 
     LOG_TOPIC("45a2d", WARN, arangodb::iresearch::TOPIC) << message;
-    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, message);
+    THROW_ARANGO_EXCEPTION_MESSAGE(res.errorNumber(), message);
   }
 
-  auto& values = analyzer->attributes().get<irs::term_attribute>();
-
-  if (!values) {
-    auto const message =
-        "failure to retrieve values from arangosearch analyzer name '"s
-        + static_cast<std::string>(name)
-        + "' while computing result for function 'TOKENS'";
-
-    LOG_TOPIC("f46f2", WARN, arangodb::iresearch::TOPIC) << message;
-    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, message);
-  }
+  TRI_ASSERT(tokens);
 
   // to avoid copying Builder's default buffer when initializing AqlValue
   // create the buffer externally and pass ownership directly into AqlValue
@@ -223,9 +212,7 @@ arangodb::aql::AqlValue aqlFnTokens(arangodb::aql::ExpressionContext* expression
 
   builder.openArray();
 
-  while (analyzer->next()) {
-    auto value = irs::ref_cast<char>(values->value());
-
+  for (auto& value: *tokens) {
     arangodb::iresearch::addStringRef(builder, value);
   }
 
@@ -746,6 +733,7 @@ irs::analysis::analyzer::ptr IResearchAnalyzerFeature::AnalyzerPool::get() const
 
 IResearchAnalyzerFeature::IResearchAnalyzerFeature(arangodb::application_features::ApplicationServer& server)
     : ApplicationFeature(server, IResearchAnalyzerFeature::name()) {
+  _tokensCache._limit = 4096; // enough for frequently repeated query terms
   setOptional(true);
   startsAfter("V8Phase");
   // used for registering IResearch analyzer functions
@@ -791,6 +779,18 @@ IResearchAnalyzerFeature::IResearchAnalyzerFeature(arangodb::application_feature
        );
 }
 
+void IResearchAnalyzerFeature::collectOptions( // collect options
+    std::shared_ptr<arangodb::options::ProgramOptions> options // options
+) {
+  ApplicationFeature::collectOptions(options);
+  options->addSection("arangosearch", "Configure the ArangoSearch feature");
+  options->addOption("--arangosearch.analyzer-cache-size",
+                     "maximum number of short inputs whose tokens are cached "
+                     "per analyzer configuration for use by 'TOKENS' and "
+                     "'PHRASE' (0 == disabled)",
+                     new arangodb::options::UInt64Parameter(&(_tokensCache._limit)));
+}
+
 arangodb::Result IResearchAnalyzerFeature::emplace( // emplace an analyzer
   EmplaceResult& result, // emplacement result on success (out-parameter)
   irs::string_ref const& name, // analyzer name
@@ -1878,6 +1878,101 @@ void IResearchAnalyzerFeature::stop() {
 
     _analyzers = getStaticAnalyzers();  // clear cache and reload static analyzers
   }
+
+  {
+    std::lock_guard<std::mutex> lock(_tokensCache._mutex);
+
+    _tokensCache._index.clear();
+    _tokensCache._entries.clear();
+  }
+}
+
+arangodb::Result IResearchAnalyzerFeature::tokens( // analyze data
+    std::shared_ptr<Tokens const>& result, // produced tokens (out-param)
+    AnalyzerPool const& pool, // analyzer to use
+    irs::string_ref const& data // data to analyze
+) {
+  auto const cacheable = // short inputs only
+    _tokensCache._limit && data.size() <= TOKENS_CACHE_MAX_INPUT_SIZE;
+  std::string key;
+
+  if (cacheable) {
+    // the tokens depend only on the analyzer configuration, not on the name
+    key.reserve(pool.type().size() + pool.properties().size() + data.size() + 2);
+    key.append(pool.type().c_str(), pool.type().size()).append(1, '\0');
+    key.append(pool.properties().c_str(), pool.properties().size()).append(1, '\0');
+    key.append(data.c_str(), data.size());
+
+    std::lock_guard<std::mutex> lock(_tokensCache._mutex);
+    auto itr = _tokensCache._index.find(irs::string_ref(key));
+
+    if (itr != _tokensCache._index.end()) {
+      _tokensCache._entries.splice( // mark as most recently used
+        _tokensCache._entries.begin(), _tokensCache._entries, itr->second // args
+      );
+      result = itr->second->second;
+      ++_tokensCache._hits;
+
+      return arangodb::Result();
+    }
+
+    ++_tokensCache._misses;
+  }
+
+  auto analyzer = pool.get();
+
+  if (!analyzer) {
+    return arangodb::Result( // result
+      TRI_ERROR_BAD_PARAMETER, // code
+      "failure to find arangosearch analyzer with name '"s + pool.name() + "'"
+    );
+  }
+
+  if (!analyzer->reset(data)) {
+    return arangodb::Result( // result
+      TRI_ERROR_INTERNAL, // code
+      "failure to reset arangosearch analyzer with name '"s + pool.name() + "'"
+    );
+  }
+
+  auto& values = analyzer->attributes().get<irs::term_attribute>();
+
+  if (!values) {
+    return arangodb::Result( // result
+      TRI_ERROR_INTERNAL, // code
+      "failure to retrieve values from arangosearch analyzer with name '"s + pool.name() + "'"
+    );
+  }
+
+  auto tokens = std::make_shared<Tokens>();
+
+  while (analyzer->next()) {
+    auto value = irs::ref_cast<char>(values->value());
+
+    tokens->emplace_back(value.c_str(), value.size());
+  }
+
+  result = std::move(tokens);
+
+  if (cacheable) {
+    std::lock_guard<std::mutex> lock(_tokensCache._mutex);
+
+    // the same input might have been cached concurrently
+    if (_tokensCache._index.find(irs::string_ref(key)) == _tokensCache._index.end()) {
+      _tokensCache._entries.emplace_front(std::move(key), result);
+      _tokensCache._index.emplace( // index by the key stored in the entry
+        irs::string_ref(_tokensCache._entries.front().first), // key
+        _tokensCache._entries.begin() // entry
+      );
+
+      while (_tokensCache._entries.size() > _tokensCache._limit) {
+        _tokensCache._index.erase(irs::string_ref(_tokensCache._entries.back().first));
+        _tokensCache._entries.pop_back(); // evict least recently used
+      }
+    }
+  }
+
+  return arangodb::Result();
 }
 
 arangodb::Result IResearchAnalyzerFeature::storeAnalyzer(AnalyzerPool& pool) {
@@ -24,6 +24,10 @@
 #ifndef ARANGOD_IRESEARCH__IRESEARCH_ANALYZER_FEATURE_H
 #define ARANGOD_IRESEARCH__IRESEARCH_ANALYZER_FEATURE_H 1
 
+#include <atomic>
+#include <list>
+#include <mutex>
+
 #include "analysis/analyzer.hpp"
 #include "utils/async_utils.hpp"
 #include "utils/hash_utils.hpp"
@@ -89,6 +93,11 @@ class IResearchAnalyzerFeature final : public arangodb::application_features::Ap
     void setKey(irs::string_ref const& type);
   };
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the terms produced by an analyzer for a single input
+  //////////////////////////////////////////////////////////////////////////////
+  typedef std::vector<std::string> Tokens;
+
   explicit IResearchAnalyzerFeature(arangodb::application_features::ApplicationServer& server);
 
   //////////////////////////////////////////////////////////////////////////////
@@ -184,6 +193,7 @@ class IResearchAnalyzerFeature final : public arangodb::application_features::Ap
     bool expandVocbasePrefix = true // use full vocbase name as prefix for active/system v.s. EMPTY/'::'
   );
 
+  void collectOptions(std::shared_ptr<options::ProgramOptions>) override;
   void prepare() override;
 
   //////////////////////////////////////////////////////////////////////////////
@@ -196,6 +206,25 @@ class IResearchAnalyzerFeature final : public arangodb::application_features::Ap
   void start() override;
   void stop() override;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief analyze 'data' with an analyzer instance of 'pool', the tokens of
+  ///        short inputs are served from an LRU cache indexed by the analyzer
+  ///        type, the analyzer properties and the input
+  /// @param result the tokens produced by the analyzer (out-param)
+  /// @return success
+  //////////////////////////////////////////////////////////////////////////////
+  arangodb::Result tokens( // analyze data
+    std::shared_ptr<Tokens const>& result, // produced tokens (out-param)
+    AnalyzerPool const& pool, // analyzer to use
+    irs::string_ref const& data // data to analyze
+  );
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @return number of tokens() invocations served from/missed in the cache
+  //////////////////////////////////////////////////////////////////////////////
+  size_t tokensCacheHits() const noexcept { return _tokensCache._hits.load(); }
+  size_t tokensCacheMisses() const noexcept { return _tokensCache._misses.load(); }
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief visit all analyzers for the specified vocbase
   /// @param vocbase only visit analysers for this vocbase (nullptr == static)
@@ -214,9 +243,24 @@ class IResearchAnalyzerFeature final : public arangodb::application_features::Ap
   // their associated metas
   typedef std::unordered_map<irs::hashed_string_ref, AnalyzerPool::ptr> Analyzers;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief LRU cache of tokens produced for recently analyzed inputs
+  //////////////////////////////////////////////////////////////////////////////
+  struct TokensCache {
+    typedef std::list<std::pair<std::string, std::shared_ptr<Tokens const>>> Entries;
+
+    Entries _entries; // cached tokens, most recently used first
+    std::atomic<size_t> _hits{ 0 }; // lookups served from the cache
+    std::unordered_map<irs::string_ref, Entries::iterator> _index; // keys reference '_entries'
+    uint64_t _limit; // maximum number of cached entries (0 == disabled)
+    std::atomic<size_t> _misses{ 0 }; // lookups of cacheable inputs missing in the cache
+    std::mutex _mutex; // for use with members '_entries', '_index'
+  };
+
   Analyzers _analyzers; // all analyzers known to this feature (including static) (names are stored with expanded vocbase prefixes)
   std::unordered_map<std::string, std::chrono::system_clock::time_point> _lastLoad; // last time a database was loaded
   mutable irs::async_utils::read_write_mutex _mutex; // for use with member '_analyzers', '_lastLoad'
+  TokensCache _tokensCache;
 
   static Analyzers const& getStaticAnalyzers();
 
@@ -329,8 +329,12 @@ Field& Field::operator=(Field&& rhs) {
 // ----------------------------------------------------------------------------
 
 FieldIterator::FieldIterator(arangodb::transaction::Methods& trx)
+    : FieldIterator(*trx.resolver()) {
+}
+
+FieldIterator::FieldIterator(arangodb::CollectionNameResolver const& resolver)
     : _nameBuffer(BufferPool.emplace().release()),  // FIXME don't use shared_ptr
-      _trx(&trx) {
+      _resolver(&resolver) {
   // initialize iterator's value
 }
 
@@ -439,7 +443,7 @@ bool FieldIterator::setStringValue(
     auto& buffer = valueBuffer();
 
     buffer = transaction::helpers::extractIdString( // extract id
-      _trx->resolver(), // resolver
+      _resolver, // resolver
       value, // value
       baseSlice // base slice
     );
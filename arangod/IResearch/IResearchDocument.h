@@ -51,6 +51,9 @@ class SortCondition;  // forward declaration
 }  // namespace arangodb
 
 namespace arangodb {
+
+class CollectionNameResolver;  // forward declaration
+
 namespace transaction {
 
 class Methods;  // forward declaration
@@ -127,6 +130,10 @@ class FieldIterator : public std::iterator<std::forward_iterator_tag, Field cons
  public:
   explicit FieldIterator(arangodb::transaction::Methods& trx);
 
+  /// @param resolver used for resolving '_id' attributes, must outlive
+  ///        the iterator
+  explicit FieldIterator(arangodb::CollectionNameResolver const& resolver);
+
   Field const& operator*() const noexcept { return _value; }
 
   FieldIterator& operator++() {
@@ -141,7 +148,7 @@ class FieldIterator : public std::iterator<std::forward_iterator_tag, Field cons
   bool valid() const noexcept { return !_stack.empty(); }
 
   bool operator==(FieldIterator const& rhs) const noexcept {
-    TRI_ASSERT(_trx == rhs._trx);  // compatibility
+    TRI_ASSERT(_resolver == rhs._resolver);  // compatibility
     return _stack == rhs._stack;
   }
 
@@ -223,7 +230,7 @@ class FieldIterator : public std::iterator<std::forward_iterator_tag, Field cons
   std::vector<Level> _stack;
   std::shared_ptr<std::string> _nameBuffer;  // buffer for field name
   std::shared_ptr<std::string> _valueBuffer;  // need temporary buffer for custom types in VelocyPack
-  arangodb::transaction::Methods* _trx;
+  arangodb::CollectionNameResolver const* _resolver;
   Field _value;  // iterator's value
 };               // FieldIterator
 
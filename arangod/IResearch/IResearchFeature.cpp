@@ -942,6 +942,10 @@ IResearchFeature::IResearchFeature(arangodb::application_features::ApplicationSe
     : ApplicationFeature(server, IResearchFeature::name()),
       _async(std::make_unique<Async>()),
       _running(false),
+      _asyncIndexing(false),
+      _asyncIndexingMaxLag(100000),
+      _consolidationMaxRate(0),
+      _consolidationSegmentsThreshold(0),
       _threads(0),
       _threadsLimit(0) {
   setOptional(true);
@@ -978,6 +982,26 @@ void IResearchFeature::collectOptions(std::shared_ptr<arangodb::options::Program
                      "upper limit to the autodetected number of threads to use "
                      "for asynchronous tasks (0 == use default)",
                      new arangodb::options::UInt64Parameter(&_threadsLimit));
+  options->addOption(std::string("--") + section + ".async-indexing",
+                     "index the documents of committed transactions by "
+                     "asynchronous tasks instead of within the transactions "
+                     "(queries using 'waitForSync' see all committed documents)",
+                     new arangodb::options::BooleanParameter(&_asyncIndexing));
+  options->addOption(std::string("--") + section + ".async-indexing-max-lag",
+                     "maximum number of queued document operations per link "
+                     "with asynchronous indexing, above the limit committing "
+                     "transactions index the queued operations themselves",
+                     new arangodb::options::UInt64Parameter(&_asyncIndexingMaxLag));
+  options->addOption(std::string("--") + section + ".consolidation-max-rate",
+                     "maximum number of bytes per second to consolidate per "
+                     "link, consolidations are postponed accordingly "
+                     "(0 == unlimited)",
+                     new arangodb::options::UInt64Parameter(&_consolidationMaxRate));
+  options->addOption(std::string("--") + section + ".consolidation-segments-threshold",
+                     "number of segments of a link after a commit which "
+                     "triggers a consolidation ahead of the consolidation "
+                     "interval (0 == disabled)",
+                     new arangodb::options::UInt64Parameter(&_consolidationSegmentsThreshold));
 }
 
 /*static*/ std::string const& IResearchFeature::name() { return FEATURE_NAME; }
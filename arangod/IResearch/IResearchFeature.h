@@ -67,6 +67,34 @@ class IResearchFeature final : public application_features::ApplicationFeature {
   //////////////////////////////////////////////////////////////////////////////
   void asyncNotify() const;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @return link updates of committed transactions are queued and handed
+  ///         over to the data stores by asynchronous tasks
+  //////////////////////////////////////////////////////////////////////////////
+  bool asyncIndexing() const noexcept { return _asyncIndexing; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @return maximum number of queued link updates per link, committing
+  ///         transactions index the queued updates themselves above the limit
+  //////////////////////////////////////////////////////////////////////////////
+  size_t asyncIndexingMaxLag() const noexcept {
+    return static_cast<size_t>(_asyncIndexingMaxLag);
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @return maximum number of bytes per second consolidated per link
+  ///         (0 == unlimited)
+  //////////////////////////////////////////////////////////////////////////////
+  uint64_t consolidationMaxRate() const noexcept { return _consolidationMaxRate; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @return number of segments of a link after a commit that triggers a
+  ///         consolidation ahead of the consolidation interval (0 == disabled)
+  //////////////////////////////////////////////////////////////////////////////
+  size_t consolidationSegmentsThreshold() const noexcept {
+    return static_cast<size_t>(_consolidationSegmentsThreshold);
+  }
+
   void beginShutdown() override;
   void collectOptions(std::shared_ptr<options::ProgramOptions>) override;
   static std::string const& name();
@@ -91,6 +119,10 @@ class IResearchFeature final : public application_features::ApplicationFeature {
 
   std::shared_ptr<Async> _async;  // object managing async jobs (never null!!!)
   std::atomic<bool> _running;
+  bool _asyncIndexing;
+  uint64_t _asyncIndexingMaxLag;
+  uint64_t _consolidationMaxRate;
+  uint64_t _consolidationSegmentsThreshold;
   uint64_t _threads;
   uint64_t _threadsLimit;
 };
@@ -110,19 +110,25 @@ arangodb::Result logMalformedNode(arangodb::aql::AstNodeType type) {
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief appends value tokens to a phrase filter
 ////////////////////////////////////////////////////////////////////////////////
-void appendTerms(irs::by_phrase& filter, irs::string_ref const& value,
-                 irs::analysis::analyzer& stream, size_t firstOffset) {
-  // reset stream
-  stream.reset(value);
+arangodb::Result appendTerms(irs::by_phrase& filter, irs::string_ref const& value,
+                             IResearchAnalyzerFeature& analyzers,
+                             IResearchAnalyzerFeature::AnalyzerPool const& pool,
+                             size_t firstOffset) {
+  // analyze value (served from the tokens cache for repeated query terms)
+  std::shared_ptr<IResearchAnalyzerFeature::Tokens const> tokens;
+  auto res = analyzers.tokens(tokens, pool, value);
 
-  // get token attribute
-  irs::term_attribute const& token = *stream.attributes().get<irs::term_attribute>();
+  if (!res.ok()) {
+    return res;
+  }
 
   // add tokens
-  while (stream.next()) {
-    filter.push_back(token.value(), firstOffset);
+  for (auto& token: *tokens) {
+    filter.push_back(irs::string_ref(token), firstOffset);
     firstOffset = 0;
   }
+
+  return {};
 }
 
 FORCE_INLINE void appendExpression(irs::boolean_filter& filter,
@@ -895,7 +901,7 @@ arangodb::Result fromIn(irs::boolean_filter* filter, QueryContext const& ctx,
     }
 
     // range
-    auto const* range = value.getRange();
+    auto const range = value.getRange();
     if (!range) {
       return {TRI_ERROR_BAD_PARAMETER, "no valid range"};
     }
@@ -955,7 +961,7 @@ arangodb::Result fromIn(irs::boolean_filter* filter, QueryContext const& ctx,
     }
     case arangodb::iresearch::SCOPED_VALUE_TYPE_RANGE: {
       // range
-      auto const* range = value.getRange();
+      auto const range = value.getRange();
 
       if (!range) {
         return {TRI_ERROR_BAD_PARAMETER, "no valid range"};
@@ -1626,7 +1632,7 @@ arangodb::Result fromFuncPhrase(irs::boolean_filter* filter, QueryContext const&
   }
 
   irs::by_phrase* phrase = nullptr;
-  irs::analysis::analyzer::ptr analyzer;
+  IResearchAnalyzerFeature* analyzers = nullptr;
 
   if (filter) {
     std::string name;
@@ -1638,10 +1644,11 @@ arangodb::Result fromFuncPhrase(irs::boolean_filter* filter, QueryContext const&
     }
 
     TRI_ASSERT(analyzerPool._pool);
-    analyzer = analyzerPool._pool->get();  // get analyzer from pool
+    analyzers = // feature providing the tokens
+      arangodb::application_features::ApplicationServer::lookupFeature<IResearchAnalyzerFeature>();
 
-    if (!analyzer) {
-      auto message = "'PHRASE' AQL function: Unable to instantiate analyzer '"s + analyzerPool._pool->name() + "'";
+    if (!analyzers) {
+      auto message = "'PHRASE' AQL function: '"s + IResearchAnalyzerFeature::name() + "' feature is not registered, unable to instantiate analyzer '" + analyzerPool._pool->name() + "'";
       LOG_TOPIC("4d142", WARN, arangodb::iresearch::TOPIC) << message;
       return {TRI_ERROR_INTERNAL, message};
     }
@@ -1652,8 +1659,13 @@ arangodb::Result fromFuncPhrase(irs::boolean_filter* filter, QueryContext const&
     phrase->field(std::move(name));
     phrase->boost(filterCtx.boost);
 
-    TRI_ASSERT(analyzer);
-    appendTerms(*phrase, value, *analyzer, 0);
+    auto res = appendTerms(*phrase, value, *analyzers, *analyzerPool._pool, 0);
+
+    if (!res.ok()) {
+      auto message = "'PHRASE' AQL function: "s + res.errorMessage();
+      LOG_TOPIC("9b3f6", WARN, arangodb::iresearch::TOPIC) << message;
+      return {res.errorNumber(), message};
+    }
   }
 
   decltype(fieldArg) offsetArg = nullptr;
@@ -1702,8 +1714,14 @@ arangodb::Result fromFuncPhrase(irs::boolean_filter* filter, QueryContext const&
     }
 
     if (phrase) {
-      TRI_ASSERT(analyzer);
-      appendTerms(*phrase, value, *analyzer, offset);
+      TRI_ASSERT(analyzers);
+      auto res = appendTerms(*phrase, value, *analyzers, *analyzerPool._pool, offset);
+
+      if (!res.ok()) {
+        auto message = "'PHRASE' AQL function: "s + res.errorMessage();
+        LOG_TOPIC("6e0a8", WARN, arangodb::iresearch::TOPIC) << message;
+        return {res.errorNumber(), message};
+      }
     }
   }
 
@@ -44,12 +44,51 @@
 #include "StorageEngine/StorageEngine.h"
 #include "StorageEngine/TransactionState.h"
 #include "Transaction/Methods.h"
+#include "Utils/CollectionNameResolver.h"
 #include "VocBase/LogicalCollection.h"
 
 #include "IResearchLink.h"
 
+#include <limits>
+
+namespace arangodb {
+namespace iresearch {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief document operations of a transaction in the order of invocation
+////////////////////////////////////////////////////////////////////////////////
+struct IResearchLink::IndexingBatch {
+  static constexpr size_t REMOVAL = std::numeric_limits<size_t>::max();
+
+  struct Operation {
+    LocalDocumentId _documentId;
+    size_t _offset; // offset of the document body in '_documents' (REMOVAL == removal)
+  };
+
+  void insert(LocalDocumentId const& documentId, velocypack::Slice const& doc) {
+    _operations.emplace_back(Operation{documentId, _documents.size()});
+    _documents.append(doc.start(), doc.byteSize());
+  }
+
+  void remove(LocalDocumentId const& documentId) {
+    _operations.emplace_back(Operation{documentId, REMOVAL});
+  }
+
+  velocypack::Buffer<uint8_t> _documents; // copies of the inserted document bodies
+  std::vector<Operation> _operations;
+};
+
+} // iresearch
+} // arangodb
+
 namespace {
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the interval of the asynchronous indexing task in case
+///        notifications about new committed transactions were missed
+////////////////////////////////////////////////////////////////////////////////
+size_t const ASYNC_INDEXING_INTERVAL_MSEC = 100;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief the suffix appened to the index_meta filename to generate the
 ///        backup filename to be used for renaming
@@ -77,6 +116,7 @@ struct LinkTrxState final : public arangodb::TransactionState::Cookie {
   irs::index_writer::documents_context _ctx;
   std::unique_lock<ReadMutex> _linkLock;  // prevent data-store deallocation (lock @ AsyncSelf)
   arangodb::iresearch::PrimaryKeyFilterContainer _removals;  // list of document removals
+  std::unique_ptr<arangodb::iresearch::IResearchLink::IndexingBatch> _batch;  // operations to index after commit (asynchronous indexing only)
 
   LinkTrxState(std::unique_lock<ReadMutex>&& linkLock, irs::index_writer& writer) noexcept
       : _ctx(writer.documents()), _linkLock(std::move(linkLock)) {
@@ -106,10 +146,16 @@ struct LinkTrxState final : public arangodb::TransactionState::Cookie {
   operator irs::index_writer::documents_context&() noexcept { return _ctx; }
 
   void remove(arangodb::LocalDocumentId const& value) {
+    if (_batch) {
+      _batch->remove(value);
+      return;
+    }
+
     _ctx.remove(_removals.emplace(value));
   }
 
   void reset() noexcept {
+    _batch.reset();
     _removals.clear();
     _ctx.reset();
   }
@@ -219,6 +265,35 @@ inline arangodb::Result insertDocument(irs::index_writer::documents_context& ctx
     }
   }
 
+  // Stored values
+  {
+    struct StoredField {
+      irs::string_ref name() const noexcept {
+        return *column;
+      }
+
+      bool write(irs::data_output& out) const {
+        out.write_bytes(slice.start(), slice.byteSize());
+        return true;
+      }
+
+      std::string const* column;
+      VPackSlice slice;
+    } field; // StoredField
+
+    auto& fields = meta._storedValues.fields();
+    auto& columns = meta._storedValues.columns();
+
+    for (size_t i = 0, size = fields.size(); i < size; ++i) {
+      field.column = &columns[i];
+      field.slice = document.get(fields[i]);
+      if (field.slice.isNone()) {
+        field.slice = VPackSlice::nullSlice();
+      }
+      doc.insert<irs::Action::STORE>(field);
+    }
+  }
+
   // System fields
 
   // Indexed and Stored: LocalDocumentId
@@ -251,6 +326,7 @@ IResearchLink::IResearchLink( // constructor
 ): _asyncFeature(nullptr),
    _asyncSelf(irs::memory::make_unique<AsyncLinkPtr::element_type>(nullptr)), // mark as data store not initialized
    _asyncTerminate(false),
+   _consolidationRequested(false),
    _collection(collection),
    _id(iid) {
   auto* key = this;
@@ -270,7 +346,7 @@ IResearchLink::IResearchLink( // constructor
     auto prev = state->cookie(key, nullptr);  // get existing cookie
     auto rollback = arangodb::transaction::Status::COMMITTED != status;
 
-    if (rollback && prev) {
+    if (prev) {
 // TODO FIXME find a better way to look up a ViewState
 #ifdef ARANGODB_ENABLE_MAINTAINER_MODE
       auto& ctx = dynamic_cast<LinkTrxState&>(*prev);
@@ -278,7 +354,24 @@ IResearchLink::IResearchLink( // constructor
       auto& ctx = static_cast<LinkTrxState&>(*prev);
 #endif
 
-      ctx.reset();
+      if (rollback) {
+        ctx.reset();
+      } else if (ctx._batch && !ctx._batch->_operations.empty()) {
+        try {
+          key->enqueue(std::move(ctx._batch)); // '_asyncSelf' locked by 'ctx'
+        } catch (std::exception const& e) {
+          LOG_TOPIC("e4b1d", ERR, arangodb::iresearch::TOPIC)
+              << "caught exception while queueing document operations of "
+                 "arangosearch link '" << key->id() << "', tid '" << state->id()
+              << "': " << e.what();
+          IR_LOG_EXCEPTION();
+        } catch (...) {
+          LOG_TOPIC("9a0e3", WARN, arangodb::iresearch::TOPIC)
+              << "caught exception while queueing document operations of "
+                 "arangosearch link '" << key->id() << "', tid '" << state->id() << "'";
+          IR_LOG_EXCEPTION();
+        }
+      }
     }
 
     prev.reset();
@@ -318,6 +411,15 @@ void IResearchLink::afterTruncate() {
 
   TRI_ASSERT(_dataStore);  // must be valid if _asyncSelf->get() is valid
 
+  // operations queued before the truncation are obsolete
+  std::lock_guard<std::mutex> applyLock(_indexingQueue._applyMutex);
+
+  {
+    std::lock_guard<std::mutex> lock(_indexingQueue._mutex);
+    _indexingQueue._batches.clear();
+    _indexingQueue._size.store(0);
+  }
+
   try {
     _dataStore._writer->clear();
     _dataStore._reader = _dataStore._reader.reopen();
@@ -335,6 +437,12 @@ void IResearchLink::afterTruncate() {
   }
 }
 
+bool IResearchLink::asyncIndexing() const noexcept {
+  return _asyncFeature // tasks registered
+    && _asyncFeature->asyncIndexing() // enabled
+    && RecoveryState::DONE == _dataStore._recovery; // recovery is done synchronously
+}
+
 void IResearchLink::batchInsert( // insert documents
     arangodb::transaction::Methods& trx, // transaction
     std::vector<std::pair<arangodb::LocalDocumentId, arangodb::velocypack::Slice>> const& batch, // documents
@@ -514,12 +622,28 @@ arangodb::Result IResearchLink::commitUnsafe() {
   // NOTE: assumes that '_asyncSelf' is read-locked (for use with async tasks)
   TRI_ASSERT(_dataStore); // must be valid if _asyncSelf->get() is valid
 
+  // the 'Flush' marker written below must cover all committed transactions
+  auto res = indexQueuedUnsafe();
+
+  if (!res.ok()) {
+    LOG_TOPIC("c1f07", WARN, arangodb::iresearch::TOPIC)
+      << "error while indexing queued document operations before commit of arangosearch link '" << id() << "': " << res.errorNumber() << " " << res.errorMessage();
+  }
+
   try {
+    auto const start = std::chrono::steady_clock::now();
+
     _dataStore._writer->commit();
 
     SCOPED_LOCK(_readerMutex);
     auto reader = _dataStore._reader.reopen(); // update reader
 
+    _stats._commitTimeMsec.store( // remember duration of the commit
+      std::chrono::duration_cast<std::chrono::milliseconds>( // msec
+        std::chrono::steady_clock::now() - start // duration
+      ).count()
+    );
+
     if (!reader) {
       // nothing more to do
       LOG_TOPIC("37bcf", WARN, arangodb::iresearch::TOPIC)
@@ -586,6 +710,7 @@ arangodb::Result IResearchLink::commitUnsafe() {
     }
 
     _dataStore._reader = reader; // update reader
+    _stats._segments.store(reader.size());
     arangodb::aql::QueryCache::instance()->invalidate(
       &(_collection.vocbase()), _viewGuid
     );
@@ -628,8 +753,21 @@ arangodb::Result IResearchLink::consolidateUnsafe( // consolidate segments
   // NOTE: assumes that '_asyncSelf' is read-locked (for use with async tasks)
   TRI_ASSERT(_dataStore); // must be valid if _asyncSelf->get() is valid
 
+  size_t consolidatedBytes = 0;
+  auto accountingPolicy = [&policy, &consolidatedBytes]( // wrap policy
+      std::set<irs::segment_meta const*>& candidates, // candidates
+      irs::index_meta const& meta, // index meta
+      irs::index_writer::consolidating_segments_t const& consolidating // segments
+  )->void {
+    policy.policy()(candidates, meta, consolidating);
+
+    for (auto* segment: candidates) {
+      consolidatedBytes += segment->size; // account segments selected by policy
+    }
+  };
+
   try {
-    if (!_dataStore._writer->consolidate(policy.policy(), nullptr, progress)) {
+    if (!_dataStore._writer->consolidate(accountingPolicy, nullptr, progress)) {
       return arangodb::Result( // result
         TRI_ERROR_INTERNAL, // code
         std::string("failure while executing consolidation policy '") + policy.properties().toString() + "' on arangosearch link '" + std::to_string(id()) + "' run id '" + std::to_string(size_t(&runId)) + "'"
@@ -647,6 +785,8 @@ arangodb::Result IResearchLink::consolidateUnsafe( // consolidate segments
     );
   }
 
+  _stats._consolidatedBytes.fetch_add(consolidatedBytes);
+
   return arangodb::Result();
 }
 
@@ -724,10 +864,117 @@ arangodb::Result IResearchLink::drop() {
   return arangodb::Result();
 }
 
+void IResearchLink::enqueue(std::unique_ptr<IndexingBatch>&& batch) {
+  // NOTE: assumes that '_asyncSelf' is read-locked (by the transaction state)
+  TRI_ASSERT(batch);
+  TRI_ASSERT(_asyncFeature);
+  auto const count = batch->_operations.size();
+  size_t size;
+
+  {
+    std::lock_guard<std::mutex> lock(_indexingQueue._mutex);
+    _indexingQueue._batches.emplace_back(std::move(batch));
+    size = _indexingQueue._size += count;
+  }
+
+  if (size > _asyncFeature->asyncIndexingMaxLag()) {
+    // bound the lag by indexing in the committing thread
+    auto res = indexQueuedUnsafe();
+
+    if (!res.ok()) {
+      LOG_TOPIC("0b7ea", WARN, arangodb::iresearch::TOPIC)
+        << "error while indexing queued document operations of arangosearch link '" << id() << "': " << res.errorNumber() << " " << res.errorMessage();
+    }
+  } else if (size == count) {
+    _asyncFeature->asyncNotify(); // the queue was empty, wake up the indexing task
+  }
+}
+
 bool IResearchLink::hasSelectivityEstimate() const {
   return false; // selectivity can only be determined per query since multiple fields are indexed
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @note assumes that '_asyncSelf' is read-locked (for use with async tasks)
+////////////////////////////////////////////////////////////////////////////////
+arangodb::Result IResearchLink::indexQueuedUnsafe() {
+  // NOTE: assumes that '_asyncSelf' is read-locked (for use with async tasks)
+  TRI_ASSERT(_dataStore); // must be valid if _asyncSelf->get() is valid
+
+  std::lock_guard<std::mutex> applyLock(_indexingQueue._applyMutex);
+  std::vector<std::unique_ptr<IndexingBatch>> batches;
+
+  {
+    std::lock_guard<std::mutex> lock(_indexingQueue._mutex);
+    batches.swap(_indexingQueue._batches);
+  }
+
+  if (batches.empty()) {
+    return arangodb::Result(); // nothing to do
+  }
+
+  size_t count = 0;
+
+  for (auto& batch : batches) {
+    count += batch->_operations.size();
+  }
+
+  auto decrement = irs::make_finally([this, count]()->void {
+    _indexingQueue._size -= count;
+  });
+  arangodb::Result result;
+  PrimaryKeyFilterContainer removals; // must outlive 'ctx'
+  auto ctx = _dataStore._writer->documents();
+
+  try {
+    CollectionNameResolver resolver(_collection.vocbase());
+    FieldIterator body(resolver);
+
+    for (auto& batch : batches) {
+      for (auto& operation : batch->_operations) {
+        if (IndexingBatch::REMOVAL == operation._offset) {
+          ctx.remove(removals.emplace(operation._documentId));
+          continue;
+        }
+
+        auto res = insertDocument( // insert document
+          ctx, // documents context
+          body, // field iterator
+          velocypack::Slice(batch->_documents.data() + operation._offset), // document body
+          operation._documentId, // document id
+          _meta, // link meta
+          id() // link id
+        );
+
+        if (!res.ok()) {
+          result = std::move(res); // report the last failure, continue with other documents
+        }
+      }
+    }
+
+    if (!removals.empty()) {
+      // hold references even after the context is released
+      ctx.remove(irs::filter::make<PrimaryKeyFilterContainer>(std::move(removals)));
+    }
+  } catch (std::exception const& e) {
+    ctx.reset(); // drop partially applied operations
+
+    return arangodb::Result( // result
+      TRI_ERROR_INTERNAL, // code
+      std::string("caught exception while indexing queued document operations of arangosearch link '") + std::to_string(id()) + "': " + e.what()
+    );
+  } catch (...) {
+    ctx.reset(); // drop partially applied operations
+
+    return arangodb::Result( // result
+      TRI_ERROR_INTERNAL, // code
+      std::string("caught exception while indexing queued document operations of arangosearch link '") + std::to_string(id()) + "'"
+    );
+  }
+
+  return result;
+}
+
 arangodb::Result IResearchLink::init(
     arangodb::velocypack::Slice const& definition,
     InitCallback const& initCallback /* = { }*/ ) {
@@ -1190,6 +1437,13 @@ arangodb::Result IResearchLink::initDataStore(InitCallback const& initCallback,
   _dataStore._meta._writebufferIdle = options.segment_pool_size;
   _dataStore._meta._writebufferSizeMax = options.segment_memory_max;
 
+  // operations queued for a previous data store are obsolete
+  {
+    std::lock_guard<std::mutex> lock(_indexingQueue._mutex);
+    _indexingQueue._batches.clear();
+    _indexingQueue._size.store(0);
+  }
+
   _asyncSelf = irs::memory::make_unique<AsyncLinkPtr::element_type>(this); // create a new 'self' (previous was reset during unload() above)
   _asyncTerminate.store(false); // allow new asynchronous job invocation
   _flushCallback = IResearchFeature::walFlushCallback(*this);
@@ -1253,8 +1507,20 @@ arangodb::Result IResearchLink::initDataStore(InitCallback const& initCallback,
         if (!res.ok()) {
           LOG_TOPIC("8377b", WARN, arangodb::iresearch::TOPIC)
             << "error while committing arangosearch link '" << id() << "': " << res.errorNumber() << " " <<  res.errorMessage();
-        } else if (state._cleanupIntervalStep // if enabled
-                   && state._cleanupIntervalCount++ > state._cleanupIntervalStep) {
+
+          return true; // reschedule
+        }
+
+        auto const segmentsThreshold = _asyncFeature->consolidationSegmentsThreshold();
+
+        if (segmentsThreshold // if enabled
+            && _stats._segments.load() >= segmentsThreshold // too many segments
+            && !_consolidationRequested.exchange(true)) { // not yet requested
+          _asyncFeature->asyncNotify(); // wake up the consolidation task ahead of its interval
+        }
+
+        if (state._cleanupIntervalStep // if enabled
+            && state._cleanupIntervalCount++ > state._cleanupIntervalStep) {
           state._cleanupIntervalCount = 0; // reset counter
           res = cleanupUnsafe(); // run cleanup ('_asyncSelf' locked by async task)
 
@@ -1268,7 +1534,34 @@ arangodb::Result IResearchLink::initDataStore(InitCallback const& initCallback,
       }
     );
 
+    if (_asyncFeature->asyncIndexing()) {
+      _asyncFeature->async( // register asynchronous indexing task
+        _asyncSelf, // mutex
+        [this](size_t& timeoutMsec, bool)->bool {
+          if (_asyncTerminate.load()) {
+            return false; // termination requested
+          }
+
+          timeoutMsec = ASYNC_INDEXING_INTERVAL_MSEC;
+
+          if (!_indexingQueue._size.load()) {
+            return true; // reschedule, nothing to index
+          }
+
+          auto res = indexQueuedUnsafe(); // run indexing ('_asyncSelf' locked by async task)
+
+          if (!res.ok()) {
+            LOG_TOPIC("5e3d2", WARN, arangodb::iresearch::TOPIC)
+              << "error while indexing queued document operations of arangosearch link '" << id() << "': " << res.errorNumber() << " " <<  res.errorMessage();
+          }
+
+          return true; // reschedule
+        }
+      );
+    }
+
     struct ConsolidateState: public CommitState {
+      std::chrono::system_clock::time_point _next; // earliest start time due to rate limit
       irs::merge_writer::flush_progress_t _progress;
     } consolidateState;
 
@@ -1302,21 +1595,42 @@ arangodb::Result IResearchLink::initDataStore(InitCallback const& initCallback,
           return true; // reschedule
         }
 
+        auto now = std::chrono::system_clock::now();
+
+        if (now < state._next) {
+          timeoutMsec = std::chrono::duration_cast<std::chrono::milliseconds>( // msec
+            state._next - now // remaining msec of the rate limit
+          ).count() + 1;
+
+          return true; // reschedule (consolidation rate limit exceeded)
+        }
+
         size_t usedMsec = std::chrono::duration_cast<std::chrono::milliseconds>(
-          std::chrono::system_clock::now() - state._last
+          now - state._last
         ).count();
 
-        if (usedMsec < state._consolidationIntervalMsec) {
+        if (usedMsec < state._consolidationIntervalMsec
+            && !_consolidationRequested.exchange(false)) { // not requested by commit
           timeoutMsec = state._consolidationIntervalMsec - usedMsec; // still need to sleep
 
           return true; // reschedule (with possibly updated '_consolidationIntervalMsec')
         }
 
-        state._last = std::chrono::system_clock::now(); // remember last task start time
+        _consolidationRequested.store(false); // request satisfied by this run
+        state._last = now; // remember last task start time
         timeoutMsec = state._consolidationIntervalMsec;
 
+        auto const consolidatedBytes = _stats._consolidatedBytes.load();
         auto res = // consolidate
           consolidateUnsafe(state._consolidationPolicy, state._progress); // run consolidation ('_asyncSelf' locked by async task)
+        auto const maxRate = _asyncFeature->consolidationMaxRate();
+
+        if (maxRate) { // postpone the next run until written bytes fit into the rate
+          auto const bytes = _stats._consolidatedBytes.load() - consolidatedBytes;
+
+          state._next = std::chrono::system_clock::now() // throttled start time
+            + std::chrono::milliseconds(bytes * 1000 / maxRate);
+        }
 
         if (!res.ok()) {
           LOG_TOPIC("bce4f", WARN, arangodb::iresearch::TOPIC)
@@ -1451,9 +1765,12 @@ arangodb::Result IResearchLink::insert( // insert document
 
     TRI_ASSERT(_dataStore); // must be valid if _asyncSelf->get() is valid
 
+    bool const async = asyncIndexing();
+
     // optimization for single-document insert-only transactions
     if (trx.isSingleOperationTransaction() // only for single-docuemnt transactions
-        && RecoveryState::DONE == _dataStore._recovery) {
+        && RecoveryState::DONE == _dataStore._recovery
+        && !async) {
       auto ctx = _dataStore._writer->documents();
 
       return insertImpl(ctx);
@@ -1462,6 +1779,10 @@ arangodb::Result IResearchLink::insert( // insert document
     auto ptr = irs::memory::make_unique<LinkTrxState>(std::move(lock),
                                                       *(_dataStore._writer));
 
+    if (async) {
+      ptr->_batch = irs::memory::make_unique<IndexingBatch>();
+    }
+
     ctx = ptr.get();
     state.cookie(key, std::move(ptr));
 
@@ -1486,6 +1807,21 @@ arangodb::Result IResearchLink::insert( // insert document
   // below only during recovery after the 'checkpoint' marker, or post recovery
   // ...........................................................................
 
+  if (ctx->_batch) {
+    // analyzed and indexed by an asynchronous task after the commit
+    try {
+      ctx->_batch->insert(documentId, doc);
+    } catch (std::exception const& e) {
+      return arangodb::Result(TRI_ERROR_INTERNAL,
+                              std::string("caught exception while queueing "
+                                          "document for arangosearch link '") +
+                                  std::to_string(id()) + "', revision '" +
+                                  std::to_string(documentId.id()) + "': " + e.what());
+    }
+
+    return arangodb::Result();
+  }
+
   return insertImpl(ctx->_ctx);
 }
 
@@ -1493,6 +1829,20 @@ bool IResearchLink::isHidden() const {
   return !arangodb::ServerState::instance()->isDBServer(); // hide links unless we are on a DBServer
 }
 
+void IResearchLink::toVelocyPackStats( // append statistics
+    arangodb::velocypack::Builder& builder // output builder
+) const {
+  TRI_ASSERT(builder.isOpenObject());
+  builder.add("indexingLag", arangodb::velocypack::Value(indexingLag()));
+  builder.add("segments", arangodb::velocypack::Value(_stats._segments.load()));
+  builder.add( // duration of the last commit
+    "commitTimeMsec", arangodb::velocypack::Value(_stats._commitTimeMsec.load())
+  );
+  builder.add( // total size of consolidated segments
+    "consolidatedBytes", arangodb::velocypack::Value(_stats._consolidatedBytes.load())
+  );
+}
+
 bool IResearchLink::isSorted() const {
   return false; // IResearch does not provide a fixed default sort order
 }
@@ -1650,6 +2000,10 @@ arangodb::Result IResearchLink::remove( // remove document
       std::move(lock), *(_dataStore._writer)
     );
 
+    if (asyncIndexing()) {
+      ptr->_batch = irs::memory::make_unique<IndexingBatch>();
+    }
+
     ctx = ptr.get();
     state.cookie(key, std::move(ptr));
 
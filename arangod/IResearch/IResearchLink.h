@@ -35,6 +35,9 @@
 #include "Indexes/Index.h"
 #include "Transaction/Status.h"
 
+#include <atomic>
+#include <mutex>
+
 namespace arangodb {
 namespace iresearch {
 
@@ -179,6 +182,25 @@ class IResearchLink {
     arangodb::Index::OperationMode mode // operation mode
   ); // arangodb::Index override
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief document operations of a committed transaction awaiting
+  ///        asynchronous indexing
+  //////////////////////////////////////////////////////////////////////////////
+  struct IndexingBatch;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @return number of document operations of committed transactions not yet
+  ///         handed over to the data store (0 unless asynchronous indexing)
+  //////////////////////////////////////////////////////////////////////////////
+  size_t indexingLag() const noexcept { return _indexingQueue._size.load(); }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief append data store statistics to the figures of the link:
+  ///        indexing lag, segment count, duration of the last commit and
+  ///        bytes consolidated so far
+  //////////////////////////////////////////////////////////////////////////////
+  void toVelocyPackStats(arangodb::velocypack::Builder& builder) const;
+
   ///////////////////////////////////////////////////////////////////////////////
   /// @brief 'this' for the lifetime of the link data-store
   ///        for use with asynchronous calls, e.g. callbacks, view
@@ -266,25 +288,65 @@ class IResearchLink {
     } 
   };
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief batches of committed transactions awaiting asynchronous indexing
+  //////////////////////////////////////////////////////////////////////////////
+  struct IndexingQueue {
+    std::mutex _applyMutex; // preserves the order of batches handed over to the data store
+    std::vector<std::unique_ptr<IndexingBatch>> _batches; // protected by '_mutex'
+    std::mutex _mutex; // for use with member '_batches'
+    std::atomic<size_t> _size{ 0 }; // number of queued document operations
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief statistics of the data store maintenance
+  //////////////////////////////////////////////////////////////////////////////
+  struct Stats {
+    std::atomic<size_t> _segments{ 0 }; // number of segments of the current snapshot
+    std::atomic<uint64_t> _commitTimeMsec{ 0 }; // duration of the last commit
+    std::atomic<uint64_t> _consolidatedBytes{ 0 }; // size of consolidated segments
+  };
+
   VPackComparer _comparer;
   IResearchFeature* _asyncFeature; // the feature where async jobs were registered (nullptr == no jobs registered)
   AsyncLinkPtr _asyncSelf; // 'this' for the lifetime of the link (for use with asynchronous calls)
   std::atomic<bool> _asyncTerminate; // trigger termination of long-running async jobs
+  std::atomic<bool> _consolidationRequested; // run consolidation ahead of the interval
   arangodb::LogicalCollection& _collection; // the linked collection
   DataStore _dataStore; // the iresearch data store, protected by _asyncSelf->mutex()
   std::function<arangodb::Result(arangodb::velocypack::Slice const&)> _flushCallback; // for writing 'Flush' marker during commit (guaranteed valid by init)
   TRI_idx_iid_t const _id; // the index identifier
+  IndexingQueue _indexingQueue; // operations of committed transactions (asynchronous indexing only)
   IResearchLinkMeta const _meta; // how this collection should be indexed (read-only, set via init())
   std::mutex _readerMutex; // prevents query cache double invalidation
+  Stats _stats; // data store maintenance statistics
   std::function<void(arangodb::transaction::Methods& trx, arangodb::transaction::Status status)> _trxCallback; // for insert(...)/remove(...)
   std::string const _viewGuid; // the identifier of the desired view (read-only, set via init())
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @return document operations of new transactions are indexed by an
+  ///         asynchronous task after the transactions are committed
+  //////////////////////////////////////////////////////////////////////////////
+  bool asyncIndexing() const noexcept;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief run filesystem cleanup on the data store
   /// @note assumes that '_asyncSelf' is read-locked (for use with async tasks)
   //////////////////////////////////////////////////////////////////////////////
   arangodb::Result cleanupUnsafe();
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief queue operations of a committed transaction for asynchronous
+  ///        indexing, index the queue right away if it exceeds the maximum lag
+  //////////////////////////////////////////////////////////////////////////////
+  void enqueue(std::unique_ptr<IndexingBatch>&& batch);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief hand over all queued operations to the data store
+  /// @note assumes that '_asyncSelf' is read-locked (for use with async tasks)
+  //////////////////////////////////////////////////////////////////////////////
+  arangodb::Result indexQueuedUnsafe();
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief mark the current data store state as the latest valid state
   /// @note assumes that '_asyncSelf' is read-locked (for use with async tasks)
@@ -276,7 +276,7 @@ arangodb::Result modifyLinks( // modify links
     //        arangodb::Index::Compare(...)
     //        hence must use 'isCreation=true' for normalize(...) to match
     auto res = arangodb::iresearch::IResearchLinkHelper::normalize( // normalize to validate analyzer definitions
-      normalized, link, true, view.vocbase(), &view.primarySort() // args
+      normalized, link, true, view.vocbase(), &view.primarySort(), &view.storedValues() // args
     );
 
     if (!res.ok()) {
@@ -653,7 +653,8 @@ namespace iresearch {
     arangodb::velocypack::Slice definition, // source definition
     bool isCreation, // definition for index creation
     TRI_vocbase_t const& vocbase, // index vocbase
-    IResearchViewSort const* primarySort /* = nullptr */
+    IResearchViewSort const* primarySort /* = nullptr */,
+    IResearchViewStoredValues const* storedValues /* = nullptr */
 ) {
   if (!normalized.isOpenObject()) {
     return arangodb::Result(
@@ -713,6 +714,11 @@ namespace iresearch {
     meta._sort = *primarySort;
   }
 
+  if (storedValues) {
+    // normalize stored values if specified
+    meta._storedValues = *storedValues;
+  }
+
   if (!meta.json(normalized, isCreation, nullptr, &vocbase)) { // 'isCreation' is set when forPersistence
     return arangodb::Result( // result
       TRI_ERROR_BAD_PARAMETER, // code
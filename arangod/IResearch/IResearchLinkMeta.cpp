@@ -89,7 +89,8 @@ IResearchLinkMeta::Mask::Mask(bool mask /*= false*/) noexcept
       _includeAllFields(mask),
       _trackListPositions(mask),
       _storeValues(mask),
-      _sort(mask) {
+      _sort(mask),
+      _storedValues(mask) {
 }
 
 IResearchLinkMeta::IResearchLinkMeta()
@@ -141,6 +142,10 @@ bool IResearchLinkMeta::operator==(IResearchLinkMeta const& other) const noexcep
     return false;  // values do not match
   }
 
+  if (_storedValues != other._storedValues) {
+    return false;  // values do not match
+  }
+
   return true;
 }
 
@@ -186,6 +191,20 @@ bool IResearchLinkMeta::init( // initialize meta
     }
   }
 
+  {
+    // optional stored values
+    static VPackStringRef const fieldName("storedValues");
+
+    auto const field = slice.get(fieldName);
+    mask->_storedValues = field.isArray();
+
+    if (readAnalyzerDefinition && mask->_storedValues) {
+      if (!_storedValues.fromVelocyPack(field, errorField)) {
+        return false;
+      }
+    }
+  }
+
   {
     // optional object list
     static const std::string fieldName("analyzerDefinitions");
@@ -554,6 +573,16 @@ bool IResearchLinkMeta::json( // append meta jSON
     }
   }
 
+  // omitted unless configured, stored values are an opt-in feature
+  if (writeAnalyzerDefinition && !_storedValues.empty()
+      && (!ignoreEqual || _storedValues != ignoreEqual->_storedValues)
+      && (!mask || mask->_storedValues)) {
+    velocypack::ArrayBuilder arrayScope(&builder, "storedValues");
+    if (!_storedValues.toVelocyPack(builder)) {
+      return false;
+    }
+  }
+
   std::map<std::string, IResearchAnalyzerFeature::AnalyzerPool::ptr> analyzers;
 
   if ((!ignoreEqual || !equalAnalyzers(_analyzers, ignoreEqual->_analyzers)) &&
@@ -712,6 +741,7 @@ size_t IResearchLinkMeta::memory() const noexcept {
   size += _analyzers.size() * sizeof(decltype(_analyzers)::value_type);
   size += _fields.size() * sizeof(decltype(_fields)::value_type);
   size += _sort.memory();
+  size += _storedValues.memory();
 
   for (auto& entry : _fields) {
     size += entry.key().size();
@@ -34,6 +34,7 @@
 #include "Containers.h"
 #include "IResearchAnalyzerFeature.h"
 #include "IResearchViewSort.h"
+#include "IResearchViewStoredValues.h"
 
 namespace arangodb {
 namespace velocypack {
@@ -84,6 +85,7 @@ struct IResearchLinkMeta {
     bool _trackListPositions;
     bool _storeValues;
     bool _sort;
+    bool _storedValues;
     explicit Mask(bool mask = false) noexcept;
   };
 
@@ -93,6 +95,7 @@ struct IResearchLinkMeta {
   typedef UnorderedRefKeyMap<char, UniqueHeapInstance<IResearchLinkMeta>> Fields;
 
   IResearchViewSort _sort; // sort condition associated with the link
+  IResearchViewStoredValues _storedValues; // stored values associated with the link
   Analyzers _analyzers;  // analyzers to apply to every field
   Fields _fields;  // explicit list of fields to be indexed with optional overrides
   bool _includeAllFields;    // include all fields or only fields listed in
@@ -162,6 +162,7 @@ void IResearchMMFilesLink::toVelocyPack( // generate definition
 
     figuresBuilder.openObject();
     toVelocyPackFigures(figuresBuilder);
+    toVelocyPackStats(figuresBuilder);
     figuresBuilder.close();
     builder.add("figures", figuresBuilder.slice());
   }
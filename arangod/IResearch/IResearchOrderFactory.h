@@ -97,6 +97,26 @@ struct Scorer {
   aql::AstNode const* node{};  // scorer node
 };                             // Scorer
 
+////////////////////////////////////////////////////////////////////////////////
+/// @struct ScoresLimit
+/// @brief if 'limit' is non-zero, only the best 'limit' documents according
+///        to the scorer at position 'scorer' have to be produced by a view,
+///        e.g. for 'SORT BM25(d) DESC LIMIT n'
+////////////////////////////////////////////////////////////////////////////////
+struct ScoresLimit {
+  bool operator==(ScoresLimit const& rhs) const noexcept {
+    return limit == rhs.limit && scorer == rhs.scorer && ascending == rhs.ascending;
+  }
+
+  bool operator!=(ScoresLimit const& rhs) const noexcept {
+    return !(*this == rhs);
+  }
+
+  size_t limit{0};
+  size_t scorer{0};
+  bool ascending{false};
+};  // ScoresLimit
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @class ScorerReplacer
 /// @brief utility class that replaces scorer function call with corresponding
@@ -64,6 +64,10 @@ class IResearchRocksDBRecoveryHelper final : public RocksDBRecoveryHelper {
 
   virtual void prepare() override;
 
+  // links of different collections are independent, and _recoveredIndexes
+  // only changes on IndexCreate markers
+  virtual bool parallelRecovery() const override { return true; }
+
   virtual void PutCF(uint32_t column_family_id, const rocksdb::Slice& key,
                      const rocksdb::Slice& value) override;
 
@@ -86,7 +90,6 @@ class IResearchRocksDBRecoveryHelper final : public RocksDBRecoveryHelper {
   std::set<IndexId> _recoveredIndexes;  // set of already recovered indexes
   DatabaseFeature* _dbFeature{};
   RocksDBEngine* _engine{};
-  uint32_t _documentCF{};
 };
 
 }  // end namespace iresearch
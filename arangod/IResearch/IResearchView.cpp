@@ -1047,6 +1047,7 @@ arangodb::Result IResearchView::updateProperties(arangodb::velocypack::Slice con
     meta._writebufferIdle = _meta._writebufferIdle;
     meta._writebufferSizeMax = _meta._writebufferSizeMax;
     meta._primarySort = _meta._primarySort;
+    meta._storedValues = _meta._storedValues;
 
     _meta = std::move(meta);
 
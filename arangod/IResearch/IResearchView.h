@@ -184,6 +184,14 @@ class IResearchView final: public arangodb::LogicalView {
     return _meta._primarySort;
   }
 
+  ///////////////////////////////////////////////////////////////////////////////
+  /// @return attributes which values are stored in a view in addition to being
+  ///         indexed, empty -> none
+  ///////////////////////////////////////////////////////////////////////////////
+  IResearchViewStoredValues const& storedValues() const noexcept {
+    return _meta._storedValues;
+  }
+
  protected:
 
   //////////////////////////////////////////////////////////////////////////////
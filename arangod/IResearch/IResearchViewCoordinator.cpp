@@ -379,6 +379,7 @@ arangodb::Result IResearchViewCoordinator::properties(velocypack::Slice const& s
 
     // reset non-updatable values to match current meta
     meta._locale = _meta._locale;
+    meta._storedValues = _meta._storedValues;
 
     // only trigger persisting of properties if they have changed
     if (_meta != meta) {
@@ -204,7 +204,8 @@ IResearchViewMeta::Mask::Mask(bool mask /*=false*/) noexcept
       _writebufferActive(mask),
       _writebufferIdle(mask),
       _writebufferSizeMax(mask),
-      _primarySort(mask) {
+      _primarySort(mask),
+      _storedValues(mask) {
 }
 
 IResearchViewMeta::IResearchViewMeta()
@@ -249,6 +250,7 @@ IResearchViewMeta& IResearchViewMeta::operator=(IResearchViewMeta&& other) noexc
     _writebufferIdle = std::move(other._writebufferIdle);
     _writebufferSizeMax = std::move(other._writebufferSizeMax);
     _primarySort = std::move(other._primarySort);
+    _storedValues = std::move(other._storedValues);
   }
 
   return *this;
@@ -266,6 +268,7 @@ IResearchViewMeta& IResearchViewMeta::operator=(IResearchViewMeta const& other)
     _writebufferIdle = other._writebufferIdle;
     _writebufferSizeMax = other._writebufferSizeMax;
     _primarySort = other._primarySort;
+    _storedValues = other._storedValues;
   }
 
   return *this;
@@ -318,6 +321,10 @@ bool IResearchViewMeta::operator==(IResearchViewMeta const& other) const noexcep
     return false;  // values do not match
   }
 
+  if (_storedValues != other._storedValues) {
+    return false;  // values do not match
+  }
+
   return true;
 }
 
@@ -592,6 +599,26 @@ bool IResearchViewMeta::init(arangodb::velocypack::Slice const& slice, std::stri
     }
   }
 
+  {
+    // optional array
+    static VPackStringRef const fieldName("storedValues");
+    std::string errorSubField;
+
+    auto const field = slice.get(fieldName);
+    mask->_storedValues = !field.isNone();
+
+    if (!mask->_storedValues) {
+      _storedValues = defaults._storedValues;
+    } else if (!_storedValues.fromVelocyPack(field, errorSubField)) {
+      errorField = fieldName.toString();
+      if (!errorSubField.empty()) {
+       errorField += "=>" + errorSubField;
+      }
+
+      return false;
+    }
+  }
+
   return true;
 }
 
@@ -658,6 +685,16 @@ bool IResearchViewMeta::json(arangodb::velocypack::Builder& builder,
     }
   }
 
+  // omitted unless configured, stored values are an opt-in feature
+  if (!_storedValues.empty()
+      && (!ignoreEqual || _storedValues != ignoreEqual->_storedValues)
+      && (!mask || mask->_storedValues)) {
+    velocypack::ArrayBuilder arrayScope(&builder, "storedValues");
+    if (!_storedValues.toVelocyPack(builder)) {
+      return false;
+    }
+  }
+
   return true;
 }
 
@@ -28,6 +28,7 @@
 #include <unordered_set>
 
 #include "IResearchViewSort.h"
+#include "IResearchViewStoredValues.h"
 #include "VocBase/voc-types.h"
 #include "index/index_writer.hpp"
 #include "velocypack/Builder.h"
@@ -84,6 +85,7 @@ struct IResearchViewMeta {
     bool _writebufferIdle;
     bool _writebufferSizeMax;
     bool _primarySort;
+    bool _storedValues;
     explicit Mask(bool mask = false) noexcept;
   };
 
@@ -97,6 +99,7 @@ struct IResearchViewMeta {
   size_t _writebufferIdle; // maximum number of segments cached in the pool
   size_t _writebufferSizeMax; // maximum memory byte size per segment before a segment flush is triggered (0 == unlimited)
   IResearchViewSort _primarySort;
+  IResearchViewStoredValues _storedValues; // attributes stored in addition to being indexed
   // NOTE: if adding fields don't forget to modify the default constructor !!!
   // NOTE: if adding fields don't forget to modify the copy constructor !!!
   // NOTE: if adding fields don't forget to modify the move constructor !!!
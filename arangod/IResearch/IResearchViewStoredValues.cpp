@@ -0,0 +1,109 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "IResearchViewStoredValues.h"
+#include "VelocyPackHelper.h"
+#include "Basics/StaticStrings.h"
+#include "velocypack/Builder.h"
+#include "velocypack/Iterator.h"
+
+#include <algorithm>
+
+namespace {
+
+// prefix of the columns holding stored values, distinct from '@_PK'
+std::string const COLUMN_PREFIX("@_SV:");
+
+}
+
+namespace arangodb {
+namespace iresearch {
+
+size_t IResearchViewStoredValues::find(std::string const& field) const noexcept {
+  auto const it = std::lower_bound(_fields.begin(), _fields.end(), field);
+
+  return it != _fields.end() && *it == field
+    ? static_cast<size_t>(std::distance(_fields.begin(), it))
+    : _fields.size();
+}
+
+/*static*/ std::string IResearchViewStoredValues::column(std::string const& field) {
+  return COLUMN_PREFIX + field;
+}
+
+bool IResearchViewStoredValues::toVelocyPack(velocypack::Builder& builder) const {
+  if (!builder.isOpenArray()) {
+    return false;
+  }
+
+  for (auto& field : _fields) {
+    builder.add(VPackValue(field));
+  }
+
+  return true;
+}
+
+bool IResearchViewStoredValues::fromVelocyPack(
+    velocypack::Slice slice,
+    std::string& error) {
+  clear();
+
+  if (!slice.isArray()) {
+    return false;
+  }
+
+  _fields.reserve(slice.length());
+
+  for (auto fieldSlice : velocypack::ArrayIterator(slice)) {
+    // '_id' is stored as a custom type which can't be decoded without the
+    // corresponding collection
+    if (!fieldSlice.isString() || !fieldSlice.getStringLength() ||
+        arangodb::iresearch::getStringRef(fieldSlice) == StaticStrings::IdString) {
+      error = "[" + std::to_string(_fields.size()) + "]";
+      return false;
+    }
+
+    _fields.emplace_back(arangodb::iresearch::getStringRef(fieldSlice));
+  }
+
+  std::sort(_fields.begin(), _fields.end());
+  _fields.erase(std::unique(_fields.begin(), _fields.end()), _fields.end());
+
+  _columns.reserve(_fields.size());
+
+  for (auto& field : _fields) {
+    _columns.emplace_back(column(field));
+  }
+
+  return true;
+}
+
+size_t IResearchViewStoredValues::memory() const noexcept {
+  size_t size = sizeof(IResearchViewStoredValues);
+
+  for (size_t i = 0; i < _fields.size(); ++i) {
+    size += _fields[i].size() + _columns[i].size();
+  }
+
+  return size;
+}
+
+} // iresearch
+} // arangodb
@@ -0,0 +1,99 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_IRESEARCH__IRESEARCH_VIEW_STORED_VALUES_H
+#define ARANGODB_IRESEARCH__IRESEARCH_VIEW_STORED_VALUES_H 1
+
+#include "velocypack/Slice.h"
+
+#include <string>
+#include <vector>
+
+namespace arangodb {
+
+namespace velocypack {
+class Builder;
+}
+
+namespace iresearch {
+
+// top-level document attributes which values are stored inside a view in
+// addition to being indexed, so that they can be returned without reading
+// documents from the storage engine
+class IResearchViewStoredValues {
+ public:
+  IResearchViewStoredValues() = default;
+  IResearchViewStoredValues(const IResearchViewStoredValues&) = default;
+  IResearchViewStoredValues(IResearchViewStoredValues&&) = default;
+  IResearchViewStoredValues& operator=(const IResearchViewStoredValues&) = default;
+  IResearchViewStoredValues& operator=(IResearchViewStoredValues&&) = default;
+
+  bool operator==(IResearchViewStoredValues const& rhs) const noexcept {
+    return _fields == rhs._fields;
+  }
+
+  bool operator!=(IResearchViewStoredValues const& rhs) const noexcept {
+    return !(*this == rhs);
+  }
+
+  void clear() noexcept {
+    _fields.clear();
+    _columns.clear();
+  }
+
+  size_t size() const noexcept {
+    return _fields.size();
+  }
+
+  bool empty() const noexcept {
+    return _fields.empty();
+  }
+
+  // attribute names, sorted
+  std::vector<std::string> const& fields() const noexcept {
+    return _fields;
+  }
+
+  // names of the columns holding the values of the attributes from 'fields()'
+  std::vector<std::string> const& columns() const noexcept {
+    return _columns;
+  }
+
+  // @return position of a specified attribute in 'fields()', 'size()' if the
+  //         attribute isn't stored
+  size_t find(std::string const& field) const noexcept;
+
+  // @return name of the column holding values of a specified attribute
+  static std::string column(std::string const& field);
+
+  size_t memory() const noexcept;
+
+  bool toVelocyPack(velocypack::Builder& builder) const;
+  bool fromVelocyPack(velocypack::Slice, std::string& error);
+
+ private:
+  std::vector<std::string> _fields;
+  std::vector<std::string> _columns;
+}; // IResearchViewStoredValues
+
+} // iresearch
+} // arangodb
+
+#endif // ARANGODB_IRESEARCH__IRESEARCH_VIEW_STORED_VALUES_H
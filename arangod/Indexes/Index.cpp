@@ -917,16 +917,26 @@ void Index::expandInSearchValues(VPackSlice const base, VPackBuilder& result) co
 
 bool Index::covers(std::unordered_set<std::string> const& attributes) const {
   // check if we can use covering indexes
-  if (_fields.size() < attributes.size()) {
+  auto const& fields = coveredFields();
+  if (fields.size() < attributes.size()) {
     // we will not be able to satisfy all requested projections with this index
     return false;
   }
 
+  // every requested attribute must be one of the index fields. the index may
+  // have more fields than requested, e.g. an index on [a, b] covers [a]
   std::string result;
-  for (size_t i = 0; i < _fields.size(); ++i) {
-    result.clear();
-    TRI_AttributeNamesToString(_fields[i], result, false);
-    if (std::find(attributes.begin(), attributes.end(), result) == attributes.end()) {
+  for (auto const& it : attributes) {
+    bool found = false;
+    for (auto const& field : fields) {
+      result.clear();
+      TRI_AttributeNamesToString(field, result, false);
+      if (result == it) {
+        found = true;
+        break;
+      }
+    }
+    if (!found) {
       return false;
     }
   }
@@ -987,7 +997,7 @@ double Index::getTimestamp(arangodb::velocypack::Slice const& doc,
   if (value.isString()) {
     // string value. we expect it to be YYYY-MM-DD etc.
     tp_sys_clock_ms tp;
-    if (basics::parseDateTime(value.copyString(), tp)) {
+    if (basics::parseDateTime(arangodb::velocypack::StringRef(value), tp)) {
       return static_cast<double>(
           std::chrono::duration_cast<std::chrono::seconds>(tp.time_since_epoch())
               .count());
@@ -43,6 +43,7 @@ namespace basics {
 class LocalTaskQueue;
 }
 
+class IndexHistogram;
 class IndexIterator;
 class LogicalCollection;
 struct IndexIteratorOptions;
@@ -232,7 +233,8 @@ class Index {
   /// @brief whether or not any attribute is expanded
   inline bool hasExpansion() const { return _useExpansion; }
 
-  /// @brief whether or not the index covers all the attributes passed in
+  /// @brief whether or not the index covers all the attributes passed in,
+  /// i.e. all of them can be produced from the index values alone
   virtual bool covers(std::unordered_set<std::string> const& attributes) const;
 
   /// @brief return the underlying collection
@@ -332,6 +334,28 @@ class Index {
     TRI_ASSERT(false);  // should never be called except on Coordinator
   }
 
+  /// @brief add a mergeable sketch of the indexed values as an object to the
+  /// builder, so the coordinator can combine the estimates of all shards.
+  /// returns false without touching the builder if there is no such sketch
+  virtual bool selectivitySketch(arangodb::velocypack::Builder&) {
+    return false;
+  }
+
+  /// @brief histogram over the values of the first index attribute, used to
+  /// estimate range conditions. nullptr if the index has none (yet)
+  virtual std::shared_ptr<IndexHistogram const> histogram() const {
+    return nullptr;
+  }
+
+  /// @brief collect the ids of at most limit documents whose indexed expiry
+  /// timestamp is not after stamp, oldest first. only TTL indexes that can
+  /// scan their entries directly implement this, everyone else returns
+  /// TRI_ERROR_NOT_IMPLEMENTED and the TTL thread falls back to AQL
+  virtual Result lookupExpired(transaction::Methods&, double /*stamp*/, size_t /*limit*/,
+                               std::vector<LocalDocumentId>& /*result*/) const {
+    return Result(TRI_ERROR_NOT_IMPLEMENTED);
+  }
+
   /// @brief whether or not the index is implicitly unique
   /// this can be the case if the index is not declared as unique,
   /// but contains a unique attribute such as _key
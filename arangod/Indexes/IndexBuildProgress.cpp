@@ -0,0 +1,80 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "IndexBuildProgress.h"
+#include "ApplicationFeatures/ApplicationServer.h"
+#include "Basics/MutexLocker.h"
+
+#include <algorithm>
+#include <thread>
+
+using namespace arangodb;
+
+thread_local IndexBuildProgress* IndexBuildProgress::CURRENT = nullptr;
+
+IndexBuildProgress::IndexBuildProgress(uint64_t maxWriteRate)
+    : _maxWriteRate(maxWriteRate), _total(0), _done(0), _writeClock() {}
+
+void IndexBuildProgress::setTotal(uint64_t documents) noexcept {
+  _total.store(documents, std::memory_order_relaxed);
+}
+
+void IndexBuildProgress::advance(uint64_t documents, uint64_t bytes) {
+  _done.fetch_add(documents, std::memory_order_relaxed);
+
+  auto delay = writeDelay(bytes, clock::now());
+  // sleep in steps, so that a large write does not delay the shutdown
+  auto const step = std::chrono::duration_cast<clock::duration>(std::chrono::milliseconds(100));
+  while (delay > clock::duration::zero() &&
+         !application_features::ApplicationServer::isStopping()) {
+    auto const sleep = std::min(delay, step);
+    std::this_thread::sleep_for(sleep);
+    delay -= sleep;
+  }
+}
+
+IndexBuildProgress::clock::duration IndexBuildProgress::writeDelay(uint64_t bytes,
+                                                                   clock::time_point now) {
+  if (_maxWriteRate == 0) {
+    return clock::duration::zero();
+  }
+
+  MUTEX_LOCKER(locker, _writeLock);
+  auto const earliest = now - std::chrono::seconds(1);
+  if (_writeClock < earliest) {
+    _writeClock = earliest;
+  }
+  _writeClock += std::chrono::duration_cast<clock::duration>(
+      std::chrono::duration<double>(static_cast<double>(bytes) / _maxWriteRate));
+
+  if (_writeClock <= now) {
+    return clock::duration::zero();
+  }
+  return _writeClock - now;
+}
+
+uint64_t IndexBuildProgress::percent() const noexcept {
+  uint64_t const total = _total.load(std::memory_order_relaxed);
+  if (total == 0) {
+    return 0;
+  }
+  // the total is an estimate, so the count may overshoot it
+  return std::min<uint64_t>(100, _done.load(std::memory_order_relaxed) * 100 / total);
+}
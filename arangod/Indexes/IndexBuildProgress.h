@@ -0,0 +1,91 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_INDEXES_INDEX_BUILD_PROGRESS_H
+#define ARANGOD_INDEXES_INDEX_BUILD_PROGRESS_H 1
+
+#include "Basics/Common.h"
+#include "Basics/Mutex.h"
+
+#include <atomic>
+#include <chrono>
+
+namespace arangodb {
+
+/// @brief progress of an index build, and the limit for its write rate.
+/// whoever creates an index may make a progress object the CURRENT one of
+/// its thread, the storage engine then reports the documents it indexed to
+/// it while filling the index
+class IndexBuildProgress {
+ public:
+  typedef std::chrono::steady_clock clock;
+
+  /// @brief maxWriteRate is in bytes per second, 0 means no limit
+  explicit IndexBuildProgress(uint64_t maxWriteRate = 0);
+
+  IndexBuildProgress(IndexBuildProgress const&) = delete;
+  IndexBuildProgress& operator=(IndexBuildProgress const&) = delete;
+
+  /// @brief set the number of documents the build has to index
+  void setTotal(uint64_t documents) noexcept;
+
+  /// @brief account documents indexed and bytes written by the build. waits
+  /// until the write rate allows the bytes. may be called from several
+  /// threads at the same time
+  void advance(uint64_t documents, uint64_t bytes);
+
+  /// @brief how long a write of the given size has to wait at the time
+  /// given. unused write capacity is kept for at most one second
+  clock::duration writeDelay(uint64_t bytes, clock::time_point now);
+
+  /// @brief percentage of the documents indexed so far, between 0 and 100
+  uint64_t percent() const noexcept;
+
+ public:
+  /// @brief the index build of the current thread, may be nullptr
+  static thread_local IndexBuildProgress* CURRENT;
+
+ private:
+  uint64_t const _maxWriteRate;
+  std::atomic<uint64_t> _total;
+  std::atomic<uint64_t> _done;
+
+  /// @brief protects _writeClock
+  Mutex _writeLock;
+  /// @brief the time at which the writes accounted so far are paid for
+  clock::time_point _writeClock;
+};
+
+/// @brief scope guard for the index build progress of a thread
+struct IndexBuildProgressScope {
+  explicit IndexBuildProgressScope(IndexBuildProgress* progress)
+      : _old(IndexBuildProgress::CURRENT) {
+    IndexBuildProgress::CURRENT = progress;
+  }
+
+  ~IndexBuildProgressScope() { IndexBuildProgress::CURRENT = _old; }
+
+ private:
+  IndexBuildProgress* _old;
+};
+
+}  // namespace arangodb
+
+#endif
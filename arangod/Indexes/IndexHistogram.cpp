@@ -0,0 +1,189 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "IndexHistogram.h"
+#include "Basics/Exceptions.h"
+#include "Basics/VelocyPackHelper.h"
+
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include <algorithm>
+
+using namespace arangodb;
+
+constexpr size_t IndexHistogram::defaultBuckets;
+
+namespace {
+int compareValues(VPackSlice const& lhs, VPackSlice const& rhs) {
+  return basics::VelocyPackHelper::compare(lhs, rhs, true);
+}
+}  // namespace
+
+IndexHistogram::IndexHistogram(VPackSlice const& samples, size_t buckets)
+    : _numSamples(0) {
+  TRI_ASSERT(samples.isArray());
+  TRI_ASSERT(buckets > 0);
+
+  std::vector<VPackSlice> values;
+  values.reserve(samples.length());
+  for (VPackSlice it : VPackArrayIterator(samples)) {
+    values.emplace_back(it);
+  }
+  std::sort(values.begin(), values.end(), [](VPackSlice const& lhs, VPackSlice const& rhs) {
+    return ::compareValues(lhs, rhs) < 0;
+  });
+
+  size_t const n = values.size();
+  _numSamples = n;
+
+  _bounds.openArray();
+  if (n > 0) {
+    // the boundaries are the smallest value and the last value of each
+    // bucket. runs of equal values are never split, so that the fractions
+    // stored for a boundary are exact for the sample
+    size_t pos = 0;
+    for (size_t bucket = 0; bucket <= buckets && pos < n; ++bucket) {
+      size_t target = (bucket * n) / buckets;
+      if (target > 0) {
+        --target;
+      }
+      pos = (std::max)(pos, target);
+
+      size_t first = pos;
+      while (first > 0 && ::compareValues(values[first - 1], values[pos]) == 0) {
+        --first;
+      }
+      size_t last = pos;
+      while (last + 1 < n && ::compareValues(values[last + 1], values[pos]) == 0) {
+        ++last;
+      }
+
+      _bounds.add(values[pos]);
+      _lessThan.emplace_back(static_cast<double>(first) / n);
+      _lessEqual.emplace_back(static_cast<double>(last + 1) / n);
+      pos = last + 1;
+    }
+  }
+  _bounds.close();
+}
+
+IndexHistogram::IndexHistogram(VPackSlice const& slice, FromPersistent)
+    : _numSamples(0) {
+  if (!slice.isObject()) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_BAD_PARAMETER,
+                                   "invalid index histogram");
+  }
+  VPackSlice bounds = slice.get("bounds");
+  VPackSlice lessThan = slice.get("lessThan");
+  VPackSlice lessEqual = slice.get("lessEqual");
+  if (!bounds.isArray() || !lessThan.isArray() || !lessEqual.isArray() ||
+      bounds.length() != lessThan.length() || bounds.length() != lessEqual.length()) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_BAD_PARAMETER,
+                                   "invalid index histogram");
+  }
+
+  _bounds.add(bounds);
+  for (VPackSlice it : VPackArrayIterator(lessThan)) {
+    _lessThan.emplace_back(it.getNumber<double>());
+  }
+  for (VPackSlice it : VPackArrayIterator(lessEqual)) {
+    _lessEqual.emplace_back(it.getNumber<double>());
+  }
+  _numSamples = basics::VelocyPackHelper::getNumericValue<uint64_t>(slice, "samples", 0);
+}
+
+double IndexHistogram::estimateRange(VPackSlice const& lower, bool includeLower,
+                                     VPackSlice const& upper, bool includeUpper) const {
+  if (_lessThan.empty()) {
+    return 1.0;
+  }
+
+  double const below = lower.isNone() ? 0.0 : fractionBelow(lower, !includeLower);
+  double const atMost = upper.isNone() ? 1.0 : fractionBelow(upper, includeUpper);
+  return (std::min)((std::max)(atMost - below, 0.0), 1.0);
+}
+
+double IndexHistogram::fractionBelow(VPackSlice const& value, bool inclusive) const {
+  VPackSlice bounds = _bounds.slice();
+  size_t const n = _lessThan.size();
+
+  // binary search for the first boundary that is not less than the value
+  size_t low = 0;
+  size_t high = n;
+  while (low < high) {
+    size_t mid = low + (high - low) / 2;
+    if (::compareValues(bounds.at(mid), value) < 0) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+
+  if (low == n) {
+    // greater than all sampled values
+    return 1.0;
+  }
+
+  VPackSlice bound = bounds.at(low);
+  if (::compareValues(bound, value) == 0) {
+    return inclusive ? _lessEqual[low] : _lessThan[low];
+  }
+  if (low == 0) {
+    // less than all sampled values
+    return 0.0;
+  }
+
+  // the value lies strictly between two boundaries. the values in between
+  // are assumed to be distributed evenly for numbers, for all other types
+  // half of them are taken
+  VPackSlice previous = bounds.at(low - 1);
+  double const from = _lessEqual[low - 1];
+  double const to = _lessThan[low];
+  double position = 0.5;
+  if (previous.isNumber() && bound.isNumber() && value.isNumber()) {
+    double const left = previous.getNumber<double>();
+    double const right = bound.getNumber<double>();
+    if (right > left) {
+      position = (value.getNumber<double>() - left) / (right - left);
+    }
+  }
+  return from + position * (to - from);
+}
+
+void IndexHistogram::toVelocyPack(VPackBuilder& builder) const {
+  VPackObjectBuilder guard(&builder);
+  builder.add("samples", VPackValue(_numSamples));
+  builder.add("bounds", _bounds.slice());
+  builder.add(VPackValue("lessThan"));
+  {
+    VPackArrayBuilder arrayGuard(&builder);
+    for (double it : _lessThan) {
+      builder.add(VPackValue(it));
+    }
+  }
+  builder.add(VPackValue("lessEqual"));
+  {
+    VPackArrayBuilder arrayGuard(&builder);
+    for (double it : _lessEqual) {
+      builder.add(VPackValue(it));
+    }
+  }
+}
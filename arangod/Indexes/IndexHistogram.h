@@ -0,0 +1,84 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_INDEXES_INDEX_HISTOGRAM_H
+#define ARANGOD_INDEXES_INDEX_HISTOGRAM_H 1
+
+#include "Basics/Common.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+namespace arangodb {
+
+/// @brief equi-depth histogram over the values of the first attribute of
+/// an index, built from a sample of the values. each bucket holds about the
+/// same number of sampled values, so ranges over skewed data are estimated
+/// much better than by the fixed guesses used without a histogram.
+/// values are ordered like the AQL sort order, which is the index order
+class IndexHistogram {
+ public:
+  static constexpr size_t defaultBuckets = 64;
+
+  /// @brief builds the histogram from an array of sampled values. the order
+  /// of the values does not matter
+  explicit IndexHistogram(velocypack::Slice const& samples, size_t buckets = defaultBuckets);
+
+  /// @brief tag type to create a histogram from its serialized form
+  struct FromPersistent {};
+
+  /// @brief restores a histogram serialized by toVelocyPack, throws
+  /// TRI_ERROR_BAD_PARAMETER on invalid input
+  IndexHistogram(velocypack::Slice const& slice, FromPersistent);
+
+  /// @brief estimated fraction (0 to 1) of the values in the range. a none
+  /// slice as bound means that the range is open on that side
+  double estimateRange(velocypack::Slice const& lower, bool includeLower,
+                       velocypack::Slice const& upper, bool includeUpper) const;
+
+  /// @brief number of values the histogram was built from
+  uint64_t numSamples() const { return _numSamples; }
+
+  /// @brief number of distinct bucket boundaries
+  size_t numBounds() const { return _lessThan.size(); }
+
+  void toVelocyPack(velocypack::Builder& builder) const;
+
+ private:
+  /// @brief estimated fraction of the values that are less than the value,
+  /// or less than or equal to it
+  double fractionBelow(velocypack::Slice const& value, bool inclusive) const;
+
+ private:
+  /// @brief the distinct bucket boundaries in ascending order, starting with
+  /// the smallest sampled value and ending with the largest one
+  velocypack::Builder _bounds;
+
+  /// @brief per boundary, the fraction of the sampled values that are less
+  /// than the boundary, and less than or equal to it
+  std::vector<double> _lessThan;
+  std::vector<double> _lessEqual;
+
+  uint64_t _numSamples;
+};
+
+}  // namespace arangodb
+
+#endif
@@ -27,14 +27,90 @@
 #include "Aql/SortCondition.h"
 #include "Aql/Variable.h"
 #include "Basics/StaticStrings.h"
+#include "Basics/VelocyPackHelper.h"
 #include "Indexes/Index.h"
+#include "Indexes/IndexHistogram.h"
 #include "Indexes/SimpleAttributeEqualityMatcher.h"
 #include "VocBase/vocbase.h"
 
+#include <velocypack/Builder.h>
 #include <velocypack/StringRef.h>
 
 using namespace arangodb;
 
+namespace {
+/// @brief estimated fraction of the index entries that satisfy the range
+/// conditions on the first index attribute, or a negative value if there is
+/// no usable histogram or a bound is not a constant
+double estimateRangeFraction(arangodb::Index const* idx,
+                             std::vector<arangodb::aql::AstNode const*> const& nodes,
+                             arangodb::aql::Variable const* reference) {
+  std::shared_ptr<IndexHistogram const> histogram = idx->histogram();
+  if (histogram == nullptr || histogram->numSamples() == 0) {
+    return -1.0;
+  }
+
+  velocypack::Builder lower;
+  velocypack::Builder upper;
+  bool includeLower = true;
+  bool includeUpper = true;
+
+  for (auto const* op : nodes) {
+    auto type = op->type;
+    if (type == arangodb::aql::NODE_TYPE_OPERATOR_BINARY_NE) {
+      // does not restrict the range
+      continue;
+    }
+    arangodb::aql::AstNode const* value = op->getMember(1);
+    if (!op->getMember(0)->isAttributeAccessForVariable(reference, false)) {
+      // 5 < doc.value
+      value = op->getMember(0);
+      type = arangodb::aql::Ast::ReverseOperator(type);
+    }
+    if (!value->isConstant()) {
+      return -1.0;
+    }
+
+    velocypack::Builder bound;
+    value->toVelocyPackValue(bound);
+
+    // of several bounds on the same side, keep the tighter one
+    switch (type) {
+      case arangodb::aql::NODE_TYPE_OPERATOR_BINARY_LT:
+      case arangodb::aql::NODE_TYPE_OPERATOR_BINARY_LE: {
+        bool const include = type == arangodb::aql::NODE_TYPE_OPERATOR_BINARY_LE;
+        int cmp = upper.isEmpty() ? -1 : basics::VelocyPackHelper::compare(bound.slice(), upper.slice(), true);
+        if (cmp < 0 || (cmp == 0 && !include)) {
+          upper = std::move(bound);
+          includeUpper = include;
+        }
+        break;
+      }
+      case arangodb::aql::NODE_TYPE_OPERATOR_BINARY_GT:
+      case arangodb::aql::NODE_TYPE_OPERATOR_BINARY_GE: {
+        bool const include = type == arangodb::aql::NODE_TYPE_OPERATOR_BINARY_GE;
+        int cmp = lower.isEmpty() ? 1 : basics::VelocyPackHelper::compare(bound.slice(), lower.slice(), true);
+        if (cmp > 0 || (cmp == 0 && !include)) {
+          lower = std::move(bound);
+          includeLower = include;
+        }
+        break;
+      }
+      default:
+        return -1.0;
+    }
+  }
+
+  if (lower.isEmpty() && upper.isEmpty()) {
+    return -1.0;
+  }
+  return histogram->estimateRange(lower.isEmpty() ? velocypack::Slice::noneSlice() : lower.slice(),
+                                  includeLower,
+                                  upper.isEmpty() ? velocypack::Slice::noneSlice() : upper.slice(),
+                                  includeUpper);
+}
+}  // namespace
+
 bool SortedIndexAttributeMatcher::accessFitsIndex(
     arangodb::Index const* idx,            // index
     arangodb::aql::AstNode const* access,  // attribute access
@@ -209,6 +285,7 @@ Index::UsageCosts SortedIndexAttributeMatcher::supportsFilterCondition(
   size_t attributesCovered = 0;
   size_t attributesCoveredByEquality = 0;
   double equalityReductionFactor = 20.0;
+  bool usedHistogram = false;
   costs.estimatedCosts = static_cast<double>(itemsInIndex);
 
   for (size_t i = 0; i < idx->fields().size(); ++i) {
@@ -247,8 +324,16 @@ Index::UsageCosts SortedIndexAttributeMatcher::supportsFilterCondition(
         equalityReductionFactor = 2.0;
       }
     } else {
+      double fraction = -1.0;
+      if (i == 0) {
+        fraction = ::estimateRangeFraction(idx, nodes, reference);
+      }
       // quick estimate for the potential reductions caused by the conditions
-      if (nodes.size() >= 2) {
+      if (fraction >= 0.0) {
+        // the histogram knows how the values are distributed
+        costs.estimatedCosts *= fraction;
+        usedHistogram = true;
+      } else if (nodes.size() >= 2) {
         // at least two (non-equality) conditions. probably a range with lower
         // and upper bound defined
         costs.estimatedCosts /= 7.5;
@@ -356,6 +441,12 @@ Index::UsageCosts SortedIndexAttributeMatcher::supportsFilterCondition(
                                  std::log2(static_cast<double>(itemsInIndex)) * values);
       // slightly prefer indexes that cover more attributes
       costs.estimatedCosts -= (attributesCovered - 1) * 0.02;
+      if (usedHistogram) {
+        // the fixed guesses for ranges are too rough to let them into the
+        // costs, but a histogram estimate is good enough to account for
+        // scanning the range, at the per-item cost of a forward iteration
+        costs.estimatedCosts += costs.estimatedItems * 0.001;
+      }
     }
     costs.coveredAttributes = attributesCovered;
     costs.supportsCondition = true;
@@ -1579,6 +1579,11 @@ uint64_t MMFilesCollection::numberDocuments(transaction::Methods* trx) const {
   return primaryIndex()->size();
 }
 
+uint64_t MMFilesCollection::approximateNumberDocuments() const {
+  TRI_ASSERT(!ServerState::instance()->isCoordinator());
+  return primaryIndex()->size();
+}
+
 void MMFilesCollection::sizeHint(transaction::Methods* trx, int64_t hint) {
   if (hint <= 0) {
     return;
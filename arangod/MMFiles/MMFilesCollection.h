@@ -159,6 +159,7 @@ class MMFilesCollection final : public PhysicalCollection {
   }
 
   uint64_t numberDocuments(transaction::Methods* trx) const override;
+  uint64_t approximateNumberDocuments() const override;
 
   /// @brief report extra memory used by indexes etc.
   size_t memory() const override;
@@ -24,6 +24,8 @@
 #include "MMFilesCompactionFeature.h"
 
 #include "Basics/Exceptions.h"
+#include "Basics/MutexLocker.h"
+#include "Basics/system-functions.h"
 #include "Logger/Logger.h"
 #include "MMFiles/MMFilesLogfileManager.h"
 #include "ProgramOptions/ProgramOptions.h"
@@ -47,7 +49,10 @@ MMFilesCompactionFeature::MMFilesCompactionFeature(application_features::Applica
       _maxResultFilesize(128 * 1024 * 1024),
       _deadNumberThreshold(16384),
       _deadSizeThreshold(128 * 1024),
-      _deadShare(0.1) {
+      _deadShare(0.1),
+      _threads(1),
+      _maxIORate(0),
+      _throttledUntil(0.0) {
   setOptional(true);
   onlyEnabledWith("MMFilesEngine");
 
@@ -99,6 +104,15 @@ void MMFilesCompactionFeature::collectOptions(std::shared_ptr<options::ProgramOp
                      "how large the resulting file may be in comparison to the "
                      "collections '--database.maximal-journal-size' setting",
                      new UInt64Parameter(&_maxSizeFactor));
+
+  options->addOption("--compaction.threads",
+                     "number of compactor threads per database",
+                     new UInt64Parameter(&_threads));
+
+  options->addOption("--compaction.max-io-rate",
+                     "maximum number of bytes per second all compactor threads "
+                     "may read and write (0 = unlimited)",
+                     new UInt64Parameter(&_maxIORate));
 }
 
 void MMFilesCompactionFeature::validateOptions(std::shared_ptr<options::ProgramOptions> options) {
@@ -132,4 +146,28 @@ void MMFilesCompactionFeature::validateOptions(std::shared_ptr<options::ProgramO
         << "compaction.max-file-size-factor should be at least: 1";
     _maxSizeFactor = 1;
   }
+
+  if (_threads < 1) {
+    LOG_TOPIC("3e9b4", WARN, Logger::COMPACTOR)
+        << "compaction.threads should be at least: 1";
+    _threads = 1;
+  } else if (_threads > 16) {
+    LOG_TOPIC("5c0d8", WARN, Logger::COMPACTOR)
+        << "compaction.threads should be at most: 16";
+    _threads = 16;
+  }
+}
+
+double MMFilesCompactionFeature::throttle(uint64_t bytes, double started) {
+  if (_maxIORate == 0) {
+    return 0.0;
+  }
+
+  MUTEX_LOCKER(locker, _throttleLock);
+  // unused rate does not accumulate while the compactors are idle
+  if (_throttledUntil < started) {
+    _throttledUntil = started;
+  }
+  _throttledUntil += static_cast<double>(bytes) / static_cast<double>(_maxIORate);
+  return _throttledUntil;
 }
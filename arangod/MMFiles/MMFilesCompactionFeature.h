@@ -25,6 +25,7 @@
 #define ARANGOD_MMFILES_COMPACTION_FEATURE_H 1
 
 #include "ApplicationFeatures/ApplicationFeature.h"
+#include "Basics/Mutex.h"
 
 namespace arangodb {
 namespace options {
@@ -73,6 +74,20 @@ class MMFilesCompactionFeature : public application_features::ApplicationFeature
   /// compacted
   double _deadShare;
 
+  /// @brief number of compactor threads per database
+  uint64_t _threads;
+
+  /// @brief maximum number of bytes per second all compactor threads read
+  /// and write together. 0 means unlimited
+  uint64_t _maxIORate;
+
+  /// @brief protects _throttledUntil
+  Mutex _throttleLock;
+
+  /// @brief point in time until which the I/O of the compactor threads has
+  /// used up the rate
+  double _throttledUntil;
+
   MMFilesCompactionFeature(MMFilesCompactionFeature const&) = delete;
   MMFilesCompactionFeature& operator=(MMFilesCompactionFeature const&) = delete;
 
@@ -121,6 +136,14 @@ class MMFilesCompactionFeature : public application_features::ApplicationFeature
   /// compacted
   double deadShare() const { return _deadShare; }
 
+  /// @brief number of compactor threads per database
+  size_t threads() const { return static_cast<size_t>(_threads); }
+
+  /// @brief accounts for the bytes a compaction run that began at the start
+  /// time has read and written. returns the point in time the caller has to
+  /// wait for to stay within the configured I/O rate
+  double throttle(uint64_t bytes, double started);
+
  public:
   void collectOptions(std::shared_ptr<options::ProgramOptions>) override final;
   void validateOptions(std::shared_ptr<options::ProgramOptions>) override final;
@@ -589,6 +589,7 @@ void MMFilesCompactorThread::compactDatafiles(LogicalCollection* collection,
 
   physical->_datafileStatistics.compactionRun(nrCombined, compactionBytesRead,
                                               context->_dfi.sizeAlive);
+  _bytesCompacted += compactionBytesRead + context->_dfi.sizeAlive;
   try {
     physical->_datafileStatistics.replace(compactor->fid(), context->_dfi, true);
   } catch (...) {
@@ -955,7 +956,7 @@ bool MMFilesCompactorThread::compactCollection(LogicalCollection* collection, bo
 }
 
 MMFilesCompactorThread::MMFilesCompactorThread(TRI_vocbase_t& vocbase)
-    : Thread("MMFilesCompactor"), _vocbase(vocbase) {}
+    : Thread("MMFilesCompactor"), _vocbase(vocbase), _bytesCompacted(0) {}
 
 MMFilesCompactorThread::~MMFilesCompactorThread() { shutdown(); }
 
@@ -964,136 +965,167 @@ void MMFilesCompactorThread::signal() {
   locker.signal();
 }
 
-void MMFilesCompactorThread::run() {
+/// @brief compacts the collections of the database, the ones with the most
+/// dead bytes first. returns the number of collections compacted
+size_t MMFilesCompactorThread::compactCollections() {
   MMFilesEngine* engine = static_cast<MMFilesEngine*>(EngineSelectorFeature::ENGINE);
-  std::vector<std::shared_ptr<arangodb::LogicalCollection>> collections;
-  int numCompacted = 0;
-  while (true) {
-    // keep initial _state value as vocbase->_state might change during
-    // compaction loop
-    TRI_vocbase_t::State state = _vocbase.state();
 
-    try {
-      engine->tryPreventCompaction(
-          &_vocbase,
-          [this, &numCompacted, &collections, &engine](TRI_vocbase_t* vocbase) {
-            // compaction is currently allowed
-            numCompacted = 0;
-
-            try {
-              // copy all collections
-              collections = _vocbase.collections(false);
-            } catch (...) {
-              collections.clear();
-            }
+  std::vector<std::pair<int64_t, std::shared_ptr<LogicalCollection>>> candidates;
+
+  try {
+    // copy all collections
+    for (auto& collection : _vocbase.collections(false)) {
+      if (collection->status() != TRI_VOC_COL_STATUS_LOADED) {
+        continue;
+      }
+      auto physical = static_cast<MMFilesCollection*>(collection->getPhysical());
+      TRI_ASSERT(physical != nullptr);
+      if (!physical->doCompact()) {
+        continue;
+      }
+      int64_t sizeDead = physical->_datafileStatistics.all().sizeDead;
+      candidates.emplace_back(sizeDead, std::move(collection));
+    }
+  } catch (...) {
+    return 0;
+  }
 
-            for (auto& collection : collections) {
-              bool worked = false;
+  // collections without dead bytes are still visited at the end, as they
+  // may have small datafiles to merge or datafiles with deletions only
+  std::stable_sort(candidates.begin(), candidates.end(),
+                   [](std::pair<int64_t, std::shared_ptr<LogicalCollection>> const& lhs,
+                      std::pair<int64_t, std::shared_ptr<LogicalCollection>> const& rhs) {
+                     return lhs.first > rhs.first;
+                   });
 
-              if (engine->isCompactionDisabled()) {
-                continue;
-              }
+  size_t numCompacted = 0;
 
-              auto callback = [this, &collection, &worked, &engine]() -> void {
-                if (collection->status() != TRI_VOC_COL_STATUS_LOADED &&
-                    collection->status() != TRI_VOC_COL_STATUS_UNLOADING) {
-                  return;
-                }
+  for (auto& candidate : candidates) {
+    if (engine->isCompactionDisabled() || isStopping()) {
+      break;
+    }
 
-                bool doCompact =
-                    static_cast<MMFilesCollection*>(collection->getPhysical())->doCompact();
+    auto& collection = candidate.second;
+    bool worked = false;
+    double const started = TRI_microtime();
+    _bytesCompacted = 0;
 
-                if (engine->isCompactionDisabled()) {
-                  doCompact = false;
-                }
+    auto callback = [this, &collection, &worked, &engine]() -> void {
+      if (collection->status() != TRI_VOC_COL_STATUS_LOADED &&
+          collection->status() != TRI_VOC_COL_STATUS_UNLOADING) {
+        return;
+      }
 
-                // for document collection, compactify datafiles
-                if (collection->status() == TRI_VOC_COL_STATUS_LOADED && doCompact) {
-                  // check whether someone else holds a read-lock on the
-                  // compaction lock
-
-                  auto physical =
-                      static_cast<MMFilesCollection*>(collection->getPhysical());
-                  TRI_ASSERT(physical != nullptr);
-
-                  MMFilesTryCompactionLocker compactionLocker(physical);
-
-                  if (!compactionLocker.isLocked()) {
-                    // someone else is holding the compactor lock, we'll not
-                    // compact
-                    return;
-                  }
-
-                  try {
-                    double const now = TRI_microtime();
-                    if (physical->lastCompactionStamp() +
-                            MMFilesCompactionFeature::COMPACTOR->compactionCollectionInterval() <=
-                        now) {
-                      auto ce = arangodb::MMFilesCollection::toMMFilesCollection(
-                                    collection.get())
-                                    ->ditches()
-                                    ->createMMFilesCompactionDitch(__FILE__, __LINE__);
-
-                      if (ce == nullptr) {
-                        // out of memory
-                        LOG_TOPIC("5cd66", WARN, Logger::COMPACTOR)
-                            << "out of memory when trying to create compaction "
-                               "ditch";
-                      } else {
-                        try {
-                          bool wasBlocked = false;
-                          worked = compactCollection(collection.get(), wasBlocked);
-
-                          if (!worked && !wasBlocked) {
-                            // set compaction stamp
-                            physical->lastCompactionStamp(now);
-                          }
-                          // if we worked or were blocked, then we don't set the
-                          // compaction stamp to force another round of
-                          // compaction
-                        } catch (std::exception const& ex) {
-                          LOG_TOPIC("a9e71", ERR, Logger::COMPACTOR)
-                              << "caught exception during compaction: " << ex.what();
-                        } catch (...) {
-                          LOG_TOPIC("5f4c3", ERR, Logger::COMPACTOR)
-                              << "an unknown exception occurred during "
-                                 "compaction";
-                          // in case an error occurs, we must still free this
-                          // ditch
-                        }
-
-                        arangodb::MMFilesCollection::toMMFilesCollection(
-                            collection.get())
-                            ->ditches()
-                            ->freeDitch(ce);
-                      }
-                    }
-                  } catch (std::exception const& ex) {
-                    LOG_TOPIC("e38b9", ERR, Logger::COMPACTOR)
-                        << "caught exception during compaction: " << ex.what();
-                  } catch (...) {
-                    // in case an error occurs, we must still relase the lock
-                    LOG_TOPIC("e9a26", ERR, Logger::COMPACTOR)
-                        << "an unknown exception occurred during compaction";
-                  }
-                }
-              };
+      auto physical = static_cast<MMFilesCollection*>(collection->getPhysical());
+      TRI_ASSERT(physical != nullptr);
 
-              if (!collection->tryExecuteWhileStatusLocked(callback)) {
-                continue;
-              }
+      bool doCompact = physical->doCompact();
 
-              if (worked) {
-                ++numCompacted;
+      if (engine->isCompactionDisabled()) {
+        doCompact = false;
+      }
+
+      // for document collection, compactify datafiles
+      if (collection->status() == TRI_VOC_COL_STATUS_LOADED && doCompact) {
+        // check whether someone else holds a read-lock on the compaction
+        // lock. this is also what keeps several compactor threads off the
+        // same collection
+        MMFilesTryCompactionLocker compactionLocker(physical);
+
+        if (!compactionLocker.isLocked()) {
+          // someone else is holding the compactor lock, we'll not compact
+          return;
+        }
 
-                // signal the cleanup thread that we worked and that it can now
-                // wake up
-                CONDITION_LOCKER(locker, _condition);
-                locker.signal();
+        try {
+          double const now = TRI_microtime();
+          if (physical->lastCompactionStamp() +
+                  MMFilesCompactionFeature::COMPACTOR->compactionCollectionInterval() <=
+              now) {
+            auto ce = physical->ditches()->createMMFilesCompactionDitch(__FILE__, __LINE__);
+
+            if (ce == nullptr) {
+              // out of memory
+              LOG_TOPIC("5cd66", WARN, Logger::COMPACTOR)
+                  << "out of memory when trying to create compaction ditch";
+            } else {
+              try {
+                bool wasBlocked = false;
+                worked = compactCollection(collection.get(), wasBlocked);
+
+                if (!worked && !wasBlocked) {
+                  // set compaction stamp
+                  physical->lastCompactionStamp(now);
+                }
+                // if we worked or were blocked, then we don't set the
+                // compaction stamp to force another round of compaction
+              } catch (std::exception const& ex) {
+                LOG_TOPIC("a9e71", ERR, Logger::COMPACTOR)
+                    << "caught exception during compaction: " << ex.what();
+              } catch (...) {
+                LOG_TOPIC("5f4c3", ERR, Logger::COMPACTOR)
+                    << "an unknown exception occurred during compaction";
+                // in case an error occurs, we must still free this ditch
               }
+
+              physical->ditches()->freeDitch(ce);
             }
-          },
-          true);
+          }
+        } catch (std::exception const& ex) {
+          LOG_TOPIC("e38b9", ERR, Logger::COMPACTOR)
+              << "caught exception during compaction: " << ex.what();
+        } catch (...) {
+          // in case an error occurs, we must still relase the lock
+          LOG_TOPIC("e9a26", ERR, Logger::COMPACTOR)
+              << "an unknown exception occurred during compaction";
+        }
+      }
+    };
+
+    // compaction blockers are checked for each collection, so that a
+    // replication client does not have to wait for a full pass
+    engine->tryRunCompaction(&_vocbase, [&collection, &callback](TRI_vocbase_t*) {
+      collection->tryExecuteWhileStatusLocked(callback);
+    });
+
+    if (worked) {
+      ++numCompacted;
+
+      // signal the cleanup thread that we worked and that it can now
+      // wake up
+      {
+        CONDITION_LOCKER(locker, _condition);
+        locker.signal();
+      }
+
+      // stay within the configured I/O rate. the locks are released already
+      double const until =
+          MMFilesCompactionFeature::COMPACTOR->throttle(_bytesCompacted, started);
+      double now = TRI_microtime();
+      while (now < until && !isStopping()) {
+        CONDITION_LOCKER(locker, _condition);
+        locker.wait(static_cast<uint64_t>((until - now) * 1000000.0));
+        now = TRI_microtime();
+      }
+    }
+  }
+
+  return numCompacted;
+}
+
+void MMFilesCompactorThread::run() {
+  MMFilesEngine* engine = static_cast<MMFilesEngine*>(EngineSelectorFeature::ENGINE);
+  while (true) {
+    // keep initial _state value as vocbase->_state might change during
+    // compaction loop
+    TRI_vocbase_t::State state = _vocbase.state();
+
+    try {
+      size_t numCompacted = 0;
+
+      if (!engine->isCompactionDisabled()) {
+        numCompacted = compactCollections();
+      }
 
       if (numCompacted > 0) {
         // no need to sleep long or go into wait state if we worked.
@@ -93,6 +93,10 @@ class MMFilesCompactorThread final : public Thread {
   /// @brief compact the specified datafiles
   void compactDatafiles(LogicalCollection* collection, std::vector<CompactionInfo> const&);
 
+  /// @brief compacts the collections of the database, the ones with the
+  /// most dead bytes first. returns the number of collections compacted
+  size_t compactCollections();
+
   /// @brief checks all datafiles of a collection
   bool compactCollection(LogicalCollection* collection, bool& wasBlocked);
 
@@ -110,6 +114,9 @@ class MMFilesCompactorThread final : public Thread {
 
   TRI_vocbase_t& _vocbase;
   arangodb::basics::ConditionVariable _condition;
+
+  /// @brief bytes read and written by the compaction of the current collection
+  uint64_t _bytesCompacted;
 };
 
 }  // namespace arangodb
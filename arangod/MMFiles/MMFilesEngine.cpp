@@ -2570,6 +2570,32 @@ bool MMFilesEngine::tryPreventCompaction(TRI_vocbase_t* vocbase,
   return false;
 }
 
+bool MMFilesEngine::tryRunCompaction(TRI_vocbase_t* vocbase,
+                                     std::function<void(TRI_vocbase_t*)> const& callback) {
+  TRY_READ_LOCKER(locker, _compactionBlockersLock);
+
+  if (!locker.isLocked()) {
+    return false;
+  }
+
+  double const now = TRI_microtime();
+
+  // check if we have a still-valid compaction blocker
+  auto it = _compactionBlockers.find(vocbase);
+
+  if (it != _compactionBlockers.end()) {
+    for (auto const& blocker : (*it).second) {
+      if (blocker._expires > now) {
+        // found a compaction blocker
+        return false;
+      }
+    }
+  }
+
+  callback(vocbase);
+  return true;
+}
+
 int MMFilesEngine::shutdownDatabase(TRI_vocbase_t& vocbase) {
   try {
     stopCompactor(&vocbase);
@@ -2633,36 +2659,39 @@ int MMFilesEngine::stopCleanup(TRI_vocbase_t* vocbase) {
   return TRI_ERROR_NO_ERROR;
 }
 
-// start the compactor thread for the database
+// start the compactor threads for the database
 int MMFilesEngine::startCompactor(TRI_vocbase_t& vocbase) {
-  std::shared_ptr<MMFilesCompactorThread> thread;
+  MUTEX_LOCKER(locker, _threadsLock);
 
-  {
-    MUTEX_LOCKER(locker, _threadsLock);
+  auto it = _compactorThreads.find(&vocbase);
 
-    auto it = _compactorThreads.find(&vocbase);
+  if (it != _compactorThreads.end()) {
+    return TRI_ERROR_INTERNAL;
+  }
 
-    if (it != _compactorThreads.end()) {
-      return TRI_ERROR_INTERNAL;
-    }
+  auto& threads = _compactorThreads[&vocbase];
+  size_t const n = MMFilesCompactionFeature::COMPACTOR->threads();
 
-    thread.reset(new MMFilesCompactorThread(vocbase));
+  for (size_t i = 0; i < n; ++i) {
+    auto thread = std::make_shared<MMFilesCompactorThread>(vocbase);
 
     if (!thread->start()) {
       LOG_TOPIC("3addc", ERR, arangodb::Logger::COMPACTOR)
           << "could not start compactor thread";
+      // the threads started so far are stopped by their destructors
+      _compactorThreads.erase(&vocbase);
       THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
     }
 
-    _compactorThreads.emplace(&vocbase, std::move(thread));
+    threads.emplace_back(std::move(thread));
   }
 
   return TRI_ERROR_NO_ERROR;
 }
 
-// signal the compactor thread to stop
+// signal the compactor threads to stop
 int MMFilesEngine::beginShutdownCompactor(TRI_vocbase_t* vocbase) {
-  std::shared_ptr<MMFilesCompactorThread> thread;
+  std::vector<std::shared_ptr<MMFilesCompactorThread>> threads;
 
   {
     MUTEX_LOCKER(locker, _threadsLock);
@@ -2674,20 +2703,22 @@ int MMFilesEngine::beginShutdownCompactor(TRI_vocbase_t* vocbase) {
       return TRI_ERROR_NO_ERROR;
     }
 
-    thread = (*it).second;
+    threads = (*it).second;
   }
 
-  TRI_ASSERT(thread != nullptr);
+  for (auto& thread : threads) {
+    TRI_ASSERT(thread != nullptr);
 
-  thread->beginShutdown();
-  thread->signal();
+    thread->beginShutdown();
+    thread->signal();
+  }
 
   return TRI_ERROR_NO_ERROR;
 }
 
-// stop and delete the compactor thread for the database
+// stop and delete the compactor threads for the database
 int MMFilesEngine::stopCompactor(TRI_vocbase_t* vocbase) {
-  std::shared_ptr<MMFilesCompactorThread> thread;
+  std::vector<std::shared_ptr<MMFilesCompactorThread>> threads;
 
   {
     MUTEX_LOCKER(locker, _threadsLock);
@@ -2699,17 +2730,21 @@ int MMFilesEngine::stopCompactor(TRI_vocbase_t* vocbase) {
       return TRI_ERROR_NO_ERROR;
     }
 
-    thread = (*it).second;
+    threads = std::move((*it).second);
     _compactorThreads.erase(it);
   }
 
-  TRI_ASSERT(thread != nullptr);
+  for (auto& thread : threads) {
+    TRI_ASSERT(thread != nullptr);
 
-  thread->beginShutdown();
-  thread->signal();
+    thread->beginShutdown();
+    thread->signal();
+  }
 
-  while (thread->isRunning()) {
-    std::this_thread::sleep_for(std::chrono::microseconds(5000));
+  for (auto& thread : threads) {
+    while (thread->isRunning()) {
+      std::this_thread::sleep_for(std::chrono::microseconds(5000));
+    }
   }
 
   return TRI_ERROR_NO_ERROR;
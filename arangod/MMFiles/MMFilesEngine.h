@@ -328,6 +328,12 @@ class MMFilesEngine final : public StorageEngine {
                             std::function<void(TRI_vocbase_t*)> const& callback,
                             bool checkForActiveBlockers);
 
+  /// @brief a callback function of a compactor thread that is run while there
+  /// is no active compaction blocker. other compactor threads may run their
+  /// callbacks at the same time
+  bool tryRunCompaction(TRI_vocbase_t* vocbase,
+                        std::function<void(TRI_vocbase_t*)> const& callback);
+
   int shutdownDatabase(TRI_vocbase_t& vocbase) override;
 
   int openCollection(TRI_vocbase_t* vocbase, LogicalCollection* collection, bool ignoreErrors);
@@ -502,7 +508,7 @@ class MMFilesEngine final : public StorageEngine {
   // lock for threads
   arangodb::Mutex _threadsLock;
   // per-database compactor threads, protected by _threadsLock
-  std::unordered_map<TRI_vocbase_t*, std::shared_ptr<MMFilesCompactorThread>> _compactorThreads;
+  std::unordered_map<TRI_vocbase_t*, std::vector<std::shared_ptr<MMFilesCompactorThread>>> _compactorThreads;
   // per-database cleanup threads, protected by _threadsLock
   std::unordered_map<TRI_vocbase_t*, std::shared_ptr<MMFilesCleanupThread>> _cleanupThreads;
 
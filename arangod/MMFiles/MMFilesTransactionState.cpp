@@ -172,6 +172,12 @@ Result MMFilesTransactionState::commitTransaction(transaction::Methods* activeTr
 
     updateStatus(transaction::Status::COMMITTED);
 
+    for (auto& trxCollection : _collections) {
+      if (trxCollection->hasOperations()) {
+        trxCollection->collection()->bumpInvalidationTick();
+      }
+    }
+
     // if a write query, clear the query cache for the participating collections
     if (AccessMode::isWriteOrExclusive(_type) && !_collections.empty() &&
         !isSingleOperation() && arangodb::aql::QueryCache::instance()->mayBeActive()) {
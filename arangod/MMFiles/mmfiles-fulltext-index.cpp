@@ -1170,21 +1170,22 @@ int TRI_InsertWordsMMFilesFulltextIndex(TRI_fts_index_t* ftx, LocalDocumentId co
 /// note: this will free the query
 std::set<TRI_voc_rid_t> TRI_QueryMMFilesFulltextIndex(TRI_fts_index_t* const ftx,
                                                       TRI_fulltext_query_t* query) {
-  std::set<TRI_voc_rid_t> result;
-
   if (query == nullptr) {
-    return result;
+    return std::set<TRI_voc_rid_t>();
   }
 
   TRI_DEFER(TRI_FreeQueryMMFilesFulltextIndex(query));
 
   if (query->_numWords == 0) {
     // query is empty
-    return result;
+    return std::set<TRI_voc_rid_t>();
   }
 
   index__t* idx = static_cast<index__t*>(ftx);
 
+  // sorted document ids, cheaper to combine than sets
+  std::vector<TRI_voc_rid_t> result;
+
   // initial result is empty
   std::set<TRI_voc_rid_t> current;
   bool first = true;
@@ -1215,6 +1216,17 @@ std::set<TRI_voc_rid_t> TRI_QueryMMFilesFulltextIndex(TRI_fts_index_t* const ftx
     current.clear();
 
     node = FindNode(idx, word, strlen(word));
+
+    if (operation == TRI_FULLTEXT_AND && match == TRI_FULLTEXT_COMPLETE && !first) {
+      // intersect the previous result with the word's list directly
+      if (node == nullptr) {
+        result.clear();
+      } else {
+        TRI_IntersectListMMFilesFulltextIndex(node->_docs, result);
+      }
+      continue;
+    }
+
     if (node != nullptr) {
       if (match == TRI_FULLTEXT_COMPLETE) {
         // complete matching
@@ -1231,24 +1243,25 @@ std::set<TRI_voc_rid_t> TRI_QueryMMFilesFulltextIndex(TRI_fts_index_t* const ftx
     if (operation == TRI_FULLTEXT_AND) {
       // perform a logical AND of current and previous result (if any)
       if (first) {
-        result = std::move(current);
+        result.assign(current.begin(), current.end());
       } else {
-        std::set<TRI_voc_rid_t> output;
+        std::vector<TRI_voc_rid_t> output;
         std::set_intersection(result.begin(), result.end(), current.begin(),
-                              current.end(), std::inserter(output, output.begin()));
+                              current.end(), std::back_inserter(output));
         result = std::move(output);
       }
     } else if (operation == TRI_FULLTEXT_OR) {
       // perform a logical OR of current and previous result (if any)
-      std::set<TRI_voc_rid_t> output;
+      std::vector<TRI_voc_rid_t> output;
+      output.reserve(result.size() + current.size());
       std::set_union(result.begin(), result.end(), current.begin(),
-                     current.end(), std::inserter(output, output.begin()));
+                     current.end(), std::back_inserter(output));
       result = std::move(output);
     } else if (operation == TRI_FULLTEXT_EXCLUDE) {
       // perform a logical exclusion of current from previous result (if any)
-      std::set<TRI_voc_rid_t> output;
+      std::vector<TRI_voc_rid_t> output;
       std::set_difference(result.begin(), result.end(), current.begin(),
-                          current.end(), std::inserter(output, output.begin()));
+                          current.end(), std::back_inserter(output));
       result = std::move(output);
     }
 
@@ -1257,16 +1270,11 @@ std::set<TRI_voc_rid_t> TRI_QueryMMFilesFulltextIndex(TRI_fts_index_t* const ftx
 
   auto maxResults = query->_maxResults;
   if (maxResults > 0 && result.size() > maxResults) {
-    auto it = result.begin();
-    while (it != result.end() && maxResults > 0) {
-      --maxResults;
-      ++it;
-    }
-
-    result.erase(it, result.end());
+    result.resize(maxResults);
   }
 
-  return result;
+  // the vector is sorted, so the set can be built in linear time
+  return std::set<TRI_voc_rid_t>(result.begin(), result.end());
 }
 
 /// @brief return stats about the index
@@ -36,6 +36,8 @@
 
 #include "Logger/Logger.h"
 
+#include <algorithm>
+
 /// @brief return whether the list is sorted
 /// this will check the sorted bit at the start of the list
 static inline bool IsSorted(TRI_fulltext_list_t const* list) {
@@ -130,10 +132,11 @@ static uint32_t FindListEntry(TRI_fulltext_list_t* list, TRI_fulltext_list_entry
 }
 
 /// @brief initialize a new list
+/// an empty list is sorted, appending ascending document ids keeps it sorted
 static void InitList(TRI_fulltext_list_t* list, uint32_t size) {
   uint32_t* head = (uint32_t*)list;
 
-  *(head++) = size;
+  *(head++) = size | SORTED_BIT;
   *(head) = 0;
 }
 
@@ -146,10 +149,12 @@ static inline size_t MemoryList(uint32_t size) {
 
 /// @brief increase an existing list
 static TRI_fulltext_list_t* IncreaseList(TRI_fulltext_list_t* list, uint32_t size) {
+  bool const sorted = IsSorted(list);
   TRI_fulltext_list_t* copy = TRI_Reallocate(list, MemoryList(size));
 
   if (copy != nullptr) {
     InitList(copy, size);
+    SetIsSorted(copy, sorted);
   }
 
   return copy;
@@ -170,6 +175,58 @@ void TRI_CloneListMMFilesFulltextIndex(TRI_fulltext_list_t const* source,
   }
 }
 
+/// @brief intersect the sorted entries with the sorted result, in place
+/// gallops through the entries, so the costs depend on the size of the
+/// (usually much smaller) result rather than on the size of the list
+static void IntersectSorted(TRI_fulltext_list_entry_t const* entries,
+                            size_t numEntries, std::vector<TRI_voc_rid_t>& result) {
+  size_t pos = 0;
+  size_t out = 0;
+
+  for (size_t i = 0; i < result.size() && pos < numEntries; ++i) {
+    TRI_voc_rid_t const value = result[i];
+
+    // exponential search for a range containing the first entry >= value
+    size_t bound = 1;
+    while (pos + bound < numEntries && entries[pos + bound] < value) {
+      pos += bound;
+      bound *= 2;
+    }
+
+    TRI_fulltext_list_entry_t const* end =
+        entries + std::min(pos + bound + 1, numEntries);
+    pos = std::lower_bound(entries + pos, end, value) - entries;
+
+    if (pos < numEntries && entries[pos] == value) {
+      result[out++] = value;
+      ++pos;
+    }
+  }
+
+  result.resize(out);
+}
+
+void TRI_IntersectListMMFilesFulltextIndex(TRI_fulltext_list_t const* source,
+                                           std::vector<TRI_voc_rid_t>& result) {
+  if (source == nullptr) {
+    result.clear();
+    return;
+  }
+
+  uint32_t numEntries = GetNumEntries(source);
+  TRI_fulltext_list_entry_t const* entries = GetStart(source);
+
+  if (IsSorted(source)) {
+    IntersectSorted(entries, numEntries, result);
+    return;
+  }
+
+  // lists are only sorted in place by writers, work on a sorted copy
+  std::vector<TRI_fulltext_list_entry_t> sorted(entries, entries + numEntries);
+  std::sort(sorted.begin(), sorted.end());
+  IntersectSorted(sorted.data(), sorted.size(), result);
+}
+
 /// @brief clone a list by copying an existing one
 TRI_fulltext_list_t* TRI_CloneListMMFilesFulltextIndex(TRI_fulltext_list_t const* source) {
   uint32_t numEntries;
@@ -186,6 +243,7 @@ TRI_fulltext_list_t* TRI_CloneListMMFilesFulltextIndex(TRI_fulltext_list_t const
     if (numEntries > 0) {
       memcpy(GetStart(list), GetStart(source), numEntries * sizeof(TRI_fulltext_list_entry_t));
       SetNumEntries(list, numEntries);
+      SetIsSorted(list, IsSorted(source));
     }
   }
 
@@ -25,6 +25,7 @@
 #define ARANGOD_MMFILES_MMFILES_FULLTEXT_LIST_H 1
 
 #include <set>
+#include <vector>
 
 #include "VocBase/voc-types.h"
 #include "mmfiles-fulltext-common.h"
@@ -41,6 +42,10 @@ void TRI_CloneListMMFilesFulltextIndex(TRI_fulltext_list_t const*,
 
 TRI_fulltext_list_t* TRI_CloneListMMFilesFulltextIndex(TRI_fulltext_list_t const*);
 
+/// @brief intersect a sorted vector of document ids with a list, in place
+void TRI_IntersectListMMFilesFulltextIndex(TRI_fulltext_list_t const*,
+                                           std::vector<TRI_voc_rid_t>& result);
+
 /// @brief create a list
 TRI_fulltext_list_t* TRI_CreateListMMFilesFulltextIndex(uint32_t);
 
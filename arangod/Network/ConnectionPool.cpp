@@ -0,0 +1,157 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "ConnectionPool.h"
+
+#include "Basics/ReadLocker.h"
+#include "Basics/WriteLocker.h"
+#include "GeneralServer/AuthenticationFeature.h"
+#include "Logger/Logger.h"
+
+#include <fuerte/connection.h>
+
+using namespace arangodb;
+using namespace arangodb::network;
+
+ConnectionPool::ConnectionPool(ConnectionPool::Config const& config)
+    : _config(config),
+      _shutdown(false),
+      _loop(std::max(config.numIOThreads, 1U)) {
+  TRI_ASSERT(_config.maxOpenConnections > 0);
+}
+
+ConnectionPool::~ConnectionPool() { shutdown(); }
+
+std::shared_ptr<fuerte::Connection> ConnectionPool::leaseConnection(std::string const& endpoint) {
+  WRITE_LOCKER(guard, _lock);
+  if (_shutdown) {
+    return nullptr;
+  }
+  return selectConnection(_connections[endpoint], endpoint);
+}
+
+void ConnectionPool::drainConnections() {
+  WRITE_LOCKER(guard, _lock);
+  for (auto& it : _connections) {
+    for (auto& ctx : it.second) {
+      ctx.connection->cancel();
+    }
+  }
+  _connections.clear();
+}
+
+void ConnectionPool::shutdown() {
+  {
+    WRITE_LOCKER(guard, _lock);
+    _shutdown = true;
+  }
+  drainConnections();
+}
+
+void ConnectionPool::pruneConnections() {
+  auto const now = std::chrono::steady_clock::now();
+
+  WRITE_LOCKER(guard, _lock);
+  for (auto it = _connections.begin(); it != _connections.end(); /* no hoisting */) {
+    auto& list = it->second;
+    for (auto c = list.begin(); c != list.end(); /* no hoisting */) {
+      auto state = c->connection->state();
+      bool remove = (state == fuerte::Connection::State::Failed);
+      if (!remove && c->connection->requestsLeft() == 0 &&
+          (now - c->lastLeased) > _config.idleConnectionTimeout) {
+        remove = true;
+      }
+      if (remove) {
+        LOG_TOPIC("4e7a1", DEBUG, Logger::COMMUNICATION)
+            << "closing connection to '" << it->first << "'";
+        c->connection->cancel();
+        c = list.erase(c);
+      } else {
+        ++c;
+      }
+    }
+    if (list.empty()) {
+      it = _connections.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+size_t ConnectionPool::numOpenConnections() const {
+  size_t result = 0;
+  READ_LOCKER(guard, _lock);
+  for (auto const& it : _connections) {
+    result += it.second.size();
+  }
+  return result;
+}
+
+std::shared_ptr<fuerte::Connection> ConnectionPool::selectConnection(
+    std::vector<ConnectionPool::Context>& list, std::string const& endpoint) {
+  Context* best = nullptr;
+  size_t bestLoad = SIZE_MAX;
+  for (auto c = list.begin(); c != list.end(); /* no hoisting */) {
+    if (c->connection->state() == fuerte::Connection::State::Failed) {
+      c->connection->cancel();
+      c = list.erase(c);
+      continue;
+    }
+    size_t load = c->connection->requestsLeft();
+    if (load < bestLoad) {
+      best = &(*c);
+      bestLoad = load;
+    }
+    ++c;
+  }
+
+  // prefer opening another connection over queueing too many requests on
+  // an existing one, as long as we are below the limit
+  if (best == nullptr || (bestLoad >= _config.maxRequestsPerConnection &&
+                          list.size() < _config.maxOpenConnections)) {
+    list.push_back(Context{createConnection(endpoint), std::chrono::steady_clock::now()});
+    return list.back().connection;
+  }
+
+  best->lastLeased = std::chrono::steady_clock::now();
+  return best->connection;
+}
+
+std::shared_ptr<fuerte::Connection> ConnectionPool::createConnection(std::string const& endpoint) {
+  fuerte::ConnectionBuilder builder;
+  builder.endpoint(endpoint);
+  // cluster endpoints are stored as "tcp://" or "ssl://", which fuerte
+  // maps to HTTP. override the protocol with the configured one
+  builder.protocolType(_config.protocol);
+
+  AuthenticationFeature* af = AuthenticationFeature::instance();
+  if (af != nullptr && af->isActive()) {
+    std::string const& token = af->tokenCache().jwtToken();
+    if (!token.empty()) {
+      builder.jwtToken(token);
+      builder.authenticationType(fuerte::AuthenticationType::Jwt);
+    }
+  }
+
+  LOG_TOPIC("4e7a2", DEBUG, Logger::COMMUNICATION)
+      << "opening " << fuerte::to_string(_config.protocol)
+      << " connection to '" << endpoint << "'";
+  return builder.connect(_loop);
+}
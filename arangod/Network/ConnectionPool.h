@@ -0,0 +1,122 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_NETWORK_CONNECTION_POOL_H
+#define ARANGOD_NETWORK_CONNECTION_POOL_H 1
+
+#include "Basics/Common.h"
+#include "Basics/ReadWriteLock.h"
+
+#include <fuerte/loop.h>
+#include <fuerte/types.h>
+
+#include <chrono>
+#include <unordered_map>
+
+namespace arangodb {
+namespace fuerte {
+inline namespace v1 {
+class Connection;
+class ConnectionBuilder;
+}  // namespace v1
+}  // namespace fuerte
+
+namespace network {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief simple connection pool managing fuerte connections to the other
+/// servers of the cluster.
+///
+/// Connections are multiplexed, i.e. one connection can carry many requests
+/// at the same time. A new connection to an endpoint is only opened if all
+/// existing connections are busy and the per-endpoint limit is not yet
+/// reached. Idle connections are closed after a configurable time.
+////////////////////////////////////////////////////////////////////////////////
+class ConnectionPool final {
+ public:
+  struct Config {
+    /// @brief number of I/O threads driving the connections
+    unsigned numIOThreads = 1;
+    /// @brief maximum number of connections per endpoint
+    size_t maxOpenConnections = 4;
+    /// @brief number of in-flight requests above which a connection is
+    /// considered busy
+    size_t maxRequestsPerConnection = 256;
+    /// @brief idle connections are closed after this time
+    std::chrono::milliseconds idleConnectionTimeout{60000};
+    /// @brief protocol to use for all connections
+    fuerte::ProtocolType protocol = fuerte::ProtocolType::Vst;
+  };
+
+ public:
+  explicit ConnectionPool(Config const& config);
+  ~ConnectionPool();
+
+  ConnectionPool(ConnectionPool const&) = delete;
+  ConnectionPool& operator=(ConnectionPool const&) = delete;
+
+  /// @brief request a connection for the specified endpoint.
+  /// the returned connection may be shared with other requests
+  std::shared_ptr<fuerte::Connection> leaseConnection(std::string const& endpoint);
+
+  /// @brief close all connections, the pool can still be used afterwards
+  void drainConnections();
+
+  /// @brief close all connections and refuse to open new ones
+  void shutdown();
+
+  /// @brief close broken and idle connections
+  void pruneConnections();
+
+  /// @brief return the number of open connections
+  size_t numOpenConnections() const;
+
+  Config const& config() const { return _config; }
+
+ private:
+  struct Context {
+    std::shared_ptr<fuerte::Connection> connection;
+    std::chrono::steady_clock::time_point lastLeased;
+  };
+
+  /// @brief pick the least loaded usable connection, or open a new one.
+  /// must be called with the write lock held on _lock
+  std::shared_ptr<fuerte::Connection> selectConnection(std::vector<Context>& list,
+                                                       std::string const& endpoint);
+
+  /// @brief open a new connection to the endpoint
+  std::shared_ptr<fuerte::Connection> createConnection(std::string const& endpoint);
+
+ private:
+  Config const _config;
+
+  mutable basics::ReadWriteLock _lock;
+  std::unordered_map<std::string, std::vector<Context>> _connections;
+  bool _shutdown;
+
+  /// @brief event loops driving all connections. all connections are
+  /// cancelled in the destructor, so the I/O threads can be joined
+  fuerte::EventLoopService _loop;
+};
+
+}  // namespace network
+}  // namespace arangodb
+
+#endif
@@ -0,0 +1,150 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Methods.h"
+
+#include "Basics/StaticStrings.h"
+#include "Cluster/ClusterInfo.h"
+#include "Futures/Utilities.h"
+#include "Logger/Logger.h"
+#include "Network/ConnectionPool.h"
+#include "Network/NetworkFeature.h"
+
+#include <fuerte/connection.h>
+#include <fuerte/requests.h>
+
+namespace arangodb {
+namespace network {
+
+fuerte::StatusCode Response::statusCode() const {
+  if (response == nullptr) {
+    return fuerte::StatusUndefined;
+  }
+  return response->statusCode();
+}
+
+int Response::errorCode() const { return fuerteToArangoErrorCode(error); }
+
+int fuerteToArangoErrorCode(fuerte::Error err) {
+  switch (err) {
+    case fuerte::Error::NoError:
+      return TRI_ERROR_NO_ERROR;
+
+    case fuerte::Error::CouldNotConnect:
+      return TRI_ERROR_CLUSTER_BACKEND_UNAVAILABLE;
+
+    case fuerte::Error::CloseRequested:
+    case fuerte::Error::ConnectionClosed:
+    case fuerte::Error::ReadError:
+    case fuerte::Error::WriteError:
+      return TRI_ERROR_CLUSTER_CONNECTION_LOST;
+
+    case fuerte::Error::Timeout:
+      return TRI_ERROR_CLUSTER_TIMEOUT;
+
+    case fuerte::Error::QueueCapacityExceeded:
+      return TRI_ERROR_QUEUE_FULL;
+
+    case fuerte::Error::Canceled:
+      return TRI_ERROR_REQUEST_CANCELED;
+
+    case fuerte::Error::ProtocolError:
+    default:
+      return TRI_ERROR_INTERNAL;
+  }
+}
+
+std::string resolveDestination(DestinationId const& dest) {
+  if (dest.compare(0, 6, "tcp://") == 0 || dest.compare(0, 6, "ssl://") == 0) {
+    return dest;
+  }
+
+  auto ci = ClusterInfo::instance();
+  if (ci == nullptr) {
+    return StaticStrings::Empty;
+  }
+
+  std::string serverId;
+  if (dest.compare(0, 6, "shard:") == 0) {
+    std::shared_ptr<std::vector<ServerID>> resp =
+        ci->getResponsibleServer(dest.substr(6));
+    if (resp->empty()) {
+      LOG_TOPIC("4e7a5", DEBUG, Logger::COMMUNICATION)
+          << "cannot find responsible server for '" << dest << "'";
+      return StaticStrings::Empty;
+    }
+    serverId = (*resp)[0];
+  } else if (dest.compare(0, 7, "server:") == 0) {
+    serverId = dest.substr(7);
+  } else {
+    LOG_TOPIC("4e7a6", DEBUG, Logger::COMMUNICATION)
+        << "did not understand destination '" << dest << "'";
+    return StaticStrings::Empty;
+  }
+
+  return ci->getServerEndpoint(serverId);
+}
+
+FutureRes sendRequest(DestinationId const& destination, fuerte::RestVerb type,
+                      std::string const& path, velocypack::Buffer<uint8_t> payload,
+                      Timeout timeout, Headers const& headers) {
+  ConnectionPool* pool = NetworkFeature::pool();
+  if (pool == nullptr) {
+    return futures::makeFuture(Response{destination, fuerte::Error::Canceled, nullptr});
+  }
+
+  std::string endpoint = resolveDestination(destination);
+  if (endpoint.empty()) {
+    return futures::makeFuture(Response{destination, fuerte::Error::CouldNotConnect, nullptr});
+  }
+
+  auto req = fuerte::createRequest(type, fuerte::ContentType::VPack);
+  // handles a "/_db/<name>" prefix
+  req->header.parseArangoPath(path);
+  req->header.addMeta(headers);
+  if (payload.size() > 0) {
+    req->addVPack(std::move(payload));
+  }
+  req->timeout(std::chrono::duration_cast<std::chrono::milliseconds>(timeout));
+
+  std::shared_ptr<fuerte::Connection> conn;
+  try {
+    conn = pool->leaseConnection(endpoint);
+  } catch (std::exception const& ex) {
+    LOG_TOPIC("4e7a7", DEBUG, Logger::COMMUNICATION)
+        << "unable to connect to '" << endpoint << "': " << ex.what();
+  }
+  if (conn == nullptr) {
+    return futures::makeFuture(Response{destination, fuerte::Error::CouldNotConnect, nullptr});
+  }
+
+  // the callback of fuerte must be copyable, but promises are not
+  auto p = std::make_shared<futures::Promise<Response>>();
+  auto f = p->getFuture();
+  conn->sendRequest(std::move(req),
+                    [p, destination](fuerte::Error err, std::unique_ptr<fuerte::Request>,
+                                     std::unique_ptr<fuerte::Response> res) {
+                      p->setValue(Response{destination, err, std::move(res)});
+                    });
+  return f;
+}
+
+}  // namespace network
+}  // namespace arangodb
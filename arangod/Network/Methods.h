@@ -0,0 +1,79 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_NETWORK_METHODS_H
+#define ARANGOD_NETWORK_METHODS_H 1
+
+#include "Basics/Common.h"
+#include "Futures/Future.h"
+
+#include <fuerte/message.h>
+#include <fuerte/types.h>
+#include <velocypack/Buffer.h>
+
+#include <chrono>
+
+namespace arangodb {
+namespace network {
+
+/// @brief destination of a request. Either "shard:<shardId>",
+/// "server:<serverId>" or a plain endpoint such as "tcp://host:port"
+using DestinationId = std::string;
+using Headers = std::map<std::string, std::string>;
+using Timeout = std::chrono::duration<double>;
+
+/// @brief result of a request sent via the connection pool
+struct Response {
+  DestinationId destination;
+  fuerte::Error error = fuerte::Error::NoError;
+  std::unique_ptr<fuerte::Response> response;
+
+  bool ok() const {
+    return fuerte::Error::NoError == error && response != nullptr;
+  }
+
+  /// @brief HTTP status code of the response, 0 if there is none
+  fuerte::StatusCode statusCode() const;
+
+  /// @brief converts the fuerte error into an arangodb error code
+  int errorCode() const;
+};
+
+using FutureRes = arangodb::futures::Future<Response>;
+
+/// @brief send a request to a cluster-internal destination. The returned
+/// future is fulfilled on one of the network I/O threads, so continuations
+/// must not block. Continuations that do real work should be moved to the
+/// scheduler with `.via(SchedulerExecutor::lane(...))`
+FutureRes sendRequest(DestinationId const& destination, fuerte::RestVerb type,
+                      std::string const& path, velocypack::Buffer<uint8_t> payload,
+                      Timeout timeout, Headers const& headers = {});
+
+/// @brief resolve a destination to an endpoint. returns an empty string if
+/// the destination is unknown
+std::string resolveDestination(DestinationId const& destination);
+
+/// @brief converts a fuerte error into an arangodb error code
+int fuerteToArangoErrorCode(fuerte::Error err);
+
+}  // namespace network
+}  // namespace arangodb
+
+#endif
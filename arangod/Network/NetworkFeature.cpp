@@ -0,0 +1,149 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "NetworkFeature.h"
+
+#include "ApplicationFeatures/ApplicationServer.h"
+#include "Logger/Logger.h"
+#include "Network/ConnectionPool.h"
+#include "ProgramOptions/Parameters.h"
+#include "ProgramOptions/ProgramOptions.h"
+#include "Scheduler/SchedulerFeature.h"
+
+using namespace arangodb::application_features;
+using namespace arangodb::basics;
+using namespace arangodb::options;
+
+namespace arangodb {
+
+std::atomic<network::ConnectionPool*> NetworkFeature::POOL(nullptr);
+
+NetworkFeature::NetworkFeature(application_features::ApplicationServer& server)
+    : ApplicationFeature(server, "Network"),
+      _numIOThreads(2),
+      _maxOpenConnections(4),
+      _idleTtlMilli(60000),
+      _protocol("vst"),
+      _workItem(nullptr),
+      _gcfunc() {
+  setOptional(true);
+  startsAfter("DatabasePhase");
+  startsAfter("Scheduler");
+
+  _gcfunc = [this](bool canceled) {
+    if (canceled) {
+      return;
+    }
+
+    _pool->pruneConnections();
+
+    auto off = std::chrono::seconds(3);
+
+    std::lock_guard<std::mutex> guard(_workItemMutex);
+    if (!ApplicationServer::isStopping()) {
+      _workItem = SchedulerFeature::SCHEDULER->queueDelay(RequestLane::INTERNAL_LOW, off, _gcfunc);
+    }
+  };
+}
+
+void NetworkFeature::collectOptions(std::shared_ptr<options::ProgramOptions> options) {
+  options->addSection("network", "Configure cluster-internal communication");
+
+  options->addOption("--network.io-threads",
+                     "number of network I/O threads",
+                     new UInt64Parameter(&_numIOThreads));
+
+  options->addOption("--network.max-open-connections",
+                     "maximum number of open connections per endpoint",
+                     new UInt64Parameter(&_maxOpenConnections));
+
+  options->addOption("--network.idle-connection-ttl",
+                     "time in milliseconds after which idle connections are closed",
+                     new UInt64Parameter(&_idleTtlMilli));
+
+  std::unordered_set<std::string> protocols = {"http", "vst"};
+  options->addOption("--network.protocol",
+                     "protocol used for cluster-internal requests",
+                     new DiscreteValuesParameter<StringParameter>(&_protocol, protocols));
+}
+
+void NetworkFeature::validateOptions(std::shared_ptr<options::ProgramOptions>) {
+  if (_numIOThreads < 1 || _numIOThreads > 64) {
+    // an epoll instance is created per I/O thread
+    LOG_TOPIC("4e7a3", FATAL, Logger::CONFIG)
+        << "invalid value for `--network.io-threads', need a value between 1 and 64";
+    FATAL_ERROR_EXIT();
+  }
+  if (_maxOpenConnections < 1) {
+    LOG_TOPIC("4e7a4", FATAL, Logger::CONFIG)
+        << "invalid value for `--network.max-open-connections', need at least 1";
+    FATAL_ERROR_EXIT();
+  }
+}
+
+void NetworkFeature::prepare() {
+  network::ConnectionPool::Config config;
+  config.numIOThreads = static_cast<unsigned>(_numIOThreads);
+  config.maxOpenConnections = static_cast<size_t>(_maxOpenConnections);
+  config.idleConnectionTimeout = std::chrono::milliseconds(_idleTtlMilli);
+  config.protocol = (_protocol == "http") ? fuerte::ProtocolType::Http
+                                          : fuerte::ProtocolType::Vst;
+
+  _pool = std::make_unique<network::ConnectionPool>(config);
+  POOL.store(_pool.get(), std::memory_order_release);
+}
+
+void NetworkFeature::start() {
+  Scheduler* scheduler = SchedulerFeature::SCHEDULER;
+  if (scheduler != nullptr) {  // is nullptr in catch tests
+    auto off = std::chrono::seconds(3);
+    std::lock_guard<std::mutex> guard(_workItemMutex);
+    _workItem = scheduler->queueDelay(RequestLane::INTERNAL_LOW, off, _gcfunc);
+  }
+}
+
+void NetworkFeature::beginShutdown() {
+  {
+    std::lock_guard<std::mutex> guard(_workItemMutex);
+    _workItem.reset();
+  }
+  if (_pool != nullptr) {
+    // cancels all in-flight requests. their futures are fulfilled with
+    // an error
+    _pool->drainConnections();
+  }
+}
+
+void NetworkFeature::stop() {
+  {
+    std::lock_guard<std::mutex> guard(_workItemMutex);
+    _workItem.reset();
+  }
+  if (_pool != nullptr) {
+    _pool->shutdown();
+  }
+}
+
+void NetworkFeature::unprepare() {
+  POOL.store(nullptr, std::memory_order_release);
+  _pool.reset();
+}
+
+}  // namespace arangodb
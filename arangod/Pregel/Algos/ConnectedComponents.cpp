@@ -27,6 +27,7 @@
 #include "Pregel/GraphStore.h"
 #include "Pregel/IncomingCache.h"
 #include "Pregel/VertexComputation.h"
+#include "VocBase/ticks.h"
 
 using namespace arangodb::pregel;
 using namespace arangodb::pregel::algos;
@@ -60,9 +61,13 @@ VertexComputation<int64_t, int64_t, int64_t>* ConnectedComponents::createComputa
 
 struct MyGraphFormat final : public VertexGraphFormat<int64_t, int64_t> {
   uint64_t vertexIdRange = 0;
+  std::string const _sourceField;
+  bool const _useSource;
 
-  explicit MyGraphFormat(std::string const& result)
-      : VertexGraphFormat<int64_t, int64_t>(result, 0) {}
+  MyGraphFormat(std::string const& source, std::string const& result, bool useSource)
+      : VertexGraphFormat<int64_t, int64_t>(result, 0),
+        _sourceField(source),
+        _useSource(useSource) {}
 
   void willLoadVertices(uint64_t count) override {
     // if we aren't running in a cluster it doesn't matter
@@ -71,17 +76,28 @@ struct MyGraphFormat final : public VertexGraphFormat<int64_t, int64_t> {
       if (ci) {
         vertexIdRange = ci->uniqid(count);
       }
+    } else if (_useSource) {
+      // new vertices must not get the id of a component of an earlier run
+      vertexIdRange = TRI_NewTickServer();
+      TRI_UpdateTickServer(vertexIdRange + count);
     }
   }
 
   void copyVertexData(std::string const& documentId, arangodb::velocypack::Slice document,
                       int64_t& targetPtr) override {
+    if (_useSource) {
+      arangodb::velocypack::Slice seed = document.get(_sourceField);
+      if (seed.isNumber()) {
+        targetPtr = seed.getNumber<int64_t>();
+        return;
+      }
+    }
     targetPtr = vertexIdRange++;
   }
 };
 
 GraphFormat<int64_t, int64_t>* ConnectedComponents::inputFormat() const {
-  return new MyGraphFormat(_resultField);
+  return new MyGraphFormat(_sourceField, _resultField, _useSource);
 }
 
 struct MyCompensation : public VertexCompensation<int64_t, int64_t, int64_t> {
@@ -34,10 +34,19 @@ namespace algos {
 /// number of supersteps necessary is equal to the length of the maximum
 /// diameter of all components + 1
 /// doesn't necessarily leads to a correct result on unidirected graphs
+///
+/// If "sourceField" is given, the components of an earlier run stored in
+/// this attribute are used as the initial component ids. After edges or
+/// vertices were only added, the components then converge in far fewer
+/// supersteps. This is not valid if edges or vertices were removed.
 struct ConnectedComponents : public SimpleAlgorithm<int64_t, int64_t, int64_t> {
+ private:
+  bool _useSource;
+
  public:
   explicit ConnectedComponents(VPackSlice userParams)
-      : SimpleAlgorithm("ConnectedComponents", userParams) {}
+      : SimpleAlgorithm("ConnectedComponents", userParams),
+        _useSource(userParams.hasKey("sourceField")) {}
 
   bool supportsAsyncMode() const override { return true; }
   bool supportsCompensation() const override { return true; }
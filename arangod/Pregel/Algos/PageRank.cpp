@@ -75,6 +75,10 @@ struct PRComputation : public VertexComputation<float, float, float> {
   PRComputation() {}
   void compute(MessageIterator<float> const& messages) override {
     PRWorkerContext const* ctx = static_cast<PRWorkerContext const*>(context());
+    if (_convergence == nullptr) {
+      // looked up once instead of by name for every vertex
+      _convergence = getWriteAggregator(kConvergence);
+    }
     float* ptr = mutableVertexData();
     float copy = *ptr;
 
@@ -91,7 +95,7 @@ struct PRComputation : public VertexComputation<float, float, float> {
       *ptr = 0.85f * sum + ctx->commonProb;
     }
     float diff = fabs(copy - *ptr);
-    aggregate<float>(kConvergence, diff);
+    _convergence->aggregate(&diff);
 
     size_t numEdges = getEdgeCount();
     if (numEdges > 0) {
@@ -99,6 +103,9 @@ struct PRComputation : public VertexComputation<float, float, float> {
       sendMessageToAllNeighbours(val);
     }
   }
+
+ private:
+  IAggregator* _convergence = nullptr;
 };
 
 VertexComputation<float, float, float>* PageRank::createComputation(WorkerConfig const* config) const {
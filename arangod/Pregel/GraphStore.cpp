@@ -24,6 +24,7 @@
 
 #include "Basics/Common.h"
 #include "Basics/MutexLocker.h"
+#include "Basics/ScopeGuard.h"
 #include "Pregel/CommonFormats.h"
 #include "Pregel/IndexHelpers.h"
 #include "Pregel/PregelFeature.h"
@@ -196,6 +197,31 @@ RangeIterator<Vertex<V, E>> GraphStore<V, E>::vertexIterator(size_t i, size_t j)
                                      numVertices);
 }
 
+template <typename V, typename E>
+std::vector<VertexRange> GraphStore<V, E>::vertexRanges(size_t maxSize) const {
+  TRI_ASSERT(maxSize > 0);
+  std::vector<VertexRange> ranges;
+  for (size_t i = 0; i < _vertices.size(); ++i) {
+    size_t segmentSize = _vertices[i]->size();
+    for (size_t offset = 0; offset < segmentSize; offset += maxSize) {
+      ranges.push_back({i, offset, std::min(maxSize, segmentSize - offset)});
+    }
+  }
+  return ranges;
+}
+
+template <typename V, typename E>
+RangeIterator<Vertex<V, E>> GraphStore<V, E>::vertexIterator(VertexRange const& range) {
+  if (range.size == 0) {
+    return RangeIterator<Vertex<V, E>>(_vertices, 0, nullptr, 0);
+  }
+  TRI_ASSERT(range.segment < _vertices.size());
+  TRI_ASSERT(range.offset + range.size <= _vertices[range.segment]->size());
+  return RangeIterator<Vertex<V, E>>(_vertices, range.segment,
+                                     _vertices[range.segment]->begin() + range.offset,
+                                     range.size);
+}
+
 template <typename V, typename E>
 RangeIterator<Edge<E>> GraphStore<V, E>::edgeIterator(Vertex<V, E> const* entry) {
   if (entry->getEdgeCount() == 0) {
@@ -275,14 +301,18 @@ void GraphStore<V, E>::_loadVertices(ShardID const& vertexShard,
   
   std::vector<std::unique_ptr<TypedBuffer<Vertex<V, E>>>> vertices;
   std::vector<std::unique_ptr<TypedBuffer<char>>> vKeys;
-  std::vector<std::unique_ptr<TypedBuffer<Edge<E>>>> edges;
-  std::vector<std::unique_ptr<TypedBuffer<char>>> eKeys;
+  // the edges of a segment may still be loaded by another thread when we
+  // leave, so the buffers must be handed over in any case
+  TRI_DEFER(std::lock_guard<std::mutex> guard(_bufferMutex);
+            ::moveAppend(vertices, _vertices);
+            ::moveAppend(vKeys, _vertexKeys));
 
   TypedBuffer<Vertex<V, E>>* vertexBuff = nullptr;
   TypedBuffer<char>* keyBuff = nullptr;
   size_t segmentSize = std::min<size_t>(numVertices, vertexSegmentSize());
   
   std::string documentId; // temp buffer for _id of vertex
+  std::string idPrefix; // collection name part of the _id values
   auto cb = [&](LocalDocumentId const& token, VPackSlice slice) {
     if (slice.isExternal()) {
       slice = slice.resolveExternal();
@@ -314,16 +344,17 @@ void GraphStore<V, E>::_loadVertices(ShardID const& vertexShard,
     
     // load vertex data
     documentId = trx.extractIdString(slice);
+    if (idPrefix.empty()) {
+      TRI_ASSERT(documentId.size() > keyLen);
+      idPrefix = documentId.substr(0, documentId.size() - keyLen);
+    }
     if (_graphFormat->estimatedVertexSize() > 0) {
       _graphFormat->copyVertexData(documentId, slice, ventry->_data);
     }
     
+    // edges are loaded once the segment is complete
     ventry->_edges = nullptr;
     ventry->_edgeCount = 0;
-    // load edges
-    for (ShardID const& edgeShard : edgeShards) {
-      _loadEdges(trx, *ventry, edgeShard, documentId, edges, eKeys);
-    }
   };
   
   _localVertexCount += numVertices;
@@ -341,26 +372,93 @@ void GraphStore<V, E>::_loadVertices(ShardID const& vertexShard,
     LOG_TOPIC("b9ed9", DEBUG, Logger::PREGEL) << "Shard '" << vertexShard << "', "
       << numVertices << " remaining vertices";
     segmentSize = std::min<size_t>(numVertices, vertexSegmentSize());
+
+    if (vertexBuff == nullptr || vertexBuff->size() == 0 || edgeShards.empty()) {
+      continue;
+    }
+    if (!hasMore || numVertices == 0) {
+      // the last segment is handled by this thread
+      _loadSegmentEdges(vertexBuff, idPrefix, edgeShards);
+    } else {
+      // load the edges of large shards in parallel, while we continue
+      // to read the vertices of the next segment
+      _runningThreads++;
+      try {
+        Scheduler* scheduler = SchedulerFeature::SCHEDULER;
+        TRI_ASSERT(scheduler);
+        scheduler->queue(RequestLane::INTERNAL_LOW,
+                         [this, vertexBuff, idPrefix, edgeShards] {
+                           TRI_DEFER(_runningThreads--);  // exception safe
+                           try {
+                             _loadSegmentEdges(vertexBuff, idPrefix, edgeShards);
+                           } catch (std::exception const& ex) {
+                             LOG_TOPIC("9a3c7", WARN, Logger::PREGEL) << "caught exception while "
+                                                                      << "loading pregel graph: " << ex.what();
+                           }
+                         });
+      } catch (...) {
+        _runningThreads--;
+        throw;
+      }
+    }
+    // start a new segment
+    vertexBuff = nullptr;
   }
-  
-  std::lock_guard<std::mutex> guard(_bufferMutex);
-  ::moveAppend(vertices, _vertices);
-  ::moveAppend(vKeys, _vertexKeys);
-  ::moveAppend(edges, _edges);
-  ::moveAppend(eKeys, _edgeKeys);
 
   LOG_TOPIC("6d389", DEBUG, Logger::PREGEL)
     << "Pregel worker: done loading from vertex shard " << vertexShard;
 }
 
+/// Loads the edges of all vertices in a segment, using its own transaction.
+/// The edges of every vertex end up adjacent in the edge buffers.
+template <typename V, typename E>
+void GraphStore<V, E>::_loadSegmentEdges(TypedBuffer<Vertex<V, E>>* vertices,
+                                         std::string const& idPrefix,
+                                         std::vector<ShardID> const& edgeShards) {
+  transaction::Options trxOpts;
+  trxOpts.waitForSync = false;
+  trxOpts.allowImplicitCollections = true;
+  auto ctx = transaction::StandaloneContext::Create(_vocbaseGuard.database());
+  transaction::Methods trx(ctx, {}, {}, {}, trxOpts);
+  Result res = trx.begin();
+  if (!res.ok()) {
+    THROW_ARANGO_EXCEPTION(res);
+  }
+
+  std::vector<std::unique_ptr<TypedBuffer<Edge<E>>>> edges;
+  std::vector<std::unique_ptr<TypedBuffer<char>>> eKeys;
+  TRI_DEFER(std::lock_guard<std::mutex> guard(_bufferMutex);
+            ::moveAppend(edges, _edges);
+            ::moveAppend(eKeys, _edgeKeys));
+
+  // the edge index is looked up once per shard, not once per vertex
+  std::vector<std::unique_ptr<traverser::EdgeCollectionInfo>> infos;
+  infos.reserve(edgeShards.size());
+  for (ShardID const& edgeShard : edgeShards) {
+    infos.emplace_back(std::make_unique<traverser::EdgeCollectionInfo>(&trx, edgeShard));
+  }
+
+  std::string documentId = idPrefix;
+  for (Vertex<V, E>* ventry = vertices->begin(); ventry != vertices->end(); ++ventry) {
+    documentId.resize(idPrefix.size());
+    documentId.append(ventry->_key, ventry->_keyLength);
+    for (auto& info : infos) {
+      _loadEdges(trx, *ventry, *info, documentId, edges, eKeys);
+    }
+    if (_destroyed) {
+      LOG_TOPIC("2c8f0", WARN, Logger::PREGEL) << "Aborted loading graph";
+      break;
+    }
+  }
+}
+
 template <typename V, typename E>
 void GraphStore<V, E>::_loadEdges(transaction::Methods& trx, Vertex<V, E>& vertex,
-                                  ShardID const& edgeShard, std::string const& documentID,
+                                  traverser::EdgeCollectionInfo& info,
+                                  std::string const& documentID,
                                   std::vector<std::unique_ptr<TypedBuffer<Edge<E>>>>& edges,
                                   std::vector<std::unique_ptr<TypedBuffer<char>>>& edgeKeys) {
 
-  traverser::EdgeCollectionInfo info(&trx, edgeShard);
-  ManagedDocumentResult mmdr;
   std::unique_ptr<OperationCursor> cursor = info.getEdges(documentID);
   
   TypedBuffer<Edge<E>>* edgeBuff = edges.empty() ? nullptr : edges.back().get();
@@ -462,80 +560,105 @@ void GraphStore<V, E>::_loadEdges(transaction::Methods& trx, Vertex<V, E>& verte
   _localEdgeCount += addedEdges;
 }
 
-/// Loops over the array starting a new transaction for different shards
+/// Loops over the array starting a new transaction for different shards.
+/// Vertices are written as array updates of up to batchSize documents, so
+/// the engine gets one batch instead of one operation per vertex.
 /// Should not dead-lock unless we have to wait really long for other threads
 template <typename V, typename E>
 void GraphStore<V, E>::_storeVertices(std::vector<ShardID> const& globalShards,
                                       RangeIterator<Vertex<V, E>>& it) {
+  constexpr size_t batchSize = 1000;
+
   // transaction on one shard
   std::unique_ptr<arangodb::SingleCollectionTransaction> trx;
   PregelShard currentShard = (PregelShard)-1;
   Result res = TRI_ERROR_NO_ERROR;
-  
+
   VPackBuilder builder;
   size_t numDocs = 0;
-  
+
+  OperationOptions options;
+  // the results of the update are not needed, only the error counts
+  options.silent = true;
+
+  auto flush = [&]() {
+    if (numDocs == 0) {
+      return;
+    }
+    builder.close();
+    ShardID const& shard = globalShards[currentShard];
+    OperationResult opRes = trx->update(shard, builder.slice(), options);
+    if (opRes.fail()) {
+      THROW_ARANGO_EXCEPTION(opRes.result);
+    }
+    // vertices removed or modified concurrently are skipped
+    for (auto const& code : opRes.countErrorCodes) {
+      if (code.first == TRI_ERROR_ARANGO_CONFLICT) {
+        LOG_TOPIC("4e632", WARN, Logger::PREGEL)
+            << "conflict while storing " << code.second << " vertices in "
+            << shard;
+      } else if (code.first != TRI_ERROR_ARANGO_DOCUMENT_NOT_FOUND) {
+        THROW_ARANGO_EXCEPTION(code.first);
+      }
+    }
+    builder.clear();
+    numDocs = 0;
+  };
+
   // loop over vertices
   for (; it.hasMore(); ++it) {
-    if (it->shard() != currentShard || numDocs >= 1000) {
+    if (it->shard() != currentShard || numDocs >= batchSize) {
       if (trx) {
+        flush();
+      }
+      if (trx && it->shard() != currentShard) {
         res = trx->finish(res);
         if (!res.ok()) {
           THROW_ARANGO_EXCEPTION(res);
         }
+        trx.reset();
       }
-      
-      currentShard = it->shard();
-      
-      auto ctx = transaction::StandaloneContext::Create(_vocbaseGuard.database());
-      ShardID const& shard = globalShards[currentShard];
-      transaction::Options to;
-      trx.reset(new SingleCollectionTransaction(ctx, shard, AccessMode::Type::WRITE));
-      trx->addHint(transaction::Hints::Hint::INTERMEDIATE_COMMITS);
-      res = trx->begin();
-      if (!res.ok()) {
-        THROW_ARANGO_EXCEPTION(res);
+
+      if (!trx) {
+        currentShard = it->shard();
+
+        auto ctx = transaction::StandaloneContext::Create(_vocbaseGuard.database());
+        ShardID const& shard = globalShards[currentShard];
+        trx.reset(new SingleCollectionTransaction(ctx, shard, AccessMode::Type::WRITE));
+        trx->addHint(transaction::Hints::Hint::INTERMEDIATE_COMMITS);
+        res = trx->begin();
+        if (!res.ok()) {
+          THROW_ARANGO_EXCEPTION(res);
+        }
       }
-      numDocs = 0;
     }
-    
+
+    if (_destroyed) {
+      LOG_TOPIC("73ec2", WARN, Logger::PREGEL)
+          << "Storing data was canceled prematurely";
+      trx->abort();
+      trx.reset();
+      break;
+    }
+
+    if (numDocs == 0) {
+      builder.openArray();
+    }
+
     VPackStringRef const key = it->key();
     V const& data = it->data();
-    
-    builder.clear();
-    // This loop will fill a buffer of vertices until we run into a new
-    // collection
-    // or there are no more vertices for to store (or the buffer is full)
+
     builder.openObject();
     builder.add(StaticStrings::KeyString, VPackValuePair(key.data(), key.size(),
                                                          VPackValueType::String));
     /// bool store =
     _graphFormat->buildVertexDocument(builder, &data, sizeof(V));
     builder.close();
-    
     ++numDocs;
-    if (_destroyed) {
-      LOG_TOPIC("73ec2", WARN, Logger::PREGEL)
-          << "Storing data was canceled prematurely";
-      trx->abort();
-      trx.reset();
-      break;
-    }
-        
-    ShardID const& shard = globalShards[currentShard];
-    OperationOptions options;
-    OperationResult opRes = trx->update(shard, builder.slice(), options);
-    if (opRes.fail() &&
-        opRes.isNot(TRI_ERROR_ARANGO_DOCUMENT_NOT_FOUND) &&
-        opRes.isNot(TRI_ERROR_ARANGO_CONFLICT)) {
-      THROW_ARANGO_EXCEPTION(opRes.result);
-    }
-    if (opRes.is(TRI_ERROR_ARANGO_CONFLICT)) {
-       LOG_TOPIC("4e632", WARN, Logger::PREGEL) << "conflict while storing " << builder.toJson();
-    }
   }
-  
+
   if (trx) {
+    flush();
     res = trx->finish(res);
     if (!res.ok()) {
       THROW_ARANGO_EXCEPTION(res);
@@ -550,27 +673,30 @@ void GraphStore<V, E>::storeResults(WorkerConfig* config,
   _config = config;
   double now = TRI_microtime();
   TRI_ASSERT(SchedulerFeature::SCHEDULER != nullptr);
-  
-  size_t numSegments = _vertices.size();
-  if (_localVertexCount > 100000) {
+
+  // the threads take the chunks one after the other, so they stay busy
+  // even if segments or shards differ in size
+  auto chunks = std::make_shared<std::vector<VertexRange>>(vertexRanges(100000));
+  auto nextChunk = std::make_shared<std::atomic<size_t>>(0);
+
+  if (chunks->size() > 1) {
     // We expect at least parallelism to fit in a uint32_t.
-    _runningThreads = static_cast<uint32_t>(std::min<size_t>(_config->parallelism(), numSegments));
+    _runningThreads = static_cast<uint32_t>(std::min<size_t>(_config->parallelism(), chunks->size()));
   } else {
     _runningThreads = 1;
   }
   size_t numT = _runningThreads;
   LOG_TOPIC("f3fd9", DEBUG, Logger::PREGEL) << "Storing vertex data using " <<
     numT << " threads";
-  
+
   for (size_t i = 0; i < numT; i++) {
     SchedulerFeature::SCHEDULER->queue(RequestLane::INTERNAL_LOW, [=]{
-      size_t startI = i * (numSegments / numT);
-      size_t endI = (i + 1) * (numSegments / numT);
-      TRI_ASSERT(endI <= numSegments);
-      
       try {
-        RangeIterator<Vertex<V, E>> it = vertexIterator(startI, endI);
-        _storeVertices(_config->globalShardIDs(), it);
+        size_t c;
+        while (!_destroyed && (c = nextChunk->fetch_add(1)) < chunks->size()) {
+          RangeIterator<Vertex<V, E>> it = vertexIterator((*chunks)[c]);
+          _storeVertices(_config->globalShardIDs(), it);
+        }
         // TODO can't just write edges with smart graphs
       } catch (std::exception const& e) {
         LOG_TOPIC("e22c8", ERR, Logger::PREGEL) << "Storing vertex data failed: '" << e.what() << "'";
@@ -46,6 +46,10 @@ namespace transaction {
 class Methods;
 }
 
+namespace traverser {
+class EdgeCollectionInfo;
+}
+
 namespace pregel {
 
 template <typename T>
@@ -83,6 +87,11 @@ class GraphStore final {
   RangeIterator<Vertex<V,E>> vertexIterator(size_t i, size_t j);
   RangeIterator<Edge<E>> edgeIterator(Vertex<V,E> const* entry);
 
+  /// contiguous ranges of at most maxSize vertices, in storage order.
+  /// threads can take them one after the other to share the vertices
+  std::vector<VertexRange> vertexRanges(size_t maxSize) const;
+  RangeIterator<Vertex<V,E>> vertexIterator(VertexRange const& range);
+
   /// Write results to database
   void storeResults(WorkerConfig* config, std::function<void()>);
 
@@ -90,8 +99,11 @@ class GraphStore final {
   
   void _loadVertices(ShardID const& vertexShard,
                      std::vector<ShardID> const& edgeShards);
+  void _loadSegmentEdges(TypedBuffer<Vertex<V,E>>* vertices,
+                         std::string const& idPrefix,
+                         std::vector<ShardID> const& edgeShards);
   void _loadEdges(transaction::Methods& trx, Vertex<V,E>& vertexEntry,
-                  ShardID const& edgeShard,
+                  traverser::EdgeCollectionInfo& info,
                   std::string const& documentID,
                   std::vector<std::unique_ptr<TypedBuffer<Edge<E>>>>&,
                   std::vector<std::unique_ptr<TypedBuffer<char>>>&);
@@ -35,6 +35,18 @@
 using namespace arangodb;
 using namespace arangodb::pregel;
 
+namespace {
+/// the maps are keyed by std::string. looking keys up through a buffer
+/// which is reused by the thread saves an allocation per message and per
+/// vertex for keys too long for the small string optimization.
+/// the result is only valid until the next call on the same thread
+std::string const& keyBuffer(VPackStringRef const& key) {
+  thread_local std::string buffer;
+  buffer.assign(key.data(), key.size());
+  return buffer;
+}
+}  // namespace
+
 template <typename M>
 InCache<M>::InCache(MessageFormat<M> const* format)
     : _containedMessageCount(0), _format(format) {}
@@ -114,7 +126,7 @@ ArrayInCache<M>::ArrayInCache(WorkerConfig const* config, MessageFormat<M> const
 template <typename M>
 void ArrayInCache<M>::_set(PregelShard shard, VPackStringRef const& key, M const& newValue) {
   HMap& vertexMap(_shardMap[shard]);
-  vertexMap[key.toString()].push_back(newValue);
+  vertexMap[keyBuffer(key)].push_back(newValue);
 }
 
 template <typename M>
@@ -158,9 +170,8 @@ void ArrayInCache<M>::mergeCache(WorkerConfig const& config, InCache<M> const* o
 
 template <typename M>
 MessageIterator<M> ArrayInCache<M>::getMessages(PregelShard shard, VPackStringRef const& key) {
-  std::string keyS = key.toString();
   HMap const& vertexMap = _shardMap[shard];
-  auto vmsg = vertexMap.find(keyS);
+  auto vmsg = vertexMap.find(keyBuffer(key));
   if (vmsg != vertexMap.end()) {
     M const* ptr = vmsg->second.data();
     return MessageIterator<M>(ptr, vmsg->second.size());
@@ -222,13 +233,13 @@ CombiningInCache<M>::CombiningInCache(WorkerConfig const* config,
 
 template <typename M>
 void CombiningInCache<M>::_set(PregelShard shard, VPackStringRef const& key, M const& newValue) {
-  std::string keyS = key.toString();
+  std::string const& keyS = keyBuffer(key);
   HMap& vertexMap = _shardMap[shard];
   auto vmsg = vertexMap.find(keyS);
   if (vmsg != vertexMap.end()) {  // got a message for the same vertex
     _combiner->combine(vmsg->second, newValue);
   } else {
-    vertexMap.insert(std::make_pair(std::move(keyS), newValue));
+    vertexMap.emplace(keyS, newValue);
   }
 }
 
@@ -276,9 +287,8 @@ void CombiningInCache<M>::mergeCache(WorkerConfig const& config, InCache<M> cons
 
 template <typename M>
 MessageIterator<M> CombiningInCache<M>::getMessages(PregelShard shard, VPackStringRef const& key) {
-  std::string keyS = key.toString();
   HMap const& vertexMap = _shardMap[shard];
-  auto vmsg = vertexMap.find(keyS);
+  auto vmsg = vertexMap.find(keyBuffer(key));
   if (vmsg != vertexMap.end()) {
     return MessageIterator<M>(&vmsg->second);
   } else {
@@ -47,19 +47,19 @@ EdgeCollectionInfo::EdgeCollectionInfo(transaction::Methods* trx,
 std::unique_ptr<arangodb::OperationCursor> EdgeCollectionInfo::getEdges(
                                          std::string const& vertexId) {
   
-  /// @brief index used for iteration
-  transaction::Methods::IndexHandle indexId;
-  
-  auto var = _searchBuilder.getVariable();
-  auto cond = _searchBuilder.getOutboundCondition();
-  bool worked = _trx->getBestIndexHandleForFilterCondition(_collectionName, cond,
-                                                           var, 1000, aql::IndexHint(), indexId);
-  TRI_ASSERT(worked);  // We always have an edge Index
+  if (_indexId.getIndex() == nullptr) {
+    // the index is the same for all vertices, only look it up once
+    auto var = _searchBuilder.getVariable();
+    auto cond = _searchBuilder.getOutboundCondition();
+    bool worked = _trx->getBestIndexHandleForFilterCondition(_collectionName, cond,
+                                                             var, 1000, aql::IndexHint(), _indexId);
+    TRI_ASSERT(worked);  // We always have an edge Index
+  }
   
   _searchBuilder.setVertexId(vertexId);
   IndexIteratorOptions opts;
   opts.enableCache = false;
-  return std::make_unique<OperationCursor>(_trx->indexScanForCondition(indexId,
+  return std::make_unique<OperationCursor>(_trx->indexScanForCondition(_indexId,
                                                                        _searchBuilder.getOutboundCondition(),
                                                                        _searchBuilder.getVariable(), opts));
 }
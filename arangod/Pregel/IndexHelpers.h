@@ -25,11 +25,9 @@
 #define ARANGOD_PREGEL_INDEX_HELPERS_H 1
 
 #include "Aql/Graphs.h"
+#include "Transaction/Methods.h"
 
 namespace arangodb {
-namespace transaction{
-  class Methods;
-}
 struct OperationCursor;
   
 namespace traverser {
@@ -62,6 +60,12 @@ class EdgeCollectionInfo {
 
   aql::EdgeConditionBuilderContainer _searchBuilder;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the edge index, determined on the first call to getEdges
+  //////////////////////////////////////////////////////////////////////////////
+
+  transaction::Methods::IndexHandle _indexId;
+
  public:
   EdgeCollectionInfo(transaction::Methods* trx, std::string const& cname);
 
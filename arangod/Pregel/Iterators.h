@@ -82,6 +82,13 @@ class MessageIterator {
   size_t size() const { return _size; }
 };
 
+/// a part of one vertex segment, see GraphStore::vertexRanges()
+struct VertexRange {
+  size_t segment;
+  size_t offset;
+  size_t size;
+};
+
 template <typename T>
 class RangeIterator {
  private:
@@ -129,6 +136,7 @@ class RangeIterator {
     other._beginPtr = nullptr;
     other._currentBufferEnd = nullptr;
     other._size = 0;
+    return *this;
   }
 
 //  iterator begin() { return RangeIterator(_buffers.begin(), _begin, _end); }
@@ -144,12 +152,18 @@ class RangeIterator {
     ++_beginPtr;
     --_size;
     if (_beginPtr == _currentBufferEnd && _size > 0) {
+      // memory-mapped buffers are streamed from disk: release the buffer
+      // we are done with and read ahead the one after the next
+      _buffers[_beginBuffer]->dontNeed();
       ++_beginBuffer;
       TRI_ASSERT(_beginBuffer < _buffers.size());
       TypedBuffer<T>* tb = _buffers[_beginBuffer].get();
       _beginPtr = tb->begin();
       _currentBufferEnd = tb->end();
       TRI_ASSERT(_beginPtr != _currentBufferEnd);
+      if (_beginBuffer + 1 < _buffers.size() && tb->size() < _size) {
+        _buffers[_beginBuffer + 1]->willNeed();
+      }
     }
     return *this;
   }
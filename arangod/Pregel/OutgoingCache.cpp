@@ -31,6 +31,7 @@
 #include "Cluster/ClusterComm.h"
 #include "Cluster/ServerState.h"
 #include "VocBase/LogicalCollection.h"
+#include "VocBase/ticks.h"
 
 #include <velocypack/Iterator.h>
 #include <velocypack/velocypack-aliases.h>
@@ -38,12 +39,79 @@
 using namespace arangodb;
 using namespace arangodb::pregel;
 
+namespace {
+/// @brief maximum number of unanswered batches per thread. flushing waits
+/// for answers beyond that, so that memory usage stays bounded
+constexpr size_t maxPendingResponses = 64;
+}  // namespace
+
 template <typename M>
 OutCache<M>::OutCache(WorkerConfig* state, MessageFormat<M> const* format)
-    : _config(state), _format(format) {
+    : _config(state), _format(format), _coordTransactionID(TRI_NewTickServer()) {
   _baseUrl = Utils::baseUrl(_config->database(), Utils::workerPrefix);
 }
 
+template <typename M>
+OutCache<M>::~OutCache() {
+  if (_pendingResponses > 0) {
+    auto cc = ClusterComm::instance();
+    if (cc != nullptr) {
+      cc->drop(_coordTransactionID, 0, "");
+    }
+  }
+}
+
+template <typename M>
+void OutCache<M>::_sendBatch(PregelShard shard, VPackSlice batch) {
+  auto cc = ClusterComm::instance();
+  if (cc == nullptr) {
+    // nullptr only happens on controlled shutdown
+    return;
+  }
+  while (_pendingResponses >= ::maxPendingResponses) {
+    _waitForResponse();
+  }
+
+  // binary VelocyPack, so that neither side has to deal with JSON
+  std::unordered_map<std::string, std::string> headers;
+  headers.emplace(StaticStrings::ContentTypeHeader, StaticStrings::MimeTypeVPack);
+  ShardID const& shardId = this->_config->globalShardIDs()[shard];
+  auto body = std::make_shared<std::string const>(batch.startAs<char>(), batch.byteSize());
+  cc->asyncRequest(_coordTransactionID, "shard:" + shardId, rest::RequestType::POST,
+                   _baseUrl + Utils::messagesPath, std::move(body), headers,
+                   nullptr, 180.0);
+  ++_pendingResponses;
+}
+
+template <typename M>
+void OutCache<M>::_waitForResponse() {
+  TRI_ASSERT(_pendingResponses > 0);
+  auto cc = ClusterComm::instance();
+  if (cc == nullptr) {
+    _pendingResponses = 0;
+    return;
+  }
+  ClusterCommResult res = cc->wait(_coordTransactionID, 0, "", 180.0);
+  if (res.status == CL_COMM_DROPPED) {
+    // nothing left to wait for
+    _pendingResponses = 0;
+    return;
+  }
+  --_pendingResponses;
+  if (res.status != CL_COMM_RECEIVED || res.answer_code != rest::ResponseCode::OK) {
+    LOG_TOPIC("4b1e6", ERR, Logger::PREGEL)
+        << "Error sending messages to " << res.shardID << ": "
+        << res.stringifyErrorMessage();
+  }
+}
+
+template <typename M>
+void OutCache<M>::waitForResponses() {
+  while (_pendingResponses > 0) {
+    _waitForResponse();
+  }
+}
+
 // ================= ArrayOutCache ==================
 
 template <typename M>
@@ -91,7 +159,6 @@ void ArrayOutCache<M>::flushMessages() {
   options.buildUnindexedArrays = true;
   options.buildUnindexedObjects = true;
 
-  std::vector<ClusterCommRequest> requests;
   for (auto const& it : _shardMap) {
     PregelShard shard = it.first;
     std::unordered_map<VPackStringRef, std::vector<M>> const& vertexMessageMap = it.second;
@@ -123,16 +190,9 @@ void ArrayOutCache<M>::flushMessages() {
     }
     data.close();
     data.close();
-    // add a request
-    ShardID const& shardId = this->_config->globalShardIDs()[shard];
-    auto body = std::make_shared<std::string>(data.toJson());
-    requests.emplace_back("shard:" + shardId, rest::RequestType::POST,
-                          this->_baseUrl + Utils::messagesPath, body);
+    this->_sendBatch(shard, data.slice());
   }
 
-  ClusterComm::instance()->performRequests(requests, 120,
-                                           LogTopic("Pregel message transfer"), false);
-  Utils::printResponses(requests);
   this->_removeContainedMessages();
 }
 
@@ -169,7 +229,7 @@ void CombiningOutCache<M>::appendMessage(PregelShard shard,
     std::unordered_map<VPackStringRef, M>& vertexMap = _shardMap[shard];
     auto it = vertexMap.find(key);
     if (it != vertexMap.end()) {  // more than one message
-      _combiner->combine(vertexMap[key], data);
+      _combiner->combine(it->second, data);
     } else {  // first message for this vertex
       vertexMap.emplace(key, data);
 
@@ -195,7 +255,6 @@ void CombiningOutCache<M>::flushMessages() {
   options.buildUnindexedArrays = true;
   options.buildUnindexedObjects = true;
 
-  std::vector<ClusterCommRequest> requests;
   for (auto const& it : _shardMap) {
     PregelShard shard = it.first;
     std::unordered_map<VPackStringRef, M> const& vertexMessageMap = it.second;
@@ -224,15 +283,9 @@ void CombiningOutCache<M>::flushMessages() {
     }
     data.close();
     data.close();
-    // add a request
-    ShardID const& shardId = this->_config->globalShardIDs()[shard];
-    auto body = std::make_shared<std::string>(data.toJson());
-    requests.emplace_back("shard:" + shardId, rest::RequestType::POST,
-                          this->_baseUrl + Utils::messagesPath, body);
+    this->_sendBatch(shard, data.slice());
   }
 
-  ClusterComm::instance()->performRequests(requests, 180, LogTopic("Pregel"), false);
-  Utils::printResponses(requests);
   _removeContainedMessages();
 }
 
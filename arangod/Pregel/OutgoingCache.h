@@ -65,11 +65,21 @@ class OutCache {
   size_t _containedMessages = 0;
   size_t _sendCount = 0;
   size_t _sendCountNextGSS = 0;
+
+  /// @brief batches that were sent but not yet answered
+  TRI_voc_tick_t _coordTransactionID;
+  size_t _pendingResponses = 0;
+
   virtual void _removeContainedMessages() = 0;
 
+  /// @brief send a batch of messages to the worker responsible for the
+  /// shard, without waiting for the answer
+  void _sendBatch(PregelShard shard, velocypack::Slice batch);
+  void _waitForResponse();
+
  public:
   OutCache(WorkerConfig* state, MessageFormat<M> const* format);
-  virtual ~OutCache() {}
+  virtual ~OutCache();
 
   size_t sendCount() const { return _sendCount; }
   size_t sendCountNextGSS() const { return _sendCountNextGSS; }
@@ -88,12 +98,18 @@ class OutCache {
   }
 
   void clear() {
+    TRI_ASSERT(_pendingResponses == 0);
     _sendCount = 0;
     _sendCountNextGSS = 0;
     _removeContainedMessages();
   };
   virtual void appendMessage(PregelShard shard, velocypack::StringRef const& key, M const& data) = 0;
+  /// @brief send all buffered messages. the computation can continue while
+  /// the batches are transferred
   virtual void flushMessages() = 0;
+  /// @brief wait until all batches sent so far have been received by the
+  /// other workers
+  void waitForResponses();
 };
 
 template <typename M>
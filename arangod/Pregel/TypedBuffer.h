@@ -57,6 +57,12 @@ struct TypedBuffer {
   /// end usage of the structure
   virtual void close() = 0;
 
+  /// hint that the contents will be accessed soon
+  virtual void willNeed() {}
+
+  /// hint that the contents will not be accessed for a while
+  virtual void dontNeed() {}
+
   /// raw access
   T* begin() const { return _begin; }
   T* end() const { return _end; }
@@ -175,13 +181,11 @@ class MappedFileBuffer : public TypedBuffer<T> {
       THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_SYS_ERROR, std::string("pregel cannot create mmap file '") + _filename + "': " + TRI_last_error());
     }
 
-    // memory map the data
+    // memory map the data. the mapping is not populated, so that graphs
+    // larger than the available RAM can be paged in and out while the
+    // supersteps walk over the buffers
     void* data;
     int flags = MAP_SHARED;
-#ifdef __linux__
-    // try populating the mapping already
-    flags |= MAP_POPULATE;
-#endif
     int res = TRI_MMFile(0, _mappedSize, PROT_WRITE | PROT_READ, flags, _fd,
                          &_mmHandle, 0, &data);
 
@@ -220,11 +224,14 @@ class MappedFileBuffer : public TypedBuffer<T> {
     TRI_MMFileAdvise(this->_begin, _mappedSize, TRI_MADVISE_RANDOM);
   }
 
-  void willNeed() {
+  /// start reading the pages from disk in the background
+  void willNeed() override {
     TRI_MMFileAdvise(this->_begin, _mappedSize, TRI_MADVISE_WILLNEED);
   }
 
-  void dontNeed() {
+  /// allow the kernel to drop the pages. the mapping is shared, so the
+  /// contents are read back from the file on the next access
+  void dontNeed() override {
     TRI_MMFileAdvise(this->_begin, _mappedSize, TRI_MADVISE_DONTNEED);
   }
 
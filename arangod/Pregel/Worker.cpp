@@ -61,6 +61,7 @@ Worker<V, E, M>::Worker(TRI_vocbase_t& vocbase, Algorithm<V, E, M>* algo, VPackS
     : _state(WorkerState::IDLE),
       _config(&vocbase, initConfig),
       _algorithm(algo),
+      _nextVertexRange(0),
       _nextGSSSendMessageCount(0),
       _requestedNextGSS(false) {
   MUTEX_LOCKER(guard, _commandMutex);
@@ -316,29 +317,30 @@ void Worker<V, E, M>::_startProcessing() {
   Scheduler* scheduler = SchedulerFeature::SCHEDULER;
 
   size_t total = _graphStore->localVertexCount();
-  size_t numSegments = _graphStore->numberVertexSegments();
+  // small ranges keep all threads busy until the end of the superstep,
+  // even if the vertices of some shards need more work than others
+  _vertexRanges = _graphStore->vertexRanges(10000);
 
   if (total > 100000) {
-    _runningThreads = std::min<size_t>(_config.parallelism(), numSegments);
+    _runningThreads = std::min<size_t>(_config.parallelism(), _vertexRanges.size());
   } else {
     _runningThreads = 1;
   }
   TRI_ASSERT(_runningThreads >= 1);
   TRI_ASSERT(_runningThreads <= _config.parallelism());
   size_t numT = _runningThreads;
-  
+  // every thread starts with its own range
+  _nextVertexRange = numT;
+
   auto self = shared_from_this();
   for (size_t i = 0; i < numT; i++) {
-    scheduler->queue(RequestLane::INTERNAL_LOW, [self, this, i, numT, numSegments] {
+    scheduler->queue(RequestLane::INTERNAL_LOW, [self, this, i] {
       if (_state != WorkerState::COMPUTING) {
         LOG_TOPIC("f0e3d", WARN, Logger::PREGEL) << "Execution aborted prematurely.";
         return;
       }
-      size_t startI = i * (numSegments / numT);
-      size_t endI = (i+1) * (numSegments / numT);
-      TRI_ASSERT(endI <= numSegments);
-      
-      auto vertices = _graphStore->vertexIterator(startI, endI);
+      auto vertices = _graphStore->vertexIterator(
+          i < _vertexRanges.size() ? _vertexRanges[i] : VertexRange{0, 0, 0});
       // should work like a join operation
       if (_processVertices(i, vertices) && _state == WorkerState::COMPUTING) {
         _finishedProcessing();  // last thread turns the lights out
@@ -390,24 +392,38 @@ bool Worker<V, E, M>::_processVertices(size_t threadId,
   }
 
   size_t activeCount = 0;
-  for (; vertexIterator.hasMore(); ++vertexIterator) {
-    Vertex<V,E>* vertexEntry = *vertexIterator;
-    MessageIterator<M> messages =
-        _readCache->getMessages(vertexEntry->shard(), vertexEntry->key());
-    
-    if (messages.size() > 0 || vertexEntry->active()) {
-      vertexComputation->_vertexEntry = vertexEntry;
-      vertexComputation->compute(messages);
-      if (vertexEntry->active()) {
-        activeCount++;
+  auto processRange = [&](RangeIterator<Vertex<V,E>>& vertices) {
+    for (; vertices.hasMore(); ++vertices) {
+      Vertex<V,E>* vertexEntry = *vertices;
+      MessageIterator<M> messages =
+          _readCache->getMessages(vertexEntry->shard(), vertexEntry->key());
+
+      if (messages.size() > 0 || vertexEntry->active()) {
+        vertexComputation->_vertexEntry = vertexEntry;
+        vertexComputation->compute(messages);
+        if (vertexEntry->active()) {
+          activeCount++;
+        }
+      }
+      if (_state != WorkerState::COMPUTING) {
+        break;
       }
     }
-    if (_state != WorkerState::COMPUTING) {
-      break;
-    }
+  };
+
+  processRange(vertexIterator);
+  // then help with the ranges no thread has taken yet
+  size_t next;
+  while (_state == WorkerState::COMPUTING &&
+         (next = _nextVertexRange.fetch_add(1)) < _vertexRanges.size()) {
+    auto vertices = _graphStore->vertexIterator(_vertexRanges[next]);
+    processRange(vertices);
   }
   // ==================== send messages to other shards ====================
   outCache->flushMessages();
+  // earlier batches were sent while computing, the superstep is only
+  // complete once all of them have arrived
+  outCache->waitForResponses();
   if (ADB_UNLIKELY(!_writeCache)) {  // ~Worker was called
     LOG_TOPIC("ee2ab", WARN, Logger::PREGEL) << "Execution aborted prematurely.";
     return false;
@@ -493,6 +509,7 @@ void Worker<V, E, M>::_finishedProcessing() {
         } else {
           // TODO call _startProcessing ???
           _runningThreads = 1;
+          _vertexRanges.clear();
           auto addedVertices = _graphStore->vertexIterator(currentAVCount, total);
           _processVertices(0, addedVertices);
         }
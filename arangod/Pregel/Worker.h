@@ -32,6 +32,7 @@
 #include "Basics/asio_ns.h"
 #include "Pregel/AggregatorHandler.h"
 #include "Pregel/Algorithm.h"
+#include "Pregel/Iterators.h"
 #include "Pregel/Statistics.h"
 #include "Pregel/WorkerConfig.h"
 #include "Pregel/WorkerContext.h"
@@ -70,9 +71,6 @@ class InCache;
 template <typename M>
 class OutCache;
 
-template <typename T>
-class RangeIterator;
-
 template <typename V, typename E, typename M>
 class VertexContext;
 
@@ -129,6 +127,9 @@ class Worker : public IWorker {
   uint64_t _activeCount = 0;
   /// current number of running threads
   size_t _runningThreads = 0;
+  /// the vertices of the current gss, taken by the threads one by one
+  std::vector<VertexRange> _vertexRanges;
+  std::atomic<size_t> _nextVertexRange;
   /// During async mode this should keep track of the send messages
   std::atomic<uint64_t> _nextGSSSendMessageCount;
   /// if the worker has started sendng messages to the next GSS
@@ -666,6 +666,10 @@ Result DatabaseInitialSyncer::fetchCollectionDump(arangodb::LogicalCollection* c
 
   double const startTime = TRI_microtime();
 
+  // filling an empty collection, the storage engine may ingest all batches
+  // directly. it decides itself whether this is safe
+  bool const bulkLoad = getSize(*coll) == 0;
+
   // the shared status will wait in its destructor until all posted
   // requests have been completed/canceled!
   auto self = shared_from_this();
@@ -753,6 +757,10 @@ Result DatabaseInitialSyncer::fetchCollectionDump(arangodb::LogicalCollection* c
     trx.addHint(transaction::Hints::Hint::RECOVERY);
     // do not index the operations in our own transaction
     trx.addHint(transaction::Hints::Hint::NO_INDEXING);
+    if (bulkLoad) {
+      // write the batch as SST files instead of going through the memtables
+      trx.addHint(transaction::Hints::Hint::BULK_LOAD);
+    }
 
     // smaller batch sizes should work better here
 #if VPACK_DUMP
@@ -48,8 +48,14 @@ class DatabaseInitialSyncer final : public InitialSyncer {
   friend ::arangodb::Result syncChunkRocksDB(
       DatabaseInitialSyncer& syncer, SingleCollectionTransaction* trx,
       InitialSyncerIncrementalSyncStats& stats, std::string const& keysId,
-      uint64_t chunkId, std::string const& lowString,
+      uint64_t chunkId, uint64_t chunkSize, std::string const& lowString,
       std::string const& highString, std::vector<std::string> const& markers);
+  friend ::arangodb::Result syncChunkRangesRocksDB(
+      DatabaseInitialSyncer& syncer, SingleCollectionTransaction* trx,
+      InitialSyncerIncrementalSyncStats& stats, std::string const& keysId,
+      uint64_t chunkId, uint64_t chunkSize, std::string const& lowString,
+      std::string const& highString, std::vector<std::string> const& markers,
+      std::vector<TRI_voc_rid_t> const& revisions);
 
  public:
   /// @brief apply phases
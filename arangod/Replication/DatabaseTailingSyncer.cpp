@@ -133,7 +133,8 @@ Result DatabaseTailingSyncer::syncCollectionCatchupInternal(std::string const& c
     // send request
     std::unique_ptr<httpclient::SimpleHttpResult> response;
     _state.connection.lease([&](httpclient::SimpleHttpClient* client) {
-      response.reset(client->request(rest::RequestType::GET, url, nullptr, 0));
+      response.reset(client->request(rest::RequestType::GET, url, nullptr, 0,
+                                     tailingHeaders()));
     });
 
     if (replutils::hasFailed(response.get())) {
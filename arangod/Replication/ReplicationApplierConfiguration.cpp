@@ -53,6 +53,7 @@ ReplicationApplierConfiguration::ReplicationApplierConfiguration()
       _initialSyncMaxWaitTime(300 * 1000 * 1000),
       _autoResyncRetries(2),
       _maxPacketSize(512 * 1024 * 1024),
+      _applyThreads(4),
       _sslProtocol(0),
       _skipCreateDrop(false),
       _autoStart(false),
@@ -84,6 +85,7 @@ void ReplicationApplierConfiguration::reset() {
   _initialSyncMaxWaitTime = 300 * 1000 * 1000;
   _autoResyncRetries = 2;
   _maxPacketSize = 512 * 1024 * 1024;
+  _applyThreads = 4;
   _sslProtocol = 0;
   _skipCreateDrop = false;
   _autoStart = false;
@@ -138,6 +140,7 @@ void ReplicationApplierConfiguration::toVelocyPack(VPackBuilder& builder, bool i
   builder.add("autoResync", VPackValue(_autoResync));
   builder.add("autoResyncRetries", VPackValue(_autoResyncRetries));
   builder.add("maxPacketSize", VPackValue(_maxPacketSize));
+  builder.add("applyThreads", VPackValue(_applyThreads));
   builder.add("includeSystem", VPackValue(_includeSystem));
   builder.add("includeFoxxQueues", VPackValue(_includeFoxxQueues));
   builder.add("requireFromPresent", VPackValue(_requireFromPresent));
@@ -361,6 +364,11 @@ ReplicationApplierConfiguration ReplicationApplierConfiguration::fromVelocyPack(
     configuration._maxPacketSize = value.getNumber<uint64_t>();
   }
 
+  value = slice.get("applyThreads");
+  if (value.isNumber()) {
+    configuration._applyThreads = (std::max)(value.getNumber<uint64_t>(), uint64_t(1));
+  }
+
   // read the endpoint
   value = slice.get("endpoint");
   if (!value.isNone()) {
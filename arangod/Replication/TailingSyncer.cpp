@@ -23,6 +23,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "TailingSyncer.h"
+#include "Basics/ConditionLocker.h"
 #include "Basics/Exceptions.h"
 #include "Basics/NumberUtils.h"
 #include "Basics/ReadLocker.h"
@@ -31,6 +32,7 @@
 #include "Basics/StringBuffer.h"
 #include "Basics/VelocyPackHelper.h"
 #include "Basics/WriteLocker.h"
+#include "Indexes/Index.h"
 #include "Logger/Logger.h"
 #include "Replication/InitialSyncer.h"
 #include "Replication/ReplicationApplier.h"
@@ -38,6 +40,8 @@
 #include "Rest/HttpRequest.h"
 #include "RestServer/DatabaseFeature.h"
 #include "RestServer/SystemDatabaseFeature.h"
+#include "Scheduler/Scheduler.h"
+#include "Scheduler/SchedulerFeature.h"
 #include "SimpleHttpClient/SimpleHttpClient.h"
 #include "SimpleHttpClient/SimpleHttpResult.h"
 #include "StorageEngine/EngineSelectorFeature.h"
@@ -56,8 +60,11 @@
 #include <velocypack/Parser.h>
 #include <velocypack/Slice.h>
 #include <velocypack/StringRef.h>
+#include <velocypack/Validator.h>
 #include <velocypack/velocypack-aliases.h>
 
+#include <lz4.h>
+
 using namespace arangodb;
 using namespace arangodb::basics;
 using namespace arangodb::httpclient;
@@ -70,6 +77,14 @@ static arangodb::velocypack::StringRef const dataRef("data");
 static arangodb::velocypack::StringRef const tickRef("tick");
 static arangodb::velocypack::StringRef const dbRef("db");
 
+/// @brief number of document operations applyLog collects at most before
+/// applying them
+static size_t const maxPendingDocuments = 4096;
+
+/// @brief below this number of operations per lane it is cheaper to apply
+/// the operations on the applier thread
+static size_t const minDocumentsPerLane = 16;
+
 bool hasHeader(std::unique_ptr<httpclient::SimpleHttpResult> const& response,
                std::string const& name) {
   return response->hasHeaderField(name);
@@ -95,8 +110,91 @@ uint64_t getUIntHeader(std::unique_ptr<httpclient::SimpleHttpResult> const& resp
   return 0;
 }
 
+/// @brief whether the failed application of a marker is ignored as per the
+/// ignoreErrors configuration. if not, the marker is added to the message.
+/// markers received as VelocyPack have no line
+bool ignoreApplyError(arangodb::Result& res, char const* lineStart, size_t lineLength,
+                      VPackSlice marker, uint64_t& ignoreCount,
+                      std::string const& databaseName) {
+  std::string errorMsg = res.errorMessage();
+
+  if (ignoreCount == 0) {
+    std::string json;
+    if (lineStart == nullptr) {
+      json = marker.toJson();
+      lineStart = json.data();
+      lineLength = json.size();
+    }
+    if (lineLength > 1024) {
+      errorMsg += ", offending marker: " + std::string(lineStart, 1024) + "...";
+    } else {
+      errorMsg += ", offending marker: " + std::string(lineStart, lineLength);
+    }
+
+    res.reset(res.errorNumber(), errorMsg);
+    return false;
+  }
+
+  ignoreCount--;
+  LOG_TOPIC("c887a", WARN, arangodb::Logger::REPLICATION)
+      << "ignoring replication error for database '" << databaseName
+      << "': " << errorMsg;
+  return true;
+}
+
+/// @brief whether the master sent the markers as VelocyPack
+bool isVelocyPackBody(arangodb::httpclient::SimpleHttpResult* response) {
+  bool found = false;
+  std::string const& contentType =
+      response->getHeaderField(StaticStrings::ContentTypeHeader, found);
+  return found && contentType.compare(0, StaticStrings::MimeTypeVPack.size(),
+                                      StaticStrings::MimeTypeVPack) == 0;
+}
+
+/// @brief uncompresses an LZ4-compressed body into buffer and points the
+/// range to it. leaves uncompressed bodies alone
+arangodb::Result uncompressBody(arangodb::httpclient::SimpleHttpResult* response,
+                                char const*& begin, char const*& end, std::string& buffer) {
+  bool found = false;
+  std::string const& compression =
+      response->getHeaderField(StaticStrings::ReplicationHeaderCompression, found);
+  if (!found) {
+    return arangodb::Result();
+  }
+
+  std::string const& uncompressedSize =
+      response->getHeaderField(StaticStrings::ReplicationHeaderUncompressedSize, found);
+  size_t size = found ? static_cast<size_t>(StringUtils::uint64(uncompressedSize)) : 0;
+  if (compression != "lz4" || size == 0 || size > static_cast<size_t>(LZ4_MAX_INPUT_SIZE)) {
+    return arangodb::Result(TRI_ERROR_REPLICATION_INVALID_RESPONSE,
+                            "invalid compression of WAL tailing response");
+  }
+
+  buffer.resize(size);
+  int length = LZ4_decompress_safe(begin, &buffer[0], static_cast<int>(end - begin),
+                                   static_cast<int>(size));
+  if (length != static_cast<int>(size)) {
+    return arangodb::Result(TRI_ERROR_REPLICATION_INVALID_RESPONSE,
+                            "cannot decompress WAL tailing response");
+  }
+
+  begin = buffer.data();
+  end = begin + size;
+  return arangodb::Result();
+}
+
 }  // namespace
 
+/// @brief headers of WAL tailing requests. they ask for the markers as
+/// LZ4-compressed VelocyPack, which masters that do not know the format
+/// ignore
+std::unordered_map<std::string, std::string> const& TailingSyncer::tailingHeaders() {
+  static std::unordered_map<std::string, std::string> const headers{
+      {StaticStrings::Accept, StaticStrings::MimeTypeVPack},
+      {StaticStrings::ReplicationHeaderCompression, "lz4"}};
+  return headers;
+}
+
 /// @brief base url of the replication API
 std::string const TailingSyncer::WalAccessUrl = "/_api/wal";
 
@@ -395,6 +493,15 @@ Result TailingSyncer::processDocument(TRI_replication_operation_e type,
     return Result(TRI_ERROR_ARANGO_DATA_SOURCE_NOT_FOUND);
   }
 
+  return processDocument(type, *vocbase, coll, slice, _documentBuilder,
+                         AccessMode::Type::EXCLUSIVE);
+}
+
+/// @brief process a document operation on an already resolved collection
+Result TailingSyncer::processDocument(TRI_replication_operation_e type,
+                                      TRI_vocbase_t& vocbase, LogicalCollection* coll,
+                                      VPackSlice const& slice, VPackBuilder& builder,
+                                      AccessMode::Type accessMode) {
   bool const isSystem = coll->system();
   bool const isUsers = coll->name() == TRI_COL_NAME_USERS; 
 
@@ -437,15 +544,15 @@ Result TailingSyncer::processDocument(TRI_replication_operation_e type,
   // in case this is a removal we need to build our marker
   VPackSlice applySlice = data;
   if (type == REPLICATION_MARKER_REMOVE) {
-    _documentBuilder.clear();
-    _documentBuilder.openObject();
-    _documentBuilder.add(StaticStrings::KeyString, key);
+    builder.clear();
+    builder.openObject();
+    builder.add(StaticStrings::KeyString, key);
     if (rev.isString()) {
       // _rev is an optional attribute
-      _documentBuilder.add(StaticStrings::RevString, rev);
+      builder.add(StaticStrings::RevString, rev);
     }
-    _documentBuilder.close();
-    applySlice = _documentBuilder.slice();
+    builder.close();
+    applySlice = builder.slice();
   }
 
   if (tid > 0) {  // part of a transaction
@@ -501,14 +608,16 @@ Result TailingSyncer::processDocument(TRI_replication_operation_e type,
     }
     
     // update the apply tick for all standalone operations
-    SingleCollectionTransaction trx(transaction::StandaloneContext::Create(*vocbase),
-                                    *coll, AccessMode::Type::EXCLUSIVE);
+    SingleCollectionTransaction trx(transaction::StandaloneContext::Create(vocbase),
+                                    *coll, accessMode);
 
     // we will always check if the target document already exists and then either
     // carry out an insert or a replace.
     // so we will be carrying out either a read-then-insert or a read-then-replace
     // operation, which is a single write operation. and for MMFiles this is also
-    // safe as we have the exclusive lock on the underlying collection anyway 
+    // safe as we have the exclusive lock on the underlying collection anyway.
+    // a non-exclusive access mode is only used when no other thread applies
+    // operations for the same key
     trx.addHint(transaction::Hints::Hint::SINGLE_OPERATION);
 
     Result res = trx.begin();
@@ -1061,6 +1170,11 @@ Result TailingSyncer::applyLog(SimpleHttpResult* response, TRI_voc_tick_t firstR
   };
   TRI_DEFER(reloader());
 
+  // operations that were collected but not applied are of no use
+  // any more
+  _pendingDocuments.clear();
+  TRI_DEFER(_pendingDocuments.clear());
+
   StringBuffer& data = response->getBody();
   char const* p = data.begin();
   char const* end = p + data.length();
@@ -1068,39 +1182,64 @@ Result TailingSyncer::applyLog(SimpleHttpResult* response, TRI_voc_tick_t firstR
   // buffer must end with a NUL byte
   TRI_ASSERT(*end == '\0');
 
+  std::string uncompressed;
+  Result res = ::uncompressBody(response, p, end, uncompressed);
+  if (res.fail()) {
+    return res;
+  }
+
+  // masters that know the binary format only use it if we asked for it
+  bool const binary = ::isVelocyPackBody(response);
+
   // TODO: re-use a builder!
   auto builder = std::make_shared<VPackBuilder>();
 
   while (p < end) {
-    char const* q = static_cast<char const*>(memchr(p, '\n', (end - p)));
+    char const* lineStart = nullptr;
+    size_t lineLength = 0;
 
-    if (q == nullptr) {
-      q = end;
-    }
+    builder->clear();
+    if (binary) {
+      // one VelocyPack value per marker, one after the other
+      try {
+        VPackValidator validator;
+        validator.validate(p, static_cast<size_t>(end - p), /*isSubPart*/ true);
+        VPackSlice marker(reinterpret_cast<uint8_t const*>(p));
+        builder->add(marker);
+        p += marker.byteSize();
+      } catch (std::exception const& ex) {
+        return Result(TRI_ERROR_REPLICATION_INVALID_RESPONSE, ex.what());
+      }
+    } else {
+      char const* q = static_cast<char const*>(memchr(p, '\n', (end - p)));
 
-    char const* lineStart = p;
-    size_t const lineLength = q - p;
+      if (q == nullptr) {
+        q = end;
+      }
 
-    if (lineLength < 2) {
-      // we are done
-      return Result();
-    }
+      lineStart = p;
+      lineLength = q - p;
 
-    TRI_ASSERT(q <= end);
+      if (lineLength < 2) {
+        // we are done
+        break;
+      }
 
-    applyStats.processedMarkers++;
+      TRI_ASSERT(q <= end);
 
-    builder->clear();
-    try {
-      VPackParser parser(builder);
-      parser.parse(p, static_cast<size_t>(q - p));
-    } catch (std::exception const& ex) {
-      return Result(TRI_ERROR_HTTP_CORRUPTED_JSON, ex.what());
-    } catch (...) {
-      return Result(TRI_ERROR_OUT_OF_MEMORY);
+      try {
+        VPackParser parser(builder);
+        parser.parse(p, static_cast<size_t>(q - p));
+      } catch (std::exception const& ex) {
+        return Result(TRI_ERROR_HTTP_CORRUPTED_JSON, ex.what());
+      } catch (...) {
+        return Result(TRI_ERROR_OUT_OF_MEMORY);
+      }
+
+      p = q + 1;
     }
 
-    p = q + 1;
+    applyStats.processedMarkers++;
 
     VPackSlice const slice = builder->slice();
 
@@ -1124,56 +1263,244 @@ Result TailingSyncer::applyLog(SimpleHttpResult* response, TRI_voc_tick_t firstR
     // entry is skipped?
     bool skipped = skipMarker(firstRegularTick, slice, markerTick, markerType);
 
-    if (!skipped) {
-      Result res = applyLogMarker(slice, applyStats, firstRegularTick, markerTick, markerType);
+    if (skipped && !_pendingDocuments.empty()) {
+      // the tick must not overtake the pending operations
+      _pendingDocuments.push_back(PendingDocument{nullptr, nullptr, nullptr, markerType,
+                                                  markerTick, true, lineStart, lineLength});
+      continue;
+    }
 
-      if (res.fail()) {
-        // apply error
-        std::string errorMsg = res.errorMessage();
-
-        if (ignoreCount == 0) {
-          if (lineLength > 1024) {
-            errorMsg +=
-                ", offending marker: " + std::string(lineStart, 1024) + "...";
-          } else {
-            errorMsg += ", offending marker: " + std::string(lineStart, lineLength);
+    if (!skipped && isStandaloneDocument(slice, markerType)) {
+      TRI_vocbase_t* vocbase = nullptr;
+      std::shared_ptr<LogicalCollection> coll;
+      try {
+        vocbase = resolveVocbase(slice);
+        if (vocbase != nullptr) {
+          coll = resolveCollection(*vocbase, slice);
+        }
+      } catch (...) {
+        // the error is reported when the marker is applied on its own
+        coll.reset();
+      }
+
+      if (coll != nullptr) {
+        if (markerType == REPLICATION_MARKER_DOCUMENT) {
+          ++applyStats.processedDocuments;
+        } else {
+          ++applyStats.processedRemovals;
+        }
+        _pendingDocuments.push_back(PendingDocument{std::move(builder), vocbase,
+                                                    std::move(coll), markerType, markerTick,
+                                                    false, lineStart, lineLength});
+        builder = std::make_shared<VPackBuilder>();
+
+        if (_pendingDocuments.size() >= ::maxPendingDocuments) {
+          res = applyPendingDocuments(firstRegularTick, ignoreCount);
+          if (res.fail()) {
+            return res;
           }
+        }
+        continue;
+      }
+    }
 
-          res.reset(res.errorNumber(), errorMsg);
-          return res;
+    // all other markers must see the effects of the operations before them
+    res = applyPendingDocuments(firstRegularTick, ignoreCount);
+    if (res.fail()) {
+      return res;
+    }
+
+    if (!skipped) {
+      res = applyLogMarker(slice, applyStats, firstRegularTick, markerTick, markerType);
+
+      if (res.fail() && !::ignoreApplyError(res, lineStart, lineLength, slice,
+                                             ignoreCount, _state.databaseName)) {
+        return res;
+      }
+    }
+
+    updateProcessedTick(firstRegularTick, markerTick, skipped);
+  }
+
+  // reached the end
+  return applyPendingDocuments(firstRegularTick, ignoreCount);
+}
+
+/// @brief whether the marker is a standalone document operation
+bool TailingSyncer::isStandaloneDocument(VPackSlice const& slice,
+                                         TRI_replication_operation_e type) const {
+  if (_state.applier._applyThreads <= 1 ||
+      (type != REPLICATION_MARKER_DOCUMENT && type != REPLICATION_MARKER_REMOVE)) {
+    return false;
+  }
+
+  arangodb::velocypack::StringRef const transactionId =
+      VelocyPackHelper::getStringRef(slice, "tid", "");
+  return transactionId.empty() ||
+         NumberUtils::atoi_zero<TRI_voc_tid_t>(transactionId.data(),
+                                               transactionId.data() +
+                                                   transactionId.size()) == 0;
+}
+
+/// @brief applies the pending document operations. operations are
+/// distributed over lanes so that all operations for one key, or for one
+/// collection if its keys can not be separated, end up in the same lane and
+/// keep their order. lanes run in parallel
+Result TailingSyncer::applyPendingDocuments(TRI_voc_tick_t firstRegularTick,
+                                            uint64_t& ignoreCount) {
+  if (_pendingDocuments.empty()) {
+    return Result();
+  }
+
+  size_t const n = _pendingDocuments.size();
+  size_t numLanes = (std::min)(static_cast<size_t>(_state.applier._applyThreads),
+                               n / ::minDocumentsPerLane);
+  if (numLanes == 0) {
+    numLanes = 1;
+  }
+
+  // with RocksDB operations on different keys do not conflict, MMFiles
+  // locks the whole collection anyway
+  bool const splitKeys = numLanes > 1 &&
+                         EngineSelectorFeature::ENGINE->typeName() == "rocksdb";
+
+  std::vector<std::vector<size_t>> lanes(numLanes);
+  std::vector<AccessMode::Type> accessModes(n, AccessMode::Type::EXCLUSIVE);
+  std::unordered_map<TRI_voc_cid_t, bool> keysSeparable;
+
+  for (size_t i = 0; i < n; ++i) {
+    PendingDocument const& doc = _pendingDocuments[i];
+    if (doc.skipped) {
+      continue;
+    }
+
+    uint64_t hash = VPackSlice::defaultSeed ^ doc.collection->id();
+    if (splitKeys) {
+      auto it = keysSeparable.find(doc.collection->id());
+      if (it == keysSeparable.end()) {
+        // a unique secondary index may make the application of one key
+        // remove another document, so such collections are applied in order
+        bool separable = true;
+        for (auto const& idx : doc.collection->getIndexes()) {
+          if (idx->unique() && idx->type() != Index::TRI_IDX_TYPE_PRIMARY_INDEX) {
+            separable = false;
+            break;
+          }
+        }
+        it = keysSeparable.emplace(doc.collection->id(), separable).first;
+      }
+      if ((*it).second) {
+        VPackSlice key = doc.marker->slice().get(::dataRef).get(StaticStrings::KeyString);
+        if (key.isString()) {
+          hash = key.hashString(hash);
         }
+        accessModes[i] = AccessMode::Type::WRITE;
+      }
+    }
+    lanes[hash % numLanes].push_back(i);
+  }
 
-        ignoreCount--;
-        LOG_TOPIC("c887a", WARN, Logger::REPLICATION)
-            << "ignoring replication error for database '" << _state.databaseName
-            << "': " << errorMsg;
+  std::vector<Result> results(n);
+  auto applyLane = [this, &results, &accessModes](std::vector<size_t> const& lane) {
+    VPackBuilder documentBuilder;
+    for (size_t i : lane) {
+      PendingDocument const& doc = _pendingDocuments[i];
+      try {
+        results[i] = processDocument(doc.type, *doc.vocbase, doc.collection.get(),
+                                     doc.marker->slice(), documentBuilder, accessModes[i]);
+      } catch (basics::Exception const& ex) {
+        results[i].reset(ex.code(), ex.what());
+      } catch (std::exception const& ex) {
+        results[i].reset(TRI_ERROR_INTERNAL, ex.what());
+      } catch (...) {
+        results[i].reset(TRI_ERROR_INTERNAL, "unknown exception in processDocument");
       }
     }
+  };
 
-    // update tick value
-    WRITE_LOCKER_EVENTUAL(writeLocker, _applier->_statusLock);
+  basics::ConditionVariable condition;
+  size_t running = 0;
 
-    if (markerTick > firstRegularTick &&
-        markerTick > _applier->_state._lastProcessedContinuousTick) {
-      TRI_ASSERT(markerTick > 0);
-      _applier->_state._lastProcessedContinuousTick = markerTick;
+  for (size_t l = 1; l < numLanes; ++l) {
+    if (lanes[l].empty()) {
+      continue;
     }
 
-    if (_applier->_state._lastProcessedContinuousTick > _applier->_state._lastAppliedContinuousTick) {
-      _applier->_state._lastAppliedContinuousTick = _applier->_state._lastProcessedContinuousTick;
+    {
+      CONDITION_LOCKER(locker, condition);
+      ++running;
     }
 
-    if (skipped) {
-      ++_applier->_state._totalSkippedOperations;
-    } else if (_ongoingTransactions.empty()) {
-      _applier->_state._safeResumeTick = _applier->_state._lastProcessedContinuousTick;
+    bool queued = false;
+    if (SchedulerFeature::SCHEDULER != nullptr) {
+      try {
+        queued = SchedulerFeature::SCHEDULER->queue(RequestLane::INTERNAL_LOW, [&, l]() {
+          applyLane(lanes[l]);
+          CONDITION_LOCKER(locker, condition);
+          --running;
+          locker.signal();
+        });
+      } catch (...) {
+      }
+    }
+
+    if (!queued) {
+      {
+        CONDITION_LOCKER(locker, condition);
+        --running;
+      }
+      applyLane(lanes[l]);
     }
   }
 
-  // reached the end
+  applyLane(lanes[0]);
+
+  {
+    CONDITION_LOCKER(locker, condition);
+    while (running > 0) {
+      locker.wait();
+    }
+  }
+
+  // report errors and advance the ticks in the order of the markers
+  for (size_t i = 0; i < n; ++i) {
+    PendingDocument const& doc = _pendingDocuments[i];
+    Result& res = results[i];
+    if (res.fail() &&
+        !::ignoreApplyError(res, doc.line, doc.lineLength, doc.marker->slice(),
+                            ignoreCount, _state.databaseName)) {
+      _pendingDocuments.clear();
+      return res;
+    }
+    updateProcessedTick(firstRegularTick, doc.tick, doc.skipped);
+  }
+
+  _pendingDocuments.clear();
   return Result();
 }
 
+/// @brief updates the applier state after a marker has been handled
+void TailingSyncer::updateProcessedTick(TRI_voc_tick_t firstRegularTick,
+                                        TRI_voc_tick_t markerTick, bool skipped) {
+  WRITE_LOCKER_EVENTUAL(writeLocker, _applier->_statusLock);
+
+  if (markerTick > firstRegularTick &&
+      markerTick > _applier->_state._lastProcessedContinuousTick) {
+    TRI_ASSERT(markerTick > 0);
+    _applier->_state._lastProcessedContinuousTick = markerTick;
+  }
+
+  if (_applier->_state._lastProcessedContinuousTick > _applier->_state._lastAppliedContinuousTick) {
+    _applier->_state._lastAppliedContinuousTick = _applier->_state._lastProcessedContinuousTick;
+  }
+
+  if (skipped) {
+    ++_applier->_state._totalSkippedOperations;
+  } else if (_ongoingTransactions.empty()) {
+    _applier->_state._safeResumeTick = _applier->_state._lastProcessedContinuousTick;
+  }
+}
+
 /// @brief run method, performs continuous synchronization
 /// catches exceptions
 Result TailingSyncer::run() {
@@ -1808,7 +2135,7 @@ void TailingSyncer::fetchMasterLog(std::shared_ptr<Syncer::JobSynchronizer> shar
 
     _state.connection.lease([&](httpclient::SimpleHttpClient* client) {
       response.reset(client->request(rest::RequestType::PUT, url, body.c_str(),
-                                     body.size()));
+                                     body.size(), tailingHeaders()));
     });
 
     time = TRI_microtime() - time;
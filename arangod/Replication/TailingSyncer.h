@@ -28,9 +28,12 @@
 #include "Basics/Common.h"
 #include "Replication/ReplicationApplierConfiguration.h"
 #include "Replication/Syncer.h"
+#include "VocBase/AccessMode.h"
 
 #include <velocypack/Builder.h>
 
+#include <atomic>
+
 struct TRI_vocbase_t;
 
 namespace arangodb {
@@ -68,6 +71,9 @@ class TailingSyncer : public Syncer {
   /// @brief decide based on _masterInfo which api to use
   virtual std::string tailingBaseUrl(std::string const& command);
 
+  /// @brief headers to send with WAL tailing requests
+  static std::unordered_map<std::string, std::string> const& tailingHeaders();
+
   /// @brief set the applier progress
   void setProgress(std::string const&);
 
@@ -112,6 +118,13 @@ class TailingSyncer : public Syncer {
   /// @brief process a document operation, based on the VelocyPack provided
   Result processDocument(TRI_replication_operation_e, arangodb::velocypack::Slice const&);
 
+  /// @brief process a document operation on an already resolved collection.
+  /// the builder is used for the removal markers, the access mode for
+  /// standalone operations
+  Result processDocument(TRI_replication_operation_e, TRI_vocbase_t& vocbase,
+                         LogicalCollection* coll, arangodb::velocypack::Slice const&,
+                         arangodb::velocypack::Builder& builder, AccessMode::Type accessMode);
+
   /// @brief renames a collection, based on the VelocyPack provided
   Result renameCollection(arangodb::velocypack::Slice const&);
 
@@ -173,6 +186,20 @@ class TailingSyncer : public Syncer {
   /// @brief determines if we can work in parallel on master and slave
   void checkParallel();
 
+  /// @brief whether the marker is a standalone document operation that may
+  /// be applied concurrently with operations on other collections or keys
+  bool isStandaloneDocument(arangodb::velocypack::Slice const& slice,
+                            TRI_replication_operation_e type) const;
+
+  /// @brief applies the pending document operations, operations for different
+  /// collections or keys in parallel, and updates the ticks in marker order
+  arangodb::Result applyPendingDocuments(TRI_voc_tick_t firstRegularTick,
+                                         uint64_t& ignoreCount);
+
+  /// @brief updates the applier state after a marker has been handled
+  void updateProcessedTick(TRI_voc_tick_t firstRegularTick,
+                           TRI_voc_tick_t markerTick, bool skipped);
+
   arangodb::Result removeSingleDocument(arangodb::LogicalCollection* coll, std::string const& key);
 
   arangodb::Result handleRequiredFromPresentFailure(TRI_voc_tick_t fromTick,
@@ -200,7 +227,7 @@ class TailingSyncer : public Syncer {
   TRI_voc_tick_t _initialTick;
 
   /// @brief whether or not an operation modified the _users collection
-  bool _usersModified;
+  std::atomic<bool> _usersModified;
 
   /// @brief use the initial tick
   bool _useTick;
@@ -229,6 +256,24 @@ class TailingSyncer : public Syncer {
   /// @brief recycled builder for repeated document creation
   arangodb::velocypack::Builder _documentBuilder;
 
+  /// @brief a marker of the continuous log whose application is deferred
+  /// until the pending document operations are applied together
+  struct PendingDocument {
+    std::shared_ptr<arangodb::velocypack::Builder> marker;
+    TRI_vocbase_t* vocbase;
+    std::shared_ptr<LogicalCollection> collection;
+    TRI_replication_operation_e type;
+    TRI_voc_tick_t tick;
+    // the marker was skipped, only its tick needs to be processed
+    bool skipped;
+    // the marker in the response body, for error messages
+    char const* line;
+    size_t lineLength;
+  };
+
+  /// @brief document operations collected by applyLog
+  std::vector<PendingDocument> _pendingDocuments;
+
   static std::string const WalAccessUrl;
 };
 }  // namespace arangodb
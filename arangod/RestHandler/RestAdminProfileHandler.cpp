@@ -0,0 +1,187 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "RestAdminProfileHandler.h"
+
+#include "Basics/FileUtils.h"
+#include "Basics/Profiler.h"
+#include "Basics/ScopeGuard.h"
+#include "Basics/files.h"
+#include "Rest/HttpResponse.h"
+#include "Utils/ExecContext.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::basics;
+using namespace arangodb::rest;
+
+namespace {
+/// @brief a CPU profile blocks the request for its duration
+constexpr double maxCpuProfileDuration = 60.0;
+}  // namespace
+
+RestAdminProfileHandler::RestAdminProfileHandler(GeneralRequest* request,
+                                                 GeneralResponse* response)
+    : RestBaseHandler(request, response) {}
+
+RestStatus RestAdminProfileHandler::execute() {
+  // the profiles show the internals of all databases
+  if (ExecContext::CURRENT != nullptr && !ExecContext::CURRENT->isAdminUser()) {
+    generateError(rest::ResponseCode::FORBIDDEN, TRI_ERROR_FORBIDDEN);
+    return RestStatus::DONE;
+  }
+
+  std::vector<std::string> const& suffixes = _request->suffixes();
+  if (suffixes.size() == 1 && suffixes[0] == "cpu") {
+    handleCpu();
+  } else if (suffixes.size() == 1 && suffixes[0] == "heap") {
+    handleHeap();
+  } else {
+    generateError(rest::ResponseCode::NOT_FOUND, TRI_ERROR_HTTP_NOT_FOUND,
+                  "expecting /_admin/profile/cpu or /_admin/profile/heap");
+  }
+  return RestStatus::DONE;
+}
+
+void RestAdminProfileHandler::handleCpu() {
+  if (_request->requestType() != rest::RequestType::GET) {
+    generateError(rest::ResponseCode::METHOD_NOT_ALLOWED, TRI_ERROR_HTTP_METHOD_NOT_ALLOWED);
+    return;
+  }
+
+  profiler::CpuProfileOptions options;
+  double const duration = _request->parsedValue("duration", 10.0);
+  if (duration <= 0.0 || duration > ::maxCpuProfileDuration) {
+    generateError(rest::ResponseCode::BAD, TRI_ERROR_HTTP_BAD_PARAMETER,
+                  "duration must be between 0 and 60 seconds");
+    return;
+  }
+  options.duration = std::chrono::milliseconds(static_cast<int64_t>(duration * 1000.0));
+  uint64_t const frequency = _request->parsedValue("frequency", uint64_t(options.frequency));
+  if (frequency == 0 || frequency > 1000) {
+    generateError(rest::ResponseCode::BAD, TRI_ERROR_HTTP_BAD_PARAMETER,
+                  "frequency must be between 1 and 1000");
+    return;
+  }
+  options.frequency = static_cast<uint32_t>(frequency);
+  options.idle = _request->parsedValue("idle", options.idle);
+
+  std::string profile;
+  Result res = profiler::sampleCpu(options, profile);
+  if (res.fail()) {
+    generateError(res);
+    return;
+  }
+  writeText(profile);
+}
+
+void RestAdminProfileHandler::handleHeap() {
+  auto const type = _request->requestType();
+  if (type == rest::RequestType::PUT) {
+    bool parseSuccess = false;
+    VPackSlice body = parseVPackBody(parseSuccess);
+    if (!parseSuccess) {
+      // error already written
+      return;
+    }
+    VPackSlice active = body.isObject() ? body.get("active") : VPackSlice();
+    if (!active.isBoolean()) {
+      generateError(rest::ResponseCode::BAD, TRI_ERROR_HTTP_BAD_PARAMETER,
+                    "expecting an object with a boolean 'active' attribute");
+      return;
+    }
+    Result res = profiler::setHeapProfileActive(active.getBoolean());
+    if (res.fail()) {
+      generateError(res);
+      return;
+    }
+    writeHeapActive();
+    return;
+  }
+
+  if (type != rest::RequestType::GET) {
+    generateError(rest::ResponseCode::METHOD_NOT_ALLOWED, TRI_ERROR_HTTP_METHOD_NOT_ALLOWED);
+    return;
+  }
+
+  std::string filename;
+  {
+    std::string errorMessage;
+    long systemError;
+    if (TRI_GetTempName("profiles", filename, false, systemError, errorMessage) != TRI_ERROR_NO_ERROR) {
+      generateError(rest::ResponseCode::SERVER_ERROR, TRI_ERROR_INTERNAL,
+                    "could not generate temp file: " + errorMessage);
+      return;
+    }
+  }
+  TRI_DEFER(TRI_UnlinkFile(filename.c_str()));
+
+  Result res = profiler::dumpHeapProfile(filename);
+  if (res.fail()) {
+    generateError(res);
+    return;
+  }
+  std::string profile;
+  res = FileUtils::slurp(filename, profile);
+  if (res.fail()) {
+    generateError(res);
+    return;
+  }
+  writeText(profile);
+}
+
+void RestAdminProfileHandler::writeHeapActive() {
+  bool active = false;
+  Result res = profiler::heapProfileActive(active);
+  if (res.fail()) {
+    generateError(res);
+    return;
+  }
+  VPackBuilder builder;
+  builder.openObject();
+  builder.add("active", VPackValue(active));
+  builder.close();
+  generateOk(rest::ResponseCode::OK, builder);
+}
+
+void RestAdminProfileHandler::writeText(std::string const& text) {
+  _response->setResponseCode(rest::ResponseCode::OK);
+  switch (_response->transportType()) {
+    case Endpoint::TransportType::HTTP: {
+      HttpResponse* httpResponse = dynamic_cast<HttpResponse*>(_response.get());
+      if (httpResponse == nullptr) {
+        THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "unable to cast response object");
+      }
+      _response->setContentType(rest::ContentType::TEXT);
+      httpResponse->body().appendText(text.data(), text.size());
+      break;
+    }
+    case Endpoint::TransportType::VST: {
+      VPackBuffer<uint8_t> buffer;
+      VPackBuilder builder(buffer);
+      builder.add(VPackValuePair(text.data(), text.size(), VPackValueType::String));
+      _response->setContentType(rest::ContentType::VPACK);
+      _response->setPayload(std::move(buffer), true);
+      break;
+    }
+  }
+}
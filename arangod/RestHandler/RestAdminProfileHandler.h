@@ -0,0 +1,54 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_REST_HANDLER_REST_ADMIN_PROFILE_HANDLER_H
+#define ARANGOD_REST_HANDLER_REST_ADMIN_PROFILE_HANDLER_H 1
+
+#include "Basics/Common.h"
+#include "RestHandler/RestBaseHandler.h"
+
+namespace arangodb {
+
+/// @brief profiles of the running server, for administrators only:
+///   GET /_admin/profile/cpu?duration=<s>&frequency=<hz>&idle=<bool>
+///     samples the stacks of the server threads, in the collapsed format
+///     of the flame graph tools
+///   GET /_admin/profile/heap
+///     a jemalloc heap profile, for jeprof
+///   PUT /_admin/profile/heap with {"active": <bool>}
+///     starts or stops sampling allocations for heap profiles
+class RestAdminProfileHandler : public RestBaseHandler {
+ public:
+  RestAdminProfileHandler(GeneralRequest*, GeneralResponse*);
+
+  char const* name() const override final { return "RestAdminProfileHandler"; }
+  /// @brief profiles are mostly needed when the server is busy
+  RequestLane lane() const override final { return RequestLane::CLUSTER_ADMIN; }
+  RestStatus execute() override;
+
+ private:
+  void handleCpu();
+  void handleHeap();
+  void writeHeapActive();
+  void writeText(std::string const& text);
+};
+}  // namespace arangodb
+
+#endif
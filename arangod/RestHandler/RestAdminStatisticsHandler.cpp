@@ -21,9 +21,17 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "RestAdminStatisticsHandler.h"
+#include "Basics/StringUtils.h"
+#include "Cluster/FollowerReads.h"
+#include "Cluster/ServerState.h"
 #include "GeneralServer/ServerSecurityFeature.h"
+#include "Rest/HttpResponse.h"
+#include "Statistics/ClusterCommStatistics.h"
 #include "Statistics/Descriptions.h"
+#include "Statistics/MaintenanceStatistics.h"
+#include "Statistics/Metrics.h"
 #include "Statistics/StatisticsFeature.h"
+#include "Statistics/Tracing.h"
 
 using namespace arangodb;
 using namespace arangodb::basics;
@@ -54,6 +62,10 @@ RestStatus RestAdminStatisticsHandler::execute() {
     getStatistics();
   } else if (_request->requestPath() == "/_admin/statistics-description") {
     getStatisticsDescription();
+  } else if (_request->requestPath() == "/_admin/metrics") {
+    getMetrics();
+  } else if (_request->requestPath() == "/_admin/trace") {
+    getTraces();
   } else {
     generateError(rest::ResponseCode::NOT_FOUND, TRI_ERROR_HTTP_NOT_FOUND);
   }
@@ -93,6 +105,20 @@ void RestAdminStatisticsHandler::getStatistics() {
   desc->serverStatistics(tmp);
   tmp.close();  // server
 
+  if (ServerState::instance()->isCoordinator()) {
+    tmp.add("clusterComm", VPackValue(VPackValueType::Object, true));
+    ClusterCommStatistics::toVelocyPack(tmp);
+    tmp.close();  // clusterComm
+
+    tmp.add("followerLag", VPackValue(VPackValueType::Object, true));
+    FollowerReads::toVelocyPack(tmp);
+    tmp.close();  // followerLag
+  } else if (ServerState::instance()->isDBServer()) {
+    tmp.add("maintenance", VPackValue(VPackValueType::Object, true));
+    MaintenanceStatistics::toVelocyPack(tmp);
+    tmp.close();  // maintenance
+  }
+
   tmp.add(StaticStrings::Error, VPackValue(false));
   tmp.add(StaticStrings::Code, VPackValue(static_cast<int>(ResponseCode::OK)));
   tmp.close();  // outer
@@ -132,3 +158,64 @@ void RestAdminStatisticsHandler::getStatisticsDescription() {
   tmp.close();  // outer
   generateResult(ResponseCode::OK, std::move(buffer));
 }
+
+void RestAdminStatisticsHandler::getMetrics() {
+  auto* feature =
+      application_features::ApplicationServer::getFeature<StatisticsFeature>(
+          "Statistics");
+  if (!feature->exportMetricsApi()) {
+    generateError(rest::ResponseCode::NOT_FOUND, TRI_ERROR_DISABLED,
+                  "metrics API not enabled");
+    return;
+  }
+
+  std::string result;
+  metrics::toPrometheus(result);
+
+  _response->setResponseCode(rest::ResponseCode::OK);
+  switch (_response->transportType()) {
+    case Endpoint::TransportType::HTTP: {
+      HttpResponse* httpResponse = dynamic_cast<HttpResponse*>(_response.get());
+      if (httpResponse == nullptr) {
+        THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "unable to cast response object");
+      }
+      _response->setContentType(std::string("text/plain; version=0.0.4"));
+      httpResponse->body().appendText(result.data(), result.size());
+      break;
+    }
+    case Endpoint::TransportType::VST: {
+      VPackBuffer<uint8_t> buffer;
+      VPackBuilder builder(buffer);
+      builder.add(VPackValuePair(result.data(), result.size(), VPackValueType::String));
+      _response->setContentType(rest::ContentType::VPACK);
+      _response->setPayload(std::move(buffer), true);
+      break;
+    }
+  }
+}
+
+void RestAdminStatisticsHandler::getTraces() {
+  if (!tracing::enabled()) {
+    generateError(rest::ResponseCode::NOT_FOUND, TRI_ERROR_DISABLED,
+                  "tracing not enabled");
+    return;
+  }
+
+  // clients can poll with the value of "next" to only get new spans
+  bool found;
+  std::string const& since = _request->value("since", found);
+
+  std::vector<tracing::SpanRecord> spans;
+  uint64_t next = tracing::spans(found ? StringUtils::uint64(since) : 0, spans);
+
+  VPackBuffer<uint8_t> buffer;
+  VPackBuilder tmp(buffer);
+  tmp.openObject();
+  tmp.add(VPackValue("spans"));
+  tracing::toVelocyPack(spans, tmp);
+  tmp.add("next", VPackValue(next));
+  tmp.add(StaticStrings::Error, VPackValue(false));
+  tmp.add(StaticStrings::Code, VPackValue(static_cast<int>(ResponseCode::OK)));
+  tmp.close();
+  generateResult(ResponseCode::OK, std::move(buffer));
+}
@@ -41,6 +41,8 @@ class RestAdminStatisticsHandler : public RestBaseHandler {
  private:
   void getStatistics();
   void getStatisticsDescription();
+  void getMetrics();
+  void getTraces();
 };
 }  // namespace arangodb
 
@@ -23,6 +23,7 @@
 
 #include "RestBatchHandler.h"
 
+#include "Basics/MutexLocker.h"
 #include "Basics/StaticStrings.h"
 #include "Basics/StringUtils.h"
 #include "GeneralServer/GeneralServer.h"
@@ -37,8 +38,17 @@ using namespace arangodb;
 using namespace arangodb::basics;
 using namespace arangodb::rest;
 
+namespace {
+/// @brief upper bound for the "concurrency" parameter of a batch
+constexpr size_t maxConcurrency = 32;
+}  // namespace
+
 RestBatchHandler::RestBatchHandler(GeneralRequest* request, GeneralResponse* response)
-    : RestVocbaseBaseHandler(request, response), _errors(0) {}
+    : RestVocbaseBaseHandler(request, response),
+      _errors(0),
+      _partsScheduled(0),
+      _partsDone(0),
+      _queueFull(false) {}
 
 RestBatchHandler::~RestBatchHandler() {}
 
@@ -66,19 +76,11 @@ RestStatus RestBatchHandler::executeVst() {
   return RestStatus::DONE;
 }
 
-void RestBatchHandler::processSubHandlerResult(RestHandler const& handler) {
+void RestBatchHandler::appendPartResponse(HttpResponse& partResponse,
+                                          char const* contentId, size_t contentIdLength) {
   HttpResponse* httpResponse = dynamic_cast<HttpResponse*>(_response.get());
 
-  HttpResponse* partResponse = dynamic_cast<HttpResponse*>(handler.response());
-
-  if (partResponse == nullptr) {
-    generateError(rest::ResponseCode::BAD, TRI_ERROR_INTERNAL,
-                  "could not create a response for batch part request");
-    continueHandlerExecution();
-    return;
-  }
-
-  rest::ResponseCode const code = partResponse->responseCode();
+  rest::ResponseCode const code = partResponse.responseCode();
 
   // count everything above 400 as error
   if (int(code) >= 400) {
@@ -90,34 +92,52 @@ void RestBatchHandler::processSubHandlerResult(RestHandler const& handler) {
   httpResponse->body().appendText(StaticStrings::BatchContentType);
 
   // append content-id if it is present
-  if (_helper.contentId != nullptr) {
-    httpResponse->body().appendText(
-        "\r\nContent-Id: " + std::string(_helper.contentId, _helper.contentIdLength));
+  if (contentId != nullptr) {
+    httpResponse->body().appendText("\r\nContent-Id: " +
+                                    std::string(contentId, contentIdLength));
   }
 
   httpResponse->body().appendText(TRI_CHAR_LENGTH_PAIR("\r\n\r\n"));
 
   // remove some headers we don't need
-  partResponse->setConnectionType(rest::ConnectionType::C_NONE);
-  partResponse->setHeaderNC(StaticStrings::Server, "");
+  partResponse.setConnectionType(rest::ConnectionType::C_NONE);
+  partResponse.setHeaderNC(StaticStrings::Server, "");
 
   // append the part response header
-  partResponse->writeHeader(&httpResponse->body());
+  partResponse.writeHeader(&httpResponse->body());
 
   // append the part response body
-  httpResponse->body().appendText(partResponse->body());
+  httpResponse->body().appendText(partResponse.body());
   httpResponse->body().appendText(TRI_CHAR_LENGTH_PAIR("\r\n"));
+}
+
+void RestBatchHandler::finishResponse() {
+  HttpResponse* httpResponse = dynamic_cast<HttpResponse*>(_response.get());
+
+  // append final boundary + "--"
+  httpResponse->body().appendText(_boundary + "--");
+
+  if (_errors > 0) {
+    httpResponse->setHeaderNC(StaticStrings::Errors, StringUtils::itoa(_errors));
+  }
+}
+
+void RestBatchHandler::processSubHandlerResult(RestHandler const& handler) {
+  HttpResponse* partResponse = dynamic_cast<HttpResponse*>(handler.response());
+
+  if (partResponse == nullptr) {
+    generateError(rest::ResponseCode::BAD, TRI_ERROR_INTERNAL,
+                  "could not create a response for batch part request");
+    continueHandlerExecution();
+    return;
+  }
+
+  appendPartResponse(*partResponse, _helper.contentId, _helper.contentIdLength);
 
   // we've read the last part
   if (!_helper.containsMore) {
     // complete the handler
-
-    // append final boundary + "--"
-    httpResponse->body().appendText(_boundary + "--");
-
-    if (_errors > 0) {
-      httpResponse->setHeaderNC(StaticStrings::Errors, StringUtils::itoa(_errors));
-    }
+    finishResponse();
     continueHandlerExecution();
   } else {
     if (!executeNextHandler()) {
@@ -126,7 +146,7 @@ void RestBatchHandler::processSubHandlerResult(RestHandler const& handler) {
   }
 }
 
-bool RestBatchHandler::executeNextHandler() {
+bool RestBatchHandler::createPartHandler(std::shared_ptr<RestHandler>& handler) {
   // get authorization header. we will inject this into the subparts
   std::string const& authorization = _request->header(StaticStrings::Authorization);
 
@@ -199,8 +219,6 @@ bool RestBatchHandler::executeNextHandler() {
                        authorization.c_str(), authorization.size());
   }
 
-  std::shared_ptr<RestHandler> handler;
-
   {
     std::unique_ptr<HttpResponse> response(new HttpResponse(rest::ResponseCode::SERVER_ERROR, new StringBuffer(false)));
 
@@ -216,6 +234,15 @@ bool RestBatchHandler::executeNextHandler() {
     }
   }
 
+  return true;
+}
+
+bool RestBatchHandler::executeNextHandler() {
+  std::shared_ptr<RestHandler> handler;
+  if (!createPartHandler(handler)) {
+    return false;
+  }
+
   // assume a bad lane, so the request is definitely executed via the queues
   auto const lane = RequestLane::CLIENT_V8;
 
@@ -243,6 +270,97 @@ bool RestBatchHandler::executeNextHandler() {
   return true;
 }
 
+bool RestBatchHandler::executeParallel(size_t concurrency) {
+  // parts are independent of each other, so they can all be set up now
+  do {
+    std::shared_ptr<RestHandler> handler;
+    if (!createPartHandler(handler)) {
+      return false;
+    }
+    _parts.push_back(Part{std::move(handler), _helper.contentId, _helper.contentIdLength});
+  } while (_helper.containsMore);
+
+  MUTEX_LOCKER(guard, _partsLock);
+  while (_partsScheduled < std::min(concurrency, _parts.size())) {
+    if (!scheduleNextPart()) {
+      break;
+    }
+  }
+
+  if (_partsScheduled == 0) {
+    generateError(rest::ResponseCode::SERVICE_UNAVAILABLE, TRI_ERROR_QUEUE_FULL);
+    return false;
+  }
+  return true;
+}
+
+bool RestBatchHandler::scheduleNextPart() {
+  TRI_ASSERT(_partsScheduled < _parts.size());
+  auto handler = _parts[_partsScheduled].handler;
+
+  // unlike in sequential mode, the lane of the part is used. parts that
+  // need V8 still go through the V8 lane, but reads are not throttled by it
+  bool ok = SchedulerFeature::SCHEDULER->queue(
+      handler->lane(), [this, self = shared_from_this(), handler]() {
+        // ignore any errors here, will be handled later by inspecting the response
+        try {
+          ExecContextScope scope(nullptr);  // workaround because of assertions
+          handler->runHandler([this, self](RestHandler*) { parallelPartDone(); });
+        } catch (...) {
+          parallelPartDone();
+        }
+      });
+
+  if (!ok) {
+    _queueFull = true;
+    return false;
+  }
+  ++_partsScheduled;
+  return true;
+}
+
+void RestBatchHandler::parallelPartDone() {
+  {
+    MUTEX_LOCKER(guard, _partsLock);
+    ++_partsDone;
+    if (!_queueFull && _partsScheduled < _parts.size()) {
+      // keep the number of running parts constant
+      scheduleNextPart();
+    }
+    if (_partsDone < _partsScheduled) {
+      // other parts are still running
+      return;
+    }
+  }
+
+  // all parts are done, or no more parts can be scheduled
+  finishParallel();
+}
+
+void RestBatchHandler::finishParallel() {
+  if (_queueFull) {
+    generateError(rest::ResponseCode::SERVICE_UNAVAILABLE, TRI_ERROR_QUEUE_FULL);
+    continueHandlerExecution();
+    return;
+  }
+
+  for (auto const& part : _parts) {
+    HttpResponse* partResponse = dynamic_cast<HttpResponse*>(part.handler->response());
+
+    if (partResponse == nullptr) {
+      generateError(rest::ResponseCode::BAD, TRI_ERROR_INTERNAL,
+                    "could not create a response for batch part request");
+      continueHandlerExecution();
+      return;
+    }
+
+    appendPartResponse(*partResponse, part.contentId, part.contentIdLength);
+  }
+
+  finishResponse();
+  continueHandlerExecution();
+}
+
 RestStatus RestBatchHandler::executeHttp() {
   HttpResponse* httpResponse = dynamic_cast<HttpResponse*>(_response.get());
 
@@ -291,6 +409,19 @@ RestStatus RestBatchHandler::executeHttp() {
   _helper.message = _multipartMessage;
   _helper.searchStart = _multipartMessage.messageStart;
 
+  // parts are executed one after the other, unless the client declares
+  // them independent by asking for more concurrency
+  bool found;
+  std::string const& value = _request->value("concurrency", found);
+  size_t concurrency = 1;
+  if (found) {
+    concurrency = std::min(static_cast<size_t>(StringUtils::uint64(value)), ::maxConcurrency);
+  }
+
+  if (concurrency > 1) {
+    return executeParallel(concurrency) ? RestStatus::WAITING : RestStatus::DONE;
+  }
+
   // and wait for completion
   return executeNextHandler() ? RestStatus::WAITING : RestStatus::DONE;
 }
@@ -25,6 +25,7 @@
 #define ARANGOD_REST_HANDLER_REST_BATCH_HANDLER_H 1
 
 #include "Basics/Common.h"
+#include "Basics/Mutex.h"
 #include "RestHandler/RestVocbaseBaseHandler.h"
 
 namespace arangodb {
@@ -84,13 +85,47 @@ class RestBatchHandler : public RestVocbaseBaseHandler {
   bool extractPart(SearchHelper&);
 
  private:
+  // extract the next part and create a handler for it
+  bool createPartHandler(std::shared_ptr<RestHandler>& handler);
+
+  // append the response of a part to the batch response
+  void appendPartResponse(HttpResponse& partResponse, char const* contentId,
+                          size_t contentIdLength);
+
+  // append the final boundary to the batch response
+  void finishResponse();
+
   bool executeNextHandler();
   void processSubHandlerResult(RestHandler const& handler);
 
+  // parallel mode: all parts are extracted up front and executed with at
+  // most the requested concurrency. the responses are assembled in the
+  // order of the parts once all of them are done
+  bool executeParallel(size_t concurrency);
+  // must be called under _partsLock
+  bool scheduleNextPart();
+  void parallelPartDone();
+  void finishParallel();
+
   MultipartMessage _multipartMessage;
   SearchHelper _helper;
   size_t _errors;
   std::string _boundary;
+
+  struct Part {
+    std::shared_ptr<RestHandler> handler;
+    char const* contentId;
+    size_t contentIdLength;
+  };
+
+  Mutex _partsLock;
+  std::vector<Part> _parts;
+  // number of parts scheduled so far
+  size_t _partsScheduled;
+  // number of scheduled parts that have finished
+  size_t _partsDone;
+  // whether the scheduler refused to queue a part
+  bool _queueFull;
 };
 }  // namespace arangodb
 
@@ -26,11 +26,13 @@
 #include "ApplicationFeatures/ApplicationServer.h"
 #include "Cluster/ClusterFeature.h"
 #include "Cluster/ClusterInfo.h"
+#include "Cluster/ClusterMethods.h"
 #include "Cluster/ServerState.h"
 #include "Rest/HttpRequest.h"
 #include "StorageEngine/EngineSelectorFeature.h"
 #include "StorageEngine/PhysicalCollection.h"
 #include "StorageEngine/StorageEngine.h"
+#include "Transaction/Helpers.h"
 #include "Transaction/Methods.h"
 #include "Transaction/StandaloneContext.h"
 #include "Utils/Events.h"
@@ -169,6 +171,29 @@ void RestCollectionHandler::handleCommandGet() {
     } else if (sub == "count") {
       // /_api/collection/<identifier>/count
       bool details = _request->parsedValue("details", false);
+      if (_request->parsedValue("approximate", false) &&
+          ServerState::instance()->isCoordinator()) {
+        // answer from the counts the DB servers report to the agency, without
+        // a transaction and without contacting any DB server
+        std::vector<std::pair<std::string, uint64_t>> counts;
+        int res = approximateCountOnCoordinator(_vocbase.name(), coll->name(), counts);
+        if (res == TRI_ERROR_NO_ERROR) {
+          int64_t total = 0;
+          OperationResult opRes = transaction::helpers::buildCountResult(
+              counts, details ? transaction::CountType::Detailed : transaction::CountType::Normal,
+              total);
+          VPackObjectBuilder obj(&builder, true);
+          obj->add("count", opRes.slice());
+          obj->add("approximate", VPackValue(true));
+          collectionRepresentation(builder, *coll,
+                                   /*showProperties*/ false,
+                                   /*showFigures*/ false,
+                                   /*showCount*/ false,
+                                   /*detailedCount*/ false);
+          return;
+        }
+        // not all shards have reported yet, fall back to an exact count
+      }
       collectionRepresentation(builder, *coll,
                                /*showProperties*/ true,
                                /*showFigures*/ false,
@@ -303,7 +328,10 @@ void RestCollectionHandler::handleCommandPost() {
                 "doCompact", StaticStrings::DataSourceSystem,
                 StaticStrings::DataSourceId, "isVolatile", "journalSize",
                 "indexBuckets", "keyOptions", StaticStrings::WaitForSyncString,
-                "cacheEnabled", StaticStrings::ShardKeys, StaticStrings::NumberOfShards,
+                "cacheEnabled", "compressDocuments", "dedicatedColumnFamily",
+                "documentsCompactionStyle",
+                StaticStrings::ShardKeys,
+                StaticStrings::NumberOfShards,
                 StaticStrings::DistributeShardsLike, "avoidServers", StaticStrings::IsSmart,
                 "shardingStrategy", StaticStrings::GraphSmartGraphAttribute, 
                 StaticStrings::SmartJoinAttribute, StaticStrings::ReplicationFactor,
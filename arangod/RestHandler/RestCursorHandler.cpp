@@ -30,12 +30,17 @@
 #include "Basics/VelocyPackHelper.h"
 #include "Basics/ScopeGuard.h"
 #include "Cluster/ServerState.h"
+#include "Rest/ResponseBodyStream.h"
+#include "Scheduler/Scheduler.h"
+#include "Scheduler/SchedulerFeature.h"
 #include "Transaction/Context.h"
 #include "Utils/Cursor.h"
 #include "Utils/CursorRepository.h"
 #include "Utils/Events.h"
 
+#include <velocypack/Dumper.h>
 #include <velocypack/Iterator.h>
+#include <velocypack/Sink.h>
 #include <velocypack/Value.h>
 #include <velocypack/velocypack-aliases.h>
 
@@ -50,6 +55,8 @@ RestCursorHandler::RestCursorHandler(GeneralRequest* request, GeneralResponse* r
       _queryResult(),
       _queryRegistry(queryRegistry),
       _leasedCursor(nullptr),
+      _chunkedCursor(nullptr),
+      _chunked(false),
       _hasStarted(false),
       _queryKilled(false),
       _isValidForFinalize(false),
@@ -61,6 +68,12 @@ RestCursorHandler::~RestCursorHandler() {
     TRI_ASSERT(cursors != nullptr);
     cursors->release(_leasedCursor);
   }
+  if (_chunkedCursor != nullptr) {
+    auto cursors = _vocbase.cursorRepository();
+    TRI_ASSERT(cursors != nullptr);
+    _chunkedCursor->setDeleted();
+    cursors->release(_chunkedCursor);
+  }
 }
 
 RestStatus RestCursorHandler::execute() {
@@ -90,6 +103,9 @@ RestStatus RestCursorHandler::continueExecute() {
     Cursor* cs = _leasedCursor;
     _leasedCursor = nullptr;
     if (type == rest::RequestType::POST) {
+      if (_chunked) {
+        return generateChunkedResult(cs);
+      }
       return generateCursorResult(rest::ResponseCode::CREATED, cs);
     } else if (type == rest::RequestType::PUT) {
       if (_request->requestPath() == SIMPLE_QUERY_ALL_PATH) {
@@ -205,10 +221,16 @@ RestStatus RestCursorHandler::registerQueryOrCursor(VPackSlice const& slice) {
   bool count = VelocyPackHelper::getBooleanValue(opts, "count", false);
 
   if (stream) {
+    _chunked = VelocyPackHelper::getBooleanValue(opts, "chunked", false);
+
     if (count) {
       generateError(Result(TRI_ERROR_BAD_PARAMETER,
                            "cannot use 'count' option for a streaming query"));
       return RestStatus::DONE;
+    } else if (_chunked && !_response->allowBodyStream()) {
+      generateError(Result(TRI_ERROR_BAD_PARAMETER,
+                           "'chunked' results require a synchronous HTTP/1.1 request"));
+      return RestStatus::DONE;
     } else {
       CursorRepository* cursors = _vocbase.cursorRepository();
       TRI_ASSERT(cursors != nullptr);
@@ -217,6 +239,9 @@ RestStatus RestCursorHandler::registerQueryOrCursor(VPackSlice const& slice) {
                                                   /*contextOwnedByExt*/ false,
                                                   createAQLTransactionContext());
 
+      if (_chunked) {
+        return generateChunkedResult(cursor);
+      }
       return generateCursorResult(rest::ResponseCode::CREATED, cursor);
     }
   }
@@ -454,6 +479,10 @@ void RestCursorHandler::buildOptions(VPackSlice const& slice) {
     if (!isStream) {
       isStream = VelocyPackHelper::getBooleanValue(opts, "stream", false);
     }
+    if (!isStream) {
+      // chunked results are produced by a streaming cursor
+      isStream = VelocyPackHelper::getBooleanValue(opts, "chunked", false);
+    }
     for (auto const& it : VPackObjectIterator(opts)) {
       if (!it.key.isString() || it.value.isNone()) {
         continue;
@@ -553,6 +582,168 @@ RestStatus RestCursorHandler::generateCursorResult(rest::ResponseCode code,
   return RestStatus::DONE;
 }
 
+RestStatus RestCursorHandler::generateChunkedResult(arangodb::Cursor* cursor) {
+  // always clean up, unless the cursor is handed over to the producer
+  auto guard = scopeGuard([this, &cursor]() {
+    auto cursors = _vocbase.cursorRepository();
+    TRI_ASSERT(cursors != nullptr);
+    cursors->release(cursor);
+  });
+
+  std::string chunk;
+  bool hasMore = false;
+  aql::ExecutionState state;
+  Result r;
+  std::tie(state, r) = dumpChunk(cursor, chunk, hasMore, [self = shared_from_this()]() {
+    self->continueHandlerExecution();
+  });
+  if (state == aql::ExecutionState::WAITING) {
+    _leasedCursor = cursor;
+    guard.cancel();
+    return RestStatus::WAITING;
+  }
+
+  if (r.fail()) {
+    // the first batch decides about the response code
+    generateError(r);
+    return RestStatus::DONE;
+  }
+
+  resetResponse(rest::ResponseCode::CREATED);
+  _response->setContentType(rest::ContentType::DUMP);
+
+  _chunkStream = std::make_shared<ResponseBodyStream>();
+  _response->setBodyStream(_chunkStream);
+
+  if (!hasMore) {
+    _chunkStream->write(std::move(chunk), true);
+    _chunkStream.reset();
+    return RestStatus::DONE;
+  }
+
+  // the remaining batches are produced after the response has been handed
+  // over, paced by the connection
+  _chunkedCursor = cursor;
+  guard.cancel();
+  _chunkStream->setResumeCallback([self = shared_from_this()]() {
+    static_cast<RestCursorHandler*>(self.get())->scheduleChunks();
+  });
+
+  if (_chunkStream->write(std::move(chunk), false)) {
+    scheduleChunks();
+  }
+  return RestStatus::DONE;
+}
+
+std::pair<aql::ExecutionState, Result> RestCursorHandler::dumpChunk(
+    arangodb::Cursor* cursor, std::string& out, bool& hasMore,
+    std::function<void()> const& continueCallback) {
+  // dump might delete the cursor
+  std::shared_ptr<transaction::Context> ctx = cursor->context();
+
+  VPackBuffer<uint8_t> buffer;
+  VPackBuilder builder(buffer);
+  builder.openObject();
+
+  aql::ExecutionState state;
+  Result r;
+  std::tie(state, r) = cursor->dump(builder, continueCallback);
+  if (state == aql::ExecutionState::WAITING || r.fail()) {
+    return {state, r};
+  }
+
+  builder.add(StaticStrings::Error, VPackValue(false));
+  builder.add(StaticStrings::Code, VPackValue(static_cast<int>(rest::ResponseCode::CREATED)));
+  builder.close();
+
+  hasMore = builder.slice().get("hasMore").isTrue();
+
+  VPackStringSink sink(&out);
+  VPackDumper dumper(&sink, ctx->getVPackOptionsForDump());
+  dumper.dump(builder.slice());
+  out.push_back('\n');
+
+  return {state, r};
+}
+
+void RestCursorHandler::writeChunks() {
+  TRI_ASSERT(_chunkedCursor != nullptr);
+
+  auto self = shared_from_this();
+
+  while (true) {
+    if (_chunkStream->aborted()) {
+      // the client went away
+      _chunkedCursor->setDeleted();
+      finishChunks();
+      return;
+    }
+
+    std::string chunk;
+    bool hasMore = false;
+    aql::ExecutionState state;
+    Result r;
+    std::tie(state, r) = dumpChunk(_chunkedCursor, chunk, hasMore, [self]() {
+      static_cast<RestCursorHandler*>(self.get())->scheduleChunks();
+    });
+    if (state == aql::ExecutionState::WAITING) {
+      // continued by the query
+      return;
+    }
+
+    if (r.fail()) {
+      // the response code is sent already, the error is the last line
+      VPackBuilder error;
+      error.openObject();
+      error.add(StaticStrings::Error, VPackValue(true));
+      error.add(StaticStrings::ErrorNum, VPackValue(r.errorNumber()));
+      error.add(StaticStrings::ErrorMessage, VPackValue(r.errorMessage()));
+      error.add(StaticStrings::Code,
+                VPackValue(static_cast<int>(GeneralResponse::responseCode(r.errorNumber()))));
+      error.close();
+      chunk = error.slice().toJson() + "\n";
+      _chunkedCursor->setDeleted();
+      hasMore = false;
+    }
+
+    bool const more = _chunkStream->write(std::move(chunk), !hasMore);
+
+    if (!hasMore) {
+      finishChunks();
+      return;
+    }
+    if (!more) {
+      // continued by the connection, which may already have happened
+      return;
+    }
+  }
+}
+
+void RestCursorHandler::scheduleChunks() {
+  bool ok = SchedulerFeature::SCHEDULER->queue(lane(), [self = shared_from_this()]() {
+    static_cast<RestCursorHandler*>(self.get())->writeChunks();
+  });
+
+  if (!ok) {
+    LOG_TOPIC("8a1f4", WARN, Logger::QUERIES)
+        << "cannot continue chunked result of cursor, queue is full";
+    _chunkStream->abort();
+    _chunkedCursor->setDeleted();
+    finishChunks();
+  }
+}
+
+void RestCursorHandler::finishChunks() {
+  auto cursors = _vocbase.cursorRepository();
+  TRI_ASSERT(cursors != nullptr);
+  cursors->release(_chunkedCursor);
+  _chunkedCursor = nullptr;
+
+  // the callback keeps this handler alive
+  _chunkStream->setResumeCallback(std::function<void()>());
+  _chunkStream.reset();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief was docuBlock JSF_post_api_cursor
 ////////////////////////////////////////////////////////////////////////////////
@@ -24,6 +24,7 @@
 #ifndef ARANGOD_REST_HANDLER_REST_CURSOR_HANDLER_H
 #define ARANGOD_REST_HANDLER_REST_CURSOR_HANDLER_H 1
 
+#include "Aql/ExecutionState.h"
 #include "Aql/QueryResult.h"
 #include "Basics/Common.h"
 #include "Basics/Mutex.h"
@@ -47,6 +48,7 @@ struct QueryResult;
 }  // namespace aql
 
 class Cursor;
+class ResponseBodyStream;
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief cursor request handler
@@ -137,6 +139,32 @@ class RestCursorHandler : public RestVocbaseBaseHandler {
 
   RestStatus generateCursorResult(rest::ResponseCode code, arangodb::Cursor*);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief respond with the first batch of the cursor and keep writing the
+  /// following batches into the chunked response body, one line of JSON
+  /// per batch. this function takes care of the cursor as well
+  //////////////////////////////////////////////////////////////////////////////
+
+  RestStatus generateChunkedResult(arangodb::Cursor*);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief dumps the next batch of the cursor as one line of JSON
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::pair<aql::ExecutionState, Result> dumpChunk(arangodb::Cursor*, std::string& out,
+                                                   bool& hasMore,
+                                                   std::function<void()> const& continueCallback);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief writes batches into the response stream until the connection
+  /// has to catch up, the query has to wait or the cursor is exhausted.
+  /// runs on a scheduler thread after the response has been handed over
+  //////////////////////////////////////////////////////////////////////////////
+
+  void writeChunks();
+  void scheduleChunks();
+  void finishChunks();
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief create a cursor and return the first results
   //////////////////////////////////////////////////////////////////////////////
@@ -180,6 +208,17 @@ class RestCursorHandler : public RestVocbaseBaseHandler {
   //////////////////////////////////////////////////////////////////////////////
   Cursor* _leasedCursor;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief cursor and response stream of a chunked result, owned by the
+  /// producer of the chunks once the response has been handed over
+  //////////////////////////////////////////////////////////////////////////////
+
+  Cursor* _chunkedCursor;
+  std::shared_ptr<ResponseBodyStream> _chunkStream;
+
+  /// @brief whether the client has asked for a chunked result
+  bool _chunked;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief lock for currently running query
   //////////////////////////////////////////////////////////////////////////////
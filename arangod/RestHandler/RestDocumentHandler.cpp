@@ -22,11 +22,16 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "RestDocumentHandler.h"
+#include "Basics/HybridLogicalClock.h"
 #include "Basics/StaticStrings.h"
 #include "Basics/StringUtils.h"
 #include "Basics/VelocyPackHelper.h"
+#include "Cluster/FollowerInfo.h"
 #include "Cluster/ServerState.h"
 #include "Rest/HttpRequest.h"
+#include "Scheduler/Scheduler.h"
+#include "Scheduler/SchedulerFeature.h"
+#include "StorageEngine/EngineSelectorFeature.h"
 #include "Transaction/Helpers.h"
 #include "Transaction/Hints.h"
 #include "Transaction/StandaloneContext.h"
@@ -42,7 +47,16 @@ using namespace arangodb::basics;
 using namespace arangodb::rest;
 
 RestDocumentHandler::RestDocumentHandler(GeneralRequest* request, GeneralResponse* response)
-    : RestVocbaseBaseHandler(request, response) {}
+    : RestVocbaseBaseHandler(request, response), _wouldBlock(false) {}
+
+bool RestDocumentHandler::canRunOnIoThread() const {
+  // reads by key, which the rocksdb engine can try to answer from memtables
+  // and caches. in a cluster the lookup always involves the network
+  auto const type = _request->requestType();
+  return (type == rest::RequestType::GET || type == rest::RequestType::HEAD) &&
+         _request->suffixes().size() == 2 &&
+         ServerState::instance()->isSingleServer() && EngineSelectorFeature::isRocksDB();
+}
 
 RestStatus RestDocumentHandler::execute() {
   // extract the sub-request type
@@ -71,10 +85,37 @@ RestStatus RestDocumentHandler::execute() {
     default: { generateNotImplemented("ILLEGAL " + DOCUMENT_PATH); }
   }
 
+  if (_wouldBlock) {
+    return continueOnScheduler();
+  }
+
   // this handler is done
   return RestStatus::DONE;
 }
 
+RestStatus RestDocumentHandler::continueExecute() {
+  // the read started on the IO thread is simply repeated
+  TRI_ASSERT(!_onIoThread);
+  return execute();
+}
+
+RestStatus RestDocumentHandler::continueOnScheduler() {
+  TRI_ASSERT(_onIoThread);
+  _wouldBlock = false;
+  _onIoThread = false;
+
+  bool ok = SchedulerFeature::SCHEDULER->queue(lane(), [self = shared_from_this()]() {
+    self->continueHandlerExecution();
+  });
+
+  if (ok) {
+    return RestStatus::WAITING;
+  }
+
+  generateError(rest::ResponseCode::SERVICE_UNAVAILABLE, TRI_ERROR_QUEUE_FULL);
+  return RestStatus::DONE;
+}
+
 void RestDocumentHandler::shutdownExecute(bool isFinalized) noexcept {
   try {
     GeneralRequest const* request = _request.get();
@@ -196,6 +237,10 @@ bool RestDocumentHandler::insertDocument() {
     return false;
   }
 
+  if (!opOptions.isSynchronousReplicationFrom.empty()) {
+    advanceAppliedTimestamp(collectionName);
+  }
+
   generateSaved(result, collectionName,
                 TRI_col_type_e(trx->getCollectionType(collectionName)),
                 trx->transactionContextPtr()->getVPackOptionsForDump(), isMultiple);
@@ -247,6 +292,12 @@ bool RestDocumentHandler::readSingleDocument(bool generateBody) {
 
   OperationOptions options;
   options.ignoreRevs = true;
+  extractFollowerReadOptions(options);
+
+  uint64_t appliedTimestamp = 0;
+  if (!checkFollowerRead(collection, appliedTimestamp)) {
+    return false;
+  }
 
   TRI_voc_rid_t ifRid = extractRevision("if-match", isValidRevision);
   if (!isValidRevision) {
@@ -269,6 +320,10 @@ bool RestDocumentHandler::readSingleDocument(bool generateBody) {
   auto trx = createTransaction(collection, AccessMode::Type::READ);
 
   trx->addHint(transaction::Hints::Hint::SINGLE_OPERATION);
+  if (_onIoThread) {
+    // the IO thread must not wait for disk
+    trx->addHint(transaction::Hints::Hint::NO_BLOCKING_READ);
+  }
 
   // ...........................................................................
   // inside read transaction
@@ -281,7 +336,21 @@ bool RestDocumentHandler::readSingleDocument(bool generateBody) {
     return false;
   }
 
-  OperationResult result = trx->document(collection, search, options);
+  OperationResult result;
+  try {
+    result = trx->document(collection, search, options);
+  } catch (basics::Exception const& ex) {
+    if (!_onIoThread || ex.code() != TRI_ERROR_ARANGO_INCOMPLETE_READ) {
+      throw;
+    }
+    result.result.reset(TRI_ERROR_ARANGO_INCOMPLETE_READ);
+  }
+
+  if (_onIoThread && result.is(TRI_ERROR_ARANGO_INCOMPLETE_READ)) {
+    // not in memory, read it again on a scheduler thread
+    _wouldBlock = true;
+    return false;
+  }
 
   res = trx->finish(result.result);
 
@@ -313,6 +382,7 @@ bool RestDocumentHandler::readSingleDocument(bool generateBody) {
   // use default options
   generateDocument(result.slice(), generateBody,
                    trx->transactionContextPtr()->getVPackOptionsForDump());
+  addFollowerReadHeaders(options, appliedTimestamp);
   return true;
 }
 
@@ -495,6 +565,10 @@ bool RestDocumentHandler::modifyDocument(bool isPatch) {
     return false;
   }
 
+  if (!opOptions.isSynchronousReplicationFrom.empty()) {
+    advanceAppliedTimestamp(collectionName);
+  }
+
   generateSaved(result, collectionName,
                 TRI_col_type_e(trx->getCollectionType(collectionName)),
                 trx->transactionContextPtr()->getVPackOptionsForDump(), isArrayCase);
@@ -605,6 +679,10 @@ bool RestDocumentHandler::removeDocument() {
     return false;
   }
 
+  if (!opOptions.isSynchronousReplicationFrom.empty()) {
+    advanceAppliedTimestamp(collectionName);
+  }
+
   generateDeleted(result, collectionName,
                   TRI_col_type_e(trx->getCollectionType(collectionName)),
                   trx->transactionContextPtr()->getVPackOptionsForDump(), isMultiple);
@@ -629,6 +707,12 @@ bool RestDocumentHandler::readManyDocuments() {
 
   OperationOptions opOptions;
   opOptions.ignoreRevs = _request->parsedValue(StaticStrings::IgnoreRevsString, true);
+  extractFollowerReadOptions(opOptions);
+
+  uint64_t appliedTimestamp = 0;
+  if (!checkFollowerRead(collectionName, appliedTimestamp)) {
+    return false;
+  }
 
   auto trx = createTransaction(collectionName, AccessMode::Type::READ);
 
@@ -662,5 +746,89 @@ bool RestDocumentHandler::readManyDocuments() {
 
   generateDocument(result.slice(), true,
                    trx->transactionContextPtr()->getVPackOptionsForDump());
+  addFollowerReadHeaders(opOptions, appliedTimestamp);
+  return true;
+}
+
+void RestDocumentHandler::extractFollowerReadOptions(OperationOptions& options) {
+  if (!ServerState::instance()->isCoordinator()) {
+    return;
+  }
+  bool found = false;
+  std::string const& allow = _request->header(StaticStrings::AllowDirtyReads, found);
+  if (!found || !StringUtils::boolean(allow)) {
+    return;
+  }
+  options.allowDirtyReads = true;
+  // uses the encoding of _rev values, so that clients can pass the revision
+  // of their last write to read their own writes
+  std::string const& timestamp = _request->header(StaticStrings::ReadTimestamp, found);
+  if (found) {
+    options.readTimestamp = HybridLogicalClock::decodeTimeStamp(timestamp);
+  }
+}
+
+bool RestDocumentHandler::checkFollowerRead(std::string const& collectionName,
+                                            uint64_t& appliedTimestamp) {
+  if (!ServerState::instance()->isDBServer()) {
+    return true;
+  }
+  bool found = false;
+  std::string const& allow = _request->header(StaticStrings::AllowDirtyReads, found);
+  if (!found || !StringUtils::boolean(allow)) {
+    return true;
+  }
+
+  auto collection = _vocbase.lookupCollection(collectionName);
+  if (collection == nullptr || collection->followers()->getLeader().empty()) {
+    // we are the leader, or the read will fail anyway
+    return true;
+  }
+
+  uint64_t requested = 0;
+  std::string const& timestamp = _request->header(StaticStrings::ReadTimestamp, found);
+  if (found) {
+    requested = HybridLogicalClock::decodeTimeStamp(timestamp);
+  }
+
+  appliedTimestamp = collection->followers()->appliedTimestamp();
+  if (appliedTimestamp == 0 || appliedTimestamp < requested) {
+    generateError(rest::ResponseCode::SERVICE_UNAVAILABLE,
+                  TRI_ERROR_CLUSTER_SHARD_FOLLOWER_REFUSES_OPERATION,
+                  "follower has not caught up with the requested read timestamp");
+    addFollowerReadHeaders(OperationOptions(), appliedTimestamp);
+    return false;
+  }
   return true;
 }
+
+void RestDocumentHandler::addFollowerReadHeaders(OperationOptions const& options,
+                                                 uint64_t appliedTimestamp) {
+  if (options.allowDirtyReads) {
+    // coordinator: the result may not contain the latest writes
+    _response->setHeaderNC(StaticStrings::PotentialDirtyRead, "true");
+  }
+  if (appliedTimestamp != 0) {
+    // follower: tell the coordinator how far behind we are
+    _response->setHeaderNC(StaticStrings::AppliedTimestamp,
+                           HybridLogicalClock::encodeTimeStamp(appliedTimestamp));
+  }
+}
+
+void RestDocumentHandler::advanceAppliedTimestamp(std::string const& collectionName) {
+  // the leader's clock when sending the operation. everything it had
+  // acknowledged by then has been replicated to us
+  bool found = false;
+  std::string const& value = _request->header(StaticStrings::HLCHeader, found);
+  if (!found) {
+    return;
+  }
+  uint64_t timestamp = HybridLogicalClock::decodeTimeStamp(value);
+  if (timestamp == 0 || timestamp == UINT64_MAX) {
+    return;
+  }
+  auto collection = _vocbase.lookupCollection(collectionName);
+  if (collection != nullptr) {
+    collection->followers()->advanceAppliedTimestamp(timestamp);
+  }
+}
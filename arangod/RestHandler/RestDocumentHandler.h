@@ -28,12 +28,16 @@
 #include "RestHandler/RestVocbaseBaseHandler.h"
 
 namespace arangodb {
+struct OperationOptions;
+
 class RestDocumentHandler : public RestVocbaseBaseHandler {
  public:
   RestDocumentHandler(GeneralRequest*, GeneralResponse*);
 
  public:
   RestStatus execute() override final;
+  RestStatus continueExecute() override final;
+  bool canRunOnIoThread() const override final;
   char const* name() const override final { return "RestDocumentHandler"; }
   RequestLane lane() const override final { return RequestLane::CLIENT_SLOW; }
   void shutdownExecute(bool isFinalized) noexcept override;
@@ -51,6 +55,9 @@ class RestDocumentHandler : public RestVocbaseBaseHandler {
   // reads a single document
   bool readSingleDocument(bool generateBody);
 
+  // continues a read that started on the IO thread on the scheduler
+  RestStatus continueOnScheduler();
+
   // reads multiple documents
   bool readManyDocuments();
 
@@ -68,6 +75,24 @@ class RestDocumentHandler : public RestVocbaseBaseHandler {
 
   // removes a document
   bool removeDocument();
+
+  // coordinator: reads the options for reads from followers
+  void extractFollowerReadOptions(OperationOptions& options);
+
+  // DB server: refuses a read sent to a follower that is not in sync, or
+  // has not caught up with the requested time stamp
+  bool checkFollowerRead(std::string const& collectionName, uint64_t& appliedTimestamp);
+
+  // flags potentially stale results, and reports the follower's progress
+  void addFollowerReadHeaders(OperationOptions const& options, uint64_t appliedTimestamp);
+
+  // DB server: advances the applied time stamp of a follower after a
+  // synchronously replicated operation
+  void advanceAppliedTimestamp(std::string const& collectionName);
+
+ private:
+  // the read on the IO thread would have had to wait for disk
+  bool _wouldBlock;
 };
 }  // namespace arangodb
 
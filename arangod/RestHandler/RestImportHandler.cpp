@@ -22,13 +22,21 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "RestImportHandler.h"
+#include "Basics/ConditionLocker.h"
+#include "Basics/ConditionVariable.h"
 #include "Basics/NumberUtils.h"
+#include "Basics/ScopeGuard.h"
 #include "Basics/StaticStrings.h"
 #include "Basics/StringUtils.h"
 #include "Basics/VelocyPackHelper.h"
 #include "Cluster/ServerState.h"
 #include "Logger/Logger.h"
 #include "Rest/HttpRequest.h"
+#include "Rest/RequestBodyStream.h"
+#include "Scheduler/Scheduler.h"
+#include "Scheduler/SchedulerFeature.h"
+#include "StorageEngine/EngineSelectorFeature.h"
+#include "StorageEngine/StorageEngine.h"
 #include "Transaction/Helpers.h"
 #include "Transaction/StandaloneContext.h"
 #include "Utils/OperationOptions.h"
@@ -46,6 +54,192 @@ using namespace arangodb;
 using namespace arangodb::basics;
 using namespace arangodb::rest;
 
+namespace {
+/// @brief documents of a streamed body are inserted whenever they take up
+/// this many bytes
+size_t const StreamBatchSize = 4 * 1024 * 1024;
+
+/// @brief linewise bodies held in memory are parsed in chunks of about this
+/// size. bodies of at least two chunks are parsed by up to ParseJobs
+/// scheduler threads in addition to the handler thread
+size_t const ParseChunkSize = 1024 * 1024;
+size_t const ParseJobs = 4;
+
+bool isLineWhitespace(char c) {
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\b' || c == '\f';
+}
+
+/// @brief a chunk of lines of an import body
+struct ParsedChunk {
+  ParsedChunk(char* begin, char* end) : begin(begin), end(end) {}
+
+  char* const begin;
+  char* const end;
+  /// @brief array of the lines that could be parsed
+  VPackBuilder values;
+  /// @brief the number within the chunk of all non-empty lines, and the
+  /// start of those that could not be parsed
+  std::vector<std::pair<size_t, char const*>> lines;
+  size_t numLines = 0;
+  size_t numEmpty = 0;
+  int errorCode = TRI_ERROR_NO_ERROR;
+  bool done = false;
+};
+
+/// @brief parses the chunks of a body. the handler thread asks for the
+/// chunks in order and parses a chunk itself if no helper has claimed it
+/// yet, so it never waits for a helper that has not started
+class LineParser : public std::enable_shared_from_this<LineParser> {
+ public:
+  LineParser(char* begin, char* end, bool countLastEmpty)
+      : _next(0), _running(0), _countLastEmpty(countLastEmpty) {
+    while (begin < end) {
+      char* chunkEnd = end;
+      if (static_cast<size_t>(end - begin) > ParseChunkSize) {
+        char* p = static_cast<char*>(
+            memchr(begin + ParseChunkSize, '\n', end - begin - ParseChunkSize));
+        if (p != nullptr) {
+          chunkEnd = p + 1;
+        }
+      }
+      _chunks.emplace_back(std::make_unique<ParsedChunk>(begin, chunkEnd));
+      begin = chunkEnd;
+    }
+  }
+
+  size_t size() const { return _chunks.size(); }
+
+  /// @brief queues up to jobs helpers
+  void start(size_t jobs) {
+    auto* scheduler = SchedulerFeature::SCHEDULER;
+    if (scheduler == nullptr || _chunks.size() < 2) {
+      return;
+    }
+    jobs = std::min(jobs, _chunks.size() - 1);
+    for (size_t i = 0; i < jobs; ++i) {
+      auto self = shared_from_this();
+      if (!scheduler->queue(RequestLane::CLIENT_SLOW, [self]() { self->work(); })) {
+        // the handler thread parses what is left
+        break;
+      }
+    }
+  }
+
+  /// @brief the parsed chunk. must be called for every chunk in order
+  ParsedChunk& get(size_t index) {
+    TRI_ASSERT(index < _chunks.size());
+    ParsedChunk& chunk = *_chunks[index];
+    size_t expected = index;
+    if (_next.compare_exchange_strong(expected, index + 1)) {
+      parse(chunk);
+    } else {
+      CONDITION_LOCKER(guard, _condition);
+      while (!chunk.done) {
+        guard.wait();
+      }
+    }
+    if (chunk.errorCode != TRI_ERROR_NO_ERROR) {
+      THROW_ARANGO_EXCEPTION(chunk.errorCode);
+    }
+    return chunk;
+  }
+
+  /// @brief frees the memory of a chunk that has been imported
+  void release(size_t index) {
+    ParsedChunk& chunk = *_chunks[index];
+    chunk.values = VPackBuilder();
+    std::vector<std::pair<size_t, char const*>>().swap(chunk.lines);
+  }
+
+  /// @brief lets the helpers stop, and waits for the chunks they are
+  /// parsing. must be called before the body goes away
+  void stop() {
+    _next.store(_chunks.size());
+    CONDITION_LOCKER(guard, _condition);
+    while (_running > 0) {
+      guard.wait();
+    }
+  }
+
+ private:
+  void work() {
+    {
+      CONDITION_LOCKER(guard, _condition);
+      ++_running;
+    }
+    while (true) {
+      size_t index = _next.fetch_add(1);
+      if (index >= _chunks.size()) {
+        break;
+      }
+      parse(*_chunks[index]);
+    }
+    CONDITION_LOCKER(guard, _condition);
+    --_running;
+    guard.broadcast();
+  }
+
+  void parse(ParsedChunk& chunk) {
+    try {
+      VPackBuilder line;
+      char* p = chunk.begin;
+      chunk.values.openArray();
+      while (p < chunk.end) {
+        ++chunk.numLines;
+        char* next = static_cast<char*>(memchr(p, '\n', chunk.end - p));
+        char const* lineStart = p;
+        char const* lineEnd = (next == nullptr) ? chunk.end : next;
+        if (next != nullptr) {
+          // the line is used as error context
+          *next = '\0';
+        }
+        p = (next == nullptr) ? chunk.end : next + 1;
+
+        while (lineStart < lineEnd && isLineWhitespace(*lineStart)) {
+          ++lineStart;
+        }
+        while (lineEnd > lineStart && isLineWhitespace(*(lineEnd - 1))) {
+          --lineEnd;
+        }
+        if (lineStart == lineEnd) {
+          if (next != nullptr || _countLastEmpty) {
+            ++chunk.numEmpty;
+          }
+          continue;
+        }
+
+        try {
+          VPackParser parser(line);
+          parser.parse(lineStart, lineEnd - lineStart);
+        } catch (std::exception const&) {
+          chunk.lines.emplace_back(chunk.numLines, lineStart);
+          continue;
+        }
+        chunk.values.add(line.slice());
+        chunk.lines.emplace_back(chunk.numLines, nullptr);
+      }
+      chunk.values.close();
+    } catch (std::bad_alloc const&) {
+      chunk.errorCode = TRI_ERROR_OUT_OF_MEMORY;
+    } catch (...) {
+      chunk.errorCode = TRI_ERROR_INTERNAL;
+    }
+
+    CONDITION_LOCKER(guard, _condition);
+    chunk.done = true;
+    guard.broadcast();
+  }
+
+ private:
+  std::vector<std::unique_ptr<ParsedChunk>> _chunks;
+  /// @brief the next chunk to be claimed
+  std::atomic<size_t> _next;
+  basics::ConditionVariable _condition;
+  size_t _running;
+  bool const _countLastEmpty;
+};
+}  // namespace
+
 RestImportHandler::RestImportHandler(GeneralRequest* request, GeneralResponse* response)
     : RestVocbaseBaseHandler(request, response),
       _onDuplicateAction(DUPLICATE_ERROR),
@@ -95,11 +289,14 @@ RestStatus RestImportHandler::execute() {
       switch (_response->transportType()) {
         case Endpoint::TransportType::HTTP: {
           if (_request->contentType() == arangodb::ContentType::VPACK) {
-            createFromVPack(documentType);
+            if (readBodyStream(std::string())) {
+              createFromVPack(documentType);
+            }
           } else if (found && (documentType == "documents" || documentType == "array" ||
                                documentType == "list" || documentType == "auto")) {
+            // consumes a streamed body itself
             createFromJson(documentType);
-          } else {
+          } else if (readBodyStream(std::string())) {
             // CSV
             createFromKeyValueList();
           }
@@ -299,6 +496,10 @@ bool RestImportHandler::createFromJson(std::string const& type) {
     return false;
   }
 
+  // the body is still arriving if the request was dispatched early
+  std::shared_ptr<RequestBodyStream> const stream = _request->bodyStream();
+  std::string received;
+
   bool linewise;
 
   if (type == "documents") {
@@ -324,7 +525,14 @@ bool RestImportHandler::createFromJson(std::string const& type) {
                                      "invalid request type");
     }
 
-    std::string const& body = req->body();
+    if (stream != nullptr) {
+      // wait for the first non-whitespace character
+      while (received.find_first_not_of(" \t\r\n\b\f") == std::string::npos &&
+             stream->read(received)) {
+      }
+    }
+
+    std::string const& body = stream == nullptr ? req->body() : received;
 
     char const* ptr = body.c_str();
     char const* end = ptr + body.size();
@@ -348,7 +556,8 @@ bool RestImportHandler::createFromJson(std::string const& type) {
 
   // find and load collection given by name or identifier
   auto ctx = transaction::StandaloneContext::Create(_vocbase);
-  SingleCollectionTransaction trx(ctx, collectionName, AccessMode::Type::WRITE);
+  SingleCollectionTransaction trx(ctx, collectionName, importAccessMode());
+  addPriorityHint(trx);
   trx.addHint(transaction::Hints::Hint::INTERMEDIATE_COMMITS);
 
   // .............................................................................
@@ -374,6 +583,8 @@ bool RestImportHandler::createFromJson(std::string const& type) {
 
   VPackBuilder babies;
   babies.openArray();
+  // the line of each document in babies
+  std::vector<size_t> lines;
 
   VPackBuilder tmpBuilder;
 
@@ -387,82 +598,152 @@ bool RestImportHandler::createFromJson(std::string const& type) {
     }
 
     // each line is a separate JSON document
-    std::string const& body = req->body();
-    char const* ptr = body.c_str();
-    char const* end = ptr + body.size();
     size_t i = 0;
-
     VPackBuilder lineBuilder;
-    while (ptr < end) {
-      // read line until done
-      i++;
 
-      TRI_ASSERT(ptr != nullptr);
+    // imports the lines in the range, returns false if the import is to
+    // be aborted
+    auto importLines = [&](char const* ptr, char const* end) -> bool {
+      while (ptr < end) {
+        // read line until done
+        i++;
 
-      // trim whitespace at start of line
-      while (ptr < end && (*ptr == ' ' || *ptr == '\t' || *ptr == '\r' ||
-                           *ptr == '\b' || *ptr == '\f')) {
-        ++ptr;
-      }
+        TRI_ASSERT(ptr != nullptr);
 
-      if (ptr == end || *ptr == '\0') {
-        break;
-      }
+        // trim whitespace at start of line
+        while (ptr < end && (*ptr == ' ' || *ptr == '\t' || *ptr == '\r' ||
+                             *ptr == '\b' || *ptr == '\f')) {
+          ++ptr;
+        }
 
-      // now find end of line
-      char const* pos = static_cast<char const*>(memchr(ptr, '\n', end - ptr));
-      char const* oldPtr = nullptr;
-      bool success = false;
+        if (ptr == end || *ptr == '\0') {
+          return true;
+        }
 
-      if (pos == ptr) {
-        // line starting with \n, i.e. empty line
-        ptr = pos + 1;
-        ++result._numEmpty;
-        continue;
-      }
+        // now find end of line
+        char const* pos = static_cast<char const*>(memchr(ptr, '\n', end - ptr));
+        char const* oldPtr = nullptr;
+        bool success = false;
+
+        if (pos == ptr) {
+          // line starting with \n, i.e. empty line
+          ptr = pos + 1;
+          ++result._numEmpty;
+          continue;
+        }
+
+        TRI_ASSERT(ptr != nullptr);
+        oldPtr = ptr;
 
-      TRI_ASSERT(ptr != nullptr);
-      oldPtr = ptr;
+        tmpBuilder.clear();
+        if (pos != nullptr) {
+          // non-empty line
+          *(const_cast<char*>(pos)) = '\0';
+          parseVelocyPackLine(tmpBuilder, ptr, pos, success);
+          ptr = pos + 1;
+        } else {
+          // last-line, non-empty
+          parseVelocyPackLine(tmpBuilder, ptr, end, success);
+          ptr = end;
+        }
+
+        if (!success) {
+          std::string errorMsg = buildParseError(i, oldPtr);
+          registerError(result, errorMsg);
+          if (complete) {
+            // only perform a full import: abort
+            res.reset(TRI_ERROR_HTTP_CORRUPTED_JSON);
+            return false;
+          }
+          // Do not try to store illegal document
+          continue;
+        }
 
-      tmpBuilder.clear();
-      if (pos != nullptr) {
-        // non-empty line
-        *(const_cast<char*>(pos)) = '\0';
-        parseVelocyPackLine(tmpBuilder, ptr, pos, success);
-        ptr = pos + 1;
+        res = handleSingleDocument(trx, lineBuilder, result, babies,
+                                   tmpBuilder.slice(), isEdgeCollection, i);
+
+        if (res.fail()) {
+          if (complete) {
+            // only perform a full import: abort
+            return false;
+          }
+
+          res.reset();
+        } else {
+          lines.push_back(i);
+        }
+      }
+      return true;
+    };
+
+    if (stream == nullptr) {
+      std::string const& body = req->body();
+      char* begin = const_cast<char*>(body.c_str());
+
+      if (body.size() >= 2 * ::ParseChunkSize) {
+        res = importLinesParallel(
+            trx, result, collectionName, begin, begin + body.size(), 0, false,
+            complete, opOptions,
+            [&](size_t line, VPackSlice value, char const* lineStart,
+                VPackBuilder& documents) -> int {
+              if (value.isNone()) {
+                registerError(result, buildParseError(line, lineStart));
+                return TRI_ERROR_HTTP_CORRUPTED_JSON;
+              }
+              return handleSingleDocument(trx, lineBuilder, result, documents,
+                                          value, isEdgeCollection, line);
+            });
       } else {
-        // last-line, non-empty
-        parseVelocyPackLine(tmpBuilder, ptr, end, success);
-        ptr = end;
+        importLines(begin, begin + body.size());
       }
+    } else {
+      // import all complete lines whenever data arrives, and insert the
+      // documents in batches, so neither the body nor the documents are
+      // held as a whole
+      bool more = true;
+
+      while (more) {
+        more = stream->read(received);
+
+        size_t length = received.size();
+        if (more) {
+          size_t const lineEnd = received.rfind('\n');
+          length = (lineEnd == std::string::npos) ? 0 : lineEnd + 1;
+        }
 
-      if (!success) {
-        std::string errorMsg = buildParseError(i, oldPtr);
-        registerError(result, errorMsg);
-        if (complete) {
-          // only perform a full import: abort
-          break;
+        if (length > 0) {
+          if (!importLines(received.c_str(), received.c_str() + length)) {
+            break;
+          }
+          received.erase(0, length);
         }
-        // Do not try to store illegal document
-        continue;
-      }
 
-      res = handleSingleDocument(trx, lineBuilder, result, babies,
-                                 tmpBuilder.slice(), isEdgeCollection, i);
+        if (more && babies.buffer()->size() >= ::StreamBatchSize) {
+          babies.close();
+          res = performImport(trx, result, collectionName, babies, complete,
+                              opOptions, &lines);
+          babies.clear();
+          babies.openArray();
+          lines.clear();
 
-      if (res.fail()) {
-        if (complete) {
-          // only perform a full import: abort
-          break;
+          if (res.fail()) {
+            break;
+          }
         }
+      }
 
-        res.reset();
+      if (res.ok() && stream->aborted()) {
+        // the client went away, do not commit what is left of the import
+        res.reset(TRI_ERROR_REQUEST_CANCELED);
       }
     }
   }
 
   else {
     // the entire request body is one JSON document
+    if (!readBodyStream(std::move(received))) {
+      return false;
+    }
 
     VPackSlice documents;
     try {
@@ -508,7 +789,8 @@ bool RestImportHandler::createFromJson(std::string const& type) {
 
   if (res.ok()) {
     // no error so far. go on and perform the actual insert
-    res = performImport(trx, result, collectionName, babies, complete, opOptions);
+    res = performImport(trx, result, collectionName, babies, complete,
+                        opOptions, linewise ? &lines : nullptr);
   }
 
   res = trx.finish(res);
@@ -555,7 +837,8 @@ bool RestImportHandler::createFromVPack(std::string const& type) {
 
   // find and load collection given by name or identifier
   auto ctx = transaction::StandaloneContext::Create(_vocbase);
-  SingleCollectionTransaction trx(ctx, collectionName, AccessMode::Type::WRITE);
+  SingleCollectionTransaction trx(ctx, collectionName, importAccessMode());
+  addPriorityHint(trx);
 
   // .............................................................................
   // inside write transaction
@@ -737,7 +1020,8 @@ bool RestImportHandler::createFromKeyValueList() {
 
   // find and load collection given by name or identifier
   auto ctx = transaction::StandaloneContext::Create(_vocbase);
-  SingleCollectionTransaction trx(ctx, collectionName, AccessMode::Type::WRITE);
+  SingleCollectionTransaction trx(ctx, collectionName, importAccessMode());
+  addPriorityHint(trx);
 
   // .............................................................................
   // inside write transaction
@@ -763,11 +1047,39 @@ bool RestImportHandler::createFromKeyValueList() {
   VPackBuilder parsedValues;
   VPackBuilder babies;
   babies.openArray();
+  // the line of each document in babies
+  std::vector<size_t> lines;
 
   size_t i = static_cast<size_t>(lineNumber);
   VPackBuilder lineBuilder;
   VPackBuilder objectBuilder;
 
+  if (static_cast<size_t>(bodyEnd - current) >= 2 * ::ParseChunkSize) {
+    res = importLinesParallel(
+        trx, result, collectionName, const_cast<char*>(current),
+        const_cast<char*>(bodyEnd), i, true, complete, opOptions,
+        [&](size_t line, VPackSlice values, char const* lineStart,
+            VPackBuilder& documents) -> int {
+          if (values.isNone()) {
+            registerError(result, buildParseError(line, lineStart));
+            return TRI_ERROR_INTERNAL;
+          }
+          std::string errorMsg;
+          try {
+            objectBuilder.clear();
+            createVelocyPackObject(objectBuilder, keys, values, errorMsg, line);
+            return handleSingleDocument(trx, lineBuilder, result, documents,
+                                        objectBuilder.slice(), isEdgeCollection, line);
+          } catch (...) {
+            // raise any error
+            registerError(result, errorMsg);
+            return TRI_ERROR_INTERNAL;
+          }
+        });
+    // everything has been imported
+    current = nullptr;
+  }
+
   while (current != nullptr && current < bodyEnd) {
     i++;
 
@@ -821,6 +1133,9 @@ bool RestImportHandler::createFromKeyValueList() {
         createVelocyPackObject(objectBuilder, keys, values, errorMsg, i);
         res = handleSingleDocument(trx, lineBuilder, result, babies,
                                    objectBuilder.slice(), isEdgeCollection, i);
+        if (res.ok()) {
+          lines.push_back(i);
+        }
       } catch (...) {
         // raise any error
         res = TRI_ERROR_INTERNAL;
@@ -842,7 +1157,8 @@ bool RestImportHandler::createFromKeyValueList() {
 
   if (res.ok()) {
     // no error so far. go on and perform the actual insert
-    res = performImport(trx, result, collectionName, babies, complete, opOptions);
+    res = performImport(trx, result, collectionName, babies, complete,
+                        opOptions, &lines);
   }
 
   res = trx.finish(res);
@@ -863,7 +1179,8 @@ Result RestImportHandler::performImport(SingleCollectionTransaction& trx,
                                         RestImportResult& result,
                                         std::string const& collectionName,
                                         VPackBuilder const& babies, bool complete,
-                                        OperationOptions const& opOptions) {
+                                        OperationOptions const& opOptions,
+                                        std::vector<size_t> const* lines) {
   auto makeError = [&](size_t i, int res, VPackSlice const& slice, RestImportResult& result) {
     VPackOptions options(VPackOptions::Defaults);
     options.escapeUnicode = false;
@@ -874,8 +1191,9 @@ Result RestImportHandler::performImport(SingleCollectionTransaction& trx,
       part = part.substr(0, 255) + "...";
     }
 
+    size_t const position = (lines == nullptr) ? i : (*lines)[i];
     std::string errorMsg =
-        positionize(i) + "creating document failed with error '" +
+        positionize(position) + "creating document failed with error '" +
         TRI_errno_string(res) + "', offending document: " + part;
     registerError(result, errorMsg);
   };
@@ -989,10 +1307,113 @@ Result RestImportHandler::performImport(SingleCollectionTransaction& trx,
   return res;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief import the lines of a body held in memory in parallel
+////////////////////////////////////////////////////////////////////////////////
+
+Result RestImportHandler::importLinesParallel(
+    SingleCollectionTransaction& trx, RestImportResult& result,
+    std::string const& collectionName, char* begin, char* end,
+    size_t firstLine, bool countLastEmpty, bool complete,
+    OperationOptions const& opOptions,
+    std::function<int(size_t, VPackSlice, char const*, VPackBuilder&)> const& handleLine) {
+  auto parser = std::make_shared<LineParser>(begin, end, countLastEmpty);
+  // the helpers must be done with the body before it goes away
+  TRI_DEFER(parser->stop());
+  parser->start(::ParseJobs);
+
+  Result res;
+  VPackBuilder babies;
+  babies.openArray();
+  // the line of each document in babies
+  std::vector<size_t> lines;
+  size_t line = firstLine;
+
+  for (size_t index = 0; index < parser->size(); ++index) {
+    ParsedChunk& chunk = parser->get(index);
+    result._numEmpty += chunk.numEmpty;
+
+    VPackArrayIterator values(chunk.values.slice());
+    for (auto const& it : chunk.lines) {
+      size_t const current = line + it.first;
+      VPackSlice value;
+      if (it.second == nullptr) {
+        value = values.value();
+        values.next();
+      }
+
+      res = handleLine(current, value, it.second, babies);
+
+      if (res.fail()) {
+        if (complete) {
+          // only perform a full import: abort
+          break;
+        }
+        res.reset();
+      } else {
+        // the document has been added
+        lines.push_back(current);
+      }
+    }
+    line += chunk.numLines;
+    parser->release(index);
+
+    if (res.fail()) {
+      break;
+    }
+
+    // insert the documents of the chunks parsed so far while the helpers
+    // parse the next ones
+    if (babies.buffer()->size() >= ::StreamBatchSize || index + 1 == parser->size()) {
+      babies.close();
+      res = performImport(trx, result, collectionName, babies, complete, opOptions, &lines);
+      babies.clear();
+      babies.openArray();
+      lines.clear();
+
+      if (res.fail()) {
+        break;
+      }
+    }
+  }
+
+  return res;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief create response for number of documents created / failed
 ////////////////////////////////////////////////////////////////////////////////
 
+bool RestImportHandler::readBodyStream(std::string&& received) {
+  std::shared_ptr<RequestBodyStream> const stream = _request->bodyStream();
+
+  if (stream == nullptr) {
+    return true;
+  }
+
+  // http required here
+  HttpRequest* req = dynamic_cast<HttpRequest*>(_request.get());
+
+  if (req == nullptr) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "invalid request type");
+  }
+
+  std::string body = std::move(received);
+  body.reserve(stream->length());
+  while (stream->read(body)) {
+  }
+
+  if (stream->aborted()) {
+    generateError(rest::ResponseCode::BAD, TRI_ERROR_REQUEST_CANCELED,
+                  "connection closed while receiving the request body");
+    return false;
+  }
+
+  req->setBody(std::move(body));
+  _request->setBodyStream(nullptr);
+  return true;
+}
+
 void RestImportHandler::generateDocumentsCreated(RestImportResult const& result) {
   resetResponse(rest::ResponseCode::CREATED);
 
@@ -1090,6 +1511,28 @@ void RestImportHandler::createVelocyPackObject(VPackBuilder& result, VPackSlice
   result.close();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief add the transaction hints requested by the client
+////////////////////////////////////////////////////////////////////////////////
+
+void RestImportHandler::addPriorityHint(SingleCollectionTransaction& trx) const {
+  bool found;
+  std::string const& value = _request->header(StaticStrings::XArangoLowPriority, found);
+
+  if (found && StringUtils::boolean(value)) {
+    trx.addHint(transaction::Hints::Hint::LOW_PRIORITY);
+  }
+  if (isBulkLoad()) {
+    trx.addHint(transaction::Hints::Hint::BULK_LOAD);
+  }
+}
+
+bool RestImportHandler::isBulkLoad() const {
+  // without the server option, the import is a regular one
+  return _request->parsedValue("bulkLoad", false) &&
+         EngineSelectorFeature::ENGINE->allowsBulkLoad();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief validate keys
 ////////////////////////////////////////////////////////////////////////////////
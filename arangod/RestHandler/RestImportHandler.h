@@ -27,6 +27,7 @@
 #include "Basics/Common.h"
 #include "Basics/Result.h"
 #include "RestHandler/RestVocbaseBaseHandler.h"
+#include "VocBase/AccessMode.h"
 
 #include <velocypack/Builder.h>
 #include <velocypack/Slice.h>
@@ -116,12 +117,37 @@ class RestImportHandler : public RestVocbaseBaseHandler {
   bool createFromKeyValueListVPack() { return false; }
 
   //////////////////////////////////////////////////////////////////////////////
-  /// @brief perform the actual import (insert/update/replace) operations
+  /// @brief perform the actual import (insert/update/replace) operations.
+  /// lines holds the line number of each document for error messages
   //////////////////////////////////////////////////////////////////////////////
 
   Result performImport(SingleCollectionTransaction& trx, RestImportResult& result,
                        std::string const& collectionName, VPackBuilder const& babies,
-                       bool complete, OperationOptions const& opOptions);
+                       bool complete, OperationOptions const& opOptions,
+                       std::vector<size_t> const* lines = nullptr);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief imports the lines of a body that is held in memory. the lines
+  /// are parsed in chunks by scheduler threads, while the documents of the
+  /// chunks parsed before are inserted. handleLine is called in line order
+  /// with a slice of None and the start of the line for lines that cannot be
+  /// parsed, and adds the document to the babies
+  //////////////////////////////////////////////////////////////////////////////
+
+  Result importLinesParallel(
+      SingleCollectionTransaction& trx, RestImportResult& result,
+      std::string const& collectionName, char* begin, char* end,
+      size_t firstLine, bool countLastEmpty, bool complete,
+      OperationOptions const& opOptions,
+      std::function<int(size_t, arangodb::velocypack::Slice, char const*, VPackBuilder&)> const& handleLine);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief reads the rest of a streamed body into the request, for the
+  /// import types that need the complete body. received is the part of the
+  /// body already consumed. returns false if the connection went away
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool readBodyStream(std::string&& received);
 
   //////////////////////////////////////////////////////////////////////////////
   /// @brief creates the result
@@ -149,6 +175,29 @@ class RestImportHandler : public RestVocbaseBaseHandler {
 
   bool checkKeys(arangodb::velocypack::Slice const&) const;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief marks the transaction as low-priority if the client asked for it
+  /// via the x-arango-low-priority header
+  //////////////////////////////////////////////////////////////////////////////
+
+  void addPriorityHint(SingleCollectionTransaction&) const;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief whether the client asked for a bulk load via the bulkLoad URL
+  /// parameter. bulk loads lock the collection exclusively and are committed
+  /// by ingesting SST files
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool isBulkLoad() const;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief access mode for the import transaction
+  //////////////////////////////////////////////////////////////////////////////
+
+  AccessMode::Type importAccessMode() const {
+    return isBulkLoad() ? AccessMode::Type::EXCLUSIVE : AccessMode::Type::WRITE;
+  }
+
  private:
   //////////////////////////////////////////////////////////////////////////////
   /// @brief enumeration for unique constraint handling
@@ -168,11 +168,12 @@ RestStatus RestIndexHandler::getIndexes() {
 
 RestStatus RestIndexHandler::getSelectivityEstimates() {
   // .............................................................................
-  // /_api/index/selectivity?collection=<collection-name>
+  // /_api/index/selectivity?collection=<collection-name>&sketches=<bool>
   // .............................................................................
   
   bool found = false;
   std::string cName = _request->value("collection", found);
+  bool const withSketches = _request->parsedValue("sketches", false);
   if (cName.empty()) {
     generateError(rest::ResponseCode::NOT_FOUND, TRI_ERROR_ARANGO_DATA_SOURCE_NOT_FOUND);
     return RestStatus::DONE;
@@ -205,6 +206,21 @@ RestStatus RestIndexHandler::getSelectivityEstimates() {
     }
   }
   builder.close();
+  if (withSketches) {
+    // mergeable sketches for the coordinator, per index
+    builder.add("sketches", VPackValue(VPackValueType::Object));
+    VPackBuilder sketch;
+    for (std::shared_ptr<Index> idx : idxs) {
+      sketch.clear();
+      if (!idx->unique() && idx->selectivitySketch(sketch)) {
+        std::string name = coll->name();
+        name.push_back(TRI_INDEX_HANDLE_SEPARATOR_CHR);
+        name.append(std::to_string(idx->id()));
+        builder.add(name, sketch.slice());
+      }
+    }
+    builder.close();
+  }
   builder.close();
   
   generateResult(rest::ResponseCode::OK, std::move(buffer));
@@ -32,6 +32,7 @@
 #include "GeneralServer/AsyncJobManager.h"
 #include "Rest/HttpRequest.h"
 #include "Rest/HttpResponse.h"
+#include "Utils/ExecContext.h"
 #include "VocBase/ticks.h"
 
 using namespace arangodb;
@@ -179,6 +180,18 @@ void RestJobHandler::getJobByType(std::string const& type) {
     count = (size_t)StringUtils::uint64(value);
   }
 
+  if (type == "statistics") {
+    ExecContext const* exec = ExecContext::CURRENT;
+    if (exec != nullptr && !exec->isAdminUser()) {
+      generateError(rest::ResponseCode::FORBIDDEN, TRI_ERROR_FORBIDDEN);
+      return;
+    }
+    VPackBuilder result;
+    _jobManager->statistics(result);
+    generateResult(rest::ResponseCode::OK, result.slice());
+    return;
+  }
+
   std::vector<AsyncJobResult::IdType> ids;
   if (type == "done") {
     ids = _jobManager->done(count);
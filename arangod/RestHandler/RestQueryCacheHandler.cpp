@@ -24,6 +24,11 @@
 #include "RestQueryCacheHandler.h"
 #include "Aql/QueryCache.h"
 #include "Rest/HttpRequest.h"
+#include "VocBase/LogicalCollection.h"
+#include "VocBase/vocbase.h"
+
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
 
 using namespace arangodb;
 using namespace arangodb::aql;
@@ -105,6 +110,11 @@ void RestQueryCacheHandler::readProperties() {
 void RestQueryCacheHandler::replaceProperties() {
   auto const& suffixes = _request->suffixes();
 
+  if (suffixes.size() == 1 && suffixes[0] == "ticks") {
+    readTicks();
+    return;
+  }
+
   if (suffixes.size() != 1 || suffixes[0] != "properties") {
     generateError(rest::ResponseCode::BAD, TRI_ERROR_HTTP_BAD_PARAMETER,
                   "expecting PUT /_api/query-cache/properties");
@@ -127,3 +137,36 @@ void RestQueryCacheHandler::replaceProperties() {
   arangodb::aql::QueryCache::instance()->properties(body);
   readProperties();
 }
+
+void RestQueryCacheHandler::readTicks() {
+  bool validBody = false;
+  VPackSlice body = this->parseVPackBody(validBody);
+  if (!validBody) {
+    // error message generated in parseJsonBody
+    return;
+  }
+
+  if (!body.isArray()) {
+    generateError(rest::ResponseCode::BAD, TRI_ERROR_HTTP_BAD_PARAMETER,
+                  "expecting a JSON-Array body");
+    return;
+  }
+
+  VPackBuilder result;
+  result.openObject();
+  result.add("ticks", VPackValue(VPackValueType::Object));
+  for (auto const& name : VPackArrayIterator(body)) {
+    if (!name.isString()) {
+      continue;
+    }
+    // unknown collections are left out, so the caller treats them as changed
+    auto collection = _vocbase.lookupCollection(name.copyString());
+    if (collection != nullptr) {
+      result.add(name.copyString(),
+                 VPackValue(std::to_string(collection->invalidationTick())));
+    }
+  }
+  result.close();
+  result.close();
+  generateResult(rest::ResponseCode::OK, result.slice());
+}
@@ -59,6 +59,13 @@ class RestQueryCacheHandler : public RestVocbaseBaseHandler {
 
   void replaceProperties();
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief returns the invalidation ticks of the collections (shards) in
+  /// the request body. used by coordinators to validate cached results
+  //////////////////////////////////////////////////////////////////////////////
+
+  void readTicks();
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief clears the cache
   //////////////////////////////////////////////////////////////////////////////
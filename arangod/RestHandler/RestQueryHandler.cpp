@@ -114,6 +114,12 @@ bool RestQueryHandler::readQuery(bool slow) {
     result.add("runTime", VPackValue(q.runTime));
     result.add("state", VPackValue(QueryExecutionState::toString(q.state)));
     result.add("stream", VPackValue(q.stream));
+    if (q.metrics != nullptr) {
+      result.add("nodes", q.metrics->slice());
+    }
+    if (!slow) {
+      result.add("memoryUsage", VPackValue(q.memoryUsage));
+    }
     result.close();
   }
   result.close();
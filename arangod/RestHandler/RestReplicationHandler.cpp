@@ -62,6 +62,7 @@
 #include <velocypack/Iterator.h>
 #include <velocypack/Parser.h>
 #include <velocypack/Slice.h>
+#include <velocypack/Validator.h>
 #include <velocypack/velocypack-aliases.h>
 
 using namespace arangodb;
@@ -106,26 +107,9 @@ static bool ignoreHiddenEnterpriseCollection(std::string const& name, bool force
   return false;
 }
 
-static Result restoreDataParser(char const* ptr, char const* pos,
-                                std::string const& collectionName, int line,
-                                std::string& key, VPackBuilder& builder,
-                                VPackSlice& doc, TRI_replication_operation_e& type) {
-  builder.clear();
-
-  try {
-    VPackParser parser(builder, builder.options);
-    parser.parse(ptr, static_cast<size_t>(pos - ptr));
-  } catch (std::exception const& ex) {
-    // Could not even build the string
-    return Result{TRI_ERROR_HTTP_CORRUPTED_JSON,
-                  "received invalid JSON data for collection '" + collectionName +
-                      "' on line " + std::to_string(line) + ": " + ex.what()};
-  } catch (...) {
-    return Result{TRI_ERROR_INTERNAL};
-  }
-
-  VPackSlice const slice = builder.slice();
-
+static Result restoreDataMarker(VPackSlice const& slice, std::string const& collectionName,
+                                int line, std::string& key, VPackSlice& doc,
+                                TRI_replication_operation_e& type) {
   if (!slice.isObject()) {
     return Result{TRI_ERROR_HTTP_CORRUPTED_JSON,
                   "received invalid JSON data for collection '" +
@@ -185,6 +169,27 @@ static Result restoreDataParser(char const* ptr, char const* pos,
   return Result{TRI_ERROR_NO_ERROR};
 }
 
+static Result restoreDataParser(char const* ptr, char const* pos,
+                                std::string const& collectionName, int line,
+                                std::string& key, VPackBuilder& builder,
+                                VPackSlice& doc, TRI_replication_operation_e& type) {
+  builder.clear();
+
+  try {
+    VPackParser parser(builder, builder.options);
+    parser.parse(ptr, static_cast<size_t>(pos - ptr));
+  } catch (std::exception const& ex) {
+    // Could not even build the string
+    return Result{TRI_ERROR_HTTP_CORRUPTED_JSON,
+                  "received invalid JSON data for collection '" + collectionName +
+                      "' on line " + std::to_string(line) + ": " + ex.what()};
+  } catch (...) {
+    return Result{TRI_ERROR_INTERNAL};
+  }
+
+  return restoreDataMarker(builder.slice(), collectionName, line, key, doc, type);
+}
+
 RestReplicationHandler::RestReplicationHandler(GeneralRequest* request, GeneralResponse* response)
     : RestVocbaseBaseHandler(request, response) {}
 
@@ -1235,10 +1240,20 @@ Result RestReplicationHandler::processRestoreData(std::string const& colName) {
     return processRestoreUsersBatch(colName);
   }
 
+  // a bulk load locks the collection exclusively and is committed by
+  // ingesting SST files, bypassing the WAL. servers must opt in
+  bool const bulkLoad = _request->parsedValue("bulkLoad", false) &&
+                        EngineSelectorFeature::ENGINE->allowsBulkLoad();
+
   auto ctx = transaction::StandaloneContext::Create(_vocbase);
-  SingleCollectionTransaction trx(ctx, colName, AccessMode::Type::WRITE);
+  SingleCollectionTransaction trx(ctx, colName,
+                                  bulkLoad ? AccessMode::Type::EXCLUSIVE
+                                           : AccessMode::Type::WRITE);
 
   trx.addHint(transaction::Hints::Hint::RECOVERY);  // to turn off waitForSync!
+  if (bulkLoad) {
+    trx.addHint(transaction::Hints::Hint::BULK_LOAD);
+  }
 
   Result res = trx.begin();
 
@@ -1276,6 +1291,57 @@ Result RestReplicationHandler::parseBatch(std::string const& collectionName,
 
   VPackValueLength currentPos = 0;
 
+  if (_request->contentType() == rest::ContentType::VPACK) {
+    // a sequence of markers as the VelocyPack dump API hands them out.
+    // they are taken as they are, apart from the server-specific custom
+    // type of _id, which the insert generates anew anyway
+    VPackValidator validator(&options);
+    int line = 0;
+    VPackArrayBuilder guard(&allMarkers);
+    std::string key;
+    while (ptr < end) {
+      ++line;
+      try {
+        validator.validate(ptr, static_cast<size_t>(end - ptr), /*isSubPart*/ true);
+      } catch (std::exception const& ex) {
+        return Result{TRI_ERROR_HTTP_CORRUPTED_JSON,
+                      "received invalid VelocyPack data for collection '" +
+                          collectionName + "' in marker " + std::to_string(line) +
+                          ": " + ex.what()};
+      }
+      VPackSlice const marker(reinterpret_cast<uint8_t const*>(ptr));
+
+      key.clear();
+      VPackSlice doc;
+      TRI_replication_operation_e type = REPLICATION_INVALID;
+      Result res = restoreDataMarker(marker, collectionName, line, key, doc, type);
+      if (res.fail()) {
+        return res;
+      }
+
+      allMarkers.openObject();
+      for (auto const& pair : VPackObjectIterator(marker, true)) {
+        if (pair.value.start() != doc.start()) {
+          allMarkers.add(pair.key.stringRef(), pair.value);
+          continue;
+        }
+        allMarkers.add(pair.key.stringRef(), VPackValue(VPackValueType::Object));
+        for (auto const& attribute : VPackObjectIterator(doc, true)) {
+          if (!attribute.value.isCustom()) {
+            allMarkers.add(attribute.key.stringRef(), attribute.value);
+          }
+        }
+        allMarkers.close();
+      }
+      allMarkers.close();
+
+      latest[key] = currentPos;
+      ++currentPos;
+      ptr += marker.byteSize();
+    }
+    return Result{TRI_ERROR_NO_ERROR};
+  }
+
   // First parse and collect all markers, we assemble everything in one
   // large builder holding an array. We keep for each key the latest
   // entry.
@@ -25,7 +25,9 @@
 
 #include "Actions/ActionFeature.h"
 #include "ApplicationFeatures/ApplicationServer.h"
+#include "Basics/Exceptions.h"
 #include "Basics/ReadLocker.h"
+#include "Basics/VelocyPackHelper.h"
 #include "Basics/WriteLocker.h"
 #include "Cluster/ClusterInfo.h"
 #include "Cluster/ServerState.h"
@@ -33,7 +35,10 @@
 #include "Transaction/Manager.h"
 #include "Transaction/ManagerFeature.h"
 #include "Transaction/Helpers.h"
+#include "Transaction/Methods.h"
 #include "Transaction/Status.h"
+#include "Utils/OperationOptions.h"
+#include "Utils/OperationResult.h"
 #include "V8/JavaScriptSecurityContext.h"
 #include "V8Server/V8Context.h"
 #include "V8Server/V8DealerFeature.h"
@@ -47,6 +52,34 @@ using namespace arangodb;
 using namespace arangodb::basics;
 using namespace arangodb::rest;
 
+namespace {
+/// @brief the options of one operation of a pipelined request, named
+/// like the URL parameters of the document API
+OperationOptions buildOperationOptions(VPackSlice options) {
+  OperationOptions opOptions;
+  if (!options.isObject()) {
+    return opOptions;
+  }
+  opOptions.waitForSync =
+      VelocyPackHelper::getBooleanValue(options, StaticStrings::WaitForSyncString, false);
+  opOptions.returnNew =
+      VelocyPackHelper::getBooleanValue(options, StaticStrings::ReturnNewString, false);
+  opOptions.returnOld =
+      VelocyPackHelper::getBooleanValue(options, StaticStrings::ReturnOldString, false);
+  opOptions.silent =
+      VelocyPackHelper::getBooleanValue(options, StaticStrings::SilentString, false);
+  opOptions.overwrite =
+      VelocyPackHelper::getBooleanValue(options, StaticStrings::OverWrite, false);
+  opOptions.ignoreRevs =
+      VelocyPackHelper::getBooleanValue(options, StaticStrings::IgnoreRevsString, true);
+  opOptions.keepNull =
+      VelocyPackHelper::getBooleanValue(options, StaticStrings::KeepNullString, true);
+  opOptions.mergeObjects =
+      VelocyPackHelper::getBooleanValue(options, StaticStrings::MergeObjectsString, true);
+  return opOptions;
+}
+}  // namespace
+
 RestTransactionHandler::RestTransactionHandler(GeneralRequest* request, GeneralResponse* response)
     : RestVocbaseBaseHandler(request, response), _v8Context(nullptr), _lock() {}
 
@@ -58,6 +91,9 @@ RestStatus RestTransactionHandler::execute() {
       if (_request->suffixes().size() == 1 &&
           _request->suffixes()[0] == "begin") {
         executeBegin();
+      } else if (_request->suffixes().size() == 2 &&
+                 _request->suffixes()[1] == "operations") {
+        executeOperations();
       } else if (_request->suffixes().empty()) {
         executeJSTransaction();
       } else {
@@ -177,7 +213,10 @@ void RestTransactionHandler::executeCommit() {
   transaction::Manager* mgr = transaction::ManagerFeature::manager();
   TRI_ASSERT(mgr != nullptr);
   
-  Result res = mgr->commitManagedTrx(tid);
+  // with waitForSync the commit only returns once it is durable
+  bool const waitForSync =
+      _request->parsedValue(StaticStrings::WaitForSyncString, false);
+  Result res = mgr->commitManagedTrx(tid, waitForSync);
   if (res.fail()) {
     generateError(res);
   } else {
@@ -208,6 +247,120 @@ void RestTransactionHandler::executeAbort() {
   }
 }
 
+/// @brief applies an array of document operations to a managed transaction,
+/// in order and with a single round trip. each operation is an object with
+/// the attributes "type" (insert, update, replace or remove), "collection",
+/// "data" (a document or an array of documents as for the document API) and
+/// optionally "options". the result holds one entry per applied operation.
+/// processing stops at the first failing operation, whose entry carries
+/// the error, the transaction remains running in any case
+void RestTransactionHandler::executeOperations() {
+  TRI_ASSERT(_request->suffixes().size() == 2 &&
+             _request->suffixes()[1] == "operations");
+
+  TRI_voc_tid_t tid = basics::StringUtils::uint64(_request->suffixes()[0]);
+  if (tid == 0) {
+    generateError(rest::ResponseCode::BAD, TRI_ERROR_BAD_PARAMETER,
+                  "bad transaction ID");
+    return;
+  }
+
+  bool parseSuccess = false;
+  VPackSlice body = parseVPackBody(parseSuccess);
+  if (!parseSuccess) {
+    // error message generated in parseVPackBody
+    return;
+  }
+  if (!body.isArray()) {
+    generateError(rest::ResponseCode::BAD, TRI_ERROR_BAD_PARAMETER,
+                  "expecting an array of operations");
+    return;
+  }
+
+  transaction::Manager* mgr = transaction::ManagerFeature::manager();
+  TRI_ASSERT(mgr != nullptr);
+
+  auto ctx = mgr->leaseManagedTrx(tid, AccessMode::Type::WRITE);
+  if (!ctx) {
+    generateError(rest::ResponseCode::NOT_FOUND, TRI_ERROR_TRANSACTION_NOT_FOUND);
+    return;
+  }
+
+  // the collections were declared when the transaction began
+  transaction::Methods trx(ctx, {}, {}, {}, transaction::Options());
+  Result res = trx.begin();
+  if (res.fail()) {
+    generateError(res);
+    return;
+  }
+
+  VPackBuffer<uint8_t> buffer;
+  VPackBuilder builder(buffer);
+  builder.openObject(true);
+  builder.add(StaticStrings::Code, VPackValue(static_cast<int>(rest::ResponseCode::OK)));
+  builder.add(StaticStrings::Error, VPackValue(false));
+  builder.add("result", VPackValue(VPackValueType::Array));
+
+  for (VPackSlice op : VPackArrayIterator(body)) {
+    std::string const type = VelocyPackHelper::getStringValue(op, "type", "");
+    std::string const collection =
+        VelocyPackHelper::getStringValue(op, "collection", "");
+    VPackSlice data = op.isObject() ? op.get("data") : VPackSlice::noneSlice();
+    if (collection.empty() || !(data.isObject() || data.isArray() || data.isString())) {
+      res.reset(TRI_ERROR_BAD_PARAMETER,
+                "expecting an operation with collection and data");
+    } else {
+      OperationOptions const opOptions = ::buildOperationOptions(op.get("options"));
+      OperationResult opRes(TRI_ERROR_BAD_PARAMETER);
+      try {
+        if (type == "insert") {
+          opRes = trx.insert(collection, data, opOptions);
+        } else if (type == "update") {
+          opRes = trx.update(collection, data, opOptions);
+        } else if (type == "replace") {
+          opRes = trx.replace(collection, data, opOptions);
+        } else if (type == "remove") {
+          opRes = trx.remove(collection, data, opOptions);
+        } else {
+          opRes.result.reset(TRI_ERROR_BAD_PARAMETER,
+                             "unknown operation type '" + type + "'");
+        }
+      } catch (basics::Exception const& ex) {
+        opRes.result.reset(ex.code(), ex.what());
+      }
+      res = opRes.result;
+      if (res.ok()) {
+        if (opRes.buffer != nullptr) {
+          builder.add(opRes.slice());
+        } else {
+          builder.add(VPackSlice::emptyObjectSlice());
+        }
+      }
+    }
+
+    if (res.fail()) {
+      builder.openObject();
+      builder.add(StaticStrings::Error, VPackValue(true));
+      builder.add(StaticStrings::ErrorNum, VPackValue(res.errorNumber()));
+      builder.add(StaticStrings::ErrorMessage, VPackValue(res.errorMessage()));
+      builder.close();
+      break;
+    }
+  }
+
+  builder.close();
+  builder.close();
+
+  // the transaction is embedded, this only returns the lease; a failed
+  // operation does not roll back the operations before it
+  res = trx.finish(TRI_ERROR_NO_ERROR);
+  if (res.fail()) {
+    generateError(res);
+    return;
+  }
+  generateResult(rest::ResponseCode::OK, std::move(buffer), trx.transactionContext());
+}
+
 void RestTransactionHandler::generateTransactionResult(rest::ResponseCode code,
                                                        TRI_voc_tid_t tid,
                                                        transaction::Status status) {
@@ -306,12 +459,17 @@ bool RestTransactionHandler::cancel() {
 /// @brief returns the short id of the server which should handle this request
 uint32_t RestTransactionHandler::forwardingTarget() {
   rest::RequestType const type = _request->requestType();
-  if (type != rest::RequestType::GET && type != rest::RequestType::PUT &&
-      type != rest::RequestType::DELETE_REQ) {
+  std::vector<std::string> const& suffixes = _request->suffixes();
+  if (type == rest::RequestType::POST) {
+    // only the operations of an existing transaction must be forwarded
+    if (suffixes.size() != 2 || suffixes[1] != "operations") {
+      return 0;
+    }
+  } else if (type != rest::RequestType::GET && type != rest::RequestType::PUT &&
+             type != rest::RequestType::DELETE_REQ) {
     return 0;
   }
 
-  std::vector<std::string> const& suffixes = _request->suffixes();
   if (suffixes.size() < 1) {
     return 0;
   }
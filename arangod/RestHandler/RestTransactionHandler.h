@@ -54,6 +54,7 @@ class RestTransactionHandler : public arangodb::RestVocbaseBaseHandler {
   void executeBegin();
   void executeCommit();
   void executeAbort();
+  void executeOperations();
   void generateTransactionResult(rest::ResponseCode code, TRI_voc_tid_t tid,
                                  transaction::Status status);
 
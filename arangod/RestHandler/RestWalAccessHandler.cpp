@@ -42,6 +42,8 @@
 #include <velocypack/Iterator.h>
 #include <velocypack/velocypack-aliases.h>
 
+#include <lz4.h>
+
 using namespace arangodb;
 using namespace arangodb::basics;
 using namespace arangodb::rest;
@@ -227,6 +229,31 @@ void RestWalAccessHandler::handleCommandLastTick(WalAccess const* wal) {
   generateResult(rest::ResponseCode::OK, result.slice());
 }
 
+/// @brief LZ4-compresses the body if that is worth it, the follower learns
+/// about it from the compression header
+void RestWalAccessHandler::compressTailBody(basics::StringBuffer& buffer) {
+  size_t const size = buffer.length();
+  if (size < 4096 || size > static_cast<size_t>(LZ4_MAX_INPUT_SIZE)) {
+    return;
+  }
+
+  int const bound = LZ4_compressBound(static_cast<int>(size));
+  // one more byte for the terminating NUL
+  basics::StringBuffer compressed(static_cast<size_t>(bound) + 1, false);
+  int length = LZ4_compress_default(buffer.c_str(), compressed.begin(),
+                                    static_cast<int>(size), bound);
+  // only use the compressed variant if it saves at least 10%
+  if (length <= 0 || static_cast<size_t>(length) >= size - size / 10) {
+    return;
+  }
+  compressed.increaseLength(static_cast<size_t>(length));
+  buffer.swap(&compressed);
+
+  _response->setHeaderNC(StaticStrings::ReplicationHeaderCompression, "lz4");
+  _response->setHeaderNC(StaticStrings::ReplicationHeaderUncompressedSize,
+                         StringUtils::itoa(static_cast<uint64_t>(size)));
+}
+
 void RestWalAccessHandler::handleCommandTail(WalAccess const* wal) {
   bool const useVst = (_request->transportType() == Endpoint::TransportType::VST);
 
@@ -267,6 +294,7 @@ void RestWalAccessHandler::handleCommandTail(WalAccess const* wal) {
   };
 
   size_t length = 0;
+  bool useVPack = false;
 
   if (useVst) {
     result = wal->tail(filter, chunkSize, barrierId, 
@@ -287,22 +315,53 @@ void RestWalAccessHandler::handleCommandTail(WalAccess const* wal) {
                                      "invalid response type");
     }
     basics::StringBuffer& buffer = httpResponse->body();
-    basics::VPackStringBufferAdapter adapter(buffer.stringBuffer());
-    // note: we need the CustomTypeHandler here
-    VPackDumper dumper(&adapter, &opts);
-    result = wal->tail(filter, chunkSize, barrierId, 
-                       [&](TRI_vocbase_t* vocbase, VPackSlice const& marker) {
-                         length++;
 
-                         if (vocbase != nullptr) {  // database drop has no vocbase
-                           prepOpts(*vocbase);
-                         }
+    if (_request->contentTypeResponse() == rest::ContentType::VPACK) {
+      // the markers as a sequence of VelocyPack values, saving the JSON
+      // encoding here and the parsing on the follower
+      VPackBuffer<uint8_t> sanitized;
+      result = wal->tail(filter, chunkSize, barrierId,
+                         [&](TRI_vocbase_t* vocbase, VPackSlice const& marker) {
+                           length++;
+
+                           if (vocbase != nullptr) {  // database drop has no vocbase
+                             prepOpts(*vocbase);
+                           }
+
+                           if (VelocyPackHelper::hasNonClientTypes(marker, true, true)) {
+                             sanitized.clear();
+                             VPackBuilder builder(sanitized, &opts);
+                             VelocyPackHelper::sanitizeNonClientTypes(marker, VPackSlice::noneSlice(),
+                                                                      builder, &opts, true, true, true);
+                             buffer.appendText(reinterpret_cast<char const*>(sanitized.data()),
+                                               sanitized.size());
+                           } else {
+                             buffer.appendText(marker.startAs<char>(), marker.byteSize());
+                           }
+                         });
+      useVPack = true;
+    } else {
+      basics::VPackStringBufferAdapter adapter(buffer.stringBuffer());
+      // note: we need the CustomTypeHandler here
+      VPackDumper dumper(&adapter, &opts);
+      result = wal->tail(filter, chunkSize, barrierId,
+                         [&](TRI_vocbase_t* vocbase, VPackSlice const& marker) {
+                           length++;
+
+                           if (vocbase != nullptr) {  // database drop has no vocbase
+                             prepOpts(*vocbase);
+                           }
+
+                           dumper.dump(marker);
+                           buffer.appendChar('\n');
+                           // LOG_TOPIC("cda47", INFO, Logger::REPLICATION) <<
+                           // marker.toJson(&opts);
+                         });
+    }
 
-                         dumper.dump(marker);
-                         buffer.appendChar('\n');
-                         // LOG_TOPIC("cda47", INFO, Logger::REPLICATION) <<
-                         // marker.toJson(&opts);
-                       });
+    if (result.ok() && _request->header(StaticStrings::ReplicationHeaderCompression) == "lz4") {
+      compressTailBody(buffer);
+    }
   }
 
   if (result.fail()) {
@@ -311,7 +370,7 @@ void RestWalAccessHandler::handleCommandTail(WalAccess const* wal) {
   }
 
   // transfer ownership of the buffer contents
-  _response->setContentType(rest::ContentType::DUMP);
+  _response->setContentType(useVPack ? rest::ContentType::VPACK : rest::ContentType::DUMP);
 
   TRI_ASSERT(result.latestTick() >= result.lastIncludedTick());
   TRI_ASSERT(result.latestTick() >= result.lastScannedTick());
@@ -47,6 +47,7 @@ class RestWalAccessHandler : public arangodb::RestVocbaseBaseHandler {
   void handleCommandTickRange(WalAccess const* wal);
   void handleCommandLastTick(WalAccess const* wal);
   void handleCommandTail(WalAccess const* wal);
+  void compressTailBody(basics::StringBuffer& buffer);
   void handleCommandDetermineOpenTransactions(WalAccess const* wal);
 
   void grantTemporaryRights();
@@ -48,6 +48,7 @@
 #include "RestServer/DatabasePathFeature.h"
 #include "RestServer/QueryRegistryFeature.h"
 #include "RestServer/TraverserEngineRegistryFeature.h"
+#include "Scheduler/SchedulerFeature.h"
 #include "StorageEngine/EngineSelectorFeature.h"
 #include "StorageEngine/StorageEngine.h"
 #include "Utils/CollectionKeysRepository.h"
@@ -57,6 +58,7 @@
 #include "V8Server/V8DealerFeature.h"
 #include "V8Server/v8-query.h"
 #include "V8Server/v8-vocbase.h"
+#include "VocBase/DatabaseQuota.h"
 #include "VocBase/KeyGenerator.h"
 #include "VocBase/LogicalCollection.h"
 #include "VocBase/ticks.h"
@@ -298,6 +300,27 @@ void DatabaseFeature::collectOptions(std::shared_ptr<ProgramOptions> options) {
       new AtomicBooleanParameter(&_throwCollectionNotLoadedError),
       arangodb::options::makeFlags(arangodb::options::Flags::Hidden));
 
+  options->addOption("--database.max-scheduler-share",
+                     "share of the scheduler threads the client requests of "
+                     "a database may occupy at the same time, between 0 and "
+                     "1 (0 = unlimited). does not apply to _system",
+                     new DoubleParameter(&_defaultQuota.schedulerShare));
+
+  options->addOption("--database.max-write-rate",
+                     "bytes per second a database may write (0 = "
+                     "unlimited). does not apply to _system",
+                     new UInt64Parameter(&_defaultQuota.writeRate));
+
+  options->addOption("--database.max-concurrent-queries",
+                     "AQL queries a database may run at the same time (0 = "
+                     "unlimited). does not apply to _system",
+                     new UInt64Parameter(&_defaultQuota.queries));
+
+  options->addOption("--database.quota",
+                     "limit for a single database, overriding the general "
+                     "one, e.g. 'mydb:max-write-rate=1048576'",
+                     new VectorParameter<StringParameter>(&_quotas));
+
   // the following option was removed in 3.2
   // index-creation is now automatically parallelized via the Boost ASIO thread
   // pool
@@ -328,6 +351,53 @@ void DatabaseFeature::validateOptions(std::shared_ptr<ProgramOptions> options) {
     FATAL_ERROR_EXIT();
   }
 
+  if (_defaultQuota.schedulerShare < 0.0 || _defaultQuota.schedulerShare > 1.0) {
+    LOG_TOPIC("4d2b7", FATAL, arangodb::Logger::FIXME)
+        << "invalid value for '--database.max-scheduler-share'. expected a "
+           "value between 0 and 1";
+    FATAL_ERROR_EXIT();
+  }
+
+  for (auto const& quota : _quotas) {
+    auto colon = quota.find(':');
+    auto equals = quota.find('=', colon);
+    if (colon == std::string::npos || colon == 0 || equals == std::string::npos) {
+      LOG_TOPIC("a8f31", FATAL, arangodb::Logger::FIXME)
+          << "invalid value for '--database.quota': '" << quota
+          << "'. expected <database>:<option>=<value>";
+      FATAL_ERROR_EXIT();
+    }
+
+    std::string const database = quota.substr(0, colon);
+    std::string const option = quota.substr(colon + 1, equals - colon - 1);
+    std::string const value = quota.substr(equals + 1);
+
+    auto it = _databaseQuotas.find(database);
+    if (it == _databaseQuotas.end()) {
+      it = _databaseQuotas.emplace(database, _defaultQuota).first;
+    }
+
+    if (option == "max-scheduler-share") {
+      double share = StringUtils::doubleDecimal(value);
+      if (share < 0.0 || share > 1.0) {
+        LOG_TOPIC("8e0c4", FATAL, arangodb::Logger::FIXME)
+            << "invalid value for '--database.quota': '" << quota
+            << "'. expected a scheduler share between 0 and 1";
+        FATAL_ERROR_EXIT();
+      }
+      it->second.schedulerShare = share;
+    } else if (option == "max-write-rate") {
+      it->second.writeRate = StringUtils::uint64(value);
+    } else if (option == "max-concurrent-queries") {
+      it->second.queries = StringUtils::uint64(value);
+    } else {
+      LOG_TOPIC("c15a9", FATAL, arangodb::Logger::FIXME)
+          << "invalid value for '--database.quota': '" << quota
+          << "'. unknown option '" << option << "'";
+      FATAL_ERROR_EXIT();
+    }
+  }
+
   // sanity check
   if (_checkVersion && _upgrade) {
     LOG_TOPIC("a25b0", FATAL, arangodb::Logger::FIXME)
@@ -631,6 +701,8 @@ int DatabaseFeature::createDatabase(TRI_voc_tick_t id, std::string const& name,
     TRI_ASSERT(status == TRI_ERROR_NO_ERROR);
     TRI_ASSERT(vocbase != nullptr);
 
+    applyQuota(*vocbase);
+
     if (vocbase->type() == TRI_VOCBASE_TYPE_NORMAL) {
       try {
         vocbase->addReplicationApplier();
@@ -1262,6 +1334,7 @@ int DatabaseFeature::iterateDatabases(VPackSlice const& databases) {
 
       // try to open this database
       auto* database = engine->openDatabase(it, _upgrade).release();
+      applyQuota(*database);
 
       if (!ServerState::isCoordinator(role) && !ServerState::isAgent(role)) {
         try {
@@ -1384,3 +1457,26 @@ void DatabaseFeature::enableDeadlockDetection() {
     vocbase->_deadlockDetector.enabled(true);
   }
 }
+
+void DatabaseFeature::applyQuota(TRI_vocbase_t& vocbase) const {
+  QuotaOptions options;
+  auto it = _databaseQuotas.find(vocbase.name());
+  if (it != _databaseQuotas.end()) {
+    options = it->second;
+  } else if (!vocbase.isSystem()) {
+    options = _defaultQuota;
+  }
+
+  DatabaseQuota::Limits limits;
+  if (options.schedulerShare > 0.0) {
+    auto* scheduler = static_cast<SchedulerFeature*>(
+        ApplicationServer::lookupFeature("Scheduler"));
+    uint64_t threads = (scheduler != nullptr) ? scheduler->maximalThreads() : 0;
+    limits.schedulerJobs = (std::max)(
+        uint64_t(1), static_cast<uint64_t>(std::ceil(options.schedulerShare * threads)));
+  }
+  limits.writeRate = options.writeRate;
+  limits.queries = options.queries;
+
+  vocbase.quota().setLimits(limits);
+}
@@ -168,12 +168,28 @@ class DatabaseFeature : public application_features::ApplicationFeature {
   /// @brief activates deadlock detection in all existing databases
   void enableDeadlockDetection();
 
+  /// @brief set the resource limits of a database from the options
+  void applyQuota(TRI_vocbase_t& vocbase) const;
+
   uint64_t _maximalJournalSize;
   bool _defaultWaitForSync;
   bool _forceSyncProperties;
   bool _ignoreDatafileErrors;
   std::atomic<bool> _throwCollectionNotLoadedError;
 
+  struct QuotaOptions {
+    /// @brief share of the scheduler threads, 0 means no limit
+    double schedulerShare = 0.0;
+    uint64_t writeRate = 0;
+    uint64_t queries = 0;
+  };
+
+  /// @brief limits of all databases but _system
+  QuotaOptions _defaultQuota;
+  /// @brief limits of single databases, as <database>:<option>=<value>
+  std::vector<std::string> _quotas;
+  std::unordered_map<std::string, QuotaOptions> _databaseQuotas;
+
   std::unique_ptr<DatabaseManagerThread> _databaseManager;
 
   std::atomic<DatabasesLists*> _databasesLists;
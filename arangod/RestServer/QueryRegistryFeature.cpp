@@ -25,7 +25,9 @@
 #include "Aql/Query.h"
 #include "Aql/QueryCache.h"
 #include "Aql/QueryRegistry.h"
+#include "Aql/ResourceUsage.h"
 #include "Cluster/ServerState.h"
+#include "Graph/CoordinatorVertexCache.h"
 #include "ProgramOptions/ProgramOptions.h"
 #include "ProgramOptions/Section.h"
 
@@ -43,8 +45,13 @@ QueryRegistryFeature::QueryRegistryFeature(application_features::ApplicationServ
       _trackBindVars(true),
       _failOnWarning(false),
       _smartJoins(true),
+      _snippetTemplates(true),
       _queryMemoryLimit(0),
+      _globalMemoryLimit(0),
+      _globalMemoryAdmissionTimeout(10.0),
+      _cursorSpillThreshold(0),
       _maxQueryPlans(128),
+      _maxOptimizerRuntime(1.0),
       _slowQueryThreshold(10.0),
       _slowStreamingQueryThreshold(10.0),
       _queryCacheMode("off"),
@@ -52,7 +59,8 @@ QueryRegistryFeature::QueryRegistryFeature(application_features::ApplicationServ
       _queryCacheMaxResultsSize(0),
       _queryCacheMaxEntrySize(0),
       _queryCacheIncludeSystem(false),
-      _queryRegistryTTL(0) {
+      _queryRegistryTTL(0),
+      _vertexCacheSize(0) {
   setOptional(false);
   startsAfter("V8Phase");
 
@@ -75,6 +83,19 @@ void QueryRegistryFeature::collectOptions(std::shared_ptr<ProgramOptions> option
                      "memory threshold for AQL queries (in bytes)",
                      new UInt64Parameter(&_queryMemoryLimit));
 
+  options->addOption("--query.global-memory-limit",
+                     "memory threshold for all AQL queries of the server "
+                     "together (in bytes); 0 means no limit",
+                     new UInt64Parameter(&_globalMemoryLimit))
+                     .setIntroducedIn(30500);
+
+  options->addOption("--query.global-memory-admission-timeout",
+                     "time (in seconds) a new query waits for memory when "
+                     "the global query memory limit is reached, before it "
+                     "fails",
+                     new DoubleParameter(&_globalMemoryAdmissionTimeout))
+                     .setIntroducedIn(30500);
+
   options->addOption("--query.tracking", "whether to track slow AQL queries",
                      new BooleanParameter(&_trackSlowQueries));
 
@@ -123,6 +144,26 @@ void QueryRegistryFeature::collectOptions(std::shared_ptr<ProgramOptions> option
                      "maximum number of query plans to create for a query",
                      new UInt64Parameter(&_maxQueryPlans));
 
+  options->addOption("--query.optimizer-max-runtime",
+                     "time (in seconds) after which the optimizer stops "
+                     "creating additional query plans; 0 means no limit",
+                     new DoubleParameter(&_maxOptimizerRuntime))
+                     .setIntroducedIn(30500);
+
+  options->addOption("--query.cursor-spill-threshold",
+                     "size (in bytes) of non-streaming cursor results above "
+                     "which they are kept in a memory-mapped temporary file "
+                     "instead of RAM; 0 means results are never spilled",
+                     new UInt64Parameter(&_cursorSpillThreshold))
+                     .setIntroducedIn(30500);
+
+  options->addOption("--query.vertex-cache-size",
+                     "size (in bytes) of the cache for vertex documents of "
+                     "traversals on a coordinator, shared by all read-only "
+                     "queries; 0 means no cache",
+                     new UInt64Parameter(&_vertexCacheSize))
+                     .setIntroducedIn(30500);
+
   options->addOption("--query.registry-ttl",
                      "default time-to-live of cursors and query snippets (in "
                      "seconds); if <= 0, value will default to 30 for "
@@ -135,6 +176,13 @@ void QueryRegistryFeature::collectOptions(std::shared_ptr<ProgramOptions> option
                      new BooleanParameter(&_smartJoins),
                      arangodb::options::makeFlags(arangodb::options::Flags::Hidden, arangodb::options::Flags::Enterprise))
                      .setIntroducedIn(30405).setIntroducedIn(30500);
+
+  options->addOption("--query.snippet-templates",
+                     "send the query snippets for further shards of a DB server "
+                     "as references to the snippet of its first shard",
+                     new BooleanParameter(&_snippetTemplates),
+                     arangodb::options::makeFlags(arangodb::options::Flags::Hidden))
+                     .setIntroducedIn(30500);
 }
 
 void QueryRegistryFeature::validateOptions(std::shared_ptr<ProgramOptions> options) {
@@ -145,6 +193,10 @@ void QueryRegistryFeature::validateOptions(std::shared_ptr<ProgramOptions> optio
     FATAL_ERROR_EXIT();
   }
 
+  if (_globalMemoryAdmissionTimeout < 0.0) {
+    _globalMemoryAdmissionTimeout = 0.0;
+  }
+
   // cap the value somehow. creating this many plans really does not make sense
   _maxQueryPlans = std::min(_maxQueryPlans, decltype(_maxQueryPlans)(1024));
 }
@@ -170,12 +222,19 @@ void QueryRegistryFeature::prepare() {
     _queryRegistryTTL = ServerState::instance()->isSingleServer() ? 30 : 600;
   }
 
+  aql::GlobalResourceMonitor::instance().setMemoryLimit(_globalMemoryLimit);
+  aql::GlobalResourceMonitor::instance().setAdmissionTimeout(_globalMemoryAdmissionTimeout);
+
   // create the query registery
   _queryRegistry.reset(new aql::QueryRegistry(_queryRegistryTTL));
   QUERY_REGISTRY.store(_queryRegistry.get(), std::memory_order_release);
 }
 
-void QueryRegistryFeature::start() {}
+void QueryRegistryFeature::start() {
+  if (ServerState::instance()->isCoordinator()) {
+    graph::CoordinatorVertexCache::create(_vertexCacheSize);
+  }
+}
 
 void QueryRegistryFeature::beginShutdown() {
   TRI_ASSERT(_queryRegistry != nullptr);
@@ -186,6 +245,7 @@ void QueryRegistryFeature::stop() {
   TRI_ASSERT(_queryRegistry != nullptr);
   _queryRegistry->disallowInserts();
   _queryRegistry->destroyAll();
+  graph::CoordinatorVertexCache::destroy();
 }
 
 void QueryRegistryFeature::unprepare() {
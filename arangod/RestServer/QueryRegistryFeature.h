@@ -56,16 +56,24 @@ class QueryRegistryFeature final : public application_features::ApplicationFeatu
   }
   bool failOnWarning() const { return _failOnWarning; }
   bool smartJoins() const { return _smartJoins; }
+  bool snippetTemplates() const { return _snippetTemplates; }
   uint64_t queryMemoryLimit() const { return _queryMemoryLimit; }
+  uint64_t cursorSpillThreshold() const { return _cursorSpillThreshold; }
   uint64_t maxQueryPlans() const { return _maxQueryPlans; }
+  double maxOptimizerRuntime() const { return _maxOptimizerRuntime; }
 
  private:
   bool _trackSlowQueries;
   bool _trackBindVars;
   bool _failOnWarning;
   bool _smartJoins;
+  bool _snippetTemplates;
   uint64_t _queryMemoryLimit;
+  uint64_t _globalMemoryLimit;
+  double _globalMemoryAdmissionTimeout;
+  uint64_t _cursorSpillThreshold;
   uint64_t _maxQueryPlans;
+  double _maxOptimizerRuntime;
   double _slowQueryThreshold;
   double _slowStreamingQueryThreshold;
   std::string _queryCacheMode;
@@ -74,6 +82,7 @@ class QueryRegistryFeature final : public application_features::ApplicationFeatu
   uint64_t _queryCacheMaxEntrySize;
   bool _queryCacheIncludeSystem;
   double _queryRegistryTTL;
+  uint64_t _vertexCacheSize;
 
  public:
   aql::QueryRegistry* queryRegistry() const { return _queryRegistry.get(); }
@@ -37,6 +37,10 @@
 #include "ProgramOptions/ProgramOptions.h"
 #include "RestServer/DatabaseFeature.h"
 #include "RestServer/QueryRegistryFeature.h"
+#include "Transaction/Helpers.h"
+#include "Transaction/StandaloneContext.h"
+#include "Utils/OperationOptions.h"
+#include "Utils/SingleCollectionTransaction.h"
 #include "VocBase/LogicalCollection.h"
 #include "VocBase/vocbase.h"
 
@@ -53,6 +57,19 @@ using namespace arangodb::options;
 namespace {
 // the AQL query to remove documents
 std::string const removeQuery("FOR doc IN @@collection FILTER doc.@indexAttribute >= 0 && doc.@indexAttribute <= @stamp SORT doc.@indexAttribute LIMIT @limit REMOVE doc IN @@collection OPTIONS { ignoreErrors: true }");
+
+// maximum number of documents removed by a single transaction when the TTL
+// index can look up the expired documents itself
+size_t const removeBatchSize = 1000;
+
+/// @brief check whether an error during TTL removal is expected and can be
+/// ignored. the thread will try to remove the documents again later
+bool isToleratedError(Result const& res) {
+  return res.is(TRI_ERROR_ARANGO_READ_ONLY) ||
+         res.is(TRI_ERROR_ARANGO_CONFLICT) ||
+         res.is(TRI_ERROR_LOCKED) ||
+         res.is(TRI_ERROR_ARANGO_DATA_SOURCE_NOT_FOUND);
+}
 }
 
 namespace arangodb {
@@ -316,6 +333,25 @@ class TtlThread final : public Thread {
           double expireAfter = ea.getNumericValue<double>();
           LOG_TOPIC("5cca5", DEBUG, Logger::TTL) << "TTL thread going to work for collection '" << collection->name() << "', expireAfter: " << Logger::FIXED(expireAfter, 0) << ", stamp: " << (stamp - expireAfter) << ", limit: " << std::min(properties.maxCollectionRemoves, limitLeft);
 
+          uint64_t directRemoved = 0;
+          Result res = removeExpiredDirect(*vocbase, *collection, *index,
+                                           stamp - expireAfter,
+                                           std::min(properties.maxCollectionRemoves, limitLeft),
+                                           directRemoved);
+          if (!res.is(TRI_ERROR_NOT_IMPLEMENTED)) {
+            if (res.fail() && !::isToleratedError(res)) {
+              LOG_TOPIC("4e7ab", WARN, Logger::TTL) << "error during TTL document removal for collection '" << collection->name() << "': " << res.errorMessage();
+            }
+            // documents removed before a failing batch are still gone
+            stats.documentsRemoved += directRemoved;
+            if (directRemoved > 0) {
+              LOG_TOPIC("4e7ac", DEBUG, Logger::TTL) << "TTL thread removed " << directRemoved << " documents for collection '" << collection->name() << "'";
+              limitLeft -= std::min(limitLeft, directRemoved);
+            }
+            // there can only be one TTL index per collection
+            break;
+          }
+
           auto bindVars = std::make_shared<VPackBuilder>();
           bindVars->openObject();
           bindVars->add("@collection", VPackValue(collection->name()));
@@ -335,10 +371,7 @@ class TtlThread final : public Thread {
           if (queryResult.result.fail()) {
             // we can probably live with an error here...
             // the thread will try to remove the documents again on next iteration
-            if (!queryResult.result.is(TRI_ERROR_ARANGO_READ_ONLY) &&
-                !queryResult.result.is(TRI_ERROR_ARANGO_CONFLICT) &&
-                !queryResult.result.is(TRI_ERROR_LOCKED) &&
-                !queryResult.result.is(TRI_ERROR_ARANGO_DATA_SOURCE_NOT_FOUND)) {
+            if (!::isToleratedError(queryResult.result)) {
               LOG_TOPIC("08300", WARN, Logger::TTL) << "error during TTL document removal for collection '" << collection->name() << "': " << queryResult.result.errorMessage();
             }
           } else {
@@ -381,6 +414,79 @@ class TtlThread final : public Thread {
     }
   }
 
+ private:
+  /// @brief remove up to limit expired documents from the collection, using
+  /// the TTL index to find them. the removal is carried out in batches of
+  /// separate transactions, so no single transaction grows large and locks
+  /// are held only briefly. the documents are removed with the regular
+  /// document API, so that all other indexes are maintained and the removals
+  /// are replicated to followers. returns TRI_ERROR_NOT_IMPLEMENTED if the
+  /// index cannot look up expired documents itself
+  Result removeExpiredDirect(TRI_vocbase_t& vocbase, LogicalCollection& collection,
+                             Index const& index, double stamp, uint64_t limit,
+                             uint64_t& removed) {
+    removed = 0;
+    std::vector<LocalDocumentId> ids;
+
+    while (removed < limit) {
+      if (!isActive() || isStopping()) {
+        break;
+      }
+
+      SingleCollectionTransaction trx(transaction::StandaloneContext::Create(vocbase),
+                                      collection, AccessMode::Type::WRITE);
+      Result res = trx.begin();
+      if (res.fail()) {
+        return res;
+      }
+
+      size_t batchSize = static_cast<size_t>(std::min<uint64_t>(limit - removed, ::removeBatchSize));
+      res = index.lookupExpired(trx, stamp, batchSize, ids);
+      if (res.fail() || ids.empty()) {
+        // nothing found, or the index cannot do the lookup
+        return res;
+      }
+
+      // build the list of keys to remove
+      _builder.clear();
+      _builder.openArray();
+      for (auto const& id : ids) {
+        collection.readDocumentWithCallback(&trx, id, [this](LocalDocumentId const&, VPackSlice doc) {
+          _builder.add(transaction::helpers::extractKeyFromDocument(doc));
+        });
+      }
+      _builder.close();
+
+      OperationOptions options;
+      options.ignoreRevs = true;
+      options.silent = true;
+      options.waitForSync = false;
+
+      OperationResult opRes = trx.remove(collection.name(), _builder.slice(), options);
+      res = trx.finish(opRes.result);
+      if (res.fail()) {
+        return res;
+      }
+
+      // documents that could not be removed (e.g. because of a concurrent
+      // modification) are reported by their error codes
+      size_t failed = 0;
+      for (auto const& it : opRes.countErrorCodes) {
+        failed += it.second;
+      }
+      size_t n = _builder.slice().length();
+      removed += (n > failed) ? n - failed : 0;
+
+      if (failed > 0 || ids.size() < batchSize) {
+        // no more expired documents, or some of them are currently being
+        // modified by someone else. leave them for the next run
+        break;
+      }
+    }
+
+    return Result();
+  }
+
  private:
   TtlFeature* _ttlFeature;
 
@@ -68,6 +68,7 @@
 #include "GeneralServer/ServerSecurityFeature.h"
 #include "Logger/LoggerBufferFeature.h"
 #include "Logger/LoggerFeature.h"
+#include "Network/NetworkFeature.h"
 #include "Pregel/PregelFeature.h"
 #include "ProgramOptions/ProgramOptions.h"
 #include "Random/RandomFeature.h"
@@ -193,6 +194,7 @@ static int runServer(int argc, char** argv, ArangoGlobalContext& context) {
     server.addFeature(new LoggerFeature(server, true));
     server.addFeature(new MaintenanceFeature(server));
     server.addFeature(new MaxMapCountFeature(server));
+    server.addFeature(new NetworkFeature(server));
     server.addFeature(new NonceFeature(server));
     server.addFeature(new PageSizeFeature(server));
     server.addFeature(new PrivilegeFeature(server));
@@ -23,6 +23,7 @@
 #include "RocksDBBackgroundThread.h"
 #include "Basics/ConditionLocker.h"
 #include "RestServer/DatabaseFeature.h"
+#include "RocksDBEngine/RocksDBCacheSnapshotManager.h"
 #include "RocksDBEngine/RocksDBCommon.h"
 #include "RocksDBEngine/RocksDBEngine.h"
 #include "RocksDBEngine/RocksDBReplicationManager.h"
@@ -77,6 +78,15 @@ void RocksDBBackgroundThread::run() {
         }
       }
 
+      RocksDBCacheSnapshotManager* snapshots = _engine->cacheSnapshotManager();
+      if (snapshots != nullptr && !isStopping()) {
+        // warm up the index caches from the previous run's snapshots in
+        // small portions, and take new snapshots once this is done
+        if (!snapshots->restore()) {
+          snapshots->persist(false);
+        }
+      }
+
       bool force = isStopping();
       _engine->replicationManager()->garbageCollect(force);
 
@@ -117,5 +127,13 @@ void RocksDBBackgroundThread::run() {
     }
   }
 
+  RocksDBCacheSnapshotManager* snapshots = _engine->cacheSnapshotManager();
+  if (snapshots != nullptr) {
+    try {
+      snapshots->persist(true);
+    } catch (...) {
+    }
+  }
+
   _engine->settingsManager()->sync(true);  // final write on shutdown
 }
@@ -0,0 +1,111 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "RocksDBBlockCache.h"
+
+#include <velocypack/Value.h>
+
+using namespace arangodb;
+
+RocksDBBlockCache::RocksDBBlockCache(std::shared_ptr<rocksdb::Cache> wrapped)
+    : _wrapped(std::move(wrapped)), _hits(0), _misses(0), _inserts(0) {
+  TRI_ASSERT(_wrapped != nullptr);
+}
+
+RocksDBBlockCache::~RocksDBBlockCache() = default;
+
+char const* RocksDBBlockCache::Name() const { return _wrapped->Name(); }
+
+rocksdb::Status RocksDBBlockCache::Insert(rocksdb::Slice const& key, void* value, size_t charge,
+                                          void (*deleter)(rocksdb::Slice const& key, void* value),
+                                          Handle** handle, Priority priority) {
+  _inserts.fetch_add(1, std::memory_order_relaxed);
+  return _wrapped->Insert(key, value, charge, deleter, handle, priority);
+}
+
+rocksdb::Cache::Handle* RocksDBBlockCache::Lookup(rocksdb::Slice const& key,
+                                                  rocksdb::Statistics* stats) {
+  Handle* handle = _wrapped->Lookup(key, stats);
+  if (handle != nullptr) {
+    _hits.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    _misses.fetch_add(1, std::memory_order_relaxed);
+  }
+  return handle;
+}
+
+bool RocksDBBlockCache::Ref(Handle* handle) { return _wrapped->Ref(handle); }
+
+bool RocksDBBlockCache::Release(Handle* handle, bool forceErase) {
+  return _wrapped->Release(handle, forceErase);
+}
+
+void* RocksDBBlockCache::Value(Handle* handle) { return _wrapped->Value(handle); }
+
+void RocksDBBlockCache::Erase(rocksdb::Slice const& key) { _wrapped->Erase(key); }
+
+uint64_t RocksDBBlockCache::NewId() { return _wrapped->NewId(); }
+
+void RocksDBBlockCache::SetCapacity(size_t capacity) {
+  _wrapped->SetCapacity(capacity);
+}
+
+void RocksDBBlockCache::SetStrictCapacityLimit(bool strictCapacityLimit) {
+  _wrapped->SetStrictCapacityLimit(strictCapacityLimit);
+}
+
+bool RocksDBBlockCache::HasStrictCapacityLimit() const {
+  return _wrapped->HasStrictCapacityLimit();
+}
+
+size_t RocksDBBlockCache::GetCapacity() const { return _wrapped->GetCapacity(); }
+
+size_t RocksDBBlockCache::GetUsage() const { return _wrapped->GetUsage(); }
+
+size_t RocksDBBlockCache::GetUsage(Handle* handle) const {
+  return _wrapped->GetUsage(handle);
+}
+
+size_t RocksDBBlockCache::GetPinnedUsage() const {
+  return _wrapped->GetPinnedUsage();
+}
+
+void RocksDBBlockCache::DisownData() { _wrapped->DisownData(); }
+
+void RocksDBBlockCache::ApplyToAllCacheEntries(void (*callback)(void*, size_t),
+                                               bool threadSafe) {
+  _wrapped->ApplyToAllCacheEntries(callback, threadSafe);
+}
+
+void RocksDBBlockCache::EraseUnRefEntries() { _wrapped->EraseUnRefEntries(); }
+
+std::string RocksDBBlockCache::GetPrintableOptions() const {
+  return _wrapped->GetPrintableOptions();
+}
+
+void RocksDBBlockCache::toVelocyPack(VPackBuilder& builder) const {
+  uint64_t h = _hits.load(std::memory_order_relaxed);
+  uint64_t m = _misses.load(std::memory_order_relaxed);
+  builder.add("hits", VPackValue(h));
+  builder.add("misses", VPackValue(m));
+  builder.add("hitRate",
+              VPackValue(h + m == 0 ? 0.0 : static_cast<double>(h) / static_cast<double>(h + m)));
+  builder.add("inserts", VPackValue(_inserts.load(std::memory_order_relaxed)));
+}
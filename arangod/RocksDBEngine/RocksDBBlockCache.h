@@ -0,0 +1,83 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGO_ROCKSDB_ROCKSDB_BLOCK_CACHE_H
+#define ARANGO_ROCKSDB_ROCKSDB_BLOCK_CACHE_H 1
+
+#include "Basics/Common.h"
+
+#include <rocksdb/cache.h>
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+namespace arangodb {
+
+/// @brief forwards to a (possibly shared) RocksDB block cache and counts
+/// the lookups and inserts made through it. One instance is used per
+/// column family, so the counters tell how well the cache serves the
+/// specific access pattern, even if all column families share the same
+/// underlying cache
+class RocksDBBlockCache final : public rocksdb::Cache {
+ public:
+  explicit RocksDBBlockCache(std::shared_ptr<rocksdb::Cache> wrapped);
+  ~RocksDBBlockCache();
+
+  char const* Name() const override;
+
+  rocksdb::Status Insert(rocksdb::Slice const& key, void* value, size_t charge,
+                         void (*deleter)(rocksdb::Slice const& key, void* value),
+                         Handle** handle, Priority priority) override;
+
+  Handle* Lookup(rocksdb::Slice const& key, rocksdb::Statistics* stats) override;
+
+  bool Ref(Handle* handle) override;
+  bool Release(Handle* handle, bool forceErase) override;
+  void* Value(Handle* handle) override;
+  void Erase(rocksdb::Slice const& key) override;
+  uint64_t NewId() override;
+  void SetCapacity(size_t capacity) override;
+  void SetStrictCapacityLimit(bool strictCapacityLimit) override;
+  bool HasStrictCapacityLimit() const override;
+  size_t GetCapacity() const override;
+  size_t GetUsage() const override;
+  size_t GetUsage(Handle* handle) const override;
+  size_t GetPinnedUsage() const override;
+  void DisownData() override;
+  void ApplyToAllCacheEntries(void (*callback)(void*, size_t), bool threadSafe) override;
+  void EraseUnRefEntries() override;
+  std::string GetPrintableOptions() const override;
+
+  /// @brief the underlying cache
+  std::shared_ptr<rocksdb::Cache> const& wrapped() const { return _wrapped; }
+
+  /// @brief adds "hits", "misses", "hitRate" and "inserts" to an open object
+  void toVelocyPack(VPackBuilder& builder) const;
+
+ private:
+  std::shared_ptr<rocksdb::Cache> _wrapped;
+  std::atomic<uint64_t> _hits;
+  std::atomic<uint64_t> _misses;
+  std::atomic<uint64_t> _inserts;
+};
+
+}  // namespace arangodb
+
+#endif
@@ -22,11 +22,14 @@
 
 #include "RocksDBBuilderIndex.h"
 
+#include "Basics/FileUtils.h"
 #include "Basics/HashSet.h"
 #include "Basics/VelocyPackHelper.h"
+#include "Indexes/IndexBuildProgress.h"
 #include "RocksDBEngine/RocksDBCollection.h"
 #include "RocksDBEngine/RocksDBColumnFamily.h"
 #include "RocksDBEngine/RocksDBCommon.h"
+#include "RocksDBEngine/RocksDBEngine.h"
 #include "RocksDBEngine/RocksDBLogValue.h"
 #include "RocksDBEngine/RocksDBMethods.h"
 #include "RocksDBEngine/RocksDBTransactionCollection.h"
@@ -46,6 +49,8 @@
 #include <velocypack/Iterator.h>
 #include <velocypack/velocypack-aliases.h>
 
+#include <thread>
+
 using namespace arangodb;
 using namespace arangodb::rocksutils;
 
@@ -168,7 +173,7 @@ static arangodb::Result fillIndex(RocksDBIndex& ridx, WriteBatchType& batch,
   ro.prefix_same_as_start = true;
   ro.iterate_upper_bound = &upper;
 
-  rocksdb::ColumnFamilyHandle* docCF = RocksDBColumnFamily::documents();
+  rocksdb::ColumnFamilyHandle* docCF = rcoll->documentsColumnFamily();
   std::unique_ptr<rocksdb::Iterator> it(rootDB->NewIterator(ro, docCF));
 
   auto mode = snap == nullptr ? AccessMode::Type::EXCLUSIVE : AccessMode::Type::WRITE;
@@ -185,13 +190,20 @@ static arangodb::Result fillIndex(RocksDBIndex& ridx, WriteBatchType& batch,
   TRI_IF_FAILURE("RocksDBBuilderIndex::fillIndex") { FATAL_ERROR_EXIT(); }
 
   uint64_t numDocsWritten = 0;
+  uint64_t numDocsReported = 0;
+  IndexBuildProgress* progress = IndexBuildProgress::CURRENT;
+  if (progress != nullptr) {
+    progress->setTotal(rcoll->numberDocuments());
+  }
   auto state = RocksDBTransactionState::toState(&trx);
   RocksDBTransactionCollection* trxColl = trx.resolveTrxCollection();
   // write batch will be reset every x documents
   MethodsType batched(state, &batch);
   
   auto commitLambda = [&] {
+    uint64_t bytes = 0;
     if (batch.GetWriteBatch()->Count() > 0) {
+      bytes = batch.GetWriteBatch()->GetDataSize();
       s = rootDB->Write(wo, batch.GetWriteBatch());
       if (!s.ok()) {
         res = rocksutils::convertStatus(s, rocksutils::StatusHint::index);
@@ -199,6 +211,11 @@ static arangodb::Result fillIndex(RocksDBIndex& ridx, WriteBatchType& batch,
     }
     batch.Clear();
 
+    if (progress != nullptr) {
+      progress->advance(numDocsWritten - numDocsReported, bytes);
+      numDocsReported = numDocsWritten;
+    }
+
     auto ops = trxColl->stealTrackedOperations();
     if (!ops.empty()) {
       TRI_ASSERT(ridx.hasSelectivityEstimate() && ops.size() == 1);
@@ -220,6 +237,7 @@ static arangodb::Result fillIndex(RocksDBIndex& ridx, WriteBatchType& batch,
     }
   };
 
+  std::string valueBuffer;
   for (it->Seek(bounds.start()); it->Valid(); it->Next()) {
     TRI_ASSERT(it->key().compare(upper) < 0);
     if (application_features::ApplicationServer::isStopping()) {
@@ -228,7 +246,8 @@ static arangodb::Result fillIndex(RocksDBIndex& ridx, WriteBatchType& batch,
     }
 
     res = ridx.insert(trx, &batched, RocksDBKey::documentId(it->key()),
-                      VPackSlice(reinterpret_cast<uint8_t const*>(it->value().data())), Index::OperationMode::normal);
+                      rcoll->documentFromValue(it->value(), valueBuffer),
+                      Index::OperationMode::normal);
     if (res.fail()) {
       break;
     }
@@ -265,6 +284,330 @@ static arangodb::Result fillIndex(RocksDBIndex& ridx, WriteBatchType& batch,
   return res;
 }
 
+namespace {
+
+/// @brief minimum number of documents for a parallel index build
+constexpr uint64_t parallelFillMinDocuments = 100000;
+
+/// @brief approximate size of a sorted run, i.e. of one SST file
+constexpr size_t parallelFillRunSize = 64 * 1024 * 1024;
+
+/// @brief only non-unique VPack-based indexes can be filled in parallel:
+/// their keys contain the document id, so the partitions can never produce
+/// conflicting keys, and they do not need to look up existing entries
+bool useParallelFill(RocksDBIndex const& ridx) {
+  if (ridx.unique() || !Index::allowExpansion(ridx.type())) {
+    return false;
+  }
+  if (globalRocksEngine()->indexBuildThreads() <= 1) {
+    return false;
+  }
+  auto* rcoll = static_cast<RocksDBCollection*>(ridx.collection().getPhysical());
+  return rcoll->numberDocuments() >= parallelFillMinDocuments;
+}
+
+/// @brief collects the index entries that an index wrote into a WriteBatch
+struct RunCollector final : public rocksdb::WriteBatch::Handler {
+  std::vector<std::pair<std::string, std::string>> entries;
+
+  rocksdb::Status PutCF(uint32_t, rocksdb::Slice const& key,
+                        rocksdb::Slice const& value) override {
+    entries.emplace_back(key.ToString(), value.ToString());
+    return rocksdb::Status();
+  }
+
+  rocksdb::Status DeleteCF(uint32_t, rocksdb::Slice const&) override {
+    return rocksdb::Status::NotSupported("delete while filling index");
+  }
+
+  rocksdb::Status SingleDeleteCF(uint32_t, rocksdb::Slice const&) override {
+    return rocksdb::Status::NotSupported("delete while filling index");
+  }
+
+  rocksdb::Status DeleteRangeCF(uint32_t, rocksdb::Slice const&, rocksdb::Slice const&) override {
+    return rocksdb::Status::NotSupported("delete while filling index");
+  }
+};
+
+/// @brief reads the document id part of a document key as a big-endian
+/// number, which preserves the key order independent of the key format
+uint64_t documentKeyOrdinal(rocksdb::Slice const& key) {
+  TRI_ASSERT(key.size() == 2 * sizeof(uint64_t));
+  uint64_t value = 0;
+  for (size_t i = sizeof(uint64_t); i < 2 * sizeof(uint64_t); ++i) {
+    value = (value << 8) | static_cast<uint8_t>(key.data()[i]);
+  }
+  return value;
+}
+
+std::string documentKeyFromOrdinal(rocksdb::Slice const& prefix, uint64_t value) {
+  std::string key(prefix.data(), sizeof(uint64_t));
+  for (size_t i = 0; i < sizeof(uint64_t); ++i) {
+    key.push_back(static_cast<char>((value >> (8 * (sizeof(uint64_t) - 1 - i))) & 0xFFU));
+  }
+  return key;
+}
+
+/// @brief fills the index entries of all documents in [lower, upper) into
+/// sorted SST files
+Result fillPartition(RocksDBIndex& ridx, rocksdb::Snapshot const* snap,
+                     AccessMode::Type mode, bool foreground, std::string const& lower,
+                     std::string const& upper, std::string const& filePrefix,
+                     std::vector<std::string>& files, IndexBuildProgress* progress) {
+  rocksdb::DB* rootDB = rocksutils::globalRocksDB()->GetRootDB();
+  RocksDBCollection* rcoll =
+      static_cast<RocksDBCollection*>(ridx.collection().getPhysical());
+
+  rocksdb::Slice upperSlice(upper);
+  rocksdb::ReadOptions ro(/*cksum*/ false, /*cache*/ false);
+  ro.snapshot = snap;
+  ro.prefix_same_as_start = true;
+  ro.iterate_upper_bound = &upperSlice;
+  std::unique_ptr<rocksdb::Iterator> it(rootDB->NewIterator(ro, rcoll->documentsColumnFamily()));
+
+  LogicalCollection& coll = ridx.collection();
+  ::BuilderTrx trx(transaction::StandaloneContext::Create(coll.vocbase()), coll, mode);
+  if (mode == AccessMode::Type::EXCLUSIVE) {
+    trx.addHint(transaction::Hints::Hint::LOCK_NEVER);
+  }
+  Result res = trx.begin();
+  if (res.fail()) {
+    return res;
+  }
+
+  auto state = RocksDBTransactionState::toState(&trx);
+  RocksDBTransactionCollection* trxColl = trx.resolveTrxCollection();
+  rocksdb::WriteBatch batch(32 * 1024 * 1024);
+  RocksDBBatchedMethods batched(state, &batch);
+  uint64_t docsInRun = 0;
+
+  auto writeRun = [&]() -> Result {
+    RunCollector collector;
+    uint64_t const bytes = batch.GetDataSize();
+    rocksdb::Status s = batch.Iterate(&collector);
+    batch.Clear();
+    if (!s.ok()) {
+      return rocksutils::convertStatus(s, rocksutils::StatusHint::index);
+    }
+    if (progress != nullptr) {
+      progress->advance(docsInRun, bytes);
+    }
+    docsInRun = 0;
+
+    auto ops = trxColl->stealTrackedOperations();
+    if (!ops.empty()) {
+      TRI_ASSERT(ridx.hasSelectivityEstimate() && ops.size() == 1);
+      auto op = ops.begin();
+      TRI_ASSERT(ridx.id() == op->first);
+      if (foreground) {
+        for (uint64_t hash : op->second.inserts) {
+          ridx.estimator()->insert(hash);
+        }
+      } else {
+        ridx.estimator()->bufferUpdates(1, std::move(op->second.inserts),
+                                        std::move(op->second.removals));
+      }
+    }
+
+    if (collector.entries.empty()) {
+      return Result();
+    }
+
+    files.emplace_back(filePrefix + std::to_string(files.size()) + ".sst");
+    // an array index can produce the same entry twice for a document
+    return rocksutils::writeSstFile(rootDB, ridx.columnFamily(), collector.entries,
+                                    files.back(), /*skipDuplicates*/ true);
+  };
+
+  std::string valueBuffer;
+  for (it->Seek(lower); it->Valid(); it->Next()) {
+    if (application_features::ApplicationServer::isStopping()) {
+      return res.reset(TRI_ERROR_SHUTTING_DOWN);
+    }
+
+    res = ridx.insert(trx, &batched, RocksDBKey::documentId(it->key()),
+                      rcoll->documentFromValue(it->value(), valueBuffer),
+                      Index::OperationMode::normal);
+    if (res.fail()) {
+      return res;
+    }
+    ++docsInRun;
+
+    if (batch.GetDataSize() >= parallelFillRunSize) {
+      res = writeRun();
+      if (res.fail()) {
+        return res;
+      }
+    }
+  }
+
+  if (!it->status().ok()) {
+    return res.reset(rocksutils::convertStatus(it->status(), rocksutils::StatusHint::index));
+  }
+
+  res = writeRun();
+  if (res.ok()) {
+    res = trx.commit();
+  }
+  return res;
+}
+
+/// @brief fills a non-unique index by splitting the collection's documents
+/// into key ranges that are processed concurrently. every partition writes
+/// sorted runs into SST files, which are then ingested into the index column
+/// family. this bypasses the memtable and the WAL entirely and is safe
+/// because nothing else writes index entries for an index under construction
+Result parallelFillIndex(RocksDBIndex& ridx, rocksdb::Snapshot const* snap, bool foreground) {
+  RocksDBEngine* engine = globalRocksEngine();
+  rocksdb::DB* rootDB = engine->db()->GetRootDB();
+
+  // all partitions must see the same data. in foreground mode the collection
+  // is locked exclusively, so a snapshot taken now is equivalent
+  rocksdb::Snapshot const* ownSnap = nullptr;
+  if (snap == nullptr) {
+    ownSnap = rootDB->GetSnapshot();
+    snap = ownSnap;
+  }
+  auto releaseSnap = scopeGuard([&] {
+    if (ownSnap != nullptr) {
+      rootDB->ReleaseSnapshot(ownSnap);
+    }
+  });
+
+  RocksDBCollection* rcoll =
+      static_cast<RocksDBCollection*>(ridx.collection().getPhysical());
+  auto bounds = RocksDBKeyBounds::CollectionDocuments(rcoll->objectId());
+  rocksdb::Slice upper(bounds.end());
+
+  // the partitions run in their own threads, so they get the progress of
+  // this thread passed in
+  IndexBuildProgress* progress = IndexBuildProgress::CURRENT;
+  if (progress != nullptr) {
+    progress->setTotal(rcoll->numberDocuments());
+  }
+
+  // determine the first and last document key
+  std::string firstKey, lastKey;
+  {
+    rocksdb::ReadOptions ro(/*cksum*/ false, /*cache*/ false);
+    ro.snapshot = snap;
+    ro.prefix_same_as_start = true;
+    ro.iterate_upper_bound = &upper;
+    std::unique_ptr<rocksdb::Iterator> it(rootDB->NewIterator(ro, rcoll->documentsColumnFamily()));
+    it->Seek(bounds.start());
+    if (it->Valid()) {
+      firstKey = it->key().ToString();
+      it->SeekForPrev(bounds.end());
+      if (it->Valid()) {
+        lastKey = it->key().ToString();
+      }
+    }
+    if (!it->status().ok()) {
+      return rocksutils::convertStatus(it->status(), rocksutils::StatusHint::index);
+    }
+  }
+
+  std::string dir = engine->ingestionPath();
+  if (!basics::FileUtils::isDirectory(dir)) {
+    long systemError;
+    std::string errorMessage;
+    int r = TRI_CreateRecursiveDirectory(dir.c_str(), systemError, errorMessage);
+    if (r != TRI_ERROR_NO_ERROR) {
+      return Result(r, "unable to create SST ingestion directory '" + dir + "': " + errorMessage);
+    }
+  }
+
+  std::vector<std::string> boundaries;
+  if (!firstKey.empty() && !lastKey.empty()) {
+    uint64_t first = ::documentKeyOrdinal(firstKey);
+    uint64_t last = ::documentKeyOrdinal(lastKey);
+    uint64_t n = engine->indexBuildThreads();
+    uint64_t step = std::max(static_cast<uint64_t>(1), (last - first) / n);
+    boundaries.emplace_back(bounds.start().ToString());
+    for (uint64_t i = 1; i < n && first + i * step <= last; ++i) {
+      boundaries.emplace_back(::documentKeyFromOrdinal(firstKey, first + i * step));
+    }
+    boundaries.emplace_back(bounds.end().ToString());
+  }
+
+  size_t numPartitions = boundaries.empty() ? 0 : boundaries.size() - 1;
+  std::vector<Result> results(numPartitions);
+  std::vector<std::vector<std::string>> files(numPartitions);
+  auto mode = foreground ? AccessMode::Type::EXCLUSIVE : AccessMode::Type::WRITE;
+  std::string const filePrefix = basics::FileUtils::buildFilename(
+      dir, std::to_string(ridx.objectId()) + "-");
+
+  auto removeFiles = scopeGuard([&] {
+    for (auto const& partition : files) {
+      for (auto const& file : partition) {
+        // files that were ingested have already been moved
+        if (basics::FileUtils::exists(file)) {
+          TRI_UnlinkFile(file.c_str());
+        }
+      }
+    }
+  });
+
+  {
+    std::vector<std::thread> threads;
+    threads.reserve(numPartitions);
+    for (size_t i = 0; i < numPartitions; ++i) {
+      threads.emplace_back([&, i]() {
+        try {
+          results[i] = ::fillPartition(ridx, snap, mode, foreground, boundaries[i],
+                                       boundaries[i + 1],
+                                       filePrefix + std::to_string(i) + "-",
+                                       files[i], progress);
+        } catch (basics::Exception const& ex) {
+          results[i].reset(ex.code(), ex.what());
+        } catch (std::exception const& ex) {
+          results[i].reset(TRI_ERROR_INTERNAL, ex.what());
+        } catch (...) {
+          results[i].reset(TRI_ERROR_INTERNAL);
+        }
+      });
+    }
+    for (auto& t : threads) {
+      t.join();
+    }
+  }
+
+  for (auto const& r : results) {
+    if (r.fail()) {
+      return r;
+    }
+  }
+
+  TRI_IF_FAILURE("RocksDBBuilderIndex::fillIndex") { FATAL_ERROR_EXIT(); }
+
+  // runs of different partitions may overlap, and RocksDB does not ingest
+  // overlapping files in one go. all keys are new, so order does not matter
+  rocksdb::IngestExternalFileOptions ifo;
+  ifo.move_files = true;
+  uint64_t numFiles = 0;
+  for (auto const& partition : files) {
+    for (auto const& file : partition) {
+      rocksdb::Status s = rootDB->IngestExternalFile(ridx.columnFamily(), {file}, ifo);
+      if (!s.ok()) {
+        return rocksutils::convertStatus(s, rocksutils::StatusHint::index);
+      }
+      ++numFiles;
+    }
+  }
+
+  if (ridx.estimator() != nullptr) {
+    ridx.estimator()->setAppliedSeq(rootDB->GetLatestSequenceNumber());
+  }
+
+  LOG_TOPIC("4e7a8", DEBUG, Logger::ENGINES)
+      << "SNAPSHOT CAPTURED in " << numPartitions << " partitions, ingested "
+      << numFiles << " files";
+
+  return Result();
+}
+
+}  // namespace
+
 arangodb::Result RocksDBBuilderIndex::fillIndexForeground() {
   RocksDBIndex* internal = _wrapped.get();
   TRI_ASSERT(internal != nullptr);
@@ -278,6 +621,8 @@ arangodb::Result RocksDBBuilderIndex::fillIndexForeground() {
     // avoid duplicate index keys. must therefore use a WriteBatchWithIndex
     rocksdb::WriteBatchWithIndex batch(cmp, 32 * 1024 * 1024);
     res = ::fillIndex<rocksdb::WriteBatchWithIndex, RocksDBBatchedWithIndexMethods, true>(*internal, batch, snap);
+  } else if (::useParallelFill(*internal)) {
+    res = ::parallelFillIndex(*internal, snap, true);
   } else {
     // non-unique index. all index keys will be unique anyway because they
     // contain the document id we can therefore get away with a cheap WriteBatch
@@ -351,7 +696,7 @@ struct ReplayHandler final : public rocksdb::WriteBatch::Handler {
     incTick();
     if (column_family_id == RocksDBColumnFamily::definitions()->GetID()) {
       _lastObjectID = 0;
-    } else if (column_family_id == RocksDBColumnFamily::documents()->GetID()) {
+    } else if (RocksDBColumnFamily::isDocuments(column_family_id)) {
       _lastObjectID = RocksDBKey::objectId(key);
     }
 
@@ -362,7 +707,7 @@ struct ReplayHandler final : public rocksdb::WriteBatch::Handler {
     incTick();
     if (column_family_id == RocksDBColumnFamily::definitions()->GetID()) {
       _lastObjectID = 0;
-    } else if (column_family_id == RocksDBColumnFamily::documents()->GetID()) {
+    } else if (RocksDBColumnFamily::isDocuments(column_family_id)) {
       _lastObjectID = RocksDBKey::objectId(key);
     }
     return rocksdb::Status();
@@ -372,7 +717,7 @@ struct ReplayHandler final : public rocksdb::WriteBatch::Handler {
     incTick();
     if (column_family_id == RocksDBColumnFamily::definitions()->GetID()) {
       _lastObjectID = 0;
-    } else if (column_family_id == RocksDBColumnFamily::documents()->GetID()) {
+    } else if (RocksDBColumnFamily::isDocuments(column_family_id)) {
       _lastObjectID = RocksDBKey::objectId(key);
     }
     return rocksdb::Status();
@@ -558,6 +903,8 @@ arangodb::Result RocksDBBuilderIndex::fillIndexBackground(Locker& locker) {
     // avoid duplicate index keys. must therefore use a WriteBatchWithIndex
     rocksdb::WriteBatchWithIndex batch(cmp, 32 * 1024 * 1024);
     res = ::fillIndex<rocksdb::WriteBatchWithIndex, RocksDBBatchedWithIndexMethods, false>(*internal, batch, snap);
+  } else if (::useParallelFill(*internal)) {
+    res = ::parallelFillIndex(*internal, snap, false);
   } else {
     // non-unique index. all index keys will be unique anyway because they
     // contain the document id we can therefore get away with a cheap WriteBatch
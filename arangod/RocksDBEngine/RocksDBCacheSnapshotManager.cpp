@@ -0,0 +1,284 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "RocksDBCacheSnapshotManager.h"
+
+#include "ApplicationFeatures/ApplicationServer.h"
+#include "Basics/FileUtils.h"
+#include "Basics/ScopeGuard.h"
+#include "Basics/StringUtils.h"
+#include "Basics/files.h"
+#include "Basics/system-functions.h"
+#include "Logger/Logger.h"
+#include "RestServer/DatabaseFeature.h"
+#include "RocksDBEngine/RocksDBEngine.h"
+#include "RocksDBEngine/RocksDBIndex.h"
+#include "Transaction/StandaloneContext.h"
+#include "Utils/SingleCollectionTransaction.h"
+#include "VocBase/LogicalCollection.h"
+#include "VocBase/vocbase.h"
+
+#include <algorithm>
+
+#include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/Slice.h>
+#include <velocypack/Validator.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+namespace {
+std::string const snapshotSuffix(".vpack");
+
+bool hasCache(Index const& idx) {
+  return idx.type() == Index::TRI_IDX_TYPE_PRIMARY_INDEX ||
+         idx.type() == Index::TRI_IDX_TYPE_EDGE_INDEX;
+}
+}  // namespace
+
+RocksDBCacheSnapshotManager::RocksDBCacheSnapshotManager(RocksDBEngine* engine,
+                                                         std::string const& directory,
+                                                         double interval)
+    : _engine(engine),
+      _directory(directory),
+      _interval(interval),
+      _lastPersist(TRI_microtime()),
+      _loaded(false) {}
+
+std::string RocksDBCacheSnapshotManager::snapshotFile(uint64_t objectId) const {
+  return basics::FileUtils::buildFilename(_directory,
+                                          std::to_string(objectId) + ::snapshotSuffix);
+}
+
+void RocksDBCacheSnapshotManager::persist(bool force) {
+  if (!_loaded) {
+    // do not overwrite the previous snapshots with those of a cold cache
+    return;
+  }
+
+  double const now = TRI_microtime();
+  if (!force && now < _lastPersist + _interval) {
+    return;
+  }
+  _lastPersist = now;
+
+  auto dbfeature = DatabaseFeature::DATABASE;
+  if (dbfeature == nullptr) {
+    return;
+  }
+
+  if (!basics::FileUtils::isDirectory(_directory)) {
+    int error = TRI_ERROR_NO_ERROR;
+    if (!basics::FileUtils::createDirectory(_directory, &error)) {
+      LOG_TOPIC("c1a3f", WARN, Logger::CACHE)
+          << "could not create cache snapshot directory '" << _directory
+          << "': " << TRI_errno_string(error);
+      return;
+    }
+  }
+
+  VPackBuilder builder;
+  size_t numFiles = 0;
+  for (auto const& pair : _engine->collectionMappings()) {
+    TRI_vocbase_t* vocbase = dbfeature->useDatabase(pair.first);
+    if (!vocbase) {
+      continue;
+    }
+    TRI_DEFER(vocbase->release());
+
+    TRI_vocbase_col_status_e status;
+    std::shared_ptr<LogicalCollection> coll = vocbase->useCollection(pair.second, status);
+    if (!coll) {
+      continue;
+    }
+    TRI_DEFER(vocbase->releaseCollection(coll.get()));
+
+    for (auto const& idx : coll->getIndexes()) {
+      if (!::hasCache(*idx)) {
+        continue;
+      }
+      auto* rIdx = static_cast<RocksDBIndex*>(idx.get());
+      if (isPending(rIdx->objectId())) {
+        // keep the previous snapshot until it has been restored completely
+        continue;
+      }
+      std::vector<std::string> keys = rIdx->cacheHotKeys(maxKeysPerIndex);
+      if (keys.empty()) {
+        continue;
+      }
+
+      builder.clear();
+      builder.openObject();
+      builder.add("keys", VPackValue(VPackValueType::Array));
+      for (auto const& key : keys) {
+        builder.add(VPackValuePair(key.data(), key.size(), VPackValueType::Binary));
+      }
+      builder.close();
+      builder.close();
+
+      // write to a temporary file first, so a crash never leaves a
+      // truncated snapshot behind
+      std::string const filename = snapshotFile(rIdx->objectId());
+      std::string const tmpFilename = filename + ".tmp";
+      try {
+        basics::FileUtils::spit(tmpFilename, builder.slice().startAs<char>(),
+                                builder.slice().byteSize(), false);
+      } catch (...) {
+        LOG_TOPIC("c1a40", WARN, Logger::CACHE)
+            << "could not write cache snapshot file '" << tmpFilename << "'";
+        continue;
+      }
+      if (TRI_RenameFile(tmpFilename.c_str(), filename.c_str()) != TRI_ERROR_NO_ERROR) {
+        TRI_UnlinkFile(tmpFilename.c_str());
+        continue;
+      }
+      ++numFiles;
+    }
+  }
+
+  LOG_TOPIC("c1a41", DEBUG, Logger::CACHE)
+      << "wrote " << numFiles << " cache snapshot file(s)";
+}
+
+bool RocksDBCacheSnapshotManager::isPending(uint64_t objectId) const {
+  return std::any_of(_pending.begin(), _pending.end(), [objectId](PendingRestore const& pending) {
+    return pending.objectId == objectId;
+  });
+}
+
+void RocksDBCacheSnapshotManager::loadSnapshots() {
+  TRI_ASSERT(!_loaded);
+  _loaded = true;
+
+  if (!basics::FileUtils::isDirectory(_directory)) {
+    return;
+  }
+
+  for (auto const& name : basics::FileUtils::listFiles(_directory)) {
+    std::string const filename = basics::FileUtils::buildFilename(_directory, name);
+    if (name.size() <= ::snapshotSuffix.size() ||
+        name.compare(name.size() - ::snapshotSuffix.size(),
+                     ::snapshotSuffix.size(), ::snapshotSuffix) != 0) {
+      // e.g. a leftover temporary file
+      TRI_UnlinkFile(filename.c_str());
+      continue;
+    }
+
+    PendingRestore pending;
+    pending.objectId = basics::StringUtils::uint64(
+        name.substr(0, name.size() - ::snapshotSuffix.size()));
+    pending.position = 0;
+
+    try {
+      std::string const content = basics::FileUtils::slurp(filename);
+      VPackValidator validator;
+      validator.validate(content.data(), content.size());
+
+      VPackSlice keys = VPackSlice(reinterpret_cast<uint8_t const*>(content.data())).get("keys");
+      if (keys.isArray()) {
+        pending.keys.reserve(keys.length());
+        for (VPackSlice key : VPackArrayIterator(keys)) {
+          if (key.isBinary()) {
+            VPackValueLength length;
+            uint8_t const* data = key.getBinary(length);
+            pending.keys.emplace_back(reinterpret_cast<char const*>(data),
+                                      static_cast<size_t>(length));
+          }
+        }
+      }
+    } catch (...) {
+      LOG_TOPIC("c1a42", WARN, Logger::CACHE)
+          << "ignoring invalid cache snapshot file '" << filename << "'";
+      pending.keys.clear();
+    }
+
+    if (pending.objectId != 0 && !pending.keys.empty()) {
+      // the file is removed once all of its keys have been restored, so
+      // that a shutdown in the middle of the warmup does not lose it
+      _pending.emplace_back(std::move(pending));
+    } else {
+      TRI_UnlinkFile(filename.c_str());
+    }
+  }
+
+  LOG_TOPIC("c1a43", DEBUG, Logger::CACHE)
+      << "restoring " << _pending.size() << " cache snapshot(s)";
+}
+
+bool RocksDBCacheSnapshotManager::restore() {
+  if (!_loaded) {
+    loadSnapshots();
+  }
+
+  auto dbfeature = DatabaseFeature::DATABASE;
+  size_t budget = restoreBatchSize;
+  while (budget > 0 && !_pending.empty() && dbfeature != nullptr &&
+         !application_features::ApplicationServer::isStopping()) {
+    PendingRestore& pending = _pending.back();
+    size_t const n = std::min(budget, pending.keys.size() - pending.position);
+    std::vector<std::string> keys(pending.keys.begin() + pending.position,
+                                  pending.keys.begin() + pending.position + n);
+    uint64_t const objectId = pending.objectId;
+    // advance first, so that a failing index is not retried forever
+    pending.position += n;
+    budget -= n;
+    if (pending.position == pending.keys.size()) {
+      // the next snapshot will be taken from the warmed-up cache
+      TRI_UnlinkFile(snapshotFile(objectId).c_str());
+      _pending.pop_back();
+    }
+
+    RocksDBEngine::IndexTriple triple = _engine->mapObjectToIndex(objectId);
+    if (std::get<0>(triple) == 0) {
+      // index was dropped in the meantime
+      continue;
+    }
+
+    TRI_vocbase_t* vocbase = dbfeature->useDatabase(std::get<0>(triple));
+    if (!vocbase) {
+      continue;
+    }
+    TRI_DEFER(vocbase->release());
+
+    TRI_vocbase_col_status_e status;
+    std::shared_ptr<LogicalCollection> coll =
+        vocbase->useCollection(std::get<1>(triple), status);
+    if (!coll) {
+      continue;
+    }
+    TRI_DEFER(vocbase->releaseCollection(coll.get()));
+
+    std::shared_ptr<Index> idx = coll->lookupIndex(std::get<2>(triple));
+    if (idx == nullptr || !::hasCache(*idx)) {
+      continue;
+    }
+
+    SingleCollectionTransaction trx(transaction::StandaloneContext::Create(*vocbase),
+                                    *coll, AccessMode::Type::READ);
+    if (trx.begin().fail()) {
+      continue;
+    }
+    static_cast<RocksDBIndex*>(idx.get())->warmupCacheKeys(&trx, keys);
+    trx.commit();
+  }
+
+  return !_pending.empty();
+}
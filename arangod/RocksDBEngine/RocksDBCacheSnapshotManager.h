@@ -0,0 +1,79 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_ROCKSDB_ENGINE_ROCKSDB_CACHE_SNAPSHOT_MANAGER_H
+#define ARANGOD_ROCKSDB_ENGINE_ROCKSDB_CACHE_SNAPSHOT_MANAGER_H 1
+
+#include "Basics/Common.h"
+
+#include <string>
+#include <vector>
+
+namespace arangodb {
+
+class RocksDBEngine;
+
+/// @brief persists the hot keys of the edge and primary index caches to small
+/// files in the database directory, and re-populates the caches from these
+/// files after a restart, so that caches do not start out cold.
+/// not thread-safe: only the RocksDB background thread uses an instance.
+class RocksDBCacheSnapshotManager {
+ public:
+  /// @brief maximum number of keys persisted per index cache
+  static constexpr size_t maxKeysPerIndex = 65536;
+  /// @brief maximum number of keys restored per call to restore(), to bound
+  /// the I/O the warmup adds to the regular workload
+  static constexpr size_t restoreBatchSize = 8192;
+
+  RocksDBCacheSnapshotManager(RocksDBEngine* engine, std::string const& directory,
+                              double interval);
+
+  /// @brief write new snapshots if the interval has passed since the last
+  /// write, or unconditionally if force is set. the snapshot of an index that
+  /// is still being restored from the previous run is left as it is
+  void persist(bool force);
+
+  /// @brief re-populate the caches with at most restoreBatchSize keys from the
+  /// snapshots of the previous run. returns true if there is more to restore
+  bool restore();
+
+ private:
+  struct PendingRestore {
+    uint64_t objectId;
+    std::vector<std::string> keys;
+    size_t position;
+  };
+
+  bool isPending(uint64_t objectId) const;
+  void loadSnapshots();
+  std::string snapshotFile(uint64_t objectId) const;
+
+ private:
+  RocksDBEngine* _engine;
+  std::string const _directory;
+  double const _interval;
+  double _lastPersist;
+  bool _loaded;
+  std::vector<PendingRestore> _pending;
+};
+
+}  // namespace arangodb
+
+#endif
@@ -21,6 +21,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "Aql/PlanCache.h"
+#include "Basics/MutexLocker.h"
 #include "Basics/ReadLocker.h"
 #include "Basics/Result.h"
 #include "Basics/StaticStrings.h"
@@ -39,6 +40,7 @@
 #include "RocksDBEngine/RocksDBBuilderIndex.h"
 #include "RocksDBEngine/RocksDBCommon.h"
 #include "RocksDBEngine/RocksDBComparator.h"
+#include "RocksDBEngine/RocksDBDocumentDictionary.h"
 #include "RocksDBEngine/RocksDBEngine.h"
 #include "RocksDBEngine/RocksDBIterators.h"
 #include "RocksDBEngine/RocksDBKey.h"
@@ -81,6 +83,14 @@ RocksDBCollection::RocksDBCollection(LogicalCollection& collection,
           !collection.system() &&
           basics::VelocyPackHelper::readBooleanValue(info, "cacheEnabled", false) &&
           CacheManagerFeature::MANAGER != nullptr),
+      _dedicatedColumnFamily(
+          !collection.system() &&
+          basics::VelocyPackHelper::readBooleanValue(info, "dedicatedColumnFamily", false)),
+      _universalCompaction(basics::VelocyPackHelper::getStringValue(
+                               info, "documentsCompactionStyle", "level") == "universal"),
+      _compressDocuments(
+          !collection.system() &&
+          basics::VelocyPackHelper::readBooleanValue(info, "compressDocuments", false)),
       _numIndexCreations(0) {
   TRI_ASSERT(!ServerState::instance()->isCoordinator());
   VPackSlice s = info.get("isVolatile");
@@ -89,6 +99,17 @@ RocksDBCollection::RocksDBCollection(LogicalCollection& collection,
         TRI_ERROR_BAD_PARAMETER,
         "volatile collections are unsupported in the RocksDB engine");
   }
+  s = info.get("documentsCompactionStyle");
+  if (!s.isNone() && !s.isEqualString("level") && !s.isEqualString("universal")) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(
+        TRI_ERROR_BAD_PARAMETER,
+        "documentsCompactionStyle must be either 'level' or 'universal'");
+  }
+  if (_universalCompaction && !_dedicatedColumnFamily) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(
+        TRI_ERROR_BAD_PARAMETER,
+        "documentsCompactionStyle 'universal' requires a dedicated column family");
+  }
 
   TRI_ASSERT(_logicalCollection.isAStub() || _objectId != 0);
   rocksutils::globalRocksEngine()->addCollectionMapping(
@@ -97,6 +118,9 @@ RocksDBCollection::RocksDBCollection(LogicalCollection& collection,
   if (_cacheEnabled) {
     createCache();
   }
+  if (_compressDocuments && _objectId != 0) {
+    loadDocumentDictionary();
+  }
 }
 
 RocksDBCollection::RocksDBCollection(LogicalCollection& collection,
@@ -110,6 +134,11 @@ RocksDBCollection::RocksDBCollection(LogicalCollection& collection,
       _cachePresent(false),
       _cacheEnabled(static_cast<RocksDBCollection const*>(physical)->_cacheEnabled &&
                     CacheManagerFeature::MANAGER != nullptr),
+      _dedicatedColumnFamily(
+          static_cast<RocksDBCollection const*>(physical)->_dedicatedColumnFamily),
+      _universalCompaction(static_cast<RocksDBCollection const*>(physical)->_universalCompaction),
+      _compressDocuments(static_cast<RocksDBCollection const*>(physical)->_compressDocuments),
+      _dictionary(std::atomic_load(&static_cast<RocksDBCollection const*>(physical)->_dictionary)),
       _numIndexCreations(0) {
   TRI_ASSERT(!ServerState::instance()->isCoordinator());
   rocksutils::globalRocksEngine()->addCollectionMapping(
@@ -175,9 +204,20 @@ void RocksDBCollection::getPropertiesVPack(velocypack::Builder& result) const {
   TRI_ASSERT(result.isOpenObject());
   result.add("objectId", VPackValue(std::to_string(_objectId)));
   result.add("cacheEnabled", VPackValue(_cacheEnabled));
+  result.add("dedicatedColumnFamily", VPackValue(_dedicatedColumnFamily));
+  result.add("documentsCompactionStyle",
+             VPackValue(_universalCompaction ? "universal" : "level"));
+  result.add("compressDocuments", VPackValue(_compressDocuments));
   TRI_ASSERT(result.isOpenObject());
 }
 
+rocksdb::ColumnFamilyHandle* RocksDBCollection::documentsColumnFamily() const {
+  if (_dedicatedColumnFamily) {
+    return RocksDBColumnFamily::documents(_objectId);
+  }
+  return RocksDBColumnFamily::documents();
+}
+
 /// @brief closes an open collection
 int RocksDBCollection::close() {
   READ_LOCKER(guard, _indexesLock);
@@ -314,6 +354,9 @@ std::shared_ptr<Index> RocksDBCollection::createIndex(VPackSlice const& info,
   if (res.fail()) {
     THROW_ARANGO_EXCEPTION(res);
   }
+  // the new index has no persisted estimate yet, so load the others before
+  // the index shows up in the list
+  _meta.loadIndexEstimates(_logicalCollection);
   _numIndexCreations.fetch_add(1, std::memory_order_release);
   auto colGuard = scopeGuard([&] {
     vocbase.releaseCollection(&_logicalCollection);
@@ -585,6 +628,12 @@ Result RocksDBCollection::truncate(transaction::Methods& trx, OperationOptions&
   auto state = RocksDBTransactionState::toState(&trx);
   RocksDBMethods* mthds = state->rocksdbMethods();
 
+  if (_keyRangeLocks.lockAllKeys(state->id()) != TRI_ERROR_NO_ERROR) {
+    // truncate would remove documents in key ranges of other transactions
+    return Result(TRI_ERROR_ARANGO_CONFLICT,
+                  "collection has key ranges locked by other transactions");
+  }
+
   if (state->isOnlyExclusiveTransaction() &&
       state->hasHint(transaction::Hints::Hint::ALLOW_RANGE_DELETE) &&
       this->canUseRangeDeleteInWal() && _numberDocuments >= 32 * 1024) {
@@ -656,6 +705,7 @@ Result RocksDBCollection::truncate(transaction::Methods& trx, OperationOptions&
     uint64_t numDocs = _numberDocuments.exchange(0);
     _meta.adjustNumberDocuments(seq, /*revision*/ newRevisionId(),
                                 -static_cast<int64_t>(numDocs));
+    _logicalCollection.bumpInvalidationTick();
 
     {
       READ_LOCKER(guard, _indexesLock);
@@ -676,7 +726,7 @@ Result RocksDBCollection::truncate(transaction::Methods& trx, OperationOptions&
 
   // normal transactional truncate
   RocksDBKeyBounds documentBounds = RocksDBKeyBounds::CollectionDocuments(_objectId);
-  rocksdb::Comparator const* cmp = RocksDBColumnFamily::documents()->GetComparator();
+  rocksdb::Comparator const* cmp = documentsColumnFamily()->GetComparator();
   rocksdb::ReadOptions ro = mthds->iteratorReadOptions();
   rocksdb::Slice const end = documentBounds.end();
   ro.iterate_upper_bound = &end;
@@ -689,6 +739,7 @@ Result RocksDBCollection::truncate(transaction::Methods& trx, OperationOptions&
 
   uint64_t found = 0;
   VPackBuilder docBuffer;
+  std::string valueBuffer;
   auto iter = mthds->NewIterator(ro, documentBounds.columnFamily());
   for (iter->Seek(documentBounds.start());
        iter->Valid() && cmp->Compare(iter->key(), end) < 0;
@@ -696,7 +747,7 @@ Result RocksDBCollection::truncate(transaction::Methods& trx, OperationOptions&
 
     ++found;
     TRI_ASSERT(_objectId == RocksDBKey::objectId(iter->key()));
-    VPackSlice document(reinterpret_cast<uint8_t const*>(iter->value().data()));
+    VPackSlice document = documentFromValue(iter->value(), valueBuffer);
     TRI_ASSERT(document.isObject());
 
     // tmp may contain a pointer into rocksdb::WriteBuffer::_rep. This is
@@ -841,6 +892,90 @@ bool RocksDBCollection::readDocumentWithCallback(transaction::Methods* trx,
   return false;
 }
 
+void RocksDBCollection::readDocumentsWithCallback(transaction::Methods* trx,
+                                                  std::vector<LocalDocumentId> const& documentIds,
+                                                  IndexIterator::DocumentCallback const& cb) const {
+  TRI_ASSERT(trx->state()->isRunning());
+  TRI_ASSERT(_objectId != 0);
+
+  size_t const n = documentIds.size();
+  // documents found in the cache are copied into cached, all others are
+  // looked up in RocksDB in one go. results points to the value per position
+  std::unique_ptr<rocksdb::PinnableSlice[]> cached(new rocksdb::PinnableSlice[n]);
+  std::vector<rocksdb::PinnableSlice const*> results(n, nullptr);
+  std::vector<RocksDBKey> keys;
+  std::vector<size_t> positions;
+  keys.reserve(n);
+  positions.reserve(n);
+
+  bool lockTimeout = false;
+  for (size_t i = 0; i < n; ++i) {
+    if (!documentIds[i].isSet()) {
+      continue;
+    }
+    if (useCache()) {
+      TRI_ASSERT(_cache != nullptr);
+      // check cache first for fast path
+      LocalDocumentId::BaseType const id = documentIds[i].id();
+      auto f = _cache->find(&id, sizeof(id));
+      if (f.found()) {
+        cached[i].PinSelf(rocksdb::Slice(reinterpret_cast<char const*>(f.value()->value()),
+                                         f.value()->valueSize()));
+        results[i] = &cached[i];
+        continue;
+      }
+      if (f.result().errorNumber() == TRI_ERROR_LOCK_TIMEOUT) {
+        // assuming someone is currently holding a write lock, which
+        // is why we cannot access the TransactionalBucket.
+        lockTimeout = true;  // we skip the inserts in this case
+      }
+    }
+
+    RocksDBKey key;
+    key.constructDocument(_objectId, documentIds[i]);
+    keys.emplace_back(std::move(key));
+    positions.emplace_back(i);
+  }
+
+  size_t const numLookups = keys.size();
+  std::unique_ptr<rocksdb::PinnableSlice[]> values;
+  if (numLookups > 0) {
+    std::vector<rocksdb::Slice> slices;
+    slices.reserve(numLookups);
+    for (auto const& key : keys) {
+      slices.emplace_back(key.string());
+    }
+    values.reset(new rocksdb::PinnableSlice[numLookups]);
+    std::vector<rocksdb::Status> statuses(numLookups);
+
+    RocksDBMethods* mthd = RocksDBTransactionState::toMethods(trx);
+    mthd->MultiGet(documentsColumnFamily(), numLookups, slices.data(),
+                   values.get(), statuses.data());
+
+    for (size_t i = 0; i < numLookups; ++i) {
+      if (!statuses[i].ok()) {
+        LOG_TOPIC("a9b2e", DEBUG, Logger::ENGINES)
+            << "NOT FOUND rev: " << documentIds[positions[i]].id()
+            << " trx: " << trx->state()->id() << " objectID " << _objectId
+            << " name: " << _logicalCollection.name();
+        continue;
+      }
+      uncompressDocument(values[i]);
+      results[positions[i]] = &values[i];
+      if (useCache() && !lockTimeout) {
+        insertIntoCache(documentIds[positions[i]], values[i]);
+      }
+    }
+  }
+
+  for (size_t i = 0; i < n; ++i) {
+    if (results[i] != nullptr) {
+      TRI_ASSERT(results[i]->size() > 0);
+      cb(documentIds[i], VPackSlice(reinterpret_cast<uint8_t const*>(results[i]->data())));
+    }
+  }
+}
+
 Result RocksDBCollection::insert(arangodb::transaction::Methods* trx,
                                  arangodb::velocypack::Slice const slice,
                                  arangodb::ManagedDocumentResult& resultMdr,
@@ -859,6 +994,11 @@ Result RocksDBCollection::insert(arangodb::transaction::Methods* trx,
   }
 
   VPackSlice newSlice = builder->slice();
+  res = waitForKeyRange(trx, transaction::helpers::extractKeyFromDocument(newSlice));
+  if (res.fail()) {
+    return res;
+  }
+
   if (options.overwrite) {
     // special optimization for the overwrite case:
     // in case the operation is a RepSert, we will first check if the specified
@@ -890,7 +1030,7 @@ Result RocksDBCollection::insert(arangodb::transaction::Methods* trx,
 
   LocalDocumentId const documentId = LocalDocumentId::create();
 
-  RocksDBSavePoint guard(trx, TRI_VOC_DOCUMENT_OPERATION_INSERT);
+  RocksDBSavePoint guard(trx, TRI_VOC_DOCUMENT_OPERATION_INSERT, options.abortOnFailure);
 
   auto* state = RocksDBTransactionState::toState(trx);
   state->prepareOperation(_logicalCollection.id(), revisionId, TRI_VOC_DOCUMENT_OPERATION_INSERT);
@@ -940,6 +1080,11 @@ Result RocksDBCollection::update(arangodb::transaction::Methods* trx,
     return TRI_ERROR_ARANGO_DOCUMENT_KEY_BAD;
   }
 
+  Result res = waitForKeyRange(trx, keySlice);
+  if (res.fail()) {
+    return res;
+  }
+
   auto const oldDocumentId = primaryIndex()->lookupKey(trx, VPackStringRef(keySlice));
   if (!oldDocumentId.isSet()) {
     return TRI_ERROR_ARANGO_DOCUMENT_NOT_FOUND;
@@ -947,8 +1092,8 @@ Result RocksDBCollection::update(arangodb::transaction::Methods* trx,
   std::string* prevBuffer = previousMdr.setManaged();
   // uses either prevBuffer or avoids memcpy (if read hits block cache)
   rocksdb::PinnableSlice previousPS(prevBuffer);
-  Result res = lookupDocumentVPack(trx, oldDocumentId, previousPS,
-                                   /*readCache*/true, /*fillCache*/false);
+  res = lookupDocumentVPack(trx, oldDocumentId, previousPS,
+                            /*readCache*/true, /*fillCache*/false);
   if (res.fail()) {
     return res;
   }
@@ -999,7 +1144,7 @@ Result RocksDBCollection::update(arangodb::transaction::Methods* trx,
   }
 
   VPackSlice const newDoc(builder->slice());
-  RocksDBSavePoint guard(trx, TRI_VOC_DOCUMENT_OPERATION_UPDATE);
+  RocksDBSavePoint guard(trx, TRI_VOC_DOCUMENT_OPERATION_UPDATE, options.abortOnFailure);
 
   auto* state = RocksDBTransactionState::toState(trx);
   // add possible log statement under guard
@@ -1050,6 +1195,11 @@ Result RocksDBCollection::replace(transaction::Methods* trx,
     return TRI_ERROR_ARANGO_DOCUMENT_KEY_BAD;
   }
 
+  Result res = waitForKeyRange(trx, keySlice);
+  if (res.fail()) {
+    return res;
+  }
+
   auto const oldDocumentId = primaryIndex()->lookupKey(trx, VPackStringRef(keySlice));
   if (!oldDocumentId.isSet()) {
     return TRI_ERROR_ARANGO_DOCUMENT_NOT_FOUND;
@@ -1057,8 +1207,8 @@ Result RocksDBCollection::replace(transaction::Methods* trx,
   std::string* prevBuffer = previousMdr.setManaged();
   // uses either prevBuffer or avoids memcpy (if read hits block cache)
   rocksdb::PinnableSlice previousPS(prevBuffer);
-  Result res = lookupDocumentVPack(trx, oldDocumentId, previousPS,
-                                   /*readCache*/true, /*fillCache*/false);
+  res = lookupDocumentVPack(trx, oldDocumentId, previousPS,
+                            /*readCache*/true, /*fillCache*/false);
   if (res.fail()) {
     return res;
   }
@@ -1099,7 +1249,7 @@ Result RocksDBCollection::replace(transaction::Methods* trx,
   }
 
   VPackSlice const newDoc(builder->slice());
-  RocksDBSavePoint guard(trx, TRI_VOC_DOCUMENT_OPERATION_REPLACE);
+  RocksDBSavePoint guard(trx, TRI_VOC_DOCUMENT_OPERATION_REPLACE, options.abortOnFailure);
 
   auto* state = RocksDBTransactionState::toState(trx);
   // add possible log statement under guard
@@ -1155,6 +1305,11 @@ Result RocksDBCollection::remove(transaction::Methods& trx, velocypack::Slice sl
     return TRI_ERROR_ARANGO_DOCUMENT_KEY_BAD;
   }
 
+  Result res = waitForKeyRange(&trx, keySlice);
+  if (res.fail()) {
+    return res;
+  }
+
   auto const documentId = primaryIndex()->lookupKey(&trx, VPackStringRef(keySlice));
   if (!documentId.isSet()) {
     return TRI_ERROR_ARANGO_DOCUMENT_NOT_FOUND;
@@ -1162,8 +1317,8 @@ Result RocksDBCollection::remove(transaction::Methods& trx, velocypack::Slice sl
   std::string* prevBuffer = previousMdr.setManaged();
   // uses either prevBuffer or avoids memcpy (if read hits block cache)
   rocksdb::PinnableSlice previousPS(prevBuffer);
-  Result res = lookupDocumentVPack(&trx, documentId, previousPS,
-                                   /*readCache*/true, /*fillCache*/false);
+  res = lookupDocumentVPack(&trx, documentId, previousPS,
+                            /*readCache*/true, /*fillCache*/false);
   if (res.fail()) {
     return res;
   }
@@ -1184,7 +1339,7 @@ Result RocksDBCollection::remove(transaction::Methods& trx, velocypack::Slice sl
   }
 
   auto state = RocksDBTransactionState::toState(&trx);
-  RocksDBSavePoint guard(&trx, TRI_VOC_DOCUMENT_OPERATION_REMOVE);
+  RocksDBSavePoint guard(&trx, TRI_VOC_DOCUMENT_OPERATION_REMOVE, options.abortOnFailure);
 
   // add possible log statement under guard
   state->prepareOperation(_logicalCollection.id(), previousMdr.revisionId(),
@@ -1229,12 +1384,17 @@ void RocksDBCollection::figuresSpecific(std::shared_ptr<arangodb::velocypack::Bu
   rocksdb::Range r(bounds.start(), bounds.end());
 
   uint64_t out = 0;
-  db->GetApproximateSizes(RocksDBColumnFamily::documents(), &r, 1, &out,
+  db->GetApproximateSizes(documentsColumnFamily(), &r, 1, &out,
                           static_cast<uint8_t>(
                               rocksdb::DB::SizeApproximationFlags::INCLUDE_MEMTABLES |
                               rocksdb::DB::SizeApproximationFlags::INCLUDE_FILES));
 
   builder->add("documentsSize", VPackValue(out));
+  if (_compressDocuments) {
+    auto dictionary = std::atomic_load(&_dictionary);
+    builder->add("documentDictionarySize",
+                 VPackValue(dictionary == nullptr ? 0 : dictionary->size()));
+  }
   bool cacheInUse = useCache();
   builder->add("cacheInUse", VPackValue(cacheInUse));
   if (cacheInUse) {
@@ -1268,7 +1428,7 @@ Result RocksDBCollection::insertDocument(arangodb::transaction::Methods* trx,
   RocksDBTransactionState* state = RocksDBTransactionState::toState(trx);
   if (state->hasHint(transaction::Hints::Hint::GLOBAL_MANAGED)) {
     // blacklist new document to avoid caching without committing first
-    blackListKey(key.ref());
+    blackListKey(documentId);
   }
     
   RocksDBMethods* mthds = state->rocksdbMethods();
@@ -1276,10 +1436,9 @@ Result RocksDBCollection::insertDocument(arangodb::transaction::Methods* trx,
   IndexingDisabler disabler(mthds, trx->isSingleOperationTransaction());
 
   TRI_ASSERT(key->containsLocalDocumentId(documentId));
-  rocksdb::Status s =
-      mthds->PutUntracked(RocksDBColumnFamily::documents(), key.ref(),
-                          rocksdb::Slice(doc.startAs<char>(),
-                                         static_cast<size_t>(doc.byteSize())));
+  transaction::StringLeaser buffer(trx);
+  rocksdb::Status s = mthds->PutUntracked(documentsColumnFamily(), key.ref(),
+                                          documentValue(doc, *buffer.get()));
   if (!s.ok()) {
     return res.reset(rocksutils::convertStatus(s, rocksutils::document));
   }
@@ -1310,14 +1469,14 @@ Result RocksDBCollection::removeDocument(arangodb::transaction::Methods* trx,
   RocksDBKeyLeaser key(trx);
   key->constructDocument(_objectId, documentId);
 
-  blackListKey(key.ref());
+  blackListKey(documentId);
 
   RocksDBMethods* mthds = RocksDBTransactionState::toMethods(trx);
 
   // disable indexing in this transaction if we are allowed to
   IndexingDisabler disabler(mthds, trx->isSingleOperationTransaction());
 
-  rocksdb::Status s = mthds->SingleDelete(RocksDBColumnFamily::documents(), key.ref());
+  rocksdb::Status s = mthds->SingleDelete(documentsColumnFamily(), key.ref());
   if (!s.ok()) {
     return res.reset(rocksutils::convertStatus(s, rocksutils::document));
   }
@@ -1360,25 +1519,25 @@ Result RocksDBCollection::updateDocument(transaction::Methods* trx,
   RocksDBKeyLeaser key(trx);
   key->constructDocument(_objectId, oldDocumentId);
   TRI_ASSERT(key->containsLocalDocumentId(oldDocumentId));
-  blackListKey(key.ref());
+  blackListKey(oldDocumentId);
 
-  rocksdb::Status s = mthds->SingleDelete(RocksDBColumnFamily::documents(), key.ref());
+  rocksdb::Status s = mthds->SingleDelete(documentsColumnFamily(), key.ref());
   if (!s.ok()) {
     return res.reset(rocksutils::convertStatus(s, rocksutils::document));
   }
 
   key->constructDocument(_objectId, newDocumentId);
   TRI_ASSERT(key->containsLocalDocumentId(newDocumentId));
-  s = mthds->PutUntracked(RocksDBColumnFamily::documents(), key.ref(),
-                          rocksdb::Slice(newDoc.startAs<char>(),
-                                         static_cast<size_t>(newDoc.byteSize())));
+  transaction::StringLeaser buffer(trx);
+  s = mthds->PutUntracked(documentsColumnFamily(), key.ref(),
+                          documentValue(newDoc, *buffer.get()));
   if (!s.ok()) {
     return res.reset(rocksutils::convertStatus(s, rocksutils::document));
   }
   
   if (state->hasHint(transaction::Hints::Hint::GLOBAL_MANAGED)) {
     // blacklist new document to avoid caching without committing first
-    blackListKey(key.ref());
+    blackListKey(newDocumentId);
   }
     
   READ_LOCKER(guard, _indexesLock);
@@ -1414,8 +1573,8 @@ arangodb::Result RocksDBCollection::lookupDocumentVPack(transaction::Methods* tr
   if (readCache && useCache()) {
     TRI_ASSERT(_cache != nullptr);
     // check cache first for fast path
-    auto f = _cache->find(key->string().data(),
-                          static_cast<uint32_t>(key->string().size()));
+    LocalDocumentId::BaseType const id = documentId.id();
+    auto f = _cache->find(&id, sizeof(id));
     if (f.found()) {  // copy finding into buffer
       ps.PinSelf(rocksdb::Slice(reinterpret_cast<char const*>(f.value()->value()),
                                 f.value()->valueSize()));
@@ -1430,7 +1589,7 @@ arangodb::Result RocksDBCollection::lookupDocumentVPack(transaction::Methods* tr
   }
 
   RocksDBMethods* mthd = RocksDBTransactionState::toMethods(trx);
-  rocksdb::Status s = mthd->Get(RocksDBColumnFamily::documents(), key->string(), &ps);
+  rocksdb::Status s = mthd->Get(documentsColumnFamily(), key->string(), &ps);
 
   if (!s.ok()) {
     LOG_TOPIC("f63dd", DEBUG, Logger::ENGINES)
@@ -1439,50 +1598,155 @@ arangodb::Result RocksDBCollection::lookupDocumentVPack(transaction::Methods* tr
     return res.reset(rocksutils::convertStatus(s, rocksutils::document));
   }
 
+  uncompressDocument(ps);
   if (fillCache && useCache() && !lockTimeout) {
-    TRI_ASSERT(_cache != nullptr);
-    // write entry back to cache
-    auto entry =
-        cache::CachedValue::construct(key->string().data(),
-                                      static_cast<uint32_t>(key->string().size()),
-                                      ps.data(), static_cast<uint64_t>(ps.size()));
-    if (entry) {
-      auto status = _cache->insert(entry);
-      if (status.errorNumber() == TRI_ERROR_LOCK_TIMEOUT) {
-        // the writeLock uses cpu_relax internally, so we can try yield
-        std::this_thread::yield();
-        status = _cache->insert(entry);
-      }
-      if (status.fail()) {
-        delete entry;
-      }
-    }
+    insertIntoCache(documentId, ps);
   }
 
   return res;
 }
 
+VPackSlice RocksDBCollection::documentFromValue(rocksdb::Slice const& value,
+                                                std::string& buffer) const {
+  if (!RocksDBDocumentDictionary::isCompressed(value)) {
+    return VPackSlice(reinterpret_cast<uint8_t const*>(value.data()));
+  }
+  auto dictionary = std::atomic_load(&_dictionary);
+  if (dictionary == nullptr) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(
+        TRI_ERROR_INTERNAL,
+        "no dictionary for compressed document in collection '" +
+            _logicalCollection.name() + "'");
+  }
+  return dictionary->uncompress(value, buffer);
+}
+
+void RocksDBCollection::uncompressDocument(rocksdb::PinnableSlice& value) const {
+  if (!RocksDBDocumentDictionary::isCompressed(value)) {
+    return;
+  }
+  std::string buffer;
+  documentFromValue(value, buffer);
+  value.Reset();
+  *value.GetSelf() = std::move(buffer);
+  value.PinSelf();
+}
+
+rocksdb::Slice RocksDBCollection::documentValue(VPackSlice doc, std::string& buffer) const {
+  if (_compressDocuments) {
+    auto dictionary = std::atomic_load(&_dictionary);
+    if (dictionary == nullptr) {
+      sampleDocument(doc);
+    } else if (dictionary->compress(doc, buffer)) {
+      return rocksdb::Slice(buffer);
+    }
+  }
+  return rocksdb::Slice(doc.startAs<char>(), static_cast<size_t>(doc.byteSize()));
+}
+
+void RocksDBCollection::sampleDocument(VPackSlice doc) const {
+  MUTEX_LOCKER(locker, _samplesLock);
+  if (std::atomic_load(&_dictionary) != nullptr) {
+    return;
+  }
+
+  _samples.append(doc.startAs<char>(), static_cast<size_t>(doc.byteSize()));
+  if (_samples.size() < RocksDBDocumentDictionary::sampleSize) {
+    return;
+  }
+
+  auto dictionary = std::make_shared<RocksDBDocumentDictionary const>(
+      RocksDBDocumentDictionary::build(_samples));
+  _samples.clear();
+  _samples.shrink_to_fit();
+
+  // the dictionary is written on its own and before any document that is
+  // compressed with it, so recovery always finds it
+  VPackBuilder builder;
+  dictionary->toVelocyPack(builder);
+  RocksDBKey key;
+  key.constructDocumentDictionaryValue(_objectId);
+  RocksDBValue value = RocksDBValue::DocumentDictionaryValue(builder.slice());
+  rocksdb::WriteOptions wo;
+  rocksdb::Status s = rocksutils::globalRocksDB()->Put(wo, RocksDBColumnFamily::definitions(),
+                                                       key.string(), value.string());
+  if (!s.ok()) {
+    // sampled again for the next attempt
+    LOG_TOPIC("5d0a3", WARN, Logger::ENGINES)
+        << "could not store document dictionary of collection '"
+        << _logicalCollection.name() << "': " << s.ToString();
+    return;
+  }
+
+  LOG_TOPIC("e2c71", DEBUG, Logger::ENGINES)
+      << "built document dictionary of " << dictionary->size()
+      << " bytes for collection '" << _logicalCollection.name() << "'";
+  std::atomic_store(&_dictionary, std::move(dictionary));
+}
+
+void RocksDBCollection::loadDocumentDictionary() {
+  RocksDBKey key;
+  key.constructDocumentDictionaryValue(_objectId);
+  rocksdb::PinnableSlice value;
+  rocksdb::Status s = rocksutils::globalRocksDB()->Get(rocksdb::ReadOptions(),
+                                                       RocksDBColumnFamily::definitions(),
+                                                       key.string(), &value);
+  if (s.IsNotFound()) {
+    return;
+  }
+  if (!s.ok()) {
+    THROW_ARANGO_EXCEPTION(rocksutils::convertStatus(s));
+  }
+  std::atomic_store(&_dictionary, std::make_shared<RocksDBDocumentDictionary const>(
+                                      RocksDBValue::data(value)));
+}
+
+void RocksDBCollection::insertIntoCache(LocalDocumentId const& documentId,
+                                        rocksdb::Slice const& value) const {
+  TRI_ASSERT(_cache != nullptr);
+  // write entry back to cache. the cache is per collection, so the
+  // LocalDocumentId alone identifies the document
+  LocalDocumentId::BaseType const id = documentId.id();
+  auto entry =
+      cache::CachedValue::construct(&id, sizeof(id),
+                                    value.data(), static_cast<uint64_t>(value.size()));
+  if (entry) {
+    auto status = _cache->insert(entry);
+    if (status.errorNumber() == TRI_ERROR_LOCK_TIMEOUT) {
+      // the writeLock uses cpu_relax internally, so we can try yield
+      std::this_thread::yield();
+      status = _cache->insert(entry);
+    }
+    if (status.fail()) {
+      delete entry;
+    }
+  }
+}
+
 bool RocksDBCollection::lookupDocumentVPack(transaction::Methods* trx,
                                             LocalDocumentId const& documentId,
                                             IndexIterator::DocumentCallback const& cb,
                                             bool withCache) const {
 
+  bool fillCache = withCache;
   if (withCache && useCache()) {
-    RocksDBKeyLeaser key(trx);
-    key->constructDocument(_objectId, documentId);
     TRI_ASSERT(_cache != nullptr);
     // check cache first for fast path
-    auto f = _cache->find(key->string().data(),
-                          static_cast<uint32_t>(key->string().size()));
+    LocalDocumentId::BaseType const id = documentId.id();
+    auto f = _cache->find(&id, sizeof(id));
     if (f.found()) {
       cb(documentId, VPackSlice(reinterpret_cast<uint8_t const*>(f.value()->value())));
       return true;
     }
+    if (f.result().errorNumber() == TRI_ERROR_LOCK_TIMEOUT) {
+      // someone is holding the bucket's lock, skip the insert as well
+      fillCache = false;
+    }
   }
 
   transaction::StringLeaser buffer(trx);
   rocksdb::PinnableSlice ps(buffer.get());
-  Result res = lookupDocumentVPack(trx, documentId, ps, /*readCache*/false, withCache);
+  Result res = lookupDocumentVPack(trx, documentId, ps, /*readCache*/false, fillCache);
   if (res.ok()) {
     TRI_ASSERT(ps.size() > 0);
     cb(documentId, VPackSlice(reinterpret_cast<uint8_t const*>(ps.data())));
@@ -1709,7 +1973,7 @@ void RocksDBCollection::estimateSize(velocypack::Builder& builder) {
   RocksDBKeyBounds bounds = RocksDBKeyBounds::CollectionDocuments(_objectId);
   rocksdb::Range r(bounds.start(), bounds.end());
   uint64_t out = 0, total = 0;
-  db->GetApproximateSizes(RocksDBColumnFamily::documents(), &r, 1, &out,
+  db->GetApproximateSizes(documentsColumnFamily(), &r, 1, &out,
                           static_cast<uint8_t>(
                               rocksdb::DB::SizeApproximationFlags::INCLUDE_MEMTABLES |
                               rocksdb::DB::SizeApproximationFlags::INCLUDE_FILES));
@@ -1761,14 +2025,14 @@ void RocksDBCollection::destroyCache() const {
   _cachePresent = false;
 }
 
-// blacklist given key from transactional cache
-void RocksDBCollection::blackListKey(RocksDBKey const& k) const {
+// blacklist given document from transactional cache
+void RocksDBCollection::blackListKey(LocalDocumentId const& documentId) const {
   if (useCache()) {
     TRI_ASSERT(_cache != nullptr);
+    LocalDocumentId::BaseType const id = documentId.id();
     bool blacklisted = false;
     while (!blacklisted) {
-      auto status = _cache->blacklist(k.buffer()->data(),
-                                      static_cast<uint32_t>(k.buffer()->size()));
+      auto status = _cache->blacklist(&id, sizeof(id));
       if (status.ok()) {
         blacklisted = true;
       } else if (status.errorNumber() == TRI_ERROR_SHUTTING_DOWN) {
@@ -1790,6 +2054,23 @@ void RocksDBCollection::trackWaitForSync(arangodb::transaction::Methods* trx,
   }
 }
 
+Result RocksDBCollection::waitForKeyRange(arangodb::transaction::Methods* trx,
+                                          VPackSlice key) {
+  if (!key.isString()) {
+    return Result();
+  }
+  double timeout = trx->state()->timeout();
+  if (timeout <= 0.0) {
+    timeout = defaultLockTimeout;
+  }
+  int res = _keyRangeLocks.lockKey(trx->state()->id(), VPackStringRef(key), timeout);
+  if (res != TRI_ERROR_NO_ERROR) {
+    return Result(res, "timed out waiting for a key range lock on collection '" +
+                           _logicalCollection.name() + "'");
+  }
+  return Result();
+}
+
 /// @brief can use non transactional range delete in write ahead log
 bool RocksDBCollection::canUseRangeDeleteInWal() const {
   if (ServerState::instance()->isSingleServer()) {
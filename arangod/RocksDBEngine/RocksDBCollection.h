@@ -25,9 +25,11 @@
 #define ARANGOD_ROCKSDB_ENGINE_ROCKSDB_COLLECTION_H 1
 
 #include "Basics/Common.h"
+#include "Basics/Mutex.h"
 #include "Basics/ReadWriteLock.h"
 #include "RocksDBEngine/RocksDBCollectionMeta.h"
 #include "RocksDBEngine/RocksDBCommon.h"
+#include "RocksDBEngine/RocksDBKeyRangeLocks.h"
 #include "StorageEngine/PhysicalCollection.h"
 #include "VocBase/LogicalCollection.h"
 
@@ -43,6 +45,7 @@ class Cache;
 class LogicalCollection;
 class ManagedDocumentResult;
 class Result;
+class RocksDBDocumentDictionary;
 class RocksDBPrimaryIndex;
 class RocksDBVPackIndex;
 class LocalDocumentId;
@@ -82,6 +85,7 @@ class RocksDBCollection final : public PhysicalCollection {
   TRI_voc_rid_t revision(arangodb::transaction::Methods* trx) const override;
   uint64_t numberDocuments() const;
   uint64_t numberDocuments(transaction::Methods* trx) const override;
+  uint64_t approximateNumberDocuments() const override { return numberDocuments(); }
 
   /// @brief report extra memory used by indexes etc.
   size_t memory() const override;
@@ -139,6 +143,13 @@ class RocksDBCollection final : public PhysicalCollection {
   bool readDocumentWithCallback(transaction::Methods* trx, LocalDocumentId const& token,
                                 IndexIterator::DocumentCallback const& cb) const override;
 
+  /// @brief lookup multiple documents with a single RocksDB MultiGet for all
+  /// documents not found in the cache. cb is called for every document found,
+  /// in the order of documentIds. not thread-safe on same transaction::Context
+  void readDocumentsWithCallback(transaction::Methods* trx,
+                                 std::vector<LocalDocumentId> const& documentIds,
+                                 IndexIterator::DocumentCallback const& cb) const;
+
   Result insert(arangodb::transaction::Methods* trx, arangodb::velocypack::Slice newSlice,
                 arangodb::ManagedDocumentResult& resultMdr, OperationOptions& options,
                 bool lock, KeyLockInfo* /*keyLockInfo*/,
@@ -169,6 +180,9 @@ class RocksDBCollection final : public PhysicalCollection {
   int lockRead(double timeout = 0.0);
   void unlockRead();
 
+  /// @brief key range locks of transactions that hold the shared lock
+  RocksDBKeyRangeLocks& keyRangeLocks() { return _keyRangeLocks; }
+
   /// recalculte counts for collection in case of failure
   uint64_t recalculateCounts();
 
@@ -176,6 +190,26 @@ class RocksDBCollection final : public PhysicalCollection {
 
   inline bool cacheEnabled() const { return _cacheEnabled; }
 
+  /// @brief whether or not the documents of this collection are stored in
+  /// a column family of their own
+  bool hasDedicatedColumnFamily() const { return _dedicatedColumnFamily; }
+
+  /// @brief whether or not the dedicated documents column family uses
+  /// universal compaction
+  bool useUniversalCompaction() const { return _universalCompaction; }
+
+  /// @brief column family containing the documents of this collection
+  rocksdb::ColumnFamilyHandle* documentsColumnFamily() const;
+
+  /// @brief whether or not documents are stored compressed
+  bool compressDocuments() const { return _compressDocuments; }
+
+  /// @brief the document in a value of the documents column family.
+  /// compressed documents are uncompressed into buffer, which must
+  /// outlive the returned slice then
+  velocypack::Slice documentFromValue(rocksdb::Slice const& value,
+                                      std::string& buffer) const;
+
   RocksDBCollectionMeta& meta() { return _meta; }
 
  private:
@@ -221,6 +255,23 @@ class RocksDBCollection final : public PhysicalCollection {
                            IndexIterator::DocumentCallback const& cb,
                            bool withCache) const;
 
+  /// @brief uncompresses a document value read from RocksDB in place
+  void uncompressDocument(rocksdb::PinnableSlice& value) const;
+
+  /// @brief the value to store for a document. it points into buffer if
+  /// the document was compressed
+  rocksdb::Slice documentValue(velocypack::Slice doc, std::string& buffer) const;
+
+  /// @brief keeps a sample of a document, and builds and stores the
+  /// compression dictionary once there are enough samples
+  void sampleDocument(velocypack::Slice doc) const;
+
+  /// @brief loads the compression dictionary, if it was built already
+  void loadDocumentDictionary();
+
+  /// @brief write a document back to the cache
+  void insertIntoCache(LocalDocumentId const& documentId, rocksdb::Slice const& value) const;
+
   /// @brief create hash-cache
   void createCache() const;
   /// @brief destory hash-cache
@@ -231,12 +282,16 @@ class RocksDBCollection final : public PhysicalCollection {
     return (_cacheEnabled && _cachePresent);
   }
   
-  /// @brief track key in file
-  void blackListKey(RocksDBKey const& key) const;
+  /// @brief invalidate the cache entry for the given document
+  void blackListKey(LocalDocumentId const& documentId) const;
 
   /// @brief track the usage of waitForSync option in an operation
   void trackWaitForSync(arangodb::transaction::Methods* trx, OperationOptions& options);
 
+  /// @brief waits until the key is not in a key range locked by another
+  /// transaction, and keeps it registered until the transaction ends
+  Result waitForKeyRange(arangodb::transaction::Methods* trx, velocypack::Slice key);
+
   /// @brief can use non transactional range delete in write ahead log
   bool canUseRangeDeleteInWal() const;
 
@@ -251,6 +306,8 @@ class RocksDBCollection final : public PhysicalCollection {
   RocksDBPrimaryIndex* _primaryIndex;
   /// @brief collection lock used for write access
   mutable basics::ReadWriteLock _exclusiveLock;
+  /// @brief key ranges locked by writers instead of _exclusiveLock
+  RocksDBKeyRangeLocks _keyRangeLocks;
   /// @brief document cache (optional)
   mutable std::shared_ptr<cache::Cache> _cache;
 
@@ -258,6 +315,19 @@ class RocksDBCollection final : public PhysicalCollection {
   // it's quicker than accessing the shared_ptr each time
   mutable bool _cachePresent;
   bool _cacheEnabled;
+  /// @brief documents are stored in a dedicated column family
+  bool const _dedicatedColumnFamily;
+  /// @brief the dedicated column family uses universal compaction
+  bool const _universalCompaction;
+  /// @brief documents are compressed with a dictionary
+  bool const _compressDocuments;
+  /// @brief the compression dictionary, nullptr until enough documents
+  /// were sampled. only accessed via std::atomic_load / std::atomic_store
+  mutable std::shared_ptr<RocksDBDocumentDictionary const> _dictionary;
+  /// @brief protects _samples
+  mutable Mutex _samplesLock;
+  /// @brief sample documents to build the dictionary from
+  mutable std::string _samples;
   /// @brief number of index creations in progress
   std::atomic<int> _numIndexCreations;
 };
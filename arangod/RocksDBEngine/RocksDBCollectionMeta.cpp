@@ -24,6 +24,7 @@
 
 #include "Basics/ReadLocker.h"
 #include "Basics/WriteLocker.h"
+#include "Indexes/IndexHistogram.h"
 #include "RocksDBEngine/RocksDBCollection.h"
 #include "RocksDBEngine/RocksDBColumnFamily.h"
 #include "RocksDBEngine/RocksDBCuckooIndexEstimator.h"
@@ -70,7 +71,8 @@ void RocksDBCollectionMeta::DocCount::toVelocyPack(VPackBuilder& b) const {
   b.close();
 }
 
-RocksDBCollectionMeta::RocksDBCollectionMeta() : _count(0, 0, 0, 0) {}
+RocksDBCollectionMeta::RocksDBCollectionMeta()
+    : _count(0, 0, 0, 0), _estimatesLoaded(true), _estimatesLoading(false) {}
 
 /**
  * @brief Place a blocker to allow proper commit/serialize semantics
@@ -248,9 +250,13 @@ Result RocksDBCollectionMeta::serializeMeta(rocksdb::WriteBatch& batch,
     }
   }
 
-  // Step 3. store the index estimates
+  // Step 3. store the index estimates. estimates which were never loaded
+  // have not changed either
   std::string output;
   auto indexes = coll.getIndexes();
+  if (!indexEstimatesLoaded()) {
+    indexes.clear();
+  }
   for (std::shared_ptr<arangodb::Index>& index : indexes) {
     RocksDBIndex* idx = static_cast<RocksDBIndex*>(index.get());
     RocksDBCuckooIndexEstimator<uint64_t>* est = idx->estimator();
@@ -285,11 +291,44 @@ Result RocksDBCollectionMeta::serializeMeta(rocksdb::WriteBatch& batch,
     }
   }
 
+  // Step 4. rebuild and store the index histograms that are missing or
+  // outdated. like the estimates, they are only looked at once loaded
+  uint64_t const numberDocuments =
+      _count._added > _count._removed ? _count._added - _count._removed : 0;
+  for (std::shared_ptr<arangodb::Index>& index : indexes) {
+    RocksDBIndex* idx = static_cast<RocksDBIndex*>(index.get());
+    if (!idx->needToRebuildHistogram(numberDocuments)) {
+      continue;
+    }
+
+    std::shared_ptr<IndexHistogram const> histogram = idx->rebuildHistogram();
+    if (histogram == nullptr) {
+      continue;
+    }
+    LOG_TOPIC("4b1e7", TRACE, Logger::ENGINES)
+        << "rebuilt histogram for index '" << idx->objectId() << "' from "
+        << histogram->numSamples() << " samples";
+
+    tmp.clear();
+    histogram->toVelocyPack(tmp);
+    key.constructIndexHistogramValue(idx->objectId());
+    RocksDBValue value = RocksDBValue::IndexHistogramValue(tmp.slice());
+    rocksdb::Status s = batch.Put(cf, key.string(), value.string());
+    if (!s.ok()) {
+      LOG_TOPIC("8a4d2", WARN, Logger::ENGINES) << "writing index histogram failed";
+      return res.reset(rocksutils::convertStatus(s));
+    }
+  }
+
   return res;
 }
 
 /// @brief deserialize collection metadata, only called on startup
 Result RocksDBCollectionMeta::deserializeMeta(rocksdb::DB* db, LogicalCollection& coll) {
+  // reading and parsing the estimates of all indexes dominated the startup
+  // of servers with many collections
+  _estimatesLoaded.store(false, std::memory_order_release);
+
   RocksDBCollection* rcoll = static_cast<RocksDBCollection*>(coll.getPhysical());
 
   // Step 1. load the counter
@@ -335,18 +374,61 @@ Result RocksDBCollectionMeta::deserializeMeta(rocksdb::DB* db, LogicalCollection
     }
   }
 
-  // Step 3. load the index estimates
+  return Result();
+}
+
+/// @brief load the persisted index estimates on first use
+void RocksDBCollectionMeta::loadIndexEstimates(LogicalCollection& coll) {
+  if (indexEstimatesLoaded()) {
+    return;
+  }
+
+  std::lock_guard<std::recursive_mutex> guard(_estimatesLock);
+  if (indexEstimatesLoaded() || _estimatesLoading) {
+    // loaded by another thread, or we are loading them right now
+    return;
+  }
+  _estimatesLoading = true;
+
+  rocksdb::DB* db = rocksutils::globalRocksDB();
+  auto cf = RocksDBColumnFamily::definitions();
+  rocksdb::ReadOptions ro;
+  ro.fill_cache = false;
+
+  RocksDBKey key;
+  rocksdb::PinnableSlice value;
+
   auto indexes = coll.getIndexes();
   for (std::shared_ptr<arangodb::Index>& index : indexes) {
     RocksDBIndex* idx = static_cast<RocksDBIndex*>(index.get());
+
+    key.constructIndexHistogramValue(idx->objectId());
+    value.Reset();
+    rocksdb::Status s = db->Get(ro, cf, key.string(), &value);
+    if (s.ok()) {
+      try {
+        idx->setHistogram(std::make_shared<IndexHistogram const>(
+            RocksDBValue::data(value), IndexHistogram::FromPersistent()));
+      } catch (basics::Exception const& ex) {
+        // rebuilt by the next sync
+        LOG_TOPIC("c90b4", WARN, Logger::ENGINES)
+            << "ignoring histogram of index with objectId '" << idx->objectId()
+            << "': " << ex.what();
+      }
+    }
+
     if (idx->estimator() == nullptr) {
       continue;
     }
 
     key.constructIndexEstimateValue(idx->objectId());
+    value.Reset();
     s = db->Get(ro, cf, key.string(), &value);
     if (!s.ok() && !s.IsNotFound()) {
-      return rocksutils::convertStatus(s);
+      LOG_TOPIC("7e0c2", WARN, Logger::ENGINES)
+          << "reading index estimate of index with objectId '" << idx->objectId()
+          << "' failed: " << s.ToString();
+      continue;
     } else if (s.IsNotFound()) {  // expected with nosync recovery tests
       LOG_TOPIC("ecdbb", WARN, Logger::ENGINES)
           << "recalculating index estimate for index "
@@ -372,7 +454,8 @@ Result RocksDBCollectionMeta::deserializeMeta(rocksdb::DB* db, LogicalCollection
     }
   }
 
-  return Result();
+  _estimatesLoading = false;
+  _estimatesLoaded.store(true, std::memory_order_release);
 }
 
 // static helper methods to modify collection meta entries in rocksdb
@@ -419,10 +502,18 @@ Result RocksDBCollectionMeta::deserializeMeta(rocksdb::DB* db, LogicalCollection
     return rocksutils::convertStatus(s);
   }
 
+  key.constructDocumentDictionaryValue(objectId);
+  s = db->Delete(wo, cf, key.string());
+  if (!s.ok() && !s.IsNotFound()) {
+    LOG_TOPIC("b7f0e", ERR, Logger::ENGINES)
+        << "could not delete document dictionary: " << s.ToString();
+    return rocksutils::convertStatus(s);
+  }
+
   return Result();
 }
 
-/// @brief remove collection index estimate
+/// @brief remove the estimate and the histogram of an index
 /*static*/ Result RocksDBCollectionMeta::deleteIndexEstimate(rocksdb::DB* db, uint64_t objectId) {
   rocksdb::ColumnFamilyHandle* const cf = RocksDBColumnFamily::definitions();
   rocksdb::WriteOptions wo;
@@ -433,5 +524,11 @@ Result RocksDBCollectionMeta::deserializeMeta(rocksdb::DB* db, LogicalCollection
   if (!s.ok() && !s.IsNotFound()) {
     return rocksutils::convertStatus(s);
   }
+
+  key.constructIndexHistogramValue(objectId);
+  s = db->Delete(wo, cf, key.string());
+  if (!s.ok() && !s.IsNotFound()) {
+    return rocksutils::convertStatus(s);
+  }
   return Result();
 }
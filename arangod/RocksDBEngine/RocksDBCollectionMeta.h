@@ -27,6 +27,7 @@
 #include "Basics/Result.h"
 #include "VocBase/voc-types.h"
 
+#include <atomic>
 #include <mutex>
 #include <map>
 #include <set>
@@ -111,9 +112,19 @@ struct RocksDBCollectionMeta final {
                                  bool force, arangodb::velocypack::Builder&,
                                  rocksdb::SequenceNumber& appliedSeq);
 
-  /// @brief deserialize collection metadata, only called on startup
+  /// @brief deserialize collection metadata, only called on startup.
+  /// the index estimates are loaded on first use
   arangodb::Result deserializeMeta(rocksdb::DB*, LogicalCollection&);
 
+  /// @brief load the persisted index estimates of a collection that was
+  /// opened on startup. does nothing once they are loaded
+  void loadIndexEstimates(LogicalCollection&);
+
+  /// @brief whether the index estimates are in memory
+  bool indexEstimatesLoaded() const {
+    return _estimatesLoaded.load(std::memory_order_acquire);
+  }
+
 
 public:
   // static helper methods to modify collection meta entries in rocksdb
@@ -124,7 +135,7 @@ public:
   /// @brief remove collection metadata
   static Result deleteCollectionMeta(rocksdb::DB*, uint64_t objectId);
 
-  /// @brief remove collection index estimate
+  /// @brief remove the estimate and the histogram of an index
   static Result deleteIndexEstimate(rocksdb::DB*, uint64_t objectId);
 
  private:
@@ -154,6 +165,12 @@ public:
   std::map<rocksdb::SequenceNumber, Adjustment> _bufferedAdjs;
   /// @brief internal buffer for adjustments
   std::map<rocksdb::SequenceNumber, Adjustment> _stagedAdjs;
+
+  /// @brief protects the loading of index estimates. recursive, as loading
+  /// makes the indexes look up their estimators
+  std::recursive_mutex _estimatesLock;
+  std::atomic<bool> _estimatesLoaded;
+  bool _estimatesLoading;
 };
 }  // namespace arangodb
 
@@ -23,6 +23,7 @@
 #ifndef ARANGOD_ROCKSDB_ENGINE_COLUMN_FAMILY_H
 #define ARANGOD_ROCKSDB_ENGINE_COLUMN_FAMILY_H 1
 
+#include "Basics/ReadWriteLock.h"
 #include "RocksDBEngine/RocksDBCommon.h"
 
 #include <rocksdb/db.h>
@@ -48,6 +49,25 @@ struct RocksDBColumnFamily {
 
   static rocksdb::ColumnFamilyHandle* documents() { return _documents; }
 
+  /// documents column family of the collection with the given object id.
+  /// this is the collection's dedicated column family if it has one, and
+  /// the shared documents column family otherwise
+  static rocksdb::ColumnFamilyHandle* documents(uint64_t objectId);
+
+  /// whether or not the column family id belongs to the shared or to a
+  /// dedicated documents column family
+  static bool isDocuments(uint32_t cfId);
+
+  /// name prefix of dedicated documents column families. the full name is
+  /// the prefix followed by the collection's object id
+  static constexpr char const* dedicatedDocumentsPrefix = "Documents-";
+
+  /// name prefix of dedicated documents column families that use universal
+  /// compaction. this must be encoded in the name, as the compaction style
+  /// has to be known when the column family is opened
+  static constexpr char const* dedicatedUniversalDocumentsPrefix =
+      "DocumentsUniversal-";
+
   static rocksdb::ColumnFamilyHandle* primary() { return _primary; }
 
   static rocksdb::ColumnFamilyHandle* edge() { return _edge; }
@@ -85,6 +105,9 @@ struct RocksDBColumnFamily {
     if (cf == _fulltext) {
       return "fulltext";
     }
+    if (isDocuments(cf->GetID())) {
+      return "documents";
+    }
     if (cf == rocksutils::defaultCF()) {
       return "invalid";
     }
@@ -104,6 +127,16 @@ struct RocksDBColumnFamily {
   static rocksdb::ColumnFamilyHandle* _geo;
   static rocksdb::ColumnFamilyHandle* _fulltext;
   static std::vector<rocksdb::ColumnFamilyHandle*> _allHandles;
+
+  // dedicated documents column families, by collection object id. these
+  // are managed by the RocksDBEngine
+  static basics::ReadWriteLock _dedicatedLock;
+  static std::unordered_map<uint64_t, rocksdb::ColumnFamilyHandle*> _dedicatedDocuments;
+  static std::unordered_set<uint32_t> _dedicatedIds;
+  static std::atomic<bool> _hasDedicated;
+  // handles of dropped dedicated column families. these are only
+  // destroyed on shutdown, as they may still be in use
+  static std::vector<rocksdb::ColumnFamilyHandle*> _droppedHandles;
 };
 
 }  // namespace arangodb
@@ -38,6 +38,7 @@
 
 #include <rocksdb/comparator.h>
 #include <rocksdb/convenience.h>
+#include <rocksdb/sst_file_writer.h>
 #include <rocksdb/utilities/transaction_db.h>
 #include <velocypack/Iterator.h>
 #include <velocypack/StringRef.h>
@@ -260,5 +261,32 @@ Result removeLargeRange(rocksdb::DB* db, RocksDBKeyBounds const& bounds,
   }
 }
 
+Result writeSstFile(rocksdb::DB* db, rocksdb::ColumnFamilyHandle* cf,
+                    std::vector<std::pair<std::string, std::string>>& entries,
+                    std::string const& path, bool skipDuplicates) {
+  rocksdb::Comparator const* cmp = cf->GetComparator();
+  std::sort(entries.begin(), entries.end(), [cmp](auto const& lhs, auto const& rhs) {
+    return cmp->Compare(lhs.first, rhs.first) < 0;
+  });
+
+  rocksdb::Options options(db->GetDBOptions(), db->GetOptions(cf));
+  rocksdb::SstFileWriter writer(rocksdb::EnvOptions(), options, cf);
+  rocksdb::Status s = writer.Open(path);
+  for (size_t i = 0; i < entries.size() && s.ok(); ++i) {
+    if (i > 0 && cmp->Compare(entries[i - 1].first, entries[i].first) == 0) {
+      if (skipDuplicates) {
+        continue;
+      }
+      return Result(TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED,
+                    "duplicate key in SST file");
+    }
+    s = writer.Put(entries[i].first, entries[i].second);
+  }
+  if (s.ok()) {
+    s = writer.Finish();
+  }
+  return convertStatus(s);
+}
+
 }  // namespace rocksutils
 }  // namespace arangodb
@@ -91,6 +91,14 @@ std::size_t countKeyRange(rocksdb::DB*, RocksDBKeyBounds const&, bool prefix_sam
 Result removeLargeRange(rocksdb::DB* db, RocksDBKeyBounds const& bounds,
                         bool prefixSameAsStart, bool useRangeDelete);
 
+/// @brief sorts the entries with the column family's comparator and writes
+/// them into a new SST file, which can then be ingested. fails with
+/// TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED if a key occurs more than
+/// once, unless skipDuplicates is set, in which case only one is kept
+Result writeSstFile(rocksdb::DB* db, rocksdb::ColumnFamilyHandle* cf,
+                    std::vector<std::pair<std::string, std::string>>& entries,
+                    std::string const& path, bool skipDuplicates);
+
 // optional switch to std::function to reduce amount of includes and
 // to avoid template
 // this helper is not meant for transactional usage!
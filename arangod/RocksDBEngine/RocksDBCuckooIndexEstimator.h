@@ -28,6 +28,7 @@
 #include <map>
 
 #include "Basics/Exceptions.h"
+#include "Basics/HyperLogLog.h"
 #include "Basics/ReadLocker.h"
 #include "Basics/ReadWriteLock.h"
 #include "Basics/WriteLocker.h"
@@ -149,8 +150,10 @@ class RocksDBCuckooIndexEstimator {
     // is NOT a printed character in the serialized string
     // NOCOMPRESSION:
     // type|length|size|nrUsed|nrCuckood|nrTotal|niceSize|logSize|base|counters
-    NOCOMPRESSION = '1'
-
+    NOCOMPRESSION = '1',
+    // SKETCH:
+    // type|length|size|nrUsed|nrCuckood|nrTotal|niceSize|logSize|base|counters|sketch
+    SKETCH = '2'
   };
 
  public:
@@ -158,6 +161,7 @@ class RocksDBCuckooIndexEstimator {
     TRI_ASSERT(serialized.size() > sizeof(_appliedSeq) + sizeof(char));
     switch (serialized[sizeof(_appliedSeq)]) {
       case SerializeFormat::NOCOMPRESSION:
+      case SerializeFormat::SKETCH:
         return true;
     }
     return false;
@@ -180,7 +184,8 @@ class RocksDBCuckooIndexEstimator {
         _nrCuckood(0),
         _nrTotal(0),
         _appliedSeq(0),
-        _needToPersist(false) {
+        _needToPersist(false),
+        _sketchComplete(true) {
     // Inflate size so that we have some padding to avoid failure
     size *= 2;
     size = (size >= 1024) ? size : 1024;  // want 256 buckets minimum
@@ -208,9 +213,11 @@ class RocksDBCuckooIndexEstimator {
         _nrCuckood(0),
         _nrTotal(0),
         _appliedSeq(0),
-        _needToPersist(false) {
+        _needToPersist(false),
+        _sketchComplete(false) {
     switch (serialized[sizeof(_appliedSeq)]) {
-      case SerializeFormat::NOCOMPRESSION: {
+      case SerializeFormat::NOCOMPRESSION:
+      case SerializeFormat::SKETCH: {
         deserializeUncompressed(serialized);
         break;
       }
@@ -265,15 +272,17 @@ class RocksDBCuckooIndexEstimator {
       TRI_ASSERT(appliedSeq != std::numeric_limits<rocksdb::SequenceNumber>::max());
       rocksutils::uint64ToPersistent(serialized, appliedSeq);
 
-      // type
-      serialized += SerializeFormat::NOCOMPRESSION;
+      // type. a sketch that does not cover all values must not be
+      // persisted, otherwise it would look complete after a restart
+      serialized += _sketchComplete ? SerializeFormat::SKETCH : SerializeFormat::NOCOMPRESSION;
 
       // length
       uint64_t serialLength =
           (sizeof(SerializeFormat) + sizeof(uint64_t) + sizeof(_size) +
            sizeof(_nrUsed) + sizeof(_nrCuckood) + sizeof(_nrTotal) + sizeof(_niceSize) +
            sizeof(_logSize) + (_size * kSlotSize * kSlotsPerBucket)) +
-          (_size * kCounterSize * kSlotsPerBucket);
+          (_size * kCounterSize * kSlotsPerBucket) +
+          (_sketchComplete ? basics::HyperLogLog::serializedSize() : 0);
 
       serialized.reserve(sizeof(uint64_t) + serialLength);
       // We always prepend the length, so parsing is easier
@@ -303,6 +312,10 @@ class RocksDBCuckooIndexEstimator {
                                        *(reinterpret_cast<uint32_t*>(_counters + i)));
       }
 
+      if (_sketchComplete) {
+        _sketch.serialize(serialized);
+      }
+
       bool havePendingUpdates = !_insertBuffers.empty() || !_removalBuffers.empty() ||
                                 !_truncateBuffer.empty();
       _needToPersist.store(havePendingUpdates, std::memory_order_release);
@@ -319,6 +332,10 @@ class RocksDBCuckooIndexEstimator {
     _nrCuckood = 0;
     _nrUsed = 0;
 
+    // an empty sketch is complete again
+    _sketch.clear();
+    _sketchComplete = true;
+
     // Reset filter content
     // Now initialize all slots in all buckets with zero data:
     for (uint32_t b = 0; b < _size; ++b) {
@@ -407,6 +424,7 @@ class RocksDBCuckooIndexEstimator {
         slot.increase();
       }
       ++_nrTotal;
+      _sketch.insert(hash1);
       _needToPersist.store(true, std::memory_order_release);
     }
 
@@ -465,6 +483,26 @@ class RocksDBCuckooIndexEstimator {
   // not thread safe. called only during tests
   uint64_t nrCuckood() const { return _nrCuckood; }
 
+  /**
+   * @brief Copy the distinct value sketch along with the counters
+   *
+   * Unlike the cuckoo table, sketches of different shards can be merged.
+   * The sketch only ever grows, removals are reflected in nrUsed only.
+   *
+   * @return false if the sketch does not cover all values, e.g. because the
+   *         estimate was persisted by a version without sketches
+   */
+  bool copySketch(basics::HyperLogLog& sketch, uint64_t& nrUsed, uint64_t& nrTotal) const {
+    READ_LOCKER(locker, _lock);
+    if (!_sketchComplete) {
+      return false;
+    }
+    sketch = _sketch;
+    nrUsed = _nrUsed;
+    nrTotal = _nrTotal;
+    return true;
+  }
+
   bool needToPersist() const {
     return _needToPersist.load(std::memory_order_acquire);
   }
@@ -801,7 +839,8 @@ class RocksDBCuckooIndexEstimator {
     _appliedSeq = rocksutils::uint64FromPersistent(current);
     current += sizeof(_appliedSeq);
 
-    TRI_ASSERT(*current == SerializeFormat::NOCOMPRESSION);
+    char const format = *current;
+    TRI_ASSERT(format == SerializeFormat::NOCOMPRESSION || format == SerializeFormat::SKETCH);
     current++;  // Skip format char
 
     uint64_t length = rocksutils::uint64FromPersistent(current);
@@ -836,12 +875,14 @@ class RocksDBCuckooIndexEstimator {
     deriveSizesAndAlloc();
 
     // Validate that we have enough data in the serialized format.
+    size_t const sketchSize =
+        (format == SerializeFormat::SKETCH) ? basics::HyperLogLog::serializedSize() : 0;
     TRI_ASSERT(serialized.size() ==
                (sizeof(_appliedSeq) + sizeof(SerializeFormat) +
                 sizeof(uint64_t) + sizeof(_size) + sizeof(_nrUsed) +
                 sizeof(_nrCuckood) + sizeof(_nrTotal) + sizeof(_niceSize) +
                 sizeof(_logSize) + (_size * kSlotSize * kSlotsPerBucket)) +
-                   (_size * kCounterSize * kSlotsPerBucket));
+                   (_size * kCounterSize * kSlotsPerBucket) + sketchSize);
 
     // Insert the raw data
     // Size is as follows: nrOfBuckets * kSlotsPerBucket * SlotSize
@@ -860,6 +901,10 @@ class RocksDBCuckooIndexEstimator {
           rocksutils::uint32FromPersistent(current);
       current += kCounterSize;
     }
+
+    if (sketchSize > 0) {
+      _sketchComplete = _sketch.deserialize(current, sketchSize);
+    }
   }
 
   void initializeDefault() {
@@ -932,6 +977,9 @@ class RocksDBCuckooIndexEstimator {
   std::atomic<rocksdb::SequenceNumber> _appliedSeq;
   std::atomic<bool> _needToPersist;
 
+  basics::HyperLogLog _sketch;  // mergeable distinct value sketch
+  bool _sketchComplete;         // whether the sketch covers all values
+
   std::multimap<rocksdb::SequenceNumber, std::vector<Key>> _insertBuffers;
   std::multimap<rocksdb::SequenceNumber, std::vector<Key>> _removalBuffers;
   std::set<rocksdb::SequenceNumber> _truncateBuffer;
@@ -0,0 +1,131 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "RocksDBDocumentDictionary.h"
+
+#include "Basics/Exceptions.h"
+#include "RocksDBEngine/RocksDBFormat.h"
+
+#include <velocypack/Value.h>
+
+using namespace arangodb;
+
+constexpr uint8_t RocksDBDocumentDictionary::compressedMarker;
+constexpr size_t RocksDBDocumentDictionary::headerSize;
+constexpr size_t RocksDBDocumentDictionary::maxSize;
+constexpr size_t RocksDBDocumentDictionary::sampleSize;
+constexpr size_t RocksDBDocumentDictionary::minDocumentSize;
+
+RocksDBDocumentDictionary::RocksDBDocumentDictionary(std::string&& data)
+    : _data(std::move(data)) {
+  prepare();
+}
+
+RocksDBDocumentDictionary::RocksDBDocumentDictionary(VPackSlice slice) {
+  VPackSlice data = slice.get("data");
+  if (!data.isBinary()) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                   "invalid document dictionary");
+  }
+  VPackValueLength length;
+  uint8_t const* p = data.getBinary(length);
+  _data.assign(reinterpret_cast<char const*>(p), static_cast<size_t>(length));
+  prepare();
+}
+
+void RocksDBDocumentDictionary::prepare() {
+  if (_data.empty() || _data.size() > maxSize) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                   "invalid document dictionary size");
+  }
+  LZ4_resetStream(&_stream);
+  LZ4_loadDict(&_stream, _data.data(), static_cast<int>(_data.size()));
+}
+
+/*static*/ std::string RocksDBDocumentDictionary::build(std::string const& samples) {
+  // LZ4 prefers matches close to the data being compressed, and the end
+  // of the dictionary is the closest to it. the most recent samples are
+  // kept for that reason
+  if (samples.size() <= maxSize) {
+    return samples;
+  }
+  return samples.substr(samples.size() - maxSize);
+}
+
+bool RocksDBDocumentDictionary::compress(VPackSlice document, std::string& out) const {
+  size_t const size = static_cast<size_t>(document.byteSize());
+  if (size < minDocumentSize || size > static_cast<size_t>(LZ4_MAX_INPUT_SIZE)) {
+    return false;
+  }
+
+  // the loaded dictionary must not be modified, so compress with a copy
+  LZ4_stream_t stream;
+  std::memcpy(&stream, &_stream, sizeof(stream));
+
+  out.clear();
+  out.push_back(static_cast<char>(compressedMarker));
+  rocksutils::uint32ToPersistent(out, static_cast<uint32_t>(size));
+  TRI_ASSERT(out.size() == headerSize);
+  int const bound = LZ4_compressBound(static_cast<int>(size));
+  out.resize(headerSize + static_cast<size_t>(bound));
+  int compressed = LZ4_compress_fast_continue(&stream, document.startAs<char>(),
+                                              &out[headerSize],
+                                              static_cast<int>(size), bound, 1);
+  // only worth it if this saves at least an eighth
+  if (compressed <= 0 || headerSize + static_cast<size_t>(compressed) > size - size / 8) {
+    return false;
+  }
+  out.resize(headerSize + static_cast<size_t>(compressed));
+  return true;
+}
+
+VPackSlice RocksDBDocumentDictionary::uncompress(rocksdb::Slice const& value,
+                                                 std::string& out) const {
+  TRI_ASSERT(isCompressed(value));
+  if (value.size() <= headerSize) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                   "invalid compressed document");
+  }
+  size_t const size = rocksutils::uint32FromPersistent(value.data() + sizeof(uint8_t));
+  if (size == 0 || size > static_cast<size_t>(LZ4_MAX_INPUT_SIZE)) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                   "invalid uncompressed size of document");
+  }
+  out.resize(size);
+  int uncompressed =
+      LZ4_decompress_safe_usingDict(value.data() + headerSize, &out[0],
+                                    static_cast<int>(value.size() - headerSize),
+                                    static_cast<int>(size), _data.data(),
+                                    static_cast<int>(_data.size()));
+  VPackSlice document(reinterpret_cast<uint8_t const*>(out.data()));
+  if (uncompressed != static_cast<int>(size) || document.byteSize() != size) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                   "cannot uncompress document");
+  }
+  return document;
+}
+
+void RocksDBDocumentDictionary::toVelocyPack(VPackBuilder& builder) const {
+  builder.openObject();
+  builder.add("data", VPackValuePair(reinterpret_cast<uint8_t const*>(_data.data()),
+                                     static_cast<VPackValueLength>(_data.size()),
+                                     VPackValueType::Binary));
+  builder.close();
+}
@@ -0,0 +1,106 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGO_ROCKSDB_ROCKSDB_DOCUMENT_DICTIONARY_H
+#define ARANGO_ROCKSDB_ROCKSDB_DOCUMENT_DICTIONARY_H 1
+
+#include "Basics/Common.h"
+
+#include <rocksdb/slice.h>
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include <lz4.h>
+
+namespace arangodb {
+
+/// @brief LZ4 dictionary for compressing the documents of a collection.
+/// The documents of a collection repeat the same attribute names and
+/// value structure, which block compression only exploits within a block.
+/// Compressing each document against a dictionary built from sample
+/// documents of the collection removes this redundancy from the values
+/// themselves, so it shrinks the block cache footprint as well.
+///
+/// A dictionary never changes once it is built. Compressed values start
+/// with a marker byte that is no valid start of a document, followed by the
+/// uncompressed size and the LZ4 block
+class RocksDBDocumentDictionary {
+ public:
+  /// @brief first byte of a compressed document value. it is the
+  /// VelocyPack "illegal" type, so plain documents never start with it
+  static constexpr uint8_t compressedMarker = 0x17;
+
+  /// @brief size of the header of a compressed document value
+  static constexpr size_t headerSize = sizeof(uint8_t) + sizeof(uint32_t);
+
+  /// @brief maximum size of a dictionary. LZ4 only refers back 64KB
+  static constexpr size_t maxSize = 32 * 1024;
+
+  /// @brief amount of sample documents to build a dictionary from
+  static constexpr size_t sampleSize = 4 * maxSize;
+
+  /// @brief documents smaller than this are stored uncompressed
+  static constexpr size_t minDocumentSize = 32;
+
+  explicit RocksDBDocumentDictionary(std::string&& data);
+
+  /// @brief restores a dictionary from its VelocyPack representation
+  explicit RocksDBDocumentDictionary(VPackSlice slice);
+
+  RocksDBDocumentDictionary(RocksDBDocumentDictionary const&) = delete;
+  RocksDBDocumentDictionary& operator=(RocksDBDocumentDictionary const&) = delete;
+
+  /// @brief builds a dictionary from the concatenated sample documents.
+  /// later samples are more likely to be kept
+  static std::string build(std::string const& samples);
+
+  /// @brief whether a document value is compressed
+  static bool isCompressed(rocksdb::Slice const& value) {
+    return !value.empty() && static_cast<uint8_t>(value[0]) == compressedMarker;
+  }
+
+  /// @brief size of the dictionary in bytes
+  size_t size() const { return _data.size(); }
+
+  /// @brief compresses the document into out. returns false if this does
+  /// not save enough space, and the document should be stored as it is
+  bool compress(VPackSlice document, std::string& out) const;
+
+  /// @brief uncompresses a compressed document value into out. throws if
+  /// the value is corrupted
+  VPackSlice uncompress(rocksdb::Slice const& value, std::string& out) const;
+
+  /// @brief stores the dictionary as a VelocyPack object
+  void toVelocyPack(VPackBuilder& builder) const;
+
+ private:
+  void prepare();
+
+  std::string _data;
+  /// @brief compression stream with the dictionary loaded, copied for every
+  /// compression instead of loading the dictionary again
+  LZ4_stream_t _stream;
+};
+
+}  // namespace arangodb
+
+#endif
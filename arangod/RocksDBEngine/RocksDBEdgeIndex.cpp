@@ -34,6 +34,7 @@
 #include "RocksDBEdgeIndex.h"
 #include "RocksDBEngine/RocksDBCollection.h"
 #include "RocksDBEngine/RocksDBCommon.h"
+#include "RocksDBEngine/RocksDBEdgeIndexCacheEntry.h"
 #include "RocksDBEngine/RocksDBKey.h"
 #include "RocksDBEngine/RocksDBKeyBounds.h"
 #include "RocksDBEngine/RocksDBMethods.h"
@@ -103,6 +104,10 @@ class RocksDBEdgeIndexLookupIterator final : public IndexIterator {
     // intentional copy of the options
     rocksdb::ReadOptions ro = mthds->iteratorReadOptions();
     ro.fill_cache = EdgeIndexFillBlockCache;
+    // the iterator is reused for all lookup keys, so the bound is updated
+    // in place before each seek
+    _upperBound = _bounds.end();
+    ro.iterate_upper_bound = &_upperBound;
     _iterator = mthds->NewIterator(ro, index->columnFamily());
   }
 
@@ -156,6 +161,35 @@ class RocksDBEdgeIndexLookupIterator final : public IndexIterator {
           return true;
         }
       }
+
+      // edges of the current _from/_to value that were found in the cache
+      LocalDocumentId docId;
+      VPackSlice vertexId;
+      while (_decoder.next(docId, vertexId)) {
+        std::forward<F>(cb)(docId, vertexId);
+        limit--;
+
+        if (limit == 0) {
+          return true;
+        }
+      }
+
+      if (_decoder.needsChunk()) {
+        uint64_t returned = _decoder.returned();
+        if (!loadChunkFromCache()) {
+          // the chunk has been evicted or belongs to a newer cache entry.
+          // read all edges again, but skip the ones already returned
+          _decoder.clear();
+          lookupInRocksDB(arangodb::velocypack::StringRef(_lastKey));
+          while (returned > 0 && _builderIterator.valid()) {
+            _builderIterator.next();
+            TRI_ASSERT(_builderIterator.valid());
+            _builderIterator.next();
+            --returned;
+          }
+        }
+        continue;
+      }
       
       if (!_keysIterator.valid()) {
         // We are done iterating
@@ -173,36 +207,11 @@ class RocksDBEdgeIndexLookupIterator final : public IndexIterator {
           // Try to read from cache
           auto finding = _cache->find(fromTo.data(), (uint32_t)fromTo.size());
           if (finding.found()) {
-            needRocksLookup = false;
-            // We got sth. in the cache
-            VPackSlice cachedData(finding.value()->value());
-            TRI_ASSERT(cachedData.isArray());
-            if (cachedData.length() / 2 < limit) {              
-              // Directly return it, no need to copy
-              _builderIterator = VPackArrayIterator(cachedData);
-              while (_builderIterator.valid()) {
-                TRI_ASSERT(_builderIterator.value().isNumber());
-                LocalDocumentId docId{_builderIterator.value().getNumericValue<uint64_t>()};
-                
-                _builderIterator.next();
-                
-                TRI_ASSERT(_builderIterator.valid());
-                TRI_ASSERT(_builderIterator.value().isString());
-                std::forward<F>(cb)(docId, _builderIterator.value());
-                
-                _builderIterator.next();
-                limit--;
-              }
-              _builderIterator = VPackArrayIterator(VPackSlice::emptyArraySlice());
-            } else {
-              // We need to copy it.
-              // And then we just get back to beginning of the loop
-              _builder.clear();
-              _builder.add(cachedData);
-              TRI_ASSERT(_builder.slice().isArray());
-              _builderIterator = VPackArrayIterator(_builder.slice());
-              // Do not set limit
-            }
+            // We got sth. in the cache. Only its first chunk is copied, the
+            // edges are decoded while they are returned
+            needRocksLookup = !_decoder.start(finding.value()->value(),
+                                              finding.value()->valueSize());
+            TRI_ASSERT(!needRocksLookup);
             break;
           }  // finding found
           if (finding.result().isNot(TRI_ERROR_LOCK_TIMEOUT)) {
@@ -221,7 +230,8 @@ class RocksDBEdgeIndexLookupIterator final : public IndexIterator {
       _keysIterator.next();
     }
     TRI_ASSERT(limit == 0);
-    return _builderIterator.valid() || _keysIterator.valid();
+    return _builderIterator.valid() || _decoder.hasEdges() ||
+           _decoder.needsChunk() || _keysIterator.valid();
   }
 
   // calls cb(documentId)
@@ -260,6 +270,7 @@ class RocksDBEdgeIndexLookupIterator final : public IndexIterator {
     _lastKey = VPackSlice::nullSlice();
     _builderIterator =
         VPackArrayIterator(arangodb::velocypack::Slice::emptyArraySlice());
+    _decoder.clear();
   }
 
   /// @brief index supports rearming
@@ -303,12 +314,33 @@ class RocksDBEdgeIndexLookupIterator final : public IndexIterator {
 
   void resetInplaceMemory() { _builder.clear(); }
 
+  /// @brief hand the next cached chunk of the current _from/_to value to
+  /// the decoder
+  bool loadChunkFromCache() {
+    TRI_ASSERT(_cache != nullptr);
+    std::string key = RocksDBEdgeIndexCacheEntry::chunkKey(
+        arangodb::velocypack::StringRef(_lastKey), _decoder.nextChunk());
+    for (size_t attempts = 0; attempts < 10; ++attempts) {
+      auto finding = _cache->find(key.data(), (uint32_t)key.size());
+      if (finding.found()) {
+        return _decoder.append(finding.value()->value(), finding.value()->valueSize());
+      }
+      if (finding.result().isNot(TRI_ERROR_LOCK_TIMEOUT)) {
+        break;
+      }
+      cpu_relax();
+    }
+    return false;
+  }
+
   void lookupInRocksDB(VPackStringRef fromTo) {
     // Bad case read from RocksDB
     _bounds = RocksDBKeyBounds::EdgeIndexVertex(_index->_objectId, fromTo);
     resetInplaceMemory();
+    _encoder.clear();
     rocksdb::Comparator const* cmp = _index->comparator();
     auto end = _bounds.end();
+    _upperBound = end;
 
     cache::Cache* cc = _cache.get();
     _builder.openArray(true);
@@ -323,6 +355,9 @@ class RocksDBEdgeIndexLookupIterator final : public IndexIterator {
       _builder.add(VPackValue(documentId.id()));
       VPackStringRef vertexId = RocksDBValue::vertexId(_iterator->value());
       _builder.add(VPackValuePair(vertexId.data(), vertexId.size(), VPackValueType::String));
+      if (cc != nullptr) {
+        _encoder.add(documentId, vertexId);
+      }
     }
     _builder.close();
 
@@ -331,31 +366,10 @@ class RocksDBEdgeIndexLookupIterator final : public IndexIterator {
     
     if (cc != nullptr) {
       // TODO Add cache retry on next call
-      // Now we have something in _inplaceMemory.
-      // It may be an empty array or a filled one, never mind, we cache both
-      auto entry =
-          cache::CachedValue::construct(fromTo.data(),
-                                        static_cast<uint32_t>(fromTo.size()),
-                                        _builder.slice().start(),
-                                        static_cast<uint64_t>(_builder.slice().byteSize()));
-      if (entry) {
-        bool inserted = false;
-        for (size_t attempts = 0; attempts < 10; attempts++) {
-          auto status = cc->insert(entry);
-          if (status.ok()) {
-            inserted = true;
-            break;
-          }
-          if (status.errorNumber() != TRI_ERROR_LOCK_TIMEOUT) {
-            break;
-          }
-          cpu_relax();
-        }
-        if (!inserted) {
-          LOG_TOPIC("c1809", DEBUG, arangodb::Logger::CACHE)
-              << "Failed to cache: " << fromTo.toString();
-          delete entry;
-        }
+      // It may be an empty list or a filled one, never mind, we cache both
+      if (!_encoder.store(cc, fromTo)) {
+        LOG_TOPIC("c1809", DEBUG, arangodb::Logger::CACHE)
+            << "Failed to cache: " << fromTo.toString();
       }
     }
     TRI_ASSERT(_builder.slice().isArray());
@@ -371,10 +385,15 @@ class RocksDBEdgeIndexLookupIterator final : public IndexIterator {
   // the following 2 values are required for correct batch handling
   std::unique_ptr<rocksdb::Iterator> _iterator;  // iterator position in rocksdb
   RocksDBKeyBounds _bounds;
+  // used for iterate_upper_bound
+  rocksdb::Slice _upperBound;
   
   arangodb::velocypack::Builder _builder;
   arangodb::velocypack::ArrayIterator _builderIterator;
   arangodb::velocypack::Slice _lastKey;
+
+  RocksDBEdgeIndexCacheEncoder _encoder;
+  RocksDBEdgeIndexCacheDecoder _decoder;
 };
 
 }  // namespace arangodb
@@ -434,6 +453,7 @@ double RocksDBEdgeIndex::selectivityEstimate(arangodb::velocypack::StringRef con
   if (!attribute.empty() && attribute.compare(_directionAttr)) {
     return 0.0;
   }
+  loadEstimator();
   TRI_ASSERT(_estimator != nullptr);
   return _estimator->computeEstimate();
 }
@@ -678,12 +698,41 @@ void RocksDBEdgeIndex::warmup(transaction::Methods* trx,
   queue->enqueue(task4);
 }
 
+void RocksDBEdgeIndex::warmupCacheKeys(transaction::Methods* trx,
+                                       std::vector<std::string> const& keys) {
+  if (!useCache() || keys.empty()) {
+    return;
+  }
+
+  // lease builder, but immediately pass it to the unique_ptr so we don't leak
+  transaction::BuilderLeaser builder(trx);
+  std::unique_ptr<VPackBuilder> lookupKeys(builder.steal());
+  lookupKeys->openArray(/*unindexed*/true);
+  for (auto const& key : keys) {
+    if (RocksDBEdgeIndexCacheEntry::isChunkKey(arangodb::velocypack::StringRef(key))) {
+      // chunks are reloaded together with the first entry
+      continue;
+    }
+    lookupKeys->add(VPackValuePair(key.data(), key.size(), VPackValueType::String));
+  }
+  lookupKeys->close();
+
+  // the lookup iterator stores every vertex it has to read from RocksDB in
+  // the cache, so simply exhaust it
+  RocksDBEdgeIndexLookupIterator it(&_collection, trx, this, std::move(lookupKeys), _cache);
+  while (it.next([](LocalDocumentId const&) -> void {}, 1000)) {
+    if (application_features::ApplicationServer::isStopping()) {
+      return;
+    }
+  }
+}
+
 void RocksDBEdgeIndex::warmupInternal(transaction::Methods* trx, rocksdb::Slice const& lower,
                                       rocksdb::Slice const& upper) {
   auto rocksColl = toRocksDBCollection(_collection);
   bool needsInsert = false;
   std::string previous = "";
-  VPackBuilder builder;
+  RocksDBEdgeIndexCacheEncoder encoder;
 
   // intentional copy of the read options
   auto* mthds = RocksDBTransactionState::toMethods(trx);
@@ -711,7 +760,7 @@ void RocksDBEdgeIndex::warmupInternal(transaction::Methods* trx, rocksdb::Slice
     arangodb::velocypack::StringRef v = RocksDBKey::vertexId(key);
     if (previous.empty()) {
       // First call.
-      builder.clear();
+      encoder.clear();
       previous = v.toString();
       bool shouldTry = true;
       while (shouldTry) {
@@ -723,7 +772,6 @@ void RocksDBEdgeIndex::warmupInternal(transaction::Methods* trx, rocksdb::Slice
             finding.result().errorNumber() != TRI_ERROR_LOCK_TIMEOUT) {
           shouldTry = false;
           needsInsert = true;
-          builder.openArray(true);
         }
       }
     }
@@ -732,36 +780,13 @@ void RocksDBEdgeIndex::warmupInternal(transaction::Methods* trx, rocksdb::Slice
       if (needsInsert) {
         // Switch to next vertex id.
         // Store what we have.
-        builder.close();
-
         while (cc->isBusy()) {
           // We should wait here, the cache will reject
           // any inserts anyways.
           std::this_thread::sleep_for(std::chrono::microseconds(10000));
         }
 
-        auto entry =
-            cache::CachedValue::construct(previous.data(),
-                                          static_cast<uint32_t>(previous.size()),
-                                          builder.slice().start(),
-                                          static_cast<uint64_t>(builder.slice().byteSize()));
-        if (entry) {
-          bool inserted = false;
-          for (size_t attempts = 0; attempts < 10; attempts++) {
-            auto status = cc->insert(entry);
-            if (status.ok()) {
-              inserted = true;
-              break;
-            }
-            if (status.errorNumber() != TRI_ERROR_LOCK_TIMEOUT) {
-              break;
-            }
-          }
-          if (!inserted) {
-            delete entry;
-          }
-        }
-        builder.clear();
+        encoder.store(cc, arangodb::velocypack::StringRef(previous));
       }
       // Need to store
       previous = v.toString();
@@ -770,7 +795,6 @@ void RocksDBEdgeIndex::warmupInternal(transaction::Methods* trx, rocksdb::Slice
         needsInsert = false;
       } else {
         needsInsert = true;
-        builder.openArray(true);
       }
     }
     if (needsInsert) {
@@ -782,47 +806,33 @@ void RocksDBEdgeIndex::warmupInternal(transaction::Methods* trx, rocksdb::Slice
         continue;
       }
       
-      builder.add(VPackValue(docId.id()));
       VPackSlice doc(mdr.vpack());
       VPackSlice toFrom =
       _isFromIndex ? transaction::helpers::extractToFromDocument(doc)
                    : transaction::helpers::extractFromFromDocument(doc);
       TRI_ASSERT(toFrom.isString());
-      builder.add(toFrom);
+      encoder.add(docId, arangodb::velocypack::StringRef(toFrom));
     }
   }
 
   if (!previous.empty() && needsInsert) {
     // We still have something to store
-    builder.close();
-
-    auto entry =
-        cache::CachedValue::construct(previous.data(),
-                                      static_cast<uint32_t>(previous.size()),
-                                      builder.slice().start(),
-                                      static_cast<uint64_t>(builder.slice().byteSize()));
-    if (entry) {
-      bool inserted = false;
-      for (size_t attempts = 0; attempts < 10; attempts++) {
-        auto status = cc->insert(entry);
-        if (status.ok()) {
-          inserted = true;
-          break;
-        }
-        if (status.errorNumber() != TRI_ERROR_LOCK_TIMEOUT) {
-          break;
-        }
-      }
-      if (!inserted) {
-        delete entry;
-      }
-    }
+    encoder.store(cc, arangodb::velocypack::StringRef(previous));
   }
   LOG_TOPIC("99a29", DEBUG, Logger::ENGINES) << "loaded n: " << n;
 }
 
 // ===================== Helpers ==================
 
+/// @brief the cache for lookups of the transaction. reads as of an older
+/// timestamp bypass it, as it holds the current state
+std::shared_ptr<cache::Cache> RocksDBEdgeIndex::cacheFor(transaction::Methods* trx) const {
+  if (RocksDBTransactionState::toState(trx)->hasHistoricSnapshot()) {
+    return nullptr;
+  }
+  return _cache;
+}
+
 /// @brief create the iterator
 std::unique_ptr<IndexIterator> RocksDBEdgeIndex::createEqIterator(transaction::Methods* trx,
                                                                   arangodb::aql::AstNode const* attrNode,
@@ -832,7 +842,7 @@ std::unique_ptr<IndexIterator> RocksDBEdgeIndex::createEqIterator(transaction::M
   std::unique_ptr<VPackBuilder> keys(builder.steal());
 
   fillLookupValue(*(keys.get()), valNode);
-  return std::make_unique<RocksDBEdgeIndexLookupIterator>(&_collection, trx, this, std::move(keys), _cache);
+  return std::make_unique<RocksDBEdgeIndexLookupIterator>(&_collection, trx, this, std::move(keys), cacheFor(trx));
 }
 
 /// @brief create the iterator
@@ -844,7 +854,7 @@ std::unique_ptr<IndexIterator> RocksDBEdgeIndex::createInIterator(transaction::M
   std::unique_ptr<VPackBuilder> keys(builder.steal());
 
   fillInLookupValues(trx, *(keys.get()), valNode);
-  return std::make_unique<RocksDBEdgeIndexLookupIterator>(&_collection, trx, this, std::move(keys), _cache);
+  return std::make_unique<RocksDBEdgeIndexLookupIterator>(&_collection, trx, this, std::move(keys), cacheFor(trx));
 }
 
 void RocksDBEdgeIndex::fillLookupValue(VPackBuilder& keys,
@@ -895,12 +905,14 @@ void RocksDBEdgeIndex::handleValNode(VPackBuilder* keys,
 }
 
 void RocksDBEdgeIndex::afterTruncate(TRI_voc_tick_t tick) {
+  loadEstimator();
   TRI_ASSERT(_estimator != nullptr);
   _estimator->bufferTruncate(tick);
   RocksDBIndex::afterTruncate(tick);
 }
 
 RocksDBCuckooIndexEstimator<uint64_t>* RocksDBEdgeIndex::estimator() {
+  loadEstimator();
   return _estimator.get();
 }
 
@@ -109,6 +109,10 @@ class RocksDBEdgeIndex final : public RocksDBIndex {
   void warmup(arangodb::transaction::Methods* trx,
               std::shared_ptr<basics::LocalTaskQueue> queue) override;
 
+  /// @brief reload the cached edges of the given vertex ids
+  void warmupCacheKeys(transaction::Methods* trx,
+                       std::vector<std::string> const& keys) override;
+
   void afterTruncate(TRI_voc_tick_t tick) override;
 
   Result insert(transaction::Methods& trx, RocksDBMethods* methods,
@@ -127,6 +131,10 @@ class RocksDBEdgeIndex final : public RocksDBIndex {
   std::unique_ptr<IndexIterator> createInIterator(transaction::Methods*, arangodb::aql::AstNode const*,
                                                   arangodb::aql::AstNode const*) const;
 
+  /// @brief the cache for lookups of the transaction, nullptr if the
+  /// transaction must not use it
+  std::shared_ptr<cache::Cache> cacheFor(transaction::Methods*) const;
+
   /// @brief populate the keys builder with a single (string) lookup value
   void fillLookupValue(arangodb::velocypack::Builder& keys,
                        arangodb::aql::AstNode const* value) const;
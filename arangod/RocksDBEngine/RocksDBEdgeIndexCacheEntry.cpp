@@ -0,0 +1,302 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "RocksDBEdgeIndexCacheEntry.h"
+#include "Basics/cpu-relax.h"
+#include "Cache/Cache.h"
+#include "Cache/CachedValue.h"
+#include "VocBase/ticks.h"
+
+#include <cstring>
+
+using namespace arangodb;
+
+namespace {
+void appendVarint(std::string& out, uint64_t value) {
+  while (value >= 0x80) {
+    out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<char>(value));
+}
+
+bool readVarint(uint8_t const*& p, uint8_t const* end, uint64_t& value) {
+  value = 0;
+  unsigned shift = 0;
+  while (p < end && shift < 64) {
+    uint8_t b = *p++;
+    value |= static_cast<uint64_t>(b & 0x7f) << shift;
+    if ((b & 0x80) == 0) {
+      return true;
+    }
+    shift += 7;
+  }
+  return false;
+}
+
+inline uint64_t zigzagEncode(uint64_t delta) {
+  return (delta << 1) ^ (0 - (delta >> 63));
+}
+
+inline uint64_t zigzagDecode(uint64_t value) {
+  return (value >> 1) ^ (0 - (value & 1));
+}
+
+/// @brief append a VelocyPack string value
+void appendString(std::string& out, arangodb::velocypack::StringRef value) {
+  uint64_t size = value.size();
+  if (size <= 126) {
+    out.push_back(static_cast<char>(0x40 + size));
+  } else {
+    out.push_back(static_cast<char>(0xbf));
+    for (size_t i = 0; i < 8; ++i) {
+      out.push_back(static_cast<char>(size & 0xff));
+      size >>= 8;
+    }
+  }
+  out.append(value.data(), value.size());
+}
+}  // namespace
+
+constexpr size_t RocksDBEdgeIndexCacheEntry::edgesPerChunk;
+
+std::string RocksDBEdgeIndexCacheEntry::chunkKey(arangodb::velocypack::StringRef fromTo,
+                                                 uint64_t chunk) {
+  std::string key;
+  if (chunk == 0) {
+    key.assign(fromTo.data(), fromTo.size());
+  } else {
+    key.reserve(fromTo.size() + 4);
+    key.append(fromTo.data(), fromTo.size());
+    key.push_back('\0');
+    appendVarint(key, chunk);
+  }
+  return key;
+}
+
+RocksDBEdgeIndexCacheEncoder::RocksDBEdgeIndexCacheEncoder()
+    : _numEdges(0), _lastId(0) {}
+
+void RocksDBEdgeIndexCacheEncoder::clear() {
+  _chunks.clear();
+  _edges.clear();
+  _dictionary.clear();
+  _positions.clear();
+  _numEdges = 0;
+  _lastId = 0;
+}
+
+void RocksDBEdgeIndexCacheEncoder::add(LocalDocumentId const& documentId,
+                                       arangodb::velocypack::StringRef vertexId) {
+  if (_numEdges == RocksDBEdgeIndexCacheEntry::edgesPerChunk) {
+    finishChunk();
+  }
+
+  auto it = _positions.find(vertexId.toString());
+  uint64_t position;
+  if (it == _positions.end()) {
+    position = _positions.size();
+    _positions.emplace(vertexId.toString(), position);
+    appendString(_dictionary, vertexId);
+  } else {
+    position = it->second;
+  }
+
+  // consecutive ids of the same vertex are usually close to each other
+  appendVarint(_edges, zigzagEncode(documentId.id() - _lastId));
+  appendVarint(_edges, position);
+  _lastId = documentId.id();
+  ++_numEdges;
+}
+
+void RocksDBEdgeIndexCacheEncoder::finishChunk() {
+  std::string chunk;
+  chunk.reserve(_dictionary.size() + _edges.size() + 16);
+  appendVarint(chunk, _numEdges);
+  appendVarint(chunk, _positions.size());
+  chunk.append(_dictionary);
+  chunk.append(_edges);
+  _chunks.emplace_back(std::move(chunk));
+
+  _edges.clear();
+  _dictionary.clear();
+  _positions.clear();
+  _numEdges = 0;
+  _lastId = 0;
+}
+
+std::vector<std::string> RocksDBEdgeIndexCacheEncoder::finish() {
+  if (_numEdges > 0 || _chunks.empty()) {
+    // an empty set of edges is cached as well
+    finishChunk();
+  }
+
+  uint64_t const tag = TRI_NewTickServer();
+  std::vector<std::string> result;
+  result.reserve(_chunks.size());
+  for (size_t i = 0; i < _chunks.size(); ++i) {
+    std::string chunk;
+    chunk.reserve(_chunks[i].size() + sizeof(tag) + 8);
+    chunk.append(reinterpret_cast<char const*>(&tag), sizeof(tag));
+    appendVarint(chunk, i);
+    appendVarint(chunk, _chunks.size());
+    chunk.append(_chunks[i]);
+    result.emplace_back(std::move(chunk));
+  }
+  clear();
+  return result;
+}
+
+bool RocksDBEdgeIndexCacheEncoder::store(cache::Cache* cache,
+                                         arangodb::velocypack::StringRef fromTo) {
+  TRI_ASSERT(cache != nullptr);
+  std::vector<std::string> chunks = finish();
+
+  for (size_t i = chunks.size(); i > 0; --i) {
+    std::string key = RocksDBEdgeIndexCacheEntry::chunkKey(fromTo, i - 1);
+    auto entry = cache::CachedValue::construct(key.data(), key.size(),
+                                               chunks[i - 1].data(),
+                                               chunks[i - 1].size());
+    if (entry == nullptr) {
+      return false;
+    }
+    bool inserted = false;
+    for (size_t attempts = 0; attempts < 10; attempts++) {
+      auto status = cache->insert(entry);
+      if (status.ok()) {
+        inserted = true;
+        break;
+      }
+      if (status.errorNumber() != TRI_ERROR_LOCK_TIMEOUT) {
+        break;
+      }
+      basics::cpu_relax();
+    }
+    if (!inserted) {
+      // without this chunk the previous ones are useless
+      delete entry;
+      return false;
+    }
+  }
+  return true;
+}
+
+RocksDBEdgeIndexCacheDecoder::RocksDBEdgeIndexCacheDecoder() { clear(); }
+
+void RocksDBEdgeIndexCacheDecoder::clear() {
+  _data.clear();
+  _dictionary.clear();
+  _position = nullptr;
+  _end = nullptr;
+  _tag = 0;
+  _chunk = 0;
+  _numChunks = 0;
+  _remaining = 0;
+  _returned = 0;
+  _lastId = 0;
+}
+
+bool RocksDBEdgeIndexCacheDecoder::start(uint8_t const* data, size_t size) {
+  _returned = 0;
+  if (!load(data, size) || _chunk != 0) {
+    clear();
+    return false;
+  }
+  return true;
+}
+
+bool RocksDBEdgeIndexCacheDecoder::append(uint8_t const* data, size_t size) {
+  uint64_t const tag = _tag;
+  uint64_t const chunk = _chunk + 1;
+  uint64_t const numChunks = _numChunks;
+  if (!load(data, size) || _tag != tag || _chunk != chunk || _numChunks != numChunks) {
+    // the chunk was written by a different fill of the cache
+    uint64_t const returned = _returned;
+    clear();
+    _returned = returned;
+    return false;
+  }
+  return true;
+}
+
+bool RocksDBEdgeIndexCacheDecoder::load(uint8_t const* data, size_t size) {
+  _dictionary.clear();
+  _remaining = 0;
+  _lastId = 0;
+  if (data == nullptr || size < sizeof(_tag)) {
+    return false;
+  }
+  _data.assign(reinterpret_cast<char const*>(data), size);
+
+  uint8_t const* p = reinterpret_cast<uint8_t const*>(_data.data());
+  uint8_t const* end = p + _data.size();
+  memcpy(&_tag, p, sizeof(_tag));
+  p += sizeof(_tag);
+
+  uint64_t numEdges;
+  uint64_t dictionarySize;
+  if (!readVarint(p, end, _chunk) || !readVarint(p, end, _numChunks) ||
+      !readVarint(p, end, numEdges) || !readVarint(p, end, dictionarySize) ||
+      dictionarySize > numEdges) {
+    return false;
+  }
+
+  _dictionary.reserve(dictionarySize);
+  for (uint64_t i = 0; i < dictionarySize; ++i) {
+    if (p >= end) {
+      return false;
+    }
+    arangodb::velocypack::Slice vertexId(p);
+    if (!vertexId.isString() || (*p == 0xbf && end - p < 9) ||
+        static_cast<uint64_t>(end - p) < vertexId.byteSize()) {
+      return false;
+    }
+    _dictionary.emplace_back(vertexId);
+    p += vertexId.byteSize();
+  }
+
+  _position = p;
+  _end = end;
+  _remaining = numEdges;
+  return true;
+}
+
+bool RocksDBEdgeIndexCacheDecoder::next(LocalDocumentId& documentId,
+                                        arangodb::velocypack::Slice& vertexId) {
+  if (_remaining == 0) {
+    return false;
+  }
+  uint64_t delta;
+  uint64_t position;
+  if (!readVarint(_position, _end, delta) || !readVarint(_position, _end, position) ||
+      position >= _dictionary.size()) {
+    // corrupted entries are not produced by the encoder
+    TRI_ASSERT(false);
+    _remaining = 0;
+    _numChunks = 0;
+    return false;
+  }
+  _lastId += zigzagDecode(delta);
+  documentId = LocalDocumentId(_lastId);
+  vertexId = _dictionary[position];
+  --_remaining;
+  ++_returned;
+  return true;
+}
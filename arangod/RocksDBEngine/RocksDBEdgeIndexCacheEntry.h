@@ -0,0 +1,153 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_ROCKSDB_ENGINE_ROCKSDB_EDGE_INDEX_CACHE_ENTRY_H
+#define ARANGOD_ROCKSDB_ENGINE_ROCKSDB_EDGE_INDEX_CACHE_ENTRY_H 1
+
+#include "Basics/Common.h"
+#include "VocBase/LocalDocumentId.h"
+
+#include <velocypack/Slice.h>
+#include <velocypack/StringRef.h>
+
+#include <unordered_map>
+
+namespace arangodb {
+namespace cache {
+class Cache;
+}
+
+/// @brief compressed representation of all edges of a single _from/_to
+/// value, as stored in the edge index cache.
+///
+/// The edges are split into chunks of at most edgesPerChunk edges, and each
+/// chunk is stored as a separate cache entry. The first chunk uses the
+/// _from/_to value as its cache key, all following chunks use the value
+/// followed by a NUL byte and the chunk number. Only the first chunk is
+/// invalidated by writes, so all chunks carry the tag of the first one and
+/// chunks with a different tag are treated as cache misses.
+///
+/// Every chunk has the following layout (all numbers are varints):
+///   - tag (8 bytes, not a varint), chunk number, number of chunks, number of
+///     edges
+///   - number of distinct vertex ids, followed by the vertex ids as
+///     VelocyPack strings
+///   - for every edge the zigzag-encoded difference of its LocalDocumentId to
+///     the one of the previous edge, and the position of its other vertex id
+///     in the chunk's dictionary
+struct RocksDBEdgeIndexCacheEntry {
+  /// @brief maximum number of edges per cache entry
+  static constexpr size_t edgesPerChunk = 1024;
+
+  /// @brief cache key of the chunk with the given number
+  static std::string chunkKey(arangodb::velocypack::StringRef fromTo, uint64_t chunk);
+
+  /// @brief whether or not the cache key belongs to a chunk other than the
+  /// first one
+  static bool isChunkKey(arangodb::velocypack::StringRef key) {
+    return memchr(key.data(), '\0', key.size()) != nullptr;
+  }
+};
+
+/// @brief builds the cache entries for one _from/_to value
+class RocksDBEdgeIndexCacheEncoder {
+ public:
+  RocksDBEdgeIndexCacheEncoder();
+
+  /// @brief forget everything added so far
+  void clear();
+
+  /// @brief add an edge. edges must be added in index order
+  void add(LocalDocumentId const& documentId, arangodb::velocypack::StringRef vertexId);
+
+  /// @brief serialize all edges added so far, chunk 0 first
+  std::vector<std::string> finish();
+
+  /// @brief serialize all edges added so far and insert them into the
+  /// cache. the first chunk is inserted last, so that readers never see it
+  /// before the remaining chunks are present. returns true if all chunks
+  /// were inserted
+  bool store(cache::Cache* cache, arangodb::velocypack::StringRef fromTo);
+
+ private:
+  void finishChunk();
+
+ private:
+  std::vector<std::string> _chunks;
+  std::string _edges;
+  std::string _dictionary;
+  std::unordered_map<std::string, uint64_t> _positions;
+  uint64_t _numEdges;
+  LocalDocumentId::BaseType _lastId;
+};
+
+/// @brief iterates over the edges of the cache entries of one _from/_to
+/// value, decoding a single chunk at a time
+class RocksDBEdgeIndexCacheDecoder {
+ public:
+  RocksDBEdgeIndexCacheDecoder();
+
+  /// @brief reset to the empty state
+  void clear();
+
+  /// @brief start decoding with the first chunk. returns false if the data
+  /// is not a valid first chunk
+  bool start(uint8_t const* data, size_t size);
+
+  /// @brief continue decoding with the next chunk. returns false if the
+  /// data does not belong to the current set of chunks
+  bool append(uint8_t const* data, size_t size);
+
+  /// @brief return the next edge of the current chunk. the vertex id remains
+  /// valid until the next chunk is loaded. returns false if the current
+  /// chunk is exhausted
+  bool next(LocalDocumentId& documentId, arangodb::velocypack::Slice& vertexId);
+
+  /// @brief whether or not the current chunk has unreturned edges
+  bool hasEdges() const { return _remaining > 0; }
+
+  /// @brief whether or not there are chunks left that need to be loaded
+  bool needsChunk() const { return _remaining == 0 && _chunk + 1 < _numChunks; }
+
+  /// @brief number of the chunk that needs to be loaded next
+  uint64_t nextChunk() const { return _chunk + 1; }
+
+  /// @brief number of edges returned since start()
+  uint64_t returned() const { return _returned; }
+
+ private:
+  bool load(uint8_t const* data, size_t size);
+
+ private:
+  std::string _data;
+  std::vector<arangodb::velocypack::Slice> _dictionary;
+  uint8_t const* _position;
+  uint8_t const* _end;
+  uint64_t _tag;
+  uint64_t _chunk;
+  uint64_t _numChunks;
+  uint64_t _remaining;
+  uint64_t _returned;
+  LocalDocumentId::BaseType _lastId;
+};
+
+}  // namespace arangodb
+
+#endif
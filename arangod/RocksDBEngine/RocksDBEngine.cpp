@@ -31,6 +31,7 @@
 #include "Basics/Result.h"
 #include "Basics/RocksDBLogger.h"
 #include "Basics/StaticStrings.h"
+#include "Basics/StringUtils.h"
 #include "Basics/Thread.h"
 #include "Basics/VelocyPackHelper.h"
 #include "Basics/WriteLocker.h"
@@ -49,10 +50,13 @@
 #include "RestServer/ServerIdFeature.h"
 #include "RocksDBEngine/RocksDBBackgroundErrorListener.h"
 #include "RocksDBEngine/RocksDBBackgroundThread.h"
+#include "RocksDBEngine/RocksDBBlockCache.h"
+#include "RocksDBEngine/RocksDBCacheSnapshotManager.h"
 #include "RocksDBEngine/RocksDBCollection.h"
 #include "RocksDBEngine/RocksDBColumnFamily.h"
 #include "RocksDBEngine/RocksDBCommon.h"
 #include "RocksDBEngine/RocksDBComparator.h"
+#include "RocksDBEngine/RocksDBFilterPolicy.h"
 #include "RocksDBEngine/RocksDBIncrementalSync.h"
 #include "RocksDBEngine/RocksDBIndex.h"
 #include "RocksDBEngine/RocksDBIndexFactory.h"
@@ -65,6 +69,7 @@
 #include "RocksDBEngine/RocksDBReplicationTailing.h"
 #include "RocksDBEngine/RocksDBRestHandlers.h"
 #include "RocksDBEngine/RocksDBSettingsManager.h"
+#include "RocksDBEngine/RocksDBSnapshotThread.h"
 #include "RocksDBEngine/RocksDBSyncThread.h"
 #include "RocksDBEngine/RocksDBThrottle.h"
 #include "RocksDBEngine/RocksDBTransactionCollection.h"
@@ -91,9 +96,11 @@
 #include <rocksdb/slice_transform.h>
 #include <rocksdb/statistics.h>
 #include <rocksdb/table.h>
+#include <rocksdb/table_properties.h>
 #include <rocksdb/transaction_log.h>
 #include <rocksdb/utilities/transaction_db.h>
 #include <rocksdb/write_batch.h>
+#include <rocksdb/write_buffer_manager.h>
 
 #include <velocypack/Iterator.h>
 #include <velocypack/velocypack-aliases.h>
@@ -118,6 +125,33 @@ rocksdb::ColumnFamilyHandle* RocksDBColumnFamily::_vpack(nullptr);
 rocksdb::ColumnFamilyHandle* RocksDBColumnFamily::_geo(nullptr);
 rocksdb::ColumnFamilyHandle* RocksDBColumnFamily::_fulltext(nullptr);
 std::vector<rocksdb::ColumnFamilyHandle*> RocksDBColumnFamily::_allHandles;
+basics::ReadWriteLock RocksDBColumnFamily::_dedicatedLock;
+std::unordered_map<uint64_t, rocksdb::ColumnFamilyHandle*> RocksDBColumnFamily::_dedicatedDocuments;
+std::unordered_set<uint32_t> RocksDBColumnFamily::_dedicatedIds;
+std::atomic<bool> RocksDBColumnFamily::_hasDedicated(false);
+std::vector<rocksdb::ColumnFamilyHandle*> RocksDBColumnFamily::_droppedHandles;
+
+rocksdb::ColumnFamilyHandle* RocksDBColumnFamily::documents(uint64_t objectId) {
+  if (_hasDedicated.load(std::memory_order_acquire)) {
+    READ_LOCKER(guard, _dedicatedLock);
+    auto it = _dedicatedDocuments.find(objectId);
+    if (it != _dedicatedDocuments.end()) {
+      return (*it).second;
+    }
+  }
+  return _documents;
+}
+
+bool RocksDBColumnFamily::isDocuments(uint32_t cfId) {
+  if (cfId == _documents->GetID()) {
+    return true;
+  }
+  if (!_hasDedicated.load(std::memory_order_acquire)) {
+    return false;
+  }
+  READ_LOCKER(guard, _dedicatedLock);
+  return _dedicatedIds.find(cfId) != _dedicatedIds.end();
+}
 
 // minimum value for --rocksdb.sync-interval (in ms)
 // a value of 0 however means turning off the syncing altogether!
@@ -181,6 +215,7 @@ RocksDBEngine::RocksDBEngine(application_features::ApplicationServer& server)
       _pruneWaitTime(10.0),
       _pruneWaitTimeInitial(180.0),
       _maxWalArchiveSizeLimit(0),
+      _cacheSnapshotInterval(0.0),
       _releasedTick(0),
 #ifdef _WIN32
       // background syncing is not supported on Windows
@@ -189,6 +224,14 @@ RocksDBEngine::RocksDBEngine(application_features::ApplicationServer& server)
       _syncInterval(100),
 #endif
       _useThrottle(true),
+      _adaptiveIntermediateCommits(true),
+      _allowBulkLoad(false),
+      _indexBuildThreads(static_cast<uint32_t>(
+          std::max(static_cast<size_t>(1),
+                   std::min(static_cast<size_t>(4), TRI_numberProcessors() / 2)))),
+      _recoveryThreads(static_cast<uint32_t>(
+          std::max(static_cast<size_t>(1),
+                   std::min(static_cast<size_t>(8), TRI_numberProcessors() / 2)))),
       _useReleasedTick(false),
       _debugLogging(false) {
 
@@ -217,6 +260,18 @@ void RocksDBEngine::shutdownRocksDBInstance() noexcept {
   for (rocksdb::ColumnFamilyHandle* h : RocksDBColumnFamily::_allHandles) {
     _db->DestroyColumnFamilyHandle(h);
   }
+  {
+    WRITE_LOCKER(guard, RocksDBColumnFamily::_dedicatedLock);
+    for (auto const& it : RocksDBColumnFamily::_dedicatedDocuments) {
+      _db->DestroyColumnFamilyHandle(it.second);
+    }
+    for (rocksdb::ColumnFamilyHandle* h : RocksDBColumnFamily::_droppedHandles) {
+      _db->DestroyColumnFamilyHandle(h);
+    }
+    RocksDBColumnFamily::_dedicatedDocuments.clear();
+    RocksDBColumnFamily::_dedicatedIds.clear();
+    RocksDBColumnFamily::_droppedHandles.clear();
+  }
 
   // now prune all obsolete WAL files
   try {
@@ -291,9 +346,40 @@ void RocksDBEngine::collectOptions(std::shared_ptr<options::ProgramOptions> opti
       new DoubleParameter(&_pruneWaitTimeInitial),
       arangodb::options::makeFlags(arangodb::options::Flags::Hidden));
 
+  options->addOption("--rocksdb.cache-snapshot-interval",
+                     "interval (in seconds) for persisting the hot keys of the "
+                     "edge and primary index caches, which are used to warm up "
+                     "these caches after a restart (0 = turned off)",
+                     new DoubleParameter(&_cacheSnapshotInterval));
+
   options->addOption("--rocksdb.throttle", "enable write-throttling",
                      new BooleanParameter(&_useThrottle));
 
+  options->addOption("--rocksdb.adaptive-intermediate-commits",
+                     "lower the size of automatic intermediate commits while "
+                     "flushes and compactions are behind (requires "
+                     "--rocksdb.throttle)",
+                     new BooleanParameter(&_adaptiveIntermediateCommits));
+
+  options->addOption("--rocksdb.allow-bulk-load",
+                     "commit imports and restores that request a bulk load "
+                     "by ingesting SST files. such data is not written to the "
+                     "WAL and is lost for WAL tailing clients, so bulk loads "
+                     "fall back to regular commits while replication clients "
+                     "are registered",
+                     new BooleanParameter(&_allowBulkLoad));
+
+  options->addOption("--rocksdb.index-build-threads",
+                     "number of threads used to fill a new non-unique "
+                     "hash, skiplist or persistent index (1 = single-threaded)",
+                     new UInt32Parameter(&_indexBuildThreads));
+
+  options->addOption("--rocksdb.recovery-threads",
+                     "number of threads that apply the WAL to counts, index "
+                     "estimates and arangosearch links on startup "
+                     "(1 = single-threaded)",
+                     new UInt32Parameter(&_recoveryThreads));
+
   options->addOption("--rocksdb.debug-logging",
                      "true to enable rocksdb debug logging",
                      new BooleanParameter(&_debugLogging),
@@ -339,6 +425,14 @@ void RocksDBEngine::validateOptions(std::shared_ptr<options::ProgramOptions> opt
            "--rocksdb.wal-file-timeout-initial. "
         << "Replication clients might have trouble to get in sync";
   }
+
+  if (_indexBuildThreads == 0) {
+    _indexBuildThreads = 1;
+  }
+
+  if (_recoveryThreads == 0) {
+    _recoveryThreads = 1;
+  }
 }
 
 // preparation phase for storage engine. can be used for internal setup.
@@ -509,14 +603,31 @@ void RocksDBEngine::start() {
   }
 
   rocksdb::BlockBasedTableOptions tableOptions;
+  _indexBlockCache.reset();
   if (opts->_blockCacheSize > 0) {
     tableOptions.block_cache =
         rocksdb::NewLRUCache(opts->_blockCacheSize,
                              static_cast<int>(opts->_blockCacheShardBits),
-                             /*strict_capacity_limit*/ opts->_enforceBlockCacheSizeLimit);
-    // tableOptions.cache_index_and_filter_blocks =
-    // tableOptions.pin_l0_filter_and_index_blocks_in_cache
-    // opts->_compactionReadaheadSize > 0;
+                             /*strict_capacity_limit*/ opts->_enforceBlockCacheSizeLimit,
+                             opts->_blockCacheHighPriorityPoolRatio);
+    if (opts->_indexBlockCacheSize > 0) {
+      // index column families get a cache of their own, so that large
+      // document scans cannot evict the blocks needed for point lookups
+      _indexBlockCache =
+          rocksdb::NewLRUCache(opts->_indexBlockCacheSize,
+                               static_cast<int>(opts->_blockCacheShardBits),
+                               /*strict_capacity_limit*/ opts->_enforceBlockCacheSizeLimit,
+                               opts->_blockCacheHighPriorityPoolRatio);
+    }
+    // index and filter blocks compete with data blocks for the cache, but
+    // are evicted last. with a high priority pool, they are inserted into
+    // a reserved part of the cache
+    tableOptions.cache_index_and_filter_blocks = opts->_cacheIndexAndFilterBlocks;
+    tableOptions.cache_index_and_filter_blocks_with_high_priority =
+        opts->_cacheIndexAndFilterBlocks;
+    tableOptions.pin_l0_filter_and_index_blocks_in_cache =
+        opts->_pinl0FilterAndIndexBlocksInCache;
+    tableOptions.pin_top_level_index_and_filter = opts->_pinTopLevelIndexAndFilter;
   } else {
     tableOptions.no_block_cache = true;
   }
@@ -558,6 +669,13 @@ void RocksDBEngine::start() {
 
   if (opts->_totalWriteBufferSize > 0) {
     _options.db_write_buffer_size = opts->_totalWriteBufferSize;
+    if (opts->_chargeWriteBuffersToBlockCache && tableOptions.block_cache != nullptr) {
+      // memtables reserve their memory in the block cache, so both share
+      // one budget
+      _options.write_buffer_manager =
+          std::make_shared<rocksdb::WriteBufferManager>(opts->_totalWriteBufferSize,
+                                                        tableOptions.block_cache);
+    }
   }
 
   // this is cfFamilies.size() + 2 ... but _option needs to be set before
@@ -567,24 +685,78 @@ void RocksDBEngine::start() {
   // cf options for definitons (dbs, collections, views, ...)
   rocksdb::ColumnFamilyOptions definitionsCF(_options);
 
+  // every column family with a bloom filter gets its own filter policy
+  // instance, so we can tell how useful the filter is for it
+  _filterPolicies.clear();
+  // likewise, every column family accesses the block cache through its own
+  // counting wrapper. all but the documents column family use the index
+  // block cache if there is one
+  _blockCaches.clear();
+  auto useBlockCache = [this](std::string const& name, rocksdb::BlockBasedTableOptions& tblo) {
+    if (tblo.block_cache == nullptr) {
+      return;
+    }
+    std::shared_ptr<rocksdb::Cache> cache = tblo.block_cache;
+    if (_indexBlockCache != nullptr && name != "documents") {
+      cache = _indexBlockCache;
+    }
+    auto wrapper = std::make_shared<RocksDBBlockCache>(std::move(cache));
+    _blockCaches.emplace(name, wrapper);
+    tblo.block_cache = wrapper;
+  };
+  auto tableFactory = [this, &useBlockCache](std::string const& name,
+                                             rocksdb::BlockBasedTableOptions tblo,
+                                             bool blockBasedFilter) {
+    auto policy = std::make_shared<RocksDBFilterPolicy>(10, blockBasedFilter);
+    _filterPolicies.emplace(name, policy);
+    tblo.filter_policy = policy;
+    useBlockCache(name, tblo);
+    return std::shared_ptr<rocksdb::TableFactory>(rocksdb::NewBlockBasedTableFactory(tblo));
+  };
+
   // cf options with fixed 8 byte object id prefix for documents
   rocksdb::ColumnFamilyOptions fixedPrefCF(_options);
   fixedPrefCF.prefix_extractor = std::shared_ptr<rocksdb::SliceTransform const>(
       rocksdb::NewFixedPrefixTransform(RocksDBKey::objectIdSize()));
 
+  rocksdb::ColumnFamilyOptions documentsCF(fixedPrefCF);
+  documentsCF.table_factory = tableFactory("documents", tableOptions, true);
+  rocksdb::ColumnFamilyOptions geoCF(fixedPrefCF);
+  geoCF.table_factory = tableFactory("geo", tableOptions, true);
+  rocksdb::ColumnFamilyOptions fulltextCF(fixedPrefCF);
+  fulltextCF.table_factory = tableFactory("fulltext", tableOptions, true);
+
+  // primary index lookups are point gets, so use a whole-key bloom filter
+  // in the full filter format. this can optionally be partitioned, so that
+  // only the top-level index needs to stay in memory
+  rocksdb::ColumnFamilyOptions primaryCF(fixedPrefCF);
+  {
+    rocksdb::BlockBasedTableOptions tblo(tableOptions);
+    tblo.whole_key_filtering = true;
+    if (opts->_partitionFilters) {
+      tblo.index_type = rocksdb::BlockBasedTableOptions::IndexType::kTwoLevelIndexSearch;
+      tblo.partition_filters = true;
+    }
+    primaryCF.table_factory = tableFactory("primary", tblo, false);
+  }
+
   // construct column family options with prefix containing indexed value
   rocksdb::ColumnFamilyOptions dynamicPrefCF(_options);
   dynamicPrefCF.prefix_extractor = std::make_shared<RocksDBPrefixExtractor>();
-  // also use hash-search based SST file format
-  rocksdb::BlockBasedTableOptions tblo(tableOptions);
-  tblo.index_type = rocksdb::BlockBasedTableOptions::IndexType::kHashSearch;
-  dynamicPrefCF.table_factory =
-      std::shared_ptr<rocksdb::TableFactory>(rocksdb::NewBlockBasedTableFactory(tblo));
+  {
+    // also use hash-search based SST file format. edge lookups are prefix
+    // seeks only, so the filter only needs to contain the prefixes
+    rocksdb::BlockBasedTableOptions tblo(tableOptions);
+    tblo.index_type = rocksdb::BlockBasedTableOptions::IndexType::kHashSearch;
+    tblo.whole_key_filtering = false;
+    dynamicPrefCF.table_factory = tableFactory("edge", tblo, false);
+  }
 
   // velocypack based index variants with custom comparator
   rocksdb::ColumnFamilyOptions vpackFixedPrefCF(fixedPrefCF);
   rocksdb::BlockBasedTableOptions tblo2(tableOptions);
   tblo2.filter_policy.reset();  // intentionally no bloom filter here
+  useBlockCache("vpack", tblo2);
   vpackFixedPrefCF.table_factory =
       std::shared_ptr<rocksdb::TableFactory>(rocksdb::NewBlockBasedTableFactory(tblo2));
   vpackFixedPrefCF.comparator = _vpackCmp.get();
@@ -594,15 +766,23 @@ void RocksDBEngine::start() {
   // no prefix families for default column family (Has to be there)
   cfFamilies.emplace_back(rocksdb::kDefaultColumnFamilyName,
                           definitionsCF);                   // 0
-  cfFamilies.emplace_back("Documents", fixedPrefCF);        // 1
-  cfFamilies.emplace_back("PrimaryIndex", fixedPrefCF);     // 2
+  cfFamilies.emplace_back("Documents", documentsCF);        // 1
+  cfFamilies.emplace_back("PrimaryIndex", primaryCF);       // 2
   cfFamilies.emplace_back("EdgeIndex", dynamicPrefCF);      // 3
   cfFamilies.emplace_back("VPackIndex", vpackFixedPrefCF);  // 4
-  cfFamilies.emplace_back("GeoIndex", fixedPrefCF);         // 5
-  cfFamilies.emplace_back("FulltextIndex", fixedPrefCF);    // 6
+  cfFamilies.emplace_back("GeoIndex", geoCF);               // 5
+  cfFamilies.emplace_back("FulltextIndex", fulltextCF);     // 6
   // DO NOT FORGET TO DESTROY THE CFs ON CLOSE
   //  Update max_write_buffer_number above if you change number of families used
 
+  // dedicated documents column families use the same settings as the
+  // shared one
+  _dedicatedDocumentsOptions = documentsCF;
+  _dedicatedUniversalDocumentsOptions = documentsCF;
+  _dedicatedUniversalDocumentsOptions.compaction_style = rocksdb::kCompactionStyleUniversal;
+  _dedicatedUniversalDocumentsOptions.compaction_options_universal.allow_trivial_move = true;
+  size_t const numberOfStaticColumnFamilies = cfFamilies.size();
+
   std::vector<rocksdb::ColumnFamilyHandle*> cfHandles;
   size_t const numberOfColumnFamilies = RocksDBColumnFamily::minNumberOfColumnFamilies;
   bool dbExisted = false;
@@ -655,6 +835,17 @@ void RocksDBEngine::start() {
         }
       }
 
+      // all dedicated documents column families must be opened, too
+      for (auto const& it : existingColumnFamilies) {
+        if (it.compare(0, strlen(RocksDBColumnFamily::dedicatedDocumentsPrefix),
+                       RocksDBColumnFamily::dedicatedDocumentsPrefix) == 0) {
+          cfFamilies.emplace_back(it, _dedicatedDocumentsOptions);
+        } else if (it.compare(0, strlen(RocksDBColumnFamily::dedicatedUniversalDocumentsPrefix),
+                              RocksDBColumnFamily::dedicatedUniversalDocumentsPrefix) == 0) {
+          cfFamilies.emplace_back(it, _dedicatedUniversalDocumentsOptions);
+        }
+      }
+
       if (existingColumnFamilies.size() < numberOfColumnFamilies) {
         LOG_TOPIC("e99ec", FATAL, arangodb::Logger::STARTUP)
             << "unexpected number of column families found in database ("
@@ -710,9 +901,25 @@ void RocksDBEngine::start() {
   RocksDBColumnFamily::_vpack = cfHandles[4];
   RocksDBColumnFamily::_geo = cfHandles[5];
   RocksDBColumnFamily::_fulltext = cfHandles[6];
-  RocksDBColumnFamily::_allHandles = cfHandles;
+  RocksDBColumnFamily::_allHandles.assign(cfHandles.begin(),
+                                          cfHandles.begin() + numberOfStaticColumnFamilies);
   TRI_ASSERT(RocksDBColumnFamily::_definitions->GetID() == 0);
 
+  // register the dedicated documents column families
+  {
+    WRITE_LOCKER(guard, RocksDBColumnFamily::_dedicatedLock);
+    for (size_t i = numberOfStaticColumnFamilies; i < cfHandles.size(); ++i) {
+      // the object id follows the first '-' in the name
+      std::string const& name = cfHandles[i]->GetName();
+      uint64_t objectId = basics::StringUtils::uint64(name.substr(name.find('-') + 1));
+      RocksDBColumnFamily::_dedicatedDocuments.emplace(objectId, cfHandles[i]);
+      RocksDBColumnFamily::_dedicatedIds.emplace(cfHandles[i]->GetID());
+    }
+    if (!RocksDBColumnFamily::_dedicatedDocuments.empty()) {
+      RocksDBColumnFamily::_hasDedicated.store(true, std::memory_order_release);
+    }
+  }
+
   // will crash the process if version does not match
   arangodb::rocksdbStartupVersionCheck(_db, dbExisted);
 
@@ -743,12 +950,34 @@ void RocksDBEngine::start() {
     }
   }
 
+  if (arangodb::ServerState::instance()->isDBServer()) {
+    // keep snapshots for reads of cluster queries as of a coordinator-chosen
+    // timestamp. they pin old versions of the data, so they expire quickly
+    _snapshotThread.reset(new RocksDBSnapshotThread(_db->GetBaseDB(), std::chrono::seconds(5)));
+    if (!_snapshotThread->start()) {
+      LOG_TOPIC("9794a", FATAL, Logger::ENGINES)
+          << "could not start rocksdb snapshot thread";
+      FATAL_ERROR_EXIT();
+    }
+  }
+
   TRI_ASSERT(_db != nullptr);
   _settingsManager.reset(new RocksDBSettingsManager(_db));
   _replicationManager.reset(new RocksDBReplicationManager());
 
   _settingsManager->retrieveInitialValues();
 
+  // remove leftovers of ingestions interrupted by a shutdown or crash
+  if (basics::FileUtils::isDirectory(ingestionPath())) {
+    TRI_RemoveDirectory(ingestionPath().c_str());
+  }
+
+  if (_cacheSnapshotInterval > 0.0 && CacheManagerFeature::MANAGER != nullptr) {
+    _cacheSnapshotManager.reset(new RocksDBCacheSnapshotManager(
+        this, basics::FileUtils::buildFilename(_basePath, "cache-snapshots"),
+        _cacheSnapshotInterval));
+  }
+
   double const counterSyncSeconds = 2.5;
   _backgroundThread.reset(new RocksDBBackgroundThread(this, counterSyncSeconds));
   if (!_backgroundThread->start()) {
@@ -803,6 +1032,16 @@ void RocksDBEngine::stop() {
     }
     _syncThread.reset();
   }
+
+  if (_snapshotThread) {
+    _snapshotThread->beginShutdown();
+
+    // wait until snapshot thread stops
+    while (_snapshotThread->isRunning()) {
+      std::this_thread::yield();
+    }
+    _snapshotThread.reset();
+  }
 }
 
 void RocksDBEngine::unprepare() {
@@ -836,6 +1075,9 @@ void RocksDBEngine::addParametersForNewCollection(VPackBuilder& builder, VPackSl
   if (!info.hasKey("cacheEnabled") || !info.get("cacheEnabled").isBool()) {
     builder.add("cacheEnabled", VPackValue(false));
   }
+  if (!info.hasKey("dedicatedColumnFamily") || !info.get("dedicatedColumnFamily").isBool()) {
+    builder.add("dedicatedColumnFamily", VPackValue(false));
+  }
 }
 
 // create storage-engine specific collection
@@ -1207,19 +1449,28 @@ std::string RocksDBEngine::createCollection(TRI_vocbase_t& vocbase,
                                                /*translateCid*/ true, /*forPersist*/ true);
   TRI_UpdateTickServer(static_cast<TRI_voc_tick_t>(cid));
 
+  auto* rcoll = toRocksDBCollection(collection.getPhysical());
+
+  // the column family must exist before the collection becomes visible
+  if (rcoll->hasDedicatedColumnFamily()) {
+    Result r = createDedicatedColumnFamily(rcoll->objectId(), rcoll->useUniversalCompaction());
+    if (r.fail()) {
+      THROW_ARANGO_EXCEPTION(r);
+    }
+  }
+
   int res =
       writeCreateCollectionMarker(vocbase.id(), cid, builder.slice(),
                                   RocksDBLogValue::CollectionCreate(vocbase.id(), cid));
 
   if (res != TRI_ERROR_NO_ERROR) {
+    if (rcoll->hasDedicatedColumnFamily()) {
+      dropDedicatedColumnFamily(rcoll->objectId());
+    }
     THROW_ARANGO_EXCEPTION(res);
   }
 
-#ifdef ARANGODB_ENABLE_MAINTAINER_MODE
-  auto* rcoll = toRocksDBCollection(collection.getPhysical());
-
   TRI_ASSERT(rcoll->numberDocuments() == 0);
-#endif
 
   return std::string();  // no need to return a path
 }
@@ -1316,7 +1567,17 @@ arangodb::Result RocksDBEngine::dropCollection(TRI_vocbase_t& vocbase,
     }
   }
 
-  // delete documents
+  // delete documents. if the collection has its own column family, we can
+  // simply drop it and are done
+  if (coll->hasDedicatedColumnFamily()) {
+    res = dropDedicatedColumnFamily(coll->objectId());
+    if (res.fail()) {
+      LOG_TOPIC("5c0b7", ERR, Logger::ENGINES)
+          << "unable to drop column family: " << res.errorMessage();
+    }
+    return Result();
+  }
+
   RocksDBKeyBounds bounds = RocksDBKeyBounds::CollectionDocuments(coll->objectId());
   auto result = rocksutils::removeLargeRange(db, bounds, prefixSameAsStart, useRangeDelete);
 
@@ -1529,6 +1790,55 @@ void RocksDBEngine::addRestHandlers(rest::RestHandlerFactory& handlerFactory) {
   RocksDBRestHandlers::registerResources(&handlerFactory);
 }
 
+Result RocksDBEngine::createDedicatedColumnFamily(uint64_t objectId, bool universalCompaction) {
+  std::string name(universalCompaction ? RocksDBColumnFamily::dedicatedUniversalDocumentsPrefix
+                                       : RocksDBColumnFamily::dedicatedDocumentsPrefix);
+  name.append(std::to_string(objectId));
+
+  rocksdb::ColumnFamilyHandle* handle = nullptr;
+  rocksdb::Status s = _db->CreateColumnFamily(
+      universalCompaction ? _dedicatedUniversalDocumentsOptions : _dedicatedDocumentsOptions,
+      name, &handle);
+  if (!s.ok()) {
+    return rocksutils::convertStatus(s);
+  }
+  TRI_ASSERT(handle != nullptr);
+
+  LOG_TOPIC("0a5d1", DEBUG, Logger::ENGINES) << "created column family '" << name << "'";
+
+  WRITE_LOCKER(guard, RocksDBColumnFamily::_dedicatedLock);
+  RocksDBColumnFamily::_dedicatedDocuments.emplace(objectId, handle);
+  RocksDBColumnFamily::_dedicatedIds.emplace(handle->GetID());
+  RocksDBColumnFamily::_hasDedicated.store(true, std::memory_order_release);
+  return Result();
+}
+
+Result RocksDBEngine::dropDedicatedColumnFamily(uint64_t objectId) {
+  rocksdb::ColumnFamilyHandle* handle = nullptr;
+  {
+    WRITE_LOCKER(guard, RocksDBColumnFamily::_dedicatedLock);
+    auto it = RocksDBColumnFamily::_dedicatedDocuments.find(objectId);
+    if (it == RocksDBColumnFamily::_dedicatedDocuments.end()) {
+      return Result();
+    }
+    handle = (*it).second;
+    RocksDBColumnFamily::_dedicatedDocuments.erase(it);
+    RocksDBColumnFamily::_dedicatedIds.erase(handle->GetID());
+    // the handle may still be used by iterators or snapshots of other
+    // threads, so it is only destroyed on shutdown
+    RocksDBColumnFamily::_droppedHandles.push_back(handle);
+  }
+
+  rocksdb::Status s = _db->DropColumnFamily(handle);
+  if (!s.ok()) {
+    return rocksutils::convertStatus(s);
+  }
+
+  LOG_TOPIC("0a5d2", DEBUG, Logger::ENGINES)
+      << "dropped column family '" << handle->GetName() << "'";
+  return Result();
+}
+
 void RocksDBEngine::addCollectionMapping(uint64_t objectId, TRI_voc_tick_t did,
                                          TRI_voc_cid_t cid) {
   if (objectId != 0) {
@@ -1894,7 +2204,13 @@ Result RocksDBEngine::dropDatabase(TRI_voc_tick_t id) {
 
     // delete documents
     RocksDBKeyBounds bounds = RocksDBKeyBounds::CollectionDocuments(objectId);
-    res = rocksutils::removeLargeRange(db, bounds, true, useRangeDelete);
+    bool const dedicated =
+        RocksDBColumnFamily::documents(objectId) != RocksDBColumnFamily::documents();
+    if (dedicated) {
+      res = dropDedicatedColumnFamily(objectId);
+    } else {
+      res = rocksutils::removeLargeRange(db, bounds, true, useRangeDelete);
+    }
     if (res.fail()) {
       LOG_TOPIC("6dbc6", WARN, Logger::ENGINES)
           << "error deleting collection documents: '" << res.errorMessage() << "'";
@@ -1918,7 +2234,9 @@ Result RocksDBEngine::dropDatabase(TRI_voc_tick_t id) {
 
 #ifdef ARANGODB_ENABLE_MAINTAINER_MODE
     // check if documents have been deleted
-    numDocsLeft += rocksutils::countKeyRange(db, bounds, true);
+    if (!dedicated) {
+      numDocsLeft += rocksutils::countKeyRange(db, bounds, true);
+    }
 #endif
   });
 
@@ -2074,6 +2392,31 @@ std::unique_ptr<TRI_vocbase_t> RocksDBEngine::openExistingDatabase(
   }
 }
 
+std::string RocksDBEngine::ingestionPath() const {
+  return basics::FileUtils::buildFilename(_path, "sst-ingest");
+}
+
+void RocksDBEngine::delayLowPriorityWrite(uint64_t bytes) const {
+  if (_listener != nullptr) {
+    _listener->DelayLowPriorityWrite(bytes);
+  }
+}
+
+uint64_t RocksDBEngine::intermediateCommitSize(uint64_t configured) const {
+  if (!_adaptiveIntermediateCommits || _listener == nullptr) {
+    return configured;
+  }
+  int64_t backlog = _listener->backlog();
+  if (backlog <= 0) {
+    return configured;
+  }
+  // halve the size for every unit of backlog, down to 1/16th, but never
+  // below 1MB unless that much was configured anyway
+  static constexpr uint64_t minSize = 1024 * 1024;
+  uint64_t adapted = configured >> std::min<int64_t>(backlog, 4);
+  return std::max(adapted, std::min(configured, minSize));
+}
+
 void RocksDBEngine::getStatistics(VPackBuilder& builder) const {
   // add int properties
   auto addInt = [&](std::string const& s) {
@@ -2114,6 +2457,32 @@ void RocksDBEngine::getStatistics(VPackBuilder& builder) const {
                                  rocksdb::DB::SizeApproximationFlags::INCLUDE_FILES));
 
     builder.add("memory", VPackValue(out));
+
+    auto it = _filterPolicies.find(name);
+    if (it != _filterPolicies.end()) {
+      builder.add("filter", VPackValue(VPackValueType::Object));
+      it->second->toVelocyPack(builder);
+      // sizes of the filter and index blocks of all live SST files
+      rocksdb::TablePropertiesCollection props;
+      if (_db->GetPropertiesOfAllTables(c, &props).ok()) {
+        uint64_t filterSize = 0;
+        uint64_t indexSize = 0;
+        for (auto const& p : props) {
+          filterSize += p.second->filter_size;
+          indexSize += p.second->index_size;
+        }
+        builder.add("filterSize", VPackValue(filterSize));
+        builder.add("indexSize", VPackValue(indexSize));
+      }
+      builder.close();
+    }
+
+    auto cache = _blockCaches.find(name);
+    if (cache != _blockCaches.end()) {
+      builder.add("blockCache", VPackValue(VPackValueType::Object));
+      cache->second->toVelocyPack(builder);
+      builder.close();
+    }
     builder.close();
   };
 
@@ -2152,6 +2521,14 @@ void RocksDBEngine::getStatistics(VPackBuilder& builder) const {
   addInt(rocksdb::DB::Properties::kBlockCacheCapacity);
   addInt(rocksdb::DB::Properties::kBlockCacheUsage);
   addInt(rocksdb::DB::Properties::kBlockCachePinnedUsage);
+  if (_indexBlockCache != nullptr) {
+    builder.add("rocksdb.index-block-cache-capacity",
+                VPackValue(_indexBlockCache->GetCapacity()));
+    builder.add("rocksdb.index-block-cache-usage",
+                VPackValue(_indexBlockCache->GetUsage()));
+    builder.add("rocksdb.index-block-cache-pinned-usage",
+                VPackValue(_indexBlockCache->GetPinnedUsage()));
+  }
   addInt(rocksdb::DB::Properties::kTotalSstFilesSize);
   addInt(rocksdb::DB::Properties::kActualDelayedWriteRate);
   addInt(rocksdb::DB::Properties::kIsWriteStopped);
@@ -2182,6 +2559,12 @@ void RocksDBEngine::getStatistics(VPackBuilder& builder) const {
     builder.add("cache.hit-rate-recent", VPackValue(0));
   }
 
+  if (_listener != nullptr) {
+    builder.add("throttle", VPackValue(VPackValueType::Object));
+    _listener->toVelocyPack(builder);
+    builder.close();
+  }
+
   // print column family statistics
   builder.add("columnFamilies", VPackValue(VPackValueType::Object));
   addCf("definitions", RocksDBColumnFamily::definitions());
@@ -51,11 +51,15 @@ namespace arangodb {
 class PhysicalCollection;
 class PhysicalView;
 class RocksDBBackgroundThread;
+class RocksDBBlockCache;
+class RocksDBCacheSnapshotManager;
+class RocksDBFilterPolicy;
 class RocksDBKey;
 class RocksDBLogValue;
 class RocksDBRecoveryHelper;
 class RocksDBReplicationManager;
 class RocksDBSettingsManager;
+class RocksDBSnapshotThread;
 class RocksDBSyncThread;
 class RocksDBThrottle;  // breaks tons if RocksDBThrottle.h included here
 class RocksDBVPackComparator;
@@ -147,6 +151,7 @@ class RocksDBEngine final : public StorageEngine {
   double minimumSyncReplicationTimeout() const override { return 1.0; }
 
   bool supportsDfdb() const override { return false; }
+  bool allowsBulkLoad() const override { return _allowBulkLoad; }
   bool useRawDocumentPointers() override { return false; }
 
   std::unique_ptr<transaction::Manager> createTransactionManager() override;
@@ -303,6 +308,13 @@ class RocksDBEngine final : public StorageEngine {
                                   velocypack::Slice const& slice,
                                   RocksDBLogValue&& logValue);
 
+  /// @brief creates the dedicated documents column family for the
+  /// collection with the given object id
+  Result createDedicatedColumnFamily(uint64_t objectId, bool universalCompaction);
+  /// @brief drops the dedicated documents column family of the collection
+  /// with the given object id. does nothing if there is none
+  Result dropDedicatedColumnFamily(uint64_t objectId);
+
   void addCollectionMapping(uint64_t, TRI_voc_tick_t, TRI_voc_cid_t);
   std::vector<std::pair<TRI_voc_tick_t, TRI_voc_cid_t>> collectionMappings() const;
   void addIndexMapping(uint64_t objectId, TRI_voc_tick_t, TRI_voc_cid_t, TRI_idx_iid_t);
@@ -381,10 +393,40 @@ class RocksDBEngine final : public StorageEngine {
     return _replicationManager.get();
   }
 
+  /// @brief number of threads for filling new indexes
+  uint32_t indexBuildThreads() const { return _indexBuildThreads; }
+
+  /// @brief number of threads for applying the WAL during recovery
+  uint32_t recoveryThreads() const { return _recoveryThreads; }
+
+  /// @brief directory for temporary SST files that are built for ingestion
+  /// (index builds, bulk loads). it is inside the RocksDB directory, so the
+  /// files can be moved on ingestion
+  std::string ingestionPath() const;
+
+  /// @brief slows down a low-priority write of the given size while
+  /// compactions are behind. does nothing if the throttle is turned off
+  void delayLowPriorityWrite(uint64_t bytes) const;
+
+  /// @brief size limit for automatic intermediate commits. the configured
+  /// size is lowered while flushes and compactions are behind, so that
+  /// large transactions do not pile up more unflushed data
+  uint64_t intermediateCommitSize(uint64_t configured) const;
+
   /// @brief returns a pointer to the sync thread
   /// note: returns a nullptr if automatic syncing is turned off!
   RocksDBSyncThread* syncThread() const { return _syncThread.get(); }
 
+  /// @brief returns the snapshots kept for reads as of a timestamp
+  /// note: returns a nullptr on servers other than DB servers!
+  RocksDBSnapshotThread* snapshotThread() const { return _snapshotThread.get(); }
+
+  /// @brief persists and restores index cache warmup snapshots
+  /// note: returns a nullptr if cache snapshots are turned off!
+  RocksDBCacheSnapshotManager* cacheSnapshotManager() const {
+    return _cacheSnapshotManager.get();
+  }
+
   static arangodb::Result registerRecoveryHelper(std::shared_ptr<RocksDBRecoveryHelper> helper);
   static std::vector<std::shared_ptr<RocksDBRecoveryHelper>> const& recoveryHelpers();
 
@@ -393,6 +435,19 @@ class RocksDBEngine final : public StorageEngine {
   rocksdb::TransactionDB* _db;
   /// default read options
   rocksdb::Options _options;
+  /// options for dedicated documents column families
+  rocksdb::ColumnFamilyOptions _dedicatedDocumentsOptions;
+  /// options for dedicated documents column families with universal
+  /// compaction, which rewrites (large) documents less often
+  rocksdb::ColumnFamilyOptions _dedicatedUniversalDocumentsOptions;
+  /// bloom filter policies per column family (by statistics name), used
+  /// for reporting how useful the filters are
+  std::unordered_map<std::string, std::shared_ptr<RocksDBFilterPolicy>> _filterPolicies;
+  /// block cache wrappers per column family (by statistics name), used
+  /// for reporting the cache hits
+  std::unordered_map<std::string, std::shared_ptr<RocksDBBlockCache>> _blockCaches;
+  /// separate block cache for the index column families, may be nullptr
+  std::shared_ptr<rocksdb::Cache> _indexBlockCache;
   /// arangodb comparator - requried because of vpack in keys
   std::unique_ptr<RocksDBVPackComparator> _vpackCmp;
   /// path used by rocksdb (inside _basePath)
@@ -404,6 +459,8 @@ class RocksDBEngine final : public StorageEngine {
   std::unique_ptr<RocksDBReplicationManager> _replicationManager;
   /// @brief tracks the count of documents in collections
   std::unique_ptr<RocksDBSettingsManager> _settingsManager;
+  /// @brief index cache warmup snapshots (nullptr if turned off)
+  std::unique_ptr<RocksDBCacheSnapshotManager> _cacheSnapshotManager;
   /// @brief Local wal access abstraction
   std::unique_ptr<RocksDBWalAccess> _walAccess;
 
@@ -442,6 +499,9 @@ class RocksDBEngine final : public StorageEngine {
   /// @brief maximum total size (in bytes) of archived WAL files
   uint64_t _maxWalArchiveSizeLimit;
 
+  // number of seconds between two index cache warmup snapshots (0 = off)
+  double _cacheSnapshotInterval;
+
   // do not release walfiles containing writes later than this
   TRI_voc_tick_t _releasedTick;
 
@@ -449,6 +509,10 @@ class RocksDBEngine final : public StorageEngine {
   /// note: this is a nullptr if automatic syncing is turned off!
   std::unique_ptr<RocksDBSyncThread> _syncThread;
 
+  /// Background thread taking snapshots for consistent reads across shards
+  /// note: this is a nullptr on servers other than DB servers!
+  std::unique_ptr<RocksDBSnapshotThread> _snapshotThread;
+
   // WAL sync interval, specified in milliseconds by end user, but uses
   // microseconds internally
   uint64_t _syncInterval;
@@ -456,6 +520,20 @@ class RocksDBEngine final : public StorageEngine {
   // use write-throttling
   bool _useThrottle;
 
+  // lower the intermediate commit size under write pressure
+  bool _adaptiveIntermediateCommits;
+
+  /// @brief honor bulk load requests, whose data bypasses the WAL
+  bool _allowBulkLoad;
+
+  /// @brief number of threads used to fill a new non-unique index, which is
+  /// then ingested as SST files (1 = single-threaded transactional fill)
+  uint32_t _indexBuildThreads;
+
+  /// @brief number of threads that apply WAL entries during recovery. the
+  /// entries are partitioned by collection (1 = single-threaded)
+  uint32_t _recoveryThreads;
+
   /// @brief whether or not to use _releasedTick when determining the WAL files to prune
   bool _useReleasedTick;
 
@@ -0,0 +1,96 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "RocksDBFilterPolicy.h"
+
+#include <velocypack/Value.h>
+
+using namespace arangodb;
+
+namespace {
+
+/// @brief counts the probes of a full (or partitioned) filter
+class CountingFilterBitsReader final : public rocksdb::FilterBitsReader {
+ public:
+  CountingFilterBitsReader(rocksdb::FilterBitsReader* wrapped, RocksDBFilterPolicy const& policy)
+      : _wrapped(wrapped), _policy(policy) {}
+
+  bool MayMatch(rocksdb::Slice const& entry) override {
+    bool result = _wrapped->MayMatch(entry);
+    _policy.count(result);
+    return result;
+  }
+
+  void MayMatch(int numKeys, rocksdb::Slice** keys, bool* mayMatch) override {
+    _wrapped->MayMatch(numKeys, keys, mayMatch);
+    for (int i = 0; i < numKeys; ++i) {
+      _policy.count(mayMatch[i]);
+    }
+  }
+
+ private:
+  std::unique_ptr<rocksdb::FilterBitsReader> _wrapped;
+  RocksDBFilterPolicy const& _policy;
+};
+
+}  // namespace
+
+RocksDBFilterPolicy::RocksDBFilterPolicy(int bitsPerKey, bool blockBased)
+    : _wrapped(rocksdb::NewBloomFilterPolicy(bitsPerKey, blockBased)),
+      _checked(0),
+      _useful(0) {}
+
+RocksDBFilterPolicy::~RocksDBFilterPolicy() = default;
+
+char const* RocksDBFilterPolicy::Name() const { return _wrapped->Name(); }
+
+void RocksDBFilterPolicy::CreateFilter(rocksdb::Slice const* keys, int n,
+                                       std::string* dst) const {
+  _wrapped->CreateFilter(keys, n, dst);
+}
+
+bool RocksDBFilterPolicy::KeyMayMatch(rocksdb::Slice const& key,
+                                      rocksdb::Slice const& filter) const {
+  bool result = _wrapped->KeyMayMatch(key, filter);
+  count(result);
+  return result;
+}
+
+rocksdb::FilterBitsBuilder* RocksDBFilterPolicy::GetFilterBitsBuilder() const {
+  return _wrapped->GetFilterBitsBuilder();
+}
+
+rocksdb::FilterBitsReader* RocksDBFilterPolicy::GetFilterBitsReader(rocksdb::Slice const& contents) const {
+  rocksdb::FilterBitsReader* reader = _wrapped->GetFilterBitsReader(contents);
+  if (reader == nullptr) {
+    // block-based filter
+    return nullptr;
+  }
+  return new CountingFilterBitsReader(reader, *this);
+}
+
+void RocksDBFilterPolicy::toVelocyPack(VPackBuilder& builder) const {
+  uint64_t c = checked();
+  uint64_t u = useful();
+  builder.add("checked", VPackValue(c));
+  builder.add("useful", VPackValue(u));
+  builder.add("usefulRate",
+              VPackValue(c == 0 ? 0.0 : static_cast<double>(u) / static_cast<double>(c)));
+}
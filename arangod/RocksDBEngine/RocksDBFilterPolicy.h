@@ -0,0 +1,82 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGO_ROCKSDB_ROCKSDB_FILTER_POLICY_H
+#define ARANGO_ROCKSDB_ROCKSDB_FILTER_POLICY_H 1
+
+#include "Basics/Common.h"
+
+#include <rocksdb/filter_policy.h>
+#include <rocksdb/slice.h>
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+namespace arangodb {
+
+/// @brief wraps one of RocksDB's builtin bloom filter policies and counts
+/// how often the filter was consulted and how often it could rule out a key
+/// (or prefix). One instance is used per column family, so the counters
+/// tell how useful the filter is for the specific access pattern.
+/// The name of the wrapped policy is passed through unchanged, so existing
+/// SST files remain readable in both directions
+class RocksDBFilterPolicy final : public rocksdb::FilterPolicy {
+ public:
+  /// @brief if blockBased is true, uses the (old) block-based filter format,
+  /// otherwise uses full filters, which are required for partitioned filters
+  RocksDBFilterPolicy(int bitsPerKey, bool blockBased);
+  ~RocksDBFilterPolicy();
+
+  char const* Name() const override;
+
+  void CreateFilter(rocksdb::Slice const* keys, int n, std::string* dst) const override;
+
+  bool KeyMayMatch(rocksdb::Slice const& key, rocksdb::Slice const& filter) const override;
+
+  rocksdb::FilterBitsBuilder* GetFilterBitsBuilder() const override;
+
+  rocksdb::FilterBitsReader* GetFilterBitsReader(rocksdb::Slice const& contents) const override;
+
+  /// @brief number of filter probes
+  uint64_t checked() const { return _checked.load(std::memory_order_relaxed); }
+
+  /// @brief number of filter probes that avoided reading a data block
+  uint64_t useful() const { return _useful.load(std::memory_order_relaxed); }
+
+  /// @brief adds "checked", "useful" and "usefulRate" to an open object
+  void toVelocyPack(VPackBuilder& builder) const;
+
+  /// @brief counts the result of a single filter probe
+  void count(bool mayMatch) const {
+    _checked.fetch_add(1, std::memory_order_relaxed);
+    if (!mayMatch) {
+      _useful.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+ private:
+  std::unique_ptr<rocksdb::FilterPolicy const> _wrapped;
+  mutable std::atomic<uint64_t> _checked;
+  mutable std::atomic<uint64_t> _useful;
+};
+
+}  // namespace arangodb
+
+#endif
@@ -437,6 +437,11 @@ Result RocksDBFulltextIndex::executeQuery(transaction::Methods* trx,
   return TRI_ERROR_NO_ERROR;
 }
 
+/// @brief AND-combine a complete word with at most this many previous results
+/// by looking up the (word, document) keys instead of scanning all postings
+/// of the word
+static size_t const MaxIntersectionLookups = 1024;
+
 static RocksDBKeyBounds MakeBounds(uint64_t oid, FulltextQueryToken const& token) {
   if (token.matchType == FulltextQueryToken::COMPLETE) {
     return RocksDBKeyBounds::FulltextIndexComplete(oid, arangodb::velocypack::StringRef(token.value));
@@ -450,6 +455,41 @@ Result RocksDBFulltextIndex::applyQueryToken(transaction::Methods* trx,
                                              FulltextQueryToken const& token,
                                              std::set<LocalDocumentId>& resultSet) {
   auto mthds = RocksDBTransactionState::toMethods(trx);
+
+  if (token.operation == FulltextQueryToken::AND &&
+      token.matchType == FulltextQueryToken::COMPLETE &&
+      !resultSet.empty() && resultSet.size() <= MaxIntersectionLookups) {
+    // few previous results: probe them instead of scanning the postings
+    std::vector<RocksDBKey> keys;
+    keys.reserve(resultSet.size());
+    std::vector<rocksdb::Slice> slices;
+    slices.reserve(resultSet.size());
+    for (LocalDocumentId const& documentId : resultSet) {
+      keys.emplace_back();
+      keys.back().constructFulltextIndexValue(_objectId,
+                                              arangodb::velocypack::StringRef(token.value),
+                                              documentId);
+      slices.emplace_back(keys.back().string());
+    }
+
+    size_t const numLookups = slices.size();
+    std::unique_ptr<rocksdb::PinnableSlice[]> values(new rocksdb::PinnableSlice[numLookups]);
+    std::vector<rocksdb::Status> statuses(numLookups);
+    mthds->MultiGet(_cf, numLookups, slices.data(), values.get(), statuses.data());
+
+    size_t i = 0;
+    for (auto it = resultSet.begin(); it != resultSet.end(); ++i) {
+      if (statuses[i].ok()) {
+        ++it;
+      } else if (statuses[i].IsNotFound()) {
+        it = resultSet.erase(it);
+      } else {
+        return rocksutils::convertStatus(statuses[i]);
+      }
+    }
+    return Result();
+  }
+
   // why can't I have an assignment operator when I want one
   RocksDBKeyBounds bounds = MakeBounds(_objectId, token);
   rocksdb::Slice end = bounds.end();
@@ -459,8 +499,8 @@ Result RocksDBFulltextIndex::applyQueryToken(transaction::Methods* trx,
   ro.iterate_upper_bound = &end;
   std::unique_ptr<rocksdb::Iterator> iter = mthds->NewIterator(ro, _cf);
 
-  // set is used to perform an intersection with the result set
-  std::set<LocalDocumentId> intersect;
+  // sorted and deduplicated below to perform an intersection with the result set
+  std::vector<LocalDocumentId> intersect;
   // apply left to right logic, merging all current results with ALL previous
   for (iter->Seek(bounds.start());
        iter->Valid() && cmp->Compare(iter->key(), end) < 0;
@@ -475,7 +515,7 @@ Result RocksDBFulltextIndex::applyQueryToken(transaction::Methods* trx,
     LocalDocumentId documentId =
         RocksDBKey::indexDocumentId(RocksDBEntryType::FulltextIndexValue, iter->key());
     if (token.operation == FulltextQueryToken::AND) {
-      intersect.insert(documentId);
+      intersect.emplace_back(documentId);
     } else if (token.operation == FulltextQueryToken::OR) {
       resultSet.insert(documentId);
     } else if (token.operation == FulltextQueryToken::EXCLUDE) {
@@ -486,6 +526,7 @@ Result RocksDBFulltextIndex::applyQueryToken(transaction::Methods* trx,
     if (resultSet.empty() || intersect.empty()) {
       resultSet.clear();
     } else {
+      std::sort(intersect.begin(), intersect.end());
       std::set<LocalDocumentId> output;
       std::set_intersection(resultSet.begin(), resultSet.end(), intersect.begin(),
                             intersect.end(), std::inserter(output, output.begin()));
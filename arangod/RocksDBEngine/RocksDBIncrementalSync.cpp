@@ -166,7 +166,7 @@ Result removeKeysOutsideRange(VPackSlice chunkSlice, LogicalCollection* coll,
 
 Result syncChunkRocksDB(DatabaseInitialSyncer& syncer, SingleCollectionTransaction* trx,
                         InitialSyncerIncrementalSyncStats& stats,
-                        std::string const& keysId, uint64_t chunkId,
+                        std::string const& keysId, uint64_t chunkId, uint64_t chunkSize,
                         std::string const& lowString, std::string const& highString,
                         std::vector<std::string> const& markers) {
   // first thing we do is extend the barrier's lifetime
@@ -175,7 +175,6 @@ Result syncChunkRocksDB(DatabaseInitialSyncer& syncer, SingleCollectionTransacti
   }
 
   std::string const baseUrl = replutils::ReplicationUrl + "/keys";
-  TRI_voc_tick_t const chunkSize = 5000;
   LogicalCollection* coll = trx->documentCollection();
   std::string const& collectionName = coll->name();
   RocksDBCollection* physical = static_cast<RocksDBCollection*>(coll->getPhysical());
@@ -551,6 +550,131 @@ Result syncChunkRocksDB(DatabaseInitialSyncer& syncer, SingleCollectionTransacti
   return Result();
 }
 
+Result syncChunkRangesRocksDB(DatabaseInitialSyncer& syncer, SingleCollectionTransaction* trx,
+                              InitialSyncerIncrementalSyncStats& stats,
+                              std::string const& keysId, uint64_t chunkId, uint64_t chunkSize,
+                              std::string const& lowString, std::string const& highString,
+                              std::vector<std::string> const& markers,
+                              std::vector<TRI_voc_rid_t> const& revisions) {
+  TRI_ASSERT(markers.size() == revisions.size());
+
+  // each level splits a chunk into this many sub chunks. the master does not
+  // accept chunks of less than 100 keys
+  uint64_t const subChunkFactor = 5;
+  uint64_t const minSubChunkSize = 200;
+  uint64_t const subChunkSize = chunkSize / subChunkFactor;
+
+  // masters before 3.5 do not provide hashes of sub chunks. if there is no
+  // local key in the range, all keys have to be fetched anyway
+  bool const supportsHashes = syncer._state.master.majorVersion > 3 ||
+                              (syncer._state.master.majorVersion == 3 &&
+                               syncer._state.master.minorVersion >= 5);
+  if (!supportsHashes || markers.empty() || subChunkSize < minSubChunkSize ||
+      chunkSize % subChunkFactor != 0) {
+    return syncChunkRocksDB(syncer, trx, stats, keysId, chunkId, chunkSize,
+                            lowString, highString, markers);
+  }
+
+  if (!syncer._state.isChildSyncer) {
+    syncer._state.barrier.extend(syncer._state.connection);
+  }
+
+  std::unique_ptr<httpclient::SimpleHttpResult> response;
+  {
+    std::string const url =
+        replutils::ReplicationUrl + "/keys/" + keysId +
+        "?type=hashes&chunk=" + std::to_string(chunkId) +
+        "&chunkSize=" + std::to_string(chunkSize) + "&low=" + lowString +
+        "&subChunkSize=" + std::to_string(subChunkSize);
+
+    syncer.setProgress(std::string("fetching hashes of keys chunk ") +
+                       std::to_string(chunkId) + " from " + url);
+
+    double t = TRI_microtime();
+
+    syncer._state.connection.lease([&](httpclient::SimpleHttpClient* client) {
+      response.reset(client->retryRequest(rest::RequestType::PUT, url, nullptr,
+                                          0, replutils::createHeaders()));
+    });
+
+    stats.waitedForKeys += TRI_microtime() - t;
+    ++stats.numKeysRequests;
+
+    if (replutils::hasFailed(response.get())) {
+      return replutils::buildHttpError(response.get(), url, syncer._state.connection);
+    }
+  }
+
+  TRI_ASSERT(response != nullptr);
+
+  VPackBuilder builder;
+  Result r = replutils::parseResponse(builder, response.get());
+  response.reset();  // not needed anymore
+
+  VPackSlice const subChunks = builder.slice();
+  if (r.fail() || !subChunks.isArray() || subChunks.length() == 0) {
+    return Result(TRI_ERROR_REPLICATION_INVALID_RESPONSE,
+                  std::string("got invalid response from master at ") +
+                      syncer._state.master.endpoint + ": response is no array");
+  }
+
+  VPackBuilder tempBuilder;
+  char ridBuffer[21];
+  size_t const numSubChunks = static_cast<size_t>(subChunks.length());
+  size_t nextMarker = 0;
+
+  for (size_t j = 0; j < numSubChunks; ++j) {
+    VPackSlice const subChunk = subChunks.at(j);
+    VPackSlice const lowSlice = subChunk.get("low");
+    VPackSlice const highSlice = subChunk.get("high");
+    VPackSlice const hashSlice = subChunk.get("hash");
+    if (!lowSlice.isString() || !highSlice.isString() || !hashSlice.isString()) {
+      return Result(TRI_ERROR_REPLICATION_INVALID_RESPONSE,
+                    std::string("got invalid response from master at ") +
+                        syncer._state.master.endpoint +
+                        ": sub chunks in response have an invalid format");
+    }
+
+    // the sub chunk owns all local keys up to the low key of the next one,
+    // local keys between its high key and that are removed when it is synced
+    std::vector<std::string> subMarkers;
+    std::vector<TRI_voc_rid_t> subRevisions;
+    uint64_t localHash = 0x012345678;
+    while (nextMarker < markers.size()) {
+      std::string const& localKey = markers[nextMarker];
+      if (j + 1 < numSubChunks &&
+          subChunks.at(j + 1).get("low").compareString(localKey) <= 0) {
+        break;
+      }
+
+      tempBuilder.clear();
+      tempBuilder.add(VPackValue(localKey));
+      localHash ^= tempBuilder.slice().hashString();
+      tempBuilder.clear();
+      tempBuilder.add(TRI_RidToValuePair(revisions[nextMarker], &ridBuffer[0]));
+      localHash ^= tempBuilder.slice().hashString();
+
+      subMarkers.emplace_back(localKey);
+      subRevisions.emplace_back(revisions[nextMarker]);
+      ++nextMarker;
+    }
+
+    if (std::to_string(localHash) == hashSlice.copyString()) {
+      continue;
+    }
+
+    Result res = syncChunkRangesRocksDB(syncer, trx, stats, keysId,
+                                        chunkId * subChunkFactor + j, subChunkSize,
+                                        lowSlice.copyString(), highSlice.copyString(),
+                                        subMarkers, subRevisions);
+    if (res.fail()) {
+      return res;
+    }
+  }
+
+  return Result();
+}
+
 Result handleSyncKeysRocksDB(DatabaseInitialSyncer& syncer,
                              arangodb::LogicalCollection* col, std::string const& keysId) {
   double const startTime = TRI_microtime();
@@ -669,8 +793,9 @@ Result handleSyncKeysRocksDB(DatabaseInitialSyncer& syncer,
     std::string highKey;
     std::string hashString;
     uint64_t localHash = 0x012345678;
-    // chunk keys
+    // chunk keys and their revisions
     std::vector<std::string> markers;
+    std::vector<TRI_voc_rid_t> revisions;
     bool foundLowKey = false;
 
     auto resetChunk = [&]() -> void {
@@ -706,6 +831,7 @@ Result handleSyncKeysRocksDB(DatabaseInitialSyncer& syncer,
 
       // now reset chunk information
       markers.clear();
+      revisions.clear();
       lowKey = lowSlice.copyString();
       highKey = highSlice.copyString();
       hashString = hashSlice.copyString();
@@ -719,10 +845,10 @@ Result handleSyncKeysRocksDB(DatabaseInitialSyncer& syncer,
     VPackBuilder tempBuilder;
 
     std::function<void(std::string, std::uint64_t)> compareChunk =
-        [&trx, &physical, &options, &foundLowKey, &markers, &localHash,
+        [&trx, &physical, &options, &foundLowKey, &markers, &revisions, &localHash,
          &hashString, &syncer, &currentChunkId, &numChunks, &keysId,
          &resetChunk, &compareChunk, &lowKey, &highKey, &tempBuilder,
-         &stats](std::string const& docKey, std::uint64_t docRev) {
+         &stats, &chunkSize](std::string const& docKey, std::uint64_t docRev) {
           int cmp1 = docKey.compare(lowKey);
 
           if (cmp1 < 0) {
@@ -757,6 +883,7 @@ Result handleSyncKeysRocksDB(DatabaseInitialSyncer& syncer,
             }
 
             markers.emplace_back(docKey);
+            revisions.emplace_back(docRev);
             // don't bother hashing if we have't found lower key
             if (foundLowKey) {
               tempBuilder.clear();
@@ -787,8 +914,9 @@ Result handleSyncKeysRocksDB(DatabaseInitialSyncer& syncer,
           TRI_ASSERT(!rangeUnequal || nextChunk);  // A => B
           if (nextChunk) {  // we are out of range, see next chunk
             if (rangeUnequal && currentChunkId < numChunks) {
-              Result res = syncChunkRocksDB(syncer, &trx, stats, keysId,
-                                            currentChunkId, lowKey, highKey, markers);
+              Result res = syncChunkRangesRocksDB(syncer, &trx, stats, keysId,
+                                                  currentChunkId, chunkSize, lowKey,
+                                                  highKey, markers, revisions);
               if (!res.ok()) {
                 THROW_ARANGO_EXCEPTION(res);
               }
@@ -827,7 +955,7 @@ Result handleSyncKeysRocksDB(DatabaseInitialSyncer& syncer,
     // we might have missed chunks, if the keys don't exist at all locally
     while (currentChunkId < numChunks) {
       Result res = syncChunkRocksDB(syncer, &trx, stats, keysId, currentChunkId,
-                                    lowKey, highKey, markers);
+                                    chunkSize, lowKey, highKey, markers);
       if (!res.ok()) {
         THROW_ARANGO_EXCEPTION(res);
       }
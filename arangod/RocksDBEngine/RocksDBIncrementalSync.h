@@ -32,10 +32,20 @@ class LogicalCollection;
 
 Result syncChunkRocksDB(DatabaseInitialSyncer& syncer, SingleCollectionTransaction* trx,
                         InitialSyncerIncrementalSyncStats& stats,
-                        std::string const& keysId, uint64_t chunkId,
+                        std::string const& keysId, uint64_t chunkId, uint64_t chunkSize,
                         std::string const& lowString, std::string const& highString,
                         std::vector<std::string> const& markers);
 
+/// @brief syncs a chunk whose hash differs. the chunk is split into sub
+/// chunks whose hashes are compared with the master, and only the sub chunks
+/// that differ are synced, recursively
+Result syncChunkRangesRocksDB(DatabaseInitialSyncer& syncer, SingleCollectionTransaction* trx,
+                              InitialSyncerIncrementalSyncStats& stats,
+                              std::string const& keysId, uint64_t chunkId, uint64_t chunkSize,
+                              std::string const& lowString, std::string const& highString,
+                              std::vector<std::string> const& markers,
+                              std::vector<TRI_voc_rid_t> const& revisions);
+
 Result handleSyncKeysRocksDB(DatabaseInitialSyncer& syncer,
                              arangodb::LogicalCollection* col, std::string const& keysId);
 }  // namespace arangodb
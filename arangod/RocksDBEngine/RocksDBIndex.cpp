@@ -21,6 +21,7 @@
 /// @author Jan Steemann
 ////////////////////////////////////////////////////////////////////////////////
 
+#include "Basics/StringUtils.h"
 #include "Basics/VelocyPackHelper.h"
 #include "Cache/CacheManagerFeature.h"
 #include "Cache/Common.h"
@@ -179,6 +180,14 @@ void RocksDBIndex::createCache() {
   TRI_ASSERT(_cacheEnabled);
 }
 
+std::vector<std::string> RocksDBIndex::cacheHotKeys(size_t maxKeys) const {
+  if (!useCache()) {
+    return std::vector<std::string>();
+  }
+  TRI_ASSERT(_cache != nullptr);
+  return _cache->hotKeys(maxKeys);
+}
+
 void RocksDBIndex::destroyCache() {
   if (!_cachePresent) {
     return;
@@ -275,6 +284,38 @@ size_t RocksDBIndex::memory() const {
   return static_cast<size_t>(out);
 }
 
+void RocksDBIndex::loadEstimator() const {
+  auto physical = static_cast<RocksDBCollection*>(_collection.getPhysical());
+  // the physical collection is not yet set while its indexes are created
+  if (physical != nullptr) {
+    physical->meta().loadIndexEstimates(_collection);
+  }
+}
+
+bool RocksDBIndex::selectivitySketch(VPackBuilder& builder) {
+  RocksDBCuckooIndexEstimator<uint64_t>* est = estimator();
+  if (est == nullptr) {
+    return false;
+  }
+
+  basics::HyperLogLog sketch;
+  uint64_t nrUsed = 0;
+  uint64_t nrTotal = 0;
+  if (!est->copySketch(sketch, nrUsed, nrTotal)) {
+    return false;
+  }
+
+  std::string serialized;
+  sketch.serialize(serialized);
+
+  builder.openObject();
+  builder.add("used", VPackValue(nrUsed));
+  builder.add("total", VPackValue(nrTotal));
+  builder.add("sketch", VPackValue(basics::StringUtils::encodeBase64(serialized)));
+  builder.close();
+  return true;
+}
+
 /// compact the index, should reduce read amplification
 void RocksDBIndex::compact() {
   rocksdb::TransactionDB* db = rocksutils::globalRocksDB();
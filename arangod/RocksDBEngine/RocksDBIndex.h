@@ -86,6 +86,15 @@ class RocksDBIndex : public Index {
   void createCache();
   void destroyCache();
 
+  /// @brief returns the keys of the hottest cache entries (at most maxKeys),
+  /// to be persisted in a cache warmup snapshot
+  std::vector<std::string> cacheHotKeys(size_t maxKeys) const;
+
+  /// @brief reload the cache entries for keys returned by an earlier call to
+  /// cacheHotKeys(). does nothing for indexes without a cache
+  virtual void warmupCacheKeys(transaction::Methods* trx,
+                               std::vector<std::string> const& keys) {}
+
   /// insert index elements into the specified write batch.
   virtual Result insert(transaction::Methods& trx, RocksDBMethods* methods,
                         LocalDocumentId const& documentId,
@@ -119,6 +128,18 @@ class RocksDBIndex : public Index {
   virtual void setEstimator(std::unique_ptr<RocksDBCuckooIndexEstimator<uint64_t>>) {}
   virtual void recalculateEstimates() {}
 
+  /// @brief value histogram, optional. an index without one never needs to
+  /// rebuild it and ignores histograms passed in
+  virtual bool needToRebuildHistogram(uint64_t /*numberDocuments*/) const {
+    return false;
+  }
+  virtual std::shared_ptr<IndexHistogram const> rebuildHistogram() {
+    return nullptr;
+  }
+  virtual void setHistogram(std::shared_ptr<IndexHistogram const>) {}
+
+  bool selectivitySketch(arangodb::velocypack::Builder&) override;
+
   virtual bool isPersistent() const override { return true; }
 
  protected:
@@ -132,6 +153,10 @@ class RocksDBIndex : public Index {
                rocksdb::ColumnFamilyHandle* cf, bool useCache);
 
   inline bool useCache() const { return (_cacheEnabled && _cachePresent); }
+
+  /// @brief make sure the persisted estimates of the collection's indexes
+  /// are loaded, they are loaded on first use after startup
+  void loadEstimator() const;
   void blackListKey(char const* data, std::size_t len);
   void blackListKey(arangodb::velocypack::StringRef& ref) {
     blackListKey(ref.data(), ref.size());
@@ -49,7 +49,8 @@ RocksDBAllIndexIterator::RocksDBAllIndexIterator(LogicalCollection* col,
       _cmp(RocksDBColumnFamily::documents()->GetComparator()) {
   // acquire rocksdb transaction
   auto* mthds = RocksDBTransactionState::toMethods(trx);
-  rocksdb::ColumnFamilyHandle* cf = RocksDBColumnFamily::documents();
+  rocksdb::ColumnFamilyHandle* cf =
+      static_cast<RocksDBCollection*>(col->getPhysical())->documentsColumnFamily();
 
   rocksdb::ReadOptions options = mthds->iteratorReadOptions();
   TRI_ASSERT(options.snapshot != nullptr);
@@ -118,8 +119,11 @@ bool RocksDBAllIndexIterator::nextDocument(IndexIterator::DocumentCallback const
     return false;
   }
 
+  auto* physical = static_cast<RocksDBCollection*>(_collection->getPhysical());
+  std::string buffer;
   while (limit > 0) {
-    cb(RocksDBKey::documentId(_iterator->key()), VPackSlice(reinterpret_cast<uint8_t const*>(_iterator->value().data())));
+    cb(RocksDBKey::documentId(_iterator->key()),
+       physical->documentFromValue(_iterator->value(), buffer));
     --limit;
     _iterator->Next();
 
@@ -167,7 +171,8 @@ RocksDBAnyIndexIterator::RocksDBAnyIndexIterator(LogicalCollection* col,
   TRI_ASSERT(options.prefix_same_as_start);
   options.fill_cache = AnyIteratorFillBlockCache;
   options.verify_checksums = false;  // TODO evaluate
-  _iterator = mthds->NewIterator(options, RocksDBColumnFamily::documents());
+  _iterator = mthds->NewIterator(
+      options, static_cast<RocksDBCollection*>(col->getPhysical())->documentsColumnFamily());
   TRI_ASSERT(_iterator);
 
   _total = col->numberDocuments(trx, transaction::CountType::Normal);
@@ -238,8 +243,11 @@ bool RocksDBAnyIndexIterator::nextDocument(IndexIterator::DocumentCallback const
     return false;
   }
 
+  auto* physical = static_cast<RocksDBCollection*>(_collection->getPhysical());
+  std::string buffer;
   while (limit > 0) {
-    cb(RocksDBKey::documentId(_iterator->key()), VPackSlice(reinterpret_cast<uint8_t const*>(_iterator->value().data())));
+    cb(RocksDBKey::documentId(_iterator->key()),
+       physical->documentFromValue(_iterator->value(), buffer));
     --limit;
     _returned++;
     _iterator->Next();
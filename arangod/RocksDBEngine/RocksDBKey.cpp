@@ -255,6 +255,28 @@ void RocksDBKey::constructIndexEstimateValue(uint64_t collectionObjectId) {
   TRI_ASSERT(_buffer->size() == keyLength);
 }
 
+void RocksDBKey::constructIndexHistogramValue(uint64_t objectId) {
+  TRI_ASSERT(objectId != 0);
+  _type = RocksDBEntryType::IndexHistogramValue;
+  size_t keyLength = sizeof(char) + sizeof(uint64_t);
+  _buffer->clear();
+  _buffer->reserve(keyLength);
+  _buffer->push_back(static_cast<char>(_type));
+  uint64ToPersistent(*_buffer, objectId);
+  TRI_ASSERT(_buffer->size() == keyLength);
+}
+
+void RocksDBKey::constructDocumentDictionaryValue(uint64_t objectId) {
+  TRI_ASSERT(objectId != 0);
+  _type = RocksDBEntryType::DocumentDictionaryValue;
+  size_t keyLength = sizeof(char) + sizeof(uint64_t);
+  _buffer->clear();
+  _buffer->reserve(keyLength);
+  _buffer->push_back(static_cast<char>(_type));
+  uint64ToPersistent(*_buffer, objectId);
+  TRI_ASSERT(_buffer->size() == keyLength);
+}
+
 void RocksDBKey::constructKeyGeneratorValue(uint64_t objectId) {
   TRI_ASSERT(objectId != 0);
   _type = RocksDBEntryType::KeyGeneratorValue;
@@ -156,6 +156,17 @@ class RocksDBKey {
   //////////////////////////////////////////////////////////////////////////////
   void constructKeyGeneratorValue(uint64_t objectId);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Create a fully-specified key for the value histogram of an index
+  //////////////////////////////////////////////////////////////////////////////
+  void constructIndexHistogramValue(uint64_t objectId);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Create a fully-specified key for the document compression
+  ///        dictionary of a collection
+  //////////////////////////////////////////////////////////////////////////////
+  void constructDocumentDictionaryValue(uint64_t objectId);
+
  public:
   //////////////////////////////////////////////////////////////////////////////
   /// @brief Extracts the type from a key
@@ -297,6 +308,8 @@ class RocksDBKey {
       case RocksDBEntryType::ReplicationApplierConfig:
       case RocksDBEntryType::IndexEstimateValue:
       case RocksDBEntryType::KeyGeneratorValue:
+      case RocksDBEntryType::IndexHistogramValue:
+      case RocksDBEntryType::DocumentDictionaryValue:
       case RocksDBEntryType::View:
         return type;
       default:
@@ -125,6 +125,14 @@ RocksDBKeyBounds RocksDBKeyBounds::KeyGenerators() {
   return RocksDBKeyBounds(RocksDBEntryType::KeyGeneratorValue);
 }
 
+RocksDBKeyBounds RocksDBKeyBounds::IndexHistogramValues() {
+  return RocksDBKeyBounds(RocksDBEntryType::IndexHistogramValue);
+}
+
+RocksDBKeyBounds RocksDBKeyBounds::DocumentDictionaryValues() {
+  return RocksDBKeyBounds(RocksDBEntryType::DocumentDictionaryValue);
+}
+
 RocksDBKeyBounds RocksDBKeyBounds::FulltextIndexPrefix(uint64_t objectId,
                                                        arangodb::velocypack::StringRef const& word) {
   // I did not want to pass a bool to the constructor for this
@@ -204,7 +212,7 @@ rocksdb::ColumnFamilyHandle* RocksDBKeyBounds::columnFamily() const {
     case RocksDBEntryType::Placeholder:
       return RocksDBColumnFamily::invalid();
     case RocksDBEntryType::Document:
-      return RocksDBColumnFamily::documents();
+      return RocksDBColumnFamily::documents(objectId());
     case RocksDBEntryType::PrimaryIndexValue:
       return RocksDBColumnFamily::primary();
     case RocksDBEntryType::EdgeIndexValue:
@@ -224,6 +232,8 @@ rocksdb::ColumnFamilyHandle* RocksDBKeyBounds::columnFamily() const {
     case RocksDBEntryType::ReplicationApplierConfig:
     case RocksDBEntryType::IndexEstimateValue:
     case RocksDBEntryType::KeyGeneratorValue:
+    case RocksDBEntryType::IndexHistogramValue:
+    case RocksDBEntryType::DocumentDictionaryValue:
     case RocksDBEntryType::View:
       return RocksDBColumnFamily::definitions();
   }
@@ -280,7 +290,9 @@ RocksDBKeyBounds::RocksDBKeyBounds(RocksDBEntryType type) : _type(type) {
     }
     case RocksDBEntryType::CounterValue:
     case RocksDBEntryType::IndexEstimateValue:
-    case RocksDBEntryType::KeyGeneratorValue: {
+    case RocksDBEntryType::KeyGeneratorValue:
+    case RocksDBEntryType::IndexHistogramValue:
+    case RocksDBEntryType::DocumentDictionaryValue: {
       _internals.reserve(2 * (sizeof(char) + sizeof(uint64_t)));
       _internals.push_back(static_cast<char>(_type));
       uint64ToPersistent(_internals.buffer(), 0);
@@ -156,6 +156,16 @@ class RocksDBKeyBounds {
   //////////////////////////////////////////////////////////////////////////////
   static RocksDBKeyBounds KeyGenerators();
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Bounds for all index histograms
+  //////////////////////////////////////////////////////////////////////////////
+  static RocksDBKeyBounds IndexHistogramValues();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Bounds for all document compression dictionaries
+  //////////////////////////////////////////////////////////////////////////////
+  static RocksDBKeyBounds DocumentDictionaryValues();
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief Bounds for all entries of a fulltext index, matching prefixes
   //////////////////////////////////////////////////////////////////////////////
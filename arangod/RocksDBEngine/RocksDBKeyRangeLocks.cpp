@@ -0,0 +1,174 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "RocksDBKeyRangeLocks.h"
+
+#include "Basics/ConditionLocker.h"
+#include "Basics/system-functions.h"
+
+using namespace arangodb;
+
+bool RocksDBKeyRangeLocks::Range::contains(arangodb::velocypack::StringRef key) const {
+  if (key.compare(lower) < 0) {
+    return false;
+  }
+  return upper.empty() || key.compare(upper) < 0;
+}
+
+bool RocksDBKeyRangeLocks::Range::overlaps(Range const& other) const {
+  bool const startsBeforeOtherEnds = other.upper.empty() || lower < other.upper;
+  bool const endsAfterOtherStarts = upper.empty() || other.lower < upper;
+  return startsBeforeOtherEnds && endsAfterOtherStarts;
+}
+
+RocksDBKeyRangeLocks::Range RocksDBKeyRangeLocks::prefixRange(std::string const& prefix) {
+  Range range{prefix, prefix};
+  // the upper bound is the smallest string that is greater than all
+  // strings with the prefix. trailing 0xff bytes cannot be incremented
+  while (!range.upper.empty() && static_cast<uint8_t>(range.upper.back()) == 0xff) {
+    range.upper.pop_back();
+  }
+  if (!range.upper.empty()) {
+    range.upper.back() = static_cast<char>(static_cast<uint8_t>(range.upper.back()) + 1);
+  }
+  return range;
+}
+
+bool RocksDBKeyRangeLocks::conflicts(TRI_voc_tid_t tid, std::vector<Range> const& ranges) const {
+  for (auto const& it : _ranges) {
+    if (it.first == tid) {
+      continue;
+    }
+    for (Range const& range : ranges) {
+      if (it.second.overlaps(range)) {
+        return true;
+      }
+    }
+  }
+
+  for (auto const& it : _writers) {
+    if (it.first == tid) {
+      continue;
+    }
+    if (it.second.allKeys) {
+      return true;
+    }
+    for (Range const& range : ranges) {
+      // the smallest registered key not below the range must be beyond it
+      auto key = it.second.keys.lower_bound(range.lower);
+      if (key != it.second.keys.end() &&
+          range.contains(arangodb::velocypack::StringRef(*key))) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+int RocksDBKeyRangeLocks::lock(TRI_voc_tid_t tid, std::vector<Range> const& ranges,
+                               double timeout) {
+  double const end = TRI_microtime() + timeout;
+
+  CONDITION_LOCKER(guard, _condition);
+  while (true) {
+    if (!conflicts(tid, ranges)) {
+      for (Range const& range : ranges) {
+        _ranges.emplace_back(tid, range);
+      }
+      _numEntries.store(_ranges.size() + _writers.size());
+      return TRI_ERROR_NO_ERROR;
+    }
+
+    double const now = TRI_microtime();
+    if (now >= end) {
+      return TRI_ERROR_LOCK_TIMEOUT;
+    }
+    guard.wait(std::max<uint64_t>(1, static_cast<uint64_t>((end - now) * 1000.0 * 1000.0)));
+  }
+}
+
+void RocksDBKeyRangeLocks::unlock(TRI_voc_tid_t tid) {
+  if (_numEntries.load() == 0) {
+    // entries of this transaction would have been added by this thread
+    return;
+  }
+
+  CONDITION_LOCKER(guard, _condition);
+  _ranges.erase(std::remove_if(_ranges.begin(), _ranges.end(),
+                               [tid](std::pair<TRI_voc_tid_t, Range> const& it) {
+                                 return it.first == tid;
+                               }),
+                _ranges.end());
+  _writers.erase(tid);
+  _numEntries.store(_ranges.size() + _writers.size());
+  guard.broadcast();
+}
+
+int RocksDBKeyRangeLocks::lockKey(TRI_voc_tid_t tid, arangodb::velocypack::StringRef key,
+                                  double timeout) {
+  double const end = TRI_microtime() + timeout;
+
+  CONDITION_LOCKER(guard, _condition);
+  while (true) {
+    bool conflict = false;
+    for (auto const& it : _ranges) {
+      if (it.first != tid && it.second.contains(key)) {
+        conflict = true;
+        break;
+      }
+    }
+
+    if (!conflict) {
+      // keep the key until the transaction ends, so that no range covering
+      // it can be granted before the document is committed
+      _writers[tid].keys.emplace(key.data(), key.size());
+      _numEntries.store(_ranges.size() + _writers.size());
+      return TRI_ERROR_NO_ERROR;
+    }
+
+    double const now = TRI_microtime();
+    if (now >= end) {
+      return TRI_ERROR_LOCK_TIMEOUT;
+    }
+    guard.wait(std::max<uint64_t>(1, static_cast<uint64_t>((end - now) * 1000.0 * 1000.0)));
+  }
+}
+
+int RocksDBKeyRangeLocks::lockAllKeys(TRI_voc_tid_t tid) {
+  CONDITION_LOCKER(guard, _condition);
+  for (auto const& it : _ranges) {
+    if (it.first != tid) {
+      return TRI_ERROR_ARANGO_CONFLICT;
+    }
+  }
+  _writers[tid].allKeys = true;
+  _numEntries.store(_ranges.size() + _writers.size());
+  return TRI_ERROR_NO_ERROR;
+}
+
+bool RocksDBKeyRangeLocks::lockedByOthers(TRI_voc_tid_t tid) {
+  CONDITION_LOCKER(guard, _condition);
+  for (auto const& it : _ranges) {
+    if (it.first != tid) {
+      return true;
+    }
+  }
+  return false;
+}
@@ -0,0 +1,107 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_ROCKSDB_ENGINE_ROCKSDB_KEY_RANGE_LOCKS_H
+#define ARANGOD_ROCKSDB_ENGINE_ROCKSDB_KEY_RANGE_LOCKS_H 1
+
+#include "Basics/Common.h"
+#include "Basics/ConditionVariable.h"
+#include "VocBase/voc-types.h"
+
+#include <velocypack/StringRef.h>
+
+#include <set>
+
+namespace arangodb {
+
+/// @brief exclusive locks on ranges of document keys of one collection.
+/// transactions that hold the shared collection lock can lock the key
+/// ranges they are going to modify instead of the whole collection, so
+/// that batch jobs on disjoint ranges do not serialize. writers of other
+/// transactions wait for the ranges their keys fall into.
+/// writers register each key they modify until their transaction ends, and
+/// a range is only granted while no other transaction has a key in it. a
+/// transaction that locks a range after a writer checked its key would
+/// otherwise not see the writer's uncommitted document in its snapshot.
+/// the registered keys take about as much memory as the document locks
+/// RocksDB keeps for the same transaction
+class RocksDBKeyRangeLocks {
+ public:
+  /// @brief the keys in [lower, upper). an empty upper bound means that
+  /// the range is unbounded
+  struct Range {
+    std::string lower;
+    std::string upper;
+
+    bool contains(arangodb::velocypack::StringRef key) const;
+    bool overlaps(Range const& other) const;
+  };
+
+  /// @brief the range of all keys starting with the prefix
+  static Range prefixRange(std::string const& prefix);
+
+ public:
+  RocksDBKeyRangeLocks() : _numEntries(0) {}
+
+  /// @brief locks all ranges at once for the transaction, waiting up to
+  /// timeout seconds for overlapping ranges and for registered keys of
+  /// other transactions. returns TRI_ERROR_LOCK_TIMEOUT if they were not
+  /// released in time
+  int lock(TRI_voc_tid_t tid, std::vector<Range> const& ranges, double timeout);
+
+  /// @brief releases all ranges and keys of the transaction
+  void unlock(TRI_voc_tid_t tid);
+
+  /// @brief waits up to timeout seconds until the key is not in a range of
+  /// another transaction, and registers it for the transaction until
+  /// unlock. returns TRI_ERROR_LOCK_TIMEOUT otherwise
+  int lockKey(TRI_voc_tid_t tid, arangodb::velocypack::StringRef key, double timeout);
+
+  /// @brief registers that the transaction modifies all keys, as truncate
+  /// does. fails with TRI_ERROR_ARANGO_CONFLICT if another transaction holds
+  /// a range, otherwise other transactions cannot lock ranges until unlock
+  int lockAllKeys(TRI_voc_tid_t tid);
+
+  /// @brief whether or not another transaction holds a range
+  bool lockedByOthers(TRI_voc_tid_t tid);
+
+ private:
+  /// @brief the keys registered by one writing transaction
+  struct Writer {
+    std::set<std::string> keys;
+    bool allKeys = false;
+  };
+
+  /// @brief whether or not a range or a key of another transaction
+  /// conflicts with one of the ranges. must hold the _condition lock
+  bool conflicts(TRI_voc_tid_t tid, std::vector<Range> const& ranges) const;
+
+ private:
+  basics::ConditionVariable _condition;
+  std::vector<std::pair<TRI_voc_tid_t, Range>> _ranges;
+  std::unordered_map<TRI_voc_tid_t, Writer> _writers;
+  /// @brief number of ranges and writers, lets unlock skip the mutex for
+  /// transactions that never registered anything
+  std::atomic<size_t> _numEntries;
+};
+
+}  // namespace arangodb
+
+#endif
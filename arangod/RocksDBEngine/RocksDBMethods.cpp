@@ -38,10 +38,12 @@ using namespace arangodb;
 // ================= RocksDBSavePoint ==================
 
 RocksDBSavePoint::RocksDBSavePoint(transaction::Methods* trx,
-                                   TRI_voc_document_operation_e operationType)
+                                   TRI_voc_document_operation_e operationType,
+                                   bool abortOnFailure)
     : _trx(trx),
       _operationType(operationType),
-      _handled(_trx->isSingleOperationTransaction()) {
+      _handled(abortOnFailure || _trx->isSingleOperationTransaction()),
+      _abortOnFailure(abortOnFailure && !_trx->isSingleOperationTransaction()) {
   TRI_ASSERT(trx != nullptr);
   if (!_handled) {
     auto mthds = RocksDBTransactionState::toMethods(_trx);
@@ -63,6 +65,8 @@ RocksDBSavePoint::~RocksDBSavePoint() {
       // whatever happens during rollback, no exceptions are allowed to escape
       // from here
     }
+  } else if (_abortOnFailure) {
+    RocksDBTransactionState::toState(_trx)->setUnrevertedFailure();
   }
 }
 
@@ -83,6 +87,7 @@ void RocksDBSavePoint::finish(bool hasPerformedIntermediateCommit) {
 
   // this will prevent the rollback call in the destructor
   _handled = true;
+  _abortOnFailure = false;
 }
 
 void RocksDBSavePoint::rollback() {
@@ -108,6 +113,15 @@ rocksdb::ReadOptions RocksDBMethods::iteratorReadOptions() {
   return _state->_rocksReadOptions;
 }
 
+void RocksDBMethods::MultiGet(rocksdb::ColumnFamilyHandle* cf, size_t numKeys,
+                              rocksdb::Slice const* keys,
+                              rocksdb::PinnableSlice* values,
+                              rocksdb::Status* statuses) {
+  for (size_t i = 0; i < numKeys; ++i) {
+    statuses[i] = this->Get(cf, keys[i], &values[i]);
+  }
+}
+
 #ifdef ARANGODB_ENABLE_MAINTAINER_MODE
 std::size_t RocksDBMethods::countInBounds(RocksDBKeyBounds const& bounds, bool isElementInRange) {
   std::size_t count = 0;
@@ -153,6 +167,17 @@ rocksdb::Status RocksDBReadOnlyMethods::Get(rocksdb::ColumnFamilyHandle* cf,
   return _db->Get(ro, cf, key, val);
 }
 
+void RocksDBReadOnlyMethods::MultiGet(rocksdb::ColumnFamilyHandle* cf, size_t numKeys,
+                                      rocksdb::Slice const* keys,
+                                      rocksdb::PinnableSlice* values,
+                                      rocksdb::Status* statuses) {
+  TRI_ASSERT(cf != nullptr);
+  rocksdb::ReadOptions const& ro = _state->_rocksReadOptions;
+  TRI_ASSERT(ro.snapshot != nullptr ||
+             (_state->isReadOnlyTransaction() && _state->isSingleOperation()));
+  _db->MultiGet(ro, cf, numKeys, keys, values, statuses);
+}
+
 rocksdb::Status RocksDBReadOnlyMethods::GetForUpdate(rocksdb::ColumnFamilyHandle* cf,
                                                      rocksdb::Slice const& key,
                                                      rocksdb::PinnableSlice* val) {
@@ -222,6 +247,16 @@ rocksdb::Status RocksDBTrxMethods::Get(rocksdb::ColumnFamilyHandle* cf,
   return _state->_rocksTransaction->Get(ro, cf, key, val);
 }
 
+void RocksDBTrxMethods::MultiGet(rocksdb::ColumnFamilyHandle* cf, size_t numKeys,
+                                 rocksdb::Slice const* keys,
+                                 rocksdb::PinnableSlice* values,
+                                 rocksdb::Status* statuses) {
+  TRI_ASSERT(cf != nullptr);
+  rocksdb::ReadOptions const& ro = _state->_rocksReadOptions;
+  TRI_ASSERT(ro.snapshot != nullptr);
+  _state->_rocksTransaction->MultiGet(ro, cf, numKeys, keys, values, statuses);
+}
+
 rocksdb::Status RocksDBTrxMethods::GetForUpdate(rocksdb::ColumnFamilyHandle* cf,
                                                 rocksdb::Slice const& key,
                                                 rocksdb::PinnableSlice* val) {
@@ -284,6 +319,50 @@ void RocksDBTrxMethods::PopSavePoint() {
 #endif
 }
 
+// =================== RocksDBOptimisticTrxMethods ====================
+
+RocksDBOptimisticTrxMethods::RocksDBOptimisticTrxMethods(RocksDBTransactionState* state)
+    : RocksDBTrxMethods(state) {}
+
+rocksdb::Status RocksDBOptimisticTrxMethods::GetForUpdate(rocksdb::ColumnFamilyHandle* cf,
+                                                          rocksdb::Slice const& key,
+                                                          rocksdb::PinnableSlice* val) {
+  TRI_ASSERT(cf != nullptr);
+  rocksdb::ReadOptions const& ro = _state->_rocksReadOptions;
+  TRI_ASSERT(ro.snapshot != nullptr);
+  _state->_optimisticKeys.track(cf, key);
+  return _state->_rocksTransaction->Get(ro, cf, key, val);
+}
+
+rocksdb::Status RocksDBOptimisticTrxMethods::Put(rocksdb::ColumnFamilyHandle* cf,
+                                                 RocksDBKey const& key,
+                                                 rocksdb::Slice const& val,
+                                                 bool /*assume_tracked*/) {
+  TRI_ASSERT(cf != nullptr);
+  return _state->_optimisticKeys.put(_state->_rocksTransaction, cf, key.string(), val);
+}
+
+rocksdb::Status RocksDBOptimisticTrxMethods::PutUntracked(rocksdb::ColumnFamilyHandle* cf,
+                                                          RocksDBKey const& key,
+                                                          rocksdb::Slice const& val) {
+  TRI_ASSERT(cf != nullptr);
+  // neither checked nor locked
+  return _state->_rocksTransaction->GetWriteBatch()->Put(cf, key.string(), val);
+}
+
+rocksdb::Status RocksDBOptimisticTrxMethods::Delete(rocksdb::ColumnFamilyHandle* cf,
+                                                    RocksDBKey const& key) {
+  TRI_ASSERT(cf != nullptr);
+  return _state->_optimisticKeys.remove(_state->_rocksTransaction, cf, key.string());
+}
+
+rocksdb::Status RocksDBOptimisticTrxMethods::SingleDelete(rocksdb::ColumnFamilyHandle* cf,
+                                                          RocksDBKey const& key) {
+  TRI_ASSERT(cf != nullptr);
+  return _state->_optimisticKeys.singleRemove(_state->_rocksTransaction, cf,
+                                              key.string());
+}
+
 // =================== RocksDBBatchedMethods ====================
 
 RocksDBBatchedMethods::RocksDBBatchedMethods(RocksDBTransactionState* state,
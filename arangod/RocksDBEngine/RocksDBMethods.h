@@ -49,7 +49,11 @@ class RocksDBTransactionState;
 
 class RocksDBSavePoint {
  public:
-  RocksDBSavePoint(transaction::Methods* trx, TRI_voc_document_operation_e operationType);
+  /// @brief no savepoint is created if the transaction cannot outlive
+  /// a failure of the operation, i.e. for single operation transactions
+  /// and for operations with the abortOnFailure option
+  RocksDBSavePoint(transaction::Methods* trx, TRI_voc_document_operation_e operationType,
+                   bool abortOnFailure = false);
   ~RocksDBSavePoint();
 
   /// @brief acknowledges the current savepoint, so there
@@ -65,6 +69,9 @@ class RocksDBSavePoint {
   transaction::Methods* _trx;
   TRI_voc_document_operation_e const _operationType;
   bool _handled;
+  // no savepoint was created for abortOnFailure, an unfinished
+  // operation must be reported to the transaction state
+  bool _abortOnFailure;
 };
 
 class RocksDBMethods {
@@ -89,6 +96,12 @@ class RocksDBMethods {
   virtual rocksdb::Status GetForUpdate(rocksdb::ColumnFamilyHandle*,
                                        rocksdb::Slice const&,
                                        rocksdb::PinnableSlice*) = 0;
+  /// @brief look up multiple keys of the same column family in one go, so
+  /// RocksDB can coalesce the block reads. the default implementation
+  /// issues one Get per key
+  virtual void MultiGet(rocksdb::ColumnFamilyHandle*, size_t numKeys,
+                        rocksdb::Slice const* keys, rocksdb::PinnableSlice* values,
+                        rocksdb::Status* statuses);
   /// assume_tracked=true will assume you used GetForUpdate on this key earlier.
   /// it will still verify this, so it is slower than PutUntracked
   virtual rocksdb::Status Put(rocksdb::ColumnFamilyHandle*, RocksDBKey const&,
@@ -129,6 +142,9 @@ class RocksDBReadOnlyMethods final : public RocksDBMethods {
   rocksdb::Status GetForUpdate(rocksdb::ColumnFamilyHandle*,
                                rocksdb::Slice const&,
                                rocksdb::PinnableSlice*) override;
+  void MultiGet(rocksdb::ColumnFamilyHandle*, size_t numKeys,
+                rocksdb::Slice const* keys, rocksdb::PinnableSlice* values,
+                rocksdb::Status* statuses) override;
   rocksdb::Status Put(rocksdb::ColumnFamilyHandle*, RocksDBKey const& key,
                       rocksdb::Slice const& val, bool assume_tracked) override;
   rocksdb::Status PutUntracked(rocksdb::ColumnFamilyHandle*, RocksDBKey const& key,
@@ -167,6 +183,9 @@ class RocksDBTrxMethods : public RocksDBMethods {
   rocksdb::Status GetForUpdate(rocksdb::ColumnFamilyHandle*,
                                rocksdb::Slice const&,
                                rocksdb::PinnableSlice*) override;
+  void MultiGet(rocksdb::ColumnFamilyHandle*, size_t numKeys,
+                rocksdb::Slice const* keys, rocksdb::PinnableSlice* values,
+                rocksdb::Status* statuses) override;
   rocksdb::Status Put(rocksdb::ColumnFamilyHandle*, RocksDBKey const& key,
                       rocksdb::Slice const& val, bool assume_tracked) override;
   rocksdb::Status PutUntracked(rocksdb::ColumnFamilyHandle*, RocksDBKey const& key,
@@ -185,6 +204,23 @@ class RocksDBTrxMethods : public RocksDBMethods {
   bool _indexingDisabled;
 };
 
+/// transaction wrapper for optimistic transactions. writes and reads for
+/// update do not lock the keys, they are validated on commit instead
+class RocksDBOptimisticTrxMethods final : public RocksDBTrxMethods {
+ public:
+  explicit RocksDBOptimisticTrxMethods(RocksDBTransactionState* state);
+
+  rocksdb::Status GetForUpdate(rocksdb::ColumnFamilyHandle*,
+                               rocksdb::Slice const&,
+                               rocksdb::PinnableSlice*) override;
+  rocksdb::Status Put(rocksdb::ColumnFamilyHandle*, RocksDBKey const& key,
+                      rocksdb::Slice const& val, bool assume_tracked) override;
+  rocksdb::Status PutUntracked(rocksdb::ColumnFamilyHandle*, RocksDBKey const& key,
+                               rocksdb::Slice const& val) override;
+  rocksdb::Status Delete(rocksdb::ColumnFamilyHandle*, RocksDBKey const& key) override;
+  rocksdb::Status SingleDelete(rocksdb::ColumnFamilyHandle*, RocksDBKey const&) override;
+};
+
 
 /// wraps a writebatch - non transactional
 class RocksDBBatchedMethods final : public RocksDBMethods {
@@ -0,0 +1,79 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "RocksDBOptimisticKeys.h"
+
+#include "RocksDBEngine/RocksDBCommon.h"
+
+#include <rocksdb/options.h>
+#include <rocksdb/utilities/transaction.h>
+#include <rocksdb/utilities/write_batch_with_index.h>
+
+using namespace arangodb;
+
+void RocksDBOptimisticKeys::track(rocksdb::ColumnFamilyHandle* cf,
+                                  rocksdb::Slice const& key) {
+  _keys.emplace_back(cf, key.ToString());
+}
+
+rocksdb::Status RocksDBOptimisticKeys::put(rocksdb::Transaction* trx,
+                                           rocksdb::ColumnFamilyHandle* cf,
+                                           rocksdb::Slice const& key,
+                                           rocksdb::Slice const& value) {
+  track(cf, key);
+  return trx->GetWriteBatch()->Put(cf, key, value);
+}
+
+rocksdb::Status RocksDBOptimisticKeys::remove(rocksdb::Transaction* trx,
+                                              rocksdb::ColumnFamilyHandle* cf,
+                                              rocksdb::Slice const& key) {
+  track(cf, key);
+  return trx->GetWriteBatch()->Delete(cf, key);
+}
+
+rocksdb::Status RocksDBOptimisticKeys::singleRemove(rocksdb::Transaction* trx,
+                                                    rocksdb::ColumnFamilyHandle* cf,
+                                                    rocksdb::Slice const& key) {
+  track(cf, key);
+  return trx->GetWriteBatch()->SingleDelete(cf, key);
+}
+
+Result RocksDBOptimisticKeys::validate(rocksdb::Transaction* trx) {
+  if (_keys.empty()) {
+    return Result();
+  }
+
+  TRI_ASSERT(trx != nullptr);
+  // a key locked by someone else is a conflict as well, so do not wait
+  trx->SetLockTimeout(0);
+  rocksdb::ReadOptions ro;
+  for (auto const& it : _keys) {
+    rocksdb::Status s =
+        trx->GetForUpdate(ro, it.first, it.second, static_cast<std::string*>(nullptr));
+    if (!s.ok()) {
+      if (s.IsBusy() || s.IsTimedOut()) {
+        return Result(TRI_ERROR_ARANGO_CONFLICT, "write-write conflict");
+      }
+      return rocksutils::convertStatus(s);
+    }
+  }
+  _keys.clear();
+  return Result();
+}
@@ -0,0 +1,88 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_ROCKSDB_ENGINE_ROCKSDB_OPTIMISTIC_KEYS_H
+#define ARANGOD_ROCKSDB_ENGINE_ROCKSDB_OPTIMISTIC_KEYS_H 1
+
+#include "Basics/Common.h"
+#include "Basics/Result.h"
+
+#include <rocksdb/slice.h>
+#include <rocksdb/status.h>
+
+namespace rocksdb {
+class ColumnFamilyHandle;
+class Transaction;
+}  // namespace rocksdb
+
+namespace arangodb {
+
+/// @brief keys written or read for update by a transaction with the option
+/// optimisticConcurrency. such transactions write without locking, and
+/// validate the keys when committing: each key is locked without waiting
+/// and checked against the snapshot of the RocksDB transaction. a key that
+/// another transaction wrote since then, or that is locked by another
+/// transaction, is a write-write conflict.
+/// intermediate commits validate the keys written since the previous
+/// commit. the next segment starts with a new snapshot, so that writes of
+/// others to keys of an already committed segment are no conflict
+class RocksDBOptimisticKeys {
+ public:
+  /// @brief whether a transaction uses optimistic concurrency control.
+  /// transactions that only write collections they lock exclusively skip
+  /// concurrency control altogether and use the regular methods
+  static bool useFor(bool optimisticConcurrency, bool onlyExclusive) {
+    return optimisticConcurrency && !onlyExclusive;
+  }
+
+  /// @brief remember a key to validate on the next commit, i.e. one that
+  /// was read for update
+  void track(rocksdb::ColumnFamilyHandle* cf, rocksdb::Slice const& key);
+
+  /// @brief write to the transaction without locking the key, and track
+  /// it. the write goes into the indexed write batch of the transaction
+  /// directly, because a pessimistic transaction locks the key even in its
+  /// untracked methods
+  rocksdb::Status put(rocksdb::Transaction* trx, rocksdb::ColumnFamilyHandle* cf,
+                      rocksdb::Slice const& key, rocksdb::Slice const& value);
+  rocksdb::Status remove(rocksdb::Transaction* trx, rocksdb::ColumnFamilyHandle* cf,
+                         rocksdb::Slice const& key);
+  rocksdb::Status singleRemove(rocksdb::Transaction* trx, rocksdb::ColumnFamilyHandle* cf,
+                               rocksdb::Slice const& key);
+
+  /// @brief locks all tracked keys, without waiting, and checks that nobody
+  /// else wrote them since the snapshot of the transaction. the locks are
+  /// held until the commit, so nothing can sneak in between. returns
+  /// TRI_ERROR_ARANGO_CONFLICT otherwise. the keys are forgotten on success
+  Result validate(rocksdb::Transaction* trx);
+
+  /// @brief forget all tracked keys, i.e. when a new segment starts
+  void clear() noexcept { _keys.clear(); }
+
+  bool empty() const noexcept { return _keys.empty(); }
+  size_t size() const noexcept { return _keys.size(); }
+
+ private:
+  std::vector<std::pair<rocksdb::ColumnFamilyHandle*, std::string>> _keys;
+};
+
+}  // namespace arangodb
+
+#endif
@@ -30,6 +30,7 @@
 #include "Aql/Function.h"
 #include "Aql/IndexHint.h"
 #include "Aql/IndexNode.h"
+#include "Aql/MaterializeNode.h"
 #include "Aql/ModificationNodes.h"
 #include "Aql/Optimizer.h"
 #include "Aql/OptimizerRule.h"
@@ -38,6 +39,7 @@
 #include "Aql/SortNode.h"
 #include "Basics/HashSet.h"
 #include "Basics/StaticStrings.h"
+#include "Cluster/ServerState.h"
 #include "Indexes/Index.h"
 #include "VocBase/LogicalCollection.h"
 
@@ -49,7 +51,27 @@ namespace {
 
 std::vector<ExecutionNode::NodeType> const reduceExtractionToProjectionTypes = {
     ExecutionNode::ENUMERATE_COLLECTION, ExecutionNode::INDEX};
-          
+
+/// @brief whether or not n is an IndexNode using a single index that can
+/// produce all attributes from its index values
+bool indexNodeCoversAttributes(ExecutionNode const* n,
+                               std::unordered_set<std::string> const& attributes) {
+  if (n->getType() != ExecutionNode::INDEX) {
+    return false;
+  }
+  auto const& indexes = ExecutionNode::castTo<IndexNode const*>(n)->getIndexes();
+  if (indexes.empty()) {
+    return false;
+  }
+  auto idx = indexes[0].getIndex();
+  for (auto const& it : indexes) {
+    if (it.getIndex() != idx) {
+      return false;
+    }
+  }
+  return idx->hasCoveringIterator() && idx->covers(attributes);
+}
+
 }  // namespace
 
 void RocksDBOptimizerRules::registerResources() {
@@ -59,6 +81,12 @@ void RocksDBOptimizerRules::registerResources() {
                                       reduceExtractionToProjectionRule,
                                       OptimizerRule::reduceExtractionToProjectionRule,
                                       false, true);
+  // fetch documents produced by an IndexNode only after SORT and LIMIT,
+  // if everything in between can be served from the index values
+  OptimizerRulesFeature::registerRule("late-document-materialization",
+                                      lateDocumentMaterializationRule,
+                                      OptimizerRule::lateDocumentMaterializationRule,
+                                      false, true);
   // remove SORT RAND() LIMIT 1 if appropriate
   OptimizerRulesFeature::registerRule("remove-sort-rand-limit-1", removeSortRandRule,
                                       OptimizerRule::removeSortRandRule, false, true);
@@ -186,8 +214,10 @@ void RocksDBOptimizerRules::reduceExtractionToProjectionRule(
       current = current->getFirstParent();
     }
 
-    // projections are currently limited (arbitrarily to 5 attributes)
-    if (optimize && !stop && !attributes.empty() && attributes.size() <= 5) {
+    // projections are currently limited (arbitrarily to 5 attributes), unless
+    // they can be served from the index values alone
+    if (optimize && !stop && !attributes.empty() &&
+        (attributes.size() <= 5 || ::indexNodeCoversAttributes(n, attributes))) {
       if (n->getType() == ExecutionNode::ENUMERATE_COLLECTION &&
           std::find(attributes.begin(), attributes.end(), StaticStrings::IdString) == attributes.end()) { 
         // the node is still an EnumerateCollection... now check if we should turn it into an index scan
@@ -209,6 +239,10 @@ void RocksDBOptimizerRules::reduceExtractionToProjectionRule(
             // index doesn't cover the projection
             return false;
           }
+          if (idx->sparse()) {
+            // a sparse index does not contain all documents of the collection
+            return false;
+          }
           if (idx->type() != arangodb::Index::IndexType::TRI_IDX_TYPE_PRIMARY_INDEX &&
               idx->type() != arangodb::Index::IndexType::TRI_IDX_TYPE_HASH_INDEX &&
               idx->type() != arangodb::Index::IndexType::TRI_IDX_TYPE_SKIPLIST_INDEX &&
@@ -346,6 +380,139 @@ void RocksDBOptimizerRules::reduceExtractionToProjectionRule(
   opt->addPlan(std::move(plan), rule, modified);
 }
 
+// fetch documents produced by an IndexNode only after SORT and LIMIT.
+// FOR doc IN coll FILTER doc.a == @a SORT doc.b LIMIT 10 RETURN doc
+// will then read the documents only for the 10 remaining rows, and evaluate
+// the SORT from the values of the index on [a, b]
+void RocksDBOptimizerRules::lateDocumentMaterializationRule(
+    Optimizer* opt, std::unique_ptr<ExecutionPlan> plan, OptimizerRule const* rule) {
+  bool modified = false;
+
+  // the MaterializeNode is not yet distributed in the cluster
+  if (!ServerState::instance()->isSingleServer()) {
+    opt->addPlan(std::move(plan), rule, modified);
+    return;
+  }
+
+  SmallVector<ExecutionNode*>::allocator_type::arena_type a;
+  SmallVector<ExecutionNode*> nodes{a};
+  plan->findNodesOfType(nodes, EN::LIMIT, true);
+
+  arangodb::HashSet<Variable const*> vars;
+  std::unordered_set<std::string> attributes;
+  std::vector<CalculationNode*> calculations;
+
+  for (auto const& limitNode : nodes) {
+    // walk up from the LIMIT to the IndexNode, only accepting nodes that
+    // can work on the index values
+    IndexNode* indexNode = nullptr;
+    bool hasSort = false;
+    calculations.clear();
+
+    ExecutionNode* current = limitNode->getFirstDependency();
+    while (current != nullptr) {
+      auto const type = current->getType();
+      if (type == EN::INDEX) {
+        indexNode = ExecutionNode::castTo<IndexNode*>(current);
+        break;
+      }
+      if (type == EN::SORT) {
+        hasSort = true;
+      } else if (type == EN::CALCULATION) {
+        calculations.emplace_back(ExecutionNode::castTo<CalculationNode*>(current));
+      } else if (type != EN::FILTER) {
+        break;
+      }
+      current = current->getFirstDependency();
+    }
+
+    if (indexNode == nullptr || !hasSort || indexNode->isLateMaterialized() ||
+        !indexNode->projections().empty() || indexNode->getIndexes().size() != 1) {
+      continue;
+    }
+
+    Variable const* outVariable = indexNode->outVariable();
+    if (!limitNode->isVarUsedLater(outVariable)) {
+      // nobody needs the full document after the LIMIT
+      continue;
+    }
+
+    auto const& index = indexNode->getIndexes()[0].getIndex();
+    if (!index->hasCoveringIterator() ||
+        (index->type() != arangodb::Index::IndexType::TRI_IDX_TYPE_HASH_INDEX &&
+         index->type() != arangodb::Index::IndexType::TRI_IDX_TYPE_SKIPLIST_INDEX &&
+         index->type() != arangodb::Index::IndexType::TRI_IDX_TYPE_PERSISTENT_INDEX)) {
+      continue;
+    }
+
+    // collect the attributes of the document used between the IndexNode
+    // and the LIMIT. they all must be served by the index
+    bool stop = false;
+    attributes.clear();
+    current = limitNode->getFirstDependency();
+    while (current != indexNode && !stop) {
+      vars.clear();
+      current->getVariablesUsedHere(vars);
+      if (vars.find(outVariable) != vars.end()) {
+        if (current->getType() != EN::CALCULATION) {
+          // e.g. SORT doc
+          stop = true;
+          break;
+        }
+        auto exp = ExecutionNode::castTo<CalculationNode*>(current)->expression();
+        if (exp == nullptr || exp->node() == nullptr ||
+            !Ast::getReferencedAttributes(exp->node(), outVariable, attributes)) {
+          stop = true;
+          break;
+        }
+      }
+      current = current->getFirstDependency();
+    }
+
+    // _id cannot be produced from index values
+    if (stop || attributes.empty() ||
+        attributes.find(StaticStrings::IdString) != attributes.end() ||
+        !index->covers(attributes)) {
+      continue;
+    }
+
+    auto ast = plan->getAst();
+    Variable const* docIdVariable = ast->variables()->createTemporaryVariable();
+    Variable const* documentVariable = ast->variables()->createTemporaryVariable();
+
+    indexNode->projections(std::move(attributes));
+    indexNode->initIndexCoversProjections();
+    if (indexNode->coveringIndexAttributePositions().empty()) {
+      // should not happen, as the index covers all attributes. but without
+      // covering there would be no gain
+      indexNode->projections(std::vector<std::string>());
+      indexNode->initIndexCoversProjections();
+      continue;
+    }
+    indexNode->setLateMaterialized(docIdVariable, documentVariable);
+
+    std::unordered_map<VariableId, Variable const*> replacements;
+    replacements.emplace(outVariable->id, documentVariable);
+    for (auto calculationNode : calculations) {
+      vars.clear();
+      calculationNode->getVariablesUsedHere(vars);
+      if (vars.find(outVariable) != vars.end()) {
+        calculationNode->expression()->replaceVariables(replacements);
+      }
+    }
+
+    auto materializeNode =
+        new MaterializeNode(plan.get(), plan->nextId(), indexNode->collection(),
+                            *docIdVariable, *outVariable);
+    plan->registerNode(materializeNode);
+    plan->insertAfter(limitNode, materializeNode);
+
+    modified = true;
+  }
+
+  opt->addPlan(std::move(plan), rule, modified);
+}
+
 /// @brief remove SORT RAND() if appropriate
 void RocksDBOptimizerRules::removeSortRandRule(Optimizer* opt,
                                                std::unique_ptr<ExecutionPlan> plan,
@@ -40,6 +40,10 @@ struct RocksDBOptimizerRules {
   static void reduceExtractionToProjectionRule(aql::Optimizer* opt,
                                                std::unique_ptr<aql::ExecutionPlan> plan,
                                                aql::OptimizerRule const* rule);
+  // fetch documents produced by an IndexNode only after SORT and LIMIT
+  static void lateDocumentMaterializationRule(aql::Optimizer* opt,
+                                              std::unique_ptr<aql::ExecutionPlan> plan,
+                                              aql::OptimizerRule const* rule);
   // remove SORT RAND() LIMIT 1 if appropriate
   static void removeSortRandRule(aql::Optimizer* opt,
                                  std::unique_ptr<aql::ExecutionPlan> plan,
@@ -221,20 +221,27 @@ class RocksDBPrimaryIndexInIterator final : public IndexIterator {
       return false;
     }
 
-    while (limit > 0) {
-      LocalDocumentId documentId =
-          _index->lookupKey(_trx, arangodb::velocypack::StringRef(*_iterator));
+    bool const hasMore = lookupBatch(limit);
+    for (auto const& documentId : _documentIds) {
       if (documentId.isSet()) {
         cb(documentId);
-        --limit;
       }
+    }
+    return hasMore;
+  }
 
-      _iterator.next();
-      if (!_iterator.valid()) {
-        return false;
-      }
+  bool nextDocument(DocumentCallback const& cb, size_t limit) override {
+    if (limit == 0 || !_iterator.valid()) {
+      // No limit no data, or we are actually done. The last call should have
+      // returned false
+      TRI_ASSERT(limit > 0);  // Someone called with limit == 0. Api broken
+      return false;
     }
-    return true;
+
+    bool const hasMore = lookupBatch(limit);
+    // fetch all documents of the batch with a single MultiGet as well
+    toRocksDBCollection(*_collection)->readDocumentsWithCallback(_trx, _documentIds, cb);
+    return hasMore;
   }
 
   bool nextCovering(DocumentCallback const& cb, size_t limit) override {
@@ -246,20 +253,14 @@ class RocksDBPrimaryIndexInIterator final : public IndexIterator {
       return false;
     }
 
-    while (limit > 0) {
-      LocalDocumentId documentId =
-          _index->lookupKey(_trx, arangodb::velocypack::StringRef(*_iterator));
-      if (documentId.isSet()) {
-        cb(documentId, *_iterator);
-        --limit;
-      }
-
-      _iterator.next();
-      if (!_iterator.valid()) {
-        return false;
+    bool const hasMore = lookupBatch(limit);
+    TRI_ASSERT(_documentIds.size() == _keySlices.size());
+    for (size_t i = 0; i < _documentIds.size(); ++i) {
+      if (_documentIds[i].isSet()) {
+        cb(_documentIds[i], _keySlices[i]);
       }
     }
-    return true;
+    return hasMore;
   }
 
   void reset() override { _iterator.reset(); }
@@ -269,10 +270,32 @@ class RocksDBPrimaryIndexInIterator final : public IndexIterator {
   bool hasCovering() const override { return _allowCoveringIndexOptimization; }
 
  private:
+  /// @brief look up the next (at most) limit keys in one go. returns whether
+  /// or not there are more keys left. keys that are not found produce unset
+  /// entries in _documentIds, so a batch can yield less than limit documents
+  bool lookupBatch(size_t limit) {
+    _keySlices.clear();
+    _keyRefs.clear();
+    while (limit > 0 && _iterator.valid()) {
+      VPackSlice key = *_iterator;
+      _keySlices.emplace_back(key);
+      _keyRefs.emplace_back(key);
+      --limit;
+      _iterator.next();
+    }
+    _index->lookupKeys(_trx, _keyRefs, _documentIds);
+    return _iterator.valid();
+  }
+
   RocksDBPrimaryIndex* _index;
   std::unique_ptr<VPackBuilder> _keys;
   arangodb::velocypack::ArrayIterator _iterator;
   bool const _allowCoveringIndexOptimization;
+
+  /// @brief the current batch of keys and their document ids
+  std::vector<VPackSlice> _keySlices;
+  std::vector<arangodb::velocypack::StringRef> _keyRefs;
+  std::vector<LocalDocumentId> _documentIds;
 };
 
 class RocksDBPrimaryIndexRangeIterator final : public IndexIterator {
@@ -490,8 +513,12 @@ LocalDocumentId RocksDBPrimaryIndex::lookupKey(transaction::Methods* trx,
   RocksDBKeyLeaser key(trx);
   key->constructPrimaryIndexValue(_objectId, keyRef);
 
+  // the cache holds the current state, which reads as of an older
+  // timestamp must not see
+  bool const cached =
+      useCache() && !RocksDBTransactionState::toState(trx)->hasHistoricSnapshot();
   bool lockTimeout = false;
-  if (useCache()) {
+  if (cached) {
     TRI_ASSERT(_cache != nullptr);
     // check cache first for fast path
     auto f = _cache->find(key->string().data(),
@@ -511,31 +538,132 @@ LocalDocumentId RocksDBPrimaryIndex::lookupKey(transaction::Methods* trx,
   rocksdb::PinnableSlice val;
   rocksdb::Status s = mthds->Get(_cf, key->string(), &val);
   if (!s.ok()) {
+    if (s.IsIncomplete()) {
+      // with NO_BLOCKING_READ, the key is not in memory. this must not be
+      // mistaken for a missing document
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_ARANGO_INCOMPLETE_READ);
+    }
     return LocalDocumentId();
   }
 
-  if (useCache() && !lockTimeout) {
-    TRI_ASSERT(_cache != nullptr);
+  if (cached && !lockTimeout) {
+    insertIntoCache(key->string(), val);
+  }
 
-    // write entry back to cache
-    auto entry =
-        cache::CachedValue::construct(key->string().data(),
-                                      static_cast<uint32_t>(key->string().size()),
-                                      val.data(), static_cast<uint64_t>(val.size()));
-    if (entry) {
-      Result status = _cache->insert(entry);
-      if (status.errorNumber() == TRI_ERROR_LOCK_TIMEOUT) {
-        // the writeLock uses cpu_relax internally, so we can try yield
-        std::this_thread::yield();
-        status = _cache->insert(entry);
+  return RocksDBValue::documentId(val);
+}
+
+void RocksDBPrimaryIndex::lookupKeys(transaction::Methods* trx,
+                                     std::vector<arangodb::velocypack::StringRef> const& keys,
+                                     std::vector<LocalDocumentId>& documentIds) const {
+  size_t const n = keys.size();
+  documentIds.clear();
+  documentIds.resize(n);
+
+  // keys that still need to be looked up in RocksDB, plus their positions
+  std::vector<RocksDBKey> rocksKeys;
+  std::vector<size_t> positions;
+  rocksKeys.reserve(n);
+  positions.reserve(n);
+
+  bool const cached =
+      useCache() && !RocksDBTransactionState::toState(trx)->hasHistoricSnapshot();
+  bool lockTimeout = false;
+  for (size_t i = 0; i < n; ++i) {
+    RocksDBKey key;
+    key.constructPrimaryIndexValue(_objectId, keys[i]);
+
+    if (cached) {
+      TRI_ASSERT(_cache != nullptr);
+      // check cache first for fast path
+      auto f = _cache->find(key.string().data(),
+                            static_cast<uint32_t>(key.string().size()));
+      if (f.found()) {
+        rocksdb::Slice s(reinterpret_cast<char const*>(f.value()->value()),
+                         f.value()->valueSize());
+        documentIds[i] = RocksDBValue::documentId(s);
+        continue;
+      } else if (f.result().errorNumber() == TRI_ERROR_LOCK_TIMEOUT) {
+        // assuming someone is currently holding a write lock, which
+        // is why we cannot access the TransactionalBucket.
+        lockTimeout = true;  // we skip the inserts in this case
       }
-      if (status.fail()) {
-        delete entry;
+    }
+
+    rocksKeys.emplace_back(std::move(key));
+    positions.emplace_back(i);
+  }
+
+  size_t const numLookups = rocksKeys.size();
+  if (numLookups == 0) {
+    return;
+  }
+
+  std::vector<rocksdb::Slice> slices;
+  slices.reserve(numLookups);
+  for (auto const& key : rocksKeys) {
+    slices.emplace_back(key.string());
+  }
+  std::unique_ptr<rocksdb::PinnableSlice[]> values(new rocksdb::PinnableSlice[numLookups]);
+  std::vector<rocksdb::Status> statuses(numLookups);
+
+  RocksDBMethods* mthds = RocksDBTransactionState::toMethods(trx);
+  mthds->MultiGet(_cf, numLookups, slices.data(), values.get(), statuses.data());
+
+  for (size_t i = 0; i < numLookups; ++i) {
+    if (!statuses[i].ok()) {
+      if (statuses[i].IsIncomplete()) {
+        THROW_ARANGO_EXCEPTION(TRI_ERROR_ARANGO_INCOMPLETE_READ);
       }
+      continue;
+    }
+    documentIds[positions[i]] = RocksDBValue::documentId(values[i]);
+
+    if (cached && !lockTimeout) {
+      insertIntoCache(slices[i], values[i]);
     }
   }
+}
 
-  return RocksDBValue::documentId(val);
+void RocksDBPrimaryIndex::warmupCacheKeys(transaction::Methods* trx,
+                                          std::vector<std::string> const& keys) {
+  if (!useCache() || keys.empty()) {
+    return;
+  }
+
+  // cache keys are full primary index keys: object id followed by _key
+  std::vector<arangodb::velocypack::StringRef> refs;
+  refs.reserve(keys.size());
+  for (auto const& key : keys) {
+    if (key.size() > sizeof(uint64_t)) {
+      refs.emplace_back(RocksDBKey::primaryKey(rocksdb::Slice(key)));
+    }
+  }
+
+  // looking the keys up will populate the cache
+  std::vector<LocalDocumentId> documentIds;
+  lookupKeys(trx, refs, documentIds);
+}
+
+void RocksDBPrimaryIndex::insertIntoCache(rocksdb::Slice const& key,
+                                          rocksdb::Slice const& value) const {
+  TRI_ASSERT(_cache != nullptr);
+
+  // write entry back to cache
+  auto entry =
+      cache::CachedValue::construct(key.data(), static_cast<uint32_t>(key.size()),
+                                    value.data(), static_cast<uint64_t>(value.size()));
+  if (entry) {
+    Result status = _cache->insert(entry);
+    if (status.errorNumber() == TRI_ERROR_LOCK_TIMEOUT) {
+      // the writeLock uses cpu_relax internally, so we can try yield
+      std::this_thread::yield();
+      status = _cache->insert(entry);
+    }
+    if (status.fail()) {
+      delete entry;
+    }
+  }
 }
 
 /// @brief reads a revision id from the primary index
@@ -79,6 +79,17 @@ class RocksDBPrimaryIndex final : public RocksDBIndex {
   LocalDocumentId lookupKey(transaction::Methods* trx,
                             arangodb::velocypack::StringRef key) const;
 
+  /// @brief looks up multiple keys at once, using a single RocksDB MultiGet
+  /// for all keys not found in the cache. documentIds will contain one entry
+  /// per key, which is unset if the key does not exist
+  void lookupKeys(transaction::Methods* trx,
+                  std::vector<arangodb::velocypack::StringRef> const& keys,
+                  std::vector<LocalDocumentId>& documentIds) const;
+
+  /// @brief reload the cache entries for the given primary index keys
+  void warmupCacheKeys(transaction::Methods* trx,
+                       std::vector<std::string> const& keys) override;
+
   /// @brief reads a revision id from the primary index
   /// if the document does not exist, this function will return false
   /// if the document exists, the function will return true
@@ -126,6 +137,9 @@ class RocksDBPrimaryIndex final : public RocksDBIndex {
                 velocypack::Slice const& newDoc, Index::OperationMode mode) override;
 
  private:
+  /// @brief write a primary index entry back to the cache
+  void insertIntoCache(rocksdb::Slice const& key, rocksdb::Slice const& value) const;
+
   /// @brief create the iterator, for a single attribute, IN operator
   std::unique_ptr<IndexIterator> createInIterator(transaction::Methods*, arangodb::aql::AstNode const*,
                                                   arangodb::aql::AstNode const*, bool ascending);
@@ -37,6 +37,13 @@ class RocksDBRecoveryHelper {
 
   virtual void prepare() {}
 
+  /// @brief whether the helper can be called by several recovery threads at
+  /// the same time. such a helper receives the data changes of a collection
+  /// in WAL order, but changes of different collections concurrently.
+  /// LogData is only called for markers which are not part of a document
+  /// operation, and only after all previous data changes have been applied
+  virtual bool parallelRecovery() const { return false; }
+
   virtual void PutCF(uint32_t column_family_id, const rocksdb::Slice& key,
                      const rocksdb::Slice& value) {}
 
@@ -31,6 +31,7 @@
 #include "Basics/VelocyPackHelper.h"
 #include "Basics/WriteLocker.h"
 #include "Basics/exitcodes.h"
+#include "Basics/system-functions.h"
 #include "Logger/Logger.h"
 #include "RestServer/DatabaseFeature.h"
 #include "RocksDBEngine/RocksDBCollection.h"
@@ -42,6 +43,7 @@
 #include "RocksDBEngine/RocksDBKeyBounds.h"
 #include "RocksDBEngine/RocksDBLogValue.h"
 #include "RocksDBEngine/RocksDBRecoveryHelper.h"
+#include "RocksDBEngine/RocksDBRecoveryWorkers.h"
 #include "RocksDBEngine/RocksDBSettingsManager.h"
 #include "RocksDBEngine/RocksDBVPackIndex.h"
 #include "RocksDBEngine/RocksDBValue.h"
@@ -69,7 +71,12 @@ RocksDBRecoveryManager* RocksDBRecoveryManager::instance() {
 /// Constructor needs to be called synchrunously,
 /// will load counts from the db and scan the WAL
 RocksDBRecoveryManager::RocksDBRecoveryManager(application_features::ApplicationServer& server)
-    : ApplicationFeature(server, featureName()), _db(nullptr), _inRecovery(true) {
+    : ApplicationFeature(server, featureName()),
+      _db(nullptr),
+      _inRecovery(true),
+      _firstSequence(0),
+      _lastSequence(0),
+      _currentSequence(0) {
   setOptional(true);
   startsAfter("BasicsPhase");
 
@@ -109,6 +116,269 @@ void RocksDBRecoveryManager::runRecovery() {
   // now restore collection counts into collections
 }
 
+namespace {
+
+// find collection by object id
+RocksDBCollection* findCollection(uint64_t objectId) {
+  RocksDBEngine* engine = rocksutils::globalRocksEngine();
+  // now adjust the counter in collections which are already loaded
+  RocksDBEngine::CollectionPair dbColPair = engine->mapObjectToCollection(objectId);
+  if (dbColPair.second == 0 || dbColPair.first == 0) {
+    // collection with this objectID not known.Skip.
+    return nullptr;
+  }
+  DatabaseFeature* df = DatabaseFeature::DATABASE;
+  TRI_vocbase_t* vocbase = df->useDatabase(dbColPair.first);
+  if (vocbase == nullptr) {
+    return nullptr;
+  }
+  TRI_DEFER(vocbase->release());
+  return static_cast<RocksDBCollection*>(
+      vocbase->lookupCollection(dbColPair.second)->getPhysical());
+}
+
+// find index by object id
+RocksDBIndex* findIndex(uint64_t objectId) {
+  RocksDBEngine* engine = rocksutils::globalRocksEngine();
+  RocksDBEngine::IndexTriple triple = engine->mapObjectToIndex(objectId);
+  if (std::get<0>(triple) == 0 && std::get<1>(triple) == 0) {
+    return nullptr;
+  }
+
+  DatabaseFeature* df = DatabaseFeature::DATABASE;
+  TRI_vocbase_t* vb = df->useDatabase(std::get<0>(triple));
+  if (vb == nullptr) {
+    return nullptr;
+  }
+  TRI_DEFER(vb->release());
+
+  auto coll = vb->lookupCollection(std::get<1>(triple));
+
+  if (coll == nullptr) {
+    return nullptr;
+  }
+
+  std::shared_ptr<Index> index = coll->lookupIndex(std::get<2>(triple));
+  if (index == nullptr) {
+    return nullptr;
+  }
+  return static_cast<RocksDBIndex*>(index.get());
+}
+
+// collection a document or index entry belongs to, 0 if unknown or if the
+// entry is not part of a collection, like definitions and settings
+TRI_voc_cid_t collectionOf(uint32_t columnFamilyId, rocksdb::Slice const& key) {
+  RocksDBEngine* engine = rocksutils::globalRocksEngine();
+  if (RocksDBColumnFamily::isDocuments(columnFamilyId)) {
+    return engine->mapObjectToCollection(RocksDBKey::objectId(key)).second;
+  }
+  if (columnFamilyId == RocksDBColumnFamily::primary()->GetID() ||
+      columnFamilyId == RocksDBColumnFamily::edge()->GetID() ||
+      columnFamilyId == RocksDBColumnFamily::vpack()->GetID() ||
+      columnFamilyId == RocksDBColumnFamily::geo()->GetID() ||
+      columnFamilyId == RocksDBColumnFamily::fulltext()->GetID()) {
+    return std::get<1>(engine->mapObjectToIndex(RocksDBKey::objectId(key)));
+  }
+  return 0;
+}
+
+// whether a log marker is part of a document operation. all other markers
+// change the definition of databases, collections, indexes or views
+bool isOperationMarker(RocksDBLogType type) {
+  switch (type) {
+    case RocksDBLogType::BeginTransaction:
+    case RocksDBLogType::DocumentOperationsPrologue:
+    case RocksDBLogType::DocumentRemove:
+    case RocksDBLogType::SinglePut:
+    case RocksDBLogType::SingleRemove:
+    case RocksDBLogType::DocumentRemoveAsPartOfUpdate:
+    case RocksDBLogType::CommitTransaction:
+    case RocksDBLogType::DocumentRemoveV2:
+    case RocksDBLogType::SingleRemoveV2:
+    case RocksDBLogType::TrackedDocumentInsert:
+    case RocksDBLogType::TrackedDocumentRemove:
+      return true;
+    default:
+      return false;
+  }
+}
+
+using WBOperation = RocksDBRecoveryWorkers::Operation;
+
+/// applies data changes to collection counts, index estimates and the
+/// recovery helpers that support parallel recovery, either right away or on
+/// the recovery threads
+class WBApplier {
+ public:
+  explicit WBApplier(size_t numThreads)
+      : _workers(numThreads, [this](WBOperation const& op) { execute(op); }) {
+    for (auto const& helper : RocksDBEngine::recoveryHelpers()) {
+      if (helper->parallelRecovery()) {
+        _helpers.emplace_back(helper);
+      }
+    }
+  }
+
+  /// schedule an operation of a known collection
+  void apply(TRI_voc_cid_t cid, WBOperation&& op) {
+    _workers.schedule(cid, std::move(op));
+  }
+
+  /// whether operations are applied by recovery threads
+  bool parallel() const { return _workers.parallel(); }
+
+  /// wait until all scheduled operations have been applied
+  void drain() { _workers.drain(); }
+
+  /// the first error a recovery thread ran into
+  Result result() { return _workers.result(); }
+
+  /// apply an operation on the calling thread
+  void execute(WBOperation const& op) {
+    rocksdb::Slice key(op.key);
+    switch (op.type) {
+      case WBOperation::Type::Put:
+        put(op.columnFamilyId, key, rocksdb::Slice(op.value), op.sequence);
+        break;
+      case WBOperation::Type::Delete:
+      case WBOperation::Type::SingleDelete:
+        remove(op.columnFamilyId, key, op.sequence, op.lastRemovedDocRid,
+               op.type == WBOperation::Type::SingleDelete);
+        break;
+      case WBOperation::Type::DeleteRange:
+        removeRange(op.columnFamilyId, key, rocksdb::Slice(op.value), op.sequence);
+        break;
+    }
+  }
+
+  void put(uint32_t cfId, rocksdb::Slice const& key, rocksdb::Slice const& value,
+           rocksdb::SequenceNumber seq) {
+    if (RocksDBColumnFamily::isDocuments(cfId)) {
+      auto coll = findCollection(RocksDBKey::objectId(key));
+      if (coll && coll->meta().countUnsafe()._committedSeq < seq) {
+        auto& cc = coll->meta().countUnsafe();
+        cc._committedSeq = seq;
+        cc._added++;
+        std::string valueBuffer;
+        cc._revisionId = transaction::helpers::extractRevFromDocument(
+            coll->documentFromValue(value, valueBuffer));
+        coll->loadInitialNumberDocuments();
+      }
+
+    } else {
+      // We have to adjust the estimate with an insert
+      uint64_t hash = 0;
+      if (cfId == RocksDBColumnFamily::vpack()->GetID()) {
+        hash = RocksDBVPackIndex::HashForKey(key);
+      } else if (cfId == RocksDBColumnFamily::edge()->GetID()) {
+        hash = RocksDBEdgeIndex::HashForKey(key);
+      }
+
+      if (hash != 0) {
+        auto* idx = findIndex(RocksDBKey::objectId(key));
+        if (idx) {
+          RocksDBCuckooIndexEstimator<uint64_t>* est = idx->estimator();
+          if (est && est->appliedSeq() < seq) {
+            // We track estimates for this index
+            est->insert(hash);
+          }
+        }
+      }
+    }
+
+    for (auto const& helper : _helpers) {
+      helper->PutCF(cfId, key, value);
+    }
+  }
+
+  void remove(uint32_t cfId, rocksdb::Slice const& key, rocksdb::SequenceNumber seq,
+              TRI_voc_rid_t lastRemovedDocRid, bool single) {
+    if (RocksDBColumnFamily::isDocuments(cfId)) {
+      auto coll = findCollection(RocksDBKey::objectId(key));
+      if (coll && coll->meta().countUnsafe()._committedSeq < seq) {
+        auto& cc = coll->meta().countUnsafe();
+        cc._committedSeq = seq;
+        cc._removed++;
+        if (lastRemovedDocRid != 0) {
+          cc._revisionId = lastRemovedDocRid;
+        }
+        coll->loadInitialNumberDocuments();
+      }
+
+    } else {
+      // We have to adjust the estimate with an insert
+      uint64_t hash = 0;
+      if (cfId == RocksDBColumnFamily::vpack()->GetID()) {
+        hash = RocksDBVPackIndex::HashForKey(key);
+      } else if (cfId == RocksDBColumnFamily::edge()->GetID()) {
+        hash = RocksDBEdgeIndex::HashForKey(key);
+      }
+
+      if (hash != 0) {
+        auto* idx = findIndex(RocksDBKey::objectId(key));
+        if (idx) {
+          RocksDBCuckooIndexEstimator<uint64_t>* est = idx->estimator();
+          if (est && est->appliedSeq() < seq) {
+            // We track estimates for this index
+            est->remove(hash);
+          }
+        }
+      }
+    }
+
+    for (auto const& helper : _helpers) {
+      if (single) {
+        helper->SingleDeleteCF(cfId, key);
+      } else {
+        helper->DeleteCF(cfId, key);
+      }
+    }
+  }
+
+  void removeRange(uint32_t cfId, rocksdb::Slice const& beginKey,
+                   rocksdb::Slice const& endKey, rocksdb::SequenceNumber seq) {
+    for (auto const& helper : _helpers) {
+      helper->DeleteRangeCF(cfId, beginKey, endKey);
+    }
+
+    // check for a range-delete of the primary index
+    if (RocksDBColumnFamily::isDocuments(cfId)) {
+      uint64_t objectId = RocksDBKey::objectId(beginKey);
+      TRI_ASSERT(objectId == RocksDBKey::objectId(endKey));
+
+      auto coll = findCollection(objectId);
+      if (!coll) {
+        return;
+      }
+
+      if (coll->meta().countUnsafe()._committedSeq <= seq) {
+        auto& cc = coll->meta().countUnsafe();
+        cc._committedSeq = seq;
+        cc._added = 0;
+        cc._removed = 0;
+        coll->loadInitialNumberDocuments();
+
+        for (std::shared_ptr<arangodb::Index> const& idx : coll->getIndexes()) {
+          RocksDBIndex* ridx = static_cast<RocksDBIndex*>(idx.get());
+          RocksDBCuckooIndexEstimator<uint64_t>* est = ridx->estimator();
+          TRI_ASSERT(ridx->type() != Index::TRI_IDX_TYPE_EDGE_INDEX || est);
+          if (est) {
+            est->clear();
+            est->setAppliedSeq(seq);
+          }
+        }
+      }
+    }
+  }
+
+ private:
+  // declared first, as the recovery threads use them until they are joined
+  std::vector<std::shared_ptr<RocksDBRecoveryHelper>> _helpers;
+  RocksDBRecoveryWorkers _workers;
+};
+
+}  // namespace
+
 class WBReader final : public rocksdb::WriteBatch::Handler {
  private:
   // used to track used IDs for key-generators
@@ -124,14 +394,26 @@ class WBReader final : public rocksdb::WriteBatch::Handler {
   rocksdb::SequenceNumber _currentSequence;  /// current sequence nr
   bool _startOfBatch = false;
 
+  /// applies the data changes, possibly on other threads
+  WBApplier& _applier;
+  /// recovery helpers which are called in WAL order by this reader
+  std::vector<std::shared_ptr<RocksDBRecoveryHelper>> _helpers;
+
  public:
   /// @param seqs sequence number from which to count operations
-  explicit WBReader()
+  explicit WBReader(WBApplier& applier)
       : _maxTick(TRI_NewTickServer()),
         _maxHLC(0),
         _lastRemovedDocRid(0),
         _startSequence(0),
-        _currentSequence(0) {}
+        _currentSequence(0),
+        _applier(applier) {
+    for (auto const& helper : RocksDBEngine::recoveryHelpers()) {
+      if (!helper->parallelRecovery()) {
+        _helpers.emplace_back(helper);
+      }
+    }
+  }
 
   void startNewBatch(rocksdb::SequenceNumber startSequence) {
     // starting new write batch
@@ -166,52 +448,6 @@ class WBReader final : public rocksdb::WriteBatch::Handler {
     }
   }
 
-  // find estimator for index
-  RocksDBCollection* findCollection(uint64_t objectId) {
-    RocksDBEngine* engine = rocksutils::globalRocksEngine();
-    // now adjust the counter in collections which are already loaded
-    RocksDBEngine::CollectionPair dbColPair = engine->mapObjectToCollection(objectId);
-    if (dbColPair.second == 0 || dbColPair.first == 0) {
-      // collection with this objectID not known.Skip.
-      return nullptr;
-    }
-    DatabaseFeature* df = DatabaseFeature::DATABASE;
-    TRI_vocbase_t* vocbase = df->useDatabase(dbColPair.first);
-    if (vocbase == nullptr) {
-      return nullptr;
-    }
-    TRI_DEFER(vocbase->release());
-    return static_cast<RocksDBCollection*>(
-        vocbase->lookupCollection(dbColPair.second)->getPhysical());
-  }
-
-  RocksDBIndex* findIndex(uint64_t objectId) {
-    RocksDBEngine* engine = rocksutils::globalRocksEngine();
-    RocksDBEngine::IndexTriple triple = engine->mapObjectToIndex(objectId);
-    if (std::get<0>(triple) == 0 && std::get<1>(triple) == 0) {
-      return nullptr;
-    }
-
-    DatabaseFeature* df = DatabaseFeature::DATABASE;
-    TRI_vocbase_t* vb = df->useDatabase(std::get<0>(triple));
-    if (vb == nullptr) {
-      return nullptr;
-    }
-    TRI_DEFER(vb->release());
-
-    auto coll = vb->lookupCollection(std::get<1>(triple));
-
-    if (coll == nullptr) {
-      return nullptr;
-    }
-
-    std::shared_ptr<Index> index = coll->lookupIndex(std::get<2>(triple));
-    if (index == nullptr) {
-      return nullptr;
-    }
-    return static_cast<RocksDBIndex*>(index.get());
-  }
-
   void updateMaxTick(uint32_t column_family_id, const rocksdb::Slice& key,
                      const rocksdb::Slice& value) {
     // RETURN (side-effect): update _maxTick
@@ -224,7 +460,7 @@ class WBReader final : public rocksdb::WriteBatch::Handler {
     //          - documents - _rev (revision as maxtick)
     //          - databases
 
-    if (column_family_id == RocksDBColumnFamily::documents()->GetID()) {
+    if (RocksDBColumnFamily::isDocuments(column_family_id)) {
       storeMaxHLC(RocksDBKey::documentId(key).id());
     } else if (column_family_id == RocksDBColumnFamily::primary()->GetID()) {
       // document key
@@ -286,6 +522,36 @@ class WBReader final : public rocksdb::WriteBatch::Handler {
     }
   }
 
+  // hands a data change to the recovery thread of its collection. changes
+  // of unknown collections are applied right away, after all others
+  void dispatch(WBOperation::Type type, uint32_t cfId, rocksdb::Slice const& key,
+                rocksdb::Slice const& value) {
+    TRI_voc_cid_t cid = 0;
+    if (_applier.parallel()) {
+      cid = collectionOf(cfId, key);
+      if (cid != 0) {
+        _applier.apply(cid, WBOperation{type, cfId, key.ToString(), value.ToString(),
+                                        _currentSequence, _lastRemovedDocRid});
+        return;
+      }
+      _applier.drain();
+    }
+
+    switch (type) {
+      case WBOperation::Type::Put:
+        _applier.put(cfId, key, value, _currentSequence);
+        break;
+      case WBOperation::Type::Delete:
+      case WBOperation::Type::SingleDelete:
+        _applier.remove(cfId, key, _currentSequence, _lastRemovedDocRid,
+                        type == WBOperation::Type::SingleDelete);
+        break;
+      case WBOperation::Type::DeleteRange:
+        _applier.removeRange(cfId, key, value, _currentSequence);
+        break;
+    }
+  }
+
  public:
   rocksdb::Status PutCF(uint32_t column_family_id, const rocksdb::Slice& key,
                         const rocksdb::Slice& value) override {
@@ -293,94 +559,38 @@ class WBReader final : public rocksdb::WriteBatch::Handler {
     incTick();
 
     updateMaxTick(column_family_id, key, value);
-    if (column_family_id == RocksDBColumnFamily::documents()->GetID()) {
-      auto coll = findCollection(RocksDBKey::objectId(key));
-      if (coll && coll->meta().countUnsafe()._committedSeq < _currentSequence) {
-        auto& cc = coll->meta().countUnsafe();
-        cc._committedSeq = _currentSequence;
-        cc._added++;
-        cc._revisionId =
-            transaction::helpers::extractRevFromDocument(RocksDBValue::data(value));
-        coll->loadInitialNumberDocuments();
-      }
-
-    } else {
-      // We have to adjust the estimate with an insert
-      uint64_t hash = 0;
-      if (column_family_id == RocksDBColumnFamily::vpack()->GetID()) {
-        hash = RocksDBVPackIndex::HashForKey(key);
-      } else if (column_family_id == RocksDBColumnFamily::edge()->GetID()) {
-        hash = RocksDBEdgeIndex::HashForKey(key);
-      }
+    dispatch(WBOperation::Type::Put, column_family_id, key, value);
 
-      if (hash != 0) {
-        auto* idx = findIndex(RocksDBKey::objectId(key));
-        if (idx) {
-          RocksDBCuckooIndexEstimator<uint64_t>* est = idx->estimator();
-          if (est && est->appliedSeq() < _currentSequence) {
-            // We track estimates for this index
-            est->insert(hash);
-          }
-        }
-      }
-    }
-
-    RocksDBEngine* engine = rocksutils::globalRocksEngine();
-    for (auto helper : engine->recoveryHelpers()) {
+    for (auto const& helper : _helpers) {
       helper->PutCF(column_family_id, key, value);
     }
 
     return rocksdb::Status();
   }
 
-  void handleDeleteCF(uint32_t cfId, const rocksdb::Slice& key) {
+  void handleDeleteCF(uint32_t cfId, const rocksdb::Slice& key, bool single) {
     incTick();
 
-    if (cfId == RocksDBColumnFamily::documents()->GetID()) {
+    bool const isDocument = RocksDBColumnFamily::isDocuments(cfId);
+    if (isDocument) {
       uint64_t objectId = RocksDBKey::objectId(key);
 
       storeMaxHLC(RocksDBKey::documentId(key).id());
       storeMaxTick(objectId);
+    }
 
-      auto coll = findCollection(RocksDBKey::objectId(key));
-      if (coll && coll->meta().countUnsafe()._committedSeq < _currentSequence) {
-        auto& cc = coll->meta().countUnsafe();
-        cc._committedSeq = _currentSequence;
-        cc._removed++;
-        if (_lastRemovedDocRid != 0) {
-          cc._revisionId = _lastRemovedDocRid;
-        }
-        coll->loadInitialNumberDocuments();
-      }
-      _lastRemovedDocRid = 0;  // reset in any case
-
-    } else {
-      // We have to adjust the estimate with an insert
-      uint64_t hash = 0;
-      if (cfId == RocksDBColumnFamily::vpack()->GetID()) {
-        hash = RocksDBVPackIndex::HashForKey(key);
-      } else if (cfId == RocksDBColumnFamily::edge()->GetID()) {
-        hash = RocksDBEdgeIndex::HashForKey(key);
-      }
+    dispatch(single ? WBOperation::Type::SingleDelete : WBOperation::Type::Delete,
+             cfId, key, rocksdb::Slice());
 
-      if (hash != 0) {
-        auto* idx = findIndex(RocksDBKey::objectId(key));
-        if (idx) {
-          RocksDBCuckooIndexEstimator<uint64_t>* est = idx->estimator();
-          if (est && est->appliedSeq() < _currentSequence) {
-            // We track estimates for this index
-            est->remove(hash);
-          }
-        }
-      }
+    if (isDocument) {
+      _lastRemovedDocRid = 0;  // reset in any case
     }
   }
 
   rocksdb::Status DeleteCF(uint32_t column_family_id, const rocksdb::Slice& key) override {
     LOG_TOPIC("5f341", TRACE, Logger::ENGINES) << "recovering DELETE " << RocksDBKey(key);
-    handleDeleteCF(column_family_id, key);
-    RocksDBEngine* engine = rocksutils::globalRocksEngine();
-    for (auto helper : engine->recoveryHelpers()) {
+    handleDeleteCF(column_family_id, key, false);
+    for (auto const& helper : _helpers) {
       helper->DeleteCF(column_family_id, key);
     }
 
@@ -390,10 +600,9 @@ class WBReader final : public rocksdb::WriteBatch::Handler {
   rocksdb::Status SingleDeleteCF(uint32_t column_family_id, const rocksdb::Slice& key) override {
     LOG_TOPIC("aa997", TRACE, Logger::ENGINES)
         << "recovering SINGLE DELETE " << RocksDBKey(key);
-    handleDeleteCF(column_family_id, key);
+    handleDeleteCF(column_family_id, key, true);
 
-    RocksDBEngine* engine = rocksutils::globalRocksEngine();
-    for (auto helper : engine->recoveryHelpers()) {
+    for (auto const& helper : _helpers) {
       helper->SingleDeleteCF(column_family_id, key);
     }
 
@@ -407,39 +616,11 @@ class WBReader final : public rocksdb::WriteBatch::Handler {
         << RocksDBKey(end_key);
     incTick();
     // drop and truncate can use this, truncate is handled via a Log marker
-    RocksDBEngine* engine = rocksutils::globalRocksEngine();
-    for (auto helper : engine->recoveryHelpers()) {
+    for (auto const& helper : _helpers) {
       helper->DeleteRangeCF(column_family_id, begin_key, end_key);
     }
 
-    // check for a range-delete of the primary index
-    if (column_family_id == RocksDBColumnFamily::documents()->GetID()) {
-      uint64_t objectId = RocksDBKey::objectId(begin_key);
-      TRI_ASSERT(objectId == RocksDBKey::objectId(end_key));
-
-      auto coll = findCollection(objectId);
-      if (!coll) {
-        return rocksdb::Status();
-      }
-
-      if (coll->meta().countUnsafe()._committedSeq <= _currentSequence) {
-        auto& cc = coll->meta().countUnsafe();
-        cc._committedSeq = _currentSequence;
-        cc._added = 0;
-        cc._removed = 0;
-        coll->loadInitialNumberDocuments();
-
-        for (std::shared_ptr<arangodb::Index> const& idx : coll->getIndexes()) {
-          RocksDBIndex* ridx = static_cast<RocksDBIndex*>(idx.get());
-          RocksDBCuckooIndexEstimator<uint64_t>* est = ridx->estimator();
-          TRI_ASSERT(ridx->type() != Index::TRI_IDX_TYPE_EDGE_INDEX || est);
-          if (est) {
-            est->clear();
-            est->setAppliedSeq(_currentSequence);
-          }
-        }
-      }
-    }
+    dispatch(WBOperation::Type::DeleteRange, column_family_id, begin_key, end_key);
 
     return rocksdb::Status();  // make WAL iterator happy
   }
@@ -457,8 +638,18 @@ class WBReader final : public rocksdb::WriteBatch::Handler {
         _lastRemovedDocRid = 0;  // reset in any other case
         break;
     }
-    RocksDBEngine* engine = rocksutils::globalRocksEngine();
-    for (auto helper : engine->recoveryHelpers()) {
+
+    if (isOperationMarker(type)) {
+      for (auto const& helper : _helpers) {
+        helper->LogData(blob);
+      }
+      return;
+    }
+
+    // markers that change definitions see all previous data changes applied,
+    // and are seen by all helpers in registration order
+    _applier.drain();
+    for (auto const& helper : RocksDBEngine::recoveryHelpers()) {
       helper->LogData(blob);
     }
   }
@@ -477,8 +668,9 @@ Result RocksDBRecoveryManager::parseRocksWAL() {
       helper->prepare();
     }
 
+    WBApplier applier(engine->recoveryThreads());
     // Tell the WriteBatch reader the transaction markers to look for
-    WBReader handler;
+    WBReader handler(applier);
     rocksdb::SequenceNumber earliest = engine->settingsManager()->earliestSeqNeeded();
     auto minTick = std::min(earliest, engine->releasedTick());
 
@@ -486,6 +678,10 @@ Result RocksDBRecoveryManager::parseRocksWAL() {
     RocksDBFilePurgePreventer purgePreventer(
         rocksutils::globalRocksEngine()->disallowPurging());
 
+    _firstSequence.store(minTick, std::memory_order_relaxed);
+    _lastSequence.store(_db->GetLatestSequenceNumber(), std::memory_order_relaxed);
+    _currentSequence.store(minTick, std::memory_order_relaxed);
+
     std::unique_ptr<rocksdb::TransactionLogIterator> iterator;  // reader();
     rocksdb::Status s =
         _db->GetUpdatesSince(minTick, &iterator,
@@ -494,10 +690,13 @@ Result RocksDBRecoveryManager::parseRocksWAL() {
     rv = rocksutils::convertStatus(s);
 
     if (rv.ok()) {
+      double nextReport = TRI_microtime() + 10.0;
+
       while (iterator->Valid()) {
         s = iterator->status();
         if (s.ok()) {
           rocksdb::BatchResult batch = iterator->GetBatch();
+          _currentSequence.store(batch.sequence, std::memory_order_relaxed);
           handler.startNewBatch(batch.sequence);
           s = batch.writeBatchPtr->Iterate(&handler);
         }
@@ -510,10 +709,25 @@ Result RocksDBRecoveryManager::parseRocksWAL() {
           break;
         }
 
+        double const now = TRI_microtime();
+        if (now >= nextReport) {
+          LOG_TOPIC("c3a71", INFO, Logger::ENGINES)
+              << "replayed " << static_cast<int>(progress() * 100.0)
+              << "% of the RocksDB WAL";
+          nextReport = now + 10.0;
+        }
+
         iterator->Next();
       }
     }
 
+    applier.drain();
+    if (rv.ok()) {
+      rv = applier.result();
+    }
+    _currentSequence.store(_lastSequence.load(std::memory_order_relaxed),
+                           std::memory_order_relaxed);
+
     shutdownRv = handler.shutdownWBReader();
 
     return rv;
@@ -530,4 +744,18 @@ Result RocksDBRecoveryManager::parseRocksWAL() {
   return res;
 }
 
+double RocksDBRecoveryManager::progress() const {
+  uint64_t first = _firstSequence.load(std::memory_order_relaxed);
+  uint64_t last = _lastSequence.load(std::memory_order_relaxed);
+  uint64_t current = _currentSequence.load(std::memory_order_relaxed);
+  if (!inRecovery() || last <= first) {
+    return 1.0;
+  }
+  if (current <= first) {
+    return 0.0;
+  }
+  return std::min(1.0, static_cast<double>(current - first) /
+                           static_cast<double>(last - first));
+}
+
 }  // namespace arangodb
@@ -50,6 +50,9 @@ class RocksDBRecoveryManager final : public application_features::ApplicationFea
     return _inRecovery.load(std::memory_order_acquire);
   }
 
+  /// @brief share of the WAL that has been replayed, between 0 and 1
+  double progress() const;
+
  private:
   Result parseRocksWAL();
 
@@ -60,6 +63,12 @@ class RocksDBRecoveryManager final : public application_features::ApplicationFea
   rocksdb::TransactionDB* _db;
 
   std::atomic<bool> _inRecovery;
+
+  /// @brief WAL range that is replayed, and the start of the batch replayed
+  /// last, for reporting progress
+  std::atomic<uint64_t> _firstSequence;
+  std::atomic<uint64_t> _lastSequence;
+  std::atomic<uint64_t> _currentSequence;
 };
 
 }  // namespace arangodb
@@ -0,0 +1,116 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "RocksDBRecoveryWorkers.h"
+
+#include "Basics/ConditionLocker.h"
+#include "Basics/Exceptions.h"
+#include "Basics/MutexLocker.h"
+
+using namespace arangodb;
+
+RocksDBRecoveryWorkers::RocksDBRecoveryWorkers(size_t numThreads,
+                                               std::function<void(Operation const&)> apply)
+    : _apply(std::move(apply)), _stopping(false) {
+  if (numThreads <= 1) {
+    // everything is applied by the WAL reader itself
+    return;
+  }
+  _workers.reserve(numThreads);
+  for (size_t i = 0; i < numThreads; ++i) {
+    _workers.emplace_back(std::make_unique<Worker>());
+  }
+  for (auto& worker : _workers) {
+    Worker* w = worker.get();
+    w->thread = std::thread([this, w]() { run(*w); });
+  }
+}
+
+RocksDBRecoveryWorkers::~RocksDBRecoveryWorkers() {
+  _stopping.store(true);
+  for (auto& worker : _workers) {
+    CONDITION_LOCKER(guard, worker->condition);
+    guard.broadcast();
+  }
+  for (auto& worker : _workers) {
+    if (worker->thread.joinable()) {
+      worker->thread.join();
+    }
+  }
+}
+
+void RocksDBRecoveryWorkers::schedule(TRI_voc_cid_t cid, Operation&& op) {
+  TRI_ASSERT(!_workers.empty());
+  Worker& worker = *_workers[cid % _workers.size()];
+  CONDITION_LOCKER(guard, worker.condition);
+  while (worker.queue.size() >= maxQueued) {
+    guard.wait();
+  }
+  worker.queue.emplace_back(std::move(op));
+  guard.broadcast();
+}
+
+void RocksDBRecoveryWorkers::drain() {
+  for (auto& worker : _workers) {
+    CONDITION_LOCKER(guard, worker->condition);
+    while (!worker->queue.empty() || worker->busy) {
+      guard.wait();
+    }
+  }
+}
+
+Result RocksDBRecoveryWorkers::result() {
+  MUTEX_LOCKER(locker, _resultLock);
+  return _result;
+}
+
+void RocksDBRecoveryWorkers::run(Worker& worker) {
+  std::deque<Operation> batch;
+  while (true) {
+    {
+      CONDITION_LOCKER(guard, worker.condition);
+      while (worker.queue.empty() && !_stopping.load()) {
+        guard.wait();
+      }
+      if (worker.queue.empty()) {
+        return;
+      }
+      batch.swap(worker.queue);
+      worker.busy = true;
+      // the reader may wait for space in the queue
+      guard.broadcast();
+    }
+
+    for (auto const& op : batch) {
+      Result res = basics::catchVoidToResult([&]() -> void { _apply(op); });
+      if (res.fail()) {
+        MUTEX_LOCKER(locker, _resultLock);
+        if (_result.ok()) {
+          _result = std::move(res);
+        }
+      }
+    }
+    batch.clear();
+
+    CONDITION_LOCKER(guard, worker.condition);
+    worker.busy = false;
+    guard.broadcast();
+  }
+}
@@ -0,0 +1,102 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_ROCKSDB_ENGINE_ROCKSDB_RECOVERY_WORKERS_H
+#define ARANGOD_ROCKSDB_ENGINE_ROCKSDB_RECOVERY_WORKERS_H 1
+
+#include "Basics/Common.h"
+#include "Basics/ConditionVariable.h"
+#include "Basics/Mutex.h"
+#include "Basics/Result.h"
+#include "VocBase/voc-types.h"
+
+#include <rocksdb/types.h>
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <thread>
+
+namespace arangodb {
+
+/// @brief the threads that apply the data changes found in the WAL during
+/// recovery. the changes are partitioned by collection, so the changes of
+/// one collection are applied in WAL order, while different collections are
+/// applied concurrently. the WAL reader calls drain() before anything that
+/// depends on all earlier changes, e.g. a marker that changes definitions
+class RocksDBRecoveryWorkers {
+ public:
+  /// @brief a WAL entry that changes the data of a single collection
+  struct Operation {
+    enum class Type : uint8_t { Put, Delete, SingleDelete, DeleteRange };
+
+    Type type;
+    uint32_t columnFamilyId;
+    std::string key;
+    // the value of a put, the end key of a range delete
+    std::string value;
+    rocksdb::SequenceNumber sequence;
+    TRI_voc_rid_t lastRemovedDocRid;
+  };
+
+  /// @brief maximum number of queued operations per thread
+  static constexpr size_t maxQueued = 4096;
+
+  /// @brief starts the given number of threads, which call apply for each
+  /// operation. with less than two threads, no thread is started and the
+  /// caller applies the operations itself
+  RocksDBRecoveryWorkers(size_t numThreads, std::function<void(Operation const&)> apply);
+  ~RocksDBRecoveryWorkers();
+
+  /// @brief whether operations are applied by recovery threads
+  bool parallel() const { return !_workers.empty(); }
+
+  /// @brief schedule an operation of a known collection. waits while the
+  /// queue of its thread is full
+  void schedule(TRI_voc_cid_t cid, Operation&& op);
+
+  /// @brief wait until all scheduled operations have been applied
+  void drain();
+
+  /// @brief the first error a recovery thread ran into
+  Result result();
+
+ private:
+  struct Worker {
+    basics::ConditionVariable condition;
+    std::deque<Operation> queue;
+    bool busy = false;
+    std::thread thread;
+  };
+
+  void run(Worker& worker);
+
+ private:
+  std::function<void(Operation const&)> const _apply;
+  std::vector<std::unique_ptr<Worker>> _workers;
+  std::atomic<bool> _stopping;
+  Mutex _resultLock;
+  Result _result;
+};
+
+}  // namespace arangodb
+
+#endif
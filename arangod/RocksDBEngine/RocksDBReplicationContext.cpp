@@ -126,7 +126,7 @@ void RocksDBReplicationContext::removeVocbase(TRI_vocbase_t& vocbase) {
 /// remove matching iterator
 void RocksDBReplicationContext::releaseIterators(TRI_vocbase_t& vocbase, TRI_voc_cid_t cid) {
   MUTEX_LOCKER(locker, _contextLock);
-  auto it = _iterators.find(cid);
+  auto it = _iterators.find({cid, 0});
   if (it != _iterators.end()) {
     if (it->second->isUsed()) {
       LOG_TOPIC("74164", ERR, Logger::REPLICATION) << "trying to delete used iterator";
@@ -151,7 +151,7 @@ std::tuple<Result, TRI_voc_cid_t, uint64_t> RocksDBReplicationContext::bindColle
 
   MUTEX_LOCKER(writeLocker, _contextLock);
 
-  auto it = _iterators.find(cid);
+  auto it = _iterators.find({cid, 0});
   if (it != _iterators.end()) {  // nothing to do here
     return std::make_tuple(Result{}, it->second->logical->id(), it->second->numberDocuments);
   }
@@ -178,12 +178,12 @@ std::tuple<Result, TRI_voc_cid_t, uint64_t> RocksDBReplicationContext::bindColle
   TRI_ASSERT(_snapshot != nullptr);
 
   auto iter = std::make_unique<CollectionIterator>(vocbase, logical, true, _snapshot);
-  auto result = _iterators.emplace(cid, std::move(iter));
+  auto result = _iterators.emplace(std::make_pair(cid, size_t(0)), std::move(iter));
   TRI_ASSERT(result.second);
 
   CollectionIterator* cIter = result.first->second.get();
   if (nullptr == cIter->iter) {
-    _iterators.erase(cid);
+    _iterators.erase(result.first);
     return std::make_tuple(Result(TRI_ERROR_INTERNAL,
                                   "could not create db iterators"),
                            0, 0);
@@ -241,8 +241,9 @@ Result RocksDBReplicationContext::getInventory(TRI_vocbase_t& vocbase, bool incl
 // creating a new iterator if one does not exist for this collection
 RocksDBReplicationContext::DumpResult RocksDBReplicationContext::dumpJson(
     TRI_vocbase_t& vocbase, std::string const& cname,
-    basics::StringBuffer& buff, uint64_t chunkSize) {
-  TRI_ASSERT(_users > 0);
+    basics::StringBuffer& buff, uint64_t chunkSize,
+    size_t range, size_t numRanges) {
+  TRI_ASSERT(_users > 0 && range < numRanges);
   CollectionIterator* cIter{nullptr};
   auto guard = scopeGuard([&] { releaseDumpIterator(cIter); });
 
@@ -253,23 +254,26 @@ RocksDBReplicationContext::DumpResult RocksDBReplicationContext::dumpJson(
     }
 
     MUTEX_LOCKER(writeLocker, _contextLock);
-    cIter = getCollectionIterator(vocbase, cid, /*sorted*/ false, /*create*/ true);
+    cIter = getCollectionIterator(vocbase, cid, /*sorted*/ false, /*create*/ true,
+                                  numRanges > 1 ? range + 1 : 0, numRanges);
     if (!cIter || cIter->sorted() || !cIter->iter) {
       return DumpResult(TRI_ERROR_BAD_PARAMETER);
     }
   }
 
-  TRI_ASSERT(cIter->bounds.columnFamily() == RocksDBColumnFamily::documents());
+  TRI_ASSERT(RocksDBColumnFamily::isDocuments(cIter->bounds.columnFamily()->GetID()));
 
   arangodb::basics::VPackStringBufferAdapter adapter(buff.stringBuffer());
   VPackDumper dumper(&adapter, &cIter->vpackOptions);
+  auto* physical = toRocksDBCollection(*cIter->logical);
+  std::string valueBuffer;
   TRI_ASSERT(cIter->iter && !cIter->sorted());
   while (cIter->hasMore() && buff.length() < chunkSize) {
     buff.appendText("{\"type\":");
     buff.appendInteger(REPLICATION_MARKER_DOCUMENT);  // set type
     buff.appendText(",\"data\":");
     // printing the data, note: we need the CustomTypeHandler here
-    dumper.dump(velocypack::Slice(reinterpret_cast<uint8_t const*>(cIter->iter->value().data())));
+    dumper.dump(physical->documentFromValue(cIter->iter->value(), valueBuffer));
     buff.appendText("}\n");
     cIter->iter->Next();
   }
@@ -285,8 +289,9 @@ RocksDBReplicationContext::DumpResult RocksDBReplicationContext::dumpJson(
 // creating a new iterator if one does not exist for this collection
 RocksDBReplicationContext::DumpResult RocksDBReplicationContext::dumpVPack(
     TRI_vocbase_t& vocbase, std::string const& cname,
-    VPackBuffer<uint8_t>& buffer, uint64_t chunkSize) {
-  TRI_ASSERT(_users > 0 && chunkSize > 0);
+    VPackBuffer<uint8_t>& buffer, uint64_t chunkSize,
+    size_t range, size_t numRanges) {
+  TRI_ASSERT(_users > 0 && chunkSize > 0 && range < numRanges);
 
   CollectionIterator* cIter{nullptr};
   auto guard = scopeGuard([&] { releaseDumpIterator(cIter); });
@@ -298,21 +303,24 @@ RocksDBReplicationContext::DumpResult RocksDBReplicationContext::dumpVPack(
     }
 
     MUTEX_LOCKER(writeLocker, _contextLock);
-    cIter = getCollectionIterator(vocbase, cid, /*sorted*/ false, /*create*/ true);
+    cIter = getCollectionIterator(vocbase, cid, /*sorted*/ false, /*create*/ true,
+                                  numRanges > 1 ? range + 1 : 0, numRanges);
     if (!cIter || cIter->sorted() || !cIter->iter) {
       return DumpResult(TRI_ERROR_BAD_PARAMETER);
     }
   }
 
-  TRI_ASSERT(cIter->bounds.columnFamily() == RocksDBColumnFamily::documents());
+  TRI_ASSERT(RocksDBColumnFamily::isDocuments(cIter->bounds.columnFamily()->GetID()));
 
   VPackBuilder builder(buffer, &cIter->vpackOptions);
+  auto* physical = toRocksDBCollection(*cIter->logical);
+  std::string valueBuffer;
   TRI_ASSERT(cIter->iter && !cIter->sorted());
   while (cIter->hasMore() && buffer.length() < chunkSize) {
     builder.openObject();
     builder.add("type", VPackValue(REPLICATION_MARKER_DOCUMENT));
     builder.add(VPackValue("data"));
-    builder.add(velocypack::Slice(reinterpret_cast<uint8_t const*>(cIter->iter->value().data())));
+    builder.add(physical->documentFromValue(cIter->iter->value(), valueBuffer));
     builder.close();
     cIter->iter->Next();
   }
@@ -386,11 +394,12 @@ arangodb::Result RocksDBReplicationContext::dumpKeyChunks(TRI_vocbase_t& vocbase
         docKey.constructDocument(cObjectId, docId);
 
         rocksdb::PinnableSlice ps;
-        auto s = db->Get(cIter->readOptions(), RocksDBColumnFamily::documents(),
+        auto s = db->Get(cIter->readOptions(), RocksDBColumnFamily::documents(cObjectId),
                          docKey.string(), &ps);
         if (s.ok()) {
           TRI_ASSERT(ps.size() > 0);
-          docRev = TRI_ExtractRevisionId(VPackSlice(reinterpret_cast<uint8_t const*>(ps.data())));
+          std::string valueBuffer;
+          docRev = TRI_ExtractRevisionId(rcoll->documentFromValue(ps, valueBuffer));
         } else {
           LOG_TOPIC("32e3b", WARN, Logger::REPLICATION)
               << "inconsistent primary index, "
@@ -444,6 +453,115 @@ arangodb::Result RocksDBReplicationContext::dumpKeyChunks(TRI_vocbase_t& vocbase
   return rv;
 }
 
+/// dump the hashes of the sub chunks of a chunk for incremental sync
+arangodb::Result RocksDBReplicationContext::dumpKeyHashes(
+    TRI_vocbase_t& vocbase, TRI_voc_cid_t cid, VPackBuilder& b, size_t chunk,
+    size_t chunkSize, std::string const& lowKey, size_t subChunkSize) {
+  TRI_ASSERT(_users > 0 && chunkSize > 0 && subChunkSize > 0);
+  CollectionIterator* cIter{nullptr};
+  auto guard = scopeGuard([&cIter] {
+    if (cIter) {
+      cIter->release();
+    }
+  });
+
+  Result rv;
+  {
+    if (0 == cid || _snapshot == nullptr) {
+      return Result{TRI_ERROR_BAD_PARAMETER};
+    }
+
+    MUTEX_LOCKER(writeLocker, _contextLock);
+    cIter = getCollectionIterator(vocbase, cid, /*sorted*/ true, /*create*/ false);
+    if (!cIter || !cIter->sorted() || !cIter->iter) {
+      return Result{TRI_ERROR_BAD_PARAMETER};
+    }
+  }
+
+  TRI_ASSERT(cIter->bounds.columnFamily() == RocksDBColumnFamily::primary());
+
+  if (lowKey.empty() ||
+      (chunk != 0 && ((std::numeric_limits<std::size_t>::max() / chunk) < chunkSize))) {
+    return rv.reset(TRI_ERROR_BAD_PARAMETER,
+                    "It seems that your chunk / chunkSize "
+                    "combination is not valid - overflow");
+  }
+
+  RocksDBKey tmpKey;
+  tmpKey.constructPrimaryIndexValue(cIter->bounds.objectId(),
+                                    arangodb::velocypack::StringRef(lowKey));
+  cIter->iter->Seek(tmpKey.string());
+  cIter->lastSortedIteratorOffset = chunk * chunkSize;
+
+  // reserve some space in the result builder to avoid frequent reallocations
+  b.reserve(8192);
+  char ridBuffer[21];  // temporary buffer for stringifying revision ids
+  VPackBuilder tmpHashBuilder;
+  rocksdb::TransactionDB* db = globalRocksDB();
+  auto* rcoll = static_cast<RocksDBCollection*>(cIter->logical->getPhysical());
+  const uint64_t cObjectId = rcoll->objectId();
+
+  b.openArray(true);
+  while (chunkSize > 0 && cIter->hasMore()) {
+    // the hash is built like the one of a chunk in dumpKeyChunks
+    std::string subLowKey, subHighKey;
+    uint64_t hash = 0x012345678;
+
+    size_t k = (std::min)(subChunkSize, chunkSize);
+    chunkSize -= k;
+    while (k-- > 0 && cIter->hasMore()) {
+      arangodb::velocypack::StringRef key = RocksDBKey::primaryKey(cIter->iter->key());
+      if (subLowKey.empty()) {
+        subLowKey.assign(key.data(), key.size());
+      }
+      subHighKey.assign(key.data(), key.size());
+
+      TRI_voc_rid_t docRev;
+      if (!RocksDBValue::revisionId(cIter->iter->value(), docRev)) {
+        // for collections that do not have the revisionId in the value
+        LocalDocumentId docId = RocksDBValue::documentId(cIter->iter->value());
+        tmpKey.constructDocument(cObjectId, docId);
+
+        rocksdb::PinnableSlice ps;
+        auto s = db->Get(cIter->readOptions(), RocksDBColumnFamily::documents(cObjectId),
+                         tmpKey.string(), &ps);
+        if (!s.ok()) {
+          LOG_TOPIC("b7e2a", WARN, Logger::REPLICATION)
+              << "inconsistent primary index, "
+              << "did not find document with key " << key.toString();
+          TRI_ASSERT(false);
+          return rv.reset(TRI_ERROR_INTERNAL);
+        }
+        TRI_ASSERT(ps.size() > 0);
+        std::string valueBuffer;
+        docRev = TRI_ExtractRevisionId(rcoll->documentFromValue(ps, valueBuffer));
+      }
+
+      tmpHashBuilder.clear();
+      tmpHashBuilder.add(VPackValuePair(key.data(), key.size(), VPackValueType::String));
+      hash ^= tmpHashBuilder.slice().hashString();
+      tmpHashBuilder.clear();
+      tmpHashBuilder.add(TRI_RidToValuePair(docRev, &ridBuffer[0]));
+      hash ^= tmpHashBuilder.slice().hashString();
+
+      cIter->iter->Next();
+      cIter->lastSortedIteratorOffset++;
+    }
+
+    if (subLowKey.empty()) {
+      break;
+    }
+    b.add(VPackValue(VPackValueType::Object));
+    b.add("low", VPackValue(subLowKey));
+    b.add("high", VPackValue(subHighKey));
+    b.add("hash", VPackValue(std::to_string(hash)));
+    b.close();
+  }
+  b.close();
+
+  return rv;
+}
+
 /// dump all keys from collection for incremental sync
 arangodb::Result RocksDBReplicationContext::dumpKeys(TRI_vocbase_t& vocbase,
                                                      TRI_voc_cid_t cid, VPackBuilder& b,
@@ -532,11 +650,12 @@ arangodb::Result RocksDBReplicationContext::dumpKeys(TRI_vocbase_t& vocbase,
       tmpKey.constructDocument(cObjectId, docId);
 
       rocksdb::PinnableSlice ps;
-      auto s = db->Get(cIter->readOptions(), RocksDBColumnFamily::documents(),
+      auto s = db->Get(cIter->readOptions(), RocksDBColumnFamily::documents(cObjectId),
                        tmpKey.string(), &ps);
       if (s.ok()) {
         TRI_ASSERT(ps.size() > 0);
-        docRev = TRI_ExtractRevisionId(VPackSlice(reinterpret_cast<uint8_t const*>(ps.data())));
+        std::string valueBuffer;
+        docRev = TRI_ExtractRevisionId(rcoll->documentFromValue(ps, valueBuffer));
       } else {
         arangodb::velocypack::StringRef key = RocksDBKey::primaryKey(cIter->iter->key());
         LOG_TOPIC("41803", WARN, Logger::REPLICATION)
@@ -670,12 +789,14 @@ arangodb::Result RocksDBReplicationContext::dumpDocuments(
         tmpKey.constructDocument(cObjectId, docId);
 
         rocksdb::PinnableSlice ps;
-        auto s = db->Get(cIter->readOptions(), RocksDBColumnFamily::documents(),
+        auto s = db->Get(cIter->readOptions(), RocksDBColumnFamily::documents(cObjectId),
                          tmpKey.string(), &ps);
         if (s.ok()) {
           TRI_ASSERT(ps.size() > 0);
-          TRI_ASSERT(VPackSlice(reinterpret_cast<uint8_t const*>(ps.data())).isObject());
-          b.add(VPackSlice(reinterpret_cast<uint8_t const*>(ps.data())));
+          std::string valueBuffer;
+          VPackSlice doc = rcoll->documentFromValue(ps, valueBuffer);
+          TRI_ASSERT(doc.isObject());
+          b.add(doc);
         } else {
           arangodb::velocypack::StringRef key = RocksDBKey::primaryKey(cIter->iter->key());
           LOG_TOPIC("d79df", WARN, Logger::REPLICATION)
@@ -792,6 +913,7 @@ RocksDBReplicationContext::CollectionIterator::CollectionIterator(
       vpackOptions{Options::Defaults},
       numberDocuments{0},
       isNumberDocumentsExclusive{false},
+      range{0},
       _resolver(vocbase),
       _cTypeHandler{},
       _readOptions{},
@@ -845,6 +967,9 @@ void RocksDBReplicationContext::CollectionIterator::setSorted(bool sorted) {
 
     TRI_ASSERT(_upperLimit.size() > 0);
     _readOptions.iterate_upper_bound = &_upperLimit;
+    _rangeStart.clear();
+    _rangeEnd.clear();
+    range = 0;
     iter.reset(rocksutils::globalRocksDB()->NewIterator(_readOptions, cf));
     TRI_ASSERT(iter);
     iter->Seek(bounds.start());
@@ -852,6 +977,61 @@ void RocksDBReplicationContext::CollectionIterator::setSorted(bool sorted) {
   }
 }
 
+void RocksDBReplicationContext::CollectionIterator::setRange(size_t range, size_t numRanges) {
+  TRI_ASSERT(!_sortedIterator);
+  TRI_ASSERT(range > 0 && range <= numRanges);
+  this->range = range;
+  if (numRanges <= 1) {
+    return;
+  }
+
+  // find the first and the last document of the collection. a document key
+  // is the collection's object id followed by 8 bytes of document id. read
+  // as a big-endian number, these bytes follow the iteration order, no
+  // matter in which endianness the document ids were written
+  rocksdb::ReadOptions ro = _readOptions;
+  ro.prefix_same_as_start = false;
+  ro.total_order_seek = true;
+  std::unique_ptr<rocksdb::Iterator> probe(
+      rocksutils::globalRocksDB()->NewIterator(ro, bounds.columnFamily()));
+
+  probe->Seek(bounds.start());
+  if (!probe->Valid() || _cmp->Compare(probe->key(), bounds.end()) > 0) {
+    // no documents, all ranges are empty. the first gets all the nothing
+    return;
+  }
+  TRI_ASSERT(probe->key().size() == 2 * sizeof(uint64_t));
+  std::string const prefix(probe->key().data(), sizeof(uint64_t));
+  uint64_t const first =
+      rocksutils::uintFromPersistentBigEndian<uint64_t>(probe->key().data() + sizeof(uint64_t));
+
+  probe->SeekForPrev(bounds.end());
+  TRI_ASSERT(probe->Valid());
+  uint64_t const last =
+      rocksutils::uintFromPersistentBigEndian<uint64_t>(probe->key().data() + sizeof(uint64_t));
+  TRI_ASSERT(last >= first);
+
+  // range i covers [split(i - 1), split(i)), the outer ranges are open
+  uint64_t const width = (last - first) / numRanges;
+  auto split = [&](size_t i) {
+    std::string key(prefix);
+    rocksutils::uintToPersistentBigEndian<uint64_t>(key, first + width * i);
+    return key;
+  };
+
+  if (range > 1) {
+    _rangeStart = split(range - 1);
+  }
+  if (range < numRanges) {
+    _rangeEnd = split(range);
+    _upperLimit = rocksdb::Slice(_rangeEnd);
+    // the iterator holds on to the read options it was created with
+    iter.reset(rocksutils::globalRocksDB()->NewIterator(_readOptions, bounds.columnFamily()));
+    TRI_ASSERT(iter);
+  }
+  resetToStart();
+}
+
 // iterator convenience methods
 
 bool RocksDBReplicationContext::CollectionIterator::hasMore() const {
@@ -873,17 +1053,23 @@ uint64_t RocksDBReplicationContext::CollectionIterator::skipKeys(uint64_t toSkip
 }
 
 void RocksDBReplicationContext::CollectionIterator::resetToStart() {
-  iter->Seek(bounds.start());
+  if (_rangeStart.empty()) {
+    iter->Seek(bounds.start());
+  } else {
+    iter->Seek(_rangeStart);
+  }
 }
 
 RocksDBReplicationContext::CollectionIterator* RocksDBReplicationContext::getCollectionIterator(
-    TRI_vocbase_t& vocbase, TRI_voc_cid_t cid, bool sorted, bool allowCreate) {
+    TRI_vocbase_t& vocbase, TRI_voc_cid_t cid, bool sorted, bool allowCreate,
+    size_t range, size_t numRanges) {
   _contextLock.assertLockedByCurrentThread();
+  TRI_ASSERT(range == 0 || !sorted);
   lazyCreateSnapshot();
 
   CollectionIterator* cIter{nullptr};
   // check if iterator already exists
-  auto it = _iterators.find(cid);
+  auto it = _iterators.find({cid, range});
 
   if (_iterators.end() != it) {
     // exists, check if used
@@ -901,15 +1087,18 @@ RocksDBReplicationContext::CollectionIterator* RocksDBReplicationContext::getCol
 
     if (nullptr != logical) {
       auto result =
-          _iterators.emplace(cid, std::make_unique<CollectionIterator>(vocbase, logical, sorted,
-                                                                       _snapshot));
+          _iterators.emplace(std::make_pair(cid, range),
+                             std::make_unique<CollectionIterator>(vocbase, logical,
+                                                                  sorted, _snapshot));
 
       if (result.second) {
         cIter = result.first->second.get();
 
         if (nullptr == cIter->iter) {
           cIter = nullptr;
-          _iterators.erase(cid);
+          _iterators.erase(result.first);
+        } else if (range > 0) {
+          cIter->setRange(range, numRanges);
         }
       }
     }
@@ -939,7 +1128,7 @@ void RocksDBReplicationContext::releaseDumpIterator(CollectionIterator* it) {
     if (!it->hasMore()) {
       it->vocbase.replicationClients().track(replicationClientId(), _snapshotTick, _ttl);
       MUTEX_LOCKER(locker, _contextLock);
-      _iterators.erase(it->logical->id());
+      _iterators.erase({it->logical->id(), it->range});
     } else {  // Context::release() will update the replication client
       it->release();
     }
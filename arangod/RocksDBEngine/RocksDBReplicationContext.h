@@ -81,10 +81,16 @@ class RocksDBReplicationContext {
     uint64_t numberDocuments;
     /// @brief snapshot and number documents were fetched exclusively
     bool isNumberDocumentsExclusive;
+    /// @brief 1-based key range of the documents this iterator is
+    /// restricted to, 0 for all documents
+    size_t range;
 
     rocksdb::ReadOptions const& readOptions() const { return _readOptions; }
     bool sorted() const { return _sortedIterator; }
     void setSorted(bool);
+    /// @brief restricts an unsorted iterator to one of numRanges key ranges
+    /// of about the same width. the ranges together cover all documents
+    void setRange(size_t range, size_t numRanges);
 
     void use() noexcept {
       TRI_ASSERT(!isUsed());
@@ -107,6 +113,9 @@ class RocksDBReplicationContext {
     rocksdb::ReadOptions _readOptions;
     /// @brief upper limit for iterate_upper_bound
     rocksdb::Slice _upperLimit;
+    /// @brief bounds of the key range, empty if not restricted
+    std::string _rangeStart;
+    std::string _rangeEnd;
     rocksdb::Comparator const* _cmp;
     /// no one is allowed to use this concurrently
     std::atomic<bool> _isUsed;
@@ -140,6 +149,9 @@ class RocksDBReplicationContext {
 
   // ========================= Dump API =============================
 
+  /// @brief maximum number of key ranges a dump can be split into
+  static constexpr size_t MaxDumpRanges = 64;
+
   struct DumpResult {
     DumpResult(int res) : hasMore(false), includedTick(0), _result(res) {}
     DumpResult(int res, bool hm, uint64_t tick)
@@ -163,14 +175,18 @@ class RocksDBReplicationContext {
   };
 
   // iterates over at most 'limit' documents in the collection specified,
-  // creating a new iterator if one does not exist for this collection
+  // creating a new iterator if one does not exist for this collection.
+  // with numRanges > 1 only the documents of the 0-based key range are
+  // dumped, so that several clients can dump one collection in parallel
   DumpResult dumpJson(TRI_vocbase_t& vocbase, std::string const& cname,
-                      basics::StringBuffer&, uint64_t chunkSize);
+                      basics::StringBuffer&, uint64_t chunkSize,
+                      size_t range = 0, size_t numRanges = 1);
 
   // iterates over at most 'limit' documents in the collection specified,
   // creating a new iterator if one does not exist for this collection
   DumpResult dumpVPack(TRI_vocbase_t& vocbase, std::string const& cname,
-                       velocypack::Buffer<uint8_t>& buffer, uint64_t chunkSize);
+                       velocypack::Buffer<uint8_t>& buffer, uint64_t chunkSize,
+                       size_t range = 0, size_t numRanges = 1);
 
   // ==================== Incremental Sync ===========================
 
@@ -183,6 +199,12 @@ class RocksDBReplicationContext {
   arangodb::Result dumpKeys(TRI_vocbase_t& vocbase, TRI_voc_cid_t cid,
                             velocypack::Builder& outBuilder, size_t chunk,
                             size_t chunkSize, std::string const& lowKey);
+  /// dump low key, high key and hash of the sub chunks of subChunkSize keys
+  /// of a chunk, so that the client can narrow down the keys that differ
+  arangodb::Result dumpKeyHashes(TRI_vocbase_t& vocbase, TRI_voc_cid_t cid,
+                                 velocypack::Builder& outBuilder, size_t chunk,
+                                 size_t chunkSize, std::string const& lowKey,
+                                 size_t subChunkSize);
   /// dump keys and document
   arangodb::Result dumpDocuments(TRI_vocbase_t& vocbase, TRI_voc_cid_t cid,
                                  velocypack::Builder& b, size_t chunk,
@@ -211,7 +233,8 @@ class RocksDBReplicationContext {
   void lazyCreateSnapshot();
 
   CollectionIterator* getCollectionIterator(TRI_vocbase_t& vocbase, TRI_voc_cid_t cid,
-                                            bool sorted, bool allowCreate);
+                                            bool sorted, bool allowCreate,
+                                            size_t range = 0, size_t numRanges = 1);
 
   void releaseDumpIterator(CollectionIterator*);
 
@@ -222,7 +245,8 @@ class RocksDBReplicationContext {
 
   uint64_t _snapshotTick;  // tick in WAL from _snapshot
   rocksdb::Snapshot const* _snapshot;
-  std::map<TRI_voc_cid_t, std::unique_ptr<CollectionIterator>> _iterators;
+  /// @brief iterators by collection and key range, see CollectionIterator::range
+  std::map<std::pair<TRI_voc_cid_t, size_t>, std::unique_ptr<CollectionIterator>> _iterators;
 
   double const _ttl;
   /// @brief expiration time, updated under lock by ReplicationManager
@@ -280,6 +280,15 @@ bool RocksDBReplicationManager::containsUsedContext() {
   return false;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not there are any contexts, used or not
+////////////////////////////////////////////////////////////////////////////////
+
+bool RocksDBReplicationManager::hasContexts() {
+  MUTEX_LOCKER(mutexLocker, _lock);
+  return !_contexts.empty();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief drop contexts by database (at least mark them as deleted)
 ////////////////////////////////////////////////////////////////////////////////
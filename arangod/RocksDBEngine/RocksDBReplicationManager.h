@@ -114,6 +114,12 @@ class RocksDBReplicationManager {
 
   void beginShutdown();
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief whether or not there are any contexts, used or not
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool hasContexts();
+
  private:
   //////////////////////////////////////////////////////////////////////////////
   /// @brief return a context for garbage collection
@@ -25,6 +25,7 @@
 #include "Basics/StaticStrings.h"
 #include "Logger/Logger.h"
 #include "Replication/common-defines.h"
+#include "RocksDBEngine/RocksDBCollection.h"
 #include "RocksDBEngine/RocksDBColumnFamily.h"
 #include "RocksDBEngine/RocksDBCommon.h"
 #include "RocksDBEngine/RocksDBLogValue.h"
@@ -111,7 +112,6 @@ class WALParser final : public rocksdb::WriteBatch::Handler {
   WALParser(TRI_vocbase_t* vocbase, bool includeSystem,
             TRI_voc_cid_t collectionId, VPackBuilder& builder)
       : _definitionsCF(RocksDBColumnFamily::definitions()->GetID()),
-        _documentsCF(RocksDBColumnFamily::documents()->GetID()),
         _primaryCF(RocksDBColumnFamily::primary()->GetID()),
 
         _vocbase(vocbase),
@@ -389,7 +389,7 @@ class WALParser final : public rocksdb::WriteBatch::Handler {
       // reset everything immediately after DDL operations
       resetTransientState();
 
-    } else if (column_family_id == _documentsCF) {
+    } else if (RocksDBColumnFamily::isDocuments(column_family_id)) {
       if (_state != TRANSACTION && _state != SINGLE_PUT) {
         resetTransientState();
         return rocksdb::Status();
@@ -409,6 +409,7 @@ class WALParser final : public rocksdb::WriteBatch::Handler {
 
       LogicalCollection* col = loadCollection(cid);
       TRI_ASSERT(col != nullptr);
+      std::string valueBuffer;
       {
         VPackObjectBuilder marker(&_builder, true);
         marker->add("tick", VPackValue(std::to_string(_currentSequence)));
@@ -417,7 +418,7 @@ class WALParser final : public rocksdb::WriteBatch::Handler {
         marker->add("tid", VPackValue(std::to_string(_currentTrxId)));
         marker->add("cid", VPackValue(std::to_string(cid)));
         marker->add("cname", VPackValue(col->name()));
-        marker->add("data", RocksDBValue::data(value));
+        marker->add("data", toRocksDBCollection(*col)->documentFromValue(value, valueBuffer));
       }
       updateLastEmittedTick(_currentSequence);
 
@@ -600,7 +601,6 @@ class WALParser final : public rocksdb::WriteBatch::Handler {
 
  private:
   uint32_t const _definitionsCF;
-  uint32_t const _documentsCF;
   uint32_t const _primaryCF;
 
   // these parameters are relevant to determine if we can print
@@ -97,6 +97,8 @@ void RocksDBRestReplicationHandler::handleCommandBatch() {
     b.add(VPackValue(VPackValueType::Object));
     b.add("id", VPackValue(std::to_string(ctx->id())));  // id always string
     b.add("lastTick", VPackValue(std::to_string(ctx->snapshotTick())));
+    // dumps of this batch can be split into key ranges
+    b.add("dumpRanges", VPackValue(RocksDBReplicationContext::MaxDumpRanges));
     b.close();
 
     generateResult(rest::ResponseCode::OK, b.slice());
@@ -517,10 +519,13 @@ void RocksDBRestReplicationHandler::handleCommandFetchKeys() {
   std::string const& value = _request->value("type", found);
 
   bool keys = true;
+  bool hashes = false;
   if (value == "keys") {
     keys = true;
   } else if (value == "docs") {
     keys = false;
+  } else if (value == "hashes") {
+    hashes = true;
   } else {
     generateError(rest::ResponseCode::BAD, TRI_ERROR_HTTP_BAD_PARAMETER,
                   "invalid 'type' value");
@@ -545,7 +550,21 @@ void RocksDBRestReplicationHandler::handleCommandFetchKeys() {
   VPackBuffer<uint8_t> buffer;
   VPackBuilder builder(buffer, transactionContext->getVPackOptions());
 
-  if (keys) {
+  if (hashes) {
+    uint64_t subChunkSize = _request->parsedValue("subChunkSize", chunkSize);
+    if (subChunkSize < 100 || subChunkSize > chunkSize) {
+      generateError(rest::ResponseCode::BAD, TRI_ERROR_HTTP_BAD_PARAMETER,
+                    "invalid 'subChunkSize' value");
+      return;
+    }
+    Result rv = ctx->dumpKeyHashes(_vocbase, cid, builder, chunk,
+                                   static_cast<size_t>(chunkSize), lowKey,
+                                   static_cast<size_t>(subChunkSize));
+    if (rv.fail()) {
+      generateError(rv);
+      return;
+    }
+  } else if (keys) {
     Result rv = ctx->dumpKeys(_vocbase, cid, builder, chunk,
                               static_cast<size_t>(chunkSize), lowKey);
     if (rv.fail()) {
@@ -669,6 +688,21 @@ void RocksDBRestReplicationHandler::handleCommandDump() {
     return;
   }
 
+  // a dump may be split into several key ranges, which are fetched
+  // independently of each other
+  size_t numRanges = 1;
+  size_t range = 0;
+  std::string const& rangesString = _request->value("ranges", found);
+  if (found) {
+    numRanges = static_cast<size_t>(StringUtils::uint64(rangesString));
+    range = static_cast<size_t>(StringUtils::uint64(_request->value("range")));
+    if (numRanges == 0 || numRanges > RocksDBReplicationContext::MaxDumpRanges || range >= numRanges) {
+      generateError(rest::ResponseCode::BAD, TRI_ERROR_HTTP_BAD_PARAMETER,
+                    "replication dump - invalid key range");
+      return;
+    }
+  }
+
   uint64_t chunkSize = determineChunkSize();
   size_t reserve = std::max<size_t>(chunkSize, 8192);
 
@@ -677,7 +711,7 @@ void RocksDBRestReplicationHandler::handleCommandDump() {
     VPackBuffer<uint8_t> buffer;
     buffer.reserve(reserve);  // avoid reallocs
 
-    res = ctx->dumpVPack(_vocbase, cname, buffer, chunkSize);
+    res = ctx->dumpVPack(_vocbase, cname, buffer, chunkSize, range, numRanges);
     // generate the result
     if (res.fail()) {
       generateError(res.result());
@@ -706,7 +740,7 @@ void RocksDBRestReplicationHandler::handleCommandDump() {
     }
 
     // do the work!
-    res = ctx->dumpJson(_vocbase, cname, dump, determineChunkSize());
+    res = ctx->dumpJson(_vocbase, cname, dump, chunkSize, range, numRanges);
 
     if (res.fail()) {
       if (res.is(TRI_ERROR_BAD_PARAMETER)) {
@@ -0,0 +1,136 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "RocksDBSnapshotThread.h"
+#include "Basics/ConditionLocker.h"
+#include "Basics/Exceptions.h"
+#include "Basics/HybridLogicalClock.h"
+#include "Basics/MutexLocker.h"
+#include "Logger/Logger.h"
+#include "Transaction/Options.h"
+#include "VocBase/ticks.h"
+
+#include <rocksdb/db.h>
+
+#include <algorithm>
+
+using namespace arangodb;
+
+RocksDBSnapshotThread::RocksDBSnapshotThread(rocksdb::DB* db,
+                                             std::chrono::milliseconds retention)
+    : Thread("RocksDBSnapshot"), _db(db), _retention(retention), _expiredUpTo(0) {}
+
+RocksDBSnapshotThread::~RocksDBSnapshotThread() { shutdown(); }
+
+void RocksDBSnapshotThread::beginShutdown() {
+  Thread::beginShutdown();
+
+  // wake up the thread that may be waiting in run()
+  CONDITION_LOCKER(guard, _condition);
+  guard.broadcast();
+}
+
+std::shared_ptr<rocksdb::Snapshot const> RocksDBSnapshotThread::snapshotAt(uint64_t timestamp) {
+  TRI_HybridLogicalClock(timestamp);
+
+  MUTEX_LOCKER(locker, _lock);
+  if (timestamp <= _expiredUpTo) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_BAD_PARAMETER,
+                                   "snapshot timestamp is too old");
+  }
+
+  auto it = std::lower_bound(_snapshots.begin(), _snapshots.end(), timestamp,
+                             [](Entry const& entry, uint64_t value) {
+                               return entry.timestamp < value;
+                             });
+  if (it != _snapshots.end()) {
+    return it->snapshot;
+  }
+  // the grid point has not been passed locally before. the snapshot taken
+  // now is shared with all other reads as of the same timestamp
+  return appendSnapshot();
+}
+
+void RocksDBSnapshotThread::takeSnapshot() {
+  uint64_t const now = basics::HybridLogicalClock::extractTime(TRI_HybridLogicalClock());
+  uint64_t const retention = static_cast<uint64_t>(_retention.count());
+  uint64_t const cutoff =
+      basics::HybridLogicalClock::assembleTimeStamp(now > retention ? now - retention : 0, 0);
+
+  std::deque<Entry> expired;
+  {
+    MUTEX_LOCKER(locker, _lock);
+    appendSnapshot();
+    while (!_snapshots.empty() && _snapshots.front().timestamp < cutoff) {
+      _expiredUpTo = _snapshots.front().timestamp;
+      expired.emplace_back(std::move(_snapshots.front()));
+      _snapshots.pop_front();
+    }
+  }
+  // the snapshots are released outside the lock, if nobody uses them anymore
+}
+
+std::shared_ptr<rocksdb::Snapshot const> RocksDBSnapshotThread::appendSnapshot() {
+  _lock.assertLockedByCurrentThread();
+
+  if (!_snapshots.empty() &&
+      _snapshots.back().snapshot->GetSequenceNumber() == _db->GetLatestSequenceNumber()) {
+    // nothing was written since the last snapshot, so it is reused
+    _snapshots.emplace_back(Entry{TRI_HybridLogicalClock(), _snapshots.back().snapshot});
+    return _snapshots.back().snapshot;
+  }
+
+  rocksdb::DB* db = _db;
+  std::shared_ptr<rocksdb::Snapshot const> snapshot(
+      db->GetSnapshot(), [db](rocksdb::Snapshot const* s) { db->ReleaseSnapshot(s); });
+  // the timestamp is taken under the lock, so timestamps are ascending
+  _snapshots.emplace_back(Entry{TRI_HybridLogicalClock(), snapshot});
+  return snapshot;
+}
+
+void RocksDBSnapshotThread::run() {
+  uint64_t const interval = transaction::Options::snapshotGridInterval;
+
+  while (!isStopping()) {
+    try {
+      // wait until the clock passes the next grid point
+      uint64_t const now =
+          basics::HybridLogicalClock::extractTime(TRI_HybridLogicalClock());
+      uint64_t const next = (now / interval + 1) * interval;
+      {
+        CONDITION_LOCKER(guard, _condition);
+        guard.wait(std::chrono::microseconds((next - now) * 1000));
+      }
+      if (isStopping()) {
+        break;
+      }
+      takeSnapshot();
+    } catch (std::exception const& ex) {
+      LOG_TOPIC("2ddcd", ERR, Logger::ENGINES)
+          << "caught exception in RocksDBSnapshotThread: " << ex.what();
+    } catch (...) {
+      LOG_TOPIC("20131", ERR, Logger::ENGINES)
+          << "caught unknown exception in RocksDBSnapshotThread";
+    }
+  }
+
+  MUTEX_LOCKER(locker, _lock);
+  _snapshots.clear();
+}
@@ -0,0 +1,94 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_ROCKSDB_ENGINE_SNAPSHOT_THREAD_H
+#define ARANGOD_ROCKSDB_ENGINE_SNAPSHOT_THREAD_H 1
+
+#include "Basics/Common.h"
+#include "Basics/ConditionVariable.h"
+#include "Basics/Mutex.h"
+#include "Basics/Thread.h"
+
+#include <chrono>
+#include <deque>
+#include <memory>
+
+namespace rocksdb {
+class DB;
+class Snapshot;
+}  // namespace rocksdb
+
+namespace arangodb {
+
+/// @brief maps points of the hybrid logical clock to RocksDB snapshots.
+/// the thread takes a snapshot whenever the clock passes a multiple of
+/// the snapshot grid interval and keeps it for a while, so that all shards
+/// of a cluster query can read as of the same timestamp
+class RocksDBSnapshotThread final : public Thread {
+ public:
+  RocksDBSnapshotThread(rocksdb::DB* db, std::chrono::milliseconds retention);
+
+  ~RocksDBSnapshotThread();
+
+  void beginShutdown() override;
+
+  /// @brief the first snapshot taken at or after the given timestamp. if
+  /// there is none yet, a snapshot is taken right away. the local clock is
+  /// advanced past the timestamp, so all later snapshots are taken after
+  /// it as well. throws if the snapshots of the timestamp have expired
+  std::shared_ptr<rocksdb::Snapshot const> snapshotAt(uint64_t timestamp);
+
+  /// @brief take a snapshot of the current state, and drop the snapshots
+  /// that have expired
+  void takeSnapshot();
+
+ protected:
+  void run() override;
+
+ private:
+  struct Entry {
+    uint64_t timestamp;
+    std::shared_ptr<rocksdb::Snapshot const> snapshot;
+  };
+
+  /// @brief append a snapshot of the current state, _lock must be held
+  std::shared_ptr<rocksdb::Snapshot const> appendSnapshot();
+
+  rocksdb::DB* _db;
+
+  /// @brief how long snapshots are kept
+  std::chrono::milliseconds const _retention;
+
+  /// @brief protects _snapshots and _expiredUpTo
+  Mutex _lock;
+
+  /// @brief snapshots, ordered by timestamp
+  std::deque<Entry> _snapshots;
+
+  /// @brief timestamp of the latest dropped snapshot. reads as of it or
+  /// earlier cannot be served anymore
+  uint64_t _expiredUpTo;
+
+  /// @brief wakes up the thread on shutdown
+  basics::ConditionVariable _condition;
+};
+}  // namespace arangodb
+
+#endif
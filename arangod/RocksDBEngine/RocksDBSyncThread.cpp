@@ -22,6 +22,7 @@
 
 #include "RocksDBSyncThread.h"
 #include "Basics/ConditionLocker.h"
+#include "Basics/Exceptions.h"
 #include "Basics/RocksDBUtils.h"
 #include "Logger/Logger.h"
 #include "RocksDBEngine/RocksDBEngine.h"
@@ -36,11 +37,13 @@ RocksDBSyncThread::RocksDBSyncThread(RocksDBEngine* engine, std::chrono::millise
       _engine(engine),
       _interval(interval),
       _lastSyncTime(std::chrono::steady_clock::now()),
-      _lastSequenceNumber(0) {}
+      _lastSequenceNumber(0),
+      _syncedSequenceNumber(0),
+      _syncInProgress(false) {}
 
 RocksDBSyncThread::~RocksDBSyncThread() { shutdown(); }
 
-Result RocksDBSyncThread::syncWal() {
+Result RocksDBSyncThread::syncWal(rocksdb::SequenceNumber seq) {
   // note the following line in RocksDB documentation (rocksdb/db.h):
   // > Currently only works if allow_mmap_writes = false in Options.
   TRI_ASSERT(!_engine->rocksDBOptions().allow_mmap_writes);
@@ -49,6 +52,7 @@ Result RocksDBSyncThread::syncWal() {
 
   // set time of last syncing under the lock
   auto const now = std::chrono::steady_clock::now();
+  auto lastSequenceNumber = db->GetLatestSequenceNumber();
   {
     CONDITION_LOCKER(guard, _condition);
 
@@ -57,16 +61,54 @@ Result RocksDBSyncThread::syncWal() {
       _lastSyncTime = now;
     }
 
-    auto lastSequenceNumber = db->GetLatestSequenceNumber();
-
     if (lastSequenceNumber > _lastSequenceNumber) {
       // update last sequence number
       _lastSequenceNumber = lastSequenceNumber;
     }
   }
 
+  if (seq == 0 || seq > lastSequenceNumber) {
+    seq = lastSequenceNumber;
+  }
+
   // actual syncing is done without holding the lock
-  return sync(db);
+  return syncUpTo(db, seq);
+}
+
+Result RocksDBSyncThread::syncUpTo(rocksdb::DB* db, rocksdb::SequenceNumber seq) {
+  CONDITION_LOCKER(guard, _groupCondition);
+
+  while (_syncedSequenceNumber < seq) {
+    if (_syncInProgress) {
+      // somebody else is syncing. if our data was in the WAL before that
+      // sync started we are covered, otherwise the next sync covers us
+      // together with everybody else who arrived in the meantime
+      guard.wait();
+      continue;
+    }
+
+    // we are the leader of this group. everything with a sequence number up
+    // to target has been written to the WAL already and will be synced
+    _syncInProgress = true;
+    rocksdb::SequenceNumber const target = db->GetLatestSequenceNumber();
+
+    guard.unlock();
+    Result res = basics::catchToResult([&]() -> Result { return sync(db); });
+    guard.lock();
+
+    _syncInProgress = false;
+    if (res.ok() && target > _syncedSequenceNumber) {
+      _syncedSequenceNumber = target;
+    }
+    // wake up the group. if we failed, one of the waiters will retry
+    guard.broadcast();
+
+    if (res.fail()) {
+      return res;
+    }
+  }
+
+  return Result();
 }
 
 Result RocksDBSyncThread::sync(rocksdb::DB* db) {
@@ -133,8 +175,9 @@ void RocksDBSyncThread::run() {
         _lastSequenceNumber = lastSequenceNumber;
       }
 
-      // will update last sync time, and do the actual sync
-      Result res = sync(db);
+      // will update last sync time, and do the actual sync. foreground
+      // committers waiting for a sync are released by this as well
+      Result res = syncUpTo(db, db->GetLatestSequenceNumber());
 
       if (res.fail()) {
         LOG_TOPIC("5e275", WARN, Logger::ENGINES)
@@ -50,8 +50,12 @@ class RocksDBSyncThread final : public Thread {
 
   /// @brief updates last sync time and calls the synchronization
   /// this is the preferred method to call when trying to avoid redundant
-  /// syncs by foreground work and the background sync thread
-  Result syncWal();
+  /// syncs by foreground work and the background sync thread.
+  /// concurrent callers are group-committed: while one caller syncs, the
+  /// others wait, and the next sync covers all of them at once. a caller
+  /// returns as soon as the WAL is synced up to seq (0 means everything
+  /// written so far)
+  Result syncWal(rocksdb::SequenceNumber seq = 0);
 
   /// @brief unconditionally syncs the RocksDB WAL, static variant
   static Result sync(rocksdb::DB* db);
@@ -60,6 +64,9 @@ class RocksDBSyncThread final : public Thread {
   void run() override;
 
  private:
+  /// @brief sync the WAL at least up to seq, joining an ongoing sync
+  Result syncUpTo(rocksdb::DB* db, rocksdb::SequenceNumber seq);
+
   RocksDBEngine* _engine;
 
   /// @brief the sync interval
@@ -73,6 +80,16 @@ class RocksDBSyncThread final : public Thread {
 
   /// @brief protects _lastSyncTime and _lastSequenceNumber
   arangodb::basics::ConditionVariable _condition;
+
+  /// @brief the WAL is known to be synced up to this sequence number
+  rocksdb::SequenceNumber _syncedSequenceNumber;
+
+  /// @brief whether some thread is currently syncing the WAL
+  bool _syncInProgress;
+
+  /// @brief protects _syncedSequenceNumber and _syncInProgress, waiters for
+  /// an ongoing sync wait on it
+  arangodb::basics::ConditionVariable _groupCondition;
 };
 }  // namespace arangodb
 
@@ -47,6 +47,11 @@
 #include "Basics/MutexLocker.h"
 #include "Logger/Logger.h"
 
+#include <thread>
+
+#include <velocypack/Value.h>
+#include <velocypack/velocypack-aliases.h>
+
 namespace arangodb {
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -107,7 +112,10 @@ RocksDBThrottle::RocksDBThrottle()
       _threadRunning(false),
       _replaceIdx(2),
       _throttleBps(0),
-      _firstThrottle(true) {
+      _firstThrottle(true),
+      _backlog(0),
+      _lowPriorityDelays(0),
+      _lowPriorityDelayMicros(0) {
   memset(&_throttleData, 0, sizeof(_throttleData));
 }
 
@@ -179,6 +187,9 @@ void RocksDBThrottle::OnFlushCompleted(rocksdb::DB* db,
     std::call_once(_initFlag, &RocksDBThrottle::Startup, this, db);
   }  // if
 
+  // keep the backlog current for low-priority writers
+  UpdateBacklog();
+
 }  // RocksDBThrottle::OnFlushCompleted
 
 void RocksDBThrottle::OnCompactionCompleted(rocksdb::DB* db,
@@ -195,6 +206,9 @@ void RocksDBThrottle::OnCompactionCompleted(rocksdb::DB* db,
   //  "setcap" on the arangod binary for it to even matter, see comments at top)
   RocksDBThrottle::AdjustThreadPriority((0 == ci.base_input_level) ? 2 : 3);
 
+  // keep the backlog current for low-priority writers
+  UpdateBacklog();
+
 }  // RocksDBThrottle::OnCompactionCompleted
 
 void RocksDBThrottle::Startup(rocksdb::DB* db) {
@@ -451,6 +465,7 @@ int64_t RocksDBThrottle::ComputeBacklog() {
   bool ret_flag;
   std::string ret_string, property_name;
   int temp;
+  std::vector<FamilyState_t> family_state;
 
   // want count of level 0 files to estimate if compactions "behind"
   //  and therefore likely to start stalling / stopping
@@ -462,8 +477,26 @@ int64_t RocksDBThrottle::ComputeBacklog() {
     imm_trigger = 3;
   }  // else
 
+  {
+    // reuse the (static) names and limits of the previous run
+    MUTEX_LOCKER(mutexLocker, _familyMutex);
+    family_state = _familyState;
+  }  // lock
+
+  if (family_state.size() != _families.size()) {
+    family_state.clear();
+    for (auto& cf : _families) {
+      family_state.emplace_back(FamilyState_t{
+          cf->GetName(), 0, 0, 0,
+          _internalRocksDB->GetOptions(cf).soft_pending_compaction_bytes_limit});
+    }  // for
+  }    // if
+
   // loop through column families to obtain family specific counts
-  for (auto& cf : _families) {
+  for (size_t i = 0; i < _families.size(); ++i) {
+    auto& cf = _families[i];
+    auto& state = family_state[i];
+
     property_name = rocksdb::DB::Properties::kNumFilesAtLevelPrefix;
     property_name.append("0");
     ret_flag = _internalRocksDB->GetProperty(cf, property_name, &ret_string);
@@ -472,6 +505,7 @@ int64_t RocksDBThrottle::ComputeBacklog() {
     } else {
       temp = 0;
     }  // else
+    state._level0Files = temp;
 
     if (kL0_SlowdownWritesTrigger <= temp) {
       temp -= (kL0_SlowdownWritesTrigger - 1);
@@ -487,16 +521,121 @@ int64_t RocksDBThrottle::ComputeBacklog() {
     if (ret_flag) {
       temp = std::stoi(ret_string);
       imm_backlog += temp;
-    }  // if
-  }    // for
+    } else {
+      temp = 0;
+    }  // else
+    state._immutableMemtables = temp;
+
+    // rocksdb starts stalling all writes once a single family reaches its
+    //  soft limit of pending compaction bytes.  Add one point per eighth of
+    //  the limit once half of it is reached, so the throttle (and the
+    //  low-priority writers) kick in earlier
+    uint64_t pending = 0;
+    if (_internalRocksDB->GetIntProperty(cf, rocksdb::DB::Properties::kEstimatePendingCompactionBytes,
+                                         &pending)) {
+      state._pendingCompactionBytes = pending;
+      uint64_t soft_limit = state._softPendingCompactionBytesLimit;
+      if (8 <= soft_limit && soft_limit / 2 < pending) {
+        compaction_backlog +=
+            static_cast<int64_t>((pending - soft_limit / 2) / (soft_limit / 8)) + 1;
+      }  // if
+    }    // if
+  }      // for
 
   if (imm_trigger < imm_backlog) {
     compaction_backlog += (imm_backlog - imm_trigger);
   }  // if
 
+  {
+    MUTEX_LOCKER(mutexLocker, _familyMutex);
+    _familyState = std::move(family_state);
+  }  // lock
+  _backlog.store(compaction_backlog);
+
   return compaction_backlog;
 }  // RocksDBThrottle::Computebacklog
 
+///
+/// @brief Refresh the backlog outside of the regular throttle interval,
+///  called after each flush and compaction
+///
+void RocksDBThrottle::UpdateBacklog() {
+  // using condition variable's mutex to protect _internalRocksDB race
+  CONDITION_LOCKER(guard, _threadCondvar);
+
+  if (nullptr != _internalRocksDB) {
+    try {
+      ComputeBacklog();
+    } catch (...) {
+      // only used for low-priority writers, next interval will catch up
+    }  // try/catch
+  }    // if
+}  // RocksDBThrottle::UpdateBacklog
+
+///
+/// @brief Low-priority writers only get a fraction of the current
+///  throttle rate, which shrinks as the backlog grows
+///
+std::chrono::microseconds RocksDBThrottle::DelayLowPriorityWrite(uint64_t Bytes) {
+  std::chrono::microseconds delay(0);
+  int64_t backlog = _backlog.load();
+
+  if (0 < backlog && 0 < Bytes) {
+    uint64_t rate;
+    {
+      MUTEX_LOCKER(mutexLocker, _threadMutex);
+      rate = _throttleBps;
+    }  // lock
+
+    // no throttle computed yet
+    if (100 < rate) {
+      rate /= static_cast<uint64_t>(backlog + 1);
+      if (0 == rate) rate = 1;
+
+      int64_t micros = static_cast<int64_t>(
+          std::min<uint64_t>((Bytes * 1000000) / rate, kMaxLowPriorityDelayMicros));
+      delay = std::chrono::microseconds(micros);
+
+      if (0 < micros) {
+        std::this_thread::sleep_for(delay);
+        _lowPriorityDelays.fetch_add(1);
+        _lowPriorityDelayMicros.fetch_add(static_cast<uint64_t>(micros));
+      }  // if
+    }    // if
+  }      // if
+
+  return delay;
+}  // RocksDBThrottle::DelayLowPriorityWrite
+
+void RocksDBThrottle::toVelocyPack(velocypack::Builder& builder) {
+  TRI_ASSERT(builder.isOpenObject());
+
+  uint64_t throttle_bps;
+  {
+    MUTEX_LOCKER(mutexLocker, _threadMutex);
+    throttle_bps = _throttleBps;
+  }  // lock
+
+  builder.add("active", VPackValue(_threadRunning.load()));
+  builder.add("throttleBps", VPackValue(throttle_bps));
+  builder.add("backlog", VPackValue(_backlog.load()));
+  builder.add("lowPriorityDelays", VPackValue(_lowPriorityDelays.load()));
+  builder.add("lowPriorityDelayMicros", VPackValue(_lowPriorityDelayMicros.load()));
+
+  MUTEX_LOCKER(mutexLocker, _familyMutex);
+  builder.add("columnFamilies", VPackValue(VPackValueType::Object));
+  for (auto const& state : _familyState) {
+    builder.add(state._name, VPackValue(VPackValueType::Object));
+    builder.add("level0Files", VPackValue(state._level0Files));
+    builder.add("immutableMemtables", VPackValue(state._immutableMemtables));
+    builder.add("pendingCompactionBytes", VPackValue(state._pendingCompactionBytes));
+    builder.add("softPendingCompactionBytesLimit",
+                VPackValue(state._softPendingCompactionBytesLimit));
+    builder.close();
+  }  // for
+  builder.close();
+}  // RocksDBThrottle::toVelocyPack
+
 /// @brief Adjust the active thread's priority to match the work
 ///  it is performing.  The routine is called HEAVILY.
 void RocksDBThrottle::AdjustThreadPriority(int Adjustment) {
@@ -42,6 +42,8 @@
 #include "Basics/ConditionVariable.h"
 #include "Basics/Mutex.h"
 
+#include <velocypack/Builder.h>
+
 // public rocksdb headers
 #include <rocksdb/db.h>
 #include <rocksdb/listener.h>
@@ -87,6 +89,17 @@ class RocksDBThrottle : public rocksdb::EventListener {
 
   void StopThread();
 
+  /// @brief slow down a low-priority write of the given size while
+  ///  compactions are behind, so that bulk writers back off before the
+  ///  global throttle hits all writers.  Returns the applied delay
+  std::chrono::microseconds DelayLowPriorityWrite(uint64_t Bytes);
+
+  /// @brief add the current throttle state to an open object
+  void toVelocyPack(velocypack::Builder& builder);
+
+  /// @brief most recent compaction backlog, 0 if compactions keep up
+  int64_t backlog() const { return _backlog.load(); }
+
  protected:
   void Startup(rocksdb::DB* db);
 
@@ -99,6 +112,8 @@ class RocksDBThrottle : public rocksdb::EventListener {
 
   int64_t ComputeBacklog();
 
+  void UpdateBacklog();
+
   void RecalculateThrottle();
 
   // I am unable to figure out static initialization of std::chrono::seconds,
@@ -116,6 +131,9 @@ class RocksDBThrottle : public rocksdb::EventListener {
   //  (from original Google leveldb db/dbformat.h)
   static constexpr int64_t kL0_SlowdownWritesTrigger = 8;
 
+  // upper bound for a single low-priority write delay
+  static constexpr int64_t kMaxLowPriorityDelayMicros = 1000000;
+
   struct ThrottleData_t {
     std::chrono::microseconds _micros;
     uint64_t _keys;
@@ -123,6 +141,15 @@ class RocksDBThrottle : public rocksdb::EventListener {
     uint64_t _compactions;
   };
 
+  // per column family input of the backlog computation, kept for reporting
+  struct FamilyState_t {
+    std::string _name;
+    int64_t _level0Files;
+    int64_t _immutableMemtables;
+    uint64_t _pendingCompactionBytes;
+    uint64_t _softPendingCompactionBytesLimit;
+  };
+
   rocksdb::DBImpl* _internalRocksDB;
   std::once_flag _initFlag;
   std::atomic<bool> _threadRunning;
@@ -145,6 +172,17 @@ class RocksDBThrottle : public rocksdb::EventListener {
   std::unique_ptr<WriteControllerToken> _delayToken;
   std::vector<rocksdb::ColumnFamilyHandle*> _families;
 
+  // separate from _threadMutex, which is locked before _threadCondvar
+  //  while UpdateBacklog() locks this one after _threadCondvar
+  Mutex _familyMutex;
+  std::vector<FamilyState_t> _familyState;
+
+  // most recent result of ComputeBacklog()
+  std::atomic<int64_t> _backlog;
+
+  std::atomic<uint64_t> _lowPriorityDelays;
+  std::atomic<uint64_t> _lowPriorityDelayMicros;
+
 };  // class RocksDBThrottle
 
 }  // namespace arangodb
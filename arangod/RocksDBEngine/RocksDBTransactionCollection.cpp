@@ -44,7 +44,8 @@ RocksDBTransactionCollection::RocksDBTransactionCollection(TransactionState* trx
       _numInserts(0),
       _numUpdates(0),
       _numRemoves(0),
-      _usageLocked(false) {}
+      _usageLocked(false),
+      _keyRangesLocked(false) {}
 
 RocksDBTransactionCollection::~RocksDBTransactionCollection() = default;
 
@@ -139,6 +140,12 @@ void RocksDBTransactionCollection::unuse(int nestingLevel) {
 }
 
 void RocksDBTransactionCollection::release() {
+  if (_collection != nullptr && AccessMode::isWriteOrExclusive(_accessType)) {
+    // the keys our writes registered, the documents are committed by now
+    auto physical = static_cast<RocksDBCollection*>(_collection->getPhysical());
+    physical->keyRangeLocks().unlock(_transaction->id());
+  }
+
   // questionable, but seems to work
   if (_transaction->hasHint(transaction::Hints::Hint::LOCK_NEVER) ||
       _transaction->hasHint(transaction::Hints::Hint::NO_USAGE_LOCK)) {
@@ -220,6 +227,8 @@ void RocksDBTransactionCollection::commitCounts(TRI_voc_tid_t trxId, uint64_t co
     coll->adjustNumberDocuments(_revision, adjustment);  // update online count
     coll->meta().adjustNumberDocuments(commitSeq, _revision,
                                        adjustment);  // buffer for recovery
+    // the modification is visible now
+    _collection->bumpInvalidationTick();
   }
 
   // Update the index estimates.
@@ -301,6 +310,13 @@ int RocksDBTransactionCollection::doLock(AccessMode::Type type, int nestingLevel
     res = physical->lockRead(timeout);
   }
 
+  if (res == TRI_ERROR_NO_ERROR && AccessMode::isWrite(type)) {
+    res = lockKeyRanges(physical, timeout);
+    if (res != TRI_ERROR_NO_ERROR) {
+      physical->unlockRead();
+    }
+  }
+
   if (res == TRI_ERROR_NO_ERROR) {
     _lockType = type;
     // not an error, but we use TRI_ERROR_LOCKED to indicate that we actually
@@ -318,6 +334,37 @@ int RocksDBTransactionCollection::doLock(AccessMode::Type type, int nestingLevel
   return res;
 }
 
+/// @brief locks the key ranges given for the collection in the transaction
+/// options, while the collection itself is only locked in shared mode
+int RocksDBTransactionCollection::lockKeyRanges(RocksDBCollection* physical, double timeout) {
+  auto const& prefixes = _transaction->options().lockKeyPrefixes;
+  auto it = prefixes.find(_collection->name());
+  if (it == prefixes.end() || it->second.empty()) {
+    return TRI_ERROR_NO_ERROR;
+  }
+
+  std::vector<RocksDBKeyRangeLocks::Range> ranges;
+  ranges.reserve(it->second.size());
+  for (auto const& prefix : it->second) {
+    ranges.emplace_back(RocksDBKeyRangeLocks::prefixRange(prefix));
+  }
+  if (timeout <= 0.0) {
+    timeout = transaction::Options::defaultLockTimeout;
+  }
+
+  LOG_TRX("8d3a2", TRACE, _transaction, _nestingLevel)
+      << "locking " << ranges.size() << " key range(s) of collection " << _cid;
+  int res = physical->keyRangeLocks().lock(_transaction->id(), ranges, timeout);
+  if (res == TRI_ERROR_NO_ERROR) {
+    _keyRangesLocked = true;
+  } else if (timeout >= 0.1) {
+    LOG_TOPIC("c0b47", WARN, Logger::QUERIES)
+        << "timed out after " << timeout << " s waiting for key range locks "
+        << "on collection '" << _collection->name() << "'";
+  }
+  return res;
+}
+
 /// @brief unlock a collection
 int RocksDBTransactionCollection::doUnlock(AccessMode::Type type, int nestingLevel) {
   if (!AccessMode::isWriteOrExclusive(type) || !AccessMode::isWriteOrExclusive(_lockType)) {
@@ -363,6 +410,10 @@ int RocksDBTransactionCollection::doUnlock(AccessMode::Type type, int nestingLev
   } else {
     // write locking means we'll be releasing the collection's RW lock in read
     // mode
+    if (_keyRangesLocked) {
+      physical->keyRangeLocks().unlock(_transaction->id());
+      _keyRangesLocked = false;
+    }
     physical->unlockRead();
   }
 
@@ -30,6 +30,7 @@
 #include "VocBase/voc-types.h"
 
 namespace arangodb {
+class RocksDBCollection;
 struct RocksDBDocumentOperation;
 namespace transaction {
 class Methods;
@@ -116,6 +117,10 @@ class RocksDBTransactionCollection final : public TransactionCollection {
   /// @brief request an unlock for a collection
   int doUnlock(AccessMode::Type, int nestingLevel) override;
 
+  /// @brief lock the key ranges of the transaction options for a write
+  /// collection
+  int lockKeyRanges(RocksDBCollection* physical, double timeout);
+
  private:
   uint64_t _initialNumberDocuments;
   TRI_voc_rid_t _revision;
@@ -123,6 +128,7 @@ class RocksDBTransactionCollection final : public TransactionCollection {
   uint64_t _numUpdates;
   uint64_t _numRemoves;
   bool _usageLocked;
+  bool _keyRangesLocked;
 
   /// @brief A list where all indexes with estimates can store their operations
   ///        Will be applied to the inserter on commit and not applied on abort
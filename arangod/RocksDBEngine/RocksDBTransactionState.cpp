@@ -25,25 +25,39 @@
 
 #include "Aql/QueryCache.h"
 #include "Basics/Exceptions.h"
+#include "Basics/FileUtils.h"
+#include "Basics/files.h"
 #include "Cache/CacheManagerFeature.h"
 #include "Cache/Manager.h"
 #include "Cache/Transaction.h"
+#include "Cluster/FollowerInfo.h"
+#include "Cluster/ServerState.h"
 #include "Logger/Logger.h"
+#include "Replication/ReplicationClients.h"
+#include "Replication/ReplicationFeature.h"
+#include "RestServer/SystemDatabaseFeature.h"
 #include "RocksDBEngine/RocksDBCollection.h"
 #include "RocksDBEngine/RocksDBCommon.h"
 #include "RocksDBEngine/RocksDBEngine.h"
+#include "RocksDBEngine/RocksDBIndex.h"
 #include "RocksDBEngine/RocksDBLogValue.h"
 #include "RocksDBEngine/RocksDBMethods.h"
+#include "RocksDBEngine/RocksDBReplicationManager.h"
+#include "RocksDBEngine/RocksDBSettingsManager.h"
+#include "RocksDBEngine/RocksDBSnapshotThread.h"
 #include "RocksDBEngine/RocksDBSyncThread.h"
 #include "RocksDBEngine/RocksDBTransactionCollection.h"
 #include "StorageEngine/EngineSelectorFeature.h"
 #include "StorageEngine/StorageEngine.h"
+#include "Statistics/Tracing.h"
 #include "StorageEngine/TransactionCollection.h"
 #include "Transaction/Context.h"
+#include "Transaction/Helpers.h"
 #include "Transaction/Manager.h"
 #include "Transaction/ManagerFeature.h"
 #include "Transaction/Methods.h"
 #include "Utils/ExecContext.h"
+#include "VocBase/DatabaseQuota.h"
 #include "VocBase/LogicalCollection.h"
 #include "VocBase/ticks.h"
 
@@ -66,6 +80,8 @@ RocksDBTransactionState::RocksDBTransactionState(TRI_vocbase_t& vocbase, TRI_voc
       _numInserts(0),
       _numUpdates(0),
       _numRemoves(0),
+      _numIntermediateCommits(0),
+      _hasUnrevertedFailure(false),
       _parallel(false) {}
 
 /// @brief free a transaction container
@@ -83,6 +99,18 @@ Result RocksDBTransactionState::beginTransaction(transaction::Hints hints) {
 
   if (nestingLevel() == 0) {
     _hints = hints;  // set hints before useCollections
+
+    RocksDBSnapshotThread* snapshots = rocksutils::globalRocksEngine()->snapshotThread();
+    if (isReadOnlyTransaction() && !isSingleOperation() &&
+        _options.snapshotTimestamp != 0 && snapshots != nullptr) {
+      // read as of the timestamp the coordinator chose for all shards
+      try {
+        _historicSnapshot = snapshots->snapshotAt(_options.snapshotTimestamp);
+      } catch (basics::Exception const& ex) {
+        updateStatus(transaction::Status::ABORTED);
+        return Result(ex.code(), ex.what());
+      }
+    }
   }
 
   Result result = useCollections(nestingLevel());
@@ -115,11 +143,18 @@ Result RocksDBTransactionState::beginTransaction(transaction::Hints hints) {
 
     rocksdb::TransactionDB* db = rocksutils::globalRocksDB();
     _rocksReadOptions.prefix_same_as_start = true;  // should always be true
+    if (hasHint(transaction::Hints::Hint::NO_BLOCKING_READ)) {
+      // memtables and block cache only, everything else is reported as
+      // an incomplete read
+      _rocksReadOptions.read_tier = rocksdb::kBlockCacheTier;
+    }
 
     TRI_ASSERT(_readSnapshot == nullptr);
     if (isReadOnlyTransaction()) {
       // no need to acquire a snapshot for a single op
-      if (!isSingleOperation()) {
+      if (_historicSnapshot != nullptr) {
+        _rocksReadOptions.snapshot = _historicSnapshot.get();
+      } else if (!isSingleOperation()) {
         _readSnapshot = db->GetSnapshot();  // must call ReleaseSnapshot later
         TRI_ASSERT(_readSnapshot != nullptr);
         _rocksReadOptions.snapshot = _readSnapshot;
@@ -135,7 +170,12 @@ Result RocksDBTransactionState::beginTransaction(transaction::Hints hints) {
         TRI_ASSERT(_readSnapshot != nullptr);
       }
 
-      _rocksMethods.reset(new RocksDBTrxMethods(this));
+      if (RocksDBOptimisticKeys::useFor(_options.optimisticConcurrency,
+                                        isOnlyExclusiveTransaction())) {
+        _rocksMethods.reset(new RocksDBOptimisticTrxMethods(this));
+      } else {
+        _rocksMethods.reset(new RocksDBTrxMethods(this));
+      }
       if (hasHint(transaction::Hints::Hint::NO_INDEXING)) {
         // do not track our own writes... we can only use this in very
         // specific scenarios, i.e. when we are sure that we will have a
@@ -199,10 +239,14 @@ void RocksDBTransactionState::createTransaction() {
 
   TRI_ASSERT(_rocksTransaction == nullptr ||
              _rocksTransaction->GetState() == rocksdb::Transaction::COMMITED ||
+             (_rocksTransaction->GetState() == rocksdb::Transaction::ROLLEDBACK &&
+              hasHint(transaction::Hints::Hint::BULK_LOAD)) ||
              (_rocksTransaction->GetState() == rocksdb::Transaction::STARTED &&
               _rocksTransaction->GetNumKeys() == 0));
   rocksdb::WriteOptions wo;
   _rocksTransaction = db->BeginTransaction(wo, trxOpts, _rocksTransaction);
+  // keys of an earlier intermediate commit are validated already
+  _optimisticKeys.clear();
 
   // add transaction begin marker
   if (!hasHint(transaction::Hints::Hint::SINGLE_OPERATION)) {
@@ -232,6 +276,7 @@ void RocksDBTransactionState::cleanupTransaction() noexcept {
     db->ReleaseSnapshot(_readSnapshot);  // calls delete
     _readSnapshot = nullptr;
   }
+  _historicSnapshot.reset();
 }
 
 arangodb::Result RocksDBTransactionState::internalCommit() {
@@ -248,6 +293,17 @@ arangodb::Result RocksDBTransactionState::internalCommit() {
 
   Result result;
   if (hasOperations()) {  // might not have ops for fillIndex
+    uint64_t const writeSize = _rocksTransaction->GetWriteBatch()->GetWriteBatch()->GetDataSize();
+    if (hasHint(transaction::Hints::Hint::LOW_PRIORITY)) {
+      // bulk writers back off first while compactions are behind
+      rocksutils::globalRocksEngine()->delayLowPriorityWrite(writeSize);
+    }
+    if (!hasHint(transaction::Hints::Hint::RECOVERY) &&
+        !transaction::isFollowerTransactionId(id())) {
+      // the leader was throttled already
+      _vocbase.quota().throttleWrite(writeSize);
+    }
+
     // we are actually going to attempt a commit
     if (!hasHint(transaction::Hints::Hint::SINGLE_OPERATION)) {
       // add custom commit marker to increase WAL tailing reliability
@@ -307,19 +363,31 @@ arangodb::Result RocksDBTransactionState::internalCommit() {
     }
 #endif
 
-    // total number of sequence ID consuming records
-    uint64_t numOps = _rocksTransaction->GetNumPuts() +
-                      _rocksTransaction->GetNumDeletes() +
-                      _rocksTransaction->GetNumMerges();
-    // will invalidate all counts
-    result = rocksutils::convertStatus(_rocksTransaction->Commit());
+    // total number of sequence ID consuming records. counted in the batch,
+    // because optimistic writes do not go through the transaction's methods
+    uint64_t numOps = _rocksTransaction->GetWriteBatch()->GetWriteBatch()->Count();
+    bool ingested = false;
+    result = _optimisticKeys.validate(_rocksTransaction);
+    if (result.ok() && hasHint(transaction::Hints::Hint::BULK_LOAD)) {
+      result = ingestWriteBatch(ingested);
+    }
+    if (result.ok() && !ingested) {
+      // will invalidate all counts
+      result = rocksutils::convertStatus(_rocksTransaction->Commit());
+    }
 
     if (result.ok()) {
       TRI_ASSERT(numOps > 0);  // simon: should hold unless we're being stupid
-      rocksdb::SequenceNumber postCommitSeq = _rocksTransaction->GetId();
-      TRI_ASSERT(postCommitSeq != 0);
-      if (ADB_LIKELY(numOps > 0)) {
-        postCommitSeq += numOps - 1;  // add to get to the next batch
+      rocksdb::SequenceNumber postCommitSeq;
+      if (ingested) {
+        // the ingested files got the latest sequence number
+        postCommitSeq = rocksutils::globalRocksDB()->GetLatestSequenceNumber();
+      } else {
+        postCommitSeq = _rocksTransaction->GetId();
+        TRI_ASSERT(postCommitSeq != 0);
+        if (ADB_LIKELY(numOps > 0)) {
+          postCommitSeq += numOps - 1;  // add to get to the next batch
+        }
       }
       TRI_ASSERT(postCommitSeq <= rocksutils::globalRocksDB()->GetLatestSequenceNumber());
 
@@ -336,14 +404,26 @@ arangodb::Result RocksDBTransactionState::internalCommit() {
         committed = true;
       }
 
+      if (ingested) {
+        // the ingested data is not in the WAL, so recovery cannot recompute
+        // the counts and estimates for it. persist them right away
+        RocksDBEngine* engine = rocksutils::globalRocksEngine();
+        Result syncRes = engine->settingsManager()->sync(true);
+        if (syncRes.fail()) {
+          LOG_TOPIC("4e7a9", WARN, Logger::ENGINES)
+              << "unable to persist counts after bulk load: " << syncRes.errorMessage();
+        }
+      }
+
 #ifndef _WIN32
       // wait for sync if required, for all other platforms but Windows
       if (waitForSync()) {
         RocksDBEngine* engine = static_cast<RocksDBEngine*>(EngineSelectorFeature::ENGINE);
         TRI_ASSERT(engine != nullptr);
         if (engine->syncThread()) {
-          // we do have a sync thread
-          result = engine->syncThread()->syncWal();
+          // we do have a sync thread. it group-commits concurrent
+          // transactions, so we only wait until our own data is synced
+          result = engine->syncThread()->syncWal(postCommitSeq);
         } else {
           // no sync thread present... this may be the case if automatic
           // syncing is completely turned off. in this case, use the
@@ -372,10 +452,177 @@ arangodb::Result RocksDBTransactionState::internalCommit() {
   return result;
 }
 
+namespace {
+
+/// @brief collects the puts of a write batch per column family. anything
+/// else (removals, merges) makes the batch unsuitable for ingestion
+struct IngestionCollector final : public rocksdb::WriteBatch::Handler {
+  std::unordered_map<uint32_t, std::vector<std::pair<std::string, std::string>>> entries;
+  bool supported = true;
+
+  bool Continue() override { return supported; }
+
+  rocksdb::Status PutCF(uint32_t cfId, rocksdb::Slice const& key,
+                        rocksdb::Slice const& value) override {
+    entries[cfId].emplace_back(key.ToString(), value.ToString());
+    return rocksdb::Status();
+  }
+
+  rocksdb::Status DeleteCF(uint32_t, rocksdb::Slice const&) override {
+    supported = false;
+    return rocksdb::Status();
+  }
+
+  rocksdb::Status SingleDeleteCF(uint32_t, rocksdb::Slice const&) override {
+    supported = false;
+    return rocksdb::Status();
+  }
+
+  rocksdb::Status DeleteRangeCF(uint32_t, rocksdb::Slice const&, rocksdb::Slice const&) override {
+    supported = false;
+    return rocksdb::Status();
+  }
+
+  rocksdb::Status MergeCF(uint32_t, rocksdb::Slice const&, rocksdb::Slice const&) override {
+    supported = false;
+    return rocksdb::Status();
+  }
+
+  // the transaction markers are only needed for WAL tailing
+  void LogData(rocksdb::Slice const&) override {}
+};
+
+}  // namespace
+
+Result RocksDBTransactionState::ingestWriteBatch(bool& ingested) {
+  ingested = false;
+
+  // ingested data never shows up in the WAL, so WAL-based replication
+  // would silently miss it. the exclusive lock guarantees that nobody can
+  // write the same keys between our unique checks and the ingestion.
+  // on DB servers only follower shards qualify, nobody tails their WAL,
+  // and a follower that takes over is synced from snapshots by others
+  bool const isDBServer = ServerState::instance()->isDBServer();
+  if ((!ServerState::instance()->isSingleServer() && !isDBServer) ||
+      (ReplicationFeature::INSTANCE != nullptr &&
+       ReplicationFeature::INSTANCE->isActiveFailoverEnabled()) ||
+      !isOnlyExclusiveTransaction()) {
+    return Result();
+  }
+
+  // bulk loads are opt-in, and clients that dump or tail this server would
+  // miss the data. the system database tracks global WAL tailers
+  RocksDBEngine* engine = rocksutils::globalRocksEngine();
+  if (!engine->allowsBulkLoad() || engine->replicationManager()->hasContexts() ||
+      _vocbase.replicationClients().lowestServedValue() != UINT64_MAX) {
+    return Result();
+  }
+  auto* sysDbFeature =
+      application_features::ApplicationServer::lookupFeature<SystemDatabaseFeature>();
+  SystemDatabaseFeature::ptr system = sysDbFeature ? sysDbFeature->use() : nullptr;
+  if (system != nullptr && system->replicationClients().lowestServedValue() != UINT64_MAX) {
+    return Result();
+  }
+
+  // the column families we can write into
+  std::unordered_map<uint32_t, rocksdb::ColumnFamilyHandle*> families;
+  for (auto& trxColl : _collections) {
+    LogicalCollection* coll = trxColl->collection().get();
+    if (isDBServer && coll->followers()->getLeader().empty()) {
+      // we are the leader of the shard
+      return Result();
+    }
+    auto* rcoll = static_cast<RocksDBCollection*>(coll->getPhysical());
+    families.emplace(rcoll->documentsColumnFamily()->GetID(), rcoll->documentsColumnFamily());
+    for (auto const& idx : coll->getIndexes()) {
+      if (idx->type() == Index::TRI_IDX_TYPE_IRESEARCH_LINK) {
+        // links maintain their own data store
+        return Result();
+      }
+      auto* cf = static_cast<RocksDBIndex*>(idx.get())->columnFamily();
+      families.emplace(cf->GetID(), cf);
+    }
+  }
+
+  ::IngestionCollector collector;
+  rocksdb::Status s = _rocksTransaction->GetWriteBatch()->GetWriteBatch()->Iterate(&collector);
+  if (!s.ok()) {
+    return rocksutils::convertStatus(s);
+  }
+  if (!collector.supported || collector.entries.empty()) {
+    return Result();
+  }
+  for (auto const& it : collector.entries) {
+    if (families.find(it.first) == families.end()) {
+      return Result();
+    }
+  }
+
+  std::string const dir = engine->ingestionPath();
+  if (!basics::FileUtils::isDirectory(dir)) {
+    long systemError;
+    std::string errorMessage;
+    int r = TRI_CreateRecursiveDirectory(dir.c_str(), systemError, errorMessage);
+    if (r != TRI_ERROR_NO_ERROR) {
+      return Result(r, "unable to create SST ingestion directory '" + dir + "': " + errorMessage);
+    }
+  }
+
+  rocksdb::DB* rootDB = rocksutils::globalRocksDB()->GetRootDB();
+  std::vector<rocksdb::IngestExternalFileArg> args;
+  auto removeFiles = scopeGuard([&] {
+    for (auto const& arg : args) {
+      for (auto const& file : arg.external_files) {
+        // files that were ingested have already been moved
+        if (basics::FileUtils::exists(file)) {
+          TRI_UnlinkFile(file.c_str());
+        }
+      }
+    }
+  });
+
+  for (auto& it : collector.entries) {
+    rocksdb::IngestExternalFileArg arg;
+    arg.column_family = families[it.first];
+    arg.options.move_files = true;
+    arg.external_files.emplace_back(basics::FileUtils::buildFilename(
+        dir, "bulk-" + std::to_string(id()) + "-" + std::to_string(it.first) + ".sst"));
+    args.emplace_back(std::move(arg));
+
+    Result res = rocksutils::writeSstFile(rootDB, args.back().column_family, it.second,
+                                          args.back().external_files.front(),
+                                          /*skipDuplicates*/ false);
+    if (res.is(TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED)) {
+      // a key was written more than once, which only a regular commit
+      // can resolve
+      return Result();
+    } else if (res.fail()) {
+      return res;
+    }
+  }
+
+  // all column families at once, or none
+  s = rootDB->IngestExternalFiles(args);
+  if (!s.ok()) {
+    return rocksutils::convertStatus(s);
+  }
+  ingested = true;
+
+  // throw away the write batch, the data is in place now
+  _rocksTransaction->Rollback();
+
+  LOG_TOPIC("4e7aa", DEBUG, Logger::ENGINES)
+      << "bulk load of transaction " << id() << " ingested into " << args.size()
+      << " column families";
+
+  return Result();
+}
+
 /// @brief commit a transaction
 Result RocksDBTransactionState::commitTransaction(transaction::Methods* activeTrx) {
   LOG_TRX("5cb03", TRACE, this, nestingLevel())
       << "committing " << AccessMode::typeString(_type) << " transaction";
+  tracing::ScopedSpan traceSpan("RocksDB commit");
 
   TRI_ASSERT(_status == transaction::Status::RUNNING);
   TRI_IF_FAILURE("TransactionWriteCommitMarker") {
@@ -384,7 +631,11 @@ Result RocksDBTransactionState::commitTransaction(transaction::Methods* activeTr
 
   arangodb::Result res;
   if (nestingLevel() == 0) {
-    if (_rocksTransaction != nullptr) {
+    if (_hasUnrevertedFailure) {
+      // the caller promised to abort after any failed operation
+      res.reset(TRI_ERROR_INTERNAL,
+                "cannot commit a transaction with partially applied operations");
+    } else if (_rocksTransaction != nullptr) {
       res = internalCommit();
     }
     if (res.ok()) {
@@ -552,6 +803,8 @@ uint64_t RocksDBTransactionState::sequenceNumber() const {
     return static_cast<uint64_t>(_rocksTransaction->GetSnapshot()->GetSequenceNumber());
   } else if (_readSnapshot != nullptr) {
     return static_cast<uint64_t>(_readSnapshot->GetSequenceNumber());
+  } else if (_historicSnapshot != nullptr) {
+    return static_cast<uint64_t>(_historicSnapshot->GetSequenceNumber());
   } else if (isReadOnlyTransaction() && isSingleOperation()) {
     return rocksutils::latestSequenceNumber();
   }
@@ -616,14 +869,27 @@ Result RocksDBTransactionState::triggerIntermediateCommit(bool& hasPerformedInte
 Result RocksDBTransactionState::checkIntermediateCommit(uint64_t newSize, bool& hasPerformedIntermediateCommit) {
   hasPerformedIntermediateCommit = false;
 
+  if (_hasUnrevertedFailure) {
+    // must not make the partial writes of a failed operation durable,
+    // the transaction is going to be aborted anyway
+    return Result();
+  }
+
   if (hasHint(transaction::Hints::Hint::INTERMEDIATE_COMMITS)) {
     auto numOperations = _numInserts + _numUpdates + _numRemoves;
     // perform an intermediate commit
     // this will be done if either the "number of operations" or the
     // "transaction size" counters have reached their limit
-    if (_options.intermediateCommitCount <= numOperations ||
-        _options.intermediateCommitSize <= newSize) {
-      return triggerIntermediateCommit(hasPerformedIntermediateCommit);
+    // the size limit shrinks while RocksDB is behind with flushes and
+    // compactions, it never grows beyond the configured value
+    uint64_t sizeLimit = rocksutils::globalRocksEngine()->intermediateCommitSize(
+        _options.intermediateCommitSize);
+    if (_options.intermediateCommitCount <= numOperations || sizeLimit <= newSize) {
+      Result res = triggerIntermediateCommit(hasPerformedIntermediateCommit);
+      if (hasPerformedIntermediateCommit) {
+        ++_numIntermediateCommits;
+      }
+      return res;
     }
   }
   return TRI_ERROR_NO_ERROR;
@@ -27,6 +27,7 @@
 #include "Basics/Common.h"
 #include "Basics/SmallVector.h"
 #include "RocksDBEngine/RocksDBKey.h"
+#include "RocksDBEngine/RocksDBOptimisticKeys.h"
 #include "StorageEngine/TransactionState.h"
 #include "Transaction/Hints.h"
 #include "Transaction/Methods.h"
@@ -61,6 +62,7 @@ class RocksDBTransactionState final : public TransactionState {
   friend class RocksDBMethods;
   friend class RocksDBReadOnlyMethods;
   friend class RocksDBTrxMethods;
+  friend class RocksDBOptimisticTrxMethods;
   friend class RocksDBBatchedMethods;
   friend class RocksDBBatchedWithIndexMethods;
 
@@ -84,6 +86,9 @@ class RocksDBTransactionState final : public TransactionState {
   uint64_t numInserts() const { return _numInserts; }
   uint64_t numUpdates() const { return _numUpdates; }
   uint64_t numRemoves() const { return _numRemoves; }
+  uint64_t numIntermediateCommits() const override {
+    return _numIntermediateCommits;
+  }
 
   inline bool hasOperations() const {
     return (_numInserts > 0 || _numRemoves > 0 || _numUpdates > 0);
@@ -99,6 +104,11 @@ class RocksDBTransactionState final : public TransactionState {
   /// @brief undo the effects of the previous prepareOperation call
   void rollbackOperation(TRI_voc_document_operation_e operationType);
 
+  /// @brief an operation failed without a savepoint to roll back to, its
+  /// partial writes are still in the transaction. the transaction can
+  /// only be aborted from now on
+  void setUnrevertedFailure() { _hasUnrevertedFailure = true; }
+
   /// @brief add an operation for a transaction collection
   /// sets hasPerformedIntermediateCommit to true if an intermediate commit was
   /// performed
@@ -119,6 +129,11 @@ class RocksDBTransactionState final : public TransactionState {
   /// @brief acquire a database snapshot
   bool setSnapshotOnReadOnly();
 
+  /// @brief whether the transaction reads as of a timestamp chosen by a
+  /// coordinator. it must neither read nor fill the index caches then,
+  /// as they hold the current state
+  bool hasHistoricSnapshot() const { return _historicSnapshot != nullptr; }
+
   static RocksDBTransactionState* toState(transaction::Methods* trx) {
     TRI_ASSERT(trx != nullptr);
     TransactionState* state = trx->state();
@@ -155,6 +170,11 @@ class RocksDBTransactionState final : public TransactionState {
   /// @brief internally commit a transaction
   arangodb::Result internalCommit();
 
+  /// @brief bulk-load variant of the rocksdb commit: writes the transaction's
+  /// write batch into SST files and ingests them. sets ingested to false if
+  /// the write batch cannot be ingested and needs a regular commit instead
+  arangodb::Result ingestWriteBatch(bool& ingested);
+
   /// @brief Trigger an intermediate commit.
   /// Handle with care if failing after this commit it will only
   /// be rolled back until this point of time.
@@ -172,6 +192,9 @@ class RocksDBTransactionState final : public TransactionState {
   /// @brief used for read-only trx and intermediate commits
   /// For intermediate commits this MUST ONLY be used for iteratos
   rocksdb::Snapshot const* _readSnapshot;
+  /// @brief shared snapshot of read-only trx with a snapshot timestamp,
+  /// used instead of _readSnapshot
+  std::shared_ptr<rocksdb::Snapshot const> _historicSnapshot;
   /// @brief shared read options which can be used by operations
   /// For intermediate commits iterators MUST use the _readSnapshot
   rocksdb::ReadOptions _rocksReadOptions;
@@ -181,6 +204,10 @@ class RocksDBTransactionState final : public TransactionState {
   /// @brief wrapper to use outside this class to access rocksdb
   std::unique_ptr<RocksDBMethods> _rocksMethods;
 
+  /// @brief keys to validate on commit in optimistic mode, since the last
+  /// (intermediate) commit
+  RocksDBOptimisticKeys _optimisticKeys;
+
 #ifdef ARANGODB_ENABLE_MAINTAINER_MODE
   /// store the number of log entries in WAL
   uint64_t _numLogdata = 0;
@@ -191,6 +218,10 @@ class RocksDBTransactionState final : public TransactionState {
   uint64_t _numInserts;
   uint64_t _numUpdates;
   uint64_t _numRemoves;
+  uint64_t _numIntermediateCommits;
+
+  /// @brief an operation failed and could not be rolled back
+  bool _hasUnrevertedFailure;
 
   /// @brief if true there key buffers will no longer be shared
   bool _parallel;
@@ -23,6 +23,7 @@
 
 #include "RocksDBTtlIndex.h"
 #include "Basics/StaticStrings.h"
+#include "Indexes/IndexIterator.h"
 #include "Transaction/Helpers.h"
 #include "VocBase/LogicalCollection.h"
 
@@ -62,6 +63,33 @@ void RocksDBTtlIndex::toVelocyPack(arangodb::velocypack::Builder& builder,
   builder.close();
 }
 
+/// @brief collects the ids of expired documents straight from the index, so
+/// the TTL thread does not need to plan and run an AQL query for this
+Result RocksDBTtlIndex::lookupExpired(transaction::Methods& trx, double stamp, size_t limit,
+                                      std::vector<LocalDocumentId>& result) const {
+  result.clear();
+  if (limit == 0) {
+    return Result();
+  }
+
+  // the index only contains non-negative numeric timestamps (see insert()),
+  // so the range [0, stamp] covers exactly the expired documents
+  transaction::BuilderLeaser search(&trx);
+  search->openArray();
+  search->openObject();
+  search->add(StaticStrings::IndexGe, VPackValue(0.0));
+  search->add(StaticStrings::IndexLe, VPackValue(stamp));
+  search->close();
+  search->close();
+
+  return basics::catchToResult([&]() -> Result {
+    std::unique_ptr<IndexIterator> it = lookup(&trx, search->slice(), false);
+    result.reserve(limit);
+    it->next([&result](LocalDocumentId const& id) { result.emplace_back(id); }, limit);
+    return Result();
+  });
+}
+
 /// @brief inserts a document into the index
 Result RocksDBTtlIndex::insert(transaction::Methods& trx, RocksDBMethods* mthds,
                                LocalDocumentId const& documentId,
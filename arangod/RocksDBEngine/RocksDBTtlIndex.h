@@ -49,6 +49,10 @@ class RocksDBTtlIndex final : public RocksDBSkiplistIndex {
   
   void toVelocyPack(arangodb::velocypack::Builder& builder,
                     std::underlying_type<Index::Serialize>::type flags) const override;
+
+  /// @brief scan the index entries in [0, stamp] in timestamp order
+  Result lookupExpired(transaction::Methods& trx, double stamp, size_t limit,
+                       std::vector<LocalDocumentId>& result) const override;
   
  protected:
   // special override method that extracts a timestamp value from the index attribute
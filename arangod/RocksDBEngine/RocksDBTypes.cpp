@@ -97,6 +97,14 @@ static rocksdb::Slice IndexEstimateValue(
 static RocksDBEntryType keyGeneratorValue = RocksDBEntryType::KeyGeneratorValue;
 static rocksdb::Slice KeyGeneratorValue(
     reinterpret_cast<std::underlying_type<RocksDBEntryType>::type*>(&keyGeneratorValue), 1);
+
+static RocksDBEntryType indexHistogramValue = RocksDBEntryType::IndexHistogramValue;
+static rocksdb::Slice IndexHistogramValue(
+    reinterpret_cast<std::underlying_type<RocksDBEntryType>::type*>(&indexHistogramValue), 1);
+
+static RocksDBEntryType documentDictionaryValue = RocksDBEntryType::DocumentDictionaryValue;
+static rocksdb::Slice DocumentDictionaryValue(
+    reinterpret_cast<std::underlying_type<RocksDBEntryType>::type*>(&documentDictionaryValue), 1);
 }  // namespace
 
 char const* arangodb::rocksDBEntryTypeName(arangodb::RocksDBEntryType type) {
@@ -135,6 +143,10 @@ char const* arangodb::rocksDBEntryTypeName(arangodb::RocksDBEntryType type) {
       return "IndexEstimateValue";
     case arangodb::RocksDBEntryType::KeyGeneratorValue:
       return "KeyGeneratorValue";
+    case arangodb::RocksDBEntryType::IndexHistogramValue:
+      return "IndexHistogramValue";
+    case arangodb::RocksDBEntryType::DocumentDictionaryValue:
+      return "DocumentDictionaryValue";
   }
   return "Invalid";
 }
@@ -231,6 +243,10 @@ rocksdb::Slice const& arangodb::rocksDBSlice(RocksDBEntryType const& type) {
       return IndexEstimateValue;
     case RocksDBEntryType::KeyGeneratorValue:
       return KeyGeneratorValue;
+    case RocksDBEntryType::IndexHistogramValue:
+      return IndexHistogramValue;
+    case RocksDBEntryType::DocumentDictionaryValue:
+      return DocumentDictionaryValue;
   }
 
   return Placeholder;  // avoids warning - errorslice instead ?!
@@ -52,7 +52,9 @@ enum class RocksDBEntryType : char {
   IndexEstimateValue = '<',
   KeyGeneratorValue = '=',
   View = '>',
-  GeoIndexValue = '?'
+  GeoIndexValue = '?',
+  IndexHistogramValue = '@',
+  DocumentDictionaryValue = 'A'
 };
 
 char const* rocksDBEntryTypeName(RocksDBEntryType);
@@ -29,6 +29,7 @@
 #include "Basics/StaticStrings.h"
 #include "Basics/VelocyPackHelper.h"
 #include "Indexes/SortedIndexAttributeMatcher.h"
+#include "Random/RandomGenerator.h"
 #include "RocksDBEngine/RocksDBCollection.h"
 #include "RocksDBEngine/RocksDBColumnFamily.h"
 #include "RocksDBEngine/RocksDBCommon.h"
@@ -168,6 +169,9 @@ class RocksDBVPackUniqueIndexIterator final : public IndexIterator {
 };
 
 /// @brief Iterator structure for RocksDB. We require a start and stop node
+/// for each range. All ranges (e.g. the values of an IN list) are scanned
+/// with the same RocksDB iterator, and rearming for a new condition only
+/// replaces the ranges, but keeps the iterator
 class RocksDBVPackIndexIterator final : public IndexIterator {
  private:
   friend class RocksDBVPackIndex;
@@ -175,61 +179,61 @@ class RocksDBVPackIndexIterator final : public IndexIterator {
  public:
   RocksDBVPackIndexIterator(LogicalCollection* collection, transaction::Methods* trx,
                             arangodb::RocksDBVPackIndex const* index,
-                            bool reverse, RocksDBKeyBounds&& bounds)
+                            bool reverse, std::vector<RocksDBKeyBounds>&& ranges)
       : IndexIterator(collection, trx),
         _index(index),
         _cmp(static_cast<RocksDBVPackComparator const*>(index->comparator())),
         _fullEnumerationObjectId(0),
         _reverse(reverse),
-        _bounds(std::move(bounds)) {
+        _ranges(std::move(ranges)),
+        _currentRange(0) {
     TRI_ASSERT(index->columnFamily() == RocksDBColumnFamily::vpack());
+    TRI_ASSERT(!_ranges.empty());
 
     RocksDBMethods* mthds = RocksDBTransactionState::toMethods(trx);
     rocksdb::ReadOptions options = mthds->iteratorReadOptions();
-    // we need to have a pointer to a slice for the upper bound
-    // so we need to assign the slice to an instance variable here
+    // we need to have a pointer to a slice for the bound, which is
+    // updated in place for every range the iterator is positioned on
     if (reverse) {
-      _rangeBound = _bounds.start();
       options.iterate_lower_bound = &_rangeBound;
-      VPackSlice s = VPackSlice(reinterpret_cast<uint8_t const*>(_rangeBound.data() + sizeof(uint64_t)));
-      if (s.isArray() && s.length() == 1 && s.at(0).isMinKey()) {
-        // lower bound is the min key. that means we can get away with a
-        // cheap outOfBounds comparator
-        _fullEnumerationObjectId = _index->objectId();
-      }
     } else {
-      _rangeBound = _bounds.end();
       options.iterate_upper_bound = &_rangeBound;
-      VPackSlice s = VPackSlice(reinterpret_cast<uint8_t const*>(_rangeBound.data() + sizeof(uint64_t)));
-      if (s.isArray() && s.length() == 1 && s.at(0).isMaxKey()) {
-        // upper bound is the max key. that means we can get away with a
-        // cheap outOfBounds comparator
-        _fullEnumerationObjectId = _index->objectId();
-      }
     }
 
     TRI_ASSERT(options.prefix_same_as_start);
     _iterator = mthds->NewIterator(options, index->columnFamily());
-    if (reverse) {
-      _iterator->SeekForPrev(_bounds.end());
-    } else {
-      _iterator->Seek(_bounds.start());
-    }
+    seekRange();
   }
 
  public:
   char const* typeName() const override { return "rocksdb-index-iterator"; }
 
+  /// @brief index supports rearming
+  bool canRearm() const override { return true; }
+
+  /// @brief rearm the index iterator
+  bool rearm(arangodb::aql::AstNode const* node, arangodb::aql::Variable const* variable,
+             IndexIteratorOptions const& opts) override {
+    TRI_ASSERT(_reverse == !opts.ascending);
+    std::vector<RocksDBKeyBounds> ranges;
+    if (!_index->rangesForCondition(node, variable, opts, ranges)) {
+      return false;
+    }
+    TRI_ASSERT(!ranges.empty());
+    // positioned on the first range by the following reset()
+    _ranges = std::move(ranges);
+    _currentRange = 0;
+    return true;
+  }
+
   /// @brief Get the next limit many elements in the index
   bool next(LocalDocumentIdCallback const& cb, size_t limit) override {
     TRI_ASSERT(_trx->state()->isRunning());
 
-    if (limit == 0 || !_iterator->Valid() || outOfRange()) {
+    if (limit == 0 || !inRange()) {
       // No limit no data, or we are actually done. The last call should have
       // returned false
       TRI_ASSERT(limit > 0);  // Someone called with limit == 0. Api broken
-      // validate that Iterator is in a good shape and hasn't failed
-      arangodb::rocksutils::checkIteratorStatus(_iterator.get());
       return false;
     }
 
@@ -237,12 +241,10 @@ class RocksDBVPackIndexIterator final : public IndexIterator {
       TRI_ASSERT(_index->objectId() == RocksDBKey::objectId(_iterator->key()));
 
       cb(_index->_unique ? RocksDBValue::documentId(_iterator->value())
-                        : RocksDBKey::indexDocumentId(_bounds.type(), _iterator->key()));
+                        : RocksDBKey::indexDocumentId(bounds().type(), _iterator->key()));
 
       --limit;
       if (!advance()) {
-        // validate that Iterator is in a good shape and hasn't failed
-        arangodb::rocksutils::checkIteratorStatus(_iterator.get());
         return false;
       }
     }
@@ -253,12 +255,10 @@ class RocksDBVPackIndexIterator final : public IndexIterator {
   bool nextCovering(DocumentCallback const& cb, size_t limit) override {
     TRI_ASSERT(_trx->state()->isRunning());
 
-    if (limit == 0 || !_iterator->Valid() || outOfRange()) {
+    if (limit == 0 || !inRange()) {
       // No limit no data, or we are actually done. The last call should have
       // returned false
       TRI_ASSERT(limit > 0);  // Someone called with limit == 0. Api broken
-      // validate that Iterator is in a good shape and hasn't failed
-      arangodb::rocksutils::checkIteratorStatus(_iterator.get());
       return false;
     }
 
@@ -268,13 +268,11 @@ class RocksDBVPackIndexIterator final : public IndexIterator {
 
       LocalDocumentId const documentId(
           _index->_unique ? RocksDBValue::documentId(_iterator->value())
-                          : RocksDBKey::indexDocumentId(_bounds.type(), key));
+                          : RocksDBKey::indexDocumentId(bounds().type(), key));
       cb(documentId, RocksDBKey::indexedVPack(key));
 
       --limit;
       if (!advance()) {
-        // validate that Iterator is in a good shape and hasn't failed
-        arangodb::rocksutils::checkIteratorStatus(_iterator.get());
         return false;
       }
     }
@@ -285,9 +283,7 @@ class RocksDBVPackIndexIterator final : public IndexIterator {
   void skip(uint64_t count, uint64_t& skipped) override {
     TRI_ASSERT(_trx->state()->isRunning());
 
-    if (!_iterator->Valid() || outOfRange()) {
-      // validate that Iterator is in a good shape and hasn't failed
-      arangodb::rocksutils::checkIteratorStatus(_iterator.get());
+    if (!inRange()) {
       return;
     }
 
@@ -297,8 +293,6 @@ class RocksDBVPackIndexIterator final : public IndexIterator {
       --count;
       ++skipped;
       if (!advance()) {
-        // validate that Iterator is in a good shape and hasn't failed
-        arangodb::rocksutils::checkIteratorStatus(_iterator.get());
         return;
       }
     }
@@ -308,14 +302,8 @@ class RocksDBVPackIndexIterator final : public IndexIterator {
   void reset() override {
     TRI_ASSERT(_trx->state()->isRunning());
 
-    if (_reverse) {
-      _iterator->SeekForPrev(_bounds.end());
-    } else {
-      _iterator->Seek(_bounds.start());
-    }
-    
-    // validate that Iterator is in a good shape and hasn't failed
-    arangodb::rocksutils::checkIteratorStatus(_iterator.get());
+    _currentRange = 0;
+    seekRange();
   }
 
   /// @brief we provide a method to provide the index attribute values
@@ -325,6 +313,54 @@ class RocksDBVPackIndexIterator final : public IndexIterator {
   }
 
  private:
+  RocksDBKeyBounds const& bounds() const {
+    TRI_ASSERT(_currentRange < _ranges.size());
+    return _ranges[_currentRange];
+  }
+
+  /// @brief position the iterator at the start of the current range
+  void seekRange() {
+    RocksDBKeyBounds const& b = bounds();
+    _fullEnumerationObjectId = 0;
+    if (_reverse) {
+      _rangeBound = b.start();
+      VPackSlice s = VPackSlice(reinterpret_cast<uint8_t const*>(_rangeBound.data() + sizeof(uint64_t)));
+      if (s.isArray() && s.length() == 1 && s.at(0).isMinKey()) {
+        // lower bound is the min key. that means we can get away with a
+        // cheap outOfBounds comparator
+        _fullEnumerationObjectId = _index->objectId();
+      }
+      _iterator->SeekForPrev(b.end());
+    } else {
+      _rangeBound = b.end();
+      VPackSlice s = VPackSlice(reinterpret_cast<uint8_t const*>(_rangeBound.data() + sizeof(uint64_t)));
+      if (s.isArray() && s.length() == 1 && s.at(0).isMaxKey()) {
+        // upper bound is the max key. that means we can get away with a
+        // cheap outOfBounds comparator
+        _fullEnumerationObjectId = _index->objectId();
+      }
+      _iterator->Seek(b.start());
+    }
+
+    // validate that Iterator is in a good shape and hasn't failed
+    arangodb::rocksutils::checkIteratorStatus(_iterator.get());
+  }
+
+  /// @brief whether the iterator is positioned on an entry, moving on to
+  /// the next ranges once the current one is exhausted
+  bool inRange() {
+    while (!_iterator->Valid() || outOfRange()) {
+      // validate that Iterator is in a good shape and hasn't failed
+      arangodb::rocksutils::checkIteratorStatus(_iterator.get());
+      if (_currentRange + 1 >= _ranges.size()) {
+        return false;
+      }
+      ++_currentRange;
+      seekRange();
+    }
+    return true;
+  }
+
   inline bool outOfRange() const {
     if (_fullEnumerationObjectId) {
       // we are enumerating the entire index
@@ -350,7 +386,7 @@ class RocksDBVPackIndexIterator final : public IndexIterator {
       _iterator->Next();
     }
 
-    return _iterator->Valid() && !outOfRange();
+    return inRange();
   }
 
   arangodb::RocksDBVPackIndex const* _index;
@@ -358,7 +394,9 @@ class RocksDBVPackIndexIterator final : public IndexIterator {
   std::unique_ptr<rocksdb::Iterator> _iterator;
   uint64_t _fullEnumerationObjectId;
   bool const _reverse;
-  RocksDBKeyBounds _bounds;
+  /// @brief ranges to scan, in the order of iteration
+  std::vector<RocksDBKeyBounds> _ranges;
+  size_t _currentRange;
   // used for iterate_upper_bound iterate_lower_bound
   rocksdb::Slice _rangeBound;
 };
@@ -381,7 +419,9 @@ RocksDBVPackIndex::RocksDBVPackIndex(TRI_idx_iid_t iid, arangodb::LogicalCollect
           arangodb::basics::VelocyPackHelper::getBooleanValue(info,
                                                               "deduplicate", true)),
       _allowPartialIndex(true),
-      _estimator(nullptr) {
+      _estimator(nullptr),
+      _histogramChanges(0),
+      _histogramOutdated(false) {
   TRI_ASSERT(_cf == RocksDBColumnFamily::vpack());
 
   if (!_unique && !ServerState::instance()->isCoordinator()) {
@@ -406,6 +446,7 @@ double RocksDBVPackIndex::selectivityEstimate(arangodb::velocypack::StringRef co
   if (_unique) {
     return 1.0;
   }
+  loadEstimator();
   TRI_ASSERT(_estimator != nullptr);
   return _estimator->computeEstimate();
 }
@@ -762,6 +803,10 @@ Result RocksDBVPackIndex::insert(transaction::Methods& trx, RocksDBMethods* mthd
     }
   }
 
+  if (res.ok()) {
+    _histogramChanges.fetch_add(elements.size(), std::memory_order_relaxed);
+  }
+
   return res;
 }
 
@@ -918,19 +963,23 @@ Result RocksDBVPackIndex::remove(transaction::Methods& trx, RocksDBMethods* mthd
     addErrorMsg(res);
   }
 
+  if (res.ok()) {
+    _histogramChanges.fetch_add(count, std::memory_order_relaxed);
+  }
+
   return res;
 }
 
-/// @brief attempts to locate an entry in the index
-/// Warning: who ever calls this function is responsible for destroying
-/// the RocksDBVPackIndexIterator* results
-std::unique_ptr<IndexIterator> RocksDBVPackIndex::lookup(transaction::Methods* trx,
-                                                         VPackSlice const searchValues, bool reverse) const {
+/// @brief determines the key range for the search values and appends it
+/// to ranges. returns false instead if allowPointLookup is set and the
+/// search values denote a single entry of a unique index, which is then
+/// looked up directly. leftSearch contains the index values of that entry
+bool RocksDBVPackIndex::searchBounds(VPackSlice const searchValues, VPackBuilder& leftSearch,
+                                     std::vector<RocksDBKeyBounds>& ranges,
+                                     bool allowPointLookup) const {
   TRI_ASSERT(searchValues.isArray());
   TRI_ASSERT(searchValues.length() <= _fields.size());
 
-  VPackBuilder leftSearch;
-
   VPackSlice lastNonEq;
   leftSearch.openArray();
   for (auto const& it : VPackArrayIterator(searchValues)) {
@@ -943,10 +992,10 @@ std::unique_ptr<IndexIterator> RocksDBVPackIndex::lookup(transaction::Methods* t
     leftSearch.add(eq);
   }
 
-  if (lastNonEq.isNone() && _unique && searchValues.length() == _fields.size()) {
+  if (lastNonEq.isNone() && _unique && searchValues.length() == _fields.size() &&
+      allowPointLookup) {
     leftSearch.close();
-
-    return std::make_unique<RocksDBVPackUniqueIndexIterator>(&_collection, trx, this, leftSearch.slice());
+    return false;
   }
 
   VPackSlice leftBorder;
@@ -1023,11 +1072,23 @@ std::unique_ptr<IndexIterator> RocksDBVPackIndex::lookup(transaction::Methods* t
     }
   }
 
-  RocksDBKeyBounds bounds =
-      _unique ? RocksDBKeyBounds::UniqueVPackIndex(_objectId, leftBorder, rightBorder)
-              : RocksDBKeyBounds::VPackIndex(_objectId, leftBorder, rightBorder);
+  ranges.emplace_back(_unique ? RocksDBKeyBounds::UniqueVPackIndex(_objectId, leftBorder, rightBorder)
+                              : RocksDBKeyBounds::VPackIndex(_objectId, leftBorder, rightBorder));
+  return true;
+}
+
+/// @brief attempts to locate an entry in the index
+/// Warning: who ever calls this function is responsible for destroying
+/// the RocksDBVPackIndexIterator* results
+std::unique_ptr<IndexIterator> RocksDBVPackIndex::lookup(transaction::Methods* trx,
+                                                         VPackSlice const searchValues, bool reverse) const {
+  VPackBuilder leftSearch;
+  std::vector<RocksDBKeyBounds> ranges;
+  if (!searchBounds(searchValues, leftSearch, ranges, true)) {
+    return std::make_unique<RocksDBVPackUniqueIndexIterator>(&_collection, trx, this, leftSearch.slice());
+  }
 
-  return std::make_unique<RocksDBVPackIndexIterator>(&_collection, trx, this, reverse, std::move(bounds));
+  return std::make_unique<RocksDBVPackIndexIterator>(&_collection, trx, this, reverse, std::move(ranges));
 }
 
 Index::UsageCosts RocksDBVPackIndex::supportsFilterCondition(
@@ -1049,14 +1110,14 @@ arangodb::aql::AstNode* RocksDBVPackIndex::specializeCondition(
   return SortedIndexAttributeMatcher::specializeCondition(this, node, reference);
 }
 
-std::unique_ptr<IndexIterator> RocksDBVPackIndex::iteratorForCondition(
-    transaction::Methods* trx, arangodb::aql::AstNode const* node,
-    arangodb::aql::Variable const* reference, IndexIteratorOptions const& opts) {
-  TRI_ASSERT(!isSorted() || opts.sorted);
-
-  VPackBuilder searchValues;
+/// @brief builds the search values for the condition. returns false if
+/// the condition is not supported and cannot produce any results
+bool RocksDBVPackIndex::searchValuesForCondition(arangodb::aql::AstNode const* node,
+                                                 arangodb::aql::Variable const* reference,
+                                                 VPackBuilder& searchValues,
+                                                 bool& needNormalize) const {
   searchValues.openArray();
-  bool needNormalize = false;
+  needNormalize = false;
   if (node == nullptr) {
     // We only use this index for sort. Empty searchValue
     VPackArrayBuilder guard(&searchValues);
@@ -1213,7 +1274,7 @@ std::unique_ptr<IndexIterator> RocksDBVPackIndex::iteratorForCondition(
               // unsupported right now. Should have been rejected by
               // supportsFilterCondition
               TRI_ASSERT(false);
-              return std::make_unique<EmptyIndexIterator>(&_collection, trx);
+              return false;
           }
 
           value->toVelocyPackValue(searchValues);
@@ -1222,6 +1283,51 @@ std::unique_ptr<IndexIterator> RocksDBVPackIndex::iteratorForCondition(
     }
   }
   searchValues.close();
+  return true;
+}
+
+/// @brief determines the key ranges to scan for the condition, in the
+/// order of iteration. returns false if the condition cannot produce any
+/// results
+bool RocksDBVPackIndex::rangesForCondition(arangodb::aql::AstNode const* node,
+                                           arangodb::aql::Variable const* reference,
+                                           IndexIteratorOptions const& opts,
+                                           std::vector<RocksDBKeyBounds>& ranges) const {
+  VPackBuilder searchValues;
+  bool needNormalize;
+  if (!searchValuesForCondition(node, reference, searchValues, needNormalize)) {
+    return false;
+  }
+
+  VPackBuilder leftSearch;
+  if (needNormalize) {
+    VPackBuilder expandedSearchValues;
+    expandInSearchValues(searchValues.slice(), expandedSearchValues);
+    for (VPackSlice val : VPackArrayIterator(expandedSearchValues.slice())) {
+      leftSearch.clear();
+      searchBounds(val, leftSearch, ranges, false);
+    }
+    if (!opts.ascending) {
+      std::reverse(ranges.begin(), ranges.end());
+    }
+  } else {
+    VPackSlice searchSlice = searchValues.slice();
+    TRI_ASSERT(searchSlice.length() == 1);
+    searchBounds(searchSlice.at(0), leftSearch, ranges, false);
+  }
+  return !ranges.empty();
+}
+
+std::unique_ptr<IndexIterator> RocksDBVPackIndex::iteratorForCondition(
+    transaction::Methods* trx, arangodb::aql::AstNode const* node,
+    arangodb::aql::Variable const* reference, IndexIteratorOptions const& opts) {
+  TRI_ASSERT(!isSorted() || opts.sorted);
+
+  VPackBuilder searchValues;
+  bool needNormalize;
+  if (!searchValuesForCondition(node, reference, searchValues, needNormalize)) {
+    return std::make_unique<EmptyIndexIterator>(&_collection, trx);
+  }
 
   TRI_IF_FAILURE("PersistentIndex::noIterator") {
     THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
@@ -1237,6 +1343,32 @@ std::unique_ptr<IndexIterator> RocksDBVPackIndex::iteratorForCondition(
     transaction::BuilderLeaser expandedSearchValues(trx);
     expandInSearchValues(searchValues.slice(), *(expandedSearchValues.get()));
     VPackSlice expandedSlice = expandedSearchValues->slice();
+    std::vector<RocksDBKeyBounds> ranges;
+    VPackBuilder leftSearch;
+    bool pointLookups = false;
+
+    for (VPackSlice val : VPackArrayIterator(expandedSlice)) {
+      leftSearch.clear();
+      if (!searchBounds(val, leftSearch, ranges, true)) {
+        // all values are point lookups in a unique index then, which
+        // need no RocksDB iterator
+        pointLookups = true;
+        break;
+      }
+    }
+
+    if (!pointLookups) {
+      if (ranges.empty()) {
+        return std::make_unique<EmptyIndexIterator>(&_collection, trx);
+      }
+      if (!opts.ascending) {
+        std::reverse(ranges.begin(), ranges.end());
+      }
+      // a single RocksDB iterator scans the ranges of all values
+      return std::make_unique<RocksDBVPackIndexIterator>(&_collection, trx, this,
+                                                         !opts.ascending, std::move(ranges));
+    }
+
     std::vector<std::unique_ptr<IndexIterator>> iterators;
 
     for (VPackSlice val : VPackArrayIterator(expandedSlice)) {
@@ -1257,15 +1389,21 @@ std::unique_ptr<IndexIterator> RocksDBVPackIndex::iteratorForCondition(
 }
 
 void RocksDBVPackIndex::afterTruncate(TRI_voc_tick_t tick) {
+  if (supportsHistogram()) {
+    std::atomic_store(&_histogram, std::shared_ptr<IndexHistogram const>());
+    _histogramOutdated.store(true, std::memory_order_release);
+  }
   if (unique()) {
     return;
   }
+  loadEstimator();
   TRI_ASSERT(_estimator != nullptr);
   _estimator->bufferTruncate(tick);
   RocksDBIndex::afterTruncate(tick);
 }
 
 RocksDBCuckooIndexEstimator<uint64_t>* RocksDBVPackIndex::estimator() {
+  loadEstimator();
   return _estimator.get();
 }
 
@@ -1300,3 +1438,115 @@ void RocksDBVPackIndex::recalculateEstimates() {
   }
   _estimator->setAppliedSeq(seq);
 }
+
+namespace {
+/// @brief number of documents sampled to build a histogram
+constexpr size_t histogramSamples = 1024;
+
+/// @brief smaller collections are scanned quickly anyway, and histograms
+/// are rebuilt only after this many changes (or a tenth of the documents)
+constexpr uint64_t histogramMinChanges = 1000;
+}  // namespace
+
+bool RocksDBVPackIndex::supportsHistogram() const {
+  return _expanding[0] == -1 && !ServerState::instance()->isCoordinator();
+}
+
+std::shared_ptr<IndexHistogram const> RocksDBVPackIndex::histogram() const {
+  if (!supportsHistogram()) {
+    return nullptr;
+  }
+  loadEstimator();
+  return std::atomic_load(&_histogram);
+}
+
+bool RocksDBVPackIndex::needToRebuildHistogram(uint64_t numberDocuments) const {
+  if (!supportsHistogram()) {
+    return false;
+  }
+  if (_histogramOutdated.load(std::memory_order_acquire)) {
+    return true;
+  }
+  uint64_t const changes = _histogramChanges.load(std::memory_order_relaxed);
+  if (std::atomic_load(&_histogram) == nullptr) {
+    return numberDocuments >= histogramMinChanges;
+  }
+  return changes >= (std::max)(histogramMinChanges, numberDocuments / 10);
+}
+
+std::shared_ptr<IndexHistogram const> RocksDBVPackIndex::rebuildHistogram() {
+  if (!supportsHistogram()) {
+    return nullptr;
+  }
+
+  // changes made while sampling count towards the next rebuild
+  _histogramChanges.store(0, std::memory_order_relaxed);
+  _histogramOutdated.store(false, std::memory_order_release);
+
+  // the documents are sampled by seeking to random document ids between the
+  // first and the last document of the collection. document ids grow over
+  // time, so this is about uniform unless large ranges were removed. a
+  // document key is the collection's object id followed by 8 bytes of
+  // document id, read as a big-endian number these follow the iteration order
+  RocksDBCollection* rcoll = static_cast<RocksDBCollection*>(_collection.getPhysical());
+  auto bounds = RocksDBKeyBounds::CollectionDocuments(rcoll->objectId());
+  rocksdb::Slice const end = bounds.end();
+  rocksdb::ReadOptions options;
+  options.iterate_upper_bound = &end;
+  options.prefix_same_as_start = false;
+  options.total_order_seek = true;
+  options.verify_checksums = false;
+  options.fill_cache = false;
+  std::unique_ptr<rocksdb::Iterator> it(
+      rocksutils::globalRocksDB()->NewIterator(options, bounds.columnFamily()));
+
+  VPackBuilder samples;
+  samples.openArray();
+
+  it->Seek(bounds.start());
+  if (it->Valid()) {
+    TRI_ASSERT(it->key().size() == 2 * sizeof(uint64_t));
+    std::string const prefix(it->key().data(), sizeof(uint64_t));
+    uint64_t const first =
+        rocksutils::uintFromPersistentBigEndian<uint64_t>(it->key().data() + sizeof(uint64_t));
+    it->SeekForPrev(end);
+    TRI_ASSERT(it->Valid());
+    uint64_t const last =
+        rocksutils::uintFromPersistentBigEndian<uint64_t>(it->key().data() + sizeof(uint64_t));
+    TRI_ASSERT(last >= first);
+
+    std::string key;
+    std::string valueBuffer;
+    std::vector<std::string> const& path = _paths[0];
+    for (size_t i = 0; i < histogramSamples; ++i) {
+      key.assign(prefix);
+      rocksutils::uintToPersistentBigEndian<uint64_t>(
+          key, first + RandomGenerator::interval(last - first));
+      it->Seek(key);
+      if (!it->Valid()) {
+        continue;
+      }
+
+      VPackSlice value = rcoll->documentFromValue(it->value(), valueBuffer).get(path);
+      if (value.isNone() || value.isNull()) {
+        if (_sparse) {
+          // sparse indexes do not contain the document
+          continue;
+        }
+        value = VPackSlice::nullSlice();
+      }
+      samples.add(value);
+    }
+  }
+  samples.close();
+
+  auto histogram = std::make_shared<IndexHistogram const>(samples.slice());
+  std::atomic_store(&_histogram, histogram);
+  return histogram;
+}
+
+void RocksDBVPackIndex::setHistogram(std::shared_ptr<IndexHistogram const> histogram) {
+  if (supportsHistogram()) {
+    std::atomic_store(&_histogram, std::move(histogram));
+  }
+}
@@ -29,6 +29,7 @@
 #include "Aql/AstNode.h"
 #include "Basics/Common.h"
 #include "Basics/SmallVector.h"
+#include "Indexes/IndexHistogram.h"
 #include "Indexes/IndexIterator.h"
 #include "RocksDBEngine/RocksDBCuckooIndexEstimator.h"
 #include "RocksDBEngine/RocksDBFormat.h"
@@ -78,6 +79,15 @@ class RocksDBVPackIndex : public RocksDBIndex {
   void setEstimator(std::unique_ptr<RocksDBCuckooIndexEstimator<uint64_t>>) override;
   void recalculateEstimates() override;
 
+  std::shared_ptr<IndexHistogram const> histogram() const override;
+  bool needToRebuildHistogram(uint64_t numberDocuments) const override;
+
+  /// @brief builds a new histogram from a sample of the collection's
+  /// documents and installs it. returns nullptr if the index does not
+  /// support histograms
+  std::shared_ptr<IndexHistogram const> rebuildHistogram() override;
+  void setHistogram(std::shared_ptr<IndexHistogram const>) override;
+
   void toVelocyPack(VPackBuilder&, std::underlying_type<Index::Serialize>::type) const override;
 
   bool canBeDropped() const override { return true; }
@@ -134,6 +144,25 @@ class RocksDBVPackIndex : public RocksDBIndex {
   /// @brief return the number of paths
   inline size_t numPaths() const { return _paths.size(); }
 
+  /// @brief determines the key range for the search values, see .cpp
+  bool searchBounds(velocypack::Slice const searchValues, velocypack::Builder& leftSearch,
+                    std::vector<RocksDBKeyBounds>& ranges, bool allowPointLookup) const;
+
+  /// @brief builds the search values for the condition
+  bool searchValuesForCondition(arangodb::aql::AstNode const* node,
+                                arangodb::aql::Variable const* reference,
+                                velocypack::Builder& searchValues, bool& needNormalize) const;
+
+  /// @brief determines the key ranges to scan for the condition
+  bool rangesForCondition(arangodb::aql::AstNode const* node,
+                          arangodb::aql::Variable const* reference,
+                          IndexIteratorOptions const& opts,
+                          std::vector<RocksDBKeyBounds>& ranges) const;
+
+  /// @brief histograms are kept for the first attribute if it does not
+  /// expand, and only where the data is
+  bool supportsHistogram() const;
+
   /// @brief helper function to transform AttributeNames into string lists
   void fillPaths(std::vector<std::vector<std::string>>& paths, std::vector<int>& expanding);
 
@@ -176,6 +205,15 @@ class RocksDBVPackIndex : public RocksDBIndex {
   /// On insertion of a document we have to insert it into the estimator,
   /// On removal we have to remove it in the estimator as well.
   std::unique_ptr<RocksDBCuckooIndexEstimator<uint64_t>> _estimator;
+
+  /// @brief equi-depth histogram of the first attribute's values, replaced
+  /// as a whole by the background sync, so it is accessed atomically
+  std::shared_ptr<IndexHistogram const> _histogram;
+
+  /// @brief number of index entries inserted or removed since the histogram
+  /// was built, and whether it must be rebuilt regardless (after truncate)
+  std::atomic<uint64_t> _histogramChanges;
+  std::atomic<bool> _histogramOutdated;
 };
 }  // namespace arangodb
 
@@ -70,6 +70,14 @@ RocksDBValue RocksDBValue::KeyGeneratorValue(VPackSlice const& data) {
   return RocksDBValue(RocksDBEntryType::KeyGeneratorValue, data);
 }
 
+RocksDBValue RocksDBValue::IndexHistogramValue(VPackSlice const& data) {
+  return RocksDBValue(RocksDBEntryType::IndexHistogramValue, data);
+}
+
+RocksDBValue RocksDBValue::DocumentDictionaryValue(VPackSlice const& data) {
+  return RocksDBValue(RocksDBEntryType::DocumentDictionaryValue, data);
+}
+
 RocksDBValue RocksDBValue::S2Value(S2Point const& p) { return RocksDBValue(p); }
 
 RocksDBValue RocksDBValue::Empty(RocksDBEntryType type) {
@@ -172,6 +180,8 @@ RocksDBValue::RocksDBValue(RocksDBEntryType type, VPackSlice const& data)
     case RocksDBEntryType::Collection:
     case RocksDBEntryType::View:
     case RocksDBEntryType::KeyGeneratorValue:
+    case RocksDBEntryType::IndexHistogramValue:
+    case RocksDBEntryType::DocumentDictionaryValue:
     case RocksDBEntryType::ReplicationApplierConfig: {
       _buffer.reserve(static_cast<size_t>(data.byteSize()));
       _buffer.append(reinterpret_cast<char const*>(data.begin()),
@@ -54,6 +54,8 @@ class RocksDBValue {
   static RocksDBValue View(VPackSlice const& data);
   static RocksDBValue ReplicationApplierConfig(VPackSlice const& data);
   static RocksDBValue KeyGeneratorValue(VPackSlice const& data);
+  static RocksDBValue IndexHistogramValue(VPackSlice const& data);
+  static RocksDBValue DocumentDictionaryValue(VPackSlice const& data);
   static RocksDBValue S2Value(S2Point const& c);
 
   //////////////////////////////////////////////////////////////////////////////
@@ -24,6 +24,7 @@
 #include "Basics/StaticStrings.h"
 #include "Replication/TailingSyncer.h"
 #include "RestServer/DatabaseFeature.h"
+#include "RocksDBEngine/RocksDBCollection.h"
 #include "RocksDBEngine/RocksDBColumnFamily.h"
 #include "RocksDBEngine/RocksDBCommon.h"
 #include "RocksDBEngine/RocksDBLogValue.h"
@@ -104,7 +105,6 @@ class MyWALDumper final : public rocksdb::WriteBatch::Handler, public WalAccessC
               size_t maxResponseSize)
       : WalAccessContext(filter, f),
         _definitionsCF(RocksDBColumnFamily::definitions()->GetID()),
-        _documentsCF(RocksDBColumnFamily::documents()->GetID()),
         _primaryCF(RocksDBColumnFamily::primary()->GetID()),
         _maxResponseSize(maxResponseSize),
         _startSequence(0),
@@ -524,7 +524,7 @@ class MyWALDumper final : public rocksdb::WriteBatch::Handler, public WalAccessC
       // reset everything immediately after DDL operations
       resetTransientState();
 
-    } else if (column_family_id == _documentsCF) {
+    } else if (RocksDBColumnFamily::isDocuments(column_family_id)) {
       if (_state != TRANSACTION && _state != SINGLE_PUT) {
         resetTransientState();
         return rocksdb::Status();
@@ -548,6 +548,7 @@ class MyWALDumper final : public rocksdb::WriteBatch::Handler, public WalAccessC
       TRI_vocbase_t* vocbase = loadVocbase(dbid);
       LogicalCollection* col = loadCollection(dbid, cid);
       TRI_ASSERT(vocbase != nullptr && col != nullptr);
+      std::string valueBuffer;
 
       {
         VPackObjectBuilder marker(&_builder, true);
@@ -556,7 +557,7 @@ class MyWALDumper final : public rocksdb::WriteBatch::Handler, public WalAccessC
         marker->add("db", VPackValue(vocbase->name()));
         marker->add("cuid", VPackValue(col->guid()));
         marker->add("tid", VPackValue(std::to_string(_currentTrxId)));
-        marker->add("data", RocksDBValue::data(value));
+        marker->add("data", toRocksDBCollection(*col)->documentFromValue(value, valueBuffer));
       }
 
       printMarker(vocbase);
@@ -751,7 +752,6 @@ class MyWALDumper final : public rocksdb::WriteBatch::Handler, public WalAccessC
 
  private:
   uint32_t const _definitionsCF;
-  uint32_t const _documentsCF;
   uint32_t const _primaryCF;
   size_t const _maxResponseSize;
 
@@ -25,6 +25,7 @@
 #ifndef ARANGOD_SCHEDULER_SCHEDULER_H
 #define ARANGOD_SCHEDULER_SCHEDULER_H 1
 
+#include <array>
 #include <condition_variable>
 #include <mutex>
 #include <queue>
@@ -158,6 +159,8 @@ class Scheduler {
     uint64_t _fifo1;
     uint64_t _fifo2;
     uint64_t _fifo3;
+    // number of queued jobs per RequestLane
+    std::array<uint64_t, NumRequestLanes> _queuedPerLane;
   };
 
   virtual void addQueueStatistics(velocypack::Builder&) const = 0;
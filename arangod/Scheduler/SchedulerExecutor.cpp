@@ -0,0 +1,55 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "SchedulerExecutor.h"
+
+#include "Scheduler/Scheduler.h"
+#include "Scheduler/SchedulerFeature.h"
+
+#include <array>
+
+using namespace arangodb;
+
+namespace {
+template <size_t... I>
+std::array<SchedulerExecutor, NumRequestLanes> makeExecutors(std::index_sequence<I...>) {
+  return {{SchedulerExecutor(static_cast<RequestLane>(I))...}};
+}
+}  // namespace
+
+void SchedulerExecutor::add(Func func) {
+  Scheduler* scheduler = SchedulerFeature::SCHEDULER;
+  if (scheduler != nullptr) {
+    // the scheduler takes copyable functions only
+    auto fn = std::make_shared<Func>(std::move(func));
+    if (scheduler->queue(_lane, [fn]() { (*fn)(); })) {
+      return;
+    }
+    func = std::move(*fn);
+  }
+  func();
+}
+
+SchedulerExecutor* SchedulerExecutor::lane(RequestLane lane) {
+  static std::array<SchedulerExecutor, NumRequestLanes> executors =
+      makeExecutors(std::make_index_sequence<NumRequestLanes>());
+  TRI_ASSERT(static_cast<size_t>(lane) < executors.size());
+  return &executors[static_cast<size_t>(lane)];
+}
@@ -0,0 +1,48 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_SCHEDULER_SCHEDULER_EXECUTOR_H
+#define ARANGOD_SCHEDULER_SCHEDULER_EXECUTOR_H 1
+
+#include "Futures/Executor.h"
+#include "GeneralServer/RequestLane.h"
+
+namespace arangodb {
+
+/// @brief runs future continuations as jobs on one lane of the scheduler,
+/// e.g. future.via(SchedulerExecutor::lane(RequestLane::CLUSTER_INTERNAL)).
+/// continuations run inline if there is no scheduler, or if its queue for
+/// the lane is full
+class SchedulerExecutor final : public futures::Executor {
+ public:
+  explicit SchedulerExecutor(RequestLane lane) : _lane(lane) {}
+
+  void add(Func func) override;
+
+  /// @brief the executor for a lane, which lives as long as the process
+  static SchedulerExecutor* lane(RequestLane lane);
+
+ private:
+  RequestLane const _lane;
+};
+
+}  // namespace arangodb
+
+#endif
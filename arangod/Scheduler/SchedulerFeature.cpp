@@ -110,6 +110,12 @@ void SchedulerFeature::collectOptions(std::shared_ptr<options::ProgramOptions> o
                      new UInt64Parameter(&_fifo1Size),
                      arangodb::options::makeFlags(arangodb::options::Flags::Hidden));
 
+  options->addOption("--server.maximal-client-lane-queue-size",
+                     "maximum number of queued requests per client request "
+                     "lane, further requests are rejected (0 = unlimited)",
+                     new UInt64Parameter(&_clientLaneQueueSize),
+                     arangodb::options::makeFlags(arangodb::options::Flags::Hidden));
+
   // obsolete options
   options->addObsoleteOption("--server.threads", "number of threads", true);
 
@@ -170,7 +176,8 @@ void SchedulerFeature::prepare() {
 #endif
   _scheduler =
       std::make_unique<SupervisedScheduler>(_nrMinimalThreads, _nrMaximalThreads,
-                                            _queueSize, _fifo1Size, _fifo2Size);
+                                            _queueSize, _fifo1Size, _fifo2Size,
+                                            _clientLaneQueueSize);
 #if (_MSC_VER >= 1)
 #pragma warning(pop)
 #endif
@@ -44,12 +44,17 @@ class SchedulerFeature final : public application_features::ApplicationFeature {
   void stop() override final;
   void unprepare() override final;
 
+  /// @brief the maximal number of scheduler threads, valid after the
+  /// options have been validated
+  uint64_t maximalThreads() const { return _nrMaximalThreads; }
+
  private:
   uint64_t _nrMinimalThreads = 2;
   uint64_t _nrMaximalThreads = 0;
   uint64_t _queueSize = 128;
   uint64_t _fifo1Size = 1024 * 1024;
   uint64_t _fifo2Size = 4096;
+  uint64_t _clientLaneQueueSize = 0;
 
   std::unique_ptr<Scheduler> _scheduler;
 
@@ -36,6 +36,7 @@
 #include "Random/RandomGenerator.h"
 #include "Rest/GeneralResponse.h"
 #include "Statistics/RequestStatistics.h"
+#include "Statistics/Tracing.h"
 
 using namespace arangodb;
 using namespace arangodb::basics;
@@ -94,15 +95,23 @@ class SupervisedSchedulerWorkerThread final : public SupervisedSchedulerThread {
 
 }  // namespace arangodb
 
+thread_local SupervisedScheduler::LocalQueue* SupervisedScheduler::_currentLocalQueue = nullptr;
+thread_local SupervisedScheduler* SupervisedScheduler::_currentScheduler = nullptr;
+thread_local SupervisedScheduler::WorkItem const* SupervisedScheduler::_currentWork = nullptr;
+
 SupervisedScheduler::SupervisedScheduler(uint64_t minThreads, uint64_t maxThreads,
                                          uint64_t maxQueueSize,
-                                         uint64_t fifo1Size, uint64_t fifo2Size)
+                                         uint64_t fifo1Size, uint64_t fifo2Size,
+                                         uint64_t maxClientLaneQueueSize)
     : _numWorker(0),
       _stopping(false),
+      _localQueuesMemory(new char[maxThreads * sizeof(LocalQueue) + alignof(LocalQueue)]),
+      _localQueues(nullptr),
       _jobsSubmitted(0),
       _jobsDequeued(0),
       _jobsDone(0),
       _jobsDirectExec(0),
+      _maxClientLaneQueueSize(maxClientLaneQueueSize),
       _wakeupQueueLength(5),
       _wakeupTime_ns(1000),
       _definitiveWakeupTime_ns(100000),
@@ -111,9 +120,50 @@ SupervisedScheduler::SupervisedScheduler(uint64_t minThreads, uint64_t maxThread
   _queue[0].reserve(maxQueueSize);
   _queue[1].reserve(fifo1Size);
   _queue[2].reserve(fifo2Size);
+
+  for (auto& queued : _queuedPerLane) {
+    queued.store(0, std::memory_order_relaxed);
+  }
+
+  void* memory = _localQueuesMemory.get();
+  size_t space = maxThreads * sizeof(LocalQueue) + alignof(LocalQueue);
+  memory = std::align(alignof(LocalQueue), maxThreads * sizeof(LocalQueue), memory, space);
+  TRI_ASSERT(memory != nullptr);
+  _localQueues = static_cast<LocalQueue*>(memory);
+  for (uint64_t i = 0; i < maxThreads; ++i) {
+    new (&_localQueues[i]) LocalQueue();
+  }
+}
+
+SupervisedScheduler::~SupervisedScheduler() {
+  for (size_t i = 0; i < _maxNumWorker; ++i) {
+    _localQueues[i].~LocalQueue();
+  }
+
+  WorkItem* work;
+  while (_freeWorkItems.pop(work)) {
+    delete work;
+  }
+}
+
+SupervisedScheduler::WorkItem* SupervisedScheduler::acquireWorkItem(std::function<void()>&& handler,
+                                                                    RequestLane lane) {
+  WorkItem* work;
+  if (_freeWorkItems.pop(work)) {
+    work->_handler = std::move(handler);
+    work->_lane = lane;
+    return work;
+  }
+  return new WorkItem(std::move(handler), lane);
 }
 
-SupervisedScheduler::~SupervisedScheduler() {}
+void SupervisedScheduler::releaseWorkItem(WorkItem* work) noexcept {
+  // destroy the captures right away, and not only when the item is reused
+  work->_handler = nullptr;
+  if (!_freeWorkItems.bounded_push(work)) {
+    delete work;
+  }
+}
 
 bool SupervisedScheduler::queue(RequestLane lane, std::function<void()> handler, bool allowDirectHandling) {
   if (!isDirectDeadlockLane(lane) &&
@@ -138,10 +188,38 @@ bool SupervisedScheduler::queue(RequestLane lane, std::function<void()> handler,
   TRI_ASSERT(queueNo <= 2);
   TRI_ASSERT(isStopping() == false);
 
-  WorkItem* work = new WorkItem(std::move(handler));
+  std::atomic<uint64_t>& queuedInLane = _queuedPerLane[static_cast<size_t>(lane)];
 
-  if (!_queue[queueNo].push(work)) {
-    delete work;
+  if (_maxClientLaneQueueSize != 0 && isClientRequestLane(lane) &&
+      queuedInLane.load(std::memory_order_relaxed) >= _maxClientLaneQueueSize) {
+    // this lane is overloaded, reject right away
+    return false;
+  }
+
+  tracing::SpanContext trace = tracing::current();
+  if (trace.sampled()) {
+    // record the time spent in the queue, and continue the trace on the
+    // worker thread
+    handler = [trace, queued = tracing::now(), handler = std::move(handler)]() {
+      tracing::record("scheduler queue", trace, queued, tracing::now());
+      tracing::ContextScope scope(trace);
+      handler();
+    };
+  }
+
+  WorkItem* work = acquireWorkItem(std::move(handler), lane);
+  queuedInLane.fetch_add(1, std::memory_order_relaxed);
+
+  WorkItem* expected = nullptr;
+  if (_currentScheduler == this && _currentLocalQueue != nullptr &&
+      _currentWork != nullptr && _currentWork->_lane == lane &&
+      _currentLocalQueue->_work.compare_exchange_strong(expected, work,
+                                                        std::memory_order_release,
+                                                        std::memory_order_relaxed)) {
+    // queued as the continuation of the job running on this worker thread
+  } else if (!_queue[queueNo].push(work)) {
+    queuedInLane.fetch_sub(1, std::memory_order_relaxed);
+    releaseWorkItem(work);
     return false;
   }
 
@@ -240,6 +318,8 @@ void SupervisedScheduler::runWorker() {
   state->_sleepTimeout_ms = 20 * (id + 1);
   state->_queueRetryCount = (512 >> id) + 3;
 
+  acquireLocalQueue();
+
   while (true) {
     std::unique_ptr<WorkItem> work = getWork(state);
     if (work == nullptr) {
@@ -247,10 +327,12 @@ void SupervisedScheduler::runWorker() {
     }
 
     _jobsDequeued++;
+    _queuedPerLane[static_cast<size_t>(work->_lane)].fetch_sub(1, std::memory_order_relaxed);
 
     try {
       state->_lastJobStarted = clock::now();
       state->_working = true;
+      _currentWork = work.get();
       work->_handler();
       state->_working = false;
     } catch (std::exception const& ex) {
@@ -260,9 +342,81 @@ void SupervisedScheduler::runWorker() {
       LOG_TOPIC("d4121", ERR, Logger::THREADS)
           << "scheduler loop caught unknown exception";
     }
+    _currentWork = nullptr;
 
+    releaseWorkItem(work.release());
     _jobsDone.fetch_add(1, std::memory_order_release);
   }
+
+  releaseLocalQueue();
+}
+
+void SupervisedScheduler::acquireLocalQueue() {
+  // the number of running worker threads, including abandoned ones, never
+  // exceeds _maxNumWorker, so there is always a free slot
+  for (size_t i = 0; i < _maxNumWorker; ++i) {
+    if (!_localQueues[i]._inUse.exchange(true, std::memory_order_acquire)) {
+      _currentLocalQueue = &_localQueues[i];
+      _currentScheduler = this;
+      return;
+    }
+  }
+
+  // run without a local slot. all jobs go to the shared queues
+  TRI_ASSERT(false);
+}
+
+void SupervisedScheduler::releaseLocalQueue() {
+  if (_currentLocalQueue == nullptr) {
+    return;
+  }
+
+  // getWork only returns nullptr after it has emptied this thread's slot,
+  // and nobody but this thread can fill it
+  TRI_ASSERT(_currentLocalQueue->_work.load() == nullptr);
+  _currentLocalQueue->_inUse.store(false, std::memory_order_release);
+  _currentLocalQueue = nullptr;
+  _currentScheduler = nullptr;
+}
+
+bool SupervisedScheduler::stealWork(WorkItem*& work) {
+  // start scanning right after the own slot, so that idle workers do not all
+  // compete for the same slots, and the lowest slots are not always drained
+  // first
+  size_t start = 0;
+  if (_currentLocalQueue != nullptr) {
+    start = static_cast<size_t>(_currentLocalQueue - _localQueues) + 1;
+  }
+
+  for (size_t i = 0; i < _maxNumWorker; ++i) {
+    LocalQueue& queue = _localQueues[(start + i) % _maxNumWorker];
+    if (&queue != _currentLocalQueue &&
+        queue._work.load(std::memory_order_relaxed) != nullptr) {
+      work = queue._work.exchange(nullptr, std::memory_order_acquire);
+      if (work != nullptr && startOrRequeue(work)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+// must keep some real or potential threads reserved for high priority
+bool SupervisedScheduler::canStart(WorkItem const* work) const {
+  return PriorityRequestLane(work->_lane) == RequestPriority::HIGH ||
+         (_jobsDequeued - _jobsDone) < (_maxNumWorker / 2);
+}
+
+// decides for a job taken from a local slot whether it runs now. a job that
+// must wait for the high priority reservation is moved to its shared queue,
+// where it is dequeued like all other jobs of its priority
+bool SupervisedScheduler::startOrRequeue(WorkItem* work) {
+  if (canStart(work)) {
+    return true;
+  }
+  size_t queueNo = static_cast<size_t>(PriorityRequestLane(work->_lane));
+  // if the shared queue cannot take it, run it rather than lose it
+  return !_queue[queueNo].push(work);
 }
 
 void SupervisedScheduler::runSupervisor() {
@@ -375,6 +529,16 @@ std::unique_ptr<SupervisedScheduler::WorkItem> SupervisedScheduler::getWork(
     std::shared_ptr<WorkerState>& state) {
   WorkItem* work;
 
+  // a continuation queued by the previous job of this thread runs first. this
+  // is done even if the thread is about to stop, so the slot is always empty
+  // when the thread leaves getWork with a nullptr
+  if (_currentLocalQueue != nullptr) {
+    work = _currentLocalQueue->_work.exchange(nullptr, std::memory_order_acquire);
+    if (work != nullptr && startOrRequeue(work)) {
+      return std::unique_ptr<WorkItem>(work);
+    }
+  }
+
   while (!state->_stop) {
     uint64_t triesCount = 0;
     while (triesCount < state->_queueRetryCount) {
@@ -390,6 +554,11 @@ std::unique_ptr<SupervisedScheduler::WorkItem> SupervisedScheduler::getWork(
       cpu_relax();
     } // while
 
+    // the shared queues are empty, take over a continuation of a busy worker
+    if (stealWork(work)) {
+      return std::unique_ptr<WorkItem>(work);
+    }
+
     std::unique_lock<std::mutex> guard(_mutex);
 
     if (state->_stop) {
@@ -505,7 +674,11 @@ Scheduler::QueueStatistics SupervisedScheduler::queueStatistics() const {
   uint64_t queueLength = _jobsSubmitted.load(std::memory_order_relaxed) -
                          _jobsDone.load(std::memory_order_relaxed);
 
-  return QueueStatistics{numWorker, numWorker, queueLength, 0, 0, 0};
+  QueueStatistics stats{numWorker, numWorker, queueLength, 0, 0, 0, {}};
+  for (size_t i = 0; i < NumRequestLanes; ++i) {
+    stats._queuedPerLane[i] = _queuedPerLane[i].load(std::memory_order_relaxed);
+  }
+  return stats;
 }
 
 void SupervisedScheduler::addQueueStatistics(velocypack::Builder& b) const {
@@ -40,7 +40,8 @@ class SupervisedSchedulerManagerThread;
 class SupervisedScheduler final : public Scheduler {
  public:
   SupervisedScheduler(uint64_t minThreads, uint64_t maxThreads, uint64_t maxQueueSize,
-                      uint64_t fifo1Size, uint64_t fifo2Size);
+                      uint64_t fifo1Size, uint64_t fifo2Size,
+                      uint64_t maxClientLaneQueueSize = 0);
   virtual ~SupervisedScheduler();
 
   bool queue(RequestLane lane, std::function<void()>, bool allowDirectHandling = false) override;
@@ -66,11 +67,12 @@ class SupervisedScheduler final : public Scheduler {
 
   struct WorkItem final {
     std::function<void()> _handler;
+    RequestLane _lane;
 
-    explicit WorkItem(std::function<void()> const& handler)
-        : _handler(handler) {}
-    explicit WorkItem(std::function<void()>&& handler)
-        : _handler(std::move(handler)) {}
+    explicit WorkItem(std::function<void()> const& handler, RequestLane lane)
+        : _handler(handler), _lane(lane) {}
+    explicit WorkItem(std::function<void()>&& handler, RequestLane lane)
+        : _handler(std::move(handler)), _lane(lane) {}
     ~WorkItem() {}
 
     void operator()() { _handler(); }
@@ -80,12 +82,53 @@ class SupervisedScheduler final : public Scheduler {
   // in a container class and store pointers. -- Maybe there is a better way?
   boost::lockfree::queue<WorkItem*> _queue[3];
 
+  // WorkItems that have been executed are kept for reuse, so that queueing a
+  // job does not need a heap allocation for the WorkItem in the common case.
+  // The list is bounded, surplus items are freed.
+  static size_t const FREELIST_SIZE = 4 * 1024;
+  boost::lockfree::queue<WorkItem*, boost::lockfree::capacity<FREELIST_SIZE>> _freeWorkItems;
+
+  WorkItem* acquireWorkItem(std::function<void()>&& handler, RequestLane lane);
+  void releaseWorkItem(WorkItem* work) noexcept;
+
+  // Each running worker thread owns one local slot. A job queued from within
+  // a worker thread in the lane of the job it is running is put into that
+  // thread's slot if it is empty, so the continuation of a handler runs next
+  // on the same thread (and core), without touching the shared queues. Idle
+  // workers steal from other workers' slots when the shared queues are empty,
+  // so a slot never starves behind a long running job. Low priority jobs from
+  // a slot are subject to the same high priority reservation as jobs from the
+  // shared queues.
+  struct alignas(64) LocalQueue {
+    std::atomic<WorkItem*> _work;
+    std::atomic<bool> _inUse;
+
+    LocalQueue() : _work(nullptr), _inUse(false) {}
+  };
+  // new[] does not honor the alignment of LocalQueue before C++17, so the
+  // slots are constructed in a suitably aligned part of _localQueuesMemory
+  std::unique_ptr<char[]> _localQueuesMemory;
+  LocalQueue* _localQueues;
+
+  // slot, scheduler and running job of the current worker thread, nullptr
+  // for other threads
+  static thread_local LocalQueue* _currentLocalQueue;
+  static thread_local SupervisedScheduler* _currentScheduler;
+  static thread_local WorkItem const* _currentWork;
+
   // aligning required to prevent false sharing - assumes cache line size is 64
   alignas(64) std::atomic<uint64_t> _jobsSubmitted;
   alignas(64) std::atomic<uint64_t> _jobsDequeued;
   alignas(64) std::atomic<uint64_t> _jobsDone;
   alignas(64) std::atomic<uint64_t> _jobsDirectExec;
 
+  // number of queued, but not yet dequeued jobs per lane. a client lane with
+  // more than _maxClientLaneQueueSize queued jobs (0 = unlimited) rejects new
+  // jobs, so that a flood of one kind of client requests can neither fill up
+  // the shared queues nor delay cluster internal requests indefinitely
+  alignas(64) std::atomic<uint64_t> _queuedPerLane[NumRequestLanes];
+  uint64_t const _maxClientLaneQueueSize;
+
   // During a queue operation there a two reasons to manually wake up a worker
   //  1. the queue length is bigger than _wakeupQueueLength and the last submit time
   //      is bigger than _wakeupTime_ns.
@@ -140,6 +183,11 @@ class SupervisedScheduler final : public Scheduler {
   std::unique_ptr<SupervisedSchedulerManagerThread> _manager;
 
   std::unique_ptr<WorkItem> getWork(std::shared_ptr<WorkerState>& state);
+  bool stealWork(WorkItem*& work);
+  bool canStart(WorkItem const* work) const;
+  bool startOrRequeue(WorkItem* work);
+  void acquireLocalQueue();
+  void releaseLocalQueue();
 
   void startOneThread();
   void stopOneThread();
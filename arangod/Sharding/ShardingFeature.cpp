@@ -25,6 +25,7 @@
 #include "Cluster/ServerState.h"
 #include "Sharding/ShardingInfo.h"
 #include "Sharding/ShardingStrategyDefault.h"
+#include "Sharding/ShardingStrategyGeo.h"
 #include "VocBase/LogicalCollection.h"
 
 #ifdef USE_ENTERPRISE
@@ -59,6 +60,9 @@ void ShardingFeature::prepare() {
   registerFactory(ShardingStrategyHash::NAME, [](ShardingInfo* sharding) {
     return std::make_unique<ShardingStrategyHash>(sharding);
   });
+  registerFactory(ShardingStrategyGeo::NAME, [](ShardingInfo* sharding) {
+    return std::make_unique<ShardingStrategyGeo>(sharding);
+  });
 #ifdef USE_ENTERPRISE
   // the following sharding strategies are only available in the enterprise
   // edition
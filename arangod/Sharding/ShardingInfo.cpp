@@ -385,3 +385,8 @@ int ShardingInfo::getResponsibleShard(arangodb::velocypack::Slice slice, bool do
   return _shardingStrategy->getResponsibleShard(slice, docComplete, shardID,
                                                 usesDefaultShardKeys, key);
 }
+
+int ShardingInfo::getResponsibleShards(arangodb::velocypack::Slice documents,
+                                       bool docComplete, std::vector<ShardID>& shardIDs) {
+  return _shardingStrategy->getResponsibleShards(documents, docComplete, shardIDs);
+}
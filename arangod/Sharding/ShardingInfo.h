@@ -46,6 +46,7 @@ class ShardingInfo {
 
   bool usesSameShardingStrategy(ShardingInfo const* other) const;
   std::string shardingStrategyName() const;
+  ShardingStrategy* shardingStrategy() const { return _shardingStrategy.get(); }
 
   LogicalCollection* collection() const;
   void toVelocyPack(arangodb::velocypack::Builder& result, bool translateCids);
@@ -82,6 +83,9 @@ class ShardingInfo {
                           ShardID& shardID, bool& usesDefaultShardKeys,
                           std::string const& key = "");
 
+  int getResponsibleShards(arangodb::velocypack::Slice documents, bool docComplete,
+                           std::vector<ShardID>& shardIDs);
+
  private:
   // @brief the logical collection we are working for
   LogicalCollection* _collection;
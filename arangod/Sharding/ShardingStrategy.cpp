@@ -22,9 +22,11 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "ShardingStrategy.h"
+#include "Basics/StaticStrings.h"
 #include "Cluster/ServerState.h"
 
 #include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
 #include <velocypack/velocypack-aliases.h>
 
 using namespace arangodb;
@@ -33,6 +35,30 @@ bool ShardingStrategy::isCompatible(ShardingStrategy const* other) const {
   return name() == other->name();
 }
 
+int ShardingStrategy::getResponsibleShards(VPackSlice documents, bool docComplete,
+                                           std::vector<ShardID>& shardIDs) {
+  TRI_ASSERT(documents.isArray());
+  VPackBuilder temp;
+  ShardID shardID;
+  bool usesDefaultShardKeys;
+
+  for (VPackSlice value : VPackArrayIterator(documents)) {
+    if (value.isString()) {
+      temp.clear();
+      temp.openObject();
+      temp.add(StaticStrings::KeyString, value);
+      temp.close();
+      value = temp.slice();
+    }
+    int res = getResponsibleShard(value, docComplete, shardID, usesDefaultShardKeys);
+    if (res != TRI_ERROR_NO_ERROR) {
+      return res;
+    }
+    shardIDs.emplace_back(shardID);
+  }
+  return TRI_ERROR_NO_ERROR;
+}
+
 void ShardingStrategy::toVelocyPack(VPackBuilder& result) {
   // only need to print sharding strategy if we are in a cluster
   if (ServerState::instance()->isRunningInCluster()) {
@@ -74,6 +74,19 @@ class ShardingStrategy {
   virtual int getResponsibleShard(arangodb::velocypack::Slice, bool docComplete,
                                   ShardID& shardID, bool& usesDefaultShardKeys,
                                   std::string const& key = "") = 0;
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief find the shards that are responsible for all documents of an
+  /// array. A member of the array that is a string is treated like a document
+  /// with just this `_key`.
+  ///
+  /// The responsible shard of each document is appended to shardIDs, in
+  /// order. Stops at the first document for which getResponsibleShard would
+  /// report an error, and returns that error.
+  ////////////////////////////////////////////////////////////////////////////////
+
+  virtual int getResponsibleShards(arangodb::velocypack::Slice documents,
+                                   bool docComplete, std::vector<ShardID>& shardIDs);
 };
 
 }  // namespace arangodb
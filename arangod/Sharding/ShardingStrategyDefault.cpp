@@ -32,6 +32,7 @@
 #include "VocBase/LogicalCollection.h"
 
 #include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
 #include <velocypack/Slice.h>
 #include <velocypack/StringRef.h>
 #include <velocypack/velocypack-aliases.h>
@@ -42,6 +43,18 @@ namespace {
 
 enum class Part : uint8_t { ALL, FRONT, BACK };
 
+/// @brief appended to the hash of the shard keys, to improve the distribution
+constexpr char const* magicPhrase =
+    "Foxx you have stolen the goose, give she back again!";
+constexpr size_t magicLength = 52;
+
+/// @brief whether a string slice is encoded the way a builder would encode
+/// it, so that hashing it in place gives the same result as hashing a copy
+inline bool isShortestString(VPackSlice const& sub) {
+  // strings of up to 126 bytes have a short form
+  return sub.head() != 0xbf || sub.getStringLength() > 126;
+}
+
 void preventUseOnSmartEdgeCollection(LogicalCollection const* collection,
                                      std::string const& strategyName) {
   if (collection->isSmart() && collection->type() == TRI_COL_TYPE_EDGE) {
@@ -79,6 +92,10 @@ VPackSlice buildTemporarySlice(VPackSlice const& sub, Part const& part,
     }
     switch (part) {
       case Part::ALL: {
+        if (key.size() == sub.getStringLength() && isShortestString(sub)) {
+          // the key is the whole string, which needs no copy
+          return sub;
+        }
         // by adding the key to the builder, we may invalidate the original key...
         // however, this is safe here as the original key is not used after we have
         // added to the builder
@@ -238,10 +255,6 @@ int ShardingStrategyHashBase::getResponsibleShard(arangodb::velocypack::Slice sl
                                                   bool docComplete, ShardID& shardID,
                                                   bool& usesDefaultShardKeys,
                                                   std::string const& key) {
-  static constexpr char const* magicPhrase =
-      "Foxx you have stolen the goose, give she back again!";
-  static constexpr size_t magicLength = 52;
-
   determineShards();
   TRI_ASSERT(!_shards.empty());
 
@@ -253,11 +266,53 @@ int ShardingStrategyHashBase::getResponsibleShard(arangodb::velocypack::Slice sl
 
   uint64_t hash = hashByAttributes(slice, _sharding->shardKeys(), docComplete, res, key);
   // To improve our hash function result:
-  hash = TRI_FnvHashBlock(hash, magicPhrase, magicLength);
+  hash = TRI_FnvHashBlock(hash, ::magicPhrase, ::magicLength);
   shardID = _shards[hash % _shards.size()];
   return res;
 }
 
+int ShardingStrategyHashBase::getResponsibleShardsImpl(VPackSlice documents, bool docComplete,
+                                                       std::vector<ShardID>& shardIDs) {
+  TRI_ASSERT(documents.isArray());
+  determineShards();
+  TRI_ASSERT(!_shards.empty());
+
+  auto const& shardKeys = _sharding->shardKeys();
+  TRI_ASSERT(!shardKeys.empty());
+  // with `_key` as the only shard key, a document given by its key can be
+  // hashed without building the document {_key: key} first. both hash the
+  // key string only
+  bool const keyOnly = (shardKeys.size() == 1 && shardKeys[0] == StaticStrings::KeyString);
+
+  VPackBuilder temporaryBuilder;
+  for (VPackSlice value : VPackArrayIterator(documents)) {
+    int res = TRI_ERROR_NO_ERROR;
+    uint64_t hash;
+    if (value.isString() && keyOnly) {
+      temporaryBuilder.clear();
+      VPackSlice sub =
+          ::buildTemporarySlice<false>(value, ::Part::ALL, temporaryBuilder, false);
+      hash = sub.normalizedHash(TRI_FnvHashBlockInitial());
+    } else {
+      if (value.isString()) {
+        temporaryBuilder.clear();
+        temporaryBuilder.openObject();
+        temporaryBuilder.add(StaticStrings::KeyString, value);
+        temporaryBuilder.close();
+        value = temporaryBuilder.slice();
+      }
+      // calls virtual "hashByAttributes" function
+      hash = hashByAttributes(value, shardKeys, docComplete, res, StaticStrings::Empty);
+    }
+    if (res != TRI_ERROR_NO_ERROR) {
+      return res;
+    }
+    hash = TRI_FnvHashBlock(hash, ::magicPhrase, ::magicLength);
+    shardIDs.emplace_back(_shards[hash % _shards.size()]);
+  }
+  return TRI_ERROR_NO_ERROR;
+}
+
 void ShardingStrategyHashBase::determineShards() {
   if (_shardsSet) {
     TRI_ASSERT(!_shards.empty());
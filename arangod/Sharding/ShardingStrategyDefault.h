@@ -91,10 +91,15 @@ class ShardingStrategyHashBase : public ShardingStrategy {
                                     std::vector<std::string> const& attributes,
                                     bool docComplete, int& error, std::string const& key);
 
- private:
+ protected:
+  /// @brief batch version of getResponsibleShard. only usable by strategies
+  /// that do not override getResponsibleShard
+  int getResponsibleShardsImpl(arangodb::velocypack::Slice documents,
+                               bool docComplete, std::vector<ShardID>& shardIDs);
+
+  /// @brief fetch the collection's shards on first use
   void determineShards();
 
- protected:
   ShardingInfo* _sharding;
   std::vector<ShardID> _shards;
   bool _usesDefaultShardKeys;
@@ -110,6 +115,11 @@ class ShardingStrategyCommunityCompat final : public ShardingStrategyHashBase {
 
   std::string const& name() const override { return NAME; }
 
+  int getResponsibleShards(arangodb::velocypack::Slice documents, bool docComplete,
+                           std::vector<ShardID>& shardIDs) override {
+    return getResponsibleShardsImpl(documents, docComplete, shardIDs);
+  }
+
   static std::string const NAME;
 };
 
@@ -148,6 +158,11 @@ class ShardingStrategyHash final : public ShardingStrategyHashBase {
 
   std::string const& name() const override { return NAME; }
 
+  int getResponsibleShards(arangodb::velocypack::Slice documents, bool docComplete,
+                           std::vector<ShardID>& shardIDs) override {
+    return getResponsibleShardsImpl(documents, docComplete, shardIDs);
+  }
+
   static std::string const NAME;
 };
 
@@ -0,0 +1,134 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "ShardingStrategyGeo.h"
+#include "Basics/Exceptions.h"
+#include "Basics/StaticStrings.h"
+#include "Geo/GeoJson.h"
+#include "Sharding/ShardingInfo.h"
+
+#include <s2/s2latlng.h>
+
+#include <velocypack/Slice.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+namespace {
+/// @brief leaf cell ids of all six cube faces lie below this value
+constexpr uint64_t cellIdRange = uint64_t(S2CellId::kNumFaces) << S2CellId::kPosBits;
+}  // namespace
+
+std::string const ShardingStrategyGeo::NAME("geo");
+
+ShardingStrategyGeo::ShardingStrategyGeo(ShardingInfo* sharding)
+    : ShardingStrategyHashBase(sharding) {
+  TRI_ASSERT(!_usesDefaultShardKeys);
+  auto const& shardKeys = _sharding->shardKeys();
+  if (shardKeys.size() > 2) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(
+        TRI_ERROR_BAD_PARAMETER,
+        std::string("sharding strategy ") + NAME +
+            " needs a location attribute or a latitude and a longitude attribute as shard keys");
+  }
+  for (auto const& it : shardKeys) {
+    if (it == StaticStrings::KeyString || it.front() == ':' || it.back() == ':') {
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_BAD_PARAMETER,
+                                     std::string("invalid shard key '") + it +
+                                         "' for sharding strategy " + NAME);
+    }
+  }
+}
+
+int ShardingStrategyGeo::location(VPackSlice doc, bool docComplete,
+                                  S2LatLng& point, bool& valid) const {
+  valid = false;
+  doc = doc.resolveExternal();
+  if (!doc.isObject()) {
+    return docComplete ? TRI_ERROR_NO_ERROR : TRI_ERROR_CLUSTER_NOT_ALL_SHARDING_ATTRIBUTES_GIVEN;
+  }
+
+  auto const& shardKeys = _sharding->shardKeys();
+  VPackSlice values[2];
+  for (size_t i = 0; i < shardKeys.size(); ++i) {
+    values[i] = doc.get(shardKeys[i]).resolveExternal();
+    if (values[i].isNone() && !docComplete) {
+      return TRI_ERROR_CLUSTER_NOT_ALL_SHARDING_ATTRIBUTES_GIVEN;
+    }
+  }
+
+  if (shardKeys.size() == 2) {
+    if (values[0].isNumber() && values[1].isNumber()) {
+      point = S2LatLng::FromDegrees(values[0].getNumber<double>(),
+                                    values[1].getNumber<double>());
+      valid = point.is_valid();
+    }
+  } else if (values[0].isArray() ||
+             geo::geojson::type(values[0]) == geo::geojson::Type::POINT) {
+    valid = geo::geojson::parsePoint(values[0], point).ok() && point.is_valid();
+  }
+  return TRI_ERROR_NO_ERROR;
+}
+
+int ShardingStrategyGeo::getResponsibleShard(VPackSlice slice, bool docComplete,
+                                             ShardID& shardID, bool& usesDefaultShardKeys,
+                                             std::string const& key) {
+  determineShards();
+  TRI_ASSERT(!_shards.empty());
+  usesDefaultShardKeys = false;
+
+  S2LatLng point;
+  bool valid;
+  int res = location(slice, docComplete, point, valid);
+  if (res != TRI_ERROR_NO_ERROR) {
+    return res;
+  }
+
+  if (!valid) {
+    // no point, so no geo query can prune the shard of this document away
+    shardID = _shards[0];
+  } else {
+    shardID = _shards[shardIndex(S2CellId(point), _shards.size())];
+  }
+  return TRI_ERROR_NO_ERROR;
+}
+
+std::unordered_set<ShardID> ShardingStrategyGeo::shardsForCells(std::vector<S2CellId> const& cells) {
+  determineShards();
+  TRI_ASSERT(!_shards.empty());
+
+  std::unordered_set<ShardID> result;
+  result.emplace(_shards[0]);
+  for (S2CellId const& cell : cells) {
+    size_t const first = shardIndex(cell.range_min(), _shards.size());
+    size_t const last = shardIndex(cell.range_max(), _shards.size());
+    for (size_t i = first; i <= last; ++i) {
+      result.emplace(_shards[i]);
+    }
+  }
+  return result;
+}
+
+size_t ShardingStrategyGeo::shardIndex(S2CellId cell, size_t numShards) {
+  TRI_ASSERT(numShards > 0);
+  uint64_t const perShard = (::cellIdRange + numShards - 1) / numShards;
+  size_t const index = static_cast<size_t>(cell.id() / perShard);
+  return std::min(index, numShards - 1);
+}
@@ -0,0 +1,73 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_SHARDING_SHARDING_STRATEGY_GEO_H
+#define ARANGOD_SHARDING_SHARDING_STRATEGY_GEO_H 1
+
+#include "Basics/Common.h"
+#include "Sharding/ShardingStrategyDefault.h"
+
+#include <s2/s2cell_id.h>
+
+#include <unordered_set>
+
+class S2LatLng;
+
+namespace arangodb {
+class ShardingInfo;
+
+/// @brief sharding by location. the shard keys hold a point, either as a
+/// latitude and a longitude attribute, or as a single attribute with a
+/// GeoJSON point or a [longitude, latitude] pair, like a geo index with
+/// geoJson set. the S2 cells along the Hilbert curve are split into equal
+/// ranges, one per shard, so that documents close to each other are mostly
+/// on the same shard. documents without a point location are put on the
+/// first shard
+class ShardingStrategyGeo final : public ShardingStrategyHashBase {
+ public:
+  explicit ShardingStrategyGeo(ShardingInfo* sharding);
+
+  std::string const& name() const override { return NAME; }
+
+  int getResponsibleShard(arangodb::velocypack::Slice, bool docComplete,
+                          ShardID& shardID, bool& usesDefaultShardKeys,
+                          std::string const& key = "") override;
+
+  /// @brief the shards that may hold documents located in one of the
+  /// cells. the first shard is always included
+  std::unordered_set<ShardID> shardsForCells(std::vector<S2CellId> const& cells);
+
+  /// @brief the shard of a leaf cell, out of the given number of shards
+  static size_t shardIndex(S2CellId cell, size_t numShards);
+
+  static std::string const NAME;
+
+ private:
+  /// @brief read the point a document is located at. returns
+  /// TRI_ERROR_CLUSTER_NOT_ALL_SHARDING_ATTRIBUTES_GIVEN for incomplete
+  /// documents without the shard keys, and sets valid to false if the
+  /// shard keys do not hold a point
+  int location(arangodb::velocypack::Slice doc, bool docComplete,
+               S2LatLng& point, bool& valid) const;
+};
+
+}  // namespace arangodb
+
+#endif
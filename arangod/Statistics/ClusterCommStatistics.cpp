@@ -0,0 +1,147 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "ClusterCommStatistics.h"
+
+#include "Basics/MutexLocker.h"
+#include "Statistics/Metrics.h"
+#include "Statistics/StatisticsFeature.h"
+#include "Statistics/figures.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::basics;
+
+namespace {
+struct ShardStatistics {
+  ShardStatistics()
+      : totalTime(TRI_RequestTimeDistributionVectorStatistics) {}
+
+  StatisticsDistribution totalTime;
+};
+
+struct DestinationStatistics {
+  DestinationStatistics()
+      : requests(0),
+        inFlight(0),
+        totalTime(TRI_RequestTimeDistributionVectorStatistics),
+        queueTime(TRI_RequestTimeDistributionVectorStatistics),
+        bytesSent(TRI_BytesSentDistributionVectorStatistics),
+        bytesReceived(TRI_BytesReceivedDistributionVectorStatistics) {}
+
+  uint64_t requests;
+  int64_t inFlight;
+  StatisticsDistribution totalTime;
+  StatisticsDistribution queueTime;
+  StatisticsDistribution bytesSent;
+  StatisticsDistribution bytesReceived;
+  std::unordered_map<std::string, std::unique_ptr<ShardStatistics>> shards;
+};
+
+/// @brief protects destinations
+Mutex destinationsMutex;
+
+/// @brief statistics per destination server
+std::unordered_map<std::string, std::unique_ptr<DestinationStatistics>> destinations;
+
+DestinationStatistics& destination(std::string const& serverID) {
+  auto& entry = destinations[serverID];
+  if (entry == nullptr) {
+    entry = std::make_unique<DestinationStatistics>();
+  }
+  return *entry;
+}
+
+void addDistribution(VPackBuilder& b, char const* name, StatisticsDistribution const& dist) {
+  b.add(name, VPackValue(VPackValueType::Object));
+  b.add("sum", VPackValue(dist._total));
+  b.add("count", VPackValue(dist._count));
+  b.add("counts", VPackValue(VPackValueType::Array));
+  for (auto const& it : dist._counts) {
+    b.add(VPackValue(it));
+  }
+  b.close();
+  b.close();
+}
+}  // namespace
+
+bool ClusterCommStatistics::requestStarted(Sample& sample) {
+  if (!StatisticsFeature::enabled()) {
+    return false;
+  }
+
+  sample.startTime = TRI_microtime();
+
+  MUTEX_LOCKER(guard, destinationsMutex);
+  DestinationStatistics& dest = destination(sample.serverID);
+  ++dest.requests;
+  ++dest.inFlight;
+  dest.bytesSent.addFigure(static_cast<double>(sample.bytesSent));
+  return true;
+}
+
+void ClusterCommStatistics::requestFinished(Sample const& sample, size_t bytesReceived) {
+  double const now = TRI_microtime();
+  // responses that never went through the scheduler (e.g. connection
+  // errors) did not spend any time in the queue
+  double const receivedTime = sample.receivedTime > 0.0 ? sample.receivedTime : now;
+  metrics::ClusterRequestTime.observe(receivedTime - sample.startTime);
+
+  MUTEX_LOCKER(guard, destinationsMutex);
+  DestinationStatistics& dest = destination(sample.serverID);
+  --dest.inFlight;
+  dest.totalTime.addFigure(receivedTime - sample.startTime);
+  dest.queueTime.addFigure(now - receivedTime);
+  dest.bytesReceived.addFigure(static_cast<double>(bytesReceived));
+
+  if (!sample.shardID.empty()) {
+    auto& shard = dest.shards[sample.shardID];
+    if (shard == nullptr) {
+      shard = std::make_unique<ShardStatistics>();
+    }
+    shard->totalTime.addFigure(receivedTime - sample.startTime);
+  }
+}
+
+void ClusterCommStatistics::toVelocyPack(VPackBuilder& builder) {
+  MUTEX_LOCKER(guard, destinationsMutex);
+  for (auto const& it : destinations) {
+    DestinationStatistics const& dest = *it.second;
+    builder.add(it.first, VPackValue(VPackValueType::Object));
+    builder.add("requests", VPackValue(dest.requests));
+    builder.add("inFlight", VPackValue(dest.inFlight));
+    addDistribution(builder, "totalTime", dest.totalTime);
+    addDistribution(builder, "queueTime", dest.queueTime);
+    addDistribution(builder, "bytesSent", dest.bytesSent);
+    addDistribution(builder, "bytesReceived", dest.bytesReceived);
+
+    builder.add("shards", VPackValue(VPackValueType::Object));
+    for (auto const& shard : dest.shards) {
+      builder.add(shard.first, VPackValue(VPackValueType::Object));
+      addDistribution(builder, "totalTime", shard.second->totalTime);
+      builder.close();
+    }
+    builder.close();  // shards
+
+    builder.close();
+  }
+}
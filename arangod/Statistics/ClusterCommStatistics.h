@@ -0,0 +1,62 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_STATISTICS_CLUSTER_COMM_STATISTICS_H
+#define ARANGOD_STATISTICS_CLUSTER_COMM_STATISTICS_H 1
+
+#include "Basics/Common.h"
+
+namespace arangodb {
+namespace velocypack {
+class Builder;
+}
+
+/// @brief per-destination statistics for the cluster-internal requests
+/// sent via ClusterComm. these make it possible to find out which DB server
+/// (and which of its shards) is responsible for slow cluster operations
+class ClusterCommStatistics {
+ public:
+  /// @brief bookkeeping for a single request
+  struct Sample {
+    std::string serverID;
+    std::string shardID;
+    size_t bytesSent = 0;
+    /// @brief time the request was handed to the communicator
+    double startTime = 0.0;
+    /// @brief time the response arrived in the communicator, the time
+    /// until the response callback runs is accounted as queue time
+    double receivedTime = 0.0;
+  };
+
+  /// @brief registers the start of a request. returns false if statistics
+  /// are disabled, in which case requestFinished must not be called
+  static bool requestStarted(Sample& sample);
+
+  /// @brief registers the completion (or failure) of a request
+  static void requestFinished(Sample const& sample, size_t bytesReceived);
+
+  /// @brief adds the statistics of all destinations to the builder, which
+  /// must contain an open object
+  static void toVelocyPack(velocypack::Builder& builder);
+};
+
+}  // namespace arangodb
+
+#endif
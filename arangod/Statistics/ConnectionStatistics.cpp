@@ -24,7 +24,9 @@
 #include "ConnectionStatistics.h"
 
 #include "Basics/MutexLocker.h"
+#include "GeneralServer/GeneralServerFeature.h"
 #include "Rest/CommonDefines.h"
+#include "Statistics/RequestStatistics.h"
 
 using namespace arangodb;
 using namespace arangodb::basics;
@@ -49,6 +51,12 @@ void ConnectionStatistics::SET_HTTP(ConnectionStatistics* stat) {
   }
 }
 
+void ConnectionStatistics::ADD_ACCEPT_TIME(double acceptTime) {
+  if (StatisticsFeature::enabled()) {
+    TRI_AcceptTimeDistributionStatistics.addFigure(acceptTime);
+  }
+}
+
 void ConnectionStatistics::initialize() {
   _statisticsBuffer.reset(new ConnectionStatistics[QUEUE_SIZE]());
 
@@ -79,15 +87,21 @@ void ConnectionStatistics::fill(
   }
 
   httpConnections = TRI_HttpConnectionsStatistics;
-  totalRequests = TRI_TotalRequestsStatistics;
-  {
-    MUTEX_LOCKER(locker, TRI_RequestsStatisticsMutex);
-    methodRequests = TRI_MethodRequestsStatistics;
-  }
-  asyncRequests = TRI_AsyncRequestsStatistics;
+  RequestStatistics::fillCounters(totalRequests, methodRequests, asyncRequests);
   connectionTime = TRI_ConnectionTimeDistributionStatistics;
 }
 
+void ConnectionStatistics::fillAccept(StatisticsDistribution& acceptTime,
+                                      std::vector<uint64_t>& ioContextConnections) {
+  ioContextConnections = GeneralServerFeature::ioContextClients();
+
+  if (!StatisticsFeature::enabled()) {
+    return;
+  }
+
+  acceptTime = TRI_AcceptTimeDistributionStatistics;
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                    public methods
 // -----------------------------------------------------------------------------
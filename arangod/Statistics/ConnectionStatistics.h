@@ -48,12 +48,21 @@ class ConnectionStatistics {
 
   static void SET_HTTP(ConnectionStatistics* stat);
 
+  /// @brief time from accepting a connection until its comm task is started,
+  /// which includes the TLS handshake
+  static void ADD_ACCEPT_TIME(double acceptTime);
+
   static void fill(basics::StatisticsCounter& httpConnections,
                    basics::StatisticsCounter& totalRequests,
                    std::array<basics::StatisticsCounter, basics::MethodRequestsStatisticsSize>& methodRequests,
                    basics::StatisticsCounter& asyncRequests,
                    basics::StatisticsDistribution& connectionTime);
 
+  /// @brief accept latencies and the number of connections each io context
+  /// of the general server currently handles
+  static void fillAccept(basics::StatisticsDistribution& acceptTime,
+                         std::vector<uint64_t>& ioContextConnections);
+
  private:
   ConnectionStatistics() { reset(); }
 
@@ -22,6 +22,8 @@
 
 #include "Descriptions.h"
 #include "Basics/process-utils.h"
+#include "GeneralServer/ReadBufferPool.h"
+#include "Rest/HttpResponse.h"
 #include "Scheduler/Scheduler.h"
 #include "Scheduler/SchedulerFeature.h"
 #include "Statistics/ConnectionStatistics.h"
@@ -106,6 +108,7 @@ void stats::Figure::toVPack(velocypack::Builder& b) const {
 stats::Descriptions::Descriptions()
     : _requestTimeCuts(arangodb::basics::TRI_RequestTimeDistributionVectorStatistics),
       _connectionTimeCuts(arangodb::basics::TRI_ConnectionTimeDistributionVectorStatistics),
+      _acceptTimeCuts(arangodb::basics::TRI_AcceptTimeDistributionVectorStatistics),
       _bytesSendCuts(arangodb::basics::TRI_BytesSentDistributionVectorStatistics),
       _bytesReceivedCuts(arangodb::basics::TRI_BytesReceivedDistributionVectorStatistics) {
   _groups.emplace_back(Group{stats::GroupType::System, "Process Statistics",
@@ -248,6 +251,12 @@ stats::Descriptions::Descriptions()
              // cuts: internal.connectionTimeDistribution,
              stats::Unit::Seconds, _connectionTimeCuts});
 
+  _figures.emplace_back(
+      Figure{stats::GroupType::Client, "acceptTime", "Accept Time",
+             "Time from accepting a connection until it is served, including "
+             "the TLS handshake.",
+             stats::FigureType::Distribution, stats::Unit::Seconds, _acceptTimeCuts});
+
   _figures.emplace_back(Figure{stats::GroupType::Http,
                                "requestsTotal",
                                "Total requests",
@@ -374,6 +383,14 @@ void stats::Descriptions::serverStatistics(velocypack::Builder& b) const {
   SchedulerFeature::SCHEDULER->addQueueStatistics(b);
 
   b.close();
+
+  b.add("readBuffers", VPackValue(VPackValueType::Object, true));
+  rest::ReadBufferPool::toVelocyPack(b);
+  b.close();
+
+  b.add("compression", VPackValue(VPackValueType::Object, true));
+  HttpResponse::compressionStatistics(b);
+  b.close();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -407,6 +424,18 @@ void stats::Descriptions::clientStatistics(velocypack::Builder& b) const {
   b.add("httpConnections", VPackValue(httpConnections._count));
   FillDistribution(b, "connectionTime", connectionTime);
 
+  basics::StatisticsDistribution acceptTime;
+  std::vector<uint64_t> ioContextConnections;
+
+  ConnectionStatistics::fillAccept(acceptTime, ioContextConnections);
+
+  FillDistribution(b, "acceptTime", acceptTime);
+  b.add("ioContextConnections", VPackValue(VPackValueType::Array, true));
+  for (uint64_t connections : ioContextConnections) {
+    b.add(VPackValue(connections));
+  }
+  b.close();
+
   basics::StatisticsDistribution totalTime;
   basics::StatisticsDistribution requestTime;
   basics::StatisticsDistribution queueTime;
@@ -82,6 +82,7 @@ class Descriptions final {
  private:
   std::vector<double> _requestTimeCuts;
   std::vector<double> _connectionTimeCuts;
+  std::vector<double> _acceptTimeCuts;
   std::vector<double> _bytesSendCuts;
   std::vector<double> _bytesReceivedCuts;
 
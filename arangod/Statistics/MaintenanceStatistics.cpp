@@ -0,0 +1,74 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "MaintenanceStatistics.h"
+
+#include "Basics/MutexLocker.h"
+#include "Statistics/StatisticsFeature.h"
+#include "Statistics/figures.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::basics;
+
+namespace {
+constexpr size_t numPhases = static_cast<size_t>(MaintenanceStatistics::Phase::TOTAL) + 1;
+
+char const* const phaseNames[numPhases] = {"localCollections", "phaseOne",
+                                            "phaseTwo", "report", "total"};
+
+struct PhaseStatistics {
+  PhaseStatistics() : time(TRI_RequestTimeDistributionVectorStatistics) {}
+
+  StatisticsDistribution time;
+};
+
+/// @brief protects phases
+Mutex phasesMutex;
+
+PhaseStatistics phases[numPhases];
+}  // namespace
+
+void MaintenanceStatistics::addPhaseTime(Phase phase, double seconds) {
+  if (!StatisticsFeature::enabled()) {
+    return;
+  }
+
+  MUTEX_LOCKER(guard, phasesMutex);
+  phases[static_cast<size_t>(phase)].time.addFigure(seconds);
+}
+
+void MaintenanceStatistics::toVelocyPack(VPackBuilder& builder) {
+  MUTEX_LOCKER(guard, phasesMutex);
+  for (size_t i = 0; i < numPhases; ++i) {
+    StatisticsDistribution const& dist = phases[i].time;
+    builder.add(phaseNames[i], VPackValue(VPackValueType::Object));
+    builder.add("sum", VPackValue(dist._total));
+    builder.add("count", VPackValue(dist._count));
+    builder.add("counts", VPackValue(VPackValueType::Array));
+    for (auto const& it : dist._counts) {
+      builder.add(VPackValue(it));
+    }
+    builder.close();
+    builder.close();
+  }
+}
@@ -0,0 +1,54 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_STATISTICS_MAINTENANCE_STATISTICS_H
+#define ARANGOD_STATISTICS_MAINTENANCE_STATISTICS_H 1
+
+#include "Basics/Common.h"
+
+namespace arangodb {
+namespace velocypack {
+class Builder;
+}
+
+/// @brief time spent by the DB server maintenance (DBServerAgencySync) in
+/// each of its phases, to see where a slow maintenance run spends its time
+class MaintenanceStatistics {
+ public:
+  enum class Phase {
+    LOCAL_COLLECTIONS = 0,  // collecting the local shards
+    PHASE_ONE,              // diffing plan and local, creating actions
+    PHASE_TWO,              // diffing local and current
+    REPORT,                 // reporting to current
+    TOTAL
+  };
+
+  /// @brief registers the duration of a phase in seconds. does nothing if
+  /// statistics are disabled
+  static void addPhaseTime(Phase phase, double seconds);
+
+  /// @brief adds the statistics of all phases to the builder, which must
+  /// contain an open object
+  static void toVelocyPack(velocypack::Builder& builder);
+};
+
+}  // namespace arangodb
+
+#endif
@@ -0,0 +1,316 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Metrics.h"
+
+#include "Basics/StringUtils.h"
+#include "Cache/CacheManagerFeature.h"
+#include "Cache/Manager.h"
+#include "GeneralServer/RequestLane.h"
+#include "Rest/CommonDefines.h"
+#include "Scheduler/Scheduler.h"
+#include "Scheduler/SchedulerFeature.h"
+#include "Statistics/RequestStatistics.h"
+#include "Statistics/ServerStatistics.h"
+#include "Statistics/StatisticsFeature.h"
+#include "StorageEngine/EngineSelectorFeature.h"
+#include "StorageEngine/StorageEngine.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace arangodb;
+using namespace arangodb::basics;
+
+namespace {
+std::vector<double> const durationBounds({0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025,
+                                          0.05, 0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0});
+
+char const* const laneNames[] = {"client-fast",      "client-aql",      "client-v8",
+                                 "client-slow",      "client-ui",       "agency-internal",
+                                 "agency-cluster",   "cluster-internal", "cluster-v8",
+                                 "cluster-admin",    "server-replication", "task-v8",
+                                 "internal-low"};
+static_assert(sizeof(laneNames) / sizeof(laneNames[0]) == NumRequestLanes,
+              "lane names out of sync with RequestLane");
+
+std::string number(double value) {
+  if (std::isnan(value)) {
+    return "NaN";
+  }
+  if (std::isinf(value)) {
+    return value > 0 ? "+Inf" : "-Inf";
+  }
+  return StringUtils::ftoa(value);
+}
+
+void header(std::string& result, std::string const& name, char const* type,
+            char const* help) {
+  result.append("# HELP ").append(name).append(" ").append(help).append("\n");
+  result.append("# TYPE ").append(name).append(" ").append(type).append("\n");
+}
+
+// the labels must be rendered already, e.g. {method="GET"}
+void sample(std::string& result, std::string const& name,
+            std::string const& labels, std::string const& value) {
+  result.append(name).append(labels).append(" ").append(value).append("\n");
+}
+
+void counter(std::string& result, std::string const& name, char const* help,
+             uint64_t value) {
+  header(result, name, "counter", help);
+  sample(result, name, "", StringUtils::itoa(value));
+}
+
+void gauge(std::string& result, std::string const& name, char const* help, double value) {
+  header(result, name, "gauge", help);
+  sample(result, name, "", number(value));
+}
+
+// buckets are per bucket, Prometheus buckets are cumulative
+void histogram(std::string& result, std::string const& name, char const* help,
+               std::vector<double> const& bounds,
+               std::vector<uint64_t> const& buckets, double sum) {
+  TRI_ASSERT(buckets.size() == bounds.size() + 1);
+  header(result, name, "histogram", help);
+  uint64_t total = 0;
+  for (size_t i = 0; i < buckets.size(); ++i) {
+    total += buckets[i];
+    std::string le = i < bounds.size() ? number(bounds[i]) : "+Inf";
+    sample(result, name + "_bucket", "{le=\"" + le + "\"}", StringUtils::itoa(total));
+  }
+  sample(result, name + "_sum", "", number(sum));
+  sample(result, name + "_count", "", StringUtils::itoa(total));
+}
+
+void histogram(std::string& result, std::string const& name, char const* help,
+               metrics::Histogram const& h) {
+  histogram(result, name, help, h.bounds(), h.counts(), h.sum());
+}
+
+// the request distributions count values below their cuts, which is close
+// enough to the "less or equal" of Prometheus buckets
+void histogram(std::string& result, std::string const& name, char const* help,
+               StatisticsDistribution const& dist) {
+  histogram(result, name, help, dist._cuts, dist._counts, dist._total);
+}
+
+// makes a valid metric name of a storage engine figure, e.g.
+// "rocksdb.num-running-flushes" becomes "arangodb_rocksdb_num_running_flushes"
+std::string metricName(std::string const& figure) {
+  std::string name("arangodb_");
+  for (char c : figure) {
+    if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')) {
+      name.push_back(c);
+    } else if (name.back() != '_') {
+      name.push_back('_');
+    }
+  }
+  return name;
+}
+
+void serverMetrics(std::string& result) {
+  gauge(result, "arangodb_server_uptime_seconds",
+        "Number of seconds the server has been running",
+        ServerStatistics::statistics()._uptime);
+
+  counter(result, "arangodb_transactions_started_total",
+          "Number of top-level transactions started",
+          metrics::TransactionsStarted.load());
+  counter(result, "arangodb_transactions_committed_total",
+          "Number of top-level transactions committed",
+          metrics::TransactionsCommitted.load());
+  counter(result, "arangodb_transactions_aborted_total",
+          "Number of top-level transactions aborted",
+          metrics::TransactionsAborted.load());
+
+  histogram(result, "arangodb_cluster_request_duration_seconds",
+            "Time until the response of a cluster-internal request arrived",
+            metrics::ClusterRequestTime);
+}
+
+void httpMetrics(std::string& result) {
+  StatisticsCounter totalRequests;
+  std::array<StatisticsCounter, MethodRequestsStatisticsSize> methodRequests;
+  StatisticsCounter asyncRequests;
+  RequestStatistics::fillCounters(totalRequests, methodRequests, asyncRequests);
+
+  gauge(result, "arangodb_http_connections", "Number of open client connections",
+        static_cast<double>(TRI_HttpConnectionsStatistics._count.load()));
+  counter(result, "arangodb_http_async_requests_total",
+          "Number of asynchronously executed requests",
+          static_cast<uint64_t>(asyncRequests._count.load()));
+
+  std::string const name("arangodb_http_requests_total");
+  header(result, name, "counter", "Number of requests by HTTP method");
+  for (size_t i = 0; i < MethodRequestsStatisticsSize; ++i) {
+    auto type = static_cast<rest::RequestType>(i);
+    if (type == rest::RequestType::ILLEGAL) {
+      continue;
+    }
+    sample(result, name,
+           std::string("{method=\"") + rest::requestToString(type) + "\"}",
+           StringUtils::itoa(static_cast<uint64_t>(methodRequests[i]._count.load())));
+  }
+
+  if (!StatisticsFeature::enabled()) {
+    return;
+  }
+
+  StatisticsDistribution totalTime;
+  StatisticsDistribution requestTime;
+  StatisticsDistribution queueTime;
+  StatisticsDistribution ioTime;
+  StatisticsDistribution bytesSent;
+  StatisticsDistribution bytesReceived;
+  RequestStatistics::fill(totalTime, requestTime, queueTime, ioTime, bytesSent, bytesReceived);
+
+  histogram(result, "arangodb_http_request_duration_seconds",
+            "Time between receiving a request and sending the response", totalTime);
+  histogram(result, "arangodb_http_request_execution_duration_seconds",
+            "Time spent executing requests", requestTime);
+  histogram(result, "arangodb_http_request_queue_duration_seconds",
+            "Time requests spent in the scheduler queue", queueTime);
+  histogram(result, "arangodb_http_request_received_bytes",
+            "Size of the received requests", bytesReceived);
+  histogram(result, "arangodb_http_response_sent_bytes",
+            "Size of the sent responses", bytesSent);
+}
+
+void schedulerMetrics(std::string& result) {
+  Scheduler* scheduler = SchedulerFeature::SCHEDULER;
+  if (scheduler == nullptr) {
+    return;
+  }
+
+  Scheduler::QueueStatistics stats = scheduler->queueStatistics();
+  gauge(result, "arangodb_scheduler_threads", "Number of scheduler worker threads",
+        static_cast<double>(stats._running));
+  gauge(result, "arangodb_scheduler_queue_length",
+        "Number of jobs submitted to the scheduler and not yet done",
+        static_cast<double>(stats._queued));
+
+  std::string const name("arangodb_scheduler_lane_queue_length");
+  header(result, name, "gauge", "Number of jobs queued by request lane");
+  for (size_t i = 0; i < NumRequestLanes; ++i) {
+    sample(result, name, std::string("{lane=\"") + ::laneNames[i] + "\"}",
+           StringUtils::itoa(stats._queuedPerLane[i]));
+  }
+}
+
+void cacheMetrics(std::string& result) {
+  cache::Manager* manager = CacheManagerFeature::MANAGER;
+  if (manager == nullptr) {
+    return;
+  }
+
+  auto rates = manager->globalHitRates();
+  gauge(result, "arangodb_cache_limit_bytes", "Global memory limit of the caches",
+        static_cast<double>(manager->globalLimit()));
+  gauge(result, "arangodb_cache_allocated_bytes",
+        "Memory allocated by all caches", static_cast<double>(manager->globalAllocation()));
+  // the rates are percentages, or NaN if there were no lookups yet
+  gauge(result, "arangodb_cache_hit_rate_lifetime",
+        "Ratio of cache hits since the server started", rates.first / 100.0);
+  gauge(result, "arangodb_cache_hit_rate_recent",
+        "Ratio of cache hits among the recent lookups", rates.second / 100.0);
+}
+
+void engineMetrics(std::string& result) {
+  StorageEngine* engine = EngineSelectorFeature::ENGINE;
+  if (engine == nullptr) {
+    return;
+  }
+
+  VPackBuilder builder;
+  engine->getStatistics(builder);
+  VPackSlice stats = builder.slice();
+  if (!stats.isObject()) {
+    return;
+  }
+
+  for (auto const& it : VPackObjectIterator(stats)) {
+    // nested objects and textual reports cannot be exported as samples
+    if (!it.value.isNumber()) {
+      continue;
+    }
+    std::string figure = it.key.copyString();
+    if (StringUtils::isPrefix(figure, "cache.")) {
+      // exported by cacheMetrics
+      continue;
+    }
+    gauge(result, ::metricName(figure), "Storage engine figure",
+          it.value.getNumber<double>());
+  }
+}
+}  // namespace
+
+namespace arangodb {
+namespace metrics {
+
+Counter TransactionsStarted;
+Counter TransactionsCommitted;
+Counter TransactionsAborted;
+
+Histogram ClusterRequestTime(::durationBounds);
+
+Histogram::Histogram(std::vector<double> bounds)
+    : _bounds(std::move(bounds)),
+      _counts(new std::atomic<uint64_t>[_bounds.size() + 1]),
+      _sum(0.0) {
+  TRI_ASSERT(std::is_sorted(_bounds.begin(), _bounds.end()));
+  for (size_t i = 0; i <= _bounds.size(); ++i) {
+    _counts[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+void Histogram::observe(double value) {
+  size_t bucket = std::lower_bound(_bounds.begin(), _bounds.end(), value) -
+                  _bounds.begin();
+  _counts[bucket].fetch_add(1, std::memory_order_relaxed);
+
+  double sum = _sum.load(std::memory_order_relaxed);
+  while (!_sum.compare_exchange_weak(sum, sum + value, std::memory_order_relaxed)) {
+  }
+}
+
+std::vector<uint64_t> Histogram::counts() const {
+  std::vector<uint64_t> result;
+  result.reserve(_bounds.size() + 1);
+  for (size_t i = 0; i <= _bounds.size(); ++i) {
+    result.push_back(_counts[i].load(std::memory_order_relaxed));
+  }
+  return result;
+}
+
+void toPrometheus(std::string& result) {
+  ::serverMetrics(result);
+  ::httpMetrics(result);
+  ::schedulerMetrics(result);
+  ::cacheMetrics(result);
+  ::engineMetrics(result);
+}
+
+}  // namespace metrics
+}  // namespace arangodb
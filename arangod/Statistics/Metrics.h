@@ -0,0 +1,83 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_STATISTICS_METRICS_H
+#define ARANGOD_STATISTICS_METRICS_H 1
+
+#include "Basics/Common.h"
+
+#include <atomic>
+
+namespace arangodb {
+namespace metrics {
+
+/// @brief a monotonic counter, safe to bump from any thread without locking
+class Counter {
+ public:
+  Counter() : _value(0) {}
+  Counter(Counter const&) = delete;
+  Counter& operator=(Counter const&) = delete;
+
+  void count(uint64_t n = 1) { _value.fetch_add(n, std::memory_order_relaxed); }
+  uint64_t load() const { return _value.load(std::memory_order_relaxed); }
+
+ private:
+  std::atomic<uint64_t> _value;
+};
+
+/// @brief a histogram with fixed bucket bounds. buckets count the values
+/// less than or equal to their bound, the last bucket takes everything else.
+/// recording a value takes three relaxed atomic operations and no lock
+class Histogram {
+ public:
+  explicit Histogram(std::vector<double> bounds);
+  Histogram(Histogram const&) = delete;
+  Histogram& operator=(Histogram const&) = delete;
+
+  void observe(double value);
+
+  std::vector<double> const& bounds() const { return _bounds; }
+  /// @brief per bucket, not cumulative, bounds().size() + 1 entries
+  std::vector<uint64_t> counts() const;
+  double sum() const { return _sum.load(std::memory_order_relaxed); }
+
+ private:
+  std::vector<double> const _bounds;
+  std::unique_ptr<std::atomic<uint64_t>[]> _counts;
+  std::atomic<double> _sum;
+};
+
+/// @brief top-level transactions, counted in transaction::Methods
+extern Counter TransactionsStarted;
+extern Counter TransactionsCommitted;
+extern Counter TransactionsAborted;
+
+/// @brief duration of ClusterComm requests until the response arrived
+extern Histogram ClusterRequestTime;
+
+/// @brief appends all metrics in the Prometheus text exposition format
+/// (version 0.0.4). figures owned by other subsystems (scheduler, storage
+/// engine, cache) are read at the time of the call
+void toPrometheus(std::string& result);
+
+}  // namespace metrics
+}  // namespace arangodb
+
+#endif
@@ -30,6 +30,109 @@
 using namespace arangodb;
 using namespace arangodb::basics;
 
+namespace {
+/// @brief upper limit for the number of buckets of the request distributions
+constexpr size_t MaxBuckets = 8;
+
+/// @brief number of statistics objects moved between a thread cache and the
+/// global pool at once
+constexpr size_t BatchSize = 32;
+
+// increments a value that is only written by one thread. readers may see
+// an older value, but never a torn one
+template <typename T>
+inline void add(std::atomic<T>& value, T n) {
+  value.store(value.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+/// @brief the part of a request distribution recorded by one thread
+struct ThreadDistribution {
+  explicit ThreadDistribution(std::vector<double> const& cuts)
+      : cuts(cuts), count(0), total(0.0) {
+    TRI_ASSERT(cuts.size() < MaxBuckets);
+    for (auto& it : counts) {
+      it.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  void addFigure(double value) {
+    add(count, uint64_t(1));
+    add(total, value);
+
+    size_t i = 0;
+    while (i < cuts.size() && value >= cuts[i]) {
+      ++i;
+    }
+    add(counts[i], uint64_t(1));
+  }
+
+  void addTo(StatisticsDistribution& result) const {
+    result._count += count.load(std::memory_order_relaxed);
+    result._total += total.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < result._counts.size(); ++i) {
+      result._counts[i] += counts[i].load(std::memory_order_relaxed);
+    }
+  }
+
+  std::vector<double> const& cuts;
+  std::atomic<uint64_t> count;
+  std::atomic<double> total;
+  std::array<std::atomic<uint64_t>, MaxBuckets> counts;
+};
+
+/// @brief the figures of all requests a thread has released. written by
+/// the owning thread only, readers add them up
+struct ThreadStatistics {
+  ThreadStatistics()
+      : totalRequests(0),
+        asyncRequests(0),
+        totalTime(TRI_RequestTimeDistributionVectorStatistics),
+        requestTime(TRI_RequestTimeDistributionVectorStatistics),
+        queueTime(TRI_RequestTimeDistributionVectorStatistics),
+        ioTime(TRI_RequestTimeDistributionVectorStatistics),
+        bytesSent(TRI_BytesSentDistributionVectorStatistics),
+        bytesReceived(TRI_BytesReceivedDistributionVectorStatistics),
+        inUse(false) {
+    for (auto& it : methodRequests) {
+      it.store(0, std::memory_order_relaxed);
+    }
+    freeList.reserve(2 * BatchSize);
+  }
+
+  std::atomic<uint64_t> totalRequests;
+  std::atomic<uint64_t> asyncRequests;
+  std::array<std::atomic<uint64_t>, MethodRequestsStatisticsSize> methodRequests;
+
+  ThreadDistribution totalTime;
+  ThreadDistribution requestTime;
+  ThreadDistribution queueTime;
+  ThreadDistribution ioTime;
+  ThreadDistribution bytesSent;
+  ThreadDistribution bytesReceived;
+
+  /// @brief statistics objects cached for acquire, owner only
+  std::vector<RequestStatistics*> freeList;
+
+  /// @brief whether a thread owns the entry, protected by threadsMutex
+  bool inUse;
+};
+
+/// @brief protects threads
+Mutex threadsMutex;
+
+/// @brief the statistics of all threads that ever released a request. the
+/// entries are never freed, as they hold the figures of their threads, but
+/// the entry of a finished thread is taken over by the next new thread
+std::vector<std::unique_ptr<ThreadStatistics>> threads;
+
+void forEachThread(std::function<void(ThreadStatistics const&)> const& cb) {
+  MUTEX_LOCKER(guard, threadsMutex);
+  for (auto const& it : threads) {
+    cb(*it);
+  }
+}
+}  // namespace
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                    static members
 // -----------------------------------------------------------------------------
@@ -38,7 +141,56 @@ std::unique_ptr<RequestStatistics[]> RequestStatistics::_statisticsBuffer;
 
 boost::lockfree::queue<RequestStatistics*, boost::lockfree::capacity<RequestStatistics::QUEUE_SIZE>> RequestStatistics::_freeList;
 
-boost::lockfree::queue<RequestStatistics*, boost::lockfree::capacity<RequestStatistics::QUEUE_SIZE>> RequestStatistics::_finishedList;
+namespace {
+/// @brief binds a ThreadStatistics entry to the current thread, and hands
+/// it back together with the cached objects when the thread ends
+class ThreadStatisticsHolder {
+ public:
+  ThreadStatisticsHolder() : _statistics(nullptr) {}
+
+  ~ThreadStatisticsHolder() {
+    if (_statistics == nullptr) {
+      return;
+    }
+    giveBack(_statistics->freeList.size());
+    MUTEX_LOCKER(guard, threadsMutex);
+    _statistics->inUse = false;
+  }
+
+  ThreadStatistics& get() {
+    if (_statistics == nullptr) {
+      MUTEX_LOCKER(guard, threadsMutex);
+      for (auto& it : threads) {
+        if (!it->inUse) {
+          _statistics = it.get();
+          break;
+        }
+      }
+      if (_statistics == nullptr) {
+        threads.emplace_back(std::make_unique<ThreadStatistics>());
+        _statistics = threads.back().get();
+      }
+      _statistics->inUse = true;
+    }
+    return *_statistics;
+  }
+
+  /// @brief moves cached objects back into the global pool
+  void giveBack(size_t n) {
+    auto& freeList = _statistics->freeList;
+    while (n-- > 0) {
+      RequestStatistics* statistics = freeList.back();
+      freeList.pop_back();
+      RequestStatistics::pushFree(statistics);
+    }
+  }
+
+ private:
+  ThreadStatistics* _statistics;
+};
+
+thread_local ThreadStatisticsHolder localStatistics;
+}  // namespace
 
 // -----------------------------------------------------------------------------
 // --SECTION--                                             static public methods
@@ -50,118 +202,101 @@ void RequestStatistics::initialize() {
   for (size_t i = 0; i < QUEUE_SIZE; ++i) {
     RequestStatistics* entry = &_statisticsBuffer[i];
     TRI_ASSERT(entry->_released);
-    TRI_ASSERT(!entry->_inQueue);
     bool ok = _freeList.push(entry);
     TRI_ASSERT(ok);
   }
 }
 
-size_t RequestStatistics::processAll() {
-  RequestStatistics* statistics = nullptr;
-  size_t count = 0;
-
-  while (_finishedList.pop(statistics)) {
-    if (statistics != nullptr) {
-      TRI_ASSERT(!statistics->_released);
-      TRI_ASSERT(statistics->_inQueue);
-      statistics->_inQueue = false;
-      process(statistics);
-      ++count;
-    }
-  }
-
-  return count;
-}
-
 RequestStatistics* RequestStatistics::acquire() {
   if (!StatisticsFeature::enabled()) {
     return nullptr;
   }
 
-  RequestStatistics* statistics = nullptr;
+  auto& freeList = ::localStatistics.get().freeList;
 
-  if (_freeList.pop(statistics)) {
-    TRI_ASSERT(statistics->_released);
-    TRI_ASSERT(!statistics->_inQueue);
+  if (freeList.empty()) {
+    // refill the thread cache with a batch from the global pool
+    RequestStatistics* statistics = nullptr;
+    while (freeList.size() < BatchSize && _freeList.pop(statistics)) {
+      TRI_ASSERT(statistics->_released);
+      freeList.push_back(statistics);
+    }
 
-    statistics->_released = false;
-  } else {
-    statistics = nullptr;
-    LOG_TOPIC("62d99", TRACE, arangodb::Logger::FIXME)
-        << "no free element on statistics queue";
+    if (freeList.empty()) {
+      LOG_TOPIC("62d99", TRACE, arangodb::Logger::FIXME)
+          << "no free element on statistics queue";
+      return nullptr;
+    }
   }
 
+  RequestStatistics* statistics = freeList.back();
+  freeList.pop_back();
+  TRI_ASSERT(statistics->_released);
+  statistics->_released = false;
+
   return statistics;
 }
 
-// -----------------------------------------------------------------------------
-// --SECTION--                                            static private methods
-// -----------------------------------------------------------------------------
+void RequestStatistics::pushFree(RequestStatistics* statistics) {
+  int tries = 0;
 
-void RequestStatistics::process(RequestStatistics* statistics) {
-  TRI_ASSERT(statistics != nullptr);
+  while (++tries < 1000) {
+    if (_freeList.push(statistics)) {
+      break;
+    }
+    std::this_thread::sleep_for(std::chrono::microseconds(10000));
+  }
 
-  {
-    TRI_TotalRequestsStatistics.incCounter();
+  if (tries > 1) {
+    LOG_TOPIC("fb453", WARN, Logger::MEMORY) << "_freeList.push failed " << tries - 1 << " times.";
+  }
+}
 
-    if (statistics->_async) {
-      TRI_AsyncRequestsStatistics.incCounter();
-    }
+// -----------------------------------------------------------------------------
+// --SECTION--                                                   private methods
+// -----------------------------------------------------------------------------
 
-    {
-      MUTEX_LOCKER(locker, TRI_RequestsStatisticsMutex);
-      TRI_MethodRequestsStatistics[(size_t)statistics->_requestType].incCounter();
-    }
+void RequestStatistics::process() {
+  ThreadStatistics& local = ::localStatistics.get();
 
-    // check that the request was completely received and transmitted
-    if (statistics->_readStart != 0.0 &&
-        (statistics->_async || statistics->_writeEnd != 0.0)) {
-      double totalTime;
+  add(local.totalRequests, uint64_t(1));
 
-      if (statistics->_async) {
-        totalTime = statistics->_requestEnd - statistics->_readStart;
-      } else {
-        totalTime = statistics->_writeEnd - statistics->_readStart;
-      }
+  if (_async) {
+    add(local.asyncRequests, uint64_t(1));
+  }
 
-      TRI_TotalTimeDistributionStatistics.addFigure(totalTime);
+  add(local.methodRequests[(size_t)_requestType], uint64_t(1));
 
-      double requestTime = statistics->_requestEnd - statistics->_requestStart;
-      TRI_RequestTimeDistributionStatistics.addFigure(requestTime);
+  // check that the request was completely received and transmitted
+  if (_readStart != 0.0 && (_async || _writeEnd != 0.0)) {
+    double totalTime;
 
-      double queueTime = 0.0;
+    if (_async) {
+      totalTime = _requestEnd - _readStart;
+    } else {
+      totalTime = _writeEnd - _readStart;
+    }
 
-      if (statistics->_queueStart != 0.0 && statistics->_queueEnd != 0.0) {
-        queueTime = statistics->_queueEnd - statistics->_queueStart;
-        TRI_QueueTimeDistributionStatistics.addFigure(queueTime);
-      }
+    local.totalTime.addFigure(totalTime);
 
-      double ioTime = totalTime - requestTime - queueTime;
+    double requestTime = _requestEnd - _requestStart;
+    local.requestTime.addFigure(requestTime);
 
-      if (ioTime >= 0.0) {
-        TRI_IoTimeDistributionStatistics.addFigure(ioTime);
-      }
+    double queueTime = 0.0;
 
-      TRI_BytesSentDistributionStatistics.addFigure(statistics->_sentBytes);
-      TRI_BytesReceivedDistributionStatistics.addFigure(statistics->_receivedBytes);
+    if (_queueStart != 0.0 && _queueEnd != 0.0) {
+      queueTime = _queueEnd - _queueStart;
+      local.queueTime.addFigure(queueTime);
     }
-  }
-
-  // clear statistics
-  statistics->reset();
 
-  // put statistics item back onto the freelist
-  int tries = 0;
+    double ioTime = totalTime - requestTime - queueTime;
 
-  while (++tries < 1000) {
-    if (_freeList.push(statistics)) {
-      break;
+    if (ioTime >= 0.0) {
+      local.ioTime.addFigure(ioTime);
     }
-    std::this_thread::sleep_for(std::chrono::microseconds(10000));
-  }
 
-  if (tries > 1) {
-    LOG_TOPIC("fb453", WARN, Logger::MEMORY) << "_freeList.push failed " << tries - 1 << " times.";
+    local.bytesSent.addFigure(_sentBytes);
+    local.bytesReceived.addFigure(_receivedBytes);
   }
 }
 
@@ -171,16 +306,20 @@ void RequestStatistics::process(RequestStatistics* statistics) {
 
 void RequestStatistics::release() {
   TRI_ASSERT(!_released);
-  TRI_ASSERT(!_inQueue);
 
   if (!_ignore) {
-    _inQueue = true;
-    bool ok = _finishedList.push(this);
-    TRI_ASSERT(ok);
-  } else {
-    reset();
-    bool ok = _freeList.push(this);
-    TRI_ASSERT(ok);
+    process();
+  }
+
+  reset();
+
+  auto& freeList = ::localStatistics.get().freeList;
+  freeList.push_back(this);
+
+  if (freeList.size() >= 2 * BatchSize) {
+    // this thread releases more than it acquires, e.g. because the requests
+    // are handled on other threads than they were read on
+    ::localStatistics.giveBack(BatchSize);
   }
 }
 
@@ -194,12 +333,51 @@ void RequestStatistics::fill(StatisticsDistribution& totalTime,
     return;
   }
 
-  totalTime = TRI_TotalTimeDistributionStatistics;
-  requestTime = TRI_RequestTimeDistributionStatistics;
-  queueTime = TRI_QueueTimeDistributionStatistics;
-  ioTime = TRI_IoTimeDistributionStatistics;
-  bytesSent = TRI_BytesSentDistributionStatistics;
-  bytesReceived = TRI_BytesReceivedDistributionStatistics;
+  auto init = [](StatisticsDistribution& dist, std::vector<double> const& cuts) {
+    dist._count = 0;
+    dist._total = 0.0;
+    dist._cuts = cuts;
+    dist._counts.assign(cuts.size() + 1, 0);
+  };
+
+  init(totalTime, TRI_RequestTimeDistributionVectorStatistics);
+  init(requestTime, TRI_RequestTimeDistributionVectorStatistics);
+  init(queueTime, TRI_RequestTimeDistributionVectorStatistics);
+  init(ioTime, TRI_RequestTimeDistributionVectorStatistics);
+  init(bytesSent, TRI_BytesSentDistributionVectorStatistics);
+  init(bytesReceived, TRI_BytesReceivedDistributionVectorStatistics);
+
+  ::forEachThread([&](ThreadStatistics const& local) {
+    local.totalTime.addTo(totalTime);
+    local.requestTime.addTo(requestTime);
+    local.queueTime.addTo(queueTime);
+    local.ioTime.addTo(ioTime);
+    local.bytesSent.addTo(bytesSent);
+    local.bytesReceived.addTo(bytesReceived);
+  });
+}
+
+void RequestStatistics::fillCounters(
+    StatisticsCounter& totalRequests,
+    std::array<StatisticsCounter, MethodRequestsStatisticsSize>& methodRequests,
+    StatisticsCounter& asyncRequests) {
+  int64_t total = 0;
+  int64_t async = 0;
+  std::array<int64_t, MethodRequestsStatisticsSize> methods{};
+
+  ::forEachThread([&](ThreadStatistics const& local) {
+    total += local.totalRequests.load(std::memory_order_relaxed);
+    async += local.asyncRequests.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < MethodRequestsStatisticsSize; ++i) {
+      methods[i] += local.methodRequests[i].load(std::memory_order_relaxed);
+    }
+  });
+
+  totalRequests._count.store(total);
+  asyncRequests._count.store(async);
+  for (size_t i = 0; i < MethodRequestsStatisticsSize; ++i) {
+    methodRequests[i]._count.store(methods[i]);
+  }
 }
 
 std::string RequestStatistics::timingsCsv() {
@@ -34,14 +34,23 @@
 #include <boost/lockfree/queue.hpp>
 
 namespace arangodb {
+
+/// @brief timings and sizes of a single request. the objects are pooled and
+/// cached per thread, and a released object is accounted in the figures of
+/// the releasing thread right away. the figures of all threads are only
+/// added up when they are read, so the request path neither allocates nor
+/// touches state shared with other threads, except for moving batches of
+/// objects between the thread caches and the global pool
 class RequestStatistics {
  public:
   static void initialize();
-  static size_t processAll();
 
   static RequestStatistics* acquire();
   void release();
 
+  /// @brief returns an unused object from a thread cache to the global pool
+  static void pushFree(RequestStatistics*);
+
   static void SET_ASYNC(RequestStatistics* stat) {
     if (stat != nullptr) {
       stat->_async = true;
@@ -153,6 +162,10 @@ class RequestStatistics {
                    basics::StatisticsDistribution& bytesSent,
                    basics::StatisticsDistribution& bytesReceived);
 
+  static void fillCounters(basics::StatisticsCounter& totalRequests,
+                           std::array<basics::StatisticsCounter, basics::MethodRequestsStatisticsSize>& methodRequests,
+                           basics::StatisticsCounter& asyncRequests);
+
   std::string timingsCsv();
   std::string to_string();
   void trace_log();
@@ -164,9 +177,8 @@ class RequestStatistics {
 
   static boost::lockfree::queue<RequestStatistics*, boost::lockfree::capacity<QUEUE_SIZE>> _freeList;
 
-  static boost::lockfree::queue<RequestStatistics*, boost::lockfree::capacity<QUEUE_SIZE>> _finishedList;
-
-  static void process(RequestStatistics*);
+  /// @brief adds the figures to the statistics of the calling thread
+  void process();
 
   RequestStatistics() { reset(); }
 
@@ -188,7 +200,6 @@ class RequestStatistics {
     _executeError = false;
     _ignore = false;
     _released = true;
-    _inQueue = false;
   }
 
   double _readStart;   // CommTask::processRead - read first byte of message
@@ -212,7 +223,6 @@ class RequestStatistics {
   bool _executeError;
   bool _ignore;
   bool _released;
-  bool _inQueue;
 };
 }  // namespace arangodb
 
@@ -30,6 +30,8 @@
 #include "Statistics/RequestStatistics.h"
 #include "Statistics/ServerStatistics.h"
 #include "Statistics/StatisticsWorker.h"
+#include "Statistics/TraceExporter.h"
+#include "Statistics/Tracing.h"
 #include "VocBase/vocbase.h"
 
 #include <chrono>
@@ -47,8 +49,8 @@ using namespace arangodb::options;
 namespace arangodb {
 namespace basics {
 
-Mutex TRI_RequestsStatisticsMutex;
-
+std::vector<double> const TRI_AcceptTimeDistributionVectorStatistics({0.0001, 0.001, 0.01,
+                                                                      0.1, 1.0});
 std::vector<double> const TRI_BytesReceivedDistributionVectorStatistics({250, 1000, 2000,
                                                                          5000, 10000});
 std::vector<double> const TRI_BytesSentDistributionVectorStatistics({250, 1000, 2000,
@@ -57,66 +59,14 @@ std::vector<double> const TRI_ConnectionTimeDistributionVectorStatistics({0.1, 1
 std::vector<double> const TRI_RequestTimeDistributionVectorStatistics({0.01, 0.05, 0.1,
                                                                        0.2, 0.5, 1.0});
 
-StatisticsCounter TRI_AsyncRequestsStatistics;
 StatisticsCounter TRI_HttpConnectionsStatistics;
-StatisticsCounter TRI_TotalRequestsStatistics;
-std::array<StatisticsCounter, MethodRequestsStatisticsSize> TRI_MethodRequestsStatistics;
 
-StatisticsDistribution TRI_BytesReceivedDistributionStatistics(TRI_BytesReceivedDistributionVectorStatistics);
-StatisticsDistribution TRI_BytesSentDistributionStatistics(TRI_BytesSentDistributionVectorStatistics);
+StatisticsDistribution TRI_AcceptTimeDistributionStatistics(TRI_AcceptTimeDistributionVectorStatistics);
 StatisticsDistribution TRI_ConnectionTimeDistributionStatistics(TRI_ConnectionTimeDistributionVectorStatistics);
-StatisticsDistribution TRI_IoTimeDistributionStatistics(TRI_RequestTimeDistributionVectorStatistics);
-StatisticsDistribution TRI_QueueTimeDistributionStatistics(TRI_RequestTimeDistributionVectorStatistics);
-StatisticsDistribution TRI_RequestTimeDistributionStatistics(TRI_RequestTimeDistributionVectorStatistics);
-StatisticsDistribution TRI_TotalTimeDistributionStatistics(TRI_RequestTimeDistributionVectorStatistics);
 
 }  // namespace basics
 }  // namespace arangodb
 
-// -----------------------------------------------------------------------------
-// --SECTION--                                                  StatisticsThread
-// -----------------------------------------------------------------------------
-
-class arangodb::StatisticsThread final : public Thread {
- public:
-  StatisticsThread() : Thread("Statistics") {}
-  ~StatisticsThread() { shutdown(); }
-
- public:
-  void run() override {
-    uint64_t const MAX_SLEEP_TIME = 250 * 1000;
-
-    uint64_t sleepTime = 100 * 1000;
-    int nothingHappened = 0;
-
-    while (!isStopping() && StatisticsFeature::enabled()) {
-      size_t count = RequestStatistics::processAll();
-
-      if (count == 0) {
-        if (++nothingHappened == 10 * 30) {
-          // increase sleep time every 30 seconds
-          nothingHappened = 0;
-          sleepTime += 50 * 1000;
-
-          if (sleepTime > MAX_SLEEP_TIME) {
-            sleepTime = MAX_SLEEP_TIME;
-          }
-        }
-
-        std::this_thread::sleep_for(std::chrono::microseconds(sleepTime));
-      } else {
-        nothingHappened = 0;
-
-        if (count < 10) {
-          std::this_thread::sleep_for(std::chrono::microseconds(10 * 1000));
-        } else if (count < 100) {
-          std::this_thread::sleep_for(std::chrono::microseconds(1 * 1000));
-        }
-      }
-    }
-  }
-};
-
 // -----------------------------------------------------------------------------
 // --SECTION--                                                 StatisticsFeature
 // -----------------------------------------------------------------------------
@@ -126,6 +76,10 @@ StatisticsFeature* StatisticsFeature::STATISTICS = nullptr;
 StatisticsFeature::StatisticsFeature(application_features::ApplicationServer& server)
     : ApplicationFeature(server, "Statistics"),
       _statistics(true),
+      _exportMetricsApi(false),
+      _statisticsHistory(true),
+      _traceSampleRate(0.0),
+      _traceBufferSize(16384),
       _descriptions(new stats::Descriptions()) {
   startsAfter("AQLPhase");
   setOptional(true);
@@ -140,13 +94,66 @@ void StatisticsFeature::collectOptions(std::shared_ptr<ProgramOptions> options)
                      "turn statistics gathering on or off",
                      new BooleanParameter(&_statistics),
                      arangodb::options::makeFlags(arangodb::options::Flags::Hidden));
+
+  options->addOption("--server.export-metrics-api",
+                     "serve the statistics in Prometheus text format at "
+                     "/_admin/metrics. turns off --server.statistics-history "
+                     "unless that is set explicitly",
+                     new BooleanParameter(&_exportMetricsApi))
+                     .setIntroducedIn(30500);
+
+  options->addOption("--server.statistics-history",
+                     "periodically write the statistics into the system "
+                     "collections _statistics, _statistics15 and "
+                     "_statisticsRaw, as used by the web interface",
+                     new BooleanParameter(&_statisticsHistory))
+                     .setIntroducedIn(30500);
+
+  options->addOption("--server.trace-sample-rate",
+                     "fraction of requests that are traced (0 = off, "
+                     "1 = all). traced requests can be inspected at "
+                     "/_admin/trace",
+                     new DoubleParameter(&_traceSampleRate))
+                     .setIntroducedIn(30500);
+
+  options->addOption("--server.trace-buffer-size",
+                     "number of trace spans kept in memory",
+                     new UInt64Parameter(&_traceBufferSize))
+                     .setIntroducedIn(30500);
+
+  options->addOption("--server.trace-collector",
+                     "endpoint of an OpenTelemetry collector the trace "
+                     "spans are sent to, e.g. tcp://127.0.0.1:4318",
+                     new StringParameter(&_traceCollector))
+                     .setIntroducedIn(30500);
 }
 
-void StatisticsFeature::validateOptions(std::shared_ptr<ProgramOptions>) {
+void StatisticsFeature::validateOptions(std::shared_ptr<ProgramOptions> options) {
   if (!_statistics) {
     // turn ourselves off
     disable();
   }
+
+  if (_exportMetricsApi &&
+      !options->processingResult().touched("server.statistics-history")) {
+    // metrics are scraped and stored externally, there is no need to pay
+    // for writing them into the system collections as well
+    _statisticsHistory = false;
+  }
+
+  if (_traceSampleRate < 0.0 || _traceSampleRate > 1.0) {
+    LOG_TOPIC("3d1c8", FATAL, arangodb::Logger::STATISTICS)
+        << "invalid value for --server.trace-sample-rate, expecting a value "
+        << "between 0 and 1";
+    FATAL_ERROR_EXIT();
+  }
+
+  if (_traceSampleRate > 0.0 && _traceBufferSize == 0) {
+    LOG_TOPIC("5a0f2", FATAL, arangodb::Logger::STATISTICS)
+        << "invalid value for --server.trace-buffer-size, expecting a value "
+        << "greater than 0";
+    FATAL_ERROR_EXIT();
+  }
 }
 
 void StatisticsFeature::prepare() {
@@ -157,6 +164,8 @@ void StatisticsFeature::prepare() {
   ServerStatistics::initialize();
   ConnectionStatistics::initialize();
   RequestStatistics::initialize();
+
+  tracing::configure(_traceSampleRate, static_cast<size_t>(_traceBufferSize));
 }
 
 void StatisticsFeature::start() {
@@ -179,15 +188,22 @@ void StatisticsFeature::start() {
     FATAL_ERROR_EXIT();
   }
 
-  _statisticsThread.reset(new StatisticsThread);
-  _statisticsWorker.reset(new StatisticsWorker(*vocbase));
+  if (tracing::enabled() && !_traceCollector.empty()) {
+    _traceExporter.reset(new TraceExporter(_traceCollector));
 
-  if (!_statisticsThread->start()) {
-    LOG_TOPIC("46b0c", FATAL, arangodb::Logger::STATISTICS)
-        << "could not start statistics thread";
-    FATAL_ERROR_EXIT();
+    if (!_traceExporter->start()) {
+      LOG_TOPIC("b7e20", FATAL, arangodb::Logger::STATISTICS)
+          << "could not start trace exporter";
+      FATAL_ERROR_EXIT();
+    }
+  }
+
+  if (!_statisticsHistory) {
+    return;
   }
 
+  _statisticsWorker.reset(new StatisticsWorker(*vocbase));
+
   if (!_statisticsWorker->start()) {
     LOG_TOPIC("6ecdc", FATAL, arangodb::Logger::STATISTICS)
         << "could not start statistics worker";
@@ -196,24 +212,26 @@ void StatisticsFeature::start() {
 }
 
 void StatisticsFeature::stop() {
-  if (_statisticsThread != nullptr) {
-    _statisticsThread->beginShutdown();
+  if (_statisticsWorker != nullptr) {
+    _statisticsWorker->beginShutdown();
 
-    while (_statisticsThread->isRunning()) {
+    while (_statisticsWorker->isRunning()) {
       std::this_thread::sleep_for(std::chrono::microseconds(10000));
     }
   }
 
-  if (_statisticsWorker != nullptr) {
-    _statisticsWorker->beginShutdown();
+  _statisticsWorker.reset();
 
-    while (_statisticsWorker->isRunning()) {
+  if (_traceExporter != nullptr) {
+    _traceExporter->beginShutdown();
+
+    while (_traceExporter->isRunning()) {
       std::this_thread::sleep_for(std::chrono::microseconds(10000));
     }
   }
 
-  _statisticsThread.reset();
-  _statisticsWorker.reset();
+  _traceExporter.reset();
+  tracing::configure(0.0, 0);
 
   STATISTICS = nullptr;
 }
@@ -34,35 +34,28 @@
 namespace arangodb {
 namespace basics {
 
-extern Mutex TRI_RequestsStatisticsMutex;
-
+extern std::vector<double> const TRI_AcceptTimeDistributionVectorStatistics;
 extern std::vector<double> const TRI_BytesReceivedDistributionVectorStatistics;
 extern std::vector<double> const TRI_BytesSentDistributionVectorStatistics;
 extern std::vector<double> const TRI_ConnectionTimeDistributionVectorStatistics;
 extern std::vector<double> const TRI_RequestTimeDistributionVectorStatistics;
 
-extern StatisticsCounter TRI_AsyncRequestsStatistics;
 extern StatisticsCounter TRI_HttpConnectionsStatistics;
-extern StatisticsCounter TRI_TotalRequestsStatistics;
 
 constexpr size_t MethodRequestsStatisticsSize =
     ((size_t)arangodb::rest::RequestType::ILLEGAL) + 1;
-extern std::array<StatisticsCounter, MethodRequestsStatisticsSize> TRI_MethodRequestsStatistics;
 
-extern StatisticsDistribution TRI_BytesReceivedDistributionStatistics;
-extern StatisticsDistribution TRI_BytesSentDistributionStatistics;
+// the request counters and distributions are kept per thread, see
+// RequestStatistics::fill and RequestStatistics::fillCounters
+extern StatisticsDistribution TRI_AcceptTimeDistributionStatistics;
 extern StatisticsDistribution TRI_ConnectionTimeDistributionStatistics;
-extern StatisticsDistribution TRI_IoTimeDistributionStatistics;
-extern StatisticsDistribution TRI_QueueTimeDistributionStatistics;
-extern StatisticsDistribution TRI_RequestTimeDistributionStatistics;
-extern StatisticsDistribution TRI_TotalTimeDistributionStatistics;
 }  // namespace basics
 namespace stats {
 class Descriptions;
 }
 
-class StatisticsThread;
 class StatisticsWorker;
+class TraceExporter;
 
 class StatisticsFeature final : public application_features::ApplicationFeature {
  public:
@@ -91,12 +84,20 @@ class StatisticsFeature final : public application_features::ApplicationFeature
     return nullptr;
   }
 
+  /// @brief whether /_admin/metrics is served
+  bool exportMetricsApi() const { return _exportMetricsApi; }
+
  private:
   bool _statistics;
+  bool _exportMetricsApi;
+  bool _statisticsHistory;
+  double _traceSampleRate;
+  uint64_t _traceBufferSize;
+  std::string _traceCollector;
 
   std::unique_ptr<stats::Descriptions> _descriptions;
-  std::unique_ptr<StatisticsThread> _statisticsThread;
   std::unique_ptr<StatisticsWorker> _statisticsWorker;
+  std::unique_ptr<TraceExporter> _traceExporter;
 };
 
 }  // namespace arangodb
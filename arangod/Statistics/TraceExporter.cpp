@@ -0,0 +1,122 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "TraceExporter.h"
+
+#include "Basics/ConditionLocker.h"
+#include "Endpoint/Endpoint.h"
+#include "Logger/Logger.h"
+#include "SimpleHttpClient/GeneralClientConnection.h"
+#include "SimpleHttpClient/SimpleHttpClient.h"
+#include "SimpleHttpClient/SimpleHttpResult.h"
+#include "Statistics/Tracing.h"
+
+using namespace arangodb;
+
+namespace {
+/// @brief the default path of the OTLP/HTTP trace receiver
+std::string const exportPath("/v1/traces");
+
+/// @brief how often spans are sent, in microseconds
+constexpr uint64_t exportInterval = 5 * 1000 * 1000;
+}  // namespace
+
+TraceExporter::TraceExporter(std::string const& endpoint)
+    : Thread("TraceExporter"), _endpoint(endpoint), _exported(0) {}
+
+TraceExporter::~TraceExporter() { shutdown(); }
+
+void TraceExporter::beginShutdown() {
+  Thread::beginShutdown();
+
+  // wake up
+  CONDITION_LOCKER(guard, _cv);
+  guard.signal();
+}
+
+void TraceExporter::run() {
+  while (!isStopping()) {
+    try {
+      exportSpans();
+    } catch (std::exception const& ex) {
+      LOG_TOPIC("8b3e1", WARN, Logger::STATISTICS)
+          << "caught exception in TraceExporter: " << ex.what();
+    } catch (...) {
+      LOG_TOPIC("0c4d7", WARN, Logger::STATISTICS)
+          << "caught unknown exception in TraceExporter";
+    }
+
+    CONDITION_LOCKER(guard, _cv);
+    guard.wait(exportInterval);
+  }
+
+  // send what is left
+  try {
+    exportSpans();
+  } catch (...) {
+  }
+}
+
+void TraceExporter::exportSpans() {
+  std::vector<tracing::SpanRecord> spans;
+  uint64_t next = tracing::spans(_exported, spans);
+  if (spans.empty()) {
+    _exported = next;
+    return;
+  }
+
+  if (_connection == nullptr) {
+    std::unique_ptr<Endpoint> endpoint(Endpoint::clientFactory(_endpoint));
+    if (endpoint == nullptr) {
+      LOG_TOPIC("313a0", ERR, Logger::STATISTICS)
+          << "invalid value for --server.trace-collector ('" << _endpoint << "')";
+      beginShutdown();
+      return;
+    }
+    _connection.reset(httpclient::GeneralClientConnection::factory(endpoint, 10.0, 5.0, 1, 0));
+    if (_connection == nullptr) {
+      return;
+    }
+  }
+
+  std::string body;
+  tracing::toOtlpJson(spans, body);
+
+  httpclient::SimpleHttpClientParams params(10.0, false);
+  params.keepConnectionOnDestruction(true);
+  httpclient::SimpleHttpClient client(_connection.get(), params);
+
+  std::unordered_map<std::string, std::string> headers;
+  headers["content-type"] = "application/json";
+
+  std::unique_ptr<httpclient::SimpleHttpResult> response(
+      client.request(rest::RequestType::POST, exportPath, body.data(), body.size(), headers));
+
+  if (response == nullptr || !response->isComplete() || response->wasHttpError()) {
+    LOG_TOPIC("4e9d2", DEBUG, Logger::STATISTICS)
+        << "could not send " << spans.size() << " trace span(s) to '"
+        << _endpoint << "'";
+    // the spans are not sent again, but can still be fetched from
+    // /_admin/trace as long as they are in the ring buffer
+    _connection.reset();
+  }
+
+  _exported = next;
+}
@@ -0,0 +1,56 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_STATISTICS_TRACE_EXPORTER_H
+#define ARANGOD_STATISTICS_TRACE_EXPORTER_H 1
+
+#include "Basics/ConditionVariable.h"
+#include "Basics/Thread.h"
+
+namespace arangodb {
+namespace httpclient {
+class GeneralClientConnection;
+}
+
+/// @brief periodically sends the recorded trace spans to an OpenTelemetry
+/// collector, using OTLP/JSON over HTTP
+class TraceExporter final : public Thread {
+ public:
+  explicit TraceExporter(std::string const& endpoint);
+  ~TraceExporter();
+
+  void run() override;
+  void beginShutdown() override;
+
+ private:
+  /// @brief sends all spans recorded since the last call
+  void exportSpans();
+
+  std::string const _endpoint;
+  std::unique_ptr<httpclient::GeneralClientConnection> _connection;
+  basics::ConditionVariable _cv;
+
+  /// @brief sequence number of the first span not yet exported
+  uint64_t _exported;
+};
+
+}  // namespace arangodb
+
+#endif
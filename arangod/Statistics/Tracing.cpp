@@ -0,0 +1,319 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Tracing.h"
+
+#include "Basics/MutexLocker.h"
+#include "Random/RandomGenerator.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include <atomic>
+#include <chrono>
+
+using namespace arangodb;
+using namespace arangodb::tracing;
+
+namespace {
+
+std::atomic<double> sampleRate(0.0);
+
+// the ring buffer. only sampled spans get here, so a mutex is good enough
+arangodb::Mutex bufferLock;
+std::vector<SpanRecord> buffer;
+// number of spans recorded so far. the span with sequence number n is at
+// position n % buffer.size()
+uint64_t sequence = 0;
+
+thread_local SpanContext currentContext;
+
+uint64_t newId() {
+  uint64_t id;
+  do {
+    id = RandomGenerator::interval(UINT64_MAX);
+  } while (id == 0);
+  return id;
+}
+
+void push(SpanRecord&& span) {
+  MUTEX_LOCKER(locker, bufferLock);
+  if (buffer.empty()) {
+    return;
+  }
+  buffer[sequence % buffer.size()] = std::move(span);
+  ++sequence;
+}
+
+void appendHex(std::string& result, uint64_t value) {
+  static char const* const digits = "0123456789abcdef";
+  for (int shift = 60; shift >= 0; shift -= 4) {
+    result.push_back(digits[(value >> shift) & 0xf]);
+  }
+}
+
+std::string toHex(uint64_t value) {
+  std::string result;
+  result.reserve(16);
+  appendHex(result, value);
+  return result;
+}
+
+bool parseHex(char const* p, char const* e, uint64_t& value) noexcept {
+  if (e - p != 16) {
+    return false;
+  }
+  value = 0;
+  while (p < e) {
+    char c = *p++;
+    value <<= 4;
+    if (c >= '0' && c <= '9') {
+      value |= c - '0';
+    } else if (c >= 'a' && c <= 'f') {
+      value |= c - 'a' + 10;
+    } else if (c >= 'A' && c <= 'F') {
+      value |= c - 'A' + 10;
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+void tracing::configure(double rate, size_t bufferSize) {
+  MUTEX_LOCKER(locker, bufferLock);
+  buffer.clear();
+  buffer.resize(rate > 0.0 ? bufferSize : 0);
+  sequence = 0;
+  sampleRate.store(buffer.empty() ? 0.0 : rate, std::memory_order_relaxed);
+}
+
+bool tracing::enabled() noexcept {
+  return sampleRate.load(std::memory_order_relaxed) > 0.0;
+}
+
+SpanContext tracing::sample() {
+  SpanContext context;
+  double rate = sampleRate.load(std::memory_order_relaxed);
+  if (rate > 0.0 &&
+      (rate >= 1.0 || RandomGenerator::interval(UINT32_MAX) < rate * UINT32_MAX)) {
+    context.traceId = newId();
+  }
+  return context;
+}
+
+SpanContext tracing::current() noexcept { return currentContext; }
+
+uint64_t tracing::now() noexcept {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+std::string tracing::toHeader(SpanContext const& context) {
+  std::string result;
+  result.reserve(33);
+  appendHex(result, context.traceId);
+  result.push_back('-');
+  appendHex(result, context.spanId);
+  return result;
+}
+
+SpanContext tracing::fromHeader(std::string const& value) noexcept {
+  SpanContext context;
+  if (value.size() != 33 || value[16] != '-' || !enabled()) {
+    return context;
+  }
+  char const* p = value.data();
+  uint64_t traceId;
+  uint64_t spanId;
+  if (parseHex(p, p + 16, traceId) && parseHex(p + 17, p + 33, spanId)) {
+    context.traceId = traceId;
+    context.spanId = spanId;
+  }
+  return context;
+}
+
+void tracing::record(char const* name, SpanContext const& parent,
+                     uint64_t start, uint64_t end) {
+  if (!parent.sampled()) {
+    return;
+  }
+  try {
+    push(SpanRecord{parent.traceId, newId(), parent.spanId, name, "", start, end});
+  } catch (...) {
+    // tracing must never make a request fail
+  }
+}
+
+uint64_t tracing::spans(uint64_t since, std::vector<SpanRecord>& result) {
+  MUTEX_LOCKER(locker, bufferLock);
+  if (buffer.empty()) {
+    return sequence;
+  }
+  uint64_t first = since;
+  if (sequence > buffer.size() && first < sequence - buffer.size()) {
+    // older spans have been overwritten already
+    first = sequence - buffer.size();
+  }
+  for (uint64_t i = first; i < sequence; ++i) {
+    result.emplace_back(buffer[i % buffer.size()]);
+  }
+  return sequence;
+}
+
+void tracing::toVelocyPack(std::vector<SpanRecord> const& spans, VPackBuilder& builder) {
+  builder.openArray();
+  for (auto const& span : spans) {
+    builder.openObject();
+    builder.add("traceId", VPackValue(toHex(span.traceId)));
+    builder.add("spanId", VPackValue(toHex(span.spanId)));
+    if (span.parentId != 0) {
+      builder.add("parentId", VPackValue(toHex(span.parentId)));
+    }
+    builder.add("name", VPackValue(span.name));
+    if (!span.detail.empty()) {
+      builder.add("detail", VPackValue(span.detail));
+    }
+    // in seconds, like the other timestamps in the statistics
+    builder.add("started", VPackValue(static_cast<double>(span.start) / 1e9));
+    builder.add("duration", VPackValue(static_cast<double>(span.end - span.start) / 1e9));
+    builder.close();
+  }
+  builder.close();
+}
+
+void tracing::toOtlpJson(std::vector<SpanRecord> const& spans, std::string& result) {
+  // see opentelemetry-proto, opentelemetry/proto/collector/trace/v1.
+  // trace ids have 128 bits there, ours are padded with zeros
+  VPackBuilder builder;
+  builder.openObject();
+  builder.add("resourceSpans", VPackValue(VPackValueType::Array));
+  builder.openObject();
+  builder.add("resource", VPackValue(VPackValueType::Object));
+  builder.add("attributes", VPackValue(VPackValueType::Array));
+  builder.openObject();
+  builder.add("key", VPackValue("service.name"));
+  builder.add("value", VPackValue(VPackValueType::Object));
+  builder.add("stringValue", VPackValue("arangod"));
+  builder.close();  // value
+  builder.close();  // attribute
+  builder.close();  // attributes
+  builder.close();  // resource
+
+  builder.add("scopeSpans", VPackValue(VPackValueType::Array));
+  builder.openObject();
+  builder.add("spans", VPackValue(VPackValueType::Array));
+  for (auto const& span : spans) {
+    builder.openObject();
+    builder.add("traceId", VPackValue(toHex(0) + toHex(span.traceId)));
+    builder.add("spanId", VPackValue(toHex(span.spanId)));
+    if (span.parentId != 0) {
+      builder.add("parentSpanId", VPackValue(toHex(span.parentId)));
+    }
+    builder.add("name", VPackValue(span.name));
+    // SPAN_KIND_INTERNAL
+    builder.add("kind", VPackValue(1));
+    // 64 bit integers are encoded as strings in OTLP/JSON
+    builder.add("startTimeUnixNano", VPackValue(std::to_string(span.start)));
+    builder.add("endTimeUnixNano", VPackValue(std::to_string(span.end)));
+    if (!span.detail.empty()) {
+      builder.add("attributes", VPackValue(VPackValueType::Array));
+      builder.openObject();
+      builder.add("key", VPackValue("detail"));
+      builder.add("value", VPackValue(VPackValueType::Object));
+      builder.add("stringValue", VPackValue(span.detail));
+      builder.close();  // value
+      builder.close();  // attribute
+      builder.close();  // attributes
+    }
+    builder.close();
+  }
+  builder.close();  // spans
+  builder.close();  // scopeSpan
+  builder.close();  // scopeSpans
+  builder.close();  // resourceSpan
+  builder.close();  // resourceSpans
+  builder.close();
+
+  result.append(builder.slice().toJson());
+}
+
+ContextScope::ContextScope(SpanContext const& context) noexcept
+    : _previous(currentContext) {
+  currentContext = context;
+}
+
+ContextScope::~ContextScope() { currentContext = _previous; }
+
+Span::Span(char const* name, SpanContext const& parent)
+    : _parentId(0), _start(0) {
+  if (!parent.sampled()) {
+    return;
+  }
+  _context.traceId = parent.traceId;
+  _context.spanId = newId();
+  _parentId = parent.spanId;
+  _start = now();
+  _name = name;
+}
+
+Span::Span(Span&& other) noexcept
+    : _context(other._context),
+      _parentId(other._parentId),
+      _start(other._start),
+      _name(std::move(other._name)),
+      _detail(std::move(other._detail)) {
+  other._context = SpanContext();
+}
+
+Span& Span::operator=(Span&& other) noexcept {
+  if (this != &other) {
+    finish();
+    _context = other._context;
+    _parentId = other._parentId;
+    _start = other._start;
+    _name = std::move(other._name);
+    _detail = std::move(other._detail);
+    other._context = SpanContext();
+  }
+  return *this;
+}
+
+void Span::setDetail(std::string detail) {
+  if (active()) {
+    _detail = std::move(detail);
+  }
+}
+
+void Span::finish() noexcept {
+  if (!active()) {
+    return;
+  }
+  try {
+    push(SpanRecord{_context.traceId, _context.spanId, _parentId,
+                    std::move(_name), std::move(_detail), _start, now()});
+  } catch (...) {
+    // tracing must never make a request fail
+  }
+  _context = SpanContext();
+}
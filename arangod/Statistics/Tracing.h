@@ -0,0 +1,158 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_STATISTICS_TRACING_H
+#define ARANGOD_STATISTICS_TRACING_H 1
+
+#include "Basics/Common.h"
+
+namespace arangodb {
+namespace velocypack {
+class Builder;
+}
+
+/// @brief request tracing. a sampled request carries a trace id, which is
+/// passed on to the DB servers in the x-arango-trace header. the steps of a
+/// request (scheduler queue, V8 context, query phases, cluster requests,
+/// commits) are recorded as spans into a ring buffer. spans of requests that
+/// are not sampled cost a thread-local lookup and nothing else
+namespace tracing {
+
+/// @brief identifies a span within a trace. a context with a trace id of 0
+/// belongs to a request that is not sampled
+struct SpanContext {
+  uint64_t traceId = 0;
+  uint64_t spanId = 0;
+
+  bool sampled() const noexcept { return traceId != 0; }
+};
+
+/// @brief a finished span
+struct SpanRecord {
+  uint64_t traceId;
+  uint64_t spanId;
+  uint64_t parentId;
+  std::string name;
+  std::string detail;
+  /// @brief nanoseconds since the epoch
+  uint64_t start;
+  uint64_t end;
+};
+
+/// @brief set the sample rate (0 turns tracing off, 1 traces every
+/// request) and the number of spans kept in the ring buffer
+void configure(double sampleRate, size_t bufferSize);
+
+/// @brief whether requests are sampled at all
+bool enabled() noexcept;
+
+/// @brief the context of a new trace if the sampling says so, otherwise
+/// an unsampled context. the returned context has no span of its own yet
+SpanContext sample();
+
+/// @brief the context of the current thread
+SpanContext current() noexcept;
+
+/// @brief nanoseconds since the epoch
+uint64_t now() noexcept;
+
+/// @brief value for the x-arango-trace header
+std::string toHeader(SpanContext const&);
+
+/// @brief parses the x-arango-trace header. returns an unsampled context
+/// if the value is invalid
+SpanContext fromHeader(std::string const&) noexcept;
+
+/// @brief records a span that has already finished
+void record(char const* name, SpanContext const& parent, uint64_t start, uint64_t end);
+
+/// @brief the spans recorded after sequence number `since` that are still
+/// in the ring buffer. returns the sequence number to continue from
+uint64_t spans(uint64_t since, std::vector<SpanRecord>& result);
+
+/// @brief appends spans as an array of objects
+void toVelocyPack(std::vector<SpanRecord> const& spans, velocypack::Builder& builder);
+
+/// @brief appends spans as an OpenTelemetry (OTLP/JSON) export request
+void toOtlpJson(std::vector<SpanRecord> const& spans, std::string& result);
+
+/// @brief makes a context the current one of this thread, for as long as
+/// the scope lives
+class ContextScope {
+ public:
+  explicit ContextScope(SpanContext const& context) noexcept;
+  ~ContextScope();
+
+  ContextScope(ContextScope const&) = delete;
+  ContextScope& operator=(ContextScope const&) = delete;
+
+ private:
+  SpanContext const _previous;
+};
+
+/// @brief a span that is recorded when it is finished or destroyed. a span
+/// whose parent is not sampled does nothing. the name is only copied for
+/// sampled spans
+class Span {
+ public:
+  Span() noexcept : _parentId(0), _start(0) {}
+  Span(char const* name, SpanContext const& parent);
+  ~Span() { finish(); }
+
+  Span(Span&&) noexcept;
+  Span& operator=(Span&&) noexcept;
+  Span(Span const&) = delete;
+  Span& operator=(Span const&) = delete;
+
+  bool active() const noexcept { return _context.sampled(); }
+  SpanContext const& context() const noexcept { return _context; }
+
+  /// @brief additional information, e.g. the request path
+  void setDetail(std::string detail);
+
+  void finish() noexcept;
+
+ private:
+  SpanContext _context;
+  uint64_t _parentId;
+  uint64_t _start;
+  std::string _name;
+  std::string _detail;
+};
+
+/// @brief a child span of the current context that is the current context
+/// itself while it lives
+class ScopedSpan {
+ public:
+  explicit ScopedSpan(char const* name)
+      : _span(name, current()), _scope(_span.context()) {}
+
+  Span& span() noexcept { return _span; }
+
+ private:
+  // order matters: the scope is left before the span is finished
+  Span _span;
+  ContextScope _scope;
+};
+
+}  // namespace tracing
+}  // namespace arangodb
+
+#endif
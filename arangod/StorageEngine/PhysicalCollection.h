@@ -72,6 +72,10 @@ class PhysicalCollection {
   // @brief Return the number of documents in this collection
   virtual uint64_t numberDocuments(transaction::Methods* trx) const = 0;
 
+  /// @brief number of documents without a transaction. does not reflect
+  /// ongoing transactions and may be slightly off, use for reporting only
+  virtual uint64_t approximateNumberDocuments() const = 0;
+
   /// @brief report extra memory used by indexes etc.
   virtual size_t memory() const = 0;
 
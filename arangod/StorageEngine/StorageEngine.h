@@ -106,6 +106,9 @@ class StorageEngine : public application_features::ApplicationFeature {
   // minimum timeout for the synchronous replication
   virtual double minimumSyncReplicationTimeout() const = 0;
 
+  // whether imports and restores may be committed without the WAL
+  virtual bool allowsBulkLoad() const { return false; }
+
   // status functionality
   // --------------------
 
@@ -184,6 +184,9 @@ class TransactionState {
 
   virtual bool hasFailedOperations() const = 0;
 
+  /// @brief number of automatic intermediate commits performed so far
+  virtual uint64_t numIntermediateCommits() const { return 0; }
+
   TransactionCollection* findCollection(TRI_voc_cid_t cid) const;
 
   /// @brief make a exclusive transaction, only valid before begin
@@ -52,6 +52,9 @@ class Hints {
     ALLOW_RANGE_DELETE = 8192,    // enable range-delete in rocksdb
     FROM_TOPLEVEL_AQL = 16384,    // transaction is only runnning one AQL query
     GLOBAL_MANAGED = 32768,  // transaction with externally managed lifetime
+    LOW_PRIORITY = 65536,    // bulk writer, throttled first in rocksdb
+    BULK_LOAD = 131072,      // commit via SST file ingestion in rocksdb
+    NO_BLOCKING_READ = 262144,  // fail reads that need disk IO in rocksdb
   };
 
   Hints() : _value(0) {}
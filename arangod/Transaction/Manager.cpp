@@ -191,7 +191,6 @@ void Manager::registerAQLTrx(TransactionState* state) {
   
   TRI_ASSERT(state != nullptr);
   const size_t bucket = getBucket(state->id());
-  READ_LOCKER(allTransactionsLocker, _allTransactionsLock);
   WRITE_LOCKER(writeLocker, _transactions[bucket]._lock);
 
   auto& buck = _transactions[bucket];
@@ -209,7 +208,6 @@ void Manager::registerAQLTrx(TransactionState* state) {
 
 void Manager::unregisterAQLTrx(TRI_voc_tid_t tid) noexcept {
   const size_t bucket = getBucket(tid);
-  READ_LOCKER(allTransactionsLocker, _allTransactionsLock);
   WRITE_LOCKER(writeLocker, _transactions[bucket]._lock);
 
   auto& buck = _transactions[bucket];
@@ -295,7 +293,6 @@ Result Manager::createManagedTrx(TRI_vocbase_t& vocbase, TRI_voc_tid_t tid,
   const size_t bucket = getBucket(tid);
 
   { // quick check whether ID exists
-    READ_LOCKER(allTransactionsLocker, _allTransactionsLock);
     WRITE_LOCKER(writeLocker, _transactions[bucket]._lock);
     auto& buck = _transactions[bucket];
     auto it = buck._managed.find(tid);
@@ -361,7 +358,6 @@ Result Manager::createManagedTrx(TRI_vocbase_t& vocbase, TRI_voc_tid_t tid,
   }
 
   { // add transaction to bucket
-    READ_LOCKER(allTransactionsLocker, _allTransactionsLock);
     WRITE_LOCKER(writeLocker, _transactions[bucket]._lock);
     auto it = _transactions[bucket]._managed.find(tid);
     if (it != _transactions[bucket]._managed.end()) {
@@ -392,7 +388,6 @@ std::shared_ptr<transaction::Context> Manager::leaseManagedTrx(TRI_voc_tid_t tid
   int i = 0;
   TransactionState* state = nullptr;
   do {
-    READ_LOCKER(allTransactionsLocker, _allTransactionsLock);
     WRITE_LOCKER(writeLocker, _transactions[bucket]._lock);
 
     auto it = _transactions[bucket]._managed.find(tid);
@@ -426,7 +421,6 @@ std::shared_ptr<transaction::Context> Manager::leaseManagedTrx(TRI_voc_tid_t tid
     }
 
     writeLocker.unlock(); // failure;
-    allTransactionsLocker.unlock();
     std::this_thread::yield();
 
     if (i++ > 32) {
@@ -448,7 +442,6 @@ std::shared_ptr<transaction::Context> Manager::leaseManagedTrx(TRI_voc_tid_t tid
 
 void Manager::returnManagedTrx(TRI_voc_tid_t tid, AccessMode::Type mode) noexcept {
   const size_t bucket = getBucket(tid);
-  READ_LOCKER(allTransactionsLocker, _allTransactionsLock);
   WRITE_LOCKER(writeLocker, _transactions[bucket]._lock);
 
   auto it = _transactions[bucket]._managed.find(tid);
@@ -483,7 +476,6 @@ void Manager::returnManagedTrx(TRI_voc_tid_t tid, AccessMode::Type mode) noexcep
 /// @brief get the transasction state
 transaction::Status Manager::getManagedTrxStatus(TRI_voc_tid_t tid) const {
   size_t bucket = getBucket(tid);
-  READ_LOCKER(allTransactionsLocker, _allTransactionsLock);
   READ_LOCKER(writeLocker, _transactions[bucket]._lock);
 
   auto it = _transactions[bucket]._managed.find(tid);
@@ -502,8 +494,8 @@ transaction::Status Manager::getManagedTrxStatus(TRI_voc_tid_t tid) const {
   }
 }
 
-Result Manager::commitManagedTrx(TRI_voc_tid_t tid) {
-  return updateTransaction(tid, transaction::Status::COMMITTED, false);
+Result Manager::commitManagedTrx(TRI_voc_tid_t tid, bool waitForSync) {
+  return updateTransaction(tid, transaction::Status::COMMITTED, false, waitForSync);
 }
 
 Result Manager::abortManagedTrx(TRI_voc_tid_t tid) {
@@ -512,7 +504,7 @@ Result Manager::abortManagedTrx(TRI_voc_tid_t tid) {
 
 Result Manager::updateTransaction(TRI_voc_tid_t tid,
                                   transaction::Status status,
-                                  bool clearServers) {
+                                  bool clearServers, bool waitForSync) {
   TRI_ASSERT(status == transaction::Status::COMMITTED ||
              status == transaction::Status::ABORTED);
 
@@ -525,7 +517,6 @@ Result Manager::updateTransaction(TRI_voc_tid_t tid,
 
   std::unique_ptr<TransactionState> state;
   {
-    READ_LOCKER(allTransactionsLocker, _allTransactionsLock);
     WRITE_LOCKER(writeLocker, _transactions[bucket]._lock);
 
     auto& buck = _transactions[bucket];
@@ -577,7 +568,6 @@ Result Manager::updateTransaction(TRI_voc_tid_t tid,
   }
 
   auto abortTombstone = [&] {  // set tombstone entry to aborted
-    READ_LOCKER(allTransactionsLocker, _allTransactionsLock);
     WRITE_LOCKER(writeLocker, _transactions[bucket]._lock);
     auto& buck = _transactions[bucket];
     auto it = buck._managed.find(tid);
@@ -603,6 +593,9 @@ Result Manager::updateTransaction(TRI_voc_tid_t tid,
     trx.state()->clearKnownServers();
   }
   if (status == transaction::Status::COMMITTED) {
+    if (waitForSync) {
+      trx.state()->waitForSync(true);
+    }
     res = trx.commit();
     if (res.fail()) { // set final status to aborted
       abortTombstone();
@@ -624,8 +617,6 @@ bool Manager::garbageCollect(bool abortAll) {
   SmallVector<TRI_voc_tid_t, 64>::allocator_type::arena_type arena;
   SmallVector<TRI_voc_tid_t, 64> toAbort{arena};
 
-  READ_LOCKER(allTransactionsLocker, _allTransactionsLock);
-
   for (size_t bucket = 0; bucket < numBuckets; ++bucket) {
     WRITE_LOCKER(locker, _transactions[bucket]._lock);
     double now = TRI_microtime();
@@ -690,7 +681,6 @@ bool Manager::abortManagedTrx(std::function<bool(TransactionState const&)> cb) {
   SmallVector<TRI_voc_tid_t, 64>::allocator_type::arena_type arena;
   SmallVector<TRI_voc_tid_t, 64> toAbort{arena};
 
-  READ_LOCKER(allTransactionsLocker, _allTransactionsLock);
   for (size_t bucket = 0; bucket < numBuckets; ++bucket) {
     READ_LOCKER(locker, _transactions[bucket]._lock);
 
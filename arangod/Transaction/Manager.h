@@ -113,7 +113,9 @@ class Manager final {
   /// @brief get the meta transasction state
   transaction::Status getManagedTrxStatus(TRI_voc_tid_t) const;
     
-  Result commitManagedTrx(TRI_voc_tid_t);
+  /// @brief commit a managed transaction. with waitForSync the commit
+  /// returns once it is durable
+  Result commitManagedTrx(TRI_voc_tid_t, bool waitForSync = false);
   Result abortManagedTrx(TRI_voc_tid_t);
   
   /// @brief collect forgotten transactions
@@ -123,13 +125,15 @@ class Manager final {
   bool abortManagedTrx(std::function<bool(TransactionState const&)>);
   
  private:
-  // hashes the transaction id into a bucket
+  // hashes the transaction id into a bucket. the two lowest bits of cluster
+  // transaction ids encode their type, all coordinator transactions would
+  // end up in a quarter of the buckets if they were included
   inline size_t getBucket(TRI_voc_tid_t tid) const {
-    return std::hash<TRI_voc_cid_t>()(tid) % numBuckets;
+    return std::hash<TRI_voc_cid_t>()(tid >> 2) % numBuckets;
   }
   
   Result updateTransaction(TRI_voc_tid_t tid, transaction::Status status,
-                           bool clearServers);
+                           bool clearServers, bool waitForSync = false);
   
  private:
     
@@ -159,11 +163,14 @@ private:
   
   const bool _keepTransactionData;
 
-  // a lock protecting ALL buckets in _transactions
+  // a lock protecting _activeTransactions and _failedTransactions of ALL
+  // buckets, taken exclusively to get a consistent view of them. the managed
+  // transactions only need the lock of their bucket, so that leasing and
+  // (un)registering them does not contend on this lock
   mutable basics::ReadWriteLock _allTransactionsLock;
 
   struct {
-    // a lock protecting _activeTransactions and _failedTransactions
+    // a lock protecting _activeTransactions, _failedTransactions and _managed
     mutable basics::ReadWriteLock _lock;
 
     // currently ongoing transactions
@@ -41,12 +41,14 @@
 #include "Cluster/ClusterMethods.h"
 #include "Cluster/ClusterTrxMethods.h"
 #include "Cluster/FollowerInfo.h"
+#include "Cluster/ReplicationPipeline.h"
 #include "Cluster/ReplicationTimeoutFeature.h"
 #include "Cluster/ServerState.h"
 #include "ClusterEngine/ClusterEngine.h"
 #include "Indexes/Index.h"
 #include "Logger/Logger.h"
 #include "RocksDBEngine/RocksDBEngine.h"
+#include "Statistics/Metrics.h"
 #include "StorageEngine/EngineSelectorFeature.h"
 #include "StorageEngine/PhysicalCollection.h"
 #include "StorageEngine/StorageEngine.h"
@@ -987,10 +989,14 @@ Result transaction::Methods::begin() {
   TRI_ASSERT(!(a && b));
 #endif
 
+  bool const topLevel = _state->isTopLevelTransaction();
   auto res = _state->beginTransaction(_localHints);
   if (res.fail()) {
     return res;
   }
+  if (topLevel) {
+    metrics::TransactionsStarted.count();
+  }
 
   applyStatusChangeCallbacks(*this, Status::RUNNING);
 
@@ -1026,8 +1032,12 @@ Result transaction::Methods::commit() {
     }
   }
 
+  bool const topLevel = _state->isTopLevelTransaction();
   res = _state->commitTransaction(this);
   if (res.ok()) {
+    if (topLevel) {
+      metrics::TransactionsCommitted.count();
+    }
     applyStatusChangeCallbacks(*this, Status::COMMITTED);
   }
 
@@ -1052,8 +1062,12 @@ Result transaction::Methods::abort() {
     }  // abort locally anyway
   }
 
+  bool const topLevel = _state->isTopLevelTransaction();
   res = _state->abortTransaction(this);
   if (res.ok()) {
+    if (topLevel) {
+      metrics::TransactionsAborted.count();
+    }
     applyStatusChangeCallbacks(*this, Status::ABORTED);
   }
 
@@ -3343,26 +3357,22 @@ Result Methods::replicateOperations(LogicalCollection const& collection,
 
   // path and requestType are different for insert/remove/modify.
 
-  std::stringstream pathStream;
-  pathStream << "/_db/" << arangodb::basics::StringUtils::urlEncode(vocbase().name())
-             << "/_api/document/"
-             << arangodb::basics::StringUtils::urlEncode(collection.name());
-  if (operation != TRI_VOC_DOCUMENT_OPERATION_INSERT && !value.isArray()) {
-    TRI_ASSERT(value.isObject());
-    TRI_ASSERT(value.hasKey(StaticStrings::KeyString));
-    pathStream << "/" << value.get(StaticStrings::KeyString).copyString();
-  }
-  pathStream << "?isRestore=true&isSynchronousReplication="
-             << ServerState::instance()->getId() << "&"
-             << StaticStrings::SilentString << "=true";
+  std::string const prefix = "/_db/" +
+                             arangodb::basics::StringUtils::urlEncode(vocbase().name()) +
+                             "/_api/document/" +
+                             arangodb::basics::StringUtils::urlEncode(collection.name());
+  std::stringstream queryStream;
+  queryStream << "?isRestore=true&isSynchronousReplication="
+              << ServerState::instance()->getId() << "&"
+              << StaticStrings::SilentString << "=true";
 
   arangodb::rest::RequestType requestType = RequestType::ILLEGAL;
 
   switch (operation) {
     case TRI_VOC_DOCUMENT_OPERATION_INSERT:
       requestType = arangodb::rest::RequestType::POST;
-      pathStream << "&" << StaticStrings::OverWrite << "="
-                 << (options.overwrite ? "true" : "false");
+      queryStream << "&" << StaticStrings::OverWrite << "="
+                  << (options.overwrite ? "true" : "false");
       break;
     case TRI_VOC_DOCUMENT_OPERATION_UPDATE:
       requestType = arangodb::rest::RequestType::PATCH;
@@ -3378,7 +3388,7 @@ Result Methods::replicateOperations(LogicalCollection const& collection,
       TRI_ASSERT(false);
   }
 
-  std::string const path{pathStream.str()};
+  std::string const query{queryStream.str()};
 
   transaction::BuilderLeaser payload(this);
 
@@ -3418,22 +3428,76 @@ Result Methods::replicateOperations(LogicalCollection const& collection,
     return res;
   }
 
-  auto body = std::make_shared<std::string>();
-  *body = payload->slice().toJson();
+  // sends a single document or an array of documents to all followers
+  auto send = [&](VPackSlice documents, ReplicationPipeline::Outcome& outcome) {
+    std::string path = prefix;
+    if (operation != TRI_VOC_DOCUMENT_OPERATION_INSERT && !documents.isArray()) {
+      TRI_ASSERT(documents.isObject());
+      TRI_ASSERT(documents.hasKey(StaticStrings::KeyString));
+      path.push_back('/');
+      path.append(documents.get(StaticStrings::KeyString).copyString());
+    }
+    path.append(query);
 
-  // Now prepare the requests:
-  std::vector<ClusterCommRequest> requests;
-  requests.reserve(followers->size());
+    auto body = std::make_shared<std::string>();
+    *body = documents.toJson();
 
-  for (auto const& f : *followers) {
-    auto headers = std::make_unique<std::unordered_map<std::string, std::string>>();
-    ClusterTrxMethods::addTransactionHeader(*this, f, *headers);
-    requests.emplace_back("server:" + f, requestType, path, body, std::move(headers));
-  }
+    // Now prepare the requests:
+    std::vector<ClusterCommRequest> requests;
+    requests.reserve(followers->size());
+
+    for (auto const& f : *followers) {
+      auto headers = std::make_unique<std::unordered_map<std::string, std::string>>();
+      ClusterTrxMethods::addTransactionHeader(*this, f, *headers);
+      requests.emplace_back("server:" + f, requestType, path, body, std::move(headers));
+    }
+
+    size_t const n = documents.isArray() ? documents.length() : 1;
+    double const timeout = chooseTimeout(n, body->size() * followers->size());
 
-  double const timeout = chooseTimeout(count, body->size() * followers->size());
+    cc->performRequests(requests, timeout, Logger::REPLICATION, false);
+
+    outcome.applied.reserve(requests.size());
+    for (auto const& r : requests) {
+      bool replicationWorked =
+          r.done && r.result.status == CL_COMM_RECEIVED &&
+          (r.result.answer_code == rest::ResponseCode::ACCEPTED ||
+           r.result.answer_code == rest::ResponseCode::CREATED ||
+           r.result.answer_code == rest::ResponseCode::OK);
+      if (replicationWorked) {
+        bool found;
+        r.result.answer->header(StaticStrings::ErrorCodes, found);
+        replicationWorked = !found;
+      }
+      outcome.applied.push_back(replicationWorked);
+    }
+    outcome.refused = findRefusal(requests);
+  };
+
+  ReplicationPipeline::Outcome outcome;
+  if (ReplicationPipeline::enabled() && !value.isArray() &&
+      _state->hasHint(transaction::Hints::Hint::SINGLE_OPERATION)) {
+    // concurrent single-document operations with the same followers share
+    // the requests, no transaction header is needed for them
+    std::string stream = prefix + query;
+    stream.append(" ").append(std::to_string(static_cast<int>(requestType)));
+    for (auto const& f : *followers) {
+      stream.append(" ").append(f);
+    }
+    outcome = ReplicationPipeline::instance().replicate(
+        stream, payload->slice(), [&send](VPackSlice documents, ReplicationPipeline::Outcome& o) {
+          TRI_ASSERT(documents.isArray());
+          // a single document is sent exactly as without the pipeline
+          send(documents.length() == 1 ? documents.at(0) : documents, o);
+        });
+    if (outcome.errorCode != TRI_ERROR_NO_ERROR) {
+      THROW_ARANGO_EXCEPTION(outcome.errorCode);
+    }
+  } else {
+    send(payload->slice(), outcome);
+  }
+  TRI_ASSERT(outcome.applied.size() == followers->size());
 
-  cc->performRequests(requests, timeout, Logger::REPLICATION, false);
   // If any would-be-follower refused to follow there are two possiblities:
   // (1) there is a new leader in the meantime, or
   // (2) the follower was restarted and forgot that it is a follower.
@@ -3448,17 +3512,7 @@ Result Methods::replicateOperations(LogicalCollection const& collection,
 
   // We drop all followers that were not successful:
   for (size_t i = 0; i < followers->size(); ++i) {
-    bool replicationWorked =
-        requests[i].done && requests[i].result.status == CL_COMM_RECEIVED &&
-        (requests[i].result.answer_code == rest::ResponseCode::ACCEPTED ||
-         requests[i].result.answer_code == rest::ResponseCode::CREATED ||
-         requests[i].result.answer_code == rest::ResponseCode::OK);
-    if (replicationWorked) {
-      bool found;
-      requests[i].result.answer->header(StaticStrings::ErrorCodes, found);
-      replicationWorked = !found;
-    }
-    if (!replicationWorked) {
+    if (!outcome.applied[i]) {
       auto const& followerInfo = collection.followers();
       if (followerInfo->remove((*followers)[i])) {
         // TODO: what happens if a server is re-added during a transaction ?
@@ -3475,7 +3529,7 @@ Result Methods::replicateOperations(LogicalCollection const& collection,
     }
   }
 
-  if (findRefusal(requests)) {  // case (1), caller may abort this transaction
+  if (outcome.refused) {  // case (1), caller may abort this transaction
     return res.reset(TRI_ERROR_CLUSTER_SHARD_LEADER_RESIGNED);
   }
 
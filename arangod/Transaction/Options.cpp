@@ -22,8 +22,11 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "Options.h"
+#include "Basics/HybridLogicalClock.h"
+#include "VocBase/ticks.h"
 
 #include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
 #include <velocypack/Slice.h>
 #include <velocypack/velocypack-aliases.h>
 
@@ -39,7 +42,10 @@ Options::Options()
       intermediateCommitSize(defaultIntermediateCommitSize),
       intermediateCommitCount(defaultIntermediateCommitCount),
       allowImplicitCollections(true),
-      waitForSync(false)
+      waitForSync(false),
+      optimisticConcurrency(false),
+      consistentSnapshot(false),
+      snapshotTimestamp(0)
 #ifdef USE_ENTERPRISE
       ,
       skipInaccessibleCollections(false)
@@ -54,6 +60,15 @@ void Options::setLimits(uint64_t maxTransactionSize, uint64_t intermediateCommit
   defaultIntermediateCommitCount = intermediateCommitCount;
 }
 
+uint64_t Options::consistentSnapshotTimestamp() {
+  uint64_t const now = basics::HybridLogicalClock::extractTime(TRI_HybridLogicalClock());
+  uint64_t grid = (now / snapshotGridInterval) * snapshotGridInterval;
+  if (grid >= snapshotGridInterval) {
+    grid -= snapshotGridInterval;
+  }
+  return basics::HybridLogicalClock::assembleTimeStamp(grid, 0);
+}
+
 void Options::fromVelocyPack(arangodb::velocypack::Slice const& slice) {
   VPackSlice value;
 
@@ -82,6 +97,33 @@ void Options::fromVelocyPack(arangodb::velocypack::Slice const& slice) {
   if (value.isBool()) {
     waitForSync = value.getBool();
   }
+  value = slice.get("optimisticConcurrency");
+  if (value.isBool()) {
+    optimisticConcurrency = value.getBool();
+  }
+  value = slice.get("consistentSnapshot");
+  if (value.isBool()) {
+    consistentSnapshot = value.getBool();
+  }
+  value = slice.get("snapshotTimestamp");
+  if (value.isNumber()) {
+    snapshotTimestamp = value.getNumber<uint64_t>();
+  }
+  value = slice.get("lockKeyPrefixes");
+  if (value.isObject()) {
+    lockKeyPrefixes.clear();
+    for (auto it : VPackObjectIterator(value)) {
+      if (!it.value.isArray()) {
+        continue;
+      }
+      auto& prefixes = lockKeyPrefixes[it.key.copyString()];
+      for (VPackSlice prefix : VPackArrayIterator(it.value)) {
+        if (prefix.isString()) {
+          prefixes.emplace_back(prefix.copyString());
+        }
+      }
+    }
+  }
 #ifdef USE_ENTERPRISE
   value = slice.get("skipInaccessibleCollections");
   if (value.isBool()) {
@@ -100,6 +142,22 @@ void Options::toVelocyPack(arangodb::velocypack::Builder& builder) const {
   builder.add("intermediateCommitCount", VPackValue(intermediateCommitCount));
   builder.add("allowImplicit", VPackValue(allowImplicitCollections));
   builder.add("waitForSync", VPackValue(waitForSync));
+  builder.add("optimisticConcurrency", VPackValue(optimisticConcurrency));
+  builder.add("consistentSnapshot", VPackValue(consistentSnapshot));
+  if (snapshotTimestamp != 0) {
+    builder.add("snapshotTimestamp", VPackValue(snapshotTimestamp));
+  }
+  if (!lockKeyPrefixes.empty()) {
+    builder.add("lockKeyPrefixes", VPackValue(VPackValueType::Object));
+    for (auto const& it : lockKeyPrefixes) {
+      builder.add(it.first, VPackValue(VPackValueType::Array));
+      for (auto const& prefix : it.second) {
+        builder.add(VPackValue(prefix));
+      }
+      builder.close();
+    }
+    builder.close();
+  }
 #ifdef USE_ENTERPRISE
   builder.add("skipInaccessibleCollections", VPackValue(skipInaccessibleCollections));
 #endif
@@ -52,6 +52,15 @@ struct Options {
   static uint64_t defaultIntermediateCommitSize;
   static uint64_t defaultIntermediateCommitCount;
 
+  /// @brief DB servers keep read snapshots at every multiple of this
+  /// many milliseconds of their hybrid logical clock
+  static constexpr uint64_t snapshotGridInterval = 100;
+
+  /// @brief hybrid logical clock timestamp for a consistent read across
+  /// shards: the latest grid point that lies at least one interval back,
+  /// so that the DB servers have usually taken their snapshots for it
+  static uint64_t consistentSnapshotTimestamp();
+
   /// @brief time (in seconds) that is spent waiting for a lock
   double lockTimeout;
   uint64_t maxTransactionSize;
@@ -59,6 +68,21 @@ struct Options {
   uint64_t intermediateCommitCount;
   bool allowImplicitCollections;
   bool waitForSync;
+  /// @brief do not lock written keys while the transaction runs, but check
+  /// them for conflicting writes on commit. for workloads with rare conflicts.
+  /// intermediate commits check the keys written since the previous commit.
+  /// transactions that only write collections they lock exclusively ignore
+  /// the option. see RocksDBOptimisticKeys
+  bool optimisticConcurrency;
+  /// @brief key prefixes to lock per write collection. writers of other
+  /// transactions wait for these keys, but not for the rest of the collection
+  std::unordered_map<std::string, std::vector<std::string>> lockKeyPrefixes;
+  /// @brief read all shards of a cluster query as of the same point of
+  /// the hybrid logical clock. the coordinator picks snapshotTimestamp
+  bool consistentSnapshot;
+  /// @brief hybrid logical clock timestamp that read-only transactions on
+  /// DB servers read as of, 0 means the current state
+  uint64_t snapshotTimestamp;
 #ifdef USE_ENTERPRISE
   bool skipInaccessibleCollections;
 #endif
@@ -24,8 +24,10 @@
 #include "CursorRepository.h"
 
 #include "Aql/QueryCursor.h"
+#include "ApplicationFeatures/ApplicationServer.h"
 #include "Basics/MutexLocker.h"
 #include "Logger/Logger.h"
+#include "RestServer/QueryRegistryFeature.h"
 #include "Utils/ExecContext.h"
 #include "VocBase/ticks.h"
 #include "VocBase/vocbase.h"
@@ -133,8 +135,12 @@ Cursor* CursorRepository::createFromQueryResult(aql::QueryResult&& result, size_
                                                 double ttl, bool hasCount) {
   TRI_ASSERT(result.data != nullptr);
 
-  std::unique_ptr<Cursor> cursor(
-      new aql::QueryResultCursor(_vocbase, std::move(result), batchSize, ttl, hasCount));
+  auto feature = application_features::ApplicationServer::lookupFeature<QueryRegistryFeature>(
+      "QueryRegistry");
+  uint64_t spillThreshold = (feature != nullptr ? feature->cursorSpillThreshold() : 0);
+
+  std::unique_ptr<Cursor> cursor(new aql::QueryResultCursor(_vocbase, std::move(result), batchSize,
+                                                            ttl, hasCount, spillThreshold));
   cursor->use();
 
   return addCursor(std::move(cursor));
@@ -41,6 +41,9 @@ struct OperationOptions {
         returnNew(false),
         isRestore(false),
         overwrite(false),
+        allowDirtyReads(false),
+        abortOnFailure(false),
+        readTimestamp(0),
         indexOperationMode(Index::OperationMode::normal) {}
 
   // original marker, set by an engine's recovery procedure only!
@@ -82,6 +85,18 @@ struct OperationOptions {
   // from the wrong leader.
   std::string isSynchronousReplicationFrom;
 
+  // for reads on coordinators: the read may be served by an in-sync follower
+  bool allowDirtyReads;
+
+  // a failed document aborts the whole transaction, so the storage engine
+  // does not need to undo the partial writes of a single failed document
+  // in a multi-document operation. saves one savepoint per document
+  bool abortOnFailure;
+
+  // for follower reads: HLC time stamp the follower must have caught up
+  // with, 0 if any in-sync follower will do
+  uint64_t readTimestamp;
+
   Index::OperationMode indexOperationMode;
 };
 
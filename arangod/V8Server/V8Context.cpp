@@ -43,6 +43,7 @@ V8Context::V8Context(size_t id, v8::Isolate* isolate)
       _locker(nullptr),
       _creationStamp(TRI_microtime()),
       _lastGcStamp(0.0),
+      _lastUsedStamp(_creationStamp),
       _invocations(0),
       _invocationsSinceLastGc(0),
       _hasActiveExternals(false) {}
@@ -88,6 +89,8 @@ void V8Context::setCleaned(double stamp) {
 
 double V8Context::age() const { return TRI_microtime() - _creationStamp; }
 
+double V8Context::idleTime() const { return TRI_microtime() - _lastUsedStamp; }
+
 bool V8Context::shouldBeRemoved(double maxAge, uint64_t maxInvocations) const {
   if (maxAge > 0.0 && age() > maxAge) {
     // context is "too old"
@@ -89,6 +89,9 @@ class V8Context {
   bool isDefault() const { return _id == 0; }
   void assertLocked() const;
   double age() const;
+  // seconds since the context was handed out last
+  double idleTime() const;
+  void setUsed(double stamp) { _lastUsedStamp = stamp; }
   void lockAndEnter();
   void unlockAndExit();
   uint64_t invocations() const { return _invocations; }
@@ -103,6 +106,7 @@ class V8Context {
   v8::Locker* _locker;
   double const _creationStamp;
   double _lastGcStamp;
+  double _lastUsedStamp;
   uint64_t _invocations;
   uint64_t _invocationsSinceLastGc;
   bool _hasActiveExternals;
@@ -44,6 +44,7 @@
 #include "RestServer/DatabasePathFeature.h"
 #include "RestServer/SystemDatabaseFeature.h"
 #include "Scheduler/SchedulerFeature.h"
+#include "Statistics/Tracing.h"
 #include "Transaction/V8Context.h"
 #include "V8/JavaScriptSecurityContext.h"
 #include "V8/v8-buffer.h"
@@ -97,6 +98,7 @@ V8DealerFeature::V8DealerFeature(application_features::ApplicationServer& server
       _gcFrequency(60.0),
       _gcInterval(2000),
       _maxContextAge(60.0),
+      _maxContextIdleTime(60.0),
       _copyInstallation(false),
       _nrMaxContexts(0),
       _nrMinContexts(0),
@@ -171,6 +173,12 @@ void V8DealerFeature::collectOptions(std::shared_ptr<ProgramOptions> options) {
       new DoubleParameter(&_maxContextAge),
       arangodb::options::makeFlags(arangodb::options::Flags::Hidden));
 
+  options->addOption(
+      "--javascript.v8-contexts-max-idle-time",
+      "time (in seconds) after which an unused V8 context above the minimum "
+      "number of contexts is disposed (0 = never)",
+      new DoubleParameter(&_maxContextIdleTime));
+
   options->addOption(
       "--javascript.allow-admin-execute",
       "for testing purposes allow '_admin/execute', NEVER enable on production",
@@ -385,15 +393,48 @@ void V8DealerFeature::start() {
     _idleContexts.reserve(static_cast<size_t>(_nrMaxContexts));
     _dirtyContexts.reserve(static_cast<size_t>(_nrMaxContexts));
 
-    for (size_t i = 0; i < _nrMinContexts; ++i) {
-      guard.unlock();  // avoid lock order inversion in buildContext
-      V8Context* context = buildContext(nextId());
-      guard.lock();
+    guard.unlock();  // avoid lock order inversion in buildContext
+
+    // every context runs the bootstrap code, which takes a while. the
+    // default context is built first, all others in parallel
+    std::vector<V8Context*> built(static_cast<size_t>(_nrMinContexts), nullptr);
+    std::vector<std::exception_ptr> errors(built.size());
+    built[0] = buildContext(nextId());
+    {
+      std::vector<std::thread> threads;
+      threads.reserve(built.size() - 1);
+      for (size_t i = 1; i < built.size(); ++i) {
+        threads.emplace_back([&, i]() {
+          try {
+            built[i] = buildContext(nextId());
+          } catch (...) {
+            errors[i] = std::current_exception();
+          }
+        });
+      }
+      for (auto& t : threads) {
+        t.join();
+      }
+    }
+
+    guard.lock();
+    for (size_t i = 0; i < built.size(); ++i) {
+      if (errors[i] != nullptr) {
+        for (auto& context : built) {
+          delete context;
+        }
+        std::rethrow_exception(errors[i]);
+      }
+    }
+    for (auto& context : built) {
       TRI_ASSERT(context != nullptr);
       try {
         _contexts.push_back(context);
       } catch (...) {
-        delete context;
+        // delete the contexts not yet in the list
+        for (auto it = built.begin() + _contexts.size(); it != built.end(); ++it) {
+          delete *it;
+        }
         throw;
       }
     }
@@ -634,6 +675,52 @@ void V8DealerFeature::collectGarbage() {
           gotSignal = guard.wait(waitTime);
         }
 
+        V8Context* superfluous = pickIdleContextForRemoval();
+        if (superfluous != nullptr) {
+          LOG_TOPIC("4e5d1", DEBUG, Logger::V8)
+              << "removing idle V8 context #" << superfluous->id()
+              << ", number of contexts is now: " << _contexts.size();
+
+          guard.unlock();
+          shutdownContext(superfluous);
+          continue;
+        }
+
+        if (needsSpareContext()) {
+          // all contexts are in use. create another one now, so that the
+          // next request does not have to wait for it
+          ++_nrInflightContexts;
+          guard.unlock();
+
+          V8Context* spare = nullptr;
+          try {
+            spare = addContext();
+          } catch (...) {
+          }
+
+          guard.lock();
+          --_nrInflightContexts;
+
+          if (spare != nullptr) {
+            try {
+              _contexts.push_back(spare);
+              try {
+                _idleContexts.push_back(spare);
+              } catch (...) {
+                _contexts.pop_back();
+                throw;
+              }
+              LOG_TOPIC("b91c4", DEBUG, Logger::V8)
+                  << "created spare V8 context #" << spare->id()
+                  << ", number of contexts is now " << _contexts.size();
+            } catch (...) {
+              delete spare;
+            }
+            guard.broadcast();
+          }
+          continue;
+        }
+
         if (preferFree && !_idleContexts.empty()) {
           context = pickFreeContextForGc();
         }
@@ -879,6 +966,7 @@ void V8DealerFeature::prepareLockedContext(TRI_vocbase_t* vocbase, V8Context* co
 /// currently returns a nullptr if no context can be acquired in time
 V8Context* V8DealerFeature::enterContext(TRI_vocbase_t* vocbase, JavaScriptSecurityContext const& securityContext) {
   TRI_ASSERT(vocbase != nullptr);
+  tracing::ScopedSpan traceSpan("V8 context acquisition");
 
   if (_stopping) {
     return nullptr;
@@ -991,9 +1079,15 @@ V8Context* V8DealerFeature::enterContext(TRI_vocbase_t* vocbase, JavaScriptSecur
     TRI_ASSERT(context != nullptr);
 
     _idleContexts.pop_back();
+    context->setUsed(TRI_microtime());
 
     // should not fail because we reserved enough space beforehand
     _busyContexts.emplace(context);
+
+    if (needsSpareContext()) {
+      // wake up the gc thread, which creates another context
+      guard.broadcast();
+    }
   }
 
   TRI_ASSERT(context != nullptr);
@@ -1291,6 +1385,41 @@ void V8DealerFeature::shutdownContexts() {
   LOG_TOPIC("7cdb2", DEBUG, arangodb::Logger::V8) << "V8 contexts are shut down";
 }
 
+V8Context* V8DealerFeature::pickIdleContextForRemoval() {
+  if (_maxContextIdleTime <= 0.0 || _contexts.size() <= _nrMinContexts ||
+      _dynamicContextCreationBlockers > 0) {
+    return nullptr;
+  }
+
+  // the context that has not been used for the longest time
+  auto picked = _idleContexts.end();
+  double maxIdleTime = _maxContextIdleTime;
+
+  for (auto it = _idleContexts.begin(); it != _idleContexts.end(); ++it) {
+    double const idleTime = (*it)->idleTime();
+    if (!(*it)->isDefault() && idleTime > maxIdleTime) {
+      picked = it;
+      maxIdleTime = idleTime;
+    }
+  }
+
+  if (picked == _idleContexts.end()) {
+    return nullptr;
+  }
+
+  V8Context* context = *picked;
+  _idleContexts.erase(picked);
+  _contexts.erase(std::remove(_contexts.begin(), _contexts.end(), context),
+                  _contexts.end());
+  return context;
+}
+
+bool V8DealerFeature::needsSpareContext() const {
+  return _idleContexts.empty() && _dirtyContexts.empty() && !_stopping &&
+         _dynamicContextCreationBlockers == 0 && _nrInflightContexts == 0 &&
+         _contexts.size() < _nrMaxContexts;
+}
+
 V8Context* V8DealerFeature::pickFreeContextForGc() {
   int const n = static_cast<int>(_idleContexts.size());
 
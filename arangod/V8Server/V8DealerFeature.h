@@ -63,6 +63,7 @@ class V8DealerFeature final : public application_features::ApplicationFeature {
   double _gcFrequency;
   uint64_t _gcInterval;
   double _maxContextAge;
+  double _maxContextIdleTime;
   std::string _appPath;
   std::string _startupDirectory;
   std::string _nodeModulesDirectory;
@@ -124,6 +125,8 @@ class V8DealerFeature final : public application_features::ApplicationFeature {
   V8Context* addContext();
   V8Context* buildContext(size_t id);
   V8Context* pickFreeContextForGc();
+  V8Context* pickIdleContextForRemoval();
+  bool needsSpareContext() const;
   void shutdownContext(V8Context* context);
   void unblockDynamicContextCreation();
   void loadJavaScriptFileInternal(std::string const& file, V8Context* context,
@@ -35,6 +35,7 @@
 #include "Basics/WriteLocker.h"
 #include "Basics/conversions.h"
 #include "Cluster/ClusterInfo.h"
+#include "Cluster/ClusterMethods.h"
 #include "Cluster/FollowerInfo.h"
 #include "GeneralServer/AuthenticationFeature.h"
 #include "Indexes/Index.h"
@@ -48,6 +49,7 @@
 #include "StorageEngine/EngineSelectorFeature.h"
 #include "StorageEngine/PhysicalCollection.h"
 #include "StorageEngine/StorageEngine.h"
+#include "Transaction/Helpers.h"
 #include "Transaction/Hints.h"
 #include "Transaction/V8Context.h"
 #include "Utils/CollectionNameResolver.h"
@@ -2406,6 +2408,7 @@ static void JS_ExistsVocbase(v8::FunctionCallbackInfo<v8::Value> const& args) {
 
 static void JS_CountVocbaseCol(v8::FunctionCallbackInfo<v8::Value> const& args) {
   TRI_V8_TRY_CATCH_BEGIN(isolate);
+  v8::Local<v8::Context> context = isolate->GetCurrentContext();
   v8::HandleScope scope(isolate);
 
   auto* col = UnwrapCollection(isolate, args.Holder());
@@ -2419,27 +2422,51 @@ static void JS_CountVocbaseCol(v8::FunctionCallbackInfo<v8::Value> const& args)
   }
 
   bool details = false;
+  bool approximate = false;
   if (args.Length() == 1 && ServerState::instance()->isCoordinator()) {
-    details = TRI_ObjectToBoolean(isolate, args[0]);
+    if (args[0]->IsObject()) {
+      // count({ details, approximate })
+      v8::Handle<v8::Object> optionsObject = args[0].As<v8::Object>();
+      if (TRI_HasProperty(context, isolate, optionsObject, "details")) {
+        details = TRI_ObjectToBoolean(isolate,
+                                      optionsObject->Get(TRI_V8_ASCII_STRING(isolate, "details")));
+      }
+      if (TRI_HasProperty(context, isolate, optionsObject, "approximate")) {
+        approximate = TRI_ObjectToBoolean(
+            isolate, optionsObject->Get(TRI_V8_ASCII_STRING(isolate, "approximate")));
+      }
+    } else {
+      details = TRI_ObjectToBoolean(isolate, args[0]);
+    }
   }
 
   auto& collectionName = col->name();
-  SingleCollectionTransaction trx(transaction::V8Context::Create(col->vocbase(), true),
-                                  collectionName, AccessMode::Type::READ);
+  OperationResult opResult;
 
-  Result res = trx.begin();
+  std::vector<std::pair<std::string, uint64_t>> counts;
+  if (approximate && approximateCountOnCoordinator(col->vocbase().name(), collectionName,
+                                                   counts) == TRI_ERROR_NO_ERROR) {
+    // served from the counts reported to the agency, without a transaction
+    int64_t total = 0;
+    opResult = transaction::helpers::buildCountResult(
+        counts, details ? transaction::CountType::Detailed : transaction::CountType::Normal, total);
+  } else {
+    SingleCollectionTransaction trx(transaction::V8Context::Create(col->vocbase(), true),
+                                    collectionName, AccessMode::Type::READ);
 
-  if (!res.ok()) {
-    TRI_V8_THROW_EXCEPTION(res);
-  }
+    Result res = trx.begin();
 
-  OperationResult opResult =
-      trx.count(collectionName, details ? transaction::CountType::Detailed
-                                        : transaction::CountType::Normal);
-  res = trx.finish(opResult.result);
+    if (!res.ok()) {
+      TRI_V8_THROW_EXCEPTION(res);
+    }
 
-  if (res.fail()) {
-    TRI_V8_THROW_EXCEPTION(res);
+    opResult = trx.count(collectionName, details ? transaction::CountType::Detailed
+                                                 : transaction::CountType::Normal);
+    res = trx.finish(opResult.result);
+
+    if (res.fail()) {
+      TRI_V8_THROW_EXCEPTION(res);
+    }
   }
 
   VPackSlice s = opResult.slice();
@@ -921,6 +921,8 @@ static void JS_QueriesCurrentAql(v8::FunctionCallbackInfo<v8::Value> const& args
       obj->Set(TRI_V8_ASCII_STRING(isolate, "state"),
                TRI_V8_STD_STRING(isolate, aql::QueryExecutionState::toString(q.state)));
       obj->Set(TRI_V8_ASCII_STRING(isolate, "stream"), v8::Boolean::New(isolate, q.stream));
+      obj->Set(TRI_V8_ASCII_STRING(isolate, "memoryUsage"),
+               v8::Number::New(isolate, static_cast<double>(q.memoryUsage)));
       result->Set(i++, obj);
     }
 
@@ -977,6 +979,10 @@ static void JS_QueriesSlowAql(v8::FunctionCallbackInfo<v8::Value> const& args) {
       obj->Set(TRI_V8_ASCII_STRING(isolate, "state"),
                TRI_V8_STD_STRING(isolate, aql::QueryExecutionState::toString(q.state)));
       obj->Set(TRI_V8_ASCII_STRING(isolate, "stream"), v8::Boolean::New(isolate, q.stream));
+      if (q.metrics != nullptr) {
+        obj->Set(TRI_V8_ASCII_STRING(isolate, "nodes"),
+                 TRI_VPackToV8(isolate, q.metrics->slice()));
+      }
       result->Set(i++, obj);
     }
 
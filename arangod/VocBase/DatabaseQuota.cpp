@@ -0,0 +1,217 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "DatabaseQuota.h"
+
+#include "ApplicationFeatures/ApplicationServer.h"
+#include "Basics/Exceptions.h"
+#include "Basics/MutexLocker.h"
+#include "Basics/ScopeGuard.h"
+#include "Scheduler/Scheduler.h"
+#include "Scheduler/SchedulerFeature.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include <thread>
+
+using namespace arangodb;
+
+namespace {
+uint64_t microseconds(DatabaseQuota::clock::duration d) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(d).count();
+}
+}  // namespace
+
+DatabaseQuota::DatabaseQuota()
+    : _maxSchedulerJobs(0),
+      _maxWriteRate(0),
+      _maxQueries(0),
+      _jobsRunning(0),
+      _writeClock(),
+      _queriesRunning(0),
+      _jobsDone(0),
+      _jobsParked(0),
+      _jobsTime(0),
+      _queriesStarted(0),
+      _queriesRejected(0),
+      _bytesWritten(0),
+      _writesThrottledTime(0) {}
+
+void DatabaseQuota::setLimits(Limits const& limits) {
+  _maxSchedulerJobs.store(limits.schedulerJobs);
+  _maxWriteRate.store(limits.writeRate);
+  _maxQueries.store(limits.queries);
+}
+
+DatabaseQuota::Limits DatabaseQuota::limits() const {
+  Limits limits;
+  limits.schedulerJobs = _maxSchedulerJobs.load(std::memory_order_relaxed);
+  limits.writeRate = _maxWriteRate.load(std::memory_order_relaxed);
+  limits.queries = _maxQueries.load(std::memory_order_relaxed);
+  return limits;
+}
+
+void DatabaseQuota::runJob(RequestLane lane, std::function<void()>&& job) {
+  {
+    MUTEX_LOCKER(locker, _jobsLock);
+    uint64_t const limit = _maxSchedulerJobs.load(std::memory_order_relaxed);
+    if (limit > 0 && _jobsRunning >= limit) {
+      _parkedJobs.push_back(ParkedJob{lane, std::move(job)});
+      _jobsParked.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    ++_jobsRunning;
+  }
+
+  execute(std::move(job));
+}
+
+void DatabaseQuota::execute(std::function<void()>&& job) {
+  std::function<void()> next = std::move(job);
+
+  // runs parked jobs inline if the scheduler does not take them
+  while (next) {
+    std::function<void()> current = std::move(next);
+    next = nullptr;
+
+    auto const started = clock::now();
+    auto guard = scopeGuard([this, started, &next]() { finishJob(started, next); });
+    current();
+  }
+}
+
+void DatabaseQuota::finishJob(clock::time_point started, std::function<void()>& next) noexcept {
+  _jobsTime.fetch_add(::microseconds(clock::now() - started), std::memory_order_relaxed);
+  _jobsDone.fetch_add(1, std::memory_order_relaxed);
+
+  ParkedJob parked;
+  {
+    MUTEX_LOCKER(locker, _jobsLock);
+    uint64_t const limit = _maxSchedulerJobs.load(std::memory_order_relaxed);
+    if (_parkedJobs.empty() || (limit > 0 && _jobsRunning > limit)) {
+      TRI_ASSERT(_jobsRunning > 0);
+      --_jobsRunning;
+      return;
+    }
+    // the slot is handed on to the longest parked job, so jobs that arrive
+    // in the meantime cannot overtake it
+    parked = std::move(_parkedJobs.front());
+    _parkedJobs.pop_front();
+  }
+
+  try {
+    Scheduler* scheduler = SchedulerFeature::SCHEDULER;
+    if (scheduler != nullptr) {
+      std::function<void()> job = parked.job;
+      if (scheduler->queue(parked.lane, [this, job = std::move(job)]() mutable {
+            execute(std::move(job));
+          })) {
+        return;
+      }
+    }
+  } catch (...) {
+  }
+
+  next = std::move(parked.job);
+}
+
+void DatabaseQuota::startQuery() {
+  uint64_t const limit = _maxQueries.load(std::memory_order_relaxed);
+  uint64_t const running = _queriesRunning.fetch_add(1) + 1;
+  if (limit > 0 && running > limit) {
+    _queriesRunning.fetch_sub(1);
+    _queriesRejected.fetch_add(1, std::memory_order_relaxed);
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_RESOURCE_LIMIT,
+                                   "too many concurrent queries in database");
+  }
+  _queriesStarted.fetch_add(1, std::memory_order_relaxed);
+}
+
+void DatabaseQuota::finishQuery() noexcept {
+  TRI_ASSERT(_queriesRunning.load() > 0);
+  _queriesRunning.fetch_sub(1);
+}
+
+DatabaseQuota::clock::duration DatabaseQuota::writeDelay(uint64_t bytes,
+                                                         clock::time_point now) {
+  uint64_t const rate = _maxWriteRate.load(std::memory_order_relaxed);
+  if (rate == 0) {
+    return clock::duration::zero();
+  }
+
+  MUTEX_LOCKER(locker, _writeLock);
+  auto const earliest = now - std::chrono::seconds(1);
+  if (_writeClock < earliest) {
+    _writeClock = earliest;
+  }
+  _writeClock += std::chrono::duration_cast<clock::duration>(
+      std::chrono::duration<double>(static_cast<double>(bytes) / rate));
+
+  if (_writeClock <= now) {
+    return clock::duration::zero();
+  }
+  return _writeClock - now;
+}
+
+void DatabaseQuota::throttleWrite(uint64_t bytes) {
+  _bytesWritten.fetch_add(bytes, std::memory_order_relaxed);
+
+  auto delay = writeDelay(bytes, clock::now());
+  if (delay == clock::duration::zero()) {
+    return;
+  }
+
+  _writesThrottledTime.fetch_add(::microseconds(delay), std::memory_order_relaxed);
+
+  // sleep in steps, so that a large write does not delay the shutdown
+  auto const step = std::chrono::duration_cast<clock::duration>(std::chrono::milliseconds(100));
+  while (delay > clock::duration::zero() &&
+         !application_features::ApplicationServer::isStopping()) {
+    auto const sleep = std::min(delay, step);
+    std::this_thread::sleep_for(sleep);
+    delay -= sleep;
+  }
+}
+
+void DatabaseQuota::toVelocyPack(VPackBuilder& builder) const {
+  uint64_t jobsRunning;
+  uint64_t jobsWaiting;
+  {
+    MUTEX_LOCKER(locker, _jobsLock);
+    jobsRunning = _jobsRunning;
+    jobsWaiting = _parkedJobs.size();
+  }
+
+  VPackObjectBuilder guard(&builder);
+  builder.add("maxSchedulerJobs", VPackValue(_maxSchedulerJobs.load()));
+  builder.add("maxWriteRate", VPackValue(_maxWriteRate.load()));
+  builder.add("maxQueries", VPackValue(_maxQueries.load()));
+  builder.add("schedulerJobsRunning", VPackValue(jobsRunning));
+  builder.add("schedulerJobsWaiting", VPackValue(jobsWaiting));
+  builder.add("schedulerJobsDone", VPackValue(_jobsDone.load()));
+  builder.add("schedulerJobsParked", VPackValue(_jobsParked.load()));
+  builder.add("schedulerTime", VPackValue(_jobsTime.load() / 1000000.0));
+  builder.add("queriesRunning", VPackValue(_queriesRunning.load()));
+  builder.add("queriesStarted", VPackValue(_queriesStarted.load()));
+  builder.add("queriesRejected", VPackValue(_queriesRejected.load()));
+  builder.add("bytesWritten", VPackValue(_bytesWritten.load()));
+  builder.add("writeThrottleTime", VPackValue(_writesThrottledTime.load() / 1000000.0));
+}
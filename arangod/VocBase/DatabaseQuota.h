@@ -0,0 +1,127 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_VOCBASE_DATABASE_QUOTA_H
+#define ARANGOD_VOCBASE_DATABASE_QUOTA_H 1
+
+#include "Basics/Common.h"
+#include "Basics/Mutex.h"
+#include "GeneralServer/RequestLane.h"
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <functional>
+
+namespace arangodb {
+namespace velocypack {
+class Builder;
+}
+
+/// @brief limits for the server resources a single database may use, and
+/// the database's usage of them. they keep one busy database from degrading
+/// the service of all other databases of the server
+class DatabaseQuota {
+ public:
+  typedef std::chrono::steady_clock clock;
+
+  struct Limits {
+    /// @brief client requests of the database that may run on scheduler
+    /// threads at the same time, 0 means no limit
+    uint64_t schedulerJobs = 0;
+    /// @brief bytes per second the database may write to the storage
+    /// engine, 0 means no limit
+    uint64_t writeRate = 0;
+    /// @brief AQL queries of the database that may run at the same time,
+    /// 0 means no limit
+    uint64_t queries = 0;
+  };
+
+  DatabaseQuota();
+
+  DatabaseQuota(DatabaseQuota const&) = delete;
+  DatabaseQuota& operator=(DatabaseQuota const&) = delete;
+
+  void setLimits(Limits const& limits);
+  Limits limits() const;
+
+  /// @brief run a scheduler job of the database. if the database already
+  /// runs as many jobs as it may, the job is parked and queued again once
+  /// one of the running jobs finishes. the job must keep the database in
+  /// use until it has run
+  void runJob(RequestLane lane, std::function<void()>&& job);
+
+  /// @brief register a new AQL query, throws TRI_ERROR_RESOURCE_LIMIT if
+  /// the database runs as many queries as it may
+  void startQuery();
+  void finishQuery() noexcept;
+
+  /// @brief account bytes written by a transaction and wait until the
+  /// database's write rate allows them
+  void throttleWrite(uint64_t bytes);
+
+  /// @brief how long a write of the given size has to wait at the time
+  /// given. unused write capacity is kept for at most one second
+  clock::duration writeDelay(uint64_t bytes, clock::time_point now);
+
+  void toVelocyPack(velocypack::Builder& builder) const;
+
+ private:
+  struct ParkedJob {
+    RequestLane lane;
+    std::function<void()> job;
+  };
+
+  /// @brief run an admitted job and hand its slot on when it is done
+  void execute(std::function<void()>&& job);
+
+  /// @brief release a job slot or pass it on to the next parked job,
+  /// which is returned in next if it could not be queued in the scheduler
+  void finishJob(clock::time_point started, std::function<void()>& next) noexcept;
+
+  std::atomic<uint64_t> _maxSchedulerJobs;
+  std::atomic<uint64_t> _maxWriteRate;
+  std::atomic<uint64_t> _maxQueries;
+
+  /// @brief protects _jobsRunning and _parkedJobs
+  mutable Mutex _jobsLock;
+  uint64_t _jobsRunning;
+  std::deque<ParkedJob> _parkedJobs;
+
+  /// @brief protects _writeClock
+  Mutex _writeLock;
+  /// @brief the time at which the writes accounted so far are paid for
+  clock::time_point _writeClock;
+
+  std::atomic<uint64_t> _queriesRunning;
+
+  // usage statistics
+  std::atomic<uint64_t> _jobsDone;
+  std::atomic<uint64_t> _jobsParked;
+  std::atomic<uint64_t> _jobsTime;
+  std::atomic<uint64_t> _queriesStarted;
+  std::atomic<uint64_t> _queriesRejected;
+  std::atomic<uint64_t> _bytesWritten;
+  std::atomic<uint64_t> _writesThrottledTime;
+};
+
+}  // namespace arangodb
+
+#endif
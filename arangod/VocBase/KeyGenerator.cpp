@@ -23,8 +23,6 @@
 
 #include "KeyGenerator.h"
 #include "Basics/Endian.h"
-#include "Basics/Mutex.h"
-#include "Basics/MutexLocker.h"
 #include "Basics/NumberUtils.h"
 #include "Basics/StaticStrings.h"
 #include "Basics/StringUtils.h"
@@ -191,14 +189,145 @@ enum class GeneratorType : int {
 /// @brief for older compilers
 typedef std::underlying_type<GeneratorType>::type GeneratorMapType;
 
+/// @brief number of key values a thread leases from a generator at once
+constexpr uint64_t keyBlockSize = 64;
+
+/// @brief source of unique ids for generators that lease key values
+std::atomic<uint64_t> nextLeasingGeneratorId(0);
+
+/// @brief key values a thread has leased from a generator. values in
+/// [next, end) have not been handed out yet
+struct KeyBlock {
+  uint64_t generatorId = 0;
+  uint64_t next = 0;
+  uint64_t end = 0;
+};
+
+/// @brief leases of the current thread, slotted by generator id. a thread
+/// inserting into many collections evicts leases, which only leaves gaps
+thread_local std::array<KeyBlock, 8> keyBlocks;
+
+/// @brief increasing key values for a single server. by default, every
+/// value is taken from the shared state, so values are strictly ascending
+/// in the order they are handed out. with leasing, every thread leases
+/// blocks of values, so that threads inserting into the same collection
+/// only touch the shared state once per block. values are then unique, but
+/// only ascending per thread: a thread hands out the rest of its block even
+/// after another thread leased a newer one
+class KeyValues {
+ public:
+  explicit KeyValues(bool lease)
+      : _id(lease ? nextLeasingGeneratorId.fetch_add(1, std::memory_order_relaxed) + 1 : 0),
+        _lastValue(0),
+        _trackedValue(0) {}
+
+  /// @brief highest value handed out, leased or tracked
+  uint64_t lastValue() const { return _lastValue.load(std::memory_order_relaxed); }
+
+  /// @brief the next key value, 0 when out of keys
+  uint64_t next() {
+    if (_id == 0) {
+      return nextStrict();
+    }
+
+    KeyBlock& block = keyBlocks[_id % keyBlocks.size()];
+    // values up to a tracked value may be in use by a key from elsewhere
+    if (block.generatorId == _id && block.next < block.end &&
+        block.next > _trackedValue.load(std::memory_order_relaxed)) {
+      return block.next++;
+    }
+
+    // lease a new block. it starts at the current server tick at the
+    // earliest, so that keys keep growing with time
+    uint64_t tick = TRI_NewTickServer();
+
+    if (ADB_UNLIKELY(tick == UINT64_MAX)) {
+      // out of keys
+      return 0;
+    }
+
+    uint64_t start;
+    auto lastValue = _lastValue.load(std::memory_order_relaxed);
+    do {
+      start = std::max(tick, lastValue + 1);
+      if (ADB_UNLIKELY(lastValue >= UINT64_MAX - 1ULL ||
+                       start >= UINT64_MAX - keyBlockSize)) {
+        // oops, out of keys!
+        return 0;
+      }
+    } while (!_lastValue.compare_exchange_weak(lastValue, start + keyBlockSize - 1,
+                                               std::memory_order_relaxed));
+
+    block.generatorId = _id;
+    block.next = start + 1;
+    block.end = start + keyBlockSize;
+    return start;
+  }
+
+  /// @brief track a value used by a key from elsewhere
+  void track(uint64_t value) {
+    if (_id == 0) {
+      raise(_lastValue, value);
+      return;
+    }
+    raise(_lastValue, value);
+    // the value may lie in a block that is still leased. threads lease a
+    // new block, which starts above it, once they get there
+    raise(_trackedValue, value);
+  }
+
+ private:
+  uint64_t nextStrict() {
+    uint64_t tick = TRI_NewTickServer();
+
+    if (ADB_UNLIKELY(tick == UINT64_MAX)) {
+      // out of keys
+      return 0;
+    }
+
+    // keep track of last assigned value, and make sure the value
+    // we hand out is always higher than it
+    auto lastValue = _lastValue.load(std::memory_order_relaxed);
+    if (ADB_UNLIKELY(lastValue >= UINT64_MAX - 1ULL)) {
+      // oops, out of keys!
+      return 0;
+    }
+
+    do {
+      if (tick <= lastValue) {
+        tick = _lastValue.fetch_add(1, std::memory_order_relaxed) + 1;
+        break;
+      }
+    } while (!_lastValue.compare_exchange_weak(lastValue, tick, std::memory_order_relaxed));
+
+    return tick;
+  }
+
+  static void raise(std::atomic<uint64_t>& target, uint64_t value) {
+    auto current = target.load(std::memory_order_relaxed);
+    while (value > current) {
+      if (target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+        break;
+      }
+    }
+  }
+
+ private:
+  /// @brief id of a leasing generator, 0 if values are not leased
+  uint64_t const _id;
+  std::atomic<uint64_t> _lastValue;
+  /// @brief highest value tracked from keys generated elsewhere
+  std::atomic<uint64_t> _trackedValue;
+};
+
 /// Actual key generators following...
 
 /// @brief base class for traditional key generators
 class TraditionalKeyGenerator : public KeyGenerator {
  public:
   /// @brief create the generator
-  explicit TraditionalKeyGenerator(bool allowUserKeys)
-      : KeyGenerator(allowUserKeys) {}
+  TraditionalKeyGenerator(bool allowUserKeys, bool leaseValues)
+      : KeyGenerator(allowUserKeys), _leaseValues(leaseValues) {}
 
   bool hasDynamicState() const override { return true; }
 
@@ -245,6 +374,9 @@ class TraditionalKeyGenerator : public KeyGenerator {
   void toVelocyPack(arangodb::velocypack::Builder& builder) const override {
     KeyGenerator::toVelocyPack(builder);
     builder.add("type", VPackValue("traditional"));
+    if (_leaseValues) {
+      builder.add("leaseValues", VPackValue(true));
+    }
   }
 
  protected:
@@ -253,14 +385,18 @@ class TraditionalKeyGenerator : public KeyGenerator {
 
   /// @brief track a value (internal)
   virtual void track(uint64_t value) = 0;
+
+ protected:
+  /// @brief whether single servers lease blocks of values per thread
+  bool const _leaseValues;
 };
 
 /// @brief traditional key generator for a single server
 class TraditionalKeyGeneratorSingle final : public TraditionalKeyGenerator {
  public:
   /// @brief create the generator
-  explicit TraditionalKeyGeneratorSingle(bool allowUserKeys)
-      : TraditionalKeyGenerator(allowUserKeys), _lastValue(0) {
+  TraditionalKeyGeneratorSingle(bool allowUserKeys, bool leaseValues)
+      : TraditionalKeyGenerator(allowUserKeys, leaseValues), _values(leaseValues) {
     TRI_ASSERT(!ServerState::instance()->isCoordinator());
   }
 
@@ -268,51 +404,19 @@ class TraditionalKeyGeneratorSingle final : public TraditionalKeyGenerator {
   void toVelocyPack(arangodb::velocypack::Builder& builder) const override {
     TraditionalKeyGenerator::toVelocyPack(builder);
 
-    // add our specific stuff
-    builder.add(StaticStrings::LastValue, VPackValue(_lastValue.load(std::memory_order_relaxed)));
+    // add our specific stuff. leased values count as used
+    builder.add(StaticStrings::LastValue, VPackValue(_values.lastValue()));
   }
 
  private:
   /// @brief generate a key value (internal)
-  uint64_t generateValue() override {
-    uint64_t tick = TRI_NewTickServer();
-
-    if (ADB_UNLIKELY(tick == UINT64_MAX)) {
-      // out of keys
-      return 0;
-    }
-
-    // keep track of last assigned value, and make sure the value
-    // we hand out is always higher than it
-    auto lastValue = _lastValue.load(std::memory_order_relaxed);    
-    if (ADB_UNLIKELY(lastValue >= UINT64_MAX - 1ULL)) {
-      // oops, out of keys!
-      return 0;
-    }
-
-    do {
-      if (tick <= lastValue) {
-        tick = _lastValue.fetch_add(1, std::memory_order_relaxed) + 1;
-        break;
-      }
-    } while(!_lastValue.compare_exchange_weak(lastValue, tick, std::memory_order_relaxed));
-
-    return tick;
-  }
+  uint64_t generateValue() override { return _values.next(); }
 
   /// @brief track a key value (internal)
-  void track(uint64_t value) override {
-    auto lastValue = _lastValue.load(std::memory_order_relaxed);
-    while (value > lastValue) {
-      // and update our last value
-      if (_lastValue.compare_exchange_weak(lastValue, value, std::memory_order_relaxed)) {
-        break;
-      }
-    }
-  }
+  void track(uint64_t value) override { _values.track(value); }
 
  private:
-  std::atomic<uint64_t> _lastValue;
+  KeyValues _values;
 };
 
 /// @brief traditional key generator for a coordinator
@@ -325,8 +429,8 @@ class TraditionalKeyGeneratorSingle final : public TraditionalKeyGenerator {
 class TraditionalKeyGeneratorCluster final : public TraditionalKeyGenerator {
  public:
   /// @brief create the generator
-  explicit TraditionalKeyGeneratorCluster(bool allowUserKeys)
-      : TraditionalKeyGenerator(allowUserKeys) {
+  TraditionalKeyGeneratorCluster(bool allowUserKeys, bool leaseValues)
+      : TraditionalKeyGenerator(allowUserKeys, leaseValues) {
     TRI_ASSERT(ServerState::instance()->isCoordinator());
   }
 
@@ -457,7 +561,7 @@ class PaddedKeyGeneratorSingle final : public PaddedKeyGenerator {
  public:
   /// @brief create the generator
   explicit PaddedKeyGeneratorSingle(bool allowUserKeys)
-      : PaddedKeyGenerator(allowUserKeys), _lastValue(0) {
+      : PaddedKeyGenerator(allowUserKeys), _values(false) {
     TRI_ASSERT(!ServerState::instance()->isCoordinator());
   }
 
@@ -466,49 +570,19 @@ class PaddedKeyGeneratorSingle final : public PaddedKeyGenerator {
     PaddedKeyGenerator::toVelocyPack(builder);
 
     // add our own specific values
-    builder.add(StaticStrings::LastValue, VPackValue(_lastValue.load(std::memory_order_relaxed)));
+    builder.add(StaticStrings::LastValue, VPackValue(_values.lastValue()));
   }
 
  private:
   /// @brief generate a key
-  uint64_t generateValue() override {
-    uint64_t tick = TRI_NewTickServer();
-
-    if (ADB_UNLIKELY(tick == UINT64_MAX)) {
-      // oops, out of keys!
-      return 0;
-    }
-
-    auto lastValue = _lastValue.load(std::memory_order_relaxed);
-    if (ADB_UNLIKELY(lastValue >= UINT64_MAX - 1ULL)) {
-      // oops, out of keys!
-      return 0;
-    }
-
-    do {
-      if (tick <= lastValue) {
-        tick = _lastValue.fetch_add(1, std::memory_order_relaxed) + 1;
-        break;
-      }
-    } while(!_lastValue.compare_exchange_weak(lastValue, tick, std::memory_order_relaxed));
-
-
-    return tick;
-  }
+  uint64_t generateValue() override { return _values.next(); }
 
   /// @brief generate a key value (internal)
-  void track(uint64_t value) override {
-    auto lastValue = _lastValue.load(std::memory_order_relaxed);
-    while (value > lastValue) {
-      // and update our last value
-      if (_lastValue.compare_exchange_weak(lastValue, value, std::memory_order_relaxed)) {
-        break;
-      }
-    }
-  }
+  void track(uint64_t value) override { _values.track(value); }
 
  private:
-  std::atomic<uint64_t> _lastValue;
+  // no leasing, the keys must sort in the order they were generated
+  KeyValues _values;
 };
 
 /// @brief padded key generator for a coordinator
@@ -637,7 +711,8 @@ class UuidKeyGenerator final : public KeyGenerator {
 
   /// @brief generate a key
   std::string generate() override {
-    MUTEX_LOCKER(locker, _lock);
+    // random_generator is not thread-safe. one per thread spares the lock
+    thread_local boost::uuids::random_generator uuid;
     return boost::uuids::to_string(uuid());
   }
 
@@ -648,11 +723,6 @@ class UuidKeyGenerator final : public KeyGenerator {
     KeyGenerator::toVelocyPack(builder);
     builder.add("type", VPackValue("uuid"));
   }
-
- private:
-  arangodb::Mutex _lock;
-
-  boost::uuids::random_generator uuid;
 };
 
 /// @brief all generators, by name
@@ -694,10 +764,12 @@ std::unordered_map<GeneratorMapType, std::function<KeyGenerator*(bool, VPackSlic
      }},
     {static_cast<GeneratorMapType>(GeneratorType::TRADITIONAL),
      [](bool allowUserKeys, VPackSlice options) -> KeyGenerator* {
+       bool leaseValues =
+           arangodb::basics::VelocyPackHelper::getBooleanValue(options, "leaseValues", false);
        if (ServerState::instance()->isCoordinator()) {
-         return new TraditionalKeyGeneratorCluster(allowUserKeys);
+         return new TraditionalKeyGeneratorCluster(allowUserKeys, leaseValues);
        }
-       return new TraditionalKeyGeneratorSingle(allowUserKeys);
+       return new TraditionalKeyGeneratorSingle(allowUserKeys, leaseValues);
      }},
     {static_cast<GeneratorMapType>(GeneratorType::AUTOINCREMENT),
      [](bool allowUserKeys, VPackSlice options) -> KeyGenerator* {
@@ -44,6 +44,7 @@
 #include "Utils/SingleCollectionTransaction.h"
 #include "VocBase/KeyGenerator.h"
 #include "VocBase/ManagedDocumentResult.h"
+#include "VocBase/ticks.h"
 
 #include <velocypack/Collection.h>
 #include <velocypack/StringRef.h>
@@ -141,6 +142,7 @@ LogicalCollection::LogicalCollection(TRI_vocbase_t& vocbase, VPackSlice const& i
           Helper::readBooleanValue(info, StaticStrings::DataSourceDeleted, false)),
       _version(Helper::readNumericValue<uint32_t>(info, "version", currentVersion())),
       _internalVersion(0),
+      _invalidationTick(TRI_NewTickServer()),
       _type(Helper::readNumericValue<TRI_col_type_e, int>(info, StaticStrings::DataSourceType,
                                                           TRI_COL_TYPE_UNKNOWN)),
       _status(Helper::readNumericValue<TRI_vocbase_col_status_e, int>(
@@ -317,6 +319,13 @@ int LogicalCollection::getResponsibleShard(arangodb::velocypack::Slice slice,
                                         usesDefaultShardKeys, key);
 }
 
+int LogicalCollection::getResponsibleShards(arangodb::velocypack::Slice documents,
+                                            bool docComplete,
+                                            std::vector<std::string>& shardIDs) {
+  TRI_ASSERT(_sharding != nullptr);
+  return _sharding->getResponsibleShards(documents, docComplete, shardIDs);
+}
+
 /// @briefs creates a new document key, the input slice is ignored here
 std::string LogicalCollection::createKey(VPackSlice) {
   return keyGenerator()->generate();
@@ -421,6 +430,10 @@ TRI_voc_rid_t LogicalCollection::revision(transaction::Methods* trx) const {
   return _physical->revision(trx);
 }
 
+void LogicalCollection::bumpInvalidationTick() noexcept {
+  _invalidationTick.store(TRI_NewTickServer(), std::memory_order_release);
+}
+
 std::unique_ptr<FollowerInfo> const& LogicalCollection::followers() const {
   return _followers;
 }
@@ -160,6 +160,15 @@ class LogicalCollection : public LogicalDataSource {
 
   // SECTION: Properties
   TRI_voc_rid_t revision(transaction::Methods*) const;
+
+  /// @brief a server tick that changes after every committed modification of
+  /// the collection. coordinators compare the ticks of the shards of a query
+  /// to find out whether a cached query result is still valid
+  uint64_t invalidationTick() const noexcept {
+    return _invalidationTick.load(std::memory_order_acquire);
+  }
+  /// @brief must be called after a modification was committed
+  void bumpInvalidationTick() noexcept;
   bool waitForSync() const { return _waitForSync; }
   void waitForSync(bool value) { _waitForSync = value; }
   bool isSmart() const { return _isSmart; }
@@ -196,6 +205,10 @@ class LogicalCollection : public LogicalDataSource {
                           std::string& shardID, bool& usesDefaultShardKeys,
                           std::string const& key = "");
 
+  // query shards for all documents of an array
+  int getResponsibleShards(arangodb::velocypack::Slice documents, bool docComplete,
+                           std::vector<std::string>& shardIDs);
+
   /// @briefs creates a new document key, the input slice is ignored here
   /// this method is overriden in derived classes
   virtual std::string createKey(arangodb::velocypack::Slice input);
@@ -380,6 +393,9 @@ class LogicalCollection : public LogicalDataSource {
   // @brief Internal version used for caching
   uint32_t _internalVersion;
 
+  /// @brief see invalidationTick()
+  std::atomic<uint64_t> _invalidationTick;
+
   // @brief Collection type
   TRI_col_type_e const _type;
 
@@ -60,6 +60,8 @@
 #include <velocypack/Iterator.h>
 #include <velocypack/velocypack-aliases.h>
 
+#include <algorithm>
+
 using namespace arangodb;
 using namespace arangodb::basics;
 using namespace arangodb::methods;
@@ -391,19 +393,48 @@ Result Collections::create(TRI_vocbase_t& vocbase,
 /*static*/ Result Collections::createSystem(
     TRI_vocbase_t& vocbase,
     std::string const& name) {
+  return createSystem(vocbase, std::vector<std::string>{name});
+}
+
+/*static*/ Result Collections::createSystem(
+    TRI_vocbase_t& vocbase,
+    std::vector<std::string> const& names) {
   FuncCallback const noop = [](std::shared_ptr<LogicalCollection> const&)->void{};
 
-  auto res = methods::Collections::lookup(vocbase, name, noop);
+  std::vector<std::string> missing;
+  for (auto const& name : names) {
+    auto res = methods::Collections::lookup(vocbase, name, noop);
 
-  if (res.is(TRI_ERROR_ARANGO_DATA_SOURCE_NOT_FOUND)) {
-    uint32_t defaultReplFactor = 1;
+    if (res.is(TRI_ERROR_ARANGO_DATA_SOURCE_NOT_FOUND)) {
+      missing.emplace_back(name);
+    } else if (res.fail()) {
+      return res;
+    }
+  }
 
-    auto* cl = application_features::ApplicationServer::lookupFeature<ClusterFeature>("Cluster");
+  if (missing.empty()) {
+    return Result();
+  }
 
-    if (cl != nullptr) {
-      defaultReplFactor = cl->systemReplicationFactor();
-    }
+  uint32_t defaultReplFactor = 1;
+
+  auto* cl = application_features::ApplicationServer::lookupFeature<ClusterFeature>("Cluster");
+
+  if (cl != nullptr) {
+    defaultReplFactor = cl->systemReplicationFactor();
+  }
+
+  // _graphs is the prototype of all other system collections, so it has
+  // to come first
+  std::stable_partition(missing.begin(), missing.end(),
+                        [](std::string const& name) { return name == "_graphs"; });
 
+  std::vector<VPackBuilder> properties;
+  std::vector<CollectionCreationInfo> infos;
+  properties.reserve(missing.size());
+  infos.reserve(missing.size());
+
+  for (auto const& name : missing) {
     VPackBuilder bb;
 
     {
@@ -418,17 +449,18 @@ Result Collections::create(TRI_vocbase_t& vocbase,
       }
     }
 
-    res = Collections::create(
-      vocbase, // vocbase to create in
-      name, // collection name top create
-      TRI_COL_TYPE_DOCUMENT, // collection type to create
-      bb.slice(), // collection definition to create
-      true,  // waitsForSyncReplication
-      true,  // enforceReplicationFactor
-      noop); // callback
+    properties.emplace_back(std::move(bb));
+    infos.emplace_back(
+        CollectionCreationInfo{name, TRI_COL_TYPE_DOCUMENT, properties.back().slice()});
   }
 
-  return res;
+  // in a cluster, all collections are created with a single plan change
+  return Collections::create(
+    vocbase, // vocbase to create in
+    infos, // collections to create
+    true,  // waitsForSyncReplication
+    true,  // enforceReplicationFactor
+    [](std::vector<std::shared_ptr<LogicalCollection>> const&)->void{}); // callback
 }
 
 Result Collections::load(TRI_vocbase_t& vocbase, LogicalCollection* coll) {
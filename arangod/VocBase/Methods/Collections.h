@@ -96,6 +96,8 @@ struct Collections {
                        bool createWaitsForSyncReplication,
                        bool enforceReplicationFactor, MultiFuncCallback const&);
   static Result createSystem(TRI_vocbase_t& vocbase, std::string const& name);
+  /// @brief create all missing system collections of the list at once
+  static Result createSystem(TRI_vocbase_t& vocbase, std::vector<std::string> const& names);
 
   static Result load(TRI_vocbase_t& vocbase, LogicalCollection* coll);
   static Result unload(TRI_vocbase_t* vocbase, LogicalCollection* coll);
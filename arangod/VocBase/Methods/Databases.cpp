@@ -41,6 +41,7 @@
 #include "V8Server/V8DealerFeature.h"
 #include "V8Server/v8-dispatcher.h"
 #include "V8Server/v8-user-structures.h"
+#include "VocBase/DatabaseQuota.h"
 #include "VocBase/Methods/Upgrade.h"
 #include "VocBase/vocbase.h"
 
@@ -111,6 +112,8 @@ arangodb::Result Databases::info(TRI_vocbase_t* vocbase, VPackBuilder& result) {
       }
       result.add("path", VPackValue("none"));
       result.add("isSystem", VPackValue(name[0] == '_'));
+      result.add(VPackValue("quota"));
+      vocbase->quota().toVelocyPack(result);
     }
   } else {
     VPackObjectBuilder b(&result);
@@ -118,6 +121,8 @@ arangodb::Result Databases::info(TRI_vocbase_t* vocbase, VPackBuilder& result) {
     result.add("id", VPackValue(std::to_string(vocbase->id())));
     result.add("path", VPackValue(vocbase->path()));
     result.add("isSystem", VPackValue(vocbase->isSystem()));
+    result.add(VPackValue("quota"));
+    vocbase->quota().toVelocyPack(result);
   }
   return Result();
 }
@@ -373,7 +378,12 @@ arangodb::Result Databases::drop(TRI_vocbase_t* systemVocbase, std::string const
 
   int res;
   V8DealerFeature* dealer = V8DealerFeature::DEALER;
-  if (dealer != nullptr && dealer->isEnabled()) {
+  if (ServerState::instance()->isCoordinator()) {
+    // If we are a coordinator in a cluster, we have to behave differently.
+    // No V8 context is held while waiting for the plan change, as the
+    // database objects are dropped by the heartbeat thread anyway
+    res = ::dropDBCoordinator(dbName);
+  } else if (dealer != nullptr && dealer->isEnabled()) {
     try {
       JavaScriptSecurityContext securityContext =
           JavaScriptSecurityContext::createInternalContext();
@@ -386,23 +396,18 @@ arangodb::Result Databases::drop(TRI_vocbase_t* systemVocbase, std::string const
       // clear collections in cache object
       TRI_ClearObjectCacheV8(isolate);
 
-      if (ServerState::instance()->isCoordinator()) {
-        // If we are a coordinator in a cluster, we have to behave differently:
-        res = ::dropDBCoordinator(dbName);
-      } else {
-        res = DatabaseFeature::DATABASE->dropDatabase(dbName, false, true);
-
-        if (res != TRI_ERROR_NO_ERROR) {
-          events::DropDatabase(dbName, res);
-          return Result(res);
-        }
-
-        TRI_RemoveDatabaseTasksV8Dispatcher(dbName);
-        // run the garbage collection in case the database held some objects
-        // which can now be freed
-        TRI_RunGarbageCollectionV8(isolate, 0.25);
-        V8DealerFeature::DEALER->addGlobalContextMethod("reloadRouting");
+      res = DatabaseFeature::DATABASE->dropDatabase(dbName, false, true);
+
+      if (res != TRI_ERROR_NO_ERROR) {
+        events::DropDatabase(dbName, res);
+        return Result(res);
       }
+
+      TRI_RemoveDatabaseTasksV8Dispatcher(dbName);
+      // run the garbage collection in case the database held some objects
+      // which can now be freed
+      TRI_RunGarbageCollectionV8(isolate, 0.25);
+      V8DealerFeature::DEALER->addGlobalContextMethod("reloadRouting");
     } catch (arangodb::basics::Exception const& ex) {
       events::DropDatabase(dbName, TRI_ERROR_INTERNAL);
       return Result(ex.code(), dropError + ex.message());
@@ -414,12 +419,7 @@ arangodb::Result Databases::drop(TRI_vocbase_t* systemVocbase, std::string const
       return Result(TRI_ERROR_INTERNAL, dropError);
     }
   } else {
-    if (ServerState::instance()->isCoordinator()) {
-      // If we are a coordinator in a cluster, we have to behave differently:
-      res = ::dropDBCoordinator(dbName);
-    } else {
-      res = DatabaseFeature::DATABASE->dropDatabase(dbName, false, true);
-    }
+    res = DatabaseFeature::DATABASE->dropDatabase(dbName, false, true);
   }
 
   auth::UserManager* um = AuthenticationFeature::instance()->userManager();
@@ -164,6 +164,26 @@ bool UpgradeTasks::upgradeGeoIndexes(TRI_vocbase_t& vocbase,
   return true;
 }
 
+bool UpgradeTasks::createSystemCollections(TRI_vocbase_t& vocbase,
+                                           arangodb::velocypack::Slice const& slice) {
+  std::vector<std::string> names{"_graphs",     "_aqlfunctions", "_queues",
+                                 "_jobs",       "_apps",         "_appbundles"};
+  if (vocbase.isSystem()) {
+    names.emplace_back("_users");
+  }
+
+  // creating the collections in one go saves a plan change and a round of
+  // shard creation per collection in a cluster. the setup tasks below find
+  // them and only add their indexes
+  auto const res = methods::Collections::createSystem(vocbase, names);
+
+  if (res.fail()) {
+    THROW_ARANGO_EXCEPTION(res);
+  }
+
+  return true;
+}
+
 bool UpgradeTasks::setupGraphs(TRI_vocbase_t& vocbase,
                                arangodb::velocypack::Slice const& slice) {
   ::createSystemCollection(vocbase, "_graphs"); // throws on error
@@ -34,6 +34,7 @@ namespace methods {
 /// Replaces ugrade-database.js for good
 struct UpgradeTasks {
   static bool upgradeGeoIndexes(TRI_vocbase_t& vocbase, velocypack::Slice const& slice);
+  static bool createSystemCollections(TRI_vocbase_t& vocbase, velocypack::Slice const& slice);
   static bool setupGraphs(TRI_vocbase_t& vocbase, velocypack::Slice const& slice);
   static bool setupUsers(TRI_vocbase_t& vocbase, velocypack::Slice const& slice);
   static bool createUsersIndex(TRI_vocbase_t& vocbase, velocypack::Slice const& slice);
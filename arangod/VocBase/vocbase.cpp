@@ -62,6 +62,7 @@
 #include "Utils/ExecContext.h"
 #include "Utils/VersionTracker.h"
 #include "V8Server/v8-user-structures.h"
+#include "VocBase/DatabaseQuota.h"
 #include "VocBase/LogicalCollection.h"
 #include "VocBase/LogicalView.h"
 #include "VocBase/ticks.h"
@@ -1690,10 +1691,11 @@ TRI_vocbase_t::TRI_vocbase_t(TRI_vocbase_type_e type, TRI_voc_tick_t id,
   _queries.reset(new arangodb::aql::QueryList(this));
   _cursorRepository.reset(new arangodb::CursorRepository(*this));
   _collectionKeys.reset(new arangodb::CollectionKeysRepository());
+  _quota.reset(new arangodb::DatabaseQuota());
 
-  // init collections
-  _collections.reserve(32);
-  _deadCollections.reserve(32);
+  // init collections. dead collections are rare, so no room is reserved
+  // for them in the many idle databases a server may have
+  _collections.reserve(16);
 
   TRI_CreateUserStructuresVocBase(this);
 }
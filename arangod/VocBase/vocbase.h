@@ -44,6 +44,7 @@ class QueryList;
 class CollectionNameResolver;
 class CollectionKeysRepository;
 class CursorRepository;
+class DatabaseQuota;
 class DatabaseReplicationApplier;
 class LogicalCollection;
 class LogicalDataSource;
@@ -166,6 +167,7 @@ struct TRI_vocbase_t {
   std::unique_ptr<arangodb::aql::QueryList> _queries;
   std::unique_ptr<arangodb::CursorRepository> _cursorRepository;
   std::unique_ptr<arangodb::CollectionKeysRepository> _collectionKeys;
+  std::unique_ptr<arangodb::DatabaseQuota> _quota;
 
   std::unique_ptr<arangodb::DatabaseReplicationApplier> _replicationApplier;
   arangodb::ReplicationClientsProgressTracker _replicationClients;
@@ -213,6 +215,9 @@ struct TRI_vocbase_t {
     return _collectionKeys.get();
   }
 
+  /// @brief resource limits and usage of the database
+  arangodb::DatabaseQuota& quota() const { return *_quota; }
+
   bool isOwnAppsDirectory() const { return _isOwnAppsDirectory; }
   void setIsOwnAppsDirectory(bool value) { _isOwnAppsDirectory = value; }
 
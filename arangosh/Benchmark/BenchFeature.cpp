@@ -30,11 +30,19 @@
 #include <unistd.h>
 #endif
 
+#include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
 #include "ApplicationFeatures/ApplicationServer.h"
+#include "Basics/FileUtils.h"
 #include "Basics/StringUtils.h"
+#include "Basics/VelocyPackHelper.h"
 #include "Benchmark/BenchmarkCounter.h"
 #include "Benchmark/BenchmarkOperation.h"
 #include "Benchmark/BenchmarkThread.h"
+#include "Benchmark/BenchmarkWorkload.h"
 #include "ProgramOptions/ProgramOptions.h"
 #include "ProgramOptions/Section.h"
 #include "Shell/ClientFeature.h"
@@ -76,6 +84,12 @@ BenchFeature::BenchFeature(application_features::ApplicationServer& server, int*
       _replicationFactor(1),
       _numberOfShards(1),
       _waitForSync(false),
+      _rate(0),
+      _reportInterval(0.0),
+      _jsonReportFile(""),
+      _workloadFile(""),
+      _baselineFile(""),
+      _maxRegression(10.0),
       _result(result) {
   requiresElevatedPrivileges(false);
   setOptional(false);
@@ -126,11 +140,19 @@ void BenchFeature::collectOptions(std::shared_ptr<ProgramOptions> options) {
       "crud-append",     "crud-write-read",
       "aqltrx",          "counttrx",
       "multitrx",        "multi-collection",
-      "aqlinsert",       "aqlv8"};
+      "aqlinsert",       "aqlv8",
+      "workload"};
 
   options->addOption("--test-case", "test case to use",
                      new DiscreteValuesParameter<StringParameter>(&_testCase, cases));
 
+  options
+      ->addOption("--workload-file",
+                  "JSON file with the weighted AQL operations of the "
+                  "'workload' test case",
+                  new StringParameter(&_workloadFile))
+      .setIntroducedIn(30500);
+
   options->addOption(
       "--complexity",
       "complexity parameter for the test (meaning depends on test case)",
@@ -144,6 +166,44 @@ void BenchFeature::collectOptions(std::shared_ptr<ProgramOptions> options) {
                      "filename to write junit style report to",
                      new StringParameter(&_junitReportFile));
 
+  options
+      ->addOption("--json-report-file",
+                  "filename to write a machine-readable report with latency "
+                  "percentiles to",
+                  new StringParameter(&_jsonReportFile))
+      .setIntroducedIn(30500);
+
+  options
+      ->addOption("--baseline-file",
+                  "JSON report of an earlier run to compare throughput and "
+                  "latencies with. the run fails if it is slower than the "
+                  "baseline by more than --max-regression",
+                  new StringParameter(&_baselineFile))
+      .setIntroducedIn(30500);
+
+  options
+      ->addOption("--max-regression",
+                  "percentage by which throughput may drop, or latencies may "
+                  "rise, compared to the baseline",
+                  new DoubleParameter(&_maxRegression))
+      .setIntroducedIn(30500);
+
+  options
+      ->addOption("--rate",
+                  "send requests (or batches) at this constant rate per second "
+                  "over all threads, measuring latencies from the time a "
+                  "request was due (0 waits for each response before sending "
+                  "the next request)",
+                  new UInt64Parameter(&_rate))
+      .setIntroducedIn(30500);
+
+  options
+      ->addOption("--report-interval",
+                  "report throughput and latencies every this many seconds "
+                  "(0 disables interval reports)",
+                  new DoubleParameter(&_reportInterval))
+      .setIntroducedIn(30500);
+
   options->addOption(
       "--runs", "run test n times (and calculate statistics based on median)",
       new UInt64Parameter(&_runs));
@@ -181,7 +241,15 @@ void BenchFeature::start() {
   *_result = ret;
   ARANGOBENCH = this;
 
-  std::unique_ptr<BenchmarkOperation> benchmark(GetTestCase(_testCase));
+  std::unique_ptr<BenchmarkOperation> benchmark;
+  try {
+    benchmark.reset(GetTestCase(_testCase));
+  } catch (std::exception const& ex) {
+    ARANGOBENCH = nullptr;
+    LOG_TOPIC("e0a7c", FATAL, arangodb::Logger::FIXME)
+        << "cannot load test case '" << _testCase << "': " << ex.what();
+    FATAL_ERROR_EXIT();
+  }
 
   if (benchmark == nullptr) {
     ARANGOBENCH = nullptr;
@@ -221,6 +289,11 @@ void BenchFeature::start() {
                               static_cast<int>(i), (unsigned long)_batchSize,
                               &operationsCounter, client, _keepAlive, _async, _verbose);
       thread->setOffset((size_t)(i * realStep));
+      if (_rate > 0) {
+        // the threads share the rate and take turns
+        thread->setSchedule(static_cast<double>(_rate) / static_cast<double>(_concurreny),
+                            static_cast<double>(i) / static_cast<double>(_concurreny));
+      }
       thread->start();
       threads.push_back(thread);
     }
@@ -251,9 +324,34 @@ void BenchFeature::start() {
       nextReportValue = 100;
     }
 
+    std::vector<BenchInterval> intervals;
+    double nextInterval = start + _reportInterval;
+    size_t intervalOperations = 0;
+
     while (true) {
       size_t const numOperations = operationsCounter.getDone();
 
+      if (_reportInterval > 0.0 &&
+          (TRI_microtime() >= nextInterval || numOperations >= (size_t)_operations)) {
+        BenchmarkHistogram latencies;
+        for (auto* thread : threads) {
+          latencies.merge(thread->takeIntervalLatencies());
+        }
+        intervals.push_back({TRI_microtime() - start, numOperations - intervalOperations,
+                             latencies.percentile(0.5), latencies.percentile(0.99),
+                             latencies.percentile(0.999), latencies.max()});
+        intervalOperations = numOperations;
+        nextInterval += _reportInterval;
+
+        BenchInterval const& last = intervals.back();
+        std::ostringstream line;
+        line << std::fixed << std::setprecision(6) << "interval " << last.elapsed
+             << " s: " << last.operations << " operation(s), p50: " << last.p50
+             << " s, p99: " << last.p99 << " s, p99.9: " << last.p999
+             << " s, max: " << last.max << " s";
+        status(line.str());
+      }
+
       if (numOperations >= (size_t)_operations) {
         break;
       }
@@ -283,6 +381,10 @@ void BenchFeature::start() {
         operationsCounter.incompleteFailures(),
         requestTime,
     });
+    for (auto* thread : threads) {
+      results.back().latencies.merge(thread->getLatencies());
+    }
+    results.back().intervals = std::move(intervals);
     for (size_t i = 0; i < static_cast<size_t>(_concurreny); ++i) {
       delete threads[i];
     }
@@ -290,20 +392,22 @@ void BenchFeature::start() {
   }
   std::cout << std::endl;
 
-  report(client, results);
+  // a regression compared to the baseline fails the run as well
+  bool const reported = report(client, results, benchmark.get());
   if (!ok) {
     std::cout << "At least one of the runs produced failures!" << std::endl;
   }
   benchmark->tearDown();
 
-  if (!ok) {
+  if (!ok || !reported) {
     ret = EXIT_FAILURE;
   }
 
   *_result = ret;
 }
 
-bool BenchFeature::report(ClientFeature* client, std::vector<BenchRunResult> results) {
+bool BenchFeature::report(ClientFeature* client, std::vector<BenchRunResult> results,
+                          BenchmarkOperation* operation) {
   std::cout << std::endl;
 
   std::cout << "Total number of operations: " << _operations << ", runs: " << _runs
@@ -319,7 +423,9 @@ bool BenchFeature::report(ClientFeature* client, std::vector<BenchRunResult> res
             << _collection << "'" << std::endl;
 
   std::sort(results.begin(), results.end(),
-            [](BenchRunResult a, BenchRunResult b) { return a.time < b.time; });
+            [](BenchRunResult const& a, BenchRunResult const& b) {
+              return a.time < b.time;
+            });
 
   BenchRunResult output{0, 0, 0, 0};
   if (_runs > 1) {
@@ -341,6 +447,8 @@ bool BenchFeature::report(ClientFeature* client, std::vector<BenchRunResult> res
                     (results[mid - 1].failures + results[mid].failures) / 2,
                     (results[mid - 1].incomplete + results[mid].incomplete) / 2,
                     (results[mid - 1].requestTime + results[mid].requestTime) / 2);
+      output.latencies = results[mid - 1].latencies;
+      output.latencies.merge(results[mid].latencies);
     } else {
       output = results[mid];
     }
@@ -348,11 +456,190 @@ bool BenchFeature::report(ClientFeature* client, std::vector<BenchRunResult> res
     output = results[0];
   }
   printResult(output);
+  operation->printStatistics();
+
+  bool ok = true;
+  if (!_jsonReportFile.empty() || !_baselineFile.empty()) {
+    VPackBuilder builder;
+    buildJsonReport(builder, results, output, operation);
+    if (!_jsonReportFile.empty()) {
+      ok = writeJsonReport(builder.slice());
+    }
+    if (!_baselineFile.empty()) {
+      ok = compareWithBaseline(builder.slice()) && ok;
+    }
+  }
   if (_junitReportFile.empty()) {
-    return true;
+    return ok;
   }
 
-  return writeJunitReport(output);
+  return writeJunitReport(output) && ok;
+}
+
+namespace {
+void addLatencies(VPackBuilder& builder, arangobench::BenchmarkHistogram const& latencies) {
+  builder.add("latency", VPackValue(VPackValueType::Object));
+  builder.add("count", VPackValue(latencies.count()));
+  builder.add("mean", VPackValue(latencies.mean()));
+  builder.add("p50", VPackValue(latencies.percentile(0.5)));
+  builder.add("p90", VPackValue(latencies.percentile(0.9)));
+  builder.add("p99", VPackValue(latencies.percentile(0.99)));
+  builder.add("p999", VPackValue(latencies.percentile(0.999)));
+  builder.add("max", VPackValue(latencies.max()));
+  builder.close();
+}
+
+void addRun(VPackBuilder& builder, BenchRunResult const& result, uint64_t operations) {
+  builder.openObject();
+  builder.add("time", VPackValue(result.time));
+  builder.add("operationsPerSecond", VPackValue(static_cast<double>(operations) / result.time));
+  builder.add("requestTime", VPackValue(result.requestTime));
+  builder.add("failures", VPackValue(result.failures));
+  builder.add("incomplete", VPackValue(result.incomplete));
+  addLatencies(builder, result.latencies);
+  builder.add("intervals", VPackValue(VPackValueType::Array));
+  for (auto const& it : result.intervals) {
+    builder.openObject();
+    builder.add("elapsed", VPackValue(it.elapsed));
+    builder.add("operations", VPackValue(it.operations));
+    builder.add("p50", VPackValue(it.p50));
+    builder.add("p99", VPackValue(it.p99));
+    builder.add("p999", VPackValue(it.p999));
+    builder.add("max", VPackValue(it.max));
+    builder.close();
+  }
+  builder.close();
+  builder.close();
+}
+}  // namespace
+
+void BenchFeature::buildJsonReport(VPackBuilder& builder,
+                                   std::vector<BenchRunResult> const& results,
+                                   BenchRunResult const& result,
+                                   BenchmarkOperation* operation) {
+  // all times are in seconds
+  builder.openObject();
+  builder.add("testCase", VPackValue(_testCase));
+  builder.add("complexity", VPackValue(_complexity));
+  builder.add("concurrency", VPackValue(_concurreny));
+  builder.add("requests", VPackValue(_operations));
+  builder.add("batchSize", VPackValue(_batchSize));
+  builder.add("keepAlive", VPackValue(_keepAlive));
+  builder.add("async", VPackValue(_async));
+  builder.add("rate", VPackValue(_rate));
+  builder.add("runs", VPackValue(VPackValueType::Array));
+  for (auto const& it : results) {
+    addRun(builder, it, _operations);
+  }
+  builder.close();
+  builder.add(VPackValue("result"));
+  addRun(builder, result, _operations);
+  // statistics of the test case itself, over all runs
+  operation->statisticsToVelocyPack(builder);
+  builder.close();
+}
+
+bool BenchFeature::writeJsonReport(VPackSlice report) {
+  try {
+    FileUtils::spit(_jsonReportFile, report.toJson());
+  } catch (std::exception const& ex) {
+    std::cerr << "Could not write JSON report file " << _jsonReportFile << ": "
+              << ex.what() << std::endl;
+    return false;
+  }
+  return true;
+}
+
+namespace {
+/// @brief one compared value. for throughput higher values are better,
+/// for latencies lower ones
+struct BaselineMetric {
+  std::string name;
+  VPackSlice baseline;
+  VPackSlice current;
+  bool higherIsBetter;
+};
+}  // namespace
+
+bool BenchFeature::compareWithBaseline(VPackSlice report) {
+  std::shared_ptr<VPackBuilder> parsed;
+  try {
+    parsed = VPackParser::fromJson(FileUtils::slurp(_baselineFile));
+  } catch (std::exception const& ex) {
+    std::cerr << "Could not read baseline file " << _baselineFile << ": "
+              << ex.what() << std::endl;
+    return false;
+  }
+  VPackSlice baseline = parsed->slice();
+  if (!baseline.isObject() || !baseline.get("result").isObject()) {
+    std::cerr << "Baseline file " << _baselineFile
+              << " is not a JSON report of arangobench" << std::endl;
+    return false;
+  }
+
+  // numbers taken with different parameters are not comparable
+  for (char const* key : {"testCase", "complexity", "concurrency", "requests",
+                          "batchSize", "rate"}) {
+    if (VelocyPackHelper::compare(baseline.get(key), report.get(key), false) != 0) {
+      std::cout << "Warning: the baseline was taken with " << key << " "
+                << baseline.get(key).toJson() << ", this run uses "
+                << report.get(key).toJson() << std::endl;
+    }
+  }
+
+  std::vector<BaselineMetric> metrics;
+  VPackSlice const baseResult = baseline.get("result");
+  VPackSlice const result = report.get("result");
+  metrics.push_back({"operations per second", baseResult.get("operationsPerSecond"),
+                     result.get("operationsPerSecond"), true});
+  for (char const* p : {"p50", "p99"}) {
+    metrics.push_back({std::string("latency ") + p,
+                       baseResult.get(std::vector<std::string>{"latency", p}),
+                       result.get(std::vector<std::string>{"latency", p}), false});
+  }
+  // the operations of a workload, which are in both reports
+  VPackSlice const baseOperations = baseline.get("operations");
+  VPackSlice const operations = report.get("operations");
+  if (baseOperations.isObject() && operations.isObject()) {
+    for (auto const& it : VPackObjectIterator(operations)) {
+      VPackSlice const baseOperation = baseOperations.get(it.key.copyString());
+      if (!baseOperation.isObject()) {
+        continue;
+      }
+      for (char const* p : {"p50", "p99"}) {
+        metrics.push_back({it.key.copyString() + " latency " + p,
+                           baseOperation.get(p), it.value.get(p), false});
+      }
+    }
+  }
+
+  std::cout << "Comparison with baseline " << _baselineFile
+            << " (maximum regression " << _maxRegression << "%)" << std::endl;
+  bool ok = true;
+  for (auto const& metric : metrics) {
+    if (!metric.baseline.isNumber() || !metric.current.isNumber()) {
+      continue;
+    }
+    double const base = metric.baseline.getNumber<double>();
+    double const current = metric.current.getNumber<double>();
+    if (base <= 0.0) {
+      continue;
+    }
+    double const change = (current - base) / base * 100.0;
+    bool const regressed = metric.higherIsBetter ? -change > _maxRegression
+                                                 : change > _maxRegression;
+    std::cout << "  " << metric.name << ": baseline " << std::fixed << base
+              << ", current " << current << ", change " << std::showpos
+              << std::setprecision(1) << change << std::noshowpos
+              << std::setprecision(6) << "%" << (regressed ? "  REGRESSION" : "")
+              << std::endl;
+    ok = ok && !regressed;
+  }
+  std::cout << std::endl;
+  if (!ok) {
+    std::cout << "Performance regressed compared to the baseline!" << std::endl;
+  }
+  return ok;
 }
 
 bool BenchFeature::writeJunitReport(BenchRunResult const& result) {
@@ -415,7 +702,14 @@ void BenchFeature::printResult(BenchRunResult const& result) {
             << ((double)_operations / result.time) << std::endl;
 
   std::cout << "Elapsed time since start: " << std::fixed << result.time << " s"
-            << std::endl
+            << std::endl;
+
+  arangobench::BenchmarkHistogram const& latencies = result.latencies;
+  std::cout << "Latency" << (_rate > 0 ? " (from scheduled start)" : "")
+            << ": mean " << std::fixed << latencies.mean() << " s, p50 "
+            << latencies.percentile(0.5) << " s, p99 " << latencies.percentile(0.99)
+            << " s, p99.9 " << latencies.percentile(0.999) << " s, max "
+            << latencies.max() << " s" << std::endl
             << std::endl;
 
   if (result.failures > 0) {
@@ -24,16 +24,37 @@
 #define ARANGODB_BENCHMARK_BENCH_FEATURE_H 1
 
 #include "ApplicationFeatures/ApplicationFeature.h"
+#include "Benchmark/BenchmarkHistogram.h"
 
 namespace arangodb {
 
 class ClientFeature;
 
+namespace velocypack {
+class Builder;
+class Slice;
+}  // namespace velocypack
+
+namespace arangobench {
+struct BenchmarkOperation;
+}
+
+struct BenchInterval {
+  double elapsed;
+  uint64_t operations;
+  double p50;
+  double p99;
+  double p999;
+  double max;
+};
+
 struct BenchRunResult {
   double time;
   size_t failures;
   size_t incomplete;
   double requestTime;
+  arangobench::BenchmarkHistogram latencies;
+  std::vector<BenchInterval> intervals;
 
   void update(double _time, size_t _failures, size_t _incomplete, double _requestTime) {
     time = _time;
@@ -68,12 +89,19 @@ class BenchFeature final : public application_features::ApplicationFeature {
   uint64_t replicationFactor() const { return _replicationFactor; }
   uint64_t numberOfShards() const { return _numberOfShards; }
   bool waitForSync() const { return _waitForSync; }
+  uint64_t rate() const { return _rate; }
+  std::string const& workloadFile() const { return _workloadFile; }
+  std::string const& baselineFile() const { return _baselineFile; }
 
  private:
   void status(std::string const& value);
-  bool report(ClientFeature*, std::vector<BenchRunResult>);
+  bool report(ClientFeature*, std::vector<BenchRunResult>, arangobench::BenchmarkOperation*);
   void printResult(BenchRunResult const& result);
   bool writeJunitReport(BenchRunResult const& result);
+  void buildJsonReport(velocypack::Builder& builder, std::vector<BenchRunResult> const& results,
+                       BenchRunResult const& result, arangobench::BenchmarkOperation*);
+  bool writeJsonReport(velocypack::Slice report);
+  bool compareWithBaseline(velocypack::Slice report);
 
   bool _async;
   uint64_t _concurreny;
@@ -92,6 +120,12 @@ class BenchFeature final : public application_features::ApplicationFeature {
   uint64_t _replicationFactor;
   uint64_t _numberOfShards;
   bool _waitForSync;
+  uint64_t _rate;
+  double _reportInterval;
+  std::string _jsonReportFile;
+  std::string _workloadFile;
+  std::string _baselineFile;
+  double _maxRegression;
 
   int* _result;
 
@@ -0,0 +1,154 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_BENCHMARK_BENCHMARK_HISTOGRAM_H
+#define ARANGODB_BENCHMARK_BENCHMARK_HISTOGRAM_H 1
+
+#include "Basics/Common.h"
+
+namespace arangodb {
+namespace arangobench {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief latency histogram with logarithmic buckets, in the spirit of
+/// HdrHistogram. values below 128 microseconds are counted exactly, larger
+/// ones in 64 buckets per power of two, so every recorded value is off by
+/// less than 1/64 (about 1.6%)
+////////////////////////////////////////////////////////////////////////////////
+
+class BenchmarkHistogram {
+ private:
+  static constexpr unsigned SubBucketBits = 6;
+  static constexpr uint64_t SubBuckets = uint64_t(1) << SubBucketBits;
+  static constexpr uint64_t Linear = SubBuckets * 2;
+  static constexpr size_t NumBuckets = Linear + (63 - SubBucketBits) * SubBuckets;
+
+ public:
+  BenchmarkHistogram()
+      : _buckets(static_cast<size_t>(NumBuckets), 0), _count(0), _sum(0), _max(0) {}
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief records a latency in seconds
+  //////////////////////////////////////////////////////////////////////////////
+
+  void record(double seconds) {
+    uint64_t micros = seconds <= 0.0 ? 0 : static_cast<uint64_t>(seconds * 1000000.0);
+    ++_buckets[index(micros)];
+    ++_count;
+    _sum += micros;
+    _max = (std::max)(_max, micros);
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief adds the values of another histogram
+  //////////////////////////////////////////////////////////////////////////////
+
+  void merge(BenchmarkHistogram const& other) {
+    for (size_t i = 0; i < NumBuckets; ++i) {
+      _buckets[i] += other._buckets[i];
+    }
+    _count += other._count;
+    _sum += other._sum;
+    _max = (std::max)(_max, other._max);
+  }
+
+  void clear() {
+    std::fill(_buckets.begin(), _buckets.end(), 0);
+    _count = 0;
+    _sum = 0;
+    _max = 0;
+  }
+
+  uint64_t count() const { return _count; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief average latency in seconds
+  //////////////////////////////////////////////////////////////////////////////
+
+  double mean() const {
+    return _count == 0 ? 0.0 : static_cast<double>(_sum) / _count / 1000000.0;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief maximum latency in seconds, this one is exact
+  //////////////////////////////////////////////////////////////////////////////
+
+  double max() const { return static_cast<double>(_max) / 1000000.0; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief latency in seconds that the given fraction (0.0 - 1.0) of all
+  /// values does not exceed
+  //////////////////////////////////////////////////////////////////////////////
+
+  double percentile(double fraction) const {
+    if (_count == 0) {
+      return 0.0;
+    }
+    uint64_t rank = static_cast<uint64_t>(std::ceil(fraction * _count));
+    rank = (std::max)(rank, uint64_t(1));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < NumBuckets; ++i) {
+      seen += _buckets[i];
+      if (seen >= rank) {
+        return static_cast<double>((std::min)(highest(i), _max)) / 1000000.0;
+      }
+    }
+    return max();
+  }
+
+ private:
+  static size_t index(uint64_t value) {
+    if (value < Linear) {
+      return static_cast<size_t>(value);
+    }
+    unsigned msb = 63;
+    while ((value & (uint64_t(1) << msb)) == 0) {
+      --msb;
+    }
+    // value >> shift is in [SubBuckets, 2 * SubBuckets)
+    unsigned shift = msb - SubBucketBits;
+    return static_cast<size_t>(Linear + (msb - SubBucketBits - 1) * SubBuckets +
+                               ((value >> shift) - SubBuckets));
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief highest value that falls into a bucket
+  //////////////////////////////////////////////////////////////////////////////
+
+  static uint64_t highest(size_t index) {
+    if (index < Linear) {
+      return index;
+    }
+    uint64_t offset = index - Linear;
+    unsigned shift = static_cast<unsigned>(offset / SubBuckets) + 1;
+    uint64_t sub = SubBuckets + offset % SubBuckets;
+    return ((sub + 1) << shift) - 1;
+  }
+
+  std::vector<uint64_t> _buckets;
+  uint64_t _count;
+  uint64_t _sum;
+  uint64_t _max;
+};
+
+}  // namespace arangobench
+}  // namespace arangodb
+
+#endif
@@ -27,6 +27,8 @@
 #include "Basics/Common.h"
 #include "SimpleHttpClient/SimpleHttpClient.h"
 
+#include <velocypack/Builder.h>
+
 namespace arangodb {
 namespace arangobench {
 
@@ -76,6 +78,25 @@ struct BenchmarkOperation {
   //////////////////////////////////////////////////////////////////////////////
 
   virtual char const* payload(size_t*, int const, size_t const, size_t const, bool*) = 0;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief called when a single (non-batch) request has finished, with its
+  /// latency in seconds, for operations that keep their own statistics
+  //////////////////////////////////////////////////////////////////////////////
+
+  virtual void done(int const, size_t const, size_t const, double, bool) {}
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief print the statistics kept by the operation, if any
+  //////////////////////////////////////////////////////////////////////////////
+
+  virtual void printStatistics() {}
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief add the statistics kept by the operation to an open object
+  //////////////////////////////////////////////////////////////////////////////
+
+  virtual void statisticsToVelocyPack(velocypack::Builder&) {}
 };
 }  // namespace arangobench
 }  // namespace arangodb
@@ -29,9 +29,12 @@
 #include "Basics/ConditionLocker.h"
 #include "Basics/ConditionVariable.h"
 #include "Basics/Exceptions.h"
+#include "Basics/Mutex.h"
+#include "Basics/MutexLocker.h"
 #include "Basics/Thread.h"
 #include "Basics/hashes.h"
 #include "Benchmark/BenchmarkCounter.h"
+#include "Benchmark/BenchmarkHistogram.h"
 #include "Benchmark/BenchmarkOperation.h"
 #include "Logger/Logger.h"
 #include "Rest/HttpResponse.h"
@@ -68,6 +71,8 @@ class BenchmarkThread : public arangodb::Thread {
         _offset(0),
         _counter(0),
         _time(0.0),
+        _rate(0.0),
+        _phase(0.0),
         _verbose(verbose) {
     _errorHeader = basics::StringUtils::tolower(StaticStrings::Errors);
   }
@@ -130,6 +135,9 @@ class BenchmarkThread : public arangodb::Thread {
       guard.wait();
     }
 
+    double const runStart = TRI_microtime();
+    uint64_t arrivals = 0;
+
     while (!isStopping()) {
       unsigned long numOps = _operationsCounter->next(_batchSize);
 
@@ -137,11 +145,25 @@ class BenchmarkThread : public arangodb::Thread {
         break;
       }
 
+      // in open-loop mode requests are due at a constant rate, no matter
+      // how long earlier ones took. latencies are measured from the time a
+      // request was due, so a stalling server cannot hide behind requests
+      // that were never sent (coordinated omission)
+      double due = 0.0;
+      if (_rate > 0.0) {
+        due = runStart + (static_cast<double>(arrivals++) + _phase) / _rate;
+        double const now = TRI_microtime();
+        if (due > now) {
+          std::this_thread::sleep_for(
+              std::chrono::microseconds(static_cast<uint64_t>((due - now) * 1000000.0)));
+        }
+      }
+
       if (_batchSize < 1) {
-        executeSingleRequest();
+        executeSingleRequest(due);
       } else {
         try {
-          executeBatchRequest(numOps);
+          executeBatchRequest(numOps, due);
         } catch (arangodb::basics::Exception const& ex) {
           LOG_TOPIC("bd1d1", FATAL, arangodb::Logger::FIXME)
               << "Caught exception during test execution: " << ex.code() << " "
@@ -187,11 +209,27 @@ class BenchmarkThread : public arangodb::Thread {
     return std::string("/_db/" + t->_databaseName + "/" + location);
   }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief accounts for a finished request that was due at the given time,
+  /// or started at the given time in closed-loop mode
+  //////////////////////////////////////////////////////////////////////////////
+
+  double recordLatency(double due, double start) {
+    double const end = TRI_microtime();
+    double const latency = end - (due > 0.0 ? due : start);
+    _time += end - start;
+
+    MUTEX_LOCKER(guard, _latencyLock);
+    _latencies.record(latency);
+    _intervalLatencies.record(latency);
+    return latency;
+  }
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief execute a batch request with numOperations parts
   //////////////////////////////////////////////////////////////////////////////
 
-  void executeBatchRequest(const unsigned long numOperations) {
+  void executeBatchRequest(const unsigned long numOperations, double due) {
     static char const boundary[] = "XXXarangobench-benchmarkXXX";
     size_t blen = strlen(boundary);
 
@@ -255,7 +293,7 @@ class BenchmarkThread : public arangodb::Thread {
     httpclient::SimpleHttpResult* result =
         _httpClient->request(rest::RequestType::POST, "/_api/batch",
                              batchPayload.c_str(), batchPayload.length(), _headers);
-    _time += TRI_microtime() - start;
+    recordLatency(due, start);
 
     if (result == nullptr || !result->isComplete()) {
       if (result != nullptr) {
@@ -322,7 +360,7 @@ class BenchmarkThread : public arangodb::Thread {
   /// @brief execute a single request
   //////////////////////////////////////////////////////////////////////////////
 
-  void executeSingleRequest() {
+  void executeSingleRequest(double due) {
     size_t const threadCounter = _counter++;
     size_t const globalCounter = _offset + threadCounter;
     rest::RequestType const type =
@@ -339,12 +377,15 @@ class BenchmarkThread : public arangodb::Thread {
     double start = TRI_microtime();
     httpclient::SimpleHttpResult* result =
         _httpClient->request(type, url, payload, payloadLength, _headers);
-    _time += TRI_microtime() - start;
+    double const latency = recordLatency(due, start);
 
     if (mustFree) {
       TRI_Free((void*)payload);
     }
 
+    _operation->done(_threadNumber, threadCounter, globalCounter, latency,
+                     result == nullptr || !result->isComplete() || result->wasHttpError());
+
     if (result == nullptr || !result->isComplete()) {
       _operationsCounter->incFailures(1);
       if (result != nullptr) {
@@ -388,6 +429,37 @@ class BenchmarkThread : public arangodb::Thread {
 
   double getTime() const { return _time; }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief switch to open-loop mode, with requests due at the given rate
+  /// per second. the phase (0.0 - 1.0) shifts the schedule by a fraction of
+  /// the interval, so the threads do not send in lockstep
+  //////////////////////////////////////////////////////////////////////////////
+
+  void setSchedule(double rate, double phase) {
+    _rate = rate;
+    _phase = phase;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief return the latencies of all requests of the thread
+  //////////////////////////////////////////////////////////////////////////////
+
+  BenchmarkHistogram getLatencies() {
+    MUTEX_LOCKER(guard, _latencyLock);
+    return _latencies;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief return the latencies since the last call and start over
+  //////////////////////////////////////////////////////////////////////////////
+
+  BenchmarkHistogram takeIntervalLatencies() {
+    MUTEX_LOCKER(guard, _latencyLock);
+    BenchmarkHistogram result = _intervalLatencies;
+    _intervalLatencies.clear();
+    return result;
+  }
+
  private:
   //////////////////////////////////////////////////////////////////////////////
   /// @brief the operation to benchmark
@@ -497,6 +569,36 @@ class BenchmarkThread : public arangodb::Thread {
 
   double _time;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief requests per second in open-loop mode, 0 for closed-loop mode
+  //////////////////////////////////////////////////////////////////////////////
+
+  double _rate;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief shift of the open-loop schedule, in intervals
+  //////////////////////////////////////////////////////////////////////////////
+
+  double _phase;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief protects the latency histograms, which are read while running
+  //////////////////////////////////////////////////////////////////////////////
+
+  Mutex _latencyLock;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief latencies of all requests
+  //////////////////////////////////////////////////////////////////////////////
+
+  BenchmarkHistogram _latencies;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief latencies of the requests since the last report interval
+  //////////////////////////////////////////////////////////////////////////////
+
+  BenchmarkHistogram _intervalLatencies;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief lower-case error header we look for
   //////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,427 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "BenchmarkWorkload.h"
+
+#include "Basics/Exceptions.h"
+#include "Basics/FileUtils.h"
+#include "Basics/MutexLocker.h"
+#include "Basics/StringUtils.h"
+#include "Basics/VelocyPackHelper.h"
+#include "Basics/fasthash.h"
+#include "Random/RandomGenerator.h"
+#include "SimpleHttpClient/SimpleHttpResult.h"
+
+#include <velocypack/Iterator.h>
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+using namespace arangodb;
+using namespace arangodb::arangobench;
+
+////////////////////////////////////////////////////////////////////////////////
+/// A workload file is a JSON object like this:
+///
+/// {
+///   "collections": [ { "name": "users" }, { "name": "knows", "type": "edge" } ],
+///   "views": [ { "name": "usersView", "links": { "users": { ... } } } ],
+///   "setup": [ "FOR i IN 0..9999 INSERT { _key: CONCAT('u', i) } INTO users" ],
+///   "operations": [
+///     { "name": "lookup", "weight": 80,
+///       "query": "RETURN DOCUMENT('users', @key)",
+///       "bindVars": { "key": { "distribution": "zipf", "min": 0,
+///                              "max": 9999, "prefix": "u" } } },
+///     { "name": "friends", "weight": 20,
+///       "query": "FOR v IN 1..2 OUTBOUND @start knows RETURN v._key",
+///       "bindVars": { "start": { "distribution": "uniform", "min": 0,
+///                                "max": 9999, "prefix": "users/u" } } }
+///   ]
+/// }
+///
+/// collections and views are dropped and created again before the setup
+/// queries run. bind parameters that are objects with a "distribution"
+/// ("uniform", "zipf" with an optional "exponent" between 0 and 1, or
+/// "sequential") draw from min..max, or pick one of "values". all other
+/// bind parameters are passed on as they are
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// @brief items for which the Zipf normalization constant is summed up,
+/// the rest of it is approximated by the integral
+constexpr uint64_t ZetaExactItems = 1000000;
+
+double zeta(uint64_t n, double theta) {
+  double sum = 0.0;
+  uint64_t const exact = std::min(n, ZetaExactItems);
+  for (uint64_t i = 1; i <= exact; ++i) {
+    sum += 1.0 / std::pow(static_cast<double>(i), theta);
+  }
+  if (n > exact) {
+    sum += (std::pow(static_cast<double>(n), 1.0 - theta) -
+            std::pow(static_cast<double>(exact), 1.0 - theta)) /
+           (1.0 - theta);
+  }
+  return sum;
+}
+
+/// @brief uniform random number in [0, 1)
+double uniform() {
+  uint64_t const bits = RandomGenerator::interval(UINT64_MAX) >> 11;
+  return static_cast<double>(bits) / static_cast<double>(uint64_t(1) << 53);
+}
+
+[[noreturn]] void invalid(std::string const& message) {
+  THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_BAD_PARAMETER,
+                                 "invalid workload file: " + message);
+}
+
+}  // namespace
+
+BenchmarkWorkload::Generator::Generator(VPackSlice definition)
+    : _distribution(Distribution::Constant),
+      _min(0),
+      _n(1),
+      _theta(0.0),
+      _zetan(0.0),
+      _alpha(0.0),
+      _eta(0.0) {
+  if (!definition.isObject() || !definition.hasKey("distribution")) {
+    _constant.add(definition);
+    return;
+  }
+
+  std::string const distribution =
+      basics::VelocyPackHelper::getStringValue(definition, "distribution", "");
+  if (distribution == "uniform") {
+    _distribution = Distribution::Uniform;
+  } else if (distribution == "zipf") {
+    _distribution = Distribution::Zipf;
+  } else if (distribution == "sequential") {
+    _distribution = Distribution::Sequential;
+  } else {
+    invalid("unknown distribution '" + distribution + "'");
+  }
+
+  VPackSlice values = definition.get("values");
+  if (values.isArray()) {
+    for (auto const& it : VPackArrayIterator(values)) {
+      _values.emplace_back();
+      _values.back().add(it);
+    }
+    if (_values.empty()) {
+      invalid("'values' must not be empty");
+    }
+    _n = _values.size();
+  } else {
+    _min = basics::VelocyPackHelper::getNumericValue<uint64_t>(definition, "min", 0);
+    uint64_t max = basics::VelocyPackHelper::getNumericValue<uint64_t>(definition, "max", 0);
+    if (max < _min) {
+      invalid("'max' must not be less than 'min'");
+    }
+    _n = max - _min + 1;
+    _prefix = basics::VelocyPackHelper::getStringValue(definition, "prefix", "");
+  }
+
+  if (_distribution == Distribution::Zipf) {
+    _theta = basics::VelocyPackHelper::getNumericValue<double>(definition, "exponent", 0.99);
+    if (_theta <= 0.0 || _theta >= 1.0) {
+      invalid("'exponent' must be between 0 and 1");
+    }
+    _zetan = ::zeta(_n, _theta);
+    _alpha = 1.0 / (1.0 - _theta);
+    if (_n > 2) {
+      double const zeta2 = 1.0 + std::pow(0.5, _theta);
+      _eta = (1.0 - std::pow(2.0 / static_cast<double>(_n), 1.0 - _theta)) /
+             (1.0 - zeta2 / _zetan);
+    }
+  }
+}
+
+uint64_t BenchmarkWorkload::Generator::next(size_t globalCounter) const {
+  switch (_distribution) {
+    case Distribution::Constant:
+      return 0;
+    case Distribution::Uniform:
+      return RandomGenerator::interval(_n - 1);
+    case Distribution::Sequential:
+      return globalCounter % _n;
+    case Distribution::Zipf: {
+      // Gray et al., "Quickly generating billion-record synthetic databases"
+      double const u = ::uniform();
+      double const uz = u * _zetan;
+      if (uz < 1.0 || _n == 1) {
+        return 0;
+      }
+      if (uz < 1.0 + std::pow(0.5, _theta) || _n == 2) {
+        return 1;
+      }
+      auto value = static_cast<uint64_t>(static_cast<double>(_n) *
+                                         std::pow(_eta * u - _eta + 1.0, _alpha));
+      return std::min(value, _n - 1);
+    }
+  }
+  return 0;
+}
+
+void BenchmarkWorkload::Generator::generate(VPackBuilder& builder, size_t globalCounter) const {
+  if (_distribution == Distribution::Constant) {
+    builder.add(_constant.slice());
+    return;
+  }
+  uint64_t const position = next(globalCounter);
+  if (!_values.empty()) {
+    builder.add(_values[position].slice());
+  } else if (!_prefix.empty()) {
+    builder.add(VPackValue(_prefix + std::to_string(_min + position)));
+  } else {
+    builder.add(VPackValue(_min + position));
+  }
+}
+
+BenchmarkWorkload::BenchmarkWorkload(std::string const& filename)
+    : BenchmarkOperation(), _totalWeight(0) {
+  std::shared_ptr<VPackBuilder> parsed;
+  try {
+    parsed = VPackParser::fromJson(basics::FileUtils::slurp(filename));
+  } catch (basics::Exception const&) {
+    throw;
+  } catch (std::exception const& ex) {
+    invalid(ex.what());
+  }
+  VPackSlice workload = parsed->slice();
+  if (!workload.isObject()) {
+    invalid("expecting an object");
+  }
+
+  VPackSlice collections = workload.get("collections");
+  if (collections.isArray()) {
+    _collections.add(collections);
+  }
+  VPackSlice views = workload.get("views");
+  if (views.isArray()) {
+    _views.add(views);
+  }
+  VPackSlice setup = workload.get("setup");
+  if (setup.isArray()) {
+    for (auto const& it : VPackArrayIterator(setup)) {
+      if (!it.isString()) {
+        invalid("setup queries must be strings");
+      }
+      _setupQueries.push_back(it.copyString());
+    }
+  }
+
+  VPackSlice operations = workload.get("operations");
+  if (!operations.isArray() || operations.length() == 0) {
+    invalid("expecting at least one operation");
+  }
+  for (auto const& it : VPackArrayIterator(operations)) {
+    auto op = std::make_unique<Operation>();
+    op->query = basics::VelocyPackHelper::getStringValue(it, "query", "");
+    if (op->query.empty()) {
+      invalid("operations need a query");
+    }
+    op->name = basics::VelocyPackHelper::getStringValue(
+        it, "name", "operation " + std::to_string(_operations.size() + 1));
+    op->weight = basics::VelocyPackHelper::getNumericValue<uint64_t>(it, "weight", 1);
+    VPackSlice bindVars = it.get("bindVars");
+    if (bindVars.isObject()) {
+      for (auto const& bv : VPackObjectIterator(bindVars)) {
+        op->bindVars.emplace_back(bv.key.copyString(), Generator(bv.value));
+      }
+    }
+    _totalWeight += op->weight;
+    _operations.push_back(std::move(op));
+  }
+  if (_totalWeight == 0) {
+    invalid("the weights of the operations must not all be 0");
+  }
+}
+
+bool BenchmarkWorkload::execute(httpclient::SimpleHttpClient* client, rest::RequestType type,
+                                std::string const& url, std::string const& body) {
+  std::unique_ptr<httpclient::SimpleHttpResult> result(
+      client->request(type, url, body.c_str(), body.size(), {}));
+  if (result == nullptr || !result->isComplete()) {
+    std::cerr << "request to " << url << " failed: " << client->getErrorMessage() << std::endl;
+    return false;
+  }
+  if (result->wasHttpError() && !(type == rest::RequestType::DELETE_REQ &&
+                                  result->getHttpReturnCode() == 404)) {
+    std::cerr << "request to " << url << " failed with HTTP code "
+              << result->getHttpReturnCode() << ": " << result->getBody().c_str() << std::endl;
+    return false;
+  }
+  return true;
+}
+
+bool BenchmarkWorkload::setUp(httpclient::SimpleHttpClient* client) {
+  using basics::StringUtils::urlEncode;
+
+  if (!_collections.isEmpty()) {
+    for (auto const& it : VPackArrayIterator(_collections.slice())) {
+      std::string const name = basics::VelocyPackHelper::getStringValue(it, "name", "");
+      if (!execute(client, rest::RequestType::DELETE_REQ,
+                   "/_api/collection/" + urlEncode(name), "")) {
+        return false;
+      }
+      VPackBuilder body;
+      body.openObject();
+      for (auto const& attr : VPackObjectIterator(it)) {
+        if (attr.key.isEqualString("type")) {
+          bool const edge = attr.value.isString() && attr.value.isEqualString("edge");
+          body.add("type", VPackValue(edge ? 3 : 2));
+        } else {
+          body.add(attr.key.copyString(), attr.value);
+        }
+      }
+      body.close();
+      if (!execute(client, rest::RequestType::POST, "/_api/collection",
+                   body.slice().toJson())) {
+        return false;
+      }
+    }
+  }
+
+  if (!_views.isEmpty()) {
+    for (auto const& it : VPackArrayIterator(_views.slice())) {
+      std::string const name = basics::VelocyPackHelper::getStringValue(it, "name", "");
+      if (!execute(client, rest::RequestType::DELETE_REQ, "/_api/view/" + urlEncode(name), "")) {
+        return false;
+      }
+      VPackBuilder body;
+      body.openObject();
+      if (!it.hasKey("type")) {
+        body.add("type", VPackValue("arangosearch"));
+      }
+      for (auto const& attr : VPackObjectIterator(it)) {
+        body.add(attr.key.copyString(), attr.value);
+      }
+      body.close();
+      if (!execute(client, rest::RequestType::POST, "/_api/view", body.slice().toJson())) {
+        return false;
+      }
+    }
+  }
+
+  for (auto const& query : _setupQueries) {
+    VPackBuilder body;
+    body.openObject();
+    body.add("query", VPackValue(query));
+    body.close();
+    if (!execute(client, rest::RequestType::POST, "/_api/cursor", body.slice().toJson())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+BenchmarkWorkload::Operation& BenchmarkWorkload::pick(int const threadNumber,
+                                                      size_t const threadCounter) {
+  uint64_t r = fasthash64_uint64(threadCounter, static_cast<uint64_t>(threadNumber)) % _totalWeight;
+  for (auto& op : _operations) {
+    if (r < op->weight) {
+      return *op;
+    }
+    r -= op->weight;
+  }
+  return *_operations.back();
+}
+
+std::string BenchmarkWorkload::url(int const, size_t const, size_t const) {
+  return "/_api/cursor";
+}
+
+rest::RequestType BenchmarkWorkload::type(int const, size_t const, size_t const) {
+  return rest::RequestType::POST;
+}
+
+char const* BenchmarkWorkload::payload(size_t* length, int const threadNumber,
+                                       size_t const threadCounter,
+                                       size_t const globalCounter, bool* mustFree) {
+  Operation& op = pick(threadNumber, threadCounter);
+
+  VPackBuilder body;
+  body.openObject();
+  body.add("query", VPackValue(op.query));
+  body.add("bindVars", VPackValue(VPackValueType::Object));
+  for (auto const& it : op.bindVars) {
+    body.add(VPackValue(it.first));
+    it.second.generate(body, globalCounter);
+  }
+  body.close();
+  body.close();
+
+  std::string const json = body.slice().toJson();
+  char* ptr = static_cast<char*>(TRI_Allocate(json.size() + 1));
+  if (ptr == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+  memcpy(ptr, json.c_str(), json.size() + 1);
+  *length = json.size();
+  *mustFree = true;
+  return ptr;
+}
+
+void BenchmarkWorkload::done(int const threadNumber, size_t const threadCounter,
+                             size_t const, double latency, bool failed) {
+  Operation& op = pick(threadNumber, threadCounter);
+  MUTEX_LOCKER(guard, op.lock);
+  op.latencies.record(latency);
+  if (failed) {
+    ++op.failures;
+  }
+}
+
+void BenchmarkWorkload::printStatistics() {
+  for (auto& op : _operations) {
+    MUTEX_LOCKER(guard, op->lock);
+    std::cout << "Operation '" << op->name << "': " << op->latencies.count()
+              << " request(s), " << op->failures << " failure(s), mean " << std::fixed
+              << op->latencies.mean() << " s, p50 " << op->latencies.percentile(0.5)
+              << " s, p99 " << op->latencies.percentile(0.99) << " s, p99.9 "
+              << op->latencies.percentile(0.999) << " s, max " << op->latencies.max()
+              << " s" << std::endl;
+  }
+  std::cout << std::endl;
+}
+
+void BenchmarkWorkload::statisticsToVelocyPack(VPackBuilder& builder) {
+  builder.add("operations", VPackValue(VPackValueType::Object));
+  for (auto& op : _operations) {
+    MUTEX_LOCKER(guard, op->lock);
+    builder.add(op->name, VPackValue(VPackValueType::Object));
+    builder.add("weight", VPackValue(op->weight));
+    builder.add("requests", VPackValue(op->latencies.count()));
+    builder.add("failures", VPackValue(op->failures));
+    builder.add("mean", VPackValue(op->latencies.mean()));
+    builder.add("p50", VPackValue(op->latencies.percentile(0.5)));
+    builder.add("p99", VPackValue(op->latencies.percentile(0.99)));
+    builder.add("p999", VPackValue(op->latencies.percentile(0.999)));
+    builder.add("max", VPackValue(op->latencies.max()));
+    builder.close();
+  }
+  builder.close();
+}
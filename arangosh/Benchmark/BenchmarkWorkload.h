@@ -0,0 +1,138 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_BENCHMARK_BENCHMARK_WORKLOAD_H
+#define ARANGODB_BENCHMARK_BENCHMARK_WORKLOAD_H 1
+
+#include "Basics/Common.h"
+#include "Basics/Mutex.h"
+#include "Benchmark/BenchmarkHistogram.h"
+#include "Benchmark/BenchmarkOperation.h"
+
+#include <velocypack/Builder.h>
+
+namespace arangodb {
+namespace arangobench {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief a benchmark defined by a JSON workload file: a weighted mix of
+/// parameterized AQL queries (lookups, writes, traversals, view searches)
+/// with generated bind values. statistics are kept per operation
+////////////////////////////////////////////////////////////////////////////////
+
+class BenchmarkWorkload final : public BenchmarkOperation {
+ public:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief generates the values of one bind parameter
+  //////////////////////////////////////////////////////////////////////////////
+
+  class Generator {
+   public:
+    enum class Distribution { Constant, Uniform, Zipf, Sequential };
+
+    //////////////////////////////////////////////////////////////////////////////
+    /// @brief parses a bind parameter definition. objects with a
+    /// "distribution" attribute generate values, everything else is passed
+    /// on as it is. throws on invalid definitions
+    //////////////////////////////////////////////////////////////////////////////
+
+    explicit Generator(velocypack::Slice definition);
+
+    //////////////////////////////////////////////////////////////////////////////
+    /// @brief adds the next value to the builder
+    //////////////////////////////////////////////////////////////////////////////
+
+    void generate(velocypack::Builder& builder, size_t globalCounter) const;
+
+    //////////////////////////////////////////////////////////////////////////////
+    /// @brief the next position in [0, n) drawn from the distribution
+    //////////////////////////////////////////////////////////////////////////////
+
+    uint64_t next(size_t globalCounter) const;
+
+   private:
+    Distribution _distribution;
+    velocypack::Builder _constant;
+    uint64_t _min;
+    uint64_t _n;
+    std::string _prefix;
+    std::vector<velocypack::Builder> _values;
+    // parameters of the Zipf distribution, after Gray et al.
+    double _theta;
+    double _zetan;
+    double _alpha;
+    double _eta;
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief one weighted operation of the mix
+  //////////////////////////////////////////////////////////////////////////////
+
+  struct Operation {
+    std::string name;
+    std::string query;
+    uint64_t weight;
+    std::vector<std::pair<std::string, Generator>> bindVars;
+
+    Mutex lock;
+    BenchmarkHistogram latencies;
+    uint64_t failures = 0;
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief loads the workload file, throws on errors
+  //////////////////////////////////////////////////////////////////////////////
+
+  explicit BenchmarkWorkload(std::string const& filename);
+
+  bool setUp(arangodb::httpclient::SimpleHttpClient*) override;
+  void tearDown() override {}
+
+  std::string url(int const, size_t const, size_t const) override;
+  arangodb::rest::RequestType type(int const, size_t const, size_t const) override;
+  char const* payload(size_t*, int const, size_t const, size_t const, bool*) override;
+
+  void done(int const, size_t const, size_t const, double, bool) override;
+  void printStatistics() override;
+  void statisticsToVelocyPack(velocypack::Builder&) override;
+
+ private:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the operation a request executes. all calls for the same
+  /// request must agree, so this is a function of the counters
+  //////////////////////////////////////////////////////////////////////////////
+
+  Operation& pick(int const threadNumber, size_t const threadCounter);
+
+  bool execute(arangodb::httpclient::SimpleHttpClient*, arangodb::rest::RequestType,
+               std::string const& url, std::string const& body);
+
+ private:
+  std::vector<std::unique_ptr<Operation>> _operations;
+  uint64_t _totalWeight;
+  velocypack::Builder _collections;
+  velocypack::Builder _views;
+  std::vector<std::string> _setupQueries;
+};
+
+}  // namespace arangobench
+}  // namespace arangodb
+
+#endif
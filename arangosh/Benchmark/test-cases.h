@@ -1691,6 +1691,9 @@ static BenchmarkOperation* GetTestCase(std::string const& name) {
   if (name == "stream-cursor") {
     return new StreamCursorTest();
   }
+  if (name == "workload") {
+    return new BenchmarkWorkload(ARANGOBENCH->workloadFile());
+  }
 
   return nullptr;
 }
@@ -24,6 +24,7 @@
 #include "DumpFeature.h"
 
 #include <chrono>
+#include <future>
 #include <thread>
 
 #include <velocypack/Builder.h>
@@ -31,6 +32,7 @@
 #include <velocypack/Iterator.h>
 #include <velocypack/velocypack-aliases.h>
 #include <boost/algorithm/clamp.hpp>
+#include <lz4frame.h>
 
 #include "ApplicationFeatures/ApplicationServer.h"
 #include "Basics/FileUtils.h"
@@ -69,6 +71,9 @@ constexpr uint64_t MinChunkSize = 1024 * 128;
 // NB: larger value may cause tcp issues (check exact limits)
 constexpr uint64_t MaxChunkSize = 1024 * 1024 * 96;
 
+/// @brief dump format storing the VelocyPack of the server in LZ4 frames
+constexpr auto VPackFormat = "vpack";
+
 /// @brief generic error for if server returns bad/unexpected json
 const arangodb::Result ErrorMalformedJsonResponse = {
     TRI_ERROR_INTERNAL, "got malformed JSON response from server"};
@@ -162,9 +167,12 @@ std::pair<arangodb::Result, std::vector<std::string>> getDatabases(arangodb::htt
   return {{TRI_ERROR_NO_ERROR}, databases};
 }
 
-/// @brief start a batch via the replication API
+/// @brief start a batch via the replication API. maxDumpRanges is set to
+/// the number of key ranges dumps of the batch can be split into, 1 if the
+/// server cannot split them
 std::pair<arangodb::Result, uint64_t> startBatch(arangodb::httpclient::SimpleHttpClient& client,
-                                                 std::string const& DBserver) {
+                                                 std::string const& DBserver,
+                                                 uint64_t* maxDumpRanges = nullptr) {
   using arangodb::basics::VelocyPackHelper;
   using arangodb::basics::StringUtils::uint64;
 
@@ -196,6 +204,11 @@ std::pair<arangodb::Result, uint64_t> startBatch(arangodb::httpclient::SimpleHtt
   // look up "id" value
   std::string const id = VelocyPackHelper::getStringValue(resBody, "id", "");
 
+  if (maxDumpRanges != nullptr) {
+    *maxDumpRanges = std::max<uint64_t>(
+        1, VelocyPackHelper::getNumericValue<uint64_t>(resBody, "dumpRanges", 1));
+  }
+
   return {{TRI_ERROR_NO_ERROR}, uint64(id)};
 }
 
@@ -295,6 +308,47 @@ arangodb::Result dumpJsonObjects(arangodb::DumpFeature::JobData& jobData,
   return {TRI_ERROR_NO_ERROR};
 }
 
+/// @brief name suffix of the data files of the chosen format
+std::string dataFileSuffix(arangodb::DumpFeature::Options const& options) {
+  return options.outputFormat == ::VPackFormat ? ".data.vpack.lz4" : ".data.json";
+}
+
+/// @brief appends the VelocyPack markers of one batch as an LZ4 frame.
+/// concatenated frames make a valid LZ4 stream, so every batch can be
+/// compressed on its own
+arangodb::Result dumpVPackObjects(arangodb::DumpFeature::JobData& jobData,
+                                  arangodb::ManagedDirectory::File& file,
+                                  arangodb::basics::StringBuffer const& body) {
+  if (body.length() == 0) {
+    return {TRI_ERROR_NO_ERROR};
+  }
+
+  LZ4F_preferences_t preferences;
+  memset(&preferences, 0, sizeof(preferences));
+  preferences.frameInfo.contentChecksumFlag = LZ4F_contentChecksumEnabled;
+  preferences.frameInfo.contentSize = body.length();
+
+  std::string compressed;
+  compressed.resize(LZ4F_compressFrameBound(body.length(), &preferences));
+  size_t const length = LZ4F_compressFrame(&compressed[0], compressed.size(),
+                                           body.c_str(), body.length(), &preferences);
+  if (LZ4F_isError(length)) {
+    return {TRI_ERROR_INTERNAL,
+            std::string("cannot compress dump data: ") + LZ4F_getErrorName(length)};
+  }
+
+  file.write(compressed.data(), length);
+
+  if (file.status().fail()) {
+    return {TRI_ERROR_CANNOT_WRITE_FILE, std::string("cannot write file '") + file.path() +
+                                             "': " + file.status().errorMessage()};
+  }
+
+  jobData.stats.totalWritten += static_cast<uint64_t>(length);
+
+  return {TRI_ERROR_NO_ERROR};
+}
+
 /// @brief dump the actual data from an individual collection
 arangodb::Result dumpCollection(arangodb::httpclient::SimpleHttpClient& client,
                                 arangodb::DumpFeature::JobData& jobData,
@@ -306,6 +360,12 @@ arangodb::Result dumpCollection(arangodb::httpclient::SimpleHttpClient& client,
   using arangodb::basics::StringUtils::uint64;
   using arangodb::basics::StringUtils::urlEncode;
 
+  bool const vpack = jobData.options.outputFormat == ::VPackFormat;
+  std::unordered_map<std::string, std::string> headers;
+  if (vpack) {
+    headers.emplace(arangodb::StaticStrings::Accept, arangodb::StaticStrings::MimeTypeVPack);
+  }
+
   uint64_t fromTick = minTick;
   uint64_t chunkSize = jobData.options.initialChunkSize;  // will grow adaptively up to max
   std::string baseUrl = "/_api/replication/dump?collection=" + urlEncode(name) +
@@ -317,6 +377,16 @@ arangodb::Result dumpCollection(arangodb::httpclient::SimpleHttpClient& client,
     // we are in single-server mode, we already flushed the wal
     baseUrl += "&flush=false";
   }
+  if (jobData.numRanges > 1) {
+    // only fetch our part of the collection
+    baseUrl += "&range=" + itoa(jobData.range) + "&ranges=" + itoa(jobData.numRanges);
+  }
+
+  // the previous batch is masked or compressed and written by another
+  // thread while the next one is fetched. the future is declared after the
+  // response it refers to, so that it is waited for first
+  std::unique_ptr<arangodb::httpclient::SimpleHttpResult> pending;
+  std::future<arangodb::Result> written;
 
   while (true) {
     std::string url = baseUrl + "&from=" + itoa(fromTick) + "&chunkSize=" + itoa(chunkSize);
@@ -328,7 +398,7 @@ arangodb::Result dumpCollection(arangodb::httpclient::SimpleHttpClient& client,
 
     // make the actual request for data
     std::unique_ptr<arangodb::httpclient::SimpleHttpResult> response(
-        client.request(arangodb::rest::RequestType::GET, url, nullptr, 0));
+        client.request(arangodb::rest::RequestType::GET, url, nullptr, 0, headers));
     auto check = ::checkHttpResponse(client, response);
     if (check.fail()) {
       LOG_TOPIC("ac972", ERR, arangodb::Logger::DUMP)
@@ -368,17 +438,37 @@ arangodb::Result dumpCollection(arangodb::httpclient::SimpleHttpClient& client,
                   name + "'"};
     }
 
-    // now actually write retrieved data to dump file
-    arangodb::basics::StringBuffer const& body = response->getBody();
-    arangodb::Result result = dumpJsonObjects(jobData, file, body);
+    if (vpack && response->getBody().length() > 0) {
+      bool found;
+      std::string const contentType =
+          response->getHeaderField(arangodb::StaticStrings::ContentTypeHeader, found);
+      if (!found || contentType.compare(0, arangodb::StaticStrings::MimeTypeVPack.size(),
+                                        arangodb::StaticStrings::MimeTypeVPack) != 0) {
+        return {TRI_ERROR_REPLICATION_INVALID_RESPONSE,
+                "server cannot dump collection '" + name +
+                    "' as VelocyPack, use --output-format json"};
+      }
+    }
 
-    if (result.fail()) {
-      return result;
+    // batches are written in order, so wait for the previous one
+    if (written.valid()) {
+      arangodb::Result result = written.get();
+      if (result.fail()) {
+        return result;
+      }
     }
 
+    // now actually write retrieved data to dump file
+    pending = std::move(response);
+    written = std::async(std::launch::async, [&jobData, &file, vpack,
+                                              body = &pending->getBody()]() {
+      return vpack ? dumpVPackObjects(jobData, file, *body)
+                   : dumpJsonObjects(jobData, file, *body);
+    });
+
     if (!checkMore || fromTick == 0) {
       // all done, return successful
-      return {TRI_ERROR_NO_ERROR};
+      return written.get();
     }
 
     // more data to retrieve, adaptively increase chunksize
@@ -469,7 +559,7 @@ arangodb::Result processJob(arangodb::httpclient::SimpleHttpClient& client,
   }
 
   if (!dumpStructure) {
-    if (jobData.options.progress) {
+    if (jobData.options.progress && jobData.range == 0) {
       LOG_TOPIC("a9ec1", INFO, arangodb::Logger::DUMP)
           << "# Dumping collection '" << jobData.name << "'...";
     }
@@ -480,10 +570,31 @@ arangodb::Result processJob(arangodb::httpclient::SimpleHttpClient& client,
   // prep hex string of collection name
   std::string const hexString(arangodb::rest::SslInterface::sslMD5(jobData.name));
 
+  if (jobData.range > 0) {
+    // further key range of a collection, the job for the first range takes
+    // care of the structure. each range goes into a file of its own
+    if (jobData.maskings != nullptr && !jobData.maskings->shouldDumpData(jobData.name)) {
+      return result;
+    }
+
+    auto file = jobData.directory.writableFile(
+        jobData.name + "_" + hexString + "." + std::to_string(jobData.range) +
+            ::dataFileSuffix(jobData.options),
+        true, 0, jobData.options.outputFormat != ::VPackFormat);
+    if (!::fileOk(file.get())) {
+      return ::fileError(file.get(), true);
+    }
+    return ::handleCollection(client, jobData, *file);
+  }
+
   // found a collection!
   if (jobData.options.progress) {
     LOG_TOPIC("5239e", INFO, arangodb::Logger::DUMP)
-        << "# Dumping collection '" << jobData.name << "'...";
+        << "# Dumping collection '" << jobData.name << "'"
+        << (jobData.numRanges > 1
+                ? " in " + std::to_string(jobData.numRanges) + " key ranges"
+                : std::string())
+        << "...";
   }
   ++(jobData.stats.totalCollections);
 
@@ -527,9 +638,9 @@ arangodb::Result processJob(arangodb::httpclient::SimpleHttpClient& client,
     }
 
     // always create the file so that arangorestore does not complain
-    auto file = jobData.directory.writableFile(jobData.name + "_" + hexString +
-                                                   ".data.json",
-                                               true);
+    auto file = jobData.directory.writableFile(
+        jobData.name + "_" + hexString + ::dataFileSuffix(jobData.options), true,
+        0, jobData.options.outputFormat != ::VPackFormat);
     if (!::fileOk(file.get())) {
       return ::fileError(file.get(), true);
     }
@@ -584,6 +695,7 @@ std::string DumpFeature::featureName() { return ::FeatureName; }
 
 void DumpFeature::collectOptions(std::shared_ptr<options::ProgramOptions> options) {
   using arangodb::options::BooleanParameter;
+  using arangodb::options::DiscreteValuesParameter;
   using arangodb::options::StringParameter;
   using arangodb::options::UInt32Parameter;
   using arangodb::options::UInt64Parameter;
@@ -607,6 +719,14 @@ void DumpFeature::collectOptions(std::shared_ptr<options::ProgramOptions> option
       "maximum number of collections to process in parallel. From v3.4.0",
       new UInt32Parameter(&_options.threadCount));
 
+  options->addOption(
+      "--key-ranges",
+      "number of key ranges each collection is split into. the ranges are "
+      "dumped in parallel into files of their own (RocksDB engine, single "
+      "server only)",
+      new UInt32Parameter(&_options.keyRanges))
+      .setIntroducedIn(30500);
+
   options->addOption("--dump-data", "dump collection data",
                      new BooleanParameter(&_options.dumpData));
 
@@ -654,6 +774,14 @@ void DumpFeature::collectOptions(std::shared_ptr<options::ProgramOptions> option
                      new BooleanParameter(&_options.useGzip))
                      .setIntroducedIn(30406)
                      .setIntroducedIn(30500);
+
+  std::unordered_set<std::string> formats = {"json", ::VPackFormat};
+  options->addOption(
+      "--output-format",
+      "format of the files containing collection contents: JSON lines, or "
+      "the VelocyPack of the server in LZ4 frames (RocksDB engine only)",
+      new DiscreteValuesParameter<StringParameter>(&_options.outputFormat, formats))
+      .setIntroducedIn(30500);
 }
 
 void DumpFeature::validateOptions(std::shared_ptr<options::ProgramOptions> options) {
@@ -695,6 +823,16 @@ void DumpFeature::validateOptions(std::shared_ptr<options::ProgramOptions> optio
     _options.outputPath.pop_back();
   }
 
+  if (_options.keyRanges == 0) {
+    _options.keyRanges = 1;
+  }
+
+  if (_options.outputFormat == ::VPackFormat && !_options.maskingsFile.empty()) {
+    LOG_TOPIC("8b1f4", FATAL, arangodb::Logger::DUMP)
+        << "cannot use --maskings with --output-format " << ::VPackFormat;
+    FATAL_ERROR_EXIT();
+  }
+
   uint32_t clamped =
       boost::algorithm::clamp(_options.threadCount, 1,
                               4 * static_cast<uint32_t>(TRI_numberProcessors()));
@@ -708,12 +846,23 @@ void DumpFeature::validateOptions(std::shared_ptr<options::ProgramOptions> optio
 Result DumpFeature::runDump(httpclient::SimpleHttpClient& client, std::string const& dbName) {
   Result result;
   uint64_t batchId;
-  std::tie(result, batchId) = ::startBatch(client, "");
+  uint64_t maxDumpRanges;
+  std::tie(result, batchId) = ::startBatch(client, "", &maxDumpRanges);
   if (result.fail()) {
     return result;
   }
   TRI_DEFER(::endBatch(client, "", batchId));
 
+  size_t numRanges = 1;
+  if (_options.dumpData && _options.keyRanges > 1) {
+    numRanges = static_cast<size_t>(std::min<uint64_t>(_options.keyRanges, maxDumpRanges));
+    if (numRanges < _options.keyRanges) {
+      LOG_TOPIC("e0b35", WARN, Logger::DUMP)
+          << "server can split collections into at most " << maxDumpRanges
+          << " key range(s), capping --key-ranges value";
+    }
+  }
+
   // flush the wal and so we know we are getting everything
   flushWal(client);
 
@@ -819,12 +968,16 @@ Result DumpFeature::runDump(httpclient::SimpleHttpClient& client, std::string co
       continue;
     }
 
-    // queue job to actually dump collection
-    auto jobData =
-        std::make_unique<JobData>(*_directory, *this, _options, _maskings.get(),
-                                  _stats, collection, batchId,
-                                  std::to_string(cid), name, collectionType);
-    _clientTaskQueue.queueJob(std::move(jobData));
+    // queue jobs to actually dump collection, one per key range
+    for (size_t range = 0; range < numRanges; ++range) {
+      auto jobData =
+          std::make_unique<JobData>(*_directory, *this, _options, _maskings.get(),
+                                    _stats, collection, batchId,
+                                    std::to_string(cid), name, collectionType);
+      jobData->range = range;
+      jobData->numRanges = numRanges;
+      _clientTaskQueue.queueJob(std::move(jobData));
+    }
   }
 
   // wait for all jobs to finish, then check for errors
@@ -67,9 +67,11 @@ class DumpFeature : public application_features::ApplicationFeature {
     std::vector<std::string> collections{};
     std::string outputPath{};
     std::string maskingsFile{};
+    std::string outputFormat{"json"};
     uint64_t initialChunkSize{1024 * 1024 * 8};
     uint64_t maxChunkSize{1024 * 1024 * 64};
     uint32_t threadCount{2};
+    uint32_t keyRanges{1};
     uint64_t tickStart{0};
     uint64_t tickEnd{0};
     bool allDatabases{false};
@@ -107,6 +109,10 @@ class DumpFeature : public application_features::ApplicationFeature {
     std::string const cid;
     std::string const name;
     std::string const type;
+
+    /// @brief 0-based key range of the collection to dump, out of numRanges
+    size_t range{0};
+    size_t numRanges{1};
   };
 
  private:
@@ -0,0 +1,530 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "ArrowWriter.h"
+
+#include "Basics/StringUtils.h"
+
+#include <velocypack/Slice.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+using namespace arangodb;
+
+namespace {
+
+/// @brief file magic, padded to 8 bytes in the header
+char const Magic[] = "ARROW1";
+constexpr size_t MagicLength = 6;
+
+// values of the Arrow flatbuffer schemas (Schema.fbs, Message.fbs)
+constexpr int16_t MetadataVersionV5 = 4;
+constexpr uint8_t MessageHeaderSchema = 1;
+constexpr uint8_t MessageHeaderRecordBatch = 3;
+constexpr uint8_t TypeInt = 2;
+constexpr uint8_t TypeFloatingPoint = 3;
+constexpr uint8_t TypeUtf8 = 5;
+constexpr uint8_t TypeBool = 6;
+constexpr int16_t PrecisionDouble = 2;
+
+template <typename T>
+void appendLittleEndian(std::string& out, T value) {
+  uint64_t v = static_cast<uint64_t>(value);
+  for (size_t i = 0; i < sizeof(T); ++i) {
+    out.push_back(static_cast<char>((v >> (8 * i)) & 0xff));
+  }
+}
+
+void appendDouble(std::string& out, double value) {
+  uint64_t v;
+  static_assert(sizeof(v) == sizeof(value), "unexpected double size");
+  memcpy(&v, &value, sizeof(v));
+  appendLittleEndian(out, v);
+}
+
+template <typename T>
+std::string littleEndian(T value) {
+  std::string out;
+  appendLittleEndian(out, value);
+  return out;
+}
+
+void pad(std::string& out, size_t alignment) {
+  while (out.size() % alignment != 0) {
+    out.push_back('\0');
+  }
+}
+
+void patch32(std::string& out, size_t at, uint32_t value) {
+  for (size_t i = 0; i < 4; ++i) {
+    out[at + i] = static_cast<char>((value >> (8 * i)) & 0xff);
+  }
+}
+
+/// @brief a flatbuffer written front to back. an object is always written
+/// after the objects pointing to it, as offsets must point forward, which
+/// leaves each vtable right behind its table
+class FlatBuilder {
+ public:
+  struct TableField {
+    uint16_t id;
+    // the inline value, 4 placeholder bytes for offsets
+    std::string bytes;
+  };
+
+  struct Table {
+    size_t start;
+    // positions of the placeholders, in the order of the fields given
+    std::vector<size_t> positions;
+  };
+
+  FlatBuilder() : _buffer(4, '\0') {}
+
+  static TableField offset(uint16_t id) { return {id, std::string(4, '\0')}; }
+
+  template <typename T>
+  static TableField scalar(uint16_t id, T value) {
+    return {id, littleEndian(value)};
+  }
+
+  std::string const& buffer() const { return _buffer; }
+
+  /// @brief points the root offset to the next object
+  void root() { link(0); }
+
+  /// @brief points the offset placeholder at the position to the next
+  /// object. must be called right before writing that object
+  void link(size_t at) { _pending = at; }
+
+  Table table(std::vector<TableField> const& fields) {
+    // largest values first, so no padding is needed inside the table,
+    // which starts with the 4 byte vtable offset
+    std::vector<size_t> order(fields.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+      order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&fields](size_t a, size_t b) {
+      return fields[a].bytes.size() > fields[b].bytes.size();
+    });
+
+    while ((_buffer.size() + 4) % 8 != 0) {
+      _buffer.push_back('\0');
+    }
+    Table t;
+    t.start = begin();
+    _buffer.append(4, '\0');
+
+    uint16_t numIds = 0;
+    for (auto const& f : fields) {
+      numIds = std::max(numIds, static_cast<uint16_t>(f.id + 1));
+    }
+    std::vector<uint16_t> slots(numIds, 0);
+    t.positions.resize(fields.size());
+    for (size_t i : order) {
+      slots[fields[i].id] = static_cast<uint16_t>(_buffer.size() - t.start);
+      t.positions[i] = _buffer.size();
+      _buffer.append(fields[i].bytes);
+    }
+    size_t const tableSize = _buffer.size() - t.start;
+
+    pad(_buffer, 2);
+    size_t const vtable = _buffer.size();
+    appendLittleEndian<uint16_t>(_buffer, static_cast<uint16_t>(4 + 2 * numIds));
+    appendLittleEndian<uint16_t>(_buffer, static_cast<uint16_t>(tableSize));
+    for (uint16_t slot : slots) {
+      appendLittleEndian<uint16_t>(_buffer, slot);
+    }
+    patch32(_buffer, t.start,
+            static_cast<uint32_t>(static_cast<int32_t>(t.start) - static_cast<int32_t>(vtable)));
+    return t;
+  }
+
+  void string(std::string const& value) {
+    pad(_buffer, 4);
+    begin();
+    appendLittleEndian<uint32_t>(_buffer, static_cast<uint32_t>(value.size()));
+    _buffer.append(value);
+    _buffer.push_back('\0');
+  }
+
+  /// @brief a vector of offsets, returns the positions of the placeholders
+  std::vector<size_t> offsets(size_t count) {
+    pad(_buffer, 4);
+    begin();
+    appendLittleEndian<uint32_t>(_buffer, static_cast<uint32_t>(count));
+    std::vector<size_t> positions;
+    for (size_t i = 0; i < count; ++i) {
+      positions.push_back(_buffer.size());
+      _buffer.append(4, '\0');
+    }
+    return positions;
+  }
+
+  /// @brief a vector of structs with 8 byte alignment
+  void structs(std::string const& elements, size_t count) {
+    while ((_buffer.size() + 4) % 8 != 0) {
+      _buffer.push_back('\0');
+    }
+    begin();
+    appendLittleEndian<uint32_t>(_buffer, static_cast<uint32_t>(count));
+    _buffer.append(elements);
+  }
+
+ private:
+  /// @brief resolves the pending offset to the object starting here
+  size_t begin() {
+    size_t const start = _buffer.size();
+    if (_pending != SIZE_MAX) {
+      patch32(_buffer, _pending, static_cast<uint32_t>(start - _pending));
+      _pending = SIZE_MAX;
+    }
+    return start;
+  }
+
+  std::string _buffer;
+  size_t _pending = SIZE_MAX;
+};
+
+void writeSchema(FlatBuilder& builder, std::vector<ArrowWriter::Field> const& fields) {
+  using FB = FlatBuilder;
+
+  auto schema = builder.table({FB::offset(1)});  // fields
+  builder.link(schema.positions[0]);
+  auto elements = builder.offsets(fields.size());
+
+  for (size_t i = 0; i < fields.size(); ++i) {
+    uint8_t typeId = TypeUtf8;
+    switch (fields[i].type) {
+      case ArrowWriter::Type::Bool:
+        typeId = TypeBool;
+        break;
+      case ArrowWriter::Type::Int64:
+        typeId = TypeInt;
+        break;
+      case ArrowWriter::Type::Double:
+        typeId = TypeFloatingPoint;
+        break;
+      case ArrowWriter::Type::Utf8:
+        typeId = TypeUtf8;
+        break;
+    }
+
+    builder.link(elements[i]);
+    // name, nullable, type_type, type, children
+    auto field = builder.table({FB::offset(0), FB::scalar<uint8_t>(1, 1),
+                                FB::scalar<uint8_t>(2, typeId), FB::offset(3),
+                                FB::offset(5)});
+    builder.link(field.positions[0]);
+    builder.string(fields[i].name);
+
+    builder.link(field.positions[3]);
+    if (typeId == TypeInt) {
+      // bitWidth, is_signed
+      builder.table({FB::scalar<int32_t>(0, 64), FB::scalar<uint8_t>(1, 1)});
+    } else if (typeId == TypeFloatingPoint) {
+      builder.table({FB::scalar<int16_t>(0, PrecisionDouble)});
+    } else {
+      builder.table({});
+    }
+
+    builder.link(field.positions[4]);
+    builder.offsets(0);
+  }
+}
+
+}  // namespace
+
+std::string ArrowWriter::parseSchema(std::string const& value, std::vector<Field>& fields) {
+  fields.clear();
+  for (auto const& it : basics::StringUtils::split(value, ',')) {
+    std::string part = basics::StringUtils::trim(it);
+    size_t colon = part.rfind(':');
+    if (colon == std::string::npos || colon == 0) {
+      return "expecting 'name:type' in schema, got '" + part + "'";
+    }
+    std::string const name = basics::StringUtils::trim(part.substr(0, colon));
+    std::string const type = basics::StringUtils::tolower(basics::StringUtils::trim(part.substr(colon + 1)));
+    if (type == "bool" || type == "boolean") {
+      fields.push_back({name, Type::Bool});
+    } else if (type == "int64" || type == "int") {
+      fields.push_back({name, Type::Int64});
+    } else if (type == "double" || type == "float64") {
+      fields.push_back({name, Type::Double});
+    } else if (type == "utf8" || type == "string") {
+      fields.push_back({name, Type::Utf8});
+    } else {
+      return "unsupported type '" + type + "' for attribute '" + name +
+             "', expecting bool, int64, double or utf8";
+    }
+  }
+  if (fields.empty()) {
+    return "expecting at least one attribute in schema";
+  }
+  return "";
+}
+
+ArrowWriter::ArrowWriter(std::vector<Field> fields)
+    : _fields(std::move(fields)), _rows(0), _offset(0) {
+  for (auto const& f : _fields) {
+    _columns.emplace_back(f.type);
+    _columns.back().clear();
+  }
+}
+
+size_t ArrowWriter::pendingBytes() const {
+  size_t bytes = 0;
+  for (auto const& column : _columns) {
+    bytes += column.validity.size() + column.values.size() + column.data.size();
+  }
+  return bytes;
+}
+
+std::vector<std::string> ArrowWriter::fieldNames() const {
+  std::vector<std::string> names;
+  for (auto const& f : _fields) {
+    names.push_back(f.name);
+  }
+  return names;
+}
+
+std::string ArrowWriter::header() {
+  std::string out(Magic, MagicLength);
+  pad(out, 8);
+  _offset = out.size();
+
+  FlatBuilder builder;
+  builder.root();
+  // version, header_type, header, bodyLength
+  auto message = builder.table({FlatBuilder::scalar<int16_t>(0, MetadataVersionV5),
+                                FlatBuilder::scalar<uint8_t>(1, MessageHeaderSchema),
+                                FlatBuilder::offset(2), FlatBuilder::scalar<int64_t>(3, 0)});
+  builder.link(message.positions[2]);
+  writeSchema(builder, _fields);
+
+  Block block;
+  out.append(this->message(builder.buffer(), std::string(), block));
+  return out;
+}
+
+void ArrowWriter::append(VPackSlice document) {
+  for (size_t i = 0; i < _fields.size(); ++i) {
+    VPackSlice value = VPackSlice::noneSlice();
+    if (document.isObject()) {
+      value = document.get(_fields[i].name);
+    }
+    _columns[i].append(value, _rows);
+  }
+  ++_rows;
+}
+
+void ArrowWriter::Column::append(VPackSlice value, size_t row) {
+  if (row % 8 == 0) {
+    validity.push_back('\0');
+    if (type == Type::Bool) {
+      values.push_back('\0');
+    }
+  }
+
+  bool valid = false;
+  switch (type) {
+    case Type::Bool:
+      if (value.isBoolean()) {
+        valid = true;
+        if (value.getBool()) {
+          values.back() |= static_cast<char>(1 << (row % 8));
+        }
+      }
+      break;
+    case Type::Int64: {
+      int64_t v = 0;
+      if (value.isInteger() && value.isNumber<int64_t>()) {
+        v = value.getNumber<int64_t>();
+        valid = true;
+      } else if (value.isDouble()) {
+        double d = value.getDouble();
+        // only doubles that are integers without loss
+        if (std::trunc(d) == d && d >= -9223372036854775808.0 && d < 9223372036854775808.0) {
+          v = static_cast<int64_t>(d);
+          valid = true;
+        }
+      }
+      appendLittleEndian(values, v);
+      break;
+    }
+    case Type::Double: {
+      double d = 0.0;
+      if (value.isNumber()) {
+        d = value.getNumber<double>();
+        valid = true;
+      }
+      appendDouble(values, d);
+      break;
+    }
+    case Type::Utf8:
+      if (value.isString()) {
+        VPackValueLength length;
+        char const* p = value.getString(length);
+        data.append(p, static_cast<size_t>(length));
+        valid = true;
+      } else if (!value.isNone() && !value.isNull()) {
+        data.append(value.toJson());
+        valid = true;
+      }
+      appendLittleEndian(values, static_cast<int32_t>(data.size()));
+      break;
+  }
+
+  if (valid) {
+    validity.back() |= static_cast<char>(1 << (row % 8));
+  } else {
+    ++nulls;
+  }
+}
+
+void ArrowWriter::Column::clear() {
+  nulls = 0;
+  validity.clear();
+  values.clear();
+  data.clear();
+  if (type == Type::Utf8) {
+    // the offsets start with the one of the first value
+    appendLittleEndian<int32_t>(values, 0);
+  }
+}
+
+std::string ArrowWriter::flush() {
+  if (_rows == 0) {
+    return std::string();
+  }
+
+  // the body holds all buffers, each padded to 8 bytes
+  std::string body;
+  std::string nodes;
+  std::string buffers;
+  size_t numBuffers = 0;
+
+  auto addBuffer = [&](std::string const* buffer) {
+    appendLittleEndian<int64_t>(buffers, static_cast<int64_t>(body.size()));
+    appendLittleEndian<int64_t>(buffers, static_cast<int64_t>(buffer == nullptr ? 0 : buffer->size()));
+    if (buffer != nullptr) {
+      body.append(*buffer);
+      pad(body, 8);
+    }
+    ++numBuffers;
+  };
+
+  for (auto& column : _columns) {
+    appendLittleEndian<int64_t>(nodes, static_cast<int64_t>(_rows));
+    appendLittleEndian<int64_t>(nodes, static_cast<int64_t>(column.nulls));
+
+    // the validity bitmap may be left out if there are no nulls
+    addBuffer(column.nulls > 0 ? &column.validity : nullptr);
+    addBuffer(&column.values);
+    if (column.type == Type::Utf8) {
+      addBuffer(&column.data);
+    }
+  }
+
+  FlatBuilder builder;
+  builder.root();
+  auto message = builder.table({FlatBuilder::scalar<int16_t>(0, MetadataVersionV5),
+                                FlatBuilder::scalar<uint8_t>(1, MessageHeaderRecordBatch),
+                                FlatBuilder::offset(2),
+                                FlatBuilder::scalar<int64_t>(3, static_cast<int64_t>(body.size()))});
+  builder.link(message.positions[2]);
+  // length, nodes, buffers
+  auto batch = builder.table({FlatBuilder::scalar<int64_t>(0, static_cast<int64_t>(_rows)),
+                              FlatBuilder::offset(1), FlatBuilder::offset(2)});
+  builder.link(batch.positions[1]);
+  builder.structs(nodes, _columns.size());
+  builder.link(batch.positions[2]);
+  builder.structs(buffers, numBuffers);
+
+  Block block;
+  std::string out = this->message(builder.buffer(), body, block);
+  _recordBatches.push_back(block);
+
+  _rows = 0;
+  for (auto& column : _columns) {
+    column.clear();
+  }
+  return out;
+}
+
+std::string ArrowWriter::footer() {
+  std::string out = flush();
+  size_t const start = out.size();
+
+  // end of stream
+  appendLittleEndian<uint32_t>(out, 0xFFFFFFFF);
+  appendLittleEndian<int32_t>(out, 0);
+
+  std::string blocks;
+  for (auto const& b : _recordBatches) {
+    appendLittleEndian<int64_t>(blocks, static_cast<int64_t>(b.offset));
+    appendLittleEndian<int32_t>(blocks, static_cast<int32_t>(b.metaDataLength));
+    appendLittleEndian<int32_t>(blocks, 0);  // padding
+    appendLittleEndian<int64_t>(blocks, static_cast<int64_t>(b.bodyLength));
+  }
+
+  FlatBuilder builder;
+  builder.root();
+  // version, schema, dictionaries, recordBatches
+  auto footer = builder.table({FlatBuilder::scalar<int16_t>(0, MetadataVersionV5),
+                               FlatBuilder::offset(1), FlatBuilder::offset(2),
+                               FlatBuilder::offset(3)});
+  builder.link(footer.positions[1]);
+  writeSchema(builder, _fields);
+  builder.link(footer.positions[2]);
+  builder.structs(std::string(), 0);
+  builder.link(footer.positions[3]);
+  builder.structs(blocks, _recordBatches.size());
+
+  std::string metadata = builder.buffer();
+  pad(metadata, 8);
+  out.append(metadata);
+  appendLittleEndian<int32_t>(out, static_cast<int32_t>(metadata.size()));
+  out.append(Magic, MagicLength);
+  _offset += out.size() - start;
+  return out;
+}
+
+std::string ArrowWriter::message(std::string const& metadata, std::string const& body, Block& block) {
+  std::string out;
+  appendLittleEndian<uint32_t>(out, 0xFFFFFFFF);
+  // the metadata is padded, so the body starts 8 byte aligned
+  size_t length = metadata.size();
+  while ((length % 8) != 0) {
+    ++length;
+  }
+  appendLittleEndian<int32_t>(out, static_cast<int32_t>(length));
+  out.append(metadata);
+  pad(out, 8);
+  out.append(body);
+
+  block.offset = _offset;
+  block.metaDataLength = static_cast<uint32_t>(8 + length);
+  block.bodyLength = body.size();
+  _offset += out.size();
+  return out;
+}
@@ -0,0 +1,113 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_EXPORT_ARROW_WRITER_H
+#define ARANGODB_EXPORT_ARROW_WRITER_H 1
+
+#include "Basics/Common.h"
+
+#include <velocypack/Slice.h>
+
+namespace arangodb {
+
+/// @brief writes documents as an Apache Arrow IPC file (also known as
+/// Feather V2), column by column according to a fixed schema. the
+/// metadata flatbuffers are encoded by hand, so only the flat types below
+/// are supported
+class ArrowWriter {
+ public:
+  enum class Type { Bool, Int64, Double, Utf8 };
+
+  struct Field {
+    std::string name;
+    Type type;
+  };
+
+  /// @brief parses a schema of the form "name:type,name:type", with the
+  /// types bool, int64, double and utf8 (or string). returns an empty
+  /// string on success and the error otherwise
+  static std::string parseSchema(std::string const& value, std::vector<Field>& fields);
+
+  explicit ArrowWriter(std::vector<Field> fields);
+
+  /// @brief top-level attribute names of the schema
+  std::vector<std::string> fieldNames() const;
+
+  /// @brief file magic and the schema. to be written first
+  std::string header();
+
+  /// @brief appends a document to the pending record batch. attributes
+  /// that are missing or not convertible to the column type become null,
+  /// values in a utf8 column that are no strings are stored as JSON
+  void append(velocypack::Slice document);
+
+  /// @brief number of documents in the pending record batch
+  size_t pendingRows() const { return _rows; }
+
+  /// @brief size of the column buffers of the pending record batch. utf8
+  /// columns must stay below 2 GB, as their offsets are 32 bit
+  size_t pendingBytes() const;
+
+  /// @brief the pending record batch, which is reset afterwards
+  std::string flush();
+
+  /// @brief the pending record batch, the end of stream marker and the
+  /// footer. to be written last
+  std::string footer();
+
+ private:
+  /// @brief one column of the pending record batch
+  struct Column {
+    explicit Column(Type type) : type(type), nulls(0) {}
+
+    void append(velocypack::Slice value, size_t row);
+    void clear();
+
+    Type type;
+    size_t nulls;
+    std::string validity;
+    // fixed size values, or the int32 offsets for utf8
+    std::string values;
+    // string data for utf8
+    std::string data;
+  };
+
+  /// @brief a message that was written, for the footer
+  struct Block {
+    uint64_t offset;
+    uint32_t metaDataLength;
+    uint64_t bodyLength;
+  };
+
+  /// @brief frames a message flatbuffer and its body. updates the
+  /// current file offset
+  std::string message(std::string const& metadata, std::string const& body, Block& block);
+
+ private:
+  std::vector<Field> const _fields;
+  std::vector<Column> _columns;
+  size_t _rows;
+  uint64_t _offset;
+  std::vector<Block> _recordBatches;
+};
+
+}  // namespace arangodb
+
+#endif
@@ -36,6 +36,7 @@
 
 #include <boost/algorithm/string.hpp>
 #include <boost/property_tree/detail/xml_parser_utils.hpp>
+#include <future>
 #include <iostream>
 #include <regex>
 #include <sys/types.h>
@@ -49,6 +50,10 @@ using namespace boost::property_tree::xml_parser;
 
 namespace {
 constexpr double ttlValue = 1200.;
+
+// an Arrow record batch is written once it has this many rows or bytes
+constexpr size_t arrowBatchRows = 64 * 1024;
+constexpr size_t arrowBatchBytes = 64 * 1024 * 1024;
 }
 
 namespace arangodb {
@@ -61,6 +66,7 @@ ExportFeature::ExportFeature(application_features::ApplicationServer& server, in
       _typeExport("json"),
       _csvFieldOptions(),
       _csvFields(),
+      _schemaOptions(),
       _xgmmlLabelOnly(false),
       _outputDirectory(),
       _overwrite(false),
@@ -109,8 +115,15 @@ void ExportFeature::collectOptions(std::shared_ptr<options::ProgramOptions> opti
                      "comma separated list of fileds to export into a csv file",
                      new StringParameter(&_csvFieldOptions));
 
-  std::unordered_set<std::string> exports = {"csv", "json", "jsonl", "xgmml",
-                                             "xml"};
+  options
+      ->addOption("--schema",
+                  "comma separated list of name:type pairs for the columns "
+                  "of an arrow file, with types bool, int64, double or utf8",
+                  new StringParameter(&_schemaOptions))
+      .setIntroducedIn(30500);
+
+  std::unordered_set<std::string> exports = {"arrow", "csv", "json", "jsonl",
+                                             "xgmml", "xml"};
   options->addOption("--type", "type of export",
                      new DiscreteValuesParameter<StringParameter>(&_typeExport, exports));
 }
@@ -153,7 +166,8 @@ void ExportFeature::validateOptions(std::shared_ptr<options::ProgramOptions> opt
     FATAL_ERROR_EXIT();
   }
 
-  if ((_typeExport == "json" || _typeExport == "jsonl" || _typeExport == "csv") &&
+  if ((_typeExport == "json" || _typeExport == "jsonl" || _typeExport == "csv" ||
+       _typeExport == "arrow") &&
       _collections.empty() && _query.empty()) {
     LOG_TOPIC("cdcf7", FATAL, Logger::CONFIG)
         << "expecting at least one collection or an AQL query";
@@ -169,6 +183,20 @@ void ExportFeature::validateOptions(std::shared_ptr<options::ProgramOptions> opt
 
     boost::split(_csvFields, _csvFieldOptions, boost::is_any_of(","));
   }
+
+  if (_typeExport == "arrow") {
+    if (_schemaOptions.empty()) {
+      LOG_TOPIC("5e3b7", FATAL, Logger::CONFIG)
+          << "expecting a schema for the arrow export";
+      FATAL_ERROR_EXIT();
+    }
+
+    std::string error = ArrowWriter::parseSchema(_schemaOptions, _arrowFields);
+    if (!error.empty()) {
+      LOG_TOPIC("a7c04", FATAL, Logger::CONFIG) << error;
+      FATAL_ERROR_EXIT();
+    }
+  }
 }
 
 void ExportFeature::prepare() {
@@ -251,7 +279,7 @@ void ExportFeature::start() {
   uint64_t exportedSize = 0;
 
   if (_typeExport == "json" || _typeExport == "jsonl" || _typeExport == "xml" ||
-      _typeExport == "csv") {
+      _typeExport == "csv" || _typeExport == "arrow") {
     if (_collections.size()) {
       collectionExport(httpClient.get());
 
@@ -308,11 +336,30 @@ void ExportFeature::collectionExport(SimpleHttpClient* httpClient) {
 
     std::string const url = "_api/cursor";
 
+    // only fetch the attributes that end up in the file
+    std::vector<std::string> fields;
+    if (_typeExport == "csv") {
+      fields = _csvFields;
+    } else if (_typeExport == "arrow") {
+      for (auto const& f : _arrowFields) {
+        fields.push_back(f.name);
+      }
+    }
+
     VPackBuilder post;
     post.openObject();
-    post.add("query", VPackValue("FOR doc IN @@collection RETURN doc"));
+    post.add("query", VPackValue(fields.empty()
+                                     ? "FOR doc IN @@collection RETURN doc"
+                                     : "FOR doc IN @@collection RETURN KEEP(doc, @fields)"));
     post.add("bindVars", VPackValue(VPackValueType::Object));
     post.add("@collection", VPackValue(collection));
+    if (!fields.empty()) {
+      post.add("fields", VPackValue(VPackValueType::Array));
+      for (auto const& f : fields) {
+        post.add(VPackValue(f));
+      }
+      post.close();
+    }
     post.close();
     post.add("ttl", VPackValue(::ttlValue));
     post.add("options", VPackValue(VPackValueType::Object));
@@ -322,7 +369,6 @@ void ExportFeature::collectionExport(SimpleHttpClient* httpClient) {
 
     std::shared_ptr<VPackBuilder> parsedBody =
         httpCall(httpClient, url, rest::RequestType::POST, post.toJson());
-    VPackSlice body = parsedBody->slice();
 
     int fd = TRI_CREATE(fileName.c_str(), O_CREAT | O_EXCL | O_RDWR | TRI_O_CLOEXEC,
                         S_IRUSR | S_IWUSR);
@@ -335,24 +381,8 @@ void ExportFeature::collectionExport(SimpleHttpClient* httpClient) {
     TRI_DEFER(TRI_CLOSE(fd));
 
     writeFirstLine(fd, fileName, collection);
-
-    writeBatch(fd, VPackArrayIterator(body.get("result")), fileName);
-
-    while (body.hasKey("id")) {
-      std::string const url = "/_api/cursor/" + body.get("id").copyString();
-      parsedBody = httpCall(httpClient, url, rest::RequestType::PUT);
-      body = parsedBody->slice();
-
-      writeBatch(fd, VPackArrayIterator(body.get("result")), fileName);
-    }
-
-    if (_typeExport == "json") {
-      std::string closingBracket = "\n]";
-      writeToFile(fd, closingBracket, fileName);
-    } else if (_typeExport == "xml") {
-      std::string xmlFooter = "</collection>";
-      writeToFile(fd, xmlFooter, fileName);
-    }
+    writeCursor(httpClient, parsedBody, fd, fileName);
+    writeLastLine(fd, fileName);
   }
 }
 
@@ -383,7 +413,6 @@ void ExportFeature::queryExport(SimpleHttpClient* httpClient) {
 
   std::shared_ptr<VPackBuilder> parsedBody =
       httpCall(httpClient, url, rest::RequestType::POST, post.toJson());
-  VPackSlice body = parsedBody->slice();
 
   int fd = TRI_CREATE(fileName.c_str(), O_CREAT | O_EXCL | O_RDWR | TRI_O_CLOEXEC,
                       S_IRUSR | S_IWUSR);
@@ -396,23 +425,45 @@ void ExportFeature::queryExport(SimpleHttpClient* httpClient) {
   TRI_DEFER(TRI_CLOSE(fd));
 
   writeFirstLine(fd, fileName, "");
+  writeCursor(httpClient, parsedBody, fd, fileName);
+  writeLastLine(fd, fileName);
+}
 
-  writeBatch(fd, VPackArrayIterator(body.get("result")), fileName);
+void ExportFeature::writeCursor(SimpleHttpClient* httpClient,
+                                std::shared_ptr<VPackBuilder> parsedBody, int fd,
+                                std::string const& fileName) {
+  VPackSlice body = parsedBody->slice();
 
-  while (body.hasKey("id")) {
-    std::string const url = "/_api/cursor/" + body.get("id").copyString();
-    parsedBody = httpCall(httpClient, url, rest::RequestType::PUT);
-    body = parsedBody->slice();
+  while (true) {
+    // fetch the next batch while this one is written
+    std::future<std::shared_ptr<VPackBuilder>> next;
+    if (body.hasKey("id")) {
+      std::string const url = "/_api/cursor/" + body.get("id").copyString();
+      next = std::async(std::launch::async, [this, httpClient, url]() {
+        return httpCall(httpClient, url, rest::RequestType::PUT);
+      });
+    }
 
     writeBatch(fd, VPackArrayIterator(body.get("result")), fileName);
+
+    if (!next.valid()) {
+      break;
+    }
+    parsedBody = next.get();
+    body = parsedBody->slice();
   }
+}
 
+void ExportFeature::writeLastLine(int fd, std::string const& fileName) {
   if (_typeExport == "json") {
     std::string closingBracket = "\n]";
     writeToFile(fd, closingBracket, fileName);
   } else if (_typeExport == "xml") {
     std::string xmlFooter = "</collection>";
     writeToFile(fd, xmlFooter, fileName);
+  } else if (_typeExport == "arrow") {
+    writeToFile(fd, _arrowWriter->footer(), fileName);
+    _arrowWriter.reset();
   }
 }
 
@@ -431,6 +482,10 @@ void ExportFeature::writeFirstLine(int fd, std::string const& fileName,
     xmlHeader.append("\">\n");
     writeToFile(fd, xmlHeader, fileName);
 
+  } else if (_typeExport == "arrow") {
+    _arrowWriter = std::make_unique<ArrowWriter>(_arrowFields);
+    writeToFile(fd, _arrowWriter->header(), fileName);
+
   } else if (_typeExport == "csv") {
     std::string firstLine = "";
     bool isFirstValue = true;
@@ -510,6 +565,14 @@ void ExportFeature::writeBatch(int fd, VPackArrayIterator it, std::string const&
       line.append("\n");
       writeToFile(fd, line, fileName);
     }
+  } else if (_typeExport == "arrow") {
+    for (auto const& doc : it) {
+      _arrowWriter->append(doc);
+      if (_arrowWriter->pendingRows() >= ::arrowBatchRows ||
+          _arrowWriter->pendingBytes() >= ::arrowBatchBytes) {
+        writeToFile(fd, _arrowWriter->flush(), fileName);
+      }
+    }
   } else if (_typeExport == "xml") {
     for (auto const& doc : it) {
       line.clear();
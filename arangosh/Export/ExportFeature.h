@@ -26,6 +26,7 @@
 #include <velocypack/Iterator.h>
 #include <velocypack/velocypack-aliases.h>
 #include "ApplicationFeatures/ApplicationFeature.h"
+#include "Export/ArrowWriter.h"
 #include "V8Client/ArangoClientHelper.h"
 #include "lib/Rest/CommonDefines.h"
 
@@ -54,6 +55,10 @@ class ExportFeature final : public application_features::ApplicationFeature,
   void queryExport(httpclient::SimpleHttpClient* httpClient);
   void writeFirstLine(int fd, std::string const& fileName, std::string const& collection);
   void writeBatch(int fd, VPackArrayIterator it, std::string const& fileName);
+  void writeCursor(httpclient::SimpleHttpClient* httpClient,
+                   std::shared_ptr<VPackBuilder> parsedBody, int fd,
+                   std::string const& fileName);
+  void writeLastLine(int fd, std::string const& fileName);
   void graphExport(httpclient::SimpleHttpClient* httpClient);
   void writeGraphBatch(int fd, VPackArrayIterator it, std::string const& fileName);
   void xgmmlWriteOneAtt(int fd, std::string const& fileName, VPackSlice const& slice,
@@ -71,6 +76,9 @@ class ExportFeature final : public application_features::ApplicationFeature,
   std::string _typeExport;
   std::string _csvFieldOptions;
   std::vector<std::string> _csvFields;
+  std::string _schemaOptions;
+  std::vector<ArrowWriter::Field> _arrowFields;
+  std::unique_ptr<ArrowWriter> _arrowWriter;
   bool _xgmmlLabelOnly;
 
   std::string _outputDirectory;
@@ -50,6 +50,7 @@ ImportFeature::ImportFeature(application_features::ApplicationServer& server, in
       _autoChunkSize(true),
       _chunkSize(1024 * 1024 * 1),
       _threadCount(2),
+      _pipelineDepth(1),
       _collectionName(""),
       _fromCollectionPrefix(""),
       _toCollectionPrefix(""),
@@ -58,6 +59,7 @@ ImportFeature::ImportFeature(application_features::ApplicationServer& server, in
       _createCollectionType("document"),
       _typeImport("json"),
       _overwrite(false),
+      _lowPriority(false),
       _quote("\""),
       _separator(""),
       _progress(true),
@@ -89,6 +91,13 @@ void ImportFeature::collectOptions(std::shared_ptr<options::ProgramOptions> opti
       "Number of parallel import threads. Most useful for the rocksdb engine",
       new UInt32Parameter(&_threadCount));
 
+  options->addOption(
+      "--pipeline-depth",
+      "number of requests each import thread may have in flight on its "
+      "connection (HTTP pipelining). raise it instead of --threads for "
+      "connections with high latency",
+      new UInt32Parameter(&_pipelineDepth));
+
   options->addOption("--collection", "collection name", new StringParameter(&_collectionName));
 
   options->addOption("--from-collection-prefix",
@@ -150,6 +159,12 @@ void ImportFeature::collectOptions(std::shared_ptr<options::ProgramOptions> opti
       "from the collection)",
       new BooleanParameter(&_overwrite));
 
+  options->addOption(
+      "--low-priority",
+      "ask the server to treat the import as a low-priority bulk load, which "
+      "is slowed down first when the storage engine falls behind",
+      new BooleanParameter(&_lowPriority));
+
   options->addOption("--quote", "quote character(s), used for csv",
                      new StringParameter(&_quote));
 
@@ -219,6 +234,11 @@ void ImportFeature::validateOptions(std::shared_ptr<options::ProgramOptions> opt
         << "capping --threads value to " << TRI_numberProcessors() * 2;
     _threadCount = (uint32_t)TRI_numberProcessors() * 2;
   }
+  if (_pipelineDepth < 1) {
+    LOG_TOPIC("3b7de", WARN, arangodb::Logger::FIXME)
+        << "capping --pipeline-depth value to " << 1;
+    _pipelineDepth = 1;
+  }
 
   for (auto const& it : _translations) {
     auto parts = StringUtils::split(it, "=");
@@ -317,6 +337,9 @@ void ImportFeature::start() {
       std::cout << "separator:              " << _separator << std::endl;
     }
     std::cout << "threads:                " << _threadCount << std::endl;
+    if (_pipelineDepth > 1) {
+      std::cout << "pipeline depth:         " << _pipelineDepth << std::endl;
+    }
 
     std::cout << "connect timeout:        " << client->connectionTimeout() << std::endl;
     std::cout << "request timeout:        " << client->requestTimeout() << std::endl;
@@ -362,7 +385,8 @@ void ImportFeature::start() {
 
   SimpleHttpClientParams params = _httpClient->params();
   arangodb::import::ImportHelper ih(client, client->endpoint(), params,
-                                    _chunkSize, _threadCount, _autoChunkSize);
+                                    _chunkSize, _threadCount, _autoChunkSize,
+                                    _pipelineDepth);
 
   // create colletion
   if (_createCollection) {
@@ -376,6 +400,7 @@ void ImportFeature::start() {
   ih.setConversion(_convert);
   ih.setRowsToSkip(static_cast<size_t>(_rowsToSkip));
   ih.setOverwrite(_overwrite);
+  ih.setLowPriority(_lowPriority);
   ih.useBackslash(_useBackslash);
   ih.ignoreMissing(_ignoreMissing);
 
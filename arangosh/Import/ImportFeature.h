@@ -55,6 +55,7 @@ class ImportFeature final : public application_features::ApplicationFeature,
   bool _autoChunkSize;
   uint64_t _chunkSize;
   uint32_t _threadCount;
+  uint32_t _pipelineDepth;
   std::string _collectionName;
   std::string _fromCollectionPrefix;
   std::string _toCollectionPrefix;
@@ -65,6 +66,7 @@ class ImportFeature final : public application_features::ApplicationFeature,
   std::vector<std::string> _translations;
   std::vector<std::string> _removeAttributes;
   bool _overwrite;
+  bool _lowPriority;
   std::string _quote;
   std::string _separator;
   bool _progress;
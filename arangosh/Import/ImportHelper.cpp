@@ -25,6 +25,7 @@
 #include "ImportHelper.h"
 #include "Basics/ConditionLocker.h"
 #include "Basics/MutexLocker.h"
+#include "Basics/StaticStrings.h"
 #include "Basics/StringUtils.h"
 #include "Basics/VelocyPackHelper.h"
 #include "Basics/files.h"
@@ -155,7 +156,8 @@ unsigned const ImportHelper::MaxBatchSize = 768 * 1024 * 1024;
 
 ImportHelper::ImportHelper(ClientFeature const* client, std::string const& endpoint,
                            httpclient::SimpleHttpClientParams const& params,
-                           uint64_t maxUploadSize, uint32_t threadCount, bool autoUploadSize)
+                           uint64_t maxUploadSize, uint32_t threadCount,
+                           bool autoUploadSize, uint32_t pipelineDepth)
     : _httpClient(client->createHttpClient(endpoint, params)),
       _maxUploadSize(maxUploadSize),
       _periodByteCount(0),
@@ -186,10 +188,13 @@ ImportHelper::ImportHelper(ClientFeature const* client, std::string const& endpo
       _hasError(false) {
   for (uint32_t i = 0; i < threadCount; i++) {
     auto http = client->createHttpClient(endpoint, params);
-    _senderThreads.emplace_back(new SenderThread(std::move(http), &_stats, [this]() {
-      CONDITION_LOCKER(guard, _threadsCondition);
-      guard.signal();
-    }));
+    _senderThreads.emplace_back(new SenderThread(
+        std::move(http), &_stats,
+        [this]() {
+          CONDITION_LOCKER(guard, _threadsCondition);
+          guard.signal();
+        },
+        pipelineDepth));
     _senderThreads.back()->start();
   }
 
@@ -219,6 +224,12 @@ ImportHelper::~ImportHelper() {
   }
 }
 
+void ImportHelper::setLowPriority(bool value) {
+  for (auto const& t : _senderThreads) {
+    t->setHeader(StaticStrings::XArangoLowPriority, value ? "true" : "false");
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief imports a delimited file
 ////////////////////////////////////////////////////////////////////////////////
@@ -82,7 +82,8 @@ class ImportHelper {
  public:
   ImportHelper(ClientFeature const* client, std::string const& endpoint,
                httpclient::SimpleHttpClientParams const& params, uint64_t maxUploadSize,
-               uint32_t threadCount, bool autoUploadSize = false);
+               uint32_t threadCount, bool autoUploadSize = false,
+               uint32_t pipelineDepth = 1);
 
   ~ImportHelper();
 
@@ -173,6 +174,13 @@ class ImportHelper {
 
   void setOverwrite(bool value) { _overwrite = value; }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief whether or not the server should treat the import as low-priority
+  /// bulk load, which is slowed down first when compactions fall behind
+  //////////////////////////////////////////////////////////////////////////////
+
+  void setLowPriority(bool value);
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief set the number of rows to skip
   //////////////////////////////////////////////////////////////////////////////
@@ -42,7 +42,8 @@ using namespace arangodb::import;
 QuickHistogram histogram;
 
 SenderThread::SenderThread(std::unique_ptr<httpclient::SimpleHttpClient> client,
-                           ImportStatistics* stats, std::function<void()> const& wakeup)
+                           ImportStatistics* stats, std::function<void()> const& wakeup,
+                           uint32_t pipelineDepth)
     : Thread("Import Sender"),
       _client(std::move(client)),
       _wakeup(wakeup),
@@ -50,6 +51,7 @@ SenderThread::SenderThread(std::unique_ptr<httpclient::SimpleHttpClient> client,
       _hasError(false),
       _idle(true),
       _ready(false),
+      _pipelineDepth(pipelineDepth),
       _stats(stats) {}
 
 SenderThread::~SenderThread() { shutdown(); }
@@ -73,6 +75,11 @@ void SenderThread::sendData(std::string const& url, arangodb::basics::StringBuff
   guard.broadcast();
 }
 
+void SenderThread::setHeader(std::string const& name, std::string const& value) {
+  CONDITION_LOCKER(guard, _condition);
+  _headers[name] = value;
+}
+
 bool SenderThread::hasError() {
   CONDITION_LOCKER(guard, _condition);
   return _hasError;
@@ -90,21 +97,50 @@ bool SenderThread::isIdle() {
 
 bool SenderThread::isDone() {
   CONDITION_LOCKER(guard, _condition);
-  return _idle || _hasError;
+  return (_idle && _inFlight.empty()) || _hasError;
 }
 
 void SenderThread::run() {
   while (!isStopping() && !_hasError) {
+    bool haveData;
     {
       CONDITION_LOCKER(guard, _condition);
       _ready = true;
-      if (_idle) {
+      if (_idle && _inFlight.empty()) {
         guard.wait();
       }
+      haveData = !_idle;
     }
     if (isStopping()) {
       break;
     }
+
+    if (_pipelineDepth > 1) {
+      try {
+        if (haveData) {
+          sendPipelined();
+        }
+
+        // receive a response once the pipeline is full, or when there is
+        // nothing to send
+        bool receive;
+        {
+          CONDITION_LOCKER(guard, _condition);
+          receive = !_inFlight.empty() && (_inFlight.size() >= _pipelineDepth || _idle);
+        }
+        if (receive && !_hasError) {
+          receivePipelined();
+        }
+      } catch (...) {
+        CONDITION_LOCKER(guard, _condition);
+        _hasError = true;
+        _idle = true;
+      }
+
+      _wakeup();
+      continue;
+    }
+
     try {
       if (_data.length() > 0) {
         TRI_ASSERT(!_idle && !_url.empty());
@@ -113,7 +149,7 @@ void SenderThread::run() {
           QuickHistogramTimer timer(_stats->_histogram);
           std::unique_ptr<httpclient::SimpleHttpResult> result(
               _client->request(rest::RequestType::POST, _url, _data.c_str(),
-                               _data.length()));
+                               _data.length(), _headers));
 
           handleResult(result.get());
         }
@@ -137,6 +173,55 @@ void SenderThread::run() {
   TRI_ASSERT(_idle);
 }
 
+void SenderThread::sendPipelined() {
+  TRI_ASSERT(!_idle);
+
+  if (_data.length() > 0) {
+    TRI_ASSERT(!_url.empty());
+
+    bool const sent = _client->sendRequest(rest::RequestType::POST, _url, _data.c_str(),
+                                           _data.length(), _headers);
+
+    CONDITION_LOCKER(guard, _condition);
+    if (!sent) {
+      _errorMessage = _client->getErrorMessage();
+      _hasError = true;
+    } else {
+      _inFlight.push_back(std::chrono::steady_clock::now());
+    }
+  }
+
+  _url.clear();
+  _data.reset();
+
+  // the data buffer can take the next batch while this one is in flight
+  CONDITION_LOCKER(guard, _condition);
+  _idle = true;
+}
+
+void SenderThread::receivePipelined() {
+  std::unique_ptr<httpclient::SimpleHttpResult> result(_client->receiveResponse());
+
+  std::chrono::steady_clock::time_point started;
+  {
+    CONDITION_LOCKER(guard, _condition);
+    TRI_ASSERT(!_inFlight.empty());
+    started = _inFlight.front();
+    _inFlight.pop_front();
+  }
+  _stats->_histogram.postLatency(std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - started));
+
+  if (result == nullptr || !result->isComplete()) {
+    CONDITION_LOCKER(guard, _condition);
+    _errorMessage = _client->getErrorMessage();
+    _hasError = true;
+    return;
+  }
+
+  handleResult(result.get());
+}
+
 void SenderThread::handleResult(httpclient::SimpleHttpResult* result) {
   if (result == nullptr) {
     return;
@@ -28,6 +28,9 @@
 #include "Basics/Thread.h"
 #include "SimpleHttpClient/SimpleHttpClient.h"
 
+#include <chrono>
+#include <deque>
+
 namespace arangodb {
 namespace basics {
 class StringBuffer;
@@ -46,8 +49,10 @@ class SenderThread final : public arangodb::Thread {
   SenderThread& operator=(SenderThread const&) = delete;
 
  public:
-  explicit SenderThread(std::unique_ptr<httpclient::SimpleHttpClient>,
-                        ImportStatistics* stats, std::function<void()> const& wakeup);
+  /// @brief pipelineDepth is the number of requests that may be in flight
+  /// on the connection at the same time
+  SenderThread(std::unique_ptr<httpclient::SimpleHttpClient>, ImportStatistics* stats,
+               std::function<void()> const& wakeup, uint32_t pipelineDepth = 1);
 
   ~SenderThread();
 
@@ -57,11 +62,15 @@ class SenderThread final : public arangodb::Thread {
 
   void sendData(std::string const& url, basics::StringBuffer* sender);
 
+  /// @brief sets an additional header for all subsequent requests
+  void setHeader(std::string const& name, std::string const& value);
+
   bool hasError();
   /// Ready to start sending
   bool isReady();
-  /// Currently not sending data
+  /// Can take the next data to send
   bool isIdle();
+  /// All data sent and all responses received
   bool isDone();
 
   std::string const& errorMessage() const { return _errorMessage; }
@@ -77,13 +86,19 @@ class SenderThread final : public arangodb::Thread {
   std::function<void()> _wakeup;
   std::string _url;
   basics::StringBuffer _data;
+  std::unordered_map<std::string, std::string> _headers;
   bool _hasError;
   bool _idle;
   bool _ready;
+  uint32_t const _pipelineDepth;
+  /// @brief start times of the requests in flight
+  std::deque<std::chrono::steady_clock::time_point> _inFlight;
 
   ImportStatistics* _stats;
   std::string _errorMessage;
   void handleResult(httpclient::SimpleHttpResult* result);
+  void sendPipelined();
+  void receivePipelined();
 };
 }  // namespace import
 }  // namespace arangodb
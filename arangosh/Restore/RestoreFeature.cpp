@@ -29,6 +29,7 @@
 #include <velocypack/StringRef.h>
 #include <velocypack/velocypack-aliases.h>
 #include <boost/algorithm/clamp.hpp>
+#include <lz4frame.h>
 
 #include <chrono>
 #include <thread>
@@ -36,9 +37,11 @@
 #include "ApplicationFeatures/ApplicationServer.h"
 #include "Basics/FileUtils.h"
 #include "Basics/Result.h"
+#include "Basics/ScopeGuard.h"
 #include "Basics/StaticStrings.h"
 #include "Basics/StringUtils.h"
 #include "Basics/VelocyPackHelper.h"
+#include "Basics/system-functions.h"
 #include "Logger/Logger.h"
 #include "ProgramOptions/ProgramOptions.h"
 #include "Shell/ClientFeature.h"
@@ -445,11 +448,16 @@ arangodb::Result sendRestoreIndexes(arangodb::httpclient::SimpleHttpClient& http
   return ::checkHttpResponse(httpClient, response, "restoring indexes", body);
 }
 
+/// @brief how often a batch is retried after the server was overloaded,
+/// when the throttle is in use
+constexpr int MaxOverloadRetries = 10;
+
 /// @brief Send a command to restore actual data
 arangodb::Result sendRestoreData(arangodb::httpclient::SimpleHttpClient& httpClient,
                                  arangodb::RestoreFeature::Options const& options,
+                                 arangodb::RestoreThrottle* throttle,
                                  std::string const& cname, char const* buffer,
-                                 size_t bufferSize) {
+                                 size_t bufferSize, bool vpack = false) {
   using arangodb::basics::StringUtils::urlEncode;
   using arangodb::httpclient::SimpleHttpResult;
 
@@ -457,7 +465,7 @@ arangodb::Result sendRestoreData(arangodb::httpclient::SimpleHttpClient& httpCli
   arangodb::velocypack::Builder result;
   arangodb::basics::StringBuffer cleaned;
 
-  if (options.cleanupDuplicateAttributes) {
+  if (options.cleanupDuplicateAttributes && !vpack) {
     int res = cleaned.reserve(bufferSize);
 
     if (res != TRI_ERROR_NO_ERROR) {
@@ -522,12 +530,55 @@ arangodb::Result sendRestoreData(arangodb::httpclient::SimpleHttpClient& httpCli
     bufferSize = cleaned.length();
   }
 
-  std::string const url = "/_api/replication/restore-data?collection=" + urlEncode(cname) +
-                          "&force=" + (options.force ? "true" : "false");
+  std::string url = "/_api/replication/restore-data?collection=" + urlEncode(cname) +
+                    "&force=" + (options.force ? "true" : "false");
+  if (options.bulkLoad) {
+    url += "&bulkLoad=true";
+  }
 
-  std::unique_ptr<SimpleHttpResult> response(
-      httpClient.request(arangodb::rest::RequestType::PUT, url, buffer, bufferSize));
-  return ::checkHttpResponse(httpClient, response, "restoring data", "");
+  std::unordered_map<std::string, std::string> headers;
+  if (vpack) {
+    // the markers are sent just as they were dumped
+    headers.emplace(arangodb::StaticStrings::ContentTypeHeader,
+                    arangodb::StaticStrings::MimeTypeVPack);
+  }
+
+  if (throttle == nullptr) {
+    std::unique_ptr<SimpleHttpResult> response(
+        httpClient.request(arangodb::rest::RequestType::PUT, url, buffer, bufferSize, headers));
+    return ::checkHttpResponse(httpClient, response, "restoring data", "");
+  }
+
+  for (int attempt = 1;; ++attempt) {
+    throttle->acquire();
+    double const start = TRI_microtime();
+    std::unique_ptr<SimpleHttpResult> response(
+        httpClient.request(arangodb::rest::RequestType::PUT, url, buffer, bufferSize, headers));
+    double const latency = TRI_microtime() - start;
+
+    bool overloaded = false;
+    double retryAfter = 0.0;
+    if (response != nullptr && response->isComplete()) {
+      int const code = response->getHttpReturnCode();
+      overloaded = (code == static_cast<int>(arangodb::rest::ResponseCode::SERVICE_UNAVAILABLE) ||
+                    code == static_cast<int>(arangodb::rest::ResponseCode::TOO_MANY_REQUESTS));
+      if (overloaded) {
+        bool found = false;
+        std::string const value = response->getHeaderField("retry-after", found);
+        if (found) {
+          retryAfter = arangodb::basics::StringUtils::doubleDecimal(value);
+        }
+      }
+    }
+    throttle->release(latency, overloaded, retryAfter);
+
+    if (overloaded && attempt < MaxOverloadRetries) {
+      LOG_TOPIC("7d2a4", DEBUG, arangodb::Logger::RESTORE)
+          << "server is overloaded, retrying batch for collection '" << cname << "'";
+      continue;
+    }
+    return ::checkHttpResponse(httpClient, response, "restoring data", "");
+  }
 }
 
 /// @brief Recreate a collection given its description
@@ -612,6 +663,131 @@ arangodb::Result restoreIndexes(arangodb::httpclient::SimpleHttpClient& httpClie
   return result;
 }
 
+/// @brief the number of bytes to collect before sending a batch, either
+/// the configured chunk size or what the throttle currently allows
+uint64_t batchSize(arangodb::RestoreFeature::JobData const& jobData) {
+  arangodb::RestoreThrottle const* throttle = jobData.feature.throttle();
+  return throttle == nullptr ? jobData.options.chunkSize : throttle->batchSize();
+}
+
+/// @brief Restore the data of a collection from a file with LZ4 frames of
+/// VelocyPack markers. the markers are sent to the server as they are, in
+/// batches of about the chunk size
+arangodb::Result restoreVPackData(arangodb::httpclient::SimpleHttpClient& httpClient,
+                                  arangodb::RestoreFeature::JobData& jobData,
+                                  arangodb::ManagedDirectory::File& datafile,
+                                  std::string const& cname) {
+  using arangodb::Logger;
+  using arangodb::basics::StringBuffer;
+
+  LZ4F_dctx* context = nullptr;
+  size_t status = LZ4F_createDecompressionContext(&context, LZ4F_VERSION);
+  if (LZ4F_isError(status)) {
+    return {TRI_ERROR_OUT_OF_MEMORY, "cannot create LZ4 decompression context"};
+  }
+  TRI_DEFER(LZ4F_freeDecompressionContext(context));
+
+  // the largest VelocyPack header, a compound value with 8 byte length
+  constexpr size_t maxHeaderSize = 9;
+
+  StringBuffer input(false);
+  StringBuffer markers(false);
+  size_t inputOffset = 0;
+  bool eof = false;
+  bool frameEnded = true;
+
+  while (true) {
+    // decompress what we have read. output may remain in the context
+    // while the markers buffer is full
+    bool more = inputOffset < input.length();
+    while (more) {
+      if (markers.reserve(65536) != TRI_ERROR_NO_ERROR) {
+        return {TRI_ERROR_OUT_OF_MEMORY, "out of memory"};
+      }
+      size_t const available = markers.capacity() - markers.length();
+      size_t produced = available;
+      size_t consumed = input.length() - inputOffset;
+      status = LZ4F_decompress(context, markers.end(), &produced,
+                               input.begin() + inputOffset, &consumed, nullptr);
+      if (LZ4F_isError(status)) {
+        return {TRI_ERROR_CANNOT_READ_FILE, "invalid LZ4 data in file '" +
+                                                datafile.path() + "': " +
+                                                LZ4F_getErrorName(status)};
+      }
+      if (produced == 0 && consumed == 0) {
+        break;
+      }
+      // a return value of 0 marks the end of a frame
+      frameEnded = (status == 0);
+      markers.increaseLength(produced);
+      inputOffset += consumed;
+      more = inputOffset < input.length() || produced == available;
+    }
+    input.erase_front(inputOffset);
+    inputOffset = 0;
+
+    // send all complete markers once we have collected enough of them
+    if (markers.length() >= ::batchSize(jobData) || (eof && markers.length() > 0)) {
+      char const* p = markers.begin();
+      char const* e = markers.end();
+      while (static_cast<size_t>(e - p) >= maxHeaderSize || (eof && p < e)) {
+        VPackValueLength const size =
+            VPackSlice(reinterpret_cast<uint8_t const*>(p)).byteSize();
+        if (size > static_cast<VPackValueLength>(e - p)) {
+          break;
+        }
+        p += size;
+      }
+      size_t const length = p - markers.begin();
+      if (length == 0 && eof) {
+        return {TRI_ERROR_CANNOT_READ_FILE,
+                "truncated data in file '" + datafile.path() + "'"};
+      }
+
+      if (length > 0) {
+        jobData.stats.totalBatches++;
+        arangodb::Result result =
+            ::sendRestoreData(httpClient, jobData.options, jobData.feature.throttle(), cname,
+                              markers.begin(), length, /*vpack*/ true);
+        jobData.stats.totalSent += length;
+
+        if (result.fail()) {
+          if (!jobData.options.force) {
+            LOG_TOPIC("2e6c1", ERR, Logger::RESTORE)
+                << "Error while restoring data into collection '" << cname
+                << "': " << result.errorMessage();
+            return result;
+          }
+          LOG_TOPIC("e15c4", WARN, Logger::RESTORE)
+              << "Error while restoring data into collection '" << cname
+              << "': " << result.errorMessage();
+        }
+        markers.erase_front(length);
+      }
+    }
+
+    if (eof) {
+      if (!frameEnded) {
+        // the last frame did not end
+        return {TRI_ERROR_CANNOT_READ_FILE,
+                "truncated LZ4 data in file '" + datafile.path() + "'"};
+      }
+      return {TRI_ERROR_NO_ERROR};
+    }
+
+    if (input.reserve(65536) != TRI_ERROR_NO_ERROR) {
+      return {TRI_ERROR_OUT_OF_MEMORY, "out of memory"};
+    }
+    ssize_t numRead = datafile.read(input.end(), 65536);
+    if (datafile.status().fail()) {  // error while reading
+      return datafile.status();
+    }
+    input.increaseLength(numRead);
+    jobData.stats.totalRead += static_cast<uint64_t>(numRead);
+    eof = (numRead == 0);
+  }
+}
+
 /// @brief Restore the data for a given collection
 arangodb::Result restoreData(arangodb::httpclient::SimpleHttpClient& httpClient,
                              arangodb::RestoreFeature::JobData& jobData) {
@@ -629,17 +805,39 @@ arangodb::Result restoreData(arangodb::httpclient::SimpleHttpClient& httpClient,
   std::string const collectionType(type == 2 ? "document" : "edge");
 
   // import data. check if we have a datafile
-  //  ... there are 4 possible names
+  //  ... there are 4 possible names, further key ranges only come with
+  //  the first two
+  std::string const rangeSuffix =
+      jobData.range == 0 ? "" : "." + std::to_string(jobData.range);
+
+  // a binary dump comes with VelocyPack in LZ4 frames instead
+  std::string const vpackFile = cname + "_" + arangodb::rest::SslInterface::sslMD5(cname) +
+                                rangeSuffix + ".data.vpack.lz4";
+  if (arangodb::basics::FileUtils::exists(jobData.directory.pathToFile(vpackFile))) {
+    auto datafile = jobData.directory.readableFile(vpackFile);
+    if (!datafile || datafile->status().fail()) {
+      return {TRI_ERROR_CANNOT_READ_FILE,
+              "could not open data file for collection '" + cname + "'"};
+    }
+    if (jobData.options.progress) {
+      LOG_TOPIC("0b6d2", INFO, Logger::RESTORE)
+          << "# Loading data into " << collectionType << " collection '" << cname
+          << "', compressed data size: "
+          << TRI_SizeFile(datafile->path().c_str()) << " byte(s)";
+    }
+    return ::restoreVPackData(httpClient, jobData, *datafile, cname);
+  }
+
   auto datafile = jobData.directory.readableFile(
-      cname + "_" + arangodb::rest::SslInterface::sslMD5(cname) + ".data.json");
+      cname + "_" + arangodb::rest::SslInterface::sslMD5(cname) + rangeSuffix + ".data.json");
   if (!datafile || datafile->status().fail()) {
     datafile = jobData.directory.readableFile(
-      cname + "_" + arangodb::rest::SslInterface::sslMD5(cname) + ".data.json.gz");
+      cname + "_" + arangodb::rest::SslInterface::sslMD5(cname) + rangeSuffix + ".data.json.gz");
   }
-  if (!datafile || datafile->status().fail()) {
+  if (jobData.range == 0 && (!datafile || datafile->status().fail())) {
     datafile = jobData.directory.readableFile(cname + ".data.json.gz");
   } 
-  if (!datafile || datafile->status().fail()) {
+  if (jobData.range == 0 && (!datafile || datafile->status().fail())) {
     datafile = jobData.directory.readableFile(cname + ".data.json");
   }
   if (!datafile || datafile->status().fail()) {
@@ -678,7 +876,7 @@ arangodb::Result restoreData(arangodb::httpclient::SimpleHttpClient& httpClient,
     numReadForThisCollection += numRead;
     numReadSinceLastReport += numRead;
 
-    if (buffer.length() < jobData.options.chunkSize && numRead > 0) {
+    if (buffer.length() < ::batchSize(jobData) && numRead > 0) {
       continue;  // still continue reading
     }
 
@@ -700,7 +898,8 @@ arangodb::Result restoreData(arangodb::httpclient::SimpleHttpClient& httpClient,
       }
 
       jobData.stats.totalBatches++;
-      result = ::sendRestoreData(httpClient, jobData.options, cname, buffer.begin(), length);
+      result = ::sendRestoreData(httpClient, jobData.options, jobData.feature.throttle(),
+                                 cname, buffer.begin(), length);
       jobData.stats.totalSent += length;
 
       if (result.fail()) {
@@ -734,6 +933,12 @@ arangodb::Result restoreData(arangodb::httpclient::SimpleHttpClient& httpClient,
             << int(100. * double(numReadForThisCollection) / double(fileSize)) << " %)";
         } // else
 
+        if (jobData.feature.throttle() != nullptr) {
+          percentage << ", " << jobData.feature.throttle()->concurrency()
+                     << " batch(es) in flight of up to "
+                     << jobData.feature.throttle()->batchSize() << " byte(s)";
+        }
+
         LOG_TOPIC("69a73", INFO, Logger::RESTORE)
             << "# Still loading data into " << collectionType << " collection '"
             << cname << "', " << numReadForThisCollection << ofFilesize.str()
@@ -930,7 +1135,35 @@ arangodb::Result processInputDirectory(
       }
       stats.totalCollections++;
 
+      // collections dumped in several key ranges come with one data file
+      // per range. the ranges are restored in parallel
+      size_t numRanges = 1;
+      if (options.importData) {
+        std::string const cname = arangodb::basics::VelocyPackHelper::getStringValue(
+            collection.get("parameters"), "name", "");
+        std::string const prefix =
+            cname + "_" + arangodb::rest::SslInterface::sslMD5(cname) + ".";
+        while (true) {
+          std::string const path =
+              directory.pathToFile(prefix + std::to_string(numRanges) + ".data.");
+          if (!arangodb::basics::FileUtils::exists(path + "json") &&
+              !arangodb::basics::FileUtils::exists(path + "json.gz") &&
+              !arangodb::basics::FileUtils::exists(path + "vpack.lz4")) {
+            break;
+          }
+          ++numRanges;
+        }
+      }
+
       jobs.push_back(std::move(jobData));
+
+      for (size_t range = 1; range < numRanges; ++range) {
+        auto rangeJob =
+            std::make_unique<arangodb::RestoreFeature::JobData>(directory, feature, options,
+                                                                stats, collection);
+        rangeJob->range = range;
+        jobs.push_back(std::move(rangeJob));
+      }
     }
 
     // Step 4: fire up data transfer
@@ -1028,6 +1261,11 @@ arangodb::Result processInputDirectory(
 arangodb::Result processJob(arangodb::httpclient::SimpleHttpClient& httpClient,
                             arangodb::RestoreFeature::JobData& jobData) {
   arangodb::Result result;
+  if (jobData.range > 0) {
+    // further key range of a collection, the job of the first range takes
+    // care of everything else
+    return ::restoreData(httpClient, jobData);
+  }
   if (jobData.options.indexesFirst && jobData.options.importStructure) {
     // restore indexes first if we are using rocksdb
     result = ::restoreIndexes(httpClient, jobData);
@@ -1099,6 +1337,7 @@ RestoreFeature::RestoreFeature(application_features::ApplicationServer& server,
 
 void RestoreFeature::collectOptions(std::shared_ptr<options::ProgramOptions> options) {
   using arangodb::options::BooleanParameter;
+  using arangodb::options::DoubleParameter;
   using arangodb::options::StringParameter;
   using arangodb::options::UInt32Parameter;
   using arangodb::options::UInt64Parameter;
@@ -1126,6 +1365,21 @@ void RestoreFeature::collectOptions(std::shared_ptr<options::ProgramOptions> opt
                   new UInt32Parameter(&_options.threadCount))
       .setIntroducedIn(30400);
 
+  options
+      ->addOption("--auto-rate-limit",
+                  "adjust the number of parallel data batches and their "
+                  "size to the latency and overload responses of the server, "
+                  "using --threads and --batch-size as starting points",
+                  new BooleanParameter(&_options.autoRateLimit))
+      .setIntroducedIn(30500);
+
+  options
+      ->addOption("--latency-budget",
+                  "time in seconds a data batch may take before "
+                  "--auto-rate-limit sends fewer and smaller batches",
+                  new DoubleParameter(&_options.latencyBudget))
+      .setIntroducedIn(30500);
+
   options->addOption("--include-system-collections",
                      "include system collections",
                      new BooleanParameter(&_options.includeSystemCollections));
@@ -1196,6 +1450,13 @@ void RestoreFeature::collectOptions(std::shared_ptr<options::ProgramOptions> opt
       "--force", "continue restore even in the face of some server-side errors",
       new BooleanParameter(&_options.force));
 
+  options->addOption("--bulk-load",
+                     "lock collections exclusively while restoring data and "
+                     "let the server ingest it as SST files, bypassing its "
+                     "write-ahead log (RocksDB only, requires the server "
+                     "option --rocksdb.allow-bulk-load)",
+                     new BooleanParameter(&_options.bulkLoad));
+
   // deprecated options
   options
       ->addOption("--default-number-of-shards",
@@ -1255,6 +1516,12 @@ void RestoreFeature::validateOptions(std::shared_ptr<options::ProgramOptions> op
     _options.threadCount = clamped;
   }
 
+  if (_options.latencyBudget <= 0.0) {
+    LOG_TOPIC("c91e0", FATAL, arangodb::Logger::RESTORE)
+        << "invalid value for `--latency-budget`, expecting a positive number";
+    FATAL_ERROR_EXIT();
+  }
+
   // validate shards and replication factor
   if (_options.defaultNumberOfShards == 0) {
     LOG_TOPIC("248ee", FATAL, arangodb::Logger::RESTORE)
@@ -1446,6 +1713,12 @@ void RestoreFeature::start() {
         << "Connected to ArangoDB '" << httpClient->getEndpointSpecification() << "'";
   }
 
+  if (_options.autoRateLimit) {
+    // the worker threads are the upper bound for the requests in flight
+    _throttle = std::make_unique<RestoreThrottle>(_options.threadCount, _options.chunkSize,
+                                                  _options.latencyBudget);
+  }
+
   // set up threads and workers
   _clientTaskQueue.spawnWorkers(_clientManager, _options.threadCount);
 
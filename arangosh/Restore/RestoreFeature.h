@@ -27,6 +27,7 @@
 #include "ApplicationFeatures/ApplicationFeature.h"
 
 #include "Basics/VelocyPackHelper.h"
+#include "Restore/RestoreThrottle.h"
 #include "Utils/ClientManager.h"
 #include "Utils/ClientTaskQueue.h"
 #include "Utils/ManagedDirectory.h"
@@ -68,6 +69,12 @@ class RestoreFeature final : public application_features::ApplicationFeature {
    */
   Result getFirstError() const;
 
+  /**
+   * @brief Returns the throttle adapting restore requests to the server
+   * @return  The throttle, or nullptr if --auto-rate-limit is not set
+   */
+  RestoreThrottle* throttle() const { return _throttle.get(); }
+
   /// @brief Holds configuration data to pass between methods
   struct Options {
     std::vector<std::string> collections{};
@@ -79,11 +86,14 @@ class RestoreFeature final : public application_features::ApplicationFeature {
     std::vector<std::string> numberOfShards;
     std::vector<std::string> replicationFactor;
     uint32_t threadCount{2};
+    double latencyBudget{1.0};
     bool clusterMode{false};
     bool createDatabase{false};
     bool force{false};
     bool forceSameDatabase{false};
     bool allDatabases{false};
+    bool autoRateLimit{false};
+    bool bulkLoad{false};
     bool ignoreDistributeShardsLikeErrors{false};
     bool importData{true};
     bool importStructure{true};
@@ -111,6 +121,9 @@ class RestoreFeature final : public application_features::ApplicationFeature {
     Stats& stats;
 
     VPackSlice collection;
+    /// @brief key range whose data file to restore, ranges beyond the
+    /// first one only restore data
+    size_t range{0};
 
     JobData(ManagedDirectory&, RestoreFeature&, Options const&, Stats&, VPackSlice const&);
   };
@@ -122,6 +135,7 @@ class RestoreFeature final : public application_features::ApplicationFeature {
   int& _exitCode;
   Options _options;
   Stats _stats;
+  std::unique_ptr<RestoreThrottle> _throttle;
   Mutex mutable _workerErrorLock;
   std::queue<Result> _workerErrors;
 };
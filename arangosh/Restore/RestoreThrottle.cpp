@@ -0,0 +1,113 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "RestoreThrottle.h"
+
+#include "Basics/ConditionLocker.h"
+#include "Logger/Logger.h"
+
+using namespace arangodb;
+
+constexpr uint64_t RestoreThrottle::MinBatchSize;
+constexpr double RestoreThrottle::DefaultBackoff;
+
+RestoreThrottle::RestoreThrottle(uint32_t maxConcurrency, uint64_t batchSize,
+                                 double latencyBudget)
+    : _maxConcurrency(std::max(maxConcurrency, uint32_t(1))),
+      // batches may grow beyond the configured size, but not unbounded
+      _maxBatchSize(std::max(batchSize, MinBatchSize) * 4),
+      _latencyBudget(latencyBudget),
+      _inFlight(0),
+      _concurrency(1.0),
+      _slowStart(true),
+      _backoffUntil(std::chrono::steady_clock::now()),
+      _batchSize(std::max(batchSize, MinBatchSize)) {}
+
+void RestoreThrottle::acquire() {
+  CONDITION_LOCKER(guard, _condition);
+
+  while (true) {
+    auto now = std::chrono::steady_clock::now();
+    if (now < _backoffUntil) {
+      guard.wait(std::chrono::duration_cast<std::chrono::microseconds>(_backoffUntil - now));
+      continue;
+    }
+    if (_inFlight < static_cast<uint32_t>(_concurrency)) {
+      ++_inFlight;
+      return;
+    }
+    guard.wait();
+  }
+}
+
+void RestoreThrottle::release(double latency, bool overloaded, double retryAfter) {
+  CONDITION_LOCKER(guard, _condition);
+
+  TRI_ASSERT(_inFlight > 0);
+  --_inFlight;
+
+  uint64_t batchSize = _batchSize.load(std::memory_order_relaxed);
+  double const before = _concurrency;
+
+  if (overloaded) {
+    // the server rejected the request, back off hard
+    _slowStart = false;
+    _concurrency = std::max(1.0, _concurrency / 2.0);
+    batchSize = std::max(MinBatchSize, batchSize / 2);
+    double pause = retryAfter > 0.0 ? retryAfter : DefaultBackoff;
+    auto until = std::chrono::steady_clock::now() +
+                 std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                     std::chrono::duration<double>(pause));
+    if (until > _backoffUntil) {
+      _backoffUntil = until;
+    }
+  } else if (latency > _latencyBudget) {
+    _slowStart = false;
+    _concurrency = std::max(1.0, _concurrency * 0.75);
+    batchSize = std::max(MinBatchSize, (batchSize / 4) * 3);
+  } else {
+    if (_slowStart) {
+      _concurrency += 1.0;
+    } else {
+      _concurrency += 1.0 / _concurrency;
+    }
+    _concurrency = std::min(_concurrency, static_cast<double>(_maxConcurrency));
+    if (latency < _latencyBudget / 2.0) {
+      // plenty of headroom, larger batches save round trips
+      batchSize = std::min(_maxBatchSize, batchSize + batchSize / 4);
+    }
+  }
+
+  _batchSize.store(batchSize, std::memory_order_relaxed);
+
+  if (static_cast<uint32_t>(before) != static_cast<uint32_t>(_concurrency)) {
+    LOG_TOPIC("3c0f8", DEBUG, Logger::RESTORE)
+        << "adjusting restore concurrency to " << static_cast<uint32_t>(_concurrency)
+        << ", batch size " << batchSize << " byte(s), last request took " << latency
+        << " s" << (overloaded ? " and was rejected by the server" : "");
+  }
+
+  guard.broadcast();
+}
+
+uint32_t RestoreThrottle::concurrency() const {
+  CONDITION_LOCKER(guard, _condition);
+  return static_cast<uint32_t>(_concurrency);
+}
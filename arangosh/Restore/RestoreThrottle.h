@@ -0,0 +1,83 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_RESTORE_RESTORE_THROTTLE_H
+#define ARANGODB_RESTORE_RESTORE_THROTTLE_H 1
+
+#include "Basics/Common.h"
+#include "Basics/ConditionVariable.h"
+
+#include <chrono>
+
+namespace arangodb {
+
+/// @brief adapts the number of restore requests in flight and the size of
+/// their batches to what the server absorbs. requests that finish within
+/// the latency budget let both grow (slowly, once the server has pushed
+/// back for the first time), slower requests shrink them, and overload
+/// responses (HTTP 503/429) halve them and pause all senders for the time
+/// the server asked for
+class RestoreThrottle {
+ private:
+  RestoreThrottle(RestoreThrottle const&) = delete;
+  RestoreThrottle& operator=(RestoreThrottle const&) = delete;
+
+ public:
+  /// @brief smallest batch size ever used, same as the --batch-size minimum
+  static constexpr uint64_t MinBatchSize = 1024 * 128;
+
+  /// @brief pause after an overload response without a Retry-After header
+  static constexpr double DefaultBackoff = 1.0;
+
+  RestoreThrottle(uint32_t maxConcurrency, uint64_t batchSize, double latencyBudget);
+
+  /// @brief waits until another request may be sent
+  void acquire();
+
+  /// @brief reports the outcome of a request started with acquire().
+  /// retryAfter is the pause the server asked for in seconds, 0 if none
+  void release(double latency, bool overloaded, double retryAfter);
+
+  /// @brief the number of bytes to put into the next batch
+  uint64_t batchSize() const { return _batchSize.load(std::memory_order_relaxed); }
+
+  /// @brief the current number of requests allowed in flight
+  uint32_t concurrency() const;
+
+ private:
+  basics::ConditionVariable mutable _condition;
+  uint32_t const _maxConcurrency;
+  uint64_t const _maxBatchSize;
+  double const _latencyBudget;
+
+  // protected by _condition
+  uint32_t _inFlight;
+  // fractional, so that additive increase works for any limit
+  double _concurrency;
+  // double the limit per round of requests until the server pushes back
+  bool _slowStart;
+  std::chrono::steady_clock::time_point _backoffUntil;
+
+  std::atomic<uint64_t> _batchSize;
+};
+
+}  // namespace arangodb
+
+#endif
@@ -63,6 +63,8 @@ RocksDBOptionFeature::RocksDBOptionFeature(application_features::ApplicationServ
                                 ((TRI_PhysicalMemory - (static_cast<uint64_t>(2) << 30)) * 0.3))
                           : (256 << 20)),
       _blockCacheShardBits(-1),
+      _blockCacheHighPriorityPoolRatio(0.0),
+      _indexBlockCacheSize(0),
       _tableBlockSize(
           std::max(rocksDBTableOptionsDefaults.block_size,
                    static_cast<decltype(rocksDBTableOptionsDefaults.block_size)>(16 * 1024))),
@@ -72,7 +74,13 @@ RocksDBOptionFeature::RocksDBOptionFeature(application_features::ApplicationServ
       _level0StopTrigger(rocksDBDefaults.level0_stop_writes_trigger),
       _recycleLogFileNum(rocksDBDefaults.recycle_log_file_num),
       _enforceBlockCacheSizeLimit(false),
+      _chargeWriteBuffersToBlockCache(false),
       _blockAlignDataBlocks(rocksDBTableOptionsDefaults.block_align),
+      _cacheIndexAndFilterBlocks(rocksDBTableOptionsDefaults.cache_index_and_filter_blocks),
+      _pinl0FilterAndIndexBlocksInCache(
+          rocksDBTableOptionsDefaults.pin_l0_filter_and_index_blocks_in_cache),
+      _pinTopLevelIndexAndFilter(rocksDBTableOptionsDefaults.pin_top_level_index_and_filter),
+      _partitionFilters(rocksDBTableOptionsDefaults.partition_filters),
       _enablePipelinedWrite(rocksDBDefaults.enable_pipelined_write),
       _optimizeFiltersForHits(rocksDBDefaults.optimize_filters_for_hits),
       _useDirectReads(rocksDBDefaults.use_direct_reads),
@@ -199,6 +207,30 @@ void RocksDBOptionFeature::collectOptions(std::shared_ptr<ProgramOptions> option
       "if true, aligns data blocks on lesser of page size and block size",
       new BooleanParameter(&_blockAlignDataBlocks));
 
+  options->addOption(
+      "--rocksdb.cache-index-and-filter-blocks",
+      "if true, index and filter blocks are put into the block cache and "
+      "accounted against its size limit",
+      new BooleanParameter(&_cacheIndexAndFilterBlocks));
+
+  options->addOption(
+      "--rocksdb.pin-l0-filter-and-index-blocks-in-cache",
+      "if true and index and filter blocks are cached, the index and filter "
+      "blocks of level-0 files are pinned in the block cache",
+      new BooleanParameter(&_pinl0FilterAndIndexBlocksInCache));
+
+  options->addOption(
+      "--rocksdb.pin-top-level-index-and-filter",
+      "if true and index and filter blocks are cached, the top-level index "
+      "of partitioned index and filter blocks is pinned in the block cache",
+      new BooleanParameter(&_pinTopLevelIndexAndFilter));
+
+  options->addOption(
+      "--rocksdb.partition-filters",
+      "if true, use partitioned index and filter blocks for the primary "
+      "index column family",
+      new BooleanParameter(&_partitionFilters));
+
   options->addOption(
       "--rocksdb.enable-pipelined-write",
       "if true, use a two stage write queue for WAL writes and memtable writes",
@@ -282,6 +314,29 @@ void RocksDBOptionFeature::collectOptions(std::shared_ptr<ProgramOptions> option
                      "if true, strictly enforces the block cache size limit",
                      new BooleanParameter(&_enforceBlockCacheSizeLimit));
 
+  options->addOption(
+      "--rocksdb.block-cache-high-priority-pool-ratio",
+      "fraction of the block cache reserved for index and filter blocks "
+      "if these are cached (0 means that they compete with data blocks)",
+      new DoubleParameter(&_blockCacheHighPriorityPoolRatio))
+      .setIntroducedIn(30500);
+
+  options->addOption(
+      "--rocksdb.index-block-cache-size",
+      "size (in bytes) of a separate block cache for the index column "
+      "families, so that document scans cannot evict index blocks (0 means "
+      "that all column families share the block cache)",
+      new UInt64Parameter(&_indexBlockCacheSize))
+      .setIntroducedIn(30500);
+
+  options->addOption(
+      "--rocksdb.charge-write-buffers-to-block-cache",
+      "if true, the memory of the write buffers (up to "
+      "--rocksdb.total-write-buffer-size) is accounted against the block "
+      "cache size, so that both stay within one memory budget",
+      new BooleanParameter(&_chargeWriteBuffersToBlockCache))
+      .setIntroducedIn(30500);
+
   options->addOption(
       "--rocksdb.table-block-size",
       "approximate size (in bytes) of user data packed per block",
@@ -370,6 +425,11 @@ void RocksDBOptionFeature::validateOptions(std::shared_ptr<ProgramOptions> optio
         << "invalid value for '--rocksdb.block-cache-shard-bits'";
     FATAL_ERROR_EXIT();
   }
+  if (_blockCacheHighPriorityPoolRatio < 0.0 || _blockCacheHighPriorityPoolRatio > 1.0) {
+    LOG_TOPIC("9b3e1", FATAL, arangodb::Logger::FIXME)
+        << "invalid value for '--rocksdb.block-cache-high-priority-pool-ratio'";
+    FATAL_ERROR_EXIT();
+  }
 }
 
 void RocksDBOptionFeature::start() {
@@ -401,7 +461,16 @@ void RocksDBOptionFeature::start() {
       << ", num_threads_low: " << _numThreadsLow << ", block_cache_size: " << _blockCacheSize
       << ", block_cache_shard_bits: " << _blockCacheShardBits
       << ", block_cache_strict_capacity_limit: " << _enforceBlockCacheSizeLimit
+      << ", block_cache_high_priority_pool_ratio: " << _blockCacheHighPriorityPoolRatio
+      << ", index_block_cache_size: " << _indexBlockCacheSize
+      << ", charge_write_buffers_to_block_cache: " << std::boolalpha
+      << _chargeWriteBuffersToBlockCache
       << ", table_block_size: " << _tableBlockSize
+      << ", cache_index_and_filter_blocks: " << std::boolalpha << _cacheIndexAndFilterBlocks
+      << ", pin_l0_filter_and_index_blocks_in_cache: " << std::boolalpha
+      << _pinl0FilterAndIndexBlocksInCache
+      << ", pin_top_level_index_and_filter: " << std::boolalpha << _pinTopLevelIndexAndFilter
+      << ", partition_filters: " << std::boolalpha << _partitionFilters
       << ", recycle_log_file_num: " << std::boolalpha << _recycleLogFileNum
       << ", compaction_read_ahead_size: " << _compactionReadaheadSize
       << ", level0_compaction_trigger: " << _level0CompactionTrigger
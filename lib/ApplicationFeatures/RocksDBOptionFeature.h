@@ -63,6 +63,8 @@ class RocksDBOptionFeature final : public application_features::ApplicationFeatu
   uint32_t _numThreadsLow;
   uint64_t _blockCacheSize;
   int64_t _blockCacheShardBits;
+  double _blockCacheHighPriorityPoolRatio;
+  uint64_t _indexBlockCacheSize;
   uint64_t _tableBlockSize;
   uint64_t _compactionReadaheadSize;
   int64_t _level0CompactionTrigger;
@@ -70,7 +72,12 @@ class RocksDBOptionFeature final : public application_features::ApplicationFeatu
   int64_t _level0StopTrigger;
   bool _recycleLogFileNum;
   bool _enforceBlockCacheSizeLimit;
+  bool _chargeWriteBuffersToBlockCache;
   bool _blockAlignDataBlocks;
+  bool _cacheIndexAndFilterBlocks;
+  bool _pinl0FilterAndIndexBlocksInCache;
+  bool _pinTopLevelIndexAndFilter;
+  bool _partitionFilters;
   bool _enablePipelinedWrite;
   bool _optimizeFiltersForHits;
   bool _useDirectReads;
@@ -38,6 +38,7 @@
 #endif
 
 #include "Basics/FileUtils.h"
+#include "Basics/Profiler.h"
 #include "Basics/StringUtils.h"
 #include "Basics/files.h"
 #include "Logger/LogAppender.h"
@@ -207,6 +208,11 @@ void ArangoGlobalContext::maskAllSignals() {
 #ifdef TRI_HAVE_POSIX_THREADS
   sigset_t all;
   sigfillset(&all);
+#ifdef __linux__
+  // threads started from here, which inherit the mask, can be sampled by
+  // the CPU profiler
+  sigdelset(&all, profiler::sampleSignal());
+#endif
   pthread_sigmask(SIG_SETMASK, &all, nullptr);
 #endif
 }
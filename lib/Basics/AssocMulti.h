@@ -312,13 +312,16 @@ class AssocMulti {
                                bool const checkEquality) -> Element {
       return doInsert(userData, element, hashByKey, b, overwrite, checkEquality);
     };
+    auto checkResizeBinding = [&](UserData* userData, Bucket& b, uint64_t expected) -> bool {
+      return checkResize(userData, b, expected);
+    };
 
     try {
       // create inserter tasks to be dispatched later by partitioners
       for (size_t i = 0; i < allBuckets->size(); i++) {
         std::shared_ptr<Inserter> worker;
         worker.reset(new Inserter(queue, contextDestroyer, &_buckets, doInsertBinding,
-                                  i, contextCreator(), allBuckets));
+                                  checkResizeBinding, i, contextCreator(), allBuckets));
         inserters->emplace_back(worker);
       }
       // enqueue partitioner tasks
@@ -395,6 +398,22 @@ class AssocMulti {
   }
 
  private:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief makes room for expected more elements, so that inserting them
+  /// does not resize the bucket again and again
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool checkResize(UserData* userData, Bucket& b, uint64_t expected) {
+    if (2 * b._nrAlloc < 3 * (b._nrUsed + expected)) {
+      try {
+        resizeInternal(userData, b, 2 * (b._nrUsed + expected) + 1);
+      } catch (...) {
+        return false;
+      }
+    }
+    return true;
+  }
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief adds a key/element to the array
   //////////////////////////////////////////////////////////////////////////////
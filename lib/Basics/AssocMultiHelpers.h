@@ -84,6 +84,7 @@ class MultiInserterTask final : public LocalTask {
   std::function<void(void*)> _contextDestroyer;
   std::vector<Bucket>* _buckets;
   std::function<Element(void*, Element const&, uint64_t, Bucket&, bool const, bool const)> _doInsert;
+  std::function<bool(void*, Bucket&, uint64_t)> _checkResize;
 
   size_t _i;
   void* _userData;
@@ -95,12 +96,13 @@ class MultiInserterTask final : public LocalTask {
       std::shared_ptr<LocalTaskQueue> queue,
       std::function<void(void*)> contextDestroyer, std::vector<Bucket>* buckets,
       std::function<Element(void*, Element const&, uint64_t, Bucket&, bool const, bool const)> doInsert,
-      size_t i, void* userData,
+      std::function<bool(void*, Bucket&, uint64_t)> checkResize, size_t i, void* userData,
       std::shared_ptr<std::vector<std::vector<DocumentsPerBucket>>> allBuckets)
       : LocalTask(queue),
         _contextDestroyer(contextDestroyer),
         _buckets(buckets),
         _doInsert(doInsert),
+        _checkResize(checkResize),
         _i(i),
         _userData(userData),
         _allBuckets(allBuckets) {}
@@ -125,6 +127,18 @@ class MultiInserterTask final : public LocalTask {
     try {
       Bucket& b = (*_buckets)[static_cast<size_t>(_i)];
 
+      // make room for the documents of all partitioners at once
+      uint64_t expected = 0;
+      for (auto const& it : (*_allBuckets)[_i]) {
+        expected += it.size();
+      }
+      if (!_checkResize(_userData, b, expected)) {
+        _queue->setStatus(TRI_ERROR_OUT_OF_MEMORY);
+        _contextDestroyer(_userData);
+        _queue->join();
+        return;
+      }
+
       for (auto const& it : (*_allBuckets)[_i]) {
         for (auto const& it2 : it) {
           _doInsert(_userData, it2.first, it2.second, b, true, false);
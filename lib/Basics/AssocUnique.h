@@ -63,8 +63,29 @@ class AssocUnique {
   typedef arangodb::basics::IndexBucket<Element, uint64_t> Bucket;
 
  private:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief state of a bucket that is resized gradually. the new table takes
+  /// all insertions, and every write operation on the bucket moves a few
+  /// slots of the old table over. lookups check both tables
+  //////////////////////////////////////////////////////////////////////////////
+
+  struct Migration {
+    /// @brief the old table with the elements that have not been moved yet.
+    /// not allocated if the bucket is not being resized
+    Bucket old;
+    /// @brief the next slot of the old table to move. between two steps this
+    /// is always an empty slot, so that only whole clusters are moved and
+    /// the probe sequences of the elements left behind stay intact
+    uint64_t position = 0;
+    /// @brief the number of slots of the old table left to move
+    uint64_t remaining = 0;
+
+    bool active() const { return old._table != nullptr; }
+  };
+
   AssocUniqueHelper _helper;
   std::vector<Bucket> _buckets;
+  std::vector<Migration> _migrations;
   size_t _bucketsMask;
 
   std::function<std::string()> _contextCallback;
@@ -88,6 +109,7 @@ class AssocUnique {
     _bucketsMask = nr - 1;
 
     _buckets.resize(numberBuckets);
+    _migrations.resize(numberBuckets);
 
     try {
       for (size_t j = 0; j < numberBuckets; j++) {
@@ -120,6 +142,189 @@ class AssocUnique {
  private:
   static uint64_t initialSize() { return 251; }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief tables with at least this many slots are resized gradually,
+  /// smaller ones at once
+  //////////////////////////////////////////////////////////////////////////////
+
+  static uint64_t gradualResizeSize() { return 16384; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief number of slots of the old table moved by each write operation
+  /// on a bucket that is resized gradually. the old table is empty before
+  /// the insertions in between can fill more than a quarter of the new one
+  //////////////////////////////////////////////////////////////////////////////
+
+  static uint64_t migrationStep() { return 64; }
+
+  Migration& migrationOf(Bucket const& b) {
+    return _migrations[static_cast<size_t>(&b - _buckets.data())];
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the slot of the element that isEqual accepts, or the empty slot
+  /// that ends its probe sequence
+  //////////////////////////////////////////////////////////////////////////////
+
+  template <typename F>
+  static uint64_t findSlot(Bucket const& b, uint64_t hash, F const& isEqual) {
+    uint64_t const n = b._nrAlloc;
+    uint64_t i = hash % n;
+    uint64_t k = i;
+
+    for (; i < n && b._table[i] && !isEqual(b._table[i]); ++i)
+      ;
+    if (i == n) {
+      for (i = 0; i < k && b._table[i] && !isEqual(b._table[i]); ++i)
+        ;
+    }
+    return i;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the slot of the element that isEqual accepts, in the new or the
+  /// old table of the bucket. if there is none, the empty slot of the new
+  /// table that ends its probe sequence
+  //////////////////////////////////////////////////////////////////////////////
+
+  template <typename F>
+  Element* lookup(size_t bucketId, uint64_t hash, F const& isEqual) const {
+    Bucket const& b = _buckets[bucketId];
+    Element* slot = &b._table[findSlot(b, hash, isEqual)];
+
+    if (!*slot) {
+      Migration const& m = _migrations[bucketId];
+      if (m.active()) {
+        Element* old = &m.old._table[findSlot(m.old, hash, isEqual)];
+        if (*old) {
+          return old;
+        }
+      }
+    }
+    return slot;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief number of slots of a bucket, the ones of an old table included.
+  /// positions beyond the new table refer to the old one
+  //////////////////////////////////////////////////////////////////////////////
+
+  uint64_t slots(size_t bucketId) const {
+    return _buckets[bucketId]._nrAlloc + _migrations[bucketId].old._nrAlloc;
+  }
+
+  Element const& slot(size_t bucketId, uint64_t position) const {
+    Bucket const& b = _buckets[bucketId];
+    if (position < b._nrAlloc) {
+      return b._table[position];
+    }
+    return _migrations[bucketId].old._table[position - b._nrAlloc];
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief puts an element that is known not to be in the table into it
+  //////////////////////////////////////////////////////////////////////////////
+
+  void moveElement(Bucket& b, Element const& element) {
+    uint64_t const n = b._nrAlloc;
+    uint64_t i = _helper.HashElement(element, true) % n;
+
+    while (b._table[i]) {
+      i = TRI_IncModU64(i, n);
+    }
+
+    b._table[i] = element;
+    ++b._nrUsed;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief starts to resize a bucket gradually
+  //////////////////////////////////////////////////////////////////////////////
+
+  void startMigration(Bucket& b, Migration& m, uint64_t targetSize) {
+    TRI_ASSERT(!m.active());
+    targetSize = TRI_NearPrime(targetSize);
+
+    Bucket copy;
+    copy.allocate(targetSize);
+
+    m.old = std::move(b);
+    b = std::move(copy);
+
+    // there is always an empty slot, the table is never full
+    uint64_t position = 0;
+    while (m.old._table[position]) {
+      ++position;
+    }
+    m.position = position;
+    m.remaining = m.old._nrAlloc;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief moves at least count slots of the old table to the new one, and
+  /// then the rest of the cluster the last slot belongs to
+  //////////////////////////////////////////////////////////////////////////////
+
+  void migrate(Bucket& b, Migration& m, uint64_t count) {
+    uint64_t const n = m.old._nrAlloc;
+
+    while (m.remaining > 0 && (count > 0 || m.old._table[m.position])) {
+      Element& element = m.old._table[m.position];
+      if (element) {
+        moveElement(b, element);
+        element = Element();
+        --m.old._nrUsed;
+      }
+      m.position = TRI_IncModU64(m.position, n);
+      --m.remaining;
+      if (count > 0) {
+        --count;
+      }
+    }
+
+    if (m.remaining == 0 || m.old._nrUsed == 0) {
+      TRI_ASSERT(m.old._nrUsed == 0);
+      m.old.deallocate();
+      m.remaining = 0;
+    }
+  }
+
+  void finishMigration(Bucket& b, Migration& m) {
+    if (m.active()) {
+      migrate(b, m, m.remaining);
+    }
+    TRI_ASSERT(!m.active());
+  }
+
+  void finishMigrations() {
+    for (size_t i = 0; i < _buckets.size(); ++i) {
+      finishMigration(_buckets[i], _migrations[i]);
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief removes the element at slot i of the old table. instead of
+  /// healing the hole, the rest of the cluster is moved to the new table
+  //////////////////////////////////////////////////////////////////////////////
+
+  void removeFromOld(Bucket& b, Migration& m, uint64_t i) {
+    uint64_t const n = m.old._nrAlloc;
+
+    m.old._table[i] = Element();
+    --m.old._nrUsed;
+
+    for (uint64_t k = TRI_IncModU64(i, n); m.old._table[k]; k = TRI_IncModU64(k, n)) {
+      moveElement(b, m.old._table[k]);
+      m.old._table[k] = Element();
+      --m.old._nrUsed;
+    }
+
+    if (m.old._nrUsed == 0) {
+      m.old.deallocate();
+      m.remaining = 0;
+    }
+  }
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief resizes the array
   //////////////////////////////////////////////////////////////////////////////
@@ -180,12 +385,30 @@ class AssocUnique {
   //////////////////////////////////////////////////////////////////////////////
 
   bool checkResize(UserData* userData, Bucket& b, uint64_t expected) {
-    if (2 * b._nrAlloc < 3 * (b._nrUsed + expected)) {
-      try {
-        resizeInternal(userData, b, 2 * (b._nrAlloc + expected) + 1, false);
-      } catch (...) {
-        return false;
+    Migration& m = migrationOf(b);
+
+    try {
+      if (m.active()) {
+        if (expected > 0) {
+          // bulk insertions go into a single table
+          finishMigration(b, m);
+        } else {
+          migrate(b, m, migrationStep());
+        }
       }
+
+      if (2 * b._nrAlloc < 3 * (b._nrUsed + m.old._nrUsed + expected)) {
+        finishMigration(b, m);
+
+        uint64_t const targetSize = 2 * (b._nrAlloc + expected) + 1;
+        if (expected == 0 && b._nrAlloc >= gradualResizeSize()) {
+          startMigration(b, m, targetSize);
+        } else {
+          resizeInternal(userData, b, targetSize, false);
+        }
+      }
+    } catch (...) {
+      return false;
     }
     return true;
   }
@@ -199,14 +422,12 @@ class AssocUnique {
                                              uint64_t const step,
                                              BucketPosition const& initial) const {
     Element found;
-    Bucket const* b = &_buckets[position.bucketId];
     do {
-      found = b->_table[position.position];
+      found = slot(position.bucketId, position.position);
       position.position += step;
-      while (position.position >= b->_nrAlloc) {
-        position.position -= b->_nrAlloc;
+      while (position.position >= slots(position.bucketId)) {
+        position.position -= slots(position.bucketId);
         position.bucketId = (position.bucketId + 1) % _buckets.size();
-        b = &_buckets[position.bucketId];
       }
       if (position == initial) {
         // We are done. Return the last element we have in hand
@@ -251,10 +472,15 @@ class AssocUnique {
 
  public:
   void truncate(CallbackElementFuncType callback) {
-    for (auto& b : _buckets) {
+    for (size_t i = 0; i < _buckets.size(); ++i) {
+      Bucket& b = _buckets[i];
+      Migration& m = _migrations[i];
       if (callback) {
         invokeOnAllElements(callback, b);
+        invokeOnAllElements(callback, m.old);
       }
+      m.old.deallocate();
+      m.remaining = 0;
       b.deallocate();
       b.allocate(initialSize());
     }
@@ -267,8 +493,8 @@ class AssocUnique {
   //////////////////////////////////////////////////////////////////////////////
 
   bool isEmpty() const {
-    for (auto& b : _buckets) {
-      if (b._nrUsed > 0) {
+    for (size_t i = 0; i < _buckets.size(); ++i) {
+      if (_buckets[i]._nrUsed > 0 || _migrations[i].old._nrUsed > 0) {
         return false;
       }
     }
@@ -281,8 +507,8 @@ class AssocUnique {
 
   size_t memoryUsage() const {
     size_t res = 0;
-    for (auto& b : _buckets) {
-      res += b.memoryUsage();
+    for (size_t i = 0; i < _buckets.size(); ++i) {
+      res += _buckets[i].memoryUsage() + _migrations[i].old.memoryUsage();
     }
     return res;
   }
@@ -293,16 +519,16 @@ class AssocUnique {
 
   size_t size() const {
     size_t sum = 0;
-    for (auto& b : _buckets) {
-      sum += static_cast<size_t>(b._nrUsed);
+    for (size_t i = 0; i < _buckets.size(); ++i) {
+      sum += static_cast<size_t>(_buckets[i]._nrUsed + _migrations[i].old._nrUsed);
     }
     return sum;
   }
 
   size_t capacity() const {
     size_t sum = 0;
-    for (auto& b : _buckets) {
-      sum += static_cast<size_t>(b._nrAlloc);
+    for (size_t i = 0; i < _buckets.size(); ++i) {
+      sum += static_cast<size_t>(slots(i));
     }
     return sum;
   }
@@ -312,6 +538,7 @@ class AssocUnique {
   //////////////////////////////////////////////////////////////////////////////
 
   int resize(UserData* userData, size_t size) {
+    finishMigrations();
     size /= _buckets.size();
     for (auto& b : _buckets) {
       if (2 * (2 * size + 1) < 3 * b._nrUsed) {
@@ -334,10 +561,15 @@ class AssocUnique {
   void appendToVelocyPack(VPackBuilder& builder) {
     TRI_ASSERT(builder.isOpenObject());
     builder.add("buckets", VPackValue(VPackValueType::Array));
-    for (auto& b : _buckets) {
+    for (size_t i = 0; i < _buckets.size(); ++i) {
+      Bucket const& b = _buckets[i];
+      Migration const& m = _migrations[i];
       builder.openObject();
       builder.add("nrAlloc", VPackValue(b._nrAlloc));
-      builder.add("nrUsed", VPackValue(b._nrUsed));
+      builder.add("nrUsed", VPackValue(b._nrUsed + m.old._nrUsed));
+      if (m.active()) {
+        builder.add("nrResizing", VPackValue(m.old._nrUsed));
+      }
       builder.close();
     }
     builder.close();  // buckets
@@ -350,30 +582,16 @@ class AssocUnique {
   //////////////////////////////////////////////////////////////////////////////
 
   Element find(UserData* userData, Element const& element) const {
-    uint64_t i = _helper.HashElement(element, true);
-    Bucket const& b = _buckets[i & _bucketsMask];
-
-    uint64_t const n = b._nrAlloc;
-    i = i % n;
-    uint64_t k = i;
-
-    for (; i < n && b._table[i] &&
-           !_helper.IsEqualElementElementByKey(userData, element, b._table[i]);
-         ++i)
-      ;
-    if (i == n) {
-      for (i = 0; i < k && b._table[i] &&
-                  !_helper.IsEqualElementElementByKey(userData, element, b._table[i]);
-           ++i)
-        ;
-    }
+    uint64_t hash = _helper.HashElement(element, true);
 
     // ...........................................................................
     // return whatever we found, this is nullptr if the thing was not found
     // and otherwise a valid pointer
     // ...........................................................................
 
-    return b._table[i];
+    return *lookup(hash & _bucketsMask, hash, [&](Element const& other) {
+      return _helper.IsEqualElementElementByKey(userData, element, other);
+    });
   }
 
   //////////////////////////////////////////////////////////////////////////////
@@ -382,57 +600,15 @@ class AssocUnique {
   //////////////////////////////////////////////////////////////////////////////
 
   Element findByKey(UserData* userData, Key const* key) const {
-    uint64_t hash = _helper.HashKey(key);
-    uint64_t i = hash;
-    uint64_t bucketId = i & _bucketsMask;
-    Bucket const& b = _buckets[static_cast<size_t>(bucketId)];
-
-    uint64_t const n = b._nrAlloc;
-    i = i % n;
-    uint64_t k = i;
-
-    for (; i < n && b._table[i] && !_helper.IsEqualKeyElement(userData, key, b._table[i]); ++i)
-      ;
-    if (i == n) {
-      for (i = 0; i < k && b._table[i] &&
-                  !_helper.IsEqualKeyElement(userData, key, b._table[i]);
-           ++i)
-        ;
-    }
-
-    // ...........................................................................
-    // return whatever we found, this is nullptr if the thing was not found
-    // and otherwise a valid pointer
-    // ...........................................................................
-
-    return b._table[i];
+    return *findByKeyRef(userData, key);
   }
 
   Element* findByKeyRef(UserData* userData, Key const* key) const {
     uint64_t hash = _helper.HashKey(key);
-    uint64_t i = hash;
-    uint64_t bucketId = i & _bucketsMask;
-    Bucket const& b = _buckets[static_cast<size_t>(bucketId)];
-
-    uint64_t const n = b._nrAlloc;
-    i = i % n;
-    uint64_t k = i;
-
-    for (; i < n && b._table[i] && !_helper.IsEqualKeyElement(userData, key, b._table[i]); ++i)
-      ;
-    if (i == n) {
-      for (i = 0; i < k && b._table[i] &&
-                  !_helper.IsEqualKeyElement(userData, key, b._table[i]);
-           ++i)
-        ;
-    }
 
-    // ...........................................................................
-    // return whatever we found, this is nullptr if the thing was not found
-    // and otherwise a valid pointer
-    // ...........................................................................
-
-    return &b._table[i];
+    return lookup(hash & _bucketsMask, hash, [&](Element const& other) {
+      return _helper.IsEqualKeyElement(userData, key, other);
+    });
   }
 
   //////////////////////////////////////////////////////////////////////////////
@@ -445,28 +621,30 @@ class AssocUnique {
   Element findByKey(UserData* userData, Key const* key,
                     BucketPosition& position, uint64_t& hash) const {
     hash = _helper.HashKey(key);
-    uint64_t i = hash;
-    uint64_t bucketId = i & _bucketsMask;
-    Bucket const& b = _buckets[static_cast<size_t>(bucketId)];
+    size_t const bucketId = static_cast<size_t>(hash & _bucketsMask);
+    auto isEqual = [&](Element const& other) {
+      return _helper.IsEqualKeyElement(userData, key, other);
+    };
 
-    uint64_t const n = b._nrAlloc;
-    i = i % n;
-    uint64_t k = i;
-
-    for (; i < n && b._table[i] && !_helper.IsEqualKeyElement(userData, key, b._table[i]); ++i)
-      ;
-    if (i == n) {
-      for (i = 0; i < k && b._table[i] &&
-                  !_helper.IsEqualKeyElement(userData, key, b._table[i]);
-           ++i)
-        ;
-    }
+    Bucket const& b = _buckets[bucketId];
+    uint64_t i = findSlot(b, hash, isEqual);
 
     // if requested, pass the position of the found element back
     // to the caller
-    position.bucketId = static_cast<size_t>(bucketId);
+    position.bucketId = bucketId;
     position.position = i;
 
+    if (!b._table[i]) {
+      Migration const& m = _migrations[bucketId];
+      if (m.active()) {
+        uint64_t j = findSlot(m.old, hash, isEqual);
+        if (m.old._table[j]) {
+          position.position = b._nrAlloc + j;
+          return m.old._table[j];
+        }
+      }
+    }
+
     // ...........................................................................
     // return whatever we found, this is nullptr if the thing was not found
     // and otherwise a valid pointer
@@ -481,12 +659,23 @@ class AssocUnique {
 
   int insert(UserData* userData, Element const& element) {
     uint64_t hash = _helper.HashElement(element, true);
-    Bucket& b = _buckets[hash & _bucketsMask];
+    size_t const bucketId = static_cast<size_t>(hash & _bucketsMask);
+    Bucket& b = _buckets[bucketId];
 
     if (!checkResize(userData, b, 0)) {
       return TRI_ERROR_OUT_OF_MEMORY;
     }
 
+    Migration const& m = _migrations[bucketId];
+    if (m.active()) {
+      auto isEqual = [&](Element const& other) {
+        return _helper.IsEqualElementElementByKey(userData, element, other);
+      };
+      if (m.old._table[findSlot(m.old, hash, isEqual)]) {
+        return TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED;
+      }
+    }
+
     return doInsert(userData, element, b, hash);
   }
 
@@ -503,12 +692,14 @@ class AssocUnique {
   int insertAtPosition(UserData* userData, Element const& element,
                        BucketPosition const& position) {
     Bucket& b = _buckets[position.bucketId];
-    Element const& arrayElement = b._table[position.position];
+    Element const& arrayElement = slot(position.bucketId, position.position);
 
     if (arrayElement) {
       return TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED;
     }
 
+    // empty slots are only handed out for the new table
+    TRI_ASSERT(position.position < b._nrAlloc);
     b._table[position.position] = element;
     b._nrUsed++;
 
@@ -637,84 +828,79 @@ class AssocUnique {
       k = TRI_IncModU64(k, n);
     }
 
-    if (b._nrUsed == 0) {
+    if (b._nrUsed == 0 && !migrationOf(b).active()) {
       resizeInternal(userData, b, initialSize(), true);
     }
   }
 
   //////////////////////////////////////////////////////////////////////////////
-  /// @brief removes an element from the array based on its key,
-  /// returns nullptr if the element
-  /// was not found and the old value, if it was successfully removed
+  /// @brief removes the element that isEqual accepts from a bucket
   //////////////////////////////////////////////////////////////////////////////
 
-  Element removeByKey(UserData* userData, Key const* key) {
-    uint64_t hash = _helper.HashKey(key);
-    uint64_t i = hash;
-    Bucket& b = _buckets[i & _bucketsMask];
-
-    uint64_t const n = b._nrAlloc;
-    i = i % n;
-    uint64_t k = i;
+  template <typename F>
+  Element removeFromBucket(UserData* userData, size_t bucketId, uint64_t hash,
+                           F const& isEqual) {
+    Bucket& b = _buckets[bucketId];
+    Migration& m = _migrations[bucketId];
 
-    for (; i < n && b._table[i] && !_helper.IsEqualKeyElement(userData, key, b._table[i]); ++i)
-      ;
-    if (i == n) {
-      for (i = 0; i < k && b._table[i] &&
-                  !_helper.IsEqualKeyElement(userData, key, b._table[i]);
-           ++i)
-        ;
+    if (m.active()) {
+      migrate(b, m, migrationStep());
     }
 
+    uint64_t i = findSlot(b, hash, isEqual);
     Element old = b._table[i];
 
     if (old) {
       healHole(userData, b, i);
+    } else if (m.active()) {
+      i = findSlot(m.old, hash, isEqual);
+      old = m.old._table[i];
+
+      if (old) {
+        removeFromOld(b, m, i);
+      }
     }
+
     return old;
   }
 
   //////////////////////////////////////////////////////////////////////////////
-  /// @brief removes an element from the array, returns nullptr if the element
+  /// @brief removes an element from the array based on its key,
+  /// returns nullptr if the element
   /// was not found and the old value, if it was successfully removed
   //////////////////////////////////////////////////////////////////////////////
 
-  Element remove(UserData* userData, Element const& element) {
-    uint64_t i = _helper.HashElement(element, true);
-    Bucket& b = _buckets[i & _bucketsMask];
-
-    uint64_t const n = b._nrAlloc;
-    i = i % n;
-    uint64_t k = i;
+  Element removeByKey(UserData* userData, Key const* key) {
+    uint64_t hash = _helper.HashKey(key);
 
-    for (; i < n && b._table[i] &&
-           !_helper.IsEqualElementElement(userData, element, b._table[i]);
-         ++i)
-      ;
-    if (i == n) {
-      for (i = 0; i < k && b._table[i] &&
-                  !_helper.IsEqualElementElement(userData, element, b._table[i]);
-           ++i)
-        ;
-    }
+    return removeFromBucket(userData, hash & _bucketsMask, hash, [&](Element const& other) {
+      return _helper.IsEqualKeyElement(userData, key, other);
+    });
+  }
 
-    Element old = b._table[i];
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief removes an element from the array, returns nullptr if the element
+  /// was not found and the old value, if it was successfully removed
+  //////////////////////////////////////////////////////////////////////////////
 
-    if (old) {
-      healHole(userData, b, i);
-    }
+  Element remove(UserData* userData, Element const& element) {
+    uint64_t hash = _helper.HashElement(element, true);
 
-    return old;
+    return removeFromBucket(userData, hash & _bucketsMask, hash, [&](Element const& other) {
+      return _helper.IsEqualElementElement(userData, element, other);
+    });
   }
 
   /// @brief a method to iterate over all elements in the hash. this method
   /// can NOT be used for deleting elements
   void invokeOnAllElements(CallbackElementFuncType const& callback) {
-    for (auto& b : _buckets) {
+    for (size_t i = 0; i < _buckets.size(); ++i) {
+      Bucket& b = _buckets[i];
       if (b._table == nullptr) {
         continue;
       }
-      if (!invokeOnAllElements(callback, b)) {
+      if (!invokeOnAllElements(callback, b) ||
+          !invokeOnAllElements(callback, _migrations[i].old)) {
         return;
       }
     }
@@ -745,6 +931,7 @@ class AssocUnique {
   //////////////////////////////////////////////////////////////////////////////
 
   void invokeOnAllElementsForRemoval(CallbackElementFuncType callback) {
+    finishMigrations();
     for (auto& b : _buckets) {
       if (b._table == nullptr || b._nrUsed == 0) {
         continue;
@@ -786,10 +973,7 @@ class AssocUnique {
 
       if (position.bucketId == SIZE_MAX) {
         // first call, now fill total
-        total = 0;
-        for (auto const& b : _buckets) {
-          total += b._nrUsed;
-        }
+        total = size();
 
         if (total == 0) {
           return Element();
@@ -803,15 +987,15 @@ class AssocUnique {
     }
 
     while (true) {
-      Bucket const& b = _buckets[position.bucketId];
-      uint64_t const n = b._nrAlloc;
+      uint64_t const n = slots(position.bucketId);
 
-      for (; position.position < n && !b._table[position.position]; ++position.position)
+      for (; position.position < n && !slot(position.bucketId, position.position);
+           ++position.position)
         ;
 
       if (position.position != n) {
         // found an element
-        Element found = b._table[position.position];
+        Element found = slot(position.bucketId, position.position);
 
         // move forward the position indicator one more time
         if (++position.position == n) {
@@ -851,13 +1035,12 @@ class AssocUnique {
       }
 
       position.bucketId = _buckets.size() - 1;
-      position.position = _buckets[position.bucketId]._nrAlloc - 1;
+      position.position = slots(position.bucketId) - 1;
     }
 
-    Bucket const* b = &_buckets[position.bucketId];
     Element found;
     do {
-      found = b->_table[position.position];
+      found = slot(position.bucketId, position.position);
 
       if (position.position == 0) {
         if (position.bucketId == 0) {
@@ -867,8 +1050,7 @@ class AssocUnique {
         }
 
         --position.bucketId;
-        b = &_buckets[position.bucketId];
-        position.position = b->_nrAlloc - 1;
+        position.position = slots(position.bucketId) - 1;
       } else {
         --position.position;
       }
@@ -892,12 +1074,8 @@ class AssocUnique {
     }
     if (step == 0) {
       // Initialize
-      uint64_t used = 0;
-      total = 0;
-      for (auto& b : _buckets) {
-        total += b._nrAlloc;
-        used += b._nrUsed;
-      }
+      uint64_t used = size();
+      total = capacity();
       if (used == 0) {
         return Element();
       }
@@ -912,14 +1090,14 @@ class AssocUnique {
             initialPositionNr = RandomGenerator::interval(UINT32_MAX) % total;
           }
           for (size_t i = 0; i < _buckets.size(); ++i) {
-            if (initialPositionNr < _buckets[i]._nrAlloc) {
+            if (initialPositionNr < slots(i)) {
               position.bucketId = i;
               position.position = initialPositionNr;
               initialPosition.bucketId = i;
               initialPosition.position = initialPositionNr;
               break;
             }
-            initialPositionNr -= _buckets[i]._nrAlloc;
+            initialPositionNr -= slots(i);
           }
           break;
         }
@@ -90,13 +90,18 @@ class UniqueInserterTask final : public LocalTask {
     try {
       Bucket& b = (*_buckets)[static_cast<size_t>(_i)];
 
+      // make room for the documents of all partitioners at once
+      uint64_t expected = 0;
+      for (auto const& it : (*_allBuckets)[_i]) {
+        expected += it.size();
+      }
+      if (!_checkResize(_userData, b, expected)) {
+        _queue->setStatus(TRI_ERROR_OUT_OF_MEMORY);
+        _queue->join();
+        return;
+      }
+
       for (auto const& it : (*_allBuckets)[_i]) {
-        uint64_t expected = it.size();
-        if (!_checkResize(_userData, b, expected)) {
-          _queue->setStatus(TRI_ERROR_OUT_OF_MEMORY);
-          _queue->join();
-          return;
-        }
         for (auto const& it2 : it) {
           int status = _doInsert(_userData, it2.first, b, it2.second);
           if (status != TRI_ERROR_NO_ERROR) {
@@ -0,0 +1,105 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "HyperLogLog.h"
+
+#include "Basics/fasthash.h"
+
+#include <cmath>
+
+using namespace arangodb::basics;
+
+namespace {
+constexpr uint64_t hashSeed = 0x9ae16a3b2f90404fULL;
+
+// highest rank that fits into the bits not used for the register index
+constexpr uint8_t maxRank = 64 - HyperLogLog::kPrecision + 1;
+}
+
+HyperLogLog::HyperLogLog() { clear(); }
+
+void HyperLogLog::insert(uint64_t value) noexcept {
+  uint64_t hash = fasthash64_uint64(value, ::hashSeed);
+  size_t index = static_cast<size_t>(hash >> (64 - kPrecision));
+
+  // rank is the position of the first set bit in the remaining bits. the
+  // sentinel bit caps it for an all-zero remainder
+  uint64_t remainder = (hash << kPrecision) | (uint64_t(1) << (kPrecision - 1));
+  uint8_t rank = 1;
+  while ((remainder & (uint64_t(1) << 63)) == 0) {
+    remainder <<= 1;
+    ++rank;
+  }
+
+  if (rank > _registers[index]) {
+    _registers[index] = rank;
+  }
+}
+
+void HyperLogLog::merge(HyperLogLog const& other) noexcept {
+  for (size_t i = 0; i < kRegisters; ++i) {
+    if (other._registers[i] > _registers[i]) {
+      _registers[i] = other._registers[i];
+    }
+  }
+}
+
+void HyperLogLog::clear() noexcept { _registers.fill(0); }
+
+double HyperLogLog::estimate() const noexcept {
+  double const m = static_cast<double>(kRegisters);
+  double const alpha = 0.7213 / (1.0 + 1.079 / m);
+
+  double sum = 0.0;
+  size_t zeros = 0;
+  for (uint8_t r : _registers) {
+    sum += std::ldexp(1.0, -static_cast<int>(r));
+    if (r == 0) {
+      ++zeros;
+    }
+  }
+
+  double estimate = alpha * m * m / sum;
+  if (estimate <= 2.5 * m && zeros > 0) {
+    // small range correction: linear counting is more accurate here
+    estimate = m * std::log(m / static_cast<double>(zeros));
+  }
+  // 64 bit hashes do not need a large range correction
+  return estimate;
+}
+
+void HyperLogLog::serialize(std::string& output) const {
+  output.append(reinterpret_cast<char const*>(_registers.data()), kRegisters);
+}
+
+bool HyperLogLog::deserialize(char const* data, size_t length) {
+  if (length != kRegisters) {
+    return false;
+  }
+  for (size_t i = 0; i < kRegisters; ++i) {
+    if (static_cast<uint8_t>(data[i]) > ::maxRank) {
+      return false;
+    }
+  }
+  for (size_t i = 0; i < kRegisters; ++i) {
+    _registers[i] = static_cast<uint8_t>(data[i]);
+  }
+  return true;
+}
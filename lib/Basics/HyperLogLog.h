@@ -0,0 +1,77 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_BASICS_HYPER_LOG_LOG_H
+#define ARANGODB_BASICS_HYPER_LOG_LOG_H 1
+
+#include "Basics/Common.h"
+
+#include <array>
+
+namespace arangodb {
+namespace basics {
+
+/// @brief HyperLogLog sketch to estimate the number of distinct values.
+/// Two sketches can be merged into a sketch of the union of their inputs,
+/// which allows combining the sketches of several shards without shipping
+/// the values themselves. Values can only be added, never removed.
+/// This class is not thread-safe!
+class HyperLogLog {
+ public:
+  /// @brief number of hash bits used to select a register
+  static constexpr uint32_t kPrecision = 12;
+
+  /// @brief number of registers, standard error is 1.04 / sqrt(kRegisters)
+  static constexpr size_t kRegisters = size_t(1) << kPrecision;
+
+  HyperLogLog();
+
+  /// @brief add a value. the value is hashed internally
+  void insert(uint64_t value) noexcept;
+
+  /// @brief merge another sketch into this one
+  void merge(HyperLogLog const& other) noexcept;
+
+  /// @brief reset to the empty sketch
+  void clear() noexcept;
+
+  /// @brief estimated number of distinct values inserted
+  double estimate() const noexcept;
+
+  /// @brief append the registers to the output
+  void serialize(std::string& output) const;
+
+  /// @brief restore the registers from serialized data. returns false and
+  /// leaves the sketch untouched if the data has the wrong size or contains
+  /// register values that insert() cannot produce. all valid register
+  /// values are below 0x80, so serialized data is valid UTF-8
+  bool deserialize(char const* data, size_t length);
+
+  /// @brief number of bytes produced by serialize()
+  static constexpr size_t serializedSize() { return kRegisters; }
+
+ private:
+  std::array<uint8_t, kRegisters> _registers;
+};
+
+}  // namespace basics
+}  // namespace arangodb
+
+#endif
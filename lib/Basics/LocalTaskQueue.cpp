@@ -27,6 +27,8 @@
 #include "Basics/ConditionLocker.h"
 #include "Basics/Exceptions.h"
 #include "Basics/MutexLocker.h"
+#include "Basics/ScopeGuard.h"
+#include "Basics/system-functions.h"
 #include "Logger/Logger.h"
 
 using namespace arangodb::basics;
@@ -89,14 +91,17 @@ void LocalCallbackTask::dispatch() {
 /// @brief create a queue
 ////////////////////////////////////////////////////////////////////////////////
 
-LocalTaskQueue::LocalTaskQueue(PostFn poster)
+LocalTaskQueue::LocalTaskQueue(PostFn poster, size_t concurrency)
     : _poster(poster),
+      _concurrency(concurrency > 0 ? concurrency : (std::max)(TRI_numberProcessors(), size_t(1))),
       _queue(),
       _callbackQueue(),
       _condition(),
       _mutex(),
       _missing(0),
       _started(0),
+      _runners(0),
+      _dispatching(false),
       _status(TRI_ERROR_NO_ERROR) {}
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -120,8 +125,25 @@ void LocalTaskQueue::stopTask() {
 //////////////////////////////////////////////////////////////////////////////
 
 void LocalTaskQueue::enqueue(std::shared_ptr<LocalTask> task) {
-  MUTEX_LOCKER(locker, _mutex);
-  _queue.push(task);
+  bool startRunner = false;
+  {
+    CONDITION_LOCKER(guard, _condition);
+    MUTEX_LOCKER(locker, _mutex);
+    _queue.push(task);
+
+    if (_dispatching) {
+      if (_poster && _runners < _concurrency) {
+        ++_runners;
+        startRunner = true;
+      }
+      // the waiting thread takes the task if no runner does
+      _condition.signal();
+    }
+  }
+
+  if (startRunner) {
+    postRunner(task);
+  }
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -141,6 +163,51 @@ void LocalTaskQueue::enqueueCallback(std::shared_ptr<LocalCallbackTask> task) {
 
 void LocalTaskQueue::post(std::function<void()> fn) { _poster(fn); }
 
+bool LocalTaskQueue::runNext(bool runner) {
+  std::shared_ptr<LocalTask> task;
+  {
+    CONDITION_LOCKER(guard, _condition);
+    MUTEX_LOCKER(locker, _mutex);
+
+    if (_queue.empty() || _status != TRI_ERROR_NO_ERROR) {
+      if (runner) {
+        // decided under the lock, so enqueue() knows to post a new runner
+        TRI_ASSERT(_runners > 0);
+        --_runners;
+      }
+      return false;
+    }
+
+    task = std::move(_queue.front());
+    _queue.pop();
+    ++_missing;
+    ++_started;
+  }
+
+  // the task joins itself
+  try {
+    task->run();
+  } catch (...) {
+    stopTask();
+    throw;
+  }
+  stopTask();
+  return true;
+}
+
+void LocalTaskQueue::postRunner(std::shared_ptr<LocalTask> const& task) {
+  try {
+    post([task, this]() {
+      while (runNext(true)) {
+      }
+    });
+  } catch (...) {
+    // the waiting thread runs the tasks instead
+    CONDITION_LOCKER(guard, _condition);
+    --_runners;
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief join a single task. reduces the number of waiting tasks and wakes
 /// up the queue's dispatchAndWait() routine
@@ -162,19 +229,42 @@ void LocalTaskQueue::join() {
 void LocalTaskQueue::dispatchAndWait() {
   // regular task loop
   if (!_queue.empty()) {
+    std::vector<std::shared_ptr<LocalTask>> runners;
+    {
+      CONDITION_LOCKER(guard, _condition);
+      MUTEX_LOCKER(locker, _mutex);
+      _dispatching = true;
+
+      // runners for all queued tasks but one, which this thread takes
+      if (_poster) {
+        while (_runners < _concurrency && _runners + 1 < _queue.size()) {
+          ++_runners;
+          runners.emplace_back(_queue.front());
+        }
+      }
+    }
+
+    TRI_DEFER({
+      CONDITION_LOCKER(guard, _condition);
+      _dispatching = false;
+    });
+
+    for (auto const& task : runners) {
+      postRunner(task);
+    }
+
     while (true) {
+      if (runNext(false)) {
+        continue;
+      }
+
       CONDITION_LOCKER(guard, _condition);
 
       {
         MUTEX_LOCKER(locker, _mutex);
-        // dispatch all newly queued tasks
-        if (_status == TRI_ERROR_NO_ERROR) {
-          while (!_queue.empty()) {
-            auto task = _queue.front();
-            task->dispatch();
-            _queue.pop();
-            ++_missing;
-          }
+        if (!_queue.empty() && _status == TRI_ERROR_NO_ERROR) {
+          // queued by a task in the meantime
+          continue;
         }
       }
 
@@ -92,7 +92,13 @@ class LocalTaskQueue {
   LocalTaskQueue(LocalTaskQueue const&) = delete;
   LocalTaskQueue& operator=(LocalTaskQueue const&) = delete;
 
-  explicit LocalTaskQueue(PostFn poster);
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief create a queue. tasks are run by up to concurrency runners posted
+  /// with poster (0 means one per processor), and by the thread waiting in
+  /// dispatchAndWait(). without a poster, that thread runs all tasks
+  //////////////////////////////////////////////////////////////////////////////
+
+  explicit LocalTaskQueue(PostFn poster, size_t concurrency = 0);
 
   ~LocalTaskQueue();
 
@@ -100,7 +106,8 @@ class LocalTaskQueue {
   void stopTask();
 
   //////////////////////////////////////////////////////////////////////////////
-  /// @brief enqueue a task to be run
+  /// @brief enqueue a task to be run. tasks enqueued while the queue is
+  /// dispatched are picked up by the next free runner
   //////////////////////////////////////////////////////////////////////////////
 
   void enqueue(std::shared_ptr<LocalTask>);
@@ -129,7 +136,8 @@ class LocalTaskQueue {
   //////////////////////////////////////////////////////////////////////////////
   /// @brief dispatch all tasks, including those that are queued while running,
   /// and wait for all tasks to join; then dispatch all callback tasks and wait
-  /// for them to join
+  /// for them to join. the calling thread runs tasks itself while there are
+  /// queued tasks no runner has taken yet
   //////////////////////////////////////////////////////////////////////////////
 
   void dispatchAndWait();
@@ -146,6 +154,21 @@ class LocalTaskQueue {
 
   int status();
 
+ private:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief takes the next task and runs it. returns false if there is none,
+  /// or if the queue has failed. a runner that gets false is done
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool runNext(bool runner);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief posts a runner. the task keeps the queue alive until the runner
+  /// is done, even if it only starts after dispatchAndWait() has returned
+  //////////////////////////////////////////////////////////////////////////////
+
+  void postRunner(std::shared_ptr<LocalTask> const& task);
+
  private:
   //////////////////////////////////////////////////////////////////////////////
   /// @brief post task to scheduler/io_service
@@ -153,6 +176,12 @@ class LocalTaskQueue {
 
   PostFn _poster;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief maximum number of runners
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t const _concurrency;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief internal task queue
   //////////////////////////////////////////////////////////////////////////////
@@ -189,6 +218,18 @@ class LocalTaskQueue {
 
   size_t _started;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief number of posted runners that are not done
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t _runners;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief whether dispatchAndWait() is running the regular tasks
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool _dispatching;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief overall status of queue tasks
   //////////////////////////////////////////////////////////////////////////////
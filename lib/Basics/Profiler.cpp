@@ -0,0 +1,372 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Profiler.h"
+
+#include "Basics/ScopeGuard.h"
+#include "Basics/voc-errors.h"
+
+#ifdef __linux__
+#include <cxxabi.h>
+#include <dirent.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#ifdef ARANGODB_HAVE_JEMALLOC
+extern "C" int mallctl(char const* name, void* oldp, size_t* oldlenp,
+                       void* newp, size_t newlen);
+#endif
+
+using namespace arangodb;
+
+namespace {
+
+/// @brief set while a CPU profile is taken
+std::atomic<bool> cpuProfileRunning(false);
+
+#ifdef __linux__
+
+constexpr int maxFrames = 64;
+
+/// @brief the frames of the signal handler and of the signal trampoline,
+/// which are on top of every sample
+constexpr int skipFrames = 2;
+
+/// @brief how long to wait for a thread to take its sample. threads that
+/// are stopped, e.g. by a debugger, do not handle the signal in time
+constexpr std::chrono::milliseconds sampleTimeout(10);
+
+/// @brief states of the pending sample besides the id of the thread it is
+/// requested from
+constexpr pid_t sampleIdle = 0;
+constexpr pid_t sampleWriting = -1;
+constexpr pid_t sampleDone = -2;
+
+/// @brief the one pending sample. the profiling thread signals one thread
+/// at a time and waits for it. only the handler running on the requested
+/// thread may write the frames, a late handler of an earlier thread leaves
+/// them alone
+struct Sample {
+  std::atomic<pid_t> state{sampleIdle};
+  void* frames[maxFrames];
+  int depth = 0;
+};
+Sample sample;
+
+std::once_flag handlerInstalled;
+
+pid_t currentThreadId() { return static_cast<pid_t>(syscall(SYS_gettid)); }
+
+void sampleHandler(int, siginfo_t*, void*) {
+  int const savedErrno = errno;
+  pid_t expected = currentThreadId();
+  if (sample.state.compare_exchange_strong(expected, sampleWriting)) {
+    sample.depth = backtrace(sample.frames, maxFrames);
+    sample.state.store(sampleDone);
+  }
+  errno = savedErrno;
+}
+
+void installHandler() {
+  // the first backtrace loads the unwinder, which must not happen in a
+  // signal handler
+  void* frames[1];
+  backtrace(frames, 1);
+
+  struct sigaction action;
+  memset(&action, 0, sizeof(action));
+  sigemptyset(&action.sa_mask);
+  action.sa_sigaction = sampleHandler;
+  action.sa_flags = SA_SIGINFO | SA_RESTART;
+  // the handler stays installed, a signal that arrives after the profile
+  // was taken must not terminate the process
+  sigaction(profiler::sampleSignal(), &action, nullptr);
+}
+
+struct ThreadInfo {
+  pid_t tid;
+  std::string name;
+  bool running;
+};
+
+/// @brief the name and the state of a thread of this process, from
+/// /proc/self/task/<tid>/stat, which is "<tid> (<name>) <state> ..."
+bool readThread(pid_t tid, ThreadInfo& info) {
+  char path[64];
+  snprintf(path, sizeof(path), "/proc/self/task/%d/stat", static_cast<int>(tid));
+  int fd = open(path, O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return false;
+  }
+  char buffer[512];
+  ssize_t n = read(fd, buffer, sizeof(buffer) - 1);
+  close(fd);
+  if (n <= 0) {
+    return false;
+  }
+  buffer[n] = '\0';
+
+  // the name may contain parentheses itself
+  char const* nameStart = strchr(buffer, '(');
+  char const* nameEnd = strrchr(buffer, ')');
+  if (nameStart == nullptr || nameEnd == nullptr || nameEnd < nameStart ||
+      nameEnd[1] != ' ') {
+    return false;
+  }
+  info.tid = tid;
+  info.name.assign(nameStart + 1, nameEnd - nameStart - 1);
+  info.running = nameEnd[2] == 'R';
+  return true;
+}
+
+void listThreads(std::vector<pid_t>& threads) {
+  threads.clear();
+  DIR* dir = opendir("/proc/self/task");
+  if (dir == nullptr) {
+    return;
+  }
+  while (struct dirent* entry = readdir(dir)) {
+    pid_t tid = static_cast<pid_t>(atoi(entry->d_name));
+    if (tid > 0) {
+      threads.push_back(tid);
+    }
+  }
+  closedir(dir);
+}
+
+/// @brief signal the thread and wait for its sample. returns false if the
+/// thread did not take it in time, or is gone
+bool takeSample(pid_t pid, pid_t tid) {
+  sample.state.store(tid);
+  if (syscall(SYS_tgkill, pid, tid, profiler::sampleSignal()) == 0) {
+    auto const deadline = std::chrono::steady_clock::now() + ::sampleTimeout;
+    while (std::chrono::steady_clock::now() < deadline) {
+      if (sample.state.load() == sampleDone) {
+        return true;
+      }
+      std::this_thread::yield();
+    }
+  }
+
+  pid_t expected = tid;
+  if (sample.state.compare_exchange_strong(expected, sampleIdle)) {
+    return false;
+  }
+  // the handler has started in the meantime
+  while (sample.state.load() != sampleDone) {
+    std::this_thread::yield();
+  }
+  return true;
+}
+
+/// @brief the name of a frame, without the semicolons that separate frames
+/// in the collapsed format
+std::string symbolize(void* address) {
+  std::string name;
+  Dl_info info;
+  if (dladdr(address, &info) == 0) {
+    memset(&info, 0, sizeof(info));
+  }
+  if (info.dli_sname != nullptr) {
+    int status = 0;
+    char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+    if (status == 0 && demangled != nullptr) {
+      name = demangled;
+    } else {
+      name = info.dli_sname;
+    }
+    free(demangled);
+  } else {
+    char buffer[64];
+    if (info.dli_fname != nullptr && info.dli_fbase != nullptr) {
+      // the offset within the module, for addr2line
+      char const* module = strrchr(info.dli_fname, '/');
+      name = module == nullptr ? info.dli_fname : module + 1;
+      snprintf(buffer, sizeof(buffer), "+0x%zx",
+               static_cast<size_t>(static_cast<char*>(address) -
+                                   static_cast<char*>(info.dli_fbase)));
+    } else {
+      snprintf(buffer, sizeof(buffer), "0x%zx", reinterpret_cast<size_t>(address));
+    }
+    name.append(buffer);
+  }
+  for (auto& c : name) {
+    if (c == ';' || c == '\n') {
+      c = ':';
+    }
+  }
+  return name;
+}
+
+#endif
+
+#ifdef ARANGODB_HAVE_JEMALLOC
+Result mallctlError(int res, char const* name) {
+  switch (res) {
+    case 0:
+      return Result();
+    case ENOENT:
+      return Result(TRI_ERROR_NOT_IMPLEMENTED,
+                    "jemalloc was built without heap profiling");
+    case EFAULT:
+    case EINVAL:
+      return Result(TRI_ERROR_BAD_PARAMETER,
+                    "heap profiling is not enabled, start with "
+                    "MALLOC_CONF=prof:true");
+    default:
+      return Result(TRI_ERROR_INTERNAL, std::string("jemalloc ") + name +
+                                            " failed: " + strerror(res));
+  }
+}
+#endif
+
+}  // namespace
+
+#ifdef __linux__
+int profiler::sampleSignal() { return SIGRTMIN + 5; }
+#endif
+
+Result profiler::sampleCpu(CpuProfileOptions const& options, std::string& result) {
+#ifdef __linux__
+  if (options.frequency == 0 || options.frequency > 1000) {
+    return Result(TRI_ERROR_BAD_PARAMETER,
+                  "sampling frequency must be between 1 and 1000");
+  }
+  bool expected = false;
+  if (!::cpuProfileRunning.compare_exchange_strong(expected, true)) {
+    return Result(TRI_ERROR_LOCKED, "a CPU profile is already being taken");
+  }
+  TRI_DEFER(::cpuProfileRunning.store(false));
+
+  std::call_once(::handlerInstalled, ::installHandler);
+
+  pid_t const pid = getpid();
+  pid_t const self = ::currentThreadId();
+  auto const interval = std::chrono::microseconds(1000000 / options.frequency);
+  auto const end = std::chrono::steady_clock::now() + options.duration;
+
+  // counts of distinct stacks, innermost frame first
+  std::map<std::pair<std::string, std::vector<void*>>, uint64_t> stacks;
+  std::vector<pid_t> threads;
+  ::ThreadInfo info;
+
+  auto next = std::chrono::steady_clock::now();
+  while (next < end) {
+    ::listThreads(threads);
+    for (pid_t tid : threads) {
+      if (tid == self || !::readThread(tid, info) || !(options.idle || info.running)) {
+        continue;
+      }
+      if (!::takeSample(pid, tid)) {
+        continue;
+      }
+      if (::sample.depth > ::skipFrames) {
+        std::vector<void*> frames(::sample.frames + ::skipFrames,
+                                  ::sample.frames + ::sample.depth);
+        ++stacks[std::make_pair(info.name, std::move(frames))];
+      }
+      ::sample.state.store(::sampleIdle);
+    }
+
+    next += interval;
+    auto const now = std::chrono::steady_clock::now();
+    if (next < now) {
+      // sampling takes longer than the interval, skip the missed samples
+      next = now;
+    } else {
+      std::this_thread::sleep_until(next);
+    }
+  }
+
+  // stacks that differ only in the addresses within the same functions
+  // are merged
+  std::unordered_map<void*, std::string> names;
+  std::map<std::string, uint64_t> collapsed;
+  for (auto const& it : stacks) {
+    std::string line = it.first.first;
+    auto const& frames = it.first.second;
+    for (auto frame = frames.rbegin(); frame != frames.rend(); ++frame) {
+      auto name = names.find(*frame);
+      if (name == names.end()) {
+        name = names.emplace(*frame, ::symbolize(*frame)).first;
+      }
+      line.push_back(';');
+      line.append(name->second);
+    }
+    collapsed[line] += it.second;
+  }
+  for (auto const& it : collapsed) {
+    result.append(it.first);
+    result.push_back(' ');
+    result.append(std::to_string(it.second));
+    result.push_back('\n');
+  }
+  return Result();
+#else
+  return Result(TRI_ERROR_NOT_IMPLEMENTED,
+                "CPU profiles are only supported on Linux");
+#endif
+}
+
+Result profiler::heapProfileActive(bool& active) {
+#ifdef ARANGODB_HAVE_JEMALLOC
+  size_t size = sizeof(active);
+  return ::mallctlError(mallctl("prof.active", &active, &size, nullptr, 0),
+                        "prof.active");
+#else
+  return Result(TRI_ERROR_NOT_IMPLEMENTED,
+                "heap profiles need arangod to be built with jemalloc");
+#endif
+}
+
+Result profiler::setHeapProfileActive(bool active) {
+#ifdef ARANGODB_HAVE_JEMALLOC
+  return ::mallctlError(mallctl("prof.active", nullptr, nullptr, &active, sizeof(active)),
+                        "prof.active");
+#else
+  return Result(TRI_ERROR_NOT_IMPLEMENTED,
+                "heap profiles need arangod to be built with jemalloc");
+#endif
+}
+
+Result profiler::dumpHeapProfile(std::string const& filename) {
+#ifdef ARANGODB_HAVE_JEMALLOC
+  char const* name = filename.c_str();
+  return ::mallctlError(mallctl("prof.dump", nullptr, nullptr, &name, sizeof(name)),
+                        "prof.dump");
+#else
+  return Result(TRI_ERROR_NOT_IMPLEMENTED,
+                "heap profiles need arangod to be built with jemalloc");
+#endif
+}
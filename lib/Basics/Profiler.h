@@ -0,0 +1,74 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_BASICS_PROFILER_H
+#define ARANGODB_BASICS_PROFILER_H 1
+
+#include "Basics/Common.h"
+#include "Basics/Result.h"
+
+#include <chrono>
+
+namespace arangodb {
+
+/// @brief on-demand profiling of the running process. nothing is recorded
+/// until a profile is requested, so the profilers cost nothing otherwise
+namespace profiler {
+
+struct CpuProfileOptions {
+  /// @brief how long to sample
+  std::chrono::milliseconds duration{10000};
+  /// @brief samples per second and thread. the default of 99 avoids
+  /// sampling in lockstep with work that runs every few milliseconds
+  uint32_t frequency = 99;
+  /// @brief also sample threads that are not running, e.g. ones waiting for
+  /// a lock or for I/O. otherwise only threads on a CPU are sampled
+  bool idle = false;
+};
+
+/// @brief sample the stacks of the threads of the process, and append them
+/// to result in the collapsed format of the flame graph tools. there is one
+/// line per distinct stack: the thread name, the frames from the outermost
+/// one on, separated by semicolons, and the number of samples. frames that
+/// cannot be symbolized are written as module+offset, for addr2line. only
+/// one CPU profile can be taken at a time. only implemented on Linux
+Result sampleCpu(CpuProfileOptions const& options, std::string& result);
+
+#ifdef __linux__
+/// @brief the real-time signal that interrupts a thread to sample its
+/// stack. threads block all other signals, but not this one
+int sampleSignal();
+#endif
+
+/// @brief whether jemalloc currently samples allocations for heap profiles
+Result heapProfileActive(bool& active);
+
+/// @brief start or stop sampling allocations for heap profiles. this needs
+/// a jemalloc built with profiling, and profiling enabled at startup
+/// (MALLOC_CONF=prof:true, which the bundled jemalloc has by default)
+Result setHeapProfileActive(bool active);
+
+/// @brief write a heap profile in the format of jeprof to the file
+Result dumpHeapProfile(std::string const& filename);
+
+}  // namespace profiler
+}  // namespace arangodb
+
+#endif
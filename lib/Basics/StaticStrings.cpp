@@ -76,6 +76,10 @@ std::string const StaticStrings::ReplicationHeaderFromPresent(
     "x-arango-replication-frompresent");
 std::string const StaticStrings::ReplicationHeaderActive(
     "x-arango-replication-active");
+std::string const StaticStrings::ReplicationHeaderCompression(
+    "x-arango-replication-compression");
+std::string const StaticStrings::ReplicationHeaderUncompressedSize(
+    "x-arango-replication-uncompressed-size");
 
 // database and collection names
 std::string const StaticStrings::SystemDatabase("_system");
@@ -136,6 +140,7 @@ std::string const StaticStrings::AccessControlRequestHeaders(
     "access-control-request-headers");
 std::string const StaticStrings::Allow("allow");
 std::string const StaticStrings::AllowDirtyReads("x-arango-allow-dirty-read");
+std::string const StaticStrings::AppliedTimestamp("x-arango-applied-timestamp");
 std::string const StaticStrings::Async("x-arango-async");
 std::string const StaticStrings::AsyncId("x-arango-async-id");
 std::string const StaticStrings::Authorization("authorization");
@@ -169,18 +174,23 @@ std::string const StaticStrings::NoSniff("nosniff");
 std::string const StaticStrings::Origin("origin");
 std::string const StaticStrings::PotentialDirtyRead(
     "x-arango-potential-dirty-read");
+std::string const StaticStrings::ReadTimestamp("x-arango-read-timestamp");
 std::string const StaticStrings::RequestForwardedTo(
     "x-arango-request-forwarded-to");
 std::string const StaticStrings::ResponseCode("x-arango-response-code");
 std::string const StaticStrings::Server("server");
 std::string const StaticStrings::TransactionBody("x-arango-trx-body");
 std::string const StaticStrings::TransactionId("x-arango-trx-id");
+std::string const StaticStrings::TransferEncoding("transfer-encoding");
+std::string const StaticStrings::Vary("vary");
 
 std::string const StaticStrings::Unlimited = "unlimited";
 std::string const StaticStrings::WwwAuthenticate("www-authenticate");
 std::string const StaticStrings::XContentTypeOptions("x-content-type-options");
 std::string const StaticStrings::XArangoNoLock("x-arango-nolock");
 std::string const StaticStrings::XArangoFrontend("x-arango-frontend");
+std::string const StaticStrings::XArangoLowPriority("x-arango-low-priority");
+std::string const StaticStrings::XArangoTrace("x-arango-trace");
 
 // mime types
 std::string const StaticStrings::MimeTypeJson(
@@ -75,6 +75,8 @@ class StaticStrings {
   static std::string const ReplicationHeaderLastTick;
   static std::string const ReplicationHeaderFromPresent;
   static std::string const ReplicationHeaderActive;
+  static std::string const ReplicationHeaderCompression;
+  static std::string const ReplicationHeaderUncompressedSize;
 
   // database and collection names
   static std::string const SystemDatabase;
@@ -129,6 +131,7 @@ class StaticStrings {
   static std::string const AccessControlRequestHeaders;
   static std::string const Allow;
   static std::string const AllowDirtyReads;
+  static std::string const AppliedTimestamp;
   static std::string const Async;
   static std::string const AsyncId;
   static std::string const Authorization;
@@ -157,16 +160,21 @@ class StaticStrings {
   static std::string const NoSniff;
   static std::string const Origin;
   static std::string const PotentialDirtyRead;
+  static std::string const ReadTimestamp;
   static std::string const RequestForwardedTo;
   static std::string const ResponseCode;
   static std::string const Server;
   static std::string const TransactionBody;
   static std::string const TransactionId;
+  static std::string const TransferEncoding;
+  static std::string const Vary;
   static std::string const Unlimited;
   static std::string const WwwAuthenticate;
   static std::string const XContentTypeOptions;
   static std::string const XArangoNoLock;
   static std::string const XArangoFrontend;
+  static std::string const XArangoLowPriority;
+  static std::string const XArangoTrace;
 
   // mime types
   static std::string const MimeTypeJson;
@@ -163,8 +163,9 @@ void TRI_FreeStringBuffer(TRI_string_buffer_t* self) {
   TRI_Free(self);
 }
 
-/// @brief compress the string buffer using deflate
-int TRI_DeflateStringBuffer(TRI_string_buffer_t* self, size_t bufferSize) {
+/// @brief compress the string buffer, windowBits selects the wrapper
+static int CompressStringBuffer(TRI_string_buffer_t* self, size_t bufferSize,
+                                int windowBits) {
   TRI_string_buffer_t deflated;
   char const* ptr;
   char const* end;
@@ -177,7 +178,8 @@ int TRI_DeflateStringBuffer(TRI_string_buffer_t* self, size_t bufferSize) {
   strm.opaque = Z_NULL;
 
   // initialize deflate procedure
-  res = deflateInit(&strm, Z_DEFAULT_COMPRESSION);
+  res = deflateInit2(&strm, Z_DEFAULT_COMPRESSION, Z_DEFLATED, windowBits, 8,
+                     Z_DEFAULT_STRATEGY);
 
   if (res != Z_OK) {
     return TRI_ERROR_OUT_OF_MEMORY;
@@ -246,6 +248,16 @@ int TRI_DeflateStringBuffer(TRI_string_buffer_t* self, size_t bufferSize) {
   return TRI_ERROR_NO_ERROR;
 }
 
+/// @brief compress the string buffer using deflate
+int TRI_DeflateStringBuffer(TRI_string_buffer_t* self, size_t bufferSize) {
+  return CompressStringBuffer(self, bufferSize, MAX_WBITS);
+}
+
+/// @brief compress the string buffer using deflate, with a gzip wrapper
+int TRI_GzipStringBuffer(TRI_string_buffer_t* self, size_t bufferSize) {
+  return CompressStringBuffer(self, bufferSize, 16 + MAX_WBITS);
+}
+
 /// @brief ensure the string buffer has a specific capacity
 int TRI_ReserveStringBuffer(TRI_string_buffer_t* self, size_t const length) {
   if (length > 0) {
@@ -72,6 +72,9 @@ void TRI_FreeStringBuffer(TRI_string_buffer_t*);
 /// @brief compress the string buffer using deflate
 int TRI_DeflateStringBuffer(TRI_string_buffer_t*, size_t);
 
+/// @brief compress the string buffer using deflate, with a gzip wrapper
+int TRI_GzipStringBuffer(TRI_string_buffer_t*, size_t);
+
 /// @brief ensure the string buffer has a specific capacity
 int TRI_ReserveStringBuffer(TRI_string_buffer_t*, size_t const);
 
@@ -290,6 +293,11 @@ class StringBuffer {
     return TRI_DeflateStringBuffer(&_buffer, bufferSize);
   }
 
+  /// @brief compress the buffer using deflate, with a gzip wrapper
+  int gzip(size_t bufferSize) {
+    return TRI_GzipStringBuffer(&_buffer, bufferSize);
+  }
+
   /// @brief uncompress the buffer into stringstream out, using zlib-inflate
   int inflate(std::stringstream& out, size_t bufferSize = 16384, size_t skip = 0);
 
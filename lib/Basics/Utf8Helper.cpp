@@ -34,6 +34,7 @@
 #include "unicode/uclean.h"
 #include "unicode/udata.h"
 #include "unicode/unorm2.h"
+#include "unicode/usetiter.h"
 #include "unicode/ustdio.h"
 
 #ifdef _WIN32
@@ -117,6 +118,55 @@ int Utf8Helper::compareUtf16(uint16_t const* left, size_t leftLength,
                         (const UChar*)right, (int32_t)rightLength);
 }
 
+void Utf8Helper::appendSortKey(char const* value, size_t length, std::string& result) const {
+  TRI_ASSERT(value != nullptr);
+  TRI_ASSERT(_coll);
+
+  icu::UnicodeString const str =
+      icu::UnicodeString::fromUTF8(icu::StringPiece(value, (int32_t)length));
+
+  size_t const offset = result.size();
+  // sort keys are usually not much longer than the string itself. if the
+  // guess is too small, ICU tells us the required length
+  int32_t capacity = static_cast<int32_t>(length) + 32;
+  while (true) {
+    result.resize(offset + static_cast<size_t>(capacity));
+    int32_t needed = _coll->getSortKey(str, reinterpret_cast<uint8_t*>(&result[offset]), capacity);
+    if (needed <= capacity) {
+      // needed includes the terminating NUL byte, which we do not want
+      result.resize(offset + static_cast<size_t>(needed > 0 ? needed - 1 : 0));
+      return;
+    }
+    capacity = needed;
+  }
+}
+
+bool Utf8Helper::tailorsAscii() const {
+  TRI_ASSERT(_coll);
+
+  UErrorCode status = U_ZERO_ERROR;
+  std::unique_ptr<icu::UnicodeSet> tailored(_coll->getTailoredSet(status));
+  if (U_FAILURE(status) || tailored == nullptr) {
+    // better safe than sorry
+    return true;
+  }
+
+  icu::UnicodeSetIterator it(*tailored);
+  while (it.nextRange()) {
+    if (it.isString()) {
+      icu::UnicodeString const& str = it.getString();
+      for (int32_t i = 0; i < str.length(); ++i) {
+        if (str.charAt(i) < 0x80) {
+          return true;
+        }
+      }
+    } else if (it.getCodepoint() < 0x80) {
+      return true;
+    }
+  }
+  return false;
+}
+
 bool Utf8Helper::setCollatorLanguage(std::string const& lang, void* icuDataPointer) {
   if (icuDataPointer == nullptr) {
     return false;
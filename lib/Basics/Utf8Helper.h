@@ -89,6 +89,22 @@ class Utf8Helper {
   int compareUtf16(uint16_t const* left, size_t leftLength,
                    uint16_t const* right, size_t rightLength) const;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief append the collation sort key of a utf8 string to result.
+  /// comparing two sort keys bytewise yields the same result as comparing
+  /// the strings via compareUtf8. sort keys do not contain NUL bytes
+  //////////////////////////////////////////////////////////////////////////////
+
+  void appendSortKey(char const* value, size_t length, std::string& result) const;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief whether the collation language changes the order of any ASCII
+  /// character, e.g. by contractions such as "ch" in Czech. if not, all
+  /// strings that start with an ASCII prefix p sort between p and p + U+FFFF
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool tailorsAscii() const;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief set collator by language
   /// @param lang   Lowercase two-letter or three-letter ISO-639 code.
@@ -42,6 +42,7 @@
 #include <velocypack/Options.h>
 #include <velocypack/Slice.h>
 #include <velocypack/StringRef.h>
+#include <velocypack/Validator.h>
 #include <velocypack/velocypack-aliases.h>
 #include <velocypack/velocypack-common.h>
 
@@ -569,6 +570,17 @@ VPackBuilder VelocyPackHelper::velocyPackFromFile(std::string const& path) {
   THROW_ARANGO_EXCEPTION(TRI_errno());
 }
 
+/// @brief validates binary VelocyPack and copies it into a builder
+std::shared_ptr<VPackBuilder> VelocyPackHelper::velocyPackFromBinary(
+    char const* data, size_t length, VPackOptions const& options) {
+  VPackValidator validator(&options);
+  validator.validate(data, length);
+
+  auto buffer = std::make_shared<VPackBuffer<uint8_t>>(length);
+  buffer->append(reinterpret_cast<uint8_t const*>(data), length);
+  return std::make_shared<VPackBuilder>(buffer, &options);
+}
+
 static bool PrintVelocyPack(int fd, VPackSlice const& slice, bool appendNewline) {
   if (slice.isNone()) {
     // sanity check
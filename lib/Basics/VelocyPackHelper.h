@@ -309,6 +309,11 @@ class VelocyPackHelper {
   /// @brief parses a json file to VelocyPack
   static VPackBuilder velocyPackFromFile(std::string const&);
 
+  /// @brief validates binary VelocyPack (e.g. a network body) and copies it
+  /// into a builder, without going through a parser
+  static std::shared_ptr<VPackBuilder> velocyPackFromBinary(char const* data, size_t length,
+                                                            VPackOptions const& options);
+
   /// @brief writes a VelocyPack to a file
   static bool velocyPackToFile(std::string const& filename,
                                VPackSlice const& slice, bool syncFile);
@@ -24,12 +24,13 @@
 #include "Basics/NumberUtils.h"
 #include "Logger/Logger.h"
 
-#include <boost/algorithm/string.hpp>
 #include <date/date.h>
 #include <date/iso_week.h>
 
 #include <chrono>
+#include <memory>
 #include <regex>
+#include <unordered_map>
 #include <vector>
 
 namespace {
@@ -44,7 +45,6 @@ std::string tail(std::string const& source, size_t const length) {
 }  // tail
 
 typedef void (*format_func_t)(std::string& wrk, arangodb::tp_sys_clock_ms const&);
-std::unordered_map<std::string, format_func_t> dateMap;
 auto const unixEpoch = date::sys_seconds{std::chrono::seconds{0}};
 
 std::vector<std::string> const monthNames = {"January", "February", "March",
@@ -507,45 +507,6 @@ std::
                                                                                   arangodb::tp_sys_clock_ms const& tp) {
                                                                           }}};
 
-// will be populated by DateRegexInitializer
-std::regex dateFormatRegex;
-
-std::regex const iso8601Regex(
-    "(\\+|\\-)?\\d+(\\-\\d{1,2}(\\-\\d{1,2})?)?"  // YY[YY]-MM-DD
-    "("
-    "("
-    // Time is optional
-    "(\\ |T)"                     // T or blank separates date and time
-    "\\d\\d\\:\\d\\d"             // time: hh:mm
-    "(\\:\\d\\d(\\.\\d{1,})?)?"   // Optional: :ss.mmms
-    "("
-    "z|Z|"  // trailing Z or start of timezone
-    "(\\+|\\-)"
-    "\\d?\\d\\:\\d\\d"  // timezone hh:mm
-    ")?"
-    ")|"
-    "(z|Z)"  // Z
-    ")?");
-
-/* REGEX GROUPS
-12:34:56.789-12:34
-submatch 0: '12:34:56.789-12:34'
-submatch 1: '12'
-submatch 2: '34'
-submatch 3: ':56.789'
-submatch 4: '56'
-submatch 5: '.789'
-submatch 6: '789'
-submatch 7: '-12:34'
-submatch 8: '-'
-submatch 9: '12'
-submatch 10: '34'
-*/
-
-std::regex const timeRegex(
-    "(\\d\\d)\\:(\\d\\d)(\\:(\\d\\d)(\\.(\\d{1,}))?)?((\\+|\\-)(\\d?\\d)\\:"
-    "(\\d\\d))?");
-
 /* REGEX GROUPS
 P1Y2M3W4DT5H6M7.891S
   submatch 0: P1Y2M3W4DT5H6M7.891S
@@ -571,199 +532,247 @@ std::regex const durationRegex(
     "P((\\d+)Y)?((\\d+)M)?((\\d+)W)?((\\d+)D)?(T((\\d+)H)?((\\d+)M)?((\\d+)(\\."
     "(\\d{1,3}))?S)?)?");
 
-struct DateRegexInitializer {
-  DateRegexInitializer() {
-    std::string myregex;
-
-    dateMap.reserve(sortedDateMap.size());
-    std::for_each(sortedDateMap.begin(), sortedDateMap.end(),
-                  [&myregex](std::pair<std::string const&, format_func_t> const& p) {
-                    (myregex.length() > 0) ? myregex += "|" + p.first : myregex = p.first;
-                    dateMap.insert(std::make_pair(p.first, p.second));
-                  });
-    dateFormatRegex = std::regex(myregex);
-  }
-};
-
-std::string executeDateFormatRegex(std::string const& search, 
-                                   arangodb::tp_sys_clock_ms const& tp) {
-  std::string s;
-
-  auto first = search.begin();
-  auto last = search.end();
-  typename std::smatch::difference_type positionOfLastMatch = 0;
-  auto endOfLastMatch = first;
+/// @brief a format string, split into literal text and format functions
+struct FormatPlan {
+  struct Token {
+    /// @brief function producing this part, nullptr for literal text
+    format_func_t func;
+    /// @brief position of literal text in format
+    size_t offset;
+    size_t length;
+  };
 
-  auto callback = [&tp, &endOfLastMatch, &positionOfLastMatch, &s](std::smatch const& match) {
-    auto positionOfThisMatch = match.position(0);
-    auto diff = positionOfThisMatch - positionOfLastMatch;
+  explicit FormatPlan(arangodb::velocypack::StringRef formatString)
+      : format(formatString.data(), formatString.size()) {
+    char const* p = format.data();
+    char const* e = p + format.size();
+    char const* literal = p;
 
-    auto startOfThisMatch = endOfLastMatch;
-    std::advance(startOfThisMatch, diff);
+    while (p < e) {
+      if (*p != '%') {
+        ++p;
+        continue;
+      }
+      // the first entry in sortedDateMap matching at this position wins.
+      // the last entry is a single "%", so there is always a match
+      for (auto const& it : sortedDateMap) {
+        if (static_cast<size_t>(e - p) >= it.first.size() &&
+            memcmp(p, it.first.data(), it.first.size()) == 0) {
+          if (p > literal) {
+            tokens.push_back(Token{nullptr, static_cast<size_t>(literal - format.data()),
+                                   static_cast<size_t>(p - literal)});
+          }
+          tokens.push_back(Token{it.second, 0, 0});
+          p += it.first.size();
+          literal = p;
+          break;
+        }
+      }
+    }
+    if (p > literal) {
+      tokens.push_back(Token{nullptr, static_cast<size_t>(literal - format.data()),
+                             static_cast<size_t>(p - literal)});
+    }
+  }
 
-    s.append(endOfLastMatch, startOfThisMatch);
-    auto got = dateMap.find(match.str(0));
-    if (got != dateMap.end()) {
-      got->second(s, tp);
+  void execute(std::string& result, arangodb::tp_sys_clock_ms const& tp) const {
+    for (auto const& it : tokens) {
+      if (it.func != nullptr) {
+        it.func(result, tp);
+      } else {
+        result.append(format, it.offset, it.length);
+      }
     }
-    auto lengthOfMatch = match.length(0);
+  }
 
-    positionOfLastMatch = positionOfThisMatch + lengthOfMatch;
+  std::string const format;
+  std::vector<Token> tokens;
+};
 
-    endOfLastMatch = startOfThisMatch;
-    std::advance(endOfLastMatch, lengthOfMatch);
-  };
+/// @brief maximum number of format plans cached per thread
+constexpr size_t maxCachedFormatPlans = 64;
 
-  std::regex_iterator<std::string::const_iterator> end;
-  std::regex_iterator<std::string::const_iterator> begin(first, last, dateFormatRegex);
-  std::for_each(begin, end, callback);
+/// @brief returns the plan for a format string. plans are cached per thread,
+/// because queries usually apply the same few format strings to many values
+FormatPlan const& formatPlan(arangodb::velocypack::StringRef formatString) {
+  // keys point into the format strings owned by the plans
+  thread_local std::unordered_map<arangodb::velocypack::StringRef, std::unique_ptr<FormatPlan>> plans;
 
-  s.append(endOfLastMatch, last);
+  auto it = plans.find(formatString);
+  if (it != plans.end()) {
+    return *(it->second);
+  }
 
-  return s;
+  if (plans.size() >= maxCachedFormatPlans) {
+    plans.clear();
+  }
+  auto plan = std::make_unique<FormatPlan>(formatString);
+  arangodb::velocypack::StringRef key(plan->format);
+  return *(plans.emplace(key, std::move(plan)).first->second);
 }
 
-// populates dateFormatRegex
-static DateRegexInitializer const initializer;
+inline bool isDigit(char c) noexcept { return c >= '0' && c <= '9'; }
+
+/// @brief parses an unsigned number of minDigits to maxDigits digits, and
+/// moves p forward
+bool parseNumber(char const*& p, char const* e, size_t minDigits,
+                 size_t maxDigits, int& result) noexcept {
+  char const* s = p;
+  result = 0;
+  while (p < e && static_cast<size_t>(p - s) < maxDigits && isDigit(*p)) {
+    result = result * 10 + (*p - '0');
+    ++p;
+  }
+  return static_cast<size_t>(p - s) >= minDigits;
+}
 
 }  // namespace
 
-bool arangodb::basics::parseDateTime(std::string const& dateTimeIn, arangodb::tp_sys_clock_ms& date_tp) {
+bool arangodb::basics::parseDateTime(std::string const& dateTime,
+                                     arangodb::tp_sys_clock_ms& date_tp) {
+  return parseDateTime(arangodb::velocypack::StringRef(dateTime), date_tp);
+}
+
+bool arangodb::basics::parseDateTime(arangodb::velocypack::StringRef dateTime,
+                                     arangodb::tp_sys_clock_ms& date_tp) {
   using namespace date;
   using namespace std::chrono;
 
-  std::string dateTime = dateTimeIn;
-  std::string strDate, strTime;
+  // accepts [-]Y+[-M[M][-D[D]]][(T| )hh:mm[:ss[.f+]][Z|(+|-)[h]h:mm]] and
+  // [-]Y+[-M[M][-D[D]]]Z, with surrounding whitespace
+  char const* p = dateTime.data();
+  char const* e = p + dateTime.size();
 
-  boost::algorithm::trim(dateTime);
-  
-  if (!std::regex_match(dateTime, ::iso8601Regex)) {
-    LOG_TOPIC("f19ee", DEBUG, arangodb::Logger::FIXME)
-        << "regex failed for datetime '" << dateTime << "'";
-    return false;
+  auto isSpace = [](char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+  };
+  while (p < e && isSpace(*p)) {
+    ++p;
   }
-
-  strDate = dateTime;
-
-  if (strDate.back() == 'Z' || strDate.back() == 'z') {
-    strDate.pop_back();
+  while (e > p && isSpace(*(e - 1))) {
+    --e;
   }
 
-  LOG_TOPIC("c3c7a", DEBUG, arangodb::Logger::FIXME) << "parse datetime '" << strDate << "'";
-
-  if (strDate.find("T") != std::string::npos || strDate.find(" ") != std::string::npos) {  // split into ymd / time
-    std::vector<std::string> strs;
-    boost::split(strs, strDate, boost::is_any_of("T "));
+  auto invalid = [&dateTime]() {
+    LOG_TOPIC("f19ee", DEBUG, arangodb::Logger::FIXME)
+        << "invalid datetime '" << dateTime.toString() << "'";
+    return false;
+  };
 
-    strDate = strs[0];
-    strTime = strs[1];
-  }  // if
+  // year, with an optional minus sign
+  char const* yearStart = p;
+  if (p < e && *p == '-') {
+    ++p;
+  }
+  char const* digits = p;
+  while (p < e && ::isDigit(*p)) {
+    ++p;
+  }
+  if (p == digits) {
+    return invalid();
+  }
+  int parsedYear = NumberUtils::atoi_unchecked<int>(yearStart, p);
 
-  // parse date component, moves pointer "p" forward
-  // returns true if "p" pointed to a valid number, and false otherwise
-  auto parseDateComponent = [](char const*& p, char const* e, int& result) -> bool {
-    char const* s = p;  // remember initial start
-    if (p < e && *p == '-') {
-      // skip over initial '-'
-      ++p;
-    }
-    while (p < e && *p >= '0' && *p <= '9') {
-      ++p;
-    }
-    if (p == s) {
-      // did not find any valid character
-      return false;
+  // month and day are optional, so they intentionally default to 1
+  int parsedMonth = 1, parsedDay = 1;
+  if (p < e && *p == '-') {
+    ++p;
+    if (!::parseNumber(p, e, 1, 2, parsedMonth)) {
+      return invalid();
     }
-    result = NumberUtils::atoi_unchecked<int>(s, p);
     if (p < e && *p == '-') {
       ++p;
+      if (!::parseNumber(p, e, 1, 2, parsedDay)) {
+        return invalid();
+      }
     }
-    return true;
-  };
-
-  char const* p = strDate.data();
-  char const* e = p + strDate.size();
-
-  // month and day are optional, so they intentionally default to 1
-  int parsedYear, parsedMonth = 1, parsedDay = 1;
-
-  // at least year must be valid
-  if (!parseDateComponent(p, e, parsedYear)) {
-    return false;
-  }
-
-  parseDateComponent(p, e, parsedMonth);
-  parseDateComponent(p, e, parsedDay);
-
-  if (parsedMonth < 1 || parsedMonth > 12 || parsedDay < 1 || parsedDay > 31) {
-    // definitely invalid
-    return false;
   }
 
-  LOG_TOPIC("29671", DEBUG, arangodb::Logger::FIXME)
-      << "parsed YMD " << parsedYear << " " << parsedMonth << " " << parsedDay;
-
-  date_tp = sys_days(year{parsedYear} / parsedMonth / parsedDay);
-
-  // parse Time HH:MM:SS(.SSS)((+|-)HH:MM)
-  if (1 < strTime.size()) {
-    std::smatch time_parts;
-
-    if (!std::regex_match(strTime, time_parts, ::timeRegex)) {
-      LOG_TOPIC("33cf9", DEBUG, arangodb::Logger::FIXME) << "regex failed for time " << strTime;
-      return false;
+  if (p < e && (*p == 'Z' || *p == 'z')) {
+    ++p;
+  } else if (p < e) {
+    // time
+    if (*p != 'T' && *p != ' ') {
+      return invalid();
     }
+    ++p;
 
-    // hour
-    hours parsedHours{atoi(time_parts[1].str().c_str())};
-
-    if (hours{23} < parsedHours) {
-      return false;
+    int parsedHours, parsedMinutes, parsedSeconds = 0, parsedMilliseconds = 0;
+    if (!::parseNumber(p, e, 2, 2, parsedHours) || p == e || *p != ':' ||
+        !::parseNumber(++p, e, 2, 2, parsedMinutes)) {
+      return invalid();
     }
-    date_tp += parsedHours;
-
-    // minute
-    minutes parsedMinutes{atoi(time_parts[2].str().c_str())};
-
-    if (minutes{59} < parsedMinutes) {
-      return false;
+    if (p < e && *p == ':') {
+      if (!::parseNumber(++p, e, 2, 2, parsedSeconds)) {
+        return invalid();
+      }
+      if (p < e && *p == '.') {
+        // milliseconds, .9 -> 900ms. digits beyond the third are ignored
+        char const* fraction = ++p;
+        if (!::parseNumber(p, e, 1, 3, parsedMilliseconds)) {
+          return invalid();
+        }
+        for (size_t n = p - fraction; n < 3; ++n) {
+          parsedMilliseconds *= 10;
+        }
+        while (p < e && ::isDigit(*p)) {
+          ++p;
+        }
+      }
     }
-    date_tp += parsedMinutes;
 
-    // seconds
-    seconds parsedSeconds{atoi(time_parts[4].str().c_str())};
-
-    if (seconds{59} < parsedSeconds) {
+    if (parsedHours > 23 || parsedMinutes > 59 || parsedSeconds > 59) {
       return false;
     }
-    date_tp += parsedSeconds;
-
-    // milliseconds .9 -> 900ms
-    date_tp += milliseconds{atoi((time_parts[6].str() + "00").substr(0, 3).c_str())};
 
     // time offset
-    if (time_parts[8].str().size()) {
-      hours parsedHours{atoi(time_parts[9].str().c_str())};  // hours
-
-      if (hours{23} < parsedHours) {
-        return false;
+    minutes offset{0};
+    if (p < e && (*p == 'Z' || *p == 'z')) {
+      ++p;
+    } else if (p < e && (*p == '+' || *p == '-')) {
+      bool const negative = (*p == '-');
+      int offsetHours, offsetMinutes;
+      if (!::parseNumber(++p, e, 1, 2, offsetHours) || p == e || *p != ':' ||
+          !::parseNumber(++p, e, 2, 2, offsetMinutes)) {
+        return invalid();
       }
-      minutes offset = parsedHours;
-
-      minutes parsedMinutes{atoi(time_parts[10].str().c_str())};  // minutes
-
-      if (minutes{59} < parsedMinutes) {
+      if (offsetHours > 23 || offsetMinutes > 59) {
         return false;
       }
-      offset += parsedMinutes;
-
-      if (time_parts[8].str() == "-") {
+      offset = hours{offsetHours} + minutes{offsetMinutes};
+      if (negative) {
         offset *= -1;
       }
-      date_tp -= offset;
     }
-  }  // if
 
+    if (p != e) {
+      return invalid();
+    }
+
+    if (parsedMonth < 1 || parsedMonth > 12 || parsedDay < 1 || parsedDay > 31) {
+      // definitely invalid
+      return false;
+    }
+
+    date_tp = sys_days(year{parsedYear} / parsedMonth / parsedDay);
+    date_tp += hours{parsedHours};
+    date_tp += minutes{parsedMinutes};
+    date_tp += seconds{parsedSeconds};
+    date_tp += milliseconds{parsedMilliseconds};
+    date_tp -= offset;
+    return true;
+  }
+
+  if (p != e) {
+    return invalid();
+  }
+
+  if (parsedMonth < 1 || parsedMonth > 12 || parsedDay < 1 || parsedDay > 31) {
+    // definitely invalid
+    return false;
+  }
+
+  date_tp = sys_days(year{parsedYear} / parsedMonth / parsedDay);
   return true;
 }
 
@@ -782,6 +791,13 @@ bool arangodb::basics::regexIsoDuration(std::string const& isoDuration,
 
 std::string arangodb::basics::formatDate(std::string const& formatString,
                                          arangodb::tp_sys_clock_ms const& dateValue) {
-  return ::executeDateFormatRegex(formatString, dateValue);
+  return formatDate(arangodb::velocypack::StringRef(formatString), dateValue);
+}
+
+std::string arangodb::basics::formatDate(arangodb::velocypack::StringRef formatString,
+                                         arangodb::tp_sys_clock_ms const& dateValue) {
+  std::string result;
+  ::formatPlan(formatString).execute(result, dateValue);
+  return result;
 }
 
@@ -25,6 +25,8 @@
 
 #include "Basics/Common.h"
 
+#include <velocypack/StringRef.h>
+
 #include <chrono>
 #include <regex>
 
@@ -37,12 +39,21 @@ namespace basics {
 bool parseDateTime(std::string const& dateTime, 
                    tp_sys_clock_ms& date_tp);
 
+/// @brief parses an ISO 8601 date(time) string, without allocating memory
+bool parseDateTime(arangodb::velocypack::StringRef dateTime,
+                   tp_sys_clock_ms& date_tp);
+
 bool regexIsoDuration(std::string const& isoDuration, 
                       std::smatch& durationParts);
 
 /// @brief formats a date(time) value according to formatString
 std::string formatDate(std::string const& formatString,
                        tp_sys_clock_ms const& dateValue);
+
+/// @brief formats a date(time) value according to formatString. the
+/// tokenized format string is cached
+std::string formatDate(arangodb::velocypack::StringRef formatString,
+                       tp_sys_clock_ms const& dateValue);
 }  // namespace basics
 }  // namespace arangodb
 
@@ -67,4 +67,19 @@ uint32_t TRI_Crc32HashPointer(void const*, size_t);
 /// the polynomial used is 0x1EDC6F41.
 uint32_t TRI_Crc32HashString(char const*);
 
+/// @brief computes a 64 bit XXH3 hash for memory blobs, the same as
+/// XXH3_64bits_withSeed of xxHash 0.8. blobs of more than 240 bytes are
+/// hashed with AVX2 if the CPU supports it (detected at runtime), or with
+/// NEON on aarch64. the values differ from those of XXH64 and fasthash64,
+/// so it must not replace them where hashes are persisted or compared
+/// between servers
+uint64_t TRI_Xxh3Hash64(void const*, size_t, uint64_t seed);
+
+/// @brief XXH3 without the runtime-detected implementations, for tests and
+/// benchmarks. returns the same values as TRI_Xxh3Hash64
+uint64_t TRI_Xxh3Hash64_Generic(void const*, size_t, uint64_t seed);
+
+/// @brief name of the implementation TRI_Xxh3Hash64 uses for long blobs
+char const* TRI_Xxh3Implementation();
+
 #endif
@@ -40,6 +40,7 @@
 #include <signal.h>
 #endif
 
+#include "Basics/Profiler.h"
 #include "Basics/tri-strings.h"
 #include "Logger/Logger.h"
 
@@ -63,6 +64,10 @@ struct thread_data_t {
 static void* ThreadStarter(void* data) {
   sigset_t all;
   sigfillset(&all);
+#ifdef __linux__
+  // the thread can be sampled by the CPU profiler
+  sigdelset(&all, arangodb::profiler::sampleSignal());
+#endif
   pthread_sigmask(SIG_SETMASK, &all, nullptr);
 
   // this will automatically free the thread struct when leaving this function
@@ -0,0 +1,442 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+// XXH3 64 bit hash, following the xxHash 0.8 reference implementation
+// (BSD 2-Clause License, Copyright (C) 2012-2020 Yann Collet). produces
+// the same values as XXH3_64bits_withSeed()
+
+#include "Basics/hashes.h"
+
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define ARANGODB_XXH3_AVX2 1
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define ARANGODB_XXH3_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace {
+
+constexpr uint64_t Prime32_1 = 0x9E3779B1U;
+constexpr uint64_t Prime32_2 = 0x85EBCA77U;
+constexpr uint64_t Prime32_3 = 0xC2B2AE3DU;
+constexpr uint64_t Prime64_1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t Prime64_2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64_t Prime64_3 = 0x165667B19E3779F9ULL;
+constexpr uint64_t Prime64_4 = 0x85EBCA77C2B2AE63ULL;
+constexpr uint64_t Prime64_5 = 0x27D4EB2F165667C5ULL;
+constexpr uint64_t PrimeMx1 = 0x165667919E3779F9ULL;
+constexpr uint64_t PrimeMx2 = 0x9FB21C651E98DF25ULL;
+
+constexpr size_t SecretSize = 192;
+constexpr size_t SecretSizeMin = 136;
+constexpr size_t StripeLength = 64;
+constexpr size_t SecretConsumeRate = 8;
+constexpr size_t MidSizeMax = 240;
+
+alignas(64) uint8_t const Secret[SecretSize] = {
+    0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c,
+    0xf7, 0x21, 0xad, 0x1c, 0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb,
+    0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f, 0xcb, 0x79, 0xe6, 0x4e,
+    0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+    0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6,
+    0x81, 0x3a, 0x26, 0x4c, 0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb,
+    0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3, 0x71, 0x64, 0x48, 0x97,
+    0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+    0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7,
+    0xc7, 0x0b, 0x4f, 0x1d, 0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31,
+    0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64, 0xea, 0xc5, 0xac, 0x83,
+    0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+    0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26,
+    0x29, 0xd4, 0x68, 0x9e, 0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc,
+    0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce, 0x45, 0xcb, 0x3a, 0x8f,
+    0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+};
+
+inline uint32_t swap32(uint32_t x) {
+  return ((x << 24) & 0xff000000) | ((x << 8) & 0x00ff0000) |
+         ((x >> 8) & 0x0000ff00) | ((x >> 24) & 0x000000ff);
+}
+
+inline uint64_t swap64(uint64_t x) {
+  return (static_cast<uint64_t>(swap32(static_cast<uint32_t>(x))) << 32) |
+         swap32(static_cast<uint32_t>(x >> 32));
+}
+
+inline uint32_t read32(uint8_t const* p) {
+  uint32_t value;
+  memcpy(&value, p, sizeof(value));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  value = swap32(value);
+#endif
+  return value;
+}
+
+inline uint64_t read64(uint8_t const* p) {
+  uint64_t value;
+  memcpy(&value, p, sizeof(value));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  value = swap64(value);
+#endif
+  return value;
+}
+
+inline void write64(uint8_t* p, uint64_t value) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  value = swap64(value);
+#endif
+  memcpy(p, &value, sizeof(value));
+}
+
+inline uint64_t rotl64(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+/// @brief xor of the low and high half of the 128 bit product
+inline uint64_t mul128Fold64(uint64_t lhs, uint64_t rhs) {
+#if defined(__SIZEOF_INT128__)
+  __uint128_t product = static_cast<__uint128_t>(lhs) * rhs;
+  return static_cast<uint64_t>(product) ^ static_cast<uint64_t>(product >> 64);
+#else
+  uint64_t loLo = (lhs & 0xFFFFFFFF) * (rhs & 0xFFFFFFFF);
+  uint64_t hiLo = (lhs >> 32) * (rhs & 0xFFFFFFFF);
+  uint64_t loHi = (lhs & 0xFFFFFFFF) * (rhs >> 32);
+  uint64_t hiHi = (lhs >> 32) * (rhs >> 32);
+  uint64_t cross = (loLo >> 32) + (hiLo & 0xFFFFFFFF) + loHi;
+  uint64_t upper = (hiLo >> 32) + (cross >> 32) + hiHi;
+  uint64_t lower = (cross << 32) | (loLo & 0xFFFFFFFF);
+  return lower ^ upper;
+#endif
+}
+
+inline uint64_t xxh64Avalanche(uint64_t h) {
+  h ^= h >> 33;
+  h *= Prime64_2;
+  h ^= h >> 29;
+  h *= Prime64_3;
+  h ^= h >> 32;
+  return h;
+}
+
+inline uint64_t avalanche(uint64_t h) {
+  h ^= h >> 37;
+  h *= PrimeMx1;
+  h ^= h >> 32;
+  return h;
+}
+
+inline uint64_t rrmxmx(uint64_t h, uint64_t length) {
+  h ^= rotl64(h, 49) ^ rotl64(h, 24);
+  h *= PrimeMx2;
+  h ^= (h >> 35) + length;
+  h *= PrimeMx2;
+  return h ^ (h >> 28);
+}
+
+inline uint64_t hash0To16(uint8_t const* p, size_t length, uint64_t seed) {
+  if (length > 8) {
+    uint64_t bitflip1 = (read64(Secret + 24) ^ read64(Secret + 32)) + seed;
+    uint64_t bitflip2 = (read64(Secret + 40) ^ read64(Secret + 48)) - seed;
+    uint64_t lo = read64(p) ^ bitflip1;
+    uint64_t hi = read64(p + length - 8) ^ bitflip2;
+    return avalanche(length + swap64(lo) + hi + mul128Fold64(lo, hi));
+  }
+  if (length >= 4) {
+    seed ^= static_cast<uint64_t>(swap32(static_cast<uint32_t>(seed))) << 32;
+    uint64_t input1 = read32(p);
+    uint64_t input2 = read32(p + length - 4);
+    uint64_t bitflip = (read64(Secret + 8) ^ read64(Secret + 16)) - seed;
+    return rrmxmx((input2 + (input1 << 32)) ^ bitflip, length);
+  }
+  if (length > 0) {
+    uint32_t combined = (static_cast<uint32_t>(p[0]) << 16) |
+                        (static_cast<uint32_t>(p[length >> 1]) << 24) |
+                        static_cast<uint32_t>(p[length - 1]) |
+                        (static_cast<uint32_t>(length) << 8);
+    uint64_t bitflip = (read32(Secret) ^ read32(Secret + 4)) + seed;
+    return xxh64Avalanche(combined ^ bitflip);
+  }
+  return xxh64Avalanche(seed ^ (read64(Secret + 56) ^ read64(Secret + 64)));
+}
+
+inline uint64_t mix16(uint8_t const* p, uint8_t const* secret, uint64_t seed) {
+  return mul128Fold64(read64(p) ^ (read64(secret) + seed),
+                      read64(p + 8) ^ (read64(secret + 8) - seed));
+}
+
+inline uint64_t hash17To128(uint8_t const* p, size_t length, uint64_t seed) {
+  uint64_t acc = length * Prime64_1;
+  if (length > 32) {
+    if (length > 64) {
+      if (length > 96) {
+        acc += mix16(p + 48, Secret + 96, seed);
+        acc += mix16(p + length - 64, Secret + 112, seed);
+      }
+      acc += mix16(p + 32, Secret + 64, seed);
+      acc += mix16(p + length - 48, Secret + 80, seed);
+    }
+    acc += mix16(p + 16, Secret + 32, seed);
+    acc += mix16(p + length - 32, Secret + 48, seed);
+  }
+  acc += mix16(p, Secret, seed);
+  acc += mix16(p + length - 16, Secret + 16, seed);
+  return avalanche(acc);
+}
+
+uint64_t hash129To240(uint8_t const* p, size_t length, uint64_t seed) {
+  uint64_t acc = length * Prime64_1;
+  for (size_t i = 0; i < 8; ++i) {
+    acc += mix16(p + 16 * i, Secret + 16 * i, seed);
+  }
+  acc = avalanche(acc);
+  uint64_t accEnd = mix16(p + length - 16, Secret + SecretSizeMin - 17, seed);
+  size_t rounds = length / 16;
+  for (size_t i = 8; i < rounds; ++i) {
+    accEnd += mix16(p + 16 * i, Secret + 16 * (i - 8) + 3, seed);
+  }
+  return avalanche(acc + accEnd);
+}
+
+// inputs of more than 240 bytes are consumed in stripes of 64 bytes, which
+// update 8 accumulators. the accumulators are scrambled after each block
+// of 16 stripes
+
+inline void accumulateScalar(uint64_t* acc, uint8_t const* p, uint8_t const* secret) {
+  for (size_t i = 0; i < 8; ++i) {
+    uint64_t value = read64(p + 8 * i);
+    uint64_t key = value ^ read64(secret + 8 * i);
+    acc[i ^ 1] += value;
+    acc[i] += (key & 0xFFFFFFFF) * (key >> 32);
+  }
+}
+
+inline void scrambleScalar(uint64_t* acc, uint8_t const* secret) {
+  for (size_t i = 0; i < 8; ++i) {
+    uint64_t value = acc[i];
+    value ^= value >> 47;
+    value ^= read64(secret + 8 * i);
+    value *= Prime32_1;
+    acc[i] = value;
+  }
+}
+
+#ifdef ARANGODB_XXH3_AVX2
+__attribute__((target("avx2"))) inline void accumulateAvx2(uint64_t* acc, uint8_t const* p,
+                                                           uint8_t const* secret) {
+  __m256i* xacc = reinterpret_cast<__m256i*>(acc);
+  for (size_t i = 0; i < 2; ++i) {
+    __m256i value = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p) + i);
+    __m256i key = _mm256_xor_si256(
+        value, _mm256_loadu_si256(reinterpret_cast<__m256i const*>(secret) + i));
+    __m256i product = _mm256_mul_epu32(key, _mm256_srli_epi64(key, 32));
+    __m256i swapped = _mm256_shuffle_epi32(value, _MM_SHUFFLE(1, 0, 3, 2));
+    xacc[i] = _mm256_add_epi64(product, _mm256_add_epi64(xacc[i], swapped));
+  }
+}
+
+__attribute__((target("avx2"))) inline void scrambleAvx2(uint64_t* acc, uint8_t const* secret) {
+  __m256i* xacc = reinterpret_cast<__m256i*>(acc);
+  __m256i const prime = _mm256_set1_epi32(static_cast<int>(Prime32_1));
+  for (size_t i = 0; i < 2; ++i) {
+    __m256i value = _mm256_xor_si256(xacc[i], _mm256_srli_epi64(xacc[i], 47));
+    value = _mm256_xor_si256(
+        value, _mm256_loadu_si256(reinterpret_cast<__m256i const*>(secret) + i));
+    __m256i lo = _mm256_mul_epu32(value, prime);
+    __m256i hi = _mm256_mul_epu32(_mm256_srli_epi64(value, 32), prime);
+    xacc[i] = _mm256_add_epi64(lo, _mm256_slli_epi64(hi, 32));
+  }
+}
+#endif
+
+#ifdef ARANGODB_XXH3_NEON
+inline void accumulateNeon(uint64_t* acc, uint8_t const* p, uint8_t const* secret) {
+  for (size_t i = 0; i < 4; ++i) {
+    uint64x2_t value = vreinterpretq_u64_u8(vld1q_u8(p + 16 * i));
+    uint64x2_t key = veorq_u64(value, vreinterpretq_u64_u8(vld1q_u8(secret + 16 * i)));
+    uint64x2_t sum = vaddq_u64(vld1q_u64(acc + 2 * i), vextq_u64(value, value, 1));
+    sum = vmlal_u32(sum, vmovn_u64(key), vshrn_n_u64(key, 32));
+    vst1q_u64(acc + 2 * i, sum);
+  }
+}
+
+inline void scrambleNeon(uint64_t* acc, uint8_t const* secret) {
+  uint32x2_t const prime = vdup_n_u32(static_cast<uint32_t>(Prime32_1));
+  for (size_t i = 0; i < 4; ++i) {
+    uint64x2_t value = vld1q_u64(acc + 2 * i);
+    value = veorq_u64(value, vshrq_n_u64(value, 47));
+    value = veorq_u64(value, vreinterpretq_u64_u8(vld1q_u8(secret + 16 * i)));
+    uint64x2_t hi = vshlq_n_u64(vmull_u32(vshrn_n_u64(value, 32), prime), 32);
+    vst1q_u64(acc + 2 * i, vmlal_u32(hi, vmovn_u64(value), prime));
+  }
+}
+#endif
+
+uint64_t mergeAccumulators(uint64_t const* acc, uint8_t const* secret, uint64_t start) {
+  uint64_t result = start;
+  for (size_t i = 0; i < 4; ++i) {
+    result += mul128Fold64(acc[2 * i] ^ read64(secret + 16 * i),
+                           acc[2 * i + 1] ^ read64(secret + 16 * i + 8));
+  }
+  return avalanche(result);
+}
+
+/// @brief the kernel that needs no runtime detection. NEON is part of
+/// every aarch64 CPU
+struct GenericKernel {
+  static void accumulate(uint64_t* acc, uint8_t const* p, uint8_t const* secret) {
+#ifdef ARANGODB_XXH3_NEON
+    accumulateNeon(acc, p, secret);
+#else
+    accumulateScalar(acc, p, secret);
+#endif
+  }
+  static void scramble(uint64_t* acc, uint8_t const* secret) {
+#ifdef ARANGODB_XXH3_NEON
+    scrambleNeon(acc, secret);
+#else
+    scrambleScalar(acc, secret);
+#endif
+  }
+};
+
+template <typename Kernel>
+inline void hashLongLoop(uint64_t* acc, uint8_t const* p, size_t length,
+                         uint8_t const* secret) {
+  size_t const stripesPerBlock = (SecretSize - StripeLength) / SecretConsumeRate;
+  size_t const blockLength = StripeLength * stripesPerBlock;
+  size_t const blocks = (length - 1) / blockLength;
+
+  for (size_t n = 0; n < blocks; ++n) {
+    for (size_t s = 0; s < stripesPerBlock; ++s) {
+      Kernel::accumulate(acc, p + n * blockLength + s * StripeLength,
+                         secret + s * SecretConsumeRate);
+    }
+    Kernel::scramble(acc, secret + SecretSize - StripeLength);
+  }
+
+  size_t const stripes = ((length - 1) - blockLength * blocks) / StripeLength;
+  for (size_t s = 0; s < stripes; ++s) {
+    Kernel::accumulate(acc, p + blocks * blockLength + s * StripeLength,
+                       secret + s * SecretConsumeRate);
+  }
+  // last stripe, with a secret that differs from the other ones
+  Kernel::accumulate(acc, p + length - StripeLength, secret + SecretSize - StripeLength - 7);
+}
+
+typedef void (*HashLongLoop)(uint64_t*, uint8_t const*, size_t, uint8_t const*);
+
+void hashLongLoopGeneric(uint64_t* acc, uint8_t const* p, size_t length, uint8_t const* secret) {
+  hashLongLoop<GenericKernel>(acc, p, length, secret);
+}
+
+#ifdef ARANGODB_XXH3_AVX2
+// the kernel functions must be inlined into a function that is compiled
+// for AVX2 as well, so this cannot share the template with the scalar loop
+__attribute__((target("avx2"))) void hashLongLoopAvx2(uint64_t* acc, uint8_t const* p,
+                                                      size_t length, uint8_t const* secret) {
+  size_t const stripesPerBlock = (SecretSize - StripeLength) / SecretConsumeRate;
+  size_t const blockLength = StripeLength * stripesPerBlock;
+  size_t const blocks = (length - 1) / blockLength;
+
+  for (size_t n = 0; n < blocks; ++n) {
+    for (size_t s = 0; s < stripesPerBlock; ++s) {
+      accumulateAvx2(acc, p + n * blockLength + s * StripeLength,
+                     secret + s * SecretConsumeRate);
+    }
+    scrambleAvx2(acc, secret + SecretSize - StripeLength);
+  }
+
+  size_t const stripes = ((length - 1) - blockLength * blocks) / StripeLength;
+  for (size_t s = 0; s < stripes; ++s) {
+    accumulateAvx2(acc, p + blocks * blockLength + s * StripeLength,
+                   secret + s * SecretConsumeRate);
+  }
+  accumulateAvx2(acc, p + length - StripeLength, secret + SecretSize - StripeLength - 7);
+}
+#endif
+
+HashLongLoop detectHashLongLoop() {
+#ifdef ARANGODB_XXH3_AVX2
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return hashLongLoopAvx2;
+  }
+#endif
+  return hashLongLoopGeneric;
+}
+
+uint64_t hashLong(uint8_t const* p, size_t length, uint64_t seed, HashLongLoop loop) {
+  alignas(32) uint64_t acc[8] = {Prime32_3, Prime64_1, Prime64_2, Prime64_3,
+                                 Prime64_4, Prime32_2, Prime64_5, Prime32_1};
+  if (seed == 0) {
+    loop(acc, p, length, Secret);
+    return mergeAccumulators(acc, Secret + 11, length * Prime64_1);
+  }
+
+  alignas(32) uint8_t secret[SecretSize];
+  for (size_t i = 0; i < SecretSize / 16; ++i) {
+    write64(secret + 16 * i, read64(Secret + 16 * i) + seed);
+    write64(secret + 16 * i + 8, read64(Secret + 16 * i + 8) - seed);
+  }
+  loop(acc, p, length, secret);
+  return mergeAccumulators(acc, secret + 11, length * Prime64_1);
+}
+
+HashLongLoop bestHashLongLoop() {
+  static HashLongLoop const loop = detectHashLongLoop();
+  return loop;
+}
+
+uint64_t xxh3Hash(void const* data, size_t length, uint64_t seed, HashLongLoop loop) {
+  auto p = static_cast<uint8_t const*>(data);
+  if (length <= 16) {
+    return hash0To16(p, length, seed);
+  }
+  if (length <= 128) {
+    return hash17To128(p, length, seed);
+  }
+  if (length <= MidSizeMax) {
+    return hash129To240(p, length, seed);
+  }
+  return hashLong(p, length, seed, loop);
+}
+
+}  // namespace
+
+uint64_t TRI_Xxh3Hash64(void const* data, size_t length, uint64_t seed) {
+  return xxh3Hash(data, length, seed, bestHashLongLoop());
+}
+
+uint64_t TRI_Xxh3Hash64_Generic(void const* data, size_t length, uint64_t seed) {
+  return xxh3Hash(data, length, seed, hashLongLoopGeneric);
+}
+
+char const* TRI_Xxh3Implementation() {
+#ifdef ARANGODB_XXH3_AVX2
+  if (bestHashLongLoop() == hashLongLoopAvx2) {
+    return "avx2";
+  }
+#endif
+#ifdef ARANGODB_XXH3_NEON
+  return "neon";
+#else
+  return "scalar";
+#endif
+}
@@ -34,7 +34,8 @@ enum class ErrorCode : uint8_t {
   FutureAlreadyRetrieved = 2,
   FutureNotReady = 3,
   PromiseAlreadySatisfied = 4,
-  NoState = 5
+  NoState = 5,
+  Cancelled = 6
 };
 
 struct FutureException : public std::exception {
@@ -54,6 +55,8 @@ struct FutureException : public std::exception {
         return "Promise was already satisfied";
       case ErrorCode::NoState:
         return "No shared state";
+      case ErrorCode::Cancelled:
+        return "Future was cancelled";
       default:
         return "invalid future exception";
     }
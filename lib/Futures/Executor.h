@@ -0,0 +1,55 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_FUTURES_EXECUTOR_H
+#define ARANGOD_FUTURES_EXECUTOR_H 1
+
+#include "Futures/function2/function2.hpp"
+
+namespace arangodb {
+namespace futures {
+
+/// @brief runs the continuations of a future, see Future::via().
+/// executors are not owned by the futures using them, so they must
+/// outlive them
+class Executor {
+ public:
+  using Func = fu2::unique_function<void()>;
+
+  virtual ~Executor() = default;
+
+  /// @brief run func, now or later, on any thread. func must be run
+  /// exactly once; if it cannot be scheduled it must be run inline
+  virtual void add(Func func) = 0;
+};
+
+/// @brief runs continuations on the thread that fulfills the future. this
+/// is what happens if no executor is set
+class InlineExecutor final : public Executor {
+ public:
+  void add(Func func) override { func(); }
+
+  static InlineExecutor* instance() noexcept;
+};
+
+}  // namespace futures
+}  // namespace arangodb
+
+#endif  // ARANGOD_FUTURES_EXECUTOR_H
@@ -46,5 +46,10 @@ template class Future<arangodb::OperationResult>;
 Future<Unit> makeFuture() {
   return Future<Unit>(unit);
 }
+
+InlineExecutor* InlineExecutor::instance() noexcept {
+  static InlineExecutor executor;
+  return &executor;
+}
 }  // namespace futures
 }  // namespace arangodb
@@ -141,6 +141,8 @@ class Future {
                 "use futures::Unit instead of void");
 
   friend class Promise<T>;
+  template <typename T2>
+  friend class Future;
   template <class T2>
   friend Future<T2> makeFuture(Try<T2>&&);
   friend Future<Unit> makeFuture();
@@ -283,6 +285,26 @@ class Future {
     return FutureStatus::Ready;
   }
 
+  /// Run the continuations of this Future, and of the Futures returned by
+  /// then(), thenValue() and thenError() on it, via `executor` instead of
+  /// on the thread that fulfills the Promise. Useful if the Promise is
+  /// fulfilled on an I/O thread and the continuations do real work.
+  /// nullptr runs them inline again
+  Future<T> via(Executor* executor) && {
+    getState().setExecutor(executor);
+    return std::move(*this);
+  }
+
+  /// Ask the producer to stop working on this Future, see
+  /// Promise::setInterruptHandler(). The producer may still fulfill it.
+  /// Does nothing if there is a result already
+  void raise(std::exception_ptr e) { getState().raise(std::move(e)); }
+
+  /// Raise a FutureException with ErrorCode::Cancelled
+  void cancel() {
+    raise(std::make_exception_ptr(FutureException(ErrorCode::Cancelled)));
+  }
+
   /// When this Future has completed, execute func which is a function that
   /// can be called with either `T&&` or `Try<T>&&`.
   ///
@@ -315,7 +337,7 @@ class Future {
     static_assert(!R::ReturnsFuture::value, "");
 
     Promise<B> promise;
-    auto future = promise.getFuture();
+    auto future = continuation(promise);
     getState().setCallback(
         [fn = std::forward<DF>(fn), pr = std::move(promise)](Try<T>&& t) mutable {
           if (t.hasException()) {
@@ -342,7 +364,7 @@ class Future {
                   "Function must be invocable with T");
 
     Promise<B> promise;
-    auto future = promise.getFuture();
+    auto future = continuation(promise);
     getState().setCallback([fn = std::forward<DF>(fn),
                             pr = std::move(promise)](Try<T>&& t) mutable {
       if (t.hasException()) {
@@ -373,7 +395,7 @@ class Future {
     static_assert(!std::is_same<B, void>::value, "");
 
     Promise<B> promise;
-    auto future = promise.getFuture();
+    auto future = continuation(promise);
     getState().setCallback([fn = std::forward<DF>(func),
                             pr = std::move(promise)](Try<T>&& t) mutable {
       pr.setTry(detail::makeTryWith([&fn, &t] {
@@ -392,7 +414,7 @@ class Future {
     static_assert(!isFuture<B>::value, "");
 
     Promise<B> promise;
-    auto future = promise.getFuture();
+    auto future = continuation(promise);
     getState().setCallback([fn = std::forward<F>(func),
                             pr = std::move(promise)](Try<T>&& t) mutable {
       try {
@@ -425,7 +447,7 @@ class Future {
     using DF = detail::decay_t<F>;
 
     Promise<B> promise;
-    auto future = promise.getFuture();
+    auto future = continuation(promise);
     getState().setCallback([fn = std::forward<DF>(func),
                             pr = std::move(promise)](Try<T>&& t) mutable {
       if (t.hasException()) {
@@ -454,7 +476,7 @@ class Future {
     using DF = detail::decay_t<F>;
 
     Promise<B> promise;
-    auto future = promise.getFuture();
+    auto future = continuation(promise);
     getState().setCallback(
         [fn = std::forward<DF>(fn), pr = std::move(promise)](Try<T>&& t) mutable {
           if (t.hasException()) {
@@ -502,6 +524,14 @@ class Future {
     return getStateTryChecked(*this);
   }
 
+  /// future of a continuation, which runs via the same executor
+  template <typename B>
+  Future<B> continuation(Promise<B>& promise) {
+    auto future = promise.getFuture();
+    future.getState().setExecutor(getState().getExecutor());
+    return future;
+  }
+
   template <typename Self>
   static decltype(auto) getStateTryChecked(Self& self) {
     auto& state = self.getState();
@@ -112,6 +112,15 @@ class Promise {
     getState().setResult(makeTryWith(std::forward<F>(func)));
   }
 
+  /// Set a handler that is called once if the consumer cancels the Future,
+  /// or raises another interrupt on it, see Future::raise(). It is called
+  /// right away if that has happened already. The handler typically aborts
+  /// the operation and fulfills the Promise with the exception it is given
+  template <typename F>
+  void setInterruptHandler(F&& fn) {
+    getState().setInterruptHandler(std::forward<F>(fn));
+  }
+
   arangodb::futures::Future<T> getFuture();
 
  private:
@@ -25,6 +25,7 @@
 
 #include <atomic>
 
+#include "Futures/Executor.h"
 #include "Futures/Try.h"
 #include "Futures/function2/function2.hpp"
 
@@ -55,6 +56,13 @@ class SharedState {
     Done = 1 << 3,
   };
 
+  /// bits of _interruptState. whoever of raise() and setInterruptHandler()
+  /// comes second calls the handler
+  enum InterruptBits : uint8_t {
+    HandlerSet = 1 << 0,
+    Raised = 1 << 1,
+  };
+
   /// Allow us to savely pass a core pointer to the Scheduler
   struct SharedStateScope {
     explicit SharedStateScope(SharedState* state) : _state(state) {}
@@ -222,6 +230,40 @@ class SharedState {
     }
   }
 
+  /// Call only from consumer thread, before setCallback().
+  /// The callback is passed to `executor` instead of being run by the
+  /// thread that completes the state. nullptr runs it inline
+  void setExecutor(Executor* executor) noexcept { _executor = executor; }
+
+  Executor* getExecutor() const noexcept { return _executor; }
+
+  /// Call only from producer thread, and only once.
+  /// The handler is called once if the consumer raises an interrupt,
+  /// possibly right away if it has done so already
+  template <typename F>
+  void setInterruptHandler(F&& fn) {
+    TRI_ASSERT(!(_interruptState.load() & HandlerSet));
+    _interruptHandler = std::forward<F>(fn);
+    auto prev = _interruptState.fetch_or(HandlerSet, std::memory_order_acq_rel);
+    if (prev & Raised) {
+      _interruptHandler(_interrupt);
+    }
+  }
+
+  /// Call only from consumer thread.
+  /// Passes `e` to the interrupt handler of the producer. Does nothing if
+  /// there already is a result, or if an interrupt was raised before
+  void raise(std::exception_ptr e) {
+    if (hasResult() || (_interruptState.load(std::memory_order_relaxed) & Raised)) {
+      return;
+    }
+    _interrupt = std::move(e);
+    auto prev = _interruptState.fetch_or(Raised, std::memory_order_acq_rel);
+    if (prev & HandlerSet) {
+      _interruptHandler(_interrupt);
+    }
+  }
+
   /// Called by a destructing Future (in the consumer thread, by definition).
   /// Calls `delete this` if there are no more references to `this`
   /// (including if `detachPromise()` is called previously or concurrently).
@@ -237,19 +279,26 @@ class SharedState {
 
  private:
   /// empty shared state
-  SharedState() : _state(State::Start), _attached(2) {}
+  SharedState()
+      : _executor(nullptr), _state(State::Start), _attached(2), _interruptState(0) {}
 
   /// use to construct a ready future
   explicit SharedState(Try<T>&& t)
-      : _result(std::move(t)), _state(State::OnlyResult), _attached(1) {}
+      : _executor(nullptr),
+        _result(std::move(t)),
+        _state(State::OnlyResult),
+        _attached(1),
+        _interruptState(0) {}
 
   /// use to construct a ready future
   template <typename... Args>
   explicit SharedState(in_place_t,
                        Args&&... args) noexcept(std::is_nothrow_constructible<T, Args&&...>::value)
-      : _result(in_place, std::forward<Args>(args)...),
+      : _executor(nullptr),
+        _result(in_place, std::forward<Args>(args)...),
         _state(State::OnlyResult),
-        _attached(1) {}
+        _attached(1),
+        _interruptState(0) {}
 
   ~SharedState() {
     TRI_ASSERT(_attached == 0);
@@ -270,26 +319,33 @@ class SharedState {
   void doCallback() {
     TRI_ASSERT(_state == State::Done);
     TRI_ASSERT(_callback);
-    // TRI_ASSERT(SchedulerFeature::SCHEDULER);
 
-    // in case the scheduler throws away this lamda
+    // in case the executor throws away this lamda
     _attached.fetch_add(1);
     SharedStateScope scope(this);  // will call detachOne()
-    _callback(std::move(_result));
-    /*SchedulerFeature::SCHEDULER->postContinuation([ref(std::move(scope))]() {
+    if (_executor == nullptr) {
+      _callback(std::move(_result));
+      return;
+    }
+    _executor->add([ref = std::move(scope)]() mutable {
       SharedState* state = ref._state;
       state->_callback(std::move(state->_result));
-    });*/
+    });
   }
 
  private:
   using Callback = fu2::unique_function<void(Try<T>&&)>;
+  using InterruptHandler = fu2::unique_function<void(std::exception_ptr const&)>;
   Callback _callback;
+  Executor* _executor;
   union {  // avoids having to construct the result
     Try<T> _result;
   };
   std::atomic<State> _state;
   std::atomic<uint8_t> _attached;
+  std::atomic<uint8_t> _interruptState;
+  std::exception_ptr _interrupt;
+  InterruptHandler _interruptHandler;
 };
 
 }  // namespace detail
@@ -129,6 +129,8 @@ void foreach (F&& f, Args && ... args) {
 /// if you are doing anything non-trivial after, you will probably want to
 /// follow with `via(executor)` because it will complete in whichever thread the
 /// last Future completes in.
+/// All Futures share one context, which holds the results and is allocated
+/// once, no matter how many Futures there are.
 /// The return type for Future<T> input is a Future<std::vector<Try<T>>>
 template <class InputIterator>
 Future<std::vector<Try<typename std::iterator_traits<InputIterator>::value_type::value_type>>> collectAll(
@@ -156,6 +158,42 @@ auto collectAll(Collection&& c) -> decltype(collectAll(c.begin(), c.end())) {
   return collectAll(c.begin(), c.end());
 }
 
+/// @brief The returned Future completes with the index and result of the
+/// first of the input Futures that completes, whether with a value or with
+/// an exception. The other results are dropped.
+/// The Futures are moved in, like with collectAll(). All of them share one
+/// context, which is released when the last one has completed.
+/// The returned Future must not be collected from an empty range.
+/// The return type for Future<T> input is a Future<std::pair<size_t, Try<T>>>
+template <class InputIterator>
+Future<std::pair<size_t, Try<typename std::iterator_traits<InputIterator>::value_type::value_type>>> collectAny(
+    InputIterator first, InputIterator last) {
+  using FT = typename std::iterator_traits<InputIterator>::value_type;
+  using T = typename FT::value_type;
+
+  struct Context {
+    Promise<std::pair<size_t, Try<T>>> p;
+    std::atomic<bool> done{false};
+  };
+
+  TRI_ASSERT(first != last);
+  auto ctx = std::make_shared<Context>();
+  auto future = ctx->p.getFuture();
+  for (size_t i = 0; first != last; ++first, ++i) {
+    first->thenFinal([i, ctx](Try<T>&& t) {
+      if (!ctx->done.exchange(true, std::memory_order_acq_rel)) {
+        ctx->p.setValue(std::make_pair(i, std::move(t)));
+      }
+    });
+  }
+  return future;
+}
+
+template <class Collection>
+auto collectAny(Collection&& c) -> decltype(collectAny(c.begin(), c.end())) {
+  return collectAny(c.begin(), c.end());
+}
+
 }  // namespace futures
 }  // namespace arangodb
 #endif  // ARANGOD_FUTURES_UTILITIES_H
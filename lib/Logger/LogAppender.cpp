@@ -177,13 +177,39 @@ std::pair<std::shared_ptr<LogAppender>, LogTopic*> LogAppender::buildAppender(
 }
 
 void LogAppender::log(LogMessage* message) {
+  MUTEX_LOCKER(guard, _appendersLock);
+
+  logLocked(message);
+}
+
+void LogAppender::log(std::vector<LogMessage*> const& messages) {
+  MUTEX_LOCKER(guard, _appendersLock);
+
+  for (auto const& it : _definition2appenders) {
+    it.second->startBatch();
+  }
+
+  for (auto* message : messages) {
+    try {
+      logLocked(message);
+    } catch (...) {
+    }
+  }
+
+  for (auto const& it : _definition2appenders) {
+    try {
+      it.second->finishBatch();
+    } catch (...) {
+    }
+  }
+}
+
+void LogAppender::logLocked(LogMessage* message) {
   LogLevel level = message->_level;
   size_t topicId = message->_topicId;
   std::string const& m = message->_message;
   size_t offset = message->_offset;
 
-  MUTEX_LOCKER(guard, _appendersLock);
-
   // output to appender
   auto output = [&level, &m, &offset](size_t n) -> bool {
     auto const& it = _topics2appenders.find(n);
@@ -46,6 +46,9 @@ class LogAppender {
       std::string const& definition, std::string const& contentFilter);
 
   static void log(LogMessage*);
+  // hand a batch of messages to the appenders. appenders may collect
+  // the output of the batch and write it at once
+  static void log(std::vector<LogMessage*> const&);
 
   static void reopen();
   static void shutdown();
@@ -59,6 +62,10 @@ class LogAppender {
 
   virtual std::string details() = 0;
 
+  // called before and after a batch of log messages is processed
+  virtual void startBatch() {}
+  virtual void finishBatch() {}
+
  public:
   void logMessage(LogLevel level, std::string const& message) {
     logMessage(level, message, 0);
@@ -75,6 +82,8 @@ class LogAppender {
   std::string const _filter;  // an optional content filter for log messages
 
  private:
+  static void logLocked(LogMessage*);
+
   static Mutex _appendersLock;
   static std::map<size_t, std::vector<std::shared_ptr<LogAppender>>> _topics2appenders;
   static std::map<std::pair<std::string, std::string>, std::shared_ptr<LogAppender>> _definition2appenders;
@@ -36,6 +36,9 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <fcntl.h>
+#ifndef _WIN32
+#include <sys/uio.h>
+#endif
 
 using namespace arangodb;
 using namespace arangodb::basics;
@@ -118,7 +121,7 @@ void LogAppenderStream::logMessage(LogLevel level, std::string const& message, s
 }
 
 LogAppenderFile::LogAppenderFile(std::string const& filename, std::string const& filter)
-    : LogAppenderStream(filename, filter, -1), _filename(filename) {
+    : LogAppenderStream(filename, filter, -1), _filename(filename), _inBatch(false) {
   if (_filename != "+" && _filename != "-") {
     // logging to an actual file
     size_t pos = 0;
@@ -126,6 +129,7 @@ LogAppenderFile::LogAppenderFile(std::string const& filename, std::string const&
       if (std::get<1>(it) == _filename) {
         // already have an appender for the same file
         _fd = std::get<0>(it);
+        _batch = std::get<2>(it)->_batch;
         break;
       }
       ++pos;
@@ -161,10 +165,47 @@ LogAppenderFile::LogAppenderFile(std::string const& filename, std::string const&
     }
   }
 
+  if (_batch == nullptr) {
+    _batch = std::make_shared<Batch>();
+  }
+
   _useColors = ((isatty(_fd) == 1) && Logger::getUseColor());
 }
 
 void LogAppenderFile::writeLogMessage(LogLevel level, char const* buffer, size_t len) {
+  if (_inBatch) {
+    Batch& batch = *_batch;
+    if (batch.used == batch.buffers.size()) {
+      batch.buffers.emplace_back();
+    }
+    // assign() keeps the capacity of the buffer, so buffers of previous
+    // batches can be filled without allocating
+    batch.buffers[batch.used].assign(buffer, len);
+    ++batch.used;
+    if (level == LogLevel::FATAL) {
+      batch.fatal = true;
+    }
+    if (batch.used >= maxBatchMessages) {
+      writeBatch();
+    }
+    return;
+  }
+
+  writeBuffer(buffer, len);
+
+  if (level == LogLevel::FATAL) {
+    flushFatal();
+  }
+}
+
+void LogAppenderFile::startBatch() { _inBatch = true; }
+
+void LogAppenderFile::finishBatch() {
+  _inBatch = false;
+  writeBatch();
+}
+
+void LogAppenderFile::writeBuffer(char const* buffer, size_t len) {
   bool giveUp = false;
 
   while (len > 0) {
@@ -186,15 +227,87 @@ void LogAppenderFile::writeLogMessage(LogLevel level, char const* buffer, size_t
     buffer += n;
     len -= n;
   }
+}
 
-  if (level == LogLevel::FATAL) {
-    FILE* f = TRI_FDOPEN(_fd, "a");
-    if (f != nullptr) {
-      // valid file pointer...
-      // now flush the file one last time before we shut down
-      fflush(f);
+void LogAppenderFile::writeBatch() {
+  Batch& batch = *_batch;
+  if (batch.used == 0) {
+    return;
+  }
+
+#ifdef _WIN32
+  for (size_t i = 0; i < batch.used; ++i) {
+    writeBuffer(batch.buffers[i].data(), batch.buffers[i].size());
+  }
+#else
+  // write all messages of the batch with as few system calls as possible
+  struct iovec iov[maxBatchMessages];
+  TRI_ASSERT(batch.used <= maxBatchMessages);
+  for (size_t i = 0; i < batch.used; ++i) {
+    iov[i].iov_base = const_cast<char*>(batch.buffers[i].data());
+    iov[i].iov_len = batch.buffers[i].size();
+  }
+
+  struct iovec* current = &iov[0];
+  int count = static_cast<int>(batch.used);
+  bool giveUp = false;
+
+  while (count > 0) {
+    ssize_t n = ::writev(_fd, current, count);
+
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      if (allowStdLogging()) {
+        fprintf(stderr, "cannot log data: %s\n", TRI_LAST_ERROR_STR);
+      }
+      break;  // give up, but do not try to log the failure via the Logger
+    }
+    if (n == 0) {
+      if (!giveUp) {
+        giveUp = true;
+        continue;
+      }
+      break;
+    }
+
+    // skip over what was written. a partial write may end in the middle
+    // of a message
+    size_t written = static_cast<size_t>(n);
+    while (count > 0 && written >= current->iov_len) {
+      written -= current->iov_len;
+      ++current;
+      --count;
+    }
+    if (count > 0) {
+      current->iov_base = static_cast<char*>(current->iov_base) + written;
+      current->iov_len -= written;
     }
   }
+#endif
+
+  for (size_t i = 0; i < batch.used; ++i) {
+    if (batch.buffers[i].capacity() > maxBufferSize) {
+      // do not keep overly large buffers around
+      std::string().swap(batch.buffers[i]);
+    }
+  }
+  batch.used = 0;
+
+  if (batch.fatal) {
+    batch.fatal = false;
+    flushFatal();
+  }
+}
+
+void LogAppenderFile::flushFatal() {
+  FILE* f = TRI_FDOPEN(_fd, "a");
+  if (f != nullptr) {
+    // valid file pointer...
+    // now flush the file one last time before we shut down
+    fflush(f);
+  }
 }
 
 std::string LogAppenderFile::details() {
@@ -80,6 +80,9 @@ class LogAppenderFile : public LogAppenderStream {
 
   std::string details() override final;
 
+  void startBatch() override final;
+  void finishBatch() override final;
+
  public:
   static void reopenAll();
   static void closeAll();
@@ -95,11 +98,35 @@ class LogAppenderFile : public LogAppenderStream {
   static void setFileGroup(int group) { _fileGroup = group; }
 
  private:
+  /// @brief output of the current batch, shared by all appenders that
+  /// write to the same file so that the order of messages is kept
+  struct Batch {
+    /// @brief buffers for the messages. they are reused for later batches
+    std::vector<std::string> buffers;
+    /// @brief number of buffers in use
+    size_t used = 0;
+    /// @brief whether the batch contains a fatal message
+    bool fatal = false;
+  };
+
+  /// @brief maximum number of messages written with a single writev call
+  static constexpr size_t maxBatchMessages = 64;
+
+  void writeBuffer(char const*, size_t);
+  void writeBatch();
+  void flushFatal();
+
   static std::vector<std::tuple<int, std::string, LogAppenderFile*>> _fds;
   static int _fileMode;
   static int _fileGroup;
 
   std::string _filename;
+
+  std::shared_ptr<Batch> _batch;
+
+  /// @brief whether messages are collected in _batch instead of being
+  /// written directly
+  bool _inBatch;
 };
 
 class LogAppenderStdStream : public LogAppenderStream {
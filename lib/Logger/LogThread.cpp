@@ -30,8 +30,12 @@ using namespace arangodb;
 
 arangodb::basics::ConditionVariable* LogThread::CONDITION = nullptr;
 boost::lockfree::queue<LogMessage*>* LogThread::MESSAGES = nullptr;
+std::atomic<size_t> LogThread::QUEUED(0);
+std::atomic<uint64_t> LogThread::DROPPED(0);
 
-LogThread::LogThread(std::string const& name) : Thread(name), _messages(0) {
+LogThread::LogThread(std::string const& name)
+    : Thread(name), _messages(0), _reportedDropped(DROPPED.load()) {
+  _batch.reserve(maxBatchSize);
   MESSAGES = &_messages;
   CONDITION = &_condition;
 }
@@ -43,12 +47,32 @@ LogThread::~LogThread() {
   shutdown();
 }
 
-void LogThread::log(std::unique_ptr<LogMessage>& message) {
+bool LogThread::log(std::unique_ptr<LogMessage>& message) {
+  LogLevel level = message->_level;
+  bool const isImportant =
+      (level == LogLevel::FATAL || level == LogLevel::ERR || level == LogLevel::WARN);
+
+  // count the message before it becomes visible to the log thread, so
+  // the counter cannot drop below zero
+  size_t queued = QUEUED.fetch_add(1, std::memory_order_relaxed);
+
+  if (!isImportant && queued >= Logger::_maxQueuedLogMessages) {
+    // the log thread cannot keep up. rather drop the message than let the
+    // queue grow without bounds. errors and warnings are always kept
+    QUEUED.fetch_sub(1, std::memory_order_relaxed);
+    DROPPED.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+
   if (MESSAGES->push(message.get())) {
     // only release message if adding to the queue succeeded
     // otherwise we would leak here
     message.release();
+    return true;
   }
+
+  QUEUED.fetch_sub(1, std::memory_order_relaxed);
+  return false;
 }
 
 void LogThread::flush() {
@@ -72,27 +96,47 @@ void LogThread::wakeup() {
 bool LogThread::hasMessages() { return (!MESSAGES->empty()); }
 
 void LogThread::run() {
-  LogMessage* msg;
-
   while (!isStopping() && Logger::_active.load()) {
-    while (_messages.pop(msg)) {
-      try {
-        LogAppender::log(msg);
-      } catch (...) {
-      }
-
-      delete msg;
-    }
+    processMessages();
 
     CONDITION_LOCKER(guard, *CONDITION);
     guard.wait(25 * 1000);
   }
 
-  while (_messages.pop(msg)) {
+  processMessages();
+}
+
+void LogThread::processMessages() {
+  LogMessage* msg;
+
+  while (true) {
+    TRI_ASSERT(_batch.empty());
+    while (_batch.size() < maxBatchSize && _messages.pop(msg)) {
+      QUEUED.fetch_sub(1, std::memory_order_relaxed);
+      // cannot throw, as we reserved enough space upfront
+      _batch.push_back(msg);
+    }
+
+    if (_batch.empty()) {
+      break;
+    }
+
     try {
-      LogAppender::log(msg);
+      LogAppender::log(_batch);
     } catch (...) {
     }
-    delete msg;
+
+    for (auto* it : _batch) {
+      delete it;
+    }
+    _batch.clear();
+  }
+
+  uint64_t dropped = DROPPED.load(std::memory_order_relaxed);
+  if (dropped != _reportedDropped) {
+    LOG_TOPIC("a5ef3", WARN, arangodb::Logger::FIXME)
+        << "dropped " << (dropped - _reportedDropped)
+        << " log message(s) because the log queue was full";
+    _reportedDropped = dropped;
   }
 }
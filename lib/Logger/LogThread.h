@@ -29,6 +29,9 @@
 
 #include <boost/lockfree/queue.hpp>
 
+#include <atomic>
+#include <vector>
+
 namespace arangodb {
 namespace basics {
 class ConditionVariable;
@@ -38,9 +41,16 @@ struct LogMessage;
 
 class LogThread final : public Thread {
  public:
-  static void log(std::unique_ptr<LogMessage>&);
+  // queue a message. returns false if the message could not be queued and
+  // must be logged directly. messages that are dropped because the queue
+  // is full count as handled
+  static bool log(std::unique_ptr<LogMessage>&);
   // flush all pending log messages
   static void flush();
+  // number of log messages dropped because the queue was full
+  static uint64_t droppedMessages() {
+    return DROPPED.load(std::memory_order_relaxed);
+  }
 
  public:
   explicit LogThread(std::string const& name);
@@ -57,11 +67,25 @@ class LogThread final : public Thread {
   void wakeup();
 
  private:
+  // hand all queued messages to the appenders, in batches
+  void processMessages();
+
+  // maximum number of messages handed to the appenders at once
+  static constexpr size_t maxBatchSize = 256;
+
   static arangodb::basics::ConditionVariable* CONDITION;
   static boost::lockfree::queue<LogMessage*>* MESSAGES;
+  static std::atomic<size_t> QUEUED;
+  static std::atomic<uint64_t> DROPPED;
 
   arangodb::basics::ConditionVariable _condition;
   boost::lockfree::queue<LogMessage*> _messages;
+
+  // messages of the current batch. only used by the log thread
+  std::vector<LogMessage*> _batch;
+
+  // number of dropped messages already reported
+  uint64_t _reportedDropped;
 };
 }  // namespace arangodb
 
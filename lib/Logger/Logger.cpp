@@ -68,6 +68,7 @@ bool Logger::_useEscaped(true);
 bool Logger::_keepLogRotate(false);
 bool Logger::_logRequestParameters(true);
 bool Logger::_showRole(false);
+size_t Logger::_maxQueuedLogMessages(16384);
 char Logger::_role('\0');
 TRI_pid_t Logger::_cachedPid(0);
 std::string Logger::_outputPrefix("");
@@ -264,6 +265,16 @@ void Logger::setLogRequestParameters(bool log) {
   _logRequestParameters = log;
 }
 
+// NOTE: this function should not be called if the logging is active.
+void Logger::setMaxQueuedLogMessages(size_t value) {
+  if (_active) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(
+        TRI_ERROR_INTERNAL, "cannot change settings once logging is active");
+  }
+
+  _maxQueuedLogMessages = value;
+}
+
 std::string const& Logger::translateLogLevel(LogLevel level) {
   switch (level) {
     case LogLevel::DEFAULT:
@@ -375,13 +386,15 @@ void Logger::log(char const* function, char const* file, int line,
   // now either queue or output the message
   if (_threaded) {
     try {
-      _loggingThread->log(msg);
-      bool const isDirectLogLevel =
-          (level == LogLevel::FATAL || level == LogLevel::ERR || level == LogLevel::WARN);
-      if (isDirectLogLevel) {
-        _loggingThread->flush();
+      if (_loggingThread->log(msg)) {
+        bool const isDirectLogLevel =
+            (level == LogLevel::FATAL || level == LogLevel::ERR || level == LogLevel::WARN);
+        // the logging thread itself must not wait for its own queue
+        if (isDirectLogLevel && !_loggingThread->runningInThisThread()) {
+          _loggingThread->flush();
+        }
+        return;
       }
-      return;
     } catch (...) {
       // fall-through to non-threaded logging
     }
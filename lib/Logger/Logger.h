@@ -238,6 +238,7 @@ class Logger {
   static void setKeepLogrotate(bool);
   static void setLogRequestParameters(bool);
   static bool logRequestParameters() { return _logRequestParameters; }
+  static void setMaxQueuedLogMessages(size_t);
 
   // can be called after fork()
   static void clearCachedPid() { _cachedPid = 0; }
@@ -282,6 +283,7 @@ class Logger {
   static bool _keepLogRotate;
   static bool _logRequestParameters;
   static bool _showIds;
+  static size_t _maxQueuedLogMessages;
   static char _role;  // current server role to log
   static TRI_pid_t _cachedPid;
   static std::string _outputPrefix;
@@ -172,6 +172,12 @@ void LoggerFeature::collectOptions(std::shared_ptr<ProgramOptions> options) {
                      new BooleanParameter(&_forceDirect),
                      arangodb::options::makeFlags(arangodb::options::Flags::Hidden));
 
+  options->addOption("--log.max-queued-entries",
+                     "maximum number of log messages queued for the logging "
+                     "thread. debug and info messages beyond this are dropped",
+                     new UInt64Parameter(&_maxQueuedLogMessages),
+                     arangodb::options::makeFlags(arangodb::options::Flags::Hidden));
+
   options->addOption(
       "--log.request-parameters",
       "include full URLs and HTTP request parameters in trace logs",
@@ -283,6 +289,7 @@ void LoggerFeature::prepare() {
   Logger::setOutputPrefix(_prefix);
   Logger::setKeepLogrotate(_keepLogRotate);
   Logger::setLogRequestParameters(_logRequestParameters);
+  Logger::setMaxQueuedLogMessages(static_cast<size_t>(_maxQueuedLogMessages));
 
   for (auto const& definition : _output) {
     if (_supervisor && StringUtils::isPrefix(definition, "file://")) {
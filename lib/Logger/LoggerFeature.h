@@ -52,6 +52,7 @@ class LoggerFeature final : public application_features::ApplicationFeature {
   std::string _fileMode;
   std::string _fileGroup;
   std::string _timeFormatString;
+  uint64_t _maxQueuedLogMessages = 16384;
   bool _useLocalTime = false;
   bool _useColor = true;
   bool _useEscaped = true;
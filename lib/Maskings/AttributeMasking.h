@@ -56,6 +56,7 @@ class AttributeMasking {
   bool match(std::vector<std::string> const&) const;
 
   MaskingFunction* func() const { return _func.get(); }
+  Path const& path() const noexcept { return _path; }
 
  private:
   static std::unordered_map<std::string, ParseResult<AttributeMasking> (*)(Path, Maskings*, VPackSlice const&)> _maskings;
@@ -27,6 +27,27 @@
 using namespace arangodb;
 using namespace arangodb::maskings;
 
+Collection::Collection(CollectionSelection selection,
+                       std::vector<AttributeMasking> const& maskings)
+    : _selection(selection), _maskings(maskings), _paths(1), _suffixes(1), _any(NoNode) {
+  // compile the definitions into tries, so that an attribute path is
+  // matched against all of them in one walk
+  for (size_t i = 0; i < _maskings.size(); ++i) {
+    Path const& path = _maskings[i].path();
+    auto const& components = path.components();
+
+    if (path.any()) {
+      if (_any == NoNode) {
+        _any = i;
+      }
+    } else if (path.wildcard()) {
+      insert(_suffixes, components.rbegin(), components.rend(), i);
+    } else {
+      insert(_paths, components.begin(), components.end(), i);
+    }
+  }
+}
+
 ParseResult<Collection> Collection::parse(Maskings* maskings, VPackSlice const& def) {
   if (!def.isObject()) {
     return ParseResult<Collection>(
@@ -97,3 +118,73 @@ MaskingFunction* Collection::masking(std::vector<std::string> const& path) {
 
   return nullptr;
 }
+
+size_t Collection::child(size_t node, velocypack::StringRef const& key) const {
+  return child(_paths, node, key);
+}
+
+MaskingFunction* Collection::masking(size_t node,
+                                     std::vector<velocypack::StringRef> const& path) const {
+  // the first matching definition wins
+  size_t result = _any;
+
+  if (node != NoNode && _paths[node].masking < result) {
+    result = _paths[node].masking;
+  }
+
+  size_t suffix = 0;
+
+  for (auto it = path.rbegin(); it != path.rend(); ++it) {
+    suffix = child(_suffixes, suffix, *it);
+
+    if (suffix == NoNode) {
+      break;
+    }
+
+    if (_suffixes[suffix].masking < result) {
+      result = _suffixes[suffix].masking;
+    }
+  }
+
+  if (result == NoNode) {
+    return nullptr;
+  }
+
+  return _maskings[result].func();
+}
+
+size_t Collection::child(std::vector<Node> const& trie, size_t node,
+                         velocypack::StringRef const& key) {
+  if (node == NoNode) {
+    return NoNode;
+  }
+
+  for (auto const& it : trie[node].children) {
+    if (key == it.first) {
+      return it.second;
+    }
+  }
+
+  return NoNode;
+}
+
+template <typename It>
+void Collection::insert(std::vector<Node>& trie, It begin, It end, size_t masking) {
+  size_t node = 0;
+
+  for (; begin != end; ++begin) {
+    size_t next = child(trie, node, velocypack::StringRef(*begin));
+
+    if (next == NoNode) {
+      next = trie.size();
+      trie[node].children.emplace_back(*begin, next);
+      trie.emplace_back();
+    }
+
+    node = next;
+  }
+
+  if (trie[node].masking == NoNode) {
+    trie[node].masking = masking;
+  }
+}
@@ -29,6 +29,7 @@
 #include <velocypack/Iterator.h>
 #include <velocypack/Parser.h>
 #include <velocypack/Slice.h>
+#include <velocypack/StringRef.h>
 #include <velocypack/velocypack-aliases.h>
 
 #include "Maskings/AttributeMasking.h"
@@ -43,19 +44,57 @@ class Collection {
   static ParseResult<Collection> parse(Maskings* maskings, VPackSlice const&);
 
  public:
-  Collection() {}
+  /// @brief no node of the path trie
+  static constexpr size_t NoNode = SIZE_MAX;
 
-  Collection(CollectionSelection selection, std::vector<AttributeMasking> const& maskings)
-      : _selection(selection), _maskings(maskings) {}
+ public:
+  Collection()
+      : _selection(CollectionSelection::FULL), _paths(1), _suffixes(1), _any(NoNode) {}
+
+  Collection(CollectionSelection selection, std::vector<AttributeMasking> const& maskings);
 
   CollectionSelection selection() const noexcept { return _selection; }
 
+  /// @brief the masking of the first definition matching the path
   MaskingFunction* masking(std::vector<std::string> const& path);
 
+  /// @brief the trie node of the attribute path that is a full path of a
+  /// definition, or a prefix of one. the root is node 0
+  size_t child(size_t node, velocypack::StringRef const& key) const;
+
+  /// @brief whether definitions match paths by their suffix, so that every
+  /// attribute has to be looked at
+  bool matchesSuffixes() const noexcept {
+    return _any != NoNode || _suffixes.size() > 1;
+  }
+
+  /// @brief the masking of the first definition matching the path, whose
+  /// node in the path trie is given
+  MaskingFunction* masking(size_t node, std::vector<velocypack::StringRef> const& path) const;
+
+ private:
+  struct Node {
+    std::vector<std::pair<std::string, size_t>> children;
+    /// @brief first definition ending in this node
+    size_t masking = NoNode;
+  };
+
+  static size_t child(std::vector<Node> const& trie, size_t node,
+                      velocypack::StringRef const& key);
+  template <typename It>
+  static void insert(std::vector<Node>& trie, It begin, It end, size_t masking);
+
  private:
   CollectionSelection _selection;
   // LATER: CollectionFilter _filter;
   std::vector<AttributeMasking> _maskings;
+
+  /// @brief trie of the full paths of the definitions
+  std::vector<Node> _paths;
+  /// @brief trie of the reversed paths of the definitions starting with '.'
+  std::vector<Node> _suffixes;
+  /// @brief first definition matching all paths
+  size_t _any;
 };
 }  // namespace maskings
 }  // namespace arangodb
@@ -25,9 +25,11 @@
 #include <iostream>
 
 #include "Basics/FileUtils.h"
+#include "Basics/VPackStringBufferAdapter.h"
 #include "Logger/Logger.h"
 #include "Random/RandomGenerator.h"
 
+#include <velocypack/Dumper.h>
 #include <velocypack/Iterator.h>
 #include <velocypack/Parser.h>
 #include <velocypack/velocypack-aliases.h>
@@ -176,136 +178,138 @@ bool Maskings::shouldDumpData(std::string const& name) {
   return false;
 }
 
-VPackValue Maskings::maskedItem(Collection& collection, std::vector<std::string>& path,
-                                std::string& buffer, VPackSlice const& data) {
-  static std::string xxxx("xxxx");
-
+void Maskings::addMaskedItem(Collection const& collection, velocypack::Dumper& dumper,
+                             std::vector<velocypack::StringRef> const& path,
+                             size_t node, VPackSlice const& data) {
   if (path.size() == 1 && path[0].size() >= 1 && path[0][0] == '_') {
-    if (data.isString()) {
-      velocypack::ValueLength length;
-      char const* c = data.getString(length);
-      buffer = std::string(c, length);
-      return VPackValue(buffer);
-    } else if (data.isInteger()) {
-      return VPackValue(data.getInt());
+    if (data.isString() || data.isInteger()) {
+      dumper.append(data);
+      return;
     }
   }
 
-  MaskingFunction* func = collection.masking(path);
+  MaskingFunction* func = collection.masking(node, path);
 
   if (func == nullptr) {
-    if (data.isBool()) {
-      return VPackValue(data.getBool());
-    } else if (data.isString()) {
-      velocypack::ValueLength length;
-      char const* c = data.getString(length);
-      buffer = std::string(c, length);
-      return VPackValue(buffer);
-    } else if (data.isInteger()) {
-      return VPackValue(data.getInt());
-    } else if (data.isDouble()) {
-      return VPackValue(data.getDouble());
-    } else {
-      return VPackValue(VPackValueType::Null);
-    }
+    dumper.append(data);
+    return;
+  }
+
+  std::string buffer;
+  VPackBuilder masked;
+
+  if (data.isBool()) {
+    masked.add(func->mask(data.getBool(), buffer));
+  } else if (data.isString()) {
+    velocypack::ValueLength length;
+    char const* c = data.getString(length);
+    masked.add(func->mask(std::string(c, length), buffer));
+  } else if (data.isInteger()) {
+    masked.add(func->mask(data.getInt(), buffer));
+  } else if (data.isDouble()) {
+    masked.add(func->mask(data.getDouble(), buffer));
   } else {
-    if (data.isBool()) {
-      return func->mask(data.getBool(), buffer);
-    } else if (data.isString()) {
-      velocypack::ValueLength length;
-      char const* c = data.getString(length);
-      return func->mask(std::string(c, length), buffer);
-    } else if (data.isInteger()) {
-      return func->mask(data.getInt(), buffer);
-    } else if (data.isDouble()) {
-      return func->mask(data.getDouble(), buffer);
-    } else {
-      return VPackValue(VPackValueType::Null);
-    }
+    masked.add(VPackValue(VPackValueType::Null));
   }
 
-  return VPackValue(xxxx);
+  dumper.append(masked.slice());
 }
 
-void Maskings::addMaskedArray(Collection& collection, VPackBuilder& builder,
-                              std::vector<std::string>& path, VPackSlice const& data) {
-  for (auto const& entry : VPackArrayIterator(data)) {
-    if (entry.isObject()) {
-      VPackObjectBuilder ob(&builder);
-      addMaskedObject(collection, builder, path, entry);
-    } else if (entry.isArray()) {
-      VPackArrayBuilder ap(&builder);
-      addMaskedArray(collection, builder, path, entry);
-    } else {
-      std::string buffer;
-      builder.add(maskedItem(collection, path, buffer, entry));
-    }
+void Maskings::addMasked(Collection const& collection, velocypack::Dumper& dumper,
+                         std::vector<velocypack::StringRef>& path, size_t node,
+                         VPackSlice const& data) {
+  bool const isObject = data.isObject();
+
+  if (!isObject && !data.isArray()) {
+    addMaskedItem(collection, dumper, path, node, data);
+    return;
   }
-}
 
-void Maskings::addMaskedObject(Collection& collection, VPackBuilder& builder,
-                               std::vector<std::string>& path, VPackSlice const& data) {
-  for (auto const& entry : VPackObjectIterator(data, false)) {
-    std::string key = entry.key.copyString();
-    VPackSlice const& value = entry.value;
+  if (node == Collection::NoNode && !collection.matchesSuffixes()) {
+    // no definition can match an attribute below this one
+    dumper.append(data);
+    return;
+  }
 
-    path.push_back(key);
+  velocypack::Sink* sink = dumper.sink();
 
-    if (value.isObject()) {
-      VPackObjectBuilder ob(&builder, key);
-      addMaskedObject(collection, builder, path, value);
-    } else if (value.isArray()) {
-      VPackArrayBuilder ap(&builder, key);
-      addMaskedArray(collection, builder, path, value);
-    } else {
-      std::string buffer;
-      builder.add(key, maskedItem(collection, path, buffer, value));
+  if (isObject) {
+    sink->push_back('{');
+    bool first = true;
+
+    for (auto const& entry : VPackObjectIterator(data, false)) {
+      velocypack::StringRef key = entry.key.stringRef();
+
+      if (!first) {
+        sink->push_back(',');
+      }
+      first = false;
+
+      dumper.appendString(key.data(), key.size());
+      sink->push_back(':');
+
+      path.push_back(key);
+      addMasked(collection, dumper, path, collection.child(node, key), entry.value);
+      path.pop_back();
     }
 
-    path.pop_back();
-  }
-}
+    sink->push_back('}');
+  } else {
+    // the members of an array have the path of the array
+    sink->push_back('[');
+    bool first = true;
 
-void Maskings::addMasked(Collection& collection, VPackBuilder& builder,
-                         VPackSlice const& data) {
-  if (!data.isObject()) {
-    return;
-  }
+    for (auto const& entry : VPackArrayIterator(data)) {
+      if (!first) {
+        sink->push_back(',');
+      }
+      first = false;
 
-  std::vector<std::string> path;
-  std::string dataStr("data");
-  VPackObjectBuilder ob(&builder, dataStr);
+      addMasked(collection, dumper, path, node, entry);
+    }
 
-  addMaskedObject(collection, builder, path, data);
+    sink->push_back(']');
+  }
 }
 
-void Maskings::addMasked(Collection& collection, basics::StringBuffer& data,
+void Maskings::addMasked(Collection const& collection, velocypack::Dumper& dumper,
                          VPackSlice const& slice) {
   if (!slice.isObject()) {
     return;
   }
 
   velocypack::StringRef dataStrRef("data");
+  velocypack::Sink* sink = dumper.sink();
+  std::vector<velocypack::StringRef> path;
 
-  VPackBuilder builder;
+  sink->push_back('{');
+  bool first = true;
 
-  {
-    VPackObjectBuilder ob(&builder);
+  for (auto const& entry : VPackObjectIterator(slice, false)) {
+    velocypack::StringRef key = entry.key.stringRef();
+    bool const isData = key.equals(dataStrRef);
 
-    for (auto const& entry : VPackObjectIterator(slice, false)) {
-      velocypack::StringRef key = entry.key.stringRef();
+    if (isData && !entry.value.isObject()) {
+      continue;
+    }
 
-      if (key.equals(dataStrRef)) {
-        addMasked(collection, builder, entry.value);
-      } else {
-        builder.add(key, entry.value);
-      }
+    if (!first) {
+      sink->push_back(',');
+    }
+    first = false;
+
+    dumper.appendString(key.data(), key.size());
+    sink->push_back(':');
+
+    if (isData) {
+      addMasked(collection, dumper, path, 0, entry.value);
+    } else {
+      dumper.append(entry.value);
     }
   }
 
-  std::string masked = builder.toJson();
-  data.appendText(masked);
-  data.appendText("\n");
+  sink->push_back('}');
+  sink->push_back('\n');
 }
 
 void Maskings::mask(std::string const& name, basics::StringBuffer const& data,
@@ -333,6 +337,12 @@ void Maskings::mask(std::string const& name, basics::StringBuffer const& data,
 
   result.reserve(data.length());
 
+  // the masked documents are written to the result as they are walked,
+  // without building them in between
+  basics::VPackStringBufferAdapter adapter(result.stringBuffer());
+  velocypack::Dumper dumper(&adapter);
+  velocypack::Parser parser;
+
   char const* p = data.c_str();
   char const* e = p + data.length();
   char const* q = p;
@@ -342,9 +352,10 @@ void Maskings::mask(std::string const& name, basics::StringBuffer const& data,
       ++p;
     }
 
-    std::shared_ptr<VPackBuilder> builder = VPackParser::fromJson(q, p - q);
+    parser.clear();
+    parser.parse(q, p - q);
 
-    addMasked(*collection, result, builder->slice());
+    addMasked(*collection, dumper, parser.builder().slice());
 
     while (p < e && (*p == '\n' || *p == '\r')) {
       ++p;
@@ -28,7 +28,9 @@
 #include "Basics/Common.h"
 
 #include <velocypack/Builder.h>
+#include <velocypack/Dumper.h>
 #include <velocypack/Slice.h>
+#include <velocypack/StringRef.h>
 #include <velocypack/velocypack-aliases.h>
 
 #include "Basics/StringBuffer.h"
@@ -71,14 +73,14 @@ class Maskings {
 
  private:
   ParseResult<Maskings> parse(VPackSlice const&);
-  VPackValue maskedItem(Collection& collection, std::vector<std::string>& path,
-                        std::string& buffer, VPackSlice const& data);
-  void addMaskedArray(Collection& collection, VPackBuilder& builder,
-                      std::vector<std::string>& path, VPackSlice const& data);
-  void addMaskedObject(Collection& collection, VPackBuilder& builder,
-                       std::vector<std::string>& path, VPackSlice const& data);
-  void addMasked(Collection& collection, VPackBuilder& builder, VPackSlice const& data);
-  void addMasked(Collection& collection, basics::StringBuffer& data, VPackSlice const& slice);
+  void addMaskedItem(Collection const& collection, velocypack::Dumper& dumper,
+                     std::vector<velocypack::StringRef> const& path, size_t node,
+                     VPackSlice const& data);
+  void addMasked(Collection const& collection, velocypack::Dumper& dumper,
+                 std::vector<velocypack::StringRef>& path, size_t node,
+                 VPackSlice const& data);
+  void addMasked(Collection const& collection, velocypack::Dumper& dumper,
+                 VPackSlice const& slice);
 
  private:
   std::map<std::string, Collection> _collections;
@@ -34,13 +34,19 @@ class Path {
   static ParseResult<Path> parse(std::string const&);
 
  public:
-  Path() : _wildcard(false) {}
+  Path() : _wildcard(false), _any(false) {}
 
   Path(bool wildcard, bool any, std::vector<std::string> const& components)
       : _wildcard(wildcard), _any(any), _components(components) {}
 
   bool match(std::vector<std::string> const& path) const;
 
+  bool wildcard() const noexcept { return _wildcard; }
+  bool any() const noexcept { return _any; }
+  std::vector<std::string> const& components() const noexcept {
+    return _components;
+  }
+
  private:
   bool _wildcard;
   bool _any;
@@ -37,6 +37,7 @@
 #include <velocypack/velocypack-aliases.h>
 
 namespace arangodb {
+class RequestBodyStream;
 
 namespace velocypack {
 class Builder;
@@ -208,6 +209,16 @@ class GeneralRequest {
   /// @brief parsed request payload
   virtual VPackSlice payload(arangodb::velocypack::Options const* options = &VPackOptions::Defaults) = 0;
 
+  /// @brief the body while it is still being received, nullptr if the
+  /// request was dispatched with its complete body. handlers that get a
+  /// stream find rawPayload() and payload() empty
+  std::shared_ptr<RequestBodyStream> const& bodyStream() const {
+    return _bodyStream;
+  }
+  void setBodyStream(std::shared_ptr<RequestBodyStream> stream) {
+    _bodyStream = std::move(stream);
+  }
+
   TEST_VIRTUAL std::shared_ptr<VPackBuilder> toVelocyPackBuilderPtr();
   std::shared_ptr<VPackBuilder> toVelocyPackBuilderPtrNoUniquenessChecks() {
     return std::make_shared<VPackBuilder>(payload());
@@ -255,6 +266,8 @@ class GeneralRequest {
   std::unordered_map<std::string, std::string> _headers;
   std::unordered_map<std::string, std::string> _values;
   std::unordered_map<std::string, std::vector<std::string>> _arrayValues;
+
+  std::shared_ptr<RequestBodyStream> _bodyStream;
 };
 }  // namespace arangodb
 
@@ -44,6 +44,7 @@ using rest::ContentType;
 using rest::ResponseCode;
 
 class GeneralRequest;
+class ResponseBodyStream;
 
 class GeneralResponse {
   GeneralResponse() = delete;
@@ -158,6 +159,21 @@ class GeneralResponse {
   /// used for head
   virtual bool setGenerateBody(bool) { return _generateBody; };
 
+  /// @brief whether the connection can send a body that is produced after
+  /// the response has been handed over, see setBodyStream
+  bool allowBodyStream() const { return _allowBodyStream; }
+  void setAllowBodyStream(bool allow) { _allowBodyStream = allow; }
+
+  /// @brief the body is written into the stream after the response has
+  /// been handed over, the body set on the response itself is ignored
+  std::shared_ptr<ResponseBodyStream> const& bodyStream() const {
+    return _bodyStream;
+  }
+  void setBodyStream(std::shared_ptr<ResponseBodyStream> stream) {
+    TRI_ASSERT(_allowBodyStream || stream == nullptr);
+    _bodyStream = std::move(stream);
+  }
+
  protected:
   ResponseCode _responseCode;                             // http response code
   std::unordered_map<std::string, std::string> _headers;  // headers/metadata map
@@ -166,6 +182,8 @@ class GeneralResponse {
   ConnectionType _connectionType;
   bool _generateBody;
   ContentType _contentTypeRequested;
+  bool _allowBodyStream;
+  std::shared_ptr<ResponseBodyStream> _bodyStream;
 };
 }  // namespace arangodb
 
@@ -33,6 +33,7 @@ class RestBatchHandler;
 
 namespace rest {
 class GeneralCommTask;
+class Http2CommTask;
 class HttpCommTask;
 }  // namespace rest
 
@@ -43,6 +44,7 @@ struct Options;
 
 class HttpRequest final : public GeneralRequest {
   friend class rest::HttpCommTask;
+  friend class rest::Http2CommTask;
   friend class rest::GeneralCommTask;
   friend class RestBatchHandler;  // TODO must be removed
 
@@ -72,6 +74,9 @@ class HttpRequest final : public GeneralRequest {
     return arangodb::Endpoint::TransportType::HTTP;
   }
 
+  // the HTTP/2 stream id, 1 for HTTP/1 requests
+  uint64_t messageId() const override { return _messageId; }
+
   std::string const& cookieValue(std::string const& key) const;
   std::string const& cookieValue(std::string const& key, bool& found) const;
   std::unordered_map<std::string, std::string> cookieValues() const {
@@ -80,6 +85,7 @@ class HttpRequest final : public GeneralRequest {
 
   std::string const& body() const;
   void setBody(char const* body, size_t length);
+  void setBody(std::string&& body) { _body = std::move(body); }
 
   /// @brief the body content length
   size_t contentLength() const override { return _contentLength; }
@@ -118,6 +124,7 @@ class HttpRequest final : public GeneralRequest {
  private:
   std::unordered_map<std::string, std::string> _cookies;
   int64_t _contentLength;
+  uint64_t _messageId = 1;
   std::unique_ptr<char[]> _header;
   std::string _body;
 
@@ -30,6 +30,9 @@
 #include <velocypack/velocypack-aliases.h>
 #include <time.h>
 
+#include <atomic>
+#include <chrono>
+
 #include "Basics/Exceptions.h"
 #include "Basics/StringBuffer.h"
 #include "Basics/StringUtils.h"
@@ -44,6 +47,16 @@ using namespace arangodb;
 using namespace arangodb::basics;
 
 bool HttpResponse::HIDE_PRODUCT_HEADER = false;
+uint64_t HttpResponse::COMPRESSION_THRESHOLD = 0;
+
+namespace {
+std::atomic<uint64_t> compressedResponses(0);
+std::atomic<uint64_t> compressionFailures(0);
+std::atomic<uint64_t> uncompressedBytes(0);
+std::atomic<uint64_t> compressedBytes(0);
+// in microseconds
+std::atomic<uint64_t> compressionTime(0);
+}  // namespace
 
 HttpResponse::HttpResponse(ResponseCode code, basics::StringBuffer* buffer)
     : GeneralResponse(code), _isHeadResponse(false), _body(buffer), _bodySize(0) {
@@ -379,3 +392,109 @@ void HttpResponse::addPayloadInternal(VPackSlice output, size_t inputLength,
     }
   }
 }
+
+std::string HttpResponse::negotiateEncoding(std::string const& acceptEncoding) {
+  double gzipQuality = -1.0;
+  double deflateQuality = -1.0;
+  double anyQuality = -1.0;
+
+  for (std::string const& item : StringUtils::split(acceptEncoding, ',')) {
+    // coding [; q=quality]
+    std::vector<std::string> parts = StringUtils::split(item, ';');
+    if (parts.empty()) {
+      continue;
+    }
+    std::string const coding = StringUtils::tolower(StringUtils::trim(parts[0]));
+    double quality = 1.0;
+
+    for (size_t i = 1; i < parts.size(); ++i) {
+      std::string const param = StringUtils::trim(parts[i]);
+      if (param.size() > 2 && (param[0] == 'q' || param[0] == 'Q') && param[1] == '=') {
+        quality = StringUtils::doubleDecimal(param.substr(2));
+      }
+    }
+
+    if (coding == "gzip" || coding == "x-gzip") {
+      gzipQuality = quality;
+    } else if (coding == "deflate") {
+      deflateQuality = quality;
+    } else if (coding == "*") {
+      anyQuality = quality;
+    }
+  }
+
+  // codings not mentioned get the quality of "*"
+  if (gzipQuality < 0.0) {
+    gzipQuality = anyQuality;
+  }
+  if (deflateQuality < 0.0) {
+    deflateQuality = anyQuality;
+  }
+
+  if (gzipQuality > 0.0 && gzipQuality >= deflateQuality) {
+    return "gzip";
+  }
+  if (deflateQuality > 0.0) {
+    return "deflate";
+  }
+  return std::string();
+}
+
+void HttpResponse::compressionStatistics(VPackBuilder& b) {
+  uint64_t const uncompressed = uncompressedBytes.load(std::memory_order_relaxed);
+  uint64_t const compressed = compressedBytes.load(std::memory_order_relaxed);
+
+  b.add("responses", VPackValue(compressedResponses.load(std::memory_order_relaxed)));
+  b.add("failures", VPackValue(compressionFailures.load(std::memory_order_relaxed)));
+  b.add("bytesUncompressed", VPackValue(uncompressed));
+  b.add("bytesCompressed", VPackValue(compressed));
+  b.add("ratio", VPackValue(compressed == 0 ? 0.0
+                                            : static_cast<double>(uncompressed) /
+                                                  static_cast<double>(compressed)));
+  b.add("time", VPackValue(static_cast<double>(compressionTime.load(std::memory_order_relaxed)) /
+                           1000000.0));
+}
+
+bool HttpResponse::compressBody(std::string const& acceptEncoding) {
+  if (COMPRESSION_THRESHOLD == 0 || _body == nullptr || _isHeadResponse ||
+      _body->length() < COMPRESSION_THRESHOLD ||
+      _headers.find(StaticStrings::ContentEncoding) != _headers.end()) {
+    // too small, or the body has been encoded already, e.g. by Foxx
+    return false;
+  }
+
+  std::string const encoding = negotiateEncoding(acceptEncoding);
+
+  if (encoding.empty()) {
+    return false;
+  }
+
+  size_t const length = _body->length();
+  auto const start = std::chrono::steady_clock::now();
+
+  // the body is left untouched if compression fails
+  int res = (encoding == "gzip") ? _body->gzip(16384) : _body->deflate(16384);
+
+  compressionTime.fetch_add(std::chrono::duration_cast<std::chrono::microseconds>(
+                                std::chrono::steady_clock::now() - start)
+                                .count(),
+                            std::memory_order_relaxed);
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    compressionFailures.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  compressedResponses.fetch_add(1, std::memory_order_relaxed);
+  uncompressedBytes.fetch_add(length, std::memory_order_relaxed);
+  compressedBytes.fetch_add(_body->length(), std::memory_order_relaxed);
+
+  _headers[StaticStrings::ContentEncoding] = encoding;
+  auto it = _headers.find(StaticStrings::Vary);
+  if (it == _headers.end()) {
+    _headers.emplace(StaticStrings::Vary, StaticStrings::AcceptEncoding);
+  } else if (it->second != "*") {
+    it->second.append(", ").append(StaticStrings::AcceptEncoding);
+  }
+  return true;
+}
@@ -32,19 +32,36 @@
 namespace arangodb {
 class RestBatchHandler;
 
+namespace velocypack {
+class Builder;
+}
+
 namespace rest {
+class Http2CommTask;
 class HttpCommTask;
 class GeneralCommTask;
 }  // namespace rest
 
 class HttpResponse : public GeneralResponse {
   friend class rest::HttpCommTask;
+  friend class rest::Http2CommTask;
   friend class rest::GeneralCommTask;
   friend class RestBatchHandler;  // TODO must be removed
 
  public:
   static bool HIDE_PRODUCT_HEADER;
 
+  /// @brief bodies of at least this size are compressed if the client
+  /// accepts it, 0 turns compression off
+  static uint64_t COMPRESSION_THRESHOLD;
+
+  /// @brief the content coding of an Accept-Encoding header value the
+  /// server answers with, "gzip", "deflate" or empty for none
+  static std::string negotiateEncoding(std::string const& acceptEncoding);
+
+  /// @brief totals of all compressed responses, for the server statistics
+  static void compressionStatistics(velocypack::Builder&);
+
  public:
   explicit HttpResponse(ResponseCode code, basics::StringBuffer* leased);
   ~HttpResponse();
@@ -94,9 +111,13 @@ class HttpResponse : public GeneralResponse {
     return arangodb::Endpoint::TransportType::HTTP;
   }
 
+  // the HTTP/2 stream id, 1 for HTTP/1 responses
+  uint64_t messageId() const override { return _messageId; }
+
  private:
-  // the body must already be set. deflate is then run on the existing body
-  int deflate(size_t = 16384);
+  // the body must already be set. it is compressed if the client accepts
+  // an encoding and it is large enough. returns whether it was compressed
+  bool compressBody(std::string const& acceptEncoding);
 
   std::unique_ptr<basics::StringBuffer> stealBody() {
     std::unique_ptr<basics::StringBuffer> bb(_body);
@@ -106,6 +127,7 @@ class HttpResponse : public GeneralResponse {
 
  private:
   bool _isHeadResponse;
+  uint64_t _messageId = 1;
   std::vector<std::string> _cookies;
   basics::StringBuffer* _body;
   size_t _bodySize;
@@ -0,0 +1,111 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "RequestBodyStream.h"
+#include "Basics/ConditionLocker.h"
+
+using namespace arangodb;
+
+constexpr size_t RequestBodyStream::DefaultMaxBuffered;
+
+RequestBodyStream::RequestBodyStream(size_t length, size_t maxBuffered)
+    : _length(length),
+      _maxBuffered(maxBuffered),
+      _buffered(0),
+      _finished(false),
+      _aborted(false),
+      _paused(false) {}
+
+void RequestBodyStream::setResumeCallback(std::function<void()> const& callback) {
+  CONDITION_LOCKER(guard, _condition);
+  _resume = callback;
+}
+
+bool RequestBodyStream::append(char const* data, size_t length) {
+  CONDITION_LOCKER(guard, _condition);
+
+  if (_aborted || _finished) {
+    return true;
+  }
+
+  if (length > 0) {
+    _chunks.emplace_back(data, length);
+    _buffered += length;
+    guard.signal();
+  }
+
+  if (_buffered >= _maxBuffered) {
+    _paused = true;
+    return false;
+  }
+  return true;
+}
+
+void RequestBodyStream::finish() {
+  CONDITION_LOCKER(guard, _condition);
+  _finished = true;
+  guard.broadcast();
+}
+
+void RequestBodyStream::abort() {
+  CONDITION_LOCKER(guard, _condition);
+  _aborted = true;
+  _chunks.clear();
+  _buffered = 0;
+  guard.broadcast();
+}
+
+bool RequestBodyStream::read(std::string& out) {
+  std::function<void()> resume;
+
+  {
+    CONDITION_LOCKER(guard, _condition);
+
+    while (_chunks.empty() && !_finished && !_aborted) {
+      guard.wait();
+    }
+
+    if (_aborted || _chunks.empty()) {
+      return false;
+    }
+
+    out.append(_chunks.front());
+    _buffered -= _chunks.front().size();
+    _chunks.pop_front();
+
+    // resume at half the limit, so the producer does not stop and start
+    // for every single chunk
+    if (_paused && _buffered <= _maxBuffered / 2) {
+      _paused = false;
+      resume = _resume;
+    }
+  }
+
+  if (resume) {
+    resume();
+  }
+  return true;
+}
+
+bool RequestBodyStream::aborted() const {
+  CONDITION_LOCKER(guard, _condition);
+  return _aborted;
+}
@@ -0,0 +1,84 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef ARANGODB_REST_REQUEST_BODY_STREAM_H
+#define ARANGODB_REST_REQUEST_BODY_STREAM_H 1
+
+#include "Basics/Common.h"
+#include "Basics/ConditionVariable.h"
+
+#include <deque>
+
+namespace arangodb {
+
+/// @brief body of a request that is handed to the handler while it is still
+/// being received. the connection appends the data as it arrives, the
+/// handler consumes it from a scheduler thread. at most maxBuffered bytes
+/// are held, above that the connection stops reading until the handler has
+/// caught up
+class RequestBodyStream {
+  RequestBodyStream(RequestBodyStream const&) = delete;
+  RequestBodyStream& operator=(RequestBodyStream const&) = delete;
+
+ public:
+  static constexpr size_t DefaultMaxBuffered = 4 * 1024 * 1024;
+
+  RequestBodyStream(size_t length, size_t maxBuffered = DefaultMaxBuffered);
+
+  /// @brief total length of the body, as announced by the client
+  size_t length() const { return _length; }
+
+  /// @brief called with the lock released when the handler has consumed
+  /// enough data after append returned false
+  void setResumeCallback(std::function<void()> const& callback);
+
+  /// @brief adds data. returns false if the buffer is full, the caller
+  /// should not append more until the resume callback is invoked
+  bool append(char const* data, size_t length);
+
+  /// @brief the body is complete
+  void finish();
+
+  /// @brief the connection went away, the body will never be complete
+  void abort();
+
+  /// @brief appends the next data to out, waiting for it if needed. returns
+  /// false at the end of the body or if the stream was aborted
+  bool read(std::string& out);
+
+  bool aborted() const;
+
+ private:
+  mutable basics::ConditionVariable _condition;
+  std::deque<std::string> _chunks;
+  std::function<void()> _resume;
+  size_t const _length;
+  size_t const _maxBuffered;
+  size_t _buffered;
+  bool _finished;
+  bool _aborted;
+  // append has returned false, the producer waits for the callback
+  bool _paused;
+};
+
+}  // namespace arangodb
+
+#endif
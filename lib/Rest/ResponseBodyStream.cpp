@@ -0,0 +1,138 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "ResponseBodyStream.h"
+#include "Basics/MutexLocker.h"
+
+using namespace arangodb;
+
+constexpr size_t ResponseBodyStream::DefaultMaxBuffered;
+
+ResponseBodyStream::ResponseBodyStream(size_t maxBuffered)
+    : _maxBuffered(maxBuffered),
+      _buffered(0),
+      _finished(false),
+      _aborted(false),
+      _paused(false) {}
+
+void ResponseBodyStream::setResumeCallback(std::function<void()> const& callback) {
+  MUTEX_LOCKER(guard, _lock);
+  _resume = callback;
+}
+
+void ResponseBodyStream::setNotifyCallback(std::function<void()> const& callback) {
+  MUTEX_LOCKER(guard, _lock);
+  _notify = callback;
+}
+
+bool ResponseBodyStream::write(std::string&& data, bool last) {
+  std::function<void()> notify;
+  bool more = true;
+
+  {
+    MUTEX_LOCKER(guard, _lock);
+
+    if (_aborted || _finished) {
+      return false;
+    }
+
+    if (!data.empty()) {
+      _buffered += data.size();
+      _chunks.emplace_back(std::move(data));
+    }
+    _finished = last;
+
+    if (!last && _buffered >= _maxBuffered) {
+      _paused = true;
+      more = false;
+    }
+    notify = _notify;
+  }
+
+  if (notify) {
+    notify();
+  }
+  return more;
+}
+
+bool ResponseBodyStream::take(std::string& out, bool& finished) {
+  std::function<void()> resume;
+
+  {
+    MUTEX_LOCKER(guard, _lock);
+
+    finished = _finished;
+    if (_aborted) {
+      return false;
+    }
+
+    for (auto const& chunk : _chunks) {
+      out.append(chunk);
+    }
+    _chunks.clear();
+    _buffered = 0;
+
+    if (_paused) {
+      _paused = false;
+      resume = _resume;
+    }
+  }
+
+  if (resume) {
+    resume();
+  }
+  return true;
+}
+
+void ResponseBodyStream::abort() {
+  std::function<void()> resume;
+  std::function<void()> notify;
+
+  {
+    MUTEX_LOCKER(guard, _lock);
+
+    if (_aborted) {
+      return;
+    }
+    _aborted = true;
+    _chunks.clear();
+    _buffered = 0;
+
+    // a paused producer has to learn about the abort to clean up
+    if (_paused) {
+      _paused = false;
+      resume = _resume;
+    }
+    notify = _notify;
+  }
+
+  if (resume) {
+    resume();
+  }
+  if (notify) {
+    notify();
+  }
+}
+
+bool ResponseBodyStream::aborted() const {
+  MUTEX_LOCKER(guard, _lock);
+  return _aborted;
+}
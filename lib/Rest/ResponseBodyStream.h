@@ -0,0 +1,83 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef ARANGODB_REST_RESPONSE_BODY_STREAM_H
+#define ARANGODB_REST_RESPONSE_BODY_STREAM_H 1
+
+#include "Basics/Common.h"
+#include "Basics/Mutex.h"
+
+#include <deque>
+
+namespace arangodb {
+
+/// @brief body of a response that is produced after the response header
+/// has been sent. the handler writes the body in pieces from a scheduler
+/// thread, the connection takes them whenever the socket has sent all data
+/// before. at most maxBuffered bytes are held, above that the handler
+/// pauses until the connection has caught up
+class ResponseBodyStream {
+  ResponseBodyStream(ResponseBodyStream const&) = delete;
+  ResponseBodyStream& operator=(ResponseBodyStream const&) = delete;
+
+ public:
+  static constexpr size_t DefaultMaxBuffered = 4 * 1024 * 1024;
+
+  explicit ResponseBodyStream(size_t maxBuffered = DefaultMaxBuffered);
+
+  /// @brief called with the lock released when the producer should write
+  /// again, after write returned false or after the stream was aborted
+  void setResumeCallback(std::function<void()> const& callback);
+
+  /// @brief called with the lock released when there is data to take, the
+  /// body is complete or the stream was aborted
+  void setNotifyCallback(std::function<void()> const& callback);
+
+  /// @brief adds a piece of the body, last completes the body. returns
+  /// false if the producer should pause until the resume callback
+  bool write(std::string&& data, bool last);
+
+  /// @brief appends all data written so far to out. returns false if the
+  /// stream was aborted, finished is set when the body is complete
+  bool take(std::string& out, bool& finished);
+
+  /// @brief the connection went away or the producer failed. the body will
+  /// never be complete
+  void abort();
+
+  bool aborted() const;
+
+ private:
+  mutable Mutex _lock;
+  std::deque<std::string> _chunks;
+  std::function<void()> _resume;
+  std::function<void()> _notify;
+  size_t const _maxBuffered;
+  size_t _buffered;
+  bool _finished;
+  bool _aborted;
+  // write has returned false, the producer waits for the callback
+  bool _paused;
+};
+
+}  // namespace arangodb
+
+#endif
@@ -235,6 +235,8 @@ SimpleHttpResult* SimpleHttpClient::doRequest(
 
   // ensure that result is empty
   TRI_ASSERT(_result == nullptr);
+  // responses of pipelined requests must be received first
+  TRI_ASSERT(_pendingMethods.empty());
 
   // create a new result
   _result = new SimpleHttpResult();
@@ -428,6 +430,235 @@ SimpleHttpResult* SimpleHttpClient::doRequest(
   return result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief send out a request without waiting for its response
+////////////////////////////////////////////////////////////////////////////////
+
+bool SimpleHttpClient::sendRequest(rest::RequestType method, std::string const& location,
+                                   char const* body, size_t bodyLength,
+                                   std::unordered_map<std::string, std::string> const& headers) {
+  // ensure connection has not yet been invalidated
+  TRI_ASSERT(_connection != nullptr);
+  TRI_ASSERT(_result == nullptr);
+
+  if (isAborted()) {
+    setErrorMessage("Client request aborted");
+    return false;
+  }
+
+  // reset error message
+  _errorMessage = "";
+
+  if (_pendingMethods.empty()) {
+    // start like a regular request does
+    _readBufferOffset = 0;
+    _readBuffer.reset();
+
+    if (_state == DEAD) {
+      _connection->resetNumConnectRetries();
+    }
+
+    if (_state != FINISHED) {
+      this->close();
+    }
+  } else if (!_params._keepAlive) {
+    setErrorMessage("Cannot pipeline requests without keep-alive");
+    return false;
+  } else if (_state != FINISHED) {
+    // the responses of the requests in flight are lost anyway
+    setErrorMessage("Connection to '" + _connection->getEndpoint()->specification() +
+                    "' broken while pipelining requests");
+    return false;
+  }
+
+  _method = method;
+  _writeBuffer.clear();
+  appendRequest(method, rewriteLocation(location), body, bodyLength, headers);
+
+  if (!_connection->isConnected()) {
+    handleConnect();
+
+    if (_state == DEAD) {
+      return false;
+    }
+  }
+
+  _state = IN_WRITE;
+  _written = 0;
+
+  // respect timeout
+  double const endTime = TRI_microtime() + _params._requestTimeout;
+
+  while (_written < _writeBuffer.length()) {
+    double const remainingTime = endTime - TRI_microtime();
+
+    if (remainingTime <= 0.0 || isAborted()) {
+      setErrorMessage(isAborted() ? "Client request aborted" : "Request timeout reached");
+      this->close();
+      _state = DEAD;
+      return false;
+    }
+
+    size_t bytesWritten = 0;
+    TRI_set_errno(TRI_ERROR_NO_ERROR);
+
+    if (!_connection->handleWrite(remainingTime,
+                                  static_cast<void const*>(_writeBuffer.c_str() + _written),
+                                  _writeBuffer.length() - _written, &bytesWritten)) {
+      setErrorMessage("Error writing to '" + _connection->getEndpoint()->specification() +
+                      "' '" + _connection->getErrorDetails() + "'");
+      this->close();
+      _state = DEAD;
+      return false;
+    }
+
+    _written += bytesWritten;
+  }
+
+  _pendingMethods.push_back(method);
+  // between responses
+  _state = FINISHED;
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief receive the response of the oldest request in flight
+////////////////////////////////////////////////////////////////////////////////
+
+SimpleHttpResult* SimpleHttpClient::receiveResponse() {
+  // ensure connection has not yet been invalidated
+  TRI_ASSERT(_connection != nullptr);
+  TRI_ASSERT(_result == nullptr);
+
+  if (_pendingMethods.empty()) {
+    return nullptr;
+  }
+
+  _method = _pendingMethods.front();
+  _pendingMethods.pop_front();
+
+  _result = new SimpleHttpResult();
+  auto resultGuard = scopeGuard([this] {
+    delete _result;
+    _result = nullptr;
+  });
+
+  if (_state != FINISHED) {
+    // the connection broke down after the request was sent
+    if (!haveErrorMessage()) {
+      setErrorMessage("Connection to '" + _connection->getEndpoint()->specification() +
+                      "' broken while pipelining requests");
+    }
+    _result->setHaveSentRequestFully(true);
+    _result->setResultType(SimpleHttpResult::READ_ERROR);
+    _result->setHttpReturnMessage(_errorMessage);
+
+    SimpleHttpResult* result = _result;
+    _result = nullptr;
+    resultGuard.cancel();
+    return result;
+  }
+
+  // the responses to earlier requests have been processed
+  if (_readBufferOffset > 0) {
+    _readBuffer.erase_front(_readBufferOffset);
+    _readBufferOffset = 0;
+  }
+
+  // reset error message
+  _errorMessage = "";
+  _state = IN_READ_HEADER;
+
+  // respect timeout
+  double const endTime = TRI_microtime() + _params._requestTimeout;
+  double remainingTime = _params._requestTimeout;
+
+  // the response may have been read along with an earlier one
+  if (_readBuffer.length() > 0) {
+    processHeader();
+  }
+
+  while (_state < FINISHED && remainingTime > 0.0) {
+    TRI_set_errno(TRI_ERROR_NO_ERROR);
+
+    bool connectionClosed;
+
+    if (!_connection->handleRead(remainingTime, _readBuffer, connectionClosed)) {
+      setErrorMessage("Error reading from: '" +
+                      _connection->getEndpoint()->specification() + "' '" +
+                      _connection->getErrorDetails() + "'");
+      break;
+    }
+
+    switch (_state) {
+      case (IN_READ_HEADER):
+        processHeader();
+        break;
+
+      case (IN_READ_BODY):
+        processBody();
+        break;
+
+      case (IN_READ_CHUNKED_HEADER):
+        processChunkedHeader();
+        break;
+
+      case (IN_READ_CHUNKED_BODY):
+        processChunkedBody();
+        break;
+
+      default:
+        break;
+    }
+
+    if (connectionClosed) {
+      if (_state == IN_READ_BODY && !_result->hasContentLength()) {
+        // the body ends with the connection
+        _result->setContentLength(_readBuffer.length() - _readBufferOffset);
+        processBody();
+      }
+
+      if (_state < FINISHED) {
+        setErrorMessage("Connection closed by remote");
+      } else if (!_pendingMethods.empty()) {
+        // this response is complete, but the other ones will not come
+        SimpleHttpResult* result = getResult(true);
+        _result = nullptr;
+        resultGuard.cancel();
+
+        setErrorMessage("Connection closed by remote");
+        this->close();
+        _state = DEAD;
+        return result;
+      }
+      break;
+    }
+
+    remainingTime = endTime - TRI_microtime();
+    if (isAborted()) {
+      setErrorMessage("Client request aborted");
+      break;
+    }
+  }
+
+  if (_state < FINISHED && _errorMessage.empty()) {
+    setErrorMessage("Request timeout reached");
+  }
+
+  SimpleHttpResult* result = getResult(true);
+  _result = nullptr;
+  resultGuard.cancel();
+
+  if (_state != FINISHED) {
+    // the following responses cannot be told apart any more
+    this->close();
+    _state = DEAD;
+  }
+
+  return result;
+}
+
 // -----------------------------------------------------------------------------
 // private methods
 // -----------------------------------------------------------------------------
@@ -519,7 +750,34 @@ void SimpleHttpClient::setRequest(rest::RequestType method, std::string const& l
 
   // now fill the write buffer
   _writeBuffer.clear();
+  appendRequest(method, location, body, bodyLength, headers);
 
+  if (_state == DEAD) {
+    _connection->resetNumConnectRetries();
+  }
+
+  // close connection to reset all read and write buffers
+  if (_state != FINISHED) {
+    this->close();
+  }
+
+  // we are connected, start with writing
+  if (_connection->isConnected()) {
+    _state = IN_WRITE;
+    _written = 0;
+  }
+
+  // connect to server
+  else {
+    _state = IN_CONNECT;
+  }
+
+  TRI_ASSERT(_state == IN_CONNECT || _state == IN_WRITE);
+}
+
+void SimpleHttpClient::appendRequest(rest::RequestType method, std::string const& location,
+                                     char const* body, size_t bodyLength,
+                                     std::unordered_map<std::string, std::string> const& headers) {
   // append method
   HttpRequest::appendMethod(method, &_writeBuffer);
 
@@ -598,28 +856,6 @@ void SimpleHttpClient::setRequest(rest::RequestType method, std::string const& l
   _writeBuffer.ensureNullTerminated();
 
   LOG_TOPIC("12c4b", TRACE, arangodb::Logger::HTTPCLIENT) << "request: " << _writeBuffer;
-
-  if (_state == DEAD) {
-    _connection->resetNumConnectRetries();
-  }
-
-  // close connection to reset all read and write buffers
-  if (_state != FINISHED) {
-    this->close();
-  }
-
-  // we are connected, start with writing
-  if (_connection->isConnected()) {
-    _state = IN_WRITE;
-    _written = 0;
-  }
-
-  // connect to server
-  else {
-    _state = IN_CONNECT;
-  }
-
-  TRI_ASSERT(_state == IN_CONNECT || _state == IN_WRITE);
 }
 
 // -----------------------------------------------------------------------------
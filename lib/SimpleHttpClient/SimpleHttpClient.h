@@ -32,6 +32,8 @@
 #include "Logger/Logger.h"
 #include "Rest/HttpRequest.h"
 
+#include <deque>
+
 namespace arangodb {
 namespace httpclient {
 
@@ -263,6 +265,30 @@ class SimpleHttpClient {
   SimpleHttpResult* request(rest::RequestType, std::string const&, char const*, size_t,
                             std::unordered_map<std::string, std::string> const&);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief send an http request without waiting for its response
+  /// (HTTP/1.1 pipelining). the responses of the requests sent are received
+  /// in order with receiveResponse(). the connection must be kept alive, and
+  /// no other request may be made until all responses are received.
+  /// returns false if the request could not be sent. if the connection breaks
+  /// down, the responses of all requests still in flight are lost
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool sendRequest(rest::RequestType, std::string const&, char const*, size_t,
+                   std::unordered_map<std::string, std::string> const&);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief receive the response of the oldest request sent with
+  /// sendRequest(), creating a new HttpResult object. the caller has to
+  /// delete the result object. returns nullptr if no request is in flight
+  //////////////////////////////////////////////////////////////////////////////
+
+  SimpleHttpResult* receiveResponse();
+
+  /// @brief number of requests sent with sendRequest() whose responses have
+  /// not been received yet
+  size_t pendingResponses() const noexcept { return _pendingMethods.size(); }
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief returns the current error message
   //////////////////////////////////////////////////////////////////////////////
@@ -376,6 +402,14 @@ class SimpleHttpClient {
                   char const* body, size_t bodyLength,
                   std::unordered_map<std::string, std::string> const& headerFields);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief append a request to the write buffer
+  //////////////////////////////////////////////////////////////////////////////
+
+  void appendRequest(rest::RequestType method, std::string const& location,
+                     char const* body, size_t bodyLength,
+                     std::unordered_map<std::string, std::string> const& headerFields);
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief process (a part of) the http header, the data is
   /// found in _readBuffer starting at _readBufferOffset until
@@ -479,6 +513,10 @@ class SimpleHttpClient {
 
   SimpleHttpResult* _result;
 
+  /// @brief methods of the requests sent with sendRequest(), whose
+  /// responses have not been received yet
+  std::deque<rest::RequestType> _pendingMethods;
+
   std::atomic<bool> _aborted;
 
   // empty map, used for headers
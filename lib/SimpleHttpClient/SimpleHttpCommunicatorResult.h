@@ -23,6 +23,8 @@
 #ifndef ARANGODB_SIMPLE_HTTP_CLIENT_SIMPLE_HTTP_COMMUNICATOR_RESULT_H
 #define ARANGODB_SIMPLE_HTTP_CLIENT_SIMPLE_HTTP_COMMUNICATOR_RESULT_H 1
 
+#include "Basics/StaticStrings.h"
+#include "Basics/VelocyPackHelper.h"
 #include "SimpleHttpClient/SimpleHttpResult.h"
 
 namespace arangodb {
@@ -56,6 +58,10 @@ class SimpleHttpCommunicatorResult : public SimpleHttpResult {
     return _response->body();
   }
   std::shared_ptr<VPackBuilder> getBodyVelocyPack(VPackOptions const& options) const override {
+    if (isVelocyPack()) {
+      return basics::VelocyPackHelper::velocyPackFromBinary(_response->body().c_str(),
+                                                            _response->body().length(), options);
+    }
     return VPackParser::fromJson(_response->body().c_str(),
                                  _response->body().length(), &options);
   }
@@ -106,6 +112,13 @@ class SimpleHttpCommunicatorResult : public SimpleHttpResult {
     message += " not implemented";
     throw std::runtime_error(message);
   }
+  virtual bool isVelocyPack() const override {
+    auto const& headers = _response->headers();
+    auto it = headers.find(StaticStrings::ContentTypeHeader);
+    return it != headers.end() &&
+           it->second.compare(0, StaticStrings::MimeTypeVPack.size(),
+                              StaticStrings::MimeTypeVPack) == 0;
+  }
 
  private:
   std::unique_ptr<HttpResponse> _response;
@@ -46,6 +46,7 @@ SimpleHttpResult::SimpleHttpResult()
       _returnCode(0),
       _foundHeader(false),
       _isJson(false),
+      _isVelocyPack(false),
       _hasContentLength(false),
       _chunked(false),
       _deflated(false),
@@ -66,6 +67,8 @@ void SimpleHttpResult::clear() {
   _contentLength = 0;
   _returnCode = 0;
   _foundHeader = false;
+  _isJson = false;
+  _isVelocyPack = false;
   _hasContentLength = false;
   _chunked = false;
   _deflated = false;
@@ -81,6 +84,10 @@ StringBuffer& SimpleHttpResult::getBody() { return _resultBody; }
 StringBuffer const& SimpleHttpResult::getBody() const { return _resultBody; }
 
 std::shared_ptr<VPackBuilder> SimpleHttpResult::getBodyVelocyPack(VPackOptions const& options) const {
+  if (_isVelocyPack) {
+    return VelocyPackHelper::velocyPackFromBinary(_resultBody.c_str(),
+                                                  _resultBody.length(), options);
+  }
   VPackParser parser(&options);
   parser.parse(_resultBody.c_str());
   return parser.steal();
@@ -193,6 +200,10 @@ void SimpleHttpResult::addHeaderField(char const* key, size_t keyLength,
         char const* ptr = value + length;
         // but only if not followed by anything unexpected
         _isJson = (*ptr == '\0' || *ptr == ';' || *ptr == ' ' || *ptr == '\r');
+      } else if (valueLength >= StaticStrings::MimeTypeVPack.size() &&
+                 memcmp(value, StaticStrings::MimeTypeVPack.c_str(),
+                        StaticStrings::MimeTypeVPack.size()) == 0) {
+        _isVelocyPack = true;
       }
     }
   }
@@ -220,6 +220,12 @@ class SimpleHttpResult {
 
   virtual bool isJson() const { return _isJson; }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief returns whether the result is binary VelocyPack
+  //////////////////////////////////////////////////////////////////////////////
+
+  virtual bool isVelocyPack() const { return _isVelocyPack; }
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief returns whether the request has been sent in its entirety, this
   /// is only meaningful if isComplete() returns false.
@@ -247,6 +253,7 @@ class SimpleHttpResult {
   int _returnCode;
   bool _foundHeader;
   bool _isJson;
+  bool _isVelocyPack;
   bool _hasContentLength;
   bool _chunked;
   bool _deflated;
@@ -23,6 +23,7 @@
 #include "SslServerFeature.h"
 
 #include "Basics/FileUtils.h"
+#include "Basics/MutexLocker.h"
 #include "Logger/Logger.h"
 #include "ProgramOptions/ProgramOptions.h"
 #include "ProgramOptions/Section.h"
@@ -116,6 +117,9 @@ void SslServerFeature::prepare() {
 void SslServerFeature::unprepare() {
   LOG_TOPIC("7093e", TRACE, arangodb::Logger::SSL)
       << "unpreparing ssl: " << stringifySslOptions(_sslOptions);
+
+  MUTEX_LOCKER(locker, _sslContextLock);
+  _sslContext.reset();
 }
 
 void SslServerFeature::verifySslOptions() {
@@ -145,7 +149,7 @@ void SslServerFeature::verifySslOptions() {
   }
 
   try {
-    createSslContext();
+    sslContext();
   } catch (...) {
     LOG_TOPIC("997d2", FATAL, arangodb::Logger::SSL) << "cannot create SSL context";
     FATAL_ERROR_EXIT();
@@ -294,6 +298,14 @@ asio_ns::ssl::context SslServerFeature::createSslContext() const {
   }
 }
 
+std::shared_ptr<asio_ns::ssl::context> SslServerFeature::sslContext() {
+  MUTEX_LOCKER(locker, _sslContextLock);
+  if (_sslContext == nullptr) {
+    _sslContext = std::make_shared<asio_ns::ssl::context>(createSslContext());
+  }
+  return _sslContext;
+}
+
 std::string SslServerFeature::stringifySslOptions(uint64_t opts) const {
   std::string result;
 
@@ -24,6 +24,7 @@
 #define ARANGODB_APPLICATION_FEATURES_SSL_SERVER_FEATURE_H 1
 
 #include "ApplicationFeatures/ApplicationFeature.h"
+#include "Basics/Mutex.h"
 
 // needs to come first
 #include "Ssl/ssl-helper.h"
@@ -47,6 +48,11 @@ class SslServerFeature : public application_features::ApplicationFeature {
 
   virtual asio_ns::ssl::context createSslContext() const;
 
+  /// @brief the context shared by all server connections, created on first
+  /// use. connections need to share it to resume TLS sessions, as both the
+  /// session cache and the session ticket keys live in the context
+  std::shared_ptr<asio_ns::ssl::context> sslContext();
+
  protected:
   std::string _cafile;
   std::string _keyfile;
@@ -60,6 +66,9 @@ class SslServerFeature : public application_features::ApplicationFeature {
   std::string stringifySslOptions(uint64_t opts) const;
 
   std::string _rctx;
+
+  Mutex _sslContextLock;
+  std::shared_ptr<asio_ns::ssl::context> _sslContext;  // needs _sslContextLock
 };
 
 }  // namespace arangodb
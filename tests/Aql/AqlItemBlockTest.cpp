@@ -0,0 +1,153 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "Aql/AqlItemBlock.h"
+#include "Aql/AqlItemBlockManager.h"
+#include "Aql/ResourceUsage.h"
+#include "Aql/SharedAqlItemBlockPtr.h"
+#include "Basics/VelocyPackHelper.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace arangodb {
+namespace tests {
+namespace aql {
+
+class AqlItemBlockTest : public ::testing::Test {
+ protected:
+  ResourceMonitor monitor;
+  AqlItemBlockManager itemBlockManager{&monitor};
+
+  SharedAqlItemBlockPtr buildBlock(size_t nrItems) {
+    SharedAqlItemBlockPtr block = itemBlockManager.requestBlock(nrItems, 3);
+    for (size_t i = 0; i < nrItems; ++i) {
+      block->emplaceValue(i, 0, AqlValueHintInt(static_cast<int64_t>(i)));
+      block->emplaceValue(i, 1, "some-longer-string-value-" + std::to_string(i));
+      // register 2 stays empty
+    }
+    return block;
+  }
+
+  void assertEqual(AqlItemBlock const& expected, AqlItemBlock const& actual) {
+    ASSERT_EQ(expected.size(), actual.size());
+    ASSERT_EQ(expected.getNrRegs(), actual.getNrRegs());
+    for (size_t i = 0; i < expected.size(); ++i) {
+      for (RegisterId reg = 0; reg < expected.getNrRegs(); ++reg) {
+        AqlValue const& a = expected.getValueReference(i, reg);
+        AqlValue const& b = actual.getValueReference(i, reg);
+        ASSERT_EQ(a.isEmpty(), b.isEmpty());
+        if (!a.isEmpty()) {
+          ASSERT_TRUE(basics::VelocyPackHelper::compare(a.slice(), b.slice(), true) == 0);
+        }
+      }
+    }
+  }
+};
+
+TEST_F(AqlItemBlockTest, small_blocks_are_not_compressed) {
+  auto block = buildBlock(10);
+
+  VPackBuilder builder;
+  builder.openObject();
+  block->toVelocyPack(nullptr, builder, true);
+  builder.close();
+
+  ASSERT_TRUE(builder.slice().hasKey("data"));
+  ASSERT_TRUE(builder.slice().hasKey("raw"));
+  ASSERT_FALSE(builder.slice().hasKey("compressed"));
+
+  auto copy = itemBlockManager.requestAndInitBlock(builder.slice());
+  assertEqual(*block, *copy);
+}
+
+TEST_F(AqlItemBlockTest, large_blocks_are_compressed_on_request) {
+  auto block = buildBlock(1000);
+
+  VPackBuilder plain;
+  plain.openObject();
+  block->toVelocyPack(nullptr, plain, false);
+  plain.close();
+  ASSERT_TRUE(plain.slice().hasKey("data"));
+  ASSERT_FALSE(plain.slice().hasKey("compressed"));
+
+  VPackBuilder compressed;
+  compressed.openObject();
+  block->toVelocyPack(nullptr, compressed, true);
+  compressed.close();
+  ASSERT_FALSE(compressed.slice().hasKey("data"));
+  ASSERT_FALSE(compressed.slice().hasKey("raw"));
+  ASSERT_TRUE(compressed.slice().get("compressed").isBinary());
+  ASSERT_LT(compressed.slice().byteSize(), plain.slice().byteSize());
+
+  auto copy = itemBlockManager.requestAndInitBlock(compressed.slice());
+  assertEqual(*block, *copy);
+}
+
+TEST_F(AqlItemBlockTest, small_ranges_are_stored_inline) {
+  AqlValue small(-5, 100);
+  ASSERT_TRUE(small.isRange());
+  ASSERT_TRUE(small.isInlineRange());
+  ASSERT_FALSE(small.requiresDestruction());
+  ASSERT_EQ(0, small.memoryUsage());
+  ASSERT_EQ(106, small.length());
+  ASSERT_EQ(-5, small.range()._low);
+  ASSERT_EQ(100, small.range()._high);
+
+  AqlValue large(0, int64_t(1) << 40);
+  ASSERT_TRUE(large.isRange());
+  ASSERT_FALSE(large.isInlineRange());
+  ASSERT_TRUE(large.requiresDestruction());
+  ASSERT_EQ(int64_t(1) << 40, large.range()._high);
+  large.destroy();
+}
+
+TEST_F(AqlItemBlockTest, ranges_survive_serialization) {
+  SharedAqlItemBlockPtr block = itemBlockManager.requestBlock(2, 1);
+  block->emplaceValue(0, 0, int64_t(1), int64_t(10));
+  block->emplaceValue(1, 0, int64_t(-3), int64_t(1) << 40);
+
+  VPackBuilder builder;
+  builder.openObject();
+  block->toVelocyPack(nullptr, builder, false);
+  builder.close();
+
+  auto copy = itemBlockManager.requestAndInitBlock(builder.slice());
+  ASSERT_EQ(2, copy->size());
+  AqlValue const& a = copy->getValueReference(0, 0);
+  ASSERT_TRUE(a.isInlineRange());
+  ASSERT_EQ(1, a.range()._low);
+  ASSERT_EQ(10, a.range()._high);
+  AqlValue const& b = copy->getValueReference(1, 0);
+  ASSERT_TRUE(b.isRange());
+  ASSERT_FALSE(b.isInlineRange());
+  ASSERT_EQ(-3, b.range()._low);
+  ASSERT_EQ(int64_t(1) << 40, b.range()._high);
+}
+
+}  // namespace aql
+}  // namespace tests
+}  // namespace arangodb
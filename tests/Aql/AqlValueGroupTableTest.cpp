@@ -0,0 +1,161 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "Aql/AqlValue.h"
+#include "Aql/AqlValueGroupTable.h"
+#include "Aql/Query.h"
+#include "Aql/ResourceUsage.h"
+#include "Transaction/Methods.h"
+#include "tests/Mocks/Servers.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace arangodb {
+namespace tests {
+namespace aql {
+
+class AqlValueGroupTableTest : public ::testing::Test {
+ protected:
+  mocks::MockAqlServer server;
+  std::unique_ptr<arangodb::aql::Query> fakedQuery;
+  arangodb::transaction::Methods* trx;
+
+  AqlValueGroupTableTest()
+      : fakedQuery(server.createFakeQuery()), trx(fakedQuery->trx()) {}
+
+  size_t findOrInsert(AqlValueGroupTable& table, AqlValue const* values) {
+    uint64_t hash = table.hash(values);
+    size_t position = table.find(values, hash);
+    if (position == AqlValueGroupTable::notFound) {
+      position = table.insert(values, hash);
+    }
+    return position;
+  }
+};
+
+TEST_F(AqlValueGroupTableTest, empty_table_finds_nothing) {
+  AqlValueGroupTable table(trx, 1);
+  AqlValue value(AqlValueHintInt(1));
+
+  ASSERT_EQ(0, table.size());
+  ASSERT_EQ(AqlValueGroupTable::notFound, table.find(&value, table.hash(&value)));
+}
+
+TEST_F(AqlValueGroupTableTest, groups_are_numbered_in_insertion_order) {
+  AqlValueGroupTable table(trx, 2);
+
+  // insert enough groups to make the table grow a few times
+  for (int64_t i = 0; i < 1000; ++i) {
+    AqlValue values[] = {AqlValue(AqlValueHintInt(i % 10)),
+                         AqlValue(AqlValueHintInt(i / 10))};
+    ASSERT_EQ(static_cast<size_t>(i), findOrInsert(table, values));
+  }
+  ASSERT_EQ(1000, table.size());
+
+  for (int64_t i = 0; i < 1000; ++i) {
+    AqlValue values[] = {AqlValue(AqlValueHintInt(i % 10)),
+                         AqlValue(AqlValueHintInt(i / 10))};
+    ASSERT_EQ(static_cast<size_t>(i), table.find(values, table.hash(values)));
+
+    AqlValue const* group = table.group(static_cast<size_t>(i));
+    ASSERT_EQ(i % 10, group[0].toInt64());
+    ASSERT_EQ(i / 10, group[1].toInt64());
+  }
+}
+
+TEST_F(AqlValueGroupTableTest, equal_values_with_different_representations) {
+  AqlValueGroupTable table(trx, 1);
+
+  AqlValue intValue(AqlValueHintInt(42));
+  AqlValue doubleValue(AqlValueHintDouble(42.0));
+
+  ASSERT_EQ(0, findOrInsert(table, &intValue));
+  ASSERT_EQ(0, findOrInsert(table, &doubleValue));
+  ASSERT_EQ(1, table.size());
+}
+
+TEST_F(AqlValueGroupTableTest, table_owns_managed_values) {
+  AqlValueGroupTable table(trx, 1);
+
+  for (int i = 0; i < 100; ++i) {
+    VPackBuilder builder;
+    builder.add(VPackValue(std::string(100, 'a') + std::to_string(i)));
+    AqlValue lookup(builder.slice());
+    ASSERT_TRUE(lookup.requiresDestruction());
+    AqlValueGuard guard(lookup, true);
+
+    uint64_t hash = table.hash(&lookup);
+    ASSERT_EQ(AqlValueGroupTable::notFound, table.find(&lookup, hash));
+    AqlValue copy = lookup.clone();
+    ASSERT_EQ(static_cast<size_t>(i), table.insert(&copy, hash));
+    ASSERT_EQ(static_cast<size_t>(i), table.find(&lookup, hash));
+  }
+
+  // values handed out by the caller must be erased in the table
+  AqlValue* group = table.group(0);
+  AqlValue stolen = group[0];
+  group[0].erase();
+  stolen.destroy();
+}
+
+TEST_F(AqlValueGroupTableTest, memory_is_accounted_for) {
+  ResourceMonitor monitor;
+  {
+    AqlValueGroupTable table(trx, 1, &monitor);
+    ASSERT_EQ(0, monitor.currentResources.memoryUsage);
+
+    VPackBuilder builder;
+    builder.add(VPackValue(std::string(100, 'a')));
+    AqlValue value = AqlValue(builder.slice()).clone();
+    table.insert(&value, table.hash(&value));
+
+    ASSERT_EQ(table.memoryUsage(), monitor.currentResources.memoryUsage);
+    ASSERT_GT(table.memoryUsage(), value.memoryUsage());
+  }
+  ASSERT_EQ(0, monitor.currentResources.memoryUsage);
+}
+
+TEST_F(AqlValueGroupTableTest, memory_limit_is_enforced) {
+  ResourceMonitor monitor;
+  monitor.setMemoryLimit(64 * 1024);
+
+  AqlValueGroupTable table(trx, 1, &monitor);
+  try {
+    for (int64_t i = 0; i < 1000000; ++i) {
+      AqlValue value{AqlValueHintInt(i)};
+      table.insert(&value, table.hash(&value));
+    }
+    FAIL();
+  } catch (basics::Exception const& ex) {
+    ASSERT_EQ(TRI_ERROR_RESOURCE_LIMIT, ex.code());
+  }
+  ASSERT_EQ(table.memoryUsage(), monitor.currentResources.memoryUsage);
+  ASSERT_LE(table.memoryUsage(), 64 * 1024);
+}
+
+}  // namespace aql
+}  // namespace tests
+}  // namespace arangodb
@@ -0,0 +1,104 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "RowFetcherHelper.h"
+#include "fakeit.hpp"
+
+#include "Aql/AqlItemBlock.h"
+#include "Aql/Collection.h"
+#include "Aql/HashJoinExecutor.h"
+#include "Aql/OutputAqlItemRow.h"
+#include "Aql/ResourceUsage.h"
+#include "Aql/SingleRowFetcher.h"
+#include "Indexes/IndexIterator.h"
+#include "Transaction/Methods.h"
+#include "VocBase/AccessMode.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace arangodb {
+namespace tests {
+namespace aql {
+
+class HashJoinExecutorTestNoRowsUpstream : public ::testing::Test {
+ protected:
+  ExecutionState state;
+  ResourceMonitor monitor;
+  AqlItemBlockManager itemBlockManager;
+  fakeit::Mock<TRI_vocbase_t> vocbaseMock;
+  fakeit::Mock<transaction::Methods> mockTrx;
+  Collection const abc;
+
+  HashJoinExecutorInfos infos;
+
+  SharedAqlItemBlockPtr block;
+  VPackBuilder input;
+
+  HashJoinExecutorTestNoRowsUpstream()
+      : itemBlockManager(&monitor),
+        abc("blabli", &vocbaseMock.get(), arangodb::AccessMode::Type::READ),
+        infos(0 /*outerReg*/, 1 /*outReg*/, 1 /*nrIn*/, 2 /*nrOut*/, {}, {0},
+              &abc, &mockTrx.get(), &monitor, {"a"}, {"b"}),
+        block(new AqlItemBlock(itemBlockManager, 1000, 2)) {}
+};
+
+TEST_F(HashJoinExecutorTestNoRowsUpstream, the_producer_does_not_wait) {
+  SingleRowFetcherHelper<false> fetcher(input.steal(), false);
+  HashJoinExecutor testee(fetcher, infos);
+  EnumerateCollectionStats stats{};
+
+  OutputAqlItemRow result(std::move(block), infos.getOutputRegisters(),
+                          infos.registersToKeep(), infos.registersToClear());
+  std::tie(state, stats) = testee.produceRows(result);
+  ASSERT_TRUE(state == ExecutionState::DONE);
+  ASSERT_TRUE(!result.produced());
+  ASSERT_EQ(0, stats.getScanned());
+
+  // the inner collection is only read once there is an outer row
+  fakeit::Verify(Method(mockTrx, indexScan)).Never();
+  ASSERT_EQ(0, monitor.currentResources.memoryUsage);
+}
+
+TEST_F(HashJoinExecutorTestNoRowsUpstream, the_producer_waits) {
+  SingleRowFetcherHelper<false> fetcher(input.steal(), true);
+  HashJoinExecutor testee(fetcher, infos);
+  EnumerateCollectionStats stats{};
+
+  OutputAqlItemRow result(std::move(block), infos.getOutputRegisters(),
+                          infos.registersToKeep(), infos.registersToClear());
+  std::tie(state, stats) = testee.produceRows(result);
+  ASSERT_TRUE(state == ExecutionState::WAITING);
+  ASSERT_TRUE(!result.produced());
+
+  std::tie(state, stats) = testee.produceRows(result);
+  ASSERT_TRUE(state == ExecutionState::DONE);
+  ASSERT_TRUE(!result.produced());
+  fakeit::Verify(Method(mockTrx, indexScan)).Never();
+}
+
+}  // namespace aql
+}  // namespace tests
+}  // namespace arangodb
@@ -0,0 +1,192 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "RowFetcherHelper.h"
+
+#include "Aql/AqlItemBlock.h"
+#include "Aql/Ast.h"
+#include "Aql/Collection.h"
+#include "Aql/ExecutionPlan.h"
+#include "Aql/MaterializeExecutor.h"
+#include "Aql/MaterializeNode.h"
+#include "Aql/OutputAqlItemRow.h"
+#include "Aql/Query.h"
+#include "Aql/ResourceUsage.h"
+#include "Aql/SingleRowFetcher.h"
+#include "Aql/VariableGenerator.h"
+#include "Transaction/Methods.h"
+#include "VocBase/AccessMode.h"
+#include "VocBase/LogicalCollection.h"
+#include "VocBase/vocbase.h"
+
+#include "../Mocks/Servers.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace arangodb {
+namespace tests {
+namespace aql {
+
+class MaterializeExecutorTest : public ::testing::Test {
+ protected:
+  ExecutionState state;
+  ResourceMonitor monitor;
+  AqlItemBlockManager itemBlockManager;
+  mocks::MockAqlServer server;
+  std::unique_ptr<arangodb::aql::Query> fakedQuery;
+  std::shared_ptr<LogicalCollection> logicalCollection;
+  Collection* collection;
+
+  MaterializeExecutorTest()
+      : itemBlockManager(&monitor), fakedQuery(server.createFakeQuery()) {
+    auto json = VPackParser::fromJson("{ \"name\": \"UnitTestCollection\" }");
+    logicalCollection = server.getSystemDatabase().createCollection(json->slice());
+    collection = fakedQuery->addCollection("UnitTestCollection", AccessMode::Type::READ);
+    collection->setCollection(logicalCollection.get());
+
+    // the mock hands out the position in this list as document id, starting at 1
+    auto physical = static_cast<PhysicalCollectionMock*>(logicalCollection->getPhysical());
+    for (size_t i = 1; i <= 3; ++i) {
+      VPackBuilder doc;
+      doc.openObject();
+      doc.add("_key", VPackValue("doc" + std::to_string(i)));
+      doc.add("value", VPackValue(i));
+      doc.close();
+      physical->documents.emplace_back(std::move(doc), true);
+    }
+  }
+
+  MaterializeExecutorInfos makeInfos() {
+    return MaterializeExecutorInfos(0 /*inReg*/, 1 /*outReg*/, 1 /*nrIn*/, 2 /*nrOut*/,
+                                    {} /*toClear*/, {0} /*toKeep*/, collection,
+                                    fakedQuery->trx());
+  }
+};
+
+TEST_F(MaterializeExecutorTest, there_are_no_rows_upstream) {
+  auto infos = makeInfos();
+  SharedAqlItemBlockPtr block{new AqlItemBlock(itemBlockManager, 1000, 2)};
+  VPackBuilder input;
+  SingleRowFetcherHelper<true> fetcher(input.steal(), true);
+  MaterializeExecutor testee(fetcher, infos);
+  NoStats stats{};
+
+  OutputAqlItemRow result{std::move(block), infos.getOutputRegisters(),
+                          infos.registersToKeep(), infos.registersToClear()};
+  std::tie(state, stats) = testee.produceRows(result);
+  ASSERT_EQ(ExecutionState::WAITING, state);
+  ASSERT_FALSE(result.produced());
+
+  std::tie(state, stats) = testee.produceRows(result);
+  ASSERT_EQ(ExecutionState::DONE, state);
+  ASSERT_FALSE(result.produced());
+}
+
+TEST_F(MaterializeExecutorTest, documents_are_read_in_input_order) {
+  auto infos = makeInfos();
+  SharedAqlItemBlockPtr block{new AqlItemBlock(itemBlockManager, 1000, 2)};
+  // document 42 does not exist
+  auto input = VPackParser::fromJson("[ [3], [1], [42], [2] ]");
+  SingleRowFetcherHelper<true> fetcher(input->steal(), false);
+  MaterializeExecutor testee(fetcher, infos);
+  NoStats stats{};
+
+  OutputAqlItemRow result{std::move(block), infos.getOutputRegisters(),
+                          infos.registersToKeep(), infos.registersToClear()};
+  for (size_t i = 0; i < 4; ++i) {
+    std::tie(state, stats) = testee.produceRows(result);
+    ASSERT_TRUE(result.produced());
+    result.advanceRow();
+  }
+  ASSERT_EQ(ExecutionState::DONE, state);
+
+  block = result.stealBlock();
+  std::vector<std::string> const expected = {"doc3", "doc1", "", "doc2"};
+  for (size_t row = 0; row < expected.size(); ++row) {
+    // the input register is kept
+    EXPECT_TRUE(block->getValue(row, 0).isNumber());
+    AqlValue v = block->getValue(row, 1);
+    if (expected[row].empty()) {
+      EXPECT_TRUE(v.isNull(false));
+    } else {
+      ASSERT_TRUE(v.isObject());
+      EXPECT_EQ(expected[row], v.slice().get("_key").copyString());
+    }
+  }
+}
+
+TEST_F(MaterializeExecutorTest, node_serialization) {
+  ExecutionPlan plan(fakedQuery->ast());
+  auto variables = fakedQuery->ast()->variables();
+  Variable* docId = variables->createVariable("docId", false);
+  Variable* doc = variables->createVariable("doc", true);
+
+  auto singleton = plan.registerNode(std::make_unique<SingletonNode>(&plan, plan.nextId()));
+  auto node = plan.registerNode(
+      std::make_unique<MaterializeNode>(&plan, plan.nextId(), collection, *docId, *doc));
+  node->addDependency(singleton);
+
+  EXPECT_EQ(ExecutionNode::MATERIALIZE, node->getType());
+  arangodb::HashSet<Variable const*> used;
+  node->getVariablesUsedHere(used);
+  EXPECT_EQ(1, used.size());
+  EXPECT_TRUE(used.find(docId) != used.end());
+  EXPECT_EQ(std::vector<Variable const*>{doc}, node->getVariablesSetHere());
+
+  // one document lookup per incoming row
+  EXPECT_EQ(singleton->getCost().estimatedCost + singleton->getCost().estimatedNrItems,
+            node->getCost().estimatedCost);
+
+  VPackBuilder nodes;
+  nodes.openArray();
+  node->toVelocyPackHelper(nodes, ExecutionNode::SERIALIZE_DETAILS);
+  nodes.close();
+  // dependencies come first
+  ASSERT_EQ(2, nodes.slice().length());
+  VPackSlice slice = nodes.slice().at(1);
+  EXPECT_EQ("MaterializeNode", slice.get("type").copyString());
+  EXPECT_EQ("UnitTestCollection", slice.get("collection").copyString());
+  EXPECT_EQ("docId", slice.get("inNmDocId").get("name").copyString());
+  EXPECT_EQ("doc", slice.get("outVariable").get("name").copyString());
+
+  auto restored = ExecutionNode::castTo<MaterializeNode*>(
+      plan.registerNode(std::make_unique<MaterializeNode>(&plan, slice)));
+  EXPECT_EQ(node->id(), restored->id());
+  EXPECT_EQ(doc, restored->outVariable());
+  EXPECT_EQ(collection, restored->collection());
+  used.clear();
+  restored->getVariablesUsedHere(used);
+  EXPECT_TRUE(used.find(docId) != used.end());
+
+  auto clone = ExecutionNode::castTo<MaterializeNode*>(node->clone(&plan, false, false));
+  EXPECT_EQ(doc, clone->outVariable());
+  EXPECT_EQ(collection, clone->collection());
+}
+
+}  // namespace aql
+}  // namespace tests
+}  // namespace arangodb
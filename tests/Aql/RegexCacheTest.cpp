@@ -0,0 +1,113 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "Aql/RegexCache.h"
+
+using namespace arangodb::aql;
+
+namespace {
+using Type = RegexCache::LikePatternType;
+
+Type analyze(std::string const& pattern, std::string& literal) {
+  return RegexCache::analyzeLikePattern(literal, pattern.data(), pattern.size());
+}
+
+// returns 1 for a match, 0 for no match and -1 if the regex has to decide
+int match(std::string const& pattern, std::string const& value) {
+  std::string literal;
+  Type type = analyze(pattern, literal);
+  EXPECT_NE(Type::Regex, type);
+  bool result;
+  if (!RegexCache::matchLikePattern(type, literal, value.data(), value.size(), result)) {
+    return -1;
+  }
+  return result ? 1 : 0;
+}
+}  // namespace
+
+TEST(RegexCacheTest, test_analyze_like_pattern) {
+  std::string literal;
+  EXPECT_EQ(Type::Exact, analyze("abc", literal));
+  EXPECT_EQ("abc", literal);
+  EXPECT_EQ(Type::Exact, analyze("", literal));
+  EXPECT_EQ("", literal);
+  EXPECT_EQ(Type::Prefix, analyze("abc%", literal));
+  EXPECT_EQ("abc", literal);
+  EXPECT_EQ(Type::Prefix, analyze("abc%%", literal));
+  EXPECT_EQ("abc", literal);
+  EXPECT_EQ(Type::Suffix, analyze("%abc", literal));
+  EXPECT_EQ("abc", literal);
+  EXPECT_EQ(Type::Contains, analyze("%abc%", literal));
+  EXPECT_EQ("abc", literal);
+  EXPECT_EQ(Type::Contains, analyze("%", literal));
+  EXPECT_EQ("", literal);
+
+  // escaped wildcards and regex characters are literals
+  EXPECT_EQ(Type::Prefix, analyze("a\\%b.c%", literal));
+  EXPECT_EQ("a%b.c", literal);
+  EXPECT_EQ(Type::Exact, analyze("a\\_b", literal));
+  EXPECT_EQ("a_b", literal);
+  EXPECT_EQ(Type::Exact, analyze("a\\\\b", literal));
+  EXPECT_EQ("a\\b", literal);
+  EXPECT_EQ(Type::Exact, analyze("a\\b", literal));
+  EXPECT_EQ("a\\b", literal);
+
+  EXPECT_EQ(Type::Regex, analyze("a_c", literal));
+  EXPECT_EQ(Type::Regex, analyze("a%c", literal));
+  EXPECT_EQ(Type::Regex, analyze("%a%c%", literal));
+  EXPECT_EQ(Type::Regex, analyze("abc%\\%", literal));
+}
+
+TEST(RegexCacheTest, test_match_like_pattern) {
+  EXPECT_EQ(1, match("abc", "abc"));
+  EXPECT_EQ(0, match("abc", "abcd"));
+  EXPECT_EQ(1, match("", ""));
+  EXPECT_EQ(0, match("", "a"));
+
+  EXPECT_EQ(1, match("abc%", "abc"));
+  EXPECT_EQ(1, match("abc%", "abcdef"));
+  EXPECT_EQ(0, match("abc%", "xabc"));
+  EXPECT_EQ(0, match("abc%", "ab"));
+
+  EXPECT_EQ(1, match("%abc", "xyzabc"));
+  EXPECT_EQ(0, match("%abc", "abcx"));
+
+  EXPECT_EQ(1, match("%abc%", "xxabcxx"));
+  EXPECT_EQ(1, match("%abc%", "abc"));
+  EXPECT_EQ(0, match("%abc%", "ab c"));
+  EXPECT_EQ(1, match("%", ""));
+  EXPECT_EQ(1, match("%", "anything\r\n"));
+
+  // multi-byte characters
+  EXPECT_EQ(1, match("m\xc3\xbc%", "m\xc3\xbcller"));
+  EXPECT_EQ(0, match("m\xc3\xbc%", "muller"));
+}
+
+TEST(RegexCacheTest, test_line_separators_are_left_to_the_regex) {
+  // the wildcard of a LIKE regex does not match U+2028
+  EXPECT_EQ(-1, match("abc%", "abc\xe2\x80\xa8"));
+  EXPECT_EQ(-1, match("%abc", "\xe2\x80\xa8" "abc"));
+  EXPECT_EQ(-1, match("%abc%", "abc\xc2\x85"));
+  // but it is not needed to match them here
+  EXPECT_EQ(1, match("abc\xe2\x80\xa8", "abc\xe2\x80\xa8"));
+  EXPECT_EQ(0, match("abc%", "ab\xe2\x80\xa8"));
+}
@@ -0,0 +1,121 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "Aql/ResourceUsage.h"
+
+#include <chrono>
+#include <thread>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace {
+constexpr size_t chunk = GlobalResourceMonitor::chunkSize;
+
+// restores the unlimited global budget
+struct GlobalLimit {
+  GlobalLimit(size_t limit, double timeout) {
+    GlobalResourceMonitor::instance().setMemoryLimit(limit);
+    GlobalResourceMonitor::instance().setAdmissionTimeout(timeout);
+  }
+  ~GlobalLimit() {
+    GlobalResourceMonitor::instance().setMemoryLimit(0);
+    GlobalResourceMonitor::instance().setAdmissionTimeout(0.0);
+  }
+};
+}  // namespace
+
+TEST(ResourceUsageTest, test_reserves_chunks) {
+  auto& global = GlobalResourceMonitor::instance();
+  size_t const before = global.memoryUsage();
+  {
+    ResourceMonitor monitor;
+    monitor.increaseMemoryUsage(10);
+    EXPECT_EQ(chunk, monitor.reservedMemory());
+    EXPECT_EQ(before + chunk, global.memoryUsage());
+
+    monitor.increaseMemoryUsage(chunk);
+    EXPECT_EQ(2 * chunk, monitor.reservedMemory());
+
+    monitor.increaseMemoryUsage(3 * chunk);
+    EXPECT_EQ(5 * chunk, monitor.reservedMemory());
+
+    // a spare chunk is kept
+    monitor.decreaseMemoryUsage(3 * chunk + 5);
+    EXPECT_EQ(chunk + 5, monitor.currentResources.memoryUsage);
+    EXPECT_EQ(3 * chunk, monitor.reservedMemory());
+    EXPECT_EQ(before + 3 * chunk, global.memoryUsage());
+
+    monitor.clear();
+    EXPECT_EQ(0U, monitor.reservedMemory());
+    EXPECT_EQ(before, global.memoryUsage());
+
+    monitor.increaseMemoryUsage(1);
+  }
+  EXPECT_EQ(before, global.memoryUsage());
+}
+
+TEST(ResourceUsageTest, test_global_limit) {
+  GlobalLimit limit(GlobalResourceMonitor::instance().memoryUsage() + 2 * chunk, 0.0);
+
+  ResourceMonitor first;
+  first.increaseMemoryUsage(chunk + 1);
+  EXPECT_EQ(2 * chunk, first.reservedMemory());
+
+  ResourceMonitor second;
+  try {
+    second.increaseMemoryUsage(1);
+    FAIL() << "expected an exception";
+  } catch (basics::Exception const& ex) {
+    EXPECT_EQ(TRI_ERROR_RESOURCE_LIMIT, ex.code());
+  }
+  EXPECT_EQ(0U, second.currentResources.memoryUsage);
+  EXPECT_EQ(0U, second.reservedMemory());
+
+  // new queries are rejected
+  try {
+    GlobalResourceMonitor::instance().admit();
+    FAIL() << "expected an exception";
+  } catch (basics::Exception const& ex) {
+    EXPECT_EQ(TRI_ERROR_RESOURCE_LIMIT, ex.code());
+  }
+
+  first.clear();
+  GlobalResourceMonitor::instance().admit();
+  second.increaseMemoryUsage(1);
+  EXPECT_EQ(chunk, second.reservedMemory());
+}
+
+TEST(ResourceUsageTest, test_admission_waits_for_memory) {
+  GlobalLimit limit(GlobalResourceMonitor::instance().memoryUsage() + chunk, 60.0);
+
+  ResourceMonitor first;
+  first.increaseMemoryUsage(1);
+
+  std::thread releaser([&first]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    first.clear();
+  });
+  GlobalResourceMonitor::instance().admit();
+  releaser.join();
+  EXPECT_EQ(0U, first.reservedMemory());
+}
@@ -215,6 +215,46 @@ TEST_F(SortExecutorTest, rows_upstream_we_are_waiting_for_list_of_numbers) {
   ASSERT_TRUE(number == 5);
 }
 
+TEST_F(SortExecutorTest, rows_upstream_list_of_strings_uses_collation_order) {
+  SortExecutorInfos infos(std::move(sortRegisters),
+        /*limit (ignored for default sort)*/ 0, itemBlockManager, 1, 1,
+        {}, {0}, &trx, false);
+  // enough rows to use precomputed sort keys. the strings include values that
+  // collate equal, but differ in their bytes
+  std::vector<std::string> const words = {"b", "A", "a", "Ã¤", "B", "ab", "Ab", "aB", ""};
+  VPackBuilder builder;
+  builder.openArray();
+  for (size_t i = 0; i < 64; ++i) {
+    builder.openArray();
+    builder.add(VPackValue(words[(i * 7) % words.size()] + words[i % 4]));
+    builder.close();
+  }
+  builder.close();
+  AllRowsFetcherHelper fetcher(builder.steal(), false);
+  SortExecutor testee(fetcher, infos);
+  NoStats stats{};
+
+  OutputAqlItemRow result{std::move(block), infos.getOutputRegisters(),
+                          infos.registersToKeep(), infos.registersToClear()};
+  size_t produced = 0;
+  do {
+    std::tie(state, stats) = testee.produceRows(result);
+    ASSERT_TRUE(result.produced());
+    result.advanceRow();
+    ++produced;
+  } while (state == ExecutionState::HASMORE);
+  ASSERT_TRUE(state == ExecutionState::DONE);
+  ASSERT_EQ(64, produced);
+
+  block = result.stealBlock();
+  for (size_t i = 1; i < produced; ++i) {
+    AqlValue const& previous = block->getValueReference(i - 1, 0);
+    AqlValue const& current = block->getValueReference(i, 0);
+    ASSERT_TRUE(current.isString());
+    ASSERT_LE(AqlValue::Compare(&trx, previous, current, true), 0);
+  }
+}
+
 }  // namespace aql
 }  // namespace tests
 }  // namespace arangodb
@@ -0,0 +1,165 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "gtest/gtest.h"
+
+#include "Basics/AssocUnique.h"
+#include "Basics/fasthash.h"
+
+#include <unordered_set>
+
+namespace {
+struct Element {
+  int key;
+};
+
+struct Helper {
+  static uint64_t HashKey(int const* key) {
+    return fasthash64(key, sizeof(int), 0x12345678);
+  }
+
+  static uint64_t HashElement(Element* const& element, bool) {
+    return HashKey(&element->key);
+  }
+
+  bool IsEqualKeyElement(void*, int const* key, Element* const& element) const {
+    return *key == element->key;
+  }
+
+  bool IsEqualElementElement(void*, Element* const& left, Element* const& right) const {
+    return left == right;
+  }
+
+  bool IsEqualElementElementByKey(void*, Element* const& left,
+                                  Element* const& right) const {
+    return left->key == right->key;
+  }
+};
+
+typedef arangodb::basics::AssocUnique<int, Element*, Helper> Table;
+
+// large enough for the bucket to be resized gradually
+constexpr int n = 100000;
+
+std::vector<Element> makeElements() {
+  std::vector<Element> elements(n);
+  for (int i = 0; i < n; ++i) {
+    elements[i].key = i;
+  }
+  return elements;
+}
+}  // namespace
+
+TEST(AssocUniqueTest, test_lookups_while_resizing) {
+  auto elements = makeElements();
+  Table table{Helper()};
+
+  for (int i = 0; i < n; ++i) {
+    ASSERT_EQ(TRI_ERROR_NO_ERROR, table.insert(nullptr, &elements[i]));
+    ASSERT_EQ(TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED,
+              table.insert(nullptr, &elements[i / 2]));
+    if (i % 997 == 0) {
+      // everything inserted so far is found, in whichever table it is
+      for (int j = 0; j <= i; ++j) {
+        ASSERT_EQ(&elements[j], table.findByKey(nullptr, &j));
+      }
+    }
+  }
+
+  EXPECT_EQ(static_cast<size_t>(n), table.size());
+  for (int j = 0; j < n; ++j) {
+    EXPECT_EQ(&elements[j], table.find(nullptr, &elements[j]));
+  }
+  int missing = n;
+  EXPECT_EQ(nullptr, table.findByKey(nullptr, &missing));
+}
+
+TEST(AssocUniqueTest, test_removals_while_resizing) {
+  auto elements = makeElements();
+  Table table{Helper()};
+
+  for (int i = 0; i < n; ++i) {
+    ASSERT_EQ(TRI_ERROR_NO_ERROR, table.insert(nullptr, &elements[i]));
+    if (i % 3 == 0) {
+      // removes elements from the old table as well as from the new one
+      int key = i / 2;
+      ASSERT_EQ(&elements[key], table.removeByKey(nullptr, &key));
+      elements[key].key = -1;
+    }
+  }
+
+  size_t expected = 0;
+  for (int j = 0; j < n; ++j) {
+    if (elements[j].key == -1) {
+      int key = j;
+      ASSERT_EQ(nullptr, table.findByKey(nullptr, &key));
+    } else {
+      ++expected;
+      ASSERT_EQ(&elements[j], table.findByKey(nullptr, &j));
+    }
+  }
+  EXPECT_EQ(expected, table.size());
+}
+
+TEST(AssocUniqueTest, test_iteration_while_resizing) {
+  auto elements = makeElements();
+  Table table{Helper()};
+
+  // stop in the middle of a gradual resize
+  int count = 0;
+  while (count < n) {
+    ASSERT_EQ(TRI_ERROR_NO_ERROR, table.insert(nullptr, &elements[count]));
+    ++count;
+    arangodb::velocypack::Builder builder;
+    builder.openObject();
+    table.appendToVelocyPack(builder);
+    builder.close();
+    if (builder.slice().get("buckets").at(0).hasKey("nrResizing")) {
+      break;
+    }
+  }
+  ASSERT_LT(count, n);
+
+  std::unordered_set<Element*> seen;
+  arangodb::basics::BucketPosition position;
+  uint64_t total = 0;
+  while (Element* element = table.findSequential(nullptr, position, total)) {
+    EXPECT_TRUE(seen.insert(element).second);
+  }
+  EXPECT_EQ(static_cast<uint64_t>(count), total);
+  EXPECT_EQ(static_cast<size_t>(count), seen.size());
+
+  seen.clear();
+  position.reset();
+  position.bucketId = SIZE_MAX;
+  while (Element* element = table.findSequentialReverse(nullptr, position)) {
+    EXPECT_TRUE(seen.insert(element).second);
+  }
+  EXPECT_EQ(static_cast<size_t>(count), seen.size());
+
+  seen.clear();
+  table.invokeOnAllElements([&seen](Element*& element) {
+    seen.insert(element);
+    return true;
+  });
+  EXPECT_EQ(static_cast<size_t>(count), seen.size());
+}
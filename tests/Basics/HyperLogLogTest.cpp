@@ -0,0 +1,119 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+#include "Basics/HyperLogLog.h"
+
+#include "gtest/gtest.h"
+
+using namespace arangodb::basics;
+
+namespace {
+void expectNear(double expected, double actual) {
+  // far more than the standard error of the sketch, but deterministic
+  EXPECT_GE(actual, expected * 0.95);
+  EXPECT_LE(actual, expected * 1.05);
+}
+}  // namespace
+
+TEST(HyperLogLogTest, test_empty) {
+  HyperLogLog hll;
+  EXPECT_EQ(0.0, hll.estimate());
+}
+
+TEST(HyperLogLogTest, test_duplicates_are_ignored) {
+  HyperLogLog hll;
+  for (uint64_t i = 0; i < 100000; ++i) {
+    hll.insert(i % 1000);
+  }
+  ::expectNear(1000.0, hll.estimate());
+}
+
+TEST(HyperLogLogTest, test_large_cardinality) {
+  HyperLogLog hll;
+  for (uint64_t i = 0; i < 1000000; ++i) {
+    hll.insert(i);
+  }
+  ::expectNear(1000000.0, hll.estimate());
+}
+
+TEST(HyperLogLogTest, test_merge_disjoint) {
+  HyperLogLog a;
+  HyperLogLog b;
+  for (uint64_t i = 0; i < 50000; ++i) {
+    a.insert(i);
+    b.insert(i + 50000);
+  }
+  a.merge(b);
+  ::expectNear(100000.0, a.estimate());
+}
+
+TEST(HyperLogLogTest, test_merge_overlapping) {
+  HyperLogLog a;
+  HyperLogLog b;
+  for (uint64_t i = 0; i < 50000; ++i) {
+    a.insert(i);
+    b.insert(i);
+  }
+  double before = a.estimate();
+  a.merge(b);
+  EXPECT_EQ(before, a.estimate());
+}
+
+TEST(HyperLogLogTest, test_serialize) {
+  HyperLogLog a;
+  for (uint64_t i = 0; i < 12345; ++i) {
+    a.insert(i);
+  }
+  std::string serialized;
+  a.serialize(serialized);
+  EXPECT_EQ(HyperLogLog::serializedSize(), serialized.size());
+
+  HyperLogLog b;
+  EXPECT_TRUE(b.deserialize(serialized.data(), serialized.size()));
+  EXPECT_EQ(a.estimate(), b.estimate());
+
+  HyperLogLog c;
+  EXPECT_FALSE(c.deserialize(serialized.data(), serialized.size() - 1));
+  EXPECT_EQ(0.0, c.estimate());
+}
+
+TEST(HyperLogLogTest, test_deserialize_invalid_registers) {
+  HyperLogLog hll;
+  std::string serialized;
+  hll.serialize(serialized);
+
+  // a rank that insert() cannot produce
+  serialized.back() = '\x7f';
+  HyperLogLog other;
+  EXPECT_FALSE(other.deserialize(serialized.data(), serialized.size()));
+
+  serialized.back() = '\x01';
+  EXPECT_TRUE(other.deserialize(serialized.data(), serialized.size()));
+}
+
+TEST(HyperLogLogTest, test_clear) {
+  HyperLogLog hll;
+  for (uint64_t i = 0; i < 1000; ++i) {
+    hll.insert(i);
+  }
+  hll.clear();
+  EXPECT_EQ(0.0, hll.estimate());
+}
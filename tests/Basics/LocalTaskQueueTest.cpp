@@ -0,0 +1,111 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "gtest/gtest.h"
+
+#include "Basics/LocalTaskQueue.h"
+#include "Basics/Mutex.h"
+#include "Basics/MutexLocker.h"
+
+#include <atomic>
+#include <thread>
+
+using namespace arangodb::basics;
+
+namespace {
+class CountingTask final : public LocalTask {
+ public:
+  CountingTask(std::shared_ptr<LocalTaskQueue> const& queue,
+               std::atomic<size_t>& counter, size_t children)
+      : LocalTask(queue), _counter(counter), _children(children) {}
+
+  void run() override {
+    // tasks may queue further tasks while the queue is dispatched
+    for (size_t i = 0; i < _children; ++i) {
+      _queue->enqueue(std::make_shared<CountingTask>(_queue, _counter, 0));
+    }
+    ++_counter;
+    _queue->join();
+  }
+
+ private:
+  std::atomic<size_t>& _counter;
+  size_t const _children;
+};
+
+// runs the posted runners on threads of its own
+struct ThreadPoster {
+  arangodb::Mutex mutex;
+  std::vector<std::thread> threads;
+
+  ~ThreadPoster() {
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+  LocalTaskQueue::PostFn poster() {
+    return [this](std::function<void()> fn) {
+      MUTEX_LOCKER(locker, mutex);
+      threads.emplace_back(fn);
+    };
+  }
+};
+}  // namespace
+
+TEST(LocalTaskQueueTest, test_without_poster) {
+  // the waiting thread runs everything
+  auto queue = std::make_shared<LocalTaskQueue>(nullptr);
+  std::atomic<size_t> counter(0);
+  for (size_t i = 0; i < 10; ++i) {
+    queue->enqueue(std::make_shared<CountingTask>(queue, counter, 3));
+  }
+  queue->dispatchAndWait();
+  EXPECT_EQ(40U, counter.load());
+  EXPECT_EQ(TRI_ERROR_NO_ERROR, queue->status());
+}
+
+TEST(LocalTaskQueueTest, test_with_runners) {
+  ThreadPoster poster;
+  std::atomic<size_t> counter(0);
+  {
+    auto queue = std::make_shared<LocalTaskQueue>(poster.poster(), 4);
+    queue->enqueue(std::make_shared<CountingTask>(queue, counter, 100));
+    for (size_t i = 0; i < 20; ++i) {
+      queue->enqueue(std::make_shared<CountingTask>(queue, counter, 5));
+    }
+    queue->dispatchAndWait();
+    EXPECT_EQ(221U, counter.load());
+  }
+  // more tasks than runners, so some runners were posted
+  MUTEX_LOCKER(locker, poster.mutex);
+  EXPECT_GE(poster.threads.size(), 1U);
+}
+
+TEST(LocalTaskQueueTest, test_failed_queue_stops) {
+  auto queue = std::make_shared<LocalTaskQueue>(nullptr);
+  std::atomic<size_t> counter(0);
+  queue->enqueue(std::make_shared<CountingTask>(queue, counter, 0));
+  queue->setStatus(TRI_ERROR_INTERNAL);
+  queue->dispatchAndWait();
+  EXPECT_EQ(0U, counter.load());
+}
@@ -142,3 +142,33 @@ TEST_F(LoggerTest, test_fds_after_reopen) {
 
   LogAppenderFile::clear();
 }
+
+TEST_F(LoggerTest, test_batch) {
+  LogAppenderFile logger1(logfile1, "");
+  LogAppenderFile logger2(logfile1, "");
+
+  logger1.startBatch();
+  logger2.startBatch();
+
+  for (size_t i = 0; i < 100; ++i) {
+    auto& logger = (i % 2 == 0) ? logger1 : logger2;
+    logger.logMessage(LogLevel::INFO, "batched message " + std::to_string(i), 0);
+  }
+
+  logger1.finishBatch();
+  logger2.finishBatch();
+
+  // both appenders write to the same file, in the original order
+  std::string content = FileUtils::slurp(logfile1);
+  size_t pos = 0;
+  for (size_t i = 0; i < 100; ++i) {
+    std::string expected = "batched message " + std::to_string(i) + "\n";
+    size_t found = content.find(expected, pos);
+    ASSERT_NE(found, std::string::npos);
+    EXPECT_EQ(found, pos);
+    pos = found + expected.size();
+  }
+  EXPECT_EQ(pos, content.size());
+
+  LogAppenderFile::clear();
+}
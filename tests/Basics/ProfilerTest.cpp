@@ -0,0 +1,76 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "gtest/gtest.h"
+
+#include "Basics/Profiler.h"
+
+#include <atomic>
+#include <thread>
+
+#ifdef __linux__
+#include <signal.h>
+#include <sys/prctl.h>
+#endif
+
+using namespace arangodb;
+
+#ifdef __linux__
+
+TEST(ProfilerTest, test_invalid_frequency) {
+  profiler::CpuProfileOptions options;
+  options.frequency = 0;
+  std::string result;
+  EXPECT_EQ(TRI_ERROR_BAD_PARAMETER, profiler::sampleCpu(options, result).errorNumber());
+  EXPECT_TRUE(result.empty());
+}
+
+TEST(ProfilerTest, test_samples_running_thread) {
+  std::atomic<bool> stop(false);
+  std::thread busy([&stop]() {
+    sigset_t mask;
+    sigfillset(&mask);
+    sigdelset(&mask, profiler::sampleSignal());
+    pthread_sigmask(SIG_SETMASK, &mask, nullptr);
+    prctl(PR_SET_NAME, "ProfilerBusy", 0, 0, 0);
+    while (!stop.load()) {
+    }
+  });
+
+  profiler::CpuProfileOptions options;
+  options.duration = std::chrono::milliseconds(200);
+  std::string result;
+  Result res = profiler::sampleCpu(options, result);
+  stop.store(true);
+  busy.join();
+
+  ASSERT_TRUE(res.ok());
+  // one line per stack: the thread name, the frames and the sample count
+  size_t const pos = result.find("ProfilerBusy;");
+  ASSERT_NE(std::string::npos, pos);
+  size_t const end = result.find('\n', pos);
+  ASSERT_NE(std::string::npos, end);
+  size_t const space = result.rfind(' ', end);
+  EXPECT_GT(std::stoull(result.substr(space + 1, end - space - 1)), 0ULL);
+}
+
+#endif
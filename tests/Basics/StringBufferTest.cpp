@@ -30,6 +30,7 @@
 #include "gtest/gtest.h"
 
 #include "Basics/StringBuffer.h"
+#include "Basics/StringUtils.h"
 
 using namespace arangodb;
 using namespace arangodb::basics;
@@ -74,3 +75,35 @@ TEST(StringBufferTest, test_StringBuffer2) {
   EXPECT_TRUE(buffer.length() == (size_t) 15);
   EXPECT_TRUE(std::string(buffer.c_str()) == "Hallo World1234");
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test_compress
+////////////////////////////////////////////////////////////////////////////////
+
+TEST(StringBufferTest, test_compress) {
+  std::string data;
+  for (int i = 0; i < 10000; ++i) {
+    data.append("{\"_key\":\"").append(std::to_string(i)).append("\"},");
+  }
+
+  StringBuffer gzipped(true);
+  gzipped.appendText(data);
+  EXPECT_EQ(TRI_ERROR_NO_ERROR, gzipped.gzip(16384));
+  EXPECT_LT(gzipped.length(), data.size());
+  // gzip magic bytes
+  EXPECT_EQ(0x1f, static_cast<uint8_t>(gzipped.c_str()[0]));
+  EXPECT_EQ(0x8b, static_cast<uint8_t>(gzipped.c_str()[1]));
+
+  std::string uncompressed;
+  EXPECT_TRUE(StringUtils::gzipUncompress(gzipped.c_str(), gzipped.length(), uncompressed));
+  EXPECT_EQ(data, uncompressed);
+
+  StringBuffer deflated(true);
+  deflated.appendText(data);
+  EXPECT_EQ(TRI_ERROR_NO_ERROR, deflated.deflate(16384));
+  EXPECT_LT(deflated.length(), data.size());
+
+  uncompressed.clear();
+  EXPECT_TRUE(StringUtils::gzipDeflate(deflated.c_str(), deflated.length(), uncompressed));
+  EXPECT_EQ(data, uncompressed);
+}
@@ -162,3 +162,21 @@ TEST(VPackHelperTest, tst_compare_values_unequal) {
   VPACK_EXPECT_TRUE(-1, arangodb::basics::VelocyPackHelper::compare, "1", "[true]");
   VPACK_EXPECT_TRUE(-1, arangodb::basics::VelocyPackHelper::compare, "1", "{}");
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test building from binary VelocyPack
+////////////////////////////////////////////////////////////////////////////////
+
+TEST(VPackHelperTest, tst_velocypack_from_binary) {
+  auto original = VPackParser::fromJson("{\"a\":1,\"b\":[true,\"foo\"]}");
+  VPackSlice s = original->slice();
+
+  auto copy = arangodb::basics::VelocyPackHelper::velocyPackFromBinary(
+      s.startAs<char>(), s.byteSize(), VPackOptions::Defaults);
+  EXPECT_TRUE(copy->slice().byteSize() == s.byteSize());
+  EXPECT_TRUE(0 == arangodb::basics::VelocyPackHelper::compare(s, copy->slice(), true));
+
+  // truncated data must be rejected
+  EXPECT_ANY_THROW(arangodb::basics::VelocyPackHelper::velocyPackFromBinary(
+      s.startAs<char>(), s.byteSize() - 1, VPackOptions::Defaults));
+}
@@ -73,3 +73,48 @@ TEST(DateTimeTest, testing) {
     ASSERT_FALSE(ret);
   }
 }
+
+TEST(DateTimeTest, values) {
+  using namespace std::chrono;
+  using namespace date;
+
+  auto parse = [](std::string const& value) {
+    tp_sys_clock_ms tp;
+    EXPECT_TRUE(parseDateTime(value, tp)) << value;
+    return tp.time_since_epoch().count();
+  };
+
+  ASSERT_EQ(1510444800000, parse("2017-11-12"));
+  ASSERT_EQ(1510444800000, parse("  2017-11-12Z\t"));
+  ASSERT_EQ(1510490096789, parse("2017-11-12T12:34:56.789"));
+  ASSERT_EQ(1510490096789, parse("2017-11-12 12:34:56.789123Z"));
+  ASSERT_EQ(1510490096900, parse("2017-11-12T12:34:56.9"));
+  ASSERT_EQ(1510490096000 - 37320000, parse("2017-11-12T12:34:56+10:22"));
+  ASSERT_EQ(1510490096000 + 3600000, parse("2017-11-12T12:34:56-1:00"));
+  ASSERT_EQ(1483228800000, parse("2017"));
+
+  tp_sys_clock_ms tp;
+  for (auto const& value : {"", "Z", "-", "+2017", "2017-", "2017-13", "2017-1-32",
+                            "2017-11-12T", "2017-11-12T24:00", "2017-11-12T12:60",
+                            "2017-11-12T12:34:60", "2017-11-12T12:34:56.",
+                            "2017-11-12T12:34+24:00", "2017-11-12T12:34:5",
+                            "2017-11-12t12:34", "2017-11-12T12:34Zx"}) {
+    ASSERT_FALSE(parseDateTime(value, tp)) << value;
+  }
+}
+
+TEST(DateTimeTest, format) {
+  tp_sys_clock_ms tp;
+  ASSERT_TRUE(parseDateTime("2017-03-05T04:05:06.007Z", tp));
+
+  ASSERT_EQ("2017-03-05T04:05:06.007Z", formatDate("%yyyy-%mm-%ddT%hh:%ii:%ss.%fffZ", tp));
+  ASSERT_EQ("+002017", formatDate("%yyyyyy", tp));
+  ASSERT_EQ("March Mar 3m", formatDate("%mmmm %mmm %m%&m", tp));
+  // a single % without a known placeholder produces nothing
+  ASSERT_EQ("% %q ", formatDate("%% %%q %", tp));
+  ASSERT_EQ("no placeholders", formatDate("no placeholders", tp));
+  // repeated use of a cached format
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_EQ("05.03.2017", formatDate("%dd.%mm.%yyyy", tp));
+  }
+}
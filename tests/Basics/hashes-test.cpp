@@ -699,3 +699,50 @@ TEST_F(CHashesTest, tst_crc32_utf8) {
               TRI_FinalCrc32(TRI_BlockCrc32(TRI_InitialCrc32(), buffer.c_str(),
                                             strlen(buffer.c_str()))));
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test xxh3 against the values of the reference implementation
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_F(CHashesTest, tst_xxh3_simple) {
+  auto hash = [](std::string const& value, uint64_t seed) {
+    uint64_t result = TRI_Xxh3Hash64(value.data(), value.size(), seed);
+    EXPECT_EQ(result, TRI_Xxh3Hash64_Generic(value.data(), value.size(), seed));
+    return result;
+  };
+
+  EXPECT_EQ(3244421341483603138ULL, hash("", 0));
+  EXPECT_EQ(5683168152932122062ULL, hash("", 0x12345678));
+  EXPECT_EQ(16629034431890738719ULL, hash("a", 0));
+  EXPECT_EQ(11708933799372153736ULL, hash("a", 0x12345678));
+  EXPECT_EQ(8696274497037089104ULL, hash("abc", 0));
+  EXPECT_EQ(14849292964822683943ULL, hash("abc", 0x12345678));
+  EXPECT_EQ(15296390279056496779ULL, hash("hello world", 0));
+  EXPECT_EQ(4503721869078628430ULL, hash("hello world", 0x12345678));
+  EXPECT_EQ(6518762261206555963ULL,
+            hash("The Quick Brown Fox Jumped Over The Lazy Dog", 0));
+  EXPECT_EQ(11885504795528228781ULL,
+            hash("The Quick Brown Fox Jumped Over The Lazy Dog", 0x12345678));
+}
+
+TEST_F(CHashesTest, tst_xxh3_long) {
+  auto hash = [](size_t length, uint64_t seed) {
+    std::string value;
+    for (size_t i = 0; i < length; ++i) {
+      value.push_back(static_cast<char>('a' + (i * 7) % 26));
+    }
+    // long blobs use the runtime-detected implementation, if any
+    uint64_t result = TRI_Xxh3Hash64(value.data(), value.size(), seed);
+    EXPECT_EQ(result, TRI_Xxh3Hash64_Generic(value.data(), value.size(), seed));
+    return result;
+  };
+
+  EXPECT_EQ(11298861387704593049ULL, hash(100, 0));
+  EXPECT_EQ(4896469404453072114ULL, hash(100, 0x12345678));
+  EXPECT_EQ(9040369395695955725ULL, hash(200, 0));
+  EXPECT_EQ(902774743156892071ULL, hash(200, 0x12345678));
+  EXPECT_EQ(257613219065027544ULL, hash(1000, 0));
+  EXPECT_EQ(6218715505897249306ULL, hash(1000, 0x12345678));
+  EXPECT_EQ(3657660570738539858ULL, hash(5000, 0));
+  EXPECT_EQ(14421310315508854529ULL, hash(5000, 0x12345678));
+}
@@ -0,0 +1,161 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Benchmark.h"
+
+#include "Aql/AqlItemBlock.h"
+#include "Aql/ExecutorInfos.h"
+#include "Aql/FilterExecutor.h"
+#include "Aql/HashedCollectExecutor.h"
+#include "Aql/OutputAqlItemRow.h"
+#include "Aql/Query.h"
+#include "Aql/ResourceUsage.h"
+#include "Aql/SortExecutor.h"
+#include "Aql/SortRegister.h"
+#include "Aql/Variable.h"
+#include "Random/RandomGenerator.h"
+#include "tests/Aql/RowFetcherHelper.h"
+#include "tests/Mocks/Servers.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+using namespace arangodb::benchmarks;
+using namespace arangodb::tests::aql;
+
+namespace {
+constexpr size_t numRows = 10000;
+
+/// @brief rows of a single register with random integers below range
+std::shared_ptr<VPackBuffer<uint8_t>> randomIntegers(size_t rows, int64_t range) {
+  VPackBuilder builder;
+  builder.openArray();
+  for (size_t i = 0; i < rows; ++i) {
+    builder.openArray();
+    builder.add(VPackValue(RandomGenerator::interval(int64_t(0), range - 1)));
+    builder.close();
+  }
+  builder.close();
+  return builder.steal();
+}
+
+/// @brief rows of a single register with random booleans
+std::shared_ptr<VPackBuffer<uint8_t>> randomBooleans(size_t rows) {
+  VPackBuilder builder;
+  builder.openArray();
+  for (size_t i = 0; i < rows; ++i) {
+    builder.openArray();
+    builder.add(VPackValue(RandomGenerator::interval(uint32_t(1)) == 1));
+    builder.close();
+  }
+  builder.close();
+  return builder.steal();
+}
+
+/// @brief calls produceRows until the executor is done, the output block
+/// must be large enough for all rows
+template <typename Executor>
+size_t drain(Executor& executor, OutputAqlItemRow& output) {
+  size_t produced = 0;
+  ExecutionState state = ExecutionState::HASMORE;
+  while (state != ExecutionState::DONE) {
+    std::tie(state, std::ignore) = executor.produceRows(output);
+    if (output.produced()) {
+      output.advanceRow();
+      ++produced;
+    }
+  }
+  return produced;
+}
+}  // namespace
+
+ARANGODB_BENCHMARK(FilterExecutor, half_of_10k_rows) {
+  ResourceMonitor monitor;
+  AqlItemBlockManager manager(&monitor);
+  auto input = ::randomBooleans(::numRows);
+  FilterExecutorInfos infos(0, 1, 1, {}, {});
+
+  state.setItemsPerIteration(::numRows);
+  while (state.keepRunning()) {
+    state.pauseTiming();
+    SingleRowFetcherHelper<FilterExecutor::Properties::allowsBlockPassthrough> fetcher(input, false);
+    FilterExecutor executor(fetcher, infos);
+    OutputAqlItemRow output(SharedAqlItemBlockPtr{new AqlItemBlock(manager, ::numRows, 1)},
+                            infos.getOutputRegisters(), infos.registersToKeep(),
+                            infos.registersToClear());
+    state.resumeTiming();
+
+    doNotOptimize(::drain(executor, output));
+  }
+}
+
+ARANGODB_BENCHMARK(SortExecutor, integers_10k_rows) {
+  tests::mocks::MockAqlServer server;
+  auto query = server.createFakeQuery();
+  ResourceMonitor monitor;
+  AqlItemBlockManager manager(&monitor);
+  auto input = ::randomIntegers(::numRows, 1000000);
+
+  Variable variable("value", 0);
+  std::vector<SortRegister> sortRegisters;
+  sortRegisters.emplace_back(0, SortElement(&variable, true));
+  SortExecutorInfos infos(std::move(sortRegisters), 0, manager, 1, 1, {}, {0},
+                          query->trx(), false);
+
+  state.setItemsPerIteration(::numRows);
+  while (state.keepRunning()) {
+    state.pauseTiming();
+    AllRowsFetcherHelper fetcher(input, false);
+    SortExecutor executor(fetcher, infos);
+    OutputAqlItemRow output(SharedAqlItemBlockPtr{new AqlItemBlock(manager, ::numRows, 1)},
+                            infos.getOutputRegisters(), infos.registersToKeep(),
+                            infos.registersToClear());
+    state.resumeTiming();
+
+    doNotOptimize(::drain(executor, output));
+  }
+}
+
+ARANGODB_BENCHMARK(HashedCollectExecutor, 1k_groups_of_10k_rows) {
+  tests::mocks::MockAqlServer server;
+  auto query = server.createFakeQuery();
+  ResourceMonitor monitor;
+  AqlItemBlockManager manager(&monitor);
+  size_t const groups = 1000;
+  auto input = ::randomIntegers(::numRows, groups);
+
+  HashedCollectExecutorInfos infos(1, 2, {}, {}, {0}, {1}, {{1, 0}}, 0, {}, {},
+                                   query->trx(), false);
+
+  state.setItemsPerIteration(::numRows);
+  while (state.keepRunning()) {
+    state.pauseTiming();
+    SingleRowFetcherHelper<HashedCollectExecutor::Properties::allowsBlockPassthrough> fetcher(input, false);
+    HashedCollectExecutor executor(fetcher, infos);
+    OutputAqlItemRow output(SharedAqlItemBlockPtr{new AqlItemBlock(manager, groups, 2)},
+                            infos.getOutputRegisters(), infos.registersToKeep(),
+                            infos.registersToClear());
+    state.resumeTiming();
+
+    doNotOptimize(::drain(executor, output));
+  }
+}
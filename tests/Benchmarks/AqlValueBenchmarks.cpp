@@ -0,0 +1,137 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Benchmark.h"
+
+#include "Aql/AqlValue.h"
+#include "Random/RandomGenerator.h"
+#include "Transaction/Methods.h"
+#include "tests/Mocks/Servers.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+using namespace arangodb::benchmarks;
+
+namespace {
+constexpr size_t numValues = 1024;
+
+enum class Kind { Integer, String, Document };
+
+/// @brief an array of random values. strings are longer than what fits
+/// into an inline AqlValue, documents look like small user documents
+VPackBuilder randomValues(Kind kind) {
+  VPackBuilder builder;
+  builder.openArray();
+  for (size_t i = 0; i < numValues; ++i) {
+    int64_t value = RandomGenerator::interval(int64_t(0), int64_t(1000000));
+    switch (kind) {
+      case Kind::Integer:
+        builder.add(VPackValue(value));
+        break;
+      case Kind::String:
+        builder.add(VPackValue("customers/" + std::to_string(value) +
+                               "/orders/2019-06-01"));
+        break;
+      case Kind::Document:
+        builder.openObject();
+        builder.add("_key", VPackValue(std::to_string(value)));
+        builder.add("name", VPackValue("user " + std::to_string(value % 1000)));
+        builder.add("age", VPackValue(value % 100));
+        builder.add("tags", VPackValue(VPackValueType::Array));
+        builder.add(VPackValue("a"));
+        builder.add(VPackValue(value % 7));
+        builder.close();
+        builder.close();
+        break;
+    }
+  }
+  builder.close();
+  return builder;
+}
+
+std::vector<AqlValue> toAqlValues(VPackSlice values) {
+  std::vector<AqlValue> result;
+  for (auto const& value : VPackArrayIterator(values)) {
+    // values point into the builder, like documents from the storage engine
+    result.emplace_back(AqlValueHintDocumentNoCopy(value.begin()));
+  }
+  return result;
+}
+
+void compare(State& state, Kind kind) {
+  tests::mocks::MockAqlServer server;
+  auto trx = server.createFakeTransaction();
+  VPackBuilder builder = ::randomValues(kind);
+  std::vector<AqlValue> values = ::toAqlValues(builder.slice());
+
+  state.setItemsPerIteration(values.size() - 1);
+  while (state.keepRunning()) {
+    int result = 0;
+    for (size_t i = 1; i < values.size(); ++i) {
+      result += AqlValue::Compare(trx.get(), values[i - 1], values[i], true);
+    }
+    doNotOptimize(result);
+  }
+}
+
+void hash(State& state, Kind kind) {
+  tests::mocks::MockAqlServer server;
+  auto trx = server.createFakeTransaction();
+  VPackBuilder builder = ::randomValues(kind);
+  std::vector<AqlValue> values = ::toAqlValues(builder.slice());
+
+  state.setItemsPerIteration(values.size());
+  while (state.keepRunning()) {
+    uint64_t result = 0;
+    for (auto const& value : values) {
+      result ^= value.hash(trx.get());
+    }
+    doNotOptimize(result);
+  }
+}
+}  // namespace
+
+ARANGODB_BENCHMARK(AqlValue, compare_integers) {
+  ::compare(state, ::Kind::Integer);
+}
+
+ARANGODB_BENCHMARK(AqlValue, compare_strings) {
+  ::compare(state, ::Kind::String);
+}
+
+ARANGODB_BENCHMARK(AqlValue, compare_documents) {
+  ::compare(state, ::Kind::Document);
+}
+
+ARANGODB_BENCHMARK(AqlValue, hash_integers) {
+  ::hash(state, ::Kind::Integer);
+}
+
+ARANGODB_BENCHMARK(AqlValue, hash_strings) {
+  ::hash(state, ::Kind::String);
+}
+
+ARANGODB_BENCHMARK(AqlValue, hash_documents) {
+  ::hash(state, ::Kind::Document);
+}
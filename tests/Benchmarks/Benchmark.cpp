@@ -0,0 +1,183 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Benchmark.h"
+
+#include "Basics/FileUtils.h"
+#include "Rest/Version.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+using namespace arangodb;
+using namespace arangodb::benchmarks;
+
+namespace {
+struct Registered {
+  std::string name;
+  BenchmarkFunction function;
+};
+
+std::vector<Registered>& registry() {
+  static std::vector<Registered> benchmarks;
+  return benchmarks;
+}
+
+struct Measurement {
+  std::string name;
+  uint64_t iterations;
+  // nanoseconds per iteration of all repetitions, sorted
+  std::vector<double> results;
+  uint64_t itemsPerIteration;
+
+  double median() const { return results[results.size() / 2]; }
+};
+
+/// @brief upper bound for the iterations of one measurement
+constexpr uint64_t maxIterations = 1000000000;
+
+Measurement measure(Registered const& benchmark, RunOptions const& options) {
+  Measurement m{benchmark.name, 1, {}, 0};
+
+  // find the number of iterations that takes minTime, like google benchmark
+  // does: grow the count by the ratio of the time missing, but at most 10x
+  while (true) {
+    State state(m.iterations);
+    benchmark.function(state);
+    double elapsed = state.elapsed();
+    if (elapsed >= options.minTime || m.iterations >= ::maxIterations) {
+      m.results.push_back(elapsed * 1.0e9 / static_cast<double>(m.iterations));
+      m.itemsPerIteration = state.itemsPerIteration();
+      break;
+    }
+    double factor = 10.0;
+    if (elapsed > 0.0) {
+      factor = (std::min)(factor, (std::max)(2.0, 1.4 * options.minTime / elapsed));
+    }
+    m.iterations = (std::min)(::maxIterations,
+                              static_cast<uint64_t>(m.iterations * factor) + 1);
+  }
+
+  while (m.results.size() < options.repetitions) {
+    State state(m.iterations);
+    benchmark.function(state);
+    m.results.push_back(state.elapsed() * 1.0e9 / static_cast<double>(m.iterations));
+  }
+  std::sort(m.results.begin(), m.results.end());
+  return m;
+}
+
+void print(Measurement const& m) {
+  std::cout << std::left << std::setw(48) << m.name << std::right
+            << std::setw(14) << std::fixed << std::setprecision(1)
+            << m.median() << " ns" << std::setw(12) << m.iterations;
+  if (m.itemsPerIteration > 0) {
+    double perSecond = m.itemsPerIteration * 1.0e9 / m.median();
+    std::cout << std::setw(14) << std::setprecision(3) << perSecond / 1.0e6
+              << " M items/s";
+  }
+  std::cout << std::endl;
+}
+
+void writeJson(std::vector<Measurement> const& measurements, RunOptions const& options) {
+  VPackBuilder builder;
+  builder.openObject();
+  builder.add("version", VPackValue(rest::Version::getServerVersion()));
+  builder.add("repository", VPackValue(rest::Version::getBuildRepository()));
+  builder.add("buildDate", VPackValue(rest::Version::getBuildDate()));
+  builder.add("compiler", VPackValue(rest::Version::getCompiler()));
+  builder.add("minTime", VPackValue(options.minTime));
+  builder.add("benchmarks", VPackValue(VPackValueType::Array));
+  for (auto const& m : measurements) {
+    builder.openObject();
+    builder.add("name", VPackValue(m.name));
+    builder.add("iterations", VPackValue(m.iterations));
+    builder.add("repetitions", VPackValue(m.results.size()));
+    builder.add("nsPerIteration", VPackValue(m.median()));
+    builder.add("minNsPerIteration", VPackValue(m.results.front()));
+    builder.add("maxNsPerIteration", VPackValue(m.results.back()));
+    if (m.itemsPerIteration > 0) {
+      builder.add("itemsPerIteration", VPackValue(m.itemsPerIteration));
+      builder.add("itemsPerSecond",
+                  VPackValue(m.itemsPerIteration * 1.0e9 / m.median()));
+    }
+    builder.close();
+  }
+  builder.close();
+  builder.close();
+
+  basics::FileUtils::spit(options.jsonOutput, builder.slice().toJson(), true);
+}
+}  // namespace
+
+bool arangodb::benchmarks::registerBenchmark(std::string name, BenchmarkFunction function) {
+  registry().push_back({std::move(name), std::move(function)});
+  return true;
+}
+
+int arangodb::benchmarks::runBenchmarks(RunOptions const& options) {
+  std::vector<Registered> selected;
+  for (auto const& benchmark : registry()) {
+    if (benchmark.name.find(options.filter) != std::string::npos) {
+      selected.push_back(benchmark);
+    }
+  }
+  std::sort(selected.begin(), selected.end(),
+            [](Registered const& lhs, Registered const& rhs) {
+              return lhs.name < rhs.name;
+            });
+
+  if (options.list) {
+    for (auto const& benchmark : selected) {
+      std::cout << benchmark.name << std::endl;
+    }
+    return EXIT_SUCCESS;
+  }
+
+  int result = EXIT_SUCCESS;
+  std::vector<Measurement> measurements;
+  std::cout << std::left << std::setw(48) << "benchmark" << std::right
+            << std::setw(17) << "time/iteration" << std::setw(12)
+            << "iterations" << std::setw(25) << "throughput" << std::endl;
+  for (auto const& benchmark : selected) {
+    try {
+      measurements.emplace_back(measure(benchmark, options));
+      print(measurements.back());
+    } catch (std::exception const& ex) {
+      std::cout << benchmark.name << " failed: " << ex.what() << std::endl;
+      result = EXIT_FAILURE;
+    }
+  }
+
+  if (!options.jsonOutput.empty()) {
+    try {
+      writeJson(measurements, options);
+    } catch (std::exception const& ex) {
+      std::cout << "cannot write '" << options.jsonOutput << "': " << ex.what()
+                << std::endl;
+      result = EXIT_FAILURE;
+    }
+  }
+  return result;
+}
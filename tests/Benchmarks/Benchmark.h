@@ -0,0 +1,118 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_TESTS_BENCHMARKS_BENCHMARK_H
+#define ARANGODB_TESTS_BENCHMARKS_BENCHMARK_H 1
+
+#include "Basics/Common.h"
+
+#include <chrono>
+#include <functional>
+
+namespace arangodb {
+namespace benchmarks {
+
+/// @brief keeps the compiler from optimizing away a computed value
+template <typename T>
+inline void doNotOptimize(T const& value) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static_cast<void>(*reinterpret_cast<char const volatile*>(&value));
+#endif
+}
+
+/// @brief the state passed to a benchmark function. the measured part is
+/// the loop `while (state.keepRunning()) { ... }`, setup before and after
+/// the loop is not timed, setup inside the loop must be bracketed with
+/// pauseTiming() and resumeTiming()
+class State {
+ public:
+  explicit State(uint64_t iterations)
+      : _iterations(iterations), _remaining(iterations), _started(false),
+        _elapsed(0), _itemsProcessed(0) {}
+
+  bool keepRunning() {
+    if (!_started) {
+      _started = true;
+      _start = std::chrono::steady_clock::now();
+    }
+    if (_remaining == 0) {
+      _elapsed += std::chrono::steady_clock::now() - _start;
+      return false;
+    }
+    --_remaining;
+    return true;
+  }
+
+  void pauseTiming() { _elapsed += std::chrono::steady_clock::now() - _start; }
+  void resumeTiming() { _start = std::chrono::steady_clock::now(); }
+
+  /// @brief number of items (rows, keys, comparisons) one iteration handles,
+  /// used to report the throughput
+  void setItemsPerIteration(uint64_t items) { _itemsProcessed = items; }
+
+  uint64_t iterations() const { return _iterations; }
+  uint64_t itemsPerIteration() const { return _itemsProcessed; }
+  double elapsed() const {
+    return std::chrono::duration<double>(_elapsed).count();
+  }
+
+ private:
+  uint64_t const _iterations;
+  uint64_t _remaining;
+  bool _started;
+  std::chrono::steady_clock::time_point _start;
+  std::chrono::steady_clock::duration _elapsed;
+  uint64_t _itemsProcessed;
+};
+
+typedef std::function<void(State&)> BenchmarkFunction;
+
+/// @brief registers a benchmark, used by ARANGODB_BENCHMARK
+bool registerBenchmark(std::string name, BenchmarkFunction function);
+
+struct RunOptions {
+  // substring the benchmark names must contain, empty for all
+  std::string filter;
+  // minimal time one measurement takes, in seconds
+  double minTime = 0.5;
+  size_t repetitions = 3;
+  // file the results are written to as JSON, empty for none
+  std::string jsonOutput;
+  bool list = false;
+};
+
+/// @brief runs all registered benchmarks matching the options, prints the
+/// results and returns the process exit code
+int runBenchmarks(RunOptions const& options);
+
+}  // namespace benchmarks
+}  // namespace arangodb
+
+/// @brief defines and registers a benchmark function taking a State&
+#define ARANGODB_BENCHMARK(group, name)                                         \
+  static void group##_##name##_benchmark(::arangodb::benchmarks::State&);      \
+  static bool const group##_##name##_registered =                              \
+      ::arangodb::benchmarks::registerBenchmark(#group "/" #name,              \
+                                                group##_##name##_benchmark);   \
+  static void group##_##name##_benchmark(::arangodb::benchmarks::State& state)
+
+#endif
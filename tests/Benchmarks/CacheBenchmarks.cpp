@@ -0,0 +1,101 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Benchmark.h"
+
+#include "Cache/Cache.h"
+#include "Cache/CachedValue.h"
+#include "Cache/Common.h"
+#include "Cache/Finding.h"
+#include "Cache/Manager.h"
+
+using namespace arangodb;
+using namespace arangodb::benchmarks;
+using namespace arangodb::cache;
+
+namespace {
+constexpr uint64_t numKeys = 4096;
+constexpr uint64_t cacheLimit = 16 * 1024 * 1024;
+
+/// @brief a cache filled with the keys 0 to numKeys - 1, the manager does
+/// not run background tasks, so nothing is migrated while measuring
+struct FilledCache {
+  explicit FilledCache(CacheType type)
+      : manager([](std::function<void()>) -> bool { return false; }, 4 * cacheLimit),
+        cache(manager.createCache(type, false, cacheLimit)) {
+    for (uint64_t i = 0; i < numKeys; ++i) {
+      CachedValue* value = CachedValue::construct(&i, sizeof(i), &i, sizeof(i));
+      if (!cache->insert(value).ok()) {
+        delete value;
+      }
+    }
+  }
+
+  ~FilledCache() { manager.destroyCache(cache); }
+
+  Manager manager;
+  std::shared_ptr<Cache> cache;
+};
+
+void find(State& state, CacheType type, uint64_t offset) {
+  FilledCache filled(type);
+
+  state.setItemsPerIteration(::numKeys);
+  while (state.keepRunning()) {
+    uint64_t found = 0;
+    for (uint64_t i = offset; i < offset + ::numKeys; ++i) {
+      Finding f = filled.cache->find(&i, sizeof(i));
+      found += f.found() ? 1 : 0;
+    }
+    doNotOptimize(found);
+  }
+}
+}  // namespace
+
+ARANGODB_BENCHMARK(PlainCache, find_hit) {
+  ::find(state, CacheType::Plain, 0);
+}
+
+ARANGODB_BENCHMARK(PlainCache, find_miss) {
+  ::find(state, CacheType::Plain, ::numKeys);
+}
+
+ARANGODB_BENCHMARK(TransactionalCache, find_hit) {
+  ::find(state, CacheType::Transactional, 0);
+}
+
+ARANGODB_BENCHMARK(TransactionalCache, find_miss) {
+  ::find(state, CacheType::Transactional, ::numKeys);
+}
+
+ARANGODB_BENCHMARK(PlainCache, insert) {
+  FilledCache filled(CacheType::Plain);
+
+  state.setItemsPerIteration(::numKeys);
+  while (state.keepRunning()) {
+    for (uint64_t i = 0; i < ::numKeys; ++i) {
+      // replaces the existing value of the key
+      CachedValue* value = CachedValue::construct(&i, sizeof(i), &i, sizeof(i));
+      if (!filled.cache->insert(value).ok()) {
+        delete value;
+      }
+    }
+  }
+}
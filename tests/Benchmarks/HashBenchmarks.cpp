@@ -0,0 +1,110 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Benchmark.h"
+
+#include "Basics/fasthash.h"
+#include "Basics/hashes.h"
+#include "Basics/xxhash.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::benchmarks;
+
+namespace {
+constexpr size_t numKeys = 1024;
+
+// numKeys different keys of the given length, like document keys (short)
+// or string attribute values (long)
+std::vector<std::string> makeKeys(size_t length) {
+  std::vector<std::string> keys;
+  keys.reserve(numKeys);
+  for (size_t i = 0; i < numKeys; ++i) {
+    std::string key;
+    key.reserve(length);
+    for (size_t j = 0; j < length; ++j) {
+      key.push_back(static_cast<char>('a' + (i * 31 + j * 7) % 26));
+    }
+    keys.push_back(std::move(key));
+  }
+  return keys;
+}
+
+template <typename F>
+void hash(State& state, size_t length, F const& fn) {
+  auto keys = makeKeys(length);
+  state.setItemsPerIteration(keys.size());
+  while (state.keepRunning()) {
+    uint64_t result = 0;
+    for (auto const& key : keys) {
+      result ^= fn(key.data(), key.size());
+    }
+    doNotOptimize(result);
+  }
+}
+
+// the hash functions compared, for keys of 8, 32, 256 and 4096 bytes
+uint64_t fnv(char const* p, size_t length) {
+  return TRI_FnvHashPointer(p, length);
+}
+
+uint64_t crc32(char const* p, size_t length) {
+  return TRI_Crc32HashPointer(p, length);
+}
+
+uint64_t fasthash(char const* p, size_t length) {
+  return fasthash64(p, length, 0xdeadbeef);
+}
+
+uint64_t xxh64(char const* p, size_t length) {
+  return XXH64(p, length, 0xdeadbeef);
+}
+
+uint64_t xxh3(char const* p, size_t length) {
+  return TRI_Xxh3Hash64(p, length, 0xdeadbeef);
+}
+
+uint64_t xxh3Generic(char const* p, size_t length) {
+  return TRI_Xxh3Hash64_Generic(p, length, 0xdeadbeef);
+}
+
+uint64_t vpackString(char const* p, size_t length) {
+  // includes building the slice, which the hash paths get for free
+  VPackBuilder builder;
+  builder.add(VPackValuePair(p, length, VPackValueType::String));
+  return builder.slice().normalizedHash(0xdeadbeef);
+}
+}  // namespace
+
+#define HASH_BENCHMARKS(name)                                           \
+  ARANGODB_BENCHMARK(Hashes, name##_8) { ::hash(state, 8, ::name); }     \
+  ARANGODB_BENCHMARK(Hashes, name##_32) { ::hash(state, 32, ::name); }   \
+  ARANGODB_BENCHMARK(Hashes, name##_256) { ::hash(state, 256, ::name); } \
+  ARANGODB_BENCHMARK(Hashes, name##_4096) { ::hash(state, 4096, ::name); }
+
+HASH_BENCHMARKS(fnv)
+HASH_BENCHMARKS(crc32)
+HASH_BENCHMARKS(fasthash)
+HASH_BENCHMARKS(xxh64)
+HASH_BENCHMARKS(xxh3)
+HASH_BENCHMARKS(xxh3Generic)
+HASH_BENCHMARKS(vpackString)
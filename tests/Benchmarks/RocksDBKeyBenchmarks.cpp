@@ -0,0 +1,171 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Benchmark.h"
+
+#include "Random/RandomGenerator.h"
+#include "RocksDBEngine/RocksDBComparator.h"
+#include "RocksDBEngine/RocksDBFormat.h"
+#include "RocksDBEngine/RocksDBKey.h"
+#include "RocksDBEngine/RocksDBTypes.h"
+#include "VocBase/LocalDocumentId.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/StringRef.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::benchmarks;
+
+namespace {
+constexpr size_t numKeys = 1024;
+constexpr uint64_t objectId = 123456789;
+
+// keys are encoded big endian since 3.4, which is what new databases use
+void useBigEndian() {
+  rocksutils::setRocksDBKeyFormatEndianess(RocksDBEndianness::Big);
+}
+
+std::vector<std::string> randomKeys() {
+  std::vector<std::string> keys;
+  for (size_t i = 0; i < numKeys; ++i) {
+    keys.push_back(std::to_string(RandomGenerator::interval(uint64_t(UINT64_MAX))));
+  }
+  return keys;
+}
+
+/// @brief index values of a persistent index on two attributes
+VPackBuilder randomIndexValues() {
+  VPackBuilder builder;
+  builder.openArray();
+  for (size_t i = 0; i < numKeys; ++i) {
+    uint64_t value = RandomGenerator::interval(uint64_t(1000000));
+    builder.openArray();
+    builder.add(VPackValue("category" + std::to_string(value % 10)));
+    builder.add(VPackValue(value));
+    builder.close();
+  }
+  builder.close();
+  return builder;
+}
+}  // namespace
+
+ARANGODB_BENCHMARK(RocksDBKey, construct_document) {
+  ::useBigEndian();
+  RocksDBKey key;
+
+  state.setItemsPerIteration(::numKeys);
+  while (state.keepRunning()) {
+    for (uint64_t i = 0; i < ::numKeys; ++i) {
+      key.constructDocument(::objectId, LocalDocumentId(i + 1));
+      doNotOptimize(key.size());
+    }
+  }
+}
+
+ARANGODB_BENCHMARK(RocksDBKey, decode_document_id) {
+  ::useBigEndian();
+  std::vector<std::string> encoded;
+  RocksDBKey key;
+  for (uint64_t i = 0; i < ::numKeys; ++i) {
+    key.constructDocument(::objectId, LocalDocumentId(i + 1));
+    encoded.emplace_back(key.string().data(), key.size());
+  }
+
+  state.setItemsPerIteration(::numKeys);
+  while (state.keepRunning()) {
+    uint64_t result = 0;
+    for (auto const& e : encoded) {
+      result += RocksDBKey::documentId(rocksdb::Slice(e)).id();
+    }
+    doNotOptimize(result);
+  }
+}
+
+ARANGODB_BENCHMARK(RocksDBKey, construct_primary_index_value) {
+  ::useBigEndian();
+  std::vector<std::string> keys = ::randomKeys();
+  RocksDBKey key;
+
+  state.setItemsPerIteration(keys.size());
+  while (state.keepRunning()) {
+    for (auto const& k : keys) {
+      key.constructPrimaryIndexValue(::objectId, VPackStringRef(k));
+      doNotOptimize(key.size());
+    }
+  }
+}
+
+ARANGODB_BENCHMARK(RocksDBKey, construct_edge_index_value) {
+  ::useBigEndian();
+  std::vector<std::string> vertices;
+  for (auto const& k : ::randomKeys()) {
+    vertices.push_back("vertices/" + k);
+  }
+  RocksDBKey key;
+
+  state.setItemsPerIteration(vertices.size());
+  while (state.keepRunning()) {
+    uint64_t id = 1;
+    for (auto const& v : vertices) {
+      key.constructEdgeIndexValue(::objectId, VPackStringRef(v), LocalDocumentId(id++));
+      doNotOptimize(key.size());
+    }
+  }
+}
+
+ARANGODB_BENCHMARK(RocksDBKey, construct_vpack_index_value) {
+  ::useBigEndian();
+  VPackBuilder values = ::randomIndexValues();
+  RocksDBKey key;
+
+  state.setItemsPerIteration(::numKeys);
+  while (state.keepRunning()) {
+    uint64_t id = 1;
+    for (auto const& v : VPackArrayIterator(values.slice())) {
+      key.constructVPackIndexValue(::objectId, v, LocalDocumentId(id++));
+      doNotOptimize(key.size());
+    }
+  }
+}
+
+ARANGODB_BENCHMARK(RocksDBVPackComparator, compare_index_values) {
+  ::useBigEndian();
+  VPackBuilder values = ::randomIndexValues();
+  std::vector<std::string> encoded;
+  RocksDBKey key;
+  uint64_t id = 1;
+  for (auto const& v : VPackArrayIterator(values.slice())) {
+    key.constructVPackIndexValue(::objectId, v, LocalDocumentId(id++));
+    encoded.emplace_back(key.string().data(), key.size());
+  }
+  RocksDBVPackComparator comparator;
+
+  state.setItemsPerIteration(encoded.size() - 1);
+  while (state.keepRunning()) {
+    int result = 0;
+    for (size_t i = 1; i < encoded.size(); ++i) {
+      result += comparator.Compare(rocksdb::Slice(encoded[i - 1]),
+                                   rocksdb::Slice(encoded[i]));
+    }
+    doNotOptimize(result);
+  }
+}
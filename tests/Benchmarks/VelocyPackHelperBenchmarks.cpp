@@ -0,0 +1,122 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Benchmark.h"
+
+#include "Basics/VelocyPackHelper.h"
+#include "Random/RandomGenerator.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::benchmarks;
+
+namespace {
+constexpr size_t numValues = 1024;
+
+void compare(State& state, VPackBuilder const& builder, bool useUTF8) {
+  std::vector<VPackSlice> values;
+  for (auto const& value : VPackArrayIterator(builder.slice())) {
+    values.push_back(value);
+  }
+
+  state.setItemsPerIteration(values.size() - 1);
+  while (state.keepRunning()) {
+    int result = 0;
+    for (size_t i = 1; i < values.size(); ++i) {
+      result += basics::VelocyPackHelper::compare(values[i - 1], values[i], useUTF8);
+    }
+    doNotOptimize(result);
+  }
+}
+
+int64_t randomValue() {
+  return RandomGenerator::interval(int64_t(0), int64_t(1000000));
+}
+}  // namespace
+
+ARANGODB_BENCHMARK(VelocyPackHelper, compare_numbers) {
+  VPackBuilder builder;
+  builder.openArray();
+  for (size_t i = 0; i < ::numValues; ++i) {
+    // mix integer and double representations, as AQL produces both
+    if (i % 2 == 0) {
+      builder.add(VPackValue(::randomValue()));
+    } else {
+      builder.add(VPackValue(::randomValue() / 3.0));
+    }
+  }
+  builder.close();
+  ::compare(state, builder, true);
+}
+
+ARANGODB_BENCHMARK(VelocyPackHelper, compare_strings_binary) {
+  VPackBuilder builder;
+  builder.openArray();
+  for (size_t i = 0; i < ::numValues; ++i) {
+    builder.add(VPackValue("products/" + std::to_string(::randomValue())));
+  }
+  builder.close();
+  ::compare(state, builder, false);
+}
+
+ARANGODB_BENCHMARK(VelocyPackHelper, compare_strings_utf8) {
+  VPackBuilder builder;
+  builder.openArray();
+  for (size_t i = 0; i < ::numValues; ++i) {
+    builder.add(VPackValue("Stra\xc3\x9f" "e " + std::to_string(::randomValue())));
+  }
+  builder.close();
+  ::compare(state, builder, true);
+}
+
+ARANGODB_BENCHMARK(VelocyPackHelper, compare_objects) {
+  VPackBuilder builder;
+  builder.openArray();
+  for (size_t i = 0; i < ::numValues; ++i) {
+    // equal prefixes, so the comparison has to look at several attributes
+    int64_t value = ::randomValue();
+    builder.openObject();
+    builder.add("type", VPackValue("order"));
+    builder.add("customer", VPackValue(value % 10));
+    builder.add("amount", VPackValue(value));
+    builder.add("status", VPackValue(value % 2 == 0 ? "open" : "closed"));
+    builder.close();
+  }
+  builder.close();
+  ::compare(state, builder, true);
+}
+
+ARANGODB_BENCHMARK(VelocyPackHelper, compare_arrays) {
+  VPackBuilder builder;
+  builder.openArray();
+  for (size_t i = 0; i < ::numValues; ++i) {
+    int64_t value = ::randomValue();
+    builder.openArray();
+    builder.add(VPackValue(value % 3));
+    builder.add(VPackValue("x"));
+    builder.add(VPackValue(value));
+    builder.close();
+  }
+  builder.close();
+  ::compare(state, builder, true);
+}
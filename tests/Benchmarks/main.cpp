@@ -0,0 +1,93 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "ApplicationFeatures/ShellColorsFeature.h"
+#include "Basics/ArangoGlobalContext.h"
+#include "Cluster/ServerState.h"
+#include "Logger/LogAppender.h"
+#include "Logger/Logger.h"
+#include "Random/RandomGenerator.h"
+#include "RestServer/ServerIdFeature.h"
+#include "tests/Basics/icu-helper.h"
+
+#include "Benchmark.h"
+
+#include <iostream>
+
+char const* ARGV0 = "";
+
+namespace {
+void usage() {
+  std::cout << "usage: " << ARGV0 << " [options]\n"
+            << "  --filter <string>        run benchmarks whose name contains the string\n"
+            << "  --min-time <seconds>     minimal duration of one measurement (default 0.5)\n"
+            << "  --repetitions <number>   measurements per benchmark, the median is reported (default 3)\n"
+            << "  --json-output <file>     write the results as JSON\n"
+            << "  --list                   list the benchmarks and exit\n";
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  TRI_GET_ARGV(argc, argv);
+  ARGV0 = argv[0];
+
+  arangodb::benchmarks::RunOptions options;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    bool hasValue = i + 1 < argc;
+    if (arg == "--filter" && hasValue) {
+      options.filter = argv[++i];
+    } else if (arg == "--min-time" && hasValue) {
+      options.minTime = std::stod(argv[++i]);
+    } else if (arg == "--repetitions" && hasValue) {
+      options.repetitions = (std::max)(1, std::stoi(argv[++i]));
+    } else if (arg == "--json-output" && hasValue) {
+      options.jsonOutput = argv[++i];
+    } else if (arg == "--list") {
+      options.list = true;
+    } else {
+      usage();
+      return EXIT_FAILURE;
+    }
+  }
+
+  arangodb::RandomGenerator::initialize(arangodb::RandomGenerator::RandomType::MERSENNE);
+  arangodb::Logger::initialize(false);
+  arangodb::LogAppender::addAppender("-");
+
+  arangodb::ServerState::instance()->setRole(arangodb::ServerState::ROLE_SINGLE);
+  arangodb::application_features::ApplicationServer server(nullptr, nullptr);
+  arangodb::ShellColorsFeature sc(server);
+
+  arangodb::application_features::ApplicationServer::server =
+      nullptr;  // avoid "ApplicationServer initialized twice"
+  sc.prepare();
+
+  arangodb::ArangoGlobalContext ctx(1, const_cast<char**>(&ARGV0), ".");
+  ctx.exit(0);  // set "good" exit code by default
+
+  arangodb::ServerIdFeature::setId(12345);
+  IcuInitializer::setup(ARGV0);
+
+  int result = arangodb::benchmarks::runBenchmarks(options);
+
+  arangodb::Logger::shutdown();
+  return result;
+}
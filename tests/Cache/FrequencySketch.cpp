@@ -0,0 +1,75 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for arangodb::cache::FrequencySketch
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+#include "Cache/FrequencySketch.h"
+
+#include "gtest/gtest.h"
+
+#include <stdint.h>
+
+using namespace arangodb::cache;
+
+TEST(CacheFrequencySketchTest, test_estimates_follow_access_counts) {
+  FrequencySketch sketch(1024);
+  ASSERT_TRUE(sketch.memoryUsage() >= 1024 * FrequencySketch::depth);
+
+  uint32_t const hot = 0xDEADBEEF;
+  uint32_t const cold = 0x12345678;
+
+  ASSERT_TRUE(0 == sketch.estimate(hot));
+  ASSERT_TRUE(0 == sketch.estimate(cold));
+
+  for (size_t i = 0; i < 10; i++) {
+    sketch.insertRecord(hot);
+  }
+  sketch.insertRecord(cold);
+
+  ASSERT_TRUE(sketch.estimate(hot) > 0);
+  ASSERT_TRUE(sketch.estimate(hot) >= sketch.estimate(cold));
+}
+
+TEST(CacheFrequencySketchTest, test_counters_saturate_and_age) {
+  FrequencySketch sketch(1024);
+  uint32_t const hash = 42;
+
+  for (size_t i = 0; i < 100; i++) {
+    sketch.insertRecord(hash);
+  }
+  ASSERT_TRUE(sketch.estimate(hash) <= FrequencySketch::maxCount);
+
+  uint8_t before = sketch.estimate(hash);
+  sketch.age();
+  ASSERT_TRUE(before / 2 == sketch.estimate(hash));
+}
+
+TEST(CacheFrequencySketchTest, test_width_is_normalized) {
+  ASSERT_EQ(4096, FrequencySketch::normalizedWidth(2560));
+  ASSERT_EQ(1024, FrequencySketch::normalizedWidth(1024));
+  ASSERT_EQ(65536, FrequencySketch::normalizedWidth(1 << 20));
+
+  FrequencySketch sketch(2560);
+  ASSERT_EQ(4096, sketch.width());
+  ASSERT_TRUE(sketch.memoryUsage() >= 4096 * FrequencySketch::depth);
+}
@@ -169,9 +169,11 @@ TEST(CachePlainBucketTest, verify_eviction_works_correctly) {
   ASSERT_TRUE(nullptr == res);
   ASSERT_TRUE(!bucket->isFull());
 
-  // check that we still find the right candidate if not full
-  candidate = bucket->evictionCandidate();
+  // check that we still find the right candidate if not full, and get its hash
+  uint32_t candidateHash = 0;
+  candidate = bucket->evictionCandidate(false, &candidateHash);
   ASSERT_TRUE(candidate == ptrs[1]);
+  ASSERT_EQ(hashes[1], candidateHash);
   bucket->evict(candidate, true);
   res = bucket->find(hashes[1], ptrs[1]->key(), ptrs[1]->keySize());
   ASSERT_TRUE(nullptr == res);
@@ -112,6 +112,36 @@ TEST(CachePlainCacheTest, check_that_insertion_works_as_expected) {
   manager.destroyCache(cache);
 }
 
+TEST(CachePlainCacheTest, test_that_hot_keys_are_reported) {
+  uint64_t cacheLimit = 128 * 1024;
+  auto postFn = [](std::function<void()>) -> bool { return false; };
+  Manager manager(postFn, 4 * cacheLimit);
+  auto cache = manager.createCache(CacheType::Plain, false, cacheLimit);
+
+  ASSERT_TRUE(cache->hotKeys(16).empty());
+
+  for (uint64_t i = 0; i < 1024; i++) {
+    CachedValue* value =
+        CachedValue::construct(&i, sizeof(uint64_t), &i, sizeof(uint64_t));
+    TRI_ASSERT(value != nullptr);
+    auto status = cache->insert(value);
+    if (status.fail()) {
+      delete value;
+    }
+  }
+
+  auto keys = cache->hotKeys(16);
+  ASSERT_TRUE(!keys.empty());
+  ASSERT_TRUE(keys.size() <= 16);
+  for (auto const& key : keys) {
+    ASSERT_TRUE(sizeof(uint64_t) == key.size());
+    auto f = cache->find(key.data(), static_cast<uint32_t>(key.size()));
+    ASSERT_TRUE(f.found());
+  }
+
+  manager.destroyCache(cache);
+}
+
 TEST(CachePlainCacheTest, test_that_removal_works_as_expected) {
   uint64_t cacheLimit = 128 * 1024;
   auto postFn = [](std::function<void()>) -> bool { return false; };
@@ -373,3 +403,32 @@ TEST(CachePlainCacheTest, test_hit_rate_statistics_reporting) {
   manager.destroyCache(cacheMiss);
   manager.destroyCache(cacheMixed);
 }
+
+TEST(CachePlainCacheTest, test_marginal_utility_reporting) {
+  uint64_t cacheLimit = 128 * 1024;
+  auto postFn = [](std::function<void()>) -> bool { return false; };
+  Manager manager(postFn, 4 * cacheLimit);
+  auto cache = manager.createCache(CacheType::Plain, false, cacheLimit);
+
+  ASSERT_TRUE(0.0 == cache->marginalUtility());
+
+  // cycle over more keys than fit, so that evicted keys are asked for again
+  for (uint64_t round = 0; round < 4; round++) {
+    for (uint64_t i = 0; i < 8192; i++) {
+      auto f = cache->find(&i, sizeof(uint64_t));
+      if (f.found()) {
+        continue;
+      }
+      CachedValue* value =
+          CachedValue::construct(&i, sizeof(uint64_t), &i, sizeof(uint64_t));
+      TRI_ASSERT(value != nullptr);
+      auto status = cache->insert(value);
+      if (status.fail()) {
+        delete value;
+      }
+    }
+  }
+  ASSERT_TRUE(cache->marginalUtility() > 0.0);
+
+  manager.destroyCache(cache);
+}
@@ -54,6 +54,31 @@ TEST(CacheTableTest, test_basic_constructor_behavior) {
   }
 }
 
+TEST(CacheTableTest, test_huge_page_backed_tables) {
+  for (uint32_t i = Table::minLogSize; i <= 16; i++) {
+    auto table = std::make_shared<Table>(i, true);
+    ASSERT_TRUE(table.get() != nullptr);
+    ASSERT_TRUE(table->memoryUsage() == Table::allocationSize(i, true));
+    ASSERT_TRUE(table->size() == (static_cast<uint64_t>(1) << i));
+    if ((BUCKET_SIZE << i) < Table::hugePageSize) {
+      // small tables are not worth a huge page
+      ASSERT_TRUE(Table::allocationSize(i, true) == Table::allocationSize(i));
+    } else {
+      ASSERT_TRUE(Table::allocationSize(i, true) <= Table::allocationSize(i));
+    }
+
+    table->enable();
+    for (uint64_t j = 0; j < table->size(); j++) {
+      uint32_t hash = static_cast<uint32_t>(j << (32 - i));
+      auto pair = table->fetchAndLockBucket(hash, -1);
+      auto bucket = reinterpret_cast<PlainBucket*>(pair.first);
+      ASSERT_TRUE(bucket != nullptr);
+      ASSERT_TRUE(bucket == table->primaryBucket(j));
+      bucket->unlock();
+    }
+  }
+}
+
 TEST(CacheTableTest, test_basic_bucket_fetching_behavior) {
   auto table = std::make_shared<Table>(Table::minLogSize);
   ASSERT_TRUE(table.get() != nullptr);
@@ -0,0 +1,91 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+#include "Basics/HybridLogicalClock.h"
+#include "Cluster/FollowerReads.h"
+#include "VocBase/ticks.h"
+
+#include "gtest/gtest.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+class FollowerReadsTest : public ::testing::Test {
+ protected:
+  FollowerReadsTest() { FollowerReads::clear(); }
+  ~FollowerReadsTest() { FollowerReads::clear(); }
+};
+
+TEST_F(FollowerReadsTest, test_no_followers) {
+  EXPECT_TRUE(FollowerReads::selectFollower("s1", {}, 0).empty());
+  EXPECT_TRUE(FollowerReads::selectFollower("s1", {"PRMR-1"}, 0).empty());
+}
+
+TEST_F(FollowerReadsTest, test_leader_is_never_selected) {
+  std::vector<ServerID> const servers = {"PRMR-1", "PRMR-2", "PRMR-3"};
+  std::unordered_set<ServerID> selected;
+  for (int i = 0; i < 10; ++i) {
+    ServerID follower = FollowerReads::selectFollower("s1", servers, 0);
+    EXPECT_NE("PRMR-1", follower);
+    EXPECT_FALSE(follower.empty());
+    selected.emplace(follower);
+  }
+  // reads are spread over all followers
+  EXPECT_EQ(2, selected.size());
+}
+
+TEST_F(FollowerReadsTest, test_lagging_followers_are_skipped) {
+  std::vector<ServerID> const servers = {"PRMR-1", "PRMR-2", "PRMR-3"};
+  FollowerReads::reportApplied("s1", "PRMR-2", 100);
+  FollowerReads::reportApplied("s1", "PRMR-3", 200);
+
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ("PRMR-3", FollowerReads::selectFollower("s1", servers, 150));
+  }
+  // nobody is known to have caught up, the read goes to the leader
+  EXPECT_TRUE(FollowerReads::selectFollower("s1", servers, 300).empty());
+  // followers without reports are tried, as are other shards
+  EXPECT_FALSE(FollowerReads::selectFollower("s2", servers, 300).empty());
+
+  // older reports do not move the time stamp back
+  FollowerReads::reportApplied("s1", "PRMR-3", 50);
+  EXPECT_EQ("PRMR-3", FollowerReads::selectFollower("s1", servers, 150));
+}
+
+TEST_F(FollowerReadsTest, test_lag) {
+  uint64_t now = TRI_HybridLogicalClock();
+  uint64_t behind = basics::HybridLogicalClock::assembleTimeStamp(
+      basics::HybridLogicalClock::extractTime(now) - 5000, 0);
+  FollowerReads::reportApplied("s1", "PRMR-2", behind);
+  FollowerReads::reportApplied("s2", "PRMR-2", now);
+  FollowerReads::reportApplied("s1", "PRMR-3", now);
+
+  VPackBuilder builder;
+  builder.openObject();
+  FollowerReads::toVelocyPack(builder);
+  builder.close();
+
+  // the largest lag over all shards
+  EXPECT_GE(builder.slice().get("PRMR-2").getNumber<double>(), 5.0);
+  EXPECT_LT(builder.slice().get("PRMR-3").getNumber<double>(), 1.0);
+}
@@ -0,0 +1,318 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+#include "Basics/Exceptions.h"
+#include "Cluster/InsertCoalescer.h"
+#include "Futures/Utilities.h"
+
+#include "gtest/gtest.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include <atomic>
+#include <thread>
+
+using namespace arangodb;
+
+namespace {
+VPackBuilder document(size_t i) {
+  VPackBuilder b;
+  b.openObject();
+  b.add("_key", VPackValue(std::to_string(i)));
+  b.close();
+  return b;
+}
+
+InsertCoalescer::Result answer(rest::ResponseCode code, std::string const& json) {
+  InsertCoalescer::Result result;
+  result.responseCode = code;
+  result.body = VPackParser::fromJson(json);
+  return result;
+}
+
+/// records the batches and timers of a coalescer, the test decides when
+/// timers fire and requests are answered
+struct Recorder {
+  struct Request {
+    ShardID shard;
+    std::string url;
+    VPackBuilder body;
+    futures::Promise<InsertCoalescer::Result> promise;
+  };
+
+  std::vector<Request> requests;
+  std::vector<std::function<void(bool)>> timers;
+
+  std::unique_ptr<InsertCoalescer> make(uint64_t maxBatchSize) {
+    return std::make_unique<InsertCoalescer>(
+        100, maxBatchSize,
+        [this](ShardID const& shard, std::string const& url, VPackSlice body) {
+          requests.emplace_back();
+          Request& r = requests.back();
+          r.shard = shard;
+          r.url = url;
+          r.body.add(body);
+          return r.promise.getFuture();
+        },
+        [this](std::chrono::microseconds delay, std::function<void(bool)> fn) {
+          EXPECT_EQ(100, delay.count());
+          timers.emplace_back(std::move(fn));
+          return Scheduler::WorkHandle();
+        });
+  }
+};
+}  // namespace
+
+TEST(InsertCoalescerTest, test_single_insert) {
+  Recorder recorder;
+  auto coalescer = recorder.make(1000);
+
+  auto f = coalescer->insert("s1", "/url1", document(1).slice());
+  ASSERT_EQ(1, recorder.timers.size());
+  EXPECT_TRUE(recorder.requests.empty());
+  EXPECT_FALSE(f.isReady());
+
+  recorder.timers[0](false);
+  ASSERT_EQ(1, recorder.requests.size());
+  EXPECT_EQ("s1", recorder.requests[0].shard);
+  EXPECT_EQ("/url1", recorder.requests[0].url);
+  // a batch of one is sent as a single document
+  ASSERT_TRUE(recorder.requests[0].body.slice().isObject());
+  EXPECT_EQ("1", recorder.requests[0].body.slice().get("_key").copyString());
+  EXPECT_FALSE(f.isReady());
+
+  recorder.requests[0].promise.setValue(
+      answer(rest::ResponseCode::ACCEPTED, "{\"_key\":\"1\"}"));
+  ASSERT_TRUE(f.isReady());
+  InsertCoalescer::Result r = std::move(f).get();
+  EXPECT_EQ(TRI_ERROR_NO_ERROR, r.commError);
+  EXPECT_EQ(rest::ResponseCode::ACCEPTED, r.responseCode);
+  ASSERT_NE(nullptr, r.body);
+  EXPECT_EQ("1", r.body->slice().get("_key").copyString());
+}
+
+TEST(InsertCoalescerTest, test_batch) {
+  Recorder recorder;
+  auto coalescer = recorder.make(1000);
+
+  std::vector<futures::Future<InsertCoalescer::Result>> futures;
+  for (size_t i = 0; i < 3; ++i) {
+    futures.emplace_back(coalescer->insert("s1", "/url1", document(i).slice()));
+  }
+  // other options or another shard go into another batch
+  futures.emplace_back(coalescer->insert("s1", "/url2", document(3).slice()));
+  ASSERT_EQ(2, recorder.timers.size());
+
+  recorder.timers[0](false);
+  ASSERT_EQ(1, recorder.requests.size());
+  VPackSlice body = recorder.requests[0].body.slice();
+  ASSERT_TRUE(body.isArray());
+  ASSERT_EQ(3, body.length());
+  for (size_t i = 0; i < 3; ++i) {
+    EXPECT_EQ(std::to_string(i), body.at(i).get("_key").copyString());
+  }
+
+  // documents that arrive now open a new batch
+  futures.emplace_back(coalescer->insert("s1", "/url1", document(4).slice()));
+  EXPECT_EQ(3, recorder.timers.size());
+
+  recorder.requests[0].promise.setValue(answer(
+      rest::ResponseCode::CREATED,
+      "[{\"_key\":\"0\"},{\"error\":true,\"errorNum\":1210},{\"_key\":\"2\"}]"));
+  for (size_t i = 0; i < 3; ++i) {
+    ASSERT_TRUE(futures[i].isReady());
+  }
+  EXPECT_FALSE(futures[3].isReady());
+  EXPECT_FALSE(futures[4].isReady());
+
+  InsertCoalescer::Result r0 = std::move(futures[0]).get();
+  EXPECT_EQ(rest::ResponseCode::CREATED, r0.responseCode);
+  EXPECT_EQ("0", r0.body->slice().get("_key").copyString());
+  InsertCoalescer::Result r1 = std::move(futures[1]).get();
+  EXPECT_EQ(rest::ResponseCode::CONFLICT, r1.responseCode);
+  EXPECT_TRUE(r1.body->slice().get("error").getBool());
+  InsertCoalescer::Result r2 = std::move(futures[2]).get();
+  EXPECT_EQ(rest::ResponseCode::CREATED, r2.responseCode);
+  EXPECT_EQ("2", r2.body->slice().get("_key").copyString());
+
+  recorder.timers[1](false);
+  recorder.timers[2](false);
+  ASSERT_EQ(3, recorder.requests.size());
+  EXPECT_EQ("/url2", recorder.requests[1].url);
+  EXPECT_EQ("/url1", recorder.requests[2].url);
+  EXPECT_EQ("4", recorder.requests[2].body.slice().get("_key").copyString());
+}
+
+TEST(InsertCoalescerTest, test_full_batch_is_sent_right_away) {
+  Recorder recorder;
+  auto coalescer = recorder.make(2);
+
+  auto f0 = coalescer->insert("s1", "/url1", document(0).slice());
+  auto f1 = coalescer->insert("s1", "/url1", document(1).slice());
+  ASSERT_EQ(1, recorder.requests.size());
+  EXPECT_EQ(2, recorder.requests[0].body.slice().length());
+  auto f2 = coalescer->insert("s1", "/url1", document(2).slice());
+  ASSERT_EQ(2, recorder.timers.size());
+
+  // the timer of the full batch does nothing anymore
+  recorder.timers[0](false);
+  ASSERT_EQ(1, recorder.requests.size());
+  recorder.timers[1](false);
+  ASSERT_EQ(2, recorder.requests.size());
+  EXPECT_TRUE(recorder.requests[1].body.slice().isObject());
+
+  recorder.requests[0].promise.setValue(
+      answer(rest::ResponseCode::CREATED, "[{\"_key\":\"0\"},{\"_key\":\"1\"}]"));
+  recorder.requests[1].promise.setValue(
+      answer(rest::ResponseCode::CREATED, "{\"_key\":\"2\"}"));
+  EXPECT_EQ("0", std::move(f0).get().body->slice().get("_key").copyString());
+  EXPECT_EQ("1", std::move(f1).get().body->slice().get("_key").copyString());
+  EXPECT_EQ("2", std::move(f2).get().body->slice().get("_key").copyString());
+}
+
+TEST(InsertCoalescerTest, test_request_failed_as_a_whole) {
+  Recorder recorder;
+  auto coalescer = recorder.make(1000);
+
+  auto f0 = coalescer->insert("s1", "/url1", document(0).slice());
+  auto f1 = coalescer->insert("s1", "/url1", document(1).slice());
+  recorder.timers[0](false);
+  recorder.requests[0].promise.setValue(
+      answer(rest::ResponseCode::NOT_FOUND, "{\"error\":true,\"errorNum\":1203}"));
+
+  InsertCoalescer::Result r0 = std::move(f0).get();
+  InsertCoalescer::Result r1 = std::move(f1).get();
+  EXPECT_EQ(rest::ResponseCode::NOT_FOUND, r0.responseCode);
+  EXPECT_EQ(rest::ResponseCode::NOT_FOUND, r1.responseCode);
+  // each caller has its own copy
+  ASSERT_NE(r0.body, r1.body);
+  EXPECT_EQ(1203, r0.body->slice().get("errorNum").getNumber<int>());
+  EXPECT_EQ(1203, r1.body->slice().get("errorNum").getNumber<int>());
+}
+
+TEST(InsertCoalescerTest, test_errors) {
+  Recorder recorder;
+  auto coalescer = recorder.make(1000);
+
+  // communication error
+  auto f0 = coalescer->insert("s1", "/url1", document(0).slice());
+  auto f1 = coalescer->insert("s1", "/url1", document(1).slice());
+  recorder.timers[0](false);
+  InsertCoalescer::Result error;
+  error.commError = TRI_ERROR_CLUSTER_TIMEOUT;
+  recorder.requests[0].promise.setValue(std::move(error));
+  EXPECT_EQ(TRI_ERROR_CLUSTER_TIMEOUT, std::move(f0).get().commError);
+  EXPECT_EQ(TRI_ERROR_CLUSTER_TIMEOUT, std::move(f1).get().commError);
+
+  // exception in the continuation of the request
+  auto f2 = coalescer->insert("s1", "/url1", document(2).slice());
+  recorder.timers[1](false);
+  recorder.requests[1].promise.setException(std::runtime_error("failed"));
+  EXPECT_EQ(TRI_ERROR_INTERNAL, std::move(f2).get().commError);
+
+  // timer canceled on shutdown
+  auto f3 = coalescer->insert("s1", "/url1", document(3).slice());
+  recorder.timers[2](true);
+  EXPECT_EQ(2, recorder.requests.size());
+  EXPECT_EQ(TRI_ERROR_SHUTTING_DOWN, std::move(f3).get().commError);
+}
+
+TEST(InsertCoalescerTest, test_send_throws) {
+  std::vector<std::function<void(bool)>> timers;
+  auto coalescer = std::make_unique<InsertCoalescer>(
+      100, 1000,
+      [](ShardID const&, std::string const&, VPackSlice) -> futures::Future<InsertCoalescer::Result> {
+        THROW_ARANGO_EXCEPTION(TRI_ERROR_SHUTTING_DOWN);
+      },
+      [&timers](std::chrono::microseconds, std::function<void(bool)> fn) {
+        timers.emplace_back(std::move(fn));
+        return Scheduler::WorkHandle();
+      });
+
+  auto f = coalescer->insert("s1", "/url1", document(0).slice());
+  timers[0](false);
+  ASSERT_TRUE(f.isReady());
+  EXPECT_EQ(TRI_ERROR_SHUTTING_DOWN, std::move(f).get().commError);
+}
+
+TEST(InsertCoalescerTest, test_concurrent_inserts) {
+  // answers right away with the keys of the documents, timers fire on
+  // their own threads
+  std::atomic<size_t> requests(0);
+  std::mutex timersMutex;
+  std::vector<std::thread> timers;
+  auto coalescer = std::make_unique<InsertCoalescer>(
+      100, 7,
+      [&requests](ShardID const&, std::string const&, VPackSlice body) {
+        ++requests;
+        InsertCoalescer::Result result;
+        result.responseCode = rest::ResponseCode::CREATED;
+        result.body = std::make_shared<VPackBuilder>();
+        if (body.isArray()) {
+          result.body->add(body);
+        } else {
+          result.body->openArray();
+          result.body->add(body);
+          result.body->close();
+        }
+        return futures::makeFuture(std::move(result));
+      },
+      [&timersMutex, &timers](std::chrono::microseconds, std::function<void(bool)> fn) {
+        std::lock_guard<std::mutex> guard(timersMutex);
+        timers.emplace_back([fn]() { fn(false); });
+        return Scheduler::WorkHandle();
+      });
+
+  size_t const numThreads = 4;
+  size_t const numInserts = 500;
+  std::atomic<size_t> failures(0);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < numThreads; ++t) {
+    threads.emplace_back([&, t]() {
+      for (size_t i = 0; i < numInserts; ++i) {
+        size_t const n = t * numInserts + i;
+        auto r = coalescer->insert("s1", "/url1", document(n).slice()).get();
+        VPackSlice body = r.body->slice();
+        if (body.isArray()) {
+          // a batch of one is answered as an array here
+          body = body.at(0);
+        }
+        if (r.commError != TRI_ERROR_NO_ERROR ||
+            body.get("_key").copyString() != std::to_string(n)) {
+          ++failures;
+        }
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  {
+    std::lock_guard<std::mutex> guard(timersMutex);
+    for (auto& t : timers) {
+      t.join();
+    }
+  }
+  EXPECT_EQ(0, failures.load());
+  EXPECT_LE(numThreads * numInserts / 7, requests.load());
+}
@@ -0,0 +1,138 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+#include "Basics/Exceptions.h"
+#include "Cluster/ReplicationPipeline.h"
+
+#include "gtest/gtest.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace arangodb;
+
+namespace {
+VPackBuilder document(size_t i) {
+  VPackBuilder b;
+  b.openObject();
+  b.add("_key", VPackValue(std::to_string(i)));
+  b.close();
+  return b;
+}
+}  // namespace
+
+TEST(ReplicationPipelineTest, test_single_operation) {
+  ReplicationPipeline pipeline;
+  size_t calls = 0;
+  auto outcome = pipeline.replicate("stream", document(1).slice(),
+                                    [&calls](VPackSlice documents,
+                                             ReplicationPipeline::Outcome& o) {
+                                      ++calls;
+                                      ASSERT_TRUE(documents.isArray());
+                                      ASSERT_EQ(1, documents.length());
+                                      EXPECT_EQ("1", documents.at(0).get("_key").copyString());
+                                      o.applied = {true, false};
+                                    });
+  EXPECT_EQ(1, calls);
+  EXPECT_EQ(TRI_ERROR_NO_ERROR, outcome.errorCode);
+  EXPECT_EQ((std::vector<bool>{true, false}), outcome.applied);
+  EXPECT_FALSE(outcome.refused);
+}
+
+TEST(ReplicationPipelineTest, test_send_errors) {
+  ReplicationPipeline pipeline;
+  auto outcome = pipeline.replicate("stream", document(1).slice(),
+                                    [](VPackSlice, ReplicationPipeline::Outcome&) {
+                                      THROW_ARANGO_EXCEPTION(TRI_ERROR_SHUTTING_DOWN);
+                                    });
+  EXPECT_EQ(TRI_ERROR_SHUTTING_DOWN, outcome.errorCode);
+
+  // the stream is usable afterwards
+  outcome = pipeline.replicate("stream", document(2).slice(),
+                               [](VPackSlice, ReplicationPipeline::Outcome& o) {
+                                 o.applied = {true};
+                               });
+  EXPECT_EQ(TRI_ERROR_NO_ERROR, outcome.errorCode);
+  EXPECT_EQ((std::vector<bool>{true}), outcome.applied);
+}
+
+TEST(ReplicationPipelineTest, test_concurrent_operations_are_batched) {
+  ReplicationPipeline pipeline;
+  size_t const n = 16;
+
+  std::atomic<size_t> started{0};
+  std::atomic<size_t> inFlight{0};
+  std::atomic<size_t> maxInFlight{0};
+  std::atomic<size_t> requests{0};
+  std::atomic<size_t> sent{0};
+
+  auto send = [&](VPackSlice documents, ReplicationPipeline::Outcome& o) {
+    size_t current = ++inFlight;
+    if (current > maxInFlight) {
+      maxInFlight = current;
+    }
+    if (requests++ == 0) {
+      // hold back the first request so that the others queue up
+      while (started < n) {
+        std::this_thread::yield();
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+    sent += documents.length();
+    o.applied = {documents.length() > 0};
+    --inFlight;
+  };
+
+  std::vector<std::thread> threads;
+  std::atomic<size_t> applied{0};
+  // the first operation is sent before the others start
+  threads.emplace_back([&]() {
+    ++started;
+    if (pipeline.replicate("stream", document(0).slice(), send).applied[0]) {
+      ++applied;
+    }
+  });
+  while (requests == 0) {
+    std::this_thread::yield();
+  }
+  for (size_t i = 1; i < n; ++i) {
+    threads.emplace_back([&, i]() {
+      ++started;
+      if (pipeline.replicate("stream", document(i).slice(), send).applied[0]) {
+        ++applied;
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  EXPECT_EQ(n, sent.load());
+  EXPECT_EQ(n, applied.load());
+  // one request in flight, all operations queued behind it are
+  // acknowledged by a single request
+  EXPECT_EQ(1, maxInFlight.load());
+  EXPECT_LT(requests.load(), n);
+}
@@ -0,0 +1,348 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+#include "Export/ArrowWriter.h"
+
+#include "gtest/gtest.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Parser.h>
+#include <velocypack/Slice.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include <cstring>
+
+using namespace arangodb;
+
+namespace {
+
+// a minimal reader for the Arrow IPC file format, written against the
+// specification (File.fbs, Message.fbs, Schema.fbs) independently of the
+// writer, so that the tests read the files back like any Arrow library would
+class ArrowFile {
+ public:
+  struct Field {
+    std::string name;
+    uint8_t typeId;
+    int32_t bitWidth;
+    int16_t precision;
+  };
+
+  struct Column {
+    int64_t length;
+    int64_t nulls;
+    // validity, values and (for utf8) data, an empty validity buffer means
+    // that all values are valid
+    std::vector<std::string> buffers;
+
+    bool valid(size_t row) const {
+      return buffers[0].empty() || (buffers[0][row / 8] & (1 << (row % 8))) != 0;
+    }
+    int64_t int64(size_t row) const { return read<int64_t>(buffers[1], 8 * row); }
+    double float64(size_t row) const { return read<double>(buffers[1], 8 * row); }
+    bool boolean(size_t row) const {
+      return (buffers[1][row / 8] & (1 << (row % 8))) != 0;
+    }
+    std::string utf8(size_t row) const {
+      int32_t begin = read<int32_t>(buffers[1], 4 * row);
+      int32_t end = read<int32_t>(buffers[1], 4 * (row + 1));
+      return buffers[2].substr(begin, end - begin);
+    }
+  };
+
+  struct Batch {
+    int64_t length;
+    std::vector<Column> columns;
+  };
+
+  explicit ArrowFile(std::string data) : _data(std::move(data)) {}
+
+  template <typename T>
+  static T read(std::string const& data, size_t at) {
+    EXPECT_LE(at + sizeof(T), data.size());
+    T value;
+    memcpy(&value, data.data() + at, sizeof(T));
+    return value;
+  }
+
+  std::vector<Field> fields;
+  std::vector<Batch> batches;
+
+  void parse() {
+    std::string const magic("ARROW1", 6);
+    ASSERT_GE(_data.size(), 8 + 6 + 4);
+    ASSERT_EQ(magic, _data.substr(0, 6));
+    ASSERT_EQ(magic, _data.substr(_data.size() - 6));
+
+    int32_t footerLength = read<int32_t>(_data, _data.size() - 10);
+    ASSERT_EQ(0, footerLength % 8);
+    size_t footerStart = _data.size() - 10 - footerLength;
+    std::string const footerBuffer = _data.substr(footerStart, footerLength);
+    Flatbuffer footer(footerBuffer);
+    size_t root = footer.root();
+    EXPECT_EQ(4, footer.scalar<int16_t>(root, 0, 0));  // V5
+
+    readSchema(footer, footer.offset(root, 1));
+
+    // the schema message at the start of the file
+    size_t position = 8;
+    ASSERT_EQ(0xFFFFFFFFU, read<uint32_t>(_data, position));
+    int32_t length = read<int32_t>(_data, position + 4);
+    ASSERT_EQ(0, length % 8);
+    std::string const schemaBuffer = _data.substr(position + 8, length);
+    Flatbuffer schema(schemaBuffer);
+    size_t message = schema.root();
+    EXPECT_EQ(1, schema.scalar<uint8_t>(message, 1, 0));  // Schema
+    std::vector<Field> footerFields = std::move(fields);
+    readSchema(schema, schema.offset(message, 2));
+    ASSERT_EQ(footerFields.size(), fields.size());
+    for (size_t i = 0; i < fields.size(); ++i) {
+      EXPECT_EQ(footerFields[i].name, fields[i].name);
+      EXPECT_EQ(footerFields[i].typeId, fields[i].typeId);
+    }
+
+    size_t blocks = footer.offset(root, 3);
+    uint32_t numBlocks = footer.read<uint32_t>(blocks);
+    for (uint32_t i = 0; i < numBlocks; ++i) {
+      size_t block = blocks + 4 + 24 * i;
+      readBatch(static_cast<size_t>(footer.read<int64_t>(block)),
+                footer.read<int32_t>(block + 8),
+                static_cast<size_t>(footer.read<int64_t>(block + 16)));
+    }
+
+    // the end of stream marker right before the footer
+    ASSERT_EQ(0xFFFFFFFFU, read<uint32_t>(_data, footerStart - 8));
+    ASSERT_EQ(0, read<int32_t>(_data, footerStart - 4));
+  }
+
+ private:
+  class Flatbuffer {
+   public:
+    explicit Flatbuffer(std::string const& buffer) : _buffer(buffer) {}
+
+    template <typename T>
+    T read(size_t at) const {
+      return ArrowFile::read<T>(_buffer, at);
+    }
+
+    size_t root() const { return read<uint32_t>(0); }
+
+    // position of the given field of a table, 0 if it is absent
+    size_t field(size_t table, uint16_t id) const {
+      size_t vtable = table - read<int32_t>(table);
+      uint16_t vtableSize = read<uint16_t>(vtable);
+      if (4 + 2 * id >= vtableSize) {
+        return 0;
+      }
+      uint16_t offset = read<uint16_t>(vtable + 4 + 2 * id);
+      return offset == 0 ? 0 : table + offset;
+    }
+
+    template <typename T>
+    T scalar(size_t table, uint16_t id, T defaultValue) const {
+      size_t at = field(table, id);
+      return at == 0 ? defaultValue : read<T>(at);
+    }
+
+    size_t offset(size_t table, uint16_t id) const {
+      size_t at = field(table, id);
+      EXPECT_NE(0, at);
+      return at + read<uint32_t>(at);
+    }
+
+    std::string string(size_t at) const {
+      return _buffer.substr(at + 4, read<uint32_t>(at));
+    }
+
+   private:
+    std::string const& _buffer;
+  };
+
+  void readSchema(Flatbuffer const& fb, size_t schema) {
+    size_t vector = fb.offset(schema, 1);
+    uint32_t n = fb.read<uint32_t>(vector);
+    for (uint32_t i = 0; i < n; ++i) {
+      size_t at = vector + 4 + 4 * i;
+      size_t field = at + fb.read<uint32_t>(at);
+      Field f;
+      f.name = fb.string(fb.offset(field, 0));
+      EXPECT_EQ(1, fb.scalar<uint8_t>(field, 1, 0));  // nullable
+      f.typeId = fb.scalar<uint8_t>(field, 2, 0);
+      size_t type = fb.offset(field, 3);
+      f.bitWidth = fb.scalar<int32_t>(type, 0, 0);
+      f.precision = f.typeId == 3 ? fb.scalar<int16_t>(type, 0, 0) : 0;
+      if (f.typeId == 2) {
+        EXPECT_EQ(1, fb.scalar<uint8_t>(type, 1, 0));  // signed
+      }
+      size_t children = fb.offset(field, 5);
+      EXPECT_EQ(0, fb.read<uint32_t>(children));
+      fields.push_back(f);
+    }
+  }
+
+  void readBatch(size_t offset, int32_t metaDataLength, size_t bodyLength) {
+    ASSERT_EQ(0, offset % 8);
+    ASSERT_EQ(0xFFFFFFFFU, read<uint32_t>(_data, offset));
+    int32_t length = read<int32_t>(_data, offset + 4);
+    ASSERT_EQ(metaDataLength, length + 8);
+    std::string const buffer = _data.substr(offset + 8, length);
+    Flatbuffer fb(buffer);
+    size_t message = fb.root();
+    EXPECT_EQ(3, fb.scalar<uint8_t>(message, 1, 0));  // RecordBatch
+    EXPECT_EQ(static_cast<int64_t>(bodyLength), fb.scalar<int64_t>(message, 3, 0));
+    size_t body = offset + metaDataLength;
+    ASSERT_LE(body + bodyLength, _data.size());
+
+    size_t recordBatch = fb.offset(message, 2);
+    Batch batch;
+    batch.length = fb.scalar<int64_t>(recordBatch, 0, 0);
+    size_t nodes = fb.offset(recordBatch, 1);
+    size_t buffers = fb.offset(recordBatch, 2);
+    ASSERT_EQ(fields.size(), fb.read<uint32_t>(nodes));
+
+    size_t nextBuffer = 0;
+    uint32_t numBuffers = fb.read<uint32_t>(buffers);
+    for (size_t i = 0; i < fields.size(); ++i) {
+      Column column;
+      column.length = fb.read<int64_t>(nodes + 4 + 16 * i);
+      column.nulls = fb.read<int64_t>(nodes + 4 + 16 * i + 8);
+      EXPECT_EQ(batch.length, column.length);
+      size_t count = fields[i].typeId == 5 ? 3 : 2;
+      for (size_t b = 0; b < count; ++b, ++nextBuffer) {
+        ASSERT_LT(nextBuffer, numBuffers);
+        int64_t bufferOffset = fb.read<int64_t>(buffers + 4 + 16 * nextBuffer);
+        int64_t bufferLength = fb.read<int64_t>(buffers + 4 + 16 * nextBuffer + 8);
+        EXPECT_EQ(0, bufferOffset % 8);
+        ASSERT_LE(static_cast<size_t>(bufferOffset + bufferLength), bodyLength);
+        column.buffers.push_back(_data.substr(body + bufferOffset, bufferLength));
+      }
+      batch.columns.push_back(std::move(column));
+    }
+    EXPECT_EQ(numBuffers, nextBuffer);
+    batches.push_back(std::move(batch));
+  }
+
+  std::string const _data;
+};
+
+}  // namespace
+
+TEST(ArrowWriterTest, test_parse_schema) {
+  std::vector<ArrowWriter::Field> fields;
+  EXPECT_EQ("", ArrowWriter::parseSchema("a:bool, b : INT64,c:float64,d:string", fields));
+  ASSERT_EQ(4, fields.size());
+  EXPECT_EQ("b", fields[1].name);
+  EXPECT_EQ(ArrowWriter::Type::Bool, fields[0].type);
+  EXPECT_EQ(ArrowWriter::Type::Int64, fields[1].type);
+  EXPECT_EQ(ArrowWriter::Type::Double, fields[2].type);
+  EXPECT_EQ(ArrowWriter::Type::Utf8, fields[3].type);
+
+  EXPECT_NE("", ArrowWriter::parseSchema("a", fields));
+  EXPECT_NE("", ArrowWriter::parseSchema("a:date", fields));
+  EXPECT_NE("", ArrowWriter::parseSchema(":int64", fields));
+}
+
+TEST(ArrowWriterTest, test_read_back) {
+  std::vector<ArrowWriter::Field> fields;
+  ASSERT_EQ("", ArrowWriter::parseSchema(
+                    "name:utf8,age:int64,score:double,active:bool", fields));
+  ArrowWriter writer(fields);
+
+  std::string file = writer.header();
+  std::vector<std::string> const documents = {
+      R"({"name":"a","age":1,"score":0.5,"active":true})",
+      R"({"name":"bcd","age":2.0,"score":3,"active":false})",
+      R"({"age":2.5,"score":"x","active":1})",
+      R"({"name":{"x":1},"age":-9000000000,"score":-1.25,"active":true})"};
+  // two record batches, the second one is written with the footer
+  for (size_t i = 0; i < documents.size(); ++i) {
+    if (i == 2) {
+      EXPECT_EQ(2, writer.pendingRows());
+      file.append(writer.flush());
+      EXPECT_EQ(0, writer.pendingRows());
+    }
+    auto builder = VPackParser::fromJson(documents[i]);
+    writer.append(builder->slice());
+  }
+  file.append(writer.footer());
+
+  ArrowFile reader(file);
+  reader.parse();
+  ASSERT_FALSE(::testing::Test::HasFatalFailure());
+
+  ASSERT_EQ(4, reader.fields.size());
+  EXPECT_EQ("name", reader.fields[0].name);
+  EXPECT_EQ(5, reader.fields[0].typeId);
+  EXPECT_EQ("age", reader.fields[1].name);
+  EXPECT_EQ(2, reader.fields[1].typeId);
+  EXPECT_EQ(64, reader.fields[1].bitWidth);
+  EXPECT_EQ("score", reader.fields[2].name);
+  EXPECT_EQ(3, reader.fields[2].typeId);
+  EXPECT_EQ(2, reader.fields[2].precision);
+  EXPECT_EQ("active", reader.fields[3].name);
+  EXPECT_EQ(6, reader.fields[3].typeId);
+
+  ASSERT_EQ(2, reader.batches.size());
+  auto const& first = reader.batches[0].columns;
+  EXPECT_EQ(2, reader.batches[0].length);
+  for (auto const& column : first) {
+    EXPECT_EQ(0, column.nulls);
+  }
+  EXPECT_EQ("a", first[0].utf8(0));
+  EXPECT_EQ("bcd", first[0].utf8(1));
+  EXPECT_EQ(1, first[1].int64(0));
+  EXPECT_EQ(2, first[1].int64(1));
+  EXPECT_EQ(0.5, first[2].float64(0));
+  EXPECT_EQ(3.0, first[2].float64(1));
+  EXPECT_TRUE(first[3].boolean(0));
+  EXPECT_FALSE(first[3].boolean(1));
+
+  auto const& second = reader.batches[1].columns;
+  EXPECT_EQ(2, reader.batches[1].length);
+  // missing or not convertible values are null
+  for (auto const& column : second) {
+    EXPECT_EQ(1, column.nulls);
+    EXPECT_FALSE(column.valid(0));
+    EXPECT_TRUE(column.valid(1));
+  }
+  EXPECT_EQ("", second[0].utf8(0));
+  EXPECT_EQ(R"({"x":1})", second[0].utf8(1));
+  EXPECT_EQ(-9000000000LL, second[1].int64(1));
+  EXPECT_EQ(-1.25, second[2].float64(1));
+  EXPECT_TRUE(second[3].boolean(1));
+}
+
+TEST(ArrowWriterTest, test_empty_file) {
+  std::vector<ArrowWriter::Field> fields;
+  ASSERT_EQ("", ArrowWriter::parseSchema("a:int64", fields));
+  ArrowWriter writer(fields);
+
+  std::string file = writer.header();
+  EXPECT_EQ("", writer.flush());
+  file.append(writer.footer());
+
+  ArrowFile reader(file);
+  reader.parse();
+  ASSERT_FALSE(::testing::Test::HasFatalFailure());
+  ASSERT_EQ(1, reader.fields.size());
+  EXPECT_EQ("a", reader.fields[0].name);
+  EXPECT_TRUE(reader.batches.empty());
+}
@@ -861,3 +861,130 @@ TEST(FutureTest, basic_example_fpointer) {
   p.setValue(42);
   ASSERT_TRUE(f2.get() == 43);
 }
+
+namespace {
+// queues continuations until they are run explicitly
+struct ManualExecutor final : public Executor {
+  void add(Func func) override { funcs.push_back(std::move(func)); }
+  size_t run() {
+    size_t count = 0;
+    while (!funcs.empty()) {
+      auto func = std::move(funcs.front());
+      funcs.erase(funcs.begin());
+      func();
+      ++count;
+    }
+    return count;
+  }
+  std::vector<Func> funcs;
+};
+}  // namespace
+
+TEST(FutureTest, via) {
+  ManualExecutor executor;
+  Promise<int> p;
+  auto f = p.getFuture()
+               .via(&executor)
+               .thenValue([](int i) { return i + 1; })
+               .thenValue([](int i) { return i * 2; });
+
+  p.setValue(1);
+  // nothing runs on the thread fulfilling the promise
+  ASSERT_FALSE(f.isReady());
+  ASSERT_EQ(2, executor.run());
+  ASSERT_TRUE(f.isReady());
+  ASSERT_EQ(4, f.get());
+}
+
+TEST(FutureTest, via_ready_future) {
+  ManualExecutor executor;
+  auto f = makeFuture(1).via(&executor).thenValue([](int i) { return i + 1; });
+  ASSERT_FALSE(f.isReady());
+  ASSERT_EQ(1, executor.run());
+  ASSERT_EQ(2, f.get());
+}
+
+TEST(FutureTest, via_inline) {
+  Promise<int> p;
+  auto f = p.getFuture().via(InlineExecutor::instance()).thenValue([](int i) {
+    return i + 1;
+  });
+  p.setValue(1);
+  ASSERT_TRUE(f.isReady());
+  ASSERT_EQ(2, f.get());
+}
+
+TEST(FutureTest, cancel) {
+  Promise<int> p;
+  std::exception_ptr interrupt;
+  p.setInterruptHandler([&](std::exception_ptr const& e) { interrupt = e; });
+  auto f = p.getFuture();
+  f.cancel();
+  ASSERT_TRUE(interrupt != nullptr);
+  p.setException(interrupt);
+  try {
+    f.get();
+    FAIL();
+  } catch (FutureException const& e) {
+    ASSERT_EQ(ErrorCode::Cancelled, e.code());
+  }
+}
+
+TEST(FutureTest, cancel_before_handler) {
+  Promise<int> p;
+  auto f = p.getFuture();
+  f.cancel();
+  f.cancel();
+  int calls = 0;
+  p.setInterruptHandler([&](std::exception_ptr const&) { ++calls; });
+  ASSERT_EQ(1, calls);
+  p.setValue(1);
+  ASSERT_EQ(1, f.get());
+}
+
+TEST(FutureTest, cancel_after_result) {
+  Promise<int> p;
+  int calls = 0;
+  p.setInterruptHandler([&](std::exception_ptr const&) { ++calls; });
+  auto f = p.getFuture();
+  p.setValue(1);
+  f.cancel();
+  ASSERT_EQ(0, calls);
+  ASSERT_EQ(1, f.get());
+}
+
+TEST(FutureTest, collectAll) {
+  std::vector<Promise<int>> promises(10);
+  std::vector<Future<int>> futures;
+  for (auto& p : promises) {
+    futures.push_back(p.getFuture());
+  }
+  auto all = collectAll(futures);
+  for (size_t i = promises.size(); i > 0; --i) {
+    ASSERT_FALSE(all.isReady());
+    promises[i - 1].setValue(static_cast<int>(i - 1));
+  }
+  ASSERT_TRUE(all.isReady());
+  auto results = std::move(all).get();
+  ASSERT_EQ(10, results.size());
+  for (size_t i = 0; i < results.size(); ++i) {
+    ASSERT_EQ(static_cast<int>(i), results[i].get());
+  }
+}
+
+TEST(FutureTest, collectAny) {
+  std::vector<Promise<int>> promises(10);
+  std::vector<Future<int>> futures;
+  for (auto& p : promises) {
+    futures.push_back(p.getFuture());
+  }
+  auto any = collectAny(futures);
+  ASSERT_FALSE(any.isReady());
+  promises[3].setException(eggs);
+  ASSERT_TRUE(any.isReady());
+  promises[5].setValue(5);
+
+  auto result = std::move(any).get();
+  ASSERT_EQ(3, result.first);
+  ASSERT_TRUE(result.second.hasException());
+}
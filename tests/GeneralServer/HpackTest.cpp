@@ -0,0 +1,226 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+#include "GeneralServer/Hpack.h"
+
+#include "gtest/gtest.h"
+
+using namespace arangodb::rest::hpack;
+
+namespace {
+std::string fromHex(std::string const& hex) {
+  std::string result;
+  for (size_t i = 0; i + 1 < hex.size(); i += 2) {
+    result.push_back(static_cast<char>(std::stoi(hex.substr(i, 2), nullptr, 16)));
+  }
+  return result;
+}
+
+bool decode(Decoder& decoder, std::string const& block, std::vector<HeaderField>& headers) {
+  headers.clear();
+  return decoder.decode(reinterpret_cast<uint8_t const*>(block.data()),
+                        block.size(), headers) == Decoder::Result::OK;
+}
+
+// requests of RFC 7541, C.3 and C.4
+std::vector<HeaderField> const request1 = {{":method", "GET"},
+                                           {":scheme", "http"},
+                                           {":path", "/"},
+                                           {":authority", "www.example.com"}};
+std::vector<HeaderField> const request2 = {{":method", "GET"},
+                                           {":scheme", "http"},
+                                           {":path", "/"},
+                                           {":authority", "www.example.com"},
+                                           {"cache-control", "no-cache"}};
+std::vector<HeaderField> const request3 = {{":method", "GET"},
+                                           {":scheme", "https"},
+                                           {":path", "/index.html"},
+                                           {":authority", "www.example.com"},
+                                           {"custom-key", "custom-value"}};
+}  // namespace
+
+TEST(HpackTest, test_decode_without_huffman) {
+  Decoder decoder;
+  std::vector<HeaderField> headers;
+
+  ASSERT_TRUE(decode(decoder, fromHex("828684410f7777772e6578616d706c652e636f6d"), headers));
+  EXPECT_EQ(request1, headers);
+  ASSERT_TRUE(decode(decoder, fromHex("828684be58086e6f2d6361636865"), headers));
+  EXPECT_EQ(request2, headers);
+  ASSERT_TRUE(decode(decoder, fromHex("828785bf400a637573746f6d2d6b65790c637573746f6d2d76616c7565"),
+                     headers));
+  EXPECT_EQ(request3, headers);
+
+  EXPECT_EQ(3, decoder.table().entries());
+  EXPECT_EQ(164, decoder.table().size());
+}
+
+TEST(HpackTest, test_decode_with_huffman) {
+  Decoder decoder;
+  std::vector<HeaderField> headers;
+
+  ASSERT_TRUE(decode(decoder, fromHex("828684418cf1e3c2e5f23a6ba0ab90f4ff"), headers));
+  EXPECT_EQ(request1, headers);
+  ASSERT_TRUE(decode(decoder, fromHex("828684be5886a8eb10649cbf"), headers));
+  EXPECT_EQ(request2, headers);
+  ASSERT_TRUE(decode(decoder, fromHex("828785bf408825a849e95ba97d7f8925a849e95bb8e8b4bf"), headers));
+  EXPECT_EQ(request3, headers);
+}
+
+TEST(HpackTest, test_encode) {
+  Encoder encoder;
+  std::string block;
+
+  encoder.encode(request1, block);
+  EXPECT_EQ(fromHex("828684418cf1e3c2e5f23a6ba0ab90f4ff"), block);
+  block.clear();
+  encoder.encode(request2, block);
+  EXPECT_EQ(fromHex("828684be5886a8eb10649cbf"), block);
+  block.clear();
+  encoder.encode(request3, block);
+  EXPECT_EQ(fromHex("828785bf408825a849e95ba97d7f8925a849e95bb8e8b4bf"), block);
+}
+
+TEST(HpackTest, test_encoder_keeps_credentials_out_of_the_table) {
+  Encoder encoder;
+  Decoder decoder;
+  std::vector<HeaderField> const fields = {{":status", "200"},
+                                           {"set-cookie", "arango_sid=secret"},
+                                           {"content-length", "1234"}};
+  std::string block;
+  encoder.encode(fields, block);
+  EXPECT_EQ(0, encoder.table().entries());
+
+  std::vector<HeaderField> headers;
+  ASSERT_TRUE(decode(decoder, block, headers));
+  EXPECT_EQ(fields, headers);
+  EXPECT_EQ(0, decoder.table().entries());
+}
+
+TEST(HpackTest, test_table_size_update) {
+  Encoder encoder;
+  Decoder decoder;
+  std::vector<HeaderField> const fields = {{"server", "ArangoDB"},
+                                           {"x-content-type-options", "nosniff"}};
+  std::vector<HeaderField> headers;
+
+  std::string block;
+  encoder.encode(fields, block);
+  ASSERT_TRUE(decode(decoder, block, headers));
+  EXPECT_EQ(2, decoder.table().entries());
+
+  // the peer shrinks the table, the next block starts with the update
+  encoder.setMaxTableSize(50);
+  block.clear();
+  encoder.encode(fields, block);
+  EXPECT_EQ(0x20, static_cast<uint8_t>(block[0]) & 0xe0);
+  ASSERT_TRUE(decode(decoder, block, headers));
+  EXPECT_EQ(fields, headers);
+  EXPECT_EQ(50, decoder.table().maxSize());
+  EXPECT_EQ(encoder.table().entries(), decoder.table().entries());
+  EXPECT_LE(decoder.table().size(), 50);
+
+  // no update in between two fields
+  std::string invalid = fromHex("823f11");
+  EXPECT_FALSE(decode(decoder, invalid, headers));
+  // and not larger than our settings
+  Decoder other;
+  EXPECT_FALSE(decode(other, fromHex("3fe21f"), headers));
+}
+
+TEST(HpackTest, test_huffman_roundtrip) {
+  std::string data;
+  for (int i = 0; i < 256; ++i) {
+    data.push_back(static_cast<char>(i));
+  }
+  data.append("application/json; charset=utf-8");
+
+  std::string encoded;
+  huffmanEncode(data.data(), data.size(), encoded);
+  EXPECT_EQ(huffmanEncodedLength(data.data(), data.size()), encoded.size());
+
+  std::string decoded;
+  ASSERT_TRUE(huffmanDecode(reinterpret_cast<uint8_t const*>(encoded.data()),
+                            encoded.size(), decoded));
+  EXPECT_EQ(data, decoded);
+}
+
+TEST(HpackTest, test_invalid_input) {
+  std::vector<HeaderField> headers;
+  std::string decoded;
+  Decoder decoder;
+
+  // index 0 and an index beyond static and dynamic table
+  EXPECT_FALSE(decode(decoder, fromHex("80"), headers));
+  EXPECT_FALSE(decode(decoder, fromHex("be"), headers));
+  // string literal longer than the block
+  EXPECT_FALSE(decode(decoder, fromHex("410f7777"), headers));
+  // integer that does not end
+  EXPECT_FALSE(decode(decoder, fromHex("ffffff"), headers));
+
+  // padding that is longer than 7 bits
+  std::string padding = fromHex("1fff");
+  EXPECT_FALSE(huffmanDecode(reinterpret_cast<uint8_t const*>(padding.data()),
+                             padding.size(), decoded));
+  // padding that is not made of ones
+  std::string zeros = fromHex("f0");
+  EXPECT_FALSE(huffmanDecode(reinterpret_cast<uint8_t const*>(zeros.data()),
+                             zeros.size(), decoded));
+  // EOS in the string
+  std::string eos = fromHex("ffffffff");
+  EXPECT_FALSE(huffmanDecode(reinterpret_cast<uint8_t const*>(eos.data()),
+                             eos.size(), decoded));
+}
+
+TEST(HpackTest, test_header_list_limit) {
+  Decoder decoder;
+  std::vector<HeaderField> headers;
+
+  // a single large literal that is then referenced over and over again
+  std::string block = fromHex("4001787fa11e");
+  block.append(4000, 'a');
+  block.append(1000, static_cast<char>(0xbe));
+
+  EXPECT_EQ(Decoder::Result::LIST_TOO_LARGE,
+            decoder.decode(reinterpret_cast<uint8_t const*>(block.data()),
+                           block.size(), headers, 1024 * 1024));
+  EXPECT_LT(headers.size(), 1000);
+
+  // the same list fits without a limit, and counts 32 bytes per field
+  Decoder other;
+  headers.clear();
+  EXPECT_EQ(Decoder::Result::OK,
+            other.decode(reinterpret_cast<uint8_t const*>(block.data()),
+                         block.size(), headers));
+  EXPECT_EQ(1001, headers.size());
+
+  Decoder exact;
+  headers.clear();
+  std::string small = fromHex("4001780161be");
+  EXPECT_EQ(Decoder::Result::OK,
+            exact.decode(reinterpret_cast<uint8_t const*>(small.data()),
+                         small.size(), headers, 2 * 34));
+  Decoder tooSmall;
+  headers.clear();
+  EXPECT_EQ(Decoder::Result::LIST_TOO_LARGE,
+            tooSmall.decode(reinterpret_cast<uint8_t const*>(small.data()),
+                            small.size(), headers, 2 * 34 - 1));
+}
@@ -0,0 +1,186 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+#include "Basics/StringBuffer.h"
+#include "Endpoint/ConnectionInfo.h"
+#include "GeneralServer/GeneralServer.h"
+#include "GeneralServer/Http2CommTask.h"
+#include "GeneralServer/Socket.h"
+
+#include "gtest/gtest.h"
+
+using namespace arangodb;
+using namespace arangodb::rest;
+
+namespace {
+// captures everything the task writes, reads happen through the test hook
+class MockSocket final : public Socket {
+ public:
+  MockSocket(GeneralServer::IoContext& context, std::string& output)
+      : Socket(context, false), _output(output) {}
+
+  std::string peerAddress() const override { return "127.0.0.1"; }
+  int peerPort() const override { return 8529; }
+  void setNonBlocking(bool) override {}
+  size_t writeSome(basics::StringBuffer* buffer, asio_ns::error_code&) override {
+    _output.append(buffer->c_str(), buffer->length());
+    return buffer->length();
+  }
+  void asyncWrite(asio_ns::mutable_buffers_1 const&, AsyncHandler const&) override {}
+  size_t readSome(asio_ns::mutable_buffers_1 const&, asio_ns::error_code&) override {
+    return 0;
+  }
+  std::size_t available(asio_ns::error_code&) override { return 0; }
+  void asyncRead(asio_ns::mutable_buffers_1 const&, AsyncHandler const&) override {}
+  void close(asio_ns::error_code&) override {}
+
+ protected:
+  bool sslHandshake() override { return true; }
+  void shutdownReceive(asio_ns::error_code&) override {}
+  void shutdownSend(asio_ns::error_code&) override {}
+
+ private:
+  std::string& _output;
+};
+
+constexpr uint8_t FrameData = 0x0;
+constexpr uint8_t FrameHeaders = 0x1;
+constexpr uint8_t FrameGoAway = 0x7;
+constexpr uint8_t FrameWindowUpdate = 0x8;
+constexpr uint8_t FlagEndHeaders = 0x4;
+constexpr uint8_t FlagPadded = 0x8;
+
+constexpr uint32_t NoError = 0x0;
+constexpr uint32_t ProtocolError = 0x1;
+constexpr uint32_t FlowControlError = 0x3;
+constexpr uint32_t FrameSizeError = 0x6;
+constexpr uint32_t EnhanceYourCalm = 0xb;
+
+void appendUInt32(std::string& out, uint32_t value) {
+  out.push_back(static_cast<char>(value >> 24));
+  out.push_back(static_cast<char>(value >> 16));
+  out.push_back(static_cast<char>(value >> 8));
+  out.push_back(static_cast<char>(value));
+}
+
+std::string frame(uint8_t type, uint8_t flags, uint32_t streamId,
+                  std::string const& payload) {
+  std::string out;
+  out.push_back(static_cast<char>(payload.size() >> 16));
+  out.push_back(static_cast<char>(payload.size() >> 8));
+  out.push_back(static_cast<char>(payload.size()));
+  out.push_back(static_cast<char>(type));
+  out.push_back(static_cast<char>(flags));
+  appendUInt32(out, streamId);
+  out.append(payload);
+  return out;
+}
+
+class Http2CommTaskTest : public ::testing::Test {
+ protected:
+  Http2CommTaskTest() : _server(1, false) {
+    _task = std::make_shared<Http2CommTask>(
+        _server, std::make_unique<MockSocket>(_server.selectIoContext(), _output),
+        ConnectionInfo(), 0.0, true);
+  }
+
+  // sends the connection preface and the given frames, returns whether the
+  // connection is still open afterwards
+  bool receive(std::string const& frames) {
+    std::string data(Http2CommTask::ConnectionPreface,
+                     Http2CommTask::ConnectionPrefaceLength);
+    data.append(frames);
+    return _task->receiveForTest(data.data(), data.size());
+  }
+
+  // the error code of the GOAWAY frame the server sent, if any
+  uint32_t goAwayError() const {
+    uint32_t error = NoError;
+    size_t pos = 0;
+    while (pos + 9 <= _output.size()) {
+      auto p = reinterpret_cast<uint8_t const*>(_output.data()) + pos;
+      size_t const length = (size_t(p[0]) << 16) | (size_t(p[1]) << 8) | p[2];
+      if (p[3] == FrameGoAway && length >= 8) {
+        error = (uint32_t(p[13]) << 24) | (uint32_t(p[14]) << 16) |
+                (uint32_t(p[15]) << 8) | uint32_t(p[16]);
+      }
+      pos += 9 + length;
+    }
+    return error;
+  }
+
+  GeneralServer _server;
+  std::string _output;
+  std::shared_ptr<Http2CommTask> _task;
+};
+
+// GET / on stream 1, without END_STREAM
+std::string const requestHeaders("\x82\x84", 2);
+}  // namespace
+
+TEST_F(Http2CommTaskTest, test_preface_and_window_update) {
+  std::string payload;
+  appendUInt32(payload, 1024);
+  ASSERT_TRUE(receive(frame(FrameWindowUpdate, 0, 0, payload)));
+  EXPECT_FALSE(_output.empty());
+  EXPECT_EQ(NoError, goAwayError());
+}
+
+TEST_F(Http2CommTaskTest, test_frame_too_large) {
+  std::string header = frame(FrameData, 0, 1, "");
+  header[0] = static_cast<char>(0x01);  // 65536 bytes announced
+  EXPECT_FALSE(receive(header));
+  EXPECT_EQ(FrameSizeError, goAwayError());
+}
+
+TEST_F(Http2CommTaskTest, test_invalid_padding) {
+  // the pad length covers the whole frame
+  std::string payload;
+  payload.push_back(static_cast<char>(requestHeaders.size() + 1));
+  payload.append(requestHeaders);
+  EXPECT_FALSE(receive(frame(FrameHeaders, FlagEndHeaders | FlagPadded, 1, payload)));
+  EXPECT_EQ(ProtocolError, goAwayError());
+}
+
+TEST_F(Http2CommTaskTest, test_zero_window_update) {
+  std::string payload;
+  appendUInt32(payload, 0);
+  EXPECT_FALSE(receive(frame(FrameWindowUpdate, 0, 0, payload)));
+  EXPECT_EQ(ProtocolError, goAwayError());
+}
+
+TEST_F(Http2CommTaskTest, test_window_overflow) {
+  std::string payload;
+  appendUInt32(payload, 0x7fffffff);
+  EXPECT_FALSE(receive(frame(FrameWindowUpdate, 0, 0, payload)));
+  EXPECT_EQ(FlowControlError, goAwayError());
+}
+
+TEST_F(Http2CommTaskTest, test_header_list_too_large) {
+  // one 4000 byte field in the dynamic table, referenced 1000 times
+  std::string block("\x40\x01x\x7f\xa1\x1e", 6);
+  block.append(4000, 'a');
+  block.append(1000, static_cast<char>(0xbe));
+  ASSERT_LE(block.size(), Http2CommTask::MaximalFrameSize);
+
+  EXPECT_FALSE(receive(frame(FrameHeaders, FlagEndHeaders, 1, block)));
+  EXPECT_EQ(EnhanceYourCalm, goAwayError());
+}
@@ -0,0 +1,50 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "Basics/Common.h"
+#include "Rest/HttpResponse.h"
+
+#include "gtest/gtest.h"
+
+using namespace arangodb;
+
+TEST(HttpResponseCompressionTest, test_negotiate_encoding) {
+  EXPECT_EQ("", HttpResponse::negotiateEncoding(""));
+  EXPECT_EQ("", HttpResponse::negotiateEncoding("identity"));
+  EXPECT_EQ("", HttpResponse::negotiateEncoding("br, lz4"));
+  EXPECT_EQ("gzip", HttpResponse::negotiateEncoding("gzip"));
+  EXPECT_EQ("gzip", HttpResponse::negotiateEncoding("GZIP"));
+  EXPECT_EQ("gzip", HttpResponse::negotiateEncoding("x-gzip"));
+  EXPECT_EQ("deflate", HttpResponse::negotiateEncoding("deflate"));
+  EXPECT_EQ("gzip", HttpResponse::negotiateEncoding("deflate, gzip"));
+  EXPECT_EQ("gzip", HttpResponse::negotiateEncoding("gzip, deflate, br"));
+  EXPECT_EQ("gzip", HttpResponse::negotiateEncoding("*"));
+}
+
+TEST(HttpResponseCompressionTest, test_negotiate_encoding_quality) {
+  EXPECT_EQ("deflate", HttpResponse::negotiateEncoding("gzip;q=0.5, deflate"));
+  EXPECT_EQ("gzip", HttpResponse::negotiateEncoding("gzip ; q=0.8, deflate;q=0.2"));
+  EXPECT_EQ("deflate", HttpResponse::negotiateEncoding("gzip;q=0, deflate;q=0.1"));
+  EXPECT_EQ("", HttpResponse::negotiateEncoding("gzip;q=0, deflate;q=0"));
+  EXPECT_EQ("deflate", HttpResponse::negotiateEncoding("gzip;q=0, *"));
+  EXPECT_EQ("", HttpResponse::negotiateEncoding("*;q=0"));
+  EXPECT_EQ("gzip", HttpResponse::negotiateEncoding("gzip, *;q=0"));
+}
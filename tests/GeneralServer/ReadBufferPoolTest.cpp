@@ -0,0 +1,82 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "Basics/Common.h"
+#include "Basics/StringBuffer.h"
+#include "GeneralServer/ReadBufferPool.h"
+
+#include "gtest/gtest.h"
+
+using namespace arangodb;
+using namespace arangodb::rest;
+
+TEST(ReadBufferPoolTest, test_lease_has_capacity) {
+  basics::StringBuffer buffer;
+  ASSERT_EQ(TRI_ERROR_NO_ERROR, ReadBufferPool::lease(buffer, 10001));
+  EXPECT_GE(buffer.capacity(), 10001);
+  EXPECT_TRUE(buffer.empty());
+
+  buffer.appendText("GET / HTTP/1.1\r\n\r\n");
+  ReadBufferPool::release(buffer);
+  EXPECT_EQ(0, buffer.capacity());
+  EXPECT_EQ(nullptr, buffer.c_str());
+}
+
+TEST(ReadBufferPoolTest, test_released_memory_is_reused) {
+  basics::StringBuffer buffer;
+  ASSERT_EQ(TRI_ERROR_NO_ERROR, ReadBufferPool::lease(buffer, 200 * 1024));
+  char const* memory = buffer.c_str();
+  size_t capacity = buffer.capacity();
+  ReadBufferPool::release(buffer);
+
+  // the memory went to the 256 KB class, a lease of 20 KB may take a
+  // buffer from the class above its own
+  basics::StringBuffer other;
+  ASSERT_EQ(TRI_ERROR_NO_ERROR, ReadBufferPool::lease(other, 20 * 1024));
+  EXPECT_EQ(memory, other.c_str());
+  EXPECT_EQ(capacity, other.capacity());
+  EXPECT_TRUE(other.empty());
+  ReadBufferPool::release(other);
+}
+
+TEST(ReadBufferPoolTest, test_large_buffers_are_not_pooled) {
+  basics::StringBuffer buffer;
+  ASSERT_EQ(TRI_ERROR_NO_ERROR, ReadBufferPool::lease(buffer, 32 * 1024 * 1024));
+  EXPECT_GE(buffer.capacity(), 32 * 1024 * 1024);
+  ReadBufferPool::release(buffer);
+
+  basics::StringBuffer other;
+  ASSERT_EQ(TRI_ERROR_NO_ERROR, ReadBufferPool::lease(other, 32 * 1024 * 1024));
+  EXPECT_GE(other.capacity(), 32 * 1024 * 1024);
+  ReadBufferPool::release(other);
+}
+
+TEST(ReadBufferPoolTest, test_track_memory) {
+  basics::StringBuffer buffer;
+  size_t accounted = 0;
+  ASSERT_EQ(TRI_ERROR_NO_ERROR, ReadBufferPool::lease(buffer, 10001));
+  ReadBufferPool::track(buffer, accounted);
+  EXPECT_EQ(buffer.capacity(), accounted);
+
+  ReadBufferPool::release(buffer);
+  ReadBufferPool::track(buffer, accounted);
+  EXPECT_EQ(0, accounted);
+}
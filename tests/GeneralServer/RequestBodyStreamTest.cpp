@@ -0,0 +1,103 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "Basics/Common.h"
+#include "Rest/RequestBodyStream.h"
+
+#include "gtest/gtest.h"
+
+#include <thread>
+
+using namespace arangodb;
+
+TEST(RequestBodyStreamTest, test_read_in_order) {
+  RequestBodyStream stream(6);
+  EXPECT_EQ(6, stream.length());
+
+  EXPECT_TRUE(stream.append("abc", 3));
+  EXPECT_TRUE(stream.append("def", 3));
+  stream.finish();
+
+  std::string out;
+  EXPECT_TRUE(stream.read(out));
+  EXPECT_EQ("abc", out);
+  EXPECT_TRUE(stream.read(out));
+  EXPECT_EQ("abcdef", out);
+  EXPECT_FALSE(stream.read(out));
+  EXPECT_EQ("abcdef", out);
+  EXPECT_FALSE(stream.aborted());
+}
+
+TEST(RequestBodyStreamTest, test_pause_and_resume) {
+  RequestBodyStream stream(100, 8);
+  size_t resumed = 0;
+  stream.setResumeCallback([&resumed]() { ++resumed; });
+
+  EXPECT_TRUE(stream.append("1234", 4));
+  EXPECT_TRUE(stream.append("56", 2));
+  EXPECT_FALSE(stream.append("78", 2));
+
+  std::string out;
+  // 4 bytes are left, which is half the limit
+  EXPECT_TRUE(stream.read(out));
+  EXPECT_EQ(1, resumed);
+  EXPECT_TRUE(stream.read(out));
+  EXPECT_EQ(1, resumed);
+  EXPECT_EQ("123456", out);
+}
+
+TEST(RequestBodyStreamTest, test_read_waits_for_data) {
+  RequestBodyStream stream(1000);
+  std::string out;
+
+  std::thread producer([&stream]() {
+    for (int i = 0; i < 100; ++i) {
+      stream.append("0123456789", 10);
+    }
+    stream.finish();
+  });
+
+  while (stream.read(out)) {
+  }
+  producer.join();
+
+  EXPECT_EQ(1000, out.size());
+  EXPECT_FALSE(stream.aborted());
+}
+
+TEST(RequestBodyStreamTest, test_abort_wakes_reader) {
+  RequestBodyStream stream(1000);
+  std::string out;
+
+  std::thread closer([&stream]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    stream.abort();
+  });
+
+  EXPECT_FALSE(stream.read(out));
+  closer.join();
+
+  EXPECT_TRUE(stream.aborted());
+  // data after the abort is dropped
+  EXPECT_TRUE(stream.append("abc", 3));
+  EXPECT_FALSE(stream.read(out));
+  EXPECT_TRUE(out.empty());
+}
@@ -0,0 +1,99 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "Basics/Common.h"
+#include "Rest/ResponseBodyStream.h"
+
+#include "gtest/gtest.h"
+
+using namespace arangodb;
+
+TEST(ResponseBodyStreamTest, test_take_all_written) {
+  ResponseBodyStream stream;
+  size_t notified = 0;
+  stream.setNotifyCallback([&notified]() { ++notified; });
+
+  EXPECT_TRUE(stream.write("abc", false));
+  EXPECT_TRUE(stream.write("def", false));
+  EXPECT_EQ(2, notified);
+
+  std::string out;
+  bool finished = true;
+  EXPECT_TRUE(stream.take(out, finished));
+  EXPECT_EQ("abcdef", out);
+  EXPECT_FALSE(finished);
+
+  EXPECT_TRUE(stream.write("ghi", true));
+  out.clear();
+  EXPECT_TRUE(stream.take(out, finished));
+  EXPECT_EQ("ghi", out);
+  EXPECT_TRUE(finished);
+
+  // nothing after the last piece
+  EXPECT_FALSE(stream.write("jkl", false));
+}
+
+TEST(ResponseBodyStreamTest, test_pause_and_resume) {
+  ResponseBodyStream stream(8);
+  size_t resumed = 0;
+  stream.setResumeCallback([&resumed]() { ++resumed; });
+
+  EXPECT_TRUE(stream.write("1234", false));
+  EXPECT_FALSE(stream.write("5678", false));
+  EXPECT_EQ(0, resumed);
+
+  std::string out;
+  bool finished = false;
+  EXPECT_TRUE(stream.take(out, finished));
+  EXPECT_EQ(1, resumed);
+  // not paused anymore
+  EXPECT_TRUE(stream.take(out, finished));
+  EXPECT_EQ(1, resumed);
+  EXPECT_EQ("12345678", out);
+
+  // the last piece never pauses the producer
+  EXPECT_TRUE(stream.write("123456789", true));
+}
+
+TEST(ResponseBodyStreamTest, test_abort_resumes_producer) {
+  ResponseBodyStream stream(4);
+  size_t resumed = 0;
+  size_t notified = 0;
+  stream.setResumeCallback([&resumed]() { ++resumed; });
+  stream.setNotifyCallback([&notified]() { ++notified; });
+
+  EXPECT_FALSE(stream.write("1234", false));
+  stream.abort();
+  EXPECT_TRUE(stream.aborted());
+  EXPECT_EQ(1, resumed);
+  EXPECT_EQ(2, notified);
+
+  std::string out;
+  bool finished = false;
+  EXPECT_FALSE(stream.take(out, finished));
+  EXPECT_TRUE(out.empty());
+  EXPECT_FALSE(stream.write("1234", true));
+
+  // aborting twice has no effect
+  stream.abort();
+  EXPECT_EQ(1, resumed);
+  EXPECT_EQ(2, notified);
+}
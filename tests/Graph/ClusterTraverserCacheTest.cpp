@@ -28,6 +28,7 @@
 #include "Aql/Query.h"
 #include "Cluster/ServerState.h"
 #include "Graph/ClusterTraverserCache.h"
+#include "Graph/InternedIdSet.h"
 #include "Transaction/Methods.h"
 
 #include <velocypack/Builder.h>
@@ -112,6 +113,47 @@ TEST_F(ClusterTraverserCacheTest, it_should_insert_a_null_vpack_if_vertex_not_ca
       .Exactly(1);
 }
 
+TEST_F(ClusterTraverserCacheTest, it_should_intern_equal_ids_to_the_same_dense_id) {
+  std::unordered_map<ServerID, traverser::TraverserEngineID> engines;
+
+  fakeit::Mock<transaction::Methods> trxMock;
+  transaction::Methods& trx = trxMock.get();
+
+  fakeit::Mock<Query> queryMock;
+  Query& query = queryMock.get();
+  fakeit::When(Method(queryMock, trx)).AlwaysReturn(&trx);
+
+  ClusterTraverserCache testee(&query, &engines);
+
+  std::string a = "UnitTest/A";
+  std::string b = "UnitTest/B";
+  std::string aCopy = a;
+
+  uint32_t idA = testee.internString(arangodb::velocypack::StringRef(a));
+  uint32_t idB = testee.internString(arangodb::velocypack::StringRef(b));
+  ASSERT_EQ(0u, idA);
+  ASSERT_EQ(1u, idB);
+  ASSERT_EQ(idA, testee.internString(arangodb::velocypack::StringRef(aCopy)));
+
+  // the interned string is a copy owned by the cache
+  a.assign("UnitTest/X");
+  ASSERT_TRUE(testee.internedString(idA) == arangodb::velocypack::StringRef(aCopy));
+  ASSERT_TRUE(testee.persistString(arangodb::velocypack::StringRef(aCopy)).data() ==
+              testee.internedString(idA).data());
+
+  InternedIdSet visited;
+  ASSERT_TRUE(visited.insert(idB));
+  ASSERT_FALSE(visited.insert(idB));
+  ASSERT_TRUE(visited.contains(idB));
+  ASSERT_FALSE(visited.contains(idA));
+  visited.clear();
+  ASSERT_FALSE(visited.contains(idB));
+
+  // ids start from scratch after clearing the cache
+  testee.clear();
+  ASSERT_EQ(0u, testee.internString(arangodb::velocypack::StringRef(b)));
+}
+
 }  // namespace cluster_traverser_cache_test
 }  // namespace tests
 }  // namespace arangodb
@@ -50,6 +50,8 @@
 #include <velocypack/Slice.h>
 #include <velocypack/velocypack-aliases.h>
 
+#include <set>
+
 // test setup
 #include "../Mocks/Servers.h"
 #include "../Mocks/StorageEngineMock.h"
@@ -212,6 +214,28 @@ TEST_F(KShortestPathsFinderTest, many_edges_between_two_nodes) {
   ASSERT_TRUE(false == finder->getNextPathShortestPathResult(result));
 }
 
+TEST_F(KShortestPathsFinderTest, all_paths_are_returned_exactly_once) {
+  auto start = velocypack::Parser::fromJson("\"v/40\"");
+  auto end = velocypack::Parser::fromJson("\"v/47\"");
+  ShortestPathResult result;
+  std::set<std::string> found;
+
+  finder->startKShortestPathsTraversal(start->slice(), end->slice());
+
+  for (size_t i = 0; i < 3; ++i) {
+    ASSERT_TRUE(true == finder->getNextPathShortestPathResult(result));
+    ASSERT_EQ(7u, result.length());
+    std::string path;
+    for (size_t j = 0; j < result.length(); ++j) {
+      AqlValue v = result.vertexToAqlValue(spo->cache(), j);
+      AqlValueGuard guard{v, true};
+      path += v.slice().get(StaticStrings::KeyString).copyString() + " ";
+    }
+    ASSERT_TRUE(found.emplace(path).second) << "path returned twice: " << path;
+  }
+  ASSERT_TRUE(false == finder->getNextPathShortestPathResult(result));
+}
+
 }  // namespace graph
 }  // namespace tests
 }  // namespace arangodb
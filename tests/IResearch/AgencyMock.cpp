@@ -25,6 +25,7 @@
 #include "Agency/Store.h"
 #include "Basics/ConditionLocker.h"
 #include "Basics/NumberUtils.h"
+#include "Basics/ReadLocker.h"
 #include "Basics/StringBuffer.h"
 #include "Cluster/ClusterFeature.h"
 #include "Cluster/ClusterInfo.h"
@@ -62,7 +63,7 @@ void Store::notifyObservers() const {
   std::vector<uint32_t> callbackIds;
 
   {
-    MUTEX_LOCKER(storeLocker, _storeLock);
+    READ_LOCKER(storeLocker, _storeLock);
 
     for (auto& entry: _observerTable) {
       auto& key = entry.first;
@@ -800,6 +800,35 @@ TEST_F(IResearchAnalyzerFeatureTest, test_get_properties_mismatch) {
   ASSERT_EQ(read, nullptr);
 }
 
+TEST_F(IResearchAnalyzerFeatureTest, test_tokens_cache) {
+  arangodb::iresearch::IResearchAnalyzerFeature feature(server);
+  auto pool = arangodb::iresearch::IResearchAnalyzerFeature::identity();
+  ASSERT_NE(pool, nullptr);
+
+  // miss on first analysis
+  std::shared_ptr<arangodb::iresearch::IResearchAnalyzerFeature::Tokens const> tokens;
+  EXPECT_TRUE(feature.tokens(tokens, *pool, "abc").ok());
+  ASSERT_NE(tokens, nullptr);
+  EXPECT_EQ(arangodb::iresearch::IResearchAnalyzerFeature::Tokens({"abc"}), *tokens);
+  EXPECT_EQ(0, feature.tokensCacheHits());
+  EXPECT_EQ(1, feature.tokensCacheMisses());
+
+  // hit on repeated analysis
+  std::shared_ptr<arangodb::iresearch::IResearchAnalyzerFeature::Tokens const> cached;
+  EXPECT_TRUE(feature.tokens(cached, *pool, "abc").ok());
+  EXPECT_EQ(tokens, cached);
+  EXPECT_EQ(1, feature.tokensCacheHits());
+  EXPECT_EQ(1, feature.tokensCacheMisses());
+
+  // long inputs bypass the cache
+  std::string const value(1024, 'a');
+  EXPECT_TRUE(feature.tokens(tokens, *pool, value).ok());
+  ASSERT_NE(tokens, nullptr);
+  EXPECT_EQ(arangodb::iresearch::IResearchAnalyzerFeature::Tokens({value}), *tokens);
+  EXPECT_EQ(1, feature.tokensCacheHits());
+  EXPECT_EQ(1, feature.tokensCacheMisses());
+}
+
 TEST_F(IResearchAnalyzerFeatureTest, test_get_feature_mismatch) {
   arangodb::iresearch::IResearchAnalyzerFeature::EmplaceResult result;
   arangodb::iresearch::IResearchAnalyzerFeature feature(server);
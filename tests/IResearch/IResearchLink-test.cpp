@@ -1544,3 +1544,113 @@ TEST_F(IResearchLinkTest, test_write) {
   logicalCollection->dropIndex(link->id());
   EXPECT_ANY_THROW((reader.reopen()));
 }
+
+TEST_F(IResearchLinkTest, test_write_async) {
+  static std::vector<std::string> const EMPTY;
+  auto doc0 = arangodb::velocypack::Parser::fromJson("{ \"abc\": \"def\" }");
+  auto doc1 = arangodb::velocypack::Parser::fromJson("{ \"ghi\": \"jkl\" }");
+  TRI_vocbase_t vocbase(TRI_vocbase_type_e::TRI_VOCBASE_TYPE_NORMAL, 1,
+                        "testVocbase");
+  auto linkJson = arangodb::velocypack::Parser::fromJson(
+      "{ \"id\": 42, \"type\": \"arangosearch\", \"view\": \"42\", "
+      "\"includeAllFields\": true }");
+  auto collectionJson = arangodb::velocypack::Parser::fromJson(
+      "{ \"name\": \"testCollection\" }");
+  auto viewJson = arangodb::velocypack::Parser::fromJson(
+      "{ \
+    \"id\": 42, \
+    \"name\": \"testView\", \
+    \"type\": \"arangosearch\" \
+  }");
+
+  // enable asynchronous indexing, index in the committing thread above 1 operation
+  auto* feature =
+      arangodb::application_features::ApplicationServer::lookupFeature<arangodb::iresearch::IResearchFeature>();
+  ASSERT_TRUE((feature));
+  arangodb::options::ProgramOptions options("", "", "", nullptr);
+  auto optionsPtr = std::shared_ptr<arangodb::options::ProgramOptions>(&options, [](arangodb::options::ProgramOptions*)->void {});
+  feature->collectOptions(optionsPtr);
+  options.get<arangodb::options::BooleanParameter>("arangosearch.async-indexing")->set("true");
+  options.get<arangodb::options::UInt64Parameter>("arangosearch.async-indexing-max-lag")->set("1");
+  auto restore = irs::make_finally([&options]()->void {
+    options.get<arangodb::options::BooleanParameter>("arangosearch.async-indexing")->set("false");
+  });
+  EXPECT_TRUE((feature->asyncIndexing()));
+  EXPECT_TRUE((1 == feature->asyncIndexingMaxLag()));
+
+  auto logicalCollection = vocbase.createCollection(collectionJson->slice());
+  ASSERT_TRUE((nullptr != logicalCollection));
+  auto view = std::dynamic_pointer_cast<arangodb::iresearch::IResearchView>(
+      vocbase.createView(viewJson->slice()));
+  ASSERT_TRUE((false == !view));
+  view->open();
+
+  std::string dataPath =
+      ((((irs::utf8_path() /= testFilesystemPath) /=
+         std::string("databases")) /=
+        (std::string("database-") + std::to_string(vocbase.id()))) /=
+       (std::string("arangosearch-") + std::to_string(logicalCollection->id()) + "_42"))
+          .utf8();
+  irs::fs_directory directory(dataPath);
+  bool created;
+  auto link = logicalCollection->createIndex(linkJson->slice(), created);
+  ASSERT_TRUE((false == !link && created));
+  auto* l = dynamic_cast<arangodb::iresearch::IResearchLink*>(link.get());
+  ASSERT_TRUE(l != nullptr);
+  auto reader = irs::directory_reader::open(directory);
+  EXPECT_TRUE((0 == reader.reopen().live_docs_count()));
+
+  // aborted transaction, nothing queued
+  {
+    arangodb::transaction::Methods trx(arangodb::transaction::StandaloneContext::Create(vocbase),
+                                       EMPTY, EMPTY, EMPTY,
+                                       arangodb::transaction::Options());
+    EXPECT_TRUE((trx.begin().ok()));
+    EXPECT_TRUE((l->insert(trx, arangodb::LocalDocumentId(1), doc0->slice(),
+                           arangodb::Index::OperationMode::normal)
+                     .ok()));
+    EXPECT_TRUE((trx.abort().ok()));
+    EXPECT_TRUE((0 == l->indexingLag()));
+    EXPECT_TRUE((l->commit().ok()));
+  }
+
+  EXPECT_TRUE((0 == reader.reopen().live_docs_count()));
+
+  // committed transaction, indexed not later than the next link commit
+  {
+    arangodb::transaction::Methods trx(arangodb::transaction::StandaloneContext::Create(vocbase),
+                                       EMPTY, EMPTY, EMPTY,
+                                       arangodb::transaction::Options());
+    EXPECT_TRUE((trx.begin().ok()));
+    EXPECT_TRUE((l->insert(trx, arangodb::LocalDocumentId(1), doc0->slice(),
+                           arangodb::Index::OperationMode::normal)
+                     .ok()));
+    EXPECT_TRUE((trx.commit().ok()));
+    EXPECT_TRUE((1 >= l->indexingLag()));
+    EXPECT_TRUE((l->commit().ok()));
+    EXPECT_TRUE((0 == l->indexingLag()));
+  }
+
+  EXPECT_TRUE((1 == reader.reopen().live_docs_count()));
+
+  // lag above the limit, indexed by the committing transaction
+  {
+    arangodb::transaction::Methods trx(arangodb::transaction::StandaloneContext::Create(vocbase),
+                                       EMPTY, EMPTY, EMPTY,
+                                       arangodb::transaction::Options());
+    EXPECT_TRUE((trx.begin().ok()));
+    EXPECT_TRUE((l->insert(trx, arangodb::LocalDocumentId(2), doc1->slice(),
+                           arangodb::Index::OperationMode::normal)
+                     .ok()));
+    EXPECT_TRUE((l->remove(trx, arangodb::LocalDocumentId(1), doc0->slice(),
+                           arangodb::Index::OperationMode::normal)
+                     .ok()));
+    EXPECT_TRUE((trx.commit().ok()));
+    EXPECT_TRUE((0 == l->indexingLag()));
+    EXPECT_TRUE((l->commit().ok()));
+  }
+
+  EXPECT_TRUE((1 == reader.reopen().live_docs_count()));
+  logicalCollection->dropIndex(link->id());
+  EXPECT_ANY_THROW((reader.reopen()));
+}
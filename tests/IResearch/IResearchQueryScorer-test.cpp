@@ -1828,4 +1828,75 @@ TEST_F(IResearchQueryScorerTest, test) {
       EXPECT_TRUE(static_cast<const void*>(scorers[i].var) == sub->getData());
     }
   }
+
+  // limited SORT on a single scorer is pushed into the view
+  {
+    std::string const queryString =
+        "FOR d IN testView SEARCH IN_RANGE(d.name, 'A', 'C', true, true) "
+        "SORT tfidf(d) DESC LIMIT 1, 2 "
+        "RETURN tfidf(d)";
+
+    EXPECT_TRUE(arangodb::tests::assertRules(vocbase, queryString,
+                                             {
+                                                 arangodb::aql::OptimizerRule::handleArangoSearchViewsRule,
+                                                 arangodb::aql::OptimizerRule::applySortLimitRule,
+                                                 arangodb::aql::OptimizerRule::applyArangoSearchScoresLimitRule,
+                                             }));
+
+    auto query = arangodb::tests::prepareQuery(vocbase, queryString);
+    ASSERT_TRUE(query);
+    auto* plan = query->plan();
+    ASSERT_TRUE(plan);
+
+    arangodb::SmallVector<arangodb::aql::ExecutionNode*>::allocator_type::arena_type a;
+    arangodb::SmallVector<arangodb::aql::ExecutionNode*> nodes{a};
+    plan->findNodesOfType(nodes, arangodb::aql::ExecutionNode::ENUMERATE_IRESEARCH_VIEW, true);
+    ASSERT_TRUE(1 == nodes.size());
+    auto* viewNode =
+        arangodb::aql::ExecutionNode::castTo<arangodb::iresearch::IResearchViewNode*>(
+            nodes.front());
+    ASSERT_TRUE(viewNode);
+    ASSERT_TRUE(1 == viewNode->scorers().size());
+    EXPECT_TRUE(3 == viewNode->scoresLimit().limit);
+    EXPECT_TRUE(0 == viewNode->scoresLimit().scorer);
+    EXPECT_FALSE(viewNode->scoresLimit().ascending);
+
+    // scores must not depend on the rule
+    auto limitedResult = arangodb::tests::executeQuery(vocbase, queryString);
+    ASSERT_TRUE(limitedResult.result.ok());
+    auto fullResult = arangodb::tests::executeQuery(
+        vocbase, queryString, nullptr,
+        "{ \"optimizer\": { \"rules\": [ \"-arangosearch-scores-limit\" ] } }");
+    ASSERT_TRUE(fullResult.result.ok());
+
+    auto const limitedSlice = limitedResult.data->slice();
+    auto const fullSlice = fullResult.data->slice();
+    ASSERT_TRUE(limitedSlice.isArray());
+    ASSERT_TRUE(fullSlice.isArray());
+    EXPECT_TRUE(2 == limitedSlice.length());
+    EXPECT_TRUE(0 == arangodb::basics::VelocyPackHelper::compare(fullSlice, limitedSlice, true));
+  }
+
+  // stable or multi-criteria sort is not pushed into the view
+  {
+    std::string const queryString =
+        "FOR d IN testView SEARCH IN_RANGE(d.name, 'A', 'C', true, true) "
+        "SORT tfidf(d) DESC, d.seq LIMIT 2 "
+        "RETURN d";
+
+    auto query = arangodb::tests::prepareQuery(vocbase, queryString);
+    ASSERT_TRUE(query);
+    auto* plan = query->plan();
+    ASSERT_TRUE(plan);
+
+    arangodb::SmallVector<arangodb::aql::ExecutionNode*>::allocator_type::arena_type a;
+    arangodb::SmallVector<arangodb::aql::ExecutionNode*> nodes{a};
+    plan->findNodesOfType(nodes, arangodb::aql::ExecutionNode::ENUMERATE_IRESEARCH_VIEW, true);
+    ASSERT_TRUE(1 == nodes.size());
+    auto* viewNode =
+        arangodb::aql::ExecutionNode::castTo<arangodb::iresearch::IResearchViewNode*>(
+            nodes.front());
+    ASSERT_TRUE(viewNode);
+    EXPECT_TRUE(0 == viewNode->scoresLimit().limit);
+  }
 }
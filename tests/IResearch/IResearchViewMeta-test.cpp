@@ -489,6 +489,58 @@ TEST_F(IResearchViewMetaTest, test_readCustomizedValues) {
   }
 }
 
+TEST_F(IResearchViewMetaTest, test_readStoredValues) {
+  arangodb::iresearch::IResearchViewMeta meta;
+
+  {
+    std::string errorField;
+    auto json = arangodb::velocypack::Parser::fromJson("{ \"storedValues\": {} }");
+    EXPECT_TRUE(false == meta.init(json->slice(), errorField));
+    EXPECT_TRUE("storedValues" == errorField);
+  }
+
+  {
+    std::string errorField;
+    auto json = arangodb::velocypack::Parser::fromJson(
+        "{ \"storedValues\": [ \"name\", 1 ] }");
+    EXPECT_TRUE(false == meta.init(json->slice(), errorField));
+    EXPECT_TRUE("storedValues=>[1]" == errorField);
+  }
+
+  {
+    std::string errorField;
+    auto json = arangodb::velocypack::Parser::fromJson(
+        "{ \"storedValues\": [ \"_id\" ] }");
+    EXPECT_TRUE(false == meta.init(json->slice(), errorField));
+    EXPECT_TRUE("storedValues=>[0]" == errorField);
+  }
+
+  {
+    std::string errorField;
+    auto json = arangodb::velocypack::Parser::fromJson(
+        "{ \"storedValues\": [ \"name\", \"_key\", \"name\", \"age\" ] }");
+    EXPECT_TRUE(true == meta.init(json->slice(), errorField));
+    EXPECT_TRUE(3 == meta._storedValues.size());
+    EXPECT_TRUE((std::vector<std::string>{"_key", "age", "name"} ==
+                 meta._storedValues.fields()));
+    EXPECT_TRUE(1 == meta._storedValues.find("age"));
+    EXPECT_TRUE(meta._storedValues.size() == meta._storedValues.find("missing"));
+    EXPECT_TRUE("@_SV:age" == meta._storedValues.columns()[1]);
+
+    arangodb::velocypack::Builder builder;
+    builder.openObject();
+    EXPECT_TRUE(true == meta.json(builder));
+    builder.close();
+
+    auto const slice = builder.slice().get("storedValues");
+    ASSERT_TRUE(slice.isArray());
+    ASSERT_TRUE(3 == slice.length());
+    EXPECT_TRUE("_key" == slice.at(0).copyString());
+    EXPECT_TRUE("age" == slice.at(1).copyString());
+    EXPECT_TRUE("name" == slice.at(2).copyString());
+  }
+}
+
 TEST_F(IResearchViewMetaTest, test_writeDefaults) {
   arangodb::iresearch::IResearchViewMeta meta;
   arangodb::iresearch::IResearchViewMetaState metaState;
@@ -0,0 +1,67 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "gtest/gtest.h"
+
+#include "Indexes/IndexBuildProgress.h"
+
+using namespace arangodb;
+
+TEST(IndexBuildProgressTest, test_percent) {
+  IndexBuildProgress progress;
+  EXPECT_EQ(0, progress.percent());
+
+  progress.setTotal(200);
+  progress.advance(50, 1000);
+  EXPECT_EQ(25, progress.percent());
+
+  // the total is only an estimate
+  progress.advance(300, 1000);
+  EXPECT_EQ(100, progress.percent());
+}
+
+TEST(IndexBuildProgressTest, test_scope) {
+  EXPECT_EQ(nullptr, IndexBuildProgress::CURRENT);
+  IndexBuildProgress progress;
+  {
+    IndexBuildProgressScope scope(&progress);
+    EXPECT_EQ(&progress, IndexBuildProgress::CURRENT);
+  }
+  EXPECT_EQ(nullptr, IndexBuildProgress::CURRENT);
+}
+
+TEST(IndexBuildProgressTest, test_write_delay) {
+  auto const now = IndexBuildProgress::clock::now();
+  {
+    IndexBuildProgress progress;
+    EXPECT_EQ(IndexBuildProgress::clock::duration::zero(), progress.writeDelay(1000000, now));
+  }
+
+  IndexBuildProgress progress(1000);
+  // one second of unused capacity is kept
+  EXPECT_EQ(IndexBuildProgress::clock::duration::zero(), progress.writeDelay(1000, now));
+  EXPECT_EQ(std::chrono::milliseconds(500),
+            std::chrono::duration_cast<std::chrono::milliseconds>(progress.writeDelay(500, now)));
+  // the capacity refills over time
+  EXPECT_EQ(IndexBuildProgress::clock::duration::zero(),
+            progress.writeDelay(1000, now + std::chrono::seconds(3)));
+}
@@ -0,0 +1,137 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "Basics/Exceptions.h"
+#include "Indexes/IndexHistogram.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+namespace {
+VPackBuilder numbers(int from, int to) {
+  VPackBuilder builder;
+  builder.openArray();
+  // insert in reverse order, the histogram must not care
+  for (int i = to - 1; i >= from; --i) {
+    builder.add(VPackValue(i));
+  }
+  builder.close();
+  return builder;
+}
+
+VPackBuilder value(int v) {
+  VPackBuilder builder;
+  builder.add(VPackValue(v));
+  return builder;
+}
+
+VPackSlice const none = VPackSlice::noneSlice();
+}  // namespace
+
+TEST(IndexHistogramTest, test_empty) {
+  VPackBuilder samples = numbers(0, 0);
+  IndexHistogram histogram(samples.slice());
+  EXPECT_EQ(0, histogram.numSamples());
+  EXPECT_EQ(0, histogram.numBounds());
+  EXPECT_EQ(1.0, histogram.estimateRange(none, true, none, true));
+}
+
+TEST(IndexHistogramTest, test_uniform_ranges) {
+  VPackBuilder samples = numbers(0, 1000);
+  IndexHistogram histogram(samples.slice());
+  EXPECT_EQ(1000, histogram.numSamples());
+
+  EXPECT_NEAR(1.0, histogram.estimateRange(none, true, none, true), 0.0001);
+  EXPECT_NEAR(0.1, histogram.estimateRange(none, true, value(100).slice(), false), 0.01);
+  EXPECT_NEAR(0.5, histogram.estimateRange(value(500).slice(), true, none, true), 0.01);
+  EXPECT_NEAR(0.25, histogram.estimateRange(value(250).slice(), true,
+                                            value(500).slice(), false),
+              0.01);
+
+  // out of the sampled range
+  EXPECT_EQ(0.0, histogram.estimateRange(value(2000).slice(), true, none, true));
+  EXPECT_EQ(0.0, histogram.estimateRange(none, true, value(-5).slice(), true));
+  // empty range
+  EXPECT_EQ(0.0, histogram.estimateRange(value(600).slice(), true,
+                                         value(500).slice(), true));
+}
+
+TEST(IndexHistogramTest, test_skewed_values) {
+  // 90% of the values are 0, the rest is spread over 1 to 100
+  VPackBuilder samples;
+  samples.openArray();
+  for (int i = 0; i < 900; ++i) {
+    samples.add(VPackValue(0));
+  }
+  for (int i = 1; i <= 100; ++i) {
+    samples.add(VPackValue(i));
+  }
+  samples.close();
+
+  IndexHistogram histogram(samples.slice());
+  EXPECT_NEAR(0.9, histogram.estimateRange(none, true, value(0).slice(), true), 0.0001);
+  EXPECT_NEAR(0.1, histogram.estimateRange(value(0).slice(), false, none, true), 0.0001);
+  EXPECT_NEAR(0.05, histogram.estimateRange(value(50).slice(), false, none, true), 0.01);
+}
+
+TEST(IndexHistogramTest, test_mixed_types) {
+  // values are ordered like in AQL: null < bool < number < string
+  VPackBuilder samples;
+  samples.openArray();
+  for (int i = 0; i < 100; ++i) {
+    samples.add(VPackSlice::nullSlice());
+    samples.add(VPackValue(i));
+    samples.add(VPackValue("abc" + std::to_string(i)));
+  }
+  samples.close();
+
+  IndexHistogram histogram(samples.slice());
+  VPackBuilder a;
+  a.add(VPackValue("a"));
+  EXPECT_NEAR(1.0 / 3.0, histogram.estimateRange(a.slice(), true, none, true), 0.01);
+  EXPECT_NEAR(2.0 / 3.0, histogram.estimateRange(none, true, a.slice(), false), 0.01);
+}
+
+TEST(IndexHistogramTest, test_persistence) {
+  VPackBuilder samples = numbers(0, 1000);
+  IndexHistogram original(samples.slice(), 16);
+
+  VPackBuilder serialized;
+  original.toVelocyPack(serialized);
+  IndexHistogram restored(serialized.slice(), IndexHistogram::FromPersistent());
+
+  EXPECT_EQ(original.numSamples(), restored.numSamples());
+  EXPECT_EQ(original.numBounds(), restored.numBounds());
+  for (int i = 0; i < 1000; i += 37) {
+    EXPECT_EQ(original.estimateRange(value(i).slice(), true, none, true),
+              restored.estimateRange(value(i).slice(), true, none, true));
+  }
+
+  VPackBuilder invalid;
+  invalid.openObject();
+  invalid.add("bounds", VPackValue(1));
+  invalid.close();
+  EXPECT_THROW(IndexHistogram(invalid.slice(), IndexHistogram::FromPersistent()),
+               basics::Exception);
+}
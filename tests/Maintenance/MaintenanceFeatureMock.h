@@ -104,6 +104,8 @@ public:
 
   void setSecondsActionsBlock(uint32_t seconds) { _secondsActionsBlock = seconds; }
 
+  void setActionLimit(std::string const& name, size_t limit) { _actionLimits[name] = limit; }
+
   /// @brief set thread count, then activate the threads via start().  One time usage only.
   ///   Code waits until background ApplicationServer known to have fully started.
   void setMaintenanceThreadsMax(uint32_t threads) {
@@ -394,6 +394,49 @@ TEST_F(MaintenanceFeatureTestUnthreaded, iterate_action_100_times_fail) {
   ASSERT_TRUE(tf._recentAction->getLastStatTime() <= tf._recentAction->getDoneTime());
 }
 
+TEST_F(MaintenanceFeatureTestUnthreaded, action_concurrency_limit_defers_actions) {
+  std::shared_ptr<arangodb::options::ProgramOptions> po =
+      std::make_shared<arangodb::options::ProgramOptions>("test", std::string(),
+                                                          std::string(), "path");
+  arangodb::application_features::ApplicationServer as(po, nullptr);
+
+  TestMaintenanceFeature tf(as);
+  tf.setActionLimit("TestActionBasic", 1);
+
+  auto add = [&tf](std::string const& name, std::string const& count) {
+    std::unique_ptr<ActionBase> action_base_ptr;
+    action_base_ptr.reset((ActionBase*)new TestActionBasic(
+        tf, ActionDescription(std::map<std::string, std::string>{{"name", name},
+                                                                 {"iterate_count", count}},
+                              arangodb::maintenance::NORMAL_PRIORITY)));
+    arangodb::Result result =
+        tf.addAction(std::make_shared<Action>(std::move(action_base_ptr)), false);
+    ASSERT_TRUE(result.ok());
+  };
+  add("TestActionBasic", "1");
+  add("TestActionBasic", "2");
+  add("TestActionOther", "1");
+
+  // the second TestActionBasic must wait for the first one, although it is
+  // older than TestActionOther
+  auto first = tf.findReadyAction();
+  ASSERT_NE(nullptr, first);
+  ASSERT_EQ("TestActionBasic", first->describe().name());
+  ASSERT_EQ("1", first->describe().get("iterate_count"));
+  first->setState(EXECUTING);
+
+  auto second = tf.findReadyAction();
+  ASSERT_NE(nullptr, second);
+  ASSERT_EQ("TestActionOther", second->describe().name());
+  second->setState(EXECUTING);
+
+  tf.actionFinished("TestActionBasic");
+  auto third = tf.findReadyAction();
+  ASSERT_NE(nullptr, third);
+  ASSERT_EQ("TestActionBasic", third->describe().name());
+  ASSERT_EQ("2", third->describe().get("iterate_count"));
+}
+
 TEST(MaintenanceFeatureTestThreaded, populate_action_queue_and_validate) {
   std::vector<Expected> pre_thread, post_thread;
 
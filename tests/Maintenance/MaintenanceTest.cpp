@@ -841,4 +841,36 @@ TEST_F(MaintenanceTestActionPhaseOne, removed_follower_in_plan_must_be_dropped)
   }
 }
 
+TEST(MaintenanceTestApproximateCount, follows_large_changes_only) {
+  using arangodb::maintenance::approximateCountForCurrent;
+
+  // nothing reported so far
+  ASSERT_EQ(1234, approximateCountForCurrent(1234, VPackSlice::noneSlice()));
+  ASSERT_EQ(1234, approximateCountForCurrent(1234, VPackSlice::emptyObjectSlice()));
+
+  VPackBuilder current;
+  {
+    VPackObjectBuilder o(&current);
+    current.add(APPROXIMATE_COUNT, VPackValue(10000));
+  }
+
+  // within one percent, keep what is in current
+  ASSERT_EQ(10000, approximateCountForCurrent(10000, current.slice()));
+  ASSERT_EQ(10000, approximateCountForCurrent(10100, current.slice()));
+  ASSERT_EQ(10000, approximateCountForCurrent(9900, current.slice()));
+
+  // report larger changes
+  ASSERT_EQ(10101, approximateCountForCurrent(10101, current.slice()));
+  ASSERT_EQ(9899, approximateCountForCurrent(9899, current.slice()));
+  ASSERT_EQ(0, approximateCountForCurrent(0, current.slice()));
+
+  // small collections are reported exactly
+  current.clear();
+  {
+    VPackObjectBuilder o(&current);
+    current.add(APPROXIMATE_COUNT, VPackValue(0));
+  }
+  ASSERT_EQ(1, approximateCountForCurrent(1, current.slice()));
+}
+
 #endif
@@ -672,6 +672,11 @@ uint64_t PhysicalCollectionMock::numberDocuments(arangodb::transaction::Methods*
   return documents.size();
 }
 
+uint64_t PhysicalCollectionMock::approximateNumberDocuments() const {
+  before();
+  return documents.size();
+}
+
 void PhysicalCollectionMock::open(bool ignoreErrors) {
   before();
   TRI_ASSERT(false);
@@ -72,6 +72,7 @@ class PhysicalCollectionMock: public arangodb::PhysicalCollection {
   virtual arangodb::LocalDocumentId lookupKey(arangodb::transaction::Methods*, arangodb::velocypack::Slice const&) const override;
   virtual size_t memory() const override;
   virtual uint64_t numberDocuments(arangodb::transaction::Methods* trx) const override;
+  virtual uint64_t approximateNumberDocuments() const override;
   virtual void open(bool ignoreErrors) override;
   virtual std::string const& path() const override;
   virtual arangodb::Result persistProperties() override;
@@ -0,0 +1,141 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+#include "Network/ConnectionPool.h"
+
+#include <fuerte/connection.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+using namespace arangodb;
+using namespace arangodb::network;
+
+namespace {
+/// @brief a socket that accepts connections in the kernel backlog, but
+/// never answers. connections to it stay open until they are cancelled
+class Listener {
+ public:
+  Listener() : _fd(::socket(AF_INET, SOCK_STREAM, 0)) {
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    ::bind(_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    ::listen(_fd, 64);
+    socklen_t len = sizeof(addr);
+    ::getsockname(_fd, reinterpret_cast<sockaddr*>(&addr), &len);
+    _endpoint = "tcp://127.0.0.1:" + std::to_string(ntohs(addr.sin_port));
+  }
+  ~Listener() { ::close(_fd); }
+
+  std::string const& endpoint() const { return _endpoint; }
+
+ private:
+  int _fd;
+  std::string _endpoint;
+};
+
+ConnectionPool::Config makeConfig() {
+  ConnectionPool::Config config;
+  config.numIOThreads = 1;
+  config.maxOpenConnections = 2;
+  config.protocol = fuerte::ProtocolType::Http;
+  return config;
+}
+}  // namespace
+
+TEST(ConnectionPoolTest, test_connections_are_shared) {
+  Listener listener;
+  ConnectionPool pool(makeConfig());
+
+  auto c1 = pool.leaseConnection(listener.endpoint());
+  auto c2 = pool.leaseConnection(listener.endpoint());
+  ASSERT_NE(nullptr, c1);
+  EXPECT_EQ(c1, c2);
+  EXPECT_EQ(1, pool.numOpenConnections());
+}
+
+TEST(ConnectionPoolTest, test_busy_connections_open_new_ones_up_to_the_limit) {
+  Listener listener;
+  auto config = makeConfig();
+  // every connection counts as busy
+  config.maxRequestsPerConnection = 0;
+  ConnectionPool pool(config);
+
+  auto c1 = pool.leaseConnection(listener.endpoint());
+  auto c2 = pool.leaseConnection(listener.endpoint());
+  EXPECT_NE(c1, c2);
+  EXPECT_EQ(2, pool.numOpenConnections());
+
+  // the limit is reached, the existing connections are reused
+  auto c3 = pool.leaseConnection(listener.endpoint());
+  EXPECT_TRUE(c3 == c1 || c3 == c2);
+  EXPECT_EQ(2, pool.numOpenConnections());
+}
+
+TEST(ConnectionPoolTest, test_endpoints_are_separated) {
+  Listener l1;
+  Listener l2;
+  ConnectionPool pool(makeConfig());
+
+  auto c1 = pool.leaseConnection(l1.endpoint());
+  auto c2 = pool.leaseConnection(l2.endpoint());
+  EXPECT_NE(c1, c2);
+  EXPECT_EQ(2, pool.numOpenConnections());
+}
+
+TEST(ConnectionPoolTest, test_idle_connections_are_pruned) {
+  Listener listener;
+  auto config = makeConfig();
+  config.idleConnectionTimeout = std::chrono::milliseconds(1);
+  ConnectionPool pool(config);
+
+  pool.leaseConnection(listener.endpoint());
+  EXPECT_EQ(1, pool.numOpenConnections());
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  pool.pruneConnections();
+  EXPECT_EQ(0, pool.numOpenConnections());
+}
+
+TEST(ConnectionPoolTest, test_drain_and_shutdown) {
+  Listener listener;
+  ConnectionPool pool(makeConfig());
+
+  pool.leaseConnection(listener.endpoint());
+  pool.drainConnections();
+  EXPECT_EQ(0, pool.numOpenConnections());
+
+  // the pool can still be used after draining
+  EXPECT_NE(nullptr, pool.leaseConnection(listener.endpoint()));
+  EXPECT_EQ(1, pool.numOpenConnections());
+
+  pool.shutdown();
+  EXPECT_EQ(0, pool.numOpenConnections());
+  EXPECT_EQ(nullptr, pool.leaseConnection(listener.endpoint()));
+  EXPECT_EQ(0, pool.numOpenConnections());
+}
@@ -0,0 +1,72 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+#include "Basics/voc-errors.h"
+#include "Network/Methods.h"
+#include "Network/NetworkFeature.h"
+
+#include "gtest/gtest.h"
+
+using namespace arangodb;
+using namespace arangodb::network;
+
+TEST(NetworkMethodsTest, test_error_codes) {
+  EXPECT_EQ(TRI_ERROR_NO_ERROR, fuerteToArangoErrorCode(fuerte::Error::NoError));
+  EXPECT_EQ(TRI_ERROR_CLUSTER_BACKEND_UNAVAILABLE,
+            fuerteToArangoErrorCode(fuerte::Error::CouldNotConnect));
+  EXPECT_EQ(TRI_ERROR_CLUSTER_CONNECTION_LOST,
+            fuerteToArangoErrorCode(fuerte::Error::ConnectionClosed));
+  EXPECT_EQ(TRI_ERROR_CLUSTER_CONNECTION_LOST,
+            fuerteToArangoErrorCode(fuerte::Error::ReadError));
+  EXPECT_EQ(TRI_ERROR_CLUSTER_TIMEOUT, fuerteToArangoErrorCode(fuerte::Error::Timeout));
+  EXPECT_EQ(TRI_ERROR_REQUEST_CANCELED, fuerteToArangoErrorCode(fuerte::Error::Canceled));
+  EXPECT_EQ(TRI_ERROR_INTERNAL, fuerteToArangoErrorCode(fuerte::Error::ProtocolError));
+}
+
+TEST(NetworkMethodsTest, test_response_without_answer) {
+  Response res{"server:PRMR-1", fuerte::Error::Timeout, nullptr};
+  EXPECT_FALSE(res.ok());
+  EXPECT_EQ(fuerte::StatusUndefined, res.statusCode());
+  EXPECT_EQ(TRI_ERROR_CLUSTER_TIMEOUT, res.errorCode());
+
+  Response noError{"server:PRMR-1", fuerte::Error::NoError, nullptr};
+  EXPECT_FALSE(noError.ok());
+}
+
+TEST(NetworkMethodsTest, test_resolve_destination) {
+  EXPECT_EQ("tcp://127.0.0.1:8529", resolveDestination("tcp://127.0.0.1:8529"));
+  EXPECT_EQ("ssl://[::1]:8530", resolveDestination("ssl://[::1]:8530"));
+  EXPECT_EQ("", resolveDestination("PRMR-1"));
+  EXPECT_EQ("", resolveDestination("http://127.0.0.1:8529"));
+}
+
+TEST(NetworkMethodsTest, test_send_without_pool) {
+  // the feature is not prepared in the unit tests
+  ASSERT_EQ(nullptr, NetworkFeature::pool());
+
+  auto res = sendRequest("tcp://127.0.0.1:8529", fuerte::RestVerb::Get,
+                         "/_api/version", velocypack::Buffer<uint8_t>(),
+                         Timeout(1.0))
+                 .get();
+  EXPECT_EQ("tcp://127.0.0.1:8529", res.destination);
+  EXPECT_EQ(fuerte::Error::Canceled, res.error);
+  EXPECT_FALSE(res.ok());
+}
@@ -0,0 +1,73 @@
+################################################################################
+## runs the performance tests with arangobench, called by the perfregression
+## and perfbaseline targets:
+##
+##   cmake -DARANGOBENCH=... -DENDPOINT=... -DWORKLOAD_DIR=... \
+##         -DBASELINE_DIR=... -DREPORT_DIR=... -P RunPerformanceTests.cmake
+##
+## every test writes a JSON report to REPORT_DIR. with RECORD_BASELINES the
+## reports are copied to BASELINE_DIR, otherwise arangobench compares them
+## with the baseline of the test and fails on regressions
+################################################################################
+
+foreach (var ARANGOBENCH ENDPOINT WORKLOAD_DIR BASELINE_DIR REPORT_DIR
+             REQUESTS CONCURRENCY MAX_REGRESSION)
+  if (NOT DEFINED ${var})
+    message(FATAL_ERROR "${var} is not set")
+  endif ()
+endforeach ()
+
+file(MAKE_DIRECTORY ${REPORT_DIR})
+
+# document CRUD through the REST API, with the built-in test cases, and the
+# AQL workloads
+set(TESTS crud document)
+file(GLOB WORKLOADS ${WORKLOAD_DIR}/*.json)
+foreach (workload ${WORKLOADS})
+  get_filename_component(name ${workload} NAME_WE)
+  list(APPEND TESTS ${name})
+endforeach ()
+
+set(FAILED)
+foreach (test ${TESTS})
+  set(report ${REPORT_DIR}/${test}.json)
+  set(baseline ${BASELINE_DIR}/${test}.json)
+
+  set(args
+    --server.endpoint ${ENDPOINT}
+    --requests ${REQUESTS}
+    --concurrency ${CONCURRENCY}
+    --runs 3
+    --progress false
+    --quiet true
+    --json-report-file ${report}
+  )
+  if (EXISTS ${WORKLOAD_DIR}/${test}.json)
+    list(APPEND args --test-case workload --workload-file ${WORKLOAD_DIR}/${test}.json)
+  else ()
+    list(APPEND args --test-case ${test} --collection perf_${test}
+      --number-of-shards 3 --complexity 4)
+  endif ()
+  if (NOT RECORD_BASELINES)
+    if (EXISTS ${baseline})
+      list(APPEND args --baseline-file ${baseline} --max-regression ${MAX_REGRESSION})
+    else ()
+      message(WARNING "no baseline for performance test '${test}' in ${BASELINE_DIR}")
+    endif ()
+  endif ()
+
+  message(STATUS "performance test '${test}'")
+  execute_process(
+    COMMAND ${ARANGOBENCH} ${args} ${OPTIONS}
+    RESULT_VARIABLE result
+  )
+  if (NOT result EQUAL 0)
+    list(APPEND FAILED ${test})
+  elseif (RECORD_BASELINES)
+    file(COPY ${report} DESTINATION ${BASELINE_DIR})
+  endif ()
+endforeach ()
+
+if (FAILED)
+  message(FATAL_ERROR "failed performance tests: ${FAILED}")
+endif ()
@@ -0,0 +1,179 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+#include "Basics/Exceptions.h"
+#include "RocksDBEngine/RocksDBDocumentDictionary.h"
+#include "RocksDBEngine/RocksDBFormat.h"
+
+#include "gtest/gtest.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+namespace {
+std::shared_ptr<VPackBuilder> makeDocument(size_t i) {
+  return VPackParser::fromJson(
+      "{\"_key\":\"" + std::to_string(i) + "\",\"_rev\":\"_Z7cVp3a--" +
+      std::to_string(i % 10) +
+      "\",\"customer\":{\"name\":\"customer " + std::to_string(i) +
+      "\",\"country\":\"DE\",\"active\":true},\"status\":\"shipped\","
+      "\"items\":[{\"sku\":\"A-100\",\"quantity\":" + std::to_string(i % 7) +
+      "},{\"sku\":\"B-200\",\"quantity\":1}]}");
+}
+
+std::unique_ptr<RocksDBDocumentDictionary> makeDictionary() {
+  std::string samples;
+  for (size_t i = 0; i < 1000; ++i) {
+    auto doc = makeDocument(i);
+    samples.append(doc->slice().startAs<char>(), doc->slice().byteSize());
+  }
+  return std::make_unique<RocksDBDocumentDictionary>(RocksDBDocumentDictionary::build(samples));
+}
+
+rocksdb::Slice toValue(VPackSlice slice) {
+  return rocksdb::Slice(slice.startAs<char>(), static_cast<size_t>(slice.byteSize()));
+}
+}  // namespace
+
+class RocksDBDocumentDictionaryTest : public ::testing::Test {
+ protected:
+  RocksDBDocumentDictionaryTest() {
+    // the uncompressed size in the header is stored in the key format
+    rocksutils::setRocksDBKeyFormatEndianess(RocksDBEndianness::Little);
+  }
+};
+
+TEST_F(RocksDBDocumentDictionaryTest, test_build) {
+  EXPECT_EQ("abc", RocksDBDocumentDictionary::build("abc"));
+
+  // the most recent samples are kept
+  std::string samples(RocksDBDocumentDictionary::maxSize, 'a');
+  samples.append(100, 'b');
+  std::string data = RocksDBDocumentDictionary::build(samples);
+  EXPECT_EQ(RocksDBDocumentDictionary::maxSize, data.size());
+  EXPECT_EQ(std::string(100, 'b'), data.substr(data.size() - 100));
+
+  EXPECT_THROW(std::make_unique<RocksDBDocumentDictionary>(std::string()), basics::Exception);
+  EXPECT_THROW(std::make_unique<RocksDBDocumentDictionary>(
+                   std::string(RocksDBDocumentDictionary::maxSize + 1, 'a')),
+               basics::Exception);
+}
+
+TEST_F(RocksDBDocumentDictionaryTest, test_roundtrip) {
+  auto dictionary = makeDictionary();
+  EXPECT_EQ(RocksDBDocumentDictionary::maxSize, dictionary->size());
+
+  // a document that is not part of the samples
+  auto doc = makeDocument(123456);
+  std::string compressed;
+  ASSERT_TRUE(dictionary->compress(doc->slice(), compressed));
+  EXPECT_TRUE(RocksDBDocumentDictionary::isCompressed(compressed));
+  EXPECT_LT(compressed.size(), doc->slice().byteSize() / 2);
+
+  std::string buffer;
+  VPackSlice result = dictionary->uncompress(compressed, buffer);
+  ASSERT_EQ(doc->slice().byteSize(), result.byteSize());
+  EXPECT_EQ(0, memcmp(doc->slice().start(), result.start(), result.byteSize()));
+  EXPECT_EQ("123456", result.get("_key").copyString());
+}
+
+TEST_F(RocksDBDocumentDictionaryTest, test_persisted_dictionary) {
+  auto dictionary = makeDictionary();
+  auto doc = makeDocument(42);
+  std::string compressed;
+  ASSERT_TRUE(dictionary->compress(doc->slice(), compressed));
+
+  VPackBuilder builder;
+  dictionary->toVelocyPack(builder);
+  RocksDBDocumentDictionary restored(builder.slice());
+  EXPECT_EQ(dictionary->size(), restored.size());
+
+  std::string buffer;
+  VPackSlice result = restored.uncompress(compressed, buffer);
+  ASSERT_EQ(doc->slice().byteSize(), result.byteSize());
+  EXPECT_EQ(0, memcmp(doc->slice().start(), result.start(), result.byteSize()));
+
+  EXPECT_THROW(std::make_unique<RocksDBDocumentDictionary>(VPackSlice::emptyObjectSlice()),
+               basics::Exception);
+}
+
+TEST_F(RocksDBDocumentDictionaryTest, test_uncompressed_values) {
+  auto dictionary = makeDictionary();
+
+  // values written before compression was enabled are plain documents
+  auto doc = makeDocument(1);
+  EXPECT_FALSE(RocksDBDocumentDictionary::isCompressed(toValue(doc->slice())));
+  EXPECT_FALSE(RocksDBDocumentDictionary::isCompressed(
+      toValue(VPackSlice::emptyObjectSlice())));
+  EXPECT_FALSE(RocksDBDocumentDictionary::isCompressed(rocksdb::Slice()));
+
+  // small documents are stored as they are
+  auto small = VPackParser::fromJson("{\"_key\":\"a\"}");
+  std::string out;
+  EXPECT_FALSE(dictionary->compress(small->slice(), out));
+
+  // so are documents that do not compress well
+  std::string random;
+  uint64_t x = 0x9e3779b97f4a7c15ULL;
+  for (size_t i = 0; i < 512; ++i) {
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    random.push_back(static_cast<char>('!' + (x % 90)));
+  }
+  VPackBuilder noise;
+  noise.openObject();
+  noise.add("_key", VPackValue(random));
+  noise.close();
+  EXPECT_FALSE(dictionary->compress(noise.slice(), out));
+}
+
+TEST_F(RocksDBDocumentDictionaryTest, test_corrupt_values) {
+  auto dictionary = makeDictionary();
+  auto doc = makeDocument(7);
+  std::string compressed;
+  ASSERT_TRUE(dictionary->compress(doc->slice(), compressed));
+  std::string buffer;
+
+  // only the header
+  std::string header = compressed.substr(0, RocksDBDocumentDictionary::headerSize);
+  EXPECT_THROW(dictionary->uncompress(header, buffer), basics::Exception);
+  std::string marker = compressed.substr(0, 1);
+  EXPECT_THROW(dictionary->uncompress(marker, buffer), basics::Exception);
+
+  // truncated LZ4 block
+  std::string truncated = compressed.substr(0, compressed.size() - 5);
+  EXPECT_THROW(dictionary->uncompress(truncated, buffer), basics::Exception);
+
+  // uncompressed size that does not match the block
+  std::string wrongSize = compressed.substr(0, 1);
+  rocksutils::uint32ToPersistent(wrongSize, static_cast<uint32_t>(doc->slice().byteSize() + 1));
+  wrongSize.append(compressed.substr(RocksDBDocumentDictionary::headerSize));
+  EXPECT_THROW(dictionary->uncompress(wrongSize, buffer), basics::Exception);
+
+  std::string zeroSize = compressed.substr(0, 1);
+  rocksutils::uint32ToPersistent(zeroSize, 0);
+  zeroSize.append(compressed.substr(RocksDBDocumentDictionary::headerSize));
+  EXPECT_THROW(dictionary->uncompress(zeroSize, buffer), basics::Exception);
+}
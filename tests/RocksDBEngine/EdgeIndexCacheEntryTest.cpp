@@ -0,0 +1,119 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "RocksDBEngine/RocksDBEdgeIndexCacheEntry.h"
+
+#include <velocypack/StringRef.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+namespace {
+std::string vertexFor(size_t i) {
+  return "v/" + std::to_string(i % 7);
+}
+}  // namespace
+
+TEST(RocksDBEdgeIndexCacheEntryTest, test_empty) {
+  RocksDBEdgeIndexCacheEncoder encoder;
+  std::vector<std::string> chunks = encoder.finish();
+  ASSERT_EQ(1u, chunks.size());
+
+  RocksDBEdgeIndexCacheDecoder decoder;
+  ASSERT_TRUE(decoder.start(reinterpret_cast<uint8_t const*>(chunks[0].data()),
+                            chunks[0].size()));
+  LocalDocumentId docId;
+  VPackSlice vertexId;
+  ASSERT_FALSE(decoder.next(docId, vertexId));
+  ASSERT_FALSE(decoder.needsChunk());
+}
+
+TEST(RocksDBEdgeIndexCacheEntryTest, test_roundtrip_chunks) {
+  size_t const n = 2 * RocksDBEdgeIndexCacheEntry::edgesPerChunk + 17;
+  RocksDBEdgeIndexCacheEncoder encoder;
+  for (size_t i = 0; i < n; ++i) {
+    std::string v = vertexFor(i);
+    // ids are not strictly increasing
+    encoder.add(LocalDocumentId(1000000 + i * 3 - (i % 2) * 5), velocypack::StringRef(v));
+  }
+  std::vector<std::string> chunks = encoder.finish();
+  ASSERT_EQ(3u, chunks.size());
+
+  RocksDBEdgeIndexCacheDecoder decoder;
+  ASSERT_TRUE(decoder.start(reinterpret_cast<uint8_t const*>(chunks[0].data()),
+                            chunks[0].size()));
+  size_t i = 0;
+  while (true) {
+    LocalDocumentId docId;
+    VPackSlice vertexId;
+    while (decoder.next(docId, vertexId)) {
+      ASSERT_EQ(1000000 + i * 3 - (i % 2) * 5, docId.id());
+      ASSERT_TRUE(vertexId.isString());
+      ASSERT_EQ(vertexFor(i), vertexId.copyString());
+      ++i;
+    }
+    if (!decoder.needsChunk()) {
+      break;
+    }
+    std::string const& chunk = chunks[decoder.nextChunk()];
+    ASSERT_TRUE(decoder.append(reinterpret_cast<uint8_t const*>(chunk.data()), chunk.size()));
+  }
+  ASSERT_EQ(n, i);
+  ASSERT_EQ(n, decoder.returned());
+}
+
+TEST(RocksDBEdgeIndexCacheEntryTest, test_chunk_of_other_fill_is_rejected) {
+  size_t const n = RocksDBEdgeIndexCacheEntry::edgesPerChunk + 1;
+  RocksDBEdgeIndexCacheEncoder encoder;
+  for (size_t i = 0; i < n; ++i) {
+    encoder.add(LocalDocumentId(i + 1), velocypack::StringRef("v/1"));
+  }
+  std::vector<std::string> first = encoder.finish();
+  for (size_t i = 0; i < n; ++i) {
+    encoder.add(LocalDocumentId(i + 1), velocypack::StringRef("v/1"));
+  }
+  std::vector<std::string> second = encoder.finish();
+  ASSERT_EQ(2u, first.size());
+  ASSERT_EQ(2u, second.size());
+
+  RocksDBEdgeIndexCacheDecoder decoder;
+  ASSERT_TRUE(decoder.start(reinterpret_cast<uint8_t const*>(first[0].data()),
+                            first[0].size()));
+  LocalDocumentId docId;
+  VPackSlice vertexId;
+  while (decoder.next(docId, vertexId)) {
+  }
+  ASSERT_TRUE(decoder.needsChunk());
+  ASSERT_FALSE(decoder.append(reinterpret_cast<uint8_t const*>(second[1].data()),
+                              second[1].size()));
+  ASSERT_FALSE(decoder.needsChunk());
+  ASSERT_EQ(RocksDBEdgeIndexCacheEntry::edgesPerChunk, decoder.returned());
+}
+
+TEST(RocksDBEdgeIndexCacheEntryTest, test_chunk_keys) {
+  velocypack::StringRef fromTo("v/1");
+  ASSERT_EQ("v/1", RocksDBEdgeIndexCacheEntry::chunkKey(fromTo, 0));
+  std::string key = RocksDBEdgeIndexCacheEntry::chunkKey(fromTo, 1);
+  ASSERT_NE("v/1", key);
+  ASSERT_FALSE(RocksDBEdgeIndexCacheEntry::isChunkKey(fromTo));
+  ASSERT_TRUE(RocksDBEdgeIndexCacheEntry::isChunkKey(velocypack::StringRef(key)));
+}
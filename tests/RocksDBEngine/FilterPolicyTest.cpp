@@ -0,0 +1,108 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for the counting RocksDB bloom filter policy
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+#include "gtest/gtest.h"
+
+#include "RocksDBEngine/RocksDBFilterPolicy.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+using namespace arangodb;
+
+namespace {
+
+std::vector<std::string> makeKeys(std::string const& prefix, size_t n) {
+  std::vector<std::string> keys;
+  for (size_t i = 0; i < n; ++i) {
+    keys.emplace_back(prefix + std::to_string(i));
+  }
+  return keys;
+}
+
+}  // namespace
+
+TEST(RocksDBFilterPolicyTest, test_name_is_passed_through) {
+  std::unique_ptr<rocksdb::FilterPolicy const> builtin(rocksdb::NewBloomFilterPolicy(10, false));
+  RocksDBFilterPolicy policy(10, false);
+  EXPECT_EQ(std::string(builtin->Name()), std::string(policy.Name()));
+}
+
+TEST(RocksDBFilterPolicyTest, test_full_filter_counts) {
+  RocksDBFilterPolicy policy(10, false);
+  std::unique_ptr<rocksdb::FilterBitsBuilder> builder(policy.GetFilterBitsBuilder());
+  ASSERT_NE(nullptr, builder);
+
+  auto keys = makeKeys("present", 1000);
+  for (auto const& k : keys) {
+    builder->AddKey(k);
+  }
+  std::unique_ptr<char const[]> buf;
+  rocksdb::Slice contents = builder->Finish(&buf);
+
+  std::unique_ptr<rocksdb::FilterBitsReader> reader(policy.GetFilterBitsReader(contents));
+  ASSERT_NE(nullptr, reader);
+
+  for (auto const& k : keys) {
+    EXPECT_TRUE(reader->MayMatch(k));
+  }
+  EXPECT_EQ(1000, policy.checked());
+  EXPECT_EQ(0, policy.useful());
+
+  for (auto const& k : makeKeys("absent", 1000)) {
+    reader->MayMatch(k);
+  }
+  EXPECT_EQ(2000, policy.checked());
+  // about 1% false positives with 10 bits per key
+  EXPECT_GT(policy.useful(), 950);
+  EXPECT_LE(policy.useful(), 1000);
+}
+
+TEST(RocksDBFilterPolicyTest, test_block_based_filter_counts) {
+  RocksDBFilterPolicy policy(10, true);
+  EXPECT_EQ(nullptr, policy.GetFilterBitsBuilder());
+
+  auto keys = makeKeys("present", 100);
+  std::vector<rocksdb::Slice> slices(keys.begin(), keys.end());
+  std::string filter;
+  policy.CreateFilter(slices.data(), static_cast<int>(slices.size()), &filter);
+
+  for (auto const& k : keys) {
+    EXPECT_TRUE(policy.KeyMayMatch(k, filter));
+  }
+  for (auto const& k : makeKeys("absent", 100)) {
+    policy.KeyMayMatch(k, filter);
+  }
+  EXPECT_EQ(200, policy.checked());
+  EXPECT_GT(policy.useful(), 90);
+
+  VPackBuilder b;
+  b.openObject();
+  policy.toVelocyPack(b);
+  b.close();
+  EXPECT_EQ(200, b.slice().get("checked").getUInt());
+  EXPECT_EQ(policy.useful(), b.slice().get("useful").getUInt());
+  EXPECT_GT(b.slice().get("usefulRate").getDouble(), 0.9);
+}
@@ -138,6 +138,66 @@ TEST_F(IndexEstimatorTest, test_serialize_deserialize) {
   EXPECT_TRUE(est.computeEstimate() == copy.computeEstimate());
 }
 
+TEST_F(IndexEstimatorTest, test_sketch_serialize_deserialize) {
+  std::string serialization;
+  RocksDBCuckooIndexEstimator<uint64_t> est(2048);
+  for (uint64_t i = 0; i < 1000; ++i) {
+    est.insert(i % 100);
+  }
+
+  basics::HyperLogLog sketch;
+  uint64_t used = 0;
+  uint64_t total = 0;
+  EXPECT_TRUE(est.copySketch(sketch, used, total));
+  EXPECT_EQ(100, used);
+  EXPECT_EQ(1000, total);
+  EXPECT_GE(sketch.estimate(), 95.0);
+  EXPECT_LE(sketch.estimate(), 105.0);
+
+  est.serialize(serialization, 42);
+  arangodb::velocypack::StringRef ref(serialization);
+  EXPECT_TRUE(RocksDBCuckooIndexEstimator<uint64_t>::isFormatSupported(ref));
+  RocksDBCuckooIndexEstimator<uint64_t> copy(ref);
+
+  basics::HyperLogLog copied;
+  EXPECT_TRUE(copy.copySketch(copied, used, total));
+  EXPECT_EQ(sketch.estimate(), copied.estimate());
+  EXPECT_EQ(100, used);
+  EXPECT_EQ(1000, total);
+}
+
+TEST_F(IndexEstimatorTest, test_sketch_old_format) {
+  std::string serialization;
+  RocksDBCuckooIndexEstimator<uint64_t> est(2048);
+  for (uint64_t i = 0; i < 1000; ++i) {
+    est.insert(i);
+  }
+  est.serialize(serialization, 42);
+
+  // turn it into the format without sketch
+  serialization[sizeof(uint64_t)] = '1';
+  serialization.resize(serialization.size() - basics::HyperLogLog::serializedSize());
+  std::string length;
+  rocksutils::uint64ToPersistent(length, serialization.size() - sizeof(uint64_t));
+  serialization.replace(sizeof(uint64_t) + 1, sizeof(uint64_t), length);
+
+  arangodb::velocypack::StringRef ref(serialization);
+  RocksDBCuckooIndexEstimator<uint64_t> copy(ref);
+  EXPECT_EQ(est.computeEstimate(), copy.computeEstimate());
+
+  // the sketch does not know about the old values
+  basics::HyperLogLog sketch;
+  uint64_t used = 0;
+  uint64_t total = 0;
+  EXPECT_FALSE(copy.copySketch(sketch, used, total));
+
+  // until the estimate is rebuilt
+  copy.clear();
+  copy.insert(1);
+  EXPECT_TRUE(copy.copySketch(sketch, used, total));
+  EXPECT_EQ(1, used);
+}
+
 TEST_F(IndexEstimatorTest, test_blocker_logic_basic) {
   rocksdb::SequenceNumber currentSeq(0);
   rocksdb::SequenceNumber expected = currentSeq;
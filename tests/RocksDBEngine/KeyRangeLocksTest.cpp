@@ -0,0 +1,198 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+#include "RocksDBEngine/RocksDBKeyRangeLocks.h"
+
+#include "gtest/gtest.h"
+
+#include <thread>
+
+using namespace arangodb;
+
+TEST(RocksDBKeyRangeLocksTest, test_prefix_range) {
+  auto range = RocksDBKeyRangeLocks::prefixRange("tenantA:");
+  EXPECT_EQ("tenantA:", range.lower);
+  EXPECT_EQ("tenantA;", range.upper);
+  EXPECT_TRUE(range.contains(velocypack::StringRef("tenantA:")));
+  EXPECT_TRUE(range.contains(velocypack::StringRef("tenantA:123")));
+  EXPECT_FALSE(range.contains(velocypack::StringRef("tenantA")));
+  EXPECT_FALSE(range.contains(velocypack::StringRef("tenantB:123")));
+
+  // trailing 0xff bytes cannot be incremented
+  range = RocksDBKeyRangeLocks::prefixRange("a\xff");
+  EXPECT_EQ("b", range.upper);
+  range = RocksDBKeyRangeLocks::prefixRange("\xff\xff");
+  EXPECT_TRUE(range.upper.empty());
+  EXPECT_TRUE(range.contains(velocypack::StringRef("\xff\xff\xff")));
+
+  // the empty prefix covers all keys
+  range = RocksDBKeyRangeLocks::prefixRange("");
+  EXPECT_TRUE(range.contains(velocypack::StringRef("abc")));
+}
+
+TEST(RocksDBKeyRangeLocksTest, test_overlaps) {
+  auto a = RocksDBKeyRangeLocks::prefixRange("a");
+  auto ab = RocksDBKeyRangeLocks::prefixRange("ab");
+  auto b = RocksDBKeyRangeLocks::prefixRange("b");
+  auto all = RocksDBKeyRangeLocks::prefixRange("");
+
+  EXPECT_TRUE(a.overlaps(ab));
+  EXPECT_TRUE(ab.overlaps(a));
+  EXPECT_FALSE(a.overlaps(b));
+  EXPECT_FALSE(b.overlaps(a));
+  EXPECT_TRUE(all.overlaps(a));
+  EXPECT_TRUE(b.overlaps(all));
+}
+
+TEST(RocksDBKeyRangeLocksTest, test_disjoint_ranges_do_not_block) {
+  RocksDBKeyRangeLocks locks;
+  EXPECT_FALSE(locks.lockedByOthers(1));
+
+  EXPECT_EQ(TRI_ERROR_NO_ERROR,
+            locks.lock(1, {RocksDBKeyRangeLocks::prefixRange("tenantA:")}, 0.1));
+  EXPECT_EQ(TRI_ERROR_NO_ERROR,
+            locks.lock(2, {RocksDBKeyRangeLocks::prefixRange("tenantB:")}, 0.1));
+  EXPECT_TRUE(locks.lockedByOthers(1));
+
+  // overlapping ranges of other transactions block, own ranges do not
+  EXPECT_EQ(TRI_ERROR_LOCK_TIMEOUT,
+            locks.lock(3, {RocksDBKeyRangeLocks::prefixRange("tenantA:1")}, 0.01));
+  EXPECT_EQ(TRI_ERROR_NO_ERROR,
+            locks.lock(1, {RocksDBKeyRangeLocks::prefixRange("tenantA:1")}, 0.01));
+
+  EXPECT_EQ(TRI_ERROR_NO_ERROR,
+            locks.lockKey(1, velocypack::StringRef("tenantA:1"), 0.01));
+  EXPECT_EQ(TRI_ERROR_LOCK_TIMEOUT,
+            locks.lockKey(2, velocypack::StringRef("tenantA:1"), 0.01));
+  EXPECT_EQ(TRI_ERROR_NO_ERROR,
+            locks.lockKey(3, velocypack::StringRef("tenantC:1"), 0.01));
+
+  locks.unlock(1);
+  locks.unlock(2);
+  EXPECT_FALSE(locks.lockedByOthers(3));
+  EXPECT_EQ(TRI_ERROR_NO_ERROR,
+            locks.lockKey(3, velocypack::StringRef("tenantA:1"), 0.01));
+}
+
+TEST(RocksDBKeyRangeLocksTest, test_unlock_wakes_up_waiters) {
+  RocksDBKeyRangeLocks locks;
+  ASSERT_EQ(TRI_ERROR_NO_ERROR,
+            locks.lock(1, {RocksDBKeyRangeLocks::prefixRange("a")}, 0.1));
+
+  std::thread releaser([&locks]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    locks.unlock(1);
+  });
+  EXPECT_EQ(TRI_ERROR_NO_ERROR,
+            locks.lock(2, {RocksDBKeyRangeLocks::prefixRange("")}, 10.0));
+  releaser.join();
+  EXPECT_FALSE(locks.lockedByOthers(2));
+}
+
+TEST(RocksDBKeyRangeLocksTest, test_registered_keys_block_new_ranges) {
+  RocksDBKeyRangeLocks locks;
+
+  // a writer passes the check before any range is locked
+  ASSERT_EQ(TRI_ERROR_NO_ERROR,
+            locks.lockKey(1, velocypack::StringRef("tenantA:1"), 0.1));
+
+  // a range covering the uncommitted key must wait for the writer, other
+  // ranges and the writer's own ranges are granted
+  EXPECT_EQ(TRI_ERROR_LOCK_TIMEOUT,
+            locks.lock(2, {RocksDBKeyRangeLocks::prefixRange("tenantA:")}, 0.01));
+  EXPECT_EQ(TRI_ERROR_NO_ERROR,
+            locks.lock(2, {RocksDBKeyRangeLocks::prefixRange("tenantB:")}, 0.01));
+  EXPECT_EQ(TRI_ERROR_NO_ERROR,
+            locks.lock(1, {RocksDBKeyRangeLocks::prefixRange("tenantA:")}, 0.01));
+  locks.unlock(1);
+
+  // the key stays registered through commit, the range is granted after
+  ASSERT_EQ(TRI_ERROR_NO_ERROR,
+            locks.lockKey(3, velocypack::StringRef("tenantA:2"), 0.1));
+  std::thread committer([&locks]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    locks.unlock(3);
+  });
+  EXPECT_EQ(TRI_ERROR_NO_ERROR,
+            locks.lock(2, {RocksDBKeyRangeLocks::prefixRange("tenantA:")}, 10.0));
+  committer.join();
+
+  // and now new writers in the range wait for the range holder
+  EXPECT_EQ(TRI_ERROR_LOCK_TIMEOUT,
+            locks.lockKey(4, velocypack::StringRef("tenantA:3"), 0.01));
+  locks.unlock(2);
+}
+
+TEST(RocksDBKeyRangeLocksTest, test_interleaved_writers_and_lockers) {
+  // every key a writer registered before a range was granted must be
+  // released before the range holder runs, no matter how they interleave
+  RocksDBKeyRangeLocks locks;
+  std::atomic<bool> inRange(false);
+  std::atomic<int> violations(0);
+
+  std::vector<std::thread> writers;
+  for (TRI_voc_tid_t tid = 10; tid < 14; ++tid) {
+    writers.emplace_back([&locks, &inRange, &violations, tid]() {
+      for (int i = 0; i < 200; ++i) {
+        if (locks.lockKey(tid, velocypack::StringRef("tenantA:" + std::to_string(i)),
+                          10.0) == TRI_ERROR_NO_ERROR) {
+          if (inRange.load()) {
+            violations.fetch_add(1);
+          }
+        }
+        // commit
+        locks.unlock(tid);
+      }
+    });
+  }
+  std::thread locker([&locks, &inRange]() {
+    for (int i = 0; i < 50; ++i) {
+      ASSERT_EQ(TRI_ERROR_NO_ERROR,
+                locks.lock(1, {RocksDBKeyRangeLocks::prefixRange("tenantA:")}, 10.0));
+      inRange.store(true);
+      std::this_thread::yield();
+      inRange.store(false);
+      locks.unlock(1);
+    }
+  });
+
+  for (auto& writer : writers) {
+    writer.join();
+  }
+  locker.join();
+  EXPECT_EQ(0, violations.load());
+}
+
+TEST(RocksDBKeyRangeLocksTest, test_truncate_locks_all_keys) {
+  RocksDBKeyRangeLocks locks;
+  ASSERT_EQ(TRI_ERROR_NO_ERROR, locks.lockAllKeys(1));
+  EXPECT_EQ(TRI_ERROR_LOCK_TIMEOUT,
+            locks.lock(2, {RocksDBKeyRangeLocks::prefixRange("a")}, 0.01));
+  // writers are not affected
+  EXPECT_EQ(TRI_ERROR_NO_ERROR, locks.lockKey(3, velocypack::StringRef("a1"), 0.01));
+  locks.unlock(1);
+  locks.unlock(3);
+
+  ASSERT_EQ(TRI_ERROR_NO_ERROR,
+            locks.lock(2, {RocksDBKeyRangeLocks::prefixRange("a")}, 0.01));
+  EXPECT_EQ(TRI_ERROR_ARANGO_CONFLICT, locks.lockAllKeys(1));
+  locks.unlock(2);
+}
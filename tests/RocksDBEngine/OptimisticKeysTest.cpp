@@ -0,0 +1,239 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+#include "Basics/files.h"
+#include "RocksDBEngine/RocksDBOptimisticKeys.h"
+
+#include "gtest/gtest.h"
+
+#include <rocksdb/options.h>
+#include <rocksdb/utilities/transaction.h>
+#include <rocksdb/utilities/transaction_db.h>
+#include <rocksdb/utilities/write_batch_with_index.h>
+
+using namespace arangodb;
+
+class RocksDBOptimisticKeysTest : public ::testing::Test {
+ protected:
+  rocksdb::TransactionDB* _db = nullptr;
+  std::string _directory;
+  rocksdb::WriteOptions _wo;
+  rocksdb::TransactionOptions _trxOpts;
+
+  RocksDBOptimisticKeysTest() {
+    _directory = TRI_GetTempPath();
+    _directory.push_back(TRI_DIR_SEPARATOR_CHAR);
+    _directory.append("rocksdb-optimistic-keys-test");
+    TRI_RemoveDirectory(_directory.c_str());
+
+    rocksdb::Options options;
+    options.create_if_missing = true;
+    rocksdb::Status s = rocksdb::TransactionDB::Open(
+        options, rocksdb::TransactionDBOptions(), _directory, &_db);
+    EXPECT_TRUE(s.ok());
+    // like RocksDBTransactionState, validate against the snapshot taken
+    // when the transaction (or the segment after an intermediate commit)
+    // begins
+    _trxOpts.set_snapshot = true;
+  }
+
+  ~RocksDBOptimisticKeysTest() {
+    delete _db;
+    TRI_RemoveDirectory(_directory.c_str());
+  }
+
+  rocksdb::ColumnFamilyHandle* cf() const { return _db->DefaultColumnFamily(); }
+
+  void write(rocksdb::Transaction* trx, RocksDBOptimisticKeys& keys,
+             std::string const& key, std::string const& value) {
+    ASSERT_TRUE(keys.put(trx, cf(), key, value).ok());
+  }
+
+  std::string read(std::string const& key) {
+    std::string value;
+    _db->Get(rocksdb::ReadOptions(), cf(), key, &value);
+    return value;
+  }
+};
+
+TEST_F(RocksDBOptimisticKeysTest, test_use_for) {
+  EXPECT_TRUE(RocksDBOptimisticKeys::useFor(true, false));
+  EXPECT_FALSE(RocksDBOptimisticKeys::useFor(false, false));
+  // exclusive-only transactions fall back to the regular methods
+  EXPECT_FALSE(RocksDBOptimisticKeys::useFor(true, true));
+  EXPECT_FALSE(RocksDBOptimisticKeys::useFor(false, true));
+}
+
+TEST_F(RocksDBOptimisticKeysTest, test_commit_without_conflict) {
+  RocksDBOptimisticKeys keys;
+  std::unique_ptr<rocksdb::Transaction> trx(_db->BeginTransaction(_wo, _trxOpts));
+  EXPECT_TRUE(keys.validate(trx.get()).ok());
+
+  write(trx.get(), keys, "a", "1");
+  write(trx.get(), keys, "b", "1");
+  write(trx.get(), keys, "a", "2");
+  EXPECT_EQ(3, keys.size());
+
+  // other transactions may write other keys in the meantime
+  ASSERT_TRUE(_db->Put(_wo, cf(), "c", "1").ok());
+
+  Result res = keys.validate(trx.get());
+  EXPECT_TRUE(res.ok());
+  EXPECT_TRUE(keys.empty());
+  ASSERT_TRUE(trx->Commit().ok());
+  EXPECT_EQ("2", read("a"));
+  EXPECT_EQ("1", read("b"));
+}
+
+TEST_F(RocksDBOptimisticKeysTest, test_conflict_with_committed_write) {
+  RocksDBOptimisticKeys keys;
+  std::unique_ptr<rocksdb::Transaction> trx(_db->BeginTransaction(_wo, _trxOpts));
+  write(trx.get(), keys, "a", "1");
+
+  // nothing is locked, so another writer gets through and commits first.
+  // the transaction does not see the write, it has its own snapshot
+  ASSERT_TRUE(_db->Put(_wo, cf(), "a", "other").ok());
+
+  Result res = keys.validate(trx.get());
+  EXPECT_EQ(TRI_ERROR_ARANGO_CONFLICT, res.errorNumber());
+  EXPECT_FALSE(keys.empty());
+  ASSERT_TRUE(trx->Rollback().ok());
+  EXPECT_EQ("other", read("a"));
+}
+
+TEST_F(RocksDBOptimisticKeysTest, test_writes_do_not_lock) {
+  ASSERT_TRUE(_db->Put(_wo, cf(), "b", "1").ok());
+
+  RocksDBOptimisticKeys keys;
+  std::unique_ptr<rocksdb::Transaction> trx(_db->BeginTransaction(_wo, _trxOpts));
+  write(trx.get(), keys, "a", "1");
+  ASSERT_TRUE(keys.remove(trx.get(), cf(), "b").ok());
+  EXPECT_EQ(2, keys.size());
+
+  // the transaction sees its own writes
+  rocksdb::ReadOptions ro;
+  ro.snapshot = trx->GetSnapshot();
+  std::string value;
+  ASSERT_TRUE(trx->Get(ro, cf(), "a", &value).ok());
+  EXPECT_EQ("1", value);
+  EXPECT_TRUE(trx->Get(ro, cf(), "b", &value).IsNotFound());
+
+  // others can lock the keys without waiting
+  rocksdb::TransactionOptions opts;
+  opts.lock_timeout = 0;
+  std::unique_ptr<rocksdb::Transaction> other(_db->BeginTransaction(_wo, opts));
+  ASSERT_TRUE(other->Put(cf(), "a", "other").ok());
+  ASSERT_TRUE(other->Put(cf(), "b", "other").ok());
+  ASSERT_TRUE(other->Rollback().ok());
+
+  ASSERT_TRUE(keys.validate(trx.get()).ok());
+  // all operations are in the batch, the commit counts them from there
+  EXPECT_EQ(2, trx->GetWriteBatch()->GetWriteBatch()->Count());
+  ASSERT_TRUE(trx->Commit().ok());
+  EXPECT_EQ("1", read("a"));
+  EXPECT_EQ("", read("b"));
+}
+
+TEST_F(RocksDBOptimisticKeysTest, test_conflict_with_read_for_update) {
+  ASSERT_TRUE(_db->Put(_wo, cf(), "a", "1").ok());
+
+  RocksDBOptimisticKeys keys;
+  std::unique_ptr<rocksdb::Transaction> trx(_db->BeginTransaction(_wo, _trxOpts));
+  rocksdb::ReadOptions ro;
+  ro.snapshot = trx->GetSnapshot();
+  std::string value;
+  ASSERT_TRUE(trx->Get(ro, cf(), "a", &value).ok());
+  keys.track(cf(), "a");
+
+  ASSERT_TRUE(_db->Delete(_wo, cf(), "a").ok());
+  EXPECT_EQ(TRI_ERROR_ARANGO_CONFLICT, keys.validate(trx.get()).errorNumber());
+}
+
+TEST_F(RocksDBOptimisticKeysTest, test_conflict_with_locked_key) {
+  RocksDBOptimisticKeys keys;
+  std::unique_ptr<rocksdb::Transaction> trx(_db->BeginTransaction(_wo, _trxOpts));
+  write(trx.get(), keys, "a", "1");
+
+  // a pessimistic transaction holds the lock on the key, validation must
+  // not wait for it
+  std::unique_ptr<rocksdb::Transaction> other(_db->BeginTransaction(_wo));
+  ASSERT_TRUE(other->Put(cf(), "a", "other").ok());
+
+  EXPECT_EQ(TRI_ERROR_ARANGO_CONFLICT, keys.validate(trx.get()).errorNumber());
+  ASSERT_TRUE(trx->Rollback().ok());
+  ASSERT_TRUE(other->Commit().ok());
+  EXPECT_EQ("other", read("a"));
+}
+
+TEST_F(RocksDBOptimisticKeysTest, test_validated_keys_block_other_writers) {
+  RocksDBOptimisticKeys keys;
+  std::unique_ptr<rocksdb::Transaction> trx(_db->BeginTransaction(_wo, _trxOpts));
+  write(trx.get(), keys, "a", "1");
+  ASSERT_TRUE(keys.validate(trx.get()).ok());
+
+  // between validation and commit the keys are locked
+  rocksdb::TransactionOptions opts;
+  opts.lock_timeout = 0;
+  std::unique_ptr<rocksdb::Transaction> other(_db->BeginTransaction(_wo, opts));
+  rocksdb::Status s = other->Put(cf(), "a", "other");
+  EXPECT_TRUE(s.IsBusy() || s.IsTimedOut());
+  ASSERT_TRUE(other->Rollback().ok());
+
+  ASSERT_TRUE(trx->Commit().ok());
+  EXPECT_EQ("1", read("a"));
+}
+
+TEST_F(RocksDBOptimisticKeysTest, test_intermediate_commits) {
+  RocksDBOptimisticKeys keys;
+  rocksdb::Transaction* trx = _db->BeginTransaction(_wo, _trxOpts);
+  write(trx, keys, "a", "1");
+
+  // intermediate commit
+  ASSERT_TRUE(keys.validate(trx).ok());
+  ASSERT_TRUE(trx->Commit().ok());
+
+  // the next segment reuses the transaction, as RocksDBTransactionState
+  // does, and gets a new snapshot
+  trx = _db->BeginTransaction(_wo, _trxOpts, trx);
+  keys.clear();
+
+  // writes to keys of the committed segment are no conflict anymore
+  ASSERT_TRUE(_db->Put(_wo, cf(), "a", "other").ok());
+  write(trx, keys, "b", "1");
+  EXPECT_EQ(1, keys.size());
+  ASSERT_TRUE(keys.validate(trx).ok());
+  ASSERT_TRUE(trx->Commit().ok());
+  EXPECT_EQ("other", read("a"));
+  EXPECT_EQ("1", read("b"));
+
+  // but writes to keys of the running segment are
+  trx = _db->BeginTransaction(_wo, _trxOpts, trx);
+  keys.clear();
+  write(trx, keys, "c", "1");
+  ASSERT_TRUE(_db->Put(_wo, cf(), "c", "other").ok());
+  EXPECT_EQ(TRI_ERROR_ARANGO_CONFLICT, keys.validate(trx).errorNumber());
+  ASSERT_TRUE(trx->Rollback().ok());
+  delete trx;
+
+  // the earlier segments stay committed
+  EXPECT_EQ("1", read("b"));
+  EXPECT_EQ("other", read("c"));
+}
@@ -0,0 +1,190 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+#include "RocksDBEngine/RocksDBRecoveryWorkers.h"
+
+#include "gtest/gtest.h"
+
+#include <map>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <thread>
+
+using namespace arangodb;
+
+namespace {
+
+using Operation = RocksDBRecoveryWorkers::Operation;
+
+// an entry of a simulated WAL: a data change of a collection, a marker that
+// changes definitions (e.g. creating an index or dropping a collection), or a
+// data change of a collection that is not known (yet)
+struct Entry {
+  enum class Kind { Data, Definition, Unknown };
+  Kind kind;
+  TRI_voc_cid_t cid;
+};
+
+std::vector<Entry> makeWal(size_t size, TRI_voc_cid_t numCollections) {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> kind(0, 99);
+  std::uniform_int_distribution<TRI_voc_cid_t> cid(1, numCollections);
+  std::vector<Entry> wal;
+  for (size_t i = 0; i < size; ++i) {
+    int k = kind(gen);
+    if (k < 3) {
+      wal.push_back({Entry::Kind::Definition, cid(gen)});
+    } else if (k < 5) {
+      wal.push_back({Entry::Kind::Unknown, 0});
+    } else {
+      wal.push_back({Entry::Kind::Data, cid(gen)});
+    }
+  }
+  return wal;
+}
+
+// records the operations in the order they are applied
+class Recorder {
+ public:
+  void apply(Operation const& op) {
+    if (op.sequence % 7 == 0) {
+      // let the other threads overtake this one now and then
+      std::this_thread::yield();
+    }
+    std::lock_guard<std::mutex> guard(_mutex);
+    _applied[op.columnFamilyId].push_back(op.sequence);
+    ++_count;
+  }
+
+  size_t count() {
+    std::lock_guard<std::mutex> guard(_mutex);
+    return _count;
+  }
+
+  std::map<TRI_voc_cid_t, std::vector<rocksdb::SequenceNumber>> applied() {
+    std::lock_guard<std::mutex> guard(_mutex);
+    return _applied;
+  }
+
+ private:
+  std::mutex _mutex;
+  std::map<TRI_voc_cid_t, std::vector<rocksdb::SequenceNumber>> _applied;
+  size_t _count = 0;
+};
+
+// replays the WAL the way the recovery manager does. returns the number of
+// definition markers that did not see all earlier data changes applied
+size_t replay(RocksDBRecoveryWorkers& workers, Recorder& recorder,
+              std::vector<Entry> const& wal) {
+  size_t violations = 0;
+  size_t dispatched = 0;
+  for (size_t i = 0; i < wal.size(); ++i) {
+    Entry const& entry = wal[i];
+    Operation op{Operation::Type::Put, static_cast<uint32_t>(entry.cid),
+                 "key", "value", i + 1, 0};
+    switch (entry.kind) {
+      case Entry::Kind::Data:
+        ++dispatched;
+        if (workers.parallel()) {
+          workers.schedule(entry.cid, std::move(op));
+        } else {
+          recorder.apply(op);
+        }
+        break;
+      case Entry::Kind::Unknown:
+        ++dispatched;
+        workers.drain();
+        recorder.apply(op);
+        break;
+      case Entry::Kind::Definition:
+        workers.drain();
+        if (recorder.count() != dispatched) {
+          ++violations;
+        }
+        break;
+    }
+  }
+  workers.drain();
+  return violations;
+}
+
+void checkOrder(Recorder& recorder, std::vector<Entry> const& wal) {
+  std::map<TRI_voc_cid_t, std::vector<rocksdb::SequenceNumber>> expected;
+  for (size_t i = 0; i < wal.size(); ++i) {
+    if (wal[i].kind != Entry::Kind::Definition) {
+      expected[wal[i].cid].push_back(i + 1);
+    }
+  }
+  // each collection sees all of its changes, in WAL order
+  EXPECT_EQ(expected, recorder.applied());
+}
+
+}  // namespace
+
+TEST(RocksDBRecoveryWorkersTest, test_sequential_replay) {
+  Recorder recorder;
+  RocksDBRecoveryWorkers workers(1, [&recorder](Operation const& op) {
+    recorder.apply(op);
+  });
+  ASSERT_FALSE(workers.parallel());
+
+  auto wal = makeWal(2000, 5);
+  EXPECT_EQ(0, replay(workers, recorder, wal));
+  checkOrder(recorder, wal);
+  EXPECT_TRUE(workers.result().ok());
+}
+
+TEST(RocksDBRecoveryWorkersTest, test_parallel_replay_with_definitions) {
+  Recorder recorder;
+  RocksDBRecoveryWorkers workers(4, [&recorder](Operation const& op) {
+    recorder.apply(op);
+  });
+  ASSERT_TRUE(workers.parallel());
+
+  // more collections than threads, and enough entries to fill the queues
+  auto wal = makeWal(4 * RocksDBRecoveryWorkers::maxQueued, 11);
+  EXPECT_EQ(0, replay(workers, recorder, wal));
+  checkOrder(recorder, wal);
+  EXPECT_TRUE(workers.result().ok());
+}
+
+TEST(RocksDBRecoveryWorkersTest, test_first_error_is_kept) {
+  Recorder recorder;
+  RocksDBRecoveryWorkers workers(3, [&recorder](Operation const& op) {
+    if (op.sequence == 100 || op.sequence == 200) {
+      throw std::runtime_error("broken entry " + std::to_string(op.sequence));
+    }
+    recorder.apply(op);
+  });
+
+  std::vector<Entry> wal;
+  for (size_t i = 0; i < 300; ++i) {
+    wal.push_back({Entry::Kind::Data, 1});
+  }
+  EXPECT_EQ(0, replay(workers, recorder, wal));
+
+  // the other entries are still applied, and the first error is reported
+  EXPECT_EQ(298, recorder.count());
+  Result res = workers.result();
+  EXPECT_EQ(TRI_ERROR_INTERNAL, res.errorNumber());
+  EXPECT_EQ("broken entry 100", res.errorMessage());
+}
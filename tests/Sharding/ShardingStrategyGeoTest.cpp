@@ -0,0 +1,51 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "Sharding/ShardingStrategyGeo.h"
+
+#include <s2/s2latlng.h>
+
+using namespace arangodb;
+
+TEST(ShardingStrategyGeoTest, test_shard_index_covers_all_shards) {
+  size_t const numShards = 6;
+  // the six cube faces split evenly
+  for (int face = 0; face < S2CellId::kNumFaces; ++face) {
+    S2CellId cell = S2CellId::FromFace(face);
+    EXPECT_EQ(static_cast<size_t>(face),
+              ShardingStrategyGeo::shardIndex(cell.range_min(), numShards));
+    EXPECT_EQ(static_cast<size_t>(face),
+              ShardingStrategyGeo::shardIndex(cell.range_max(), numShards));
+  }
+}
+
+TEST(ShardingStrategyGeoTest, test_shard_index_keeps_neighbors_together) {
+  S2CellId a(S2LatLng::FromDegrees(52.5200, 13.4050));
+  S2CellId b(S2LatLng::FromDegrees(52.5201, 13.4051));
+  EXPECT_EQ(ShardingStrategyGeo::shardIndex(a, 16), ShardingStrategyGeo::shardIndex(b, 16));
+}
+
+TEST(ShardingStrategyGeoTest, test_shard_index_single_shard) {
+  S2CellId cell(S2LatLng::FromDegrees(-33.8688, 151.2093));
+  EXPECT_EQ(0, ShardingStrategyGeo::shardIndex(cell, 1));
+  EXPECT_EQ(0, ShardingStrategyGeo::shardIndex(S2CellId::FromFace(5).range_max(), 1));
+}
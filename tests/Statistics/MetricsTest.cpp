@@ -0,0 +1,75 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+#include "Statistics/Metrics.h"
+
+#include "gtest/gtest.h"
+
+using namespace arangodb::metrics;
+
+TEST(MetricsTest, test_histogram_buckets) {
+  Histogram histogram({1.0, 10.0, 100.0});
+  EXPECT_EQ((std::vector<uint64_t>{0, 0, 0, 0}), histogram.counts());
+
+  histogram.observe(0.5);
+  histogram.observe(1.0);
+  histogram.observe(5.0);
+  histogram.observe(100.0);
+  histogram.observe(1000.0);
+
+  // buckets include their bound, the last one takes everything else
+  EXPECT_EQ((std::vector<uint64_t>{2, 1, 1, 1}), histogram.counts());
+  EXPECT_DOUBLE_EQ(1106.5, histogram.sum());
+}
+
+TEST(MetricsTest, test_counter) {
+  Counter counter;
+  EXPECT_EQ(0, counter.load());
+  counter.count();
+  counter.count(41);
+  EXPECT_EQ(42, counter.load());
+}
+
+TEST(MetricsTest, test_prometheus_format) {
+  TransactionsStarted.count();
+  ClusterRequestTime.observe(0.002);
+
+  std::string result;
+  toPrometheus(result);
+
+  EXPECT_NE(std::string::npos,
+            result.find("# TYPE arangodb_transactions_started_total counter\n"));
+  EXPECT_NE(std::string::npos,
+            result.find("# TYPE arangodb_cluster_request_duration_seconds histogram\n"));
+  EXPECT_NE(std::string::npos,
+            result.find("arangodb_cluster_request_duration_seconds_bucket{le=\"+Inf\"} "));
+  EXPECT_NE(std::string::npos,
+            result.find("arangodb_http_requests_total{method=\"GET\"} "));
+  // every line is a comment or a sample with a value
+  size_t start = 0;
+  while (start < result.size()) {
+    size_t end = result.find('\n', start);
+    ASSERT_NE(std::string::npos, end);
+    std::string line = result.substr(start, end - start);
+    EXPECT_TRUE(line[0] == '#' || line.find(' ') != std::string::npos) << line;
+    start = end + 1;
+  }
+}
@@ -0,0 +1,130 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+#include "Statistics/Tracing.h"
+
+#include "gtest/gtest.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::tracing;
+
+class TracingTest : public ::testing::Test {
+ protected:
+  TracingTest() { configure(1.0, 8); }
+  ~TracingTest() { configure(0.0, 0); }
+};
+
+TEST_F(TracingTest, test_disabled) {
+  configure(0.0, 8);
+  EXPECT_FALSE(enabled());
+  EXPECT_FALSE(sample().sampled());
+
+  Span span("test", sample());
+  EXPECT_FALSE(span.active());
+}
+
+TEST_F(TracingTest, test_header_roundtrip) {
+  SpanContext context;
+  context.traceId = 0x0123456789abcdefULL;
+  context.spanId = 0xfedcba9876543210ULL;
+
+  std::string header = toHeader(context);
+  EXPECT_EQ("0123456789abcdef-fedcba9876543210", header);
+
+  SpanContext parsed = fromHeader(header);
+  EXPECT_EQ(context.traceId, parsed.traceId);
+  EXPECT_EQ(context.spanId, parsed.spanId);
+
+  EXPECT_FALSE(fromHeader("").sampled());
+  EXPECT_FALSE(fromHeader("0123456789abcdef").sampled());
+  EXPECT_FALSE(fromHeader("0123456789abcdeX-fedcba9876543210").sampled());
+}
+
+TEST_F(TracingTest, test_nested_spans) {
+  SpanContext root = sample();
+  ASSERT_TRUE(root.sampled());
+  EXPECT_FALSE(current().sampled());
+
+  {
+    Span request("request", root);
+    ContextScope scope(request.context());
+    {
+      ScopedSpan child("child");
+      EXPECT_EQ(child.span().context().spanId, current().spanId);
+    }
+    EXPECT_EQ(request.context().spanId, current().spanId);
+  }
+  EXPECT_FALSE(current().sampled());
+
+  std::vector<SpanRecord> result;
+  EXPECT_EQ(2, spans(0, result));
+  ASSERT_EQ(2, result.size());
+  // the child finishes first
+  EXPECT_EQ("child", result[0].name);
+  EXPECT_EQ("request", result[1].name);
+  EXPECT_EQ(root.traceId, result[0].traceId);
+  EXPECT_EQ(result[1].spanId, result[0].parentId);
+  EXPECT_EQ(0, result[1].parentId);
+  EXPECT_LE(result[0].start, result[0].end);
+}
+
+TEST_F(TracingTest, test_ring_buffer) {
+  SpanContext root = sample();
+  for (int i = 0; i < 10; ++i) {
+    record("span", root, i, i + 1);
+  }
+
+  // only the last 8 spans are kept
+  std::vector<SpanRecord> result;
+  EXPECT_EQ(10, spans(0, result));
+  ASSERT_EQ(8, result.size());
+  EXPECT_EQ(2, result.front().start);
+  EXPECT_EQ(9, result.back().start);
+
+  result.clear();
+  EXPECT_EQ(10, spans(9, result));
+  ASSERT_EQ(1, result.size());
+  EXPECT_EQ(9, result.front().start);
+
+  result.clear();
+  EXPECT_EQ(10, spans(10, result));
+  EXPECT_TRUE(result.empty());
+}
+
+TEST_F(TracingTest, test_otlp_json) {
+  SpanContext root = sample();
+  record("span", root, 1000, 2000);
+
+  std::vector<SpanRecord> result;
+  spans(0, result);
+  std::string json;
+  toOtlpJson(result, json);
+
+  EXPECT_NE(std::string::npos, json.find("\"resourceSpans\""));
+  EXPECT_NE(std::string::npos, json.find("\"startTimeUnixNano\":\"1000\""));
+  EXPECT_NE(std::string::npos, json.find("\"endTimeUnixNano\":\"2000\""));
+  // trace ids are padded to 128 bits
+  EXPECT_NE(std::string::npos, json.find("\"traceId\":\"0000000000000000"));
+}
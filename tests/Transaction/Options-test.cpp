@@ -0,0 +1,63 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/HybridLogicalClock.h"
+#include "Transaction/Options.h"
+#include "VocBase/ticks.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include "gtest/gtest.h"
+
+using namespace arangodb;
+
+TEST(TransactionOptionsTest, test_snapshot_timestamp_roundtrip) {
+  transaction::Options options;
+  EXPECT_FALSE(options.consistentSnapshot);
+  EXPECT_EQ(0, options.snapshotTimestamp);
+
+  options.consistentSnapshot = true;
+  options.snapshotTimestamp = 12345;
+
+  VPackBuilder builder;
+  builder.openObject();
+  options.toVelocyPack(builder);
+  builder.close();
+
+  transaction::Options other;
+  other.fromVelocyPack(builder.slice());
+  EXPECT_TRUE(other.consistentSnapshot);
+  EXPECT_EQ(12345, other.snapshotTimestamp);
+}
+
+TEST(TransactionOptionsTest, test_consistent_snapshot_timestamp) {
+  typedef basics::HybridLogicalClock HLC;
+  uint64_t const interval = transaction::Options::snapshotGridInterval;
+
+  uint64_t const timestamp = transaction::Options::consistentSnapshotTimestamp();
+  uint64_t const now = HLC::extractTime(TRI_HybridLogicalClock());
+
+  // a grid point at least one interval in the past
+  EXPECT_EQ(0, HLC::extractCount(timestamp));
+  EXPECT_EQ(0, HLC::extractTime(timestamp) % interval);
+  EXPECT_LE(HLC::extractTime(timestamp) + interval, now);
+  EXPECT_GT(HLC::extractTime(timestamp) + 10 * interval, now);
+}
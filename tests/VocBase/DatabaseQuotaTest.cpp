@@ -0,0 +1,111 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "gtest/gtest.h"
+
+#include "Basics/Exceptions.h"
+#include "Scheduler/SchedulerFeature.h"
+#include "VocBase/DatabaseQuota.h"
+
+#include <vector>
+
+using namespace arangodb;
+
+namespace {
+// without a scheduler, parked jobs are run by the job that frees their slot
+struct NoScheduler {
+  Scheduler* old;
+  NoScheduler() : old(SchedulerFeature::SCHEDULER) {
+    SchedulerFeature::SCHEDULER = nullptr;
+  }
+  ~NoScheduler() { SchedulerFeature::SCHEDULER = old; }
+};
+}  // namespace
+
+TEST(DatabaseQuotaTest, test_jobs_unlimited) {
+  NoScheduler noScheduler;
+  DatabaseQuota quota;
+  std::vector<int> order;
+  quota.runJob(RequestLane::CLIENT_FAST, [&]() {
+    quota.runJob(RequestLane::CLIENT_FAST, [&]() { order.push_back(2); });
+    order.push_back(1);
+  });
+  EXPECT_EQ((std::vector<int>{2, 1}), order);
+}
+
+TEST(DatabaseQuotaTest, test_jobs_parked) {
+  NoScheduler noScheduler;
+  DatabaseQuota quota;
+  DatabaseQuota::Limits limits;
+  limits.schedulerJobs = 1;
+  quota.setLimits(limits);
+
+  std::vector<int> order;
+  quota.runJob(RequestLane::CLIENT_FAST, [&]() {
+    quota.runJob(RequestLane::CLIENT_FAST, [&]() { order.push_back(2); });
+    quota.runJob(RequestLane::CLIENT_FAST, [&]() { order.push_back(3); });
+    order.push_back(1);
+  });
+  // parked jobs run in order, once the running job is done
+  EXPECT_EQ((std::vector<int>{1, 2, 3}), order);
+}
+
+TEST(DatabaseQuotaTest, test_queries) {
+  DatabaseQuota quota;
+  DatabaseQuota::Limits limits;
+  limits.queries = 2;
+  quota.setLimits(limits);
+
+  quota.startQuery();
+  quota.startQuery();
+  try {
+    quota.startQuery();
+    FAIL() << "expected the query to be rejected";
+  } catch (basics::Exception const& ex) {
+    EXPECT_EQ(TRI_ERROR_RESOURCE_LIMIT, ex.code());
+  }
+
+  quota.finishQuery();
+  quota.startQuery();
+  quota.finishQuery();
+  quota.finishQuery();
+}
+
+TEST(DatabaseQuotaTest, test_write_delay) {
+  DatabaseQuota quota;
+  auto const now = DatabaseQuota::clock::now();
+  EXPECT_EQ(DatabaseQuota::clock::duration::zero(), quota.writeDelay(1000000, now));
+
+  DatabaseQuota::Limits limits;
+  limits.writeRate = 1000;
+  quota.setLimits(limits);
+
+  // one second of unused capacity is kept
+  EXPECT_EQ(DatabaseQuota::clock::duration::zero(), quota.writeDelay(1000, now));
+  EXPECT_EQ(std::chrono::milliseconds(500),
+            std::chrono::duration_cast<std::chrono::milliseconds>(quota.writeDelay(500, now)));
+  EXPECT_EQ(std::chrono::milliseconds(1000),
+            std::chrono::duration_cast<std::chrono::milliseconds>(quota.writeDelay(500, now)));
+  // the capacity refills over time
+  EXPECT_EQ(DatabaseQuota::clock::duration::zero(),
+            quota.writeDelay(1000, now + std::chrono::seconds(3)));
+}
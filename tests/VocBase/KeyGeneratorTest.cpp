@@ -0,0 +1,190 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+#include "Basics/StaticStrings.h"
+#include "Basics/StringUtils.h"
+#include "VocBase/KeyGenerator.h"
+
+#include "gtest/gtest.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <thread>
+
+using namespace arangodb;
+
+namespace {
+std::unique_ptr<KeyGenerator> create(std::string const& json) {
+  auto options = VPackParser::fromJson(json);
+  return std::unique_ptr<KeyGenerator>(KeyGenerator::factory(options->slice()));
+}
+
+uint64_t lastValue(KeyGenerator const& generator) {
+  VPackBuilder builder;
+  builder.openObject();
+  generator.toVelocyPack(builder);
+  builder.close();
+  return builder.slice().get(StaticStrings::LastValue).getUInt();
+}
+
+// generates keys on a thread of its own, one per call
+class KeyThread {
+ public:
+  explicit KeyThread(KeyGenerator& generator)
+      : _generator(generator), _thread([this]() { run(); }) {}
+
+  ~KeyThread() {
+    {
+      std::lock_guard<std::mutex> guard(_mutex);
+      _stop = true;
+    }
+    _cv.notify_all();
+    _thread.join();
+  }
+
+  std::string generate() {
+    std::promise<std::string> promise;
+    auto future = promise.get_future();
+    {
+      std::lock_guard<std::mutex> guard(_mutex);
+      _request = &promise;
+    }
+    _cv.notify_all();
+    return future.get();
+  }
+
+ private:
+  void run() {
+    std::unique_lock<std::mutex> guard(_mutex);
+    while (true) {
+      _cv.wait(guard, [this]() { return _stop || _request != nullptr; });
+      if (_request != nullptr) {
+        _request->set_value(_generator.generate());
+        _request = nullptr;
+      } else {
+        return;
+      }
+    }
+  }
+
+  KeyGenerator& _generator;
+  std::mutex _mutex;
+  std::condition_variable _cv;
+  std::promise<std::string>* _request = nullptr;
+  bool _stop = false;
+  std::thread _thread;
+};
+}  // namespace
+
+TEST(KeyGeneratorTest, test_traditional_keys_are_ascending_across_threads) {
+  auto generator = create("{\"type\":\"traditional\"}");
+  KeyThread a(*generator);
+  KeyThread b(*generator);
+
+  uint64_t const a1 = basics::StringUtils::uint64(a.generate());
+  uint64_t const b1 = basics::StringUtils::uint64(b.generate());
+  uint64_t const a2 = basics::StringUtils::uint64(a.generate());
+  EXPECT_LT(a1, b1);
+  EXPECT_LT(b1, a2);
+  EXPECT_EQ(a2, lastValue(*generator));
+}
+
+TEST(KeyGeneratorTest, test_padded_keys_sort_in_generation_order) {
+  auto generator = create("{\"type\":\"padded\"}");
+  KeyThread a(*generator);
+  KeyThread b(*generator);
+
+  std::string const a1 = a.generate();
+  std::string const b1 = b.generate();
+  std::string const a2 = a.generate();
+  EXPECT_EQ(16, a1.size());
+  EXPECT_LT(a1, b1);
+  EXPECT_LT(b1, a2);
+}
+
+TEST(KeyGeneratorTest, test_leased_keys_are_ascending_per_thread) {
+  auto generator = create("{\"type\":\"traditional\",\"leaseValues\":true}");
+  KeyThread a(*generator);
+  KeyThread b(*generator);
+
+  uint64_t const a1 = basics::StringUtils::uint64(a.generate());
+  uint64_t const b1 = basics::StringUtils::uint64(b.generate());
+  uint64_t const a2 = basics::StringUtils::uint64(a.generate());
+  // a hands out the rest of its block, b leased the next one
+  EXPECT_LT(a1, a2);
+  EXPECT_LT(a2, b1);
+
+  // the option is kept with the collection
+  VPackBuilder builder;
+  builder.openObject();
+  generator->toVelocyPack(builder);
+  builder.close();
+  EXPECT_TRUE(builder.slice().get("leaseValues").isTrue());
+}
+
+TEST(KeyGeneratorTest, test_tracked_keys_are_not_handed_out_by_leases) {
+  auto generator = create("{\"type\":\"traditional\",\"leaseValues\":true}");
+  uint64_t const first = basics::StringUtils::uint64(generator->generate());
+
+  // a user key inside the leased block
+  std::string const inBlock = std::to_string(first + 10);
+  ASSERT_EQ(TRI_ERROR_NO_ERROR,
+            generator->validate(inBlock.data(), inBlock.size(), false));
+  uint64_t const next = basics::StringUtils::uint64(generator->generate());
+  EXPECT_GT(next, first + 10);
+
+  // a user key above all leased values
+  std::string const above = std::to_string(next + 100000);
+  generator->track(above.data(), above.size());
+  EXPECT_GT(basics::StringUtils::uint64(generator->generate()), next + 100000);
+}
+
+TEST(KeyGeneratorTest, test_last_value_covers_leased_values) {
+  auto generator = create("{\"type\":\"traditional\",\"leaseValues\":true}");
+  uint64_t const first = basics::StringUtils::uint64(generator->generate());
+
+  // the rest of the block may be handed out before the next persist, so
+  // it counts as used
+  uint64_t const persisted = lastValue(*generator);
+  EXPECT_GE(persisted, first + 63);
+
+  // restored like RocksDBCollectionMeta does after a restart
+  auto restored = create("{\"type\":\"traditional\",\"leaseValues\":true}");
+  std::string const value = std::to_string(persisted);
+  restored->track(value.data(), value.size());
+  EXPECT_GT(basics::StringUtils::uint64(restored->generate()), persisted);
+}
+
+TEST(KeyGeneratorTest, test_last_value_without_leasing) {
+  auto generator = create("{\"type\":\"traditional\"}");
+  uint64_t const first = basics::StringUtils::uint64(generator->generate());
+  EXPECT_EQ(first, lastValue(*generator));
+
+  auto restored = create("{\"type\":\"traditional\"}");
+  std::string const value = std::to_string(first);
+  restored->track(value.data(), value.size());
+  EXPECT_GT(basics::StringUtils::uint64(restored->generate()), first);
+}